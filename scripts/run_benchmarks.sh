@@ -0,0 +1,71 @@
+#!/bin/bash -e
+
+# Copyright 2018- The Pixie Authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Builds and runs every C++ micro-benchmark in the repo (targets matching *_benchmark),
+# writing one google-benchmark JSON file per target. The JSON files can be diffed across
+# releases with google-benchmark's tools/compare.py for regression tracking.
+
+usage() {
+  echo "Usage: $0 [-o <output_dir>] [-f <target_filter>]"
+  echo " -o : Directory for JSON results (default: benchmark_results/<git-sha>)"
+  echo " -f : Only run benchmark targets whose label matches this regex"
+  exit 1
+}
+
+output_dir=""
+target_filter=""
+while getopts "o:f:h" opt; do
+  case ${opt} in
+    o) output_dir=${OPTARG} ;;
+    f) target_filter=${OPTARG} ;;
+    *) usage ;;
+  esac
+done
+
+workspace=$(bazel info workspace)
+cd "${workspace}"
+
+if [ -z "${output_dir}" ]; then
+  output_dir="benchmark_results/$(git rev-parse --short HEAD)"
+fi
+mkdir -p "${output_dir}"
+
+echo "Running bazel query to find benchmarks..."
+mapfile -t benchmarks < <(bazel query 'filter("_benchmark$", kind(cc_binary, //src/...))' 2>/dev/null)
+
+if [ -n "${target_filter}" ]; then
+  mapfile -t benchmarks < <(printf '%s\n' "${benchmarks[@]}" | grep -E "${target_filter}")
+fi
+
+if [ ${#benchmarks[@]} -eq 0 ]; then
+  echo "No benchmark targets found."
+  exit 1
+fi
+
+echo "Building ${#benchmarks[@]} benchmark targets..."
+bazel build -c opt "${benchmarks[@]}"
+
+for target in "${benchmarks[@]}"; do
+  # //src/carnot/exec:exec_node_benchmark -> src.carnot.exec.exec_node_benchmark.json
+  out_file="${output_dir}/$(echo "${target#//}" | tr '/:' '..').json"
+  echo "Running ${target} -> ${out_file}"
+  bazel run -c opt "${target}" -- \
+    --benchmark_format=json --benchmark_out="${workspace}/${out_file}"
+done
+
+echo "Results written to ${output_dir}"
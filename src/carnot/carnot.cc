@@ -16,8 +16,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include <farmhash.h>
 
 #include "src/carnot/carnot.h"
 #include "src/carnot/carnotpb/carnot.grpc.pb.h"
@@ -25,6 +33,7 @@
 #include "src/carnot/engine_state.h"
 #include "src/carnot/exec/exec_graph.h"
 #include "src/carnot/exec/grpc_router.h"
+#include "src/carnot/exec/query_result_cache.h"
 #include "src/carnot/funcs/builtins/builtins.h"
 #include "src/carnot/plan/operators.h"
 #include "src/carnot/plan/plan.h"
@@ -33,13 +42,165 @@
 #include "src/carnot/udf/registry.h"
 #include "src/common/perf/perf.h"
 #include "src/shared/types/type_utils.h"
+#include "src/table_store/table/table_export_service.h"
 #include "src/table_store/table_store.h"
 
+DEFINE_bool(enable_standing_query_contexts,
+            gflags::BoolFromEnv("PL_ENABLE_STANDING_QUERY_CONTEXTS", false),
+            "Whether Carnot keeps the execution context of a standing query (deserialized "
+            "plan, UDF bindings, client stubs, query memory pool) alive between executions, "
+            "re-binding only the queried time range per run.");
+
+DEFINE_bool(enable_query_result_cache,
+            gflags::BoolFromEnv("PL_ENABLE_QUERY_RESULT_CACHE", false),
+            "Whether Carnot caches the output row batches of repeated script executions and "
+            "serves them for re-runs whose plan and quantized time window match. Only plans "
+            "whose sinks are all memory sinks are cached; results that leave the process as a "
+            "gRPC stream cannot be replayed from the cache.");
+DEFINE_int64(query_result_cache_ttl_s,
+             gflags::Int64FromEnv("PL_QUERY_RESULT_CACHE_TTL_S", 60),
+             "How long cached query results stay servable, in seconds.");
+DEFINE_int64(query_result_cache_max_bytes,
+             gflags::Int64FromEnv("PL_QUERY_RESULT_CACHE_MAX_BYTES", 64 * 1024 * 1024),
+             "Byte budget for cached query results. Least-recently-used entries are evicted "
+             "once the budget is exceeded.");
+
+DEFINE_int32(carnot_result_server_num_cqs,
+             gflags::Int32FromEnv("PL_CARNOT_RESULT_SERVER_NUM_CQS", 0),
+             "Number of completion queues for Carnot's result server. Incoming result stream "
+             "connections are sharded across the queues, each with dedicated poller threads, "
+             "which relieves the ingest bottleneck when many agents stream results to one "
+             "Kelvin. 0 leaves the gRPC default (one shared completion queue).");
+DEFINE_int32(carnot_result_server_min_pollers,
+             gflags::Int32FromEnv("PL_CARNOT_RESULT_SERVER_MIN_POLLERS", 0),
+             "Minimum polling threads per result server completion queue. 0 leaves the gRPC "
+             "default.");
+DEFINE_int32(carnot_result_server_max_pollers,
+             gflags::Int32FromEnv("PL_CARNOT_RESULT_SERVER_MAX_POLLERS", 0),
+             "Maximum polling threads per result server completion queue. 0 leaves the gRPC "
+             "default.");
+
 namespace px {
 namespace carnot {
 
 using types::DataType;
 
+namespace {
+
+// Contexts from standing queries that have stopped running are swept after this TTL.
+constexpr std::chrono::minutes kStandingQueryContextTTL{15};
+
+// Returns a fingerprint of the logical plan that is invariant to the memory-source time
+// ranges. Consecutive executions of the same standing script produce plans that differ only
+// in those fields, so their fingerprints collide and the execution context can be reused.
+std::string StandingQueryFingerprint(const planpb::Plan& logical_plan) {
+  planpb::Plan normalized = logical_plan;
+  for (auto& pf : *normalized.mutable_nodes()) {
+    for (auto& node : *pf.mutable_nodes()) {
+      if (node.op().op_type() != planpb::OperatorType::MEMORY_SOURCE_OPERATOR) {
+        continue;
+      }
+      node.mutable_op()->mutable_mem_source_op()->clear_start_time();
+      node.mutable_op()->mutable_mem_source_op()->clear_stop_time();
+    }
+  }
+  return normalized.SerializeAsString();
+}
+
+// Copies the memory-source time ranges of the incoming plan into the cached plan. The
+// fingerprint match guarantees the two plans are identical in every other field.
+Status RebindMemorySourceTimeRanges(const planpb::Plan& logical_plan, plan::Plan* plan) {
+  for (const auto& pf_pb : logical_plan.nodes()) {
+    auto pf = plan->nodes().find(pf_pb.id());
+    if (pf == plan->nodes().end()) {
+      return error::Internal("Standing query context is missing plan fragment $0.", pf_pb.id());
+    }
+    for (const auto& node_pb : pf_pb.nodes()) {
+      if (node_pb.op().op_type() != planpb::OperatorType::MEMORY_SOURCE_OPERATOR) {
+        continue;
+      }
+      auto op = pf->second->nodes().find(node_pb.id());
+      if (op == pf->second->nodes().end()) {
+        return error::Internal("Standing query context is missing operator $0.", node_pb.id());
+      }
+      static_cast<plan::MemorySourceOperator*>(op->second.get())
+          ->SetTimeRange(node_pb.op().mem_source_op());
+    }
+  }
+  return Status::OK();
+}
+
+// The parts of a plan the query result cache keys on: one entry per memory sink plus the
+// union of the memory-source time windows.
+struct ResultCachePlanInfo {
+  std::vector<const planpb::MemorySinkOperator*> sinks;
+  int64_t start_time_ns = 0;
+  int64_t stop_time_ns = 0;
+};
+
+// Returns the cache info for the plan, or nullopt if the plan is not cacheable. Plans with
+// non-memory sinks stream their results out of the process, so there is nothing the cache
+// could replay; plans without a bounded memory-source time window would produce different
+// results every run.
+std::optional<ResultCachePlanInfo> GetResultCachePlanInfo(const planpb::Plan& logical_plan) {
+  ResultCachePlanInfo info;
+  bool has_window = false;
+  for (const auto& pf : logical_plan.nodes()) {
+    for (const auto& node : pf.nodes()) {
+      switch (node.op().op_type()) {
+        case planpb::OperatorType::MEMORY_SINK_OPERATOR:
+          info.sinks.push_back(&node.op().mem_sink_op());
+          break;
+        case planpb::OperatorType::GRPC_SINK_OPERATOR:
+        case planpb::OperatorType::OTEL_EXPORT_SINK_OPERATOR:
+          return std::nullopt;
+        case planpb::OperatorType::MEMORY_SOURCE_OPERATOR: {
+          const auto& src = node.op().mem_source_op();
+          if (src.streaming() || !src.has_start_time() || !src.has_stop_time()) {
+            return std::nullopt;
+          }
+          if (!has_window) {
+            info.start_time_ns = src.start_time().value();
+            info.stop_time_ns = src.stop_time().value();
+            has_window = true;
+          } else {
+            info.start_time_ns = std::min(info.start_time_ns, src.start_time().value());
+            info.stop_time_ns = std::max(info.stop_time_ns, src.stop_time().value());
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+  if (!has_window || info.sinks.empty()) {
+    return std::nullopt;
+  }
+  return info;
+}
+
+// Result cache entries are per sink table, so the table name is folded into the plan
+// fingerprint half of the key.
+uint64_t SinkFingerprint(uint64_t plan_fingerprint, const std::string& table_name) {
+  return plan_fingerprint ^ ::util::Fingerprint64(table_name.data(), table_name.size());
+}
+
+}  // namespace
+
+// Execution context kept alive between executions of a standing query. Holds everything
+// whose setup cost is independent of the queried time range: the deserialized plan, the plan
+// state, and the ExecState with its UDF/UDA bindings, client stubs, and warmed query memory
+// pool. Exec nodes themselves have a single-shot Open/Close lifecycle, so the execution
+// graph is rebuilt from the cached plan each run; nodes with expensive cross-run state (e.g.
+// WindowAggNode) persist it in their own caches.
+struct StandingQueryContext {
+  std::unique_ptr<plan::Plan> plan;
+  std::unique_ptr<plan::PlanState> plan_state;
+  std::unique_ptr<exec::ExecState> exec_state;
+  std::chrono::steady_clock::time_point last_used;
+};
+
 class CarnotImpl final : public Carnot {
  public:
   ~CarnotImpl() override;
@@ -87,6 +248,20 @@ class CarnotImpl final : public Carnot {
 
   void GRPCServerFunc();
 
+  // Removes and returns the cached standing-query context for the given fingerprint, or
+  // nullptr if none exists. Taking the context out of the map makes concurrent executions of
+  // the same script fall back to a fresh context instead of sharing state.
+  std::unique_ptr<StandingQueryContext> TakeStandingQueryContext(const std::string& key);
+  void ReturnStandingQueryContext(const std::string& key,
+                                  std::unique_ptr<StandingQueryContext> ctx);
+
+  // Serves a fully-cached execution: writes the cached batches into the sink tables and sends
+  // the final execution stats to the plan's execution status destinations, skipping the
+  // execution graph entirely.
+  Status ServeFromResultCache(const planpb::Plan& logical_plan, const sole::uuid& query_id,
+                              const ResultCachePlanInfo& cache_info,
+                              const std::vector<exec::QueryResultCache::Entry>& entries);
+
   AgentMetadataCallbackFunc agent_md_callback_;
   planner::compiler::Compiler compiler_;
   std::unique_ptr<EngineState> engine_state_;
@@ -96,6 +271,18 @@ class CarnotImpl final : public Carnot {
   std::unique_ptr<ClientsConfig> clients_config_;
   std::unique_ptr<ServerConfig> server_config_;
 
+  // Cached execution contexts for standing queries, keyed by a time-range-invariant
+  // fingerprint of the logical plan.
+  std::mutex standing_contexts_lock_;
+  absl::flat_hash_map<std::string, std::unique_ptr<StandingQueryContext>> standing_contexts_;
+
+  // Cached output row batches of repeated script executions. nullptr unless
+  // --enable_query_result_cache is set.
+  std::unique_ptr<exec::QueryResultCache> result_cache_;
+
+  // Serves bulk table exports on the gRPC server, alongside the result sink service.
+  std::unique_ptr<table_store::TableExportService> table_export_service_;
+
   // The id of the agent that owns this Carnot instance.
   sole::uuid agent_id_;
 };
@@ -108,6 +295,7 @@ Status CarnotImpl::Init(const sole::uuid& agent_id, std::unique_ptr<udf::Registr
   clients_config_ = std::move(clients_config);
   server_config_ = std::move(server_config);
   if (server_config_->grpc_server_port > 0) {
+    table_export_service_ = std::make_unique<table_store::TableExportService>(table_store.get());
     grpc_server_thread_ = std::make_unique<std::thread>(&CarnotImpl::GRPCServerFunc, this);
   }
 
@@ -116,6 +304,10 @@ Status CarnotImpl::Init(const sole::uuid& agent_id, std::unique_ptr<udf::Registr
                                                  clients_config_->stub_generator,
                                                  clients_config_->add_auth_to_grpc_context_func,
                                                  &server_config_->grpc_router));
+  if (FLAGS_enable_query_result_cache) {
+    result_cache_ = std::make_unique<exec::QueryResultCache>(
+        FLAGS_query_result_cache_ttl_s * 1000 * 1000 * 1000, FLAGS_query_result_cache_max_bytes);
+  }
   return Status::OK();
 }
 
@@ -225,12 +417,57 @@ void CarnotImpl::GRPCServerFunc() {
 
   builder.AddListeningPort(server_address, server_config_->grpc_server_creds);
   builder.RegisterService(&server_config_->grpc_router);
+  // Bulk table exports share the result sink server; exports are streamed straight out of the
+  // table store without going through the execution engine.
+  builder.RegisterService(table_export_service_.get());
+  // Shard the sync server across multiple completion queues when configured. gRPC spreads
+  // incoming connections across the queues, so result streams from different agents are
+  // polled by different threads instead of contending for a single shared queue.
+  if (FLAGS_carnot_result_server_num_cqs > 0) {
+    builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS,
+                                FLAGS_carnot_result_server_num_cqs);
+  }
+  if (FLAGS_carnot_result_server_min_pollers > 0) {
+    builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MIN_POLLERS,
+                                FLAGS_carnot_result_server_min_pollers);
+  }
+  if (FLAGS_carnot_result_server_max_pollers > 0) {
+    builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MAX_POLLERS,
+                                FLAGS_carnot_result_server_max_pollers);
+  }
   grpc_server_ = builder.BuildAndStart();
   std::cout << "Server listening on " << server_address << std::endl;
   CHECK(grpc_server_ != nullptr);
   grpc_server_->Wait();
 }
 
+std::unique_ptr<StandingQueryContext> CarnotImpl::TakeStandingQueryContext(
+    const std::string& key) {
+  std::lock_guard<std::mutex> lock(standing_contexts_lock_);
+  auto it = standing_contexts_.find(key);
+  if (it == standing_contexts_.end()) {
+    return nullptr;
+  }
+  auto ctx = std::move(it->second);
+  standing_contexts_.erase(it);
+  return ctx;
+}
+
+void CarnotImpl::ReturnStandingQueryContext(const std::string& key,
+                                            std::unique_ptr<StandingQueryContext> ctx) {
+  const auto now = std::chrono::steady_clock::now();
+  ctx->last_used = now;
+  std::lock_guard<std::mutex> lock(standing_contexts_lock_);
+  for (auto it = standing_contexts_.begin(); it != standing_contexts_.end();) {
+    if (now - it->second->last_used > kStandingQueryContextTTL) {
+      it = standing_contexts_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  standing_contexts_[key] = std::move(ctx);
+}
+
 Status SendTransferResultChunkToOutgoingConns(
     const absl::flat_hash_map<std::string, carnotpb::ResultSinkService::StubInterface*>&
         outgoing_servers,
@@ -316,17 +553,122 @@ Status InitiateOutgoingConns(
                                                 std::move(req));
 }
 
+Status CarnotImpl::ServeFromResultCache(
+    const planpb::Plan& logical_plan, const sole::uuid& query_id,
+    const ResultCachePlanInfo& cache_info,
+    const std::vector<exec::QueryResultCache::Entry>& entries) {
+  auto timer = ElapsedTimer();
+  timer.Start();
+
+  // An ExecState is still needed for the result-sink stubs used to report completion.
+  auto exec_state = engine_state_->CreateExecState(query_id);
+  auto outgoing_conns = GetOutgoingConns(exec_state.get(), logical_plan);
+  PL_RETURN_IF_ERROR(InitiateOutgoingConns(query_id, outgoing_conns,
+                                           engine_state_->add_auth_to_grpc_context_func()));
+
+  int64_t bytes_processed = 0;
+  int64_t rows_processed = 0;
+  for (size_t i = 0; i < cache_info.sinks.size(); ++i) {
+    const auto* sink = cache_info.sinks[i];
+    std::vector<types::DataType> col_types;
+    std::vector<std::string> col_names;
+    for (int j = 0; j < sink->column_types_size(); ++j) {
+      col_types.push_back(sink->column_types(j));
+      col_names.push_back(sink->column_names(j));
+    }
+    auto table = table_store::Table::Create(sink->name(),
+                                            table_store::schema::Relation(col_types, col_names));
+    for (const auto& batch : entries[i].batches) {
+      PL_RETURN_IF_ERROR(table->WriteRowBatch(*batch));
+      bytes_processed += batch->NumBytes();
+      rows_processed += batch->num_rows();
+    }
+    table_store()->AddTable(sink->name(), table);
+  }
+  timer.Stop();
+
+  queryresultspb::AgentExecutionStats agent_stats;
+  ToProto(agent_id_, agent_stats.mutable_agent_id());
+  agent_stats.set_execution_time_ns(timer.ElapsedTime_us() * 1000);
+  agent_stats.set_bytes_processed(bytes_processed);
+  agent_stats.set_records_processed(rows_processed);
+  return SendFinalExecutionStatsToOutgoingConns(query_id, outgoing_conns,
+                                                engine_state_->add_auth_to_grpc_context_func(),
+                                                agent_stats, {agent_stats});
+}
+
 Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uuid& query_id,
                                bool analyze) {
   auto timer = ElapsedTimer();
-  plan::Plan plan;
 
-  PL_RETURN_IF_ERROR(plan.Init(logical_plan));
+  // Serve repeated executions straight from the result cache when every sink has an entry for
+  // this plan's fingerprint and quantized time window.
+  std::optional<ResultCachePlanInfo> cache_info;
+  uint64_t plan_fingerprint = 0;
+  if (result_cache_ != nullptr) {
+    cache_info = GetResultCachePlanInfo(logical_plan);
+  }
+  if (cache_info.has_value()) {
+    const std::string normalized = StandingQueryFingerprint(logical_plan);
+    plan_fingerprint = ::util::Fingerprint64(normalized.data(), normalized.size());
+
+    const int64_t now_ns = CurrentTimeNS();
+    std::vector<exec::QueryResultCache::Entry> entries;
+    bool all_hit = true;
+    for (const auto* sink : cache_info->sinks) {
+      auto key = exec::QueryResultCache::MakeKey(SinkFingerprint(plan_fingerprint, sink->name()),
+                                                 cache_info->start_time_ns,
+                                                 cache_info->stop_time_ns);
+      auto entry = result_cache_->Get(key, now_ns);
+      if (!entry.has_value()) {
+        all_hit = false;
+        break;
+      }
+      entries.push_back(std::move(entry.value()));
+    }
+    if (all_hit) {
+      return ServeFromResultCache(logical_plan, query_id, cache_info.value(), entries);
+    }
+  }
 
-  // For each of the plan fragments in the plan, execute the query.
-  std::vector<std::string> output_table_strs;
-  auto exec_state = engine_state_->CreateExecState(query_id);
-  auto outgoing_conns = GetOutgoingConns(exec_state.get(), logical_plan);
+  // Standing queries (the same script executed every few seconds forever) reuse a cached
+  // execution context when one exists for this plan, skipping the per-run plan
+  // deserialization, UDF/UDA registration, stub creation, and allocator warmup.
+  std::string standing_key;
+  std::unique_ptr<StandingQueryContext> ctx;
+  if (FLAGS_enable_standing_query_contexts) {
+    standing_key = StandingQueryFingerprint(logical_plan);
+    ctx = TakeStandingQueryContext(standing_key);
+  }
+  if (ctx == nullptr) {
+    ctx = std::make_unique<StandingQueryContext>();
+    ctx->plan = std::make_unique<plan::Plan>();
+    PL_RETURN_IF_ERROR(ctx->plan->Init(logical_plan));
+    ctx->plan_state = engine_state_->CreatePlanState();
+    ctx->exec_state = engine_state_->CreateExecState(query_id);
+    // Record which GRPC source nodes run in this process, so that sinks targeting them can hand
+    // row batches over in-process instead of going through the gRPC stack.
+    for (const auto& pf : logical_plan.nodes()) {
+      for (const auto& node : pf.nodes()) {
+        if (node.op().op_type() == planpb::OperatorType::GRPC_SOURCE_OPERATOR) {
+          ctx->exec_state->AddLocalGRPCSourceID(node.id());
+        }
+      }
+    }
+    PL_RETURN_IF_ERROR(RegisterUDFs(ctx->exec_state.get(), ctx->plan.get()));
+  } else {
+    PL_RETURN_IF_ERROR(RebindMemorySourceTimeRanges(logical_plan, ctx->plan.get()));
+    ctx->exec_state->ResetForNextExecution(query_id);
+  }
+  plan::Plan* plan = ctx->plan.get();
+  plan::PlanState* plan_state = ctx->plan_state.get();
+  exec::ExecState* exec_state = ctx->exec_state.get();
+
+  if (cache_info.has_value()) {
+    exec_state->EnableResultCapture();
+  }
+
+  auto outgoing_conns = GetOutgoingConns(exec_state, logical_plan);
   PL_RETURN_IF_ERROR(InitiateOutgoingConns(query_id, outgoing_conns,
                                            engine_state_->add_auth_to_grpc_context_func()));
 
@@ -338,9 +680,6 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
     exec_state->set_metadata_state(metadata_state);
   }
 
-  PL_RETURN_IF_ERROR(RegisterUDFs(exec_state.get(), &plan));
-
-  auto plan_state = engine_state_->CreatePlanState();
   int64_t bytes_processed = 0;
   int64_t rows_processed = 0;
   queryresultspb::AgentExecutionStats agent_operator_exec_stats;
@@ -354,7 +693,7 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
       plan::PlanWalker()
           .OnPlanFragment([&](auto* pf) {
             auto exec_graph = exec::ExecutionGraph();
-            PL_RETURN_IF_ERROR(exec_graph.Init(schema.get(), plan_state.get(), exec_state.get(), pf,
+            PL_RETURN_IF_ERROR(exec_graph.Init(schema.get(), plan_state, exec_state, pf,
                                                /* collect_exec_node_stats */ analyze));
             PL_RETURN_IF_ERROR(exec_graph.Execute());
 
@@ -373,12 +712,16 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
                     absl::Substitute("$0 (id=$1)", pf->nodes()[node_id]->DebugString(), node_id);
                 exec::ExecNodeStats* stats = exec_node->stats();
                 stats->AddExtraMetric("batches_output", stats->batches_output);
+                stats->AddExtraMetric("batches_input", stats->batches_input);
+                stats->AddExtraMetric("rows_input", stats->rows_input);
+                stats->AddExtraMetric("bytes_input", stats->bytes_input);
                 int64_t total_time_ns = stats->TotalExecTime();
                 int64_t self_time_ns = stats->SelfExecTime();
                 LOG(INFO) << absl::Substitute(
-                    "self_time:$1\ttotal_time: $2\tbytes_output: $3\trows_output: $4\tnode_id:$0",
+                    "self_time:$1\ttotal_time: $2\tbytes_input: $3\trows_input: $4\tbytes_output: "
+                    "$5\trows_output: $6\tnode_id:$0",
                     node_name, PrettyDuration(self_time_ns), PrettyDuration(total_time_ns),
-                    stats->bytes_output, stats->rows_output);
+                    stats->bytes_input, stats->rows_input, stats->bytes_output, stats->rows_output);
 
                 queryresultspb::OperatorExecutionStats* stats_pb =
                     agent_operator_exec_stats.add_operator_execution_stats();
@@ -400,7 +743,7 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
             }
             return Status::OK();
           })
-          .Walk(&plan);
+          .Walk(plan);
   if (!s.ok()) {
     PL_RETURN_IF_ERROR(SendErrorToOutgoingConns(query_id, outgoing_conns,
                                                 engine_state_->add_auth_to_grpc_context_func(), s));
@@ -420,6 +763,13 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
     return combined_status;
   }
 
+  if (analyze) {
+    // Arrow allocations are tracked per query, so peak memory is reported at query scope;
+    // the buffering operators additionally report their own peaks via extra_metrics.
+    LOG(INFO) << absl::Substitute("Query $0 peak arrow memory: $1 bytes", query_id.str(),
+                                  exec_state->query_mem_pool().max_memory());
+  }
+
   std::vector<uuidpb::UUID> incoming_agents;
   for (const auto& id : logical_plan.incoming_agent_ids()) {
     incoming_agents.push_back(id);
@@ -456,9 +806,37 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
   // analyze=true will send per operator stats.
   all_agent_stats.push_back(agent_operator_exec_stats);
 
-  return SendFinalExecutionStatsToOutgoingConns(query_id, outgoing_conns,
-                                                engine_state_->add_auth_to_grpc_context_func(),
-                                                agent_operator_exec_stats, all_agent_stats);
+  auto final_status = SendFinalExecutionStatsToOutgoingConns(
+      query_id, outgoing_conns, engine_state_->add_auth_to_grpc_context_func(),
+      agent_operator_exec_stats, all_agent_stats);
+
+  if (cache_info.has_value() && final_status.ok()) {
+    const int64_t now_ns = CurrentTimeNS();
+    const auto& captured = exec_state->captured_result_batches();
+    for (const auto* sink : cache_info->sinks) {
+      auto key = exec::QueryResultCache::MakeKey(SinkFingerprint(plan_fingerprint, sink->name()),
+                                                 cache_info->start_time_ns,
+                                                 cache_info->stop_time_ns);
+      exec::QueryResultCache::Entry entry;
+      entry.end_time_ns = cache_info->stop_time_ns;
+      auto it = captured.find(sink->name());
+      if (it != captured.end()) {
+        entry.batches = it->second;
+      }
+      result_cache_->Put(key, std::move(entry), now_ns);
+    }
+  }
+
+  if (FLAGS_enable_standing_query_contexts && final_status.ok()) {
+    // Release this run's router-side state now instead of holding it until the next run
+    // re-keys the ExecState, then keep the context for the next execution. Failed runs drop
+    // the context so the next execution starts from a clean slate.
+    if (exec_state->grpc_router() != nullptr) {
+      exec_state->grpc_router()->DeleteQuery(query_id);
+    }
+    ReturnStandingQueryContext(standing_key, std::move(ctx));
+  }
+  return final_status;
 }
 
 CarnotImpl::~CarnotImpl() {
@@ -31,6 +31,8 @@
 #include "src/shared/metadata/metadata_state.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_bool(enable_standing_query_contexts);
+
 namespace px {
 namespace carnot {
 
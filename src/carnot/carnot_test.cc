@@ -280,6 +280,77 @@ px.display(queryDF, 'range_output'))pxl";
   EXPECT_TRUE(rb1.ColumnAt(2)->Equals(types::ToArrow(col2_out1, arrow::default_memory_pool())));
 }
 
+TEST_F(CarnotTest, standing_query_context_reuse) {
+  bool old_flag = FLAGS_enable_standing_query_contexts;
+  FLAGS_enable_standing_query_contexts = true;
+
+  std::string query = R"pxl(
+import px
+queryDF = px.DataFrame(table='big_test_table', select=['time_', 'col2', 'col3'], start_time=8, end_time=12)
+px.display(queryDF, 'standing_output'))pxl";
+
+  // Compile once, then execute the same plan repeatedly with different time windows, the way
+  // a standing script runs. After the first run the plans differ only in the memory-source
+  // time ranges, so the cached execution context is reused with the times re-bound.
+  Compiler compiler;
+  std::unique_ptr<planner::RegistryInfo> registry_info =
+      udfexporter::ExportUDFInfo().ConsumeValueOrDie();
+  planner::CompilerState compiler_state(
+      table_store_->GetRelationMap(), planner::SensitiveColumnMap{}, registry_info.get(),
+      /* time_now */ 0,
+      /* max_output_rows_per_table */ 0, "result_addr", "result_ssl_targetname",
+      planner::RedactionOptions{}, nullptr, nullptr, planner::DebugInfo{});
+  planpb::Plan plan = compiler.Compile(query, &compiler_state).ConsumeValueOrDie();
+
+  auto set_time_range = [](planpb::Plan* plan_pb, int64_t start_time, int64_t stop_time) {
+    for (auto& pf : *plan_pb->mutable_nodes()) {
+      for (auto& node : *pf.mutable_nodes()) {
+        if (node.op().op_type() != planpb::MEMORY_SOURCE_OPERATOR) {
+          continue;
+        }
+        node.mutable_op()->mutable_mem_source_op()->mutable_start_time()->set_value(start_time);
+        node.mutable_op()->mutable_mem_source_op()->mutable_stop_time()->set_value(stop_time);
+      }
+    }
+  };
+
+  auto run_and_check = [&](int64_t start_time, int64_t stop_time) {
+    result_server_->ResetQueryResults();
+    set_time_range(&plan, start_time, stop_time);
+    ASSERT_OK(carnot_->ExecutePlan(plan, sole::uuid4()));
+
+    std::vector<types::Time64NSValue> col0_expected;
+    std::vector<types::Float64Value> col1_expected;
+    std::vector<types::Int64Value> col2_expected;
+    for (size_t i = 0; i < CarnotTestUtils::big_test_col1.size(); i++) {
+      if (CarnotTestUtils::big_test_col1[i].val >= start_time &&
+          CarnotTestUtils::big_test_col1[i].val < stop_time) {
+        col0_expected.emplace_back(CarnotTestUtils::big_test_col1[i].val);
+        col1_expected.emplace_back(CarnotTestUtils::big_test_col2[i].val);
+        col2_expected.emplace_back(CarnotTestUtils::big_test_col3[i].val);
+      }
+    }
+
+    auto output_batches = result_server_->query_results("standing_output");
+    ASSERT_EQ(2, output_batches.size());
+    auto rb = output_batches[1];
+    EXPECT_TRUE(
+        rb.ColumnAt(0)->Equals(types::ToArrow(col0_expected, arrow::default_memory_pool())));
+    EXPECT_TRUE(
+        rb.ColumnAt(1)->Equals(types::ToArrow(col1_expected, arrow::default_memory_pool())));
+    EXPECT_TRUE(
+        rb.ColumnAt(2)->Equals(types::ToArrow(col2_expected, arrow::default_memory_pool())));
+  };
+
+  // Sliding windows over the last source row batch (times {8, 9, 11}). The first run builds
+  // and caches the context; the later runs reuse it.
+  run_and_check(8, 12);
+  run_and_check(9, 12);
+  run_and_check(9, 11);
+
+  FLAGS_enable_standing_query_contexts = old_flag;
+}
+
 TEST_F(CarnotTest, empty_range_test) {
   // Tests that a table that has no rows that fall within the query's range, doesn't write any
   // rowbatches to the output table.
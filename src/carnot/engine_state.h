@@ -24,8 +24,13 @@
 #include <utility>
 #include <vector>
 
+#include <absl/base/internal/spinlock.h>
+#include <absl/container/flat_hash_map.h>
+
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/exec/ml/model_pool.h"
+#include "src/carnot/exec/morsel_executor.h"
+#include "src/carnot/exec/task_executor.h"
 #include "src/carnot/funcs/funcs.h"
 #include "src/carnot/plan/plan_state.h"
 #include "src/carnot/planner/compiler_state/compiler_state.h"
@@ -77,7 +82,7 @@ class EngineState : public NotCopyable {
 
   table_store::TableStore* table_store() { return table_store_.get(); }
   std::unique_ptr<exec::ExecState> CreateExecState(const sole::uuid& query_id) {
-    return std::make_unique<exec::ExecState>(
+    auto exec_state = std::make_unique<exec::ExecState>(
         func_registry_.get(), table_store_, stub_generator_,
         [this](const std::string& remote_addr, bool insecure) {
           return MetricsStubGenerator(remote_addr, insecure);
@@ -86,8 +91,24 @@ class EngineState : public NotCopyable {
           return TraceStubGenerator(remote_addr, insecure);
         },
         query_id, model_pool_.get(), grpc_router_, add_auth_to_grpc_context_func_);
+    exec_state->set_task_executor(task_executor_.get());
+    exec_state->set_morsel_executor(morsel_executor_.get());
+    return exec_state;
   }
+  // Channels are pooled per remote and shared across queries: each query's RPCs ride the
+  // persistent connection as multiplexed HTTP/2 streams, so TLS handshakes and connection
+  // setup are not paid per query.
   std::shared_ptr<grpc::Channel> CreateChannel(const std::string& remote_addr, bool insecure) {
+    const std::string cache_key = absl::Substitute("$0:$1", remote_addr, insecure);
+    {
+      absl::base_internal::SpinLockHolder lock(&channel_cache_lock_);
+      auto it = channel_cache_.find(cache_key);
+      if (it != channel_cache_.end() &&
+          it->second->GetState(/* try_to_connect */ false) != GRPC_CHANNEL_SHUTDOWN) {
+        return it->second;
+      }
+    }
+
     grpc::ChannelArguments args;
     args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, 100000);
     args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, 100000);
@@ -95,10 +116,19 @@ class EngineState : public NotCopyable {
     args.SetInt(GRPC_ARG_HTTP2_BDP_PROBE, 1);
     args.SetInt(GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS, 50000);
     args.SetInt(GRPC_ARG_HTTP2_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS, 100000);
+    // A larger HPACK table lets repeated per-stream metadata (notably the auth token sent on
+    // every query's streams) be indexed once per connection instead of re-sent.
+    args.SetInt(GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_ENCODER, 64 * 1024);
+    args.SetInt(GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER, 64 * 1024);
 
     auto channel_creds = insecure ? grpc::InsecureChannelCredentials()
                                   : grpc::SslCredentials(grpc::SslCredentialsOptions());
-    return grpc::CreateCustomChannel(remote_addr, channel_creds, args);
+    auto chan = grpc::CreateCustomChannel(remote_addr, channel_creds, args);
+    {
+      absl::base_internal::SpinLockHolder lock(&channel_cache_lock_);
+      channel_cache_[cache_key] = chan;
+    }
+    return chan;
   }
 
   std::unique_ptr<opentelemetry::proto::collector::metrics::v1::MetricsService::StubInterface>
@@ -145,6 +175,17 @@ class EngineState : public NotCopyable {
   std::function<void(grpc::ClientContext*)> add_auth_to_grpc_context_func_;
   exec::GRPCRouter* grpc_router_ = nullptr;
   std::unique_ptr<exec::ml::ModelPool> model_pool_;
+  // Persistent per-remote channels, shared by the metrics/trace stubs of all queries.
+  absl::base_internal::SpinLock channel_cache_lock_;
+  absl::flat_hash_map<std::string, std::shared_ptr<grpc::Channel>> channel_cache_
+      GUARDED_BY(channel_cache_lock_);
+  // Work-stealing pool shared by all queries on this node for morsel parallelism, compaction,
+  // and other parallel work. Sized to the CPUs available to the agent since queries rarely
+  // overlap their parallel phases.
+  std::unique_ptr<exec::TaskExecutor> task_executor_ =
+      std::make_unique<exec::TaskExecutor>(exec::TaskExecutor::DefaultNumThreads());
+  std::unique_ptr<exec::MorselExecutor> morsel_executor_ =
+      std::make_unique<exec::MorselExecutor>(task_executor_.get());
 };
 
 }  // namespace carnot
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "src/carnot/exec/row_tuple.h"
+#include "src/common/base/base.h"
+#include "src/common/base/mem_utils.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * Serializes the group key columns of a RowTuple (fixed-size values raw, strings
+ * length-prefixed) into the format that GroupKeyDecoder reads back.
+ */
+inline void SerializeGroupKey(const std::vector<types::DataType>& key_types, const RowTuple& rt,
+                              std::string* out) {
+  for (size_t idx = 0; idx < key_types.size(); ++idx) {
+    if (key_types[idx] == types::STRING) {
+      const auto& sv = rt.GetValue<types::StringValue>(idx);
+      uint32_t len = sv.size();
+      out->append(reinterpret_cast<const char*>(&len), sizeof(len));
+      out->append(sv.data(), sv.size());
+    } else {
+      out->append(reinterpret_cast<const char*>(&rt.fixed_values[idx]),
+                  sizeof(types::FixedSizeValueUnion));
+    }
+  }
+}
+
+/**
+ * FlatAggHashTable is a flat, open-addressing hash table for group-by aggregation.
+ *
+ * Group keys are serialized into a per-table arena: fixed-size values are copied inline
+ * (with their FixedSizeValueUnion padding, so the bytes are directly comparable) and
+ * variable-size string values are stored length-prefixed. Slots hold only the key's
+ * arena offset, its hash, and the value, so probing touches a single contiguous array
+ * and inserting a new group costs an arena append instead of heap allocations.
+ *
+ * Lookups are staged through a reusable RowTuple, which callers can keep reusing across
+ * rows and batches since the table never adopts it.
+ *
+ * @tparam TValue The mapped value type. Should be cheap to move (AggNode uses a pointer).
+ */
+template <typename TValue>
+class FlatAggHashTable {
+ public:
+  /**
+   * @param key_types The data types of the group key columns. Must outlive the table.
+   */
+  explicit FlatAggHashTable(const std::vector<types::DataType>* key_types)
+      : key_types_(key_types), slots_(kInitialCapacity) {}
+
+  /**
+   * Finds or inserts the group for the given (fully populated) RowTuple.
+   * Returns a pointer to the value slot, valid until the next FindOrInsert call.
+   * On insert, *inserted is set to true and the value slot is default constructed.
+   */
+  TValue* FindOrInsert(const RowTuple& rt, bool* inserted) {
+    size_t hash = HashKey(rt, &scratch_);
+    return FindOrInsert(scratch_, hash, inserted);
+  }
+
+  /**
+   * Overload taking a key already serialized (and hashed) via HashKey(). Used with
+   * PrefetchSlot() for batched lookups; see HashKey().
+   */
+  TValue* FindOrInsert(const std::string& key, size_t hash, bool* inserted) {
+    if ((size_ + 1) * 8 > slots_.size() * 7) {
+      Grow();
+    }
+
+    size_t mask = slots_.size() - 1;
+    size_t idx = hash & mask;
+    while (slots_[idx].occupied) {
+      if (slots_[idx].hash == hash && KeyEquals(slots_[idx], key)) {
+        *inserted = false;
+        return &slots_[idx].value;
+      }
+      idx = (idx + 1) & mask;
+    }
+
+    slots_[idx].occupied = true;
+    slots_[idx].hash = hash;
+    slots_[idx].key_offset = arena_.size();
+    slots_[idx].key_len = key.size();
+    slots_[idx].value = TValue();
+    arena_.append(key);
+    // Re-hint whenever an append reallocated the arena; large groups' key bytes are re-read
+    // on every probe's memcmp, so they benefit from huge pages just like the slot array.
+    if (arena_.capacity() != hinted_arena_capacity_) {
+      HintHugePages(arena_.data(), arena_.capacity());
+      hinted_arena_capacity_ = arena_.capacity();
+    }
+    ++size_;
+    *inserted = true;
+    return &slots_[idx].value;
+  }
+
+  /**
+   * Finds the group for the given RowTuple without inserting.
+   * Returns nullptr if the group doesn't exist.
+   */
+  TValue* Find(const RowTuple& rt) {
+    size_t hash = HashKey(rt, &scratch_);
+    return Find(scratch_, hash);
+  }
+
+  /**
+   * Overload taking a key already serialized (and hashed) via HashKey().
+   */
+  TValue* Find(const std::string& key, size_t hash) {
+    size_t mask = slots_.size() - 1;
+    size_t idx = hash & mask;
+    while (slots_[idx].occupied) {
+      if (slots_[idx].hash == hash && KeyEquals(slots_[idx], key)) {
+        return &slots_[idx].value;
+      }
+      idx = (idx + 1) & mask;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Serializes the key into *serialized and returns its hash, without touching the slot
+   * array. To process a batch of rows, hash the whole chunk up front with HashKey(), call
+   * PrefetchSlot() a few rows ahead of the lookup loop, and look up with the (key, hash)
+   * overloads: the (likely out-of-cache) slot loads then overlap with the compare work.
+   */
+  size_t HashKey(const RowTuple& rt, std::string* serialized) const {
+    serialized->clear();
+    SerializeKey(rt, serialized);
+    return ::util::Hash64(serialized->data(), serialized->size());
+  }
+
+  /**
+   * Prefetches the home slot of a key with the given hash.
+   */
+  void PrefetchSlot(size_t hash) const {
+    __builtin_prefetch(&slots_[hash & (slots_.size() - 1)], /*rw*/ 0, /*locality*/ 1);
+  }
+
+  /**
+   * Invokes fn(key, value) for every group, where key is a view into the arena that can
+   * be decoded with GroupKeyDecoder.
+   */
+  template <typename TFn>
+  void ForEach(const TFn& fn) const {
+    for (const auto& slot : slots_) {
+      if (slot.occupied) {
+        fn(std::string_view(arena_.data() + slot.key_offset, slot.key_len), slot.value);
+      }
+    }
+  }
+
+  void Clear() {
+    slots_.assign(kInitialCapacity, Slot{});
+    arena_.clear();
+    hinted_arena_capacity_ = 0;
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+
+  // Arena plus slot array footprint, for memory accounting.
+  size_t ConsumedBytes() const { return arena_.capacity() + slots_.size() * sizeof(Slot); }
+
+ private:
+  static constexpr size_t kInitialCapacity = 64;
+
+  struct Slot {
+    size_t hash = 0;
+    size_t key_offset = 0;
+    uint32_t key_len = 0;
+    bool occupied = false;
+    TValue value{};
+  };
+
+  void SerializeKey(const RowTuple& rt, std::string* out) const {
+    SerializeGroupKey(*key_types_, rt, out);
+  }
+
+  bool KeyEquals(const Slot& slot, const std::string& key) const {
+    return slot.key_len == key.size() &&
+           memcmp(arena_.data() + slot.key_offset, key.data(), key.size()) == 0;
+  }
+
+  void Grow() {
+    std::vector<Slot> old_slots(slots_.size() * 2);
+    old_slots.swap(slots_);
+    // Once the slot array outgrows a huge page, random probes touch a TLB entry per probe;
+    // huge pages cut that to one entry per 2MB. No-op below that size and when THP is off.
+    HintHugePages(slots_.data(), slots_.size() * sizeof(Slot));
+    size_t mask = slots_.size() - 1;
+    for (auto& slot : old_slots) {
+      if (!slot.occupied) {
+        continue;
+      }
+      size_t idx = slot.hash & mask;
+      while (slots_[idx].occupied) {
+        idx = (idx + 1) & mask;
+      }
+      slots_[idx] = std::move(slot);
+    }
+  }
+
+  const std::vector<types::DataType>* key_types_;
+  std::vector<Slot> slots_;
+  std::string arena_;
+  std::string scratch_;
+  // Arena capacity at the last huge-page hint; avoids redundant madvise calls.
+  size_t hinted_arena_capacity_ = 0;
+  size_t size_ = 0;
+};
+
+/**
+ * GroupKeyDecoder reads individual column values back out of a serialized group key.
+ * Reset() walks the key once to record per-column offsets, so GetValue is O(1).
+ */
+class GroupKeyDecoder {
+ public:
+  explicit GroupKeyDecoder(const std::vector<types::DataType>* key_types)
+      : key_types_(key_types) {}
+
+  void Reset(std::string_view key) {
+    key_ = key;
+    offsets_.clear();
+    size_t pos = 0;
+    for (const auto& dt : *key_types_) {
+      offsets_.push_back(pos);
+      if (dt == types::STRING) {
+        uint32_t len;
+        DCHECK_LE(pos + sizeof(len), key.size());
+        memcpy(&len, key.data() + pos, sizeof(len));
+        pos += sizeof(len) + len;
+      } else {
+        pos += sizeof(types::FixedSizeValueUnion);
+      }
+    }
+    DCHECK_EQ(pos, key.size());
+  }
+
+  template <typename T>
+  T GetValue(size_t idx) const {
+    static_assert(types::ValueTypeTraits<T>::is_fixed_size, "Only fixed size values allowed");
+    DCHECK_EQ(types::ValueTypeTraits<T>::data_type, key_types_->at(idx));
+    types::FixedSizeValueUnion u;
+    memcpy(&u, key_.data() + offsets_[idx], sizeof(u));
+    return types::Get<T>(u);
+  }
+
+ private:
+  const std::vector<types::DataType>* key_types_;
+  std::string_view key_;
+  std::vector<size_t> offsets_;
+};
+
+template <>
+inline types::StringValue GroupKeyDecoder::GetValue<types::StringValue>(size_t idx) const {
+  DCHECK_EQ(types::STRING, key_types_->at(idx));
+  uint32_t len;
+  memcpy(&len, key_.data() + offsets_[idx], sizeof(len));
+  return types::StringValue(std::string(key_.substr(offsets_[idx] + sizeof(len), len)));
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -23,6 +23,9 @@
 #include <arrow/status.h>
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
 
 #include <magic_enum.hpp>
 
@@ -55,11 +58,11 @@ void ExtractIntoGroupArgs(std::vector<GroupArgs>* group_args, arrow::Array* col,
 }
 
 template <types::DataType DT>
-void AppendToBuilder(arrow::ArrayBuilder* builder, RowTuple* rt, size_t rt_idx) {
+void AppendKeyToBuilder(arrow::ArrayBuilder* builder, const GroupKeyDecoder& decoder, size_t idx) {
   using ArrowBuilder = typename types::DataTypeTraits<DT>::arrow_builder_type;
   using ValueType = typename types::DataTypeTraits<DT>::value_type;
   auto status =
-      static_cast<ArrowBuilder*>(builder)->Append(udf::UnWrap(rt->GetValue<ValueType>(rt_idx)));
+      static_cast<ArrowBuilder*>(builder)->Append(udf::UnWrap(decoder.GetValue<ValueType>(idx)));
   PL_DCHECK_OK(status);
   PL_UNUSED(status);
 }
@@ -71,13 +74,72 @@ void ExtractToColumnWrapper(const std::vector<GroupArgs>& group_args,
   size_t num_rows = rb.num_rows();
   DCHECK(num_rows <= group_args.size());
   for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
-    DCHECK(group_args[row_idx].av != nullptr);
+    if (group_args[row_idx].av == nullptr) {
+      // Overflow row; it has been routed to the spill file.
+      continue;
+    }
     auto col_wrapper = group_args[row_idx].av->agg_cols[col_idx].get();
     auto arr = rb.ColumnAt(rb_col_idx).get();
     types::ExtractValueToColumnWrapper<DT>(col_wrapper, arr, row_idx);
   }
 }
 
+// Partial aggregate states travel between agents concatenated in one binary column
+// value; each UDA's state is framed with a 4-byte length prefix. The prefix is written
+// in host byte order; all supported targets are little-endian.
+void AppendFramedState(std::string_view state, std::string* out) {
+  auto len = static_cast<uint32_t>(state.size());
+  out->append(reinterpret_cast<const char*>(&len), sizeof(len));
+  out->append(state.data(), state.size());
+}
+
+StatusOr<std::string_view> ConsumeFramedState(std::string_view* data) {
+  uint32_t len;
+  if (data->size() < sizeof(len)) {
+    return error::InvalidArgument("Malformed serialized aggregate state");
+  }
+  std::memcpy(&len, data->data(), sizeof(len));
+  data->remove_prefix(sizeof(len));
+  if (data->size() < len) {
+    return error::InvalidArgument("Malformed serialized aggregate state");
+  }
+  auto state = data->substr(0, len);
+  data->remove_prefix(len);
+  return state;
+}
+
+// Maps a UDA name onto its vectorized fast-path kind. Returns false for UDAs without one.
+bool VectorizedAggKind(const std::string& name, VectorizedAggAcc::Kind* kind) {
+  if (name == "count") {
+    *kind = VectorizedAggAcc::Kind::kCount;
+  } else if (name == "sum") {
+    *kind = VectorizedAggAcc::Kind::kSum;
+  } else if (name == "mean") {
+    *kind = VectorizedAggAcc::Kind::kMean;
+  } else if (name == "min") {
+    *kind = VectorizedAggAcc::Kind::kMin;
+  } else if (name == "max") {
+    *kind = VectorizedAggAcc::Kind::kMax;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// The output type the fast path produces for a given kind and argument type. Detection
+// requires this to match the planned output column type, so a registry whose UDA returns
+// something else falls back to the UDA path.
+types::DataType VectorizedAggOutputType(VectorizedAggAcc::Kind kind, types::DataType arg_type) {
+  switch (kind) {
+    case VectorizedAggAcc::Kind::kCount:
+      return types::DataType::INT64;
+    case VectorizedAggAcc::Kind::kMean:
+      return types::DataType::FLOAT64;
+    default:
+      return arg_type;
+  }
+}
+
 }  // namespace
 
 std::string AggNode::DebugStringImpl() {
@@ -106,12 +168,18 @@ Status AggNode::InitImpl(const plan::Operator& plan_node) {
     }
   }
 
-  size_t output_size = plan_node_->values().size() + plan_node_->groups().size();
+  is_partial_agg_ = plan_node_->partial_agg() && !plan_node_->finalize_results();
+  is_finalize_agg_ = plan_node_->finalize_results() && !plan_node_->partial_agg();
+
+  // A partial aggregate replaces the value columns with a single serialized-state column.
+  size_t output_size = is_partial_agg_ ? plan_node_->groups().size() + 1
+                                       : plan_node_->values().size() + plan_node_->groups().size();
   if (output_size != output_descriptor_->size()) {
     return error::InvalidArgument("Output size mismatch in aggregate");
   }
 
   if (HasNoGroups()) {
+    SetupVectorizedAggs();
     return Status::OK();
   }
 
@@ -128,13 +196,20 @@ Status AggNode::InitImpl(const plan::Operator& plan_node) {
     group_data_types_.emplace_back(input_descriptor_->type(group.idx));
   }
 
-  auto values_size = plan_node_->values().size();
-  for (size_t i = 0; i < values_size; ++i) {
-    auto values_idx = i + groups_size;
-    DCHECK(values_idx < output_descriptor_->size());
-    value_data_types_.emplace_back(output_descriptor_->type(values_idx));
+  if (!is_partial_agg_) {
+    auto values_size = plan_node_->values().size();
+    for (size_t i = 0; i < values_size; ++i) {
+      auto values_idx = i + groups_size;
+      DCHECK(values_idx < output_descriptor_->size());
+      value_data_types_.emplace_back(output_descriptor_->type(values_idx));
+    }
   }
 
+  if (is_finalize_agg_) {
+    // The value expressions reference the pre-split input schema, which doesn't exist
+    // here: the input is the groups plus the serialized-state column.
+    return Status::OK();
+  }
   return CreateColumnMapping();
 }
 
@@ -144,9 +219,15 @@ Status AggNode::PrepareImpl(ExecState* exec_state) {
 }
 
 Status AggNode::OpenImpl(ExecState* exec_state) {
-  if (HasNoGroups()) {
+  if (HasNoGroups() && !use_vectorized_agg_) {
     PL_RETURN_IF_ERROR(CreateUDAInfoValues(&udas_no_groups_, exec_state));
   }
+  for (auto& acc : vectorized_aggs_) {
+    acc.Reset();
+  }
+  if (is_finalize_agg_) {
+    PL_RETURN_IF_ERROR(CreateUDAInfoValues(&scratch_udas_, exec_state));
+  }
   return Status::OK();
 }
 
@@ -158,8 +239,14 @@ Status AggNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_
 }
 
 Status AggNode::CloseImpl(ExecState*) {
+  stats()->AddExtraMetric("spilled_batches", spilled_batches_);
+  stats()->AddExtraMetric("spilled_bytes", spilled_bytes_);
+  stats()->AddExtraMetric("peak_buffered_bytes", peak_buffered_bytes_);
+
   udas_no_groups_.clear();
+  scratch_udas_.clear();
   group_args_chunk_.clear();
+  agg_hash_table_.Clear();
   group_args_pool_.Clear();
   udas_pool_.Clear();
 
@@ -171,32 +258,59 @@ bool AggNode::ReadyToEmitBatches(const RowBatch& rb) const {
 }
 
 Status AggNode::ClearAggState(ExecState* exec_state) {
-  if (HasNoGroups()) {
+  if (HasNoGroups() && !use_vectorized_agg_) {
     udas_no_groups_.clear();
     PL_RETURN_IF_ERROR(CreateUDAInfoValues(&udas_no_groups_, exec_state));
   }
-  agg_hash_map_.clear();
+  for (auto& acc : vectorized_aggs_) {
+    acc.Reset();
+  }
+  agg_hash_table_.Clear();
   return Status::OK();
 }
 
 Status AggNode::AggregateGroupByNone(ExecState* exec_state, const RowBatch& rb) {
   auto values = plan_node_->values();
-  for (size_t i = 0; i < values.size(); ++i) {
-    PL_RETURN_IF_ERROR(
-        EvaluateSingleExpressionNoGroups(exec_state, udas_no_groups_[i], values[i].get(), rb));
+  if (is_finalize_agg_) {
+    // The input is a single column of serialized partial states; merge each row into the
+    // running UDAs.
+    auto* serialized_col = rb.ColumnAt(0).get();
+    for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+      PL_RETURN_IF_ERROR(MergeSerializedRow(
+          types::GetStringViewFromArrowArray(serialized_col, row_idx), &udas_no_groups_));
+    }
+  } else if (use_vectorized_agg_) {
+    PL_RETURN_IF_ERROR(UpdateVectorizedAggs(rb));
+  } else {
+    for (size_t i = 0; i < values.size(); ++i) {
+      PL_RETURN_IF_ERROR(
+          EvaluateSingleExpressionNoGroups(exec_state, udas_no_groups_[i], values[i].get(), rb));
+    }
   }
 
   if (ReadyToEmitBatches(rb)) {
     RowBatch output_rb(*output_descriptor_, 1);
-    for (size_t i = 0; i < values.size(); ++i) {
-      const auto& uda_info = udas_no_groups_[i];
-      auto builder = types::MakeArrowBuilder(uda_info.def->finalize_return_type(),
-                                             exec_state->exec_mem_pool());
-      PL_RETURN_IF_ERROR(
-          uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(), builder.get()));
+    if (use_vectorized_agg_) {
+      PL_RETURN_IF_ERROR(FinalizeVectorizedAggs(exec_state, &output_rb));
+    } else if (is_partial_agg_) {
+      std::string serialized;
+      PL_RETURN_IF_ERROR(SerializeUDAStates(udas_no_groups_, &serialized));
+      auto builder = types::MakeArrowBuilder(types::STRING, exec_state->exec_mem_pool());
+      PL_RETURN_IF_ERROR(static_cast<arrow::StringBuilder*>(builder.get())->Append(serialized));
       SharedArray out_col;
       PL_RETURN_IF_ERROR(builder->Finish(&out_col));
       PL_RETURN_IF_ERROR(output_rb.AddColumn(out_col));
+    } else {
+      for (size_t i = 0; i < values.size(); ++i) {
+        const auto& uda_info = udas_no_groups_[i];
+        auto builder = types::MakeArrowBuilder(uda_info.def->finalize_return_type(),
+                                               exec_state->exec_mem_pool());
+        PL_RETURN_IF_ERROR(
+            uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(), builder.get()));
+        SharedArray out_col;
+        PL_RETURN_IF_ERROR(builder->Finish(&out_col));
+        PL_RETURN_IF_ERROR(output_rb.AddColumn(out_col));
+      }
     }
     output_rb.set_eow(rb.eow());
     output_rb.set_eos(rb.eos());
@@ -206,6 +320,175 @@ Status AggNode::AggregateGroupByNone(ExecState* exec_state, const RowBatch& rb)
   return Status::OK();
 }
 
+void AggNode::SetupVectorizedAggs() {
+  if (is_partial_agg_ || is_finalize_agg_ || plan_node_->values().empty()) {
+    return;
+  }
+  std::vector<VectorizedAggAcc> accs;
+  for (size_t i = 0; i < plan_node_->values().size(); ++i) {
+    const auto& agg = *plan_node_->values()[i];
+    VectorizedAggAcc acc;
+    if (!VectorizedAggKind(agg.name(), &acc.kind) || !agg.init_arguments().empty()) {
+      return;
+    }
+    const auto& args = agg.arg_deps();
+    if (args.size() != 1 || args[0]->ExpressionType() != plan::Expression::kColumn) {
+      return;
+    }
+    acc.col_idx = static_cast<const plan::Column*>(args[0].get())->Index();
+    if (acc.col_idx >= static_cast<int64_t>(input_descriptor_->size())) {
+      return;
+    }
+    acc.arg_type = input_descriptor_->type(acc.col_idx);
+    // count only needs the row count, so any argument type works; the others reduce the raw
+    // value buffer and need a numeric column.
+    if (acc.kind != VectorizedAggAcc::Kind::kCount && acc.arg_type != types::DataType::INT64 &&
+        acc.arg_type != types::DataType::FLOAT64) {
+      return;
+    }
+    if (output_descriptor_->type(i) != VectorizedAggOutputType(acc.kind, acc.arg_type)) {
+      return;
+    }
+    acc.Reset();
+    accs.push_back(acc);
+  }
+  vectorized_aggs_ = std::move(accs);
+  use_vectorized_agg_ = true;
+}
+
+Status AggNode::UpdateVectorizedAggs(const RowBatch& rb) {
+  const int64_t num_rows = rb.num_rows();
+  if (num_rows == 0) {
+    return Status::OK();
+  }
+  for (auto& acc : vectorized_aggs_) {
+    acc.count += num_rows;
+    if (acc.kind == VectorizedAggAcc::Kind::kCount) {
+      continue;
+    }
+    const auto& col = *rb.ColumnAt(acc.col_idx);
+    if (acc.arg_type == types::DataType::INT64) {
+      const int64_t* vals = static_cast<const arrow::Int64Array&>(col).raw_values();
+      switch (acc.kind) {
+        case VectorizedAggAcc::Kind::kSum: {
+          int64_t sum = 0;
+          for (int64_t i = 0; i < num_rows; ++i) {
+            sum += vals[i];
+          }
+          acc.sum_int += sum;
+          break;
+        }
+        case VectorizedAggAcc::Kind::kMean: {
+          double sum = acc.sum_float;
+          for (int64_t i = 0; i < num_rows; ++i) {
+            sum += static_cast<double>(vals[i]);
+          }
+          acc.sum_float = sum;
+          break;
+        }
+        case VectorizedAggAcc::Kind::kMin: {
+          int64_t min = acc.extreme_int;
+          for (int64_t i = 0; i < num_rows; ++i) {
+            min = std::min(min, vals[i]);
+          }
+          acc.extreme_int = min;
+          break;
+        }
+        case VectorizedAggAcc::Kind::kMax: {
+          int64_t max = acc.extreme_int;
+          for (int64_t i = 0; i < num_rows; ++i) {
+            max = std::max(max, vals[i]);
+          }
+          acc.extreme_int = max;
+          break;
+        }
+        case VectorizedAggAcc::Kind::kCount:
+          break;
+      }
+    } else {
+      DCHECK(acc.arg_type == types::DataType::FLOAT64);
+      const double* vals = static_cast<const arrow::DoubleArray&>(col).raw_values();
+      switch (acc.kind) {
+        case VectorizedAggAcc::Kind::kSum:
+        case VectorizedAggAcc::Kind::kMean: {
+          double sum = acc.sum_float;
+          for (int64_t i = 0; i < num_rows; ++i) {
+            sum += vals[i];
+          }
+          acc.sum_float = sum;
+          break;
+        }
+        // The explicit comparisons mirror the builtin UDAs, so NaNs are skipped the same way
+        // (comparisons with NaN are false, keeping the current extreme).
+        case VectorizedAggAcc::Kind::kMin: {
+          double min = acc.extreme_float;
+          for (int64_t i = 0; i < num_rows; ++i) {
+            if (vals[i] < min) {
+              min = vals[i];
+            }
+          }
+          acc.extreme_float = min;
+          break;
+        }
+        case VectorizedAggAcc::Kind::kMax: {
+          double max = acc.extreme_float;
+          for (int64_t i = 0; i < num_rows; ++i) {
+            if (vals[i] > max) {
+              max = vals[i];
+            }
+          }
+          acc.extreme_float = max;
+          break;
+        }
+        case VectorizedAggAcc::Kind::kCount:
+          break;
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status AggNode::FinalizeVectorizedAggs(ExecState* exec_state, RowBatch* output_rb) {
+  for (const auto& acc : vectorized_aggs_) {
+    auto out_type = VectorizedAggOutputType(acc.kind, acc.arg_type);
+    auto builder = types::MakeArrowBuilder(out_type, exec_state->exec_mem_pool());
+    if (out_type == types::DataType::INT64) {
+      int64_t val = 0;
+      switch (acc.kind) {
+        case VectorizedAggAcc::Kind::kCount:
+          val = acc.count;
+          break;
+        case VectorizedAggAcc::Kind::kSum:
+          val = acc.sum_int;
+          break;
+        default:
+          val = acc.extreme_int;
+          break;
+      }
+      PL_RETURN_IF_ERROR(static_cast<arrow::Int64Builder*>(builder.get())->Append(val));
+    } else {
+      double val = 0;
+      switch (acc.kind) {
+        case VectorizedAggAcc::Kind::kSum:
+          val = acc.sum_float;
+          break;
+        case VectorizedAggAcc::Kind::kMean:
+          // Matches MeanUDA: an empty input divides zero by zero and yields NaN.
+          val = acc.sum_float / static_cast<double>(acc.count);
+          break;
+        default:
+          val = acc.extreme_float;
+          break;
+      }
+      PL_RETURN_IF_ERROR(static_cast<arrow::DoubleBuilder*>(builder.get())->Append(val));
+    }
+    SharedArray out_col;
+    PL_RETURN_IF_ERROR(builder->Finish(&out_col));
+    PL_RETURN_IF_ERROR(output_rb->AddColumn(out_col));
+  }
+  return Status::OK();
+}
+
 Status AggNode::ExtractRowTupleForBatch(const RowBatch& rb) {
   // Grow the group_args_chunk_ to be the size of the RowBatch.
   size_t num_rows = rb.num_rows();
@@ -236,23 +519,60 @@ Status AggNode::HashRowBatch(ExecState* exec_state, const RowBatch& rb) {
   PL_UNUSED(exec_state);
   // Loop through all the row and basically store the values into column chunk based on which
   // group they belong to.
+  overflow_rows_.clear();
+  // Once the table is over budget, existing groups keep aggregating in memory but rows
+  // with unseen keys are routed to the spill file for a later pass. An empty table is
+  // never considered over budget so that every pass absorbs at least one batch of new
+  // groups, guaranteeing the spill-processing loop makes progress.
+  peak_buffered_bytes_ = std::max(peak_buffered_bytes_, agg_hash_table_.ConsumedBytes());
+  const bool over_budget = spill_threshold_bytes_ != 0 && agg_hash_table_.size() > 0 &&
+                           agg_hash_table_.ConsumedBytes() > spill_threshold_bytes_;
+
+  // Serialize and hash the whole chunk up front, so the lookup loop below can prefetch each
+  // row's hash table slot a few rows ahead: the slot loads (likely TLB/cache misses on large
+  // tables) are then in flight while earlier rows are still being compared.
+  constexpr int64_t kSlotPrefetchDistance = 8;
+  if (static_cast<int64_t>(serialized_keys_chunk_.size()) < rb.num_rows()) {
+    serialized_keys_chunk_.resize(rb.num_rows());
+    key_hashes_chunk_.resize(rb.num_rows());
+  }
   for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+    key_hashes_chunk_[row_idx] =
+        agg_hash_table_.HashKey(*group_args_chunk_[row_idx].rt, &serialized_keys_chunk_[row_idx]);
+    if (row_idx < kSlotPrefetchDistance) {
+      agg_hash_table_.PrefetchSlot(key_hashes_chunk_[row_idx]);
+    }
+  }
+
+  for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+    if (row_idx + kSlotPrefetchDistance < rb.num_rows()) {
+      agg_hash_table_.PrefetchSlot(key_hashes_chunk_[row_idx + kSlotPrefetchDistance]);
+    }
     auto& ga = group_args_chunk_[row_idx];
-    AggHashValue* val = nullptr;
-    // Check to see if in hash
-    // TODO(zasgar): Change this to upsert.
-    auto it = agg_hash_map_.find(ga.rt);
-    // If not in hash then insert
-    if (it == agg_hash_map_.end()) {
-      // Create a val array.
-      val = CreateAggHashValue(exec_state);
-      agg_hash_map_[ga.rt] = val;
-      // We have inserted this, so the stored RowTuple is now in the table.
-      ga.rt = nullptr;
-    } else {
-      val = it->second;
+    if (over_budget) {
+      AggHashValue** slot =
+          agg_hash_table_.Find(serialized_keys_chunk_[row_idx], key_hashes_chunk_[row_idx]);
+      if (slot == nullptr) {
+        ga.av = nullptr;
+        overflow_rows_.push_back(row_idx);
+        continue;
+      }
+      ga.av = *slot;
+      continue;
+    }
+    bool inserted = false;
+    AggHashValue** slot = agg_hash_table_.FindOrInsert(serialized_keys_chunk_[row_idx],
+                                                       key_hashes_chunk_[row_idx], &inserted);
+    if (inserted) {
+      *slot = CreateAggHashValue(exec_state);
     }
-    ga.av = val;
+    // The table serializes the key into its arena, so the staged RowTuple stays with the
+    // chunk and is reused for the next batch.
+    ga.av = *slot;
+  }
+
+  if (!overflow_rows_.empty()) {
+    PL_RETURN_IF_ERROR(SpillOverflowRows(exec_state, rb));
   }
 
   auto values = plan_node_->values();
@@ -277,7 +597,10 @@ Status AggNode::EvaluatePartialAggregates(ExecState* exec_state, size_t num_reco
   for (size_t i = 0; i < num_records; ++i) {
     DCHECK(i < group_args_chunk_.size());
     auto& ga = group_args_chunk_[i];
-    DCHECK(ga.av != nullptr);
+    if (ga.av == nullptr) {
+      // Overflow row; it has been routed to the spill file.
+      continue;
+    }
     if (ga.av->agg_cols[0]->Size() > kAggCompactionThreshold) {
       PL_RETURN_IF_ERROR(EvaluateAggHashValue(exec_state, ga.av));
     }
@@ -308,30 +631,59 @@ Status AggNode::ConvertAggHashMapToRowBatch(ExecState* exec_state, RowBatch* out
     group_builders.push_back(types::MakeArrowBuilder(group_dt, exec_state->exec_mem_pool()));
   }
   std::vector<std::unique_ptr<arrow::ArrayBuilder>> value_builders;
-  for (const auto& value_data_type : value_data_types_) {
-    value_builders.push_back(types::MakeArrowBuilder(value_data_type, exec_state->exec_mem_pool()));
+  if (is_partial_agg_) {
+    // Partial aggregates emit one serialized-state column in place of the value columns.
+    value_builders.push_back(types::MakeArrowBuilder(types::STRING, exec_state->exec_mem_pool()));
+  } else {
+    for (const auto& value_data_type : value_data_types_) {
+      value_builders.push_back(
+          types::MakeArrowBuilder(value_data_type, exec_state->exec_mem_pool()));
+    }
   }
 
   // Agg into agg values and emit!
-  for (const auto& kv : agg_hash_map_) {
-    auto* groups_rt = kv.first;
-    auto* val = kv.second;
-
+  GroupKeyDecoder decoder(&group_data_types_);
+  Status emit_status;
+  agg_hash_table_.ForEach([&](std::string_view key, AggHashValue* val) {
+    if (!emit_status.ok()) {
+      return;
+    }
+    decoder.Reset(key);
     for (size_t i = 0; i < group_data_types_.size(); ++i) {
       DCHECK(i < group_builders.size());
 
-#define TYPE_CASE(_dt_) AppendToBuilder<_dt_>(group_builders[i].get(), groups_rt, i);
+#define TYPE_CASE(_dt_) AppendKeyToBuilder<_dt_>(group_builders[i].get(), decoder, i);
       PL_SWITCH_FOREACH_DATATYPE(group_data_types_[i], TYPE_CASE);
 #undef TYPE_CASE
     }
-    // Actually Finalize the UDA based on the column wrapper chunks.
-    PL_RETURN_IF_ERROR(EvaluateAggHashValue(exec_state, val));
+    // Flush the buffered column chunks into the UDAs. A finalize aggregate merges states
+    // as rows arrive, so it has nothing buffered.
+    if (!is_finalize_agg_) {
+      emit_status = EvaluateAggHashValue(exec_state, val);
+      if (!emit_status.ok()) {
+        return;
+      }
+    }
+    if (is_partial_agg_) {
+      std::string serialized;
+      emit_status = SerializeUDAStates(val->udas, &serialized);
+      if (!emit_status.ok()) {
+        return;
+      }
+      emit_status = StatusAdapter(
+          static_cast<arrow::StringBuilder*>(value_builders[0].get())->Append(serialized));
+      return;
+    }
     for (size_t i = 0; i < val->udas.size(); ++i) {
       const auto& uda_info = val->udas[i];
-      PL_RETURN_IF_ERROR(uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(),
-                                                     value_builders[i].get()));
+      emit_status = uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(),
+                                                value_builders[i].get());
+      if (!emit_status.ok()) {
+        return;
+      }
     }
-  }
+  });
+  PL_RETURN_IF_ERROR(emit_status);
 
   for (const auto& group_builder : group_builders) {
     std::shared_ptr<arrow::Array> arr;
@@ -359,17 +711,75 @@ Status AggNode::AggregateGroupByClause(ExecState* exec_state, const RowBatch& rb
   // 5. If it's the last batch then emit the values.
   PL_RETURN_IF_ERROR(ExtractRowTupleForBatch(rb));
   PL_RETURN_IF_ERROR(HashRowBatch(exec_state, rb));
-  if (plan_node_->values().size() > 0) {
+  if (is_finalize_agg_) {
+    PL_RETURN_IF_ERROR(MergeSerializedStates(exec_state, rb));
+  } else if (plan_node_->values().size() > 0) {
     PL_RETURN_IF_ERROR(EvaluatePartialAggregates(exec_state, rb.num_rows()));
   }
   PL_RETURN_IF_ERROR(ResetGroupArgs());
   if (ReadyToEmitBatches(rb)) {
-    RowBatch output_rb(*output_descriptor_, agg_hash_map_.size());
-    PL_RETURN_IF_ERROR(ConvertAggHashMapToRowBatch(exec_state, &output_rb));
-    output_rb.set_eow(rb.eow());
-    output_rb.set_eos(rb.eos());
-    PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
-    PL_RETURN_IF_ERROR(ClearAggState(exec_state));
+    // Emit the in-memory groups, then aggregate any spilled partitions one pass at a
+    // time. Reprocessing may spill again; each pass bounds its in-memory group count the
+    // same way, so this loop terminates with bounded memory regardless of cardinality.
+    while (true) {
+      auto spill_file = std::move(spill_file_);
+      bool more_passes = spill_file != nullptr && spill_file->num_batches() > 0;
+      RowBatch output_rb(*output_descriptor_, agg_hash_table_.size());
+      PL_RETURN_IF_ERROR(ConvertAggHashMapToRowBatch(exec_state, &output_rb));
+      output_rb.set_eow(rb.eow() && !more_passes);
+      output_rb.set_eos(rb.eos() && !more_passes);
+      PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
+      PL_RETURN_IF_ERROR(ClearAggState(exec_state));
+      if (!more_passes) {
+        break;
+      }
+      PL_RETURN_IF_ERROR(ProcessSpilledBatches(exec_state, spill_file.get()));
+    }
+  }
+  return Status::OK();
+}
+
+Status AggNode::SpillOverflowRows(ExecState* exec_state, const RowBatch& rb) {
+  if (spill_file_ == nullptr) {
+    PL_ASSIGN_OR_RETURN(spill_file_, SpilledRowBatchFile::Create());
+  }
+
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+  for (size_t col_idx = 0; col_idx < input_descriptor_->size(); ++col_idx) {
+    builders.push_back(
+        types::MakeArrowBuilder(input_descriptor_->type(col_idx), exec_state->exec_mem_pool()));
+    PL_RETURN_IF_ERROR(builders.back()->Reserve(overflow_rows_.size()));
+  }
+  for (size_t col_idx = 0; col_idx < input_descriptor_->size(); ++col_idx) {
+    auto arr = rb.ColumnAt(col_idx).get();
+    for (int64_t row_idx : overflow_rows_) {
+#define TYPE_CASE(_dt_)                              PL_RETURN_IF_ERROR(table_store::schema::CopyValue<_dt_>(       builders[col_idx].get(), types::GetValueFromArrowArray<_dt_>(arr, row_idx)));
+      PL_SWITCH_FOREACH_DATATYPE(input_descriptor_->type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+    }
+  }
+  PL_ASSIGN_OR_RETURN(auto overflow_rb, RowBatch::FromColumnBuilders(
+                                            *input_descriptor_, /* eow */ false, /* eos */ false,
+                                            &builders));
+  const size_t prev_bytes_written = spill_file_->bytes_written();
+  PL_RETURN_IF_ERROR(spill_file_->Write(*overflow_rb));
+  ++spilled_batches_;
+  spilled_bytes_ += spill_file_->bytes_written() - prev_bytes_written;
+  return Status::OK();
+}
+
+Status AggNode::ProcessSpilledBatches(ExecState* exec_state, SpilledRowBatchFile* spill_file) {
+  PL_RETURN_IF_ERROR(spill_file->StartRead());
+  while (spill_file->HasNext()) {
+    PL_ASSIGN_OR_RETURN(auto spilled_rb, spill_file->ReadNext());
+    PL_RETURN_IF_ERROR(ExtractRowTupleForBatch(*spilled_rb));
+    PL_RETURN_IF_ERROR(HashRowBatch(exec_state, *spilled_rb));
+    if (is_finalize_agg_) {
+      PL_RETURN_IF_ERROR(MergeSerializedStates(exec_state, *spilled_rb));
+    } else if (plan_node_->values().size() > 0) {
+      PL_RETURN_IF_ERROR(EvaluatePartialAggregates(exec_state, spilled_rb->num_rows()));
+    }
+    PL_RETURN_IF_ERROR(ResetGroupArgs());
   }
   return Status::OK();
 }
@@ -480,6 +890,46 @@ Status AggNode::EvaluateAggHashValue(ExecState* exec_state, AggHashValue* val) {
   return Status::OK();
 }
 
+Status AggNode::SerializeUDAStates(const std::vector<UDAInfo>& udas, std::string* out) {
+  for (const auto& uda_info : udas) {
+    PL_ASSIGN_OR_RETURN(types::StringValue state,
+                        uda_info.def->Serialize(uda_info.uda.get(), function_ctx_.get()));
+    AppendFramedState(state, out);
+  }
+  return Status::OK();
+}
+
+Status AggNode::MergeSerializedRow(std::string_view data, std::vector<UDAInfo>* udas) {
+  DCHECK_EQ(udas->size(), scratch_udas_.size());
+  for (size_t i = 0; i < udas->size(); ++i) {
+    PL_ASSIGN_OR_RETURN(auto state, ConsumeFramedState(&data));
+    auto& scratch = scratch_udas_[i];
+    PL_RETURN_IF_ERROR(scratch.def->Deserialize(scratch.uda.get(), function_ctx_.get(),
+                                                types::StringValue(std::string(state))));
+    auto& uda_info = (*udas)[i];
+    PL_RETURN_IF_ERROR(
+        uda_info.def->Merge(uda_info.uda.get(), scratch.uda.get(), function_ctx_.get()));
+  }
+  if (!data.empty()) {
+    return error::InvalidArgument("Trailing bytes in serialized aggregate state");
+  }
+  return Status::OK();
+}
+
+Status AggNode::MergeSerializedStates(ExecState*, const RowBatch& rb) {
+  auto* serialized_col = rb.ColumnAt(plan_node_->groups().size()).get();
+  for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+    auto& ga = group_args_chunk_[row_idx];
+    if (ga.av == nullptr) {
+      // Overflow row; it has been routed to the spill file.
+      continue;
+    }
+    PL_RETURN_IF_ERROR(MergeSerializedRow(
+        types::GetStringViewFromArrowArray(serialized_col, row_idx), &ga.av->udas));
+  }
+  return Status::OK();
+}
+
 Status AggNode::CreateColumnMapping() {
   for (const auto& expr : plan_node_->values()) {
     plan::ExpressionWalker<int> walker;
@@ -520,11 +970,15 @@ Status AggNode::CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_s
   CHECK_EQ(val->size(), 0ULL);
 
   for (const auto& value : plan_node_->values()) {
-    std::vector<types::DataType> types;
-    types.reserve(value->Deps().size());
-    for (auto* dep : value->Deps()) {
-      PL_ASSIGN_OR_RETURN(auto type, GetTypeOfDep(*dep));
-      types.push_back(type);
+    if (!is_finalize_agg_) {
+      // The deps of a finalize aggregate's expressions index the pre-split input schema,
+      // so they can't be resolved against our input descriptor.
+      std::vector<types::DataType> types;
+      types.reserve(value->Deps().size());
+      for (auto* dep : value->Deps()) {
+        PL_ASSIGN_OR_RETURN(auto type, GetTypeOfDep(*dep));
+        types.push_back(type);
+      }
     }
     auto def = exec_state->GetUDADefinition(value->uda_id());
     auto uda = def->Make();
@@ -18,15 +18,18 @@
 
 #pragma once
 #include <cstddef>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "src/carnot/exec/agg_hash_table.h"
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/exec/expression_evaluator.h"
+#include "src/carnot/exec/row_batch_spill.h"
 #include "src/carnot/exec/row_tuple.h"
 #include "src/carnot/plan/operators.h"
 #include "src/carnot/plan/scalar_expression.h"
@@ -63,13 +66,49 @@ struct GroupArgs {
   AggHashValue* av;
 };
 
-class AggNode : public ProcessingNode {
-  using AggHashMap = AbslRowTupleHashMap<AggHashValue*>;
+// Accumulator for the vectorized no-groups fast path: count/sum/mean/min/max over a single
+// numeric column are reduced with tight loops over the raw arrow value buffer instead of one
+// virtual UDA update call per row. The accumulator mirrors the corresponding builtin UDA's
+// state exactly (including its seed values), so the fast path produces bit-identical results.
+struct VectorizedAggAcc {
+  enum class Kind { kCount, kSum, kMean, kMin, kMax };
+
+  Kind kind;
+  // Index of the argument column in the input row batch. Unused for kCount.
+  int64_t col_idx = -1;
+  types::DataType arg_type = types::DATA_TYPE_UNKNOWN;
+
+  int64_t count = 0;
+  int64_t sum_int = 0;
+  // The mean numerator accumulates in a double even for INT64 args, matching MeanUDA.
+  double sum_float = 0.0;
+  int64_t extreme_int = 0;
+  double extreme_float = 0.0;
+
+  void Reset() {
+    count = 0;
+    sum_int = 0;
+    sum_float = 0.0;
+    // Seed the extremes the way the builtin UDAs do. Note that numeric_limits<double>::min()
+    // is the smallest positive double; MaxUDA uses the same seed, and matching it keeps the
+    // fast path bit-identical on empty inputs.
+    extreme_int = kind == Kind::kMin ? std::numeric_limits<int64_t>::max()
+                                     : std::numeric_limits<int64_t>::min();
+    extreme_float = kind == Kind::kMin ? std::numeric_limits<double>::max()
+                                       : std::numeric_limits<double>::min();
+  }
+};
 
+class AggNode : public ProcessingNode {
  public:
   AggNode() = default;
   virtual ~AggNode() = default;
 
+  // For unit testing, lowers the spill budget to exercise the spill path with small inputs.
+  void testing_set_spill_threshold_bytes(size_t threshold) {
+    spill_threshold_bytes_ = threshold;
+  }
+
  protected:
   Status AggregateGroupByNone(ExecState* exec_state, const table_store::schema::RowBatch& rb);
   Status AggregateGroupByClause(ExecState* exec_state, const table_store::schema::RowBatch& rb);
@@ -83,7 +122,6 @@ class AggNode : public ProcessingNode {
                          size_t parent_index) override;
 
  private:
-  AggHashMap agg_hash_map_;
   bool HasNoGroups() const { return plan_node_->groups().empty(); }
   // ReadyToEmitBatches returns true when the input stream has reached a point where output batches
   // can be emitted. In the windowed aggregate case, this happens whenever end of window (eow) is
@@ -95,17 +133,40 @@ class AggNode : public ProcessingNode {
   Status EvaluateSingleExpressionNoGroups(ExecState* exec_state, const UDAInfo& uda_info,
                                           plan::AggregateExpression* expr,
                                           const table_store::schema::RowBatch& rb);
+  // Vectorized no-groups fast path (see VectorizedAggAcc). SetupVectorizedAggs enables it when
+  // every value expression is a recognized aggregate over a single numeric column; partial and
+  // finalize aggregates always keep the UDA path since merges rely on UDA state serialization.
+  void SetupVectorizedAggs();
+  Status UpdateVectorizedAggs(const table_store::schema::RowBatch& rb);
+  Status FinalizeVectorizedAggs(ExecState* exec_state, table_store::schema::RowBatch* output_rb);
   Status EvaluateAggHashValue(ExecState* exec_state, AggHashValue* val);
   StatusOr<types::DataType> GetTypeOfDep(const plan::ScalarExpression& expr) const;
 
+  // Partial aggregates serialize their per-group UDA states into a single binary column;
+  // the finalize aggregate deserializes those states and merges them back into its UDAs.
+  Status SerializeUDAStates(const std::vector<UDAInfo>& udas, std::string* out);
+  Status MergeSerializedRow(std::string_view data, std::vector<UDAInfo>* udas);
+  Status MergeSerializedStates(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+
   // Store information about aggregate node from the query planner.
   std::unique_ptr<plan::AggregateOperator> plan_node_;
   std::unique_ptr<table_store::schema::RowDescriptor> input_descriptor_;
 
+  // A partial aggregate emits serialized UDA states instead of finalized values; a
+  // finalize aggregate consumes those states instead of raw rows. A regular aggregate
+  // has neither flag set.
+  bool is_partial_agg_ = false;
+  bool is_finalize_agg_ = false;
+  // Scratch UDA instances used by the finalize aggregate to deserialize incoming partial
+  // states before merging them; Deserialize overwrites state, so they are reused per row.
+  std::vector<UDAInfo> scratch_udas_;
+
   std::unique_ptr<udf::FunctionContext> function_ctx_;
 
   // Variables specific to GroupByNone Agg.
   std::vector<UDAInfo> udas_no_groups_;
+  bool use_vectorized_agg_ = false;
+  std::vector<VectorizedAggAcc> vectorized_aggs_;
   // END: Variables specific to GroupByNone Agg.
 
   // Variables specific to GroupBy Agg.
@@ -127,10 +188,34 @@ class AggNode : public ProcessingNode {
   std::vector<types::DataType> group_data_types_;
   std::vector<types::DataType> value_data_types_;
 
+  // Flat open-addressing map from serialized group key to aggregate state. Group keys
+  // live in the table's arena, so groups cost no per-group heap allocations.
+  FlatAggHashTable<AggHashValue*> agg_hash_table_{&group_data_types_};
+
+  // Spill state. Once the group table grows past the budget, rows belonging to unseen
+  // groups are routed to disk and aggregated in later passes, so the number of
+  // in-memory groups stays bounded. Keys in the spill file are disjoint from the
+  // in-memory table by construction, so each pass emits a disjoint set of groups.
+  std::unique_ptr<SpilledRowBatchFile> spill_file_;
+  size_t spill_threshold_bytes_ = kDefaultOperatorSpillThresholdBytes;
+  std::vector<int64_t> overflow_rows_;
+
+  // Spill and memory high-water marks, reported through ExecNodeStats at Close for
+  // queries run in analyze mode.
+  size_t spilled_batches_ = 0;
+  size_t spilled_bytes_ = 0;
+  size_t peak_buffered_bytes_ = 0;
+
   // We construct row-tuples in a batch, chunked by each column.
   // This vector holds pointers to the row_tuples which are managed by the group_args_pool_.
 
   std::vector<GroupArgs> group_args_chunk_;
+
+  // Per-row serialized keys and hashes for the current chunk, reused across batches.
+  // Hashing the whole chunk up front lets HashRowBatch prefetch each row's hash table slot
+  // a few rows ahead of the lookup.
+  std::vector<std::string> serialized_keys_chunk_;
+  std::vector<size_t> key_hashes_chunk_;
   // END: Variables specific to GroupBy Agg.
 
   // Creates a mapping between plan cols and stored cols (see above comment).
@@ -138,6 +223,8 @@ class AggNode : public ProcessingNode {
 
   Status ExtractRowTupleForBatch(const table_store::schema::RowBatch& rb);
   Status HashRowBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status SpillOverflowRows(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status ProcessSpilledBatches(ExecState* exec_state, SpilledRowBatchFile* spill_file);
   Status EvaluatePartialAggregates(ExecState* exec_state, size_t num_records);
   Status ResetGroupArgs();
   Status ConvertAggHashMapToRowBatch(ExecState* exec_state,
@@ -19,6 +19,7 @@
 #include "src/carnot/exec/agg_node.h"
 
 #include <algorithm>
+#include <limits>
 
 #include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
@@ -48,6 +49,15 @@ class MinSumUDA : public udf::UDA {
   }
   void Merge(udf::FunctionContext*, const MinSumUDA& other) { sum_ = sum_.val + other.sum_.val; }
   types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+  types::StringValue Serialize(udf::FunctionContext*) {
+    types::StringValue out;
+    out.assign(reinterpret_cast<const char*>(&sum_.val), sizeof(sum_.val));
+    return out;
+  }
+  Status Deserialize(udf::FunctionContext*, const types::StringValue& data) {
+    sum_ = *reinterpret_cast<const int64_t*>(data.data());
+    return Status::OK();
+  }
 
  protected:
   types::Int64Value sum_ = 0;
@@ -71,6 +81,78 @@ class MinSumWithInitUDA : public udf::UDA {
   types::Int64Value sum_ = 0;
 };
 
+// Minimal stand-ins for the builtin common aggregates, used by the vectorized fast-path
+// tests. The fast path is keyed on the registered UDA name, so these register under the
+// builtin names.
+class TestSumUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value v) { sum_ = sum_.val + v.val; }
+  void Merge(udf::FunctionContext*, const TestSumUDA& other) { sum_ = sum_.val + other.sum_.val; }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+
+ protected:
+  types::Int64Value sum_ = 0;
+};
+
+class TestCountUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value) { count_++; }
+  void Merge(udf::FunctionContext*, const TestCountUDA& other) { count_ += other.count_; }
+  types::Int64Value Finalize(udf::FunctionContext*) { return count_; }
+
+ protected:
+  int64_t count_ = 0;
+};
+
+class TestMeanUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Float64Value v) {
+    size_++;
+    sum_ += v.val;
+  }
+  void Merge(udf::FunctionContext*, const TestMeanUDA& other) {
+    size_ += other.size_;
+    sum_ += other.sum_;
+  }
+  types::Float64Value Finalize(udf::FunctionContext*) { return sum_ / size_; }
+
+ protected:
+  uint64_t size_ = 0;
+  double sum_ = 0;
+};
+
+class TestMinUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value v) {
+    min_ = std::min(min_.val, v.val);
+  }
+  void Merge(udf::FunctionContext*, const TestMinUDA& other) {
+    min_ = std::min(min_.val, other.min_.val);
+  }
+  types::Int64Value Finalize(udf::FunctionContext*) { return min_; }
+
+ protected:
+  types::Int64Value min_ = std::numeric_limits<int64_t>::max();
+};
+
+class TestMaxUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Float64Value v) {
+    if (v.val > max_.val) {
+      max_ = v;
+    }
+  }
+  void Merge(udf::FunctionContext*, const TestMaxUDA& other) {
+    if (other.max_.val > max_.val) {
+      max_ = other.max_;
+    }
+  }
+  types::Float64Value Finalize(udf::FunctionContext*) { return max_; }
+
+ protected:
+  types::Float64Value max_ = std::numeric_limits<double>::min();
+};
+
 constexpr char kBlockingNoGroupAgg[] = R"(
 op_type: AGGREGATE_OPERATOR
 agg_op {
@@ -93,6 +175,86 @@ agg_op {
   value_names: "value1"
 })";
 
+// Every value expression here is a common aggregate over a single numeric column, so this
+// plan takes the vectorized no-groups fast path.
+constexpr char kBlockingNoGroupVectorizedAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "sum"
+    id: 2
+    args {
+      column {
+        node: 0
+        index: 0
+      }
+    }
+  }
+  values {
+    name: "count"
+    id: 3
+    args {
+      column {
+        node: 0
+        index: 0
+      }
+    }
+  }
+  values {
+    name: "mean"
+    id: 4
+    args {
+      column {
+        node: 0
+        index: 1
+      }
+    }
+  }
+  values {
+    name: "min"
+    id: 5
+    args {
+      column {
+        node: 0
+        index: 0
+      }
+    }
+  }
+  values {
+    name: "max"
+    id: 6
+    args {
+      column {
+        node: 0
+        index: 1
+      }
+    }
+  }
+  value_names: "sum"
+  value_names: "count"
+  value_names: "mean"
+  value_names: "min"
+  value_names: "max"
+})";
+
+constexpr char kWindowedNoGroupVectorizedAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: true
+  values {
+    name: "sum"
+    id: 2
+    args {
+      column {
+        node: 0
+        index: 0
+      }
+    }
+  }
+  value_names: "sum"
+})";
+
 constexpr char kBlockingSingleGroupAgg[] = R"(
 op_type: AGGREGATE_OPERATOR
 agg_op {
@@ -270,6 +432,122 @@ agg_op {
   value_names: "value1"
 })";
 
+constexpr char kPartialNoGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 0
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+  }
+  value_names: "value1"
+  partial_agg: true
+  finalize_results: false
+})";
+
+constexpr char kFinalizeNoGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 0
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+  }
+  value_names: "value1"
+  partial_agg: false
+  finalize_results: true
+})";
+
+constexpr char kPartialSingleGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 0
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+  partial_agg: true
+  finalize_results: false
+})";
+
+constexpr char kFinalizeSingleGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 0
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+  partial_agg: false
+  finalize_results: true
+})";
+
+// Serialized partial state for a single MinSumUDA: a 4-byte length prefix followed by the
+// raw sum, matching the framing AggNode uses for the serialized_expressions column.
+std::string SerializedMinSumState(int64_t sum) {
+  std::string out;
+  auto len = static_cast<uint32_t>(sizeof(sum));
+  out.append(reinterpret_cast<const char*>(&len), sizeof(len));
+  out.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+  return out;
+}
+
 std::unique_ptr<ExecState> MakeTestExecState(udf::Registry* registry) {
   auto table_store = std::make_shared<table_store::TableStore>();
   return std::make_unique<ExecState>(registry, table_store, MockResultSinkStubGenerator,
@@ -294,6 +572,17 @@ class AggNodeTest : public ::testing::Test {
     EXPECT_OK(exec_state_->AddUDA(0, "minsum",
                                   std::vector<types::DataType>({types::INT64, types::INT64})));
     EXPECT_OK(exec_state_->AddUDA(1, "minsum_w_init", {types::INT64, types::INT64, types::INT64}));
+
+    EXPECT_TRUE(func_registry_->Register<TestSumUDA>("sum").ok());
+    EXPECT_TRUE(func_registry_->Register<TestCountUDA>("count").ok());
+    EXPECT_TRUE(func_registry_->Register<TestMeanUDA>("mean").ok());
+    EXPECT_TRUE(func_registry_->Register<TestMinUDA>("min").ok());
+    EXPECT_TRUE(func_registry_->Register<TestMaxUDA>("max").ok());
+    EXPECT_OK(exec_state_->AddUDA(2, "sum", {types::INT64}));
+    EXPECT_OK(exec_state_->AddUDA(3, "count", {types::INT64}));
+    EXPECT_OK(exec_state_->AddUDA(4, "mean", {types::FLOAT64}));
+    EXPECT_OK(exec_state_->AddUDA(5, "min", {types::INT64}));
+    EXPECT_OK(exec_state_->AddUDA(6, "max", {types::FLOAT64}));
   }
 
  protected:
@@ -414,6 +703,52 @@ TEST_F(AggNodeTest, multiple_groups_blocking) {
       .Close();
 }
 
+TEST_F(AggNodeTest, multiple_groups_blocking_with_spilling) {
+  // Same input as multiple_groups_blocking, but with the spill budget lowered so groups
+  // first seen after the budget is hit are spilled and aggregated in a second pass. The
+  // union of the emitted batches must match the in-memory result.
+  auto plan_node = PlanNodeFromPbtxt(kBlockingMultipleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  tester.node()->testing_set_spill_threshold_bytes(1);
+
+  tester
+      // The first batch's groups are aggregated in memory (an empty table is never
+      // considered over budget).
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 5, 1, 2})
+                       .AddColumn<types::Int64Value>({2, 1, 3, 1})
+                       .AddColumn<types::Int64Value>({2, 5, 3, 1})
+                       .get(),
+                   0, 0)
+      // The table is now over budget: rows for group (3, 3) spill, the rest aggregate.
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::Int64Value>({5, 1, 3, 3})
+                       .AddColumn<types::Int64Value>({1, 2, 3, 3})
+                       .AddColumn<types::Int64Value>({1, 3, 3, 8})
+                       .get(),
+                   0)
+      // First pass: the in-memory groups, with eow/eos held back for the spilled pass.
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 4, false, false)
+                          .AddColumn<types::Int64Value>({1, 1, 2, 5})
+                          .AddColumn<types::Int64Value>({2, 3, 1, 1})
+                          .AddColumn<types::Int64Value>({4, 3, 1, 2})
+                          .get(),
+                      false)
+      // Second pass: the spilled group.
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({3})
+                          .AddColumn<types::Int64Value>({3})
+                          .AddColumn<types::Int64Value>({6})
+                          .get(),
+                      false)
+      .Close();
+}
+
 TEST_F(AggNodeTest, multiple_groups_with_string_blocking) {
   auto plan_node = PlanNodeFromPbtxt(kBlockingMultipleGroupAgg);
   RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
@@ -487,6 +822,69 @@ TEST_F(AggNodeTest, no_groups_windowed) {
       .Close();
 }
 
+TEST_F(AggNodeTest, no_groups_vectorized_fast_path) {
+  auto plan_node = PlanNodeFromPbtxt(kBlockingNoGroupVectorizedAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::FLOAT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64,
+                           types::DataType::FLOAT64, types::DataType::INT64,
+                           types::DataType::FLOAT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                       .AddColumn<types::Float64Value>({1.5, 2.5, 3.5, 4.5})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::Int64Value>({5, -2})
+                       .AddColumn<types::Float64Value>({0.5, 6.5})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({Int64Value(13)})
+                          .AddColumn<types::Int64Value>({Int64Value(6)})
+                          .AddColumn<types::Float64Value>({types::Float64Value(19.0 / 6.0)})
+                          .AddColumn<types::Int64Value>({Int64Value(-2)})
+                          .AddColumn<types::Float64Value>({types::Float64Value(6.5)})
+                          .get(),
+                      false)
+      .Close();
+}
+
+// The vectorized accumulators must reset between windows, like the UDA instances do.
+TEST_F(AggNodeTest, no_groups_vectorized_windowed) {
+  auto plan_node = PlanNodeFromPbtxt(kWindowedNoGroupVectorizedAgg);
+  RowDescriptor input_rd({types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ true, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 2, 3})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, false)
+                          .AddColumn<types::Int64Value>({Int64Value(6)})
+                          .get(),
+                      false)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::Int64Value>({10, 20})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({Int64Value(30)})
+                          .get(),
+                      false)
+      .Close();
+}
+
 TEST_F(AggNodeTest, single_group_windowed) {
   auto plan_node = PlanNodeFromPbtxt(kWindowedSingleGroupAgg);
   RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
@@ -611,6 +1009,112 @@ TEST_F(AggNodeTest, single_group_blocking_init_args) {
       .Close();
 }
 
+TEST_F(AggNodeTest, no_groups_partial) {
+  auto plan_node = PlanNodeFromPbtxt(kPartialNoGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                       .AddColumn<types::Int64Value>({2, 5, 6, 8})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::Int64Value>({5, 6, 3, 4})
+                       .AddColumn<types::Int64Value>({1, 5, 3, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::StringValue>({SerializedMinSumState(23)})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, no_groups_finalize) {
+  auto plan_node = PlanNodeFromPbtxt(kFinalizeNoGroupAgg);
+  RowDescriptor input_rd({types::DataType::STRING});
+
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::StringValue>(
+                           {SerializedMinSumState(10), SerializedMinSumState(13)})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({Int64Value(23)})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, single_group_partial) {
+  auto plan_node = PlanNodeFromPbtxt(kPartialSingleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 1, 2, 2})
+                       .AddColumn<types::Int64Value>({2, 3, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::Int64Value>({5, 6, 3, 4})
+                       .AddColumn<types::Int64Value>({1, 5, 3, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 6, true, true)
+                          .AddColumn<types::Int64Value>({1, 2, 3, 4, 5, 6})
+                          .AddColumn<types::StringValue>(
+                              {SerializedMinSumState(2), SerializedMinSumState(3),
+                               SerializedMinSumState(3), SerializedMinSumState(4),
+                               SerializedMinSumState(1), SerializedMinSumState(5)})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, single_group_finalize) {
+  auto plan_node = PlanNodeFromPbtxt(kFinalizeSingleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::STRING});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  // Partial states for the same group arrive from different agents and must merge.
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 3, true, true)
+                       .AddColumn<types::Int64Value>({1, 1, 2})
+                       .AddColumn<types::StringValue>({SerializedMinSumState(2),
+                                                       SerializedMinSumState(3),
+                                                       SerializedMinSumState(4)})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::Int64Value>({1, 2})
+                          .AddColumn<types::Int64Value>({5, 4})
+                          .get(),
+                      false)
+      .Close();
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -29,11 +29,13 @@
 #include <absl/strings/str_join.h>
 #include <absl/strings/substitute.h>
 
+#include "src/carnot/carnotpb/carnot.pb.h"
 #include "src/carnot/planpb/plan.pb.h"
 #include "src/carnot/udf/udf_wrapper.h"
 #include "src/common/base/base.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/type_utils.h"
+#include "src/table_store/schema/column_copy.h"
 
 namespace px {
 namespace carnot {
@@ -115,18 +117,18 @@ Status EquijoinNode::InitImpl(const plan::Operator& plan_node) {
   return Status::OK();
 }
 
-Status EquijoinNode::InitializeColumnBuilders() {
+Status EquijoinNode::InitializeColumnBuilders(ExecState* exec_state) {
   for (size_t i = 0; i < output_descriptor_->size(); ++i) {
     column_builders_[i] =
-        MakeArrowBuilder(output_descriptor_->type(i), arrow::default_memory_pool());
+        MakeArrowBuilder(output_descriptor_->type(i), exec_state->exec_mem_pool());
     PL_RETURN_IF_ERROR(column_builders_[i]->Reserve(output_rows_per_batch_));
   }
   return Status::OK();
 }
 
-Status EquijoinNode::PrepareImpl(ExecState* /*exec_state*/) {
+Status EquijoinNode::PrepareImpl(ExecState* exec_state) {
   column_builders_.resize(output_descriptor_->size());
-  PL_RETURN_IF_ERROR(InitializeColumnBuilders());
+  PL_RETURN_IF_ERROR(InitializeColumnBuilders(exec_state));
 
   return Status::OK();
 }
@@ -134,9 +136,13 @@ Status EquijoinNode::PrepareImpl(ExecState* /*exec_state*/) {
 Status EquijoinNode::OpenImpl(ExecState* /*exec_state*/) { return Status::OK(); }
 
 Status EquijoinNode::CloseImpl(ExecState* /*exec_state*/) {
+  stats()->AddExtraMetric("spilled_batches", spilled_batches_);
+  stats()->AddExtraMetric("spilled_bytes", spilled_bytes_);
+  stats()->AddExtraMetric("peak_buffered_bytes", peak_buffered_bytes_);
+
   join_keys_chunk_.clear();
-  build_buffer_.clear();
-  probed_keys_.clear();
+  key_hashes_chunk_.clear();
+  partitions_.clear();
   key_values_pool_.Clear();
   return Status::OK();
 }
@@ -185,6 +191,25 @@ Status EquijoinNode::ExtractJoinKeysForBatch(const table_store::schema::RowBatch
 #undef TYPE_CASE
   }
 
+  // Hash the key columns for the whole batch in one pass per column, and install the
+  // precomputed hashes into the tuples. All tuples entering the join's hash containers flow
+  // through here, so every tuple carries a hash from the same batched scheme.
+  if (!spec.key_indices.empty()) {
+    key_hashes_chunk_.resize(num_rows);
+    for (size_t tuple_col_idx = 0; tuple_col_idx < spec.key_indices.size(); ++tuple_col_idx) {
+      auto input_col_idx = spec.key_indices[tuple_col_idx];
+      auto dt = key_data_types_[tuple_col_idx];
+      auto col = rb.ColumnAt(input_col_idx).get();
+
+#define TYPE_CASE(_dt_) HashColumnIntoBatch<_dt_>(col, tuple_col_idx == 0, &key_hashes_chunk_);
+      PL_SWITCH_FOREACH_DATATYPE(dt, TYPE_CASE);
+#undef TYPE_CASE
+    }
+    for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+      join_keys_chunk_[row_idx]->set_hash(key_hashes_chunk_[row_idx]);
+    }
+  }
+
   return Status::OK();
 }
 
@@ -211,7 +236,8 @@ Status EquijoinNode::HashRowBatch(const table_store::schema::RowBatch& rb) {
   // Make sure the map has constructed the necessary column wrappers for all of the tuples.
   for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
     auto& rt = join_keys_chunk_[row_idx];
-    auto& current = build_buffer_[rt];
+    auto* partition = PartitionForKey(rt);
+    auto& current = partition->build_buffer[rt];
     auto wrappers_ptr = current != nullptr ? current : build_wrappers_chunk_[row_idx];
 
     // Now extract the values into the corresponding column wrappers.
@@ -226,28 +252,56 @@ Status EquijoinNode::HashRowBatch(const table_store::schema::RowBatch& rb) {
 #undef TYPE_CASE
     }
     // Keep track of the number of rows that the build buffer matches for each key.
-    build_buffer_rows_[rt]++;
+    partition->build_buffer_rows[rt]++;
 
     if (current == nullptr) {
+      ++num_build_keys_;
       std::swap(build_wrappers_chunk_[row_idx], current);
       // Reset the new tuples that we added
       join_keys_chunk_[row_idx] = nullptr;
     }
   }
 
+  if (!radix_partitioned_ && num_build_keys_ > radix_partition_min_keys_) {
+    RadixPartitionBuildBuffer();
+  }
+
   return Status::OK();
 }
 
+EquijoinNode::JoinPartition* EquijoinNode::PartitionForKey(const RowTuple* rt) {
+  if (!radix_partitioned_) {
+    return &partitions_[0];
+  }
+  // Use the upper hash bits for the partition so we don't correlate with the hash table's
+  // bucket selection, which consumes the lower bits.
+  return &partitions_[rt->Hash() >> (sizeof(size_t) * 8 - kJoinRadixBits)];
+}
+
+void EquijoinNode::RadixPartitionBuildBuffer() {
+  DCHECK(!radix_partitioned_);
+  std::vector<JoinPartition> partitions(kNumJoinPartitions);
+  auto& old_partition = partitions_[0];
+  for (auto& [rt, wrappers] : old_partition.build_buffer) {
+    partitions[rt->Hash() >> (sizeof(size_t) * 8 - kJoinRadixBits)].build_buffer[rt] = wrappers;
+  }
+  for (auto& [rt, num_rows] : old_partition.build_buffer_rows) {
+    partitions[rt->Hash() >> (sizeof(size_t) * 8 - kJoinRadixBits)].build_buffer_rows[rt] =
+        num_rows;
+  }
+  for (auto* rt : old_partition.probed_keys) {
+    partitions[rt->Hash() >> (sizeof(size_t) * 8 - kJoinRadixBits)].probed_keys.insert(rt);
+  }
+  partitions_ = std::move(partitions);
+  radix_partitioned_ = true;
+}
+
 template <types::DataType DT>
 Status AppendValuesFromWrapper(arrow::ArrayBuilder* output_builder,
                                types::SharedColumnWrapper input_wrapper, size_t start_idx,
                                size_t num_rows) {
-  using ValueType = typename types::DataTypeTraits<DT>::value_type;
-  for (size_t row_idx = start_idx; row_idx < start_idx + num_rows; ++row_idx) {
-    PL_RETURN_IF_ERROR(table_store::schema::CopyValue<DT>(
-        output_builder, udf::UnWrap(input_wrapper->Get<ValueType>(row_idx))));
-  }
-  return Status::OK();
+  return table_store::schema::CopyWrapperRange<DT>(output_builder, input_wrapper.get(), start_idx,
+                                                   num_rows);
 }
 
 template <types::DataType DT>
@@ -272,7 +326,7 @@ Status EquijoinNode::NextOutputBatch(ExecState* exec_state) {
   }
   pending_output_batch_.swap(output_batch);
 
-  return InitializeColumnBuilders();
+  return InitializeColumnBuilders(exec_state);
 }
 
 Status EquijoinNode::FlushChunkedRows(ExecState* exec_state) {
@@ -355,15 +409,30 @@ Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::R
 
   if (rb.num_rows() > static_cast<int64_t>(probe_wrappers_chunk_.size())) {
     probe_wrappers_chunk_.resize(rb.num_rows());
+    probe_matched_rows_chunk_.resize(rb.num_rows());
   }
 
+  // Prefetch the build-table bucket a few rows ahead of the probe. The key hashes were
+  // precomputed column-at-a-time in ExtractJoinKeysForBatch, so the prefetch only computes
+  // the bucket address; on build sides larger than the cache the find() below would
+  // otherwise stall on every row.
+  constexpr int64_t kProbePrefetchDistance = 8;
   for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
-    auto it = build_buffer_.find(join_keys_chunk_[row_idx]);
-    if (it != build_buffer_.end()) {
+    if (row_idx + kProbePrefetchDistance < rb.num_rows()) {
+      RowTuple* prefetch_rt = join_keys_chunk_[row_idx + kProbePrefetchDistance];
+      PartitionForKey(prefetch_rt)->build_buffer.prefetch(prefetch_rt);
+    }
+    auto* partition = PartitionForKey(join_keys_chunk_[row_idx]);
+    auto it = partition->build_buffer.find(join_keys_chunk_[row_idx]);
+    if (it != partition->build_buffer.end()) {
       probe_wrappers_chunk_[row_idx] = it->second;
-      probed_keys_.insert(it->first);
+      probe_matched_rows_chunk_[row_idx] = partition->build_buffer_rows[it->first];
+      if (build_spec_.emit_unmatched_rows) {
+        partition->probed_keys.insert(it->first);
+      }
     } else {
       probe_wrappers_chunk_[row_idx] = nullptr;
+      probe_matched_rows_chunk_[row_idx] = 0;
     }
   }
 
@@ -384,8 +453,7 @@ Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::R
     }
 
     PL_RETURN_IF_ERROR(MatchBuildValuesAndFlush(exec_state, probe_wrappers_chunk_[row_idx], rb_ptr,
-                                                row_idx,
-                                                build_buffer_rows_[join_keys_chunk_[row_idx]]));
+                                                row_idx, probe_matched_rows_chunk_[row_idx]));
   }
 
   if (probe_eos_ && queued_rows_ > 0) {
@@ -396,12 +464,14 @@ Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::R
 }
 
 Status EquijoinNode::EmitUnmatchedBuildRows(ExecState* exec_state) {
-  for (auto it = build_buffer_.begin(); it != build_buffer_.end(); ++it) {
-    if (probed_keys_.find(it->first) != probed_keys_.end()) {
-      continue;
+  for (auto& partition : partitions_) {
+    for (auto it = partition.build_buffer.begin(); it != partition.build_buffer.end(); ++it) {
+      if (partition.probed_keys.find(it->first) != partition.probed_keys.end()) {
+        continue;
+      }
+      PL_RETURN_IF_ERROR(MatchBuildValuesAndFlush(exec_state, it->second, nullptr, 0,
+                                                  partition.build_buffer_rows[it->first]));
     }
-    PL_RETURN_IF_ERROR(MatchBuildValuesAndFlush(exec_state, it->second, nullptr, 0,
-                                                build_buffer_rows_[it->first]));
   }
 
   if (queued_rows_ > 0) {
@@ -410,20 +480,73 @@ Status EquijoinNode::EmitUnmatchedBuildRows(ExecState* exec_state) {
   return Status::OK();
 }
 
+void EquijoinNode::PublishProbeKeyFilter(ExecState* exec_state) {
+  if (build_key_filter_ == nullptr) {
+    return;
+  }
+  carnotpb::SinkKeyFilterResponse::KeyFilter filter;
+  for (int64_t key_idx : probe_spec_.key_indices) {
+    filter.add_key_column_indices(key_idx);
+  }
+  *filter.mutable_bloom_filter() = build_key_filter_->ToProto();
+  exec_state->grpc_router()->RegisterSinkKeyFilter(exec_state->query_id(),
+                                                   probe_key_filter_source_id_, std::move(filter));
+  // The filter has served its purpose; probing rechecks every row against the real hash table.
+  build_key_filter_.reset();
+}
+
 Status EquijoinNode::ConsumeBuildBatch(ExecState* exec_state,
                                        const table_store::schema::RowBatch& rb) {
   if (rb.eos()) {
     build_eos_ = true;
   }
 
+  // Start collecting build-side keys into a bloom filter when there is an upstream sink that
+  // can use it. Dropping probe rows at the sink is only correct when probe rows without a
+  // build match are discarded anyway, so joins emitting unmatched probe rows never publish.
+  if (!build_key_filter_attempted_) {
+    build_key_filter_attempted_ = true;
+    if (probe_key_filter_source_id_ >= 0 && !probe_spec_.emit_unmatched_rows &&
+        !key_data_types_.empty() && exec_state->grpc_router() != nullptr) {
+      PL_ASSIGN_OR_RETURN(build_key_filter_,
+                          bloomfilter::XXHash64BloomFilter::Create(kProbeKeyFilterMaxEntries,
+                                                                   kProbeKeyFilterErrorRate));
+    }
+  }
+
   PL_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, false));
+
+  if (build_key_filter_ != nullptr) {
+    build_key_filter_entries_ += rb.num_rows();
+    if (build_key_filter_entries_ > kProbeKeyFilterMaxEntries) {
+      build_key_filter_.reset();
+    } else {
+      // The sinks hash probe keys with the same batched column hash scheme, so membership of
+      // the per-row key hash is equivalent to membership of the key itself.
+      for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+        build_key_filter_->Insert(key_hashes_chunk_[row_idx]);
+      }
+    }
+  }
+
   PL_RETURN_IF_ERROR(HashRowBatch(rb));
 
   if (build_eos_) {
+    PublishProbeKeyFilter(exec_state);
     while (probe_batches_.size()) {
       PL_RETURN_IF_ERROR(DoProbe(exec_state, probe_batches_.front()));
       probe_batches_.pop();
     }
+    if (spilled_probe_batches_ != nullptr) {
+      // Batches were spilled strictly after the in-memory ones, so draining the queue
+      // first preserves arrival order.
+      PL_RETURN_IF_ERROR(spilled_probe_batches_->StartRead());
+      while (spilled_probe_batches_->HasNext()) {
+        PL_ASSIGN_OR_RETURN(auto spilled_rb, spilled_probe_batches_->ReadNext());
+        PL_RETURN_IF_ERROR(DoProbe(exec_state, *spilled_rb));
+      }
+      spilled_probe_batches_.reset();
+    }
   }
   return Status::OK();
 }
@@ -431,7 +554,20 @@ Status EquijoinNode::ConsumeBuildBatch(ExecState* exec_state,
 Status EquijoinNode::ConsumeProbeBatch(ExecState* exec_state,
                                        const table_store::schema::RowBatch& rb) {
   if (!build_eos_) {
+    buffered_probe_bytes_ += rb.NumBytes();
+    if (spilled_probe_batches_ != nullptr ||
+        (spill_threshold_bytes_ != 0 && buffered_probe_bytes_ > spill_threshold_bytes_)) {
+      if (spilled_probe_batches_ == nullptr) {
+        PL_ASSIGN_OR_RETURN(spilled_probe_batches_, SpilledRowBatchFile::Create());
+      }
+      const size_t prev_bytes_written = spilled_probe_batches_->bytes_written();
+      PL_RETURN_IF_ERROR(spilled_probe_batches_->Write(rb));
+      ++spilled_batches_;
+      spilled_bytes_ += spilled_probe_batches_->bytes_written() - prev_bytes_written;
+      return Status::OK();
+    }
     probe_batches_.push(rb);
+    peak_buffered_bytes_ = std::max(peak_buffered_bytes_, buffered_probe_bytes_);
     return Status::OK();
   }
   return DoProbe(exec_state, rb);
@@ -30,11 +30,13 @@
 
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/row_batch_spill.h"
 #include "src/carnot/exec/row_tuple.h"
 #include "src/carnot/plan/operators.h"
 #include "src/common/base/base.h"
 #include "src/common/base/status.h"
 #include "src/common/memory/memory.h"
+#include "src/shared/bloomfilter/bloomfilter.h"
 #include "src/shared/types/column_wrapper.h"
 #include "src/shared/types/types.h"
 #include "src/table_store/table_store.h"
@@ -45,6 +47,21 @@ namespace exec {
 
 constexpr size_t kDefaultJoinRowBatchSize = 1024;
 
+// Number of hash-prefix bits used to radix partition large builds, and the resulting
+// partition count. With 64 partitions a 10M-key build side keeps each partition's hash
+// table around L2 size instead of thrashing LLC on every probe.
+constexpr size_t kJoinRadixBits = 6;
+constexpr size_t kNumJoinPartitions = 1ULL << kJoinRadixBits;
+// Builds smaller than this stay in a single hash table; partitioning only pays off once
+// the table outgrows the cache.
+constexpr int64_t kJoinRadixPartitionMinKeys = 64 * 1024;
+
+// Sizing for the build-side key bloom filter published to upstream sinks (~300KB at these
+// parameters). Builds with more rows than this stop publishing: the false positive rate of an
+// over-full filter degrades until it no longer pays for the probe-side hashing.
+constexpr int64_t kProbeKeyFilterMaxEntries = 256 * 1024;
+constexpr double kProbeKeyFilterErrorRate = 0.01;
+
 class EquijoinNode : public ProcessingNode {
   enum class JoinInputTable { kLeftTable, kRightTable };
 
@@ -64,6 +81,31 @@ class EquijoinNode : public ProcessingNode {
   EquijoinNode() = default;
   virtual ~EquijoinNode() = default;
 
+  // For unit testing, lowers the radix partitioning threshold to exercise the
+  // partitioned path without a cache-sized build input.
+  void testing_set_radix_partition_min_keys(int64_t min_keys) {
+    radix_partition_min_keys_ = min_keys;
+  }
+
+  // For unit testing, lowers the probe-buffer spill budget.
+  void testing_set_spill_threshold_bytes(size_t threshold) {
+    spill_threshold_bytes_ = threshold;
+  }
+
+  // Index (0 = left, 1 = right) of the parent feeding the probe side. Valid after Init.
+  size_t probe_parent_index() const {
+    return probe_table_ == JoinInputTable::kLeftTable ? 0 : 1;
+  }
+
+  // Set by the execution graph when the probe side is fed directly by a GRPC source node: once
+  // the build side completes, the join publishes a bloom filter of build-side keys to the GRPC
+  // router under this source ID, so the upstream sinks can drop non-matching probe rows before
+  // transmission (sideways information passing). Only inner/one-sided joins that discard
+  // unmatched probe rows publish a filter.
+  void set_probe_key_filter_source_id(int64_t source_id) {
+    probe_key_filter_source_id_ = source_id;
+  }
+
  protected:
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
@@ -74,7 +116,7 @@ class EquijoinNode : public ProcessingNode {
                          size_t parent_index) override;
 
  private:
-  Status InitializeColumnBuilders();
+  Status InitializeColumnBuilders(ExecState* exec_state);
   bool IsProbeTable(size_t parent_index);
   Status FlushChunkedRows(ExecState* exec_state);
   Status ExtractJoinKeysForBatch(const table_store::schema::RowBatch& rb, bool is_probe);
@@ -86,6 +128,7 @@ class EquijoinNode : public ProcessingNode {
                                   std::shared_ptr<table_store::schema::RowBatch> probe_rb,
                                   int64_t probe_rb_row_idx, int64_t matching_bb_rows);
   Status EmitUnmatchedBuildRows(ExecState* exec_state);
+  void PublishProbeKeyFilter(ExecState* exec_state);
   Status NextOutputBatch(ExecState* exec_state);
   Status ConsumeBuildBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
   Status ConsumeProbeBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
@@ -125,8 +168,17 @@ class EquijoinNode : public ProcessingNode {
   std::vector<OutputChunk> chunks_;
 
   // Memory/column building members
-  // If the build stage isn't complete, we need to buffer the probe batches.
+  // If the build stage isn't complete, we need to buffer the probe batches. Batches past
+  // the spill budget go to disk instead, bounding the buffered memory.
   std::queue<table_store::schema::RowBatch> probe_batches_;
+  std::unique_ptr<SpilledRowBatchFile> spilled_probe_batches_;
+  size_t buffered_probe_bytes_ = 0;
+  size_t spill_threshold_bytes_ = kDefaultOperatorSpillThresholdBytes;
+  // Spill and memory high-water marks, reported through ExecNodeStats at Close for
+  // queries run in analyze mode.
+  size_t spilled_batches_ = 0;
+  size_t spilled_bytes_ = 0;
+  size_t peak_buffered_bytes_ = 0;
   // Column builders will flush a batch once they hit output_rows_per_batch_ rows.
   std::vector<std::unique_ptr<arrow::ArrayBuilder>> column_builders_;
   // Manages the RowTuples containing the keys for the join.
@@ -135,21 +187,49 @@ class EquijoinNode : public ProcessingNode {
 
   // Chunk of data to use when extracting join keys.
   std::vector<RowTuple*> join_keys_chunk_;
+  // Per-row key hashes computed column-at-a-time for the current chunk.
+  std::vector<uint64_t> key_hashes_chunk_;
   // Chunk of data to use when performing the build stage of the join.
   std::vector<std::vector<types::SharedColumnWrapper>*> build_wrappers_chunk_;
 
   // Chunk of data to use when performing the probe stage of the join.
-  // This will store build table data from `build_buffer_`.
+  // This will store build table data from the partitions' build buffers.
   std::vector<std::vector<types::SharedColumnWrapper>*> probe_wrappers_chunk_;
-  AbslRowTupleHashMap<std::vector<types::SharedColumnWrapper>*> build_buffer_;
-  // Store the number of rows that match a given set of keys for the build buffer.
-  // This is necessary to store in addition to the values in `build_buffer_` in
-  // the event that no columns from the build side are emitted.
-  AbslRowTupleHashMap<int64_t> build_buffer_rows_;
-
-  // For joins where the build_buffer_ needs to emit any non-probed rows at the end of the join,
-  // keep track of which ones they were.
-  AbslRowTupleHashSet probed_keys_;
+  // For each probe row, the number of build rows matching its key.
+  std::vector<int64_t> probe_matched_rows_chunk_;
+
+  // State for one radix partition of the build side. Small builds live entirely in a
+  // single partition; once the build side exceeds kJoinRadixPartitionMinKeys keys it is
+  // repartitioned by hash prefix into kNumJoinPartitions cache-sized partitions.
+  struct JoinPartition {
+    AbslRowTupleHashMap<std::vector<types::SharedColumnWrapper>*> build_buffer;
+    // Store the number of rows that match a given set of keys for the build buffer.
+    // This is necessary to store in addition to the values in `build_buffer` in
+    // the event that no columns from the build side are emitted.
+    AbslRowTupleHashMap<int64_t> build_buffer_rows;
+    // For joins where the build buffer needs to emit any non-probed rows at the end of the
+    // join, keep track of which ones they were.
+    AbslRowTupleHashSet probed_keys;
+  };
+
+  // Returns the partition owning the given key.
+  JoinPartition* PartitionForKey(const RowTuple* rt);
+  // Splits the single build partition into kNumJoinPartitions partitions by hash prefix.
+  void RadixPartitionBuildBuffer();
+
+  std::vector<JoinPartition> partitions_ = std::vector<JoinPartition>(1);
+  bool radix_partitioned_ = false;
+  int64_t num_build_keys_ = 0;
+  int64_t radix_partition_min_keys_ = kJoinRadixPartitionMinKeys;
+
+  // Bloom filter of build-side key hashes, published to the GRPC router at build EOS for the
+  // sinks feeding the probe-side source node. Null when the join is not eligible (no GRPC
+  // source feeding the probe side, or unmatched probe rows must be emitted) or when the build
+  // side outgrew the filter.
+  std::unique_ptr<bloomfilter::XXHash64BloomFilter> build_key_filter_;
+  bool build_key_filter_attempted_ = false;
+  int64_t build_key_filter_entries_ = 0;
+  int64_t probe_key_filter_source_id_ = -1;
 
   // Handle on the most recent RowBatch (in case it's the final one).
   std::unique_ptr<table_store::schema::RowBatch> pending_output_batch_;
@@ -24,11 +24,15 @@
 #include <gtest/gtest.h>
 #include <sole.hpp>
 
+#include "src/carnot/carnotpb/carnot.pb.h"
+#include "src/carnot/exec/grpc_router.h"
 #include "src/carnot/exec/test_utils.h"
 #include "src/carnot/planpb/plan.pb.h"
 #include "src/carnot/planpb/test_proto.h"
 #include "src/carnot/udf/base.h"
 #include "src/carnot/udf/registry.h"
+#include "src/common/uuid/uuid_utils.h"
+#include "src/shared/bloomfilter/bloomfilter.h"
 
 namespace px {
 namespace carnot {
@@ -686,6 +690,231 @@ TEST_F(JoinNodeTest, unordered_many_matches) {
       .Close();
 }
 
+TEST_F(JoinNodeTest, radix_partitioned_inner_join) {
+  // Same shape as ordered_inner_join, but with the radix partitioning threshold lowered
+  // so the build buffer is repartitioned by hash prefix mid-build. Results must be
+  // identical to the single-hash-table path.
+  const char* proto = R"(
+    type: INNER
+    equality_conditions {
+      left_column_index: 0
+      right_column_index: 1
+    }
+    output_columns: {
+      parent_index: 0
+      column_index: 1
+    }
+    output_columns: {
+      parent_index: 1
+      column_index: 1
+    }
+    output_columns: {
+      parent_index: 1
+      column_index: 0
+    }
+    column_names: "left_1"
+    column_names: "right_1"
+    column_names: "time_"
+    rows_per_batch: 5
+  )";
+
+  auto plan_node = PlanNodeFromPbtxt(proto);
+  RowDescriptor input_rd_0({types::DataType::INT64, types::DataType::FLOAT64});
+  RowDescriptor input_rd_1({types::DataType::TIME64NS, types::DataType::INT64});
+  RowDescriptor output_rd(
+      {types::DataType::FLOAT64, types::DataType::INT64, types::DataType::TIME64NS});
+  auto tester = exec::ExecNodeTester<EquijoinNode, plan::JoinOperator>(
+      *plan_node, output_rd, {input_rd_0, input_rd_1}, exec_state_.get());
+  tester.node()->testing_set_radix_partition_min_keys(1);
+
+  tester
+      // Build: 3 distinct keys, exceeding the lowered threshold after the first batch.
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 3, false, false)
+                       .AddColumn<types::Int64Value>({1, 2, 2})
+                       .AddColumn<types::Float64Value>({1.0, 2.0, 2.1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 3, true, true)
+                       .AddColumn<types::Int64Value>({9, 1, 1})
+                       .AddColumn<types::Float64Value>({9.0, 1.1, 1.2})
+                       .get(),
+                   0, 0)
+      // Probe
+      .ConsumeNext(RowBatchBuilder(input_rd_1, 4, false, false)
+                       .AddColumn<types::Time64NSValue>({10, 20, 30, 31})
+                       .AddColumn<types::Int64Value>({1, 2, 3, 3})
+                       .get(),
+                   1, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 5, false, false)
+                          .AddColumn<types::Float64Value>({1.0, 1.1, 1.2, 2.0, 2.1})
+                          .AddColumn<types::Int64Value>({1, 1, 1, 2, 2})
+                          .AddColumn<types::Time64NSValue>({10, 10, 10, 20, 20})
+                          .get(),
+                      true)
+      .ConsumeNext(RowBatchBuilder(input_rd_1, 3, true, true)
+                       .AddColumn<types::Time64NSValue>({101, 150, 190})
+                       .AddColumn<types::Int64Value>({1, 5, 9})
+                       .get(),
+                   1, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 4, true, true)
+                          .AddColumn<types::Float64Value>({1.0, 1.1, 1.2, 9.0})
+                          .AddColumn<types::Int64Value>({1, 1, 1, 9})
+                          .AddColumn<types::Time64NSValue>({101, 101, 101, 190})
+                          .get(),
+                      true)
+      .Close();
+}
+
+TEST_F(JoinNodeTest, spilled_probe_batches_inner_join) {
+  // Probe batches arrive before the build side finishes, with the spill budget lowered so
+  // they are buffered on disk instead of in memory. Results must be identical to the
+  // in-memory buffering path.
+  const char* proto = R"(
+    type: INNER
+    equality_conditions {
+      left_column_index: 0
+      right_column_index: 1
+    }
+    output_columns: {
+      parent_index: 0
+      column_index: 1
+    }
+    output_columns: {
+      parent_index: 1
+      column_index: 1
+    }
+    output_columns: {
+      parent_index: 1
+      column_index: 0
+    }
+    column_names: "left_1"
+    column_names: "right_1"
+    column_names: "time_"
+    rows_per_batch: 5
+  )";
+
+  auto plan_node = PlanNodeFromPbtxt(proto);
+  RowDescriptor input_rd_0({types::DataType::INT64, types::DataType::FLOAT64});
+  RowDescriptor input_rd_1({types::DataType::TIME64NS, types::DataType::INT64});
+  RowDescriptor output_rd(
+      {types::DataType::FLOAT64, types::DataType::INT64, types::DataType::TIME64NS});
+  auto tester = exec::ExecNodeTester<EquijoinNode, plan::JoinOperator>(
+      *plan_node, output_rd, {input_rd_0, input_rd_1}, exec_state_.get());
+  tester.node()->testing_set_spill_threshold_bytes(1);
+
+  tester
+      // Probe batches arrive first and go straight to the spill file.
+      .ConsumeNext(RowBatchBuilder(input_rd_1, 2, false, false)
+                       .AddColumn<types::Time64NSValue>({10, 20})
+                       .AddColumn<types::Int64Value>({1, 2})
+                       .get(),
+                   1, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_1, 2, true, true)
+                       .AddColumn<types::Time64NSValue>({101, 190})
+                       .AddColumn<types::Int64Value>({1, 9})
+                       .get(),
+                   1, 0)
+      // Build table; at eos the spilled probe batches are read back and probed.
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 3, true, true)
+                       .AddColumn<types::Int64Value>({1, 2, 9})
+                       .AddColumn<types::Float64Value>({1.0, 2.0, 9.0})
+                       .get(),
+                   0, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 4, true, true)
+                          .AddColumn<types::Float64Value>({1.0, 2.0, 1.0, 9.0})
+                          .AddColumn<types::Int64Value>({1, 2, 1, 9})
+                          .AddColumn<types::Time64NSValue>({10, 20, 101, 190})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(JoinNodeTest, publishes_probe_key_filter_at_build_eos) {
+  // Inner join whose probe side is fed by a GRPC source: at build EOS the node should publish
+  // a bloom filter of build-side keys to the router, keyed by the probe-side source ID.
+  const char* proto = R"(
+    type: INNER
+    equality_conditions {
+      left_column_index: 0
+      right_column_index: 1
+    }
+    output_columns: {
+      parent_index: 0
+      column_index: 1
+    }
+    output_columns: {
+      parent_index: 1
+      column_index: 0
+    }
+    column_names: "left_1"
+    column_names: "time_"
+    rows_per_batch: 5
+  )";
+
+  GRPCRouter router;
+  auto table_store = std::make_shared<table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                                MockResultSinkStubGenerator,
+                                                MockMetricsStubGenerator, MockTraceStubGenerator,
+                                                sole::uuid4(), nullptr, &router);
+
+  auto plan_node = PlanNodeFromPbtxt(proto);
+  RowDescriptor input_rd_0({types::DataType::INT64, types::DataType::FLOAT64});
+  RowDescriptor input_rd_1({types::DataType::TIME64NS, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::FLOAT64, types::DataType::TIME64NS});
+  auto tester = exec::ExecNodeTester<EquijoinNode, plan::JoinOperator>(
+      *plan_node, output_rd, {input_rd_0, input_rd_1}, exec_state.get());
+  constexpr int64_t kProbeSourceID = 42;
+  tester.node()->set_probe_key_filter_source_id(kProbeSourceID);
+
+  // Build side (left): keys 1, 2, 9.
+  tester.ConsumeNext(RowBatchBuilder(input_rd_0, 3, true, true)
+                         .AddColumn<types::Int64Value>({1, 2, 9})
+                         .AddColumn<types::Float64Value>({1.0, 2.0, 9.0})
+                         .get(),
+                     0, 0);
+
+  carnotpb::SinkKeyFilterRequest req;
+  ToProto(exec_state->query_id(), req.mutable_query_id());
+  req.set_grpc_source_id(kProbeSourceID);
+  carnotpb::SinkKeyFilterResponse resp;
+  auto grpc_s = router.FetchSinkKeyFilter(nullptr, &req, &resp);
+  ASSERT_TRUE(grpc_s.ok()) << grpc_s.error_message();
+  ASSERT_TRUE(resp.has_key_filter());
+  // The probe-side (right) key column index.
+  EXPECT_THAT(resp.key_filter().key_column_indices(), ::testing::ElementsAre(1));
+
+  // The filter must contain the build keys under the batched column hash scheme and (almost
+  // surely) not an absent key.
+  auto filter =
+      bloomfilter::XXHash64BloomFilter::FromProto(resp.key_filter().bloom_filter())
+          .ConsumeValueOrDie();
+  auto key_rb = RowBatchBuilder(RowDescriptor({types::DataType::INT64}), 4, false, false)
+                    .AddColumn<types::Int64Value>({1, 2, 9, 3})
+                    .get();
+  std::vector<uint64_t> key_hashes(4);
+  HashColumnIntoBatch<types::DataType::INT64>(key_rb.ColumnAt(0).get(), /*first_col*/ true,
+                                              &key_hashes);
+  EXPECT_TRUE(filter->Contains(key_hashes[0]));
+  EXPECT_TRUE(filter->Contains(key_hashes[1]));
+  EXPECT_TRUE(filter->Contains(key_hashes[2]));
+  EXPECT_FALSE(filter->Contains(key_hashes[3]));
+
+  // Probe side (right): only the matching rows come out.
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_1, 2, true, true)
+                       .AddColumn<types::Time64NSValue>({10, 20})
+                       .AddColumn<types::Int64Value>({1, 3})
+                       .get(),
+                   1, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Float64Value>({1.0})
+                          .AddColumn<types::Time64NSValue>({10})
+                          .get(),
+                      true)
+      .Close();
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
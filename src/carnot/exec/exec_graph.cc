@@ -36,13 +36,22 @@
 #include "src/carnot/exec/memory_sink_node.h"
 #include "src/carnot/exec/memory_source_node.h"
 #include "src/carnot/exec/otel_export_sink_node.h"
+#include "src/carnot/exec/sample_node.h"
+#include "src/carnot/exec/sort_node.h"
+#include "src/carnot/exec/topk_node.h"
 #include "src/carnot/exec/udtf_source_node.h"
 #include "src/carnot/exec/union_node.h"
+#include "src/carnot/exec/window_agg_node.h"
 #include "src/carnot/plan/operators.h"
 #include "src/carnot/plan/plan_state.h"
 #include "src/common/perf/perf.h"
 #include "src/table_store/table_store.h"
 
+DEFINE_int64(carnot_query_deadline_ms, gflags::Int64FromEnv("PL_CARNOT_QUERY_DEADLINE_MS", 0),
+             "Wall-clock budget in milliseconds for a single query execution. Queries that run "
+             "longer are cancelled with DEADLINE_EXCEEDED at the next row-batch boundary. Set "
+             "to 0 to disable the deadline.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -70,6 +79,9 @@ Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState
         return OnOperatorImpl<plan::MemorySinkOperator, MemorySinkNode>(node, &descriptors);
       })
       .OnAggregate([&](auto& node) {
+        if (FLAGS_enable_incremental_window_agg && WindowAggNode::CanIncrementallyAggregate(node)) {
+          return OnOperatorImpl<plan::AggregateOperator, WindowAggNode>(node, &descriptors);
+        }
         return OnOperatorImpl<plan::AggregateOperator, AggNode>(node, &descriptors);
       })
       .OnMemorySource([&](auto& node) {
@@ -84,8 +96,27 @@ Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState
       .OnUnion([&](auto& node) {
         return OnOperatorImpl<plan::UnionOperator, UnionNode>(node, &descriptors);
       })
+      .OnSort([&](auto& node) {
+        return OnOperatorImpl<plan::SortOperator, SortNode>(node, &descriptors);
+      })
+      .OnTopK([&](auto& node) {
+        return OnOperatorImpl<plan::TopKOperator, TopKNode>(node, &descriptors);
+      })
+      .OnSample([&](auto& node) {
+        return OnOperatorImpl<plan::SampleOperator, SampleNode>(node, &descriptors);
+      })
       .OnJoin([&](auto& node) {
-        return OnOperatorImpl<plan::JoinOperator, EquijoinNode>(node, &descriptors);
+        PL_RETURN_IF_ERROR(OnOperatorImpl<plan::JoinOperator, EquijoinNode>(node, &descriptors));
+        // When the probe side is fed directly by a GRPC source, the sinks feeding that source
+        // emit the probe input's schema, so the join's key column indices line up and it can
+        // publish a bloom filter of build-side keys for the sinks to pre-filter probe batches.
+        auto* join_node = static_cast<EquijoinNode*>(nodes_[node.id()]);
+        auto parents = pf_->dag().ParentsOf(node.id());
+        size_t probe_idx = join_node->probe_parent_index();
+        if (probe_idx < parents.size() && grpc_sources_.contains(parents[probe_idx])) {
+          join_node->set_probe_key_filter_source_id(parents[probe_idx]);
+        }
+        return Status::OK();
       })
       .OnGRPCSource([&](auto& node) {
         auto s = OnOperatorImpl<plan::GRPCSourceOperator, GRPCSourceNode>(node, &descriptors);
@@ -190,6 +221,7 @@ Status ExecutionGraph::ExecuteSources() {
 
   // Run all sources to completion, or exit if the query encounters an error.
   while (running_sources.size()) {
+    PL_RETURN_IF_ERROR(exec_state_->CheckCancelled());
     absl::flat_hash_set<SourceNode*> completed_sources_execute_loop;
 
     for (SourceNode* source : running_sources) {
@@ -250,6 +282,11 @@ Status ExecutionGraph::ExecuteSources() {
       YieldWithTimeout();
       timer.Stop();
 
+      // Sources with no data ready only reach GenerateNext once data arrives, so the
+      // cancellation/deadline check must also run here or a yielded query would never observe
+      // either. Cancellation wakes the yield via the router's restart-execution hook.
+      PL_RETURN_IF_ERROR(exec_state_->CheckCancelled());
+
       absl::flat_hash_set<SourceNode*> completed_sources_wait_loop;
 
       // This check is used for Memory sources that are waiting on data, because we don't currently
@@ -295,6 +332,13 @@ Status ExecutionGraph::ExecuteSources() {
 Status ExecutionGraph::Execute() {
   query_start_time_ = std::chrono::system_clock::now();
 
+  // The deadline is scoped to the query, not the fragment: if an earlier fragment of the same
+  // query already set it, keep the original so multi-fragment plans share one budget.
+  if (FLAGS_carnot_query_deadline_ms > 0 && !exec_state_->has_deadline()) {
+    exec_state_->set_deadline(std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(FLAGS_carnot_query_deadline_ms));
+  }
+
   // Get vector of nodes.
   std::vector<ExecNode*> nodes(nodes_.size());
   transform(nodes_.begin(), nodes_.end(), nodes.begin(), [](auto pair) { return pair.second; });
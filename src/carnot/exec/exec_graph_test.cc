@@ -20,6 +20,7 @@
 
 #include <arrow/array.h>
 #include <arrow/memory_pool.h>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -208,6 +209,79 @@ std::vector<std::tuple<int32_t>> calls_to_execute = {
 INSTANTIATE_TEST_SUITE_P(ExecGraphExecuteTestSuite, ExecGraphExecuteTest,
                          ::testing::ValuesIn(calls_to_execute));
 
+// Sets up a single-batch linear query for the cancellation tests below.
+class ExecGraphCancelTest : public ExecGraphTest {
+ protected:
+  void SetUp() override {
+    ExecGraphTest::SetUp();
+
+    planpb::PlanFragment pf_pb;
+    ASSERT_TRUE(TextFormat::MergeFromString(planpb::testutils::kLinearPlanFragment, &pf_pb));
+    plan_fragment_ = std::make_shared<plan::PlanFragment>(1);
+    ASSERT_OK(plan_fragment_->Init(pf_pb));
+
+    schema_ = std::make_shared<table_store::schema::Schema>();
+    schema_->AddRelation(
+        1, table_store::schema::Relation(
+               std::vector<types::DataType>(
+                   {types::DataType::INT64, types::DataType::BOOLEAN, types::DataType::FLOAT64}),
+               std::vector<std::string>({"a", "b", "c"})));
+
+    table_store::schema::Relation rel(
+        {types::DataType::INT64, types::DataType::BOOLEAN, types::DataType::FLOAT64},
+        {"col1", "col2", "col3"});
+    auto table = Table::Create("test", rel);
+    auto rb = RowBatch(RowDescriptor(rel.col_types()), 3);
+    std::vector<types::Int64Value> col1 = {1, 2, 3};
+    std::vector<types::BoolValue> col2 = {true, false, true};
+    std::vector<types::Float64Value> col3 = {1.4, 6.2, 10.2};
+    ASSERT_OK(rb.AddColumn(types::ToArrow(col1, arrow::default_memory_pool())));
+    ASSERT_OK(rb.AddColumn(types::ToArrow(col2, arrow::default_memory_pool())));
+    ASSERT_OK(rb.AddColumn(types::ToArrow(col3, arrow::default_memory_pool())));
+    ASSERT_OK(table->WriteRowBatch(rb));
+    exec_state_->table_store()->AddTable("numbers", table);
+
+    ASSERT_OK(exec_state_->AddScalarUDF(
+        0, "add",
+        std::vector<types::DataType>({types::DataType::INT64, types::DataType::FLOAT64})));
+    ASSERT_OK(exec_state_->AddScalarUDF(
+        1, "multiply",
+        std::vector<types::DataType>({types::DataType::FLOAT64, types::DataType::INT64})));
+
+    plan_state_ = std::make_unique<plan::PlanState>(func_registry_.get());
+  }
+
+  std::shared_ptr<table_store::schema::Schema> schema_;
+  std::unique_ptr<plan::PlanState> plan_state_;
+};
+
+// A tripped cancel token aborts execution with CANCELLED instead of running to completion.
+TEST_F(ExecGraphCancelTest, cancel_aborts_execution) {
+  ExecutionGraph e;
+  ASSERT_OK(e.Init(schema_.get(), plan_state_.get(), exec_state_.get(), plan_fragment_.get(),
+                   /* collect_exec_node_stats */ false));
+
+  exec_state_->Cancel("client disconnected");
+  auto s = e.Execute();
+  ASSERT_NOT_OK(s);
+  EXPECT_TRUE(error::IsCancelled(s));
+  // No output should have been produced.
+  EXPECT_EQ(nullptr, exec_state_->table_store()->GetTable("output"));
+}
+
+// An expired deadline aborts execution with DEADLINE_EXCEEDED and trips the cancel token.
+TEST_F(ExecGraphCancelTest, deadline_aborts_execution) {
+  ExecutionGraph e;
+  ASSERT_OK(e.Init(schema_.get(), plan_state_.get(), exec_state_.get(), plan_fragment_.get(),
+                   /* collect_exec_node_stats */ false));
+
+  exec_state_->set_deadline(std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+  auto s = e.Execute();
+  ASSERT_NOT_OK(s);
+  EXPECT_TRUE(error::IsDeadlineExceeded(s));
+  EXPECT_TRUE(exec_state_->cancelled());
+}
+
 TEST_F(ExecGraphTest, execute_time) {
   planpb::PlanFragment pf_pb;
   ASSERT_TRUE(TextFormat::MergeFromString(planpb::testutils::kLinearPlanFragment, &pf_pb));
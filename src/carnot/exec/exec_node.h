@@ -40,13 +40,24 @@ enum class ExecNodeType : int8_t {
 
 struct ExecNodeStats {
   explicit ExecNodeStats(bool collect_stats) : collect_exec_stats(collect_stats) {}
+
+  // Logical size of a batch. A batch carrying a selection vector shares its parent's physical
+  // columns, so NumBytes()/num_rows() reflect the unfiltered input; bytes are scaled by the
+  // selected fraction so stats track what the batch logically carries.
+  static int64_t LogicalNumBytes(const table_store::schema::RowBatch& rb) {
+    if (!rb.has_selection() || rb.num_rows() == 0) {
+      return rb.NumBytes();
+    }
+    return rb.NumBytes() * rb.num_selected_rows() / rb.num_rows();
+  }
+
   void AddOutputStats(const table_store::schema::RowBatch& rb) {
     if (!collect_exec_stats) {
       return;
     }
     ++batches_output;
-    bytes_output += rb.NumBytes();
-    rows_output += rb.num_rows();
+    bytes_output += LogicalNumBytes(rb);
+    rows_output += rb.num_selected_rows();
   }
 
   void AddInputStats(const table_store::schema::RowBatch& rb) {
@@ -54,8 +65,8 @@ struct ExecNodeStats {
       return;
     }
     ++batches_input;
-    bytes_input += rb.NumBytes();
-    rows_input += rb.num_rows();
+    bytes_input += LogicalNumBytes(rb);
+    rows_input += rb.num_selected_rows();
   }
 
   void ResumeChildTimer() {
@@ -194,8 +205,12 @@ class ExecNode {
   Status GenerateNext(ExecState* exec_state) {
     DCHECK(is_initialized_);
     DCHECK(type() == ExecNodeType::kSourceNode);
+    PL_RETURN_IF_ERROR(exec_state->CheckCancelled());
     stats_->ResumeTotalTimer();
-    PL_RETURN_IF_ERROR(GenerateNextImpl(exec_state));
+    {
+      px::profiler::HotPathSpan span("carnot.generate_next");
+      PL_RETURN_IF_ERROR(GenerateNextImpl(exec_state));
+    }
     stats_->StopTotalTimer();
     return Status::OK();
   }
@@ -218,9 +233,15 @@ class ExecNode {
       return error::Internal(
           "ConsumeNext received row batch with end of stream set but not end of window.");
     }
+    // Cancellation and deadline are checked at every batch boundary so that heavy operators
+    // (e.g. a join buffering its build side) abort promptly once the query is cancelled.
+    PL_RETURN_IF_ERROR(exec_state->CheckCancelled());
     stats_->AddInputStats(rb);
     stats_->ResumeTotalTimer();
-    PL_RETURN_IF_ERROR(ConsumeNextImpl(exec_state, rb, parent_index));
+    {
+      px::profiler::HotPathSpan span("carnot.consume_next");
+      PL_RETURN_IF_ERROR(ConsumeNextImpl(exec_state, rb, parent_index));
+    }
     stats_->StopTotalTimer();
     return Status::OK();
   }
@@ -240,6 +261,13 @@ class ExecNode {
    */
   bool IsProcessing() { return type() == ExecNodeType::kProcessingNode; }
 
+  /**
+   * Whether this node can consume row batches carrying a selection vector. Parents
+   * materialize selections before delivering batches to nodes that return false, so
+   * chains of selection-aware nodes (e.g. stacked filters) never copy column data.
+   */
+  virtual bool SupportsSelectionVectors() const { return false; }
+
   /**
    * Get a debug string for the node.
    * @return the debug string/
@@ -284,8 +312,19 @@ class ExecNode {
    */
   Status SendRowBatchToChildren(ExecState* exec_state, const table_store::schema::RowBatch& rb) {
     stats_->ResumeChildTimer();
+    // A batch carrying a selection vector is materialized at most once here, and only if some
+    // child cannot consume selections natively.
+    std::unique_ptr<table_store::schema::RowBatch> materialized;
     for (size_t i = 0; i < children_.size(); ++i) {
-      PL_RETURN_IF_ERROR(children_[i]->ConsumeNext(exec_state, rb, parent_ids_for_children_[i]));
+      const auto* out_rb = &rb;
+      if (rb.has_selection() && !children_[i]->SupportsSelectionVectors()) {
+        if (materialized == nullptr) {
+          PL_ASSIGN_OR_RETURN(materialized, rb.MaterializeSelection(exec_state->exec_mem_pool()));
+        }
+        out_rb = materialized.get();
+      }
+      PL_RETURN_IF_ERROR(
+          children_[i]->ConsumeNext(exec_state, *out_rb, parent_ids_for_children_[i]));
     }
     stats_->StopChildTimer();
     stats_->AddOutputStats(rb);
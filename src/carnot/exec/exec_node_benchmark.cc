@@ -0,0 +1,283 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <google/protobuf/text_format.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/agg_node.h"
+#include "src/carnot/exec/equijoin_node.h"
+#include "src/carnot/exec/exec_node_mock.h"
+#include "src/carnot/exec/map_node.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/planpb/test_proto.h"
+#include "src/carnot/udf/registry.h"
+#include "src/carnot/udf/udf.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+using px::carnot::exec::AggNode;
+using px::carnot::exec::EquijoinNode;
+using px::carnot::exec::ExecState;
+using px::carnot::exec::MapNode;
+using px::carnot::exec::MockExecNode;
+using px::carnot::exec::MockMetricsStubGenerator;
+using px::carnot::exec::MockResultSinkStubGenerator;
+using px::carnot::exec::MockTraceStubGenerator;
+using px::carnot::exec::RowBatchBuilder;
+using px::carnot::udf::FunctionContext;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::DataType;
+using px::types::Float64Value;
+using px::types::Int64Value;
+using px::types::Time64NSValue;
+
+namespace {
+
+class AddUDF : public px::carnot::udf::ScalarUDF {
+ public:
+  Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
+};
+
+class SumUDA : public px::carnot::udf::UDA {
+ public:
+  void Update(FunctionContext*, Int64Value arg) { sum_ = sum_.val + arg.val; }
+  void Merge(FunctionContext*, const SumUDA& other) { sum_ = sum_.val + other.sum_.val; }
+  Int64Value Finalize(FunctionContext*) { return sum_; }
+
+ protected:
+  Int64Value sum_ = 0;
+};
+
+constexpr char kGroupByAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "sum"
+    args {
+      column {
+        node: 0
+        index: 1
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+})";
+
+constexpr char kInnerJoin[] = R"(
+  type: INNER
+  equality_conditions {
+    left_column_index: 0
+    right_column_index: 1
+  }
+  output_columns: {
+    parent_index: 0
+    column_index: 1
+  }
+  output_columns: {
+    parent_index: 1
+    column_index: 0
+  }
+  column_names: "left_1"
+  column_names: "time_"
+  rows_per_batch: 1024
+)";
+
+std::unique_ptr<ExecState> MakeExecState(px::carnot::udf::Registry* registry) {
+  auto table_store = std::make_shared<px::table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(registry, table_store, MockResultSinkStubGenerator,
+                                                MockMetricsStubGenerator, MockTraceStubGenerator,
+                                                sole::uuid4(), nullptr);
+  exec_state->SetCurrentSource(1);
+  return exec_state;
+}
+
+// Runs an exec node over prebuilt input batches. Processing nodes keep per-query state, so
+// each iteration runs the full node lifecycle, like a query would.
+template <typename TNode>
+void RunNodeLifecycle(ExecState* exec_state, const px::carnot::plan::Operator& plan_node,
+                      const RowDescriptor& output_rd, const std::vector<RowDescriptor>& input_rds,
+                      const std::vector<std::pair<const RowBatch*, size_t>>& inputs) {
+  TNode node;
+  ::testing::NiceMock<MockExecNode> mock_child;
+  px::carnot::exec::FakePlanNode fake_plan(123);
+  node.AddChild(&mock_child, 0);
+  PL_CHECK_OK(node.Init(plan_node, output_rd, input_rds));
+  PL_CHECK_OK(node.Prepare(exec_state));
+  PL_CHECK_OK(node.Open(exec_state));
+  PL_CHECK_OK(mock_child.Init(fake_plan, RowDescriptor({}), {output_rd}));
+  PL_CHECK_OK(mock_child.Prepare(exec_state));
+  PL_CHECK_OK(mock_child.Open(exec_state));
+  for (const auto& [rb, parent_index] : inputs) {
+    PL_CHECK_OK(node.ConsumeNext(exec_state, *rb, parent_index));
+  }
+  PL_CHECK_OK(node.Close(exec_state));
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_AggNodeGroupBy(benchmark::State& state) {
+  const int64_t num_rows = 64 * 1024;
+  const int64_t num_groups = state.range(0);
+
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("bm_registry");
+  PL_CHECK_OK(func_registry->Register<SumUDA>("sum"));
+  auto exec_state = MakeExecState(func_registry.get());
+  PL_CHECK_OK(exec_state->AddUDA(0, "sum", std::vector<DataType>({DataType::INT64})));
+
+  px::carnot::planpb::Operator op_pb;
+  CHECK(google::protobuf::TextFormat::MergeFromString(kGroupByAgg, &op_pb));
+  auto plan_node = px::carnot::plan::AggregateOperator::FromProto(op_pb, 1);
+
+  RowDescriptor input_rd({DataType::INT64, DataType::INT64});
+  RowDescriptor output_rd({DataType::INT64, DataType::INT64});
+
+  std::vector<Int64Value> groups(num_rows);
+  std::vector<Int64Value> values(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    groups[i] = i % num_groups;
+    values[i] = i;
+  }
+  auto rb = RowBatchBuilder(input_rd, num_rows, /*eow*/ true, /*eos*/ true)
+                .AddColumn<Int64Value>(groups)
+                .AddColumn<Int64Value>(values)
+                .get();
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    RunNodeLifecycle<AggNode>(exec_state.get(), *plan_node, output_rd, {input_rd}, {{&rb, 0}});
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  state.SetBytesProcessed(state.iterations() * num_rows * 2 * sizeof(int64_t));
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_EquijoinNodeInner(benchmark::State& state) {
+  const int64_t num_probe_rows = 64 * 1024;
+  const int64_t num_build_rows = state.range(0);
+
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("bm_registry");
+  auto exec_state = MakeExecState(func_registry.get());
+
+  px::carnot::planpb::Operator op_pb;
+  auto op_proto = absl::Substitute(px::carnot::planpb::testutils::kOperatorProtoTmpl,
+                                   "JOIN_OPERATOR", "join_op", kInnerJoin);
+  CHECK(google::protobuf::TextFormat::MergeFromString(op_proto, &op_pb));
+  auto plan_node = px::carnot::plan::JoinOperator::FromProto(op_pb, 1);
+
+  RowDescriptor build_rd({DataType::INT64, DataType::FLOAT64});
+  RowDescriptor probe_rd({DataType::TIME64NS, DataType::INT64});
+  RowDescriptor output_rd({DataType::FLOAT64, DataType::TIME64NS});
+
+  std::vector<Int64Value> build_keys(num_build_rows);
+  std::vector<Float64Value> build_values(num_build_rows);
+  for (int64_t i = 0; i < num_build_rows; ++i) {
+    build_keys[i] = i;
+    build_values[i] = static_cast<double>(i);
+  }
+  auto build_rb = RowBatchBuilder(build_rd, num_build_rows, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<Int64Value>(build_keys)
+                      .AddColumn<Float64Value>(build_values)
+                      .get();
+
+  // Every probe row matches exactly one build row.
+  std::vector<Time64NSValue> probe_times(num_probe_rows);
+  std::vector<Int64Value> probe_keys(num_probe_rows);
+  for (int64_t i = 0; i < num_probe_rows; ++i) {
+    probe_times[i] = i;
+    probe_keys[i] = i % num_build_rows;
+  }
+  auto probe_rb = RowBatchBuilder(probe_rd, num_probe_rows, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<Time64NSValue>(probe_times)
+                      .AddColumn<Int64Value>(probe_keys)
+                      .get();
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    RunNodeLifecycle<EquijoinNode>(exec_state.get(), *plan_node, output_rd, {build_rd, probe_rd},
+                                   {{&build_rb, 0}, {&probe_rb, 1}});
+  }
+  state.SetItemsProcessed(state.iterations() * num_probe_rows);
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_MapNodeAddTwoCols(benchmark::State& state) {
+  const int64_t num_rows = state.range(0);
+
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("bm_registry");
+  PL_CHECK_OK(func_registry->Register<AddUDF>("add"));
+  auto exec_state = MakeExecState(func_registry.get());
+  PL_CHECK_OK(exec_state->AddScalarUDF(
+      0, "add", std::vector<DataType>({DataType::INT64, DataType::INT64})));
+
+  auto op_pb = px::carnot::planpb::testutils::CreateTestMapAddTwoCols();
+  auto plan_node = px::carnot::plan::MapOperator::FromProto(op_pb, 1);
+
+  RowDescriptor input_rd({DataType::INT64, DataType::INT64});
+  RowDescriptor output_rd({DataType::INT64});
+
+  std::vector<Int64Value> in1(num_rows);
+  std::vector<Int64Value> in2(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    in1[i] = i;
+    in2[i] = num_rows - i;
+  }
+  auto rb = RowBatchBuilder(input_rd, num_rows, /*eow*/ false, /*eos*/ false)
+                .AddColumn<Int64Value>(in1)
+                .AddColumn<Int64Value>(in2)
+                .get();
+
+  // MapNode is stateless across batches, so the node is set up once and each iteration
+  // measures a single batch's evaluation.
+  MapNode node;
+  ::testing::NiceMock<MockExecNode> mock_child;
+  px::carnot::exec::FakePlanNode fake_plan(123);
+  node.AddChild(&mock_child, 0);
+  PL_CHECK_OK(node.Init(*plan_node, output_rd, {}));
+  PL_CHECK_OK(node.Prepare(exec_state.get()));
+  PL_CHECK_OK(node.Open(exec_state.get()));
+  PL_CHECK_OK(mock_child.Init(fake_plan, RowDescriptor({}), {output_rd}));
+  PL_CHECK_OK(mock_child.Prepare(exec_state.get()));
+  PL_CHECK_OK(mock_child.Open(exec_state.get()));
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    PL_CHECK_OK(node.ConsumeNext(exec_state.get(), rb, 0));
+  }
+  PL_CHECK_OK(node.Close(exec_state.get()));
+
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  state.SetBytesProcessed(state.iterations() * num_rows * 2 * sizeof(int64_t));
+}
+
+BENCHMARK(BM_AggNodeGroupBy)->RangeMultiplier(8)->Range(16, 1 << 13);
+BENCHMARK(BM_EquijoinNodeInner)->RangeMultiplier(8)->Range(16, 1 << 13);
+BENCHMARK(BM_MapNodeAddTwoCols)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
@@ -20,8 +20,11 @@
 
 #include <arrow/memory_pool.h>
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,6 +34,7 @@
 #include "src/carnot/carnotpb/carnot.pb.h"
 #include "src/carnot/exec/grpc_router.h"
 #include "src/carnot/exec/ml/model_pool.h"
+#include "src/carnot/exec/query_memory_pool.h"
 #include "src/carnot/udf/registry.h"
 #include "src/common/base/base.h"
 #include "src/shared/metadata/metadata_state.h"
@@ -44,6 +48,9 @@ namespace px {
 namespace carnot {
 namespace exec {
 
+class MorselExecutor;
+class TaskExecutor;
+
 using ResultSinkStubGenerator =
     std::function<std::unique_ptr<carnotpb::ResultSinkService::StubInterface>(
         const std::string& address, const std::string& ssl_targetname)>;
@@ -55,8 +62,9 @@ using TraceStubGenerator = std::function<
         const std::string& address, bool insecure)>;
 
 /**
- * ExecState manages the execution state for a single query. A new one will
- * be constructed for every query executed in Carnot and it will not be reused.
+ * ExecState manages the execution state for a single query. A new one is constructed for
+ * every query executed in Carnot, except for standing queries, which reuse the state across
+ * executions (see ResetForNextExecution).
  *
  * The purpose of this class is to keep track of resources required for the query
  * and provide common resources (UDFs, UDA, etc) the operators within the query.
@@ -79,20 +87,42 @@ class ExecState {
         query_id_(query_id),
         model_pool_(model_pool),
         grpc_router_(grpc_router),
-        add_auth_to_grpc_client_context_func_(add_auth_func) {}
+        add_auth_to_grpc_client_context_func_(add_auth_func),
+        query_mem_pool_(arrow::default_memory_pool(), FLAGS_query_memory_limit_bytes) {}
 
   ~ExecState() {
     if (grpc_router_ != nullptr) {
       grpc_router_->DeleteQuery(query_id_);
     }
   }
-  arrow::MemoryPool* exec_mem_pool() {
-    // TOOD(zasgar): Make this the correct pool.
-    return arrow::default_memory_pool();
-  }
+  // The query-scoped memory pool. All exec-node arrow allocations should go through this pool so
+  // they count against the query's memory budget.
+  arrow::MemoryPool* exec_mem_pool() { return &query_mem_pool_; }
+
+  const QueryMemoryPool& query_mem_pool() const { return query_mem_pool_; }
 
   udf::Registry* func_registry() { return func_registry_; }
 
+  // Prepares this state for the next execution of a standing query: re-keys the state to the
+  // new query id and clears the per-execution source bookkeeping. UDF/UDA bindings, client
+  // stubs, and the warmed query memory pool are kept.
+  void ResetForNextExecution(const sole::uuid& query_id) {
+    if (grpc_router_ != nullptr) {
+      grpc_router_->DeleteQuery(query_id_);
+    }
+    query_id_ = query_id;
+    metadata_state_.reset();
+    current_source_ = 0;
+    current_source_set_ = false;
+    all_sources_stopped_ = false;
+    source_id_to_keep_running_map_.clear();
+    cancelled_.store(false, std::memory_order_release);
+    cancel_reason_.clear();
+    has_deadline_ = false;
+    capture_result_batches_ = false;
+    captured_result_batches_.clear();
+  }
+
   table_store::TableStore* table_store() { return table_store_.get(); }
 
   const sole::uuid& query_id() const { return query_id_; }
@@ -170,11 +200,71 @@ class ExecState {
 
   // A node (ie. Limit) can call this method to say no more records will be processed for this
   // source. That node is responsible for setting eos.
-  void StopSource(int64_t src_id) { source_id_to_keep_running_map_[src_id] = false; }
+  void StopSource(int64_t src_id) {
+    source_id_to_keep_running_map_[src_id] = false;
+    // If this is a GRPC source, cancel its incoming result streams so that upstream agents stop
+    // scanning and shipping batches for it. No-op for local sources.
+    if (grpc_router_ != nullptr) {
+      grpc_router_->CancelSourceStreams(query_id_, src_id);
+    }
+  }
+
+  // Called when a downstream consumer (e.g. the remote destination of a GRPC sink) signals that
+  // it needs no more records. Stops every source in the graph.
+  void StopAllSources() {
+    all_sources_stopped_ = true;
+    for (auto& [src_id, keep_running] : source_id_to_keep_running_map_) {
+      keep_running = false;
+    }
+  }
+
+  // Cooperatively cancels the query: trips the cancel token that every exec node checks at
+  // batch boundaries, and tears down the query's incoming result streams so upstream agents
+  // abort their fragments instead of continuing to scan and ship data. Safe to call from any
+  // thread; only the first call's reason is kept.
+  void Cancel(std::string reason) {
+    {
+      std::lock_guard<std::mutex> lock(cancel_reason_lock_);
+      if (cancelled_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      cancel_reason_ = std::move(reason);
+    }
+    cancelled_.store(true, std::memory_order_release);
+    if (grpc_router_ != nullptr) {
+      grpc_router_->CancelQuery(query_id_, cancel_reason_);
+    }
+  }
+
+  bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+  // Sets the wall-clock deadline for the query as a whole. Execution past the deadline fails
+  // with DEADLINE_EXCEEDED at the next batch boundary.
+  void set_deadline(std::chrono::steady_clock::time_point deadline) {
+    deadline_ = deadline;
+    has_deadline_ = true;
+  }
+  bool has_deadline() const { return has_deadline_; }
+
+  // Returns an error if the query has been cancelled or has passed its deadline. Checked at
+  // batch boundaries by every exec node (see ExecNode::GenerateNext/ConsumeNext) so that
+  // long-running operators abort promptly and release their state instead of running the
+  // query to completion.
+  Status CheckCancelled() {
+    if (cancelled_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(cancel_reason_lock_);
+      return error::Cancelled("Query $0 cancelled: $1", query_id_.str(), cancel_reason_);
+    }
+    if (has_deadline_ && std::chrono::steady_clock::now() >= deadline_) {
+      Cancel("query deadline exceeded");
+      return error::DeadlineExceeded("Query $0 exceeded its deadline", query_id_.str());
+    }
+    return Status::OK();
+  }
 
   bool keep_running() {
     DCHECK(current_source_set_);
-    return source_id_to_keep_running_map_[current_source_];
+    return !all_sources_stopped_ && source_id_to_keep_running_map_[current_source_];
   }
 
   void SetCurrentSource(int64_t source_id) {
@@ -192,6 +282,40 @@ class ExecState {
 
   GRPCRouter* grpc_router() { return grpc_router_; }
 
+  // GRPC source nodes that are part of this query's plan on this agent. A GRPC sink whose
+  // destination is one of these is sending to a fragment in the same process, and can hand row
+  // batches over directly instead of going through the gRPC stack.
+  void AddLocalGRPCSourceID(int64_t source_id) { local_grpc_source_ids_.insert(source_id); }
+  bool IsLocalGRPCSourceID(int64_t source_id) const {
+    return local_grpc_source_ids_.contains(source_id);
+  }
+
+  // When capture is enabled, memory sinks record the row batches they write, keyed by table
+  // name, so the caller can insert them into the query result cache after a successful run
+  // (see CarnotImpl::ExecutePlan).
+  void EnableResultCapture() { capture_result_batches_ = true; }
+  bool result_capture_enabled() const { return capture_result_batches_; }
+  void CaptureResultBatch(const std::string& table_name,
+                          std::shared_ptr<const table_store::schema::RowBatch> batch) {
+    captured_result_batches_[table_name].push_back(std::move(batch));
+  }
+  const absl::flat_hash_map<std::string,
+                            std::vector<std::shared_ptr<const table_store::schema::RowBatch>>>&
+  captured_result_batches() const {
+    return captured_result_batches_;
+  }
+
+  // The morsel executor used for intra-batch parallelism, if parallel execution is enabled.
+  // May be nullptr, in which case exec nodes must run single-threaded.
+  MorselExecutor* morsel_executor() { return morsel_executor_; }
+  void set_morsel_executor(MorselExecutor* morsel_executor) { morsel_executor_ = morsel_executor; }
+
+  // The shared task executor, for parallel work that isn't row-range shaped (e.g. per-partition
+  // tasks). May be nullptr. Groups created for this query should pass its cancel token:
+  // task_executor()->CreateTaskGroup([this] { return cancelled(); }).
+  TaskExecutor* task_executor() { return task_executor_; }
+  void set_task_executor(TaskExecutor* task_executor) { task_executor_ = task_executor; }
+
   void AddAuthToGRPCClientContext(grpc::ClientContext* ctx) {
     CHECK(add_auth_to_grpc_client_context_func_);
     add_auth_to_grpc_client_context_func_(ctx);
@@ -206,14 +330,34 @@ class ExecState {
   const TraceStubGenerator trace_stub_generator_;
   std::map<int64_t, udf::ScalarUDFDefinition*> id_to_scalar_udf_map_;
   std::map<int64_t, udf::UDADefinition*> id_to_uda_map_;
-  const sole::uuid query_id_;
+  // Non-const: standing queries reuse the state across executions via ResetForNextExecution.
+  sole::uuid query_id_;
   ml::ModelPool* model_pool_;
   GRPCRouter* grpc_router_ = nullptr;
+  MorselExecutor* morsel_executor_ = nullptr;
+  TaskExecutor* task_executor_ = nullptr;
   std::function<void(grpc::ClientContext*)> add_auth_to_grpc_client_context_func_;
 
+  QueryMemoryPool query_mem_pool_;
+
+  // Cancellation token, set by Cancel() and read by CheckCancelled() at batch boundaries.
+  // The reason is written once, under cancel_reason_lock_, before the token is tripped.
+  std::atomic<bool> cancelled_{false};
+  std::string cancel_reason_;
+  std::mutex cancel_reason_lock_;
+  std::chrono::steady_clock::time_point deadline_;
+  bool has_deadline_ = false;
+
   int64_t current_source_ = 0;
   bool current_source_set_ = false;
+  bool all_sources_stopped_ = false;
   std::map<int64_t, bool> source_id_to_keep_running_map_;
+  absl::flat_hash_set<int64_t> local_grpc_source_ids_;
+
+  bool capture_result_batches_ = false;
+  absl::flat_hash_map<std::string,
+                      std::vector<std::shared_ptr<const table_store::schema::RowBatch>>>
+      captured_result_batches_;
 
   std::vector<std::unique_ptr<carnotpb::ResultSinkService::StubInterface>> result_sink_stubs_pool_;
   // Mapping of remote address to stub that serves that address.
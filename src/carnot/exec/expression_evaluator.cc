@@ -26,12 +26,17 @@
 #include <iterator>
 #include <memory>
 #include <ostream>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include <absl/base/internal/spinlock.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/strings/str_join.h>
 #include <absl/strings/substitute.h>
 
 #include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/morsel_executor.h"
 #include "src/carnot/udf/udf_definition.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/types.h"
@@ -66,6 +71,10 @@ std::unique_ptr<ScalarExpressionEvaluator> ScalarExpressionEvaluator::Create(
       return std::make_unique<VectorNativeScalarExpressionEvaluator>(expressions, function_ctx);
     case ScalarExpressionEvaluatorType::kArrowNative:
       return std::make_unique<ArrowNativeScalarExpressionEvaluator>(expressions, function_ctx);
+    case ScalarExpressionEvaluatorType::kSIMDNative:
+      return std::make_unique<SIMDNativeScalarExpressionEvaluator>(expressions, function_ctx);
+    case ScalarExpressionEvaluatorType::kCompiled:
+      return std::make_unique<CompiledScalarExpressionEvaluator>(expressions, function_ctx);
     default:
       CHECK(0) << "Unknown expression type";
   }
@@ -139,6 +148,11 @@ Status ScalarExpressionEvaluator::Evaluate(ExecState* exec_state, const RowBatch
   CHECK(output != nullptr);
   CHECK_EQ(static_cast<size_t>(output->num_columns()), expressions_.size());
 
+  if (function_ctx_ != nullptr) {
+    // The previous batch's results have been copied into its output columns by now, so its
+    // string scratch allocations can all be dropped in one step.
+    function_ctx_->string_arena()->Reset();
+  }
   for (const auto& expression : expressions_) {
     PL_RETURN_IF_ERROR(EvaluateSingleExpression(exec_state, input, *expression, output));
   }
@@ -268,8 +282,7 @@ Status VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
     return Status::OK();
   }
 
-  PL_ASSIGN_OR_RETURN(auto result, VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
-                                       exec_state, input, expr));
+  PL_ASSIGN_OR_RETURN(auto result, EvaluateSingleExpression(exec_state, input, expr));
   PL_RETURN_IF_ERROR(output->AddColumn(result->ConvertToArrow(exec_state->exec_mem_pool())));
   return Status::OK();
 }
@@ -320,7 +333,7 @@ Status exec::ArrowNativeScalarExpressionEvaluator::EvaluateSingleExpression(
         auto def = exec_state->GetScalarUDFDefinition(fn.udf_id());
         auto udf = id_to_udf_map_[fn.udf_id()].get();
 
-        auto output = MakeArrowBuilder(def->exec_return_type(), arrow::default_memory_pool());
+        auto output = MakeArrowBuilder(def->exec_return_type(), exec_state->exec_mem_pool());
 
         std::vector<arrow::Array*> raw_children;
         raw_children.reserve(children.size());
@@ -341,6 +354,437 @@ Status exec::ArrowNativeScalarExpressionEvaluator::EvaluateSingleExpression(
   return Status::OK();
 }
 
+namespace {
+
+// Columnar kernels for the hot arithmetic/comparison/boolean UDFs in builtins/math_ops.h.
+// Each kernel is a branch-free loop over the raw column data so the compiler can
+// auto-vectorize it (AVX2/NEON). Kernels are keyed by (udf name, argument types).
+
+template <typename TIn, typename TOut, typename Op>
+SharedColumnWrapper BinarySIMDKernel(MorselExecutor* morsel_executor, const ColumnWrapper& lhs,
+                                     const ColumnWrapper& rhs, size_t num_rows, Op op) {
+  auto output = std::make_shared<types::ColumnWrapperTmpl<TOut>>(num_rows);
+  const TIn* lhs_data = static_cast<const types::ColumnWrapperTmpl<TIn>&>(lhs).UnsafeRawData();
+  const TIn* rhs_data = static_cast<const types::ColumnWrapperTmpl<TIn>&>(rhs).UnsafeRawData();
+  TOut* out_data = output->UnsafeRawData();
+  auto run_range = [&](size_t start, size_t count) {
+    for (size_t i = start; i < start + count; ++i) {
+      out_data[i] = op(lhs_data[i].val, rhs_data[i].val);
+    }
+  };
+  if (morsel_executor != nullptr) {
+    // The kernel writes disjoint row ranges, so morsels can run concurrently.
+    morsel_executor->ParallelFor(num_rows, kDefaultMorselSizeRows, run_range);
+  } else {
+    run_range(0, num_rows);
+  }
+  return output;
+}
+
+template <typename TIn>
+SharedColumnWrapper DispatchBinarySIMDKernel(MorselExecutor* morsel_executor,
+                                             const std::string& name, const ColumnWrapper& lhs,
+                                             const ColumnWrapper& rhs, size_t num_rows) {
+  using ValType = decltype(std::declval<TIn>().val);
+  if (name == "add") {
+    return BinarySIMDKernel<TIn, TIn>(morsel_executor, lhs, rhs, num_rows,
+                                      [](ValType a, ValType b) { return a + b; });
+  }
+  if (name == "subtract") {
+    return BinarySIMDKernel<TIn, TIn>(morsel_executor, lhs, rhs, num_rows,
+                                      [](ValType a, ValType b) { return a - b; });
+  }
+  if (name == "multiply") {
+    return BinarySIMDKernel<TIn, TIn>(morsel_executor, lhs, rhs, num_rows,
+                                      [](ValType a, ValType b) { return a * b; });
+  }
+  if (name == "equal") {
+    return BinarySIMDKernel<TIn, types::BoolValue>(morsel_executor, lhs, rhs, num_rows,
+                                                   [](ValType a, ValType b) { return a == b; });
+  }
+  if (name == "notEqual") {
+    return BinarySIMDKernel<TIn, types::BoolValue>(morsel_executor, lhs, rhs, num_rows,
+                                                   [](ValType a, ValType b) { return a != b; });
+  }
+  if (name == "lessThan") {
+    return BinarySIMDKernel<TIn, types::BoolValue>(morsel_executor, lhs, rhs, num_rows,
+                                                   [](ValType a, ValType b) { return a < b; });
+  }
+  if (name == "lessThanEqual") {
+    return BinarySIMDKernel<TIn, types::BoolValue>(morsel_executor, lhs, rhs, num_rows,
+                                                   [](ValType a, ValType b) { return a <= b; });
+  }
+  if (name == "greaterThan") {
+    return BinarySIMDKernel<TIn, types::BoolValue>(morsel_executor, lhs, rhs, num_rows,
+                                                   [](ValType a, ValType b) { return a > b; });
+  }
+  if (name == "greaterThanEqual") {
+    return BinarySIMDKernel<TIn, types::BoolValue>(morsel_executor, lhs, rhs, num_rows,
+                                                   [](ValType a, ValType b) { return a >= b; });
+  }
+  return nullptr;
+}
+
+SharedColumnWrapper DispatchBooleanSIMDKernel(MorselExecutor* morsel_executor,
+                                              const std::string& name, const ColumnWrapper& lhs,
+                                              const ColumnWrapper& rhs, size_t num_rows) {
+  if (name == "logicalAnd") {
+    return BinarySIMDKernel<types::BoolValue, types::BoolValue>(
+        morsel_executor, lhs, rhs, num_rows, [](bool a, bool b) { return a && b; });
+  }
+  if (name == "logicalOr") {
+    return BinarySIMDKernel<types::BoolValue, types::BoolValue>(
+        morsel_executor, lhs, rhs, num_rows, [](bool a, bool b) { return a || b; });
+  }
+  if (name == "equal") {
+    return BinarySIMDKernel<types::BoolValue, types::BoolValue>(
+        morsel_executor, lhs, rhs, num_rows, [](bool a, bool b) { return a == b; });
+  }
+  if (name == "notEqual") {
+    return BinarySIMDKernel<types::BoolValue, types::BoolValue>(
+        morsel_executor, lhs, rhs, num_rows, [](bool a, bool b) { return a != b; });
+  }
+  return nullptr;
+}
+
+// Attempts to evaluate the function with a columnar kernel. Returns nullptr if no kernel
+// matches the (name, argument types) pair; the caller is responsible for falling back.
+SharedColumnWrapper TryEvalSIMDKernel(MorselExecutor* morsel_executor, const std::string& name,
+                                      const std::vector<SharedColumnWrapper>& children,
+                                      size_t num_rows) {
+  if (children.size() == 1 && name == "not" && children[0]->data_type() == types::BOOLEAN) {
+    auto output = std::make_shared<BoolValueColumnWrapper>(num_rows);
+    const auto* in_data =
+        static_cast<const BoolValueColumnWrapper&>(*children[0]).UnsafeRawData();
+    auto* out_data = output->UnsafeRawData();
+    for (size_t i = 0; i < num_rows; ++i) {
+      out_data[i] = !in_data[i].val;
+    }
+    return output;
+  }
+  if (children.size() != 2 || children[0]->data_type() != children[1]->data_type()) {
+    return nullptr;
+  }
+  switch (children[0]->data_type()) {
+    case types::INT64:
+      return DispatchBinarySIMDKernel<types::Int64Value>(morsel_executor, name, *children[0],
+                                                         *children[1], num_rows);
+    case types::FLOAT64:
+      return DispatchBinarySIMDKernel<types::Float64Value>(morsel_executor, name, *children[0],
+                                                           *children[1], num_rows);
+    case types::BOOLEAN:
+      return DispatchBooleanSIMDKernel(morsel_executor, name, *children[0], *children[1],
+                                       num_rows);
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+bool SIMDNativeScalarExpressionEvaluator::HasSIMDKernel(
+    const std::string& name, const std::vector<types::DataType>& arg_types) {
+  if (arg_types.size() == 1) {
+    return name == "not" && arg_types[0] == types::BOOLEAN;
+  }
+  if (arg_types.size() != 2 || arg_types[0] != arg_types[1]) {
+    return false;
+  }
+  switch (arg_types[0]) {
+    case types::INT64:
+    case types::FLOAT64:
+      return name == "add" || name == "subtract" || name == "multiply" || name == "equal" ||
+             name == "notEqual" || name == "lessThan" || name == "lessThanEqual" ||
+             name == "greaterThan" || name == "greaterThanEqual";
+    case types::BOOLEAN:
+      return name == "logicalAnd" || name == "logicalOr" || name == "equal" || name == "notEqual";
+    default:
+      return false;
+  }
+}
+
+StatusOr<types::SharedColumnWrapper>
+SIMDNativeScalarExpressionEvaluator::EvaluateSingleExpression(ExecState* exec_state,
+                                                              const RowBatch& input,
+                                                              const plan::ScalarExpression& expr) {
+  CHECK(exec_state != nullptr);
+  CHECK_GT(input.num_columns(), 0);
+
+  size_t num_rows = input.num_rows();
+
+  plan::ExpressionWalker<types::SharedColumnWrapper> walker;
+  walker.OnScalarValue(
+      [&](const plan::ScalarValue& val,
+          const std::vector<types::SharedColumnWrapper>& children) -> types::SharedColumnWrapper {
+        DCHECK_EQ(children.size(), 0ULL);
+        return EvalScalarToColumnWrapper(exec_state, val, num_rows);
+      });
+
+  walker.OnColumn(
+      [&](const plan::Column& col,
+          const std::vector<types::SharedColumnWrapper>& children) -> types::SharedColumnWrapper {
+        DCHECK_EQ(children.size(), 0ULL);
+        return ColumnWrapper::FromArrow(input.ColumnAt(col.Index()));
+      });
+
+  walker.OnScalarFunc(
+      [&](const plan::ScalarFunc& fn,
+          const std::vector<types::SharedColumnWrapper>& children) -> types::SharedColumnWrapper {
+        auto simd_output =
+            TryEvalSIMDKernel(exec_state->morsel_executor(), fn.name(), children, num_rows);
+        if (simd_output != nullptr) {
+          return simd_output;
+        }
+        // No kernel for this UDF; fall back to the virtual ExecBatch dispatch.
+        auto def = exec_state->GetScalarUDFDefinition(fn.udf_id());
+        auto udf = id_to_udf_map_[fn.udf_id()].get();
+
+        std::vector<const types::ColumnWrapper*> raw_children;
+        raw_children.reserve(children.size());
+        for (const auto& child : children) {
+          raw_children.emplace_back(child.get());
+        }
+        auto output = types::ColumnWrapper::Make(def->exec_return_type(), num_rows);
+        PL_CHECK_OK(def->ExecBatch(udf, function_ctx_, raw_children, output.get(), num_rows));
+        return output;
+      });
+
+  return walker.Walk(expr);
+}
+
+namespace {
+
+// Builds a deterministic fingerprint for an expression tree. Unlike DebugString, the fingerprint
+// includes UDF ids and init arguments so that same-named functions with different registrations
+// or init values don't collide in the program cache.
+std::string ExpressionFingerprint(const plan::ScalarExpression& expr) {
+  switch (expr.ExpressionType()) {
+    case plan::Expression::kConstant:
+      return absl::Substitute("c<$0>", static_cast<const plan::ScalarValue&>(expr).DebugString());
+    case plan::Expression::kColumn: {
+      const auto& col = static_cast<const plan::Column&>(expr);
+      return absl::Substitute("col<$0,$1>", col.NodeID(), col.Index());
+    }
+    case plan::Expression::kFunc: {
+      const auto& fn = static_cast<const plan::ScalarFunc&>(expr);
+      std::vector<std::string> arg_strs;
+      for (const auto* dep : fn.Deps()) {
+        arg_strs.push_back(ExpressionFingerprint(*dep));
+      }
+      std::vector<std::string> init_strs;
+      for (const auto& init_arg : fn.init_arguments()) {
+        init_strs.push_back(init_arg.DebugString());
+      }
+      return absl::Substitute("fn<$0:$1>[$2]($3)", fn.udf_id(), fn.name(),
+                              absl::StrJoin(init_strs, ","), absl::StrJoin(arg_strs, ","));
+    }
+    default:
+      CHECK(0) << "Unsupported expression type for compilation";
+  }
+}
+
+// Process-wide cache of compiled programs, keyed by expression fingerprint. Standing scripts
+// re-run the same expressions on every execution, so the cache stays small; the cap just bounds
+// memory if a deployment runs an unusually large variety of one-off queries.
+constexpr size_t kMaxCachedPrograms = 1024;
+absl::base_internal::SpinLock g_program_cache_lock;
+absl::flat_hash_map<std::string,
+                    std::shared_ptr<const CompiledScalarExpressionEvaluator::Program>>*
+    g_program_cache = nullptr;
+
+}  // namespace
+
+StatusOr<std::shared_ptr<const CompiledScalarExpressionEvaluator::Program>>
+CompiledScalarExpressionEvaluator::CompileOrLookup(const plan::ScalarExpression& expr) {
+  std::string fingerprint = ExpressionFingerprint(expr);
+  {
+    absl::base_internal::SpinLockHolder lock(&g_program_cache_lock);
+    if (g_program_cache != nullptr) {
+      auto it = g_program_cache->find(fingerprint);
+      if (it != g_program_cache->end()) {
+        return it->second;
+      }
+    }
+  }
+
+  auto program = std::make_shared<Program>();
+  // Duplicate subtrees within the expression share a slot: the first occurrence emits the
+  // steps, later occurrences just reference its output slot.
+  absl::flat_hash_map<std::string, size_t> fp_to_slot;
+  plan::ExpressionWalker<size_t> walker;
+  walker.OnScalarValue([&](const plan::ScalarValue& val, const std::vector<size_t>&) -> size_t {
+    std::string fp = ExpressionFingerprint(val);
+    auto it = fp_to_slot.find(fp);
+    if (it != fp_to_slot.end()) {
+      return it->second;
+    }
+    Step step;
+    step.kind = Step::Kind::kConstant;
+    step.fingerprint = fp;
+    step.constant = std::make_shared<const plan::ScalarValue>(val);
+    step.out_slot = program->num_slots++;
+    program->steps.push_back(std::move(step));
+    fp_to_slot.emplace(std::move(fp), program->steps.back().out_slot);
+    return program->steps.back().out_slot;
+  });
+  walker.OnColumn([&](const plan::Column& col, const std::vector<size_t>&) -> size_t {
+    std::string fp = ExpressionFingerprint(col);
+    auto it = fp_to_slot.find(fp);
+    if (it != fp_to_slot.end()) {
+      return it->second;
+    }
+    Step step;
+    step.kind = Step::Kind::kColumn;
+    step.fingerprint = fp;
+    step.col_index = col.Index();
+    step.out_slot = program->num_slots++;
+    program->steps.push_back(std::move(step));
+    fp_to_slot.emplace(std::move(fp), program->steps.back().out_slot);
+    return program->steps.back().out_slot;
+  });
+  walker.OnScalarFunc([&](const plan::ScalarFunc& fn, const std::vector<size_t>& children) -> size_t {
+    std::string fp = ExpressionFingerprint(fn);
+    auto it = fp_to_slot.find(fp);
+    if (it != fp_to_slot.end()) {
+      return it->second;
+    }
+    Step step;
+    step.kind = Step::Kind::kScalarFunc;
+    step.fingerprint = fp;
+    step.udf_id = fn.udf_id();
+    step.udf_name = fn.name();
+    step.arg_slots = children;
+    step.out_slot = program->num_slots++;
+    program->steps.push_back(std::move(step));
+    fp_to_slot.emplace(std::move(fp), program->steps.back().out_slot);
+    return program->steps.back().out_slot;
+  });
+  PL_RETURN_IF_ERROR(walker.Walk(expr).status());
+
+  std::shared_ptr<const Program> const_program = std::move(program);
+  {
+    absl::base_internal::SpinLockHolder lock(&g_program_cache_lock);
+    if (g_program_cache == nullptr) {
+      g_program_cache = new absl::flat_hash_map<std::string, std::shared_ptr<const Program>>();
+    }
+    if (g_program_cache->size() < kMaxCachedPrograms) {
+      g_program_cache->emplace(std::move(fingerprint), const_program);
+    }
+  }
+  return const_program;
+}
+
+Status CompiledScalarExpressionEvaluator::Evaluate(ExecState* exec_state, const RowBatch& input,
+                                                   RowBatch* output) {
+  // The memo is only valid for the duration of one batch: it holds columns computed from this
+  // batch's rows, so it must not survive into the next call.
+  batch_memo_.clear();
+  batch_memo_active_ = true;
+  auto s = ScalarExpressionEvaluator::Evaluate(exec_state, input, output);
+  batch_memo_active_ = false;
+  batch_memo_.clear();
+  return s;
+}
+
+Status CompiledScalarExpressionEvaluator::Open(ExecState* exec_state) {
+  PL_RETURN_IF_ERROR(SIMDNativeScalarExpressionEvaluator::Open(exec_state));
+  // Compile (or fetch the cached program for) every expression up front, and bind this query's
+  // UDF instances to each program, so Evaluate does no per-batch setup.
+  for (const auto& expr : expressions_) {
+    PL_RETURN_IF_ERROR(BindProgram(exec_state, *expr).status());
+  }
+  return Status::OK();
+}
+
+StatusOr<const CompiledScalarExpressionEvaluator::BoundProgram*>
+CompiledScalarExpressionEvaluator::BindProgram(ExecState* exec_state,
+                                               const plan::ScalarExpression& expr) {
+  auto it = bound_programs_.find(&expr);
+  if (it != bound_programs_.end()) {
+    return &it->second;
+  }
+
+  PL_ASSIGN_OR_RETURN(auto program, CompileOrLookup(expr));
+  BoundProgram bound;
+  bound.program = program;
+  bound.defs.resize(program->steps.size(), nullptr);
+  bound.udfs.resize(program->steps.size(), nullptr);
+  for (const auto& [step_idx, step] : Enumerate(program->steps)) {
+    if (step.kind != Step::Kind::kScalarFunc) {
+      continue;
+    }
+    bound.defs[step_idx] = exec_state->GetScalarUDFDefinition(step.udf_id);
+    auto udf_it = id_to_udf_map_.find(step.udf_id);
+    if (udf_it == id_to_udf_map_.end()) {
+      return error::NotFound("No UDF instance found for id '$0'", step.udf_id);
+    }
+    bound.udfs[step_idx] = udf_it->second.get();
+  }
+  auto [inserted_it, unused] = bound_programs_.emplace(&expr, std::move(bound));
+  PL_UNUSED(unused);
+  return &inserted_it->second;
+}
+
+StatusOr<types::SharedColumnWrapper> CompiledScalarExpressionEvaluator::EvaluateSingleExpression(
+    ExecState* exec_state, const RowBatch& input, const plan::ScalarExpression& expr) {
+  CHECK(exec_state != nullptr);
+  CHECK_GT(input.num_columns(), 0);
+
+  size_t num_rows = input.num_rows();
+  PL_ASSIGN_OR_RETURN(const BoundProgram* bound, BindProgram(exec_state, expr));
+  const Program& program = *bound->program;
+
+  std::vector<types::SharedColumnWrapper> slots(program.num_slots);
+  std::vector<SharedColumnWrapper> args;
+  for (const auto& [step_idx, step] : Enumerate(program.steps)) {
+    switch (step.kind) {
+      case Step::Kind::kConstant:
+        slots[step.out_slot] = EvalScalarToColumnWrapper(exec_state, *step.constant, num_rows);
+        break;
+      case Step::Kind::kColumn:
+        slots[step.out_slot] = ColumnWrapper::FromArrow(input.ColumnAt(step.col_index));
+        break;
+      case Step::Kind::kScalarFunc: {
+        if (batch_memo_active_) {
+          auto memo_it = batch_memo_.find(step.fingerprint);
+          if (memo_it != batch_memo_.end()) {
+            slots[step.out_slot] = memo_it->second;
+            break;
+          }
+        }
+        args.clear();
+        for (size_t arg_slot : step.arg_slots) {
+          args.push_back(slots[arg_slot]);
+        }
+        auto simd_output =
+            TryEvalSIMDKernel(exec_state->morsel_executor(), step.udf_name, args, num_rows);
+        if (simd_output != nullptr) {
+          slots[step.out_slot] = std::move(simd_output);
+          if (batch_memo_active_) {
+            batch_memo_.emplace(step.fingerprint, slots[step.out_slot]);
+          }
+          break;
+        }
+        auto* def = bound->defs[step_idx];
+        auto* udf = bound->udfs[step_idx];
+        std::vector<const types::ColumnWrapper*> raw_args;
+        raw_args.reserve(args.size());
+        for (const auto& arg : args) {
+          raw_args.push_back(arg.get());
+        }
+        auto output = types::ColumnWrapper::Make(def->exec_return_type(), num_rows);
+        PL_RETURN_IF_ERROR(def->ExecBatch(udf, function_ctx_, raw_args, output.get(), num_rows));
+        slots[step.out_slot] = std::move(output);
+        if (batch_memo_active_) {
+          batch_memo_.emplace(step.fingerprint, slots[step.out_slot]);
+        }
+        break;
+      }
+    }
+  }
+  return slots[program.num_slots - 1];
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -76,6 +76,16 @@ class InitArgUDF : public udf::ScalarUDF {
   int64_t i_;
 };
 
+class CountingAddUDF : public udf::ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
+    exec_calls++;
+    return v1.val + v2.val;
+  }
+  static int exec_calls;
+};
+int CountingAddUDF::exec_calls = 0;
+
 std::shared_ptr<plan::ScalarExpression> AddScalarExpr() {
   planpb::ScalarExpression se_pb;
   google::protobuf::TextFormat::MergeFromString(kAddScalarFuncPbtxt, &se_pb);
@@ -158,7 +168,24 @@ class ScalarExpressionTest : public ::testing::TestWithParam<ScalarExpressionEva
 
 INSTANTIATE_TEST_SUITE_P(TestVecAndArrow, ScalarExpressionTest,
                          ::testing::Values(ScalarExpressionEvaluatorType::kVectorNative,
-                                           ScalarExpressionEvaluatorType::kArrowNative));
+                                           ScalarExpressionEvaluatorType::kArrowNative,
+                                           ScalarExpressionEvaluatorType::kSIMDNative,
+                                           ScalarExpressionEvaluatorType::kCompiled));
+
+TEST(SIMDNativeScalarExpressionEvaluatorTest, has_simd_kernel) {
+  EXPECT_TRUE(SIMDNativeScalarExpressionEvaluator::HasSIMDKernel(
+      "add", {types::DataType::INT64, types::DataType::INT64}));
+  EXPECT_TRUE(SIMDNativeScalarExpressionEvaluator::HasSIMDKernel(
+      "lessThan", {types::DataType::FLOAT64, types::DataType::FLOAT64}));
+  EXPECT_TRUE(SIMDNativeScalarExpressionEvaluator::HasSIMDKernel(
+      "logicalAnd", {types::DataType::BOOLEAN, types::DataType::BOOLEAN}));
+  EXPECT_TRUE(SIMDNativeScalarExpressionEvaluator::HasSIMDKernel("not", {types::DataType::BOOLEAN}));
+  // String concat and mixed-type args have no columnar kernel.
+  EXPECT_FALSE(SIMDNativeScalarExpressionEvaluator::HasSIMDKernel(
+      "add", {types::DataType::STRING, types::DataType::STRING}));
+  EXPECT_FALSE(SIMDNativeScalarExpressionEvaluator::HasSIMDKernel(
+      "add", {types::DataType::INT64, types::DataType::FLOAT64}));
+}
 
 TEST_P(ScalarExpressionTest, basic_tests) {
   RowDescriptor rd_output({types::DataType::INT64});
@@ -270,6 +297,132 @@ TEST_P(ScalarExpressionTest, eval_init_arg_udf) {
   EXPECT_EQ("init_arg, 1234, c", casted->GetString(2));
 }
 
+TEST(CompiledScalarExpressionEvaluatorTest, program_structure) {
+  auto se = ScalarExpressionOf(kAddScalarFuncNestedPbtxt);
+  auto program = CompiledScalarExpressionEvaluator::CompileOrLookup(*se).ConsumeValueOrDie();
+
+  // add(col0, add(col1, 1337)): the tree flattens to five post-order steps.
+  ASSERT_EQ(5, program->steps.size());
+  ASSERT_EQ(5, program->num_slots);
+  using Kind = CompiledScalarExpressionEvaluator::Step::Kind;
+  EXPECT_EQ(Kind::kColumn, program->steps[0].kind);
+  EXPECT_EQ(Kind::kColumn, program->steps[1].kind);
+  EXPECT_EQ(Kind::kConstant, program->steps[2].kind);
+  EXPECT_EQ(Kind::kScalarFunc, program->steps[3].kind);
+  EXPECT_EQ(Kind::kScalarFunc, program->steps[4].kind);
+  EXPECT_EQ("add", program->steps[4].udf_name);
+  EXPECT_THAT(program->steps[4].arg_slots,
+              ::testing::ElementsAre(program->steps[0].out_slot, program->steps[3].out_slot));
+}
+
+constexpr char kAddSameColumnTwicePbtxt[] = R"(
+func {
+  name: "add"
+  args {
+    column {
+      node: 0
+      index: 0
+    }
+  }
+  args {
+    column {
+      node: 0
+      index: 0
+    }
+  }
+  args_data_types: INT64
+  args_data_types: INT64
+})";
+
+TEST(CompiledScalarExpressionEvaluatorTest, duplicate_subtrees_share_slot) {
+  // add(col0, col0): the duplicated column reference compiles to a single step whose slot
+  // feeds both function arguments.
+  auto se = ScalarExpressionOf(kAddSameColumnTwicePbtxt);
+  auto program = CompiledScalarExpressionEvaluator::CompileOrLookup(*se).ConsumeValueOrDie();
+
+  ASSERT_EQ(2, program->steps.size());
+  ASSERT_EQ(2, program->num_slots);
+  using Kind = CompiledScalarExpressionEvaluator::Step::Kind;
+  EXPECT_EQ(Kind::kColumn, program->steps[0].kind);
+  EXPECT_EQ(Kind::kScalarFunc, program->steps[1].kind);
+  EXPECT_THAT(program->steps[1].arg_slots,
+              ::testing::ElementsAre(program->steps[0].out_slot, program->steps[0].out_slot));
+}
+
+constexpr char kCountingAddPbtxt[] = R"(
+func {
+  name: "counting_add"
+  args {
+    column {
+      node: 0
+      index: 0
+    }
+  }
+  args {
+    column {
+      node: 0
+      index: 1
+    }
+  }
+  args_data_types: INT64
+  args_data_types: INT64
+})";
+
+TEST(CompiledScalarExpressionEvaluatorTest, cross_column_common_subexpressions) {
+  auto func_registry = std::make_unique<udf::Registry>("test_registry");
+  EXPECT_TRUE(func_registry->Register<CountingAddUDF>("counting_add").ok());
+  auto table_store = std::make_shared<table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(func_registry.get(), table_store,
+                                                MockResultSinkStubGenerator,
+                                                MockMetricsStubGenerator, MockTraceStubGenerator,
+                                                sole::uuid4(), nullptr);
+  EXPECT_OK(exec_state->AddScalarUDF(
+      0, "counting_add", std::vector<types::DataType>({types::DataType::INT64,
+                                                       types::DataType::INT64})));
+
+  std::vector<types::Int64Value> in1 = {1, 2, 3};
+  std::vector<types::Int64Value> in2 = {3, 4, 5};
+  RowDescriptor rd({types::DataType::INT64, types::DataType::INT64});
+  RowBatch input_rb(rd, in1.size());
+  EXPECT_TRUE(input_rb.AddColumn(ToArrow(in1, arrow::default_memory_pool())).ok());
+  EXPECT_TRUE(input_rb.AddColumn(ToArrow(in2, arrow::default_memory_pool())).ok());
+
+  // Both output columns compute the same expression; the UDF must run only once per batch.
+  auto se1 = ScalarExpressionOf(kCountingAddPbtxt);
+  auto se2 = ScalarExpressionOf(kCountingAddPbtxt);
+  auto function_ctx = std::make_unique<udf::FunctionContext>(nullptr, nullptr);
+  CompiledScalarExpressionEvaluator evaluator({se1, se2}, function_ctx.get());
+  EXPECT_OK(evaluator.Open(exec_state.get()));
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+  RowBatch output_rb(output_rd, input_rb.num_rows());
+  CountingAddUDF::exec_calls = 0;
+  EXPECT_OK(evaluator.Evaluate(exec_state.get(), input_rb, &output_rb));
+  EXPECT_EQ(3, CountingAddUDF::exec_calls);
+
+  for (int col_idx = 0; col_idx < 2; ++col_idx) {
+    auto casted = static_cast<arrow::Int64Array*>(output_rb.ColumnAt(col_idx).get());
+    EXPECT_EQ(4, casted->Value(0));
+    EXPECT_EQ(6, casted->Value(1));
+    EXPECT_EQ(8, casted->Value(2));
+  }
+  EXPECT_OK(evaluator.Close(exec_state.get()));
+}
+
+TEST(CompiledScalarExpressionEvaluatorTest, program_cache_reuse) {
+  // Two deserializations of the same expression share one cached program.
+  auto se1 = ScalarExpressionOf(kAddScalarFuncNestedPbtxt);
+  auto se2 = ScalarExpressionOf(kAddScalarFuncNestedPbtxt);
+  auto program1 = CompiledScalarExpressionEvaluator::CompileOrLookup(*se1).ConsumeValueOrDie();
+  auto program2 = CompiledScalarExpressionEvaluator::CompileOrLookup(*se2).ConsumeValueOrDie();
+  EXPECT_EQ(program1.get(), program2.get());
+
+  // A structurally different expression gets its own program.
+  auto se3 = ScalarExpressionOf(kInitArgScalarFunc);
+  auto program3 = CompiledScalarExpressionEvaluator::CompileOrLookup(*se3).ConsumeValueOrDie();
+  EXPECT_NE(program1.get(), program3.get());
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
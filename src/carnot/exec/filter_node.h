@@ -41,6 +41,10 @@ class FilterNode : public ProcessingNode {
   FilterNode() = default;
   virtual ~FilterNode() = default;
 
+  // Filters consume selections natively: an incoming selection is intersected with the
+  // predicate, so chained filters share column data instead of re-copying it.
+  bool SupportsSelectionVectors() const override { return true; }
+
  protected:
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
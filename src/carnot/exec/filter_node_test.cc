@@ -223,6 +223,36 @@ TEST_F(FilterNodeTest, string_pred) {
       .Close();
 }
 
+TEST_F(FilterNodeTest, selection_vector_input) {
+  auto op_proto = planpb::testutils::CreateTestFilterTwoCols();
+  plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
+
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd(
+      {types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<FilterNode, plan::FilterOperator>(
+      *plan_node_, output_rd, {input_rd}, exec_state_.get());
+
+  // An upstream filter already dropped row 0, so only row 1 survives both selections even
+  // though the predicate passes rows 0 and 1.
+  auto input_rb = RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<types::Int64Value>({1, 1, 3, 4})
+                      .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                      .AddColumn<types::StringValue>({"ABC", "DEF", "HELLO", "WORLD"})
+                      .get();
+  input_rb.SetSelectionVector(
+      std::make_shared<std::vector<int64_t>>(std::vector<int64_t>{1, 2, 3}));
+
+  tester.ConsumeNext(input_rb, 0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({1})
+                          .AddColumn<types::Int64Value>({3})
+                          .AddColumn<types::StringValue>({"DEF"})
+                          .get())
+      .Close();
+}
+
 TEST_F(FilterNodeTest, child_fail) {
   auto op_proto = planpb::testutils::CreateTestFilterTwoCols();
   plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
@@ -19,12 +19,15 @@
 #include "src/carnot/exec/grpc_router.h"
 
 #include <algorithm>
+#include <chrono>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
 
 #include <absl/base/internal/spinlock.h>
 #include <absl/container/flat_hash_map.h>
+#include <absl/strings/substitute.h>
 #include <grpcpp/grpcpp.h>
 
 #include "src/carnot/exec/grpc_source_node.h"
@@ -35,15 +38,33 @@ namespace px {
 namespace carnot {
 namespace exec {
 
-GRPCRouter::SourceNodeTracker* GRPCRouter::GetSourceNodeTracker(QueryTracker* query_tracker,
-                                                                int64_t source_id) {
+using table_store::schema::RowBatch;
+
+namespace {
+// How often a waiting result stream rechecks the destination queue for capacity. The consumed
+// batch callback normally wakes waiters sooner; this bounds the latency of a missed wakeup.
+constexpr std::chrono::milliseconds kResultStreamFlowControlRecheckInterval{100};
+// Upper bound on how long a result stream will wait for the exec thread to drain the destination
+// queue. After this we fall back to unbounded queueing rather than failing the query, since a
+// stalled exec thread may have causes other than a slow consumer.
+constexpr std::chrono::seconds kResultStreamFlowControlTimeout{60};
+}  // namespace
+
+std::shared_ptr<GRPCRouter::SourceNodeTracker> GRPCRouter::GetSourceNodeTracker(
+    QueryTracker* query_tracker, int64_t source_id) {
   absl::base_internal::SpinLockHolder query_lock(&query_tracker->query_lock);
-  return &query_tracker->source_node_trackers[source_id];
+  auto& snt = query_tracker->source_node_trackers[source_id];
+  if (snt == nullptr) {
+    snt = std::make_shared<SourceNodeTracker>();
+  }
+  return snt;
 }
 
-Status GRPCRouter::EnqueueRowBatch(QueryTracker* query_tracker,
-                                   std::unique_ptr<carnotpb::TransferResultChunkRequest> req) {
-  if (!req->has_query_result() || !req->query_result().has_row_batch() ||
+Status GRPCRouter::EnqueueRowBatch(QueryTracker* query_tracker, SourceNodeTracker* snt,
+                                   std::unique_ptr<carnotpb::TransferResultChunkRequest> req,
+                                   ::grpc::ServerContext* context, bool* cancelled_by_consumer) {
+  if (!req->has_query_result() ||
+      (!req->query_result().has_row_batch() && !req->query_result().has_arrow_row_batch()) ||
       req->query_result().destination_case() !=
           carnotpb::TransferResultChunkRequest_SinkResult::DestinationCase::kGrpcSourceId) {
     return error::Internal(
@@ -51,18 +72,50 @@ Status GRPCRouter::EnqueueRowBatch(QueryTracker* query_tracker,
         "with a GPRC source ID.");
   }
 
-  auto snt = GetSourceNodeTracker(query_tracker, req->query_result().grpc_source_id());
-  {
-    absl::base_internal::SpinLockHolder snt_lock(&snt->node_lock);
-    // It's possible that we see row batches before we have gotten information about the query. To
-    // solve this race, We store a backlog of all the pending batches.
-    if (snt->source_node == nullptr) {
-      snt->connection_initiated_by_sink = true;
-      snt->response_backlog.emplace_back(std::move(req));
-      return Status::OK();
+  const auto deadline = std::chrono::steady_clock::now() + kResultStreamFlowControlTimeout;
+  bool bypass_flow_control = false;
+  while (true) {
+    {
+      absl::base_internal::SpinLockHolder snt_lock(&snt->node_lock);
+      if (snt->cancelled_by_consumer) {
+        // The consumer needs no more records from this source: drop the batch and tell the
+        // caller to finish the stream cleanly.
+        *cancelled_by_consumer = true;
+        return Status::OK();
+      }
+      // It's possible that we see row batches before we have gotten information about the query. To
+      // solve this race, We store a backlog of all the pending batches.
+      if (snt->source_node == nullptr) {
+        snt->connection_initiated_by_sink = true;
+        snt->response_backlog.emplace_back(std::move(req));
+        return Status::OK();
+      }
+      if (bypass_flow_control || snt->source_node->HasPendingCapacity()) {
+        snt->source_node->set_upstream_initiated_connection();
+        PL_RETURN_IF_ERROR(snt->source_node->EnqueueRowBatch(std::move(req)));
+        break;
+      }
     }
-    snt->source_node->set_upstream_initiated_connection();
-    PL_RETURN_IF_ERROR(snt->source_node->EnqueueRowBatch(std::move(req)));
+
+    // The destination queue is full. Hold off reading more of the stream so that gRPC's flow
+    // control pushes back on the upstream sink node, rather than buffering without bound.
+    if (context != nullptr && context->IsCancelled()) {
+      return error::Cancelled(
+          "Result stream cancelled while waiting for GRPC source node $0 to drain.",
+          req->query_result().grpc_source_id());
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      LOG(WARNING) << absl::Substitute(
+          "Pending queue for GRPC source node $0 has been full for over $1s; enqueueing without "
+          "flow control.",
+          req->query_result().grpc_source_id(), kResultStreamFlowControlTimeout.count());
+      bypass_flow_control = true;
+      continue;
+    }
+    // Make sure a yielded execution graph wakes up to drain the queue.
+    query_tracker->RestartExecution();
+    std::unique_lock<std::mutex> lock(query_tracker->flow_control_mu);
+    query_tracker->flow_control_cv.wait_for(lock, kResultStreamFlowControlRecheckInterval);
   }
   query_tracker->RestartExecution();
   return Status::OK();
@@ -101,8 +154,9 @@ void GRPCRouter::MarkResultStreamContextAsComplete(QueryTracker* query_tracker,
 }
 
 ::grpc::Status GRPCRouter::HandleTransferResultChunkMessage(
-    std::unique_ptr<carnotpb::TransferResultChunkRequest> req, ::grpc::ServerContext* context,
+    std::unique_ptr<carnotpb::TransferResultChunkRequest>* req_ptr, ::grpc::ServerContext* context,
     TransferResultChunkState* state) {
+  auto& req = *req_ptr;
   auto query_id = px::ParseUUID(req->query_id()).ConsumeValueOrDie();
   {
     absl::base_internal::SpinLockHolder lock(&id_to_query_tracker_map_lock_);
@@ -138,12 +192,22 @@ void GRPCRouter::MarkResultStreamContextAsComplete(QueryTracker* query_tracker,
     }
     return ::grpc::Status::OK;
   }
-  if (req->has_query_result() && req->query_result().has_row_batch()) {
+  if (req->has_query_result() && (req->query_result().has_row_batch() ||
+                                  req->query_result().has_arrow_row_batch())) {
     state->stream_has_query_results = true;
-    state->source_node_id = req->query_result().grpc_source_id();
-    auto s = EnqueueRowBatch(state->query_tracker.get(), std::move(req));
+    const int64_t source_node_id = req->query_result().grpc_source_id();
+    // All batches of a stream normally target one source node: look its tracker up once and
+    // reuse it, so the steady-state receive path takes no query_lock per row batch.
+    if (state->source_node_tracker == nullptr || state->source_node_id != source_node_id) {
+      state->source_node_tracker =
+          GetSourceNodeTracker(state->query_tracker.get(), source_node_id);
+    }
+    state->source_node_id = source_node_id;
+    auto s = EnqueueRowBatch(state->query_tracker.get(), state->source_node_tracker.get(),
+                             std::move(req), context, &state->cancelled_by_consumer);
     if (!s.ok()) {
-      return ::grpc::Status(grpc::StatusCode::INTERNAL, "failed to enqueue batch");
+      return ::grpc::Status(grpc::StatusCode::INTERNAL,
+                            absl::Substitute("failed to enqueue batch: $0", s.msg()));
     }
     return ::grpc::Status::OK;
   }
@@ -175,11 +239,21 @@ std::vector<statuspb::Status> GRPCRouter::GetIncomingWorkerErrors(const sole::uu
   auto req = std::make_unique<carnotpb::TransferResultChunkRequest>();
   TransferResultChunkState state;
   while (reader->Read(req.get())) {
-    result_status = HandleTransferResultChunkMessage(std::move(req), context, &state);
+    result_status = HandleTransferResultChunkMessage(&req, context, &state);
     if (!result_status.ok()) {
       break;
     }
-    req = std::make_unique<carnotpb::TransferResultChunkRequest>();
+    if (state.cancelled_by_consumer) {
+      // The destination source node needs no more records. Finish the RPC cleanly without
+      // draining the rest of the stream; the client sees the early close and stops producing.
+      break;
+    }
+    // A fresh request is only needed when ownership of the previous one was handed off to a
+    // source node queue. Control messages (connection initiation, exec stats, errors) leave it
+    // in place, and gRPC reuses the parsed message's internal storage on the next Read.
+    if (req == nullptr) {
+      req = std::make_unique<carnotpb::TransferResultChunkRequest>();
+    }
   }
 
   if (state.query_tracker != nullptr) {
@@ -203,6 +277,47 @@ std::vector<statuspb::Status> GRPCRouter::GetIncomingWorkerErrors(const sole::uu
   return ::grpc::Status::OK;
 }
 
+::grpc::Status GRPCRouter::FetchSinkKeyFilter(::grpc::ServerContext* /*context*/,
+                                              const ::px::carnotpb::SinkKeyFilterRequest* request,
+                                              ::px::carnotpb::SinkKeyFilterResponse* response) {
+  auto query_id_or = px::ParseUUID(request->query_id());
+  if (!query_id_or.ok()) {
+    return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT, "Failed to parse query ID");
+  }
+
+  std::shared_ptr<QueryTracker> query_tracker;
+  {
+    absl::base_internal::SpinLockHolder lock(&id_to_query_tracker_map_lock_);
+    auto it = id_to_query_tracker_map_.find(query_id_or.ConsumeValueOrDie());
+    if (it == id_to_query_tracker_map_.end()) {
+      // No filter yet (or no such query); the sink keeps sending unfiltered and polls again.
+      return ::grpc::Status::OK;
+    }
+    query_tracker = it->second;
+  }
+
+  absl::base_internal::SpinLockHolder lock(&query_tracker->query_lock);
+  auto it = query_tracker->sink_key_filters.find(request->grpc_source_id());
+  if (it != query_tracker->sink_key_filters.end()) {
+    *response->mutable_key_filter() = it->second;
+  }
+  return ::grpc::Status::OK;
+}
+
+void GRPCRouter::RegisterSinkKeyFilter(const sole::uuid& query_id, int64_t source_id,
+                                       carnotpb::SinkKeyFilterResponse::KeyFilter filter) {
+  std::shared_ptr<QueryTracker> query_tracker;
+  {
+    absl::base_internal::SpinLockHolder lock(&id_to_query_tracker_map_lock_);
+    if (!id_to_query_tracker_map_.contains(query_id)) {
+      id_to_query_tracker_map_[query_id] = std::make_shared<QueryTracker>();
+    }
+    query_tracker = id_to_query_tracker_map_[query_id];
+  }
+  absl::base_internal::SpinLockHolder lock(&query_tracker->query_lock);
+  query_tracker->sink_key_filters[source_id] = std::move(filter);
+}
+
 Status GRPCRouter::AddGRPCSourceNode(sole::uuid query_id, int64_t source_id,
                                      GRPCSourceNode* source_node,
                                      std::function<void()> restart_execution) {
@@ -223,6 +338,11 @@ Status GRPCRouter::AddGRPCSourceNode(sole::uuid query_id, int64_t source_id,
   auto snt = GetSourceNodeTracker(query_tracker.get(), source_id);
 
   absl::base_internal::SpinLockHolder snt_lock(&snt->node_lock);
+  // Wake any result streams waiting for queue capacity whenever the exec thread consumes a
+  // batch. The callback holds a reference on the query tracker, so it stays valid for the
+  // lifetime of the source node.
+  source_node->set_consumed_batch_callback(
+      [query_tracker] { query_tracker->flow_control_cv.notify_all(); });
   snt->source_node = source_node;
   if (snt->connection_initiated_by_sink) {
     source_node->set_upstream_initiated_connection();
@@ -233,6 +353,12 @@ Status GRPCRouter::AddGRPCSourceNode(sole::uuid query_id, int64_t source_id,
     }
     snt->response_backlog.clear();
   }
+  if (snt->local_backlog.size() > 0) {
+    for (auto& rb : snt->local_backlog) {
+      PL_RETURN_IF_ERROR(snt->source_node->EnqueueRowBatch(std::move(rb)));
+    }
+    snt->local_backlog.clear();
+  }
   if (snt->connection_closed_by_sink) {
     source_node->set_upstream_closed_connection();
   }
@@ -275,10 +401,135 @@ Status GRPCRouter::DeleteGRPCSourceNode(sole::uuid query_id, int64_t source_id)
     return error::Internal("Query map for query ID $0 does not contain GRPC source $1",
                            query_id.str(), source_id);
   }
+  {
+    // Active result streams may still hold a cached reference to this tracker. Clear the node
+    // pointer so any late batches fall into the backlog rather than a destroyed source node.
+    absl::base_internal::SpinLockHolder snt_lock(&it->second->node_lock);
+    it->second->source_node = nullptr;
+  }
   query_tracker->source_node_trackers.erase(it);
   return Status::OK();
 }
 
+Status GRPCRouter::InitiateLocalResultStream(const sole::uuid& query_id, int64_t source_id) {
+  std::shared_ptr<QueryTracker> query_tracker;
+  {
+    absl::base_internal::SpinLockHolder lock(&id_to_query_tracker_map_lock_);
+    if (!id_to_query_tracker_map_.contains(query_id)) {
+      id_to_query_tracker_map_[query_id] = std::make_shared<QueryTracker>();
+    }
+    query_tracker = id_to_query_tracker_map_[query_id];
+  }
+  auto snt = GetSourceNodeTracker(query_tracker.get(), source_id);
+  absl::base_internal::SpinLockHolder snt_lock(&snt->node_lock);
+  if (snt->source_node != nullptr) {
+    snt->source_node->set_upstream_initiated_connection();
+  } else {
+    snt->connection_initiated_by_sink = true;
+  }
+  return Status::OK();
+}
+
+Status GRPCRouter::EnqueueLocalRowBatch(const sole::uuid& query_id, int64_t source_id,
+                                        std::unique_ptr<RowBatch> rb,
+                                        bool* cancelled_by_consumer) {
+  std::shared_ptr<QueryTracker> query_tracker;
+  {
+    absl::base_internal::SpinLockHolder lock(&id_to_query_tracker_map_lock_);
+    auto it = id_to_query_tracker_map_.find(query_id);
+    if (it == id_to_query_tracker_map_.end()) {
+      return error::Internal(
+          "Attempting to enqueue a local row batch for uninitiated or completed query $0.",
+          query_id.str());
+    }
+    query_tracker = it->second;
+  }
+
+  const bool eos = rb->eos();
+  auto snt = GetSourceNodeTracker(query_tracker.get(), source_id);
+  {
+    absl::base_internal::SpinLockHolder snt_lock(&snt->node_lock);
+    if (snt->cancelled_by_consumer) {
+      *cancelled_by_consumer = true;
+      return Status::OK();
+    }
+    // The producing fragment may run before the fragment holding the source node registers it.
+    // Hold the batch in a backlog, matching the remote path.
+    if (snt->source_node == nullptr) {
+      snt->connection_initiated_by_sink = true;
+      snt->local_backlog.emplace_back(std::move(rb));
+      if (eos) {
+        snt->connection_closed_by_sink = true;
+      }
+      return Status::OK();
+    }
+    // Unlike the remote path, there is no flow control here: the producing and consuming
+    // fragments may share the exec thread, so blocking on queue capacity could deadlock.
+    snt->source_node->set_upstream_initiated_connection();
+    PL_RETURN_IF_ERROR(snt->source_node->EnqueueRowBatch(std::move(rb)));
+    if (eos) {
+      snt->source_node->set_upstream_closed_connection();
+    }
+  }
+  query_tracker->RestartExecution();
+  return Status::OK();
+}
+
+void GRPCRouter::CancelSourceStreams(const sole::uuid& query_id, int64_t source_id) {
+  std::shared_ptr<QueryTracker> query_tracker;
+  {
+    absl::base_internal::SpinLockHolder lock(&id_to_query_tracker_map_lock_);
+    auto it = id_to_query_tracker_map_.find(query_id);
+    if (it == id_to_query_tracker_map_.end()) {
+      // No incoming streams for this query (e.g. the source is a local one).
+      return;
+    }
+    query_tracker = it->second;
+  }
+
+  auto snt = GetSourceNodeTracker(query_tracker.get(), source_id);
+  {
+    absl::base_internal::SpinLockHolder snt_lock(&snt->node_lock);
+    snt->cancelled_by_consumer = true;
+    snt->response_backlog.clear();
+    snt->local_backlog.clear();
+  }
+  // Wake any result streams blocked on flow control so they observe the cancellation.
+  query_tracker->flow_control_cv.notify_all();
+}
+
+void GRPCRouter::CancelQuery(const sole::uuid& query_id, const std::string& reason) {
+  std::shared_ptr<QueryTracker> query_tracker;
+  {
+    absl::base_internal::SpinLockHolder lock(&id_to_query_tracker_map_lock_);
+    auto it = id_to_query_tracker_map_.find(query_id);
+    if (it == id_to_query_tracker_map_.end()) {
+      // No incoming streams for this query (e.g. all of its sources are local).
+      return;
+    }
+    query_tracker = it->second;
+  }
+  VLOG(1) << absl::Substitute("Cancelling query $0 in GRPC router: $1", query_id.str(), reason);
+  {
+    absl::base_internal::SpinLockHolder lock(&query_tracker->query_lock);
+    for (auto& [source_id, snt] : query_tracker->source_node_trackers) {
+      absl::base_internal::SpinLockHolder snt_lock(&snt->node_lock);
+      snt->cancelled_by_consumer = true;
+      snt->response_backlog.clear();
+      snt->local_backlog.clear();
+    }
+    // Break any active incoming streams so the upstream agents' sinks fail their next write and
+    // cancel their own fragments, instead of continuing to scan and ship data.
+    for (auto ctx : query_tracker->active_agent_contexts) {
+      ctx->TryCancel();
+    }
+  }
+  // Wake result streams blocked on flow control and the exec thread if it is yielded, so both
+  // observe the cancellation promptly.
+  query_tracker->flow_control_cv.notify_all();
+  query_tracker->RestartExecution();
+}
+
 void GRPCRouter::DeleteQuery(sole::uuid query_id) {
   VLOG(1) << "Deleting query ID from GRPC Router: " << query_id.str();
   std::shared_ptr<QueryTracker> query_tracker;
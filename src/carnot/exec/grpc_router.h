@@ -20,7 +20,9 @@
 
 #include <stdint.h>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -38,6 +40,7 @@
 #include "src/common/base/base.h"
 #include "src/common/base/statuspb/status.pb.h"
 #include "src/common/uuid/uuid.h"
+#include "src/table_store/table_store.h"
 
 namespace px {
 namespace carnot {
@@ -60,6 +63,23 @@ class GRPCRouter final : public carnotpb::ResultSinkService::Service {
       ::grpc::ServerReader<::px::carnotpb::TransferResultChunkRequest>* reader,
       ::px::carnotpb::TransferResultChunkResponse* response) override;
 
+  /**
+   * FetchSinkKeyFilter implements the RPC method: serves the key filter (if any) published for
+   * the requested source node. Responds with an unset key_filter until one is registered.
+   */
+  ::grpc::Status FetchSinkKeyFilter(::grpc::ServerContext* context,
+                                    const ::px::carnotpb::SinkKeyFilterRequest* request,
+                                    ::px::carnotpb::SinkKeyFilterResponse* response) override;
+
+  /**
+   * Registers a key filter for the sinks feeding the given source node (sideways information
+   * passing): the consumer of the source (e.g. a join's probe side) publishes a bloom filter
+   * of the keys it can use, and upstream sinks poll it via FetchSinkKeyFilter to drop
+   * non-matching rows before transmission. Re-registering replaces the previous filter.
+   */
+  void RegisterSinkKeyFilter(const sole::uuid& query_id, int64_t source_id,
+                             carnotpb::SinkKeyFilterResponse::KeyFilter filter);
+
   /**
    * Adds the specified source node to the router. Includes a function that should be called to
    * retrigger execution of the graph if currently yielded.
@@ -80,6 +100,37 @@ class GRPCRouter final : public carnotpb::ResultSinkService::Service {
    */
   Status DeleteGRPCSourceNode(sole::uuid query_id, int64_t source_id);
 
+  /**
+   * Cancels all incoming result streams destined for the given source node. Called when a
+   * downstream consumer (e.g. a limit) needs no more records from the source: subsequent row
+   * batches for the source are dropped and the corresponding TransferResultChunk streams are
+   * finished cleanly, so the upstream agents stop scanning and shipping data. Cancelling a
+   * source with no incoming streams is a no-op.
+   */
+  void CancelSourceStreams(const sole::uuid& query_id, int64_t source_id);
+
+  /**
+   * Cancels the query as a whole: marks every source of the query as cancelled, drops its
+   * backlogs, and cancels all active incoming result streams so the upstream agents observe the
+   * cancellation on their next write and abort their own fragments. Unlike DeleteQuery this
+   * keeps the query tracked, so the exec thread can still drain its own state. Cancelling an
+   * untracked query is a no-op.
+   */
+  void CancelQuery(const sole::uuid& query_id, const std::string& reason);
+
+  /**
+   * In-process transport for sinks whose destination source node runs in this same process.
+   * InitiateLocalResultStream mirrors the initiate_conn message of a remote stream;
+   * EnqueueLocalRowBatch hands an already-materialized row batch straight to the destination
+   * source node, skipping proto serialization. Batches that arrive before the source node is
+   * registered are held in a backlog, matching the remote path. Sets *cancelled_by_consumer
+   * (and drops the batch) if the destination needs no more records.
+   */
+  Status InitiateLocalResultStream(const sole::uuid& query_id, int64_t source_id);
+  Status EnqueueLocalRowBatch(const sole::uuid& query_id, int64_t source_id,
+                              std::unique_ptr<table_store::schema::RowBatch> rb,
+                              bool* cancelled_by_consumer);
+
   /**
    * @brief Get any errors that may have occured in the incoming worker nodes.
    *
@@ -116,8 +167,14 @@ class GRPCRouter final : public carnotpb::ResultSinkService::Service {
     // respectively.
     bool connection_initiated_by_sink GUARDED_BY(node_lock) = false;
     bool connection_closed_by_sink GUARDED_BY(node_lock) = false;
+    // Set when the consumer of the source node (e.g. a downstream limit) needs no more records.
+    // Further batches for the source are dropped and its incoming streams finished cleanly.
+    bool cancelled_by_consumer GUARDED_BY(node_lock) = false;
     std::vector<std::unique_ptr<::px::carnotpb::TransferResultChunkRequest>> response_backlog
         GUARDED_BY(node_lock);
+    // Backlog for batches handed over by an in-process sink before the source node registered.
+    std::vector<std::unique_ptr<table_store::schema::RowBatch>> local_backlog
+        GUARDED_BY(node_lock);
     absl::base_internal::SpinLock node_lock;
   };
 
@@ -126,7 +183,12 @@ class GRPCRouter final : public carnotpb::ResultSinkService::Service {
    */
   struct QueryTracker {
     QueryTracker() : create_time(std::chrono::steady_clock::now()) {}
-    absl::node_hash_map<int64_t, SourceNodeTracker> source_node_trackers GUARDED_BY(query_lock);
+    // Trackers are held by shared_ptr so that a result stream can look its destination up once
+    // and reuse the tracker across messages without re-taking query_lock per row batch. A
+    // cached tracker outlives DeleteGRPCSourceNode (which clears its source_node pointer before
+    // unmapping it), so late batches safely fall into the backlog instead of a destroyed node.
+    absl::node_hash_map<int64_t, std::shared_ptr<SourceNodeTracker>> source_node_trackers
+        GUARDED_BY(query_lock);
     const std::chrono::steady_clock::time_point create_time GUARDED_BY(query_lock);
     std::function<void()> restart_execution_func_ GUARDED_BY(query_lock);
     // The set of agents we've seen for the query.
@@ -137,8 +199,18 @@ class GRPCRouter final : public carnotpb::ResultSinkService::Service {
 
     // Errors that occur during execution from parent_agents.
     std::vector<statuspb::Status> upstream_exec_errors GUARDED_BY(query_lock);
+    // Key filters published for the sinks feeding a given source node, keyed by source node ID.
+    // Served to upstream sinks via FetchSinkKeyFilter.
+    absl::flat_hash_map<int64_t, carnotpb::SinkKeyFilterResponse::KeyFilter> sink_key_filters
+        GUARDED_BY(query_lock);
     absl::base_internal::SpinLock query_lock;
 
+    // Flow control for incoming result streams: TransferResultChunk handlers wait on this
+    // condition variable when a source node's pending queue is full, and the exec thread signals
+    // it as batches are consumed. This must be a real mutex (not a SpinLock) since waiters block.
+    std::mutex flow_control_mu;
+    std::condition_variable flow_control_cv;
+
     void ResetRestartExecutionFunc() ABSL_EXCLUSIVE_LOCKS_REQUIRED(query_lock) {
       restart_execution_func_ = std::function<void()>();
     }
@@ -156,8 +228,13 @@ class GRPCRouter final : public carnotpb::ResultSinkService::Service {
     }
   };
 
-  Status EnqueueRowBatch(QueryTracker* query_tracker,
-                         std::unique_ptr<carnotpb::TransferResultChunkRequest> req);
+  // Enqueues a row batch onto the destination source node. If the source node's pending queue
+  // is full, blocks until the exec thread has drained some of it (or the stream is cancelled),
+  // so that gRPC flow control pushes back on the upstream sink instead of buffering without
+  // bound.
+  Status EnqueueRowBatch(QueryTracker* query_tracker, SourceNodeTracker* snt,
+                         std::unique_ptr<carnotpb::TransferResultChunkRequest> req,
+                         ::grpc::ServerContext* context, bool* cancelled_by_consumer);
 
   struct TransferResultChunkState {
     int64_t source_node_id = 0;
@@ -165,17 +242,27 @@ class GRPCRouter final : public carnotpb::ResultSinkService::Service {
     // stream_has_query_results informs downstream source nodes about the health of the stream.
     // When true, the particular TransferResultChunk call has initiated the query stream.
     bool stream_has_query_results = false;
+    // Set when the destination source node has been cancelled by its consumer; the stream should
+    // be finished cleanly so the upstream agent stops sending.
+    bool cancelled_by_consumer = false;
     std::shared_ptr<QueryTracker> query_tracker = nullptr;
+    // Destination tracker for the stream's row batches, cached so the steady-state path (all
+    // batches of a stream target one source node) takes no per-message query_lock.
+    std::shared_ptr<SourceNodeTracker> source_node_tracker = nullptr;
   };
+  // Takes the request by pointer-to-owner: ownership is only consumed (*req set to nullptr)
+  // when the message is a row batch handed off to a source node queue. Control messages leave
+  // the request in place so the read loop can reuse its allocation for the next message.
   ::grpc::Status HandleTransferResultChunkMessage(
-      std::unique_ptr<::px::carnotpb::TransferResultChunkRequest> req,
+      std::unique_ptr<::px::carnotpb::TransferResultChunkRequest>* req,
       ::grpc::ServerContext* context, TransferResultChunkState* state);
 
   void MarkResultStreamClosed(QueryTracker* query_tracker, int64_t source_id);
   void RegisterResultStreamContext(QueryTracker* query_tracker, ::grpc::ServerContext* context);
   void MarkResultStreamContextAsComplete(QueryTracker* query_tracker,
                                          ::grpc::ServerContext* context);
-  SourceNodeTracker* GetSourceNodeTracker(QueryTracker* query_tracker, int64_t source_id);
+  std::shared_ptr<SourceNodeTracker> GetSourceNodeTracker(QueryTracker* query_tracker,
+                                                          int64_t source_id);
 
   absl::node_hash_map<sole::uuid, std::shared_ptr<QueryTracker>> id_to_query_tracker_map_
       GUARDED_BY(id_to_query_tracker_map_lock_);
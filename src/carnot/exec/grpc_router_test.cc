@@ -30,6 +30,7 @@
 #include <grpcpp/security/credentials.h>
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/server.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "src/api/proto/uuidpb/uuid.pb.h"
@@ -43,6 +44,7 @@
 #include "src/carnot/udf/registry.h"
 #include "src/common/base/base.h"
 #include "src/common/testing/testing.h"
+#include "src/shared/bloomfilter/bloomfilter.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/types.h"
 #include "src/table_store/schemapb/schema.pb.h"
@@ -89,7 +91,14 @@ class FakeGRPCSourceNode : public px::carnot::exec::GRPCSourceNode {
     return Status::OK();
   }
 
+  Status EnqueueRowBatch(std::unique_ptr<table_store::schema::RowBatch> row_batch) {
+    local_row_batches.emplace_back(std::move(row_batch));
+
+    return Status::OK();
+  }
+
   std::vector<std::unique_ptr<px::carnotpb::TransferResultChunkRequest>> row_batches;
+  std::vector<std::unique_ptr<table_store::schema::RowBatch>> local_row_batches;
 };
 
 TEST_F(GRPCRouterTest, no_node_router_test) {
@@ -436,6 +445,112 @@ TEST_F(GRPCRouterTest, threaded_router_test) {
   read_thread.join();
 }
 
+// Verifies that a full source node queue pauses the result stream instead of buffering without
+// bound: the writer may only ever get one batch ahead of the exec thread, and every batch is
+// still delivered in order once the exec thread drains the queue.
+TEST_F(GRPCRouterTest, backpressure_on_full_source_queue) {
+  uint64_t ab = 0xea8aa095697f49f1, cd = 0xb127d50e5b6e2645;
+  auto query_uuid = sole::rebuild(ab, cd);
+
+  auto func_registry_ = std::make_unique<udf::Registry>("test_registry");
+  auto table_store = std::make_shared<table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(
+      func_registry_.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+      MockTraceStubGenerator, sole::uuid4(), nullptr);
+
+  MockExecNode mock_child;
+
+  // This test checks that each batch is consumed individually, so keep batches from being merged.
+  const int32_t orig_coalesce_rows = FLAGS_carnot_grpc_source_coalesce_rows;
+  FLAGS_carnot_grpc_source_coalesce_rows = 0;
+
+  RowDescriptor input_rd({types::DataType::INT64});
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<px::carnot::plan::Operator> plan_node =
+      plan::GRPCSourceOperator::FromProto(op_proto, 1);
+  auto source_node = GRPCSourceNode();
+  source_node.set_result_queue_capacity(1);
+  ASSERT_OK(source_node.Init(*plan_node, input_rd, {}));
+  source_node.AddChild(&mock_child, 0);
+  ASSERT_OK(source_node.Open(exec_state.get()));
+  ASSERT_OK(source_node.Prepare(exec_state.get()));
+
+  FakePlanNode fake_plan_node(111);
+  // Silence GMOCK warnings.
+  EXPECT_CALL(mock_child, InitImpl(::testing::_));
+  EXPECT_CALL(mock_child, PrepareImpl(::testing::_));
+  EXPECT_CALL(mock_child, OpenImpl(::testing::_));
+  ASSERT_OK(mock_child.Init(fake_plan_node, RowDescriptor({}), {}));
+  ASSERT_OK(mock_child.Open(exec_state.get()));
+  ASSERT_OK(mock_child.Prepare(exec_state.get()));
+
+  // The source node must be registered before any batches arrive so that the stream hits the
+  // bounded queue rather than the pre-registration backlog.
+  ASSERT_OK(service_->AddGRPCSourceNode(query_uuid, /* source_id */ 0, &source_node, [] {}));
+
+  carnotpb::TransferResultChunkRequest initiate_stream_req0;
+  auto query_id = initiate_stream_req0.mutable_query_id();
+  query_id->set_high_bits(ab);
+  query_id->set_low_bits(cd);
+  *initiate_stream_req0.mutable_initiate_conn() =
+      carnotpb::TransferResultChunkRequest::InitiateConnection();
+
+  constexpr int kNumBatches = 20;
+
+  // Start up thread that writes row batches; its writes pause whenever the queue is full.
+  std::thread write_thread([&] {
+    px::carnotpb::TransferResultChunkResponse response;
+    grpc::ClientContext context;
+    auto writer = stub_->TransferResultChunk(&context, &response);
+    EXPECT_TRUE(writer->Write(initiate_stream_req0));
+    for (int idx = 0; idx < kNumBatches; ++idx) {
+      auto rb = RowBatchBuilder(input_rd, /*size*/ 1, /*eow*/ idx == kNumBatches - 1,
+                                /*eos*/ idx == kNumBatches - 1)
+                    .AddColumn<types::Int64Value>({
+                        idx,
+                    })
+                    .get();
+      carnotpb::TransferResultChunkRequest rb_req;
+      EXPECT_OK(rb.ToProto(rb_req.mutable_query_result()->mutable_row_batch()));
+      rb_req.mutable_query_result()->set_grpc_source_id(0);
+      auto query_id = rb_req.mutable_query_id();
+      query_id->set_high_bits(ab);
+      query_id->set_low_bits(cd);
+      EXPECT_TRUE(writer->Write(rb_req));
+    }
+    writer->WritesDone();
+    writer->Finish();
+  });
+
+  auto idx = 0;
+  while (source_node.HasBatchesRemaining()) {
+    if (!source_node.NextBatchReady()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    // The router never enqueues past the capacity of the queue.
+    EXPECT_LE(source_node.queued_batches(), 1U);
+
+    auto check_result_batch = [&](ExecState*, const table_store::schema::RowBatch& rb, int64_t) {
+      EXPECT_EQ(idx,
+                types::GetValueFromArrowArray<types::DataType::INT64>(rb.ColumnAt(0).get(), 0));
+    };
+
+    EXPECT_CALL(mock_child, ConsumeNextImpl(::testing::_, ::testing::_, ::testing::_))
+        .Times(1)
+        .WillRepeatedly(::testing::DoAll(::testing::Invoke(check_result_batch),
+                                         ::testing::Return(Status::OK())))
+        .RetiresOnSaturation();
+
+    ASSERT_OK(source_node.GenerateNext(exec_state.get()));
+    idx++;
+  }
+  EXPECT_EQ(kNumBatches, idx);
+
+  write_thread.join();
+  FLAGS_carnot_grpc_source_coalesce_rows = orig_coalesce_rows;
+}
+
 TEST_F(GRPCRouterTest, delete_query_router_test) {
   int64_t grpc_source_node_id = 1;
   uint64_t ab = 0xea8aa095697f49f1, cd = 0xb127d50e5b6e2645;
@@ -853,6 +968,192 @@ TEST_F(GRPCRouterTest, receive_execution_error) {
               ::testing::MatchesRegex(".*failed upstream execution.*"));
 }
 
+// Verifies the in-process transport: batches handed over before the source node registers are
+// backlogged and flushed on registration, later batches are delivered directly, and an eos batch
+// marks the stream closed.
+TEST_F(GRPCRouterTest, local_result_stream) {
+  int64_t grpc_source_node_id = 1;
+  auto query_id = sole::uuid4();
+
+  RowDescriptor input_rd({types::DataType::INT64});
+
+  ASSERT_OK(service_->InitiateLocalResultStream(query_id, grpc_source_node_id));
+
+  // The source node has not registered yet: this batch goes into the backlog.
+  auto rb1 = RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                 .AddColumn<types::Int64Value>({1, 2})
+                 .get();
+  bool cancelled = false;
+  ASSERT_OK(service_->EnqueueLocalRowBatch(query_id, grpc_source_node_id,
+                                           std::make_unique<table_store::schema::RowBatch>(rb1),
+                                           &cancelled));
+  EXPECT_FALSE(cancelled);
+
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<px::carnot::plan::Operator> plan_node =
+      plan::GRPCSourceOperator::FromProto(op_proto, grpc_source_node_id);
+  auto source_node = FakeGRPCSourceNode();
+  ASSERT_OK(source_node.Init(*plan_node, input_rd, {}));
+
+  ASSERT_OK(service_->AddGRPCSourceNode(query_id, grpc_source_node_id, &source_node, [] {}));
+  EXPECT_TRUE(source_node.upstream_initiated_connection());
+  ASSERT_EQ(1, source_node.local_row_batches.size());
+
+  // After registration batches are handed straight to the node; eos closes the stream.
+  auto rb2 = RowBatchBuilder(input_rd, 2, /*eow*/ true, /*eos*/ true)
+                 .AddColumn<types::Int64Value>({3, 4})
+                 .get();
+  ASSERT_OK(service_->EnqueueLocalRowBatch(query_id, grpc_source_node_id,
+                                           std::make_unique<table_store::schema::RowBatch>(rb2),
+                                           &cancelled));
+  EXPECT_FALSE(cancelled);
+  ASSERT_EQ(2, source_node.local_row_batches.size());
+  EXPECT_EQ(0, source_node.row_batches.size());
+  EXPECT_TRUE(source_node.upstream_closed_connection());
+
+  // Batches after a consumer-side cancellation are dropped.
+  service_->CancelSourceStreams(query_id, grpc_source_node_id);
+  ASSERT_OK(service_->EnqueueLocalRowBatch(query_id, grpc_source_node_id,
+                                           std::make_unique<table_store::schema::RowBatch>(rb1),
+                                           &cancelled));
+  EXPECT_TRUE(cancelled);
+  EXPECT_EQ(2, source_node.local_row_batches.size());
+}
+
+// Verifies that cancelling a source's streams finishes incoming result streams cleanly (OK status
+// with success=true) and drops any subsequent batches instead of delivering them.
+TEST_F(GRPCRouterTest, cancel_source_streams) {
+  int64_t grpc_source_node_id = 1;
+  auto query_id = sole::uuid4();
+
+  RowDescriptor input_rd({types::DataType::INT64});
+
+  // Add source node to GRPC router.
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<px::carnot::plan::Operator> plan_node =
+      plan::GRPCSourceOperator::FromProto(op_proto, grpc_source_node_id);
+  auto source_node = FakeGRPCSourceNode();
+  ASSERT_OK(source_node.Init(*plan_node, input_rd, {}));
+
+  ASSERT_OK(service_->AddGRPCSourceNode(query_id, grpc_source_node_id, &source_node, [] {}));
+
+  // Cancel the source's streams, e.g. because a downstream limit has been satisfied.
+  service_->CancelSourceStreams(query_id, grpc_source_node_id);
+
+  carnotpb::TransferResultChunkRequest initiate_stream_req;
+  ToProto(query_id, initiate_stream_req.mutable_query_id());
+  *initiate_stream_req.mutable_initiate_conn() =
+      carnotpb::TransferResultChunkRequest::InitiateConnection();
+
+  auto rb1 = RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                 .AddColumn<types::Int64Value>({1, 2})
+                 .get();
+  carnotpb::TransferResultChunkRequest rb_req1;
+  EXPECT_OK(rb1.ToProto(rb_req1.mutable_query_result()->mutable_row_batch()));
+  rb_req1.mutable_query_result()->set_grpc_source_id(grpc_source_node_id);
+  ToProto(query_id, rb_req1.mutable_query_id());
+
+  // The stream finishes gracefully rather than with an error, and the batch is dropped.
+  carnotpb::TransferResultChunkResponse response;
+  grpc::ClientContext context;
+  auto writer = stub_->TransferResultChunk(&context, &response);
+  writer->Write(initiate_stream_req);
+  writer->Write(rb_req1);
+  writer->WritesDone();
+  auto writer_s = writer->Finish();
+  EXPECT_TRUE(writer_s.ok()) << writer_s.error_message();
+  EXPECT_TRUE(response.success());
+
+  EXPECT_EQ(0, source_node.row_batches.size());
+}
+
+// Verifies that cancelling a query marks every source of the query as cancelled, drops further
+// batches, and wakes a yielded exec thread via the restart-execution hook.
+TEST_F(GRPCRouterTest, cancel_query) {
+  int64_t grpc_source_node_id = 1;
+  auto query_id = sole::uuid4();
+
+  RowDescriptor input_rd({types::DataType::INT64});
+
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<px::carnot::plan::Operator> plan_node =
+      plan::GRPCSourceOperator::FromProto(op_proto, grpc_source_node_id);
+  auto source_node = FakeGRPCSourceNode();
+  ASSERT_OK(source_node.Init(*plan_node, input_rd, {}));
+
+  bool restart_called = false;
+  ASSERT_OK(service_->AddGRPCSourceNode(query_id, grpc_source_node_id, &source_node,
+                                        [&restart_called] { restart_called = true; }));
+
+  service_->CancelQuery(query_id, "client disconnected");
+  EXPECT_TRUE(restart_called);
+
+  // Batches arriving after the cancellation are dropped, and the producer is told the consumer
+  // is gone.
+  auto rb = RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                .AddColumn<types::Int64Value>({1, 2})
+                .get();
+  bool cancelled = false;
+  ASSERT_OK(service_->EnqueueLocalRowBatch(query_id, grpc_source_node_id,
+                                           std::make_unique<table_store::schema::RowBatch>(rb),
+                                           &cancelled));
+  EXPECT_TRUE(cancelled);
+  EXPECT_EQ(0, source_node.local_row_batches.size());
+
+  // Cancelling an untracked query is a no-op.
+  service_->CancelQuery(sole::uuid4(), "client disconnected");
+}
+
+TEST_F(GRPCRouterTest, sink_key_filter_registration_and_fetch) {
+  int64_t grpc_source_node_id = 1;
+  auto query_id = sole::uuid4();
+
+  carnotpb::SinkKeyFilterRequest req;
+  ToProto(query_id, req.mutable_query_id());
+  req.set_grpc_source_id(grpc_source_node_id);
+
+  // Nothing registered yet: the response carries no filter.
+  {
+    carnotpb::SinkKeyFilterResponse response;
+    grpc::ClientContext context;
+    auto s = stub_->FetchSinkKeyFilter(&context, req, &response);
+    EXPECT_TRUE(s.ok()) << s.error_message();
+    EXPECT_FALSE(response.has_key_filter());
+  }
+
+  auto bloom_filter = px::bloomfilter::XXHash64BloomFilter::Create(1024, 0.01).ConsumeValueOrDie();
+  bloom_filter->Insert(uint64_t{42});
+  carnotpb::SinkKeyFilterResponse::KeyFilter key_filter;
+  key_filter.add_key_column_indices(0);
+  *key_filter.mutable_bloom_filter() = bloom_filter->ToProto();
+  service_->RegisterSinkKeyFilter(query_id, grpc_source_node_id, std::move(key_filter));
+
+  {
+    carnotpb::SinkKeyFilterResponse response;
+    grpc::ClientContext context;
+    auto s = stub_->FetchSinkKeyFilter(&context, req, &response);
+    EXPECT_TRUE(s.ok()) << s.error_message();
+    ASSERT_TRUE(response.has_key_filter());
+    EXPECT_THAT(response.key_filter().key_column_indices(), ::testing::ElementsAre(0));
+    auto fetched = px::bloomfilter::XXHash64BloomFilter::FromProto(
+                       response.key_filter().bloom_filter())
+                       .ConsumeValueOrDie();
+    EXPECT_TRUE(fetched->Contains(uint64_t{42}));
+    EXPECT_FALSE(fetched->Contains(uint64_t{43}));
+  }
+
+  // A filter for a different source node is not visible under this source ID.
+  {
+    carnotpb::SinkKeyFilterRequest other_req = req;
+    other_req.set_grpc_source_id(grpc_source_node_id + 1);
+    carnotpb::SinkKeyFilterResponse response;
+    grpc::ClientContext context;
+    auto s = stub_->FetchSinkKeyFilter(&context, other_req, &response);
+    EXPECT_TRUE(s.ok()) << s.error_message();
+    EXPECT_FALSE(response.has_key_filter());
+  }
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -18,6 +18,8 @@
 
 #include "src/carnot/exec/grpc_sink_node.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -26,9 +28,11 @@
 #include <absl/strings/substitute.h>
 
 #include "src/carnot/carnotpb/carnot.pb.h"
+#include "src/carnot/exec/row_tuple.h"
 #include "src/carnot/planpb/plan.pb.h"
 #include "src/common/base/macros.h"
 #include "src/common/uuid/uuid_utils.h"
+#include "src/shared/types/arrow_adapter.h"
 #include "src/table_store/table_store.h"
 
 namespace px {
@@ -38,6 +42,54 @@ namespace exec {
 using table_store::schema::RowBatch;
 using table_store::schema::RowDescriptor;
 
+namespace {
+
+// Decides whether a batch is worth compressing on the wire. Small batches aren't worth the
+// CPU, and batches dominated by high-entropy string payloads (pre-compressed or encrypted
+// data) would only grow.
+bool ShouldCompressBatch(const RowBatch& rb) {
+  if (static_cast<size_t>(rb.NumBytes()) < kMinCompressionBatchBytes) {
+    return false;
+  }
+
+  int64_t string_bytes = 0;
+  const arrow::StringArray* largest = nullptr;
+  int64_t largest_bytes = 0;
+  for (int64_t i = 0; i < rb.num_columns(); ++i) {
+    auto col = rb.ColumnAt(i);
+    if (col->type_id() != arrow::Type::STRING) {
+      continue;
+    }
+    auto typed = static_cast<arrow::StringArray*>(col.get());
+    int64_t nbytes = typed->value_offset(typed->length()) - typed->value_offset(0);
+    string_bytes += nbytes;
+    if (nbytes > largest_bytes) {
+      largest_bytes = nbytes;
+      largest = typed;
+    }
+  }
+  // Batches dominated by fixed-width columns compress well.
+  if (largest == nullptr || string_bytes * 2 < rb.NumBytes()) {
+    return true;
+  }
+
+  // Sample the dominant string column and count distinct byte values. Payloads that use
+  // nearly the full byte alphabet won't shrink under compression.
+  const uint8_t* data = largest->value_data()->data() + largest->value_offset(0);
+  auto sample_size = std::min(static_cast<size_t>(largest_bytes), kCompressionSampleBytes);
+  std::array<bool, 256> seen{};
+  int distinct = 0;
+  for (size_t i = 0; i < sample_size; ++i) {
+    if (!seen[data[i]]) {
+      seen[data[i]] = true;
+      ++distinct;
+    }
+  }
+  return distinct < kIncompressibleDistinctBytes;
+}
+
+}  // namespace
+
 std::string GRPCSinkNode::DebugStringImpl() {
   std::string destination;
   if (plan_node_->has_table_name()) {
@@ -68,7 +120,8 @@ StatusOr<carnotpb::TransferResultChunkRequest> RequestWithMetadata(
 }
 
 Status GRPCSinkNode::OptionallyCheckConnection(ExecState* exec_state) {
-  if (sent_eos_ || cancelled_) {
+  // In-process handoffs have no connection to check.
+  if (sent_eos_ || cancelled_ || local_destination_) {
     return Status::OK();
   }
 
@@ -85,7 +138,8 @@ Status GRPCSinkNode::OptionallyCheckConnection(ExecState* exec_state) {
                       RowBatch::WithZeroRows(*input_descriptor_, /* eow */ false, /* eos */ false));
   PL_RETURN_IF_ERROR(rb->ToProto(req.mutable_query_result()->mutable_row_batch()));
 
-  PL_RETURN_IF_ERROR(TryWriteRequest(exec_state, req));
+  PL_RETURN_IF_ERROR(
+      TryWriteRequest(exec_state, req, grpc::WriteOptions().set_no_compression()));
   return Status::OK();
 }
 
@@ -120,6 +174,10 @@ Status GRPCSinkNode::StartConnectionWithRetries(ExecState* exec_state, size_t n_
   stub_ = exec_state->ResultSinkServiceStub(plan_node_->address(), plan_node_->ssl_targetname());
 
   context_ = std::make_unique<grpc::ClientContext>();
+  // Compress result streams on the wire. gRPC negotiates the algorithm per stream via
+  // grpc-accept-encoding, so destinations that don't support gzip fall back to identity.
+  // Individual messages opt out via WriteOptions when compression isn't worthwhile.
+  context_->set_compression_algorithm(GRPC_COMPRESS_GZIP);
   // When we are sending the results to an external service, such as the query broker,
   // add authentication to the client context.
   if (plan_node_->has_table_name()) {
@@ -137,7 +195,7 @@ Status GRPCSinkNode::StartConnectionWithRetries(ExecState* exec_state, size_t n_
                       RowBatch::WithZeroRows(*input_descriptor_, /* eow */ false, /* eos */ false));
   PL_RETURN_IF_ERROR(rb->ToProto(req.mutable_query_result()->mutable_row_batch()));
 
-  if (!writer_->Write(req)) {
+  if (!writer_->Write(req, grpc::WriteOptions().set_no_compression())) {
     return StartConnectionWithRetries(exec_state, n_retries - 1);
   }
 
@@ -147,15 +205,36 @@ Status GRPCSinkNode::StartConnectionWithRetries(ExecState* exec_state, size_t n_
 
 Status GRPCSinkNode::CancelledByServer(ExecState* exec_state) {
   cancelled_ = true;
+  // Trip the query's cancel token so sibling operators abort at their next batch boundary and
+  // the incoming result streams feeding this fragment are torn down immediately, instead of
+  // upstream agents continuing to ship data for a query whose consumer is gone.
+  exec_state->Cancel(absl::Substitute("result stream to $0 closed by server",
+                                      plan_node_->address()));
   return error::Cancelled(
       "GRPCSinkNode $0 of query $1 could not write result to address: $2, stream closed by "
       "server",
       plan_node_->id(), exec_state->query_id().str(), plan_node_->address());
 }
 
+Status GRPCSinkNode::DownstreamCancelled(ExecState* exec_state) {
+  // The server finished the stream cleanly mid-query: the consumer has all the records it needs
+  // (e.g. a downstream limit was satisfied). Stop the upstream sources and drop any further
+  // batches rather than failing the query.
+  LOG(INFO) << absl::Substitute(
+      "GRPCSinkNode $0 of query $1: result stream to $2 closed by consumer, stopping upstream "
+      "sources",
+      plan_node_->id(), exec_state->query_id().str(), plan_node_->address());
+  cancelled_ = true;
+  // The writer has already been finished; drop it so nothing tries to close it again.
+  writer_ = nullptr;
+  exec_state->StopAllSources();
+  return Status::OK();
+}
+
 Status GRPCSinkNode::TryWriteRequest(ExecState* exec_state,
-                                     const carnotpb::TransferResultChunkRequest& req) {
-  if (writer_->Write(req)) {
+                                     const carnotpb::TransferResultChunkRequest& req,
+                                     const grpc::WriteOptions& options) {
+  if (writer_->Write(req, options)) {
     last_send_time_ = std::chrono::system_clock::now();
     return Status::OK();
   }
@@ -164,6 +243,11 @@ Status GRPCSinkNode::TryWriteRequest(ExecState* exec_state,
   // connection just died.
   writer_->WritesDone();
   auto s = writer_->Finish();
+  // A clean early finish with a successful response means the consumer deliberately closed the
+  // stream because it needs no more records (e.g. its limit was satisfied).
+  if (s.ok() && response_.success()) {
+    return DownstreamCancelled(exec_state);
+  }
   // If the Finish call was successful, then the server closed the connection and sent a response,
   // in which case we shouldn't try to reconnect. If there's an error from the server side
   // other than a RST_STREAM, we also shouldn't retry.
@@ -176,14 +260,43 @@ Status GRPCSinkNode::TryWriteRequest(ExecState* exec_state,
   PL_RETURN_IF_ERROR(StartConnection(exec_state));
 
   // Try again to write the request on the new connection.
-  if (!writer_->Write(req)) {
+  if (!writer_->Write(req, options)) {
     return CancelledByServer(exec_state);
   }
   last_send_time_ = std::chrono::system_clock::now();
   return Status::OK();
 }
 
-Status GRPCSinkNode::OpenImpl(ExecState* exec_state) { return StartConnection(exec_state); }
+Status GRPCSinkNode::OpenImpl(ExecState* exec_state) {
+  if (plan_node_->has_grpc_source_id() && exec_state->grpc_router() != nullptr &&
+      exec_state->IsLocalGRPCSourceID(plan_node_->grpc_source_id())) {
+    // The destination source node runs in this same process: hand row batches over via the
+    // local router instead of opening a gRPC stream.
+    local_destination_ = true;
+    return exec_state->grpc_router()->InitiateLocalResultStream(exec_state->query_id(),
+                                                                plan_node_->grpc_source_id());
+  }
+  PL_RETURN_IF_ERROR(StartConnection(exec_state));
+  // Delay the first key-filter poll by one check interval; the destination publishes a filter
+  // only after its build side completes.
+  last_key_filter_fetch_time_ = std::chrono::system_clock::now();
+  return Status::OK();
+}
+
+Status GRPCSinkNode::ConsumeNextLocal(ExecState* exec_state, const RowBatch& rb) {
+  bool cancelled_by_consumer = false;
+  PL_RETURN_IF_ERROR(exec_state->grpc_router()->EnqueueLocalRowBatch(
+      exec_state->query_id(), plan_node_->grpc_source_id(), std::make_unique<RowBatch>(rb),
+      &cancelled_by_consumer));
+  if (cancelled_by_consumer) {
+    return DownstreamCancelled(exec_state);
+  }
+  last_send_time_ = std::chrono::system_clock::now();
+  if (rb.eos()) {
+    sent_eos_ = true;
+  }
+  return Status::OK();
+}
 
 Status GRPCSinkNode::CloseWriter(ExecState* exec_state) {
   if (writer_ == nullptr) {
@@ -200,6 +313,11 @@ Status GRPCSinkNode::CloseWriter(ExecState* exec_state) {
 }
 
 Status GRPCSinkNode::CloseImpl(ExecState* exec_state) {
+  if (key_filter_ != nullptr) {
+    stats()->AddExtraMetric("key_filter_rows_in", key_filter_rows_in_);
+    stats()->AddExtraMetric("key_filter_rows_dropped", key_filter_rows_dropped_);
+  }
+
   if (sent_eos_ || cancelled_) {
     return Status::OK();
   }
@@ -303,18 +421,153 @@ Status GRPCSinkNode::SplitAndSendBatch(ExecState* exec_state, const RowBatch& rb
 }
 
 Status GRPCSinkNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t parent_idx) {
-  if (rb.NumBytes() > (max_batch_size_ * batch_size_factor_)) {
-    return SplitAndSendBatch(exec_state, rb, parent_idx);
+  if (cancelled_) {
+    // The downstream consumer closed the stream; any batches still in flight are dropped.
+    return Status::OK();
+  }
+  if (local_destination_) {
+    // No wire message size limit applies in-process, so batches are never split.
+    return ConsumeNextLocal(exec_state, rb);
+  }
+
+  const RowBatch* out_rb = &rb;
+  std::unique_ptr<RowBatch> filtered_rb;
+  if (plan_node_->has_grpc_source_id()) {
+    PL_RETURN_IF_ERROR(MaybeFetchKeyFilter(exec_state));
+    if (key_filter_ != nullptr && rb.num_rows() > 0) {
+      PL_ASSIGN_OR_RETURN(filtered_rb, ApplyKeyFilter(exec_state, rb));
+      if (filtered_rb != nullptr) {
+        if (filtered_rb->num_rows() == 0 && !filtered_rb->eow() && !filtered_rb->eos()) {
+          // Every row was dropped and there is no stream state to convey; skip the message.
+          return Status::OK();
+        }
+        out_rb = filtered_rb.get();
+      }
+    }
+  }
+
+  if (out_rb->NumBytes() > (max_batch_size_ * batch_size_factor_)) {
+    return SplitAndSendBatch(exec_state, *out_rb, parent_idx);
   }
-  return ConsumeNextImplNoSplit(exec_state, rb, parent_idx);
+  return ConsumeNextImplNoSplit(exec_state, *out_rb, parent_idx);
+}
+
+Status GRPCSinkNode::MaybeFetchKeyFilter(ExecState* exec_state) {
+  if (key_filter_fetch_done_ || cancelled_ || stub_ == nullptr) {
+    return Status::OK();
+  }
+  auto time_now = std::chrono::system_clock::now();
+  auto since_last_fetch =
+      std::chrono::duration_cast<std::chrono::milliseconds>(time_now - last_key_filter_fetch_time_);
+  if (since_last_fetch < connection_check_timeout_) {
+    return Status::OK();
+  }
+  last_key_filter_fetch_time_ = time_now;
+
+  carnotpb::SinkKeyFilterRequest req;
+  ToProto(exec_state->query_id(), req.mutable_query_id());
+  req.set_grpc_source_id(plan_node_->grpc_source_id());
+  carnotpb::SinkKeyFilterResponse resp;
+  grpc::ClientContext context;
+  auto s = stub_->FetchSinkKeyFilter(&context, req, &resp);
+  if (!s.ok()) {
+    VLOG(1) << absl::Substitute("GRPCSinkNode $0 in query $1: FetchSinkKeyFilter failed: $2",
+                                plan_node_->id(), exec_state->query_id().str(), s.error_message());
+    return Status::OK();
+  }
+  if (!resp.has_key_filter()) {
+    // No filter published (yet); poll again after the next interval.
+    return Status::OK();
+  }
+
+  // A filter exists; either install it or mark it unusable so we stop polling.
+  key_filter_fetch_done_ = true;
+  const auto& key_filter = resp.key_filter();
+  if (key_filter.key_column_indices().empty()) {
+    return Status::OK();
+  }
+  for (int64_t key_idx : key_filter.key_column_indices()) {
+    if (key_idx < 0 || key_idx >= static_cast<int64_t>(input_descriptor_->size())) {
+      return Status::OK();
+    }
+  }
+  auto filter_or = bloomfilter::XXHash64BloomFilter::FromProto(key_filter.bloom_filter());
+  if (!filter_or.ok()) {
+    return Status::OK();
+  }
+  key_filter_ = filter_or.ConsumeValueOrDie();
+  key_filter_col_indices_.assign(key_filter.key_column_indices().begin(),
+                                 key_filter.key_column_indices().end());
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> GRPCSinkNode::ApplyKeyFilter(ExecState* exec_state,
+                                                                 const RowBatch& rb) {
+  const size_t num_rows = rb.num_rows();
+  // Same batched column hash scheme as the destination join, so per-row hashes agree.
+  std::vector<uint64_t> hashes(num_rows);
+  for (size_t i = 0; i < key_filter_col_indices_.size(); ++i) {
+    auto col = rb.ColumnAt(key_filter_col_indices_[i]).get();
+    auto dt = input_descriptor_->type(key_filter_col_indices_[i]);
+#define TYPE_CASE(_dt_) HashColumnIntoBatch<_dt_>(col, i == 0, &hashes);
+    PL_SWITCH_FOREACH_DATATYPE(dt, TYPE_CASE);
+#undef TYPE_CASE
+  }
+  std::vector<uint8_t> matches(num_rows);
+  key_filter_->ContainsBatch8(hashes.data(), num_rows, matches.data());
+
+  size_t num_matched = 0;
+  for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+    num_matched += matches[row_idx] != 0;
+  }
+  key_filter_rows_in_ += num_rows;
+  key_filter_rows_dropped_ += num_rows - num_matched;
+  if (num_matched == num_rows) {
+    return std::unique_ptr<RowBatch>(nullptr);
+  }
+
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+  for (size_t col_idx = 0; col_idx < input_descriptor_->size(); ++col_idx) {
+    builders.push_back(
+        types::MakeArrowBuilder(input_descriptor_->type(col_idx), exec_state->exec_mem_pool()));
+    PL_RETURN_IF_ERROR(builders.back()->Reserve(num_matched));
+  }
+  for (size_t col_idx = 0; col_idx < input_descriptor_->size(); ++col_idx) {
+    auto arr = rb.ColumnAt(col_idx).get();
+    for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+      if (!matches[row_idx]) {
+        continue;
+      }
+#define TYPE_CASE(_dt_)                                    \
+  PL_RETURN_IF_ERROR(table_store::schema::CopyValue<_dt_>( \
+      builders[col_idx].get(), types::GetValueFromArrowArray<_dt_>(arr, row_idx)));
+      PL_SWITCH_FOREACH_DATATYPE(input_descriptor_->type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+    }
+  }
+  return RowBatch::FromColumnBuilders(*input_descriptor_, rb.eow(), rb.eos(), &builders);
 }
 
 Status GRPCSinkNode::ConsumeNextImplNoSplit(ExecState* exec_state, const RowBatch& rb, size_t) {
   PL_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(plan_node_.get(), exec_state));
-  // Serialize the RowBatch.
-  PL_RETURN_IF_ERROR(rb.ToProto(req.mutable_query_result()->mutable_row_batch()));
+  // Serialize the RowBatch. Internal (Carnot-to-Carnot) destinations get raw Arrow column
+  // buffers, which skips the per-value encode here and the matching decode in GRPCSourceNode.
+  if (plan_node_->has_grpc_source_id()) {
+    PL_RETURN_IF_ERROR(
+        rb.ToArrowBuffersProto(req.mutable_query_result()->mutable_arrow_row_batch()));
+  } else {
+    PL_RETURN_IF_ERROR(rb.ToProto(req.mutable_query_result()->mutable_row_batch()));
+  }
 
-  PL_RETURN_IF_ERROR(TryWriteRequest(exec_state, req));
+  grpc::WriteOptions options;
+  if (!ShouldCompressBatch(rb)) {
+    options.set_no_compression();
+  }
+  PL_RETURN_IF_ERROR(TryWriteRequest(exec_state, req, options));
+  if (cancelled_) {
+    // The write was dropped because the consumer closed the stream.
+    return Status::OK();
+  }
 
   if (!rb.eos()) {
     return Status::OK();
@@ -31,6 +31,7 @@
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/plan/operators.h"
 #include "src/common/base/base.h"
+#include "src/shared/bloomfilter/bloomfilter.h"
 #include "src/table_store/table_store.h"
 
 #include "src/carnot/carnotpb/carnot.grpc.pb.h"
@@ -51,6 +52,15 @@ constexpr float kBatchSizeFactor = 0.9f;
 // Number of times to retry connecting to grpc before giving up.
 constexpr size_t kGRPCRetries = 3;
 
+// Batches smaller than this are sent uncompressed; the per-message compression overhead
+// outweighs the savings.
+constexpr size_t kMinCompressionBatchBytes = 1024;
+// Number of bytes of string data to sample when estimating compressibility.
+constexpr size_t kCompressionSampleBytes = 1024;
+// If a sample of the dominant string column uses at least this many distinct byte values,
+// the payload is considered incompressible (e.g. pre-compressed or encrypted data).
+constexpr int kIncompressibleDistinctBytes = 224;
+
 class GRPCSinkNode : public SinkNode {
  public:
   GRPCSinkNode(size_t max_batch_size, float batch_size_factor)
@@ -67,6 +77,13 @@ class GRPCSinkNode : public SinkNode {
   const std::chrono::time_point<std::chrono::system_clock>& testing_last_send_time() const {
     return last_send_time_;
   }
+  // For unit testing, installs a key filter as if one had been fetched from the destination.
+  void testing_set_key_filter(std::unique_ptr<bloomfilter::XXHash64BloomFilter> filter,
+                              std::vector<int64_t> key_column_indices) {
+    key_filter_ = std::move(filter);
+    key_filter_col_indices_ = std::move(key_column_indices);
+    key_filter_fetch_done_ = true;
+  }
 
  protected:
   std::string DebugStringImpl() override;
@@ -89,14 +106,30 @@ class GRPCSinkNode : public SinkNode {
   Status StartConnection(ExecState* exec_state);
   Status StartConnectionWithRetries(ExecState* exec_state, size_t n_retries);
   Status CancelledByServer(ExecState* exec_state);
-  Status TryWriteRequest(ExecState* exec_state, const carnotpb::TransferResultChunkRequest& req);
+  Status DownstreamCancelled(ExecState* exec_state);
+  // In-process fast path used when the destination GRPC source node runs in this same process:
+  // hands the row batch to the source via the local GRPC router, skipping proto serialization.
+  Status ConsumeNextLocal(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status TryWriteRequest(ExecState* exec_state, const carnotpb::TransferResultChunkRequest& req,
+                         const grpc::WriteOptions& options = grpc::WriteOptions());
+  // Polls the destination (at most once per connection_check_timeout_) for a key filter
+  // published by the consumer of the destination source node (e.g. a join's build side), and
+  // installs it on success. Fetch errors are swallowed: the filter only saves work.
+  Status MaybeFetchKeyFilter(ExecState* exec_state);
+  // Drops rows whose key hashes miss key_filter_, preserving eow/eos. Returns nullptr when
+  // every row passes, so the caller can send the original batch without a copy.
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> ApplyKeyFilter(
+      ExecState* exec_state, const table_store::schema::RowBatch& rb);
 
   bool cancelled_ = false;
+  // True when the destination source node lives in this process; row batches are handed over
+  // in-process and no gRPC stream is opened.
+  bool local_destination_ = false;
 
   std::unique_ptr<grpc::ClientContext> context_;
   carnotpb::TransferResultChunkResponse response_;
 
-  carnotpb::ResultSinkService::StubInterface* stub_;
+  carnotpb::ResultSinkService::StubInterface* stub_ = nullptr;
   std::unique_ptr<grpc::ClientWriterInterface<carnotpb::TransferResultChunkRequest>> writer_;
 
   std::unique_ptr<plan::GRPCSinkOperator> plan_node_;
@@ -105,6 +138,17 @@ class GRPCSinkNode : public SinkNode {
   std::chrono::milliseconds connection_check_timeout_ = kDefaultConnectionCheckTimeoutMS;
   std::chrono::time_point<std::chrono::system_clock> last_send_time_;
 
+  // Key filter pushed down from the consumer of the destination source node. Rows whose key
+  // hashes miss the filter would be discarded by the destination, so they are dropped here
+  // before transmission.
+  std::unique_ptr<bloomfilter::XXHash64BloomFilter> key_filter_;
+  std::vector<int64_t> key_filter_col_indices_;
+  // Set once a filter is installed or determined unusable; stops further polling.
+  bool key_filter_fetch_done_ = false;
+  std::chrono::time_point<std::chrono::system_clock> last_key_filter_fetch_time_;
+  int64_t key_filter_rows_in_ = 0;
+  int64_t key_filter_rows_dropped_ = 0;
+
   size_t max_batch_size_;
   float batch_size_factor_;
 };
@@ -27,12 +27,16 @@
 
 #include "src/carnot/carnotpb/carnot.pb.h"
 #include "src/carnot/carnotpb/carnot_mock.grpc.pb.h"
+#include "src/carnot/exec/grpc_router.h"
+#include "src/carnot/exec/grpc_source_node.h"
+#include "src/carnot/exec/row_tuple.h"
 #include "src/carnot/exec/test_utils.h"
 #include "src/carnot/planpb/plan.pb.h"
 #include "src/carnot/planpb/test_proto.h"
 #include "src/carnot/udf/registry.h"
 #include "src/common/testing/testing.h"
 #include "src/common/uuid/uuid_utils.h"
+#include "src/shared/bloomfilter/bloomfilter.h"
 #include "src/shared/types/types.h"
 
 namespace px {
@@ -109,11 +113,10 @@ query_id {
   low_bits: $1
 }
 query_result {
-  row_batch {
+  arrow_row_batch {
     cols {
-      int64_data {
-      }
     }
+    col_types: INT64
   }
   grpc_source_id: 0
 }
@@ -126,12 +129,11 @@ query_id {
   low_bits: $1
 }
 query_result {
-  row_batch {
+  arrow_row_batch {
     cols {
-      int64_data {
-        data: 1
-      }
+      data: "\001\000\000\000\000\000\000\000"
     }
+    col_types: INT64
     num_rows: 1
   }
   grpc_source_id: 0
@@ -145,13 +147,11 @@ query_id {
   low_bits: $1
 }
 query_result {
-  row_batch {
+  arrow_row_batch {
     cols {
-      int64_data {
-        data: 2
-        data: 2
-      }
+      data: "\002\000\000\000\000\000\000\000\002\000\000\000\000\000\000\000"
     }
+    col_types: INT64
     num_rows: 2
     eow: true
     eos: true
@@ -217,6 +217,67 @@ TEST_F(GRPCSinkNodeTest, internal_result) {
   EXPECT_FALSE(add_metadata_called_);
 }
 
+TEST_F(GRPCSinkNodeTest, compression_heuristic) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  std::vector<grpc::WriteOptions> write_options;
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  auto save_arg = [&](TransferResultChunkRequest, grpc::WriteOptions options) {
+    write_options.push_back(options);
+  };
+  EXPECT_CALL(*writer, Write(_, _)).Times(4).WillRepeatedly(DoAll(Invoke(save_arg), Return(true)));
+  EXPECT_CALL(*writer, WritesDone());
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  // Small batch: below kMinCompressionBatchBytes, should skip compression.
+  auto small_rb = RowBatchBuilder(output_rd, 3, /*eow*/ false, /*eos*/ false)
+                      .AddColumn<types::Int64Value>({1, 2, 3})
+                      .AddColumn<types::StringValue>({"a", "b", "c"})
+                      .get();
+  tester.ConsumeNext(small_rb, 5, 0);
+
+  // Large numeric-dominated batch: should be compressed.
+  std::vector<types::Int64Value> int64_data(300, 1);
+  std::vector<types::StringValue> empty_strings(300, "");
+  auto numeric_rb = RowBatchBuilder(output_rd, 300, /*eow*/ false, /*eos*/ false)
+                        .AddColumn<types::Int64Value>(int64_data)
+                        .AddColumn<types::StringValue>(empty_strings)
+                        .get();
+  tester.ConsumeNext(numeric_rb, 5, 0);
+
+  // Batch dominated by a high-entropy string payload: should skip compression.
+  std::string high_entropy;
+  for (int i = 0; i < 2048; ++i) {
+    high_entropy.push_back(static_cast<char>(i % 256));
+  }
+  auto string_rb = RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Int64Value>({1})
+                       .AddColumn<types::StringValue>({high_entropy})
+                       .get();
+  tester.ConsumeNext(string_rb, 5, 0);
+
+  tester.Close();
+
+  ASSERT_EQ(4, write_options.size());
+  // Stream-start zero-row batch is never compressed.
+  EXPECT_TRUE(write_options[0].get_no_compression());
+  EXPECT_TRUE(write_options[1].get_no_compression());
+  EXPECT_FALSE(write_options[2].get_no_compression());
+  EXPECT_TRUE(write_options[3].get_no_compression());
+}
+
 constexpr char kExpectedExternal0RowResult[] = R"proto(
 address: "localhost:1234"
 query_id {
@@ -506,13 +567,14 @@ TEST_P(GRPCSinkNodeSplitTest, break_up_batches) {
   tester.ConsumeNext(rb, 5, 0);
 
   for (const auto& [idx, expected_num_rows] : Enumerate(test_case.expected_num_rows_per_batch)) {
-    EXPECT_EQ(actual_protos[idx].query_result().row_batch().num_rows(), expected_num_rows);
+    // This sink's destination is a GRPCSource, so batches go out as raw Arrow buffers.
+    EXPECT_EQ(actual_protos[idx].query_result().arrow_row_batch().num_rows(), expected_num_rows);
     if (idx != num_output_batches - 1) {
-      EXPECT_EQ(actual_protos[idx].query_result().row_batch().eow(), false);
-      EXPECT_EQ(actual_protos[idx].query_result().row_batch().eos(), false);
+      EXPECT_EQ(actual_protos[idx].query_result().arrow_row_batch().eow(), false);
+      EXPECT_EQ(actual_protos[idx].query_result().arrow_row_batch().eos(), false);
     } else {
-      EXPECT_EQ(actual_protos[idx].query_result().row_batch().eow(), test_case.eow);
-      EXPECT_EQ(actual_protos[idx].query_result().row_batch().eos(), test_case.eos);
+      EXPECT_EQ(actual_protos[idx].query_result().arrow_row_batch().eow(), test_case.eow);
+      EXPECT_EQ(actual_protos[idx].query_result().arrow_row_batch().eos(), test_case.eos);
     }
   }
 
@@ -722,6 +784,92 @@ TEST_F(GRPCSinkNodeTest, retry_failed_writes) {
   EXPECT_FALSE(add_metadata_called_);
 }
 
+TEST_F(GRPCSinkNodeTest, local_destination) {
+  // The destination source node runs in the same process: batches are handed over via the local
+  // router and no gRPC stream is opened (no calls on mock_ are expected).
+  GRPCRouter router;
+  auto table_store = std::make_shared<table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                                MockResultSinkStubGenerator,
+                                                MockMetricsStubGenerator, MockTraceStubGenerator,
+                                                sole::uuid4(), nullptr, &router);
+  exec_state->AddLocalGRPCSourceID(0);
+
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto source_op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<plan::Operator> source_plan_node =
+      plan::GRPCSourceOperator::FromProto(source_op_proto, 0);
+  GRPCSourceNode source_node;
+  ASSERT_OK(source_node.Init(*source_plan_node, input_rd, {}));
+  ASSERT_OK(router.AddGRPCSourceNode(exec_state->query_id(), 0, &source_node, [] {}));
+
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  ASSERT_OK(plan_node->Init(op_proto.grpc_sink_op()));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state.get());
+  EXPECT_TRUE(source_node.upstream_initiated_connection());
+
+  auto rb = RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({1, 2})
+                .get();
+  tester.ConsumeNext(rb, 5, 0);
+
+  EXPECT_EQ(1, source_node.queued_batches());
+  EXPECT_TRUE(source_node.NextBatchReady());
+  EXPECT_TRUE(source_node.upstream_closed_connection());
+
+  tester.Close();
+}
+
+TEST_F(GRPCSinkNodeTest, downstream_cancelled) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  EXPECT_CALL(*writer, Write(_, _))
+      .Times(2)
+      .WillOnce(Return(true))    // Initiate result sink.
+      .WillOnce(Return(false));  // Consumer closed the stream.
+
+  // A clean Finish with a successful response signals a deliberate consumer-side close (e.g. a
+  // downstream limit was satisfied) rather than a connection failure.
+  EXPECT_CALL(*writer, WritesDone()).WillOnce(Return(true));
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  auto rb = RowBatchBuilder(output_rd, 2, /*eow*/ false, /*eos*/ false)
+                .AddColumn<types::Int64Value>({1, 2})
+                .get();
+  // The failed write should resolve to a graceful cancellation, not an error.
+  tester.ConsumeNext(rb, 5, 0);
+
+  // All sources in the graph are stopped so the query winds down without scanning further.
+  exec_state_->SetCurrentSource(123);
+  EXPECT_FALSE(exec_state_->keep_running());
+
+  // Subsequent batches are dropped without touching the finished stream.
+  auto rb2 = RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                 .AddColumn<types::Int64Value>({3, 4})
+                 .get();
+  tester.ConsumeNext(rb2, 5, 0);
+
+  tester.Close();
+}
+
 TEST_F(GRPCSinkNodeTest, check_connection_after_eos) {
   auto op_proto = planpb::testutils::CreateTestGRPCSink2PB();
   auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
@@ -763,6 +911,124 @@ TEST_F(GRPCSinkNodeTest, check_connection_after_eos) {
   tester.Close();
 }
 
+constexpr char kExpectedKeyFilteredResult[] = R"proto(
+address: "localhost:1234"
+query_id {
+  high_bits: $0
+  low_bits: $1
+}
+query_result {
+  arrow_row_batch {
+    cols {
+      data: "\001\000\000\000\000\000\000\000\003\000\000\000\000\000\000\000"
+    }
+    col_types: INT64
+    num_rows: 2
+    eow: true
+    eos: true
+  }
+  grpc_source_id: 0
+}
+)proto";
+
+TEST_F(GRPCSinkNodeTest, key_filter_drops_non_matching_rows) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  std::vector<TransferResultChunkRequest> actual_protos;
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  auto save_req = [&](TransferResultChunkRequest req, grpc::WriteOptions) {
+    actual_protos.push_back(std::move(req));
+  };
+  EXPECT_CALL(*writer, Write(_, _)).WillRepeatedly(DoAll(Invoke(save_req), Return(true)));
+  EXPECT_CALL(*writer, WritesDone());
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  // Build a filter over keys 1 and 3, hashed with the same batched column hash scheme the
+  // destination join uses.
+  auto key_rb = RowBatchBuilder(output_rd, 2, /*eow*/ false, /*eos*/ false)
+                    .AddColumn<types::Int64Value>({1, 3})
+                    .get();
+  std::vector<uint64_t> key_hashes(2);
+  HashColumnIntoBatch<types::DataType::INT64>(key_rb.ColumnAt(0).get(), /*first_col*/ true,
+                                              &key_hashes);
+  auto filter = bloomfilter::XXHash64BloomFilter::Create(8192, 0.001).ConsumeValueOrDie();
+  for (uint64_t h : key_hashes) {
+    filter->Insert(h);
+  }
+  tester.node()->testing_set_key_filter(std::move(filter), {0});
+
+  auto rb = RowBatchBuilder(output_rd, 4, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                .get();
+  tester.ConsumeNext(rb, 5, 0);
+  tester.Close();
+
+  // First message initiates the stream; the data message should only carry rows 1 and 3.
+  ASSERT_EQ(2, actual_protos.size());
+  EXPECT_THAT(actual_protos[1],
+              EqualsProto(absl::Substitute(kExpectedKeyFilteredResult, exec_state_->query_id().ab,
+                                           exec_state_->query_id().cd)));
+}
+
+TEST_F(GRPCSinkNodeTest, key_filter_all_rows_pass) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  std::vector<TransferResultChunkRequest> actual_protos;
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  auto save_req = [&](TransferResultChunkRequest req, grpc::WriteOptions) {
+    actual_protos.push_back(std::move(req));
+  };
+  EXPECT_CALL(*writer, Write(_, _)).WillRepeatedly(DoAll(Invoke(save_req), Return(true)));
+  EXPECT_CALL(*writer, WritesDone());
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  auto key_rb = RowBatchBuilder(output_rd, 2, /*eow*/ false, /*eos*/ false)
+                    .AddColumn<types::Int64Value>({1, 2})
+                    .get();
+  std::vector<uint64_t> key_hashes(2);
+  HashColumnIntoBatch<types::DataType::INT64>(key_rb.ColumnAt(0).get(), /*first_col*/ true,
+                                              &key_hashes);
+  auto filter = bloomfilter::XXHash64BloomFilter::Create(8192, 0.001).ConsumeValueOrDie();
+  for (uint64_t h : key_hashes) {
+    filter->Insert(h);
+  }
+  tester.node()->testing_set_key_filter(std::move(filter), {0});
+
+  auto rb = RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({1, 2})
+                .get();
+  tester.ConsumeNext(rb, 5, 0);
+  tester.Close();
+
+  // All rows pass the filter, so the original batch goes through unchanged.
+  ASSERT_EQ(2, actual_protos.size());
+  EXPECT_EQ(2, actual_protos[1].query_result().arrow_row_batch().num_rows());
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -23,8 +23,16 @@
 #include <vector>
 
 #include <absl/strings/substitute.h>
+#include <arrow/array/concatenate.h>
 
 #include "src/carnot/planpb/plan.pb.h"
+#include "src/shared/types/arrow_adapter.h"
+
+DEFINE_int32(carnot_grpc_source_coalesce_rows, 1024,
+             "Target number of rows per batch emitted by GRPC source nodes. Smaller pending "
+             "batches are concatenated up to this size before being sent downstream, so that "
+             "per-batch overhead in downstream nodes is paid per target-sized batch rather than "
+             "per incoming batch. Set to 0 or 1 to disable coalescing.");
 
 namespace px {
 namespace carnot {
@@ -51,13 +59,63 @@ Status GRPCSourceNode::CloseImpl(ExecState*) { return Status::OK(); }
 
 Status GRPCSourceNode::GenerateNextImpl(ExecState* exec_state) {
   PL_RETURN_IF_ERROR(PopRowBatch());
+  PL_RETURN_IF_ERROR(CoalescePendingRowBatches(exec_state->exec_mem_pool()));
   PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *rb_));
   return Status::OK();
 }
 
+Status GRPCSourceNode::CoalescePendingRowBatches(arrow::MemoryPool* mem_pool) {
+  const int64_t target_rows = FLAGS_carnot_grpc_source_coalesce_rows;
+  if (target_rows <= 1 || rb_->eow() || rb_->eos() || rb_->num_rows() >= target_rows) {
+    return Status::OK();
+  }
+
+  std::vector<std::unique_ptr<RowBatch>> batches;
+  int64_t num_rows = rb_->num_rows();
+  batches.push_back(std::move(rb_));
+  while (num_rows < target_rows && row_batch_queue_.size_approx() > 0) {
+    PL_RETURN_IF_ERROR(PopRowBatch());
+    num_rows += rb_->num_rows();
+    const bool window_boundary = rb_->eow() || rb_->eos();
+    batches.push_back(std::move(rb_));
+    if (window_boundary) {
+      break;
+    }
+  }
+  if (batches.size() == 1) {
+    rb_ = std::move(batches[0]);
+    return Status::OK();
+  }
+
+  // Concatenate per column at the buffer level; this avoids re-encoding individual values.
+  auto merged = std::make_unique<RowBatch>(batches[0]->desc(), num_rows);
+  for (int64_t col_idx = 0; col_idx < batches[0]->num_columns(); ++col_idx) {
+    arrow::ArrayVector chunks;
+    chunks.reserve(batches.size());
+    for (const auto& batch : batches) {
+      chunks.push_back(batch->ColumnAt(col_idx));
+    }
+    std::shared_ptr<arrow::Array> col;
+    PL_RETURN_IF_ERROR(arrow::Concatenate(chunks, mem_pool, &col));
+    PL_RETURN_IF_ERROR(merged->AddColumn(col));
+  }
+  // The merge never crosses an eow/eos boundary, so the markers of the last batch carry over.
+  merged->set_eow(batches.back()->eow());
+  merged->set_eos(batches.back()->eos());
+  rb_ = std::move(merged);
+  return Status::OK();
+}
+
 Status GRPCSourceNode::EnqueueRowBatch(
     std::unique_ptr<carnotpb::TransferResultChunkRequest> row_batch) {
-  if (!row_batch_queue_.enqueue(std::move(row_batch))) {
+  if (!row_batch_queue_.enqueue(QueuedBatch{std::move(row_batch), nullptr})) {
+    return error::Internal("Failed to enqueue RowBatch");
+  }
+  return Status::OK();
+}
+
+Status GRPCSourceNode::EnqueueRowBatch(std::unique_ptr<RowBatch> row_batch) {
+  if (!row_batch_queue_.enqueue(QueuedBatch{nullptr, std::move(row_batch)})) {
     return error::Internal("Failed to enqueue RowBatch");
   }
   return Status::OK();
@@ -65,19 +123,38 @@ Status GRPCSourceNode::EnqueueRowBatch(
 
 Status GRPCSourceNode::PopRowBatch() {
   DCHECK(NextBatchReady());
-  std::unique_ptr<carnotpb::TransferResultChunkRequest> rb_request;
-  bool got_one = row_batch_queue_.try_dequeue(rb_request);
+  QueuedBatch queued;
+  bool got_one = row_batch_queue_.try_dequeue(queued);
   if (!got_one) {
     return error::Internal(
         "Called GRPCSourceNode::OptionallyPopRowBatch but there was no available row batch in the "
         "queue.");
   }
-  if (!rb_request->has_query_result() || !rb_request->query_result().has_row_batch()) {
+  if (consumed_batch_cb_) {
+    consumed_batch_cb_();
+  }
+  if (queued.row_batch != nullptr) {
+    // In-process handoff: the batch never went through a proto, use it as-is.
+    rb_ = std::move(queued.row_batch);
+    return Status::OK();
+  }
+  auto rb_request = std::move(queued.request);
+  if (!rb_request->has_query_result() || (!rb_request->query_result().has_row_batch() &&
+                                          !rb_request->query_result().has_arrow_row_batch())) {
     return error::Internal(
         "GRPCSourceNode::PopRowBatch expected TransferResultChunkRequest to have RowBatch "
         "message.");
   }
 
+  if (rb_request->query_result().has_arrow_row_batch()) {
+    // The resulting RowBatch references the request's buffers directly, so hand the request's
+    // ownership over to the columns rather than copying the data out.
+    std::shared_ptr<const carnotpb::TransferResultChunkRequest> owner(std::move(rb_request));
+    PL_ASSIGN_OR_RETURN(
+        rb_, RowBatch::FromArrowBuffersProto(owner->query_result().arrow_row_batch(), owner));
+    return Status::OK();
+  }
+
   PL_ASSIGN_OR_RETURN(rb_, RowBatch::FromProto(rb_request->query_result().row_batch()));
   return Status::OK();
 }
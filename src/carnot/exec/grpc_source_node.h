@@ -19,6 +19,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,17 +33,39 @@
 
 #include "blockingconcurrentqueue.h"
 
+DECLARE_int32(carnot_grpc_source_coalesce_rows);
+
 namespace px {
 namespace carnot {
 namespace exec {
 
 class GRPCSourceNode : public SourceNode {
  public:
+  // Bounds the number of requests that may be pending in row_batch_queue_. When the queue is
+  // full, the GRPC router stops reading from the result stream, which propagates backpressure
+  // to the upstream sink node through gRPC's flow control.
+  static constexpr size_t kDefaultResultQueueCapacity = 64;
+
   GRPCSourceNode() = default;
   virtual ~GRPCSourceNode() = default;
 
   bool NextBatchReady() override;
   virtual Status EnqueueRowBatch(std::unique_ptr<carnotpb::TransferResultChunkRequest> row_batch);
+  // In-process fast path: accepts an already-materialized row batch from a sink running in the
+  // same process, skipping the proto round trip entirely.
+  virtual Status EnqueueRowBatch(std::unique_ptr<table_store::schema::RowBatch> row_batch);
+
+  // Whether the pending queue has room for another row batch. Safe to call concurrently with
+  // the exec thread, which only ever shrinks the queue.
+  bool HasPendingCapacity() const { return row_batch_queue_.size_approx() < result_queue_capacity_; }
+  size_t queued_batches() const { return row_batch_queue_.size_approx(); }
+  void set_result_queue_capacity(size_t capacity) { result_queue_capacity_ = capacity; }
+
+  // Invoked each time the exec thread dequeues a row batch. Used by the GRPC router to wake
+  // result streams that are waiting for the queue to drain.
+  void set_consumed_batch_callback(std::function<void()> consumed_batch_cb) {
+    consumed_batch_cb_ = std::move(consumed_batch_cb);
+  }
 
   // Tracks whether the upstream sink node has successfully initiated the connection to
   // this remote source. Used by the exec graph to determine whether or not any sources have
@@ -65,13 +88,25 @@ class GRPCSourceNode : public SourceNode {
   Status GenerateNextImpl(ExecState* exec_state) override;
 
  private:
+  // A pending batch is either a serialized result chunk from a remote sink or a row batch handed
+  // over directly by a sink in the same process.
+  struct QueuedBatch {
+    std::unique_ptr<carnotpb::TransferResultChunkRequest> request;
+    std::unique_ptr<table_store::schema::RowBatch> row_batch;
+  };
+
   Status PopRowBatch();
+  // Merges further pending batches into rb_ up to the coalescing target, so that downstream
+  // nodes pay per-batch overhead once per target-sized batch rather than once per (possibly
+  // tiny) incoming batch. Never merges across an eow/eos boundary.
+  Status CoalescePendingRowBatches(arrow::MemoryPool* mem_pool);
 
   std::unique_ptr<table_store::schema::RowBatch> rb_;
-  moodycamel::BlockingConcurrentQueue<std::unique_ptr<carnotpb::TransferResultChunkRequest>>
-      row_batch_queue_;
+  moodycamel::BlockingConcurrentQueue<QueuedBatch> row_batch_queue_;
 
   std::unique_ptr<plan::GRPCSourceOperator> plan_node_;
+  size_t result_queue_capacity_ = kDefaultResultQueueCapacity;
+  std::function<void()> consumed_batch_cb_;
   bool upstream_initiated_connection_ = false;
   bool upstream_closed_connection_ = false;
 };
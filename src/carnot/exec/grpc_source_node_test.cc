@@ -18,6 +18,7 @@
 
 #include "src/carnot/exec/grpc_source_node.h"
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -87,6 +88,142 @@ TEST_F(GRPCSourceNodeTest, basic) {
   EXPECT_FALSE(tester.node()->HasBatchesRemaining());
 }
 
+TEST_F(GRPCSourceNodeTest, arrow_row_batch) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<plan::Operator> plan_node = plan::GRPCSourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<GRPCSourceNode, plan::GRPCSourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(tester.node()->HasBatchesRemaining());
+    EXPECT_FALSE(tester.node()->NextBatchReady());
+
+    std::vector<types::Int64Value> data(i, i);
+    auto rb = RowBatchBuilder(output_rd, i, /*eow*/ i == 2, /*eos*/ i == 2)
+                  .AddColumn<types::Int64Value>(data)
+                  .get();
+
+    auto rb_wrapper = std::make_unique<carnotpb::TransferResultChunkRequest>();
+    EXPECT_OK(rb.ToArrowBuffersProto(rb_wrapper->mutable_query_result()->mutable_arrow_row_batch()));
+    EXPECT_TRUE(tester.node()->EnqueueRowBatch(std::move(rb_wrapper)).ok());
+
+    EXPECT_TRUE(tester.node()->NextBatchReady());
+    tester.GenerateNextResult().ExpectRowBatch(rb);
+  }
+
+  EXPECT_FALSE(tester.node()->NextBatchReady());
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+}
+
+TEST_F(GRPCSourceNodeTest, local_row_batch) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<plan::Operator> plan_node = plan::GRPCSourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<GRPCSourceNode, plan::GRPCSourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(tester.node()->HasBatchesRemaining());
+    EXPECT_FALSE(tester.node()->NextBatchReady());
+
+    std::vector<types::Int64Value> data(i, i);
+    auto rb = RowBatchBuilder(output_rd, i, /*eow*/ i == 2, /*eos*/ i == 2)
+                  .AddColumn<types::Int64Value>(data)
+                  .get();
+
+    // In-process handoff from a sink in the same process: no proto round trip.
+    EXPECT_OK(tester.node()->EnqueueRowBatch(std::make_unique<RowBatch>(rb)));
+
+    EXPECT_TRUE(tester.node()->NextBatchReady());
+    tester.GenerateNextResult().ExpectRowBatch(rb);
+  }
+
+  EXPECT_FALSE(tester.node()->NextBatchReady());
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+}
+
+TEST_F(GRPCSourceNodeTest, coalesce_pending_batches) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<plan::Operator> plan_node = plan::GRPCSourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<GRPCSourceNode, plan::GRPCSourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+
+  // Three small pending batches, with an eow boundary in the middle of the queue.
+  auto enqueue = [&](const RowBatch& rb) {
+    auto rb_wrapper = std::make_unique<carnotpb::TransferResultChunkRequest>();
+    EXPECT_OK(rb.ToProto(rb_wrapper->mutable_query_result()->mutable_row_batch()));
+    EXPECT_OK(tester.node()->EnqueueRowBatch(std::move(rb_wrapper)));
+  };
+  enqueue(RowBatchBuilder(output_rd, 2, /*eow*/ false, /*eos*/ false)
+              .AddColumn<types::Int64Value>({1, 2})
+              .get());
+  enqueue(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ false)
+              .AddColumn<types::Int64Value>({3, 4})
+              .get());
+  enqueue(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+              .AddColumn<types::Int64Value>({5, 6})
+              .get());
+
+  // The first two batches are merged up to the eow boundary; the final window stays separate.
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 4, /*eow*/ true, /*eos*/ false)
+          .AddColumn<types::Int64Value>({1, 2, 3, 4})
+          .get());
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+          .AddColumn<types::Int64Value>({5, 6})
+          .get());
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+}
+
+TEST_F(GRPCSourceNodeTest, queue_capacity) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<plan::Operator> plan_node = plan::GRPCSourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  // This test exercises per-batch queue mechanics, so keep batches from being merged.
+  const int32_t orig_coalesce_rows = FLAGS_carnot_grpc_source_coalesce_rows;
+  FLAGS_carnot_grpc_source_coalesce_rows = 0;
+
+  auto tester = exec::ExecNodeTester<GRPCSourceNode, plan::GRPCSourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+
+  tester.node()->set_result_queue_capacity(2);
+  int num_consumed = 0;
+  tester.node()->set_consumed_batch_callback([&] { num_consumed++; });
+
+  std::vector<RowBatch> batches;
+  for (auto i = 0; i < 2; ++i) {
+    EXPECT_TRUE(tester.node()->HasPendingCapacity());
+    auto rb = RowBatchBuilder(output_rd, 1, /*eow*/ i == 1, /*eos*/ i == 1)
+                  .AddColumn<types::Int64Value>({i})
+                  .get();
+    auto rb_wrapper = std::make_unique<carnotpb::TransferResultChunkRequest>();
+    EXPECT_OK(rb.ToProto(rb_wrapper->mutable_query_result()->mutable_row_batch()));
+    EXPECT_OK(tester.node()->EnqueueRowBatch(std::move(rb_wrapper)));
+    batches.push_back(rb);
+  }
+
+  EXPECT_FALSE(tester.node()->HasPendingCapacity());
+  EXPECT_EQ(2, tester.node()->queued_batches());
+
+  // Draining a batch frees capacity and fires the consumed batch callback.
+  tester.GenerateNextResult().ExpectRowBatch(batches[0]);
+  EXPECT_TRUE(tester.node()->HasPendingCapacity());
+  EXPECT_EQ(1, num_consumed);
+
+  tester.GenerateNextResult().ExpectRowBatch(batches[1]);
+  EXPECT_EQ(2, num_consumed);
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+
+  FLAGS_carnot_grpc_source_coalesce_rows = orig_coalesce_rows;
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -47,7 +47,7 @@ Status MapNode::InitImpl(const plan::Operator& plan_node) {
 Status MapNode::PrepareImpl(ExecState* exec_state) {
   function_ctx_ = exec_state->CreateFunctionContext();
   evaluator_ = ScalarExpressionEvaluator::Create(
-      plan_node_->expressions(), ScalarExpressionEvaluatorType::kArrowNative, function_ctx_.get());
+      plan_node_->expressions(), ScalarExpressionEvaluatorType::kCompiled, function_ctx_.get());
   return Status::OK();
 }
 
@@ -62,6 +62,14 @@ Status MapNode::CloseImpl(ExecState* exec_state) {
   return Status::OK();
 }
 Status MapNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  // Empty batches (common after an upstream filter) don't need any expressions evaluated;
+  // this matters because map expressions can invoke expensive metadata UDFs.
+  if (rb.num_rows() == 0) {
+    PL_ASSIGN_OR_RETURN(auto empty_rb,
+                        RowBatch::WithZeroRows(*output_descriptor_, rb.eow(), rb.eos()));
+    PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *empty_rb));
+    return Status::OK();
+  }
   RowBatch output_rb(*output_descriptor_, rb.num_rows());
   PL_RETURN_IF_ERROR(evaluator_->Evaluate(exec_state, rb, &output_rb));
   output_rb.set_eow(rb.eow());
@@ -72,10 +72,13 @@ Status MemorySinkNode::OpenImpl(ExecState*) { return Status::OK(); }
 
 Status MemorySinkNode::CloseImpl(ExecState*) { return Status::OK(); }
 
-Status MemorySinkNode::ConsumeNextImpl(ExecState*, const RowBatch& rb, size_t) {
+Status MemorySinkNode::ConsumeNextImpl(ExecState* exec_state_, const RowBatch& rb, size_t) {
   DCHECK_EQ(static_cast<size_t>(0), children().size());
   if (rb.num_rows() > 0 || (rb.eow() || rb.eos())) {
     PL_RETURN_IF_ERROR(table_->WriteRowBatch(rb));
+    if (exec_state_->result_capture_enabled()) {
+      exec_state_->CaptureResultBatch(plan_node_->TableName(), std::make_shared<RowBatch>(rb));
+    }
   }
   return Status::OK();
 }
@@ -34,6 +34,57 @@ namespace exec {
 
 using StartSpec = Table::Cursor::StartSpec;
 using StopSpec = Table::Cursor::StopSpec;
+using PredicateSpec = Table::Cursor::PredicateSpec;
+
+namespace {
+
+Table::Cursor::ColumnPredicate::Op PredicateOpFromProto(
+    planpb::MemorySourceOperator::ColumnPredicate::Op op) {
+  switch (op) {
+    case planpb::MemorySourceOperator::ColumnPredicate::LESS_THAN_OR_EQUAL:
+      return Table::Cursor::ColumnPredicate::Op::LessThanOrEqual;
+    case planpb::MemorySourceOperator::ColumnPredicate::GREATER_THAN_OR_EQUAL:
+      return Table::Cursor::ColumnPredicate::Op::GreaterThanOrEqual;
+    case planpb::MemorySourceOperator::ColumnPredicate::STRING_PREFIX:
+      return Table::Cursor::ColumnPredicate::Op::StringPrefix;
+    case planpb::MemorySourceOperator::ColumnPredicate::EQUAL:
+    default:
+      return Table::Cursor::ColumnPredicate::Op::Equal;
+  }
+}
+
+PredicateSpec PredicateSpecFromPlanNode(const plan::MemorySourceOperator& plan_node) {
+  PredicateSpec predicate;
+  for (const auto& pred_pb : plan_node.predicates()) {
+    Table::Cursor::ColumnPredicate pred;
+    pred.col_idx = pred_pb.column_index();
+    pred.op = PredicateOpFromProto(pred_pb.op());
+    switch (pred_pb.value().value_case()) {
+      case planpb::ScalarValue::kBoolValue:
+        pred.value = pred_pb.value().bool_value();
+        break;
+      case planpb::ScalarValue::kInt64Value:
+        pred.value = pred_pb.value().int64_value();
+        break;
+      case planpb::ScalarValue::kTime64NsValue:
+        pred.value = pred_pb.value().time64_ns_value();
+        break;
+      case planpb::ScalarValue::kFloat64Value:
+        pred.value = pred_pb.value().float64_value();
+        break;
+      case planpb::ScalarValue::kStringValue:
+        pred.value = pred_pb.value().string_value();
+        break;
+      default:
+        // Predicates on unsupported value types can't be used for pruning; drop them.
+        continue;
+    }
+    predicate.push_back(std::move(pred));
+  }
+  return predicate;
+}
+
+}  // namespace
 
 std::string MemorySourceNode::DebugStringImpl() {
   return absl::Substitute("Exec::MemorySourceNode: <name: $0, output: $1>", plan_node_->TableName(),
@@ -85,7 +136,16 @@ Status MemorySourceNode::OpenImpl(ExecState* exec_state) {
       stop_spec.type = StopSpec::StopType::CurrentEndOfTable;
     }
   }
-  cursor_ = std::make_unique<Table::Cursor>(table_, start_spec, stop_spec);
+  if (plan_node_->HasRowsLimit()) {
+    // A downstream limit bounds how many rows are needed; stop the scan (and truncate the final
+    // batch) as soon as that many rows have been read.
+    stop_spec.max_rows = plan_node_->rows_limit();
+  }
+  // Push the projected column set into the cursor, so only the columns the query needs are ever
+  // converted or copied out of the table.
+  cursor_ = std::make_unique<Table::Cursor>(table_, start_spec, stop_spec,
+                                            PredicateSpecFromPlanNode(*plan_node_),
+                                            plan_node_->Columns());
 
   return Status::OK();
 }
@@ -108,7 +168,7 @@ StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::GetNextRowBatch(ExecState*
                                   /* eos */ cursor_->Done());
   }
 
-  PL_ASSIGN_OR_RETURN(auto row_batch, cursor_->GetNextRowBatch(plan_node_->Columns()));
+  PL_ASSIGN_OR_RETURN(auto row_batch, cursor_->GetNextRowBatch());
 
   rows_processed_ += row_batch->num_rows();
   bytes_processed_ += row_batch->NumBytes();
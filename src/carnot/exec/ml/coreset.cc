@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "src/carnot/exec/ml/coreset.h"
+#include "src/carnot/exec/ml/parallel.h"
 #include "src/carnot/exec/ml/sampling.h"
 
 namespace px {
@@ -29,7 +30,16 @@ namespace ml {
 void KMeansCoreset::Construct(const Eigen::MatrixXf& points, const Eigen::VectorXf& weights) {
   auto weight_sum = weights.sum();
   auto weighted_mean = ((weights.transpose() * points) / weight_sum).eval();
-  auto dists = (points.rowwise() - weighted_mean).rowwise().squaredNorm().eval();
+  // The per-point distances to the weighted mean dominate construction cost for the large
+  // union sets produced by the coreset tree, so they are computed in parallel chunks.
+  Eigen::VectorXf dists(points.rows());
+  ParallelForRows(points.rows(), MLParallelism(points.rows()),
+                  [&](size_t, size_t start, size_t count) {
+                    dists.segment(start, count) =
+                        (points.middleRows(start, count).rowwise() - weighted_mean)
+                            .rowwise()
+                            .squaredNorm();
+                  });
   auto weighted_dists = (weights.array() * dists.array()).matrix().eval();
   auto weighted_dists_sum = weighted_dists.sum();
 
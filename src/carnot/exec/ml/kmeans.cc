@@ -18,7 +18,9 @@
 
 #include "src/carnot/exec/ml/kmeans.h"
 #include <random>
+#include <vector>
 
+#include "src/carnot/exec/ml/parallel.h"
 #include "src/carnot/exec/ml/sampling.h"
 
 namespace px {
@@ -52,15 +54,30 @@ bool KMeans::LloydsIteration(const Eigen::MatrixXf& points, const Eigen::VectorX
   Eigen::MatrixXf new_centroids = Eigen::MatrixXf::Zero(centroids_.rows(), centroids_.cols());
   Eigen::ArrayXf centroid_weights = Eigen::ArrayXf::Zero(centroids_.rows());
 
-  for (int i = 0; i < points.rows(); i++) {
-    Eigen::VectorXf::Index closest_centroid;
-    (centroids_.rowwise() - points(i, Eigen::indexing::all))
-        .rowwise()
-        .squaredNorm()
-        .minCoeff(&closest_centroid);
-    new_centroids(closest_centroid, Eigen::indexing::all) +=
-        weights(i) * points(i, Eigen::indexing::all);
-    centroid_weights(closest_centroid) += weights(i);
+  // The assignment step is done chunkwise: each chunk computes its point-to-centroid dot
+  // products with a single matrix product (which Eigen vectorizes, unlike the per-point
+  // rowwise difference) and accumulates into per-thread partial sums that are reduced below.
+  // argmin_c |x - c|^2 == argmin_c (|c|^2 - 2 x.c), so the |x|^2 term is dropped.
+  size_t n_threads = MLParallelism(points.rows());
+  Eigen::VectorXf centroid_sqnorms = centroids_.rowwise().squaredNorm();
+  std::vector<Eigen::MatrixXf> partial_centroids(
+      n_threads, Eigen::MatrixXf::Zero(centroids_.rows(), centroids_.cols()));
+  std::vector<Eigen::ArrayXf> partial_weights(n_threads,
+                                              Eigen::ArrayXf::Zero(centroids_.rows()));
+  ParallelForRows(points.rows(), n_threads, [&](size_t tid, size_t start, size_t count) {
+    auto chunk = points.middleRows(start, count);
+    Eigen::MatrixXf cross = chunk * centroids_.transpose();
+    for (Eigen::Index i = 0; i < static_cast<Eigen::Index>(count); i++) {
+      Eigen::VectorXf::Index closest_centroid;
+      (centroid_sqnorms.transpose() - 2.0f * cross.row(i)).minCoeff(&closest_centroid);
+      auto weight = weights(static_cast<Eigen::Index>(start) + i);
+      partial_centroids[tid].row(closest_centroid) += weight * chunk.row(i);
+      partial_weights[tid](closest_centroid) += weight;
+    }
+  });
+  for (size_t tid = 0; tid < n_threads; tid++) {
+    new_centroids += partial_centroids[tid];
+    centroid_weights += partial_weights[tid];
   }
 
   for (int i = 0; i < k_; i++) {
@@ -83,17 +100,19 @@ void KMeans::KMeansPlusPlusInit(const Eigen::MatrixXf& points, const Eigen::Vect
   auto firstCentroid = dist(random_gen_);
   centroids_(0, Eigen::indexing::all) = points(firstCentroid, Eigen::indexing::all);
 
+  // The distance from every point to its closest chosen centroid is computed batched:
+  // |x - c|^2 = |x|^2 + |c|^2 - 2 x.c, with the cross terms coming from one matrix product
+  // per round instead of a rowwise difference per point.
+  Eigen::VectorXf point_sqnorms = points.rowwise().squaredNorm();
   Eigen::VectorXf probDist(points.rows());
   for (auto i = 1; i < k_; i++) {
-    for (auto j = 0; j < probDist.rows(); j++) {
-      auto point = points(j, Eigen::indexing::all);
-      Eigen::VectorXf::Index closestCentroid;
-      auto dist = (centroids_(Eigen::seq(0, i - 1), Eigen::indexing::all).rowwise() - point)
-                      .rowwise()
-                      .squaredNorm()
-                      .minCoeff(&closestCentroid);
-      probDist(j) = weights(j) * dist;
-    }
+    auto chosen = centroids_.topRows(i);
+    Eigen::MatrixXf cross = points * chosen.transpose();
+    Eigen::VectorXf min_dists =
+        ((-2.0f * cross).rowwise() + chosen.rowwise().squaredNorm().transpose())
+            .rowwise()
+            .minCoeff();
+    probDist = (weights.array() * (min_dists + point_sqnorms).cwiseMax(0.0f).array()).matrix();
     std::discrete_distribution<> pointDist(probDist.begin(), probDist.end());
     auto ind = pointDist(random_gen_);
     centroids_(i, Eigen::indexing::all) = points(ind, Eigen::indexing::all);
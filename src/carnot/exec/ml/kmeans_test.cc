@@ -69,6 +69,31 @@ TEST(KMeans, serialize_deserialize) {
   EXPECT_THAT(kmeans2.centroids(), UnorderedRowsAre(points, 1e-6f));
 }
 
+TEST(KMeans, large_set_parallel_path) {
+  // Enough points that the Lloyd assignment step splits across threads; the result must
+  // match the obvious clustering regardless of how the chunks are divided.
+  int points_per_cluster = 4096;
+  int d = 4;
+  Eigen::MatrixXf points(2 * points_per_cluster, d);
+  points.topRows(points_per_cluster) =
+      Eigen::MatrixXf::Random(points_per_cluster, d).array() + 10.0f;
+  points.bottomRows(points_per_cluster) =
+      Eigen::MatrixXf::Random(points_per_cluster, d).array() - 10.0f;
+  Eigen::VectorXf weights = Eigen::VectorXf::Ones(2 * points_per_cluster);
+
+  Eigen::MatrixXf expected_centroids(2, d);
+  expected_centroids.row(0) = Eigen::VectorXf::Constant(d, 10.0f);
+  expected_centroids.row(1) = Eigen::VectorXf::Constant(d, -10.0f);
+
+  auto set = std::make_shared<WeightedPointSet>(points, weights);
+  KMeans kmeans(2);
+  kmeans.Fit(set);
+
+  ASSERT_THAT(kmeans.centroids(), UnorderedRowsAre(expected_centroids, 0.2));
+  EXPECT_NE(kmeans.Transform(points.row(0).transpose()),
+            kmeans.Transform(points.row(2 * points_per_cluster - 1).transpose()));
+}
+
 TEST(KMeans, trimodal_normal_dist) {
   int k = 3;
 
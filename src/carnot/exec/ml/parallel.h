@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace px {
+namespace carnot {
+namespace exec {
+namespace ml {
+
+// Minimum rows each worker should get before a row loop is split across threads; below this
+// the thread startup cost outweighs the parallelism.
+constexpr size_t kMinRowsPerMLThread = 1024;
+
+/**
+ * Returns the number of threads to use for a row loop over `rows` rows: at most the hardware
+ * concurrency, and small enough that every thread gets at least kMinRowsPerMLThread rows.
+ */
+inline size_t MLParallelism(size_t rows) {
+  size_t hw = std::thread::hardware_concurrency();
+  if (hw == 0) {
+    hw = 1;
+  }
+  return std::max<size_t>(1, std::min(hw, rows / kMinRowsPerMLThread));
+}
+
+/**
+ * Runs fn(thread_idx, start, count) over contiguous chunks of [0, rows) on n_threads threads
+ * and blocks until all chunks are done. thread_idx is in [0, n_threads) so callers can
+ * accumulate into per-thread partial results and reduce afterwards. Chunk 0 runs on the
+ * calling thread. fn must be safe to run concurrently on disjoint row ranges.
+ */
+inline void ParallelForRows(size_t rows, size_t n_threads,
+                            const std::function<void(size_t, size_t, size_t)>& fn) {
+  if (n_threads <= 1 || rows == 0) {
+    fn(0, 0, rows);
+    return;
+  }
+  size_t chunk = (rows + n_threads - 1) / n_threads;
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads - 1);
+  for (size_t t = 1; t < n_threads; ++t) {
+    size_t start = t * chunk;
+    if (start >= rows) {
+      break;
+    }
+    threads.emplace_back(fn, t, start, std::min(chunk, rows - start));
+  }
+  fn(0, 0, std::min(chunk, rows));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace ml
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
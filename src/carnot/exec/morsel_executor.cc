@@ -0,0 +1,54 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/morsel_executor.h"
+
+#include <algorithm>
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+void MorselExecutor::ParallelFor(size_t num_rows, size_t morsel_size,
+                                 const std::function<void(size_t start, size_t count)>& fn,
+                                 int64_t weight) {
+  DCHECK_GT(morsel_size, 0U);
+  if (num_rows == 0) {
+    return;
+  }
+  // Small inputs aren't worth the dispatch overhead; run them inline.
+  if (num_rows <= morsel_size || task_executor_->num_threads() == 1) {
+    fn(0, num_rows);
+    return;
+  }
+
+  size_t num_morsels = (num_rows + morsel_size - 1) / morsel_size;
+  // The morsel index is the affinity key, which spreads consecutive morsels across workers;
+  // stealing rebalances if morsel costs are skewed.
+  auto group = task_executor_->CreateTaskGroup(/* cancelled */ nullptr, weight);
+  for (size_t i = 0; i < num_morsels; ++i) {
+    size_t start = i * morsel_size;
+    size_t count = std::min(morsel_size, num_rows - start);
+    group->Submit(i, [&fn, start, count] { fn(start, count); });
+  }
+  group->Wait();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
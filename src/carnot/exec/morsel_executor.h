@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "src/carnot/exec/task_executor.h"
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+// The default number of rows processed by a single morsel task. Sized so that a morsel's
+// input and output columns stay resident in the L2 cache for the common numeric widths.
+constexpr size_t kDefaultMorselSizeRows = 16384;
+
+/**
+ * MorselExecutor runs row-range tasks (morsels) on a TaskExecutor's work-stealing worker pool.
+ *
+ * Callers split a batch-level operation into morsels with ParallelFor. Consecutive morsels are
+ * spread across workers; idle workers steal so that skewed morsel costs do not serialize
+ * execution. ParallelFor blocks until all morsels complete, so the exec node's single-threaded
+ * push model is preserved at batch granularity.
+ *
+ * The functions passed to ParallelFor must be safe to run concurrently on disjoint row
+ * ranges; they must not touch shared mutable state without synchronization.
+ */
+class MorselExecutor : public NotCopyable {
+ public:
+  /**
+   * Creates a morsel executor on a shared task executor. The task executor must outlive this
+   * object. This is the production configuration: one TaskExecutor per agent, shared by all
+   * parallel work.
+   */
+  explicit MorselExecutor(TaskExecutor* task_executor) : task_executor_(task_executor) {}
+
+  /**
+   * Creates a morsel executor with its own pool of the given number of worker threads.
+   * @param num_threads The number of workers. Must be >= 1.
+   */
+  explicit MorselExecutor(size_t num_threads)
+      : owned_task_executor_(std::make_unique<TaskExecutor>(num_threads)),
+        task_executor_(owned_task_executor_.get()) {}
+
+  /**
+   * Splits [0, num_rows) into morsels of at most morsel_size rows and runs fn(start, count)
+   * for each morsel on the worker pool. Blocks until all morsels have completed.
+   * Ranges smaller than a single morsel are run inline on the calling thread.
+   * The weight sets this operation's scheduling share relative to other concurrent work on the
+   * pool (see TaskExecutor); 1 is the baseline.
+   */
+  void ParallelFor(size_t num_rows, size_t morsel_size,
+                   const std::function<void(size_t start, size_t count)>& fn, int64_t weight = 1);
+
+  size_t num_threads() const { return task_executor_->num_threads(); }
+
+ private:
+  std::unique_ptr<TaskExecutor> owned_task_executor_;
+  TaskExecutor* const task_executor_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/morsel_executor.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+TEST(MorselExecutorTest, covers_all_rows_exactly_once) {
+  MorselExecutor executor(4);
+  constexpr size_t kNumRows = 100000;
+  constexpr size_t kMorselSize = 1024;
+
+  std::vector<std::atomic<int>> counts(kNumRows);
+  executor.ParallelFor(kNumRows, kMorselSize, [&](size_t start, size_t count) {
+    for (size_t i = start; i < start + count; ++i) {
+      counts[i].fetch_add(1);
+    }
+  });
+
+  for (size_t i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(1, counts[i].load()) << "row " << i;
+  }
+}
+
+TEST(MorselExecutorTest, small_input_runs_inline) {
+  MorselExecutor executor(4);
+  std::vector<int64_t> data(100);
+  executor.ParallelFor(data.size(), kDefaultMorselSizeRows, [&](size_t start, size_t count) {
+    for (size_t i = start; i < start + count; ++i) {
+      data[i] = static_cast<int64_t>(i);
+    }
+  });
+  EXPECT_EQ(99 * 100 / 2, std::accumulate(data.begin(), data.end(), 0L));
+}
+
+TEST(MorselExecutorTest, empty_input_is_a_noop) {
+  MorselExecutor executor(2);
+  bool called = false;
+  executor.ParallelFor(0, kDefaultMorselSizeRows, [&](size_t, size_t) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(MorselExecutorTest, reusable_across_calls) {
+  MorselExecutor executor(2);
+  for (int iter = 0; iter < 10; ++iter) {
+    std::atomic<size_t> total(0);
+    executor.ParallelFor(10000, 64, [&](size_t, size_t count) { total.fetch_add(count); });
+    EXPECT_EQ(10000U, total.load());
+  }
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -19,14 +19,19 @@
 #include "src/carnot/exec/otel_export_sink_node.h"
 
 #include <rapidjson/document.h>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <queue>
 #include <random>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include <absl/strings/str_cat.h>
 #include <absl/strings/substitute.h>
 
 #include "glog/logging.h"
@@ -37,6 +42,10 @@
 #include "src/shared/types/typespb/types.pb.h"
 #include "src/table_store/table_store.h"
 
+DEFINE_bool(enable_async_otel_export, gflags::BoolFromEnv("PL_ENABLE_ASYNC_OTEL_EXPORT", false),
+            "If true, OTel export sinks send their requests from a background thread with a "
+            "bounded queue, so slow OTLP endpoints don't stall query execution.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -49,6 +58,28 @@ const int64_t kOTelTraceIDLength = 16;
 
 const int64_t kB3ShortTraceIDLength = 8;
 
+namespace {
+
+// Bound on the number of queued export requests per sink; beyond this the oldest request is
+// dropped so the exec graph is never backpressured by a slow endpoint.
+constexpr size_t kMaxPendingExportRequests = 128;
+constexpr int kOTelExportMaxRetries = 3;
+constexpr std::chrono::milliseconds kOTelExportInitialBackoff{100};
+
+bool RetryableOTelStatus(const grpc::Status& status) {
+  switch (status.error_code()) {
+    case grpc::StatusCode::UNAVAILABLE:
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+    case grpc::StatusCode::ABORTED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 std::string OTelExportSinkNode::DebugStringImpl() {
   return absl::Substitute("Exec::OTelExportSinkNode: $0", plan_node_->DebugString());
 }
@@ -63,6 +94,35 @@ Status OTelExportSinkNode::InitImpl(const plan::Operator& plan_node) {
   input_descriptor_ = std::make_unique<RowDescriptor>(input_descriptors_[0]);
   const auto* sink_plan_node = static_cast<const plan::OTelExportSinkOperator*>(&plan_node);
   plan_node_ = std::make_unique<plan::OTelExportSinkOperator>(*sink_plan_node);
+
+  metric_agg_states_.resize(plan_node_->metrics().size());
+  metric_latest_window_.assign(plan_node_->metrics().size(), std::numeric_limits<int64_t>::min());
+  metric_bucket_base_.assign(plan_node_->metrics().size(), 0.0);
+  for (const auto& [metric_idx, metric_pb] : Enumerate(plan_node_->metrics())) {
+    if (!metric_pb.has_pre_aggregation()) {
+      has_row_level_metrics_ = true;
+      continue;
+    }
+    const auto& preagg = metric_pb.pre_aggregation();
+    if (!metric_pb.has_gauge()) {
+      return error::InvalidArgument("OTel pre-aggregation requires a gauge metric");
+    }
+    if (preagg.window_ns() <= 0) {
+      return error::InvalidArgument("OTel pre-aggregation requires a positive window");
+    }
+    if (preagg.aggregation() != planpb::OTelMetric::PreAggregation::SUM &&
+        preagg.aggregation() != planpb::OTelMetric::PreAggregation::HISTOGRAM) {
+      return error::InvalidArgument("OTel pre-aggregation requires an aggregation type");
+    }
+    if (!plan_node_->resource_attributes_optional_json_encoded().empty()) {
+      return error::InvalidArgument(
+          "OTel pre-aggregation does not support JSON-encoded resource attributes");
+    }
+    // Clamp the scale so the bucket base stays representable.
+    const int32_t scale = std::min(std::max(preagg.scale(), -4), 20);
+    metric_bucket_base_[metric_idx] = std::pow(2.0, std::pow(2.0, -scale));
+    has_pre_aggregated_metrics_ = true;
+  }
   return Status::OK();
 }
 
@@ -76,18 +136,38 @@ Status OTelExportSinkNode::OpenImpl(ExecState* exec_state) {
   if (plan_node_->spans().size()) {
     trace_service_stub_ = exec_state->TraceServiceStub(plan_node_->url(), plan_node_->insecure());
   }
+  if (FLAGS_enable_async_otel_export) {
+    exporter_thread_ = std::thread(&OTelExportSinkNode::ExporterThread, this);
+  }
   return Status::OK();
 }
 
 Status OTelExportSinkNode::CloseImpl(ExecState* exec_state) {
-  if (sent_eos_) {
-    return Status::OK();
+  Status export_status;
+  if (exporter_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(export_mu_);
+      exporter_shutdown_ = true;
+    }
+    // The exporter drains whatever is still queued before exiting.
+    export_cv_.notify_all();
+    exporter_thread_.join();
+
+    std::lock_guard<std::mutex> lock(export_mu_);
+    export_status = export_status_;
+    if (dropped_requests_ > 0) {
+      LOG(WARNING) << absl::Substitute(
+          "OTelExportSinkNode $0 dropped $1 export requests because the endpoint couldn't keep up",
+          plan_node_->id(), dropped_requests_);
+    }
   }
 
-  LOG(INFO) << absl::Substitute("Closing OTelExportSinkNode $0 in query $1 before receiving EOS",
-                                plan_node_->id(), exec_state->query_id().str());
+  if (!sent_eos_) {
+    LOG(INFO) << absl::Substitute("Closing OTelExportSinkNode $0 in query $1 before receiving EOS",
+                                  plan_node_->id(), exec_state->query_id().str());
+  }
 
-  return Status::OK();
+  return export_status;
 }
 
 template <typename C>
@@ -207,16 +287,47 @@ Status FormatOTelStatus(int64_t id, const grpc::Status& status) {
 
 using ::opentelemetry::proto::metrics::v1::ResourceMetrics;
 Status OTelExportSinkNode::ConsumeMetrics(const RowBatch& rb) {
-  grpc::ClientContext context;
-  for (const auto& header : plan_node_->endpoint_headers()) {
-    context.AddMetadata(header.first, header.second);
-  }
-  context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
-
-  metrics_response_.Clear();
   opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest request;
+  BuildMetricsRequest(rb, &request);
+  if (rb.eos()) {
+    // Flush every still-open window.
+    for (const auto& [metric_idx, metric_pb] : Enumerate(plan_node_->metrics())) {
+      if (metric_pb.has_pre_aggregation()) {
+        FlushMetricAggregates(metric_idx, metric_pb, std::numeric_limits<int64_t>::max(),
+                              &request);
+      }
+    }
+  }
+  // Pre-aggregation can leave a batch with nothing to ship until a window closes.
+  if (has_pre_aggregated_metrics_ && request.resource_metrics_size() == 0) {
+    return Status::OK();
+  }
+  if (!FLAGS_enable_async_otel_export) {
+    return SendMetricsRequest(request);
+  }
+  std::lock_guard<std::mutex> lock(export_mu_);
+  if (pending_metrics_.size() >= kMaxPendingExportRequests) {
+    pending_metrics_.pop_front();
+    ++dropped_requests_;
+  }
+  pending_metrics_.push_back(std::move(request));
+  export_cv_.notify_one();
+  return Status::OK();
+}
 
+void OTelExportSinkNode::BuildMetricsRequest(
+    const RowBatch& rb,
+    opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest* request_ptr) {
+  auto& request = *request_ptr;
   for (int64_t row_idx = 0; row_idx < rb.ColumnAt(0)->length(); ++row_idx) {
+    for (const auto& [metric_idx, metric_pb] : Enumerate(plan_node_->metrics())) {
+      if (metric_pb.has_pre_aggregation()) {
+        AccumulateMetricRow(metric_idx, metric_pb, rb, row_idx, request_ptr);
+      }
+    }
+    if (!has_row_level_metrics_) {
+      continue;
+    }
     ::opentelemetry::proto::metrics::v1::ResourceMetrics resource_metrics;
     auto resource = resource_metrics.mutable_resource();
     AddAttributes(resource->mutable_attributes(), plan_node_->resource_attributes_normal_encoding(),
@@ -226,6 +337,9 @@ Status OTelExportSinkNode::ConsumeMetrics(const RowBatch& rb) {
 
     auto library_metrics = resource_metrics.add_instrumentation_library_metrics();
     for (const auto& metric_pb : plan_node_->metrics()) {
+      if (metric_pb.has_pre_aggregation()) {
+        continue;
+      }
       auto metric = library_metrics->add_metrics();
       metric->set_name(metric_pb.name());
       metric->set_description(metric_pb.description());
@@ -280,12 +394,161 @@ Status OTelExportSinkNode::ConsumeMetrics(const RowBatch& rb) {
         },
         std::move(resource_metrics), rb, row_idx);
   }
+}
 
-  grpc::Status status = metrics_service_stub_->Export(&context, request, &metrics_response_);
-  if (!status.ok()) {
-    return FormatOTelStatus(plan_node_->id(), status);
+void OTelExportSinkNode::AccumulateMetricRow(
+    int64_t metric_idx, const planpb::OTelMetric& metric_pb, const RowBatch& rb, int64_t row_idx,
+    opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest* request) {
+  const auto& preagg = metric_pb.pre_aggregation();
+  auto time_col = rb.ColumnAt(metric_pb.time_column_index()).get();
+  const int64_t ts = types::GetValueFromArrowArray<types::TIME64NS>(time_col, row_idx);
+  const int64_t window_start = ts - (ts % preagg.window_ns());
+
+  double value;
+  if (metric_pb.gauge().has_float_column_index()) {
+    auto double_col = rb.ColumnAt(metric_pb.gauge().float_column_index()).get();
+    value = types::GetValueFromArrowArray<types::FLOAT64>(double_col, row_idx);
+  } else {
+    auto int_col = rb.ColumnAt(metric_pb.gauge().int_column_index()).get();
+    value = static_cast<double>(types::GetValueFromArrowArray<types::INT64>(int_col, row_idx));
+  }
+
+  google::protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue> resource_attrs;
+  AddAttributes(&resource_attrs, plan_node_->resource_attributes_normal_encoding(), rb, row_idx);
+  google::protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue> attrs;
+  AddAttributes(&attrs, metric_pb.attributes(), rb, row_idx);
+
+  std::string key = absl::StrCat(window_start);
+  for (const auto& kv : resource_attrs) {
+    absl::StrAppend(&key, "|", kv.SerializeAsString());
+  }
+  for (const auto& kv : attrs) {
+    absl::StrAppend(&key, "|", kv.SerializeAsString());
+  }
+
+  auto& state = metric_agg_states_[metric_idx][key];
+  if (state.count == 0) {
+    state.resource_attributes.Swap(&resource_attrs);
+    state.attributes.Swap(&attrs);
+    state.window_start_ns = window_start;
+  }
+  ++state.count;
+  state.sum += value;
+  if (preagg.aggregation() == planpb::OTelMetric::PreAggregation::HISTOGRAM) {
+    if (value <= 0) {
+      ++state.zero_count;
+    } else {
+      const int32_t bucket = static_cast<int32_t>(
+          std::ceil(std::log(value) / std::log(metric_bucket_base_[metric_idx])));
+      ++state.buckets[bucket];
+    }
+  }
+
+  // A row landing in a newer window closes every older one: input is time-bucketed, so
+  // once the stream moves on, older windows only lose late stragglers.
+  if (window_start > metric_latest_window_[metric_idx]) {
+    FlushMetricAggregates(metric_idx, metric_pb, window_start, request);
+    metric_latest_window_[metric_idx] = window_start;
+  }
+}
+
+void OTelExportSinkNode::FlushMetricAggregates(
+    int64_t metric_idx, const planpb::OTelMetric& metric_pb, int64_t up_to_window_start,
+    opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest* request) {
+  auto& states = metric_agg_states_[metric_idx];
+  std::vector<std::string> flush_keys;
+  for (const auto& [key, state] : states) {
+    if (state.window_start_ns < up_to_window_start) {
+      flush_keys.push_back(key);
+    }
+  }
+  // Emit in a deterministic order: by window, then key.
+  std::sort(flush_keys.begin(), flush_keys.end(),
+            [&states](const std::string& a, const std::string& b) {
+              return std::tie(states.at(a).window_start_ns, a) <
+                     std::tie(states.at(b).window_start_ns, b);
+            });
+
+  const auto& preagg = metric_pb.pre_aggregation();
+  for (const auto& key : flush_keys) {
+    auto& state = states[key];
+    auto* resource_metrics = request->add_resource_metrics();
+    *resource_metrics->mutable_resource()->mutable_attributes() =
+        std::move(state.resource_attributes);
+    auto* metric = resource_metrics->add_instrumentation_library_metrics()->add_metrics();
+    metric->set_name(metric_pb.name());
+    metric->set_description(metric_pb.description());
+    metric->set_unit(metric_pb.unit());
+
+    if (preagg.aggregation() == planpb::OTelMetric::PreAggregation::SUM) {
+      auto* sum = metric->mutable_sum();
+      sum->set_aggregation_temporality(
+          ::opentelemetry::proto::metrics::v1::AGGREGATION_TEMPORALITY_DELTA);
+      auto* data_point = sum->add_data_points();
+      *data_point->mutable_attributes() = std::move(state.attributes);
+      data_point->set_start_time_unix_nano(state.window_start_ns);
+      data_point->set_time_unix_nano(state.window_start_ns + preagg.window_ns());
+      data_point->set_as_double(state.sum);
+    } else {
+      auto* histogram = metric->mutable_histogram();
+      histogram->set_aggregation_temporality(
+          ::opentelemetry::proto::metrics::v1::AGGREGATION_TEMPORALITY_DELTA);
+      auto* data_point = histogram->add_data_points();
+      *data_point->mutable_attributes() = std::move(state.attributes);
+      data_point->set_start_time_unix_nano(state.window_start_ns);
+      data_point->set_time_unix_nano(state.window_start_ns + preagg.window_ns());
+      data_point->set_count(state.count);
+      data_point->set_sum(state.sum);
+      if (state.buckets.empty()) {
+        data_point->add_bucket_counts(state.zero_count);
+      } else {
+        const double base = metric_bucket_base_[metric_idx];
+        const int32_t min_bucket = state.buckets.begin()->first;
+        const int32_t max_bucket = state.buckets.rbegin()->first;
+        // Bucket i covers (base^(i-1), base^i]; the leading bucket holds values <= the
+        // first bound (including zero_count), the trailing one is the empty overflow
+        // OTLP requires.
+        data_point->add_bucket_counts(state.zero_count);
+        data_point->add_explicit_bounds(std::pow(base, min_bucket - 1));
+        for (int32_t i = min_bucket; i <= max_bucket; ++i) {
+          auto it = state.buckets.find(i);
+          data_point->add_bucket_counts(it == state.buckets.end() ? 0 : it->second);
+          data_point->add_explicit_bounds(std::pow(base, i));
+        }
+        data_point->add_bucket_counts(0);
+      }
+    }
+    states.erase(key);
   }
-  return Status::OK();
+}
+
+Status OTelExportSinkNode::SendMetricsRequest(
+    const opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest& request) {
+  grpc::Status status;
+  auto backoff = kOTelExportInitialBackoff;
+  for (int attempt = 0; attempt <= kOTelExportMaxRetries; ++attempt) {
+    if (attempt > 0) {
+      // Exponential backoff between attempts; shutdown interrupts the wait so a closing
+      // node doesn't hang on a down endpoint.
+      std::unique_lock<std::mutex> lock(export_mu_);
+      export_cv_.wait_for(lock, backoff, [this]() { return exporter_shutdown_; });
+      backoff *= 2;
+    }
+    grpc::ClientContext context;
+    for (const auto& header : plan_node_->endpoint_headers()) {
+      context.AddMetadata(header.first, header.second);
+    }
+    context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceResponse response;
+    status = metrics_service_stub_->Export(&context, request, &response);
+    if (status.ok()) {
+      return Status::OK();
+    }
+    if (!RetryableOTelStatus(status)) {
+      break;
+    }
+  }
+  return FormatOTelStatus(plan_node_->id(), status);
 }
 
 std::string ParseID(const RowBatch& rb, int64_t column_idx, int64_t row_idx) {
@@ -314,15 +577,25 @@ std::string GenerateID(uint64_t num_bytes) {
 
 using ::opentelemetry::proto::trace::v1::ResourceSpans;
 Status OTelExportSinkNode::ConsumeSpans(const RowBatch& rb) {
-  grpc::ClientContext context;
-  for (const auto& header : plan_node_->endpoint_headers()) {
-    context.AddMetadata(header.first, header.second);
-  }
-  context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
-
-  metrics_response_.Clear();
   opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest request;
+  BuildTraceRequest(rb, &request);
+  if (!FLAGS_enable_async_otel_export) {
+    return SendTraceRequest(request);
+  }
+  std::lock_guard<std::mutex> lock(export_mu_);
+  if (pending_traces_.size() >= kMaxPendingExportRequests) {
+    pending_traces_.pop_front();
+    ++dropped_requests_;
+  }
+  pending_traces_.push_back(std::move(request));
+  export_cv_.notify_one();
+  return Status::OK();
+}
 
+void OTelExportSinkNode::BuildTraceRequest(
+    const RowBatch& rb,
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest* request_ptr) {
+  auto& request = *request_ptr;
   for (int64_t row_idx = 0; row_idx < rb.ColumnAt(0)->length(); ++row_idx) {
     // TODO(philkuz) aggregate spans by resource.
     ::opentelemetry::proto::trace::v1::ResourceSpans resource_spans;
@@ -400,12 +673,86 @@ Status OTelExportSinkNode::ConsumeSpans(const RowBatch& rb) {
         [&request](ResourceSpans span) { *request.add_resource_spans() = std::move(span); },
         std::move(resource_spans), rb, row_idx);
   }
+}
 
-  grpc::Status status = trace_service_stub_->Export(&context, request, &trace_response_);
-  if (!status.ok()) {
-    return FormatOTelStatus(plan_node_->id(), status);
+Status OTelExportSinkNode::SendTraceRequest(
+    const opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest& request) {
+  grpc::Status status;
+  auto backoff = kOTelExportInitialBackoff;
+  for (int attempt = 0; attempt <= kOTelExportMaxRetries; ++attempt) {
+    if (attempt > 0) {
+      std::unique_lock<std::mutex> lock(export_mu_);
+      export_cv_.wait_for(lock, backoff, [this]() { return exporter_shutdown_; });
+      backoff *= 2;
+    }
+    grpc::ClientContext context;
+    for (const auto& header : plan_node_->endpoint_headers()) {
+      context.AddMetadata(header.first, header.second);
+    }
+    context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceResponse response;
+    status = trace_service_stub_->Export(&context, request, &response);
+    if (status.ok()) {
+      return Status::OK();
+    }
+    if (!RetryableOTelStatus(status)) {
+      break;
+    }
+  }
+  return FormatOTelStatus(plan_node_->id(), status);
+}
+
+void OTelExportSinkNode::ExporterThread() {
+  while (true) {
+    std::deque<opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest> metrics;
+    std::deque<opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest> traces;
+    {
+      std::unique_lock<std::mutex> lock(export_mu_);
+      export_cv_.wait(lock, [this]() {
+        return exporter_shutdown_ || !pending_metrics_.empty() || !pending_traces_.empty();
+      });
+      if (exporter_shutdown_ && pending_metrics_.empty() && pending_traces_.empty()) {
+        return;
+      }
+      metrics.swap(pending_metrics_);
+      traces.swap(pending_traces_);
+    }
+
+    // Coalesce everything drained in this round into a single RPC per service: the queued
+    // ResourceMetrics/ResourceSpans are appended to the front request.
+    if (!metrics.empty()) {
+      auto& merged = metrics.front();
+      for (size_t i = 1; i < metrics.size(); ++i) {
+        for (auto& rm : *metrics[i].mutable_resource_metrics()) {
+          *merged.add_resource_metrics() = std::move(rm);
+        }
+      }
+      auto s = SendMetricsRequest(merged);
+      if (!s.ok()) {
+        LOG(WARNING) << "OTel metrics export failed: " << s.msg();
+        std::lock_guard<std::mutex> lock(export_mu_);
+        if (export_status_.ok()) {
+          export_status_ = s;
+        }
+      }
+    }
+    if (!traces.empty()) {
+      auto& merged = traces.front();
+      for (size_t i = 1; i < traces.size(); ++i) {
+        for (auto& rs : *traces[i].mutable_resource_spans()) {
+          *merged.add_resource_spans() = std::move(rs);
+        }
+      }
+      auto s = SendTraceRequest(merged);
+      if (!s.ok()) {
+        LOG(WARNING) << "OTel trace export failed: " << s.msg();
+        std::lock_guard<std::mutex> lock(export_mu_);
+        if (export_status_.ok()) {
+          export_status_ = s;
+        }
+      }
+    }
   }
-  return Status::OK();
 }
 
 Status OTelExportSinkNode::ConsumeNextImpl(ExecState*, const RowBatch& rb, size_t) {
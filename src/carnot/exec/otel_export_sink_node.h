@@ -18,8 +18,17 @@
 #pragma once
 
 #include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <absl/base/thread_annotations.h>
+#include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
 
 #include "opentelemetry/proto/collector/metrics/v1/metrics_service.grpc.pb.h"
 #include "opentelemetry/proto/collector/metrics/v1/metrics_service.pb.h"
@@ -29,6 +38,8 @@
 #include "src/common/base/base.h"
 #include "src/shared/types/types.h"
 
+DECLARE_bool(enable_async_otel_export);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -51,18 +62,84 @@ class OTelExportSinkNode : public SinkNode {
                          size_t parent_index) override;
 
  private:
+  // Running aggregate for one (resource attributes, data point attributes, window) of a
+  // pre-aggregated metric (see planpb::OTelMetric::PreAggregation).
+  struct MetricAggState {
+    google::protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue>
+        resource_attributes;
+    google::protobuf::RepeatedPtrField<::opentelemetry::proto::common::v1::KeyValue> attributes;
+    int64_t window_start_ns = 0;
+    uint64_t count = 0;
+    double sum = 0;
+    // Log-scale bucket counts (HISTOGRAM only); bucket i covers (base^(i-1), base^i].
+    // Values <= 0 land in zero_count.
+    absl::btree_map<int32_t, uint64_t> buckets;
+    uint64_t zero_count = 0;
+  };
+
   Status ConsumeMetrics(const table_store::schema::RowBatch& rb);
   Status ConsumeSpans(const table_store::schema::RowBatch& rb);
 
+  // Folds one row into the pre-aggregation state of the given metric, flushing any windows
+  // the row's timestamp closes into `request`.
+  void AccumulateMetricRow(
+      int64_t metric_idx, const planpb::OTelMetric& metric_pb,
+      const table_store::schema::RowBatch& rb, int64_t row_idx,
+      opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest* request);
+  // Emits and erases all aggregates of the metric with window_start < up_to_window_start.
+  void FlushMetricAggregates(
+      int64_t metric_idx, const planpb::OTelMetric& metric_pb, int64_t up_to_window_start,
+      opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest* request);
+
+  void BuildMetricsRequest(
+      const table_store::schema::RowBatch& rb,
+      opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest* request);
+  void BuildTraceRequest(
+      const table_store::schema::RowBatch& rb,
+      opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest* request);
+
+  // Sends a request to the OTLP endpoint, retrying retryable gRPC errors with exponential
+  // backoff. The backoff sleep is interruptible by exporter shutdown.
+  Status SendMetricsRequest(
+      const opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest& request);
+  Status SendTraceRequest(
+      const opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest& request);
+
+  // Background sender: drains the pending queues, coalesces the drained requests into one
+  // RPC per signal and sends them, so slow endpoints never stall ConsumeNext.
+  void ExporterThread();
+
   std::unique_ptr<table_store::schema::RowDescriptor> input_descriptor_;
-  opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceResponse metrics_response_;
   opentelemetry::proto::collector::metrics::v1::MetricsService::StubInterface*
       metrics_service_stub_;
-  opentelemetry::proto::collector::trace::v1::ExportTraceServiceResponse trace_response_;
   opentelemetry::proto::collector::trace::v1::TraceService::StubInterface* trace_service_stub_;
   std::unique_ptr<plan::OTelExportSinkOperator> plan_node_;
 
   std::unique_ptr<SpanConfig> span_config_;
+
+  // Pre-aggregation state, indexed by metric spec position. Aggregates are keyed by a
+  // fingerprint of (window start, resource attributes, data point attributes).
+  std::vector<absl::flat_hash_map<std::string, MetricAggState>> metric_agg_states_;
+  // Latest window start seen per metric; rows that advance it flush the older windows.
+  std::vector<int64_t> metric_latest_window_;
+  // Histogram bucket base per metric, derived from the spec's scale.
+  std::vector<double> metric_bucket_base_;
+  bool has_pre_aggregated_metrics_ = false;
+  bool has_row_level_metrics_ = false;
+
+  // State for the async export pipeline. The queues are bounded: when an endpoint can't keep
+  // up, the oldest pending request is dropped rather than backpressuring the exec graph.
+  std::thread exporter_thread_;
+  std::mutex export_mu_;
+  std::condition_variable export_cv_;
+  std::deque<opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest>
+      pending_metrics_ GUARDED_BY(export_mu_);
+  std::deque<opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest>
+      pending_traces_ GUARDED_BY(export_mu_);
+  bool exporter_shutdown_ GUARDED_BY(export_mu_) = false;
+  int64_t dropped_requests_ GUARDED_BY(export_mu_) = 0;
+  // First error seen by the exporter thread; surfaced when the node closes.
+  Status export_status_ GUARDED_BY(export_mu_);
 };
 
 }  // namespace exec
@@ -18,6 +18,7 @@
 
 #include "src/carnot/exec/otel_export_sink_node.h"
 
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -936,6 +937,131 @@ resource_metrics {
                          [](const ::testing::TestParamInfo<TestCase>& info) {
                            return info.param.name;
                          });
+
+INSTANTIATE_TEST_SUITE_P(OTelMetricsPreAggregation, OTelMetricsTest,
+                         ::testing::ValuesIn(std::vector<TestCase>{
+                             {"pre_aggregated_sum",
+                              R"pb(
+metrics {
+  name: "http.resp.count"
+  attributes {
+    name: "http.method"
+    column {
+      column_type: STRING
+      column_index: 1
+    }
+  }
+  time_column_index: 0
+  gauge { float_column_index: 2 }
+  pre_aggregation {
+    window_ns: 10
+    aggregation: SUM
+  }
+}
+)pb",
+                              {R"pb(
+cols { time64ns_data { data: 1 data: 5 data: 12 } }
+cols { string_data { data: "GET" data: "GET" data: "GET" } }
+cols { float64_data { data: 1.5 data: 2.0 data: 4.5 } }
+num_rows: 3
+eow: true
+eos: true)pb"},
+                              {R"pb(
+resource_metrics {
+  resource {}
+  instrumentation_library_metrics {
+    metrics {
+      name: "http.resp.count"
+      sum {
+        aggregation_temporality: AGGREGATION_TEMPORALITY_DELTA
+        data_points {
+          attributes {
+            key: "http.method"
+            value {
+              string_value: "GET"
+            }
+          }
+          start_time_unix_nano: 0
+          time_unix_nano: 10
+          as_double: 3.5
+        }
+      }
+    }
+  }
+}
+resource_metrics {
+  resource {}
+  instrumentation_library_metrics {
+    metrics {
+      name: "http.resp.count"
+      sum {
+        aggregation_temporality: AGGREGATION_TEMPORALITY_DELTA
+        data_points {
+          attributes {
+            key: "http.method"
+            value {
+              string_value: "GET"
+            }
+          }
+          start_time_unix_nano: 10
+          time_unix_nano: 20
+          as_double: 4.5
+        }
+      }
+    }
+  }
+})pb"}},
+                             {"pre_aggregated_histogram",
+                              R"pb(
+metrics {
+  name: "http.resp.latency"
+  time_column_index: 0
+  gauge { float_column_index: 1 }
+  pre_aggregation {
+    window_ns: 100
+    aggregation: HISTOGRAM
+    scale: 0
+  }
+}
+)pb",
+                              {R"pb(
+cols { time64ns_data { data: 1 data: 2 data: 3 } }
+cols { float64_data { data: 3.0 data: 10.0 data: 0.0 } }
+num_rows: 3
+eow: true
+eos: true)pb"},
+                              {R"pb(
+resource_metrics {
+  resource {}
+  instrumentation_library_metrics {
+    metrics {
+      name: "http.resp.latency"
+      histogram {
+        aggregation_temporality: AGGREGATION_TEMPORALITY_DELTA
+        data_points {
+          start_time_unix_nano: 0
+          time_unix_nano: 100
+          count: 3
+          sum: 13
+          bucket_counts: 1
+          bucket_counts: 1
+          bucket_counts: 0
+          bucket_counts: 1
+          bucket_counts: 0
+          explicit_bounds: 2
+          explicit_bounds: 4
+          explicit_bounds: 8
+          explicit_bounds: 16
+        }
+      }
+    }
+  }
+})pb"}},
+                         }),
+                         [](const ::testing::TestParamInfo<TestCase>& info) {
+                           return info.param.name;
+                         });
+
 class OTelSpanTest : public OTelExportSinkNodeTest,
                      public ::testing::WithParamInterface<TestCase> {};
 
@@ -1668,6 +1794,117 @@ eos: true)pb";
   EXPECT_THAT(retval.ToString(), ::testing::MatchesRegex(".*INTERNAL.*"));
 }
 
+TEST_F(OTelExportSinkNodeTest, metrics_stub_errors_retry_retryable_codes) {
+  // UNAVAILABLE is retryable: two failures followed by a success should surface as OK.
+  int calls = 0;
+  EXPECT_CALL(*metrics_mock_, Export(_, _, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([&calls](const auto&, const auto&, const auto&) {
+        ++calls;
+        if (calls < 3) {
+          return grpc::Status(grpc::UNAVAILABLE, "");
+        }
+        return grpc::Status::OK;
+      }));
+
+  planpb::OTelExportSinkOperator otel_sink_op;
+
+  std::string operator_proto = R"pb(
+metrics {
+  name: "http.resp.latency"
+  time_column_index: 0
+  gauge { int_column_index: 1 }
+})pb";
+  EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(operator_proto, &otel_sink_op));
+  auto plan_node = std::make_unique<plan::OTelExportSinkOperator>(1);
+  auto s = plan_node->Init(otel_sink_op);
+  std::string row_batch = R"pb(
+cols { time64ns_data { data: 10 data: 11 } }
+cols { int64_data { data: 15 data: 150 } }
+num_rows: 2
+eow: true
+eos: true)pb";
+
+  table_store::schemapb::RowBatchData row_batch_proto;
+  EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(row_batch, &row_batch_proto));
+  RowDescriptor input_rd = RowBatch::FromProto(row_batch_proto).ConsumeValueOrDie()->desc();
+  RowDescriptor output_rd({});
+
+  auto tester = exec::ExecNodeTester<OTelExportSinkNode, plan::OTelExportSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  auto rb = RowBatch::FromProto(row_batch_proto).ConsumeValueOrDie();
+  EXPECT_OK(tester.node()->ConsumeNext(exec_state_.get(), *rb.get(), 1));
+}
+
+TEST_F(OTelExportSinkNodeTest, async_export) {
+  FLAGS_enable_async_otel_export = true;
+
+  // Exports happen on the background thread, so the requests may arrive coalesced into
+  // fewer RPCs; collect them all and check the total exported data after Close joins the
+  // exporter.
+  std::mutex mu;
+  std::vector<otelmetricscollector::ExportMetricsServiceRequest> requests;
+  EXPECT_CALL(*metrics_mock_, Export(_, _, _))
+      .WillRepeatedly(Invoke([&](const auto&, const auto& request, const auto&) {
+        std::lock_guard<std::mutex> lock(mu);
+        requests.push_back(request);
+        return grpc::Status::OK;
+      }));
+
+  planpb::OTelExportSinkOperator otel_sink_op;
+
+  std::string operator_proto = R"pb(
+metrics {
+  name: "http.resp.latency"
+  time_column_index: 0
+  gauge { int_column_index: 1 }
+})pb";
+  EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(operator_proto, &otel_sink_op));
+  auto plan_node = std::make_unique<plan::OTelExportSinkOperator>(1);
+  auto s = plan_node->Init(otel_sink_op);
+  std::string row_batch1 = R"pb(
+cols { time64ns_data { data: 10 data: 11 } }
+cols { int64_data { data: 15 data: 150 } }
+num_rows: 2
+eow: false
+eos: false)pb";
+  std::string row_batch2 = R"pb(
+cols { time64ns_data { data: 12 data: 13 } }
+cols { int64_data { data: 16 data: 160 } }
+num_rows: 2
+eow: true
+eos: true)pb";
+
+  table_store::schemapb::RowBatchData row_batch_proto;
+  EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(row_batch1, &row_batch_proto));
+  RowDescriptor input_rd = RowBatch::FromProto(row_batch_proto).ConsumeValueOrDie()->desc();
+  RowDescriptor output_rd({});
+
+  {
+    auto tester = exec::ExecNodeTester<OTelExportSinkNode, plan::OTelExportSinkOperator>(
+        *plan_node, output_rd, {input_rd}, exec_state_.get());
+    for (const auto& rb_pb_txt : {row_batch1, row_batch2}) {
+      table_store::schemapb::RowBatchData rb_proto;
+      EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(rb_pb_txt, &rb_proto));
+      auto rb = RowBatch::FromProto(rb_proto).ConsumeValueOrDie();
+      tester.ConsumeNext(*rb.get(), 1, 0);
+    }
+    tester.Close();
+  }
+
+  int64_t total_resource_metrics = 0;
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    for (const auto& request : requests) {
+      total_resource_metrics += request.resource_metrics_size();
+    }
+  }
+  // 2 batches x 2 rows, one ResourceMetrics per row.
+  EXPECT_EQ(4, total_resource_metrics);
+
+  FLAGS_enable_async_otel_export = false;
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
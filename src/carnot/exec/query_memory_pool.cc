@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+
+#include <prometheus/counter.h>
+#include <prometheus/histogram.h>
+
+#include "src/carnot/exec/query_memory_pool.h"
+#include "src/common/metrics/metrics.h"
+
+DEFINE_int64(query_memory_limit_bytes,
+             gflags::Int64FromEnv("PL_QUERY_MEMORY_LIMIT_BYTES", 2LL * 1024 * 1024 * 1024),
+             "Maximum bytes of exec memory a single query may allocate. Allocations past the "
+             "limit fail and abort the query. Set to 0 or a negative value to disable "
+             "enforcement (allocations are still tracked).");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+namespace {
+
+prometheus::Counter& QueriesAbortedCounter() {
+  static prometheus::Counter& counter =
+      BuildCounter("carnot_query_memory_limit_exceeded",
+                   "Number of queries aborted for exceeding the query memory budget.");
+  return counter;
+}
+
+prometheus::Histogram& PeakBytesHistogram() {
+  static prometheus::Histogram& histogram =
+      prometheus::BuildHistogram()
+          .Name("carnot_query_peak_memory_bytes")
+          .Help("Peak exec memory tracked per query, recorded when the query finishes.")
+          .Register(GetMetricsRegistry())
+          .Add({}, prometheus::Histogram::BucketBoundaries{
+                       1 << 20, 4 << 20, 16 << 20, 64 << 20, 256 << 20, 1ll << 30, 4ll << 30});
+  return histogram;
+}
+
+}  // namespace
+
+QueryMemoryPool::QueryMemoryPool(arrow::MemoryPool* delegate, int64_t limit_bytes)
+    : delegate_(delegate), limit_bytes_(limit_bytes) {}
+
+QueryMemoryPool::~QueryMemoryPool() {
+  PeakBytesHistogram().Observe(static_cast<double>(peak_bytes_.load()));
+}
+
+arrow::Status QueryMemoryPool::CheckBudget(int64_t additional_bytes) {
+  if (limit_bytes_ <= 0) {
+    return arrow::Status::OK();
+  }
+  if (bytes_allocated_.load(std::memory_order_relaxed) + additional_bytes <= limit_bytes_) {
+    return arrow::Status::OK();
+  }
+  if (!limit_exceeded_.exchange(true)) {
+    QueriesAbortedCounter().Increment();
+  }
+  return arrow::Status::OutOfMemory(absl::Substitute(
+      "Query exceeded its memory budget of $0 bytes (requested $1 additional bytes). Try "
+      "reducing the time window or number of columns, or raise --query_memory_limit_bytes.",
+      limit_bytes_, additional_bytes));
+}
+
+void QueryMemoryPool::Track(int64_t delta_bytes) {
+  int64_t current = bytes_allocated_.fetch_add(delta_bytes) + delta_bytes;
+  int64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+  while (current > peak && !peak_bytes_.compare_exchange_weak(peak, current)) {
+  }
+}
+
+arrow::Status QueryMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  ARROW_RETURN_NOT_OK(CheckBudget(size));
+  ARROW_RETURN_NOT_OK(delegate_->Allocate(size, out));
+  Track(size);
+  return arrow::Status::OK();
+}
+
+arrow::Status QueryMemoryPool::Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  ARROW_RETURN_NOT_OK(CheckBudget(new_size - old_size));
+  ARROW_RETURN_NOT_OK(delegate_->Reallocate(old_size, new_size, ptr));
+  Track(new_size - old_size);
+  return arrow::Status::OK();
+}
+
+void QueryMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  delegate_->Free(buffer, size);
+  bytes_allocated_.fetch_sub(size);
+}
+
+int64_t QueryMemoryPool::bytes_allocated() const { return bytes_allocated_.load(); }
+
+int64_t QueryMemoryPool::max_memory() const { return peak_bytes_.load(); }
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
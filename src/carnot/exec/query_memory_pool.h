@@ -0,0 +1,72 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/memory_pool.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "src/common/base/base.h"
+
+DECLARE_int64(query_memory_limit_bytes);
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * QueryMemoryPool tracks the arrow allocations made on behalf of a single query and enforces a
+ * per-query memory budget. One QueryMemoryPool is owned by each ExecState, so its lifetime matches
+ * the query's. Allocations are forwarded to the wrapped pool; an allocation that would push the
+ * query past its budget fails with an OutOfMemory status, which propagates out of the exec node as
+ * a regular Status and aborts the query, instead of letting one query OOM a Carnot instance shared
+ * by many queries.
+ *
+ * A budget of 0 or less disables enforcement; allocations are still tracked.
+ */
+class QueryMemoryPool : public arrow::MemoryPool {
+ public:
+  QueryMemoryPool(arrow::MemoryPool* delegate, int64_t limit_bytes);
+  ~QueryMemoryPool() override;
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+
+  int64_t limit_bytes() const { return limit_bytes_; }
+  bool limit_exceeded() const { return limit_exceeded_.load(std::memory_order_relaxed); }
+
+ private:
+  arrow::Status CheckBudget(int64_t additional_bytes);
+  void Track(int64_t delta_bytes);
+
+  arrow::MemoryPool* delegate_;
+  const int64_t limit_bytes_;
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> peak_bytes_{0};
+  std::atomic<bool> limit_exceeded_{false};
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
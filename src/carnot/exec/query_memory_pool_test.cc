@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/builder.h>
+
+#include "src/carnot/exec/query_memory_pool.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+TEST(QueryMemoryPoolTest, TracksAllocations) {
+  QueryMemoryPool pool(arrow::default_memory_pool(), /*limit_bytes*/ 0);
+
+  uint8_t* buf = nullptr;
+  ASSERT_OK(pool.Allocate(1024, &buf));
+  EXPECT_EQ(1024, pool.bytes_allocated());
+
+  ASSERT_OK(pool.Reallocate(1024, 4096, &buf));
+  EXPECT_EQ(4096, pool.bytes_allocated());
+  EXPECT_EQ(4096, pool.max_memory());
+
+  pool.Free(buf, 4096);
+  EXPECT_EQ(0, pool.bytes_allocated());
+  // Peak is retained after the memory is freed.
+  EXPECT_EQ(4096, pool.max_memory());
+  EXPECT_FALSE(pool.limit_exceeded());
+}
+
+TEST(QueryMemoryPoolTest, EnforcesBudget) {
+  QueryMemoryPool pool(arrow::default_memory_pool(), /*limit_bytes*/ 1024);
+
+  uint8_t* buf = nullptr;
+  ASSERT_OK(pool.Allocate(512, &buf));
+
+  uint8_t* over_buf = nullptr;
+  auto status = StatusAdapter(pool.Allocate(1024, &over_buf));
+  ASSERT_NOT_OK(status);
+  EXPECT_THAT(status.msg(), ::testing::HasSubstr("memory budget"));
+  EXPECT_TRUE(pool.limit_exceeded());
+  // The failed allocation is not counted.
+  EXPECT_EQ(512, pool.bytes_allocated());
+
+  // Growing the existing allocation past the budget also fails.
+  EXPECT_NOT_OK(pool.Reallocate(512, 2048, &buf));
+
+  pool.Free(buf, 512);
+}
+
+TEST(QueryMemoryPoolTest, ZeroLimitDisablesEnforcement) {
+  QueryMemoryPool pool(arrow::default_memory_pool(), /*limit_bytes*/ 0);
+
+  uint8_t* buf = nullptr;
+  ASSERT_OK(pool.Allocate(1 << 20, &buf));
+  EXPECT_FALSE(pool.limit_exceeded());
+  pool.Free(buf, 1 << 20);
+}
+
+TEST(QueryMemoryPoolTest, ArrowBuildersRespectBudget) {
+  QueryMemoryPool pool(arrow::default_memory_pool(), /*limit_bytes*/ 1024);
+
+  arrow::Int64Builder builder(&pool);
+  EXPECT_NOT_OK(builder.Reserve(1024 * 1024));
+  EXPECT_TRUE(pool.limit_exceeded());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
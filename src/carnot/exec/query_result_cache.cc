@@ -0,0 +1,124 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/query_result_cache.h"
+
+#include <farmhash.h>
+
+#include <string>
+#include <utility>
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+namespace {
+
+int64_t EntryBytes(const QueryResultCache::Entry& entry) {
+  int64_t bytes = 0;
+  for (const auto& batch : entry.batches) {
+    bytes += batch->NumBytes();
+  }
+  return bytes;
+}
+
+}  // namespace
+
+uint64_t QueryResultCache::PlanFingerprint(const planpb::Plan& plan) {
+  std::string serialized = plan.SerializeAsString();
+  return ::util::Fingerprint64(serialized.data(), serialized.size());
+}
+
+QueryResultCache::Key QueryResultCache::MakeKey(uint64_t plan_fingerprint, int64_t start_time_ns,
+                                                int64_t end_time_ns, int64_t quantum_ns) {
+  DCHECK_GT(quantum_ns, 0);
+  return Key{plan_fingerprint, start_time_ns - (start_time_ns % quantum_ns),
+             end_time_ns - (end_time_ns % quantum_ns)};
+}
+
+void QueryResultCache::Put(const Key& key, Entry entry, int64_t now_ns) {
+  std::lock_guard<std::mutex> lock(mu_);
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    EvictLockHeld(it->second);
+  }
+
+  int64_t bytes = EntryBytes(entry);
+  lru_.push_front(CacheNode{key, std::move(entry), now_ns, bytes});
+  entries_[key] = lru_.begin();
+  total_bytes_ += bytes;
+
+  EvictExpiredAndOverBudgetLockHeld(now_ns);
+}
+
+std::optional<QueryResultCache::Entry> QueryResultCache::Get(const Key& key, int64_t now_ns) {
+  std::lock_guard<std::mutex> lock(mu_);
+
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  if (Expired(*it->second, now_ns)) {
+    EvictLockHeld(it->second);
+    return std::nullopt;
+  }
+  // Refresh the LRU position.
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->entry;
+}
+
+std::optional<QueryResultCache::Entry> QueryResultCache::GetLatestForPlan(
+    uint64_t plan_fingerprint, int64_t now_ns) {
+  std::lock_guard<std::mutex> lock(mu_);
+
+  // The cache is size-bounded, so a linear scan is acceptable here; this path runs once per
+  // query execution, not per batch.
+  NodeList::iterator best = lru_.end();
+  for (auto it = lru_.begin(); it != lru_.end(); ++it) {
+    if (it->key.plan_fingerprint != plan_fingerprint || Expired(*it, now_ns)) {
+      continue;
+    }
+    if (best == lru_.end() || it->entry.end_time_ns > best->entry.end_time_ns) {
+      best = it;
+    }
+  }
+  if (best == lru_.end()) {
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, best);
+  return best->entry;
+}
+
+void QueryResultCache::EvictLockHeld(NodeList::iterator it) {
+  total_bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void QueryResultCache::EvictExpiredAndOverBudgetLockHeld(int64_t now_ns) {
+  // Evict from the least-recently-used end, removing expired entries and then whatever else is
+  // needed to get back under the byte budget.
+  while (!lru_.empty() && (total_bytes_ > max_bytes_ || Expired(lru_.back(), now_ns))) {
+    EvictLockHeld(std::prev(lru_.end()));
+  }
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/common/base/base.h"
+#include "src/table_store/schema/row_batch.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * QueryResultCache caches the output row batches of repeated script executions.
+ *
+ * Dashboards re-run the same script with a sliding time window every few seconds, so most of a
+ * window's results were already computed by the previous run. Entries are keyed by a fingerprint
+ * of the logical plan plus the query's time range quantized to a fixed quantum, so back-to-back
+ * runs whose windows round to the same boundaries hit the same entry. On a hit, the caller can
+ * serve the cached batches and recompute only the tail window starting at the entry's
+ * end_time_ns. Entries expire after a TTL, and least-recently-used entries are evicted once the
+ * byte budget is exceeded.
+ *
+ * All times are passed in by the caller (matching Carnot::ExecuteQuery's time_now), which keeps
+ * the cache deterministic in tests.
+ */
+class QueryResultCache : public NotCopyable {
+ public:
+  // Runs whose window boundaries fall within the same quantum share a cache entry. 10s covers
+  // the refresh intervals of our dashboards while keeping windows reasonably tight.
+  static constexpr int64_t kDefaultTimeQuantumNs = 10ULL * 1000 * 1000 * 1000;
+
+  struct Key {
+    uint64_t plan_fingerprint;
+    int64_t start_time_ns;
+    int64_t end_time_ns;
+
+    bool operator==(const Key& other) const {
+      return plan_fingerprint == other.plan_fingerprint &&
+             start_time_ns == other.start_time_ns && end_time_ns == other.end_time_ns;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.plan_fingerprint, key.start_time_ns, key.end_time_ns);
+    }
+  };
+
+  struct Entry {
+    std::vector<std::shared_ptr<const table_store::schema::RowBatch>> batches;
+    // The un-quantized end of the cached computation; an incremental tail recompute covers
+    // [end_time_ns, now).
+    int64_t end_time_ns = 0;
+  };
+
+  QueryResultCache(int64_t ttl_ns, int64_t max_bytes) : ttl_ns_(ttl_ns), max_bytes_(max_bytes) {}
+
+  /**
+   * Fingerprints a logical plan by its serialized form. Stable across processes, so agents
+   * behind the same query broker agree on the key.
+   */
+  static uint64_t PlanFingerprint(const planpb::Plan& plan);
+
+  /**
+   * Builds a key with the time range quantized down to quantum_ns boundaries.
+   */
+  static Key MakeKey(uint64_t plan_fingerprint, int64_t start_time_ns, int64_t end_time_ns,
+                     int64_t quantum_ns = kDefaultTimeQuantumNs);
+
+  /**
+   * Inserts (or replaces) an entry, then evicts expired and least-recently-used entries until
+   * the byte budget is met.
+   */
+  void Put(const Key& key, Entry entry, int64_t now_ns);
+
+  /**
+   * Returns the entry for the key if present and not expired, refreshing its LRU position.
+   */
+  std::optional<Entry> Get(const Key& key, int64_t now_ns);
+
+  /**
+   * Returns the unexpired entry with the latest end_time_ns for the plan, regardless of the
+   * window boundaries. Used to find the base for an incremental tail recompute when the exact
+   * quantized window misses.
+   */
+  std::optional<Entry> GetLatestForPlan(uint64_t plan_fingerprint, int64_t now_ns);
+
+  int64_t total_bytes() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return total_bytes_;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return entries_.size();
+  }
+
+ private:
+  struct CacheNode {
+    Key key;
+    Entry entry;
+    int64_t inserted_ns;
+    int64_t bytes;
+  };
+  using NodeList = std::list<CacheNode>;
+
+  bool Expired(const CacheNode& node, int64_t now_ns) const {
+    return now_ns - node.inserted_ns > ttl_ns_;
+  }
+
+  // The following require mu_ to be held.
+  void EvictLockHeld(NodeList::iterator it);
+  void EvictExpiredAndOverBudgetLockHeld(int64_t now_ns);
+
+  const int64_t ttl_ns_;
+  const int64_t max_bytes_;
+
+  mutable std::mutex mu_;
+  // Most-recently-used entries at the front.
+  NodeList lru_;
+  absl::flat_hash_map<Key, NodeList::iterator> entries_;
+  int64_t total_bytes_ = 0;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
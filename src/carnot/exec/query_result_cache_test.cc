@@ -0,0 +1,145 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/query_result_cache.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+class QueryResultCacheTest : public ::testing::Test {
+ protected:
+  static constexpr int64_t kTTLNs = 30ULL * 1000 * 1000 * 1000;
+  static constexpr int64_t kQuantumNs = QueryResultCache::kDefaultTimeQuantumNs;
+
+  std::shared_ptr<const RowBatch> MakeBatch(const std::vector<types::Int64Value>& vals) {
+    RowDescriptor rd({types::DataType::INT64});
+    RowBatchBuilder builder(rd, vals.size(), /* eow_set */ true, /* eos_set */ true);
+    builder.AddColumn<types::Int64Value>(vals);
+    return std::make_shared<const RowBatch>(builder.get());
+  }
+
+  QueryResultCache::Entry MakeEntry(const std::vector<types::Int64Value>& vals,
+                                    int64_t end_time_ns) {
+    QueryResultCache::Entry entry;
+    entry.batches.push_back(MakeBatch(vals));
+    entry.end_time_ns = end_time_ns;
+    return entry;
+  }
+};
+
+TEST_F(QueryResultCacheTest, plan_fingerprint) {
+  planpb::Plan plan_a;
+  plan_a.mutable_dag()->add_nodes()->set_id(1);
+
+  planpb::Plan plan_b;
+  plan_b.mutable_dag()->add_nodes()->set_id(2);
+
+  EXPECT_EQ(QueryResultCache::PlanFingerprint(plan_a), QueryResultCache::PlanFingerprint(plan_a));
+  EXPECT_NE(QueryResultCache::PlanFingerprint(plan_a), QueryResultCache::PlanFingerprint(plan_b));
+}
+
+TEST_F(QueryResultCacheTest, key_quantization) {
+  // Two runs a few seconds apart, within the same quantum, share a key.
+  auto key1 = QueryResultCache::MakeKey(1, kQuantumNs + 1, 10 * kQuantumNs + 1);
+  auto key2 = QueryResultCache::MakeKey(1, kQuantumNs + 2, 10 * kQuantumNs + kQuantumNs - 1);
+  EXPECT_EQ(key1, key2);
+
+  // A run whose window crosses into the next quantum gets a new key.
+  auto key3 = QueryResultCache::MakeKey(1, kQuantumNs + 1, 11 * kQuantumNs + 1);
+  EXPECT_FALSE(key1 == key3);
+}
+
+TEST_F(QueryResultCacheTest, put_get) {
+  QueryResultCache cache(kTTLNs, /* max_bytes */ 1024 * 1024);
+
+  auto key = QueryResultCache::MakeKey(1, 0, 10 * kQuantumNs);
+  cache.Put(key, MakeEntry({1, 2, 3}, 10 * kQuantumNs + 5), /* now_ns */ 0);
+
+  auto entry = cache.Get(key, /* now_ns */ 1);
+  ASSERT_TRUE(entry.has_value());
+  ASSERT_EQ(entry->batches.size(), 1U);
+  EXPECT_EQ(entry->batches[0]->num_rows(), 3);
+  EXPECT_EQ(entry->end_time_ns, 10 * kQuantumNs + 5);
+
+  // A different plan fingerprint misses.
+  auto other_key = QueryResultCache::MakeKey(2, 0, 10 * kQuantumNs);
+  EXPECT_FALSE(cache.Get(other_key, /* now_ns */ 1).has_value());
+}
+
+TEST_F(QueryResultCacheTest, ttl_expiry) {
+  QueryResultCache cache(kTTLNs, /* max_bytes */ 1024 * 1024);
+
+  auto key = QueryResultCache::MakeKey(1, 0, 10 * kQuantumNs);
+  cache.Put(key, MakeEntry({1, 2, 3}, 10 * kQuantumNs), /* now_ns */ 0);
+
+  EXPECT_TRUE(cache.Get(key, kTTLNs).has_value());
+  EXPECT_FALSE(cache.Get(key, kTTLNs + 1).has_value());
+  EXPECT_EQ(cache.size(), 0U);
+  EXPECT_EQ(cache.total_bytes(), 0);
+}
+
+TEST_F(QueryResultCacheTest, lru_eviction_on_byte_budget) {
+  // Budget fits one entry's worth of batches, but not two.
+  auto probe = MakeEntry({1, 2, 3}, 0);
+  int64_t one_entry_bytes = probe.batches[0]->NumBytes();
+
+  QueryResultCache cache(kTTLNs, /* max_bytes */ one_entry_bytes + one_entry_bytes / 2);
+
+  auto key1 = QueryResultCache::MakeKey(1, 0, 10 * kQuantumNs);
+  auto key2 = QueryResultCache::MakeKey(2, 0, 10 * kQuantumNs);
+  cache.Put(key1, MakeEntry({1, 2, 3}, 10 * kQuantumNs), /* now_ns */ 0);
+  cache.Put(key2, MakeEntry({4, 5, 6}, 10 * kQuantumNs), /* now_ns */ 1);
+
+  // The older entry was evicted to stay within budget.
+  EXPECT_EQ(cache.size(), 1U);
+  EXPECT_FALSE(cache.Get(key1, /* now_ns */ 2).has_value());
+  EXPECT_TRUE(cache.Get(key2, /* now_ns */ 2).has_value());
+}
+
+TEST_F(QueryResultCacheTest, get_latest_for_plan) {
+  QueryResultCache cache(kTTLNs, /* max_bytes */ 1024 * 1024);
+
+  auto key1 = QueryResultCache::MakeKey(1, 0, 10 * kQuantumNs);
+  auto key2 = QueryResultCache::MakeKey(1, 0, 11 * kQuantumNs);
+  cache.Put(key1, MakeEntry({1, 2, 3}, 10 * kQuantumNs), /* now_ns */ 0);
+  cache.Put(key2, MakeEntry({1, 2, 3, 4}, 11 * kQuantumNs), /* now_ns */ 1);
+
+  // The entry with the later end time is the base for an incremental tail recompute.
+  auto entry = cache.GetLatestForPlan(1, /* now_ns */ 2);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->end_time_ns, 11 * kQuantumNs);
+
+  EXPECT_FALSE(cache.GetLatestForPlan(99, /* now_ns */ 2).has_value());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/row_batch_spill.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "src/table_store/schemapb/schema.pb.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+StatusOr<std::unique_ptr<SpilledRowBatchFile>> SpilledRowBatchFile::Create() {
+  auto spill_file = std::unique_ptr<SpilledRowBatchFile>(new SpilledRowBatchFile());
+  spill_file->file_ = std::tmpfile();
+  if (spill_file->file_ == nullptr) {
+    return error::Internal("Failed to create spill file: $0", std::strerror(errno));
+  }
+  return spill_file;
+}
+
+SpilledRowBatchFile::~SpilledRowBatchFile() {
+  if (file_ != nullptr) {
+    fclose(file_);
+  }
+}
+
+Status SpilledRowBatchFile::Write(const RowBatch& rb) {
+  DCHECK(!reading_);
+  table_store::schemapb::RowBatchData pb;
+  PL_RETURN_IF_ERROR(rb.ToProto(&pb));
+  std::string serialized;
+  if (!pb.SerializeToString(&serialized)) {
+    return error::Internal("Failed to serialize RowBatch for spilling.");
+  }
+  uint64_t size = serialized.size();
+  if (fwrite(&size, sizeof(size), 1, file_) != 1 ||
+      fwrite(serialized.data(), 1, serialized.size(), file_) != serialized.size()) {
+    return error::Internal("Failed to write $0 bytes to spill file: $1", serialized.size(),
+                           std::strerror(errno));
+  }
+  ++num_batches_;
+  bytes_written_ += sizeof(size) + serialized.size();
+  return Status::OK();
+}
+
+Status SpilledRowBatchFile::StartRead() {
+  DCHECK(!reading_);
+  if (fflush(file_) != 0 || fseek(file_, 0, SEEK_SET) != 0) {
+    return error::Internal("Failed to rewind spill file: $0", std::strerror(errno));
+  }
+  reading_ = true;
+  num_batches_read_ = 0;
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> SpilledRowBatchFile::ReadNext() {
+  DCHECK(reading_);
+  if (!HasNext()) {
+    return error::Internal("Read past the end of the spill file.");
+  }
+  uint64_t size;
+  if (fread(&size, sizeof(size), 1, file_) != 1) {
+    return error::Internal("Failed to read batch size from spill file.");
+  }
+  std::string serialized(size, '\0');
+  if (fread(serialized.data(), 1, size, file_) != size) {
+    return error::Internal("Failed to read $0-byte batch from spill file.", size);
+  }
+  table_store::schemapb::RowBatchData pb;
+  if (!pb.ParseFromString(serialized)) {
+    return error::Internal("Failed to parse spilled RowBatch.");
+  }
+  ++num_batches_read_;
+  return RowBatch::FromProto(pb);
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <memory>
+
+#include "src/common/base/base.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+// Operators keep buffering in memory until their budget is exceeded; this is the default
+// budget applied to the buffered (not-yet-consumable) side of blocking operators.
+constexpr size_t kDefaultOperatorSpillThresholdBytes = 256ULL * 1024 * 1024;
+
+/**
+ * SpilledRowBatchFile buffers RowBatches on local disk so blocking operators can bound
+ * their memory footprint.
+ *
+ * Batches are appended as length-prefixed RowBatchData protos (the same wire format used
+ * for inter-node RowBatch streams) to an unlinked temp file, so the kernel reclaims the
+ * space when the file is closed even if the query dies. The file is written in one phase
+ * and then read back sequentially.
+ */
+class SpilledRowBatchFile : public NotCopyable {
+ public:
+  static StatusOr<std::unique_ptr<SpilledRowBatchFile>> Create();
+  ~SpilledRowBatchFile();
+
+  /**
+   * Appends a RowBatch to the spill file. Must not be called after StartRead().
+   */
+  Status Write(const table_store::schema::RowBatch& rb);
+
+  /**
+   * Finishes the write phase and rewinds to the first batch.
+   */
+  Status StartRead();
+
+  /**
+   * Returns true if there are unread batches. Only valid after StartRead().
+   */
+  bool HasNext() const { return num_batches_read_ < num_batches_; }
+
+  /**
+   * Reads the next RowBatch back. Only valid after StartRead() when HasNext().
+   */
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> ReadNext();
+
+  size_t num_batches() const { return num_batches_; }
+  size_t bytes_written() const { return bytes_written_; }
+
+ private:
+  SpilledRowBatchFile() = default;
+
+  std::FILE* file_ = nullptr;
+  bool reading_ = false;
+  size_t num_batches_ = 0;
+  size_t num_batches_read_ = 0;
+  size_t bytes_written_ = 0;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
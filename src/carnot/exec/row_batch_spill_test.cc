@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/row_batch_spill.h"
+
+#include <string>
+#include <vector>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+TEST(SpilledRowBatchFileTest, write_read_roundtrip) {
+  RowDescriptor rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto rb1 = RowBatchBuilder(rd, /*size*/ 3, /*eow_set*/ false, /*eos_set*/ false)
+                 .AddColumn<types::Int64Value>({1, 2, 3})
+                 .AddColumn<types::StringValue>({"a", "bb", "ccc"})
+                 .get();
+  auto rb2 = RowBatchBuilder(rd, /*size*/ 2, /*eow_set*/ true, /*eos_set*/ true)
+                 .AddColumn<types::Int64Value>({4, 5})
+                 .AddColumn<types::StringValue>({"dddd", ""})
+                 .get();
+
+  ASSERT_OK_AND_ASSIGN(auto spill_file, SpilledRowBatchFile::Create());
+  ASSERT_OK(spill_file->Write(rb1));
+  ASSERT_OK(spill_file->Write(rb2));
+  EXPECT_EQ(2U, spill_file->num_batches());
+  EXPECT_GT(spill_file->bytes_written(), 0U);
+
+  ASSERT_OK(spill_file->StartRead());
+  ASSERT_TRUE(spill_file->HasNext());
+  ASSERT_OK_AND_ASSIGN(auto read_rb1, spill_file->ReadNext());
+  ASSERT_EQ(rb1.num_columns(), read_rb1->num_columns());
+  for (int64_t i = 0; i < rb1.num_columns(); ++i) {
+    EXPECT_TRUE(rb1.ColumnAt(i)->Equals(read_rb1->ColumnAt(i)));
+  }
+  EXPECT_FALSE(read_rb1->eow());
+  EXPECT_FALSE(read_rb1->eos());
+
+  ASSERT_TRUE(spill_file->HasNext());
+  ASSERT_OK_AND_ASSIGN(auto read_rb2, spill_file->ReadNext());
+  ASSERT_EQ(rb2.num_columns(), read_rb2->num_columns());
+  for (int64_t i = 0; i < rb2.num_columns(); ++i) {
+    EXPECT_TRUE(rb2.ColumnAt(i)->Equals(read_rb2->ColumnAt(i)));
+  }
+  EXPECT_TRUE(read_rb2->eow());
+  EXPECT_TRUE(read_rb2->eos());
+
+  EXPECT_FALSE(spill_file->HasNext());
+}
+
+TEST(SpilledRowBatchFileTest, empty_file) {
+  ASSERT_OK_AND_ASSIGN(auto spill_file, SpilledRowBatchFile::Create());
+  EXPECT_EQ(0U, spill_file->num_batches());
+  ASSERT_OK(spill_file->StartRead());
+  EXPECT_FALSE(spill_file->HasNext());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -81,6 +81,18 @@ struct RowTuple : public NotCopyable {
   void Reset() {
     fixed_values.resize(types->size());
     variable_values.clear();
+    hash_valid_ = false;
+  }
+
+  /**
+   * Stores a precomputed hash for this tuple, e.g. from the batched column hash kernel
+   * (see HashColumnIntoBatch). Precomputed hashes come from a different hash family than the
+   * lazy Hash() path, so every tuple that meets in one hash container must either have its
+   * hash set this way or none of them may.
+   */
+  void set_hash(uint64_t hash) {
+    hash_ = hash;
+    hash_valid_ = true;
   }
 
   /**
@@ -138,6 +150,9 @@ struct RowTuple : public NotCopyable {
    * @return the hash results.
    */
   size_t Hash() const {
+    if (hash_valid_) {
+      return hash_;
+    }
     DCHECK(CheckSequentialWriteOrder()) << "Variable sized write ordering mismatch";
     // For fixed sized data we just hash the stored array.
     size_t hash = ::util::Hash64(reinterpret_cast<const char*>(fixed_values.data()),
@@ -149,6 +164,8 @@ struct RowTuple : public NotCopyable {
       hash = ::px::HashCombine(
           hash, types::utils::hash<types::StringValue>()(std::get<types::StringValue>(val)));
     }
+    hash_ = hash;
+    hash_valid_ = true;
     return hash;
   }
 
@@ -185,12 +202,18 @@ struct RowTuple : public NotCopyable {
   // This index is stored as a Int64Value.
   std::vector<types::FixedSizeValueUnion> fixed_values;
   std::vector<VariableSizeValueTypeVariant> variable_values;
+
+  // Cached hash of the tuple contents, invalidated on Reset/SetValue and recomputed (or supplied
+  // in batch via set_hash) on demand.
+  mutable uint64_t hash_ = 0;
+  mutable bool hash_valid_ = false;
 };
 
 namespace internal {
 template <typename T>
 inline void SetValueHelper(RowTuple* rt, size_t idx, const T& val) {
   static_assert(types::ValueTypeTraits<T>::is_fixed_size, "Only fixed size values allowed");
+  rt->hash_valid_ = false;
   types::SetValue<T>(&rt->fixed_values[idx], val);
 }
 
@@ -251,6 +274,35 @@ void ExtractIntoRowTuple(RowTuple* rt, arrow::Array* col, int rt_col_idx, int rt
                              types::GetValue(static_cast<ArrowArrayType*>(col), rt_row_idx));
 }
 
+/**
+ * Hashes an entire key column into a per-row hash vector in one pass.
+ * The first key column overwrites hashes, subsequent columns combine into them. The resulting
+ * hashes are meant to be installed into the corresponding RowTuples via set_hash(); see the
+ * consistency requirements documented there.
+ */
+template <types::DataType DT>
+void HashColumnIntoBatch(arrow::Array* col, bool first_col, std::vector<uint64_t>* hashes) {
+  using ArrowArrayType = typename types::DataTypeTraits<DT>::arrow_array_type;
+  auto* typed_col = static_cast<ArrowArrayType*>(col);
+  size_t num_rows = hashes->size();
+  if constexpr (DT == types::DataType::STRING) {
+    for (size_t i = 0; i < num_rows; ++i) {
+      auto view = types::GetStringViewFromArrowArray(col, i);
+      uint64_t h = types::utils::HashBytes(view.data(), view.size());
+      (*hashes)[i] = first_col ? h : ::px::HashCombine((*hashes)[i], h);
+    }
+  } else if constexpr (DT == types::DataType::BOOLEAN || DT == types::DataType::UINT128) {
+    // These arrays don't expose raw_values(), so hash the materialized value per row.
+    for (size_t i = 0; i < num_rows; ++i) {
+      auto val = typed_col->Value(i);
+      uint64_t h = types::utils::HashBytes(&val, sizeof(val));
+      (*hashes)[i] = first_col ? h : ::px::HashCombine((*hashes)[i], h);
+    }
+  } else {
+    types::utils::HashFixedBatch(typed_col->raw_values(), num_rows, first_col, hashes->data());
+  }
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -97,6 +97,29 @@ TEST_F(RowTupleTest, check_equality_func_with_same_types_different_after_reset)
   EXPECT_NE(rt1_.Hash(), rt2_.Hash());
 }
 
+TEST_F(RowTupleTest, precomputed_hash_is_used) {
+  size_t lazy_hash = rt1_.Hash();
+  rt1_.set_hash(1234);
+  EXPECT_EQ(1234, rt1_.Hash());
+  EXPECT_NE(lazy_hash, 1234);
+}
+
+TEST_F(RowTupleTest, cached_hash_invalidated_on_write) {
+  rt1_.set_hash(1234);
+  rt1_.SetValue(1, types::Int64Value(100));
+  EXPECT_NE(1234, rt1_.Hash());
+}
+
+TEST_F(RowTupleTest, cached_hash_invalidated_on_reset) {
+  rt2_.set_hash(1234);
+  rt2_.Reset();
+  rt2_.SetValue(0, types::BoolValue(false));
+  rt2_.SetValue(1, types::Int64Value(1));
+  rt2_.SetValue(2, types::Float64Value(2.0));
+  rt2_.SetValue(3, types::StringValue("ABC"));
+  EXPECT_EQ(rt1_.Hash(), rt2_.Hash());
+}
+
 using RowTupleDeathTest = RowTupleTest;
 
 TEST_F(RowTupleDeathTest, read_wrong_type) {
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/sample_node.h"
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+std::string SampleNode::DebugStringImpl() {
+  return absl::Substitute("Exec::SampleNode<$0>", plan_node_->DebugString());
+}
+
+Status SampleNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::SAMPLE_OPERATOR);
+  const auto* sample_plan_node = static_cast<const plan::SampleOperator*>(&plan_node);
+  // copy the plan node to local object;
+  plan_node_ = std::make_unique<plan::SampleOperator>(*sample_plan_node);
+
+  if (plan_node_->sample_size() <= 0) {
+    return error::InvalidArgument("Sample operator must have a positive sample size");
+  }
+  if (!plan_node_->stratify_key_indices().empty()) {
+    stratify_key_descending_.assign(plan_node_->stratify_key_indices().size(), false);
+    key_encoder_ = std::make_unique<SortKeyEncoder>(&plan_node_->stratify_key_indices(),
+                                                    &stratify_key_descending_);
+  }
+  rng_.seed(plan_node_->seed() != 0 ? plan_node_->seed() : std::random_device{}());
+  return Status::OK();
+}
+
+Status SampleNode::PrepareImpl(ExecState*) { return Status::OK(); }
+
+Status SampleNode::OpenImpl(ExecState*) { return Status::OK(); }
+
+Status SampleNode::CloseImpl(ExecState*) {
+  reservoirs_.clear();
+  return Status::OK();
+}
+
+Status SampleNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  const size_t sample_size = plan_node_->sample_size();
+  std::shared_ptr<RowBatch> batch;
+  std::string key;
+  for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+    if (key_encoder_ != nullptr) {
+      key.clear();
+      key_encoder_->EncodeRow(rb, row_idx, &key);
+    }
+    auto& reservoir = reservoirs_[key];
+    ++reservoir.rows_seen;
+    if (reservoir.rows.size() < sample_size) {
+      if (batch == nullptr) {
+        batch = std::make_shared<RowBatch>(rb);
+      }
+      reservoir.rows.push_back(SampleEntry{batch, row_idx});
+      continue;
+    }
+    // Algorithm R: the i-th row replaces a kept row with probability sample_size / i.
+    const uint64_t j = rng_() % reservoir.rows_seen;
+    if (j < sample_size) {
+      if (batch == nullptr) {
+        batch = std::make_shared<RowBatch>(rb);
+      }
+      reservoir.rows[j] = SampleEntry{batch, row_idx};
+    }
+  }
+
+  if (rb.eos()) {
+    return EmitSampledRows(exec_state);
+  }
+  return Status::OK();
+}
+
+Status SampleNode::EmitSampledRows(ExecState* exec_state) {
+  int64_t num_rows = 0;
+  for (const auto& [key, reservoir] : reservoirs_) {
+    num_rows += reservoir.rows.size();
+  }
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+  for (size_t col_idx = 0; col_idx < output_descriptor_->size(); ++col_idx) {
+    builders.push_back(
+        types::MakeArrowBuilder(output_descriptor_->type(col_idx), exec_state->exec_mem_pool()));
+    PL_RETURN_IF_ERROR(builders.back()->Reserve(num_rows));
+  }
+  for (size_t col_idx = 0; col_idx < output_descriptor_->size(); ++col_idx) {
+    for (const auto& [key, reservoir] : reservoirs_) {
+      for (const auto& entry : reservoir.rows) {
+        auto arr = entry.rb->ColumnAt(col_idx).get();
+#define TYPE_CASE(_dt_)                                    \
+  PL_RETURN_IF_ERROR(table_store::schema::CopyValue<_dt_>( \
+      builders[col_idx].get(), types::GetValueFromArrowArray<_dt_>(arr, entry.row_idx)));
+        PL_SWITCH_FOREACH_DATATYPE(output_descriptor_->type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+      }
+    }
+  }
+  PL_ASSIGN_OR_RETURN(auto output_rb,
+                      RowBatch::FromColumnBuilders(*output_descriptor_, /* eow */ true,
+                                                   /* eos */ true, &builders));
+  PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *output_rb));
+  reservoirs_.clear();
+  return Status::OK();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/sort_key_encoder.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/common/base/status.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * SampleNode emits a uniform random sample of its input via reservoir sampling, using
+ * memory proportional to the sample size rather than the input. When stratify keys are
+ * set, an independent reservoir is kept per distinct key (encoded with SortKeyEncoder),
+ * so small groups stay represented. Batches are retained only while one of their rows is
+ * still in a reservoir.
+ */
+class SampleNode : public ProcessingNode {
+ public:
+  SampleNode() = default;
+  virtual ~SampleNode() = default;
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  // A sampled row: a handle on the batch it lives in plus its index within that batch.
+  struct SampleEntry {
+    std::shared_ptr<table_store::schema::RowBatch> rb;
+    int64_t row_idx;
+  };
+  struct Reservoir {
+    std::vector<SampleEntry> rows;
+    uint64_t rows_seen = 0;
+  };
+
+  Status EmitSampledRows(ExecState* exec_state);
+
+  // Reservoirs keyed by encoded stratify key; a single empty key when not stratifying.
+  absl::flat_hash_map<std::string, Reservoir> reservoirs_;
+  std::unique_ptr<SortKeyEncoder> key_encoder_;
+  std::vector<bool> stratify_key_descending_;
+  std::mt19937_64 rng_;
+  std::unique_ptr<plan::SampleOperator> plan_node_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/sort_node.h"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+std::string SortNode::DebugStringImpl() {
+  return absl::Substitute("Exec::SortNode<$0>", plan_node_->DebugString());
+}
+
+Status SortNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::SORT_OPERATOR);
+  const auto* sort_plan_node = static_cast<const plan::SortOperator*>(&plan_node);
+  // copy the plan node to local object;
+  plan_node_ = std::make_unique<plan::SortOperator>(*sort_plan_node);
+
+  key_encoder_ = std::make_unique<SortKeyEncoder>(&plan_node_->sort_key_indices(),
+                                                  &plan_node_->sort_key_descending());
+  return Status::OK();
+}
+
+Status SortNode::PrepareImpl(ExecState*) { return Status::OK(); }
+
+Status SortNode::OpenImpl(ExecState*) { return Status::OK(); }
+
+Status SortNode::CloseImpl(ExecState*) {
+  buffered_batches_.clear();
+  return Status::OK();
+}
+
+Status SortNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  buffered_batches_.push_back(rb);
+  if (rb.eos()) {
+    return SortAndEmit(exec_state);
+  }
+  return Status::OK();
+}
+
+Status SortNode::SortAndEmit(ExecState* exec_state) {
+  std::vector<SortEntry> entries;
+  int64_t total_rows = 0;
+  for (const auto& rb : buffered_batches_) {
+    total_rows += rb.num_rows();
+  }
+  entries.reserve(total_rows);
+
+  for (size_t batch_idx = 0; batch_idx < buffered_batches_.size(); ++batch_idx) {
+    const auto& rb = buffered_batches_[batch_idx];
+    for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+      SortEntry entry{"", static_cast<int64_t>(batch_idx), row_idx};
+      key_encoder_->EncodeRow(rb, row_idx, &entry.key);
+      entries.push_back(std::move(entry));
+    }
+  }
+
+  // Ties fall back to input order, making the sort stable.
+  std::sort(entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) {
+    return std::tie(a.key, a.batch_idx, a.row_idx) < std::tie(b.key, b.batch_idx, b.row_idx);
+  });
+
+  int64_t rows_per_batch =
+      plan_node_->rows_per_batch() > 0 ? plan_node_->rows_per_batch() : kDefaultSortRowBatchSize;
+
+  int64_t emitted = 0;
+  while (emitted < total_rows || total_rows == 0) {
+    int64_t batch_rows = std::min(rows_per_batch, total_rows - emitted);
+    std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+    for (size_t col_idx = 0; col_idx < output_descriptor_->size(); ++col_idx) {
+      builders.push_back(
+          types::MakeArrowBuilder(output_descriptor_->type(col_idx), exec_state->exec_mem_pool()));
+      PL_RETURN_IF_ERROR(builders.back()->Reserve(batch_rows));
+    }
+    for (size_t col_idx = 0; col_idx < output_descriptor_->size(); ++col_idx) {
+      for (int64_t i = emitted; i < emitted + batch_rows; ++i) {
+        const auto& entry = entries[i];
+        auto arr = buffered_batches_[entry.batch_idx].ColumnAt(col_idx).get();
+#define TYPE_CASE(_dt_)                                          \
+  PL_RETURN_IF_ERROR(table_store::schema::CopyValue<_dt_>(       \
+      builders[col_idx].get(), types::GetValueFromArrowArray<_dt_>(arr, entry.row_idx)));
+        PL_SWITCH_FOREACH_DATATYPE(output_descriptor_->type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+      }
+    }
+    emitted += batch_rows;
+    bool last = emitted >= total_rows;
+    PL_ASSIGN_OR_RETURN(auto output_rb,
+                        RowBatch::FromColumnBuilders(*output_descriptor_, /* eow */ last,
+                                                     /* eos */ last, &builders));
+    PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *output_rb));
+    if (last) {
+      break;
+    }
+  }
+
+  buffered_batches_.clear();
+  return Status::OK();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
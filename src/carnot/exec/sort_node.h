@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/sort_key_encoder.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/common/base/status.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+constexpr int64_t kDefaultSortRowBatchSize = 1024;
+
+/**
+ * SortNode totally orders its input by the plan's sort keys. It is a blocking operator:
+ * input batches are buffered until eos, then rows are ordered by their normalized sort
+ * keys (see SortKeyEncoder) and streamed out in rows_per_batch chunks.
+ */
+class SortNode : public ProcessingNode {
+ public:
+  SortNode() = default;
+  virtual ~SortNode() = default;
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  // A row's normalized sort key plus its location in the buffered batches.
+  struct SortEntry {
+    std::string key;
+    int64_t batch_idx;
+    int64_t row_idx;
+  };
+
+  Status SortAndEmit(ExecState* exec_state);
+
+  std::vector<table_store::schema::RowBatch> buffered_batches_;
+  std::unique_ptr<SortKeyEncoder> key_encoder_;
+  std::unique_ptr<plan::SortOperator> plan_node_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/sort_node.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/text_format.h>
+#include <gtest/gtest.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+std::unique_ptr<plan::Operator> PlanNodeFromPbtxt(const std::string& pbtxt) {
+  planpb::Operator op_pb;
+  EXPECT_TRUE(google::protobuf::TextFormat::MergeFromString(pbtxt, &op_pb));
+  return plan::Operator::FromProto(op_pb, 1);
+}
+
+class SortNodeTest : public ::testing::Test {
+ public:
+  SortNodeTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    auto table_store = std::make_shared<table_store::TableStore>();
+    exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                              MockResultSinkStubGenerator, MockMetricsStubGenerator,
+                                              MockTraceStubGenerator, sole::uuid4(), nullptr);
+  }
+
+ protected:
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+constexpr char kSingleKeySort[] = R"(
+op_type: SORT_OPERATOR
+sort_op {
+  sort_keys {
+    column_index: 0
+  }
+  rows_per_batch: 3
+})";
+
+constexpr char kMultiKeySort[] = R"(
+op_type: SORT_OPERATOR
+sort_op {
+  sort_keys {
+    column_index: 0
+    descending: true
+  }
+  sort_keys {
+    column_index: 1
+  }
+  rows_per_batch: 10
+})";
+
+TEST_F(SortNodeTest, multi_batch_ascending) {
+  auto plan_node = PlanNodeFromPbtxt(kSingleKeySort);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd,
+                                                                   {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({5, 1, 3})
+                       .AddColumn<types::StringValue>({"e", "a", "c"})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::Int64Value>({2, 4})
+                       .AddColumn<types::StringValue>({"b", "d"})
+                       .get(),
+                   0, 2)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 3, false, false)
+                          .AddColumn<types::Int64Value>({1, 2, 3})
+                          .AddColumn<types::StringValue>({"a", "b", "c"})
+                          .get())
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::Int64Value>({4, 5})
+                          .AddColumn<types::StringValue>({"d", "e"})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, multi_key_descending) {
+  auto plan_node = PlanNodeFromPbtxt(kMultiKeySort);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::FLOAT64});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::FLOAT64});
+
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd,
+                                                                   {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Int64Value>({1, 2, 2, 1})
+                       .AddColumn<types::Float64Value>({4.0, 3.0, 1.0, 2.0})
+                       .get(),
+                   0, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 4, true, true)
+                          .AddColumn<types::Int64Value>({2, 2, 1, 1})
+                          .AddColumn<types::Float64Value>({1.0, 3.0, 2.0, 4.0})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, empty_input) {
+  auto plan_node = PlanNodeFromPbtxt(kSingleKeySort);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd,
+                                                                   {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Int64Value>({})
+                       .AddColumn<types::StringValue>({})
+                       .get(),
+                   0, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 0, true, true)
+                          .AddColumn<types::Int64Value>({})
+                          .AddColumn<types::StringValue>({})
+                          .get())
+      .Close();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
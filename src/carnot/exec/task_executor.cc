@@ -0,0 +1,207 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/task_executor.h"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+DEFINE_int32(carnot_task_executor_threads,
+             gflags::Int32FromEnv("PL_CARNOT_TASK_EXECUTOR_THREADS", 0),
+             "Number of worker threads in Carnot's shared task executor. 0 sizes the pool to "
+             "the CPUs the agent is allowed to run on.");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+size_t TaskExecutor::DefaultNumThreads() {
+  if (FLAGS_carnot_task_executor_threads > 0) {
+    return FLAGS_carnot_task_executor_threads;
+  }
+  // Respect the agent's CPU affinity mask (set by cgroup cpusets in containerized deployments)
+  // rather than the raw core count of the machine.
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0 && CPU_COUNT(&cpuset) > 0) {
+    return CPU_COUNT(&cpuset);
+  }
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+TaskExecutor::TaskExecutor(size_t num_threads) {
+  CHECK_GE(num_threads, 1U);
+  queues_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+TaskExecutor::~TaskExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    shutdown_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void TaskExecutor::TaskGroup::Submit(uint64_t affinity_key, std::function<void()> task) {
+  outstanding_.fetch_add(1);
+  executor_->Enqueue(affinity_key % executor_->queues_.size(), Task{std::move(task), this});
+}
+
+void TaskExecutor::TaskGroup::Wait() {
+  std::unique_lock<std::mutex> lock(executor_->mu_);
+  executor_->done_cv_.wait(lock, [&] { return outstanding_.load() == 0; });
+}
+
+void TaskExecutor::Enqueue(size_t worker_idx, Task task) {
+  {
+    auto& queue = *queues_[worker_idx];
+    std::lock_guard<std::mutex> lock(queue.mu);
+    GroupQueue* group_queue = nullptr;
+    // Linear scan: the number of concurrently executing groups per worker is small.
+    for (auto& gq : queue.groups) {
+      if (gq->group == task.group) {
+        group_queue = gq.get();
+        break;
+      }
+    }
+    if (group_queue == nullptr) {
+      queue.groups.push_back(std::make_unique<GroupQueue>());
+      group_queue = queue.groups.back().get();
+      group_queue->group = task.group;
+    }
+    group_queue->tasks.push_back(std::move(task.fn));
+  }
+  work_cv_.notify_one();
+}
+
+bool TaskExecutor::PopOwnLocked(WorkerQueue* queue, Task* task) {
+  // Deficit round robin: on arrival at a group the worker credits it `weight` tasks, serves it
+  // until the credit is spent, then moves on. Over a full round each group runs a number of
+  // tasks proportional to its weight, regardless of how many tasks it has queued.
+  while (!queue->groups.empty()) {
+    if (queue->rr_idx >= queue->groups.size()) {
+      queue->rr_idx = 0;
+      queue->rr_charged = false;
+    }
+    GroupQueue* gq = queue->groups[queue->rr_idx].get();
+    if (gq->tasks.empty()) {
+      queue->groups.erase(queue->groups.begin() + queue->rr_idx);
+      queue->rr_charged = false;
+      continue;
+    }
+    if (!queue->rr_charged) {
+      gq->deficit += gq->group->weight();
+      queue->rr_charged = true;
+    }
+    if (gq->deficit <= 0) {
+      ++queue->rr_idx;
+      queue->rr_charged = false;
+      continue;
+    }
+    --gq->deficit;
+    task->fn = std::move(gq->tasks.front());
+    task->group = gq->group;
+    gq->tasks.pop_front();
+    if (gq->tasks.empty()) {
+      queue->groups.erase(queue->groups.begin() + queue->rr_idx);
+      queue->rr_charged = false;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool TaskExecutor::NextTask(size_t worker_idx, Task* task) {
+  // Prefer the worker's own queues, then steal from the others.
+  {
+    auto& own = *queues_[worker_idx];
+    std::lock_guard<std::mutex> lock(own.mu);
+    if (PopOwnLocked(&own, task)) {
+      return true;
+    }
+  }
+  for (size_t offset = 1; offset < queues_.size(); ++offset) {
+    auto& victim = *queues_[(worker_idx + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mu);
+    // Steal for the highest-weight group with queued work (ties: longest backlog), so idle
+    // workers help latency-sensitive groups first; steal from the back to avoid contending
+    // with the victim's own front-of-queue pops.
+    GroupQueue* best = nullptr;
+    for (auto& gq : victim.groups) {
+      if (gq->tasks.empty()) {
+        continue;
+      }
+      if (best == nullptr || gq->group->weight() > best->group->weight() ||
+          (gq->group->weight() == best->group->weight() &&
+           gq->tasks.size() > best->tasks.size())) {
+        best = gq.get();
+      }
+    }
+    if (best != nullptr) {
+      task->fn = std::move(best->tasks.back());
+      task->group = best->group;
+      best->tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskExecutor::RunTask(Task* task) {
+  // A cancelled group's tasks are drained without running so the pool frees up promptly.
+  if (!task->group->is_cancelled()) {
+    task->fn();
+  }
+  if (task->group->outstanding_.fetch_sub(1) == 1) {
+    // Last outstanding task of the group; wake any Wait() callers.
+    std::lock_guard<std::mutex> lock(mu_);
+    done_cv_.notify_all();
+  }
+}
+
+void TaskExecutor::WorkerLoop(size_t worker_idx) {
+  while (true) {
+    Task task;
+    if (NextTask(worker_idx, &task)) {
+      RunTask(&task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mu_);
+    if (shutdown_) {
+      return;
+    }
+    work_cv_.wait_for(lock, std::chrono::milliseconds(10));
+  }
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * TaskExecutor is the shared work-stealing thread pool for Carnot's parallel work: morsel-level
+ * scan/filter/agg parallelism, compaction, and any future parallel operators.
+ *
+ * Each worker owns a deque of tasks. Submitted tasks carry an affinity key; tasks with the same
+ * key are pushed onto the same worker's deque, so work for one operator or partition tends to run
+ * on one core and keeps its working set cache-resident. Idle workers steal from the back of other
+ * workers' deques, so affinity is a placement hint rather than a constraint and skewed task costs
+ * do not serialize execution.
+ *
+ * Work is submitted through a TaskGroup, which scopes completion waiting and cancellation to one
+ * logical operation (typically one query phase). A group created with a cancel check drains its
+ * remaining tasks without running them once the check trips; callers pass the owning query's
+ * ExecState cancel token so a cancelled query releases the pool promptly.
+ *
+ * Fairness: each worker schedules the groups queued on it with deficit round robin rather than
+ * FIFO. Every group gets a deficit of `weight` tasks per round, so a group that floods a queue
+ * with thousands of tasks no longer runs to completion ahead of a later, smaller group — the
+ * worker interleaves them at task (batch) granularity. Weights bias the interleave: a group
+ * with weight w runs w tasks per round for every 1 task of a weight-1 group, which lets
+ * latency-sensitive queries (e.g. alerting scripts) hold their execution latency while a large
+ * ad-hoc query shares the same pool.
+ */
+class TaskExecutor : public NotCopyable {
+ public:
+  /**
+   * The pool size used when none is specified: the --carnot_task_executor_threads flag if set,
+   * otherwise the number of CPUs the agent is actually allowed to run on.
+   */
+  static size_t DefaultNumThreads();
+
+  /**
+   * Creates an executor with the given number of worker threads.
+   * @param num_threads The number of workers. Must be >= 1.
+   */
+  explicit TaskExecutor(size_t num_threads);
+  ~TaskExecutor();
+
+  /**
+   * TaskGroup tracks a set of related tasks submitted to the executor. Groups are cheap to
+   * create; use one per logical operation so Wait() and cancellation have the right scope.
+   * A TaskGroup must outlive its submitted tasks; Wait() before destruction guarantees this.
+   */
+  class TaskGroup : public NotCopyable {
+   public:
+    /**
+     * Queues a task on the worker selected by affinity_key. Tasks sharing an affinity key
+     * land on the same worker's deque; the key is typically the operator's node id or a
+     * partition index. The task must be safe to run concurrently with the group's other tasks.
+     */
+    void Submit(uint64_t affinity_key, std::function<void()> task);
+
+    /**
+     * Blocks until every task submitted to this group has completed (or been skipped due to
+     * cancellation). The group may be reused for further Submit calls after Wait() returns.
+     */
+    void Wait();
+
+    int64_t weight() const { return weight_; }
+
+   private:
+    friend class TaskExecutor;
+    TaskGroup(TaskExecutor* executor, std::function<bool()> cancelled, int64_t weight)
+        : executor_(executor), cancelled_(std::move(cancelled)), weight_(weight) {}
+
+    bool is_cancelled() const { return cancelled_ != nullptr && cancelled_(); }
+
+    TaskExecutor* const executor_;
+    // Checked before each task runs; once it returns true the group's remaining tasks are
+    // drained without running.
+    const std::function<bool()> cancelled_;
+    // Scheduling weight: tasks per deficit-round-robin round relative to other groups.
+    const int64_t weight_;
+    std::atomic<size_t> outstanding_{0};
+  };
+
+  /**
+   * Creates a task group. The cancel check, if provided, is polled before each of the group's
+   * tasks runs; pass [exec_state] { return exec_state->cancelled(); } to tie the group's work
+   * to a query's lifetime. The weight sets the group's share of the pool relative to other
+   * groups (see the class comment); priority classes map to weights, with 1 as the baseline.
+   */
+  std::unique_ptr<TaskGroup> CreateTaskGroup(std::function<bool()> cancelled = nullptr,
+                                             int64_t weight = 1) {
+    DCHECK_GE(weight, 1);
+    return std::unique_ptr<TaskGroup>(new TaskGroup(this, std::move(cancelled), weight));
+  }
+
+  size_t num_threads() const { return workers_.size(); }
+
+ private:
+  struct Task {
+    std::function<void()> fn;
+    TaskGroup* group;
+  };
+
+  void Enqueue(size_t worker_idx, Task task);
+  void WorkerLoop(size_t worker_idx);
+  // Pops a task from the worker's own queues (deficit round robin across groups), or steals
+  // one from another worker. Returns false if no task is available.
+  bool NextTask(size_t worker_idx, Task* task);
+  void RunTask(Task* task);
+
+  // Per-worker queue of one group's pending tasks, plus the group's deficit counter on this
+  // worker. Removed once drained; a group that submits again later starts a fresh deficit.
+  struct GroupQueue {
+    TaskGroup* group;
+    std::deque<std::function<void()>> tasks;
+    int64_t deficit = 0;
+  };
+
+  struct WorkerQueue {
+    std::mutex mu;
+    // Active groups in round-robin order. Small: one entry per group with tasks queued here.
+    std::vector<std::unique_ptr<GroupQueue>> groups;
+    // Index of the group currently being served, and whether it has received this round's
+    // deficit credit yet.
+    size_t rr_idx = 0;
+    bool rr_charged = false;
+  };
+
+  // Pops the next task from the worker's own queues under DRR; assumes queue.mu is held.
+  bool PopOwnLocked(WorkerQueue* queue, Task* task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  bool shutdown_ = false;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/task_executor.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+TEST(TaskExecutorTest, runs_all_tasks) {
+  TaskExecutor executor(4);
+  constexpr size_t kNumTasks = 1000;
+
+  std::atomic<size_t> ran(0);
+  auto group = executor.CreateTaskGroup();
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    group->Submit(i, [&] { ran.fetch_add(1); });
+  }
+  group->Wait();
+  EXPECT_EQ(kNumTasks, ran.load());
+}
+
+TEST(TaskExecutorTest, group_reusable_after_wait) {
+  TaskExecutor executor(2);
+  auto group = executor.CreateTaskGroup();
+  for (int iter = 0; iter < 10; ++iter) {
+    std::atomic<size_t> ran(0);
+    for (size_t i = 0; i < 100; ++i) {
+      group->Submit(i, [&] { ran.fetch_add(1); });
+    }
+    group->Wait();
+    EXPECT_EQ(100U, ran.load());
+  }
+}
+
+TEST(TaskExecutorTest, cancelled_group_skips_tasks) {
+  TaskExecutor executor(2);
+  std::atomic<bool> cancelled(false);
+  std::atomic<size_t> ran(0);
+
+  auto group = executor.CreateTaskGroup([&] { return cancelled.load(); });
+  cancelled.store(true);
+  for (size_t i = 0; i < 100; ++i) {
+    group->Submit(i, [&] { ran.fetch_add(1); });
+  }
+  // Wait() must still return even though no task body runs.
+  group->Wait();
+  EXPECT_EQ(0U, ran.load());
+}
+
+TEST(TaskExecutorTest, affinity_key_selects_one_worker_queue) {
+  // With a single submitter and no contention, tasks sharing an affinity key are queued to the
+  // same worker. Stealing can move them, so assert the weaker property that all tasks run and
+  // at most num_threads distinct threads are used.
+  TaskExecutor executor(4);
+  std::mutex mu;
+  std::set<std::thread::id> thread_ids;
+
+  auto group = executor.CreateTaskGroup();
+  for (size_t i = 0; i < 100; ++i) {
+    group->Submit(/* affinity_key */ 7, [&] {
+      std::lock_guard<std::mutex> lock(mu);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+  }
+  group->Wait();
+  EXPECT_GE(thread_ids.size(), 1U);
+  EXPECT_LE(thread_ids.size(), executor.num_threads());
+}
+
+TEST(TaskExecutorTest, concurrent_groups_complete_independently) {
+  TaskExecutor executor(4);
+  std::atomic<size_t> ran_a(0);
+  std::atomic<size_t> ran_b(0);
+
+  auto group_a = executor.CreateTaskGroup();
+  auto group_b = executor.CreateTaskGroup();
+  for (size_t i = 0; i < 500; ++i) {
+    group_a->Submit(i, [&] { ran_a.fetch_add(1); });
+    group_b->Submit(i, [&] { ran_b.fetch_add(1); });
+  }
+  group_a->Wait();
+  group_b->Wait();
+  EXPECT_EQ(500U, ran_a.load());
+  EXPECT_EQ(500U, ran_b.load());
+}
+
+TEST(TaskExecutorTest, small_group_not_starved_by_large_group) {
+  TaskExecutor executor(1);
+
+  // Park the single worker so both groups are fully queued before anything runs.
+  std::atomic<bool> gate(false);
+  auto gate_group = executor.CreateTaskGroup();
+  gate_group->Submit(0, [&] {
+    while (!gate.load()) {
+      std::this_thread::yield();
+    }
+  });
+
+  std::atomic<size_t> big_ran(0);
+  std::atomic<size_t> small_ran(0);
+  std::atomic<size_t> big_ran_when_small_done(0);
+
+  auto big = executor.CreateTaskGroup();
+  for (size_t i = 0; i < 100; ++i) {
+    big->Submit(0, [&] { big_ran.fetch_add(1); });
+  }
+  auto small = executor.CreateTaskGroup();
+  for (size_t i = 0; i < 4; ++i) {
+    small->Submit(0, [&] {
+      if (small_ran.fetch_add(1) + 1 == 4) {
+        big_ran_when_small_done.store(big_ran.load());
+      }
+    });
+  }
+
+  gate.store(true);
+  small->Wait();
+  big->Wait();
+  EXPECT_EQ(100U, big_ran.load());
+  // DRR interleaves the two groups one task per round, so the small group finishes after only a
+  // handful of big tasks. Under FIFO it would have waited for all 100.
+  EXPECT_LE(big_ran_when_small_done.load(), 10U);
+}
+
+TEST(TaskExecutorTest, weights_bias_the_interleave) {
+  TaskExecutor executor(1);
+
+  std::atomic<bool> gate(false);
+  auto gate_group = executor.CreateTaskGroup();
+  gate_group->Submit(0, [&] {
+    while (!gate.load()) {
+      std::this_thread::yield();
+    }
+  });
+
+  std::atomic<size_t> heavy_ran(0);
+  std::atomic<size_t> light_ran(0);
+  std::atomic<size_t> heavy_ran_at_fifth_light(0);
+
+  auto heavy = executor.CreateTaskGroup(/* cancelled */ nullptr, /* weight */ 4);
+  for (size_t i = 0; i < 40; ++i) {
+    heavy->Submit(0, [&] { heavy_ran.fetch_add(1); });
+  }
+  auto light = executor.CreateTaskGroup();
+  for (size_t i = 0; i < 40; ++i) {
+    light->Submit(0, [&] {
+      if (light_ran.fetch_add(1) + 1 == 5) {
+        heavy_ran_at_fifth_light.store(heavy_ran.load());
+      }
+    });
+  }
+
+  gate.store(true);
+  heavy->Wait();
+  light->Wait();
+  // Each round runs 4 heavy tasks then 1 light task, so by the 5th light task the heavy group
+  // has run 4x as many.
+  EXPECT_EQ(20U, heavy_ran_at_fifth_light.load());
+}
+
+TEST(TaskExecutorTest, default_num_threads_is_positive) {
+  EXPECT_GE(TaskExecutor::DefaultNumThreads(), 1U);
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
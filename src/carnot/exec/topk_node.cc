@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/topk_node.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+namespace {
+bool HeapEntryLess(const std::string& a, const std::string& b) { return a < b; }
+}  // namespace
+
+std::string TopKNode::DebugStringImpl() {
+  return absl::Substitute("Exec::TopKNode<$0>", plan_node_->DebugString());
+}
+
+Status TopKNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::TOPK_OPERATOR);
+  const auto* topk_plan_node = static_cast<const plan::TopKOperator*>(&plan_node);
+  // copy the plan node to local object;
+  plan_node_ = std::make_unique<plan::TopKOperator>(*topk_plan_node);
+
+  if (plan_node_->limit() <= 0) {
+    return error::InvalidArgument("TopK operator must have a positive limit");
+  }
+  key_encoder_ = std::make_unique<SortKeyEncoder>(&plan_node_->sort_key_indices(),
+                                                  &plan_node_->sort_key_descending());
+  return Status::OK();
+}
+
+Status TopKNode::PrepareImpl(ExecState*) { return Status::OK(); }
+
+Status TopKNode::OpenImpl(ExecState*) { return Status::OK(); }
+
+Status TopKNode::CloseImpl(ExecState*) {
+  heap_.clear();
+  return Status::OK();
+}
+
+Status TopKNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  auto heap_cmp = [](const HeapEntry& a, const HeapEntry& b) {
+    return HeapEntryLess(a.key, b.key);
+  };
+  size_t limit = plan_node_->limit();
+  std::shared_ptr<RowBatch> batch;
+  std::string key;
+  for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+    key.clear();
+    key_encoder_->EncodeRow(rb, row_idx, &key);
+    if (heap_.size() >= limit && !HeapEntryLess(key, heap_.front().key)) {
+      // Row ranks below everything we're keeping; drop it without copying the batch.
+      continue;
+    }
+    if (batch == nullptr) {
+      batch = std::make_shared<RowBatch>(rb);
+    }
+    if (heap_.size() >= limit) {
+      std::pop_heap(heap_.begin(), heap_.end(), heap_cmp);
+      heap_.pop_back();
+    }
+    heap_.push_back(HeapEntry{std::move(key), batch, row_idx});
+    std::push_heap(heap_.begin(), heap_.end(), heap_cmp);
+  }
+
+  if (rb.eos()) {
+    return EmitTopRows(exec_state);
+  }
+  return Status::OK();
+}
+
+Status TopKNode::EmitTopRows(ExecState* exec_state) {
+  std::sort(heap_.begin(), heap_.end(),
+            [](const HeapEntry& a, const HeapEntry& b) { return HeapEntryLess(a.key, b.key); });
+
+  int64_t num_rows = heap_.size();
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+  for (size_t col_idx = 0; col_idx < output_descriptor_->size(); ++col_idx) {
+    builders.push_back(
+        types::MakeArrowBuilder(output_descriptor_->type(col_idx), exec_state->exec_mem_pool()));
+    PL_RETURN_IF_ERROR(builders.back()->Reserve(num_rows));
+  }
+  for (size_t col_idx = 0; col_idx < output_descriptor_->size(); ++col_idx) {
+    for (const auto& entry : heap_) {
+      auto arr = entry.rb->ColumnAt(col_idx).get();
+#define TYPE_CASE(_dt_)                                          \
+  PL_RETURN_IF_ERROR(table_store::schema::CopyValue<_dt_>(       \
+      builders[col_idx].get(), types::GetValueFromArrowArray<_dt_>(arr, entry.row_idx)));
+      PL_SWITCH_FOREACH_DATATYPE(output_descriptor_->type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+    }
+  }
+  PL_ASSIGN_OR_RETURN(auto output_rb,
+                      RowBatch::FromColumnBuilders(*output_descriptor_, /* eow */ true,
+                                                   /* eos */ true, &builders));
+  PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *output_rb));
+  heap_.clear();
+  return Status::OK();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/sort_key_encoder.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/common/base/status.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * TopKNode emits the first `limit` rows of its input according to the plan's sort keys.
+ * Rows are ranked by their normalized sort keys (see SortKeyEncoder) in a bounded
+ * max-heap, so memory is proportional to the limit rather than the input: each incoming
+ * row either displaces the currently-worst kept row or is dropped on the spot.
+ */
+class TopKNode : public ProcessingNode {
+ public:
+  TopKNode() = default;
+  virtual ~TopKNode() = default;
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  // A kept row: its normalized sort key plus a handle on the batch it lives in. Batches
+  // are retained only while one of their rows is still in the heap.
+  struct HeapEntry {
+    std::string key;
+    std::shared_ptr<table_store::schema::RowBatch> rb;
+    int64_t row_idx;
+  };
+
+  Status EmitTopRows(ExecState* exec_state);
+
+  // Max-heap on the sort key; heap_[0] is the worst kept row.
+  std::vector<HeapEntry> heap_;
+  std::unique_ptr<SortKeyEncoder> key_encoder_;
+  std::unique_ptr<plan::TopKOperator> plan_node_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
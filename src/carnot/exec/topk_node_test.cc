@@ -0,0 +1,150 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/topk_node.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/text_format.h>
+#include <gtest/gtest.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+std::unique_ptr<plan::Operator> PlanNodeFromPbtxt(const std::string& pbtxt) {
+  planpb::Operator op_pb;
+  EXPECT_TRUE(google::protobuf::TextFormat::MergeFromString(pbtxt, &op_pb));
+  return plan::Operator::FromProto(op_pb, 1);
+}
+
+class TopKNodeTest : public ::testing::Test {
+ public:
+  TopKNodeTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    auto table_store = std::make_shared<table_store::TableStore>();
+    exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                              MockResultSinkStubGenerator, MockMetricsStubGenerator,
+                                              MockTraceStubGenerator, sole::uuid4(), nullptr);
+  }
+
+ protected:
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+constexpr char kAscendingTop3[] = R"(
+op_type: TOPK_OPERATOR
+topk_op {
+  sort_keys {
+    column_index: 1
+  }
+  limit: 3
+  rows_per_batch: 10
+})";
+
+constexpr char kDescendingTop2[] = R"(
+op_type: TOPK_OPERATOR
+topk_op {
+  sort_keys {
+    column_index: 1
+    descending: true
+  }
+  limit: 2
+  rows_per_batch: 10
+})";
+
+TEST_F(TopKNodeTest, ascending_multi_batch) {
+  auto plan_node = PlanNodeFromPbtxt(kAscendingTop3);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::STRING, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<TopKNode, plan::TopKOperator>(*plan_node, output_rd,
+                                                                   {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::StringValue>({"a", "b", "c", "d"})
+                       .AddColumn<types::Int64Value>({40, 10, 30, 20})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::StringValue>({"e", "f"})
+                       .AddColumn<types::Int64Value>({5, 50})
+                       .get(),
+                   0, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 3, true, true)
+                          .AddColumn<types::StringValue>({"e", "b", "d"})
+                          .AddColumn<types::Int64Value>({5, 10, 20})
+                          .get())
+      .Close();
+}
+
+TEST_F(TopKNodeTest, descending) {
+  auto plan_node = PlanNodeFromPbtxt(kDescendingTop2);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::STRING, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<TopKNode, plan::TopKOperator>(*plan_node, output_rd,
+                                                                   {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::StringValue>({"a", "b", "c", "d"})
+                       .AddColumn<types::Int64Value>({40, 10, 50, 20})
+                       .get(),
+                   0, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::StringValue>({"c", "a"})
+                          .AddColumn<types::Int64Value>({50, 40})
+                          .get())
+      .Close();
+}
+
+TEST_F(TopKNodeTest, limit_larger_than_input) {
+  auto plan_node = PlanNodeFromPbtxt(kAscendingTop3);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::STRING, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<TopKNode, plan::TopKOperator>(*plan_node, output_rd,
+                                                                   {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::StringValue>({"a", "b"})
+                       .AddColumn<types::Int64Value>({20, 10})
+                       .get(),
+                   0, 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::StringValue>({"b", "a"})
+                          .AddColumn<types::Int64Value>({10, 20})
+                          .get())
+      .Close();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
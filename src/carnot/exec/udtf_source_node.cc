@@ -36,6 +36,11 @@
 #include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
 #include "src/table_store/table_store.h"
 
+DEFINE_int32(carnot_udtf_partitions, 1,
+             "Number of parallel instances to run for UDTF sources that support partitioned "
+             "execution. UDTFs opt in by implementing SetPartition(); all others run a single "
+             "instance regardless of this flag.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -46,6 +51,14 @@ constexpr int kUDTFBatchSize = 1024;
 
 std::string UDTFSourceNode::DebugStringImpl() { return std::string(); }
 
+namespace {
+
+bool UsePartitionedExecution(const udf::UDTFDefinition& udtf_def) {
+  return FLAGS_carnot_udtf_partitions > 1 && udtf_def.supports_partitioning();
+}
+
+}  // namespace
+
 Status UDTFSourceNode::InitImpl(const plan::Operator& plan_node) {
   const auto* source_plan_node = static_cast<const plan::UDTFSourceOperator*>(&plan_node);
   // copy the plan node to local object;
@@ -62,9 +75,9 @@ Status UDTFSourceNode::PrepareImpl(ExecState* exec_state) {
   return Status::OK();
 }
 
-Status UDTFSourceNode::OpenImpl(ExecState* exec_state) {
-  function_ctx_ = exec_state->CreateFunctionContext();
-  udtf_inst_ = udtf_def_->Make();
+StatusOr<std::unique_ptr<udf::AnyUDTF>> UDTFSourceNode::MakeUDTFInstance(
+    udf::FunctionContext* ctx) {
+  auto udtf_inst = udtf_def_->Make();
 
   ObjectPool init_args_pool{"udtf_init_args_pool"};
   std::vector<const types::BaseValueType*> init_args;
@@ -93,16 +106,148 @@ Status UDTFSourceNode::OpenImpl(ExecState* exec_state) {
     }
   }
 
-  return udtf_def_->ExecInit(udtf_inst_.get(), function_ctx_.get(), init_args);
+  PL_RETURN_IF_ERROR(udtf_def_->ExecInit(udtf_inst.get(), ctx, init_args));
+  return udtf_inst;
+}
+
+Status UDTFSourceNode::OpenImpl(ExecState* exec_state) {
+  if (!UsePartitionedExecution(*udtf_def_)) {
+    function_ctx_ = exec_state->CreateFunctionContext();
+    PL_ASSIGN_OR_RETURN(udtf_inst_, MakeUDTFInstance(function_ctx_.get()));
+    return Status::OK();
+  }
+
+  size_t num_partitions = static_cast<size_t>(FLAGS_carnot_udtf_partitions);
+  for (size_t i = 0; i < num_partitions; ++i) {
+    partition_ctxs_.emplace_back(exec_state->CreateFunctionContext());
+    PL_ASSIGN_OR_RETURN(auto udtf_inst, MakeUDTFInstance(partition_ctxs_[i].get()));
+    udtf_def_->ExecSetPartition(udtf_inst.get(), i, num_partitions);
+    partition_insts_.emplace_back(std::move(udtf_inst));
+  }
+
+  active_partitions_ = num_partitions;
+  for (size_t i = 0; i < num_partitions; ++i) {
+    partition_threads_.emplace_back(
+        [this, i, mem_pool = exec_state->exec_mem_pool()] { PartitionWorker(i, mem_pool); });
+  }
+  return Status::OK();
+}
+
+void UDTFSourceNode::PartitionWorker(size_t partition_idx, arrow::MemoryPool* mem_pool) {
+  // Bounds the queue of produced batches so that fast partitions don't buffer far ahead of the
+  // consumer.
+  constexpr size_t kMaxPendingUDTFBatches = 32;
+
+  bool has_more = true;
+  while (has_more) {
+    {
+      std::unique_lock<std::mutex> lock(batch_mu_);
+      batch_cv_.wait(lock, [this] {
+        return pending_batches_.size() < kMaxPendingUDTFBatches || stop_workers_;
+      });
+      if (stop_workers_) {
+        break;
+      }
+    }
+
+    std::vector<std::unique_ptr<arrow::ArrayBuilder>> outputs;
+    for (const auto& r : udtf_def_->output_relation()) {
+      outputs.emplace_back(types::MakeArrowBuilder(r.type(), mem_pool));
+    }
+    std::vector<arrow::ArrayBuilder*> outputs_raw;
+    for (auto& out : outputs) {
+      outputs_raw.emplace_back(out.get());
+    }
+
+    has_more = udtf_def_->ExecBatchUpdate(partition_insts_[partition_idx].get(),
+                                          partition_ctxs_[partition_idx].get(), kUDTFBatchSize,
+                                          &outputs_raw);
+
+    // The eow/eos markers are attached by GenerateNextImpl once all partitions have drained.
+    auto rb_or_s = table_store::schema::RowBatch::FromColumnBuilders(
+        *output_descriptor_, /*eow*/ false, /*eos*/ false, &outputs);
+
+    std::lock_guard<std::mutex> lock(batch_mu_);
+    if (!rb_or_s.ok()) {
+      if (partition_status_.ok()) {
+        partition_status_ = rb_or_s.status();
+      }
+      break;
+    }
+    auto rb = rb_or_s.ConsumeValueOrDie();
+    if (rb->num_rows() > 0) {
+      pending_batches_.emplace_back(std::move(rb));
+    }
+    batch_cv_.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(batch_mu_);
+    --active_partitions_;
+  }
+  batch_cv_.notify_all();
 }
 
-Status UDTFSourceNode::CloseImpl(ExecState* /*exec_state*/) { return Status::OK(); }
+void UDTFSourceNode::JoinPartitionWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(batch_mu_);
+    stop_workers_ = true;
+  }
+  batch_cv_.notify_all();
+  for (auto& thread : partition_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  partition_threads_.clear();
+}
+
+Status UDTFSourceNode::CloseImpl(ExecState* /*exec_state*/) {
+  JoinPartitionWorkers();
+  return Status::OK();
+}
+
+Status UDTFSourceNode::GenerateNextPartitioned(ExecState* exec_state) {
+  std::unique_ptr<table_store::schema::RowBatch> rb;
+  {
+    std::unique_lock<std::mutex> lock(batch_mu_);
+    batch_cv_.wait(lock, [this] { return !pending_batches_.empty() || active_partitions_ == 0; });
+    PL_RETURN_IF_ERROR(partition_status_);
+    if (!pending_batches_.empty()) {
+      rb = std::move(pending_batches_.front());
+      pending_batches_.pop_front();
+    }
+    if (pending_batches_.empty() && active_partitions_ == 0) {
+      has_more_batches_ = false;
+    }
+  }
+  // Popping a batch may unblock a worker waiting for queue space.
+  batch_cv_.notify_all();
+
+  if (rb == nullptr) {
+    // All partitions finished without leaving a batch behind; emit an empty terminal batch.
+    PL_ASSIGN_OR_RETURN(rb, table_store::schema::RowBatch::WithZeroRows(*output_descriptor_,
+                                                                        /*eow*/ true,
+                                                                        /*eos*/ true));
+    return SendRowBatchToChildren(exec_state, *rb);
+  }
+
+  if (!has_more_batches_) {
+    rb->set_eow(true);
+    rb->set_eos(true);
+  }
+  return SendRowBatchToChildren(exec_state, *rb);
+}
 
 Status UDTFSourceNode::GenerateNextImpl(ExecState* exec_state) {
+  if (UsePartitionedExecution(*udtf_def_)) {
+    return GenerateNextPartitioned(exec_state);
+  }
+
   std::vector<std::unique_ptr<arrow::ArrayBuilder>> outputs;
 
   for (const auto& r : udtf_def_->output_relation()) {
-    outputs.emplace_back(types::MakeArrowBuilder(r.type(), arrow::default_memory_pool()));
+    outputs.emplace_back(types::MakeArrowBuilder(r.type(), exec_state->exec_mem_pool()));
   }
 
   // TODO(zasgar): Change Exec to take in unique_ptrs.
@@ -18,8 +18,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "src/carnot/exec/exec_node.h"
@@ -33,6 +37,8 @@
 #include "src/common/base/status.h"
 #include "src/table_store/schema/row_descriptor.h"
 
+DECLARE_int32(carnot_udtf_partitions);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -53,11 +59,29 @@ class UDTFSourceNode : public SourceNode {
   Status GenerateNextImpl(ExecState* exec_state) override;
 
  private:
+  StatusOr<std::unique_ptr<udf::AnyUDTF>> MakeUDTFInstance(udf::FunctionContext* ctx);
+  Status GenerateNextPartitioned(ExecState* exec_state);
+  void PartitionWorker(size_t partition_idx, arrow::MemoryPool* mem_pool);
+  void JoinPartitionWorkers();
+
   bool has_more_batches_ = true;
   udf::UDTFDefinition* udtf_def_ = nullptr;
   std::unique_ptr<plan::UDTFSourceOperator> plan_node_;
   std::unique_ptr<udf::FunctionContext> function_ctx_;
   std::unique_ptr<udf::AnyUDTF> udtf_inst_;
+
+  // Partitioned execution state. Used when the UDTF supports partitioning and
+  // --carnot_udtf_partitions > 1. Each partition runs its own UDTF instance on a worker thread,
+  // and the node unions the produced row batches.
+  std::vector<std::unique_ptr<udf::FunctionContext>> partition_ctxs_;
+  std::vector<std::unique_ptr<udf::AnyUDTF>> partition_insts_;
+  std::vector<std::thread> partition_threads_;
+  std::mutex batch_mu_;
+  std::condition_variable batch_cv_;
+  std::deque<std::unique_ptr<table_store::schema::RowBatch>> pending_batches_;
+  size_t active_partitions_ = 0;
+  bool stop_workers_ = false;
+  Status partition_status_;
 };
 
 }  // namespace exec
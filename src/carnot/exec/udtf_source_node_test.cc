@@ -87,6 +87,38 @@ class BasicTestUDTF : public UDTF<BasicTestUDTF> {
   std::string some_string_;
 };
 
+// UDTF that opts into partitioned execution: each partition emits a disjoint stride of the
+// overall record range, so the union across partitions covers [0, kNumRecords).
+class PartitionedTestUDTF : public UDTF<PartitionedTestUDTF> {
+ public:
+  static constexpr int64_t kNumRecords = 10;
+
+  static constexpr auto Executor() { return udfspb::UDTFSourceExecutor::UDTF_ALL_AGENTS; }
+
+  static constexpr auto OutputRelation() {
+    return MakeArray(
+        ColInfo("out_int", types::DataType::INT64, types::PatternType::GENERAL, "int result"));
+  }
+
+  void SetPartition(size_t partition_idx, size_t total_partitions) {
+    next_ = static_cast<int64_t>(partition_idx);
+    stride_ = static_cast<int64_t>(total_partitions);
+  }
+
+  bool NextRecord(FunctionContext*, RecordWriter* rw) {
+    if (next_ >= kNumRecords) {
+      return false;
+    }
+    rw->Append<IndexOf("out_int")>(next_);
+    next_ += stride_;
+    return true;
+  }
+
+ private:
+  int64_t next_ = 0;
+  int64_t stride_ = 1;
+};
+
 constexpr char kUDTFTestPbtxt[] = R"proto(
   op_type: UDTF_SOURCE_OPERATOR
   udtf_source_op {
@@ -102,6 +134,13 @@ constexpr char kUDTFTestPbtxt[] = R"proto(
   }
 )proto";
 
+constexpr char kPartitionedUDTFTestPbtxt[] = R"proto(
+  op_type: UDTF_SOURCE_OPERATOR
+  udtf_source_op {
+    name: "partitioned_test_udtf"
+  }
+)proto";
+
 class UDTFSourceNodeTest : public ::testing::Test {
  public:
   UDTFSourceNodeTest() {
@@ -111,6 +150,7 @@ class UDTFSourceNodeTest : public ::testing::Test {
 
     func_registry_ = std::make_unique<udf::Registry>("test_registry");
     EXPECT_OK(func_registry_->Register<BasicTestUDTF>("test_udtf"));
+    EXPECT_OK(func_registry_->Register<PartitionedTestUDTF>("partitioned_test_udtf"));
     auto table_store = std::make_shared<table_store::TableStore>();
 
     exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
@@ -136,6 +176,34 @@ TEST_F(UDTFSourceNodeTest, single_output_batch_test) {
           .get());
 }
 
+TEST_F(UDTFSourceNodeTest, partitioned_output_union_test) {
+  int32_t orig_partitions = FLAGS_carnot_udtf_partitions;
+  FLAGS_carnot_udtf_partitions = 2;
+
+  planpb::Operator op_pb;
+  EXPECT_TRUE(google::protobuf::TextFormat::MergeFromString(kPartitionedUDTFTestPbtxt, &op_pb));
+  auto plan_node = plan::UDTFSourceOperator::FromProto(op_pb, 1);
+
+  RowDescriptor output_rd({types::DataType::INT64});
+  auto tester = exec::ExecNodeTester<UDTFSourceNode, plan::UDTFSourceOperator>(
+      *plan_node, output_rd, {}, exec_state_.get());
+
+  // Partitions run concurrently, so the number of batches and the row order across batches are
+  // not deterministic. Drain the node and check the union of all rows.
+  int64_t num_batches = 0;
+  while (tester.node()->HasBatchesRemaining()) {
+    tester.GenerateNextResult();
+    ++num_batches;
+  }
+  tester.ExpectRowBatchesData(RowBatchBuilder(output_rd, PartitionedTestUDTF::kNumRecords,
+                                              /*eow*/ true, /*eos*/ true)
+                                  .AddColumn<types::Int64Value>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9})
+                                  .get(),
+                              num_batches);
+
+  FLAGS_carnot_udtf_partitions = orig_partitions;
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -33,6 +33,7 @@
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/type_utils.h"
 #include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
+#include "src/table_store/schema/column_copy.h"
 
 namespace px {
 namespace carnot {
@@ -111,13 +112,32 @@ types::Time64NSValue UnionNode::GetTimeAtParentCursor(size_t parent_index) const
                                                         row_cursors_[parent_index]);
 }
 
-Status UnionNode::AppendRow(size_t parent) {
-  auto row = row_cursors_[parent];
+// Counts how many rows at the parent's cursor have time below `limit`. Rows with time equal
+// to the limit count only when allow_equal is set (merge stability with respect to parent
+// index).
+size_t UnionNode::NumMergeableRows(size_t parent, types::Time64NSValue limit,
+                                   bool allow_equal) const {
+  DCHECK(!flushed_parent_eoses_[parent]);
+  const auto* times = time_columns_[parent];
+  const auto num_rows = static_cast<size_t>(times->length());
+  size_t row = row_cursors_[parent];
+  while (row < num_rows) {
+    auto time = types::GetValueFromArrowArray<types::TIME64NS>(times, row);
+    if (time > limit || (time == limit && !allow_equal)) {
+      break;
+    }
+    ++row;
+  }
+  return row - row_cursors_[parent];
+}
+
+Status UnionNode::AppendRows(size_t parent, size_t num_rows) {
+  auto start_row = row_cursors_[parent];
   for (size_t i = 0; i < output_descriptor_->size(); ++i) {
     auto input_col = data_columns_[parent][i];
-#define TYPE_CASE(_dt_)                                    \
-  PL_RETURN_IF_ERROR(table_store::schema::CopyValue<_dt_>( \
-      column_builders_[i].get(), types::GetValueFromArrowArray<_dt_>(input_col, row)));
+#define TYPE_CASE(_dt_)                                         \
+  PL_RETURN_IF_ERROR(table_store::schema::CopyValueRange<_dt_>( \
+      column_builders_[i].get(), input_col, start_row, num_rows));
     PL_SWITCH_FOREACH_DATATYPE(output_descriptor_->type(i), TYPE_CASE);
 #undef TYPE_CASE
   }
@@ -202,24 +222,30 @@ Status UnionNode::MergeData(ExecState* exec_state) {
     size_t parent = parent_streams[0];
 
     while (parent_row_batches_[parent].size()) {
+      const auto& rb = parent_row_batches_[parent][0];
+      size_t num_rows = rb.num_rows() - row_cursors_[parent];
       if (has_limit) {
         size_t next_parent = parent_streams[1];
-        // If this time is greater than another parent stream's earliest time,
-        // or if they are the same but the first parent is at a smaller index, stop merging.
-        // This way rows are always stable with respect to input parent index.
-        if (GetTimeAtParentCursor(parent) > GetTimeAtParentCursor(next_parent) ||
-            (GetTimeAtParentCursor(parent) == GetTimeAtParentCursor(next_parent) &&
-             parent > next_parent)) {
+        // Rows merge while this stream's time stays below another parent stream's earliest
+        // time; ties go to the smaller parent index. This way rows are always stable with
+        // respect to input parent index.
+        num_rows = NumMergeableRows(parent, GetTimeAtParentCursor(next_parent),
+                                    /* allow_equal */ parent < next_parent);
+        if (num_rows == 0) {
           break;
         }
       }
+      // Append up to the output batch boundary; any remaining mergeable rows are picked up by
+      // the next pass once the flush below runs.
+      num_rows = std::min(
+          num_rows, output_rows_per_batch_ - static_cast<size_t>(column_builders_[0]->length()));
 
-      PL_RETURN_IF_ERROR(AppendRow(parent));
+      PL_RETURN_IF_ERROR(AppendRows(parent, num_rows));
+      row_cursors_[parent] += num_rows;
 
       // Mark whether or not we hit the eos for this stream, and whether the row batch needs to be
       // popped.
-      const auto& rb = parent_row_batches_[parent][0];
-      bool pop_row_batch = ++row_cursors_[parent] == static_cast<size_t>(rb.num_rows());
+      bool pop_row_batch = row_cursors_[parent] == static_cast<size_t>(rb.num_rows());
       if (pop_row_batch && rb.eos()) {
         flushed_parent_eoses_[parent] = true;
       }
@@ -0,0 +1,515 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/window_agg_node.h"
+
+#include <arrow/array.h>
+#include <arrow/array/builder_base.h>
+#include <algorithm>
+#include <cstdint>
+
+#include <absl/strings/str_join.h>
+#include <absl/strings/substitute.h>
+#include <magic_enum.hpp>
+
+#include "src/carnot/exec/agg_hash_table.h"
+#include "src/carnot/exec/expression_evaluator.h"
+#include "src/carnot/plan/scalar_expression.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/udf/udf_wrapper.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+#include "src/shared/types/types.h"
+
+DEFINE_bool(enable_incremental_window_agg,
+            gflags::BoolFromEnv("PL_ENABLE_INCREMENTAL_WINDOW_AGG", false),
+            "Whether windowed aggregates keep incremental per-window UDA state across "
+            "executions of a standing query, so each run only aggregates new rows.");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+namespace {
+
+constexpr int64_t kWindowAggCompactionThreshold = 512;
+// Cached state from standing queries that have stopped running is swept after this TTL.
+constexpr std::chrono::minutes kWindowAggStateTTL{15};
+
+template <types::DataType DT>
+void ExtractIntoRowTuples(std::vector<RowTuple*>* row_tuples, arrow::Array* col, int rt_col_idx) {
+  auto num_rows = col->length();
+  for (auto row_idx = 0; row_idx < num_rows; ++row_idx) {
+    ExtractIntoRowTuple<DT>((*row_tuples)[row_idx], col, rt_col_idx, row_idx);
+  }
+}
+
+template <types::DataType DT>
+void AppendKeyToBuilder(arrow::ArrayBuilder* builder, const GroupKeyDecoder& decoder, size_t idx) {
+  using ArrowBuilder = typename types::DataTypeTraits<DT>::arrow_builder_type;
+  using ValueType = typename types::DataTypeTraits<DT>::value_type;
+  auto status =
+      static_cast<ArrowBuilder*>(builder)->Append(udf::UnWrap(decoder.GetValue<ValueType>(idx)));
+  PL_DCHECK_OK(status);
+  PL_UNUSED(status);
+}
+
+template <types::DataType DT>
+void ExtractToBufferedColumns(const std::vector<WindowAggNode::CachedGroup*>& row_groups,
+                              const table_store::schema::RowBatch& rb, size_t col_idx,
+                              size_t rb_col_idx) {
+  size_t num_rows = rb.num_rows();
+  auto arr = rb.ColumnAt(rb_col_idx).get();
+  for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+    auto* group = row_groups[row_idx];
+    if (group == nullptr) {
+      // Row belongs to a window that was already aggregated by a previous execution.
+      continue;
+    }
+    types::ExtractValueToColumnWrapper<DT>(group->agg_cols[col_idx].get(), arr, row_idx);
+  }
+}
+
+}  // namespace
+
+WindowAggNode::StateCache* WindowAggNode::StateCache::GetInstance() {
+  static StateCache* cache = new StateCache();
+  return cache;
+}
+
+std::shared_ptr<WindowAggNode::QueryState> WindowAggNode::StateCache::GetOrCreate(
+    const std::string& key) {
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(lock_);
+  for (auto it = states_.begin(); it != states_.end();) {
+    if (it->second.use_count() == 1 && now - it->second->last_used > kWindowAggStateTTL) {
+      it = states_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto it = states_.find(key);
+  if (it == states_.end()) {
+    it = states_.emplace(key, std::make_shared<QueryState>()).first;
+    it->second->last_used = now;
+  }
+  return it->second;
+}
+
+std::string WindowAggNode::DebugStringImpl() {
+  return absl::Substitute("Exec::WindowAggNode<groups=$0, values=$1>",
+                          plan_node_->groups().size(), plan_node_->values().size());
+}
+
+Status WindowAggNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::AGGREGATE_OPERATOR);
+  const auto* agg_plan_node = static_cast<const plan::AggregateOperator*>(&plan_node);
+
+  // Copy the plan node to local object.
+  plan_node_ = std::make_unique<plan::AggregateOperator>(*agg_plan_node);
+
+  if (input_descriptors_.size() != 1) {
+    return error::InvalidArgument("WindowAgg operator expects a single input relation, got $0",
+                                  input_descriptors_.size());
+  }
+  input_descriptor_ = std::make_unique<table_store::schema::RowDescriptor>(input_descriptors_[0]);
+
+  if (!CanIncrementallyAggregate(*plan_node_)) {
+    return error::InvalidArgument(
+        "WindowAgg operator requires a windowed aggregate with at least one group");
+  }
+
+  for (const auto& value : plan_node_->values()) {
+    if (value->ExpressionType() != plan::Expression::kAgg) {
+      return error::InvalidArgument("WindowAgg operator can only use aggregate expressions");
+    }
+  }
+
+  size_t output_size = plan_node_->values().size() + plan_node_->groups().size();
+  if (output_size != output_descriptor_->size()) {
+    return error::InvalidArgument("Output size mismatch in window aggregate");
+  }
+
+  auto groups_size = plan_node_->groups().size();
+  group_data_types_.reserve(groups_size);
+  for (const auto& group : plan_node_->groups()) {
+    DCHECK(group.idx < input_descriptor_->size());
+    group_data_types_.emplace_back(input_descriptor_->type(group.idx));
+  }
+
+  // The first group column is the window bucket (e.g. px.bin(time_, window)).
+  bucket_data_type_ = group_data_types_[0];
+  if (bucket_data_type_ != types::TIME64NS && bucket_data_type_ != types::INT64) {
+    return error::InvalidArgument(
+        "WindowAgg operator requires the first group to be a time bucket (TIME64NS or INT64), "
+        "got $0",
+        magic_enum::enum_name(bucket_data_type_));
+  }
+
+  auto values_size = plan_node_->values().size();
+  for (size_t i = 0; i < values_size; ++i) {
+    auto values_idx = i + groups_size;
+    DCHECK(values_idx < output_descriptor_->size());
+    value_data_types_.emplace_back(output_descriptor_->type(values_idx));
+  }
+
+  return CreateColumnMapping();
+}
+
+Status WindowAggNode::PrepareImpl(ExecState* exec_state) {
+  function_ctx_ = exec_state->CreateFunctionContext();
+
+  state_ = StateCache::GetInstance()->GetOrCreate(BuildStateKey());
+  if (!state_->mu.try_lock()) {
+    // Another execution of the same standing query is in flight. Run against private
+    // state rather than blocking: this execution aggregates everything from scratch.
+    state_ = std::make_shared<QueryState>();
+    state_->mu.lock();
+  }
+  return Status::OK();
+}
+
+Status WindowAggNode::OpenImpl(ExecState*) { return Status::OK(); }
+
+Status WindowAggNode::CloseImpl(ExecState*) {
+  if (state_ != nullptr) {
+    state_->last_used = std::chrono::steady_clock::now();
+    state_->mu.unlock();
+    state_.reset();
+  }
+  row_tuples_chunk_.clear();
+  row_groups_.clear();
+  row_tuples_pool_.Clear();
+  return Status::OK();
+}
+
+Status WindowAggNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  size_t num_rows = rb.num_rows();
+  if (num_rows > 0) {
+    PL_RETURN_IF_ERROR(ExtractRowTupleForBatch(rb));
+
+    auto* bucket_col = rb.ColumnAt(plan_node_->groups()[0].idx).get();
+    row_groups_.assign(num_rows, nullptr);
+    for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+      int64_t bucket = BucketValue(bucket_col, row_idx);
+      saw_rows_ = true;
+      min_bucket_seen_ = std::min(min_bucket_seen_, bucket);
+      max_bucket_seen_ = std::max(max_bucket_seen_, bucket);
+      if (bucket <= state_->closed_cursor) {
+        // This window's state is already complete in the cache.
+        continue;
+      }
+      scratch_key_.clear();
+      SerializeGroupKey(group_data_types_, *row_tuples_chunk_[row_idx], &scratch_key_);
+      auto [it, inserted] = state_->groups.try_emplace(scratch_key_);
+      if (inserted) {
+        PL_RETURN_IF_ERROR(InitCachedGroup(exec_state, bucket, &it->second));
+      }
+      row_groups_[row_idx] = &it->second;
+    }
+
+    // Buffer the agg input values column-wise into the groups touched by this batch.
+    for (size_t i = 0; i < stored_cols_data_types_.size(); ++i) {
+      const auto& rb_col_idx = stored_cols_to_plan_idx_[i];
+      const auto& dt = input_descriptor_->type(rb_col_idx);
+
+#define TYPE_CASE(_dt_) ExtractToBufferedColumns<_dt_>(row_groups_, rb, i, rb_col_idx);
+      PL_SWITCH_FOREACH_DATATYPE(dt, TYPE_CASE);
+#undef TYPE_CASE
+    }
+
+    for (auto* group : row_groups_) {
+      if (group != nullptr && !group->agg_cols.empty() &&
+          group->agg_cols[0]->Size() > kWindowAggCompactionThreshold) {
+        PL_RETURN_IF_ERROR(FlushGroup(exec_state, group));
+      }
+    }
+  }
+
+  if (rb.eos()) {
+    return EmitAndAdvance(exec_state, rb);
+  }
+  return Status::OK();
+}
+
+Status WindowAggNode::ExtractRowTupleForBatch(const RowBatch& rb) {
+  size_t num_rows = rb.num_rows();
+  if (row_tuples_chunk_.size() < num_rows) {
+    size_t prev_size = row_tuples_chunk_.size();
+    row_tuples_chunk_.reserve(num_rows);
+    for (size_t idx = prev_size; idx < num_rows; ++idx) {
+      row_tuples_chunk_.push_back(row_tuples_pool_.Add(new RowTuple(&group_data_types_)));
+    }
+  }
+  for (size_t idx = 0; idx < num_rows; ++idx) {
+    row_tuples_chunk_[idx]->Reset();
+  }
+
+  for (size_t idx = 0; idx < plan_node_->groups().size(); idx++) {
+    auto grp = plan_node_->groups()[idx];
+    DCHECK(grp.idx < input_descriptor_->size());
+    auto dt = group_data_types_[idx];
+    auto col = rb.ColumnAt(grp.idx).get();
+
+#define TYPE_CASE(_dt_) ExtractIntoRowTuples<_dt_>(&row_tuples_chunk_, col, idx);
+    PL_SWITCH_FOREACH_DATATYPE(dt, TYPE_CASE);
+#undef TYPE_CASE
+  }
+  return Status::OK();
+}
+
+int64_t WindowAggNode::BucketValue(arrow::Array* arr, int64_t row_idx) const {
+  if (bucket_data_type_ == types::TIME64NS) {
+    return types::GetValueFromArrowArray<types::TIME64NS>(arr, row_idx).val;
+  }
+  return types::GetValueFromArrowArray<types::INT64>(arr, row_idx).val;
+}
+
+Status WindowAggNode::InitCachedGroup(ExecState* exec_state, int64_t bucket, CachedGroup* group) {
+  group->bucket = bucket;
+  PL_RETURN_IF_ERROR(CreateUDAInfoValues(&group->udas, exec_state));
+  for (const auto& dt : stored_cols_data_types_) {
+    group->agg_cols.emplace_back(types::ColumnWrapper::Make(dt, 0));
+  }
+  return Status::OK();
+}
+
+Status WindowAggNode::FlushGroup(ExecState* exec_state, CachedGroup* group) {
+  if (group->agg_cols.empty() || group->agg_cols[0]->Size() == 0) {
+    return Status::OK();
+  }
+  size_t values_size = plan_node_->values().size();
+  for (size_t i = 0; i < values_size; ++i) {
+    const auto& uda_info = group->udas[i];
+    const auto& expr = *plan_node_->values()[i];
+    size_t num_records = group->agg_cols[0]->Size();
+    plan::ExpressionWalker<StatusOr<types::SharedColumnWrapper>> walker;
+    walker.OnScalarValue([&](const plan::ScalarValue& scalar_val,
+                             const std::vector<StatusOr<types::SharedColumnWrapper>>& children)
+                             -> types::SharedColumnWrapper {
+      DCHECK_EQ(children.size(), 0ULL);
+      return EvalScalarToColumnWrapper(exec_state, scalar_val, num_records);
+    });
+
+    walker.OnColumn([&](const plan::Column& col,
+                        const std::vector<StatusOr<types::SharedColumnWrapper>>& children)
+                        -> types::SharedColumnWrapper {
+      DCHECK_EQ(children.size(), 0ULL);
+      return group->agg_cols[plan_cols_to_stored_map_[col.Index()]];
+    });
+
+    walker.OnAggregateExpression(
+        [&](const plan::AggregateExpression& agg,
+            const std::vector<StatusOr<types::SharedColumnWrapper>>& children)
+            -> StatusOr<types::SharedColumnWrapper> {
+          DCHECK(agg.name() == uda_info.def->name());
+          DCHECK(children.size() == uda_info.def->update_arguments().size());
+          std::vector<const types::ColumnWrapper*> raw_children;
+          raw_children.reserve(children.size());
+          for (auto& child : children) {
+            PL_RETURN_IF_ERROR(child);
+            raw_children.push_back(child.ValueOrDie().get());
+          }
+          PL_RETURN_IF_ERROR(
+              uda_info.def->ExecBatchUpdate(uda_info.uda.get(), nullptr /* ctx */, raw_children));
+          return {};
+        });
+    PL_RETURN_IF_ERROR(walker.Walk(expr));
+  }
+
+  for (auto& col : group->agg_cols) {
+    // Clear the buffered values, so we don't aggregate them twice.
+    col->Clear();
+  }
+  return Status::OK();
+}
+
+Status WindowAggNode::EmitAndAdvance(ExecState* exec_state, const RowBatch& rb) {
+  // Run any still-buffered values through the UDAs before emitting.
+  for (auto& kv : state_->groups) {
+    PL_RETURN_IF_ERROR(FlushGroup(exec_state, &kv.second));
+  }
+
+  // Windows that fell out of the query's time range are dropped.
+  if (saw_rows_) {
+    for (auto it = state_->groups.begin(); it != state_->groups.end();) {
+      if (it->second.bucket < min_bucket_seen_) {
+        it = state_->groups.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  RowBatch output_rb(*output_descriptor_, state_->groups.size());
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> group_builders;
+  for (const auto& group_dt : group_data_types_) {
+    group_builders.push_back(types::MakeArrowBuilder(group_dt, exec_state->exec_mem_pool()));
+  }
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> value_builders;
+  for (const auto& value_data_type : value_data_types_) {
+    value_builders.push_back(types::MakeArrowBuilder(value_data_type, exec_state->exec_mem_pool()));
+  }
+
+  GroupKeyDecoder decoder(&group_data_types_);
+  for (const auto& [key, group] : state_->groups) {
+    decoder.Reset(key);
+    for (size_t i = 0; i < group_data_types_.size(); ++i) {
+#define TYPE_CASE(_dt_) AppendKeyToBuilder<_dt_>(group_builders[i].get(), decoder, i);
+      PL_SWITCH_FOREACH_DATATYPE(group_data_types_[i], TYPE_CASE);
+#undef TYPE_CASE
+    }
+    // Finalize through a fresh instance merged with the cached one, so the cached UDA
+    // state stays valid for the next execution.
+    for (size_t i = 0; i < group.udas.size(); ++i) {
+      const auto& uda_info = group.udas[i];
+      auto fresh = uda_info.def->Make();
+      std::vector<std::shared_ptr<types::BaseValueType>> init_args;
+      for (const auto& arg : plan_node_->values()[i]->init_arguments()) {
+        init_args.push_back(arg.ToBaseValueType());
+      }
+      PL_RETURN_IF_ERROR(uda_info.def->ExecInit(fresh.get(), nullptr, init_args));
+      PL_RETURN_IF_ERROR(uda_info.def->Merge(fresh.get(), uda_info.uda.get(), nullptr));
+      PL_RETURN_IF_ERROR(
+          uda_info.def->FinalizeArrow(fresh.get(), function_ctx_.get(), value_builders[i].get()));
+    }
+  }
+
+  for (const auto& group_builder : group_builders) {
+    std::shared_ptr<arrow::Array> arr;
+    PL_RETURN_IF_ERROR(group_builder->Finish(&arr));
+    PL_RETURN_IF_ERROR(output_rb.AddColumn(arr));
+  }
+  for (const auto& value_builder : value_builders) {
+    std::shared_ptr<arrow::Array> arr;
+    PL_RETURN_IF_ERROR(value_builder->Finish(&arr));
+    PL_RETURN_IF_ERROR(output_rb.AddColumn(arr));
+  }
+
+  output_rb.set_eow(rb.eow());
+  output_rb.set_eos(rb.eos());
+  PL_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
+
+  if (saw_rows_) {
+    // The newest bucket is still accumulating; the next execution re-reads all of its
+    // rows, so its state must not be cached. Everything older is closed.
+    for (auto it = state_->groups.begin(); it != state_->groups.end();) {
+      if (it->second.bucket >= max_bucket_seen_) {
+        it = state_->groups.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    state_->closed_cursor = std::max(state_->closed_cursor, max_bucket_seen_ - 1);
+  }
+  return Status::OK();
+}
+
+std::string WindowAggNode::BuildStateKey() const {
+  std::vector<std::string> parts;
+  parts.push_back(absl::Substitute("op=$0", plan_node_->id()));
+  for (const auto& group : plan_node_->groups()) {
+    parts.push_back(absl::Substitute("g=$0", group.idx));
+  }
+  for (const auto& value : plan_node_->values()) {
+    std::vector<std::string> init_strs;
+    for (const auto& arg : value->init_arguments()) {
+      init_strs.push_back(arg.DebugString());
+    }
+    parts.push_back(absl::Substitute("v=$0:$1[$2]", value->uda_id(), value->DebugString(),
+                                     absl::StrJoin(init_strs, ",")));
+  }
+  for (const auto& dt : input_descriptor_->types()) {
+    parts.push_back(absl::Substitute("in=$0", static_cast<int>(dt)));
+  }
+  return absl::StrJoin(parts, ";");
+}
+
+StatusOr<types::DataType> WindowAggNode::GetTypeOfDep(const plan::ScalarExpression& expr) const {
+  // Agg exprs can only be of type col, or const.
+  switch (expr.ExpressionType()) {
+    case plan::Expression::kColumn: {
+      auto idx = static_cast<const plan::Column*>(&expr)->Index();
+      return input_descriptor_->type(idx);
+    }
+    case plan::Expression::kConstant:
+      return static_cast<const plan::ScalarValue*>(&expr)->DataType();
+    default:
+      return error::InvalidArgument("Invalid expression type in window agg: $0",
+                                    magic_enum::enum_name(expr.ExpressionType()));
+  }
+}
+
+Status WindowAggNode::CreateColumnMapping() {
+  for (const auto& expr : plan_node_->values()) {
+    plan::ExpressionWalker<int> walker;
+
+    walker.OnScalarValue(
+        [&](const plan::ScalarValue&, const std::vector<int>&) -> int { return 0; });
+
+    walker.OnColumn([&](const plan::Column& col, const std::vector<int>&) -> int {
+      auto plan_col_idx = col.Index();
+      if (plan_cols_to_stored_map_.find(plan_col_idx) == plan_cols_to_stored_map_.end()) {
+        // We aren't currently capturing this col, so add it to the list of cols to store.
+        plan_cols_to_stored_map_[plan_col_idx] = stored_cols_to_plan_idx_.size();
+        stored_cols_to_plan_idx_.emplace_back(plan_col_idx);
+        stored_cols_data_types_.emplace_back(input_descriptor_->type(plan_col_idx));
+      }
+      return 0;
+    });
+
+    walker.OnAggregateExpression(
+        [&](const plan::AggregateExpression&, const std::vector<int>&) -> int { return 0; });
+
+    PL_RETURN_IF_ERROR(walker.Walk(*expr));
+  }
+  return Status::OK();
+}
+
+Status WindowAggNode::CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_state) {
+  CHECK(val != nullptr);
+  CHECK_EQ(val->size(), 0ULL);
+
+  for (const auto& value : plan_node_->values()) {
+    std::vector<types::DataType> types;
+    types.reserve(value->Deps().size());
+    for (auto* dep : value->Deps()) {
+      PL_ASSIGN_OR_RETURN(auto type, GetTypeOfDep(*dep));
+      types.push_back(type);
+    }
+    auto def = exec_state->GetUDADefinition(value->uda_id());
+    auto uda = def->Make();
+
+    std::vector<std::shared_ptr<types::BaseValueType>> init_args;
+    for (const auto& arg : value->init_arguments()) {
+      init_args.push_back(arg.ToBaseValueType());
+    }
+    // We currently don't use FunctionContext in UDAs so continuing that tradition here, but at
+    // some point we probably want to change this.
+    PL_RETURN_IF_ERROR(def->ExecInit(uda.get(), nullptr, init_args));
+    val->emplace_back(std::move(uda), def);
+  }
+  return Status::OK();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
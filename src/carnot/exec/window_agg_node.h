@@ -0,0 +1,173 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#include <arrow/array.h>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <absl/container/node_hash_map.h>
+
+#include "src/carnot/exec/agg_node.h"
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/row_tuple.h"
+#include "src/carnot/plan/operators.h"
+#include "src/carnot/udf/udf_definition.h"
+#include "src/common/base/base.h"
+#include "src/common/memory/memory.h"
+#include "src/shared/types/column_wrapper.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/table_store.h"
+
+DECLARE_bool(enable_incremental_window_agg);
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * WindowAggNode is a streaming variant of AggNode for standing queries.
+ *
+ * Standing (repeatedly executed) PxL scripts aggregate over a sliding time window whose
+ * buckets are produced by grouping on a binned time column. Consecutive executions see
+ * mostly the same rows: all but the newest bucket were already aggregated by the previous
+ * run. This node keeps the per-group UDA state in a process-wide cache keyed by a
+ * fingerprint of the plan node, so each execution only updates UDAs for rows in buckets
+ * newer than the cached cursor and merges the cached state into the emitted result.
+ *
+ * Requirements (checked at Init): the aggregate is windowed, has at least one group, and
+ * the first group column is the window bucket (TIME64NS or INT64, e.g. px.bin(time_, w)).
+ * Buckets strictly older than the newest bucket seen in a run are considered closed; the
+ * newest bucket is still accumulating, so its state is recomputed from scratch on every
+ * run. Like the eow-based windowed aggregate, this assumes data arrives in roughly
+ * bucket order.
+ *
+ * Output is emitted at eos only: one row per window bucket and group combination covered
+ * by the query's time range. Cached UDAs are never finalized directly; results are
+ * produced by merging them into a fresh instance (UDA Merge machinery), so the cached
+ * state stays valid for the next execution.
+ */
+class WindowAggNode : public ProcessingNode {
+ public:
+  WindowAggNode() = default;
+  virtual ~WindowAggNode() = default;
+
+  /**
+   * Returns true if the plan node has the shape this node can aggregate incrementally.
+   * The bucket column type is checked at Init, where the input descriptor is available.
+   */
+  static bool CanIncrementallyAggregate(const plan::AggregateOperator& plan_node) {
+    return plan_node.windowed() && !plan_node.groups().empty();
+  }
+
+  // Per-group cached aggregate state. agg_cols buffer the UDA input values between
+  // flushes and are always empty when an execution finishes.
+  struct CachedGroup {
+    int64_t bucket = 0;
+    std::vector<UDAInfo> udas;
+    std::vector<types::SharedColumnWrapper> agg_cols;
+  };
+
+  // The cached state for one standing query. The mutex serializes executions that map to
+  // the same fingerprint; group value pointers must stay stable across inserts, hence the
+  // node_hash_map.
+  struct QueryState {
+    std::mutex mu;
+    absl::node_hash_map<std::string, CachedGroup> groups;
+    // All rows in buckets <= closed_cursor have been aggregated into `groups`.
+    int64_t closed_cursor = std::numeric_limits<int64_t>::min();
+    std::chrono::steady_clock::time_point last_used;
+  };
+
+  /**
+   * Process-wide cache of window aggregate state, keyed by plan-node fingerprint.
+   * Entries unused past the TTL are swept on access.
+   */
+  class StateCache {
+   public:
+    static StateCache* GetInstance();
+    std::shared_ptr<QueryState> GetOrCreate(const std::string& key);
+
+   private:
+    std::mutex lock_;
+    absl::node_hash_map<std::string, std::shared_ptr<QueryState>> states_;
+  };
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  Status CreateColumnMapping();
+  Status ExtractRowTupleForBatch(const table_store::schema::RowBatch& rb);
+  int64_t BucketValue(arrow::Array* arr, int64_t row_idx) const;
+  Status InitCachedGroup(ExecState* exec_state, int64_t bucket, CachedGroup* group);
+  Status CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_state);
+  StatusOr<types::DataType> GetTypeOfDep(const plan::ScalarExpression& expr) const;
+  // Runs the buffered agg_cols values through the group's UDAs and clears the buffers.
+  Status FlushGroup(ExecState* exec_state, CachedGroup* group);
+  Status EmitAndAdvance(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+
+  // Fingerprint of the plan node used as the state cache key.
+  std::string BuildStateKey() const;
+
+  std::unique_ptr<plan::AggregateOperator> plan_node_;
+  std::unique_ptr<table_store::schema::RowDescriptor> input_descriptor_;
+  std::unique_ptr<udf::FunctionContext> function_ctx_;
+
+  std::vector<types::DataType> group_data_types_;
+  std::vector<types::DataType> value_data_types_;
+  types::DataType bucket_data_type_ = types::DATA_TYPE_UNKNOWN;
+
+  // Mapping from plan columns referenced by agg expressions to buffered column slots
+  // (same scheme as AggNode).
+  std::map<int64_t, int64_t> plan_cols_to_stored_map_;
+  std::vector<int64_t> stored_cols_to_plan_idx_;
+  std::vector<types::DataType> stored_cols_data_types_;
+
+  // Shared (or detached, if another execution holds the lock) cached state.
+  std::shared_ptr<QueryState> state_;
+
+  // Per-batch scratch, reused across batches.
+  ObjectPool row_tuples_pool_{"window_agg_row_tuples_pool"};
+  std::vector<RowTuple*> row_tuples_chunk_;
+  std::vector<CachedGroup*> row_groups_;
+  std::string scratch_key_;
+
+  // Bucket range seen in this execution (over all rows, including skipped ones).
+  bool saw_rows_ = false;
+  int64_t min_bucket_seen_ = std::numeric_limits<int64_t>::max();
+  int64_t max_bucket_seen_ = std::numeric_limits<int64_t>::min();
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
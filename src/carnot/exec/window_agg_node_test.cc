@@ -0,0 +1,285 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/window_agg_node.h"
+
+#include <algorithm>
+
+#include <google/protobuf/text_format.h>
+#include <gtest/gtest.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowDescriptor;
+using types::Int64Value;
+
+// Takes the min of two arguments and sums them, mirroring the test UDA in agg_node_test.
+class MinSumUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value arg1, types::Int64Value arg2) {
+    sum_ = sum_.val + std::min(arg1.val, arg2.val);
+  }
+  void Merge(udf::FunctionContext*, const MinSumUDA& other) { sum_ = sum_.val + other.sum_.val; }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+
+ protected:
+  types::Int64Value sum_ = 0;
+};
+
+// Windowed aggregate where the first group (col 0) is the window bucket.
+constexpr char kWindowedBucketGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: true
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 2
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "window"
+  value_names: "value1"
+})";
+
+constexpr char kBlockingBucketGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 2
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "window"
+  value_names: "value1"
+})";
+
+std::unique_ptr<ExecState> MakeTestExecState(udf::Registry* registry) {
+  auto table_store = std::make_shared<table_store::TableStore>();
+  return std::make_unique<ExecState>(registry, table_store, MockResultSinkStubGenerator,
+                                     MockMetricsStubGenerator, MockTraceStubGenerator,
+                                     sole::uuid4(), nullptr);
+}
+
+// Each test uses a unique plan node id so state cached by one test is invisible to the
+// others (the cache key includes the plan node id).
+std::unique_ptr<plan::Operator> PlanNodeFromPbtxt(const std::string& pbtxt, int64_t id) {
+  planpb::Operator op_pb;
+  EXPECT_TRUE(google::protobuf::TextFormat::MergeFromString(pbtxt, &op_pb));
+  return plan::AggregateOperator::FromProto(op_pb, id);
+}
+
+class WindowAggNodeTest : public ::testing::Test {
+ public:
+  WindowAggNodeTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test");
+    EXPECT_TRUE(func_registry_->Register<MinSumUDA>("minsum").ok());
+
+    exec_state_ = MakeTestExecState(func_registry_.get());
+    EXPECT_OK(exec_state_->AddUDA(0, "minsum",
+                                  std::vector<types::DataType>({types::INT64, types::INT64})));
+  }
+
+ protected:
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+TEST_F(WindowAggNodeTest, can_incrementally_aggregate) {
+  auto windowed = PlanNodeFromPbtxt(kWindowedBucketGroupAgg, 100);
+  auto blocking = PlanNodeFromPbtxt(kBlockingBucketGroupAgg, 101);
+  EXPECT_TRUE(WindowAggNode::CanIncrementallyAggregate(
+      *static_cast<plan::AggregateOperator*>(windowed.get())));
+  EXPECT_FALSE(WindowAggNode::CanIncrementallyAggregate(
+      *static_cast<plan::AggregateOperator*>(blocking.get())));
+}
+
+TEST_F(WindowAggNodeTest, incremental_across_executions) {
+  auto plan_node = PlanNodeFromPbtxt(kWindowedBucketGroupAgg, 110);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  // First execution: buckets 1 and 2.
+  {
+    auto tester = exec::ExecNodeTester<WindowAggNode, plan::AggregateOperator>(
+        *plan_node, output_rd, {input_rd}, exec_state_.get());
+    tester
+        .ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ true, /*eos*/ true)
+                         .AddColumn<types::Int64Value>({1, 1, 2})
+                         .AddColumn<types::Int64Value>({1, 3, 2})
+                         .AddColumn<types::Int64Value>({2, 1, 5})
+                         .get(),
+                     0)
+        .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                            .AddColumn<types::Int64Value>({1, 2})
+                            .AddColumn<types::Int64Value>({2, 2})
+                            .get(),
+                        false)
+        .Close();
+  }
+
+  // Second execution re-reads the overlapping window plus new data. Bucket 1 is closed:
+  // its rows carry poisoned values, so the result only stays 2 if the cached state is
+  // used and the rows are skipped. Bucket 2 (open during the first run) is recomputed,
+  // and bucket 3 is new.
+  {
+    auto tester = exec::ExecNodeTester<WindowAggNode, plan::AggregateOperator>(
+        *plan_node, output_rd, {input_rd}, exec_state_.get());
+    tester
+        .ConsumeNext(RowBatchBuilder(input_rd, 5, /*eow*/ true, /*eos*/ true)
+                         .AddColumn<types::Int64Value>({1, 1, 2, 2, 3})
+                         .AddColumn<types::Int64Value>({100, 100, 2, 4, 7})
+                         .AddColumn<types::Int64Value>({100, 100, 5, 4, 8})
+                         .get(),
+                     0)
+        .ExpectRowBatch(RowBatchBuilder(output_rd, 3, true, true)
+                            .AddColumn<types::Int64Value>({1, 2, 3})
+                            .AddColumn<types::Int64Value>({2, 6, 7})
+                            .get(),
+                        false)
+        .Close();
+  }
+
+  // Third execution: the window has slid past bucket 1, so its cached state is dropped.
+  // Bucket 2 is now closed (cached value 6 used, poisoned rows skipped).
+  {
+    auto tester = exec::ExecNodeTester<WindowAggNode, plan::AggregateOperator>(
+        *plan_node, output_rd, {input_rd}, exec_state_.get());
+    tester
+        .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                         .AddColumn<types::Int64Value>({2, 3, 3, 4})
+                         .AddColumn<types::Int64Value>({100, 7, 1, 5})
+                         .AddColumn<types::Int64Value>({100, 8, 1, 9})
+                         .get(),
+                     0)
+        .ExpectRowBatch(RowBatchBuilder(output_rd, 3, true, true)
+                            .AddColumn<types::Int64Value>({2, 3, 4})
+                            .AddColumn<types::Int64Value>({6, 8, 5})
+                            .get(),
+                        false)
+        .Close();
+  }
+}
+
+TEST_F(WindowAggNodeTest, multiple_batches) {
+  auto plan_node = PlanNodeFromPbtxt(kWindowedBucketGroupAgg, 120);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<WindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 1})
+                       .AddColumn<types::Int64Value>({1, 2})
+                       .AddColumn<types::Int64Value>({3, 2})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Int64Value>({1, 2})
+                       .AddColumn<types::Int64Value>({4, 6})
+                       .AddColumn<types::Int64Value>({5, 7})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::Int64Value>({1, 2})
+                          .AddColumn<types::Int64Value>({7, 6})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(WindowAggNodeTest, concurrent_execution_uses_detached_state) {
+  auto plan_node = PlanNodeFromPbtxt(kWindowedBucketGroupAgg, 130);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  // The first tester holds the state lock for the whole execution, so the second one
+  // must fall back to private state and still compute correct (from-scratch) results.
+  auto tester1 = exec::ExecNodeTester<WindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  auto tester2 = exec::ExecNodeTester<WindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester2
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Int64Value>({1, 2})
+                       .AddColumn<types::Int64Value>({1, 2})
+                       .AddColumn<types::Int64Value>({2, 3})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::Int64Value>({1, 2})
+                          .AddColumn<types::Int64Value>({1, 2})
+                          .get(),
+                      false)
+      .Close();
+  tester1
+      .ConsumeNext(RowBatchBuilder(input_rd, 1, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Int64Value>({1})
+                       .AddColumn<types::Int64Value>({5})
+                       .AddColumn<types::Int64Value>({6})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({1})
+                          .AddColumn<types::Int64Value>({5})
+                          .get(),
+                      false)
+      .Close();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
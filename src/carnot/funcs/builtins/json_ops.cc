@@ -32,6 +32,32 @@ void RegisterJSONOpsOrDie(udf::Registry* registry) {
   registry->RegisterOrDie<PluckAsFloat64UDF>("pluck_float64");
   registry->RegisterOrDie<PluckArrayUDF>("pluck_array");
 
+  // Up to 8 keys are supported for the pluck_multi UDF, due to the lack of support for
+  // variadic UDF arguments in the UDF registry today (see _script_reference below).
+  // 1 key
+  registry->RegisterOrDie<PluckMultiUDF<StringValue>>("pluck_multi");
+  // 2 keys
+  registry->RegisterOrDie<PluckMultiUDF<StringValue, StringValue>>("pluck_multi");
+  // 3 keys
+  registry->RegisterOrDie<PluckMultiUDF<StringValue, StringValue, StringValue>>("pluck_multi");
+  // 4 keys
+  registry->RegisterOrDie<PluckMultiUDF<StringValue, StringValue, StringValue, StringValue>>(
+      "pluck_multi");
+  // 5 keys
+  registry->RegisterOrDie<
+      PluckMultiUDF<StringValue, StringValue, StringValue, StringValue, StringValue>>(
+      "pluck_multi");
+  // 6 keys
+  registry->RegisterOrDie<PluckMultiUDF<StringValue, StringValue, StringValue, StringValue,
+                                        StringValue, StringValue>>("pluck_multi");
+  // 7 keys
+  registry->RegisterOrDie<PluckMultiUDF<StringValue, StringValue, StringValue, StringValue,
+                                        StringValue, StringValue, StringValue>>("pluck_multi");
+  // 8 keys
+  registry->RegisterOrDie<PluckMultiUDF<StringValue, StringValue, StringValue, StringValue,
+                                        StringValue, StringValue, StringValue, StringValue>>(
+      "pluck_multi");
+
   // Up to 8 script args are supported for the _script_reference UDF, due to the lack of support for
   // variadic UDF arguments in the UDF registry today. We should clean this up if/when variadic UDF
   // arguments are supported, which will probably be done as a part of adding support for object
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include <rapidjson/document.h>
+#include <rapidjson/pointer.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -33,15 +34,39 @@ namespace px {
 namespace carnot {
 namespace builtins {
 
+// Resolves a projection path within a parsed document. Plain keys index top-level object
+// members; paths starting with '/' are interpreted as JSON Pointers (e.g. '/a/b/0') for
+// nested access. Returns nullptr when the path does not resolve.
+inline const rapidjson::Value* ResolveJSONPath(const rapidjson::Document& d,
+                                               const std::string& path) {
+  if (!path.empty() && path[0] == '/') {
+    rapidjson::Pointer ptr(path.data(), path.size());
+    if (!ptr.IsValid()) {
+      return nullptr;
+    }
+    return ptr.Get(d);
+  }
+  if (!d.IsObject()) {
+    return nullptr;
+  }
+  auto it = d.FindMember(path.data());
+  if (it == d.MemberEnd()) {
+    return nullptr;
+  }
+  return &it->value;
+}
+
 // TODO(zasgar): PL-419 To have proper support for JSON we need structs and nullable types.
 // Revisit when we have them.
+// The pluck UDFs parse in situ: Exec owns its copy of the input, so the DOM can point string
+// values into the input buffer instead of copying them out during the parse.
 class PluckUDF : public udf::ScalarUDF {
  public:
   StringValue Exec(FunctionContext*, StringValue in, StringValue key) {
     rapidjson::Document d;
-    rapidjson::ParseResult ok = d.Parse(in.data());
+    d.ParseInsitu(in.data());
     // TODO(zasgar/michellenguyen, PP-419): Replace with null when available.
-    if (ok == nullptr) {
+    if (d.HasParseError()) {
       return "";
     }
     if (!d.IsObject()) {
@@ -88,9 +113,9 @@ class PluckAsInt64UDF : public udf::ScalarUDF {
  public:
   Int64Value Exec(FunctionContext*, StringValue in, StringValue key) {
     rapidjson::Document d;
-    rapidjson::ParseResult ok = d.Parse(in.data());
+    d.ParseInsitu(in.data());
     // TODO(zasgar/michellenguyen, PP-419): Replace with null when available.
-    if (ok == nullptr) {
+    if (d.HasParseError()) {
       return 0;
     }
     if (!d.IsObject()) {
@@ -132,9 +157,9 @@ class PluckAsFloat64UDF : public udf::ScalarUDF {
  public:
   Float64Value Exec(FunctionContext*, StringValue in, StringValue key) {
     rapidjson::Document d;
-    rapidjson::ParseResult ok = d.Parse(in.data());
+    d.ParseInsitu(in.data());
     // TODO(zasgar/michellenguyen, PP-419): Replace with null when available.
-    if (ok == nullptr) {
+    if (d.HasParseError()) {
       return 0.0;
     }
     if (!d.IsObject()) {
@@ -179,9 +204,9 @@ class PluckArrayUDF : public udf::ScalarUDF {
  public:
   StringValue Exec(FunctionContext*, StringValue in, Int64Value index) {
     rapidjson::Document d;
-    rapidjson::ParseResult ok = d.Parse(in.data());
+    d.ParseInsitu(in.data());
     // TODO(zasgar/michellenguyen, PP-419): Replace with null when available.
-    if (ok == nullptr) {
+    if (d.HasParseError()) {
       return "";
     }
     if (!d.IsArray()) {
@@ -228,6 +253,52 @@ class PluckArrayUDF : public udf::ScalarUDF {
   }
 };
 
+/**
+  DocString intentionally omitted: the doc builder requires a fixed argument list, and this
+  UDF is registered at multiple arities.
+
+  PluckMultiUDF projects several keys out of a JSON string in a single parse. Each px.pluck
+  call re-parses its input, so extracting N keys from the same body costs N parses of the
+  full body; this UDF parses once and returns a JSON object mapping each requested key to
+  its value, which individual values can then be plucked from cheaply.
+
+  Keys starting with '/' are interpreted as JSON Pointer paths (e.g. '/a/b/0') for nested
+  access; other keys index top-level members. Keys that don't resolve map to empty strings.
+ */
+template <typename... T>
+class PluckMultiUDF : public udf::ScalarUDF {
+ public:
+  StringValue Exec(FunctionContext*, StringValue in, T... keys) {
+    return ExecImpl(&in, {std::forward<T>(keys)...});
+  }
+
+ private:
+  StringValue ExecImpl(StringValue* in, std::initializer_list<StringValue> keys) {
+    rapidjson::Document d;
+    d.ParseInsitu(in->data());
+    // TODO(zasgar/michellenguyen, PP-419): Replace with null when available.
+    if (d.HasParseError()) {
+      return "";
+    }
+
+    rapidjson::StringBuffer sb;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(sb);
+    writer.StartObject();
+    for (const auto& key : keys) {
+      writer.Key(key.c_str());
+      const rapidjson::Value* plucked_value = ResolveJSONPath(d, key);
+      if (plucked_value == nullptr || plucked_value->IsNull()) {
+        writer.String("");
+        continue;
+      }
+      // This is robust to nested JSON.
+      plucked_value->Accept(writer);
+    }
+    writer.EndObject();
+    return sb.GetString();
+  }
+};
+
 /**
   DocString intentionally omitted, this is a non-public function.
   This function creates a custom deep link by creating a "script reference" from a label,
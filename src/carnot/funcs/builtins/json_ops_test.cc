@@ -111,6 +111,32 @@ TEST(JSONOps, PluckArrayUDF_index_out_of_bound) {
   udf_tester.ForInput(kTestJSONArray, 3).Expect("");
 }
 
+TEST(JSONOps, PluckMultiUDF) {
+  auto udf_tester = udf::UDFTester<PluckMultiUDF<StringValue, StringValue>>();
+  udf_tester.ForInput(kTestJSONStr, "int64_key", "str_plain")
+      .Expect(R"({"int64_key":34243242341,"str_plain":"abc"})");
+  // Nested values stay serialized JSON, like px.pluck.
+  udf_tester.ForInput(kTestJSONStr, "str_key", "float64_key")
+      .Expect(R"({"str_key":{"abc":"def"},"float64_key":123423.5234})");
+}
+
+TEST(JSONOps, PluckMultiUDF_json_pointer_paths) {
+  auto udf_tester = udf::UDFTester<PluckMultiUDF<StringValue, StringValue>>();
+  udf_tester.ForInput(kTestJSONStr, "/str_key/abc", "int64_key")
+      .Expect(R"({"/str_key/abc":"def","int64_key":34243242341})");
+}
+
+TEST(JSONOps, PluckMultiUDF_non_existent_key_maps_to_empty) {
+  auto udf_tester = udf::UDFTester<PluckMultiUDF<StringValue, StringValue>>();
+  udf_tester.ForInput(kTestJSONStr, "blah", "/str_key/blah")
+      .Expect(R"({"blah":"","/str_key/blah":""})");
+}
+
+TEST(JSONOps, PluckMultiUDF_bad_input_return_empty) {
+  auto udf_tester = udf::UDFTester<PluckMultiUDF<StringValue>>();
+  udf_tester.ForInput("asdad", "str_key").Expect("");
+}
+
 TEST(JSONOps, ScriptReferenceUDF_no_args) {
   auto udf_tester = udf::UDFTester<ScriptReferenceUDF<>>();
   auto res = udf_tester.ForInput("text", "px/script").Result();
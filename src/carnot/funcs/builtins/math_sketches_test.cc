@@ -18,10 +18,13 @@
 
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
+#include <vector>
 
 #include "src/carnot/funcs/builtins/math_sketches.h"
 #include "src/carnot/udf/test_utils.h"
 #include "src/common/base/base.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
 
 namespace px {
 namespace carnot {
@@ -69,6 +72,74 @@ TEST(MathSketches, quantiles_int64) {
   EXPECT_DOUBLE_EQ(d["p99"].GetDouble(), 6);
 }
 
+TEST(MathSketches, ddsketch_quantiles_int64) {
+  auto uda_tester = udf::UDATester<DDSketchQuantilesUDA<types::Int64Value>>();
+  for (int64_t i = 1; i <= 1000; ++i) {
+    uda_tester.ForInput(i);
+  }
+  auto res = uda_tester.Result();
+
+  rapidjson::Document d;
+  d.Parse(res.data());
+  // The sketch guarantees ~2% relative accuracy on the integer fast path.
+  EXPECT_NEAR(d["p50"].GetDouble(), 500, 500 * 0.025);
+  EXPECT_NEAR(d["p90"].GetDouble(), 900, 900 * 0.025);
+  EXPECT_NEAR(d["p99"].GetDouble(), 990, 990 * 0.025);
+}
+
+TEST(MathSketches, ddsketch_quantiles_float64) {
+  auto uda_tester = udf::UDATester<DDSketchQuantilesUDA<types::Float64Value>>();
+  for (int64_t i = 1; i <= 1000; ++i) {
+    uda_tester.ForInput(static_cast<double>(i) / 10.0);
+  }
+  auto res = uda_tester.Result();
+
+  rapidjson::Document d;
+  d.Parse(res.data());
+  EXPECT_NEAR(d["p50"].GetDouble(), 50.0, 50.0 * 0.015);
+  EXPECT_NEAR(d["p99"].GetDouble(), 99.0, 99.0 * 0.015);
+}
+
+TEST(MathSketches, ddsketch_quantiles_merge) {
+  DDSketchQuantilesUDA<types::Int64Value> uda1;
+  DDSketchQuantilesUDA<types::Int64Value> uda2;
+  DDSketchQuantilesUDA<types::Int64Value> expected;
+  for (int64_t i = 1; i <= 1000; ++i) {
+    (i % 2 == 0 ? uda1 : uda2).Update(nullptr, i);
+    expected.Update(nullptr, i);
+  }
+  uda1.Merge(nullptr, uda2);
+  // Merging bucket counts is lossless, so the merged sketch finalizes identically to one
+  // that saw all the inputs.
+  EXPECT_EQ(std::string(expected.Finalize(nullptr)), std::string(uda1.Finalize(nullptr)));
+}
+
+TEST(MathSketches, ddsketch_quantiles_serialize_round_trip) {
+  DDSketchQuantilesUDA<types::Int64Value> uda;
+  for (int64_t i = 1; i <= 100; ++i) {
+    uda.Update(nullptr, i);
+  }
+  DDSketchQuantilesUDA<types::Int64Value> other;
+  EXPECT_OK(other.Deserialize(nullptr, uda.Serialize(nullptr)));
+  EXPECT_EQ(std::string(uda.Finalize(nullptr)), std::string(other.Finalize(nullptr)));
+
+  EXPECT_NOT_OK(other.Deserialize(nullptr, "bad"));
+}
+
+TEST(MathSketches, ddsketch_quantiles_batch_arrow) {
+  std::vector<types::Int64Value> in;
+  DDSketchQuantilesUDA<types::Int64Value> row_at_a_time;
+  for (int64_t i = 1; i <= 1000; ++i) {
+    in.emplace_back(i);
+    row_at_a_time.Update(nullptr, i);
+  }
+  auto in_arrow = types::ToArrow(in, arrow::default_memory_pool());
+
+  DDSketchQuantilesUDA<types::Int64Value> batch;
+  EXPECT_OK(batch.UpdateBatchArrow(nullptr, {in_arrow.get()}, in.size()));
+  EXPECT_EQ(std::string(row_at_a_time.Finalize(nullptr)), std::string(batch.Finalize(nullptr)));
+}
+
 }  // namespace builtins
 }  // namespace carnot
 }  // namespace px
@@ -334,6 +334,18 @@ Status RedactPIIUDF::Init(FunctionContext*) {
   taggers_.push_back(std::make_unique<RegexTagger<Tag::Type::IMEISV>>());
   taggers_.push_back(std::make_unique<RegexTagger<Tag::Type::CC_NUMBER>>());
   taggers_.push_back(std::make_unique<RegexTagger<Tag::Type::SSN>>());
+
+  // Compile every tagger pattern into one set so Exec can scan each body once to find which
+  // taggers can possibly match. Index i in the set corresponds to taggers_[i].
+  re2::RE2::Options opts;
+  opts.set_log_errors(false);
+  pattern_set_ = std::make_unique<re2::RE2::Set>(opts, RE2::UNANCHORED);
+  for (const auto& tagger : taggers_) {
+    if (pattern_set_->Add(tagger->pattern(), nullptr) < 0) {
+      return Status::OK();
+    }
+  }
+  pattern_set_ok_ = pattern_set_->Compile();
   return Status::OK();
 }
 
@@ -394,6 +406,22 @@ static inline std::string ReplaceTagsWithSubs(std::string input, std::vector<Tag
 
 StringValue RedactPIIUDF::Exec(FunctionContext*, StringValue input) {
   std::vector<Tag> tags;
+  if (pattern_set_ok_) {
+    // One pass over the body tells us which taggers can possibly match; the rest are
+    // skipped. Bodies without any PII candidates return without scanning per tagger.
+    matched_.clear();
+    if (!pattern_set_->Match(input, &matched_)) {
+      return input;
+    }
+    std::sort(matched_.begin(), matched_.end());
+    for (int idx : matched_) {
+      auto s = taggers_[idx]->AddTags(&input, &tags);
+      if (!s.ok()) {
+        return "Invalid regex: " + s.msg();
+      }
+    }
+    return ReplaceTagsWithSubs(input, &tags);
+  }
   for (const auto& tagger : taggers_) {
     auto s = tagger->AddTags(&input, &tags);
     if (!s.ok()) {
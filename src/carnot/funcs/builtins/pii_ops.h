@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "re2/re2.h"
+#include "re2/set.h"
 #include "src/carnot/udf/registry.h"
 #include "src/common/base/utils.h"
 #include "src/shared/types/types.h"
@@ -70,6 +71,9 @@ class Tagger {
  public:
   virtual ~Tagger() = default;
   virtual Status AddTags(std::string* input, std::vector<Tag>* tags) = 0;
+  // The regex pattern this tagger scans for, so it can also be compiled into the combined
+  // prefilter set.
+  virtual std::string_view pattern() const = 0;
 };
 
 class RedactPIIUDF : public udf::ScalarUDF {
@@ -93,6 +97,14 @@ class RedactPIIUDF : public udf::ScalarUDF {
   }
 
  private:
+  // All tagger patterns compiled into a single RE2::Set. Each body is scanned once against
+  // the set to find which taggers can possibly match; taggers the set rules out are skipped,
+  // so bodies without PII (the common case at ingest) cost one pass instead of one scan per
+  // tagger. When the set fails to compile, every tagger runs, as before.
+  std::unique_ptr<re2::RE2::Set> pattern_set_;
+  bool pattern_set_ok_ = false;
+  // Scratch buffer for the matching pattern indices, reused across rows.
+  std::vector<int> matched_;
   std::vector<std::unique_ptr<Tagger>> taggers_;
 };
 
@@ -132,6 +144,8 @@ class RegexTagger : public Tagger {
     return Status::OK();
   }
 
+  std::string_view pattern() const override { return TagTypeTraits<TTag>::BuildRegexPattern(); }
+
  private:
   re2::RE2 regex_;
 };
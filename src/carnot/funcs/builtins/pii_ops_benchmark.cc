@@ -53,6 +53,32 @@ static void BM_RedactPII(benchmark::State& state) {
 
 BENCHMARK(BM_RedactPII)->RangeMultiplier(2)->Range(1, 12);
 
+static constexpr std::string_view no_pii_chunk = R"input(
+        {"level": "info", "msg": "handled request", "path": "/api/v1/healthz",
+         "method": "GET", "handler": "healthz", "cluster": "prod"}
+)input";
+
+// Most bodies at ingest contain no PII; this measures the combined-set prefilter pass that
+// lets such bodies skip the per-tagger scans entirely.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_RedactPII_NoPII(benchmark::State& state) {
+  RedactPIIUDF udf;
+  PL_UNUSED(udf.Init(nullptr));
+
+  std::string text_chunk(no_pii_chunk);
+  std::string text;
+  for (int i = 0; i < state.range(0); i++) {
+    text += text_chunk;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(udf.Exec(nullptr, text));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(text.length()) *
+                          static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(BM_RedactPII_NoPII)->RangeMultiplier(2)->Range(1, 12);
+
 }  // namespace builtins
 }  // namespace carnot
 }  // namespace px
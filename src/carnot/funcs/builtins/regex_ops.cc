@@ -17,6 +17,9 @@
  */
 
 #include "src/carnot/funcs/builtins/regex_ops.h"
+
+#include <absl/strings/str_cat.h>
+
 #include "src/carnot/udf/registry.h"
 #include "src/common/base/base.h"
 
@@ -24,6 +27,53 @@ namespace px {
 namespace carnot {
 namespace builtins {
 
+RegexPatternCache* RegexPatternCache::GetInstance() {
+  static RegexPatternCache cache;
+  return &cache;
+}
+
+std::shared_ptr<const re2::RE2> RegexPatternCache::GetOrCompile(const std::string& pattern,
+                                                                const re2::RE2::Options& opts) {
+  // The regex builtins only vary dot_nl between them, so it is the only option folded into
+  // the key.
+  std::string key = absl::StrCat(opts.dot_nl() ? "d:" : "-:", pattern);
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->regex;
+    }
+  }
+  // Compile outside the lock; RE2 compilation can be slow for large patterns. If two threads
+  // race on the same miss, the second insert below just refreshes the entry.
+  auto regex = std::make_shared<const re2::RE2>(pattern, opts);
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->regex;
+  }
+  lru_.push_front(CacheEntry{std::move(key), regex});
+  entries_[lru_.front().key] = lru_.begin();
+  if (entries_.size() > kMaxCachedPatterns) {
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+  return regex;
+}
+
+void RegexPatternCache::Clear() {
+  std::lock_guard<std::mutex> lock(mu_);
+  entries_.clear();
+  lru_.clear();
+}
+
+size_t RegexPatternCache::size() {
+  std::lock_guard<std::mutex> lock(mu_);
+  return entries_.size();
+}
+
 void RegisterRegexOpsOrDie(udf::Registry* registry) {
   CHECK(registry != nullptr);
   /*****************************************
@@ -33,6 +83,7 @@ void RegisterRegexOpsOrDie(udf::Registry* registry) {
   registry->RegisterOrDie<RegexMatchUDF>("regex_match");
   registry->RegisterOrDie<RegexReplaceUDF>("replace");
   registry->RegisterOrDie<MatchRegexRule>("_match_regex_rule");
+  registry->RegisterOrDie<MatchRegexRuleSet>("_match_regex_rule_set");
   /*****************************************
    * Aggregate UDFs.
    *****************************************/
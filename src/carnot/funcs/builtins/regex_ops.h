@@ -23,12 +23,18 @@
 #include <absl/strings/strip.h>
 
 #include <algorithm>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <string>
 #include <utility>
 #include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
 #include "re2/re2.h"
+#include "re2/set.h"
 #include "src/carnot/udf/registry.h"
 #include "src/common/base/utils.h"
 #include "src/shared/types/types.h"
@@ -37,13 +43,51 @@ namespace px {
 namespace carnot {
 namespace builtins {
 
+/**
+ * RegexPatternCache is a process-wide LRU cache of compiled RE2 patterns. UDFs are
+ * instantiated per expression per batch, so scripts that apply the same pattern across many
+ * batches (or the same pattern in many expressions) would otherwise recompile it each time;
+ * compilation dominates Init cost for non-trivial patterns. Compiled RE2 objects are
+ * immutable and safe to share across threads, so entries are handed out as shared_ptrs.
+ */
+class RegexPatternCache {
+ public:
+  static RegexPatternCache* GetInstance();
+
+  /**
+   * Returns the compiled RE2 for the pattern, compiling and caching it on a miss. Invalid
+   * patterns are cached as well (as RE2 objects carrying their error), so repeated Inits
+   * with a bad pattern don't recompile either.
+   */
+  std::shared_ptr<const re2::RE2> GetOrCompile(const std::string& pattern,
+                                               const re2::RE2::Options& opts);
+
+  void Clear();
+  size_t size();
+
+ private:
+  // Scripts use a handful of distinct patterns each; this comfortably covers every standing
+  // script on a cluster while bounding memory for adversarial one-off queries.
+  static constexpr size_t kMaxCachedPatterns = 1024;
+
+  struct CacheEntry {
+    std::string key;
+    std::shared_ptr<const re2::RE2> regex;
+  };
+
+  std::mutex mu_;
+  // Most recently used entries at the front; lookups splice their entry back to the front.
+  std::list<CacheEntry> lru_;
+  absl::flat_hash_map<std::string, std::list<CacheEntry>::iterator> entries_;
+};
+
 class RegexMatchUDF : public udf::ScalarUDF {
  public:
   Status Init(FunctionContext*, StringValue regex) {
     re2::RE2::Options opts;
     opts.set_dot_nl(true);
     opts.set_log_errors(false);
-    regex_ = std::make_unique<re2::RE2>(regex, opts);
+    regex_ = RegexPatternCache::GetInstance()->GetOrCompile(regex, opts);
     return Status::OK();
   }
   BoolValue Exec(FunctionContext*, StringValue input) {
@@ -69,7 +113,7 @@ class RegexMatchUDF : public udf::ScalarUDF {
   }
 
  private:
-  std::unique_ptr<re2::RE2> regex_;
+  std::shared_ptr<const re2::RE2> regex_;
 };
 
 class RegexReplaceUDF : public udf::ScalarUDF {
@@ -77,7 +121,7 @@ class RegexReplaceUDF : public udf::ScalarUDF {
   Status Init(FunctionContext*, StringValue regex_pattern) {
     re2::RE2::Options opts;
     opts.set_log_errors(false);
-    regex_ = std::make_unique<re2::RE2>(regex_pattern, opts);
+    regex_ = RegexPatternCache::GetInstance()->GetOrCompile(regex_pattern, opts);
     return Status::OK();
   }
   StringValue Exec(FunctionContext*, StringValue input, StringValue sub) {
@@ -114,7 +158,7 @@ class RegexReplaceUDF : public udf::ScalarUDF {
   }
 
  private:
-  std::unique_ptr<re2::RE2> regex_;
+  std::shared_ptr<const re2::RE2> regex_;
 };
 
 class MatchRegexRule : public udf::ScalarUDF {
@@ -174,6 +218,80 @@ class MatchRegexRule : public udf::ScalarUDF {
   std::vector<std::pair<std::string, RegexMatchUDF> > regex_rules;
 };
 
+class MatchRegexRuleSet : public udf::ScalarUDF {
+ public:
+  Status Init(FunctionContext*, StringValue encodedRegexRules) {
+    // Parse encodedRegexRules as json.
+    rapidjson::Document regex_rules_json;
+    rapidjson::ParseResult parse_result = regex_rules_json.Parse(encodedRegexRules.data());
+    if (!parse_result) {
+      return Status(statuspb::Code::INVALID_ARGUMENT, "unable to parse string as json");
+    }
+    re2::RE2::Options opts;
+    opts.set_dot_nl(true);
+    opts.set_log_errors(false);
+    // Anchor both ends so each rule keeps the full-match semantics of px.regex_match.
+    set_ = std::make_unique<re2::RE2::Set>(opts, re2::RE2::ANCHOR_BOTH);
+    for (rapidjson::Value::ConstMemberIterator itr = regex_rules_json.MemberBegin();
+         itr != regex_rules_json.MemberEnd(); ++itr) {
+      std::string name = itr->name.GetString();
+      std::string regex_pattern = itr->value.GetString();
+      // _match_regex_rule treats an invalid pattern as never matching; dropping it from the
+      // set preserves that. Add returns consecutive indices, so rule_names_ stays aligned.
+      if (set_->Add(regex_pattern, nullptr) < 0) {
+        continue;
+      }
+      rule_names_.push_back(std::move(name));
+    }
+    compiled_ = set_->Compile();
+    return Status::OK();
+  }
+
+  StringValue Exec(FunctionContext*, StringValue value) {
+    if (!compiled_) {
+      return "";
+    }
+    matched_.clear();
+    if (!set_->Match(value, &matched_)) {
+      return "";
+    }
+    // Match reports every matching rule; return the first in rule order to mirror
+    // _match_regex_rule.
+    return rule_names_[*std::min_element(matched_.begin(), matched_.end())];
+  }
+
+  static udf::ScalarUDFDocBuilder Doc() {
+    return udf::ScalarUDFDocBuilder(
+               "Check for a match to a json of regex pattern rules in a string, scanning the "
+               "string once for all rules.")
+        .Details(
+            "This function checks the input string (second arg) for a match with the regex "
+            "pattern rules (first arg). "
+            "Each regex pattern must match the full string. "
+            "All the rules are compiled into a single RE2::Set, so the input is scanned once "
+            "regardless of the number of rules; prefer this over _match_regex_rule when "
+            "classifying against many rules. "
+            "We support google RE2 syntax. More details on that syntax can be found "
+            "[here](https://github.com/google/re2/wiki/Syntax). ")
+        .Example(
+            "df.rule = px._match_regex_rule_set('{\"rule1\": \".*my_regex_pattern.*\"}', "
+            "df.resp_body)")
+        .Arg("arg1",
+             "The encoded json map from the name of the rule to the regex pattern for the rule.")
+        .Arg("arg2", "The string column to match the pattern against.")
+        .Returns(
+            "string representing the name of the first rule that matched or an empty string if no "
+            "match.");
+  }
+
+ private:
+  std::unique_ptr<re2::RE2::Set> set_;
+  std::vector<std::string> rule_names_;
+  // Scratch buffer for the matching rule indices, reused across rows.
+  std::vector<int> matched_;
+  bool compiled_ = false;
+};
+
 void RegisterRegexOpsOrDie(udf::Registry* registry);
 
 }  // namespace builtins
@@ -81,6 +81,35 @@ TEST(RegexOps, invalid_regex_replace) {
           "a digit or '\\'.");
 }
 
+TEST(RegexOps, pattern_cache) {
+  auto* cache = RegexPatternCache::GetInstance();
+  cache->Clear();
+
+  re2::RE2::Options opts;
+  opts.set_dot_nl(true);
+  opts.set_log_errors(false);
+  auto first = cache->GetOrCompile("abcd.*", opts);
+  auto second = cache->GetOrCompile("abcd.*", opts);
+  // A hit hands back the already-compiled object.
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(1, cache->size());
+
+  // The same pattern with different options is a distinct entry.
+  re2::RE2::Options no_dot_nl_opts;
+  no_dot_nl_opts.set_log_errors(false);
+  auto third = cache->GetOrCompile("abcd.*", no_dot_nl_opts);
+  EXPECT_NE(first.get(), third.get());
+  EXPECT_EQ(2, cache->size());
+
+  // Invalid patterns are cached too, carrying their error.
+  auto invalid = cache->GetOrCompile(R"regex(\K)regex", opts);
+  EXPECT_NE(RE2::NoError, invalid->error_code());
+  EXPECT_EQ(invalid.get(), cache->GetOrCompile(R"regex(\K)regex", opts).get());
+
+  cache->Clear();
+  EXPECT_EQ(0, cache->size());
+}
+
 TEST(RegexOps, regex_match_rules) {
   auto udf_tester = udf::UDFTester<MatchRegexRule>();
   // Value matches regex rule.
@@ -96,6 +125,30 @@ TEST(RegexOps, regex_match_rules) {
   EXPECT_NOT_OK(MatchRegexRule().Init(nullptr, "(?i).*onpointerenter.*"));
 }
 
+TEST(RegexOps, regex_match_rule_set) {
+  auto udf_tester = udf::UDFTester<MatchRegexRuleSet>();
+  // Value matches regex rule.
+  udf_tester.Init("{\"onpointerenter_event\":\"(?i).*onpointerenter.*\"}")
+      .ForInput(
+          "UPDATE courses SET name = '<a/+/OnpOinteRENtER+=+a=prompt,a()%0dx>v3dm0s ' WHERE id = 2")
+      .Expect("onpointerenter_event");
+  // Value does not match any regex rule.
+  udf_tester.Init("{\"onpointerenter_event\":\"(?i).*onpointerenter.*\"}")
+      .ForInput("UPDATE courses SET name = 'foo' WHERE id = 2")
+      .Expect("");
+  // The first matching rule in rule order wins, even when later rules also match.
+  udf_tester.Init("{\"digits\":\"[0-9]+\",\"anything\":\".*\"}")
+      .ForInput("1234")
+      .Expect("digits");
+  udf_tester.Init("{\"digits\":\"[0-9]+\",\"anything\":\".*\"}").ForInput("abcd").Expect("anything");
+  // Patterns must match the full string, mirroring px.regex_match.
+  udf_tester.Init("{\"abc\":\"abc\"}").ForInput("abcd").Expect("");
+  // An invalid pattern never matches; the remaining rules still apply.
+  udf_tester.Init(R"json({"bad":"\\K","digits":"[0-9]+"})json").ForInput("1234").Expect("digits");
+  // Regex rules is not a valid json.
+  EXPECT_NOT_OK(MatchRegexRuleSet().Init(nullptr, "(?i).*onpointerenter.*"));
+}
+
 }  // namespace builtins
 }  // namespace carnot
 }  // namespace px
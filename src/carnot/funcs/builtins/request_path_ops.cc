@@ -34,6 +34,7 @@ void RegisterRequestPathOpsOrDie(udf::Registry* registry) {
    *****************************************/
   registry->RegisterOrDie<RequestPathClusteringPredictUDF>("_predict_request_path_cluster");
   registry->RegisterOrDie<RequestPathEndpointMatcherUDF>("_match_endpoint");
+  registry->RegisterOrDie<EndpointAnalysisUDF>("_endpoint_analysis");
   /*****************************************
    * Aggregate UDFs.
    *****************************************/
@@ -90,6 +90,33 @@ TEST(RequestPathClusteringPredict, basic_low_cardinality) {
   udf_tester.ForInput("/a/b/c", serialized_clustering).Expect("/a/b/c");
 }
 
+TEST(EndpointAnalysis, basic) {
+  auto uda_tester = udf::UDATester<RequestPathClusteringFitUDA>();
+  auto serialized_clustering = uda_tester.ForInput("/a/b/c")
+                                   .ForInput("/a/b/d")
+                                   .ForInput("a/b/a")
+                                   .ForInput("/a/b/b")
+                                   .ForInput("/a/b/e")
+                                   .ForInput("a/b/f")
+                                   .Result();
+  auto udf_tester = udf::UDFTester<EndpointAnalysisUDF>();
+  udf_tester.ForInput("/a/b/c?k=v&k2=v2", serialized_clustering)
+      .Expect(R"({"path":"/a/b/c","endpoint":"/a/b/*","params":{"k":"v","k2":"v2"}})");
+  udf_tester.ForInput("/a/b/c", serialized_clustering)
+      .Expect(R"({"path":"/a/b/c","endpoint":"/a/b/*","params":{}})");
+  udf_tester.ForInput("/a/b/c?flag", serialized_clustering)
+      .Expect(R"({"path":"/a/b/c","endpoint":"/a/b/*","params":{"flag":""}})");
+}
+
+TEST(EndpointAnalysis, basic_low_cardinality) {
+  auto uda_tester = udf::UDATester<RequestPathClusteringFitUDA>();
+  auto serialized_clustering = uda_tester.ForInput("/a/b/d").ForInput("/a/b/c").Result();
+
+  auto udf_tester = udf::UDFTester<EndpointAnalysisUDF>();
+  udf_tester.ForInput("/a/b/c?k=v", serialized_clustering)
+      .Expect(R"({"path":"/a/b/c","endpoint":"/a/b/c","params":{"k":"v"}})");
+}
+
 TEST(RequestPathEndpointMatcher, basic) {
   auto udf_tester = udf::UDFTester<RequestPathEndpointMatcherUDF>();
   udf_tester.ForInput("/a/b/c", "/a/b/*").Expect(true);
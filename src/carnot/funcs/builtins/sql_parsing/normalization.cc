@@ -23,6 +23,7 @@
 #include "pgsql_parser/PostgresSQLLexer.h"
 #include "pgsql_parser/PostgresSQLParser.h"
 #include "src/carnot/funcs/builtins/sql_parsing/normalization.h"
+#include "src/carnot/funcs/builtins/sql_parsing/normalization_cache.h"
 #include "src/common/base/logging.h"
 #include "src/common/base/statusor.h"
 
@@ -126,14 +127,28 @@ void SQLFragmentHandler::ReplaceFragmentWithPlaceholder(const SQLFragment& fragm
 
 StatusOr<NormalizeResult> normalize_pgsql(std::string sql,
                                           const std::vector<std::string>& param_values) {
-  return normalize_sql<pgsql_parser::PostgresSQLParser, pgsql_parser::PostgresSQLLexer>(
+  auto key = NormalizationCache::CacheKey("pgsql", sql, param_values);
+  StatusOr<NormalizeResult> result;
+  if (NormalizationCache::GetInstance()->Lookup(key, &result)) {
+    return result;
+  }
+  result = normalize_sql<pgsql_parser::PostgresSQLParser, pgsql_parser::PostgresSQLLexer>(
       sql, param_values);
+  NormalizationCache::GetInstance()->Insert(key, result);
+  return result;
 }
 
 StatusOr<NormalizeResult> normalize_mysql(std::string sql,
                                           const std::vector<std::string>& param_values) {
-  return normalize_sql<mysql_parser::MySQLParser, mysql_parser::MySQLLexer, UpperCaseCharStream>(
+  auto key = NormalizationCache::CacheKey("mysql", sql, param_values);
+  StatusOr<NormalizeResult> result;
+  if (NormalizationCache::GetInstance()->Lookup(key, &result)) {
+    return result;
+  }
+  result = normalize_sql<mysql_parser::MySQLParser, mysql_parser::MySQLLexer, UpperCaseCharStream>(
       sql, param_values);
+  NormalizationCache::GetInstance()->Insert(key, result);
+  return result;
 }
 
 std::ostream& operator<<(std::ostream& os, const NormalizeResult& result) {
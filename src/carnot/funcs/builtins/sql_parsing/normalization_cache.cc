@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/funcs/builtins/sql_parsing/normalization_cache.h"
+
+#include <absl/strings/str_cat.h>
+
+namespace px {
+namespace carnot {
+namespace builtins {
+namespace sql_parsing {
+
+NormalizationCache* NormalizationCache::GetInstance() {
+  static NormalizationCache cache;
+  return &cache;
+}
+
+std::string NormalizationCache::CacheKey(std::string_view dialect, std::string_view sql,
+                                         const std::vector<std::string>& param_values) {
+  std::string key;
+  absl::StrAppend(&key, dialect, ";", sql.size(), ":", sql);
+  for (const auto& param : param_values) {
+    absl::StrAppend(&key, ",", param.size(), ":", param);
+  }
+  return key;
+}
+
+bool NormalizationCache::Lookup(const std::string& key, StatusOr<NormalizeResult>* result) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  *result = it->second->result;
+  return true;
+}
+
+void NormalizationCache::Insert(const std::string& key, const StatusOr<NormalizeResult>& result) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    it->second->result = result;
+    return;
+  }
+  lru_.push_front(CacheEntry{key, result});
+  entries_[key] = lru_.begin();
+  if (entries_.size() > kMaxCachedQueries) {
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+}
+
+void NormalizationCache::Clear() {
+  std::lock_guard<std::mutex> lock(mu_);
+  entries_.clear();
+  lru_.clear();
+}
+
+size_t NormalizationCache::size() {
+  std::lock_guard<std::mutex> lock(mu_);
+  return entries_.size();
+}
+
+}  // namespace sql_parsing
+}  // namespace builtins
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/carnot/funcs/builtins/sql_parsing/normalization.h"
+
+namespace px {
+namespace carnot {
+namespace builtins {
+namespace sql_parsing {
+
+/**
+ * NormalizationCache is a process-wide LRU cache of SQL normalization results, keyed by the
+ * dialect, raw query text, and parameter values. Production workloads have a small set of
+ * distinct statements repeated millions of times, and the antlr parse dominates
+ * normalization cost; a hit skips the parser entirely. Normalization is deterministic in the
+ * key, so failed parses are cached too — a statement the parser rejects once will be
+ * rejected every time.
+ */
+class NormalizationCache {
+ public:
+  static NormalizationCache* GetInstance();
+
+  /**
+   * Builds the cache key for a normalization request. Every component is length-prefixed so
+   * distinct inputs can't concatenate to the same key.
+   */
+  static std::string CacheKey(std::string_view dialect, std::string_view sql,
+                              const std::vector<std::string>& param_values);
+
+  /**
+   * Returns true and fills *result on a hit.
+   */
+  bool Lookup(const std::string& key, StatusOr<NormalizeResult>* result);
+
+  /**
+   * Stores the result under the key, evicting the least recently used entry when the cache
+   * is full.
+   */
+  void Insert(const std::string& key, const StatusOr<NormalizeResult>& result);
+
+  void Clear();
+  size_t size();
+
+ private:
+  // Distinct statement shapes per cluster number in the low thousands; past that the oldest
+  // entries are one-off statements not worth keeping.
+  static constexpr size_t kMaxCachedQueries = 4096;
+
+  struct CacheEntry {
+    std::string key;
+    StatusOr<NormalizeResult> result;
+  };
+
+  std::mutex mu_;
+  // Most recently used entries at the front; lookups splice their entry back to the front.
+  std::list<CacheEntry> lru_;
+  absl::flat_hash_map<std::string, std::list<CacheEntry>::iterator> entries_;
+};
+
+}  // namespace sql_parsing
+}  // namespace builtins
+}  // namespace carnot
+}  // namespace px
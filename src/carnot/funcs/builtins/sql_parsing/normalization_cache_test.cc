@@ -0,0 +1,93 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "src/carnot/funcs/builtins/sql_parsing/normalization_cache.h"
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace builtins {
+namespace sql_parsing {
+
+class NormalizationCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override { NormalizationCache::GetInstance()->Clear(); }
+  void TearDown() override { NormalizationCache::GetInstance()->Clear(); }
+};
+
+TEST_F(NormalizationCacheTest, cache_key_is_unambiguous) {
+  // Length prefixes keep boundary shifts between components from colliding.
+  EXPECT_NE(NormalizationCache::CacheKey("mysql", "ab", {"c"}),
+            NormalizationCache::CacheKey("mysql", "a", {"bc"}));
+  EXPECT_NE(NormalizationCache::CacheKey("mysql", "a", {"b", "c"}),
+            NormalizationCache::CacheKey("mysql", "a", {"bc"}));
+  EXPECT_NE(NormalizationCache::CacheKey("mysql", "a", {}),
+            NormalizationCache::CacheKey("pgsql", "a", {}));
+}
+
+TEST_F(NormalizationCacheTest, lookup_and_insert) {
+  auto* cache = NormalizationCache::GetInstance();
+  auto key = NormalizationCache::CacheKey("mysql", "SELECT 1", {});
+
+  StatusOr<NormalizeResult> result;
+  EXPECT_FALSE(cache->Lookup(key, &result));
+
+  NormalizeResult to_cache;
+  to_cache.normalized_query = "SELECT ?";
+  to_cache.params = {"1"};
+  cache->Insert(key, to_cache);
+  EXPECT_EQ(1, cache->size());
+
+  ASSERT_TRUE(cache->Lookup(key, &result));
+  ASSERT_OK(result);
+  EXPECT_EQ("SELECT ?", result.ValueOrDie().normalized_query);
+  EXPECT_EQ(std::vector<std::string>{"1"}, result.ValueOrDie().params);
+}
+
+TEST_F(NormalizationCacheTest, caches_errors) {
+  auto* cache = NormalizationCache::GetInstance();
+  auto key = NormalizationCache::CacheKey("mysql", "not sql at all", {});
+  cache->Insert(key, error::InvalidArgument("parse error"));
+
+  StatusOr<NormalizeResult> result;
+  ASSERT_TRUE(cache->Lookup(key, &result));
+  EXPECT_NOT_OK(result);
+}
+
+TEST_F(NormalizationCacheTest, normalize_mysql_hits_cache) {
+  auto* cache = NormalizationCache::GetInstance();
+  auto first = normalize_mysql("SELECT name FROM users WHERE id=3", {});
+  EXPECT_EQ(1, cache->size());
+  auto second = normalize_mysql("SELECT name FROM users WHERE id=3", {});
+  EXPECT_EQ(1, cache->size());
+
+  ASSERT_OK(first);
+  ASSERT_OK(second);
+  EXPECT_EQ(first.ValueOrDie().normalized_query, second.ValueOrDie().normalized_query);
+  EXPECT_EQ(first.ValueOrDie().params, second.ValueOrDie().params);
+}
+
+}  // namespace sql_parsing
+}  // namespace builtins
+}  // namespace carnot
+}  // namespace px
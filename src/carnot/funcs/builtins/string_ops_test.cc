@@ -35,18 +35,72 @@ TEST(StringOps, basic_string_contains_test) {
   udf_tester.ForInput("apple", "z").Expect(false);
 }
 
+TEST(StringOps, string_contains_arrow_batch_test) {
+  std::vector<types::StringValue> in = {"apple", "banana", "grape"};
+  std::vector<types::StringValue> substrs = {"pl", "pl", "ape"};
+  auto in_arrow = types::ToArrow(in, arrow::default_memory_pool());
+  auto substrs_arrow = types::ToArrow(substrs, arrow::default_memory_pool());
+
+  arrow::BooleanBuilder builder;
+  ContainsUDF udf;
+  EXPECT_OK(udf.ExecBatchArrow(nullptr, {in_arrow.get(), substrs_arrow.get()}, &builder,
+                               in.size()));
+
+  std::shared_ptr<arrow::Array> res;
+  EXPECT_TRUE(builder.Finish(&res).ok());
+  auto* res_arr = static_cast<arrow::BooleanArray*>(res.get());
+  EXPECT_EQ(true, res_arr->Value(0));
+  EXPECT_EQ(false, res_arr->Value(1));
+  EXPECT_EQ(true, res_arr->Value(2));
+}
+
 TEST(StringOps, basic_string_length_test) {
   auto udf_tester = udf::UDFTester<LengthUDF>();
   udf_tester.ForInput("").Expect(0);
   udf_tester.ForInput("apple").Expect(5);
 }
 
+TEST(StringOps, string_length_arrow_batch_test) {
+  std::vector<types::StringValue> in = {"", "apple", "px"};
+  auto in_arrow = types::ToArrow(in, arrow::default_memory_pool());
+
+  arrow::Int64Builder builder;
+  LengthUDF udf;
+  EXPECT_OK(udf.ExecBatchArrow(nullptr, {in_arrow.get()}, &builder, in.size()));
+
+  std::shared_ptr<arrow::Array> res;
+  EXPECT_TRUE(builder.Finish(&res).ok());
+  auto* res_arr = static_cast<arrow::Int64Array*>(res.get());
+  EXPECT_EQ(0, res_arr->Value(0));
+  EXPECT_EQ(5, res_arr->Value(1));
+  EXPECT_EQ(2, res_arr->Value(2));
+}
+
 TEST(StringOps, basic_string_find_test) {
   auto udf_tester = udf::UDFTester<FindUDF>();
   udf_tester.ForInput("pixielabs", "xie").Expect(2);
   udf_tester.ForInput("pixielabs", "hello").Expect(-1);
 }
 
+TEST(StringOps, string_find_arrow_batch_test) {
+  std::vector<types::StringValue> in = {"pixielabs", "pixielabs", ""};
+  std::vector<types::StringValue> substrs = {"xie", "hello", "x"};
+  auto in_arrow = types::ToArrow(in, arrow::default_memory_pool());
+  auto substrs_arrow = types::ToArrow(substrs, arrow::default_memory_pool());
+
+  arrow::Int64Builder builder;
+  FindUDF udf;
+  EXPECT_OK(udf.ExecBatchArrow(nullptr, {in_arrow.get(), substrs_arrow.get()}, &builder,
+                               in.size()));
+
+  std::shared_ptr<arrow::Array> res;
+  EXPECT_TRUE(builder.Finish(&res).ok());
+  auto* res_arr = static_cast<arrow::Int64Array*>(res.get());
+  EXPECT_EQ(2, res_arr->Value(0));
+  EXPECT_EQ(-1, res_arr->Value(1));
+  EXPECT_EQ(-1, res_arr->Value(2));
+}
+
 TEST(StringOps, basic_string_substr_test) {
   auto udf_tester = udf::UDFTester<SubstringUDF>();
   udf_tester.ForInput("pixielabs", 3, 4).Expect("iela");
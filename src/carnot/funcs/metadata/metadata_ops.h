@@ -28,9 +28,12 @@
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "src/carnot/udf/registry.h"
 #include "src/carnot/udf/type_inference.h"
 #include "src/shared/metadata/metadata_state.h"
+#include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/types.h"
 
 namespace px {
@@ -63,6 +66,35 @@ inline const px::md::AgentMetadataState* GetMetadataState(px::carnot::udf::Funct
   return md;
 }
 
+// Per-batch memo table for UPID-keyed lookups.
+using UPIDMemo = absl::flat_hash_map<absl::uint128, std::string>;
+
+/**
+ * Batch-executes a UPID-keyed string lookup. Rows in a batch typically share a small number of
+ * distinct UPIDs, so each distinct UPID is resolved against the metadata state exactly once and
+ * the result is broadcast to all of its rows. The memo is cleared at the start of every batch;
+ * the metadata state is stable for the lifetime of the FunctionContext, so this is purely to
+ * keep the table's footprint bounded.
+ */
+template <typename TResolver>
+Status ExecBatchUPIDMemoized(const std::vector<arrow::Array*>& inputs,
+                             arrow::ArrayBuilder* output, int count, UPIDMemo* memo,
+                             TResolver&& resolve) {
+  auto* out = static_cast<arrow::StringBuilder*>(output);
+  PL_RETURN_IF_ERROR(out->Reserve(count));
+  memo->clear();
+  for (int i = 0; i < count; ++i) {
+    types::UInt128Value upid =
+        types::GetValueFromArrowArray<types::DataType::UINT128>(inputs[0], i);
+    auto [it, inserted] = memo->try_emplace(upid.val);
+    if (inserted) {
+      it->second = resolve(upid);
+    }
+    PL_RETURN_IF_ERROR(out->Append(it->second));
+  }
+  return Status::OK();
+}
+
 class ASIDUDF : public ScalarUDF {
  public:
   Int64Value Exec(FunctionContext* ctx) {
@@ -247,6 +279,14 @@ class UPIDToContainerIDUDF : public ScalarUDF {
     return pid->cid();
   }
 
+  // Batch mode: rows in a batch share a handful of distinct UPIDs, so each one is resolved
+  // against the metadata state once and the result broadcast (see ExecBatchUPIDMemoized).
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Kubernetes container ID from a UPID.")
         .Details(
@@ -261,17 +301,15 @@ class UPIDToContainerIDUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 inline const md::ContainerInfo* UPIDToContainer(const px::md::AgentMetadataState* md,
                                                 types::UInt128Value upid_value) {
   auto upid_uint128 = absl::MakeUint128(upid_value.High64(), upid_value.Low64());
-  auto upid = md::UPID(upid_uint128);
-  auto pid = md->GetPIDByUPID(upid);
-  if (pid == nullptr) {
-    return nullptr;
-  }
-  return md->k8s_metadata_state().ContainerInfoByID(pid->cid());
+  return md->ContainerInfoByUPID(md::UPID(upid_uint128));
 }
 
 class UPIDToContainerNameUDF : public ScalarUDF {
@@ -285,6 +323,13 @@ class UPIDToContainerNameUDF : public ScalarUDF {
     return std::string(container_info->name());
   }
 
+  // Batch mode: see ExecBatchUPIDMemoized.
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<UPIDToContainerNameUDF>(types::ST_CONTAINER_NAME,
                                                               {types::ST_NONE})};
@@ -304,16 +349,15 @@ class UPIDToContainerNameUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 inline const px::md::PodInfo* UPIDtoPod(const px::md::AgentMetadataState* md,
                                         types::UInt128Value upid_value) {
-  auto container_info = UPIDToContainer(md, upid_value);
-  if (container_info == nullptr) {
-    return nullptr;
-  }
-  auto pod_info = md->k8s_metadata_state().PodInfoByID(container_info->pod_id());
-  return pod_info;
+  auto upid_uint128 = absl::MakeUint128(upid_value.High64(), upid_value.Low64());
+  return md->PodInfoByUPID(md::UPID(upid_uint128));
 }
 
 // Stringifies a vector, including 0 and 1 element inputs.
@@ -350,6 +394,13 @@ class UPIDToNamespaceUDF : public ScalarUDF {
     return pod_info->ns();
   }
 
+  // Batch mode: see ExecBatchUPIDMemoized.
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<UPIDToNamespaceUDF>(types::ST_NAMESPACE_NAME, {types::ST_NONE})};
@@ -369,6 +420,9 @@ class UPIDToNamespaceUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 class UPIDToPodIDUDF : public ScalarUDF {
@@ -382,6 +436,13 @@ class UPIDToPodIDUDF : public ScalarUDF {
     return std::string(container_info->pod_id());
   }
 
+  // Batch mode: see ExecBatchUPIDMemoized.
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Kubernetes Pod ID from a UPID.")
         .Details(
@@ -396,6 +457,9 @@ class UPIDToPodIDUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 class UPIDToPodNameUDF : public ScalarUDF {
@@ -409,6 +473,13 @@ class UPIDToPodNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", pod_info->ns(), pod_info->name());
   }
 
+  // Batch mode: see ExecBatchUPIDMemoized.
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<UPIDToPodNameUDF>(types::ST_POD_NAME, {types::ST_NONE})};
   }
@@ -427,6 +498,9 @@ class UPIDToPodNameUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 class ServiceIDToServiceNameUDF : public ScalarUDF {
@@ -579,6 +653,13 @@ class UPIDToServiceIDUDF : public ScalarUDF {
     return StringifyVector(running_service_ids);
   }
 
+  // Batch mode: see ExecBatchUPIDMemoized.
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Service ID from a UPID.")
         .Details(
@@ -594,6 +675,9 @@ class UPIDToServiceIDUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 /**
@@ -620,6 +704,14 @@ class UPIDToServiceNameUDF : public ScalarUDF {
     }
     return StringifyVector(running_service_names);
   }
+
+  // Batch mode: see ExecBatchUPIDMemoized.
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<UPIDToServiceNameUDF>(types::ST_SERVICE_NAME, {types::ST_NONE})};
@@ -640,6 +732,9 @@ class UPIDToServiceNameUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 /**
@@ -656,6 +751,14 @@ class UPIDToNodeNameUDF : public ScalarUDF {
     std::string foo = std::string(pod_info->node_name());
     return foo;
   }
+
+  // Batch mode: see ExecBatchUPIDMemoized.
+  Status ExecBatchArrow(FunctionContext* ctx, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    return ExecBatchUPIDMemoized(inputs, output, count, &memo_,
+                                 [&](UInt128Value upid) { return Exec(ctx, upid); });
+  }
+
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<UPIDToNodeNameUDF>(types::ST_NODE_NAME, {types::ST_NONE})};
   }
@@ -672,6 +775,9 @@ class UPIDToNodeNameUDF : public ScalarUDF {
 
   // This UDF can currently only run on PEMs, because only PEMs have the UPID information.
   static udfspb::UDFSourceExecutor Executor() { return udfspb::UDFSourceExecutor::UDF_PEM; }
+
+ private:
+  UPIDMemo memo_;
 };
 
 /**
@@ -147,6 +147,25 @@ TEST_F(MetadataOpsTest, upid_to_pod_name_test) {
   udf_tester.ForInput(upid3).Expect("");
 }
 
+TEST_F(MetadataOpsTest, upid_to_pod_name_batch_test) {
+  auto function_ctx = std::make_unique<FunctionContext>(metadata_state_, nullptr);
+  UPIDToPodNameUDF udf;
+  // Repeated UPIDs exercise the memoized broadcast path.
+  std::vector<types::UInt128Value> upids = {
+      types::UInt128Value(528280977975, 89101), types::UInt128Value(528280977975, 468),
+      types::UInt128Value(528280977975, 89101), types::UInt128Value(528280977975, 123)};
+  auto upids_arrow = types::ToArrow(upids, arrow::default_memory_pool());
+  arrow::StringBuilder builder;
+  EXPECT_OK(udf.ExecBatchArrow(function_ctx.get(), {upids_arrow.get()}, &builder, upids.size()));
+  std::shared_ptr<arrow::Array> res;
+  EXPECT_TRUE(builder.Finish(&res).ok());
+  auto* res_arr = static_cast<arrow::StringArray*>(res.get());
+  EXPECT_EQ("pl/running_pod", res_arr->GetString(0));
+  EXPECT_EQ("pl/terminating_pod", res_arr->GetString(1));
+  EXPECT_EQ("pl/running_pod", res_arr->GetString(2));
+  EXPECT_EQ("", res_arr->GetString(3));
+}
+
 TEST_F(MetadataOpsTest, upid_to_namespace_test) {
   auto function_ctx = std::make_unique<FunctionContext>(metadata_state_, nullptr);
   auto udf_tester = px::carnot::udf::UDFTester<UPIDToNamespaceUDF>(std::move(function_ctx));
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#include <arpa/inet.h>
+
+#include <string_view>
+#include <vector>
+
+#include "src/common/base/inet_utils.h"
+
+namespace px {
+namespace carnot {
+namespace funcs {
+namespace net {
+
+/**
+ * Parses a dotted-quad IPv4 address (e.g. "10.32.0.1") without going through inet_pton.
+ * Returns false if the input is not a well-formed dotted-quad address; callers should then
+ * fall back to the general ParseIPAddress path (IPv6, etc.).
+ */
+inline bool FastParseIPv4(std::string_view addr_str, struct in_addr* in_addr) {
+  uint32_t addr = 0;
+  size_t pos = 0;
+  for (int octet = 0; octet < 4; ++octet) {
+    if (octet != 0) {
+      if (pos >= addr_str.size() || addr_str[pos] != '.') {
+        return false;
+      }
+      ++pos;
+    }
+    uint32_t val = 0;
+    size_t num_digits = 0;
+    while (pos < addr_str.size() && addr_str[pos] >= '0' && addr_str[pos] <= '9') {
+      val = val * 10 + (addr_str[pos] - '0');
+      ++pos;
+      ++num_digits;
+    }
+    if (num_digits == 0 || num_digits > 3 || val > 255) {
+      return false;
+    }
+    addr = (addr << 8) | val;
+  }
+  if (pos != addr_str.size()) {
+    return false;
+  }
+  in_addr->s_addr = htonl(addr);
+  return true;
+}
+
+/**
+ * A binary longest-prefix-match trie over a set of CIDR blocks, for membership queries.
+ *
+ * All addresses are mapped into IPv6 space on insert and lookup, so a single trie serves
+ * mixed IPv4/IPv6 CIDR sets. Build it once per CIDR set; each lookup then walks at most one
+ * bit per prefix bit instead of testing every CIDR linearly.
+ */
+class CIDRTrie {
+ public:
+  CIDRTrie() : nodes_(1) {}
+
+  void Insert(const CIDRBlock& cidr) {
+    CIDRBlock cidr6 = cidr.ip_addr.family == InetAddrFamily::kIPv4 ? MapIPv4ToIPv6(cidr) : cidr;
+    const auto& bytes = std::get<struct in6_addr>(cidr6.ip_addr.addr).s6_addr;
+    int32_t node = 0;
+    for (size_t i = 0; i < cidr6.prefix_length; ++i) {
+      if (nodes_[node].is_prefix_end) {
+        // An enclosing CIDR is already present; this one adds nothing.
+        return;
+      }
+      const int bit = (bytes[i / 8] >> (7 - (i % 8))) & 1;
+      if (nodes_[node].children[bit] < 0) {
+        nodes_[node].children[bit] = static_cast<int32_t>(nodes_.size());
+        nodes_.emplace_back();
+      }
+      node = nodes_[node].children[bit];
+    }
+    nodes_[node].is_prefix_end = true;
+  }
+
+  bool ContainsIP(const InetAddr& ip_addr) const {
+    InetAddr addr6 = ip_addr.family == InetAddrFamily::kIPv4 ? MapIPv4ToIPv6(ip_addr) : ip_addr;
+    if (addr6.family != InetAddrFamily::kIPv6) {
+      return false;
+    }
+    const auto& bytes = std::get<struct in6_addr>(addr6.addr).s6_addr;
+    int32_t node = 0;
+    for (size_t i = 0; i < 8 * sizeof(struct in6_addr); ++i) {
+      if (nodes_[node].is_prefix_end) {
+        return true;
+      }
+      const int bit = (bytes[i / 8] >> (7 - (i % 8))) & 1;
+      node = nodes_[node].children[bit];
+      if (node < 0) {
+        return false;
+      }
+    }
+    return nodes_[node].is_prefix_end;
+  }
+
+  bool ContainsIPString(std::string_view addr_str) const {
+    InetAddr addr = {};
+    struct in_addr addr4;
+    if (FastParseIPv4(addr_str, &addr4)) {
+      addr.family = InetAddrFamily::kIPv4;
+      addr.addr = addr4;
+    } else if (!ParseIPAddress(addr_str, &addr).ok()) {
+      return false;
+    }
+    return ContainsIP(addr);
+  }
+
+ private:
+  struct Node {
+    int32_t children[2] = {-1, -1};
+    bool is_prefix_end = false;
+  };
+  std::vector<Node> nodes_;
+};
+
+}  // namespace net
+}  // namespace funcs
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+
+#include "src/carnot/funcs/net/cidr_trie.h"
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace funcs {
+namespace net {
+
+namespace {
+CIDRBlock CIDR(std::string_view cidr_str) {
+  CIDRBlock cidr;
+  PL_CHECK_OK(ParseCIDRBlock(cidr_str, &cidr));
+  return cidr;
+}
+}  // namespace
+
+TEST(FastParseIPv4, valid) {
+  struct in_addr parsed;
+  struct in_addr expected;
+  for (const auto& addr_str : {"10.0.0.1", "0.0.0.0", "255.255.255.255", "192.168.101.7"}) {
+    ASSERT_TRUE(FastParseIPv4(addr_str, &parsed)) << addr_str;
+    ASSERT_EQ(1, inet_pton(AF_INET, addr_str, &expected));
+    EXPECT_EQ(expected.s_addr, parsed.s_addr) << addr_str;
+  }
+}
+
+TEST(FastParseIPv4, invalid) {
+  struct in_addr parsed;
+  for (const auto& addr_str : {"", "10.0.0", "10.0.0.1.2", "256.0.0.1", "10.0.0.1 ", "1.2.3.4a",
+                               "::1", "abcd", "10..0.1", "1000.0.0.1"}) {
+    EXPECT_FALSE(FastParseIPv4(addr_str, &parsed)) << addr_str;
+  }
+}
+
+TEST(CIDRTrie, ipv4_membership) {
+  CIDRTrie trie;
+  trie.Insert(CIDR("10.0.0.0/24"));
+  trie.Insert(CIDR("192.168.0.0/16"));
+
+  EXPECT_TRUE(trie.ContainsIPString("10.0.0.1"));
+  EXPECT_TRUE(trie.ContainsIPString("10.0.0.255"));
+  EXPECT_FALSE(trie.ContainsIPString("10.0.1.0"));
+  EXPECT_TRUE(trie.ContainsIPString("192.168.255.1"));
+  EXPECT_FALSE(trie.ContainsIPString("192.169.0.1"));
+  EXPECT_FALSE(trie.ContainsIPString("not-an-ip"));
+}
+
+TEST(CIDRTrie, nested_prefixes) {
+  CIDRTrie trie;
+  trie.Insert(CIDR("10.0.0.0/8"));
+  trie.Insert(CIDR("10.1.0.0/16"));
+
+  EXPECT_TRUE(trie.ContainsIPString("10.1.2.3"));
+  EXPECT_TRUE(trie.ContainsIPString("10.200.0.1"));
+  EXPECT_FALSE(trie.ContainsIPString("11.0.0.1"));
+}
+
+TEST(CIDRTrie, full_length_prefix) {
+  CIDRTrie trie;
+  trie.Insert(CIDR("10.0.0.1/32"));
+
+  EXPECT_TRUE(trie.ContainsIPString("10.0.0.1"));
+  EXPECT_FALSE(trie.ContainsIPString("10.0.0.2"));
+}
+
+TEST(CIDRTrie, ipv6_and_mixed) {
+  CIDRTrie trie;
+  trie.Insert(CIDR("fd00::/8"));
+  trie.Insert(CIDR("10.0.0.0/24"));
+
+  EXPECT_TRUE(trie.ContainsIPString("fd12:3456::1"));
+  EXPECT_FALSE(trie.ContainsIPString("fe80::1"));
+  EXPECT_TRUE(trie.ContainsIPString("10.0.0.7"));
+  // IPv4-mapped IPv6 form of an address inside the IPv4 CIDR.
+  EXPECT_TRUE(trie.ContainsIPString("::ffff:10.0.0.7"));
+}
+
+TEST(CIDRTrie, empty_trie) {
+  CIDRTrie trie;
+  EXPECT_FALSE(trie.ContainsIPString("10.0.0.1"));
+  EXPECT_FALSE(trie.ContainsIPString("::1"));
+}
+
+}  // namespace net
+}  // namespace funcs
+}  // namespace carnot
+}  // namespace px
@@ -27,6 +27,7 @@
 #include <utility>
 #include <vector>
 
+#include "src/carnot/funcs/net/cidr_trie.h"
 #include "src/carnot/funcs/net/dns.h"
 #include "src/carnot/udf/registry.h"
 #include "src/carnot/udf/type_inference.h"
@@ -60,10 +61,13 @@ class NSLookupUDF : public ScalarUDF {
 class CIDRsContainIPUDF : public ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, StringValue cidrs_str, StringValue ip_addr) {
-    // The expectation is that users will call this UDF with a constant cidrs_str, so cache to
-    // prevent unnecessary parsing.
+    // The expectation is that users will call this UDF with a constant cidrs_str, so the parsed
+    // CIDRs are loaded into an LPM trie once and reused across rows. Lookups then walk at most
+    // one trie level per prefix bit instead of testing every CIDR linearly.
     if (cidrs_str != parsed_cidr_str_) {
       parsed_cidr_str_ = cidrs_str;
+      cidr_trie_ = CIDRTrie();
+      cidrs_valid_ = false;
 
       rapidjson::Document doc;
       rapidjson::ParseResult ok = doc.Parse(cidrs_str.data());
@@ -73,30 +77,22 @@ class CIDRsContainIPUDF : public ScalarUDF {
       if (!doc.IsArray()) {
         return false;
       }
-      cidrs_.clear();
       for (rapidjson::Value::ConstValueIterator itr = doc.Begin(); itr != doc.End(); ++itr) {
         if (!itr->IsString()) {
           return false;
         }
-        cidrs_.emplace_back();
-        auto s = px::ParseCIDRBlock(itr->GetString(), &cidrs_.back());
-        if (!s.ok()) {
-          cidrs_.pop_back();
+        CIDRBlock cidr;
+        auto s = px::ParseCIDRBlock(itr->GetString(), &cidr);
+        if (s.ok()) {
+          cidr_trie_.Insert(cidr);
         }
       }
+      cidrs_valid_ = true;
     }
-
-    px::InetAddr addr = {};
-    auto s = px::ParseIPAddress(ip_addr, &addr);
-    if (!s.ok()) {
+    if (!cidrs_valid_) {
       return false;
     }
-    for (const auto& cidr : cidrs_) {
-      if (px::CIDRContainsIPAddr(cidr, addr)) {
-        return true;
-      }
-    }
-    return false;
+    return cidr_trie_.ContainsIPString(ip_addr);
   }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Determine whether an IP is contained in a set of CIDR ranges.")
@@ -116,7 +112,8 @@ class CIDRsContainIPUDF : public ScalarUDF {
 
  private:
   std::string parsed_cidr_str_ = "";
-  std::vector<px::CIDRBlock> cidrs_;
+  CIDRTrie cidr_trie_;
+  bool cidrs_valid_ = false;
 };
 
 void RegisterNetOpsOrDie(px::carnot::udf::Registry* registry);
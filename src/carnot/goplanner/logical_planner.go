@@ -94,6 +94,82 @@ func (cm GoPlanner) Plan(planState *distributedpb.LogicalPlannerState, queryRequ
 	return plan, nil
 }
 
+// SetState caches the full planner state inside the planner so later requests can use
+// UpdateState and PlanWithCachedState instead of resending the full state, which
+// dominates planning latency on large clusters.
+func (cm GoPlanner) SetState(planState *distributedpb.LogicalPlannerState) (*distributedpb.LogicalPlannerResult, error) {
+	var resultLen C.int
+	stateBytes, err := proto.Marshal(planState)
+	if err != nil {
+		return nil, err
+	}
+	stateData := C.CBytes(stateBytes)
+	defer C.free(stateData)
+
+	res := C.PlannerSetState(cm.planner, (*C.char)(stateData), C.int(len(stateBytes)), &resultLen)
+	defer C.StrFree(res)
+	resultBytes := C.GoBytes(unsafe.Pointer(res), resultLen)
+	if resultLen == 0 {
+		return nil, errors.New("no result returned")
+	}
+
+	result := &distributedpb.LogicalPlannerResult{}
+	if err := proto.Unmarshal(resultBytes, result); err != nil {
+		return result, fmt.Errorf("error: '%s'; string: '%s'", err, string(resultBytes))
+	}
+	return result, nil
+}
+
+// UpdateState applies a delta (agents and schemas added, replaced or removed) to the
+// planner state cached by SetState.
+func (cm GoPlanner) UpdateState(stateUpdate *distributedpb.LogicalPlannerStateUpdate) (*distributedpb.LogicalPlannerResult, error) {
+	var resultLen C.int
+	updateBytes, err := proto.Marshal(stateUpdate)
+	if err != nil {
+		return nil, err
+	}
+	updateData := C.CBytes(updateBytes)
+	defer C.free(updateData)
+
+	res := C.PlannerUpdateState(cm.planner, (*C.char)(updateData), C.int(len(updateBytes)), &resultLen)
+	defer C.StrFree(res)
+	resultBytes := C.GoBytes(unsafe.Pointer(res), resultLen)
+	if resultLen == 0 {
+		return nil, errors.New("no result returned")
+	}
+
+	result := &distributedpb.LogicalPlannerResult{}
+	if err := proto.Unmarshal(resultBytes, result); err != nil {
+		return result, fmt.Errorf("error: '%s'; string: '%s'", err, string(resultBytes))
+	}
+	return result, nil
+}
+
+// PlanWithCachedState plans the query against the state cached by SetState and any deltas
+// applied since, avoiding the full state round trip of Plan.
+func (cm GoPlanner) PlanWithCachedState(queryRequest *plannerpb.QueryRequest) (*distributedpb.LogicalPlannerResult, error) {
+	var resultLen C.int
+	queryRequestBytes, err := proto.Marshal(queryRequest)
+	if err != nil {
+		return nil, err
+	}
+	queryRequestData := C.CBytes(queryRequestBytes)
+	defer C.free(queryRequestData)
+
+	res := C.PlannerPlanWithCachedState(cm.planner, (*C.char)(queryRequestData), C.int(len(queryRequestBytes)), &resultLen)
+	defer C.StrFree(res)
+	lp := C.GoBytes(unsafe.Pointer(res), resultLen)
+	if resultLen == 0 {
+		return nil, errors.New("no result returned")
+	}
+
+	plan := &distributedpb.LogicalPlannerResult{}
+	if err := proto.Unmarshal(lp, plan); err != nil {
+		return plan, fmt.Errorf("error: '%s'; string: '%s'", err, string(lp))
+	}
+	return plan, nil
+}
+
 // CompileMutations compiles the query into a mutation of Pixie Data Table.
 func (cm GoPlanner) CompileMutations(planState *distributedpb.LogicalPlannerState, request *plannerpb.CompileMutationsRequest) (*plannerpb.CompileMutationsResponse, error) {
 	var resultLen C.int
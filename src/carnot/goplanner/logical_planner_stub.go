@@ -46,6 +46,23 @@ func (cm GoPlanner) Plan(planState *distributedpb.LogicalPlannerState, queryRequ
 	return nil, errorUnimplemented
 }
 
+// SetState caches the full planner state inside the planner so later requests can use
+// UpdateState and PlanWithCachedState instead of resending the full state.
+func (cm GoPlanner) SetState(planState *distributedpb.LogicalPlannerState) (*distributedpb.LogicalPlannerResult, error) {
+	return nil, errorUnimplemented
+}
+
+// UpdateState applies a delta to the planner state cached by SetState.
+func (cm GoPlanner) UpdateState(stateUpdate *distributedpb.LogicalPlannerStateUpdate) (*distributedpb.LogicalPlannerResult, error) {
+	return nil, errorUnimplemented
+}
+
+// PlanWithCachedState plans the query against the state cached by SetState and any deltas
+// applied since.
+func (cm GoPlanner) PlanWithCachedState(queryRequest *plannerpb.QueryRequest) (*distributedpb.LogicalPlannerResult, error) {
+	return nil, errorUnimplemented
+}
+
 // CompileMutations compiles the query into a mutation of Pixie Data Table.
 func (cm GoPlanner) CompileMutations(planState *distributedpb.LogicalPlannerState, request *plannerpb.CompileMutationsRequest) (*plannerpb.CompileMutationsResponse, error) {
 	return nil, errorUnimplemented
@@ -27,6 +27,7 @@ import (
 	"github.com/stretchr/testify/assert"
 	"github.com/stretchr/testify/require"
 
+	"px.dev/pixie/src/api/proto/uuidpb"
 	"px.dev/pixie/src/carnot/goplanner"
 	"px.dev/pixie/src/carnot/planner/compilerpb"
 	"px.dev/pixie/src/carnot/planner/distributedpb"
@@ -179,6 +180,64 @@ func TestPlanner_Simple(t *testing.T) {
 		[]uint64{kelvinGRPCSourceParentNode2.Id, kelvinGRPCSourceParentNode1.Id})
 }
 
+// TestPlanner_CachedState plans against a state cached inside the planner and applies a
+// delta between requests instead of resending the full state.
+func TestPlanner_CachedState(t *testing.T) {
+	var udfInfoPb udfspb.UDFInfo
+	b, err := funcs.Asset("src/vizier/funcs/data/udf.pb")
+	require.NoError(t, err)
+
+	err = proto.Unmarshal(b, &udfInfoPb)
+	require.NoError(t, err)
+
+	c, err := goplanner.New(&udfInfoPb)
+	require.NoError(t, err)
+	defer c.Free()
+
+	query := "import px\ndf = px.DataFrame(table='table1')\npx.display(df, 'out')"
+	queryRequestPB := &plannerpb.QueryRequest{
+		QueryStr: query,
+	}
+
+	// Planning before any state is cached must fail.
+	plannerResultPB, err := c.PlanWithCachedState(queryRequestPB)
+	require.NoError(t, err)
+	assert.NotEqual(t, plannerResultPB.Status.ErrCode, statuspb.OK)
+
+	plannerStatePB := new(distributedpb.LogicalPlannerState)
+	err = proto.UnmarshalText(plannerStatePBStr, plannerStatePB)
+	require.NoError(t, err)
+
+	setResultPB, err := c.SetState(plannerStatePB)
+	require.NoError(t, err)
+	assert.Equal(t, setResultPB.Status.ErrCode, statuspb.OK)
+
+	plannerResultPB, err = c.PlanWithCachedState(queryRequestPB)
+	require.NoError(t, err)
+	assert.Equal(t, plannerResultPB.Status.ErrCode, statuspb.OK)
+	assert.Equal(t, 3, len(plannerResultPB.Plan.Dag.GetNodes()))
+
+	// Remove pem2; the next plan must only span pem1 and kelvin.
+	updatePB := &distributedpb.LogicalPlannerStateUpdate{
+		RemovedAgents: []*uuidpb.UUID{
+			{
+				HighBits: 0x0000000100000000,
+				LowBits:  0x0000000000000002,
+			},
+		},
+	}
+	updateResultPB, err := c.UpdateState(updatePB)
+	require.NoError(t, err)
+	assert.Equal(t, updateResultPB.Status.ErrCode, statuspb.OK)
+
+	plannerResultPB, err = c.PlanWithCachedState(queryRequestPB)
+	require.NoError(t, err)
+	assert.Equal(t, plannerResultPB.Status.ErrCode, statuspb.OK)
+	assert.Equal(t, 2, len(plannerResultPB.Plan.Dag.GetNodes()))
+	_, hasPem2 := plannerResultPB.Plan.QbAddressToPlan["pem2"]
+	assert.False(t, hasPem2)
+}
+
 func TestPlanner_MissingTable(t *testing.T) {
 	// Create the compiler.
 	c, err := goplanner.New(&udfspb.UDFInfo{})
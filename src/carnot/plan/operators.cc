@@ -76,6 +76,12 @@ std::unique_ptr<Operator> Operator::FromProto(const planpb::Operator& pb, int64_
       return CreateOperator<LimitOperator>(id, pb.limit_op());
     case planpb::UNION_OPERATOR:
       return CreateOperator<UnionOperator>(id, pb.union_op());
+    case planpb::SORT_OPERATOR:
+      return CreateOperator<SortOperator>(id, pb.sort_op());
+    case planpb::TOPK_OPERATOR:
+      return CreateOperator<TopKOperator>(id, pb.topk_op());
+    case planpb::SAMPLE_OPERATOR:
+      return CreateOperator<SampleOperator>(id, pb.sample_op());
     case planpb::JOIN_OPERATOR:
       return CreateOperator<JoinOperator>(id, pb.join_op());
     case planpb::UDTF_SOURCE_OPERATOR:
@@ -106,6 +112,20 @@ Status MemorySourceOperator::Init(const planpb::MemorySourceOperator& pb) {
   return Status::OK();
 }
 
+void MemorySourceOperator::SetTimeRange(const planpb::MemorySourceOperator& pb) {
+  DCHECK(is_initialized_) << "Not initialized";
+  if (pb.has_start_time()) {
+    *pb_.mutable_start_time() = pb.start_time();
+  } else {
+    pb_.clear_start_time();
+  }
+  if (pb.has_stop_time()) {
+    *pb_.mutable_stop_time() = pb.stop_time();
+  } else {
+    pb_.clear_stop_time();
+  }
+}
+
 StatusOr<table_store::schema::Relation> MemorySourceOperator::OutputRelation(
     const table_store::schema::Schema&, const PlanState&,
     const std::vector<int64_t>& input_ids) const {
@@ -450,6 +470,109 @@ StatusOr<table_store::schema::Relation> LimitOperator::OutputRelation(
   return output_relation;
 }
 
+/**
+ * Sort Operator Implementation.
+ */
+std::string SortOperator::DebugString() const {
+  return absl::Substitute("Op:Sort(keys: [$0])", absl::StrJoin(sort_key_indices_, ","));
+}
+
+Status SortOperator::Init(const planpb::SortOperator& pb) {
+  pb_ = pb;
+  sort_key_indices_.reserve(pb_.sort_keys_size());
+  sort_key_descending_.reserve(pb_.sort_keys_size());
+  for (auto i = 0; i < pb_.sort_keys_size(); ++i) {
+    sort_key_indices_.push_back(pb_.sort_keys(i).column_index());
+    sort_key_descending_.push_back(pb_.sort_keys(i).descending());
+  }
+  rows_per_batch_ = pb_.rows_per_batch();
+  is_initialized_ = true;
+  return Status::OK();
+}
+
+StatusOr<table_store::schema::Relation> SortOperator::OutputRelation(
+    const table_store::schema::Schema& schema, const PlanState& /*state*/,
+    const std::vector<int64_t>& input_ids) const {
+  DCHECK(is_initialized_) << "Not initialized";
+  if (input_ids.size() != 1) {
+    return error::InvalidArgument("Sort operator must have exactly one input");
+  }
+  if (!schema.HasRelation(input_ids[0])) {
+    return error::NotFound("Missing relation ($0) for input of SortOperator", input_ids[0]);
+  }
+  // Sort reorders rows, so the output relation matches the input relation.
+  return schema.GetRelation(input_ids[0]);
+}
+
+/**
+ * TopK Operator Implementation.
+ */
+std::string TopKOperator::DebugString() const {
+  return absl::Substitute("Op:TopK($0, keys: [$1])", limit_, absl::StrJoin(sort_key_indices_, ","));
+}
+
+Status TopKOperator::Init(const planpb::TopKOperator& pb) {
+  pb_ = pb;
+  sort_key_indices_.reserve(pb_.sort_keys_size());
+  sort_key_descending_.reserve(pb_.sort_keys_size());
+  for (auto i = 0; i < pb_.sort_keys_size(); ++i) {
+    sort_key_indices_.push_back(pb_.sort_keys(i).column_index());
+    sort_key_descending_.push_back(pb_.sort_keys(i).descending());
+  }
+  limit_ = pb_.limit();
+  rows_per_batch_ = pb_.rows_per_batch();
+  is_initialized_ = true;
+  return Status::OK();
+}
+
+StatusOr<table_store::schema::Relation> TopKOperator::OutputRelation(
+    const table_store::schema::Schema& schema, const PlanState& /*state*/,
+    const std::vector<int64_t>& input_ids) const {
+  DCHECK(is_initialized_) << "Not initialized";
+  if (input_ids.size() != 1) {
+    return error::InvalidArgument("TopK operator must have exactly one input");
+  }
+  if (!schema.HasRelation(input_ids[0])) {
+    return error::NotFound("Missing relation ($0) for input of TopKOperator", input_ids[0]);
+  }
+  // TopK reorders and truncates rows, so the output relation matches the input relation.
+  return schema.GetRelation(input_ids[0]);
+}
+
+/**
+ * Sample Operator Implementation.
+ */
+std::string SampleOperator::DebugString() const {
+  return absl::Substitute("Op:Sample($0, strata: [$1])", sample_size_,
+                          absl::StrJoin(stratify_key_indices_, ","));
+}
+
+Status SampleOperator::Init(const planpb::SampleOperator& pb) {
+  pb_ = pb;
+  sample_size_ = pb_.sample_size();
+  stratify_key_indices_.reserve(pb_.stratify_key_indices_size());
+  for (auto i = 0; i < pb_.stratify_key_indices_size(); ++i) {
+    stratify_key_indices_.push_back(pb_.stratify_key_indices(i));
+  }
+  seed_ = pb_.seed();
+  is_initialized_ = true;
+  return Status::OK();
+}
+
+StatusOr<table_store::schema::Relation> SampleOperator::OutputRelation(
+    const table_store::schema::Schema& schema, const PlanState& /*state*/,
+    const std::vector<int64_t>& input_ids) const {
+  DCHECK(is_initialized_) << "Not initialized";
+  if (input_ids.size() != 1) {
+    return error::InvalidArgument("Sample operator must have exactly one input");
+  }
+  if (!schema.HasRelation(input_ids[0])) {
+    return error::NotFound("Missing relation ($0) for input of SampleOperator", input_ids[0]);
+  }
+  // Sample only drops rows, so the output relation matches the input relation.
+  return schema.GetRelation(input_ids[0]);
+}
+
 /**
  * Zip Operator Implementation.
  */
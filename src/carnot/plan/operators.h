@@ -88,6 +88,9 @@ class MemorySourceOperator : public Operator {
       const table_store::schema::Schema& schema, const PlanState& state,
       const std::vector<int64_t>& input_ids) const override;
   Status Init(const planpb::MemorySourceOperator& pb);
+  // Rebinds the time range from another instance of this operator. Used by standing queries,
+  // where consecutive executions differ only in the queried time window.
+  void SetTimeRange(const planpb::MemorySourceOperator& pb);
   std::string DebugString() const override;
   std::string TableName() const { return pb_.name(); }
   bool HasStartTime() const { return pb_.has_start_time(); }
@@ -97,6 +100,12 @@ class MemorySourceOperator : public Operator {
   std::vector<int64_t> Columns() const { return column_idxs_; }
   const types::TabletID& Tablet() const { return pb_.tablet(); }
   bool streaming() const { return pb_.streaming(); }
+  const google::protobuf::RepeatedPtrField<planpb::MemorySourceOperator::ColumnPredicate>&
+  predicates() const {
+    return pb_.predicates();
+  }
+  bool HasRowsLimit() const { return pb_.has_rows_limit(); }
+  int64_t rows_limit() const { return pb_.rows_limit().value(); }
 
  private:
   planpb::MemorySourceOperator pb_;
@@ -144,6 +153,8 @@ class AggregateOperator : public Operator {
   const std::vector<GroupInfo>& groups() const { return groups_; }
   const std::vector<std::shared_ptr<AggregateExpression>>& values() const { return values_; }
   bool windowed() const { return pb_.windowed(); }
+  bool partial_agg() const { return pb_.partial_agg(); }
+  bool finalize_results() const { return pb_.finalize_results(); }
 
  private:
   std::vector<std::shared_ptr<AggregateExpression>> values_;
@@ -262,6 +273,74 @@ class LimitOperator : public Operator {
   planpb::LimitOperator pb_;
 };
 
+class SortOperator : public Operator {
+ public:
+  explicit SortOperator(int64_t id) : Operator(id, planpb::SORT_OPERATOR) {}
+  ~SortOperator() override = default;
+
+  StatusOr<table_store::schema::Relation> OutputRelation(
+      const table_store::schema::Schema& schema, const PlanState& state,
+      const std::vector<int64_t>& input_ids) const override;
+  Status Init(const planpb::SortOperator& pb);
+  std::string DebugString() const override;
+
+  const std::vector<int64_t>& sort_key_indices() const { return sort_key_indices_; }
+  const std::vector<bool>& sort_key_descending() const { return sort_key_descending_; }
+  int64_t rows_per_batch() const { return rows_per_batch_; }
+
+ private:
+  std::vector<int64_t> sort_key_indices_;
+  std::vector<bool> sort_key_descending_;
+  int64_t rows_per_batch_ = 0;
+  planpb::SortOperator pb_;
+};
+
+class TopKOperator : public Operator {
+ public:
+  explicit TopKOperator(int64_t id) : Operator(id, planpb::TOPK_OPERATOR) {}
+  ~TopKOperator() override = default;
+
+  StatusOr<table_store::schema::Relation> OutputRelation(
+      const table_store::schema::Schema& schema, const PlanState& state,
+      const std::vector<int64_t>& input_ids) const override;
+  Status Init(const planpb::TopKOperator& pb);
+  std::string DebugString() const override;
+
+  const std::vector<int64_t>& sort_key_indices() const { return sort_key_indices_; }
+  const std::vector<bool>& sort_key_descending() const { return sort_key_descending_; }
+  int64_t limit() const { return limit_; }
+  int64_t rows_per_batch() const { return rows_per_batch_; }
+
+ private:
+  std::vector<int64_t> sort_key_indices_;
+  std::vector<bool> sort_key_descending_;
+  int64_t limit_ = 0;
+  int64_t rows_per_batch_ = 0;
+  planpb::TopKOperator pb_;
+};
+
+class SampleOperator : public Operator {
+ public:
+  explicit SampleOperator(int64_t id) : Operator(id, planpb::SAMPLE_OPERATOR) {}
+  ~SampleOperator() override = default;
+
+  StatusOr<table_store::schema::Relation> OutputRelation(
+      const table_store::schema::Schema& schema, const PlanState& state,
+      const std::vector<int64_t>& input_ids) const override;
+  Status Init(const planpb::SampleOperator& pb);
+  std::string DebugString() const override;
+
+  int64_t sample_size() const { return sample_size_; }
+  const std::vector<int64_t>& stratify_key_indices() const { return stratify_key_indices_; }
+  uint64_t seed() const { return seed_; }
+
+ private:
+  int64_t sample_size_ = 0;
+  std::vector<int64_t> stratify_key_indices_;
+  uint64_t seed_ = 0;
+  planpb::SampleOperator pb_;
+};
+
 class UnionOperator : public Operator {
  public:
   explicit UnionOperator(int64_t id) : Operator(id, planpb::UNION_OPERATOR) {}
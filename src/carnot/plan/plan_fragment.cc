@@ -83,6 +83,15 @@ Status PlanFragmentWalker::CallWalkFn(const Operator& op) {
     case planpb::OperatorType::UNION_OPERATOR:
       PL_RETURN_IF_ERROR(CallAs<UnionOperator>(on_union_walk_fn_, op));
       break;
+    case planpb::OperatorType::SORT_OPERATOR:
+      PL_RETURN_IF_ERROR(CallAs<SortOperator>(on_sort_walk_fn_, op));
+      break;
+    case planpb::OperatorType::TOPK_OPERATOR:
+      PL_RETURN_IF_ERROR(CallAs<TopKOperator>(on_topk_walk_fn_, op));
+      break;
+    case planpb::OperatorType::SAMPLE_OPERATOR:
+      PL_RETURN_IF_ERROR(CallAs<SampleOperator>(on_sample_walk_fn_, op));
+      break;
     case planpb::OperatorType::GRPC_SINK_OPERATOR:
       PL_RETURN_IF_ERROR(CallAs<GRPCSinkOperator>(on_grpc_sink_walk_fn_, op));
       break;
@@ -36,6 +36,7 @@
 #include "src/table_store/schema/relation.h"
 #include "src/table_store/schemapb/schema.pb.h"
 
+using px::carnot::planner::distributedpb::BatchLogicalPlannerResult;
 using px::carnot::planner::distributedpb::LogicalPlannerResult;
 using px::carnot::planner::plannerpb::CompileMutationsResponse;
 
@@ -73,6 +74,30 @@ px::Status LoadProto(const std::string& serialized_proto, google::protobuf::Mess
   return px::Status::OK();
 }
 
+namespace {
+
+char* PlanWithState(px::carnot::planner::LogicalPlanner* planner,
+                    const px::carnot::planner::distributedpb::LogicalPlannerState& planner_state_pb,
+                    const px::carnot::planner::plannerpb::QueryRequest& query_request_pb,
+                    int* resultLen) {
+  // PlanAsProto serves repeated (plan, cluster layout) pairs from the planner's plan cache,
+  // skipping the distributed planning rules and plan serialization for steady-state dashboards.
+  auto plan_pb_status = planner->PlanAsProto(planner_state_pb, query_request_pb);
+  if (!plan_pb_status.ok()) {
+    return ExitEarly<LogicalPlannerResult>(plan_pb_status.status(), resultLen);
+  }
+
+  // If the response is ok, then we can go ahead and set this up.
+  LogicalPlannerResult planner_result_pb;
+  WrapStatus(&planner_result_pb, plan_pb_status.status());
+  *(planner_result_pb.mutable_plan()) = plan_pb_status.ConsumeValueOrDie();
+
+  // Serialize the logical plan into bytes.
+  return PrepareResult(&planner_result_pb, resultLen);
+}
+
+}  // namespace
+
 char* PlannerPlan(PlannerPtr planner_ptr, const char* planner_state_str_c,
                   int planner_state_str_len, const char* query_request_str_c,
                   int query_request_str_len, int* resultLen) {
@@ -96,30 +121,116 @@ char* PlannerPlan(PlannerPtr planner_ptr, const char* planner_state_str_c,
 
   auto planner = reinterpret_cast<px::carnot::planner::LogicalPlanner*>(planner_ptr);
 
-  auto distributed_plan_status = planner->Plan(planner_state_pb, query_request_pb);
-  if (!distributed_plan_status.ok()) {
-    return ExitEarly<LogicalPlannerResult>(distributed_plan_status.status(), resultLen);
-  }
-  std::unique_ptr<px::carnot::planner::distributed::DistributedPlan> distributed_plan =
-      distributed_plan_status.ConsumeValueOrDie();
+  return PlanWithState(planner, planner_state_pb, query_request_pb, resultLen);
+}
 
-  // If the response is ok, then we can go ahead and set this up.
-  LogicalPlannerResult planner_result_pb;
-  WrapStatus(&planner_result_pb, distributed_plan_status.status());
-  // In the future, if we actually have plan options that will actually determine how the plan is
-  // constructed, we may want to pass the planOptions to planner.Plan. However, this
-  // will need to go through many more layers (such as the coordinator), so this is fine for now.
-  distributed_plan->SetPlanOptions(planner_state_pb.plan_options());
+char* PlannerPlanBatch(PlannerPtr planner_ptr, const char* planner_state_str_c,
+                       int planner_state_str_len, const char* batch_request_str_c,
+                       int batch_request_str_len, int* resultLen) {
+  DCHECK(planner_state_str_c != nullptr);
+  std::string planner_state_pb_str(planner_state_str_c,
+                                   planner_state_str_c + planner_state_str_len);
+  std::string batch_request_pb_str(batch_request_str_c,
+                                   batch_request_str_c + batch_request_str_len);
 
-  auto plan_pb_status = distributed_plan->ToProto();
-  if (!plan_pb_status.ok()) {
-    return ExitEarly<LogicalPlannerResult>(plan_pb_status.status(), resultLen);
+  // Load in the planner state protobuf.
+  px::carnot::planner::distributedpb::LogicalPlannerState planner_state_pb;
+  PLANNER_RETURN_IF_ERROR(BatchLogicalPlannerResult, resultLen,
+                          LoadProto(planner_state_pb_str, &planner_state_pb,
+                                    "Failed to process the logical planner state"));
+
+  // Load in the batch query request protobuf.
+  px::carnot::planner::plannerpb::BatchQueryRequest batch_request_pb;
+  PLANNER_RETURN_IF_ERROR(BatchLogicalPlannerResult, resultLen,
+                          LoadProto(batch_request_pb_str, &batch_request_pb,
+                                    "Failed to process the batch query request"));
+
+  auto planner = reinterpret_cast<px::carnot::planner::LogicalPlanner*>(planner_ptr);
+
+  auto results_or_s = planner->PlanBatch(planner_state_pb, batch_request_pb);
+  if (!results_or_s.ok()) {
+    return ExitEarly<BatchLogicalPlannerResult>(results_or_s.status(), resultLen);
   }
+  auto results = results_or_s.ConsumeValueOrDie();
 
-  *(planner_result_pb.mutable_plan()) = plan_pb_status.ConsumeValueOrDie();
+  BatchLogicalPlannerResult batch_result_pb;
+  WrapStatus(&batch_result_pb, results_or_s.status());
+  for (auto& distributed_plan_or_s : results) {
+    auto* result_pb = batch_result_pb.add_results();
+    WrapStatus(result_pb, distributed_plan_or_s.status());
+    if (!distributed_plan_or_s.ok()) {
+      continue;
+    }
+    auto distributed_plan = distributed_plan_or_s.ConsumeValueOrDie();
+    distributed_plan->SetPlanOptions(planner_state_pb.plan_options());
+    auto plan_pb_status = distributed_plan->ToProto();
+    if (!plan_pb_status.ok()) {
+      WrapStatus(result_pb, plan_pb_status.status());
+      continue;
+    }
+    *(result_pb->mutable_plan()) = plan_pb_status.ConsumeValueOrDie();
+  }
 
-  // Serialize the logical plan into bytes.
-  return PrepareResult(&planner_result_pb, resultLen);
+  return PrepareResult(&batch_result_pb, resultLen);
+}
+
+char* PlannerSetState(PlannerPtr planner_ptr, const char* planner_state_str_c,
+                      int planner_state_str_len, int* resultLen) {
+  DCHECK(planner_state_str_c != nullptr);
+  std::string planner_state_pb_str(planner_state_str_c,
+                                   planner_state_str_c + planner_state_str_len);
+
+  px::carnot::planner::distributedpb::LogicalPlannerState planner_state_pb;
+  PLANNER_RETURN_IF_ERROR(LogicalPlannerResult, resultLen,
+                          LoadProto(planner_state_pb_str, &planner_state_pb,
+                                    "Failed to process the logical planner state"));
+
+  auto planner = reinterpret_cast<px::carnot::planner::LogicalPlanner*>(planner_ptr);
+  PLANNER_RETURN_IF_ERROR(LogicalPlannerResult, resultLen,
+                          planner->SetCachedState(planner_state_pb));
+
+  LogicalPlannerResult result_pb;
+  WrapStatus(&result_pb, px::Status::OK());
+  return PrepareResult(&result_pb, resultLen);
+}
+
+char* PlannerUpdateState(PlannerPtr planner_ptr, const char* state_update_str_c,
+                         int state_update_str_len, int* resultLen) {
+  DCHECK(state_update_str_c != nullptr);
+  std::string state_update_pb_str(state_update_str_c, state_update_str_c + state_update_str_len);
+
+  px::carnot::planner::distributedpb::LogicalPlannerStateUpdate state_update_pb;
+  PLANNER_RETURN_IF_ERROR(LogicalPlannerResult, resultLen,
+                          LoadProto(state_update_pb_str, &state_update_pb,
+                                    "Failed to process the planner state update"));
+
+  auto planner = reinterpret_cast<px::carnot::planner::LogicalPlanner*>(planner_ptr);
+  PLANNER_RETURN_IF_ERROR(LogicalPlannerResult, resultLen,
+                          planner->ApplyCachedStateUpdate(state_update_pb));
+
+  LogicalPlannerResult result_pb;
+  WrapStatus(&result_pb, px::Status::OK());
+  return PrepareResult(&result_pb, resultLen);
+}
+
+char* PlannerPlanWithCachedState(PlannerPtr planner_ptr, const char* query_request_str_c,
+                                 int query_request_str_len, int* resultLen) {
+  std::string query_request_pb_str(query_request_str_c,
+                                   query_request_str_c + query_request_str_len);
+
+  px::carnot::planner::plannerpb::QueryRequest query_request_pb;
+  PLANNER_RETURN_IF_ERROR(
+      LogicalPlannerResult, resultLen,
+      LoadProto(query_request_pb_str, &query_request_pb, "Failed to process the query request"));
+
+  auto planner = reinterpret_cast<px::carnot::planner::LogicalPlanner*>(planner_ptr);
+  if (!planner->has_cached_state()) {
+    return ExitEarly<LogicalPlannerResult>(
+        px::error::FailedPrecondition("No planner state has been cached; call PlannerSetState"),
+        resultLen);
+  }
+
+  return PlanWithState(planner, planner->cached_state(), query_request_pb, resultLen);
 }
 
 char* PlannerCompileMutations(PlannerPtr planner_ptr, const char* planner_state_str_c,
@@ -45,6 +45,64 @@ PlannerPtr PlannerNew(const char* udf_info_str_data, int udf_info_str_len);
 char* PlannerPlan(PlannerPtr planner_ptr, const char* planner_state_str_c,
                   int planner_state_str_len, const char* query, int query_len, int* resultLen);
 
+/**
+ * @brief Plans a batch of query requests (e.g. one per widget of a loading dashboard)
+ * against a single compiler state, amortizing the schema ingestion that PlannerPlan repeats
+ * per call. Takes a serialized plannerpb.BatchQueryRequest and returns a serialized
+ * distributedpb.BatchLogicalPlannerResult with one entry per request, in request order.
+ *
+ * @param planner_ptr             Pointer to the Planner.
+ * @param planner_state_str_c     The planner state proto, serialized as a string.
+ * @param planner_state_str_len   Length of the planner state proto serialized string.
+ * @param batch_request_str_c     The serialized plannerpb.BatchQueryRequest.
+ * @param batch_request_str_len   Length of the serialized BatchQueryRequest.
+ * @param resultLen               Variable to store the length of the return value.
+ * @return char*                  A serialized BatchLogicalPlannerResult.
+ */
+char* PlannerPlanBatch(PlannerPtr planner_ptr, const char* planner_state_str_c,
+                       int planner_state_str_len, const char* batch_request_str_c,
+                       int batch_request_str_len, int* resultLen);
+
+/**
+ * @brief Caches a full planner state inside the planner so later plan requests can send
+ * deltas instead of the full state. On large clusters the state proto serialization
+ * dominates planning latency.
+ *
+ * @param planner_ptr             Pointer to the Planner.
+ * @param planner_state_str_c     The serialized distributedpb.LogicalPlannerState.
+ * @param planner_state_str_len   Length of the serialized LogicalPlannerState.
+ * @param resultLen               Variable to store the length of the return value.
+ * @return char*                  A serialized LogicalPlannerResult carrying the status.
+ */
+char* PlannerSetState(PlannerPtr planner_ptr, const char* planner_state_str_c,
+                      int planner_state_str_len, int* resultLen);
+
+/**
+ * @brief Applies a delta (agents and schemas added, replaced or removed) to the planner
+ * state cached by PlannerSetState.
+ *
+ * @param planner_ptr            Pointer to the Planner.
+ * @param state_update_str_c     The serialized distributedpb.LogicalPlannerStateUpdate.
+ * @param state_update_str_len   Length of the serialized LogicalPlannerStateUpdate.
+ * @param resultLen              Variable to store the length of the return value.
+ * @return char*                 A serialized LogicalPlannerResult carrying the status.
+ */
+char* PlannerUpdateState(PlannerPtr planner_ptr, const char* state_update_str_c,
+                         int state_update_str_len, int* resultLen);
+
+/**
+ * @brief Plans a query against the planner state cached by PlannerSetState and any
+ * deltas applied since, avoiding the full state round trip of PlannerPlan.
+ *
+ * @param planner_ptr             Pointer to the Planner.
+ * @param query_request_str_c     The query request proto to plan, serialized as a string.
+ * @param query_request_str_len   The length of the query request serialized string.
+ * @param resultLen               Variable to store the length of the return value.
+ * @return char*                  The distributed plan proto, serialized as a string.
+ */
+char* PlannerPlanWithCachedState(PlannerPtr planner_ptr, const char* query_request_str_c,
+                                 int query_request_str_len, int* resultLen);
+
 /**
  * @brief Compiles mutations into their executable form. Takes in a serialized
  * CompileMutationsRequest and returns a serialiaed CompileMutationsResponse.
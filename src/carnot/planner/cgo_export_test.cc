@@ -93,6 +93,91 @@ TEST_F(PlannerExportTest, one_pem_one_kelvin_query_test) {
   EXPECT_EQ(planner_result.plan().qb_address_to_plan_size(), 2);
 }
 
+TEST_F(PlannerExportTest, plan_batch) {
+  planner_ = MakePlanner();
+  int result_len;
+  std::string logical_planner_state;
+  ASSERT_TRUE(
+      testutils::CreateOnePEMOneKelvinPlannerState().SerializeToString(&logical_planner_state));
+
+  plannerpb::BatchQueryRequest batch_request_pb;
+  *batch_request_pb.add_requests() =
+      MakeQueryRequest("import px\npx.display(px.DataFrame('table1'), 'out')");
+  *batch_request_pb.add_requests() = MakeQueryRequest("this is not a valid script");
+  std::string batch_request;
+  ASSERT_TRUE(batch_request_pb.SerializeToString(&batch_request));
+
+  auto interface_result =
+      PlannerPlanBatch(planner_, logical_planner_state.c_str(), logical_planner_state.length(),
+                       batch_request.c_str(), batch_request.length(), &result_len);
+  ASSERT_GT(result_len, 0);
+
+  distributedpb::BatchLogicalPlannerResult batch_result;
+  ASSERT_TRUE(
+      batch_result.ParseFromString(std::string(interface_result, interface_result + result_len)));
+  delete[] interface_result;
+  ASSERT_OK(batch_result.status());
+  ASSERT_EQ(batch_result.results_size(), 2);
+  // The valid script plans as it would through PlannerPlan; the broken script fails only its
+  // own entry.
+  ASSERT_OK(batch_result.results(0).status());
+  EXPECT_EQ(batch_result.results(0).plan().qb_address_to_plan_size(), 2);
+  EXPECT_NOT_OK(batch_result.results(1).status());
+}
+
+TEST_F(PlannerExportTest, plan_with_cached_state) {
+  planner_ = MakePlanner();
+  int result_len;
+  std::string query = "import px\npx.display(px.DataFrame('table1'), 'out')";
+  std::string query_request;
+  ASSERT_TRUE(MakeQueryRequest(query).SerializeToString(&query_request));
+
+  // Planning before any state has been cached must fail.
+  auto interface_result =
+      PlannerPlanWithCachedState(planner_, query_request.c_str(), query_request.length(),
+                                 &result_len);
+  ASSERT_GT(result_len, 0);
+  distributedpb::LogicalPlannerResult planner_result;
+  ASSERT_TRUE(
+      planner_result.ParseFromString(std::string(interface_result, interface_result + result_len)));
+  delete[] interface_result;
+  EXPECT_NOT_OK(planner_result.status());
+
+  // Cache the full state once.
+  std::string logical_planner_state;
+  ASSERT_TRUE(
+      testutils::CreateOnePEMOneKelvinPlannerState().SerializeToString(&logical_planner_state));
+  interface_result = PlannerSetState(planner_, logical_planner_state.c_str(),
+                                     logical_planner_state.length(), &result_len);
+  ASSERT_GT(result_len, 0);
+  ASSERT_TRUE(
+      planner_result.ParseFromString(std::string(interface_result, interface_result + result_len)));
+  delete[] interface_result;
+  ASSERT_OK(planner_result.status());
+
+  // Subsequent plan requests only carry the query.
+  interface_result = PlannerPlanWithCachedState(planner_, query_request.c_str(),
+                                                query_request.length(), &result_len);
+  ASSERT_GT(result_len, 0);
+  ASSERT_TRUE(
+      planner_result.ParseFromString(std::string(interface_result, interface_result + result_len)));
+  delete[] interface_result;
+  ASSERT_OK(planner_result.status());
+  EXPECT_EQ(planner_result.plan().qb_address_to_plan_size(), 2);
+
+  // An empty delta must be accepted once state is cached.
+  distributedpb::LogicalPlannerStateUpdate update;
+  std::string update_str;
+  ASSERT_TRUE(update.SerializeToString(&update_str));
+  interface_result = PlannerUpdateState(planner_, update_str.c_str(), update_str.length(),
+                                        &result_len);
+  ASSERT_GT(result_len, 0);
+  ASSERT_TRUE(
+      planner_result.ParseFromString(std::string(interface_result, interface_result + result_len)));
+  delete[] interface_result;
+  EXPECT_OK(planner_result.status());
+}
+
 TEST_F(PlannerExportTest, bad_queries) {
   planner_ = MakePlanner();
   int result_len;
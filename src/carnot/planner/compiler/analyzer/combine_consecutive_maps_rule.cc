@@ -23,28 +23,29 @@ namespace carnot {
 namespace planner {
 namespace compiler {
 
-bool ContainsChildColumn(const ExpressionIR& expr,
-                         const absl::flat_hash_set<std::string>& colnames) {
+void CountParentColumnUses(const ExpressionIR& expr,
+                           const absl::flat_hash_set<std::string>& colnames,
+                           absl::flat_hash_map<std::string, int64_t>* use_counts) {
   if (Match(&expr, ColumnNode())) {
-    return colnames.contains(static_cast<const ColumnIR*>(&expr)->col_name());
+    const auto& col_name = static_cast<const ColumnIR*>(&expr)->col_name();
+    if (colnames.contains(col_name)) {
+      ++(*use_counts)[col_name];
+    }
+    return;
   }
   if (Match(&expr, Func())) {
     auto func = static_cast<const FuncIR*>(&expr);
     for (const auto& arg : func->all_args()) {
-      if (ContainsChildColumn(*arg, colnames)) {
-        return true;
-      }
+      CountParentColumnUses(*arg, colnames, use_counts);
     }
-    return false;
   }
-  return false;
 }
 
 bool CombineConsecutiveMapsRule::ShouldCombineMaps(
     MapIR* parent, MapIR* child, const absl::flat_hash_set<std::string>& parent_col_names) {
   // This rule is targeted at combining maps of the following style:
   // df.foo = 1
-  // df.bar = df.abc * 2
+  // df.bar = df.foo * 2
   // The logic for combining maps where the child keeps input columns is different
   // from the logic where the child does not keep input columns, so for simplicity we only
   // solve the former case right now.
@@ -56,16 +57,73 @@ bool CombineConsecutiveMapsRule::ShouldCombineMaps(
   if (parent->Children().size() > 1) {
     return false;
   }
+  // Child expressions may reference columns the parent defines; those are fused by inlining
+  // the parent's expression into the child's (see CombineMaps). Inlining a non-trivial
+  // expression into more than one use site would re-evaluate it per use site per row, so we
+  // only inline column/constant expressions into multiple uses.
+  absl::flat_hash_map<std::string, int64_t> use_counts;
   for (const auto& child_expr : child->col_exprs()) {
-    if (ContainsChildColumn(*(child_expr.node), parent_col_names)) {
-      return false;
+    CountParentColumnUses(*(child_expr.node), parent_col_names, &use_counts);
+  }
+  if (!use_counts.empty()) {
+    absl::flat_hash_map<std::string, ExpressionIR*> parent_exprs;
+    for (const auto& parent_col_expr : parent->col_exprs()) {
+      parent_exprs[parent_col_expr.name] = parent_col_expr.node;
+    }
+    for (const auto& [col_name, count] : use_counts) {
+      ExpressionIR* parent_expr = parent_exprs[col_name];
+      const bool trivial = Match(parent_expr, ColumnNode()) || Match(parent_expr, DataNode());
+      if (!trivial && count > 1) {
+        return false;
+      }
     }
   }
   return true;
 }
 
+Status CombineConsecutiveMapsRule::InlineParentColumns(
+    FuncIR* func, const absl::flat_hash_map<std::string, ExpressionIR*>& parent_exprs) {
+  // Copy the arg list: UpdateArg mutates it.
+  const std::vector<ExpressionIR*> args = func->all_args();
+  for (ExpressionIR* arg : args) {
+    if (Match(arg, ColumnNode())) {
+      const auto& col_name = static_cast<ColumnIR*>(arg)->col_name();
+      auto parent_expr = parent_exprs.find(col_name);
+      if (parent_expr != parent_exprs.end()) {
+        PL_ASSIGN_OR_RETURN(ExpressionIR * inlined, func->graph()->CopyNode(parent_expr->second));
+        PL_RETURN_IF_ERROR(func->UpdateArg(arg, inlined));
+      }
+    } else if (Match(arg, Func())) {
+      PL_RETURN_IF_ERROR(InlineParentColumns(static_cast<FuncIR*>(arg), parent_exprs));
+    }
+  }
+  return Status::OK();
+}
+
 Status CombineConsecutiveMapsRule::CombineMaps(
     MapIR* parent, MapIR* child, const absl::flat_hash_set<std::string>& parent_col_names) {
+  // Snapshot the parent's definitions before the merge loop below overwrites any of them:
+  // child expressions reference the parent's output, so substitutions must always use the
+  // parent's original expressions. Each substitution inlines a copy.
+  absl::flat_hash_map<std::string, ExpressionIR*> parent_exprs;
+  for (const auto& parent_col_expr : parent->col_exprs()) {
+    parent_exprs[parent_col_expr.name] = parent_col_expr.node;
+  }
+
+  for (size_t i = 0; i < child->col_exprs().size(); ++i) {
+    ExpressionIR* child_expr = child->col_exprs()[i].node;
+    if (Match(child_expr, ColumnNode())) {
+      const auto& col_name = static_cast<ColumnIR*>(child_expr)->col_name();
+      auto parent_expr = parent_exprs.find(col_name);
+      if (parent_expr != parent_exprs.end()) {
+        PL_ASSIGN_OR_RETURN(ExpressionIR * inlined, child->graph()->CopyNode(parent_expr->second));
+        PL_RETURN_IF_ERROR(child->UpdateColExpr(child_expr, inlined));
+      }
+    } else if (Match(child_expr, Func())) {
+      PL_RETURN_IF_ERROR(InlineParentColumns(static_cast<FuncIR*>(child_expr), parent_exprs));
+    }
+  }
+
   // If the column name is simply being overwritten, that's ok.
   for (const auto& child_col_expr : child->col_exprs()) {
     ExpressionIR* child_expr = child_col_expr.node;
@@ -30,7 +30,10 @@ namespace compiler {
 
 /**
  * @brief This rule consolidates consecutive map nodes into a single node in cases where it is
- * simple to do so.
+ * simple to do so. Child expressions that reference columns defined by the parent map are fused
+ * by inlining the parent's expression into the child's, so multi-statement scripts (df.a = ...;
+ * df.b = f(df.a); ...) collapse into one map evaluated in a single pass over each row batch
+ * instead of a chain of maps each materializing an intermediate row batch.
  *
  */
 class CombineConsecutiveMapsRule : public Rule {
@@ -44,6 +47,10 @@ class CombineConsecutiveMapsRule : public Rule {
                          const absl::flat_hash_set<std::string>& parent_col_names);
   Status CombineMaps(MapIR* parent, MapIR* child,
                      const absl::flat_hash_set<std::string>& parent_col_names);
+  // Replaces references to parent-defined columns in the (func) child expression with copies
+  // of the parent's defining expressions.
+  Status InlineParentColumns(FuncIR* func,
+                             const absl::flat_hash_map<std::string, ExpressionIR*>& parent_exprs);
 };
 
 }  // namespace compiler
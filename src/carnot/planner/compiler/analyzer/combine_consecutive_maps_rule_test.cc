@@ -63,8 +63,10 @@ TEST_F(CombineConsecutiveMapsRuleTest, multiple_with_break) {
   ColumnExpression expr1{"count_1", MakeColumn("count", 0)};
   ColumnExpression expr2{"cpu0_1", MakeColumn("cpu0", 0)};
   ColumnExpression expr3{"cpu_sum", MakeAddFunc(MakeColumn("cpu1", 0), MakeColumn("cpu2", 0))};
-  // Should break here because cpu_sum was used prior
-  ColumnExpression expr4{"cpu_sum_1", MakeColumn("cpu_sum", 0)};
+  // Should break here: cpu_sum is a non-trivial expression used twice, so inlining it
+  // would evaluate it twice per row.
+  ColumnExpression expr4{"cpu_sum_2x",
+                         MakeAddFunc(MakeColumn("cpu_sum", 0), MakeColumn("cpu_sum", 0))};
 
   auto map1 = MakeMap(mem_src, {expr1}, true);
   auto map2 = MakeMap(map1, {expr2}, true);
@@ -131,13 +133,61 @@ TEST_F(CombineConsecutiveMapsRuleTest, use_output_column) {
 
   auto map1 = MakeMap(mem_src, {parent_expr}, false);
   auto map2 = MakeMap(map1, {child_expr}, true);
+  auto map2_id = map2->id();
   MakeMemSink(map2, "abc");
   MakeMemSink(map2, "def");
 
   CombineConsecutiveMapsRule rule;
   auto result = rule.Execute(graph.get());
   ASSERT_OK(result);
-  ASSERT_FALSE(result.ConsumeValueOrDie());
+  ASSERT_TRUE(result.ConsumeValueOrDie());
+
+  EXPECT_TRUE(graph->HasNode(map1->id()));
+  EXPECT_FALSE(graph->HasNode(map2_id));
+
+  // The reference to the parent-defined column count_1 should be replaced with a copy of the
+  // parent's defining expression (a reference to the input column count).
+  ASSERT_EQ(2, map1->col_exprs().size());
+  EXPECT_EQ(parent_expr.name, map1->col_exprs()[0].name);
+  EXPECT_EQ(child_expr.name, map1->col_exprs()[1].name);
+  auto sum_func = static_cast<FuncIR*>(map1->col_exprs()[1].node);
+  ASSERT_EQ(2, sum_func->all_args().size());
+  ASSERT_MATCH(sum_func->all_args()[1], ColumnNode());
+  EXPECT_EQ("count", static_cast<ColumnIR*>(sum_func->all_args()[1])->col_name());
+}
+
+TEST_F(CombineConsecutiveMapsRuleTest, inline_nontrivial_single_use) {
+  MemorySourceIR* mem_src = MakeMemSource();
+
+  ColumnExpression parent_expr{"cpu_sum",
+                               MakeAddFunc(MakeColumn("cpu1", 0), MakeColumn("cpu2", 0))};
+  ColumnExpression child_expr{"total",
+                              MakeAddFunc(MakeColumn("cpu_sum", 0), MakeColumn("cpu0", 0))};
+
+  auto map1 = MakeMap(mem_src, {parent_expr}, true);
+  auto map2 = MakeMap(map1, {child_expr}, true);
+  auto map2_id = map2->id();
+  MakeMemSink(map2, "abc");
+
+  CombineConsecutiveMapsRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  ASSERT_TRUE(result.ConsumeValueOrDie());
+
+  EXPECT_TRUE(graph->HasNode(map1->id()));
+  EXPECT_FALSE(graph->HasNode(map2_id));
+
+  // cpu_sum is only referenced once, so its defining expression is inlined into total.
+  ASSERT_EQ(2, map1->col_exprs().size());
+  auto total_func = static_cast<FuncIR*>(map1->col_exprs()[1].node);
+  ASSERT_EQ(2, total_func->all_args().size());
+  ASSERT_MATCH(total_func->all_args()[0], Func());
+  auto inlined = static_cast<FuncIR*>(total_func->all_args()[0]);
+  ASSERT_EQ(2, inlined->all_args().size());
+  ASSERT_MATCH(inlined->all_args()[0], ColumnNode());
+  EXPECT_EQ("cpu1", static_cast<ColumnIR*>(inlined->all_args()[0])->col_name());
+  ASSERT_MATCH(inlined->all_args()[1], ColumnNode());
+  EXPECT_EQ("cpu2", static_cast<ColumnIR*>(inlined->all_args()[1])->col_name());
 }
 
 TEST_F(CombineConsecutiveMapsRuleTest, dependencies) {
@@ -30,6 +30,7 @@
 #include "src/carnot/planner/compiler/analyzer/analyzer.h"
 #include "src/carnot/planner/compiler/compiler.h"
 #include "src/carnot/planner/compiler/optimizer/optimizer.h"
+#include "src/carnot/planner/compiler/plan_cache.h"
 #include "src/carnot/planner/ir/ir.h"
 #include "src/carnot/planner/objects/pixie_module.h"
 #include "src/carnot/planner/parser/parser.h"
@@ -62,11 +63,18 @@ StatusOr<std::shared_ptr<IR>> Compiler::CompileToIR(const std::string& query,
 StatusOr<std::shared_ptr<IR>> Compiler::CompileToIR(const std::string& query,
                                                     CompilerState* compiler_state,
                                                     const ExecFuncs& exec_funcs) {
+  std::string cache_key = PlanCache::CacheKey(query, compiler_state, exec_funcs);
+  PL_ASSIGN_OR_RETURN(std::unique_ptr<IR> cached_plan, PlanCache::GetInstance()->Lookup(cache_key));
+  if (cached_plan != nullptr) {
+    return std::shared_ptr<IR>(std::move(cached_plan));
+  }
+
   PL_ASSIGN_OR_RETURN(std::shared_ptr<IR> ir, QueryToIR(query, compiler_state, exec_funcs));
   PL_RETURN_IF_ERROR(Analyze(ir.get(), compiler_state));
   PL_RETURN_IF_ERROR(Optimize(ir.get(), compiler_state));
 
   PL_RETURN_IF_ERROR(VerifyGraphHasResultSink(ir.get()));
+  PlanCache::GetInstance()->Insert(cache_key, *ir);
   return ir;
 }
 
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <string>
+
+#include "src/carnot/planner/compiler/optimizer/join_build_side_rule.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+StatusOr<bool> JoinBuildSideRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Join())) {
+    return false;
+  }
+  return MaybeFlipJoin(static_cast<JoinIR*>(ir_node));
+}
+
+StatusOr<bool> JoinBuildSideRule::MaybeFlipJoin(JoinIR* join_ir) {
+  // Only inner joins are symmetric in their parents; flipping an outer join changes which
+  // side's unmatched rows are emitted.
+  if (join_ir->join_type() != JoinIR::JoinType::kInner) {
+    return false;
+  }
+  // When the output is ordered by time, the execution engine always probes with the
+  // time-bearing input, so the build side doesn't depend on parent order.
+  const auto& column_names = join_ir->column_names();
+  if (std::find(column_names.begin(), column_names.end(), "time_") != column_names.end()) {
+    return false;
+  }
+  DCHECK_EQ(join_ir->parents().size(), 2UL);
+  double left_cardinality = EstimateCardinality(join_ir->parents()[0]);
+  double right_cardinality = EstimateCardinality(join_ir->parents()[1]);
+  if (left_cardinality == kUnknownCardinality || right_cardinality == kUnknownCardinality) {
+    return false;
+  }
+  // The left input is the build side; flip when it is meaningfully larger than the right.
+  if (left_cardinality <= right_cardinality * kFlipThreshold) {
+    return false;
+  }
+  PL_RETURN_IF_ERROR(join_ir->FlipParents());
+  return true;
+}
+
+double JoinBuildSideRule::EstimateCardinality(OperatorIR* op) {
+  if (Match(op, MemorySource())) {
+    const auto* stats =
+        compiler_state_->GetTableStatistics(static_cast<MemorySourceIR*>(op)->table_name());
+    if (stats == nullptr) {
+      return kUnknownCardinality;
+    }
+    return static_cast<double>(stats->row_count);
+  }
+  if (Match(op, Filter())) {
+    double input = EstimateCardinality(op->parents()[0]);
+    if (input == kUnknownCardinality) {
+      return kUnknownCardinality;
+    }
+    // An equality predicate on a column with known distinct count selects ~1/NDV of the
+    // input; anything else falls back to a fixed selectivity.
+    auto* filter_expr = static_cast<FilterIR*>(op)->filter_expr();
+    if (Match(filter_expr, Func())) {
+      auto* func = static_cast<FuncIR*>(filter_expr);
+      if (func->func_name() == "equal") {
+        for (ExpressionIR* arg : func->args()) {
+          if (!Match(arg, ColumnNode())) {
+            continue;
+          }
+          double distinct_count = EstimateColumnDistinctCount(static_cast<ColumnIR*>(arg));
+          if (distinct_count > 0) {
+            return input / distinct_count;
+          }
+        }
+      }
+    }
+    return input * kDefaultFilterSelectivity;
+  }
+  if (Match(op, Limit())) {
+    auto* limit = static_cast<LimitIR*>(op);
+    double input = EstimateCardinality(op->parents()[0]);
+    if (input == kUnknownCardinality) {
+      return static_cast<double>(limit->limit_value());
+    }
+    return std::min(input, static_cast<double>(limit->limit_value()));
+  }
+  if (Match(op, BlockingAgg())) {
+    auto* agg = static_cast<BlockingAggIR*>(op);
+    if (agg->group_by_all()) {
+      return 1.0;
+    }
+    double input = EstimateCardinality(op->parents()[0]);
+    // The output has one row per distinct group, estimated as the product of the group
+    // columns' distinct counts, capped at the input size.
+    double groups = 1.0;
+    for (ColumnIR* group : agg->groups()) {
+      double distinct_count = EstimateColumnDistinctCount(group);
+      if (distinct_count == kUnknownCardinality) {
+        return input;
+      }
+      groups *= distinct_count;
+    }
+    if (input == kUnknownCardinality) {
+      return groups;
+    }
+    return std::min(groups, input);
+  }
+  if (Match(op, Union())) {
+    double total = 0;
+    for (OperatorIR* parent : op->parents()) {
+      double parent_cardinality = EstimateCardinality(parent);
+      if (parent_cardinality == kUnknownCardinality) {
+        return kUnknownCardinality;
+      }
+      total += parent_cardinality;
+    }
+    return total;
+  }
+  if (Match(op, Join())) {
+    // A rough estimate: an equijoin usually emits about one row per probe row.
+    double left_cardinality = EstimateCardinality(op->parents()[0]);
+    double right_cardinality = EstimateCardinality(op->parents()[1]);
+    if (left_cardinality == kUnknownCardinality || right_cardinality == kUnknownCardinality) {
+      return kUnknownCardinality;
+    }
+    return std::max(left_cardinality, right_cardinality);
+  }
+  // Row-preserving operators (Map, Drop, etc.) pass their parent's cardinality through.
+  if (op->parents().size() == 1) {
+    return EstimateCardinality(op->parents()[0]);
+  }
+  return kUnknownCardinality;
+}
+
+double JoinBuildSideRule::EstimateColumnDistinctCount(ColumnIR* col) {
+  auto referenced_op_or_s = col->ReferencedOperator();
+  if (!referenced_op_or_s.ok()) {
+    return kUnknownCardinality;
+  }
+  // Walk through operators that neither rename columns nor change their value distribution,
+  // so the column can be resolved against the source table's statistics.
+  OperatorIR* op = referenced_op_or_s.ConsumeValueOrDie();
+  while (Match(op, Filter()) || Match(op, Limit())) {
+    op = op->parents()[0];
+  }
+  if (!Match(op, MemorySource())) {
+    return kUnknownCardinality;
+  }
+  const auto* stats =
+      compiler_state_->GetTableStatistics(static_cast<MemorySourceIR*>(op)->table_name());
+  if (stats == nullptr) {
+    return kUnknownCardinality;
+  }
+  auto it = stats->column_distinct_counts.find(col->col_name());
+  if (it == stats->column_distinct_counts.end()) {
+    return kUnknownCardinality;
+  }
+  return static_cast<double>(it->second);
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
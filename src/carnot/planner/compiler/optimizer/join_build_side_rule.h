@@ -0,0 +1,74 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+/**
+ * @brief Puts the smaller input of an inner join on the build side.
+ *
+ * The execution engine builds the join hash table from the left input and probes with the
+ * right one (unless the output is ordered by time, in which case the time-bearing input is
+ * always the probe side regardless of parent order). This rule estimates the cardinality of
+ * both inputs from the table statistics reported by the agents and flips the parents when
+ * the left input is estimated to be meaningfully larger than the right one. Joins without
+ * statistics for both sides are left untouched.
+ */
+class JoinBuildSideRule : public Rule {
+ public:
+  explicit JoinBuildSideRule(CompilerState* compiler_state)
+      : Rule(compiler_state, /*use_topo*/ false, /*reverse_topological_execution*/ false) {}
+
+ protected:
+  StatusOr<bool> Apply(IRNode* ir_node) override;
+
+ private:
+  StatusOr<bool> MaybeFlipJoin(JoinIR* join_ir);
+
+  /**
+   * @brief Estimates the number of rows the operator produces, or kUnknownCardinality if no
+   * estimate can be made (e.g. a source table without reported statistics).
+   */
+  double EstimateCardinality(OperatorIR* op);
+
+  /**
+   * @brief Returns the estimated number of distinct values of the column, resolved against
+   * the table statistics of the memory source it reads from, or kUnknownCardinality if the
+   * column cannot be traced back to a source column with statistics.
+   */
+  double EstimateColumnDistinctCount(ColumnIR* col);
+
+  static constexpr double kUnknownCardinality = -1.0;
+  // Selectivity assumed for filter predicates whose result cardinality can't be estimated
+  // from column statistics.
+  static constexpr double kDefaultFilterSelectivity = 0.25;
+  // Only flip when the left input is estimated to be at least this much larger than the
+  // right one, so near-equal estimates don't flip joins on noise.
+  static constexpr double kFlipThreshold = 1.2;
+};
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/optimizer/join_build_side_rule.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using JoinBuildSideRuleTest = RulesTest;
+
+TEST_F(JoinBuildSideRuleTest, flips_inner_join_with_larger_left_side) {
+  TableStatsMap stats;
+  stats["big"].row_count = 1000000;
+  stats["small"].row_count = 1000;
+  compiler_state_->set_table_statistics(std::move(stats));
+
+  auto big_src = MakeMemSource("big", MakeRelation());
+  auto small_src = MakeMemSource("small", MakeRelation());
+  auto join = MakeJoin({big_src, small_src}, "inner", MakeRelation(), MakeRelation(), {"count"},
+                       {"count"}, {"_x", "_y"});
+
+  JoinBuildSideRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  ASSERT_TRUE(result.ConsumeValueOrDie());
+
+  // The smaller input moves to the left (build) side; the on-columns and suffixes follow.
+  EXPECT_EQ(small_src, join->parents()[0]);
+  EXPECT_EQ(big_src, join->parents()[1]);
+  EXPECT_EQ(0, join->left_on_columns()[0]->container_op_parent_idx());
+  EXPECT_EQ(1, join->right_on_columns()[0]->container_op_parent_idx());
+  EXPECT_EQ("_y", join->suffix_strs()[0]);
+  EXPECT_EQ("_x", join->suffix_strs()[1]);
+
+  // A second pass must not flip back.
+  auto second_result = rule.Execute(graph.get());
+  ASSERT_OK(second_result);
+  EXPECT_FALSE(second_result.ConsumeValueOrDie());
+}
+
+TEST_F(JoinBuildSideRuleTest, no_flip_without_statistics) {
+  auto big_src = MakeMemSource("big", MakeRelation());
+  auto small_src = MakeMemSource("small", MakeRelation());
+  auto join = MakeJoin({big_src, small_src}, "inner", MakeRelation(), MakeRelation(), {"count"},
+                       {"count"});
+
+  JoinBuildSideRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_EQ(big_src, join->parents()[0]);
+}
+
+TEST_F(JoinBuildSideRuleTest, no_flip_when_output_is_time_ordered) {
+  TableStatsMap stats;
+  stats["big"].row_count = 1000000;
+  stats["small"].row_count = 1000;
+  compiler_state_->set_table_statistics(std::move(stats));
+
+  auto big_src = MakeMemSource("big", MakeTimeRelation());
+  auto small_src = MakeMemSource("small", MakeRelation());
+  auto join = MakeJoin({big_src, small_src}, "inner", MakeTimeRelation(), MakeRelation(),
+                       {"count"}, {"count"});
+  // Time-ordered joins always probe with the time-bearing input, so parent order doesn't
+  // determine the build side.
+  ASSERT_OK(join->SetOutputColumns({"time_"}, {MakeColumn("time_", 0, MakeTimeRelation())}));
+
+  JoinBuildSideRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_EQ(big_src, join->parents()[0]);
+}
+
+TEST_F(JoinBuildSideRuleTest, aggregated_side_estimated_by_group_distinct_count) {
+  TableStatsMap stats;
+  stats["big"].row_count = 1000000;
+  stats["big"].column_distinct_counts["count"] = 50;
+  stats["small"].row_count = 1000;
+  compiler_state_->set_table_statistics(std::move(stats));
+
+  // The left side aggregates "big" down to ~50 groups, so despite the larger source it is
+  // the smaller join input and must stay on the build side.
+  auto big_src = MakeMemSource("big", MakeRelation());
+  auto agg = MakeBlockingAgg(big_src, {MakeColumn("count", 0)},
+                             {{"cpu0_mean", MakeMeanFunc(MakeColumn("cpu0", 0))}});
+  auto small_src = MakeMemSource("small", MakeRelation());
+  auto join =
+      MakeJoin({agg, small_src}, "inner", MakeRelation(), MakeRelation(), {"count"}, {"count"});
+
+  JoinBuildSideRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_EQ(agg, join->parents()[0]);
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/compiler/plan_cache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+#include <absl/strings/str_join.h>
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+PlanCache* PlanCache::GetInstance() {
+  static PlanCache cache;
+  return &cache;
+}
+
+std::string PlanCache::CacheKey(const std::string& query, CompilerState* compiler_state,
+                                const ExecFuncs& exec_funcs) {
+  std::string key;
+  absl::StrAppend(&key, "query=", query, ";");
+
+  for (const auto& func : exec_funcs) {
+    absl::StrAppend(&key, "exec_func=", func.SerializeAsString(), ";");
+  }
+
+  // The relation map is unordered, so the schema portion of the key is built over sorted
+  // table names to keep it stable across processes and insertions.
+  std::vector<std::string> table_names;
+  table_names.reserve(compiler_state->relation_map()->size());
+  for (const auto& [name, relation] : *compiler_state->relation_map()) {
+    table_names.push_back(name);
+  }
+  std::sort(table_names.begin(), table_names.end());
+  for (const auto& name : table_names) {
+    absl::StrAppend(&key, "table=", name, ":",
+                    compiler_state->relation_map()->at(name).DebugString(), ";");
+  }
+
+  std::vector<std::string> sensitive_tables;
+  for (const auto& [name, columns] : *compiler_state->table_names_to_sensitive_columns()) {
+    std::vector<std::string> sorted_columns(columns.begin(), columns.end());
+    std::sort(sorted_columns.begin(), sorted_columns.end());
+    sensitive_tables.push_back(absl::StrCat(name, ":", absl::StrJoin(sorted_columns, ",")));
+  }
+  std::sort(sensitive_tables.begin(), sensitive_tables.end());
+  absl::StrAppend(&key, "sensitive=", absl::StrJoin(sensitive_tables, "|"), ";");
+
+  // The registry is built once at startup and never mutated, so the instance address is a
+  // sufficient stand-in for its contents.
+  absl::StrAppend(&key, "registry=",
+                  absl::StrFormat("%p", static_cast<void*>(compiler_state->registry_info())), ";");
+  // Compiled plans embed the resolved value of px.now(), so plans compiled at different
+  // times are not interchangeable.
+  absl::StrAppend(&key, "time_now=", compiler_state->time_now().val, ";");
+  absl::StrAppend(&key, "max_output_rows=", compiler_state->max_output_rows_per_table(), ";");
+  absl::StrAppend(&key, "result_address=", compiler_state->result_address(), ";");
+  absl::StrAppend(&key, "result_ssl_targetname=", compiler_state->result_ssl_targetname(), ";");
+  absl::StrAppend(&key, "redaction=", compiler_state->redaction_options().use_full_redaction, ",",
+                  compiler_state->redaction_options().use_px_redact_pii_best_effort, ";");
+  if (compiler_state->endpoint_config() != nullptr) {
+    absl::StrAppend(&key, "endpoint=", compiler_state->endpoint_config()->SerializeAsString(), ";");
+  }
+  if (compiler_state->plugin_config() != nullptr) {
+    absl::StrAppend(&key, "plugin=", compiler_state->plugin_config()->start_time_ns, ",",
+                    compiler_state->plugin_config()->end_time_ns, ";");
+  }
+  // Table statistics feed cost-based optimizer decisions, so plans compiled under different
+  // statistics are not interchangeable.
+  std::vector<std::string> stats_entries;
+  for (const auto& [name, stats] : compiler_state->table_statistics()) {
+    std::vector<std::string> column_entries;
+    for (const auto& [column, distinct_count] : stats.column_distinct_counts) {
+      column_entries.push_back(absl::StrCat(column, "=", distinct_count));
+    }
+    std::sort(column_entries.begin(), column_entries.end());
+    stats_entries.push_back(
+        absl::StrCat(name, ":", stats.row_count, ":", absl::StrJoin(column_entries, ",")));
+  }
+  std::sort(stats_entries.begin(), stats_entries.end());
+  absl::StrAppend(&key, "table_stats=", absl::StrJoin(stats_entries, "|"), ";");
+  for (const auto& attr : compiler_state->debug_info().otel_debug_attrs) {
+    absl::StrAppend(&key, "debug_attr=", attr.name, ":", attr.value, ";");
+  }
+  return key;
+}
+
+StatusOr<std::unique_ptr<IR>> PlanCache::Lookup(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::unique_ptr<IR>(nullptr);
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->plan->Clone();
+}
+
+void PlanCache::Insert(const std::string& key, const IR& plan) {
+  auto cloned_or_s = plan.Clone();
+  if (!cloned_or_s.ok()) {
+    // A plan that cannot be cloned cannot be served from the cache; compilation itself
+    // already succeeded, so just skip caching it.
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    it->second->plan = cloned_or_s.ConsumeValueOrDie();
+    return;
+  }
+  lru_.push_front(CacheEntry{key, cloned_or_s.ConsumeValueOrDie()});
+  entries_[key] = lru_.begin();
+  if (entries_.size() > kMaxCachedPlans) {
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+}
+
+void PlanCache::Clear() {
+  std::lock_guard<std::mutex> lock(mu_);
+  entries_.clear();
+  lru_.clear();
+}
+
+size_t PlanCache::size() {
+  std::lock_guard<std::mutex> lock(mu_);
+  return entries_.size();
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
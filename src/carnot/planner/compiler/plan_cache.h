@@ -0,0 +1,95 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/carnot/planner/compiler/ast_visitor.h"
+#include "src/carnot/planner/compiler_state/compiler_state.h"
+#include "src/carnot/planner/ir/ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+/**
+ * PlanCache is a process-wide cache of compiled logical plans, keyed by the query text and
+ * every piece of CompilerState that can influence the compiled output. Standing scripts are
+ * compiled repeatedly with identical inputs, and parsing plus the analyzer/optimizer passes
+ * dominate that cost; a hit replaces them with a single IR clone.
+ *
+ * Note that the resolved value of px.now() is baked into compiled plans, so time_now is part
+ * of the key: scripts using relative times ("start_time='-5m'") only hit when compiled with
+ * the same time_now, while scripts driven by absolute times or exec args hit across requests.
+ * The registry is keyed by the RegistryInfo instance, whose contents are expected to be
+ * stable for its lifetime (as they are in production, where the registry is built once at
+ * startup).
+ */
+class PlanCache {
+ public:
+  static PlanCache* GetInstance();
+
+  /**
+   * Builds the cache key for a compilation request. Everything the compiler reads from
+   * CompilerState is folded in; two requests with equal keys compile to identical plans.
+   */
+  static std::string CacheKey(const std::string& query, CompilerState* compiler_state,
+                              const ExecFuncs& exec_funcs);
+
+  /**
+   * Returns a clone of the cached plan for the key, or nullptr on a miss.
+   */
+  StatusOr<std::unique_ptr<IR>> Lookup(const std::string& key);
+
+  /**
+   * Stores a clone of the plan under the key, evicting the least recently used entry when
+   * the cache is full.
+   */
+  void Insert(const std::string& key, const IR& plan);
+
+  void Clear();
+  size_t size();
+
+ private:
+  // Standing scripts number in the low hundreds per cluster; past that the oldest entries
+  // are one-off queries not worth keeping.
+  static constexpr size_t kMaxCachedPlans = 256;
+
+  struct CacheEntry {
+    std::string key;
+    std::unique_ptr<IR> plan;
+  };
+
+  std::mutex mu_;
+  // Most recently used entries at the front; lookups splice their entry back to the front.
+  std::list<CacheEntry> lru_;
+  absl::flat_hash_map<std::string, std::list<CacheEntry>::iterator> entries_;
+};
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "src/carnot/funcs/funcs.h"
+#include "src/carnot/planner/compiler/compiler.h"
+#include "src/carnot/planner/compiler/plan_cache.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using ::px::table_store::schema::Relation;
+using ::px::testing::proto::EqualsProto;
+
+constexpr char kBasicQuery[] = R"pxl(
+import px
+df = px.DataFrame(table='cpu', select=['count', 'cpu0'])
+px.display(df, 'out')
+)pxl";
+
+class PlanCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto func_registry = std::make_unique<udf::Registry>("func_registry");
+    funcs::RegisterFuncsOrDie(func_registry.get());
+    info_ = std::make_unique<planner::RegistryInfo>();
+    PL_CHECK_OK(info_->Init(func_registry->ToProto()));
+    PlanCache::GetInstance()->Clear();
+  }
+
+  void TearDown() override { PlanCache::GetInstance()->Clear(); }
+
+  std::unique_ptr<CompilerState> MakeCompilerState(int64_t time_now) {
+    auto rel_map = std::make_unique<RelationMap>();
+    rel_map->emplace("cpu", Relation({types::INT64, types::FLOAT64}, {"count", "cpu0"}));
+    return std::make_unique<CompilerState>(
+        std::move(rel_map), SensitiveColumnMap{}, info_.get(), time_now,
+        /* max_output_rows_per_table */ 0, "result_addr", "result_ssltarget", RedactionOptions{},
+        nullptr, nullptr, planner::DebugInfo{});
+  }
+
+  std::unique_ptr<RegistryInfo> info_;
+  Compiler compiler_;
+};
+
+TEST_F(PlanCacheTest, cache_hit_returns_identical_plan) {
+  auto compiler_state = MakeCompilerState(/* time_now */ 1552607213931245000);
+  auto first_plan = compiler_.Compile(kBasicQuery, compiler_state.get());
+  ASSERT_OK(first_plan);
+  EXPECT_EQ(1, PlanCache::GetInstance()->size());
+
+  // The second compilation must be served from the cache and produce the same plan.
+  auto cached_state = MakeCompilerState(/* time_now */ 1552607213931245000);
+  auto second_plan = compiler_.Compile(kBasicQuery, cached_state.get());
+  ASSERT_OK(second_plan);
+  EXPECT_EQ(1, PlanCache::GetInstance()->size());
+  EXPECT_THAT(second_plan.ConsumeValueOrDie(),
+              EqualsProto(first_plan.ConsumeValueOrDie().DebugString()));
+}
+
+TEST_F(PlanCacheTest, key_changes_on_different_inputs) {
+  auto compiler_state = MakeCompilerState(/* time_now */ 1552607213931245000);
+  auto base_key = PlanCache::CacheKey(kBasicQuery, compiler_state.get(), {});
+
+  // A different query, a different time_now (plans embed the resolved value of px.now()), and
+  // different exec funcs must all produce different keys.
+  EXPECT_NE(base_key, PlanCache::CacheKey("import px", compiler_state.get(), {}));
+
+  auto later_state = MakeCompilerState(/* time_now */ 1552607213931245001);
+  EXPECT_NE(base_key, PlanCache::CacheKey(kBasicQuery, later_state.get(), {}));
+
+  FuncToExecute func;
+  func.set_func_name("f");
+  func.set_output_table_prefix("test");
+  EXPECT_NE(base_key, PlanCache::CacheKey(kBasicQuery, compiler_state.get(), {func}));
+
+  // Identical inputs produce identical keys.
+  auto same_state = MakeCompilerState(/* time_now */ 1552607213931245000);
+  EXPECT_EQ(base_key, PlanCache::CacheKey(kBasicQuery, same_state.get(), {}));
+}
+
+TEST_F(PlanCacheTest, lookup_insert_clear) {
+  auto* cache = PlanCache::GetInstance();
+  ASSERT_OK_AND_ASSIGN(auto missing, cache->Lookup("no-such-key"));
+  EXPECT_EQ(nullptr, missing);
+
+  auto compiler_state = MakeCompilerState(/* time_now */ 1552607213931245000);
+  ASSERT_OK_AND_ASSIGN(auto ir, compiler_.CompileToIR(kBasicQuery, compiler_state.get()));
+  cache->Insert("key", *ir);
+  EXPECT_EQ(1, cache->size());
+
+  ASSERT_OK_AND_ASSIGN(auto cached, cache->Lookup("key"));
+  ASSERT_NE(nullptr, cached);
+  // The cached plan is a clone: mutating it must not affect subsequent lookups.
+  ASSERT_OK_AND_ASSIGN(auto cached_proto, cached->ToProto());
+  ASSERT_OK_AND_ASSIGN(auto original_proto, ir->ToProto());
+  EXPECT_THAT(cached_proto, EqualsProto(original_proto.DebugString()));
+
+  cache->Clear();
+  EXPECT_EQ(0, cache->size());
+  ASSERT_OK_AND_ASSIGN(auto after_clear, cache->Lookup("key"));
+  EXPECT_EQ(nullptr, after_clear);
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -96,6 +96,17 @@ struct PluginConfig {
   int64_t end_time_ns;
 };
 
+// Statistics about the stored data of a table, used for cost-based planning decisions.
+// The values are estimates aggregated across agents and may lag the live data.
+struct TableStatistics {
+  // Total number of rows stored for the table.
+  int64_t row_count = 0;
+  // Estimated number of distinct values per column. Columns without an entry have unknown
+  // statistics.
+  absl::flat_hash_map<std::string, int64_t> column_distinct_counts;
+};
+using TableStatsMap = absl::flat_hash_map<std::string, TableStatistics>;
+
 struct OTelDebugAttribute {
   std::string name;
   std::string value;
@@ -110,8 +121,9 @@ using SensitiveColumnMap = absl::flat_hash_map<std::string, absl::flat_hash_set<
 class CompilerState : public NotCopyable {
  public:
   /**
-   * CompilerState manages the state needed to compile a single query. A new one will
-   * be constructed for every query compiled in Carnot and it will not be reused.
+   * CompilerState manages the state needed to compile a single query. A new one is
+   * constructed for every query compiled in Carnot, except for batch compile requests,
+   * which share one state across the scripts of the batch to amortize its construction.
    */
   CompilerState(std::unique_ptr<RelationMap> relation_map,
                 const SensitiveColumnMap& table_names_to_sensitive_columns,
@@ -172,6 +184,19 @@ class CompilerState : public NotCopyable {
   const RedactionOptions& redaction_options() { return redaction_options_; }
   void set_redaction_options(const RedactionOptions& options) { redaction_options_ = options; }
 
+  const TableStatsMap& table_statistics() const { return table_statistics_; }
+  void set_table_statistics(TableStatsMap table_statistics) {
+    table_statistics_ = std::move(table_statistics);
+  }
+  // Returns the statistics for the table, or nullptr if none are known.
+  const TableStatistics* GetTableStatistics(const std::string& table_name) const {
+    auto it = table_statistics_.find(table_name);
+    if (it == table_statistics_.end()) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
   planpb::OTelEndpointConfig* endpoint_config() { return endpoint_config_.get(); }
   PluginConfig* plugin_config() { return plugin_config_.get(); }
   const DebugInfo& debug_info() { return debug_info_; }
@@ -188,6 +213,7 @@ class CompilerState : public NotCopyable {
   const std::string result_address_;
   const std::string result_ssl_targetname_;
   RedactionOptions redaction_options_;
+  TableStatsMap table_statistics_;
   std::unique_ptr<planpb::OTelEndpointConfig> endpoint_config_ = nullptr;
   std::unique_ptr<PluginConfig> plugin_config_ = nullptr;
   DebugInfo debug_info_;
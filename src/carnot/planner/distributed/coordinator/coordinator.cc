@@ -28,6 +28,7 @@
 #include "src/carnot/planner/distributed/coordinator/plan_clusters.h"
 #include "src/carnot/planner/distributed/coordinator/prune_unavailable_sources_rule.h"
 #include "src/carnot/planner/distributed/coordinator/removable_ops_rule.h"
+#include "src/carnot/planner/distributed/coordinator/tablet_source_conversion_rule.h"
 #include "src/carnot/planner/distributed/splitter/splitter.h"
 #include "src/carnot/planner/rules/rules.h"
 #include "src/carnot/udfspb/udfs.pb.h"
@@ -158,10 +159,33 @@ Status CoordinatorImpl::RemoveSourcesAndDependentOperators(
   return plan->Prune(nodes_to_remove);
 }
 
-const distributedpb::CarnotInfo& CoordinatorImpl::GetRemoteProcessor() const {
-  // TODO(philkuz) update this with a more sophisticated strategy in the future.
+const distributedpb::CarnotInfo& CoordinatorImpl::ChooseRemoteProcessor(
+    const IR* logical_plan) const {
   DCHECK_GT(remote_processor_nodes_.size(), 0UL);
-  return remote_processor_nodes_[0];
+  if (remote_processor_nodes_.size() == 1) {
+    return remote_processor_nodes_[0];
+  }
+
+  // Fingerprint the query by its sorted source table names, FNV-1a so the mapping is stable
+  // across processes. Scripts reading the same tables share a Kelvin (keeping its batch caches
+  // warm for periodic re-executions); scripts reading different tables spread across Kelvins.
+  std::vector<std::string> table_names;
+  for (IRNode* node : logical_plan->FindNodesThatMatch(MemorySource())) {
+    table_names.push_back(static_cast<MemorySourceIR*>(node)->table_name());
+  }
+  std::sort(table_names.begin(), table_names.end());
+
+  uint64_t fingerprint = 1469598103934665603ULL;
+  auto mix = [&fingerprint](char c) {
+    fingerprint = (fingerprint ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+  };
+  for (const auto& name : table_names) {
+    for (char c : name) {
+      mix(c);
+    }
+    mix('\0');
+  }
+  return remote_processor_nodes_[fingerprint % remote_processor_nodes_.size()];
 }
 
 /**
@@ -237,13 +261,13 @@ StatusOr<SchemaToAgentsMap> LoadSchemaMap(
 }
 
 StatusOr<std::unique_ptr<DistributedPlan>> CoordinatorImpl::CoordinateImpl(const IR* logical_plan) {
-  // TODO(zasgar) set support_partial_agg to true to enable partial aggs.
   PL_ASSIGN_OR_RETURN(std::unique_ptr<Splitter> splitter,
-                      Splitter::Create(compiler_state_, /* support_partial_agg */ false));
+                      Splitter::Create(compiler_state_, /* support_partial_agg */ true));
   PL_ASSIGN_OR_RETURN(std::unique_ptr<BlockingSplitPlan> split_plan,
                       splitter->SplitKelvinAndAgents(logical_plan));
   auto distributed_plan = std::make_unique<DistributedPlan>();
-  PL_ASSIGN_OR_RETURN(int64_t remote_node_id, distributed_plan->AddCarnot(GetRemoteProcessor()));
+  PL_ASSIGN_OR_RETURN(int64_t remote_node_id,
+                      distributed_plan->AddCarnot(ChooseRemoteProcessor(logical_plan)));
   // TODO(philkuz) Need to update the Blocking Split Plan to better represent what we expect.
   // TODO(philkuz) (PL-1469) Future support for grabbing data from multiple Kelvin nodes.
 
@@ -268,19 +292,46 @@ StatusOr<std::unique_ptr<DistributedPlan>> CoordinatorImpl::CoordinateImpl(const
                       GetUniquePEMPlans(split_plan->before_blocking.get(), distributed_plan.get(),
                                         source_node_ids, agent_schema_map));
 
-  // Add the PEM plans to the distributed plan.
+  // Add the PEM plans to the distributed plan. Agents without a plan were pruned: their
+  // MetadataFilter doesn't match the query's metadata predicates or they lack the source
+  // tables, so no fragment is scheduled (or executed) on them at all.
+  int64_t num_pruned_agents = 0;
   for (const auto carnot_id : source_node_ids) {
     if (!agent_to_plan_map.agent_to_plan_map.contains(carnot_id)) {
       PL_RETURN_IF_ERROR(distributed_plan->DeleteNode(carnot_id));
+      ++num_pruned_agents;
       continue;
     }
     distributed_plan->Get(carnot_id)->AddPlan(agent_to_plan_map.agent_to_plan_map[carnot_id]);
   }
+  distributed_plan->SetAgentPruningStats(static_cast<int64_t>(source_node_ids.size()),
+                                         num_pruned_agents);
+  if (num_pruned_agents > 0) {
+    VLOG(1) << absl::Substitute("Pruned $0 of $1 PEMs from the distributed plan", num_pruned_agents,
+                                source_node_ids.size());
+  }
 
   for (size_t i = 0; i < agent_to_plan_map.plan_pool.size(); ++i) {
     distributed_plan->AddPlan(std::move(agent_to_plan_map.plan_pool[i]));
   }
 
+  // Expand memory sources on tabletized tables into one source per tablet, merged by a Union, so
+  // each tablet is scanned independently and downstream operators consume the merged streams.
+  for (const auto& [pem_plan, agents] : agent_to_plan_map.plan_to_agents) {
+    std::vector<const distributedpb::CarnotInfo*> agent_infos;
+    for (int64_t agent_id : agents) {
+      agent_infos.push_back(&distributed_plan->Get(agent_id)->carnot_info());
+    }
+    // A plan shared by agents with differing tablet layouts can't be tabletized once for all of
+    // them; leave its sources untableted so exec falls back to reading the whole table.
+    if (agent_infos.empty() ||
+        !TabletSourceConversionRule::AgentsShareTabletLayout(agent_infos)) {
+      continue;
+    }
+    TabletSourceConversionRule tablet_rule(*agent_infos[0]);
+    PL_RETURN_IF_ERROR(tablet_rule.Execute(pem_plan));
+  }
+
   // Prune unnecessary sources from the Kelvin plan.
   DistributedPruneUnavailableSourcesRule prune_sources_rule(agent_schema_map);
   PL_RETURN_IF_ERROR(prune_sources_rule.Apply(remote_carnot));
@@ -91,7 +91,19 @@ class CoordinatorImpl : public Coordinator {
   Status ProcessConfigImpl(const CarnotInfo& carnot_info) override;
 
  private:
-  const distributedpb::CarnotInfo& GetRemoteProcessor() const;
+  /**
+   * @brief Deterministically picks one of the available remote processors (Kelvins) for this
+   * query, by hashing a fingerprint of the logical plan's source tables. With more than one
+   * Kelvin deployed, distinct scripts hash to different Kelvins, spreading the cluster-wide
+   * merge work of concurrent queries across the fleet instead of pinning the first Kelvin at
+   * 100%. The fingerprint is stable across query broker restarts, so a periodically re-executed
+   * script keeps landing on the same Kelvin.
+   *
+   * All of a single query's partial aggregates still funnel into the chosen Kelvin;
+   * hash-partitioning one query's group keys across several Kelvins would additionally require
+   * partitioned GRPC sinks in the exec layer and multi-Kelvin stitching (PL-1469).
+   */
+  const distributedpb::CarnotInfo& ChooseRemoteProcessor(const IR* logical_plan) const;
   bool HasExecutableNodes(const IR* plan);
 
   /**
@@ -21,9 +21,12 @@
 #include <gtest/gtest.h>
 
 #include <pypa/parser/parser.hh>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_set.h>
+
 #include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
 #include "src/carnot/planner/compiler/test_utils.h"
 #include "src/carnot/planner/distributed/coordinator/coordinator.h"
@@ -169,6 +172,38 @@ TEST_F(CoordinatorTest, one_pem_three_kelvin) {
   }
 }
 
+// With multiple Kelvins available, the coordinator hashes the query's source tables to pick
+// one: the same query always lands on the same Kelvin, and queries on different tables spread
+// across the fleet.
+TEST_F(CoordinatorTest, kelvin_choice_spreads_across_queries) {
+  auto ps = LoadDistributedStatePb(kOnePEMThreeKelvinsDistributedState);
+
+  auto kelvin_for_table = [&](const std::string& table_name) {
+    graph = std::make_shared<IR>();
+    compiler_state_->relation_map()->emplace(table_name, MakeRelation());
+    auto mem_src = MakeMemSource(table_name, MakeRelation());
+    MakeMemSink(mem_src, "out");
+    ResolveTypesRule rule(compiler_state_.get());
+    PL_CHECK_OK(rule.Execute(graph.get()));
+
+    auto coordinator = Coordinator::Create(compiler_state_.get(), ps).ConsumeValueOrDie();
+    auto physical_plan = coordinator->Coordinate(graph.get()).ConsumeValueOrDie();
+    auto kelvin_address = physical_plan->Get(0)->carnot_info().query_broker_address();
+    EXPECT_THAT(kelvin_address, ContainsRegex("kelvin"));
+    return kelvin_address;
+  };
+
+  absl::flat_hash_set<std::string> chosen_kelvins;
+  for (const auto* table_name : {"table", "http_events", "conn_stats"}) {
+    // Deterministic: re-coordinating the same query picks the same Kelvin.
+    auto first_choice = kelvin_for_table(table_name);
+    EXPECT_EQ(kelvin_for_table(table_name), first_choice);
+    chosen_kelvins.insert(first_choice);
+  }
+  // Distinct queries don't all pin the same Kelvin.
+  EXPECT_GE(chosen_kelvins.size(), 2);
+}
+
 constexpr char kBadAgentSpecificationState[] = R"proto(
 carnot_info {
   query_broker_address: "pem"
@@ -274,6 +309,10 @@ TEST_F(CoordinatorTest, prune_agents_simple) {
 
   auto kelvin_sources = plan_by_qb_addr["kelvin"]->FindNodesThatMatch(GRPCSourceGroup());
   EXPECT_EQ(2, kelvin_sources.size());
+
+  // Three PEMs were considered; pem3 matched neither metadata predicate and was pruned.
+  EXPECT_EQ(3, physical_plan->num_pem_agents_considered());
+  EXPECT_EQ(1, physical_plan->num_pem_agents_pruned());
 }
 
 constexpr char kPruneAgentsDoesNotExist[] = R"pxl(
@@ -298,6 +337,10 @@ TEST_F(CoordinatorTest, prune_agents_nonexistent) {
   plan_by_qb_addr[carnot->QueryBrokerAddress()] = carnot->plan();
 
   EXPECT_EQ(1, plan_by_qb_addr["kelvin"]->FindNodesThatMatch(GRPCSourceGroup()).size());
+
+  // No agent's MetadataFilter contains the pod, so every PEM was pruned.
+  EXPECT_EQ(3, physical_plan->num_pem_agents_considered());
+  EXPECT_EQ(3, physical_plan->num_pem_agents_pruned());
 }
 
 constexpr char kPruneAgentsUnsupportedMDType[] = R"pxl(
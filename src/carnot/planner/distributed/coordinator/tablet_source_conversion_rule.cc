@@ -0,0 +1,115 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "src/carnot/planner/distributed/coordinator/tablet_source_conversion_rule.h"
+#include "src/carnot/planner/ir/ir.h"
+#include "src/carnot/planner/ir/union_ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+TabletSourceConversionRule::TabletSourceConversionRule(const distributedpb::CarnotInfo& carnot_info)
+    : Rule(nullptr, /*use_topo*/ false, /*reverse_topological_execution*/ false),
+      carnot_info_(carnot_info) {}
+
+StatusOr<bool> TabletSourceConversionRule::Apply(IRNode* node) {
+  if (Match(node, MemorySource())) {
+    return MaybeExpandMemorySource(static_cast<MemorySourceIR*>(node));
+  }
+  return false;
+}
+
+const distributedpb::TableInfo* TabletSourceConversionRule::TableInfoForTable(
+    const std::string& table_name) const {
+  for (const auto& table_info : carnot_info_.table_info()) {
+    if (table_info.table() == table_name) {
+      return &table_info;
+    }
+  }
+  return nullptr;
+}
+
+StatusOr<bool> TabletSourceConversionRule::MaybeExpandMemorySource(MemorySourceIR* mem_src) {
+  // Sources that are already pinned to a tablet have been expanded.
+  if (mem_src->HasTablet()) {
+    return false;
+  }
+  const auto* table_info = TableInfoForTable(mem_src->table_name());
+  // With zero or one tablets there is nothing to fan out; the untableted source reads the
+  // default tablet which holds all of the table's data.
+  if (table_info == nullptr || table_info->tablets_size() <= 1) {
+    return false;
+  }
+
+  IR* graph = mem_src->graph();
+  std::vector<OperatorIR*> tablet_sources;
+  for (const auto& tablet : table_info->tablets()) {
+    PL_ASSIGN_OR_RETURN(MemorySourceIR * tablet_src, graph->CopyNode(mem_src));
+    tablet_src->SetTabletValue(tablet);
+    tablet_sources.push_back(tablet_src);
+  }
+
+  PL_ASSIGN_OR_RETURN(UnionIR * union_op,
+                      graph->CreateNode<UnionIR>(mem_src->ast(), tablet_sources));
+  PL_RETURN_IF_ERROR(union_op->SetResolvedType(mem_src->resolved_type()));
+  PL_RETURN_IF_ERROR(union_op->SetDefaultColumnMapping());
+
+  for (OperatorIR* child : mem_src->Children()) {
+    PL_RETURN_IF_ERROR(child->ReplaceParent(mem_src, union_op));
+  }
+  PL_RETURN_IF_ERROR(graph->DeleteNode(mem_src->id()));
+  return true;
+}
+
+bool TabletSourceConversionRule::AgentsShareTabletLayout(
+    const std::vector<const distributedpb::CarnotInfo*>& infos) {
+  // Maps table name -> (tabletization key, sorted tablet values). TableInfo order and tablet
+  // order within a TableInfo are not significant, so normalize before comparing.
+  using TabletLayout = std::map<std::string, std::pair<std::string, std::vector<std::string>>>;
+  auto layout_for = [](const distributedpb::CarnotInfo* info) {
+    TabletLayout layout;
+    for (const auto& table_info : info->table_info()) {
+      std::vector<std::string> tablets(table_info.tablets().begin(), table_info.tablets().end());
+      std::sort(tablets.begin(), tablets.end());
+      layout[table_info.table()] = {table_info.tabletization_key(), std::move(tablets)};
+    }
+    return layout;
+  };
+
+  if (infos.empty()) {
+    return true;
+  }
+  TabletLayout first_layout = layout_for(infos[0]);
+  for (size_t i = 1; i < infos.size(); ++i) {
+    if (layout_for(infos[i]) != first_layout) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
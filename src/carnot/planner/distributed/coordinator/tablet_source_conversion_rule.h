@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "src/carnot/planner/distributed/distributed_plan/distributed_plan.h"
+#include "src/carnot/planner/distributed/distributed_rules.h"
+#include "src/carnot/planner/ir/memory_source_ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+/**
+ * @brief This rule expands a MemorySource on a tabletized table into one MemorySource per tablet,
+ * merged back together with a Union. The CarnotInfo for an agent lists the tablet values it holds
+ * for each table (TableInfo); each expanded source carries one of those tablet values so that at
+ * exec time MemorySourceNode reads from the corresponding tablet instead of the whole table. Any
+ * operator downstream of the Union (including aggregates) then consumes the merged per-tablet
+ * streams.
+ *
+ * Memory sources that already have a tablet value, or whose table has at most one tablet on this
+ * agent, are left untouched.
+ */
+class TabletSourceConversionRule : public Rule {
+ public:
+  explicit TabletSourceConversionRule(const distributedpb::CarnotInfo& carnot_info);
+  StatusOr<bool> Apply(IRNode* node) override;
+
+  /**
+   * @brief Returns true if every passed-in agent reports the same tablet layout (the same tablet
+   * values and tabletization key for every table). A plan that is shared by several agents can
+   * only be tabletized once, with one agent's CarnotInfo, when this holds.
+   */
+  static bool AgentsShareTabletLayout(const std::vector<const distributedpb::CarnotInfo*>& infos);
+
+ private:
+  StatusOr<bool> MaybeExpandMemorySource(MemorySourceIR* mem_src);
+  const distributedpb::TableInfo* TableInfoForTable(const std::string& table_name) const;
+
+  const distributedpb::CarnotInfo& carnot_info_;
+};
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/test_utils.h"
+#include "src/carnot/planner/distributed/coordinator/tablet_source_conversion_rule.h"
+#include "src/carnot/planner/ir/union_ir.h"
+#include "src/carnot/planner/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+using table_store::schema::Relation;
+using testutils::DistributedRulesTest;
+
+using TabletSourceConversionRuleTest = DistributedRulesTest;
+
+distributedpb::CarnotInfo CarnotInfoWithTablets(
+    const std::string& table, const std::vector<std::string>& tablets) {
+  distributedpb::CarnotInfo carnot_info;
+  auto table_info = carnot_info.add_table_info();
+  table_info->set_table(table);
+  table_info->set_tabletization_key("upid");
+  for (const auto& tablet : tablets) {
+    table_info->add_tablets(tablet);
+  }
+  return carnot_info;
+}
+
+TEST_F(TabletSourceConversionRuleTest, ExpandsSourceIntoPerTabletUnion) {
+  Relation relation{{types::TIME64NS, types::INT64}, {"time_", "rx_bytes"}};
+  auto mem_src = MakeMemSource("http_events", relation);
+  EXPECT_OK(mem_src->SetResolvedType(TableType::Create(relation)));
+  auto mem_sink = MakeMemSink(mem_src, "output");
+  auto mem_src_id = mem_src->id();
+
+  auto carnot_info = CarnotInfoWithTablets("http_events", {"tablet_a", "tablet_b", "tablet_c"});
+  TabletSourceConversionRule rule(carnot_info);
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ConsumeValueOrDie());
+
+  // The original source is replaced by a Union over one source per tablet.
+  EXPECT_FALSE(graph->HasNode(mem_src_id));
+  ASSERT_EQ(mem_sink->parents().size(), 1UL);
+  auto union_op = mem_sink->parents()[0];
+  ASSERT_MATCH(union_op, Union());
+  EXPECT_TRUE(union_op->resolved_type()->Equals(TableType::Create(relation)));
+
+  ASSERT_EQ(union_op->parents().size(), 3UL);
+  std::vector<std::string> tablet_values;
+  for (OperatorIR* parent : union_op->parents()) {
+    ASSERT_MATCH(parent, MemorySource());
+    auto tablet_src = static_cast<MemorySourceIR*>(parent);
+    EXPECT_EQ(tablet_src->table_name(), "http_events");
+    ASSERT_TRUE(tablet_src->HasTablet());
+    tablet_values.push_back(tablet_src->tablet_value());
+  }
+  EXPECT_THAT(tablet_values,
+              ::testing::UnorderedElementsAre("tablet_a", "tablet_b", "tablet_c"));
+}
+
+TEST_F(TabletSourceConversionRuleTest, SingleTabletAndUnknownTablesAreUntouched) {
+  Relation relation{{types::TIME64NS, types::INT64}, {"time_", "rx_bytes"}};
+  auto single_tablet_src = MakeMemSource("http_events", relation);
+  EXPECT_OK(single_tablet_src->SetResolvedType(TableType::Create(relation)));
+  MakeMemSink(single_tablet_src, "output1");
+  auto unknown_table_src = MakeMemSource("other_table", relation);
+  EXPECT_OK(unknown_table_src->SetResolvedType(TableType::Create(relation)));
+  MakeMemSink(unknown_table_src, "output2");
+
+  auto carnot_info = CarnotInfoWithTablets("http_events", {"tablet_a"});
+  TabletSourceConversionRule rule(carnot_info);
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_FALSE(single_tablet_src->HasTablet());
+  EXPECT_FALSE(unknown_table_src->HasTablet());
+}
+
+TEST_F(TabletSourceConversionRuleTest, AlreadyTabletedSourceIsUntouched) {
+  Relation relation{{types::TIME64NS, types::INT64}, {"time_", "rx_bytes"}};
+  auto mem_src = MakeMemSource("http_events", relation);
+  EXPECT_OK(mem_src->SetResolvedType(TableType::Create(relation)));
+  mem_src->SetTabletValue("tablet_a");
+  MakeMemSink(mem_src, "output");
+
+  auto carnot_info = CarnotInfoWithTablets("http_events", {"tablet_a", "tablet_b"});
+  TabletSourceConversionRule rule(carnot_info);
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_EQ(mem_src->tablet_value(), "tablet_a");
+}
+
+TEST_F(TabletSourceConversionRuleTest, AgentsShareTabletLayout) {
+  auto info_a = CarnotInfoWithTablets("http_events", {"tablet_a", "tablet_b"});
+  // Same layout with tablets listed in a different order.
+  auto info_b = CarnotInfoWithTablets("http_events", {"tablet_b", "tablet_a"});
+  auto info_c = CarnotInfoWithTablets("http_events", {"tablet_a", "tablet_c"});
+
+  EXPECT_TRUE(TabletSourceConversionRule::AgentsShareTabletLayout({&info_a, &info_b}));
+  EXPECT_FALSE(TabletSourceConversionRule::AgentsShareTabletLayout({&info_a, &info_c}));
+  EXPECT_TRUE(TabletSourceConversionRule::AgentsShareTabletLayout({}));
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
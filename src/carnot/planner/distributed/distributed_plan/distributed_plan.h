@@ -164,6 +164,20 @@ class DistributedPlan {
 
   CarnotInstance* kelvin() const { return kelvin_; }
 
+  /**
+   * @brief Records how many PEMs were considered for this query and how many were pruned
+   * because their plan fragment could not produce data (e.g. the query's metadata predicates
+   * do not match the agent's MetadataFilter, or the agent lacks the source table). Scoped
+   * queries routinely prune the vast majority of agents, so the counts are surfaced for
+   * query stats rather than leaving the pruning invisible.
+   */
+  void SetAgentPruningStats(int64_t num_considered, int64_t num_pruned) {
+    num_pem_agents_considered_ = num_considered;
+    num_pem_agents_pruned_ = num_pruned;
+  }
+  int64_t num_pem_agents_considered() const { return num_pem_agents_considered_; }
+  int64_t num_pem_agents_pruned() const { return num_pem_agents_pruned_; }
+
  private:
   plan::DAG dag_;
   absl::flat_hash_map<int64_t, std::unique_ptr<CarnotInstance>> id_to_node_map_;
@@ -176,6 +190,8 @@ class DistributedPlan {
   planpb::PlanOptions plan_options_;
   std::string exec_complete_address_;
   std::string exec_complete_ssl_targetname_;
+  int64_t num_pem_agents_considered_ = 0;
+  int64_t num_pem_agents_pruned_ = 0;
 };
 
 }  // namespace distributed
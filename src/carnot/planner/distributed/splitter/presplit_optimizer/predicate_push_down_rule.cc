@@ -0,0 +1,166 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_push_down_rule.h"
+#include "src/carnot/planner/ir/column_ir.h"
+#include "src/carnot/planner/ir/data_ir.h"
+#include "src/carnot/planner/ir/func_ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+namespace {
+
+using ScanPredicate = planpb::MemorySourceOperator::ColumnPredicate;
+
+// Maps a comparison opcode onto the scan predicate op, normalized so the column is on the
+// left-hand side. Strict comparisons are widened to their inclusive counterparts: the scan
+// only skips a batch when its statistics prove no row can match, so widening is safe and
+// only forgoes pruning of batches where the boundary value is the sole match.
+std::optional<ScanPredicate::Op> ScanOpForOpcode(FuncIR::Opcode opcode, bool column_on_left) {
+  switch (opcode) {
+    case FuncIR::Opcode::eq:
+      return ScanPredicate::EQUAL;
+    case FuncIR::Opcode::lt:
+    case FuncIR::Opcode::lteq:
+      return column_on_left ? ScanPredicate::LESS_THAN_OR_EQUAL
+                            : ScanPredicate::GREATER_THAN_OR_EQUAL;
+    case FuncIR::Opcode::gt:
+    case FuncIR::Opcode::gteq:
+      return column_on_left ? ScanPredicate::GREATER_THAN_OR_EQUAL
+                            : ScanPredicate::LESS_THAN_OR_EQUAL;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+StatusOr<bool> PredicatePushdownRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Filter())) {
+    return false;
+  }
+  auto filter = static_cast<FilterIR*>(ir_node);
+  if (handled_filter_ids_.contains(filter->id())) {
+    return false;
+  }
+  DCHECK_EQ(filter->parents().size(), 1UL);
+  OperatorIR* parent = filter->parents()[0];
+  if (!Match(parent, MemorySource())) {
+    return false;
+  }
+  // A source with several children also feeds operators that don't go through this filter,
+  // so predicates from this filter alone must not constrain the scan.
+  if (parent->Children().size() != 1) {
+    return false;
+  }
+  handled_filter_ids_.insert(filter->id());
+  return ExtractPredicates(filter, static_cast<MemorySourceIR*>(parent));
+}
+
+StatusOr<bool> PredicatePushdownRule::ExtractPredicates(FilterIR* filter, MemorySourceIR* src) {
+  std::vector<ExpressionIR*> conjuncts;
+  CollectConjuncts(filter->filter_expr(), &conjuncts);
+  bool changed = false;
+  for (ExpressionIR* conjunct : conjuncts) {
+    PL_ASSIGN_OR_RETURN(bool pushed, MaybePushConjunct(conjunct, src));
+    changed |= pushed;
+  }
+  return changed;
+}
+
+void PredicatePushdownRule::CollectConjuncts(ExpressionIR* expr,
+                                             std::vector<ExpressionIR*>* conjuncts) {
+  if (Match(expr, Func())) {
+    auto func = static_cast<FuncIR*>(expr);
+    if (func->opcode() == FuncIR::Opcode::logand) {
+      for (ExpressionIR* arg : func->args()) {
+        CollectConjuncts(arg, conjuncts);
+      }
+      return;
+    }
+  }
+  conjuncts->push_back(expr);
+}
+
+StatusOr<bool> PredicatePushdownRule::MaybePushConjunct(ExpressionIR* conjunct,
+                                                        MemorySourceIR* src) {
+  if (!Match(conjunct, Func())) {
+    return false;
+  }
+  auto func = static_cast<FuncIR*>(conjunct);
+  if (func->args().size() != 2) {
+    return false;
+  }
+  ExpressionIR* left = func->args()[0];
+  ExpressionIR* right = func->args()[1];
+  ColumnIR* column;
+  DataIR* literal;
+  bool column_on_left;
+  if (left->IsColumn() && right->IsData()) {
+    column = static_cast<ColumnIR*>(left);
+    literal = static_cast<DataIR*>(right);
+    column_on_left = true;
+  } else if (left->IsData() && right->IsColumn()) {
+    column = static_cast<ColumnIR*>(right);
+    literal = static_cast<DataIR*>(left);
+    column_on_left = false;
+  } else {
+    return false;
+  }
+
+  auto op = ScanOpForOpcode(func->opcode(), column_on_left);
+  if (!op.has_value()) {
+    return false;
+  }
+
+  DCHECK(src->column_index_map_set());
+  DCHECK(src->is_type_resolved());
+  const auto& col_names = src->resolved_table_type()->ColumnNames();
+  auto col_it = std::find(col_names.begin(), col_names.end(), column->col_name());
+  if (col_it == col_names.end()) {
+    return false;
+  }
+  auto col_idx = std::distance(col_names.begin(), col_it);
+
+  // Only push comparisons between same-typed values; the scan compares the literal against
+  // raw column statistics without casting.
+  PL_ASSIGN_OR_RETURN(auto col_type, src->resolved_table_type()->GetColumnType(*col_it));
+  if (std::static_pointer_cast<ValueType>(col_type)->data_type() != literal->EvaluatedDataType()) {
+    return false;
+  }
+
+  MemorySourceIR::ColumnPredicate pred;
+  pred.column_index = src->column_index_map()[col_idx];
+  pred.op = op.value();
+  PL_RETURN_IF_ERROR(literal->ToProto(&pred.value));
+  src->AddPredicate(std::move(pred));
+  return true;
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
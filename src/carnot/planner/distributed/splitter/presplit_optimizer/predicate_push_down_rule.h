@@ -0,0 +1,64 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "src/carnot/planner/ir/filter_ir.h"
+#include "src/carnot/planner/ir/memory_source_ir.h"
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+/**
+ * @brief Extracts conjuncts of the form `column <op> literal` from filters that read directly
+ * from a memory source and records them as scan predicates on the source.
+ *
+ * The scan uses the predicates to skip batches whose per-batch column statistics prove that
+ * no row can match. The predicates are advisory, so the filter stays in the plan and strict
+ * comparisons can be widened to their inclusive counterparts. This rule must run after
+ * FilterPushdownRule so that filters sit as close to their sources as possible.
+ */
+class PredicatePushdownRule : public Rule {
+ public:
+  explicit PredicatePushdownRule(CompilerState* compiler_state)
+      : Rule(compiler_state, /*use_topo*/ true, /*reverse_topological_execution*/ false) {}
+
+ protected:
+  StatusOr<bool> Apply(IRNode*) override;
+
+ private:
+  StatusOr<bool> ExtractPredicates(FilterIR* filter, MemorySourceIR* src);
+  StatusOr<bool> MaybePushConjunct(ExpressionIR* conjunct, MemorySourceIR* src);
+
+  // Collects the conjuncts of the expression, recursing through logical ands.
+  static void CollectConjuncts(ExpressionIR* expr, std::vector<ExpressionIR*>* conjuncts);
+
+  // Filters that have already been handled, so repeated executions of the rule don't record
+  // the same predicates again.
+  absl::flat_hash_set<int64_t> handled_filter_ids_;
+};
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
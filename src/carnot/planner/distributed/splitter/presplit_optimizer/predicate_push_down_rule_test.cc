@@ -0,0 +1,146 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_push_down_rule.h"
+#include "src/carnot/planner/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+using compiler::ResolveTypesRule;
+using ScanPredicate = planpb::MemorySourceOperator::ColumnPredicate;
+
+using PredicatePushdownTest = testutils::DistributedRulesTest;
+
+TEST_F(PredicatePushdownTest, pushes_conjuncts) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+
+  auto eq_func = MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(10));
+  auto lteq_func =
+      graph
+          ->CreateNode<FuncIR>(ast, FuncIR::op_map.find("<=")->second,
+                               std::vector<ExpressionIR*>({MakeColumn("xyz", 0), MakeInt(20)}))
+          .ConsumeValueOrDie();
+  FilterIR* filter = MakeFilter(src, MakeAndFunc(eq_func, lteq_func));
+  MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  PredicatePushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  ASSERT_EQ(2UL, src->predicates().size());
+  EXPECT_EQ(0, src->predicates()[0].column_index);
+  EXPECT_EQ(ScanPredicate::EQUAL, src->predicates()[0].op);
+  EXPECT_EQ(10, src->predicates()[0].value.int64_value());
+  EXPECT_EQ(1, src->predicates()[1].column_index);
+  EXPECT_EQ(ScanPredicate::LESS_THAN_OR_EQUAL, src->predicates()[1].op);
+  EXPECT_EQ(20, src->predicates()[1].value.int64_value());
+
+  // A second execution must not record the predicates again.
+  result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+  EXPECT_EQ(2UL, src->predicates().size());
+}
+
+TEST_F(PredicatePushdownTest, flips_op_when_literal_is_on_the_left) {
+  Relation relation({types::DataType::INT64}, {"abc"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+
+  // 5 < abc constrains abc from below, so the scan predicate is abc >= 5 (strict comparisons
+  // are widened to their inclusive counterparts).
+  auto lt_func =
+      graph
+          ->CreateNode<FuncIR>(ast, FuncIR::op_map.find("<")->second,
+                               std::vector<ExpressionIR*>({MakeInt(5), MakeColumn("abc", 0)}))
+          .ConsumeValueOrDie();
+  FilterIR* filter = MakeFilter(src, lt_func);
+  MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  PredicatePushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  ASSERT_EQ(1UL, src->predicates().size());
+  EXPECT_EQ(ScanPredicate::GREATER_THAN_OR_EQUAL, src->predicates()[0].op);
+  EXPECT_EQ(5, src->predicates()[0].value.int64_value());
+}
+
+TEST_F(PredicatePushdownTest, no_push_for_column_to_column_comparison) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+
+  auto eq_func = MakeEqualsFunc(MakeColumn("abc", 0), MakeColumn("xyz", 0));
+  FilterIR* filter = MakeFilter(src, eq_func);
+  MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  PredicatePushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+  EXPECT_TRUE(src->predicates().empty());
+}
+
+TEST_F(PredicatePushdownTest, no_push_when_source_has_multiple_children) {
+  Relation relation({types::DataType::INT64}, {"abc"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+
+  auto eq_func = MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(10));
+  FilterIR* filter = MakeFilter(src, eq_func);
+  MakeMemSink(filter, "foo", {});
+  // The second child reads the unfiltered table, so the filter's predicates must not
+  // constrain the shared scan.
+  MakeMemSink(src, "bar", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  PredicatePushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+  EXPECT_TRUE(src->predicates().empty());
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -22,6 +22,7 @@
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/carnot/planner/distributed/splitter/presplit_optimizer/filter_push_down_rule.h"
 #include "src/carnot/planner/distributed/splitter/presplit_optimizer/limit_push_down_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_push_down_rule.h"
 #include "src/carnot/planner/rules/rule_executor.h"
 
 namespace px {
@@ -59,9 +60,17 @@ class PreSplitOptimizer : public RuleExecutor<IR> {
     filter_pushdown->AddRule<FilterPushdownRule>(compiler_state_);
   }
 
+  void CreatePredicatePushdownBatch() {
+    // Runs after filter pushdown so filters sit directly above their sources. The rule tracks
+    // which filters it has handled, so a second iteration makes no further changes.
+    RuleBatch* predicate_pushdown = CreateRuleBatch<FailOnMax>("PredicatePushdown", 2);
+    predicate_pushdown->AddRule<PredicatePushdownRule>(compiler_state_);
+  }
+
   Status Init() {
     CreateLimitPushdownBatch();
     CreateFilterPushdownBatch();
+    CreatePredicatePushdownBatch();
     return Status::OK();
   }
 
@@ -294,16 +294,119 @@ func (m *TableInfo) GetTablets() []string {
 	return nil
 }
 
+type TableStatistics struct {
+	RowCount         int64                               `protobuf:"varint,1,opt,name=row_count,json=rowCount,proto3" json:"row_count,omitempty"`
+	ColumnStatistics []*TableStatistics_ColumnStatistics `protobuf:"bytes,2,rep,name=column_statistics,json=columnStatistics,proto3" json:"column_statistics,omitempty"`
+}
+
+func (m *TableStatistics) Reset()      { *m = TableStatistics{} }
+func (*TableStatistics) ProtoMessage() {}
+func (*TableStatistics) Descriptor() ([]byte, []int) {
+	return fileDescriptor_30dce4250507a2af, []int{3}
+}
+func (m *TableStatistics) XXX_Unmarshal(b []byte) error {
+	return m.Unmarshal(b)
+}
+func (m *TableStatistics) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	if deterministic {
+		return xxx_messageInfo_TableStatistics.Marshal(b, m, deterministic)
+	} else {
+		b = b[:cap(b)]
+		n, err := m.MarshalToSizedBuffer(b)
+		if err != nil {
+			return nil, err
+		}
+		return b[:n], nil
+	}
+}
+func (m *TableStatistics) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_TableStatistics.Merge(m, src)
+}
+func (m *TableStatistics) XXX_Size() int {
+	return m.Size()
+}
+func (m *TableStatistics) XXX_DiscardUnknown() {
+	xxx_messageInfo_TableStatistics.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_TableStatistics proto.InternalMessageInfo
+
+func (m *TableStatistics) GetRowCount() int64 {
+	if m != nil {
+		return m.RowCount
+	}
+	return 0
+}
+
+func (m *TableStatistics) GetColumnStatistics() []*TableStatistics_ColumnStatistics {
+	if m != nil {
+		return m.ColumnStatistics
+	}
+	return nil
+}
+
+type TableStatistics_ColumnStatistics struct {
+	ColumnName    string `protobuf:"bytes,1,opt,name=column_name,json=columnName,proto3" json:"column_name,omitempty"`
+	DistinctCount int64  `protobuf:"varint,2,opt,name=distinct_count,json=distinctCount,proto3" json:"distinct_count,omitempty"`
+}
+
+func (m *TableStatistics_ColumnStatistics) Reset()      { *m = TableStatistics_ColumnStatistics{} }
+func (*TableStatistics_ColumnStatistics) ProtoMessage() {}
+func (*TableStatistics_ColumnStatistics) Descriptor() ([]byte, []int) {
+	return fileDescriptor_30dce4250507a2af, []int{3, 0}
+}
+func (m *TableStatistics_ColumnStatistics) XXX_Unmarshal(b []byte) error {
+	return m.Unmarshal(b)
+}
+func (m *TableStatistics_ColumnStatistics) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	if deterministic {
+		return xxx_messageInfo_TableStatistics_ColumnStatistics.Marshal(b, m, deterministic)
+	} else {
+		b = b[:cap(b)]
+		n, err := m.MarshalToSizedBuffer(b)
+		if err != nil {
+			return nil, err
+		}
+		return b[:n], nil
+	}
+}
+func (m *TableStatistics_ColumnStatistics) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_TableStatistics_ColumnStatistics.Merge(m, src)
+}
+func (m *TableStatistics_ColumnStatistics) XXX_Size() int {
+	return m.Size()
+}
+func (m *TableStatistics_ColumnStatistics) XXX_DiscardUnknown() {
+	xxx_messageInfo_TableStatistics_ColumnStatistics.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_TableStatistics_ColumnStatistics proto.InternalMessageInfo
+
+func (m *TableStatistics_ColumnStatistics) GetColumnName() string {
+	if m != nil {
+		return m.ColumnName
+	}
+	return ""
+}
+
+func (m *TableStatistics_ColumnStatistics) GetDistinctCount() int64 {
+	if m != nil {
+		return m.DistinctCount
+	}
+	return 0
+}
+
 type SchemaInfo struct {
-	Name      string             `protobuf:"bytes,1,opt,name=name,proto3" json:"name,omitempty"`
-	Relation  *schemapb.Relation `protobuf:"bytes,2,opt,name=relation,proto3" json:"relation,omitempty"`
-	AgentList []*uuidpb.UUID     `protobuf:"bytes,3,rep,name=agent_list,json=agentList,proto3" json:"agent_list,omitempty"`
+	Name       string             `protobuf:"bytes,1,opt,name=name,proto3" json:"name,omitempty"`
+	Relation   *schemapb.Relation `protobuf:"bytes,2,opt,name=relation,proto3" json:"relation,omitempty"`
+	AgentList  []*uuidpb.UUID     `protobuf:"bytes,3,rep,name=agent_list,json=agentList,proto3" json:"agent_list,omitempty"`
+	Statistics *TableStatistics   `protobuf:"bytes,4,opt,name=statistics,proto3" json:"statistics,omitempty"`
 }
 
 func (m *SchemaInfo) Reset()      { *m = SchemaInfo{} }
 func (*SchemaInfo) ProtoMessage() {}
 func (*SchemaInfo) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{3}
+	return fileDescriptor_30dce4250507a2af, []int{4}
 }
 func (m *SchemaInfo) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -353,6 +456,13 @@ func (m *SchemaInfo) GetAgentList() []*uuidpb.UUID {
 	return nil
 }
 
+func (m *SchemaInfo) GetStatistics() *TableStatistics {
+	if m != nil {
+		return m.Statistics
+	}
+	return nil
+}
+
 type DistributedState struct {
 	CarnotInfo []*CarnotInfo `protobuf:"bytes,1,rep,name=carnot_info,json=carnotInfo,proto3" json:"carnot_info,omitempty"`
 	SchemaInfo []*SchemaInfo `protobuf:"bytes,2,rep,name=schema_info,json=schemaInfo,proto3" json:"schema_info,omitempty"`
@@ -361,7 +471,7 @@ type DistributedState struct {
 func (m *DistributedState) Reset()      { *m = DistributedState{} }
 func (*DistributedState) ProtoMessage() {}
 func (*DistributedState) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{4}
+	return fileDescriptor_30dce4250507a2af, []int{5}
 }
 func (m *DistributedState) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -413,7 +523,7 @@ type DistributedPlan struct {
 func (m *DistributedPlan) Reset()      { *m = DistributedPlan{} }
 func (*DistributedPlan) ProtoMessage() {}
 func (*DistributedPlan) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{5}
+	return fileDescriptor_30dce4250507a2af, []int{6}
 }
 func (m *DistributedPlan) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -471,7 +581,7 @@ type RedactionOptions struct {
 func (m *RedactionOptions) Reset()      { *m = RedactionOptions{} }
 func (*RedactionOptions) ProtoMessage() {}
 func (*RedactionOptions) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{6}
+	return fileDescriptor_30dce4250507a2af, []int{7}
 }
 func (m *RedactionOptions) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -523,7 +633,7 @@ type OTelEndpointConfig struct {
 func (m *OTelEndpointConfig) Reset()      { *m = OTelEndpointConfig{} }
 func (*OTelEndpointConfig) ProtoMessage() {}
 func (*OTelEndpointConfig) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{7}
+	return fileDescriptor_30dce4250507a2af, []int{8}
 }
 func (m *OTelEndpointConfig) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -581,7 +691,7 @@ type PluginConfig struct {
 func (m *PluginConfig) Reset()      { *m = PluginConfig{} }
 func (*PluginConfig) ProtoMessage() {}
 func (*PluginConfig) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{8}
+	return fileDescriptor_30dce4250507a2af, []int{9}
 }
 func (m *PluginConfig) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -631,7 +741,7 @@ type DebugInfo struct {
 func (m *DebugInfo) Reset()      { *m = DebugInfo{} }
 func (*DebugInfo) ProtoMessage() {}
 func (*DebugInfo) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{9}
+	return fileDescriptor_30dce4250507a2af, []int{10}
 }
 func (m *DebugInfo) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -675,7 +785,7 @@ type DebugInfo_OTelDebugAttribute struct {
 func (m *DebugInfo_OTelDebugAttribute) Reset()      { *m = DebugInfo_OTelDebugAttribute{} }
 func (*DebugInfo_OTelDebugAttribute) ProtoMessage() {}
 func (*DebugInfo_OTelDebugAttribute) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{9, 0}
+	return fileDescriptor_30dce4250507a2af, []int{10, 0}
 }
 func (m *DebugInfo_OTelDebugAttribute) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -732,7 +842,7 @@ type LogicalPlannerState struct {
 func (m *LogicalPlannerState) Reset()      { *m = LogicalPlannerState{} }
 func (*LogicalPlannerState) ProtoMessage() {}
 func (*LogicalPlannerState) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{10}
+	return fileDescriptor_30dce4250507a2af, []int{11}
 }
 func (m *LogicalPlannerState) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -817,6 +927,73 @@ func (m *LogicalPlannerState) GetDebugInfo() *DebugInfo {
 	return nil
 }
 
+type LogicalPlannerStateUpdate struct {
+	UpdatedCarnotInfo []*CarnotInfo  `protobuf:"bytes,1,rep,name=updated_carnot_info,json=updatedCarnotInfo,proto3" json:"updated_carnot_info,omitempty"`
+	RemovedAgents     []*uuidpb.UUID `protobuf:"bytes,2,rep,name=removed_agents,json=removedAgents,proto3" json:"removed_agents,omitempty"`
+	UpdatedSchemaInfo []*SchemaInfo  `protobuf:"bytes,3,rep,name=updated_schema_info,json=updatedSchemaInfo,proto3" json:"updated_schema_info,omitempty"`
+	RemovedTables     []string       `protobuf:"bytes,4,rep,name=removed_tables,json=removedTables,proto3" json:"removed_tables,omitempty"`
+}
+
+func (m *LogicalPlannerStateUpdate) Reset()      { *m = LogicalPlannerStateUpdate{} }
+func (*LogicalPlannerStateUpdate) ProtoMessage() {}
+func (*LogicalPlannerStateUpdate) Descriptor() ([]byte, []int) {
+	return fileDescriptor_30dce4250507a2af, []int{12}
+}
+func (m *LogicalPlannerStateUpdate) XXX_Unmarshal(b []byte) error {
+	return m.Unmarshal(b)
+}
+func (m *LogicalPlannerStateUpdate) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	if deterministic {
+		return xxx_messageInfo_LogicalPlannerStateUpdate.Marshal(b, m, deterministic)
+	} else {
+		b = b[:cap(b)]
+		n, err := m.MarshalToSizedBuffer(b)
+		if err != nil {
+			return nil, err
+		}
+		return b[:n], nil
+	}
+}
+func (m *LogicalPlannerStateUpdate) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_LogicalPlannerStateUpdate.Merge(m, src)
+}
+func (m *LogicalPlannerStateUpdate) XXX_Size() int {
+	return m.Size()
+}
+func (m *LogicalPlannerStateUpdate) XXX_DiscardUnknown() {
+	xxx_messageInfo_LogicalPlannerStateUpdate.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_LogicalPlannerStateUpdate proto.InternalMessageInfo
+
+func (m *LogicalPlannerStateUpdate) GetUpdatedCarnotInfo() []*CarnotInfo {
+	if m != nil {
+		return m.UpdatedCarnotInfo
+	}
+	return nil
+}
+
+func (m *LogicalPlannerStateUpdate) GetRemovedAgents() []*uuidpb.UUID {
+	if m != nil {
+		return m.RemovedAgents
+	}
+	return nil
+}
+
+func (m *LogicalPlannerStateUpdate) GetUpdatedSchemaInfo() []*SchemaInfo {
+	if m != nil {
+		return m.UpdatedSchemaInfo
+	}
+	return nil
+}
+
+func (m *LogicalPlannerStateUpdate) GetRemovedTables() []string {
+	if m != nil {
+		return m.RemovedTables
+	}
+	return nil
+}
+
 type LogicalPlannerResult struct {
 	Status *statuspb.Status `protobuf:"bytes,1,opt,name=status,proto3" json:"status,omitempty"`
 	Plan   *DistributedPlan `protobuf:"bytes,2,opt,name=plan,proto3" json:"plan,omitempty"`
@@ -825,7 +1002,7 @@ type LogicalPlannerResult struct {
 func (m *LogicalPlannerResult) Reset()      { *m = LogicalPlannerResult{} }
 func (*LogicalPlannerResult) ProtoMessage() {}
 func (*LogicalPlannerResult) Descriptor() ([]byte, []int) {
-	return fileDescriptor_30dce4250507a2af, []int{11}
+	return fileDescriptor_30dce4250507a2af, []int{13}
 }
 func (m *LogicalPlannerResult) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -868,10 +1045,63 @@ func (m *LogicalPlannerResult) GetPlan() *DistributedPlan {
 	return nil
 }
 
+type BatchLogicalPlannerResult struct {
+	Status  *statuspb.Status        `protobuf:"bytes,1,opt,name=status,proto3" json:"status,omitempty"`
+	Results []*LogicalPlannerResult `protobuf:"bytes,2,rep,name=results,proto3" json:"results,omitempty"`
+}
+
+func (m *BatchLogicalPlannerResult) Reset()      { *m = BatchLogicalPlannerResult{} }
+func (*BatchLogicalPlannerResult) ProtoMessage() {}
+func (*BatchLogicalPlannerResult) Descriptor() ([]byte, []int) {
+	return fileDescriptor_30dce4250507a2af, []int{14}
+}
+func (m *BatchLogicalPlannerResult) XXX_Unmarshal(b []byte) error {
+	return m.Unmarshal(b)
+}
+func (m *BatchLogicalPlannerResult) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	if deterministic {
+		return xxx_messageInfo_BatchLogicalPlannerResult.Marshal(b, m, deterministic)
+	} else {
+		b = b[:cap(b)]
+		n, err := m.MarshalToSizedBuffer(b)
+		if err != nil {
+			return nil, err
+		}
+		return b[:n], nil
+	}
+}
+func (m *BatchLogicalPlannerResult) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_BatchLogicalPlannerResult.Merge(m, src)
+}
+func (m *BatchLogicalPlannerResult) XXX_Size() int {
+	return m.Size()
+}
+func (m *BatchLogicalPlannerResult) XXX_DiscardUnknown() {
+	xxx_messageInfo_BatchLogicalPlannerResult.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_BatchLogicalPlannerResult proto.InternalMessageInfo
+
+func (m *BatchLogicalPlannerResult) GetStatus() *statuspb.Status {
+	if m != nil {
+		return m.Status
+	}
+	return nil
+}
+
+func (m *BatchLogicalPlannerResult) GetResults() []*LogicalPlannerResult {
+	if m != nil {
+		return m.Results
+	}
+	return nil
+}
+
 func init() {
 	proto.RegisterType((*MetadataInfo)(nil), "px.carnot.planner.distributedpb.MetadataInfo")
 	proto.RegisterType((*CarnotInfo)(nil), "px.carnot.planner.distributedpb.CarnotInfo")
 	proto.RegisterType((*TableInfo)(nil), "px.carnot.planner.distributedpb.TableInfo")
+	proto.RegisterType((*TableStatistics)(nil), "px.carnot.planner.distributedpb.TableStatistics")
+	proto.RegisterType((*TableStatistics_ColumnStatistics)(nil), "px.carnot.planner.distributedpb.TableStatistics.ColumnStatistics")
 	proto.RegisterType((*SchemaInfo)(nil), "px.carnot.planner.distributedpb.SchemaInfo")
 	proto.RegisterType((*DistributedState)(nil), "px.carnot.planner.distributedpb.DistributedState")
 	proto.RegisterType((*DistributedPlan)(nil), "px.carnot.planner.distributedpb.DistributedPlan")
@@ -884,7 +1114,9 @@ func init() {
 	proto.RegisterType((*DebugInfo)(nil), "px.carnot.planner.distributedpb.DebugInfo")
 	proto.RegisterType((*DebugInfo_OTelDebugAttribute)(nil), "px.carnot.planner.distributedpb.DebugInfo.OTelDebugAttribute")
 	proto.RegisterType((*LogicalPlannerState)(nil), "px.carnot.planner.distributedpb.LogicalPlannerState")
+	proto.RegisterType((*LogicalPlannerStateUpdate)(nil), "px.carnot.planner.distributedpb.LogicalPlannerStateUpdate")
 	proto.RegisterType((*LogicalPlannerResult)(nil), "px.carnot.planner.distributedpb.LogicalPlannerResult")
+	proto.RegisterType((*BatchLogicalPlannerResult)(nil), "px.carnot.planner.distributedpb.BatchLogicalPlannerResult")
 }
 
 func init() {
@@ -892,104 +1124,115 @@ func init() {
 }
 
 var fileDescriptor_30dce4250507a2af = []byte{
-	// 1551 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xa4, 0x57, 0x4f, 0x6f, 0x1b, 0xc7,
-	0x15, 0xd7, 0x8a, 0x94, 0x48, 0x3e, 0x92, 0x12, 0x3d, 0xa2, 0x5c, 0x96, 0x48, 0x48, 0x97, 0x48,
-	0x50, 0xc1, 0x76, 0x96, 0xa9, 0x12, 0x34, 0x69, 0x80, 0xb4, 0x11, 0x45, 0xff, 0x61, 0xac, 0x26,
-	0xea, 0x50, 0x06, 0x02, 0x1f, 0xba, 0x98, 0xe5, 0x0e, 0xc9, 0x45, 0x96, 0xbb, 0xab, 0x9d, 0x59,
-	0x43, 0x6a, 0x51, 0xa0, 0x3d, 0xf6, 0xd4, 0x7e, 0x8c, 0x9e, 0x7a, 0xeb, 0xb5, 0xd7, 0xf6, 0xe8,
-	0x63, 0x4e, 0x42, 0x4c, 0x5f, 0x7a, 0xcc, 0x47, 0x28, 0xe6, 0xcd, 0x2e, 0xb5, 0xa4, 0x09, 0xc8,
-	0x6e, 0x2f, 0xd2, 0xcc, 0x7b, 0xbf, 0xf7, 0x6f, 0xde, 0xfb, 0xed, 0x0c, 0xe1, 0x13, 0x11, 0x8d,
-	0xba, 0x23, 0x16, 0xf9, 0x81, 0xec, 0x86, 0x1e, 0xf3, 0x7d, 0x1e, 0x75, 0x1d, 0x57, 0xc8, 0xc8,
-	0xb5, 0x63, 0xc9, 0x9d, 0xd0, 0xce, 0xee, 0x2c, 0x85, 0x30, 0xc3, 0x28, 0x90, 0x01, 0x69, 0x87,
-	0x17, 0xa6, 0xb6, 0x33, 0x13, 0x3b, 0x73, 0xc9, 0xae, 0xf9, 0xc1, 0xc4, 0x95, 0xd3, 0xd8, 0x36,
-	0x47, 0xc1, 0xac, 0x3b, 0x09, 0x26, 0x41, 0x17, 0xed, 0xec, 0x78, 0x8c, 0x3b, 0xdc, 0xe0, 0x4a,
-	0xfb, 0x6b, 0xb6, 0x55, 0x22, 0x2c, 0x74, 0x35, 0xac, 0x1b, 0xc7, 0xae, 0x0a, 0xae, 0xfe, 0x25,
-	0x80, 0x77, 0x56, 0x32, 0x0d, 0xed, 0xee, 0x75, 0x3a, 0xcd, 0xf7, 0x51, 0x1b, 0xcc, 0x66, 0x81,
-	0xdf, 0xb5, 0x99, 0xe0, 0x5d, 0x21, 0x99, 0x8c, 0x45, 0x68, 0x27, 0x8b, 0x04, 0x76, 0x57, 0xc1,
-	0xc4, 0x94, 0x45, 0xdc, 0xe9, 0xda, 0x5e, 0x10, 0xcc, 0xc6, 0xae, 0x27, 0x79, 0x14, 0xda, 0xd9,
-	0x5d, 0x82, 0x7d, 0x2f, 0x83, 0x9d, 0x71, 0xc9, 0x1c, 0x26, 0x59, 0x68, 0x2f, 0x96, 0xd9, 0xc0,
-	0x92, 0xd9, 0x1e, 0xb7, 0x84, 0x0c, 0x22, 0xde, 0x15, 0xa3, 0x29, 0x9f, 0x29, 0xa0, 0x5e, 0x68,
-	0x58, 0x67, 0x6e, 0x40, 0xe5, 0xd7, 0x89, 0xe5, 0xc0, 0x1f, 0x07, 0xe4, 0x09, 0xec, 0xa6, 0x9e,
-	0xac, 0xb1, 0xcb, 0x3d, 0x47, 0x34, 0x8c, 0x3b, 0xb9, 0x83, 0x9d, 0xc3, 0x8e, 0x19, 0x5e, 0x98,
-	0x3a, 0xac, 0x79, 0x1d, 0xd6, 0x4c, 0x8d, 0xcf, 0x2e, 0x43, 0x4e, 0x77, 0x52, 0xc5, 0x43, 0xb4,
-	0x24, 0xbf, 0x87, 0xfd, 0x8b, 0x8b, 0x29, 0x13, 0xd3, 0x9f, 0x7f, 0x6c, 0x61, 0x21, 0x96, 0xae,
-	0xa4, 0xb1, 0x79, 0xc7, 0x38, 0x28, 0x1f, 0xde, 0xcf, 0xb8, 0x5c, 0xaa, 0xda, 0xfc, 0xe6, 0x9b,
-	0xc7, 0x68, 0xd5, 0x53, 0xd2, 0x87, 0x28, 0xed, 0xfd, 0x68, 0x7e, 0xd5, 0xde, 0x5b, 0xa3, 0x78,
-	0xbc, 0x41, 0xf7, 0xd2, 0x28, 0x59, 0x7c, 0x11, 0xb6, 0xb5, 0xbf, 0xce, 0xf7, 0x79, 0x80, 0x63,
-	0xec, 0x10, 0x96, 0xf8, 0x21, 0xd4, 0xcf, 0x63, 0x1e, 0x5d, 0x5a, 0x76, 0x14, 0x7c, 0xcb, 0x23,
-	0x8b, 0x39, 0x4e, 0xc4, 0x85, 0xaa, 0xd3, 0x38, 0x28, 0x51, 0x82, 0xba, 0x1e, 0xaa, 0x8e, 0xb4,
-	0x86, 0x7c, 0x02, 0x45, 0x36, 0xe1, 0xbe, 0xb4, 0x5c, 0xa7, 0x01, 0x98, 0xfa, 0xae, 0x4a, 0x5d,
-	0x0f, 0x83, 0xf9, 0xf4, 0xe9, 0xa0, 0xdf, 0x2b, 0xcf, 0xaf, 0xda, 0x85, 0x23, 0x05, 0x1a, 0xf4,
-	0x69, 0x01, 0xd1, 0x03, 0x87, 0xfc, 0x02, 0x76, 0xa7, 0x4c, 0x58, 0x93, 0x28, 0x1c, 0x59, 0x82,
-	0x47, 0xcf, 0x93, 0xd2, 0x8b, 0xbd, 0x5b, 0xf3, 0xab, 0x76, 0xf5, 0x31, 0x13, 0x8f, 0xe8, 0xe9,
-	0xf1, 0x10, 0x15, 0xb4, 0x3a, 0x65, 0xe2, 0x51, 0x14, 0x8e, 0xf4, 0x96, 0x1c, 0x42, 0x05, 0xcd,
-	0xd2, 0xec, 0x72, 0x2a, 0xbb, 0xde, 0xee, 0xfc, 0xaa, 0x5d, 0x56, 0x46, 0x49, 0x6a, 0xb4, 0xac,
-	0x40, 0x69, 0x9e, 0xef, 0xc1, 0x8e, 0x0a, 0x87, 0xcd, 0xc3, 0xae, 0x37, 0xf2, 0x2a, 0x1a, 0xad,
-	0x4c, 0x99, 0xe8, 0x33, 0xc9, 0x86, 0x4a, 0x46, 0xde, 0x87, 0x9d, 0x30, 0x0a, 0x46, 0x5c, 0x08,
-	0xae, 0xb1, 0x8d, 0x2d, 0x44, 0x55, 0x17, 0x52, 0x85, 0x25, 0x1f, 0xc3, 0x6d, 0x36, 0x1a, 0xf1,
-	0x50, 0x0a, 0x2b, 0xe2, 0xb3, 0x40, 0x72, 0x4b, 0x04, 0x71, 0x34, 0xe2, 0xa2, 0xb1, 0x8d, 0xf0,
-	0x7a, 0xa2, 0xa5, 0xa8, 0x1c, 0x6a, 0x1d, 0x19, 0x00, 0xe8, 0xa9, 0x73, 0xfd, 0x71, 0xd0, 0x28,
-	0xdc, 0xc9, 0x1d, 0x94, 0x0f, 0xef, 0x9a, 0x37, 0x90, 0xd2, 0x3c, 0x53, 0x26, 0xaa, 0x39, 0xb4,
-	0x24, 0xd3, 0x25, 0x79, 0x07, 0xf2, 0x4c, 0xb8, 0x4e, 0xa3, 0x78, 0xc7, 0x38, 0xa8, 0xf6, 0x8a,
-	0xf3, 0xab, 0x76, 0xfe, 0x68, 0x38, 0xe8, 0x53, 0x94, 0x12, 0x0a, 0xd5, 0xc5, 0xa0, 0x62, 0xac,
-	0x12, 0x36, 0xe6, 0x83, 0x1b, 0x63, 0x65, 0xc7, 0x9d, 0x56, 0x66, 0xd9, 0xe1, 0xff, 0x14, 0x76,
-	0x84, 0xf0, 0x2c, 0xc9, 0xa2, 0x09, 0x97, 0x3e, 0x9b, 0xf1, 0x46, 0x19, 0x4f, 0x1d, 0xbb, 0x35,
-	0x1c, 0x9e, 0x9c, 0xa1, 0xe2, 0x2b, 0x36, 0xe3, 0xb4, 0x2a, 0x84, 0x77, 0xb6, 0xc0, 0x75, 0xa6,
-	0x50, 0x5a, 0xd4, 0x40, 0xea, 0xb0, 0x85, 0x55, 0x24, 0x13, 0xa5, 0x37, 0xe4, 0x1e, 0xdc, 0xc2,
-	0x85, 0x74, 0x7f, 0xc7, 0xa4, 0x1b, 0xf8, 0xd6, 0xb7, 0xfc, 0x12, 0xa7, 0xa1, 0x44, 0x6b, 0x4b,
-	0x8a, 0x27, 0xfc, 0x92, 0x34, 0xa0, 0xa0, 0x65, 0xaa, 0xf1, 0xb9, 0x83, 0x12, 0x4d, 0xb7, 0x9d,
-	0xbf, 0x18, 0x00, 0x43, 0xa4, 0x30, 0xc6, 0x22, 0x90, 0xc7, 0x44, 0x75, 0x28, 0x5c, 0x93, 0xcf,
-	0xa1, 0x18, 0x71, 0x0f, 0x7d, 0x25, 0x4c, 0xfb, 0x89, 0x3a, 0x95, 0xcc, 0xd7, 0xc0, 0x4c, 0xbf,
-	0x06, 0x26, 0x4d, 0x80, 0x74, 0x61, 0x42, 0x4c, 0x00, 0x3d, 0xed, 0x9e, 0x2b, 0x24, 0x86, 0x7f,
-	0x7d, 0xde, 0x69, 0x09, 0x21, 0x27, 0xae, 0x90, 0x9d, 0xbf, 0x1b, 0x50, 0xeb, 0x5f, 0x1f, 0xf1,
-	0x50, 0x32, 0xc9, 0xc9, 0x09, 0x94, 0x75, 0x17, 0x74, 0x73, 0x0c, 0xf4, 0x72, 0xef, 0xc6, 0xe6,
-	0x5c, 0xd3, 0x94, 0xc2, 0xe8, 0x9a, 0xb2, 0x27, 0x50, 0xd6, 0x19, 0x6b, 0x6f, 0x9b, 0x6f, 0xe8,
-	0xed, 0xfa, 0x9c, 0x28, 0x88, 0xc5, 0xba, 0xf3, 0xaf, 0x1c, 0xec, 0x66, 0x12, 0x3e, 0xf5, 0x98,
-	0x4f, 0x22, 0x20, 0xe7, 0x76, 0x4a, 0x36, 0x4b, 0x06, 0x78, 0xa7, 0x24, 0x69, 0x3f, 0xb8, 0x31,
-	0xd0, 0x8a, 0x37, 0xf3, 0x37, 0x76, 0x42, 0xc9, 0xb3, 0x40, 0xed, 0x1f, 0xf8, 0x32, 0xba, 0xa4,
-	0xbb, 0xe7, 0xcb, 0x52, 0xf2, 0x1c, 0xea, 0xcb, 0x31, 0x1d, 0x36, 0x51, 0x9f, 0x18, 0x5d, 0xde,
-	0xc3, 0xff, 0x27, 0x6a, 0x9f, 0x4d, 0x06, 0x8e, 0x0e, 0x5b, 0x3b, 0x5f, 0x11, 0x93, 0x9f, 0x42,
-	0xce, 0x61, 0x13, 0xfc, 0xa2, 0x94, 0x0f, 0xf7, 0x57, 0xc2, 0x28, 0xbf, 0x47, 0x8f, 0xa8, 0x42,
-	0x34, 0x9f, 0x41, 0x7d, 0x5d, 0x25, 0xa4, 0x06, 0x39, 0x35, 0xbc, 0x7a, 0xe6, 0xd4, 0x92, 0xdc,
-	0x87, 0xad, 0xe7, 0xcc, 0x8b, 0x79, 0x32, 0x6f, 0xb7, 0x5f, 0x77, 0xaa, 0xac, 0xa9, 0x06, 0x7d,
-	0xb6, 0xf9, 0xa9, 0xd1, 0x3c, 0x86, 0xfd, 0xb5, 0xf9, 0xae, 0x71, 0x5e, 0xcf, 0x3a, 0xcf, 0x67,
-	0x9c, 0x74, 0xfe, 0x64, 0x40, 0x8d, 0x72, 0x87, 0x8d, 0xd4, 0xe0, 0x7e, 0x1d, 0xaa, 0xbf, 0x82,
-	0xdc, 0x07, 0x12, 0x0b, 0x6e, 0x8d, 0x63, 0xcf, 0xb3, 0xa2, 0x54, 0x89, 0xfe, 0x8a, 0xb4, 0x16,
-	0x0b, 0xfe, 0x30, 0xf6, 0xbc, 0x85, 0x11, 0xf9, 0x15, 0xbc, 0xab, 0xd0, 0xe1, 0x45, 0x82, 0xb5,
-	0x42, 0xd7, 0xb5, 0x6c, 0x2e, 0xa4, 0xc5, 0xc7, 0xe3, 0x20, 0x92, 0xfa, 0x83, 0x4d, 0x1b, 0xb1,
-	0xe0, 0xa7, 0x17, 0xda, 0xec, 0xd4, 0x75, 0x7b, 0x5c, 0xc8, 0x07, 0xa8, 0xef, 0xbc, 0x32, 0x80,
-	0x7c, 0x7d, 0xc6, 0xbd, 0x07, 0xbe, 0x13, 0x06, 0xae, 0x2f, 0x8f, 0x03, 0x7f, 0xec, 0x4e, 0xc8,
-	0x8f, 0x21, 0x17, 0x47, 0x9e, 0x2e, 0xa3, 0x57, 0x98, 0x5f, 0xb5, 0x73, 0x4f, 0xe9, 0x09, 0x55,
-	0x32, 0xf2, 0x0c, 0x0a, 0x53, 0xce, 0x1c, 0x1e, 0x89, 0xa4, 0xd5, 0x5f, 0xdc, 0xd8, 0xea, 0xd7,
-	0x03, 0x98, 0x8f, 0xb5, 0x0b, 0xdd, 0xe4, 0xd4, 0x21, 0x69, 0x42, 0xd1, 0xf5, 0x05, 0x1f, 0xc5,
-	0x11, 0xc7, 0x06, 0x17, 0xe9, 0x62, 0xdf, 0xfc, 0x0c, 0x2a, 0x59, 0xa3, 0x9b, 0x4e, 0xba, 0x94,
-	0x3d, 0x69, 0x0a, 0x95, 0x53, 0x2f, 0x9e, 0xb8, 0x7e, 0x52, 0x5e, 0x07, 0xaa, 0x42, 0xb2, 0x48,
-	0x5a, 0xd2, 0x9d, 0x71, 0xcb, 0xd7, 0xb7, 0x67, 0x8e, 0x96, 0x51, 0x78, 0xe6, 0xce, 0xf8, 0x57,
-	0x82, 0xb4, 0xa0, 0xcc, 0x7d, 0x67, 0x81, 0xd8, 0x44, 0x44, 0x89, 0xfb, 0x8e, 0xd6, 0x77, 0xfe,
-	0x69, 0x40, 0xa9, 0xcf, 0xed, 0x78, 0x82, 0x1c, 0x3f, 0x87, 0xfd, 0x40, 0x72, 0xcf, 0x72, 0x94,
-	0xc4, 0x62, 0x32, 0xa9, 0x5e, 0x24, 0x24, 0xfc, 0xfc, 0x66, 0x3a, 0xa4, 0xae, 0xf0, 0xb4, 0x70,
-	0x77, 0x94, 0x7a, 0xa1, 0x7b, 0xca, 0xf7, 0xb2, 0x4c, 0x34, 0x7f, 0xa9, 0x3b, 0xb7, 0x2c, 0x5e,
-	0xfb, 0x49, 0x5d, 0x7b, 0x30, 0x9d, 0x7f, 0x6c, 0xc1, 0xde, 0x49, 0x30, 0x71, 0x47, 0xcc, 0x3b,
-	0xd5, 0x29, 0xe9, 0x8f, 0xdf, 0x6f, 0xe1, 0x56, 0xf6, 0x79, 0xaa, 0x9e, 0x7a, 0x29, 0x33, 0x7e,
-	0xf6, 0x36, 0xac, 0x46, 0x6f, 0xb4, 0xe6, 0xac, 0x7e, 0x5c, 0xbf, 0x80, 0x8a, 0xb2, 0xb5, 0x02,
-	0x3d, 0xf1, 0x09, 0x93, 0xdf, 0x5d, 0x4f, 0xba, 0x84, 0x16, 0xb4, 0x1c, 0x5e, 0x6f, 0xd4, 0x1b,
-	0x20, 0xe2, 0x22, 0xf6, 0xe4, 0xe2, 0x7d, 0x91, 0xc7, 0xc2, 0xaa, 0x5a, 0x9a, 0x3e, 0x28, 0x9e,
-	0xc0, 0x7e, 0x02, 0x5b, 0xb9, 0x17, 0xb7, 0x70, 0xac, 0xf1, 0x49, 0x46, 0x11, 0xb0, 0x7c, 0x3b,
-	0xee, 0x69, 0xab, 0x61, 0xf6, 0x8e, 0x54, 0xa7, 0xb2, 0xa0, 0xe3, 0x22, 0xf5, 0xc2, 0x1b, 0x9e,
-	0xca, 0x2a, 0xcb, 0x69, 0x2d, 0x5a, 0xe5, 0xfd, 0x1f, 0xa0, 0x8e, 0x03, 0xc4, 0x13, 0x9e, 0x58,
-	0x23, 0x1c, 0x55, 0x7c, 0x3f, 0x94, 0x0f, 0x3f, 0xfa, 0x1f, 0x38, 0xd6, 0xbb, 0x3d, 0xbf, 0x6a,
-	0xaf, 0x21, 0x37, 0x25, 0x2a, 0xd0, 0x0a, 0xe1, 0x29, 0x54, 0x43, 0x64, 0x48, 0x1a, 0xf7, 0x4d,
-	0x1f, 0x24, 0x59, 0x5e, 0xd1, 0x4a, 0x98, 0x65, 0xd9, 0x00, 0x40, 0xd3, 0x01, 0xaf, 0x3d, 0xfd,
-	0xf4, 0xbc, 0xfb, 0xe6, 0x44, 0xa0, 0x25, 0x27, 0x5d, 0x7e, 0x99, 0x2f, 0x1a, 0xb5, 0xcd, 0x2f,
-	0xf3, 0xc5, 0xed, 0x5a, 0xa1, 0xf3, 0x67, 0x03, 0xea, 0xcb, 0x73, 0xab, 0x9b, 0x48, 0xee, 0xc1,
-	0xb6, 0xfe, 0x5d, 0x82, 0xc3, 0x5f, 0x3e, 0xdc, 0xc3, 0x17, 0x7a, 0xf2, 0x93, 0xc5, 0x1c, 0xe2,
-	0x82, 0x26, 0x10, 0xd2, 0x87, 0x3c, 0x5e, 0x92, 0x7a, 0xb0, 0x3f, 0x7c, 0xdb, 0xeb, 0x8a, 0xa2,
-	0x75, 0xef, 0xf8, 0xc5, 0xcb, 0xd6, 0xc6, 0x77, 0x2f, 0x5b, 0x1b, 0x3f, 0xbc, 0x6c, 0x19, 0x7f,
-	0x9c, 0xb7, 0x8c, 0xbf, 0xcd, 0x5b, 0xc6, 0xbf, 0xe7, 0x2d, 0xe3, 0xc5, 0xbc, 0x65, 0x7c, 0x3f,
-	0x6f, 0x19, 0xff, 0x99, 0xb7, 0x36, 0x7e, 0x98, 0xb7, 0x8c, 0xbf, 0xbe, 0x6a, 0x6d, 0xbc, 0x78,
-	0xd5, 0xda, 0xf8, 0xee, 0x55, 0x6b, 0xe3, 0x59, 0x75, 0xc9, 0xb5, 0xbd, 0x8d, 0xbf, 0x66, 0x3e,
-	0xfa, 0x6f, 0x00, 0x00, 0x00, 0xff, 0xff, 0xa5, 0xa7, 0x7e, 0x60, 0x37, 0x0e, 0x00, 0x00,
+	// 1728 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xa5, 0x57, 0xcd, 0x6f, 0x1b, 0x45,
+	0x14, 0xaf, 0x63, 0x27, 0xb6, 0x9f, 0xe3, 0xc4, 0x99, 0x24, 0xc5, 0x0d, 0x90, 0x80, 0x45, 0x45,
+	0x55, 0x60, 0x0d, 0xa1, 0x14, 0xa8, 0x54, 0x20, 0xce, 0x47, 0x1b, 0x1a, 0x68, 0x18, 0x27, 0x52,
+	0x55, 0x24, 0x56, 0xeb, 0xdd, 0x89, 0xb3, 0x62, 0xbd, 0xeb, 0xec, 0x47, 0x48, 0x40, 0x48, 0x70,
+	0xe4, 0xc6, 0x95, 0xff, 0x80, 0x13, 0x27, 0xb8, 0x72, 0x85, 0x63, 0x8f, 0x9c, 0x50, 0x5b, 0x2e,
+	0x1c, 0x39, 0x73, 0xe2, 0xcd, 0x9b, 0x5d, 0x7b, 0xed, 0x58, 0x72, 0x4a, 0x0f, 0x6b, 0xcf, 0xbc,
+	0xf9, 0xbd, 0xcf, 0x79, 0xef, 0xed, 0x5b, 0x78, 0x3b, 0xf0, 0xcd, 0xba, 0x69, 0xf8, 0xae, 0x17,
+	0xd6, 0xbb, 0x8e, 0xe1, 0xba, 0xc2, 0xaf, 0x5b, 0x76, 0x10, 0xfa, 0x76, 0x2b, 0x0a, 0x85, 0xd5,
+	0x6d, 0xa5, 0x77, 0xba, 0x44, 0x68, 0x5d, 0xdf, 0x0b, 0x3d, 0xb6, 0xd2, 0x3d, 0xd1, 0x14, 0x9f,
+	0x16, 0xf3, 0x69, 0x03, 0x7c, 0x4b, 0xaf, 0xb5, 0xed, 0xf0, 0x30, 0x6a, 0x69, 0xa6, 0xd7, 0xa9,
+	0xb7, 0xbd, 0xb6, 0x57, 0x27, 0xbe, 0x56, 0x74, 0x40, 0x3b, 0xda, 0xd0, 0x4a, 0xc9, 0x5b, 0x5a,
+	0x91, 0x86, 0x18, 0x5d, 0x5b, 0xc1, 0xea, 0x51, 0x64, 0x4b, 0xe5, 0xf2, 0x2f, 0x06, 0x3c, 0x37,
+	0x64, 0x29, 0x9e, 0xf6, 0xcd, 0x59, 0xba, 0x4c, 0xa7, 0x5e, 0xa7, 0xe3, 0xb9, 0xf5, 0x96, 0x11,
+	0x88, 0x7a, 0x10, 0x1a, 0x61, 0x14, 0x20, 0x48, 0x2d, 0x62, 0xd8, 0x55, 0x09, 0x0b, 0x0e, 0x0d,
+	0x5f, 0x58, 0xf5, 0x96, 0xe3, 0x79, 0x9d, 0x03, 0xdb, 0x09, 0x85, 0x8f, 0xb0, 0xd4, 0x2e, 0xc6,
+	0xbe, 0x94, 0xc2, 0x76, 0x44, 0x68, 0x58, 0x46, 0x68, 0x20, 0x30, 0x59, 0xa6, 0x15, 0x87, 0x46,
+	0xcb, 0x11, 0x7a, 0x10, 0x7a, 0x3e, 0x2a, 0x36, 0x0f, 0x45, 0x47, 0x02, 0xd5, 0x42, 0xc1, 0x6a,
+	0x8f, 0x33, 0x30, 0xfd, 0x51, 0xcc, 0xb9, 0xed, 0x1e, 0x78, 0xec, 0x0e, 0xcc, 0x26, 0x92, 0xf4,
+	0x03, 0x5b, 0x38, 0x56, 0x50, 0xcd, 0xbc, 0x90, 0xbd, 0x32, 0xb3, 0x5a, 0xd3, 0x30, 0xb2, 0x4a,
+	0xad, 0xd6, 0x57, 0xab, 0x25, 0xcc, 0x7b, 0xa7, 0x5d, 0xc1, 0x67, 0x92, 0x83, 0x2d, 0xe2, 0x64,
+	0x5f, 0xc1, 0xe2, 0xc9, 0xc9, 0xa1, 0x11, 0x1c, 0x5e, 0xbf, 0xa6, 0x93, 0x23, 0xba, 0xf2, 0xa4,
+	0x3a, 0xf1, 0x42, 0xe6, 0x4a, 0x69, 0xf5, 0xd5, 0x94, 0xc8, 0x01, 0xaf, 0xb5, 0x7b, 0xf7, 0x6e,
+	0x13, 0x57, 0x43, 0x52, 0xb7, 0x88, 0xda, 0x78, 0xe6, 0xf1, 0x9f, 0x2b, 0xf3, 0x23, 0x0e, 0x6e,
+	0x5f, 0xe0, 0xf3, 0x89, 0x96, 0x34, 0xbe, 0x00, 0x53, 0x4a, 0x5e, 0xed, 0x61, 0x0e, 0x60, 0x9d,
+	0x6e, 0x88, 0x5c, 0x7c, 0x1d, 0x16, 0x8e, 0x22, 0xe1, 0x9f, 0xea, 0x2d, 0xdf, 0xfb, 0x5c, 0xf8,
+	0xba, 0x61, 0x59, 0xbe, 0x08, 0xa4, 0x9f, 0x99, 0x2b, 0x45, 0xce, 0xe8, 0xac, 0x41, 0x47, 0x6b,
+	0xea, 0x84, 0xbd, 0x0d, 0x05, 0xa3, 0x2d, 0xdc, 0x50, 0xb7, 0xad, 0x2a, 0x90, 0xe9, 0xb3, 0xd2,
+	0x74, 0x95, 0x0c, 0xda, 0xfe, 0xfe, 0xf6, 0x46, 0xa3, 0x84, 0xd6, 0xe5, 0xd7, 0x24, 0x68, 0x7b,
+	0x83, 0xe7, 0x09, 0xbd, 0x6d, 0xb1, 0x77, 0x61, 0x16, 0x0d, 0xd3, 0xdb, 0x7e, 0xd7, 0xd4, 0x03,
+	0xe1, 0x1f, 0xc7, 0xae, 0x17, 0x1a, 0x73, 0x08, 0x2f, 0xa3, 0x2b, 0xb7, 0xf8, 0xee, 0x7a, 0x93,
+	0x0e, 0x78, 0x19, 0x91, 0xb7, 0x10, 0xa8, 0xb6, 0x6c, 0x15, 0xa6, 0x89, 0x2d, 0xb1, 0x2e, 0x2b,
+	0xad, 0x6b, 0xcc, 0x22, 0x5f, 0x49, 0x32, 0xc5, 0xa6, 0xf1, 0x92, 0x04, 0x25, 0x76, 0xbe, 0x04,
+	0x33, 0x52, 0x1d, 0x5d, 0x1e, 0xdd, 0x7a, 0x35, 0x27, 0xb5, 0xf1, 0x69, 0xa4, 0x6e, 0x20, 0xb1,
+	0x29, 0x69, 0xec, 0x32, 0xcc, 0xe0, 0xe5, 0x9b, 0xc8, 0x20, 0x14, 0xb6, 0x3a, 0x49, 0xa8, 0x72,
+	0x8f, 0x2a, 0xb1, 0xec, 0x1a, 0x5c, 0x34, 0x4c, 0x53, 0x74, 0xc3, 0x40, 0xf7, 0x45, 0xc7, 0x0b,
+	0x31, 0x91, 0xbc, 0xc8, 0x47, 0x40, 0x75, 0x8a, 0xe0, 0x0b, 0xf1, 0x29, 0xa7, 0xc3, 0xa6, 0x3a,
+	0x63, 0xdb, 0x00, 0x2a, 0xeb, 0x6c, 0x0c, 0x75, 0x35, 0x8f, 0xa9, 0x53, 0x5a, 0xbd, 0xaa, 0x8d,
+	0x29, 0x4a, 0x6d, 0x4f, 0xb2, 0xc8, 0xcb, 0xe1, 0xc5, 0x30, 0x59, 0xb2, 0xe7, 0x20, 0x67, 0x04,
+	0x18, 0xf1, 0x02, 0xaa, 0x2b, 0x37, 0x0a, 0xe8, 0x79, 0x6e, 0xad, 0x89, 0xd1, 0x25, 0x2a, 0xe3,
+	0x50, 0xee, 0x25, 0x2a, 0xe9, 0x2a, 0xd2, 0xc5, 0xbc, 0x36, 0x56, 0x57, 0x3a, 0xdd, 0xf9, 0x74,
+	0x27, 0x9d, 0xfc, 0xef, 0xc0, 0x4c, 0x10, 0x38, 0x7a, 0x68, 0xf8, 0x6d, 0x11, 0xba, 0x46, 0x47,
+	0x54, 0x4b, 0x14, 0x75, 0xba, 0xad, 0x66, 0x73, 0x67, 0x8f, 0x0e, 0x3e, 0xc6, 0x03, 0x5e, 0x46,
+	0xe0, 0x5e, 0x0f, 0x57, 0x3b, 0x84, 0x62, 0xcf, 0x07, 0xb6, 0x00, 0x93, 0xe4, 0x45, 0x9c, 0x51,
+	0x6a, 0xc3, 0x5e, 0x81, 0x39, 0x5a, 0x84, 0xf6, 0x97, 0x46, 0x68, 0x7b, 0xae, 0xfe, 0xb9, 0x38,
+	0xa5, 0x6c, 0x28, 0xf2, 0xca, 0xc0, 0xc1, 0x1d, 0x71, 0xca, 0xaa, 0x90, 0x57, 0x34, 0x79, 0xf1,
+	0x59, 0x84, 0x24, 0xdb, 0xda, 0xbf, 0x19, 0x98, 0x25, 0x55, 0x4d, 0x6c, 0x20, 0xe8, 0x98, 0x6d,
+	0x06, 0xec, 0x59, 0x28, 0xfa, 0xde, 0x17, 0xba, 0xe9, 0x45, 0x6e, 0x48, 0x4a, 0xb3, 0xbc, 0x80,
+	0x84, 0x75, 0xb9, 0x67, 0x2e, 0xcc, 0x99, 0x9e, 0x13, 0x75, 0x5c, 0x3d, 0xe8, 0x71, 0xa0, 0x5e,
+	0x79, 0x31, 0x6b, 0xe7, 0xbb, 0x98, 0xbe, 0x26, 0x6d, 0x9d, 0x24, 0xf5, 0x09, 0xbc, 0x62, 0x0e,
+	0x51, 0x96, 0xee, 0x43, 0x65, 0x18, 0xc5, 0x56, 0xa0, 0x14, 0xdb, 0x40, 0x51, 0x55, 0x71, 0x01,
+	0x45, 0x92, 0xe1, 0x94, 0x39, 0x29, 0x15, 0xdb, 0xae, 0x19, 0xc6, 0x6e, 0x4c, 0x90, 0x1b, 0xe5,
+	0x84, 0x4a, 0xbe, 0xd4, 0x1e, 0x65, 0x00, 0x9a, 0xd4, 0xbf, 0x28, 0xd0, 0x0c, 0x72, 0x29, 0x79,
+	0xb4, 0x66, 0x37, 0xa1, 0xe0, 0x0b, 0x87, 0x02, 0x19, 0xb7, 0x99, 0x17, 0xa5, 0x97, 0xa9, 0x56,
+	0xa8, 0x25, 0xad, 0x50, 0xe3, 0x31, 0x90, 0xf7, 0x58, 0x98, 0x06, 0xa0, 0x4a, 0xdd, 0x41, 0xc5,
+	0x14, 0xfb, 0xb3, 0xc5, 0xce, 0x8b, 0x04, 0xd9, 0x41, 0x04, 0xdb, 0x05, 0x48, 0x85, 0x35, 0x47,
+	0x0a, 0x5f, 0x7f, 0xd2, 0xb0, 0xf2, 0x94, 0x8c, 0xda, 0x4f, 0x19, 0xa8, 0x6c, 0xf4, 0xd1, 0x12,
+	0x25, 0xd8, 0x0e, 0x06, 0x90, 0x04, 0xaa, 0x5c, 0xcf, 0x90, 0x5d, 0xaf, 0x8c, 0xd5, 0xd3, 0xef,
+	0x7a, 0x18, 0xed, 0x7e, 0x07, 0x44, 0x69, 0x2a, 0x06, 0x4a, 0xda, 0xc4, 0x39, 0xa5, 0xf5, 0x23,
+	0x8f, 0x06, 0xf7, 0xd6, 0xb5, 0xdf, 0xb2, 0x30, 0x9b, 0x32, 0x78, 0x17, 0x79, 0x99, 0x0f, 0xec,
+	0xa8, 0x95, 0xf4, 0x2e, 0x3d, 0xf4, 0xe8, 0x15, 0x1d, 0x9b, 0xbd, 0x39, 0x56, 0xd1, 0x90, 0x34,
+	0xed, 0x93, 0x56, 0xdc, 0xe1, 0xf6, 0x3c, 0xb9, 0xdf, 0x74, 0x43, 0xff, 0x94, 0xcf, 0x1e, 0x0d,
+	0x52, 0xd9, 0x31, 0xf6, 0xf5, 0x01, 0x9d, 0x96, 0xd1, 0x96, 0x1d, 0x5b, 0xb9, 0xb7, 0xf5, 0x34,
+	0x5a, 0x37, 0x8c, 0xf6, 0xb6, 0xa5, 0xd4, 0x56, 0x8e, 0x86, 0xc8, 0xec, 0x65, 0xc8, 0xa2, 0x26,
+	0x6a, 0xd0, 0xa5, 0xd5, 0xc5, 0x21, 0x35, 0x52, 0xee, 0xda, 0x2d, 0x2e, 0x11, 0x58, 0x19, 0x0b,
+	0xa3, 0x3c, 0x61, 0x15, 0xc8, 0xca, 0x5e, 0xa0, 0xb2, 0x58, 0x2e, 0xd9, 0xab, 0x30, 0x79, 0x6c,
+	0x38, 0x91, 0x88, 0x33, 0xf8, 0xe2, 0x59, 0xa1, 0x92, 0x9b, 0x2b, 0xd0, 0x8d, 0x89, 0x77, 0x32,
+	0x4b, 0xeb, 0xb0, 0x38, 0xd2, 0xde, 0x11, 0xc2, 0x17, 0xd2, 0xc2, 0x73, 0x29, 0x21, 0xb5, 0x6f,
+	0x31, 0xf5, 0xb8, 0xb0, 0x0c, 0x53, 0x96, 0xc2, 0xdd, 0xae, 0xfc, 0x0d, 0xd0, 0x16, 0x16, 0x05,
+	0x42, 0x3f, 0x88, 0x1c, 0x07, 0x5f, 0x04, 0xf1, 0x21, 0xc9, 0x2b, 0xf0, 0x0a, 0x9e, 0x6c, 0xe1,
+	0x41, 0x8f, 0x89, 0xbd, 0x0f, 0xcf, 0x4b, 0x74, 0xf7, 0x24, 0xc6, 0xea, 0x5d, 0xdb, 0xd6, 0x5b,
+	0x22, 0x08, 0x75, 0x71, 0x70, 0xe0, 0xf9, 0xaa, 0xae, 0x0b, 0xbc, 0x8a, 0xa0, 0xdd, 0x13, 0xc5,
+	0xb6, 0x6b, 0xdb, 0x0d, 0x04, 0x6c, 0xd2, 0x79, 0xed, 0xaf, 0x0c, 0xb0, 0xbb, 0x7b, 0xc2, 0xd9,
+	0x74, 0xad, 0xae, 0x67, 0xbb, 0x58, 0xf8, 0xee, 0x81, 0xdd, 0x66, 0x97, 0x20, 0x1b, 0xf9, 0x8e,
+	0x72, 0xa3, 0x91, 0xc7, 0x7e, 0x9c, 0xdd, 0xe7, 0x3b, 0x5c, 0xd2, 0xd8, 0x7d, 0xc8, 0x1f, 0x0a,
+	0xc3, 0x12, 0x7e, 0xd2, 0xd6, 0x3e, 0x18, 0x7b, 0xd5, 0x67, 0x15, 0x68, 0xb7, 0x95, 0x08, 0x75,
+	0xc9, 0x89, 0x40, 0xb6, 0x04, 0x05, 0xdb, 0x0d, 0x84, 0x19, 0xe1, 0xbb, 0x34, 0x4b, 0x96, 0xf7,
+	0xf6, 0x4b, 0x37, 0x60, 0x3a, 0xcd, 0x34, 0x2e, 0xd2, 0xc5, 0x74, 0xa4, 0x39, 0x4c, 0xef, 0x3a,
+	0x51, 0xdb, 0x76, 0x63, 0xf7, 0x6a, 0x50, 0xc6, 0x16, 0xe0, 0x87, 0x7a, 0x68, 0x77, 0x84, 0xee,
+	0x06, 0x71, 0x17, 0x2f, 0x11, 0x71, 0x0f, 0x69, 0x1f, 0x07, 0x6c, 0x19, 0x4a, 0xc2, 0xb5, 0x7a,
+	0x08, 0xd5, 0x20, 0x8b, 0x48, 0x52, 0xe7, 0xb5, 0x5f, 0x33, 0x50, 0xdc, 0x10, 0xad, 0xa8, 0x4d,
+	0x35, 0x7e, 0x04, 0x8b, 0xf8, 0x5a, 0x76, 0x74, 0x4b, 0x52, 0x74, 0x23, 0x8c, 0xbd, 0x0f, 0xe2,
+	0x22, 0xbc, 0x39, 0xbe, 0x1c, 0x12, 0x51, 0x14, 0x2d, 0xda, 0xad, 0x25, 0x52, 0xf8, 0xbc, 0x94,
+	0x3d, 0x48, 0x0b, 0x96, 0xde, 0x53, 0x37, 0x37, 0x48, 0x1e, 0xd9, 0xa4, 0x47, 0x06, 0xa6, 0xf6,
+	0xcb, 0x24, 0xcc, 0xef, 0x78, 0x6d, 0xdb, 0x34, 0x9c, 0x5d, 0x65, 0x92, 0x6a, 0x7e, 0x9f, 0xc1,
+	0x5c, 0x7a, 0xda, 0x97, 0xbd, 0x32, 0xa9, 0x8c, 0x37, 0x9e, 0xa4, 0xaa, 0x49, 0x1a, 0xaf, 0x58,
+	0xc3, 0xcd, 0xf5, 0x03, 0x98, 0x96, 0xbc, 0xba, 0xa7, 0x32, 0x3e, 0xae, 0xe4, 0xe7, 0x47, 0x17,
+	0x5d, 0x5c, 0x16, 0xbc, 0xd4, 0xed, 0x6f, 0xe4, 0xeb, 0x0b, 0x0b, 0x2f, 0x72, 0xc2, 0xde, 0xb8,
+	0x96, 0x23, 0xc7, 0xca, 0x8a, 0x9a, 0xcc, 0x67, 0x77, 0x60, 0x31, 0x86, 0x0d, 0x8d, 0x19, 0x93,
+	0x94, 0xd6, 0x34, 0xe1, 0x72, 0x02, 0x0c, 0x0e, 0x1b, 0xf3, 0x8a, 0xab, 0x99, 0x1e, 0x39, 0x64,
+	0x54, 0x7a, 0xe5, 0xd8, 0x33, 0x3d, 0x7f, 0xce, 0xa8, 0x0c, 0x57, 0x39, 0xaf, 0xf8, 0xc3, 0x75,
+	0xff, 0x35, 0x2c, 0x50, 0x02, 0x89, 0xb8, 0x4e, 0xf0, 0xbd, 0x2c, 0x53, 0x95, 0xc6, 0xb1, 0xd2,
+	0xea, 0x9b, 0xff, 0xa3, 0xc6, 0x1a, 0x17, 0xd1, 0xc1, 0x11, 0xc5, 0xcd, 0x99, 0x54, 0x34, 0x54,
+	0xf0, 0x38, 0xdf, 0x75, 0xa9, 0x42, 0x12, 0xbd, 0xe7, 0x9d, 0xef, 0xd2, 0x75, 0xc5, 0xa7, 0xbb,
+	0xe9, 0x2a, 0xc3, 0xe1, 0x54, 0x95, 0x03, 0xbd, 0xf6, 0xd4, 0x24, 0x3f, 0x7e, 0x38, 0xed, 0x15,
+	0x02, 0x2f, 0x5a, 0xc9, 0xf2, 0xc3, 0x5c, 0x21, 0x53, 0x99, 0xc0, 0xdf, 0xa9, 0x4a, 0xbe, 0xf6,
+	0xf3, 0x04, 0x5c, 0x1a, 0x91, 0xb7, 0xfb, 0x5d, 0x4b, 0x66, 0xd7, 0xa7, 0x30, 0x1f, 0xd1, 0xca,
+	0xd2, 0x9f, 0xf2, 0x15, 0x3e, 0x17, 0xcb, 0x49, 0x7d, 0xcb, 0x5c, 0x97, 0x89, 0xd7, 0xf1, 0x8e,
+	0x51, 0x38, 0xcd, 0x24, 0x49, 0x0b, 0x3c, 0x33, 0xb2, 0x94, 0x63, 0x18, 0x7d, 0xa2, 0x04, 0x69,
+	0xa3, 0xd2, 0x93, 0x40, 0xf6, 0xc9, 0x27, 0x81, 0xc4, 0xa8, 0xd4, 0x58, 0x76, 0xb9, 0x6f, 0x14,
+	0x8d, 0x5d, 0xb2, 0x1a, 0xb2, 0xaa, 0x1a, 0x88, 0x4a, 0xd3, 0x4f, 0x50, 0xfb, 0x2e, 0x03, 0x0b,
+	0x83, 0x61, 0x53, 0xb9, 0x8f, 0x93, 0xf2, 0x94, 0xfa, 0x3a, 0xa6, 0x9e, 0x51, 0x5a, 0x9d, 0xa7,
+	0xef, 0xc4, 0xf8, 0xc3, 0x59, 0x6b, 0xd2, 0x82, 0xc7, 0x10, 0xb6, 0x01, 0x39, 0x9a, 0x2d, 0x26,
+	0xce, 0x39, 0x7a, 0x0d, 0xbd, 0xe5, 0x39, 0x71, 0xd7, 0x7e, 0xc8, 0xc0, 0xa5, 0x86, 0x11, 0x9a,
+	0x87, 0x4f, 0x6f, 0xd0, 0x5d, 0xc8, 0xab, 0x72, 0x4d, 0xee, 0xe2, 0xad, 0xb1, 0x36, 0x8d, 0x52,
+	0xca, 0x13, 0x29, 0x8d, 0xf5, 0x07, 0x8f, 0x96, 0x2f, 0xfc, 0x81, 0xcf, 0x3f, 0x8f, 0x96, 0x33,
+	0xdf, 0x3c, 0x5e, 0xce, 0xfc, 0x88, 0xcf, 0xef, 0xf8, 0x3c, 0xc0, 0xe7, 0x21, 0x3e, 0x7f, 0x3f,
+	0xc6, 0x33, 0xfc, 0xff, 0xfe, 0xaf, 0xe5, 0x0b, 0x0f, 0xf0, 0xf9, 0x03, 0x9f, 0xfb, 0xe5, 0x01,
+	0x15, 0xad, 0x29, 0xfa, 0xde, 0x7f, 0xf3, 0x3f, 0x15, 0x24, 0xd6, 0xab, 0x59, 0x11, 0x00, 0x00,
 }
 
 func (this *MetadataInfo) Equal(that interface{}) bool {
@@ -1148,6 +1391,65 @@ func (this *TableInfo) Equal(that interface{}) bool {
 	}
 	return true
 }
+func (this *TableStatistics) Equal(that interface{}) bool {
+	if that == nil {
+		return this == nil
+	}
+
+	that1, ok := that.(*TableStatistics)
+	if !ok {
+		that2, ok := that.(TableStatistics)
+		if ok {
+			that1 = &that2
+		} else {
+			return false
+		}
+	}
+	if that1 == nil {
+		return this == nil
+	} else if this == nil {
+		return false
+	}
+	if this.RowCount != that1.RowCount {
+		return false
+	}
+	if len(this.ColumnStatistics) != len(that1.ColumnStatistics) {
+		return false
+	}
+	for i := range this.ColumnStatistics {
+		if !this.ColumnStatistics[i].Equal(that1.ColumnStatistics[i]) {
+			return false
+		}
+	}
+	return true
+}
+func (this *TableStatistics_ColumnStatistics) Equal(that interface{}) bool {
+	if that == nil {
+		return this == nil
+	}
+
+	that1, ok := that.(*TableStatistics_ColumnStatistics)
+	if !ok {
+		that2, ok := that.(TableStatistics_ColumnStatistics)
+		if ok {
+			that1 = &that2
+		} else {
+			return false
+		}
+	}
+	if that1 == nil {
+		return this == nil
+	} else if this == nil {
+		return false
+	}
+	if this.ColumnName != that1.ColumnName {
+		return false
+	}
+	if this.DistinctCount != that1.DistinctCount {
+		return false
+	}
+	return true
+}
 func (this *SchemaInfo) Equal(that interface{}) bool {
 	if that == nil {
 		return this == nil
@@ -1181,6 +1483,9 @@ func (this *SchemaInfo) Equal(that interface{}) bool {
 			return false
 		}
 	}
+	if !this.Statistics.Equal(that1.Statistics) {
+		return false
+	}
 	return true
 }
 func (this *DistributedState) Equal(that interface{}) bool {
@@ -1450,6 +1755,59 @@ func (this *LogicalPlannerState) Equal(that interface{}) bool {
 	}
 	return true
 }
+func (this *LogicalPlannerStateUpdate) Equal(that interface{}) bool {
+	if that == nil {
+		return this == nil
+	}
+
+	that1, ok := that.(*LogicalPlannerStateUpdate)
+	if !ok {
+		that2, ok := that.(LogicalPlannerStateUpdate)
+		if ok {
+			that1 = &that2
+		} else {
+			return false
+		}
+	}
+	if that1 == nil {
+		return this == nil
+	} else if this == nil {
+		return false
+	}
+	if len(this.UpdatedCarnotInfo) != len(that1.UpdatedCarnotInfo) {
+		return false
+	}
+	for i := range this.UpdatedCarnotInfo {
+		if !this.UpdatedCarnotInfo[i].Equal(that1.UpdatedCarnotInfo[i]) {
+			return false
+		}
+	}
+	if len(this.RemovedAgents) != len(that1.RemovedAgents) {
+		return false
+	}
+	for i := range this.RemovedAgents {
+		if !this.RemovedAgents[i].Equal(that1.RemovedAgents[i]) {
+			return false
+		}
+	}
+	if len(this.UpdatedSchemaInfo) != len(that1.UpdatedSchemaInfo) {
+		return false
+	}
+	for i := range this.UpdatedSchemaInfo {
+		if !this.UpdatedSchemaInfo[i].Equal(that1.UpdatedSchemaInfo[i]) {
+			return false
+		}
+	}
+	if len(this.RemovedTables) != len(that1.RemovedTables) {
+		return false
+	}
+	for i := range this.RemovedTables {
+		if this.RemovedTables[i] != that1.RemovedTables[i] {
+			return false
+		}
+	}
+	return true
+}
 func (this *LogicalPlannerResult) Equal(that interface{}) bool {
 	if that == nil {
 		return this == nil
@@ -1477,15 +1835,47 @@ func (this *LogicalPlannerResult) Equal(that interface{}) bool {
 	}
 	return true
 }
-func (this *MetadataInfo) GoString() string {
-	if this == nil {
-		return "nil"
-	}
-	s := make([]string, 0, 6)
-	s = append(s, "&distributedpb.MetadataInfo{")
-	s = append(s, "MetadataFields: "+fmt.Sprintf("%#v", this.MetadataFields)+",\n")
-	if this.Filter != nil {
-		s = append(s, "Filter: "+fmt.Sprintf("%#v", this.Filter)+",\n")
+func (this *BatchLogicalPlannerResult) Equal(that interface{}) bool {
+	if that == nil {
+		return this == nil
+	}
+
+	that1, ok := that.(*BatchLogicalPlannerResult)
+	if !ok {
+		that2, ok := that.(BatchLogicalPlannerResult)
+		if ok {
+			that1 = &that2
+		} else {
+			return false
+		}
+	}
+	if that1 == nil {
+		return this == nil
+	} else if this == nil {
+		return false
+	}
+	if !this.Status.Equal(that1.Status) {
+		return false
+	}
+	if len(this.Results) != len(that1.Results) {
+		return false
+	}
+	for i := range this.Results {
+		if !this.Results[i].Equal(that1.Results[i]) {
+			return false
+		}
+	}
+	return true
+}
+func (this *MetadataInfo) GoString() string {
+	if this == nil {
+		return "nil"
+	}
+	s := make([]string, 0, 6)
+	s = append(s, "&distributedpb.MetadataInfo{")
+	s = append(s, "MetadataFields: "+fmt.Sprintf("%#v", this.MetadataFields)+",\n")
+	if this.Filter != nil {
+		s = append(s, "Filter: "+fmt.Sprintf("%#v", this.Filter)+",\n")
 	}
 	s = append(s, "}")
 	return strings.Join(s, "")
@@ -1536,11 +1926,35 @@ func (this *TableInfo) GoString() string {
 	s = append(s, "}")
 	return strings.Join(s, "")
 }
+func (this *TableStatistics) GoString() string {
+	if this == nil {
+		return "nil"
+	}
+	s := make([]string, 0, 6)
+	s = append(s, "&distributedpb.TableStatistics{")
+	s = append(s, "RowCount: "+fmt.Sprintf("%#v", this.RowCount)+",\n")
+	if this.ColumnStatistics != nil {
+		s = append(s, "ColumnStatistics: "+fmt.Sprintf("%#v", this.ColumnStatistics)+",\n")
+	}
+	s = append(s, "}")
+	return strings.Join(s, "")
+}
+func (this *TableStatistics_ColumnStatistics) GoString() string {
+	if this == nil {
+		return "nil"
+	}
+	s := make([]string, 0, 6)
+	s = append(s, "&distributedpb.TableStatistics_ColumnStatistics{")
+	s = append(s, "ColumnName: "+fmt.Sprintf("%#v", this.ColumnName)+",\n")
+	s = append(s, "DistinctCount: "+fmt.Sprintf("%#v", this.DistinctCount)+",\n")
+	s = append(s, "}")
+	return strings.Join(s, "")
+}
 func (this *SchemaInfo) GoString() string {
 	if this == nil {
 		return "nil"
 	}
-	s := make([]string, 0, 7)
+	s := make([]string, 0, 8)
 	s = append(s, "&distributedpb.SchemaInfo{")
 	s = append(s, "Name: "+fmt.Sprintf("%#v", this.Name)+",\n")
 	if this.Relation != nil {
@@ -1549,6 +1963,9 @@ func (this *SchemaInfo) GoString() string {
 	if this.AgentList != nil {
 		s = append(s, "AgentList: "+fmt.Sprintf("%#v", this.AgentList)+",\n")
 	}
+	if this.Statistics != nil {
+		s = append(s, "Statistics: "+fmt.Sprintf("%#v", this.Statistics)+",\n")
+	}
 	s = append(s, "}")
 	return strings.Join(s, "")
 }
@@ -1703,6 +2120,25 @@ func (this *LogicalPlannerState) GoString() string {
 	s = append(s, "}")
 	return strings.Join(s, "")
 }
+func (this *LogicalPlannerStateUpdate) GoString() string {
+	if this == nil {
+		return "nil"
+	}
+	s := make([]string, 0, 8)
+	s = append(s, "&distributedpb.LogicalPlannerStateUpdate{")
+	if this.UpdatedCarnotInfo != nil {
+		s = append(s, "UpdatedCarnotInfo: "+fmt.Sprintf("%#v", this.UpdatedCarnotInfo)+",\n")
+	}
+	if this.RemovedAgents != nil {
+		s = append(s, "RemovedAgents: "+fmt.Sprintf("%#v", this.RemovedAgents)+",\n")
+	}
+	if this.UpdatedSchemaInfo != nil {
+		s = append(s, "UpdatedSchemaInfo: "+fmt.Sprintf("%#v", this.UpdatedSchemaInfo)+",\n")
+	}
+	s = append(s, "RemovedTables: "+fmt.Sprintf("%#v", this.RemovedTables)+",\n")
+	s = append(s, "}")
+	return strings.Join(s, "")
+}
 func (this *LogicalPlannerResult) GoString() string {
 	if this == nil {
 		return "nil"
@@ -1718,6 +2154,21 @@ func (this *LogicalPlannerResult) GoString() string {
 	s = append(s, "}")
 	return strings.Join(s, "")
 }
+func (this *BatchLogicalPlannerResult) GoString() string {
+	if this == nil {
+		return "nil"
+	}
+	s := make([]string, 0, 6)
+	s = append(s, "&distributedpb.BatchLogicalPlannerResult{")
+	if this.Status != nil {
+		s = append(s, "Status: "+fmt.Sprintf("%#v", this.Status)+",\n")
+	}
+	if this.Results != nil {
+		s = append(s, "Results: "+fmt.Sprintf("%#v", this.Results)+",\n")
+	}
+	s = append(s, "}")
+	return strings.Join(s, "")
+}
 func valueToGoStringDistributedPlan(v interface{}, typ string) string {
 	rv := reflect.ValueOf(v)
 	if rv.IsNil() {
@@ -1970,6 +2421,83 @@ func (m *TableInfo) MarshalToSizedBuffer(dAtA []byte) (int, error) {
 	return len(dAtA) - i, nil
 }
 
+func (m *TableStatistics) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalToSizedBuffer(dAtA[:size])
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *TableStatistics) MarshalTo(dAtA []byte) (int, error) {
+	size := m.Size()
+	return m.MarshalToSizedBuffer(dAtA[:size])
+}
+
+func (m *TableStatistics) MarshalToSizedBuffer(dAtA []byte) (int, error) {
+	i := len(dAtA)
+	_ = i
+	var l int
+	_ = l
+	if len(m.ColumnStatistics) > 0 {
+		for iNdEx := len(m.ColumnStatistics) - 1; iNdEx >= 0; iNdEx-- {
+			{
+				size, err := m.ColumnStatistics[iNdEx].MarshalToSizedBuffer(dAtA[:i])
+				if err != nil {
+					return 0, err
+				}
+				i -= size
+				i = encodeVarintDistributedPlan(dAtA, i, uint64(size))
+			}
+			i--
+			dAtA[i] = 0x12
+		}
+	}
+	if m.RowCount != 0 {
+		i = encodeVarintDistributedPlan(dAtA, i, uint64(m.RowCount))
+		i--
+		dAtA[i] = 0x8
+	}
+	return len(dAtA) - i, nil
+}
+
+func (m *TableStatistics_ColumnStatistics) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalToSizedBuffer(dAtA[:size])
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *TableStatistics_ColumnStatistics) MarshalTo(dAtA []byte) (int, error) {
+	size := m.Size()
+	return m.MarshalToSizedBuffer(dAtA[:size])
+}
+
+func (m *TableStatistics_ColumnStatistics) MarshalToSizedBuffer(dAtA []byte) (int, error) {
+	i := len(dAtA)
+	_ = i
+	var l int
+	_ = l
+	if m.DistinctCount != 0 {
+		i = encodeVarintDistributedPlan(dAtA, i, uint64(m.DistinctCount))
+		i--
+		dAtA[i] = 0x10
+	}
+	if len(m.ColumnName) > 0 {
+		i -= len(m.ColumnName)
+		copy(dAtA[i:], m.ColumnName)
+		i = encodeVarintDistributedPlan(dAtA, i, uint64(len(m.ColumnName)))
+		i--
+		dAtA[i] = 0xa
+	}
+	return len(dAtA) - i, nil
+}
+
 func (m *SchemaInfo) Marshal() (dAtA []byte, err error) {
 	size := m.Size()
 	dAtA = make([]byte, size)
@@ -1990,6 +2518,18 @@ func (m *SchemaInfo) MarshalToSizedBuffer(dAtA []byte) (int, error) {
 	_ = i
 	var l int
 	_ = l
+	if m.Statistics != nil {
+		{
+			size, err := m.Statistics.MarshalToSizedBuffer(dAtA[:i])
+			if err != nil {
+				return 0, err
+			}
+			i -= size
+			i = encodeVarintDistributedPlan(dAtA, i, uint64(size))
+		}
+		i--
+		dAtA[i] = 0x22
+	}
 	if len(m.AgentList) > 0 {
 		for iNdEx := len(m.AgentList) - 1; iNdEx >= 0; iNdEx-- {
 			{
@@ -2473,6 +3013,80 @@ func (m *LogicalPlannerState) MarshalToSizedBuffer(dAtA []byte) (int, error) {
 	return len(dAtA) - i, nil
 }
 
+func (m *LogicalPlannerStateUpdate) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalToSizedBuffer(dAtA[:size])
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *LogicalPlannerStateUpdate) MarshalTo(dAtA []byte) (int, error) {
+	size := m.Size()
+	return m.MarshalToSizedBuffer(dAtA[:size])
+}
+
+func (m *LogicalPlannerStateUpdate) MarshalToSizedBuffer(dAtA []byte) (int, error) {
+	i := len(dAtA)
+	_ = i
+	var l int
+	_ = l
+	if len(m.RemovedTables) > 0 {
+		for iNdEx := len(m.RemovedTables) - 1; iNdEx >= 0; iNdEx-- {
+			i -= len(m.RemovedTables[iNdEx])
+			copy(dAtA[i:], m.RemovedTables[iNdEx])
+			i = encodeVarintDistributedPlan(dAtA, i, uint64(len(m.RemovedTables[iNdEx])))
+			i--
+			dAtA[i] = 0x22
+		}
+	}
+	if len(m.UpdatedSchemaInfo) > 0 {
+		for iNdEx := len(m.UpdatedSchemaInfo) - 1; iNdEx >= 0; iNdEx-- {
+			{
+				size, err := m.UpdatedSchemaInfo[iNdEx].MarshalToSizedBuffer(dAtA[:i])
+				if err != nil {
+					return 0, err
+				}
+				i -= size
+				i = encodeVarintDistributedPlan(dAtA, i, uint64(size))
+			}
+			i--
+			dAtA[i] = 0x1a
+		}
+	}
+	if len(m.RemovedAgents) > 0 {
+		for iNdEx := len(m.RemovedAgents) - 1; iNdEx >= 0; iNdEx-- {
+			{
+				size, err := m.RemovedAgents[iNdEx].MarshalToSizedBuffer(dAtA[:i])
+				if err != nil {
+					return 0, err
+				}
+				i -= size
+				i = encodeVarintDistributedPlan(dAtA, i, uint64(size))
+			}
+			i--
+			dAtA[i] = 0x12
+		}
+	}
+	if len(m.UpdatedCarnotInfo) > 0 {
+		for iNdEx := len(m.UpdatedCarnotInfo) - 1; iNdEx >= 0; iNdEx-- {
+			{
+				size, err := m.UpdatedCarnotInfo[iNdEx].MarshalToSizedBuffer(dAtA[:i])
+				if err != nil {
+					return 0, err
+				}
+				i -= size
+				i = encodeVarintDistributedPlan(dAtA, i, uint64(size))
+			}
+			i--
+			dAtA[i] = 0xa
+		}
+	}
+	return len(dAtA) - i, nil
+}
+
 func (m *LogicalPlannerResult) Marshal() (dAtA []byte, err error) {
 	size := m.Size()
 	dAtA = make([]byte, size)
@@ -2520,6 +3134,55 @@ func (m *LogicalPlannerResult) MarshalToSizedBuffer(dAtA []byte) (int, error) {
 	return len(dAtA) - i, nil
 }
 
+func (m *BatchLogicalPlannerResult) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalToSizedBuffer(dAtA[:size])
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *BatchLogicalPlannerResult) MarshalTo(dAtA []byte) (int, error) {
+	size := m.Size()
+	return m.MarshalToSizedBuffer(dAtA[:size])
+}
+
+func (m *BatchLogicalPlannerResult) MarshalToSizedBuffer(dAtA []byte) (int, error) {
+	i := len(dAtA)
+	_ = i
+	var l int
+	_ = l
+	if len(m.Results) > 0 {
+		for iNdEx := len(m.Results) - 1; iNdEx >= 0; iNdEx-- {
+			{
+				size, err := m.Results[iNdEx].MarshalToSizedBuffer(dAtA[:i])
+				if err != nil {
+					return 0, err
+				}
+				i -= size
+				i = encodeVarintDistributedPlan(dAtA, i, uint64(size))
+			}
+			i--
+			dAtA[i] = 0x12
+		}
+	}
+	if m.Status != nil {
+		{
+			size, err := m.Status.MarshalToSizedBuffer(dAtA[:i])
+			if err != nil {
+				return 0, err
+			}
+			i -= size
+			i = encodeVarintDistributedPlan(dAtA, i, uint64(size))
+		}
+		i--
+		dAtA[i] = 0xa
+	}
+	return len(dAtA) - i, nil
+}
+
 func encodeVarintDistributedPlan(dAtA []byte, offset int, v uint64) int {
 	offset -= sovDistributedPlan(v)
 	base := offset
@@ -2635,22 +3298,17 @@ func (m *TableInfo) Size() (n int) {
 	return n
 }
 
-func (m *SchemaInfo) Size() (n int) {
+func (m *TableStatistics) Size() (n int) {
 	if m == nil {
 		return 0
 	}
 	var l int
 	_ = l
-	l = len(m.Name)
-	if l > 0 {
-		n += 1 + l + sovDistributedPlan(uint64(l))
-	}
-	if m.Relation != nil {
-		l = m.Relation.Size()
-		n += 1 + l + sovDistributedPlan(uint64(l))
+	if m.RowCount != 0 {
+		n += 1 + sovDistributedPlan(uint64(m.RowCount))
 	}
-	if len(m.AgentList) > 0 {
-		for _, e := range m.AgentList {
+	if len(m.ColumnStatistics) > 0 {
+		for _, e := range m.ColumnStatistics {
 			l = e.Size()
 			n += 1 + l + sovDistributedPlan(uint64(l))
 		}
@@ -2658,18 +3316,61 @@ func (m *SchemaInfo) Size() (n int) {
 	return n
 }
 
-func (m *DistributedState) Size() (n int) {
+func (m *TableStatistics_ColumnStatistics) Size() (n int) {
 	if m == nil {
 		return 0
 	}
 	var l int
 	_ = l
-	if len(m.CarnotInfo) > 0 {
-		for _, e := range m.CarnotInfo {
-			l = e.Size()
-			n += 1 + l + sovDistributedPlan(uint64(l))
-		}
-	}
+	l = len(m.ColumnName)
+	if l > 0 {
+		n += 1 + l + sovDistributedPlan(uint64(l))
+	}
+	if m.DistinctCount != 0 {
+		n += 1 + sovDistributedPlan(uint64(m.DistinctCount))
+	}
+	return n
+}
+
+func (m *SchemaInfo) Size() (n int) {
+	if m == nil {
+		return 0
+	}
+	var l int
+	_ = l
+	l = len(m.Name)
+	if l > 0 {
+		n += 1 + l + sovDistributedPlan(uint64(l))
+	}
+	if m.Relation != nil {
+		l = m.Relation.Size()
+		n += 1 + l + sovDistributedPlan(uint64(l))
+	}
+	if len(m.AgentList) > 0 {
+		for _, e := range m.AgentList {
+			l = e.Size()
+			n += 1 + l + sovDistributedPlan(uint64(l))
+		}
+	}
+	if m.Statistics != nil {
+		l = m.Statistics.Size()
+		n += 1 + l + sovDistributedPlan(uint64(l))
+	}
+	return n
+}
+
+func (m *DistributedState) Size() (n int) {
+	if m == nil {
+		return 0
+	}
+	var l int
+	_ = l
+	if len(m.CarnotInfo) > 0 {
+		for _, e := range m.CarnotInfo {
+			l = e.Size()
+			n += 1 + l + sovDistributedPlan(uint64(l))
+		}
+	}
 	if len(m.SchemaInfo) > 0 {
 		for _, e := range m.SchemaInfo {
 			l = e.Size()
@@ -2840,6 +3541,39 @@ func (m *LogicalPlannerState) Size() (n int) {
 	return n
 }
 
+func (m *LogicalPlannerStateUpdate) Size() (n int) {
+	if m == nil {
+		return 0
+	}
+	var l int
+	_ = l
+	if len(m.UpdatedCarnotInfo) > 0 {
+		for _, e := range m.UpdatedCarnotInfo {
+			l = e.Size()
+			n += 1 + l + sovDistributedPlan(uint64(l))
+		}
+	}
+	if len(m.RemovedAgents) > 0 {
+		for _, e := range m.RemovedAgents {
+			l = e.Size()
+			n += 1 + l + sovDistributedPlan(uint64(l))
+		}
+	}
+	if len(m.UpdatedSchemaInfo) > 0 {
+		for _, e := range m.UpdatedSchemaInfo {
+			l = e.Size()
+			n += 1 + l + sovDistributedPlan(uint64(l))
+		}
+	}
+	if len(m.RemovedTables) > 0 {
+		for _, s := range m.RemovedTables {
+			l = len(s)
+			n += 1 + l + sovDistributedPlan(uint64(l))
+		}
+	}
+	return n
+}
+
 func (m *LogicalPlannerResult) Size() (n int) {
 	if m == nil {
 		return 0
@@ -2857,6 +3591,25 @@ func (m *LogicalPlannerResult) Size() (n int) {
 	return n
 }
 
+func (m *BatchLogicalPlannerResult) Size() (n int) {
+	if m == nil {
+		return 0
+	}
+	var l int
+	_ = l
+	if m.Status != nil {
+		l = m.Status.Size()
+		n += 1 + l + sovDistributedPlan(uint64(l))
+	}
+	if len(m.Results) > 0 {
+		for _, e := range m.Results {
+			l = e.Size()
+			n += 1 + l + sovDistributedPlan(uint64(l))
+		}
+	}
+	return n
+}
+
 func sovDistributedPlan(x uint64) (n int) {
 	return (math_bits.Len64(x|1) + 6) / 7
 }
@@ -2921,6 +3674,33 @@ func (this *TableInfo) String() string {
 	}, "")
 	return s
 }
+func (this *TableStatistics) String() string {
+	if this == nil {
+		return "nil"
+	}
+	repeatedStringForColumnStatistics := "[]*TableStatistics_ColumnStatistics{"
+	for _, f := range this.ColumnStatistics {
+		repeatedStringForColumnStatistics += strings.Replace(f.String(), "TableStatistics_ColumnStatistics", "TableStatistics_ColumnStatistics", 1) + ","
+	}
+	repeatedStringForColumnStatistics += "}"
+	s := strings.Join([]string{`&TableStatistics{`,
+		`RowCount:` + fmt.Sprintf("%v", this.RowCount) + `,`,
+		`ColumnStatistics:` + repeatedStringForColumnStatistics + `,`,
+		`}`,
+	}, "")
+	return s
+}
+func (this *TableStatistics_ColumnStatistics) String() string {
+	if this == nil {
+		return "nil"
+	}
+	s := strings.Join([]string{`&TableStatistics_ColumnStatistics{`,
+		`ColumnName:` + fmt.Sprintf("%v", this.ColumnName) + `,`,
+		`DistinctCount:` + fmt.Sprintf("%v", this.DistinctCount) + `,`,
+		`}`,
+	}, "")
+	return s
+}
 func (this *SchemaInfo) String() string {
 	if this == nil {
 		return "nil"
@@ -2934,6 +3714,7 @@ func (this *SchemaInfo) String() string {
 		`Name:` + fmt.Sprintf("%v", this.Name) + `,`,
 		`Relation:` + strings.Replace(fmt.Sprintf("%v", this.Relation), "Relation", "schemapb.Relation", 1) + `,`,
 		`AgentList:` + repeatedStringForAgentList + `,`,
+		`Statistics:` + strings.Replace(this.Statistics.String(), "TableStatistics", "TableStatistics", 1) + `,`,
 		`}`,
 	}, "")
 	return s
@@ -3078,6 +3859,34 @@ func (this *LogicalPlannerState) String() string {
 	}, "")
 	return s
 }
+func (this *LogicalPlannerStateUpdate) String() string {
+	if this == nil {
+		return "nil"
+	}
+	repeatedStringForUpdatedCarnotInfo := "[]*CarnotInfo{"
+	for _, f := range this.UpdatedCarnotInfo {
+		repeatedStringForUpdatedCarnotInfo += strings.Replace(f.String(), "CarnotInfo", "CarnotInfo", 1) + ","
+	}
+	repeatedStringForUpdatedCarnotInfo += "}"
+	repeatedStringForRemovedAgents := "[]*UUID{"
+	for _, f := range this.RemovedAgents {
+		repeatedStringForRemovedAgents += strings.Replace(fmt.Sprintf("%v", f), "UUID", "uuidpb.UUID", 1) + ","
+	}
+	repeatedStringForRemovedAgents += "}"
+	repeatedStringForUpdatedSchemaInfo := "[]*SchemaInfo{"
+	for _, f := range this.UpdatedSchemaInfo {
+		repeatedStringForUpdatedSchemaInfo += strings.Replace(f.String(), "SchemaInfo", "SchemaInfo", 1) + ","
+	}
+	repeatedStringForUpdatedSchemaInfo += "}"
+	s := strings.Join([]string{`&LogicalPlannerStateUpdate{`,
+		`UpdatedCarnotInfo:` + repeatedStringForUpdatedCarnotInfo + `,`,
+		`RemovedAgents:` + repeatedStringForRemovedAgents + `,`,
+		`UpdatedSchemaInfo:` + repeatedStringForUpdatedSchemaInfo + `,`,
+		`RemovedTables:` + fmt.Sprintf("%v", this.RemovedTables) + `,`,
+		`}`,
+	}, "")
+	return s
+}
 func (this *LogicalPlannerResult) String() string {
 	if this == nil {
 		return "nil"
@@ -3089,6 +3898,22 @@ func (this *LogicalPlannerResult) String() string {
 	}, "")
 	return s
 }
+func (this *BatchLogicalPlannerResult) String() string {
+	if this == nil {
+		return "nil"
+	}
+	repeatedStringForResults := "[]*LogicalPlannerResult{"
+	for _, f := range this.Results {
+		repeatedStringForResults += strings.Replace(f.String(), "LogicalPlannerResult", "LogicalPlannerResult", 1) + ","
+	}
+	repeatedStringForResults += "}"
+	s := strings.Join([]string{`&BatchLogicalPlannerResult{`,
+		`Status:` + strings.Replace(fmt.Sprintf("%v", this.Status), "Status", "statuspb.Status", 1) + `,`,
+		`Results:` + repeatedStringForResults + `,`,
+		`}`,
+	}, "")
+	return s
+}
 func valueToStringDistributedPlan(v interface{}) string {
 	rv := reflect.ValueOf(v)
 	if rv.IsNil() {
@@ -3748,7 +4573,7 @@ func (m *TableInfo) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *SchemaInfo) Unmarshal(dAtA []byte) error {
+func (m *TableStatistics) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -3771,17 +4596,17 @@ func (m *SchemaInfo) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: SchemaInfo: wiretype end group for non-group")
+			return fmt.Errorf("proto: TableStatistics: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: SchemaInfo: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: TableStatistics: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Name", wireType)
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field RowCount", wireType)
 			}
-			var stringLen uint64
+			m.RowCount = 0
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -3791,63 +4616,14 @@ func (m *SchemaInfo) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				stringLen |= uint64(b&0x7F) << shift
+				m.RowCount |= int64(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			intStringLen := int(stringLen)
-			if intStringLen < 0 {
-				return ErrInvalidLengthDistributedPlan
-			}
-			postIndex := iNdEx + intStringLen
-			if postIndex < 0 {
-				return ErrInvalidLengthDistributedPlan
-			}
-			if postIndex > l {
-				return io.ErrUnexpectedEOF
-			}
-			m.Name = string(dAtA[iNdEx:postIndex])
-			iNdEx = postIndex
 		case 2:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Relation", wireType)
-			}
-			var msglen int
-			for shift := uint(0); ; shift += 7 {
-				if shift >= 64 {
-					return ErrIntOverflowDistributedPlan
-				}
-				if iNdEx >= l {
-					return io.ErrUnexpectedEOF
-				}
-				b := dAtA[iNdEx]
-				iNdEx++
-				msglen |= int(b&0x7F) << shift
-				if b < 0x80 {
-					break
-				}
-			}
-			if msglen < 0 {
-				return ErrInvalidLengthDistributedPlan
-			}
-			postIndex := iNdEx + msglen
-			if postIndex < 0 {
-				return ErrInvalidLengthDistributedPlan
-			}
-			if postIndex > l {
-				return io.ErrUnexpectedEOF
-			}
-			if m.Relation == nil {
-				m.Relation = &schemapb.Relation{}
-			}
-			if err := m.Relation.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
-			}
-			iNdEx = postIndex
-		case 3:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field AgentList", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field ColumnStatistics", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -3874,8 +4650,8 @@ func (m *SchemaInfo) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.AgentList = append(m.AgentList, &uuidpb.UUID{})
-			if err := m.AgentList[len(m.AgentList)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+			m.ColumnStatistics = append(m.ColumnStatistics, &TableStatistics_ColumnStatistics{})
+			if err := m.ColumnStatistics[len(m.ColumnStatistics)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
 				return err
 			}
 			iNdEx = postIndex
@@ -3900,7 +4676,7 @@ func (m *SchemaInfo) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *DistributedState) Unmarshal(dAtA []byte) error {
+func (m *TableStatistics_ColumnStatistics) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -3923,17 +4699,17 @@ func (m *DistributedState) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: DistributedState: wiretype end group for non-group")
+			return fmt.Errorf("proto: TableStatistics_ColumnStatistics: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: DistributedState: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: TableStatistics_ColumnStatistics: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field CarnotInfo", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field ColumnName", wireType)
 			}
-			var msglen int
+			var stringLen uint64
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -3943,31 +4719,29 @@ func (m *DistributedState) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				msglen |= int(b&0x7F) << shift
+				stringLen |= uint64(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			if msglen < 0 {
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
-			postIndex := iNdEx + msglen
+			postIndex := iNdEx + intStringLen
 			if postIndex < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.CarnotInfo = append(m.CarnotInfo, &CarnotInfo{})
-			if err := m.CarnotInfo[len(m.CarnotInfo)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
-			}
+			m.ColumnName = string(dAtA[iNdEx:postIndex])
 			iNdEx = postIndex
 		case 2:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field SchemaInfo", wireType)
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field DistinctCount", wireType)
 			}
-			var msglen int
+			m.DistinctCount = 0
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -3977,26 +4751,11 @@ func (m *DistributedState) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				msglen |= int(b&0x7F) << shift
+				m.DistinctCount |= int64(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			if msglen < 0 {
-				return ErrInvalidLengthDistributedPlan
-			}
-			postIndex := iNdEx + msglen
-			if postIndex < 0 {
-				return ErrInvalidLengthDistributedPlan
-			}
-			if postIndex > l {
-				return io.ErrUnexpectedEOF
-			}
-			m.SchemaInfo = append(m.SchemaInfo, &SchemaInfo{})
-			if err := m.SchemaInfo[len(m.SchemaInfo)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
-			}
-			iNdEx = postIndex
 		default:
 			iNdEx = preIndex
 			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
@@ -4018,7 +4777,7 @@ func (m *DistributedState) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *DistributedPlan) Unmarshal(dAtA []byte) error {
+func (m *SchemaInfo) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -4041,15 +4800,47 @@ func (m *DistributedPlan) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: DistributedPlan: wiretype end group for non-group")
+			return fmt.Errorf("proto: SchemaInfo: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: DistributedPlan: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: SchemaInfo: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field QbAddressToPlan", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Name", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= uint64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Name = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		case 2:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Relation", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -4076,109 +4867,16 @@ func (m *DistributedPlan) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.QbAddressToPlan == nil {
-				m.QbAddressToPlan = make(map[string]*planpb.Plan)
+			if m.Relation == nil {
+				m.Relation = &schemapb.Relation{}
 			}
-			var mapkey string
-			var mapvalue *planpb.Plan
-			for iNdEx < postIndex {
-				entryPreIndex := iNdEx
-				var wire uint64
-				for shift := uint(0); ; shift += 7 {
-					if shift >= 64 {
-						return ErrIntOverflowDistributedPlan
-					}
-					if iNdEx >= l {
-						return io.ErrUnexpectedEOF
-					}
-					b := dAtA[iNdEx]
-					iNdEx++
-					wire |= uint64(b&0x7F) << shift
-					if b < 0x80 {
-						break
-					}
-				}
-				fieldNum := int32(wire >> 3)
-				if fieldNum == 1 {
-					var stringLenmapkey uint64
-					for shift := uint(0); ; shift += 7 {
-						if shift >= 64 {
-							return ErrIntOverflowDistributedPlan
-						}
-						if iNdEx >= l {
-							return io.ErrUnexpectedEOF
-						}
-						b := dAtA[iNdEx]
-						iNdEx++
-						stringLenmapkey |= uint64(b&0x7F) << shift
-						if b < 0x80 {
-							break
-						}
-					}
-					intStringLenmapkey := int(stringLenmapkey)
-					if intStringLenmapkey < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					postStringIndexmapkey := iNdEx + intStringLenmapkey
-					if postStringIndexmapkey < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					if postStringIndexmapkey > l {
-						return io.ErrUnexpectedEOF
-					}
-					mapkey = string(dAtA[iNdEx:postStringIndexmapkey])
-					iNdEx = postStringIndexmapkey
-				} else if fieldNum == 2 {
-					var mapmsglen int
-					for shift := uint(0); ; shift += 7 {
-						if shift >= 64 {
-							return ErrIntOverflowDistributedPlan
-						}
-						if iNdEx >= l {
-							return io.ErrUnexpectedEOF
-						}
-						b := dAtA[iNdEx]
-						iNdEx++
-						mapmsglen |= int(b&0x7F) << shift
-						if b < 0x80 {
-							break
-						}
-					}
-					if mapmsglen < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					postmsgIndex := iNdEx + mapmsglen
-					if postmsgIndex < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					if postmsgIndex > l {
-						return io.ErrUnexpectedEOF
-					}
-					mapvalue = &planpb.Plan{}
-					if err := mapvalue.Unmarshal(dAtA[iNdEx:postmsgIndex]); err != nil {
-						return err
-					}
-					iNdEx = postmsgIndex
-				} else {
-					iNdEx = entryPreIndex
-					skippy, err := skipDistributedPlan(dAtA[iNdEx:])
-					if err != nil {
-						return err
-					}
-					if (skippy < 0) || (iNdEx+skippy) < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					if (iNdEx + skippy) > postIndex {
-						return io.ErrUnexpectedEOF
-					}
-					iNdEx += skippy
-				}
+			if err := m.Relation.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
 			}
-			m.QbAddressToPlan[mapkey] = mapvalue
 			iNdEx = postIndex
-		case 2:
+		case 3:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field QbAddressToDagId", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field AgentList", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -4205,93 +4903,14 @@ func (m *DistributedPlan) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.QbAddressToDagId == nil {
-				m.QbAddressToDagId = make(map[string]uint64)
-			}
-			var mapkey string
-			var mapvalue uint64
-			for iNdEx < postIndex {
-				entryPreIndex := iNdEx
-				var wire uint64
-				for shift := uint(0); ; shift += 7 {
-					if shift >= 64 {
-						return ErrIntOverflowDistributedPlan
-					}
-					if iNdEx >= l {
-						return io.ErrUnexpectedEOF
-					}
-					b := dAtA[iNdEx]
-					iNdEx++
-					wire |= uint64(b&0x7F) << shift
-					if b < 0x80 {
-						break
-					}
-				}
-				fieldNum := int32(wire >> 3)
-				if fieldNum == 1 {
-					var stringLenmapkey uint64
-					for shift := uint(0); ; shift += 7 {
-						if shift >= 64 {
-							return ErrIntOverflowDistributedPlan
-						}
-						if iNdEx >= l {
-							return io.ErrUnexpectedEOF
-						}
-						b := dAtA[iNdEx]
-						iNdEx++
-						stringLenmapkey |= uint64(b&0x7F) << shift
-						if b < 0x80 {
-							break
-						}
-					}
-					intStringLenmapkey := int(stringLenmapkey)
-					if intStringLenmapkey < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					postStringIndexmapkey := iNdEx + intStringLenmapkey
-					if postStringIndexmapkey < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					if postStringIndexmapkey > l {
-						return io.ErrUnexpectedEOF
-					}
-					mapkey = string(dAtA[iNdEx:postStringIndexmapkey])
-					iNdEx = postStringIndexmapkey
-				} else if fieldNum == 2 {
-					for shift := uint(0); ; shift += 7 {
-						if shift >= 64 {
-							return ErrIntOverflowDistributedPlan
-						}
-						if iNdEx >= l {
-							return io.ErrUnexpectedEOF
-						}
-						b := dAtA[iNdEx]
-						iNdEx++
-						mapvalue |= uint64(b&0x7F) << shift
-						if b < 0x80 {
-							break
-						}
-					}
-				} else {
-					iNdEx = entryPreIndex
-					skippy, err := skipDistributedPlan(dAtA[iNdEx:])
-					if err != nil {
-						return err
-					}
-					if (skippy < 0) || (iNdEx+skippy) < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					if (iNdEx + skippy) > postIndex {
-						return io.ErrUnexpectedEOF
-					}
-					iNdEx += skippy
-				}
+			m.AgentList = append(m.AgentList, &uuidpb.UUID{})
+			if err := m.AgentList[len(m.AgentList)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
 			}
-			m.QbAddressToDagId[mapkey] = mapvalue
 			iNdEx = postIndex
-		case 3:
+		case 4:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Dag", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Statistics", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -4318,10 +4937,10 @@ func (m *DistributedPlan) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.Dag == nil {
-				m.Dag = &planpb.DAG{}
+			if m.Statistics == nil {
+				m.Statistics = &TableStatistics{}
 			}
-			if err := m.Dag.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+			if err := m.Statistics.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
 				return err
 			}
 			iNdEx = postIndex
@@ -4346,7 +4965,7 @@ func (m *DistributedPlan) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *RedactionOptions) Unmarshal(dAtA []byte) error {
+func (m *DistributedState) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -4369,17 +4988,17 @@ func (m *RedactionOptions) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: RedactionOptions: wiretype end group for non-group")
+			return fmt.Errorf("proto: DistributedState: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: RedactionOptions: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: DistributedState: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
-			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field UseFullRedaction", wireType)
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field CarnotInfo", wireType)
 			}
-			var v int
+			var msglen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4389,17 +5008,31 @@ func (m *RedactionOptions) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				v |= int(b&0x7F) << shift
+				msglen |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			m.UseFullRedaction = bool(v != 0)
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.CarnotInfo = append(m.CarnotInfo, &CarnotInfo{})
+			if err := m.CarnotInfo[len(m.CarnotInfo)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
 		case 2:
-			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field UsePxRedactPiiBestEffort", wireType)
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field SchemaInfo", wireType)
 			}
-			var v int
+			var msglen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4409,12 +5042,26 @@ func (m *RedactionOptions) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				v |= int(b&0x7F) << shift
+				msglen |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			m.UsePxRedactPiiBestEffort = bool(v != 0)
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.SchemaInfo = append(m.SchemaInfo, &SchemaInfo{})
+			if err := m.SchemaInfo[len(m.SchemaInfo)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
 		default:
 			iNdEx = preIndex
 			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
@@ -4436,7 +5083,7 @@ func (m *RedactionOptions) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
+func (m *DistributedPlan) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -4459,17 +5106,17 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: OTelEndpointConfig: wiretype end group for non-group")
+			return fmt.Errorf("proto: DistributedPlan: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: OTelEndpointConfig: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: DistributedPlan: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field URL", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field QbAddressToPlan", wireType)
 			}
-			var stringLen uint64
+			var msglen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4479,27 +5126,124 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				stringLen |= uint64(b&0x7F) << shift
+				msglen |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			intStringLen := int(stringLen)
-			if intStringLen < 0 {
+			if msglen < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
-			postIndex := iNdEx + intStringLen
+			postIndex := iNdEx + msglen
 			if postIndex < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.URL = string(dAtA[iNdEx:postIndex])
+			if m.QbAddressToPlan == nil {
+				m.QbAddressToPlan = make(map[string]*planpb.Plan)
+			}
+			var mapkey string
+			var mapvalue *planpb.Plan
+			for iNdEx < postIndex {
+				entryPreIndex := iNdEx
+				var wire uint64
+				for shift := uint(0); ; shift += 7 {
+					if shift >= 64 {
+						return ErrIntOverflowDistributedPlan
+					}
+					if iNdEx >= l {
+						return io.ErrUnexpectedEOF
+					}
+					b := dAtA[iNdEx]
+					iNdEx++
+					wire |= uint64(b&0x7F) << shift
+					if b < 0x80 {
+						break
+					}
+				}
+				fieldNum := int32(wire >> 3)
+				if fieldNum == 1 {
+					var stringLenmapkey uint64
+					for shift := uint(0); ; shift += 7 {
+						if shift >= 64 {
+							return ErrIntOverflowDistributedPlan
+						}
+						if iNdEx >= l {
+							return io.ErrUnexpectedEOF
+						}
+						b := dAtA[iNdEx]
+						iNdEx++
+						stringLenmapkey |= uint64(b&0x7F) << shift
+						if b < 0x80 {
+							break
+						}
+					}
+					intStringLenmapkey := int(stringLenmapkey)
+					if intStringLenmapkey < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					postStringIndexmapkey := iNdEx + intStringLenmapkey
+					if postStringIndexmapkey < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					if postStringIndexmapkey > l {
+						return io.ErrUnexpectedEOF
+					}
+					mapkey = string(dAtA[iNdEx:postStringIndexmapkey])
+					iNdEx = postStringIndexmapkey
+				} else if fieldNum == 2 {
+					var mapmsglen int
+					for shift := uint(0); ; shift += 7 {
+						if shift >= 64 {
+							return ErrIntOverflowDistributedPlan
+						}
+						if iNdEx >= l {
+							return io.ErrUnexpectedEOF
+						}
+						b := dAtA[iNdEx]
+						iNdEx++
+						mapmsglen |= int(b&0x7F) << shift
+						if b < 0x80 {
+							break
+						}
+					}
+					if mapmsglen < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					postmsgIndex := iNdEx + mapmsglen
+					if postmsgIndex < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					if postmsgIndex > l {
+						return io.ErrUnexpectedEOF
+					}
+					mapvalue = &planpb.Plan{}
+					if err := mapvalue.Unmarshal(dAtA[iNdEx:postmsgIndex]); err != nil {
+						return err
+					}
+					iNdEx = postmsgIndex
+				} else {
+					iNdEx = entryPreIndex
+					skippy, err := skipDistributedPlan(dAtA[iNdEx:])
+					if err != nil {
+						return err
+					}
+					if (skippy < 0) || (iNdEx+skippy) < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					if (iNdEx + skippy) > postIndex {
+						return io.ErrUnexpectedEOF
+					}
+					iNdEx += skippy
+				}
+			}
+			m.QbAddressToPlan[mapkey] = mapvalue
 			iNdEx = postIndex
 		case 2:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Headers", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field QbAddressToDagId", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -4526,11 +5270,11 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.Headers == nil {
-				m.Headers = make(map[string]string)
+			if m.QbAddressToDagId == nil {
+				m.QbAddressToDagId = make(map[string]uint64)
 			}
 			var mapkey string
-			var mapvalue string
+			var mapvalue uint64
 			for iNdEx < postIndex {
 				entryPreIndex := iNdEx
 				var wire uint64
@@ -4579,7 +5323,6 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 					mapkey = string(dAtA[iNdEx:postStringIndexmapkey])
 					iNdEx = postStringIndexmapkey
 				} else if fieldNum == 2 {
-					var stringLenmapvalue uint64
 					for shift := uint(0); ; shift += 7 {
 						if shift >= 64 {
 							return ErrIntOverflowDistributedPlan
@@ -4589,24 +5332,11 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 						}
 						b := dAtA[iNdEx]
 						iNdEx++
-						stringLenmapvalue |= uint64(b&0x7F) << shift
+						mapvalue |= uint64(b&0x7F) << shift
 						if b < 0x80 {
 							break
 						}
 					}
-					intStringLenmapvalue := int(stringLenmapvalue)
-					if intStringLenmapvalue < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					postStringIndexmapvalue := iNdEx + intStringLenmapvalue
-					if postStringIndexmapvalue < 0 {
-						return ErrInvalidLengthDistributedPlan
-					}
-					if postStringIndexmapvalue > l {
-						return io.ErrUnexpectedEOF
-					}
-					mapvalue = string(dAtA[iNdEx:postStringIndexmapvalue])
-					iNdEx = postStringIndexmapvalue
 				} else {
 					iNdEx = entryPreIndex
 					skippy, err := skipDistributedPlan(dAtA[iNdEx:])
@@ -4622,13 +5352,13 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 					iNdEx += skippy
 				}
 			}
-			m.Headers[mapkey] = mapvalue
+			m.QbAddressToDagId[mapkey] = mapvalue
 			iNdEx = postIndex
 		case 3:
-			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Insecure", wireType)
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Dag", wireType)
 			}
-			var v int
+			var msglen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4638,12 +5368,28 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				v |= int(b&0x7F) << shift
+				msglen |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			m.Insecure = bool(v != 0)
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			if m.Dag == nil {
+				m.Dag = &planpb.DAG{}
+			}
+			if err := m.Dag.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
 		default:
 			iNdEx = preIndex
 			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
@@ -4665,7 +5411,7 @@ func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *PluginConfig) Unmarshal(dAtA []byte) error {
+func (m *RedactionOptions) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -4688,17 +5434,17 @@ func (m *PluginConfig) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: PluginConfig: wiretype end group for non-group")
+			return fmt.Errorf("proto: RedactionOptions: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: PluginConfig: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: RedactionOptions: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
 			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field StartTimeNs", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field UseFullRedaction", wireType)
 			}
-			m.StartTimeNs = 0
+			var v int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4708,16 +5454,17 @@ func (m *PluginConfig) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				m.StartTimeNs |= int64(b&0x7F) << shift
+				v |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
+			m.UseFullRedaction = bool(v != 0)
 		case 2:
 			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field EndTimeNs", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field UsePxRedactPiiBestEffort", wireType)
 			}
-			m.EndTimeNs = 0
+			var v int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4727,11 +5474,12 @@ func (m *PluginConfig) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				m.EndTimeNs |= int64(b&0x7F) << shift
+				v |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
+			m.UsePxRedactPiiBestEffort = bool(v != 0)
 		default:
 			iNdEx = preIndex
 			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
@@ -4753,7 +5501,7 @@ func (m *PluginConfig) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *DebugInfo) Unmarshal(dAtA []byte) error {
+func (m *OTelEndpointConfig) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -4776,15 +5524,47 @@ func (m *DebugInfo) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: DebugInfo: wiretype end group for non-group")
+			return fmt.Errorf("proto: OTelEndpointConfig: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: DebugInfo: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: OTelEndpointConfig: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field OtelDebugAttributes", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field URL", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= uint64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.URL = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		case 2:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Headers", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -4811,66 +5591,673 @@ func (m *DebugInfo) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.OtelDebugAttributes = append(m.OtelDebugAttributes, &DebugInfo_OTelDebugAttribute{})
-			if err := m.OtelDebugAttributes[len(m.OtelDebugAttributes)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
+			if m.Headers == nil {
+				m.Headers = make(map[string]string)
 			}
-			iNdEx = postIndex
-		default:
-			iNdEx = preIndex
-			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
-			if err != nil {
-				return err
+			var mapkey string
+			var mapvalue string
+			for iNdEx < postIndex {
+				entryPreIndex := iNdEx
+				var wire uint64
+				for shift := uint(0); ; shift += 7 {
+					if shift >= 64 {
+						return ErrIntOverflowDistributedPlan
+					}
+					if iNdEx >= l {
+						return io.ErrUnexpectedEOF
+					}
+					b := dAtA[iNdEx]
+					iNdEx++
+					wire |= uint64(b&0x7F) << shift
+					if b < 0x80 {
+						break
+					}
+				}
+				fieldNum := int32(wire >> 3)
+				if fieldNum == 1 {
+					var stringLenmapkey uint64
+					for shift := uint(0); ; shift += 7 {
+						if shift >= 64 {
+							return ErrIntOverflowDistributedPlan
+						}
+						if iNdEx >= l {
+							return io.ErrUnexpectedEOF
+						}
+						b := dAtA[iNdEx]
+						iNdEx++
+						stringLenmapkey |= uint64(b&0x7F) << shift
+						if b < 0x80 {
+							break
+						}
+					}
+					intStringLenmapkey := int(stringLenmapkey)
+					if intStringLenmapkey < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					postStringIndexmapkey := iNdEx + intStringLenmapkey
+					if postStringIndexmapkey < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					if postStringIndexmapkey > l {
+						return io.ErrUnexpectedEOF
+					}
+					mapkey = string(dAtA[iNdEx:postStringIndexmapkey])
+					iNdEx = postStringIndexmapkey
+				} else if fieldNum == 2 {
+					var stringLenmapvalue uint64
+					for shift := uint(0); ; shift += 7 {
+						if shift >= 64 {
+							return ErrIntOverflowDistributedPlan
+						}
+						if iNdEx >= l {
+							return io.ErrUnexpectedEOF
+						}
+						b := dAtA[iNdEx]
+						iNdEx++
+						stringLenmapvalue |= uint64(b&0x7F) << shift
+						if b < 0x80 {
+							break
+						}
+					}
+					intStringLenmapvalue := int(stringLenmapvalue)
+					if intStringLenmapvalue < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					postStringIndexmapvalue := iNdEx + intStringLenmapvalue
+					if postStringIndexmapvalue < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					if postStringIndexmapvalue > l {
+						return io.ErrUnexpectedEOF
+					}
+					mapvalue = string(dAtA[iNdEx:postStringIndexmapvalue])
+					iNdEx = postStringIndexmapvalue
+				} else {
+					iNdEx = entryPreIndex
+					skippy, err := skipDistributedPlan(dAtA[iNdEx:])
+					if err != nil {
+						return err
+					}
+					if (skippy < 0) || (iNdEx+skippy) < 0 {
+						return ErrInvalidLengthDistributedPlan
+					}
+					if (iNdEx + skippy) > postIndex {
+						return io.ErrUnexpectedEOF
+					}
+					iNdEx += skippy
+				}
+			}
+			m.Headers[mapkey] = mapvalue
+			iNdEx = postIndex
+		case 3:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Insecure", wireType)
+			}
+			var v int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				v |= int(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			m.Insecure = bool(v != 0)
+		default:
+			iNdEx = preIndex
+			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if (skippy < 0) || (iNdEx+skippy) < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *PluginConfig) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowDistributedPlan
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= uint64(b&0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: PluginConfig: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: PluginConfig: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field StartTimeNs", wireType)
+			}
+			m.StartTimeNs = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.StartTimeNs |= int64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 2:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field EndTimeNs", wireType)
+			}
+			m.EndTimeNs = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.EndTimeNs |= int64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		default:
+			iNdEx = preIndex
+			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if (skippy < 0) || (iNdEx+skippy) < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *DebugInfo) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowDistributedPlan
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= uint64(b&0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: DebugInfo: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: DebugInfo: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field OtelDebugAttributes", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= int(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.OtelDebugAttributes = append(m.OtelDebugAttributes, &DebugInfo_OTelDebugAttribute{})
+			if err := m.OtelDebugAttributes[len(m.OtelDebugAttributes)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		default:
+			iNdEx = preIndex
+			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if (skippy < 0) || (iNdEx+skippy) < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *DebugInfo_OTelDebugAttribute) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowDistributedPlan
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= uint64(b&0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: OTelDebugAttribute: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: OTelDebugAttribute: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Name", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= uint64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Name = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		case 2:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Value", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= uint64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Value = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		default:
+			iNdEx = preIndex
+			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if (skippy < 0) || (iNdEx+skippy) < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowDistributedPlan
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= uint64(b&0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: LogicalPlannerState: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: LogicalPlannerState: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 2:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field DistributedState", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= int(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			if m.DistributedState == nil {
+				m.DistributedState = &DistributedState{}
+			}
+			if err := m.DistributedState.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		case 3:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field PlanOptions", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= int(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			if m.PlanOptions == nil {
+				m.PlanOptions = &planpb.PlanOptions{}
+			}
+			if err := m.PlanOptions.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		case 4:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field ResultAddress", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= uint64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.ResultAddress = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		case 5:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field ResultSSLTargetName", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= uint64(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.ResultSSLTargetName = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		case 7:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field RedactionOptions", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= int(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthDistributedPlan
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			if m.RedactionOptions == nil {
+				m.RedactionOptions = &RedactionOptions{}
+			}
+			if err := m.RedactionOptions.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		case 8:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field OTelEndpointConfig", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowDistributedPlan
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= int(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthDistributedPlan
 			}
-			if (skippy < 0) || (iNdEx+skippy) < 0 {
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
-			if (iNdEx + skippy) > l {
+			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			iNdEx += skippy
-		}
-	}
-
-	if iNdEx > l {
-		return io.ErrUnexpectedEOF
-	}
-	return nil
-}
-func (m *DebugInfo_OTelDebugAttribute) Unmarshal(dAtA []byte) error {
-	l := len(dAtA)
-	iNdEx := 0
-	for iNdEx < l {
-		preIndex := iNdEx
-		var wire uint64
-		for shift := uint(0); ; shift += 7 {
-			if shift >= 64 {
-				return ErrIntOverflowDistributedPlan
-			}
-			if iNdEx >= l {
-				return io.ErrUnexpectedEOF
+			if m.OTelEndpointConfig == nil {
+				m.OTelEndpointConfig = &OTelEndpointConfig{}
 			}
-			b := dAtA[iNdEx]
-			iNdEx++
-			wire |= uint64(b&0x7F) << shift
-			if b < 0x80 {
-				break
+			if err := m.OTelEndpointConfig.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
 			}
-		}
-		fieldNum := int32(wire >> 3)
-		wireType := int(wire & 0x7)
-		if wireType == 4 {
-			return fmt.Errorf("proto: OTelDebugAttribute: wiretype end group for non-group")
-		}
-		if fieldNum <= 0 {
-			return fmt.Errorf("proto: OTelDebugAttribute: illegal tag %d (wire type %d)", fieldNum, wire)
-		}
-		switch fieldNum {
-		case 1:
+			iNdEx = postIndex
+		case 9:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Name", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field PluginConfig", wireType)
 			}
-			var stringLen uint64
+			var msglen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4880,29 +6267,33 @@ func (m *DebugInfo_OTelDebugAttribute) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				stringLen |= uint64(b&0x7F) << shift
+				msglen |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			intStringLen := int(stringLen)
-			if intStringLen < 0 {
+			if msglen < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
-			postIndex := iNdEx + intStringLen
+			postIndex := iNdEx + msglen
 			if postIndex < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.Name = string(dAtA[iNdEx:postIndex])
+			if m.PluginConfig == nil {
+				m.PluginConfig = &PluginConfig{}
+			}
+			if err := m.PluginConfig.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
 			iNdEx = postIndex
-		case 2:
+		case 10:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Value", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field DebugInfo", wireType)
 			}
-			var stringLen uint64
+			var msglen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -4912,23 +6303,27 @@ func (m *DebugInfo_OTelDebugAttribute) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				stringLen |= uint64(b&0x7F) << shift
+				msglen |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			intStringLen := int(stringLen)
-			if intStringLen < 0 {
+			if msglen < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
-			postIndex := iNdEx + intStringLen
+			postIndex := iNdEx + msglen
 			if postIndex < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.Value = string(dAtA[iNdEx:postIndex])
+			if m.DebugInfo == nil {
+				m.DebugInfo = &DebugInfo{}
+			}
+			if err := m.DebugInfo.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
 			iNdEx = postIndex
 		default:
 			iNdEx = preIndex
@@ -4951,7 +6346,7 @@ func (m *DebugInfo_OTelDebugAttribute) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
+func (m *LogicalPlannerStateUpdate) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -4974,15 +6369,15 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: LogicalPlannerState: wiretype end group for non-group")
+			return fmt.Errorf("proto: LogicalPlannerStateUpdate: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: LogicalPlannerState: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: LogicalPlannerStateUpdate: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
-		case 2:
+		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field DistributedState", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field UpdatedCarnotInfo", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -5009,16 +6404,14 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.DistributedState == nil {
-				m.DistributedState = &DistributedState{}
-			}
-			if err := m.DistributedState.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+			m.UpdatedCarnotInfo = append(m.UpdatedCarnotInfo, &CarnotInfo{})
+			if err := m.UpdatedCarnotInfo[len(m.UpdatedCarnotInfo)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
 				return err
 			}
 			iNdEx = postIndex
-		case 3:
+		case 2:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field PlanOptions", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field RemovedAgents", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -5045,18 +6438,16 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.PlanOptions == nil {
-				m.PlanOptions = &planpb.PlanOptions{}
-			}
-			if err := m.PlanOptions.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+			m.RemovedAgents = append(m.RemovedAgents, &uuidpb.UUID{})
+			if err := m.RemovedAgents[len(m.RemovedAgents)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
 				return err
 			}
 			iNdEx = postIndex
-		case 4:
+		case 3:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field ResultAddress", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field UpdatedSchemaInfo", wireType)
 			}
-			var stringLen uint64
+			var msglen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowDistributedPlan
@@ -5066,27 +6457,29 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				stringLen |= uint64(b&0x7F) << shift
+				msglen |= int(b&0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			intStringLen := int(stringLen)
-			if intStringLen < 0 {
+			if msglen < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
-			postIndex := iNdEx + intStringLen
+			postIndex := iNdEx + msglen
 			if postIndex < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.ResultAddress = string(dAtA[iNdEx:postIndex])
+			m.UpdatedSchemaInfo = append(m.UpdatedSchemaInfo, &SchemaInfo{})
+			if err := m.UpdatedSchemaInfo[len(m.UpdatedSchemaInfo)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
 			iNdEx = postIndex
-		case 5:
+		case 4:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field ResultSSLTargetName", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field RemovedTables", wireType)
 			}
 			var stringLen uint64
 			for shift := uint(0); ; shift += 7 {
@@ -5114,83 +6507,61 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.ResultSSLTargetName = string(dAtA[iNdEx:postIndex])
+			m.RemovedTables = append(m.RemovedTables, string(dAtA[iNdEx:postIndex]))
 			iNdEx = postIndex
-		case 7:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field RedactionOptions", wireType)
-			}
-			var msglen int
-			for shift := uint(0); ; shift += 7 {
-				if shift >= 64 {
-					return ErrIntOverflowDistributedPlan
-				}
-				if iNdEx >= l {
-					return io.ErrUnexpectedEOF
-				}
-				b := dAtA[iNdEx]
-				iNdEx++
-				msglen |= int(b&0x7F) << shift
-				if b < 0x80 {
-					break
-				}
-			}
-			if msglen < 0 {
-				return ErrInvalidLengthDistributedPlan
+		default:
+			iNdEx = preIndex
+			skippy, err := skipDistributedPlan(dAtA[iNdEx:])
+			if err != nil {
+				return err
 			}
-			postIndex := iNdEx + msglen
-			if postIndex < 0 {
+			if (skippy < 0) || (iNdEx+skippy) < 0 {
 				return ErrInvalidLengthDistributedPlan
 			}
-			if postIndex > l {
+			if (iNdEx + skippy) > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.RedactionOptions == nil {
-				m.RedactionOptions = &RedactionOptions{}
-			}
-			if err := m.RedactionOptions.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
-			}
-			iNdEx = postIndex
-		case 8:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field OTelEndpointConfig", wireType)
-			}
-			var msglen int
-			for shift := uint(0); ; shift += 7 {
-				if shift >= 64 {
-					return ErrIntOverflowDistributedPlan
-				}
-				if iNdEx >= l {
-					return io.ErrUnexpectedEOF
-				}
-				b := dAtA[iNdEx]
-				iNdEx++
-				msglen |= int(b&0x7F) << shift
-				if b < 0x80 {
-					break
-				}
-			}
-			if msglen < 0 {
-				return ErrInvalidLengthDistributedPlan
-			}
-			postIndex := iNdEx + msglen
-			if postIndex < 0 {
-				return ErrInvalidLengthDistributedPlan
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *LogicalPlannerResult) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowDistributedPlan
 			}
-			if postIndex > l {
+			if iNdEx >= l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.OTelEndpointConfig == nil {
-				m.OTelEndpointConfig = &OTelEndpointConfig{}
-			}
-			if err := m.OTelEndpointConfig.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= uint64(b&0x7F) << shift
+			if b < 0x80 {
+				break
 			}
-			iNdEx = postIndex
-		case 9:
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: LogicalPlannerResult: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: LogicalPlannerResult: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field PluginConfig", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Status", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -5217,16 +6588,16 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.PluginConfig == nil {
-				m.PluginConfig = &PluginConfig{}
+			if m.Status == nil {
+				m.Status = &statuspb.Status{}
 			}
-			if err := m.PluginConfig.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+			if err := m.Status.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
 				return err
 			}
 			iNdEx = postIndex
-		case 10:
+		case 2:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field DebugInfo", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Plan", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -5253,10 +6624,10 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.DebugInfo == nil {
-				m.DebugInfo = &DebugInfo{}
+			if m.Plan == nil {
+				m.Plan = &DistributedPlan{}
 			}
-			if err := m.DebugInfo.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+			if err := m.Plan.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
 				return err
 			}
 			iNdEx = postIndex
@@ -5281,7 +6652,7 @@ func (m *LogicalPlannerState) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *LogicalPlannerResult) Unmarshal(dAtA []byte) error {
+func (m *BatchLogicalPlannerResult) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -5304,10 +6675,10 @@ func (m *LogicalPlannerResult) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: LogicalPlannerResult: wiretype end group for non-group")
+			return fmt.Errorf("proto: BatchLogicalPlannerResult: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: LogicalPlannerResult: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: BatchLogicalPlannerResult: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
@@ -5348,7 +6719,7 @@ func (m *LogicalPlannerResult) Unmarshal(dAtA []byte) error {
 			iNdEx = postIndex
 		case 2:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Plan", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Results", wireType)
 			}
 			var msglen int
 			for shift := uint(0); ; shift += 7 {
@@ -5375,10 +6746,8 @@ func (m *LogicalPlannerResult) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			if m.Plan == nil {
-				m.Plan = &DistributedPlan{}
-			}
-			if err := m.Plan.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+			m.Results = append(m.Results, &LogicalPlannerResult{})
+			if err := m.Results[len(m.Results)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
 				return err
 			}
 			iNdEx = postIndex
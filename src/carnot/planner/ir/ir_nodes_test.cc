@@ -511,6 +511,108 @@ TEST_F(ToProtoTest, limit_ir) {
   EXPECT_THAT(pb, EqualsProto(kExpectedLimitPb));
 }
 
+constexpr char kExpectedSortPb[] = R"(
+  op_type: SORT_OPERATOR
+  sort_op {
+    sort_keys {
+      column_index: 2
+      descending: true
+    }
+    sort_keys {
+      column_index: 0
+      descending: true
+    }
+  }
+)";
+
+TEST_F(ToProtoTest, sort_ir) {
+  auto mem_src = graph
+                     ->CreateNode<MemorySourceIR>(
+                         ast, "source", std::vector<std::string>{"col1", "group1", "column"})
+                     .ValueOrDie();
+  table_store::schema::Relation src_rel({types::INT64, types::INT64, types::INT64},
+                                        {"col1", "group1", "column"});
+  compiler_state_->relation_map()->emplace("source", src_rel);
+
+  auto sort = graph
+                  ->CreateNode<SortIR>(ast, mem_src, std::vector<std::string>{"column", "col1"},
+                                       /* ascending */ false)
+                  .ValueOrDie();
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  planpb::Operator pb;
+  ASSERT_OK(sort->ToProto(&pb));
+
+  EXPECT_THAT(pb, EqualsProto(kExpectedSortPb));
+}
+
+constexpr char kExpectedTopKPb[] = R"(
+  op_type: TOPK_OPERATOR
+  topk_op {
+    sort_keys {
+      column_index: 1
+    }
+    limit: 12
+  }
+)";
+
+TEST_F(ToProtoTest, topk_ir) {
+  auto mem_src = graph
+                     ->CreateNode<MemorySourceIR>(
+                         ast, "source", std::vector<std::string>{"col1", "group1", "column"})
+                     .ValueOrDie();
+  table_store::schema::Relation src_rel({types::INT64, types::INT64, types::INT64},
+                                        {"col1", "group1", "column"});
+  compiler_state_->relation_map()->emplace("source", src_rel);
+
+  auto topk = graph
+                  ->CreateNode<TopKIR>(ast, mem_src, 12, std::vector<std::string>{"group1"},
+                                       /* ascending */ true)
+                  .ValueOrDie();
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  planpb::Operator pb;
+  ASSERT_OK(topk->ToProto(&pb));
+
+  EXPECT_THAT(pb, EqualsProto(kExpectedTopKPb));
+}
+
+constexpr char kExpectedSamplePb[] = R"(
+  op_type: SAMPLE_OPERATOR
+  sample_op {
+    sample_size: 1000
+    stratify_key_indices: 1
+    seed: 42
+  }
+)";
+
+TEST_F(ToProtoTest, sample_ir) {
+  auto mem_src = graph
+                     ->CreateNode<MemorySourceIR>(
+                         ast, "source", std::vector<std::string>{"col1", "group1", "column"})
+                     .ValueOrDie();
+  table_store::schema::Relation src_rel({types::INT64, types::INT64, types::INT64},
+                                        {"col1", "group1", "column"});
+  compiler_state_->relation_map()->emplace("source", src_rel);
+
+  auto sample = graph
+                    ->CreateNode<SampleIR>(ast, mem_src, 1000, std::vector<std::string>{"group1"},
+                                           /* seed */ 42)
+                    .ValueOrDie();
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  planpb::Operator pb;
+  ASSERT_OK(sample->ToProto(&pb));
+
+  EXPECT_THAT(pb, EqualsProto(kExpectedSamplePb));
+}
+
 constexpr char kInt64PbTxt[] = R"proto(
 constant {
   data_type: INT64
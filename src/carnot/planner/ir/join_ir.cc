@@ -17,6 +17,7 @@
  */
 #include <map>
 #include <memory>
+#include <utility>
 
 #include "src/carnot/planner/ir/column_ir.h"
 #include "src/carnot/planner/ir/ir.h"
@@ -85,6 +86,39 @@ planpb::JoinOperator::JoinType JoinIR::GetPbJoinEnum(JoinType join_type) {
   return join_key_iter->second;
 }
 
+Status JoinIR::FlipParents() {
+  if (join_type_ != JoinType::kInner) {
+    return CreateIRNodeError("Can only flip the parents of an inner join, got '$0'",
+                             static_cast<int64_t>(join_type_));
+  }
+  DCHECK_EQ(parents().size(), 2UL) << "There should be exactly two parents.";
+
+  std::vector<OperatorIR*> old_parents = parents();
+  for (OperatorIR* parent : old_parents) {
+    PL_RETURN_IF_ERROR(RemoveParent(parent));
+  }
+  PL_RETURN_IF_ERROR(AddParent(old_parents[1]));
+  PL_RETURN_IF_ERROR(AddParent(old_parents[0]));
+
+  // Every column that referred to parent 0 now refers to parent 1 and vice versa. The on-column
+  // vectors additionally swap roles: the old left columns are now in the right input.
+  auto flip_columns = [](const std::vector<ColumnIR*>& columns) {
+    for (ColumnIR* col : columns) {
+      DCHECK_LT(col->container_op_parent_idx(), 2);
+      col->SetContainingOperatorParentIdx(1 - col->container_op_parent_idx());
+    }
+  };
+  flip_columns(left_on_columns_);
+  flip_columns(right_on_columns_);
+  flip_columns(output_columns_);
+  std::swap(left_on_columns_, right_on_columns_);
+
+  if (suffix_strs_.size() == 2) {
+    std::swap(suffix_strs_[0], suffix_strs_[1]);
+  }
+  return Status::OK();
+}
+
 Status JoinIR::ToProto(planpb::Operator* op) const {
   planpb::JoinOperator::JoinType join_enum_type = GetPbJoinEnum(join_type_);
   DCHECK_EQ(left_on_columns_.size(), right_on_columns_.size());
@@ -90,6 +90,13 @@ class JoinIR : public OperatorIR {
                           const std::vector<ColumnIR*>& columns);
   bool specified_as_right() const { return specified_as_right_; }
 
+  /**
+   * @brief Swaps the left and right parents, updating the join columns and any column references
+   * so the output is unchanged. Only valid for inner joins, where the two sides are symmetric;
+   * used by the optimizer to put the smaller input on the build side.
+   */
+  Status FlipParents();
+
   StatusOr<std::vector<absl::flat_hash_set<std::string>>> RequiredInputColumns() const override;
 
   const std::tuple<std::shared_ptr<TableType>, std::shared_ptr<TableType>> left_right_table_types()
@@ -63,6 +63,13 @@ Status MemorySourceIR::ToProto(planpb::Operator* op) const {
     pb->set_tablet(tablet_value());
   }
 
+  for (const auto& pred : predicates_) {
+    auto pred_pb = pb->add_predicates();
+    pred_pb->set_column_index(pred.column_index);
+    pred_pb->set_op(pred.op);
+    *pred_pb->mutable_value() = pred.value;
+  }
+
   pb->set_streaming(streaming());
   return Status::OK();
 }
@@ -106,6 +113,9 @@ Status MemorySourceIR::CopyFromNodeImpl(const IRNode* node,
   column_index_map_set_ = source_ir->column_index_map_set_;
   column_index_map_ = source_ir->column_index_map_;
   streaming_ = source_ir->streaming_;
+  tablet_value_ = source_ir->tablet_value_;
+  has_tablet_value_ = source_ir->has_tablet_value_;
+  predicates_ = source_ir->predicates_;
 
   return Status::OK();
 }
@@ -21,12 +21,14 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/carnot/planner/ir/expression_ir.h"
 #include "src/carnot/planner/ir/operator_ir.h"
 #include "src/carnot/planner/types/types.h"
+#include "src/carnot/planpb/plan.pb.h"
 #include "src/carnot/udfspb/udfs.pb.h"
 #include "src/common/base/base.h"
 #include "src/shared/types/column_wrapper.h"
@@ -102,6 +104,20 @@ class MemorySourceIR : public OperatorIR {
 
   void SetColumnNames(const std::vector<std::string>& col_names) { column_names_ = col_names; }
 
+  /**
+   * @brief A column predicate pushed down into the scan, ready to be emitted into the operator
+   * proto. The column is identified by its index within the table's relation (not within the
+   * selected columns), so the predicate stays valid when unused columns are pruned.
+   */
+  struct ColumnPredicate {
+    int64_t column_index;
+    planpb::MemorySourceOperator::ColumnPredicate::Op op;
+    planpb::ScalarValue value;
+  };
+
+  void AddPredicate(ColumnPredicate predicate) { predicates_.push_back(std::move(predicate)); }
+  const std::vector<ColumnPredicate>& predicates() const { return predicates_; }
+
   bool IsSource() const override { return true; }
 
   Status ResolveType(CompilerState* compiler_state);
@@ -126,6 +142,10 @@ class MemorySourceIR : public OperatorIR {
 
   types::TabletID tablet_value_;
   bool has_tablet_value_ = false;
+
+  // Conjunction of predicates the scan may use to skip batches. Advisory: a downstream Filter
+  // still applies the full filter expression.
+  std::vector<ColumnPredicate> predicates_;
 };
 
 }  // namespace planner
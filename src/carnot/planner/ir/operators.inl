@@ -30,6 +30,9 @@ PL_IR_NODE(GRPCSource)
 PL_IR_NODE(GRPCSink)
 PL_IR_NODE(Union)
 PL_IR_NODE(Join)
+PL_IR_NODE(Sort)
+PL_IR_NODE(TopK)
+PL_IR_NODE(Sample)
 PL_IR_NODE(TabletSourceGroup)
 PL_IR_NODE(GroupBy)
 PL_IR_NODE(UDTFSource)
@@ -172,6 +172,9 @@ inline ClassMatch<IRNodeType::kGRPCSink> GRPCSink() { return ClassMatch<IRNodeTy
 
 inline ClassMatch<IRNodeType::kJoin> Join() { return ClassMatch<IRNodeType::kJoin>(); }
 inline ClassMatch<IRNodeType::kUnion> Union() { return ClassMatch<IRNodeType::kUnion>(); }
+inline ClassMatch<IRNodeType::kSort> Sort() { return ClassMatch<IRNodeType::kSort>(); }
+inline ClassMatch<IRNodeType::kTopK> TopK() { return ClassMatch<IRNodeType::kTopK>(); }
+inline ClassMatch<IRNodeType::kSample> Sample() { return ClassMatch<IRNodeType::kSample>(); }
 inline ClassMatch<IRNodeType::kTabletSourceGroup> TabletSourceGroup() {
   return ClassMatch<IRNodeType::kTabletSourceGroup>();
 }
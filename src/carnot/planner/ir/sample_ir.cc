@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/ir/sample_ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+
+Status SampleIR::Init(OperatorIR* parent, int64_t sample_size,
+                      const std::vector<std::string>& stratify_cols, int64_t seed) {
+  PL_RETURN_IF_ERROR(AddParent(parent));
+  sample_size_ = sample_size;
+  stratify_cols_ = stratify_cols;
+  seed_ = seed;
+  return Status::OK();
+}
+
+StatusOr<std::vector<absl::flat_hash_set<std::string>>> SampleIR::RequiredInputColumns() const {
+  DCHECK(is_type_resolved());
+  return std::vector<absl::flat_hash_set<std::string>>{
+      {resolved_table_type()->ColumnNames().begin(), resolved_table_type()->ColumnNames().end()}};
+}
+
+Status SampleIR::ToProto(planpb::Operator* op) const {
+  auto pb = op->mutable_sample_op();
+  op->set_op_type(planpb::SAMPLE_OPERATOR);
+  DCHECK_EQ(parents().size(), 1UL);
+
+  DCHECK(parents()[0]->is_type_resolved());
+  auto parent_table_type = parents()[0]->resolved_table_type();
+  for (const std::string& col_name : stratify_cols_) {
+    if (!parent_table_type->HasColumn(col_name)) {
+      return CreateIRNodeError("Column '$0' referenced in by not found in parent dataframe",
+                               col_name);
+    }
+    pb->add_stratify_key_indices(parent_table_type->GetColumnIndex(col_name));
+  }
+  pb->set_sample_size(sample_size_);
+  pb->set_seed(seed_);
+  return Status::OK();
+}
+
+Status SampleIR::CopyFromNodeImpl(const IRNode* node,
+                                  absl::flat_hash_map<const IRNode*, IRNode*>*) {
+  const SampleIR* sample = static_cast<const SampleIR*>(node);
+  sample_size_ = sample->sample_size_;
+  stratify_cols_ = sample->stratify_cols_;
+  seed_ = sample->seed_;
+  return Status::OK();
+}
+
+Status SampleIR::ResolveType(CompilerState* /* compiler_state */) {
+  DCHECK_EQ(1U, parent_types().size());
+  auto parent_table = std::static_pointer_cast<TableType>(parent_types()[0]);
+  for (const auto& col_name : stratify_cols_) {
+    if (!parent_table->HasColumn(col_name)) {
+      return CreateIRNodeError("Column '$0' referenced in by not found in parent dataframe",
+                               col_name);
+    }
+  }
+  return SetResolvedType(parent_types()[0]->Copy());
+}
+
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
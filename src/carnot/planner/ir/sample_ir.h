@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/planner/compiler_state/compiler_state.h"
+#include "src/carnot/planner/ir/operator_ir.h"
+#include "src/carnot/planner/types/types.h"
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+
+/**
+ * @brief The SampleIR emits a uniform random sample of its input. It compiles down to the
+ * SampleOperator, which uses reservoir sampling so memory is proportional to the sample size
+ * rather than the input. When stratify columns are set, an independent reservoir is kept per
+ * distinct key combination, so small groups are still represented.
+ */
+class SampleIR : public OperatorIR {
+ public:
+  SampleIR() = delete;
+  explicit SampleIR(int64_t id) : OperatorIR(id, IRNodeType::kSample) {}
+
+  Status Init(OperatorIR* parent, int64_t sample_size,
+              const std::vector<std::string>& stratify_cols, int64_t seed);
+
+  Status ToProto(planpb::Operator*) const override;
+
+  int64_t sample_size() const { return sample_size_; }
+  const std::vector<std::string>& stratify_cols() const { return stratify_cols_; }
+  int64_t seed() const { return seed_; }
+
+  Status CopyFromNodeImpl(const IRNode* node,
+                          absl::flat_hash_map<const IRNode*, IRNode*>* copied_nodes_map) override;
+  inline bool IsBlocking() const override { return true; }
+
+  StatusOr<std::vector<absl::flat_hash_set<std::string>>> RequiredInputColumns() const override;
+
+  Status ResolveType(CompilerState* compiler_state);
+
+ protected:
+  // Sample has no column projection of its own, so the stratify columns must survive pruning.
+  StatusOr<absl::flat_hash_set<std::string>> PruneOutputColumnsToImpl(
+      const absl::flat_hash_set<std::string>& output_cols) override {
+    absl::flat_hash_set<std::string> kept_cols = output_cols;
+    kept_cols.insert(stratify_cols_.begin(), stratify_cols_.end());
+    return kept_cols;
+  }
+
+ private:
+  int64_t sample_size_ = 0;
+  // Names of the columns that define strata. Empty means a single global reservoir.
+  std::vector<std::string> stratify_cols_;
+  // Seed for the random generator. 0 seeds from entropy; any other value makes the sample
+  // reproducible.
+  int64_t seed_ = 0;
+};
+
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/ir/topk_ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+
+Status TopKIR::Init(OperatorIR* parent, int64_t limit_value,
+                    const std::vector<std::string>& sort_cols, bool ascending) {
+  PL_RETURN_IF_ERROR(AddParent(parent));
+  limit_value_ = limit_value;
+  sort_cols_ = sort_cols;
+  ascending_ = ascending;
+  return Status::OK();
+}
+
+StatusOr<std::vector<absl::flat_hash_set<std::string>>> TopKIR::RequiredInputColumns() const {
+  DCHECK(is_type_resolved());
+  return std::vector<absl::flat_hash_set<std::string>>{
+      {resolved_table_type()->ColumnNames().begin(), resolved_table_type()->ColumnNames().end()}};
+}
+
+Status TopKIR::ToProto(planpb::Operator* op) const {
+  auto pb = op->mutable_topk_op();
+  op->set_op_type(planpb::TOPK_OPERATOR);
+  DCHECK_EQ(parents().size(), 1UL);
+
+  DCHECK(parents()[0]->is_type_resolved());
+  auto parent_table_type = parents()[0]->resolved_table_type();
+  for (const std::string& col_name : sort_cols_) {
+    if (!parent_table_type->HasColumn(col_name)) {
+      return CreateIRNodeError("Column '$0' referenced in sort_by not found in parent dataframe",
+                               col_name);
+    }
+    planpb::SortOperator::SortKey* key_pb = pb->add_sort_keys();
+    key_pb->set_column_index(parent_table_type->GetColumnIndex(col_name));
+    key_pb->set_descending(!ascending_);
+  }
+  pb->set_limit(limit_value_);
+  return Status::OK();
+}
+
+Status TopKIR::CopyFromNodeImpl(const IRNode* node, absl::flat_hash_map<const IRNode*, IRNode*>*) {
+  const TopKIR* topk = static_cast<const TopKIR*>(node);
+  limit_value_ = topk->limit_value_;
+  sort_cols_ = topk->sort_cols_;
+  ascending_ = topk->ascending_;
+  return Status::OK();
+}
+
+Status TopKIR::ResolveType(CompilerState* /* compiler_state */) {
+  DCHECK_EQ(1U, parent_types().size());
+  auto parent_table = std::static_pointer_cast<TableType>(parent_types()[0]);
+  for (const auto& col_name : sort_cols_) {
+    if (!parent_table->HasColumn(col_name)) {
+      return CreateIRNodeError("Column '$0' referenced in sort_by not found in parent dataframe",
+                               col_name);
+    }
+  }
+  return SetResolvedType(parent_types()[0]->Copy());
+}
+
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
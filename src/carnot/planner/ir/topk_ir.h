@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/planner/compiler_state/compiler_state.h"
+#include "src/carnot/planner/ir/operator_ir.h"
+#include "src/carnot/planner/types/types.h"
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+
+/**
+ * @brief The TopKIR emits the first `limit` rows of its input according to a set of key
+ * columns. It compiles down to the TopKOperator, which holds memory proportional to the
+ * limit instead of buffering the full input the way sort+limit would.
+ */
+class TopKIR : public OperatorIR {
+ public:
+  TopKIR() = delete;
+  explicit TopKIR(int64_t id) : OperatorIR(id, IRNodeType::kTopK) {}
+
+  Status Init(OperatorIR* parent, int64_t limit_value, const std::vector<std::string>& sort_cols,
+              bool ascending);
+
+  Status ToProto(planpb::Operator*) const override;
+
+  int64_t limit_value() const { return limit_value_; }
+  const std::vector<std::string>& sort_cols() const { return sort_cols_; }
+  bool ascending() const { return ascending_; }
+
+  Status CopyFromNodeImpl(const IRNode* node,
+                          absl::flat_hash_map<const IRNode*, IRNode*>* copied_nodes_map) override;
+  inline bool IsBlocking() const override { return true; }
+
+  StatusOr<std::vector<absl::flat_hash_set<std::string>>> RequiredInputColumns() const override;
+
+  Status ResolveType(CompilerState* compiler_state);
+
+ protected:
+  // TopK has no column projection of its own, so the key columns must survive pruning.
+  StatusOr<absl::flat_hash_set<std::string>> PruneOutputColumnsToImpl(
+      const absl::flat_hash_set<std::string>& output_cols) override {
+    absl::flat_hash_set<std::string> kept_cols = output_cols;
+    kept_cols.insert(sort_cols_.begin(), sort_cols_.end());
+    return kept_cols;
+  }
+
+ private:
+  int64_t limit_value_ = 0;
+  // Names of the columns to order by, in decreasing precedence.
+  std::vector<std::string> sort_cols_;
+  bool ascending_ = true;
+};
+
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
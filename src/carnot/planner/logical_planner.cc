@@ -20,6 +20,9 @@
 
 #include <utility>
 
+#include <absl/hash/hash.h>
+#include <absl/strings/str_cat.h>
+
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/shared/scriptspb/scripts.pb.h"
 
@@ -93,8 +96,23 @@ StatusOr<std::unique_ptr<CompilerState>> CreateCompilerState(
   for (const auto& debug_info_pb : logical_state.debug_info().otel_debug_attributes()) {
     debug_info.otel_debug_attrs.push_back({debug_info_pb.name(), debug_info_pb.value()});
   }
+  // Table statistics reported by the agents, keyed by table name. Tables without reported
+  // statistics are simply absent from the map.
+  planner::TableStatsMap table_statistics;
+  for (const auto& schema_info : logical_state.distributed_state().schema_info()) {
+    if (!schema_info.has_statistics()) {
+      continue;
+    }
+    planner::TableStatistics stats;
+    stats.row_count = schema_info.statistics().row_count();
+    for (const auto& col_stats : schema_info.statistics().column_statistics()) {
+      stats.column_distinct_counts[col_stats.column_name()] = col_stats.distinct_count();
+    }
+    table_statistics[schema_info.name()] = std::move(stats);
+  }
+
   // Create a CompilerState obj using the relation map and grabbing the current time.
-  return std::make_unique<planner::CompilerState>(
+  auto compiler_state = std::make_unique<planner::CompilerState>(
       std::move(rel_map), sensitive_columns, registry_info, px::CurrentTimeNS(),
       max_output_rows_per_table, logical_state.result_address(),
       logical_state.result_ssl_targetname(),
@@ -102,6 +120,8 @@ StatusOr<std::unique_ptr<CompilerState>> CreateCompilerState(
       RedactionOptionsFromPb(logical_state.redaction_options()), std::move(otel_endpoint_config),
       // TODO(philkuz) propagate the otel debug attributes here.
       std::move(plugin_config), debug_info);
+  compiler_state->set_table_statistics(std::move(table_statistics));
+  return compiler_state;
 }
 
 StatusOr<std::unique_ptr<LogicalPlanner>> LogicalPlanner::Create(const udfspb::UDFInfo& udf_info) {
@@ -119,27 +139,186 @@ Status LogicalPlanner::Init(const udfspb::UDFInfo& udf_info) {
   return Status::OK();
 }
 
+StatusOr<std::unique_ptr<distributed::DistributedPlan>> LogicalPlanner::PlanWithCompilerState(
+    const distributedpb::LogicalPlannerState& logical_state, CompilerState* compiler_state,
+    const plannerpb::QueryRequest& query_request) {
+  // Compile into the IR.
+  std::vector<plannerpb::FuncToExecute> exec_funcs(query_request.exec_funcs().begin(),
+                                                   query_request.exec_funcs().end());
+  PL_ASSIGN_OR_RETURN(std::shared_ptr<IR> single_node_plan,
+                      compiler_.CompileToIR(query_request.query_str(), compiler_state, exec_funcs));
+  // Create the distributed plan.
+  PL_ASSIGN_OR_RETURN(auto distributed_plan,
+                      distributed_planner_->Plan(logical_state.distributed_state(), compiler_state,
+                                                 single_node_plan.get()));
+  distributed_plan->SetExecutionCompleteAddress(logical_state.result_address(),
+                                                logical_state.result_ssl_targetname());
+  return distributed_plan;
+}
+
 StatusOr<std::unique_ptr<distributed::DistributedPlan>> LogicalPlanner::Plan(
     const distributedpb::LogicalPlannerState& logical_state,
     const plannerpb::QueryRequest& query_request) {
-  // Compile into the IR.
   auto ms = logical_state.plan_options().max_output_rows_per_table();
   VLOG(1) << "Max output rows: " << ms;
   PL_ASSIGN_OR_RETURN(std::unique_ptr<CompilerState> compiler_state,
                       CreateCompilerState(logical_state, registry_info_.get(), ms));
 
+  return PlanWithCompilerState(logical_state, compiler_state.get(), query_request);
+}
+
+StatusOr<std::vector<StatusOr<std::unique_ptr<distributed::DistributedPlan>>>>
+LogicalPlanner::PlanBatch(const distributedpb::LogicalPlannerState& logical_state,
+                          const plannerpb::BatchQueryRequest& batch_request) {
+  auto ms = logical_state.plan_options().max_output_rows_per_table();
+  // The compiler state (relation map, table statistics, metadata) is built once and shared
+  // by every script in the batch; constructing it dominates compile time for small scripts.
+  PL_ASSIGN_OR_RETURN(std::unique_ptr<CompilerState> compiler_state,
+                      CreateCompilerState(logical_state, registry_info_.get(), ms));
+
+  std::vector<StatusOr<std::unique_ptr<distributed::DistributedPlan>>> results;
+  results.reserve(batch_request.requests_size());
+  for (const auto& query_request : batch_request.requests()) {
+    results.push_back(PlanWithCompilerState(logical_state, compiler_state.get(), query_request));
+  }
+  return results;
+}
+
+namespace {
+
+// Fingerprints the agent set: which agents exist and how to reach them, plus the address the
+// query results are sent to. Any membership or address change alters the fingerprint.
+uint64_t AgentSetFingerprint(const distributedpb::LogicalPlannerState& logical_state) {
+  std::string buf =
+      absl::StrCat(logical_state.result_address(), "\n", logical_state.result_ssl_targetname());
+  for (const auto& carnot_info : logical_state.distributed_state().carnot_info()) {
+    absl::StrAppend(&buf, "\n", carnot_info.SerializeAsString());
+  }
+  return absl::Hash<std::string>{}(buf);
+}
+
+// Fingerprints the schemas and which agents serve them.
+uint64_t SchemaFingerprint(const distributedpb::DistributedState& state) {
+  std::string buf;
+  for (const auto& schema_info : state.schema_info()) {
+    absl::StrAppend(&buf, "\n", schema_info.SerializeAsString());
+  }
+  return absl::Hash<std::string>{}(buf);
+}
+
+}  // namespace
+
+StatusOr<distributedpb::DistributedPlan> LogicalPlanner::PlanAsProto(
+    const distributedpb::LogicalPlannerState& logical_state,
+    const plannerpb::QueryRequest& query_request) {
+  auto ms = logical_state.plan_options().max_output_rows_per_table();
+  PL_ASSIGN_OR_RETURN(std::unique_ptr<CompilerState> compiler_state,
+                      CreateCompilerState(logical_state, registry_info_.get(), ms));
+
+  // Compilation always runs, so compile-time functions are resolved before fingerprinting and
+  // the logical plan bytes fully determine the distributed plan for a given cluster layout.
   std::vector<plannerpb::FuncToExecute> exec_funcs(query_request.exec_funcs().begin(),
                                                    query_request.exec_funcs().end());
   PL_ASSIGN_OR_RETURN(
       std::shared_ptr<IR> single_node_plan,
       compiler_.CompileToIR(query_request.query_str(), compiler_state.get(), exec_funcs));
-  // Create the distributed plan.
+  PL_ASSIGN_OR_RETURN(planpb::Plan logical_plan_pb, single_node_plan->ToProto());
+
+  PlanCacheKey key{
+      absl::Hash<std::string>{}(absl::StrCat(logical_plan_pb.SerializeAsString(), "\n",
+                                             logical_state.plan_options().SerializeAsString())),
+      AgentSetFingerprint(logical_state),
+      SchemaFingerprint(logical_state.distributed_state())};
+  auto it = plan_cache_.find(key);
+  if (it != plan_cache_.end()) {
+    return it->second;
+  }
+
   PL_ASSIGN_OR_RETURN(auto distributed_plan,
                       distributed_planner_->Plan(logical_state.distributed_state(),
                                                  compiler_state.get(), single_node_plan.get()));
   distributed_plan->SetExecutionCompleteAddress(logical_state.result_address(),
                                                 logical_state.result_ssl_targetname());
-  return distributed_plan;
+  distributed_plan->SetPlanOptions(logical_state.plan_options());
+  PL_ASSIGN_OR_RETURN(distributedpb::DistributedPlan plan_pb, distributed_plan->ToProto());
+
+  if (plan_cache_.size() >= kMaxCachedPlans) {
+    plan_cache_.clear();
+  }
+  plan_cache_.emplace(key, plan_pb);
+  return plan_pb;
+}
+
+Status LogicalPlanner::SetCachedState(const distributedpb::LogicalPlannerState& logical_state) {
+  cached_state_ = logical_state;
+  has_cached_state_ = true;
+  return Status::OK();
+}
+
+namespace {
+bool UUIDEquals(const uuidpb::UUID& a, const uuidpb::UUID& b) {
+  return a.high_bits() == b.high_bits() && a.low_bits() == b.low_bits();
+}
+}  // namespace
+
+Status LogicalPlanner::ApplyCachedStateUpdate(
+    const distributedpb::LogicalPlannerStateUpdate& update) {
+  if (!has_cached_state_) {
+    return error::FailedPrecondition(
+        "Cannot apply a planner state update: no full state has been cached");
+  }
+  auto* distributed_state = cached_state_.mutable_distributed_state();
+
+  for (const auto& removed_agent : update.removed_agents()) {
+    auto* carnot_info = distributed_state->mutable_carnot_info();
+    for (auto it = carnot_info->begin(); it != carnot_info->end();) {
+      it = UUIDEquals(it->agent_id(), removed_agent) ? carnot_info->erase(it) : it + 1;
+    }
+    // Removed agents can no longer serve any schema.
+    for (auto& schema : *distributed_state->mutable_schema_info()) {
+      auto* agent_list = schema.mutable_agent_list();
+      for (auto it = agent_list->begin(); it != agent_list->end();) {
+        it = UUIDEquals(*it, removed_agent) ? agent_list->erase(it) : it + 1;
+      }
+    }
+  }
+
+  for (const auto& updated_info : update.updated_carnot_info()) {
+    bool replaced = false;
+    for (auto& carnot_info : *distributed_state->mutable_carnot_info()) {
+      if (UUIDEquals(carnot_info.agent_id(), updated_info.agent_id())) {
+        carnot_info = updated_info;
+        replaced = true;
+        break;
+      }
+    }
+    if (!replaced) {
+      *distributed_state->add_carnot_info() = updated_info;
+    }
+  }
+
+  for (const auto& removed_table : update.removed_tables()) {
+    auto* schema_info = distributed_state->mutable_schema_info();
+    for (auto it = schema_info->begin(); it != schema_info->end();) {
+      it = it->name() == removed_table ? schema_info->erase(it) : it + 1;
+    }
+  }
+
+  for (const auto& updated_schema : update.updated_schema_info()) {
+    bool replaced = false;
+    for (auto& schema : *distributed_state->mutable_schema_info()) {
+      if (schema.name() == updated_schema.name()) {
+        schema = updated_schema;
+        replaced = true;
+        break;
+      }
+    }
+    if (!replaced) {
+      *distributed_state->add_schema_info() = updated_schema;
+    }
+  }
+
+  return Status::OK();
 }
 
 StatusOr<std::unique_ptr<compiler::MutationsIR>> LogicalPlanner::CompileTrace(
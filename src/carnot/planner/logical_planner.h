@@ -19,8 +19,11 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "src/carnot/planner/compiler/compiler.h"
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/carnot/planner/distributed/distributed_plan/distributed_plan.h"
@@ -58,6 +61,30 @@ class LogicalPlanner : public NotCopyable {
       const distributedpb::LogicalPlannerState& logical_state,
       const plannerpb::QueryRequest& query);
 
+  /**
+   * @brief Plans a batch of queries (e.g. one per widget of a loading dashboard) against a
+   * single compiler state, building the relation map and table statistics once for the whole
+   * batch. Compile failures are per-entry: results are returned in request order and one bad
+   * script does not fail the rest.
+   */
+  StatusOr<std::vector<StatusOr<std::unique_ptr<distributed::DistributedPlan>>>> PlanBatch(
+      const distributedpb::LogicalPlannerState& logical_state,
+      const plannerpb::BatchQueryRequest& batch_request);
+
+  /**
+   * @brief Plans a query and returns the serialized distributed plan, caching the result keyed
+   * by the logical plan fingerprint and the agent-set and schema fingerprints of the cluster.
+   * Steady-state dashboard workloads re-plan the same scripts against an unchanged cluster, so
+   * a hit skips the distributed splitter and stitcher rules and plan serialization entirely.
+   * Compilation always runs: compile-time functions (e.g. time macros) are baked into the
+   * logical plan, so time-varying scripts change the fingerprint and miss by construction.
+   * Any agent membership or schema change alters the fingerprints, so stale plans are never
+   * served.
+   */
+  StatusOr<distributedpb::DistributedPlan> PlanAsProto(
+      const distributedpb::LogicalPlannerState& logical_state,
+      const plannerpb::QueryRequest& query);
+
   StatusOr<std::unique_ptr<compiler::MutationsIR>> CompileTrace(
       const distributedpb::LogicalPlannerState& logical_state,
       const plannerpb::CompileMutationsRequest& mutations_req);
@@ -65,13 +92,46 @@ class LogicalPlanner : public NotCopyable {
   Status Init(std::unique_ptr<planner::RegistryInfo> registry_info);
   Status Init(const udfspb::UDFInfo& udf_info);
 
+  /**
+   * @brief Caches a full planner state so that later plan requests can reference it
+   * instead of resending the entire state, which dominates planning latency on large
+   * clusters.
+   */
+  Status SetCachedState(const distributedpb::LogicalPlannerState& logical_state);
+
+  /**
+   * @brief Applies a delta (agents and schemas added, replaced or removed) to the cached
+   * planner state. A full state must have been cached with SetCachedState first.
+   */
+  Status ApplyCachedStateUpdate(const distributedpb::LogicalPlannerStateUpdate& update);
+
+  bool has_cached_state() const { return has_cached_state_; }
+  const distributedpb::LogicalPlannerState& cached_state() const { return cached_state_; }
+  size_t plan_cache_size() const { return plan_cache_.size(); }
+
  protected:
   LogicalPlanner() {}
 
  private:
+  // Compiles one query request against an already-constructed compiler state. Used directly
+  // by Plan and once per entry by PlanBatch.
+  StatusOr<std::unique_ptr<distributed::DistributedPlan>> PlanWithCompilerState(
+      const distributedpb::LogicalPlannerState& logical_state, CompilerState* compiler_state,
+      const plannerpb::QueryRequest& query_request);
+
   compiler::Compiler compiler_;
   std::unique_ptr<distributed::Planner> distributed_planner_;
   std::unique_ptr<planner::RegistryInfo> registry_info_;
+
+  distributedpb::LogicalPlannerState cached_state_;
+  bool has_cached_state_ = false;
+
+  // Cache of serialized distributed plans, keyed by (logical plan fingerprint, agent-set
+  // fingerprint, schema fingerprint). Cleared wholesale once full; steady-state dashboards
+  // cycle through a small set of plans.
+  using PlanCacheKey = std::tuple<uint64_t, uint64_t, uint64_t>;
+  static constexpr size_t kMaxCachedPlans = 128;
+  absl::flat_hash_map<PlanCacheKey, distributedpb::DistributedPlan> plan_cache_;
 };
 
 StatusOr<std::unique_ptr<CompilerState>> CreateCompilerState(
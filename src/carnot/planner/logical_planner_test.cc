@@ -107,6 +107,58 @@ TEST_F(LogicalPlannerTest, distributed_plan_test_basic_queries) {
   EXPECT_EQ(pem1_plan->second.execution_status_destinations()[0].ssl_targetname(), "kelvin.pl.svc");
 }
 
+TEST_F(LogicalPlannerTest, plan_batch) {
+  auto planner = LogicalPlanner::Create(info_).ConsumeValueOrDie();
+  auto ps = testutils::CreateTwoPEMsOneKelvinPlannerState(testutils::kHttpEventsSchema);
+
+  plannerpb::BatchQueryRequest batch_request;
+  *batch_request.add_requests() = MakeQueryRequest(testutils::kHttpRequestStats);
+  *batch_request.add_requests() = MakeQueryRequest("this is not a valid script");
+  *batch_request.add_requests() =
+      MakeQueryRequest("import px\npx.display(px.DataFrame('http_events'), 'out')");
+
+  ASSERT_OK_AND_ASSIGN(auto results, planner->PlanBatch(ps, batch_request));
+  ASSERT_EQ(3, results.size());
+
+  // Valid scripts compile as they would through Plan; the broken script fails only its own
+  // entry.
+  ASSERT_OK(results[0]);
+  EXPECT_OK(results[0].ConsumeValueOrDie()->ToProto());
+  EXPECT_NOT_OK(results[1]);
+  ASSERT_OK(results[2]);
+  auto plan_pb = results[2].ConsumeValueOrDie()->ToProto().ConsumeValueOrDie();
+  EXPECT_NE(plan_pb.qb_address_to_plan().find("kelvin"), plan_pb.qb_address_to_plan().end());
+}
+
+TEST_F(LogicalPlannerTest, plan_cache) {
+  auto planner = LogicalPlanner::Create(info_).ConsumeValueOrDie();
+  auto ps = testutils::CreateTwoPEMsOneKelvinPlannerState(testutils::kHttpEventsSchema);
+  const std::string query = "import px\npx.display(px.DataFrame('http_events'), 'out')";
+
+  ASSERT_OK_AND_ASSIGN(auto plan1, planner->PlanAsProto(ps, MakeQueryRequest(query)));
+  EXPECT_EQ(1, planner->plan_cache_size());
+
+  // Re-planning the same script against an unchanged cluster is a cache hit: same entry,
+  // byte-identical plan.
+  ASSERT_OK_AND_ASSIGN(auto plan2, planner->PlanAsProto(ps, MakeQueryRequest(query)));
+  EXPECT_EQ(1, planner->plan_cache_size());
+  EXPECT_EQ(plan1.SerializeAsString(), plan2.SerializeAsString());
+
+  // A different script is a new entry.
+  ASSERT_OK_AND_ASSIGN(
+      auto plan3,
+      planner->PlanAsProto(
+          ps, MakeQueryRequest("import px\npx.display(px.DataFrame('http_events').head(5))")));
+  EXPECT_EQ(2, planner->plan_cache_size());
+  EXPECT_NE(plan1.SerializeAsString(), plan3.SerializeAsString());
+
+  // The same script against a different agent set misses: membership changes invalidate.
+  auto one_pem_ps = testutils::CreateOnePEMOneKelvinPlannerState(testutils::kHttpEventsSchema);
+  ASSERT_OK_AND_ASSIGN(auto plan4, planner->PlanAsProto(one_pem_ps, MakeQueryRequest(query)));
+  EXPECT_EQ(3, planner->plan_cache_size());
+  EXPECT_NE(plan1.SerializeAsString(), plan4.SerializeAsString());
+}
+
 constexpr char kSimpleQueryDefaultLimit[] = R"pxl(
 import px
 t1 = px.DataFrame(table='http_events', start_time='-120s', select=['time_'])
@@ -769,6 +821,56 @@ attributes {
 })proto"));
 }
 
+TEST_F(LogicalPlannerTest, apply_cached_state_update) {
+  auto planner = LogicalPlanner::Create(info_).ConsumeValueOrDie();
+  auto state = testutils::CreateTwoPEMsOneKelvinPlannerState(testutils::kHttpEventsSchema);
+
+  // Updates must be rejected before a full state has been cached.
+  distributedpb::LogicalPlannerStateUpdate update;
+  EXPECT_FALSE(planner->has_cached_state());
+  EXPECT_NOT_OK(planner->ApplyCachedStateUpdate(update));
+
+  ASSERT_OK(planner->SetCachedState(state));
+  ASSERT_TRUE(planner->has_cached_state());
+
+  const auto& distributed_state = state.distributed_state();
+  ASSERT_GT(distributed_state.carnot_info_size(), 0);
+  const auto& removed_agent = distributed_state.carnot_info(0).agent_id();
+  *update.add_removed_agents() = removed_agent;
+  auto* added_schema = update.add_updated_schema_info();
+  added_schema->set_name("new_table");
+  ASSERT_OK(planner->ApplyCachedStateUpdate(update));
+
+  const auto& cached = planner->cached_state().distributed_state();
+  EXPECT_EQ(distributed_state.carnot_info_size() - 1, cached.carnot_info_size());
+  auto is_removed_agent = [&](const uuidpb::UUID& id) {
+    return id.high_bits() == removed_agent.high_bits() &&
+           id.low_bits() == removed_agent.low_bits();
+  };
+  for (const auto& carnot_info : cached.carnot_info()) {
+    EXPECT_FALSE(is_removed_agent(carnot_info.agent_id()));
+  }
+  // The removed agent must also be dropped from the schema agent lists.
+  for (const auto& schema : cached.schema_info()) {
+    for (const auto& agent : schema.agent_list()) {
+      EXPECT_FALSE(is_removed_agent(agent));
+    }
+  }
+  bool found_new_table = false;
+  for (const auto& schema : cached.schema_info()) {
+    found_new_table |= schema.name() == "new_table";
+  }
+  EXPECT_TRUE(found_new_table);
+
+  // Removing the schema again leaves the cached state without it.
+  distributedpb::LogicalPlannerStateUpdate removal;
+  removal.add_removed_tables("new_table");
+  ASSERT_OK(planner->ApplyCachedStateUpdate(removal));
+  for (const auto& schema : planner->cached_state().distributed_state().schema_info()) {
+    EXPECT_NE("new_table", schema.name());
+  }
+}
+
 }  // namespace planner
 }  // namespace carnot
 }  // namespace px
@@ -19,6 +19,9 @@
 #include "src/carnot/planner/objects/dataframe.h"
 #include "src/carnot/planner/ast/ast_visitor.h"
 #include "src/carnot/planner/ir/ast_utils.h"
+#include "src/carnot/planner/ir/sample_ir.h"
+#include "src/carnot/planner/ir/sort_ir.h"
+#include "src/carnot/planner/ir/topk_ir.h"
 #include "src/carnot/planner/objects/collection_object.h"
 #include "src/carnot/planner/objects/expr_object.h"
 #include "src/carnot/planner/objects/funcobject.h"
@@ -265,11 +268,54 @@ StatusOr<QLObjectPtr> LimitHandler(CompilerState* compiler_state, IR* graph, Ope
   int64_t limit_value = rows_node->val();
   bool pem_only_val = pem_only->val() > 0;
 
+  PL_ASSIGN_OR_RETURN(std::vector<std::string> sort_cols,
+                      ParseAsListOfStrings(args.GetArg("sort_by"), "sort_by"));
+  if (!sort_cols.empty()) {
+    PL_ASSIGN_OR_RETURN(BoolIR * ascending, GetArgAs<BoolIR>(ast, args, "ascending"));
+    PL_ASSIGN_OR_RETURN(
+        TopKIR * topk_op,
+        graph->CreateNode<TopKIR>(ast, op, limit_value, sort_cols, ascending->val()));
+    return Dataframe::Create(compiler_state, topk_op, visitor);
+  }
+
   PL_ASSIGN_OR_RETURN(LimitIR * limit_op,
                       graph->CreateNode<LimitIR>(ast, op, limit_value, pem_only_val));
   return Dataframe::Create(compiler_state, limit_op, visitor);
 }
 
+// Handles the sort_values() DataFrame logic.
+StatusOr<QLObjectPtr> SortHandler(CompilerState* compiler_state, IR* graph, OperatorIR* op,
+                                  const pypa::AstPtr& ast, const ParsedArgs& args,
+                                  ASTVisitor* visitor) {
+  PL_ASSIGN_OR_RETURN(std::vector<std::string> sort_cols,
+                      ParseAsListOfStrings(args.GetArg("by"), "by"));
+  if (sort_cols.empty()) {
+    return CreateAstError(ast, "'by' must specify at least one column to sort by");
+  }
+  PL_ASSIGN_OR_RETURN(BoolIR * ascending, GetArgAs<BoolIR>(ast, args, "ascending"));
+  PL_ASSIGN_OR_RETURN(SortIR * sort_op,
+                      graph->CreateNode<SortIR>(ast, op, sort_cols, ascending->val()));
+  return Dataframe::Create(compiler_state, sort_op, visitor);
+}
+
+// Handles the sample() DataFrame logic.
+StatusOr<QLObjectPtr> SampleHandler(CompilerState* compiler_state, IR* graph, OperatorIR* op,
+                                    const pypa::AstPtr& ast, const ParsedArgs& args,
+                                    ASTVisitor* visitor) {
+  PL_ASSIGN_OR_RETURN(IntIR * rows_node, GetArgAs<IntIR>(ast, args, "n"));
+  int64_t sample_size = rows_node->val();
+  if (sample_size <= 0) {
+    return CreateAstError(ast, "'n' must be a positive number of rows to sample");
+  }
+  PL_ASSIGN_OR_RETURN(std::vector<std::string> stratify_cols,
+                      ParseAsListOfStrings(args.GetArg("by"), "by"));
+  PL_ASSIGN_OR_RETURN(IntIR * seed_node, GetArgAs<IntIR>(ast, args, "seed"));
+  PL_ASSIGN_OR_RETURN(
+      SampleIR * sample_op,
+      graph->CreateNode<SampleIR>(ast, op, sample_size, stratify_cols, seed_node->val()));
+  return Dataframe::Create(compiler_state, sample_op, visitor);
+}
+
 class SubscriptHandler {
  public:
   /**
@@ -500,13 +546,14 @@ Status Dataframe::Init() {
 
   /**
    * # Equivalent to the python method method syntax:
-   * def head(self, n=5, _pem_only=False):
+   * def head(self, n=5, sort_by=[], ascending=False, _pem_only=False):
    *     ...
    */
   PL_ASSIGN_OR_RETURN(
       std::shared_ptr<FuncObject> limitfn,
       FuncObject::Create(
-          kLimitOpID, {"n", "_pem_only"}, {{"n", "5"}, {"_pem_only", "0"}},
+          kLimitOpID, {"n", "sort_by", "ascending", "_pem_only"},
+          {{"n", "5"}, {"sort_by", "[]"}, {"ascending", "False"}, {"_pem_only", "0"}},
           /* has_variable_len_args */ false,
           /* has_variable_len_kwargs */ false,
           std::bind(&LimitHandler, compiler_state_, graph(), op(), std::placeholders::_1,
@@ -515,6 +562,40 @@ Status Dataframe::Init() {
   PL_RETURN_IF_ERROR(limitfn->SetDocString(kLimitOpDocstring));
   AddMethod(kLimitOpID, limitfn);
 
+  /**
+   * # Equivalent to the python method method syntax:
+   * def sort_values(self, by, ascending=True):
+   *     ...
+   */
+  PL_ASSIGN_OR_RETURN(
+      std::shared_ptr<FuncObject> sortfn,
+      FuncObject::Create(
+          kSortOpID, {"by", "ascending"}, {{"ascending", "True"}},
+          /* has_variable_len_args */ false,
+          /* has_variable_len_kwargs */ false,
+          std::bind(&SortHandler, compiler_state_, graph(), op(), std::placeholders::_1,
+                    std::placeholders::_2, std::placeholders::_3),
+          ast_visitor()));
+  PL_RETURN_IF_ERROR(sortfn->SetDocString(kSortOpDocstring));
+  AddMethod(kSortOpID, sortfn);
+
+  /**
+   * # Equivalent to the python method method syntax:
+   * def sample(self, n, by=[], seed=0):
+   *     ...
+   */
+  PL_ASSIGN_OR_RETURN(
+      std::shared_ptr<FuncObject> samplefn,
+      FuncObject::Create(
+          kSampleOpID, {"n", "by", "seed"}, {{"by", "[]"}, {"seed", "0"}},
+          /* has_variable_len_args */ false,
+          /* has_variable_len_kwargs */ false,
+          std::bind(&SampleHandler, compiler_state_, graph(), op(), std::placeholders::_1,
+                    std::placeholders::_2, std::placeholders::_3),
+          ast_visitor()));
+  PL_RETURN_IF_ERROR(samplefn->SetDocString(kSampleOpDocstring));
+  AddMethod(kSampleOpID, samplefn);
+
   /**
    *
    * # Equivalent to the python method method syntax:
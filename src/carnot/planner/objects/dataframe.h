@@ -264,7 +264,9 @@ class Dataframe : public QLObject {
   inline static constexpr char kLimitOpDocstring[] = R"doc(
   Return the first n rows.
 
-  Returns a DataFrame with the first n rows of data.
+  Returns a DataFrame with the first n rows of data. If sort_by is set, instead returns
+  the n best rows according to the given columns, without buffering the full input the
+  way an explicit sort followed by head() would.
 
   :topic: dataframe_ops
   :opname: Limit
@@ -273,14 +275,75 @@ class Dataframe : public QLObject {
     df = px.DataFrame('http_events')
     # Keep only the first 100 http requests.
     df = df.head(100)
+    # Keep the 100 slowest http requests.
+    df = df.head(100, sort_by='latency')
 
   Args:
     n (int): The number of rows to return. If not set, default is 5.
+    sort_by (string or List[string]): Column(s) to order the rows by before taking the
+      first n. If not set, rows are returned in arrival order.
+    ascending (bool): Whether sort_by orders smallest values first. Default is False,
+      returning the rows with the largest values.
 
   Returns:
     px.DataFrame: DataFrame with the first n rows.
   )doc";
 
+  inline static constexpr char kSortOpID[] = "sort_values";
+  inline static constexpr char kSortOpDocstring[] = R"doc(
+  Sort the DataFrame by the given columns.
+
+  Returns a DataFrame totally ordered by the given columns. Sorting is blocking: output
+  is emitted only once the input has been fully consumed, so prefer head() with sort_by
+  when only the best n rows are needed.
+
+  :topic: dataframe_ops
+  :opname: Sort
+
+  Examples:
+    df = px.DataFrame('http_events')
+    # Order http requests by latency, slowest first.
+    df = df.sort_values(by='latency', ascending=False)
+
+  Args:
+    by (string or List[string]): Column(s) to order the rows by, in decreasing precedence.
+    ascending (bool): Whether to order smallest values first. Default is True.
+
+  Returns:
+    px.DataFrame: The sorted DataFrame.
+  )doc";
+
+  inline static constexpr char kSampleOpID[] = "sample";
+  inline static constexpr char kSampleOpDocstring[] = R"doc(
+  Return a uniform random sample of n rows.
+
+  Returns a DataFrame with at most n rows drawn uniformly at random from the input, using
+  memory proportional to n rather than the input size. Sampling is blocking: the sample is
+  only complete once the input has been fully consumed. If by is set, an independent sample
+  of n rows is kept per distinct combination of the given columns, so small groups are
+  still represented.
+
+  :topic: dataframe_ops
+  :opname: Sample
+
+  Examples:
+    df = px.DataFrame('http_events')
+    # Keep roughly 1000 random http requests.
+    df = df.sample(1000)
+    # Keep up to 100 random requests per service.
+    df = df.sample(100, by='service')
+
+  Args:
+    n (int): The maximum number of rows to sample.
+    by (string or List[string]): Optional column(s) that define strata; a separate sample
+      of n rows is kept per distinct combination of values.
+    seed (int): Seed for the random generator. 0 (the default) seeds from entropy; any
+      other value makes the sample reproducible.
+
+  Returns:
+    px.DataFrame: The sampled DataFrame.
+  )doc";
+
   inline static constexpr char kMergeOpID[] = "merge";
   inline static constexpr char kMergeOpDocstring[] = R"doc(
   Merges the input DataFrame with this one using a database-style join.
@@ -234,6 +234,78 @@ TEST_F(DataframeTest, LimitNonIntArgument) {
               HasCompilerError("Expected arg 'n' as type 'Int', received 'String'"));
 }
 
+TEST_F(DataframeTest, CreateTopKFromHeadSortBy) {
+  ASSERT_OK(ParseScript(var_table, "topk = df.head(100, sort_by='latency')"));
+  auto var = var_table->Lookup("topk");
+  ASSERT_EQ(var->type_descriptor().type(), QLObjectType::kDataframe);
+  auto topk_obj = std::static_pointer_cast<Dataframe>(var);
+
+  ASSERT_MATCH(topk_obj->op(), TopK());
+  TopKIR* topk = static_cast<TopKIR*>(topk_obj->op());
+  EXPECT_EQ(topk->limit_value(), 100);
+  EXPECT_THAT(topk->sort_cols(), ElementsAre("latency"));
+  EXPECT_FALSE(topk->ascending());
+}
+
+TEST_F(DataframeTest, CreateTopKFromHeadSortByList) {
+  ASSERT_OK(ParseScript(var_table, "topk = df.head(10, sort_by=['a', 'b'], ascending=True)"));
+  auto var = var_table->Lookup("topk");
+  auto topk_obj = std::static_pointer_cast<Dataframe>(var);
+
+  ASSERT_MATCH(topk_obj->op(), TopK());
+  TopKIR* topk = static_cast<TopKIR*>(topk_obj->op());
+  EXPECT_EQ(topk->limit_value(), 10);
+  EXPECT_THAT(topk->sort_cols(), ElementsAre("a", "b"));
+  EXPECT_TRUE(topk->ascending());
+}
+
+TEST_F(DataframeTest, CreateSortValues) {
+  ASSERT_OK(ParseScript(var_table, "s = df.sort_values(by='latency', ascending=False)"));
+  auto var = var_table->Lookup("s");
+  ASSERT_EQ(var->type_descriptor().type(), QLObjectType::kDataframe);
+  auto sort_obj = std::static_pointer_cast<Dataframe>(var);
+
+  ASSERT_MATCH(sort_obj->op(), Sort());
+  SortIR* sort = static_cast<SortIR*>(sort_obj->op());
+  EXPECT_THAT(sort->sort_cols(), ElementsAre("latency"));
+  EXPECT_FALSE(sort->ascending());
+}
+
+TEST_F(DataframeTest, SortValuesRequiresColumns) {
+  EXPECT_THAT(ParseScript(var_table, "df.sort_values(by=[])"),
+              HasCompilerError("'by' must specify at least one column to sort by"));
+}
+
+TEST_F(DataframeTest, CreateSample) {
+  ASSERT_OK(ParseScript(var_table, "s = df.sample(1000)"));
+  auto var = var_table->Lookup("s");
+  ASSERT_EQ(var->type_descriptor().type(), QLObjectType::kDataframe);
+  auto sample_obj = std::static_pointer_cast<Dataframe>(var);
+
+  ASSERT_MATCH(sample_obj->op(), Sample());
+  SampleIR* sample = static_cast<SampleIR*>(sample_obj->op());
+  EXPECT_EQ(sample->sample_size(), 1000);
+  EXPECT_TRUE(sample->stratify_cols().empty());
+  EXPECT_EQ(sample->seed(), 0);
+}
+
+TEST_F(DataframeTest, CreateSampleStratified) {
+  ASSERT_OK(ParseScript(var_table, "s = df.sample(100, by=['service'], seed=7)"));
+  auto var = var_table->Lookup("s");
+  auto sample_obj = std::static_pointer_cast<Dataframe>(var);
+
+  ASSERT_MATCH(sample_obj->op(), Sample());
+  SampleIR* sample = static_cast<SampleIR*>(sample_obj->op());
+  EXPECT_EQ(sample->sample_size(), 100);
+  EXPECT_THAT(sample->stratify_cols(), ElementsAre("service"));
+  EXPECT_EQ(sample->seed(), 7);
+}
+
+TEST_F(DataframeTest, SampleRequiresPositiveN) {
+  EXPECT_THAT(ParseScript(var_table, "df.sample(0)"),
+              HasCompilerError("'n' must be a positive number of rows to sample"));
+}
+
 TEST_F(DataframeTest, SubscriptFilterRows) {
   ASSERT_OK(ParseScript(var_table, "filter = df[df.service == 'blah']"));
   auto var = var_table->Lookup("filter");
@@ -358,6 +358,51 @@ func (m *QueryRequest) GetConfigs() *Configs {
 	return nil
 }
 
+// BatchQueryRequest compiles several scripts in one call, e.g. one per widget of a loading
+// dashboard, so the compiler can share parsing and planning state across them.
+type BatchQueryRequest struct {
+	Requests []*QueryRequest `protobuf:"bytes,1,rep,name=requests,proto3" json:"requests,omitempty"`
+}
+
+func (m *BatchQueryRequest) Reset()      { *m = BatchQueryRequest{} }
+func (*BatchQueryRequest) ProtoMessage() {}
+func (*BatchQueryRequest) Descriptor() ([]byte, []int) {
+	return fileDescriptor_382d495688ef31c6, []int{3}
+}
+func (m *BatchQueryRequest) XXX_Unmarshal(b []byte) error {
+	return m.Unmarshal(b)
+}
+func (m *BatchQueryRequest) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	if deterministic {
+		return xxx_messageInfo_BatchQueryRequest.Marshal(b, m, deterministic)
+	} else {
+		b = b[:cap(b)]
+		n, err := m.MarshalToSizedBuffer(b)
+		if err != nil {
+			return nil, err
+		}
+		return b[:n], nil
+	}
+}
+func (m *BatchQueryRequest) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_BatchQueryRequest.Merge(m, src)
+}
+func (m *BatchQueryRequest) XXX_Size() int {
+	return m.Size()
+}
+func (m *BatchQueryRequest) XXX_DiscardUnknown() {
+	xxx_messageInfo_BatchQueryRequest.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_BatchQueryRequest proto.InternalMessageInfo
+
+func (m *BatchQueryRequest) GetRequests() []*QueryRequest {
+	if m != nil {
+		return m.Requests
+	}
+	return nil
+}
+
 type CompileMutationsRequest struct {
 	QueryStr  string           `protobuf:"bytes,1,opt,name=query_str,json=queryStr,proto3" json:"query_str,omitempty"`
 	ExecFuncs []*FuncToExecute `protobuf:"bytes,3,rep,name=exec_funcs,json=execFuncs,proto3" json:"exec_funcs,omitempty"`
@@ -367,7 +412,7 @@ type CompileMutationsRequest struct {
 func (m *CompileMutationsRequest) Reset()      { *m = CompileMutationsRequest{} }
 func (*CompileMutationsRequest) ProtoMessage() {}
 func (*CompileMutationsRequest) Descriptor() ([]byte, []int) {
-	return fileDescriptor_382d495688ef31c6, []int{3}
+	return fileDescriptor_382d495688ef31c6, []int{4}
 }
 func (m *CompileMutationsRequest) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -424,7 +469,7 @@ type DeleteTracepoint struct {
 func (m *DeleteTracepoint) Reset()      { *m = DeleteTracepoint{} }
 func (*DeleteTracepoint) ProtoMessage() {}
 func (*DeleteTracepoint) Descriptor() ([]byte, []int) {
-	return fileDescriptor_382d495688ef31c6, []int{4}
+	return fileDescriptor_382d495688ef31c6, []int{5}
 }
 func (m *DeleteTracepoint) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -469,7 +514,7 @@ type ConfigUpdate struct {
 func (m *ConfigUpdate) Reset()      { *m = ConfigUpdate{} }
 func (*ConfigUpdate) ProtoMessage() {}
 func (*ConfigUpdate) Descriptor() ([]byte, []int) {
-	return fileDescriptor_382d495688ef31c6, []int{5}
+	return fileDescriptor_382d495688ef31c6, []int{6}
 }
 func (m *ConfigUpdate) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -531,7 +576,7 @@ type CompileMutation struct {
 func (m *CompileMutation) Reset()      { *m = CompileMutation{} }
 func (*CompileMutation) ProtoMessage() {}
 func (*CompileMutation) Descriptor() ([]byte, []int) {
-	return fileDescriptor_382d495688ef31c6, []int{6}
+	return fileDescriptor_382d495688ef31c6, []int{7}
 }
 func (m *CompileMutation) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -626,7 +671,7 @@ type CompileMutationsResponse struct {
 func (m *CompileMutationsResponse) Reset()      { *m = CompileMutationsResponse{} }
 func (*CompileMutationsResponse) ProtoMessage() {}
 func (*CompileMutationsResponse) Descriptor() ([]byte, []int) {
-	return fileDescriptor_382d495688ef31c6, []int{7}
+	return fileDescriptor_382d495688ef31c6, []int{8}
 }
 func (m *CompileMutationsResponse) XXX_Unmarshal(b []byte) error {
 	return m.Unmarshal(b)
@@ -677,6 +722,7 @@ func init() {
 	proto.RegisterMapType((map[string]string)(nil), "px.carnot.planner.plannerpb.Configs.OTelEndpointConfig.HeadersEntry")
 	proto.RegisterType((*Configs_PluginConfig)(nil), "px.carnot.planner.plannerpb.Configs.PluginConfig")
 	proto.RegisterType((*QueryRequest)(nil), "px.carnot.planner.plannerpb.QueryRequest")
+	proto.RegisterType((*BatchQueryRequest)(nil), "px.carnot.planner.plannerpb.BatchQueryRequest")
 	proto.RegisterType((*CompileMutationsRequest)(nil), "px.carnot.planner.plannerpb.CompileMutationsRequest")
 	proto.RegisterType((*DeleteTracepoint)(nil), "px.carnot.planner.plannerpb.DeleteTracepoint")
 	proto.RegisterType((*ConfigUpdate)(nil), "px.carnot.planner.plannerpb.ConfigUpdate")
@@ -689,63 +735,63 @@ func init() {
 }
 
 var fileDescriptor_382d495688ef31c6 = []byte{
-	// 886 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xd4, 0x55, 0x51, 0x6f, 0x1b, 0x45,
-	0x10, 0xf6, 0xd9, 0x69, 0x63, 0x8f, 0x1d, 0x48, 0xb7, 0x15, 0x18, 0x57, 0xba, 0x56, 0x56, 0x41,
-	0x05, 0xda, 0xb3, 0x48, 0x91, 0x40, 0x95, 0x00, 0xe1, 0x26, 0x28, 0x54, 0x50, 0xc2, 0xd6, 0xed,
-	0x43, 0x55, 0x71, 0x5a, 0xdf, 0x4d, 0xae, 0x27, 0xee, 0x76, 0xaf, 0xbb, 0x7b, 0x28, 0x7e, 0x83,
-	0x7f, 0x80, 0xc4, 0x4f, 0xe0, 0x05, 0xfe, 0x03, 0x2f, 0xbc, 0xf1, 0x98, 0xc7, 0x3e, 0x55, 0xe4,
-	0x22, 0x01, 0x8f, 0xfd, 0x09, 0xe8, 0x76, 0xef, 0x52, 0x27, 0xb5, 0x82, 0xc5, 0x5b, 0x9f, 0x6e,
-	0x66, 0x76, 0xe6, 0x9b, 0x9d, 0x6f, 0x76, 0xe6, 0xe0, 0x9a, 0x92, 0xc1, 0x28, 0x60, 0x92, 0x0b,
-	0x3d, 0xca, 0x12, 0xc6, 0x39, 0xca, 0xfa, 0x9b, 0x4d, 0x47, 0xbb, 0x39, 0x0f, 0x7c, 0x26, 0x23,
-	0xe5, 0x65, 0x52, 0x68, 0x41, 0x2e, 0x66, 0x7b, 0x9e, 0x75, 0xf6, 0x2a, 0x27, 0xef, 0xc8, 0x79,
-	0xf0, 0xd1, 0x02, 0xa8, 0x70, 0xc6, 0x59, 0x1a, 0x07, 0xbe, 0x96, 0x2c, 0x88, 0x79, 0x34, 0x8a,
-	0xe5, 0x28, 0x11, 0x51, 0x1c, 0xb0, 0x24, 0x9b, 0xd6, 0x92, 0xc5, 0x1e, 0xbc, 0x69, 0xc2, 0x45,
-	0x9a, 0x0a, 0x3e, 0x9a, 0x32, 0x85, 0x23, 0xa5, 0x99, 0xce, 0x55, 0x36, 0xad, 0x84, 0xca, 0xed,
-	0x7a, 0x14, 0xeb, 0x47, 0xf9, 0xd4, 0x0b, 0x44, 0x3a, 0x8a, 0x44, 0x24, 0x46, 0xc6, 0x3c, 0xcd,
-	0x77, 0x8d, 0x66, 0x14, 0x23, 0x59, 0xf7, 0xe1, 0x5f, 0x0e, 0xac, 0x7d, 0x96, 0xf3, 0x60, 0x22,
-	0xb6, 0xf6, 0x30, 0xc8, 0x35, 0x92, 0x8b, 0xd0, 0x31, 0x65, 0x71, 0x96, 0x62, 0xdf, 0xb9, 0xec,
-	0x5c, 0xed, 0xd0, 0x76, 0x69, 0xb8, 0xc3, 0x52, 0x24, 0x14, 0x80, 0xc9, 0xc8, 0xff, 0x8e, 0x25,
-	0x39, 0xaa, 0x7e, 0xf3, 0x72, 0xeb, 0x6a, 0x77, 0xe3, 0x86, 0x77, 0x4a, 0xd5, 0xde, 0x31, 0x70,
-	0xef, 0x53, 0x19, 0xdd, 0x2f, 0x63, 0x69, 0x87, 0x55, 0x92, 0x22, 0x1e, 0x9c, 0x17, 0xb9, 0xce,
-	0x72, 0xed, 0x6b, 0x36, 0x4d, 0xd0, 0xcf, 0x24, 0xee, 0xc6, 0x7b, 0xfd, 0x96, 0x49, 0x7d, 0xce,
-	0x1e, 0x4d, 0xca, 0x93, 0x1d, 0x73, 0x30, 0x78, 0x1f, 0xda, 0x35, 0x0c, 0x21, 0xb0, 0x32, 0x77,
-	0x4f, 0x23, 0x93, 0x0b, 0x70, 0xc6, 0xdc, 0xaf, 0xdf, 0x34, 0x46, 0xab, 0x0c, 0x7f, 0x5e, 0x81,
-	0xd5, 0x5b, 0x82, 0xef, 0xc6, 0x91, 0x22, 0x3f, 0x38, 0x70, 0x41, 0x68, 0x4c, 0x7c, 0xe4, 0x61,
-	0x26, 0x62, 0xae, 0xfd, 0xc0, 0x9c, 0x18, 0x98, 0xee, 0xc6, 0x07, 0xa7, 0x16, 0x54, 0x81, 0x78,
-	0x5f, 0x4d, 0x30, 0xd9, 0xaa, 0xe2, 0xad, 0x6d, 0xfc, 0x5a, 0xf1, 0xf4, 0x12, 0x79, 0xd1, 0x4e,
-	0x49, 0x99, 0xec, 0xb8, 0x8d, 0xdc, 0x87, 0xb5, 0x2c, 0xc9, 0xa3, 0x98, 0xd7, 0xb9, 0x9b, 0x26,
-	0xf7, 0x7b, 0x4b, 0xe5, 0xde, 0x31, 0x91, 0x15, 0x7a, 0x2f, 0x9b, 0xd3, 0x06, 0x7f, 0x3b, 0xb0,
-	0xe0, 0x0a, 0xe4, 0x0d, 0x68, 0xe5, 0x32, 0xb1, 0x3c, 0x8d, 0x57, 0x8b, 0xa7, 0x97, 0x5a, 0xf7,
-	0xe8, 0x17, 0xb4, 0xb4, 0x91, 0x6f, 0x60, 0xf5, 0x11, 0xb2, 0x10, 0x65, 0xdd, 0xd0, 0xcd, 0xff,
-	0x59, 0xbf, 0xb7, 0x6d, 0x61, 0xb6, 0xb8, 0x96, 0x33, 0x5a, 0x83, 0x92, 0x01, 0xb4, 0x63, 0xae,
-	0x30, 0xc8, 0x25, 0x9a, 0xa6, 0xb6, 0xe9, 0x91, 0x3e, 0xb8, 0x09, 0xbd, 0xf9, 0x20, 0xb2, 0x0e,
-	0xad, 0x6f, 0x71, 0x56, 0xb5, 0xb3, 0x14, 0x17, 0x77, 0xf3, 0x66, 0xf3, 0x43, 0x67, 0x40, 0xa1,
-	0x37, 0xcf, 0x03, 0x19, 0xc2, 0x9a, 0xd2, 0x4c, 0x6a, 0x5f, 0xc7, 0x29, 0xfa, 0x5c, 0x19, 0x94,
-	0x16, 0xed, 0x1a, 0xe3, 0x24, 0x4e, 0xf1, 0x8e, 0x22, 0x2e, 0x74, 0x91, 0x87, 0x47, 0x1e, 0x4d,
-	0xe3, 0xd1, 0x41, 0x1e, 0xda, 0xf3, 0xe1, 0x6f, 0x0e, 0xf4, 0xbe, 0xce, 0x51, 0xce, 0x28, 0x3e,
-	0xce, 0x51, 0xe9, 0x72, 0x1a, 0x1e, 0x97, 0xba, 0xaf, 0xb4, 0xac, 0xa7, 0xc1, 0x18, 0xee, 0x6a,
-	0x49, 0x3e, 0x07, 0xc0, 0x3d, 0x0c, 0xfc, 0x72, 0x3c, 0x54, 0xbf, 0x65, 0xc8, 0x7b, 0x67, 0xf9,
-	0x69, 0xa0, 0x9d, 0x32, 0xba, 0x34, 0x29, 0xf2, 0x31, 0xac, 0xda, 0x77, 0xa0, 0xfa, 0x2b, 0xe6,
-	0x21, 0x5c, 0x59, 0xa6, 0x09, 0xb4, 0x0e, 0xba, 0xbd, 0xd2, 0x6e, 0xae, 0xb7, 0x86, 0xbf, 0x3b,
-	0xf0, 0xfa, 0x2d, 0x91, 0x66, 0x71, 0x82, 0x5f, 0xe6, 0x9a, 0xe9, 0x58, 0x70, 0xf5, 0x92, 0x55,
-	0x32, 0x7c, 0x0b, 0xd6, 0x37, 0x31, 0x41, 0x8d, 0x13, 0xc9, 0x02, 0x34, 0xcf, 0x6b, 0xd1, 0x98,
-	0x0f, 0x1f, 0x42, 0xcf, 0xc6, 0xde, 0xcb, 0x42, 0xa6, 0x71, 0xd9, 0xa7, 0x43, 0xae, 0xc0, 0x2b,
-	0x2c, 0x42, 0xae, 0xfd, 0x4c, 0x84, 0x76, 0xc9, 0xd9, 0x4d, 0xd3, 0x33, 0xd6, 0x1d, 0x11, 0x96,
-	0x8b, 0x6e, 0xf8, 0x6b, 0x13, 0x5e, 0x3d, 0xc1, 0x24, 0x79, 0x00, 0x67, 0xca, 0x3d, 0x8d, 0xd5,
-	0xa8, 0x8e, 0x17, 0xd4, 0x75, 0x62, 0x9f, 0x7b, 0xb1, 0xf4, 0xea, 0x2d, 0xfe, 0xbc, 0x9c, 0x4d,
-	0xcc, 0x12, 0x31, 0x4b, 0x91, 0xeb, 0xed, 0x06, 0xb5, 0x90, 0xe4, 0x21, 0x9c, 0x0b, 0x4d, 0xd5,
-	0x26, 0xd4, 0xfa, 0x99, 0x8b, 0x75, 0x37, 0xae, 0x9f, 0xca, 0xdf, 0x49, 0xae, 0xb6, 0x1b, 0x74,
-	0x3d, 0x3c, 0xc9, 0xdf, 0x0e, 0xac, 0x59, 0x7a, 0xfd, 0xdc, 0x90, 0x55, 0x75, 0xe6, 0xed, 0x25,
-	0x3a, 0x63, 0xd9, 0xdd, 0x6e, 0xd0, 0x5e, 0x30, 0xa7, 0x8f, 0x01, 0xda, 0x69, 0xc5, 0xcb, 0xf0,
-	0x27, 0x07, 0xfa, 0x2f, 0xbe, 0x3a, 0x95, 0x09, 0xae, 0x90, 0xbc, 0x0b, 0x67, 0xed, 0xff, 0xa9,
-	0x5a, 0xae, 0xe7, 0xcb, 0x9c, 0xf5, 0xaf, 0xcb, 0xbb, 0x6b, 0x04, 0x5a, 0xb9, 0x90, 0xdb, 0xd0,
-	0xa9, 0x51, 0xeb, 0x65, 0x74, 0xed, 0x3f, 0xee, 0x78, 0x2c, 0x2d, 0x7d, 0x1e, 0x3e, 0xfe, 0x64,
-	0xff, 0xc0, 0x6d, 0x3c, 0x39, 0x70, 0x1b, 0xcf, 0x0e, 0x5c, 0xe7, 0xfb, 0xc2, 0x75, 0x7e, 0x29,
-	0x5c, 0xe7, 0x8f, 0xc2, 0x75, 0xf6, 0x0b, 0xd7, 0xf9, 0xb3, 0x70, 0x9d, 0x7f, 0x0a, 0xb7, 0xf1,
-	0xac, 0x70, 0x9d, 0x1f, 0x0f, 0xdd, 0xc6, 0xfe, 0xa1, 0xdb, 0x78, 0x72, 0xe8, 0x36, 0x1e, 0x74,
-	0x8e, 0xb0, 0xa7, 0x67, 0xcd, 0x1f, 0xf2, 0xc6, 0xbf, 0x01, 0x00, 0x00, 0xff, 0xff, 0x49, 0x2f,
-	0x09, 0xcd, 0x03, 0x08, 0x00, 0x00,
+	// 895 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd5, 0x55, 0x4f, 0x6f, 0x13, 0x47,
+	0x14, 0xcf, 0xda, 0x81, 0xd8, 0xcf, 0x4e, 0x49, 0x06, 0x04, 0xc6, 0x48, 0x2e, 0x5a, 0x41, 0x45,
+	0xf9, 0xb3, 0x2b, 0x02, 0x12, 0x15, 0x12, 0xa0, 0x9a, 0xa4, 0xa2, 0xa8, 0x85, 0xb0, 0x18, 0x0e,
+	0x11, 0x62, 0xb5, 0x5e, 0x4f, 0x36, 0x2b, 0xd6, 0x3b, 0xcb, 0xcc, 0x2c, 0x4a, 0x6e, 0xe5, 0x1b,
+	0x20, 0xf1, 0x11, 0xb8, 0xc0, 0x77, 0xe8, 0x85, 0x1b, 0xc7, 0x1c, 0x39, 0x55, 0x25, 0x48, 0xb4,
+	0xc7, 0x7e, 0x84, 0xbe, 0x99, 0xd9, 0x35, 0x4e, 0xb0, 0x4c, 0xd4, 0x5b, 0x0f, 0xa3, 0x79, 0xef,
+	0xcd, 0x7b, 0xbf, 0xf7, 0x67, 0xde, 0xbc, 0x81, 0xf3, 0x82, 0x87, 0x6e, 0x18, 0xf0, 0x94, 0x49,
+	0x37, 0x4b, 0x82, 0x34, 0xa5, 0xbc, 0xdc, 0xb3, 0xbe, 0xbb, 0x9e, 0xa7, 0xa1, 0x1f, 0xf0, 0x48,
+	0x38, 0x19, 0x67, 0x92, 0x91, 0x13, 0xd9, 0xa6, 0x63, 0x94, 0x9d, 0x42, 0xc9, 0x19, 0x29, 0xb7,
+	0xaf, 0x4d, 0x80, 0x1a, 0x6c, 0xa5, 0xc1, 0x30, 0x0e, 0x7d, 0xc9, 0x83, 0x30, 0x4e, 0x23, 0x37,
+	0xe6, 0x6e, 0xc2, 0xa2, 0x38, 0x0c, 0x12, 0x44, 0x2f, 0x28, 0x83, 0xdd, 0x3e, 0xad, 0xcd, 0xd9,
+	0x70, 0xc8, 0x52, 0xb7, 0x1f, 0x08, 0xea, 0x0a, 0x19, 0xc8, 0x5c, 0xa0, 0x9e, 0x21, 0x0a, 0xb5,
+	0x0b, 0x51, 0x2c, 0x37, 0xf2, 0xbe, 0x83, 0x9a, 0x6e, 0xc4, 0x22, 0xe6, 0x6a, 0x71, 0x3f, 0x5f,
+	0xd7, 0x9c, 0x66, 0x34, 0x65, 0xd4, 0xed, 0x4f, 0x16, 0xcc, 0xff, 0x84, 0x59, 0xf4, 0xd8, 0xca,
+	0x26, 0x0d, 0x73, 0x49, 0xc9, 0x09, 0xa8, 0xeb, 0xb4, 0x30, 0x30, 0xda, 0xb2, 0x4e, 0x5a, 0x67,
+	0xea, 0x5e, 0x4d, 0x09, 0xee, 0x20, 0x4f, 0x3c, 0x00, 0x4c, 0xd7, 0x7f, 0x16, 0x24, 0x39, 0x15,
+	0xad, 0xca, 0xc9, 0xea, 0x99, 0xc6, 0xd2, 0x25, 0x67, 0x4a, 0xd6, 0xce, 0x2e, 0x70, 0xe7, 0x47,
+	0x1e, 0x3d, 0x54, 0xb6, 0x5e, 0x3d, 0x28, 0x28, 0x41, 0x1c, 0x38, 0xcc, 0x72, 0x99, 0xe5, 0xd2,
+	0x97, 0x41, 0x3f, 0xa1, 0x7e, 0xc6, 0xe9, 0x7a, 0xbc, 0xd9, 0xaa, 0x6a, 0xd7, 0x8b, 0xe6, 0xa8,
+	0xa7, 0x4e, 0x56, 0xf5, 0x41, 0xfb, 0x32, 0xd4, 0x4a, 0x18, 0x42, 0x60, 0x76, 0x2c, 0x4e, 0x4d,
+	0x93, 0x23, 0x70, 0x40, 0xc7, 0x87, 0xe1, 0x29, 0xa1, 0x61, 0xec, 0x57, 0xb3, 0x30, 0x77, 0x93,
+	0xa5, 0xeb, 0x71, 0x24, 0xc8, 0x73, 0x0b, 0x8e, 0x30, 0x49, 0x13, 0x9f, 0xa6, 0x83, 0x8c, 0xc5,
+	0xa9, 0xf4, 0x43, 0x7d, 0xa2, 0x61, 0x1a, 0x4b, 0x57, 0xa6, 0x26, 0x54, 0x80, 0x38, 0x77, 0x7b,
+	0x34, 0x59, 0x29, 0xec, 0x8d, 0xac, 0x7b, 0x74, 0xe7, 0x8f, 0x6f, 0xc9, 0x97, 0x72, 0x8f, 0x28,
+	0x67, 0xbb, 0x65, 0xe4, 0x21, 0xcc, 0x67, 0x49, 0x1e, 0xc5, 0x69, 0xe9, 0xbb, 0xa2, 0x7d, 0x5f,
+	0xdc, 0x97, 0xef, 0x55, 0x6d, 0x59, 0xa0, 0x37, 0xb3, 0x31, 0xae, 0xfd, 0x97, 0x05, 0x13, 0x42,
+	0x20, 0xc7, 0xa1, 0x9a, 0xf3, 0xc4, 0xd4, 0xa9, 0x3b, 0x87, 0x71, 0x56, 0x1f, 0x78, 0xbf, 0x78,
+	0x4a, 0x46, 0x1e, 0xc3, 0xdc, 0x06, 0x0d, 0x06, 0x94, 0x97, 0x17, 0xba, 0xfc, 0x1f, 0xf3, 0x77,
+	0x6e, 0x19, 0x98, 0x95, 0x54, 0xf2, 0x2d, 0xaf, 0x04, 0x25, 0x6d, 0xa8, 0xc5, 0xa9, 0xc0, 0xfb,
+	0xe7, 0x54, 0x5f, 0x6a, 0xcd, 0x1b, 0xf1, 0xed, 0xab, 0xd0, 0x1c, 0x37, 0x22, 0x0b, 0x50, 0x7d,
+	0x42, 0xb7, 0x8a, 0xeb, 0x54, 0xe4, 0xe4, 0xdb, 0xbc, 0x5a, 0xf9, 0xc1, 0x6a, 0x7b, 0xd0, 0x1c,
+	0xaf, 0x03, 0xb1, 0x61, 0x1e, 0x5f, 0x02, 0xc7, 0x36, 0x8a, 0x87, 0xd4, 0x4f, 0x85, 0x46, 0xa9,
+	0x7a, 0x0d, 0x2d, 0xec, 0xa1, 0xec, 0x8e, 0x20, 0x1d, 0x68, 0xe0, 0x9d, 0x8f, 0x34, 0x2a, 0x5a,
+	0xa3, 0x8e, 0x22, 0x73, 0x6e, 0xff, 0x6e, 0x41, 0xf3, 0x5e, 0x4e, 0x31, 0x7c, 0xfa, 0x14, 0x7b,
+	0x53, 0xaa, 0xd7, 0xf0, 0x54, 0xf1, 0xbe, 0x90, 0xbc, 0x7c, 0x0d, 0x5a, 0x70, 0x5f, 0x72, 0xf2,
+	0x33, 0x00, 0xc5, 0xc6, 0xf6, 0xd5, 0xf3, 0x10, 0x98, 0x9b, 0x2a, 0xde, 0xd9, 0xfd, 0xbf, 0x06,
+	0x74, 0x8c, 0x84, 0x12, 0x09, 0x72, 0x1d, 0xe6, 0x4c, 0x1f, 0x88, 0xd6, 0xac, 0x6e, 0x84, 0x53,
+	0xfb, 0xb9, 0x04, 0xaf, 0x34, 0xba, 0x3d, 0x5b, 0xab, 0x2c, 0x54, 0xed, 0x35, 0x58, 0xec, 0x06,
+	0x32, 0xdc, 0xd8, 0x95, 0xc2, 0x0a, 0xd4, 0xb8, 0x21, 0x55, 0x49, 0x54, 0x8c, 0xdf, 0x4f, 0xc5,
+	0x1e, 0x37, 0xf6, 0x46, 0xa6, 0xf6, 0x5b, 0x0b, 0x8e, 0xdd, 0x64, 0xc3, 0x2c, 0x4e, 0xe8, 0xaf,
+	0x39, 0x4e, 0x9c, 0x98, 0xa5, 0xe2, 0x7f, 0x56, 0x25, 0xfb, 0x3b, 0x58, 0x58, 0xa6, 0x09, 0x95,
+	0xb4, 0x87, 0xf3, 0x96, 0xea, 0xd6, 0x9d, 0x34, 0x42, 0xec, 0x47, 0xd0, 0x34, 0xb6, 0x0f, 0xb2,
+	0x41, 0x80, 0x33, 0x71, 0x9f, 0x6d, 0x49, 0x4e, 0xc1, 0x37, 0x41, 0x44, 0x71, 0x9e, 0x64, 0x6c,
+	0x60, 0x06, 0xa8, 0x99, 0x62, 0x4d, 0x2d, 0x5d, 0x65, 0x03, 0x35, 0x44, 0xed, 0x37, 0x15, 0x38,
+	0xb4, 0xa7, 0x92, 0x64, 0x0d, 0x0e, 0xa8, 0x3f, 0x80, 0x16, 0x63, 0xa0, 0x3b, 0x21, 0xaf, 0x3d,
+	0x7f, 0x85, 0x13, 0x73, 0xa7, 0xfc, 0x21, 0x3e, 0xa7, 0xb3, 0x4c, 0xb3, 0x84, 0x6d, 0x0d, 0xd1,
+	0xdb, 0xad, 0x19, 0xcf, 0x40, 0x92, 0x47, 0xb0, 0x38, 0xd0, 0x59, 0x6b, 0x53, 0xa3, 0xa7, 0x03,
+	0x6b, 0x2c, 0x5d, 0x98, 0x5a, 0xbf, 0xbd, 0xb5, 0x42, 0xc8, 0x85, 0xc1, 0xde, 0xfa, 0xad, 0xc2,
+	0xbc, 0x29, 0xaf, 0x9f, 0xeb, 0x62, 0x15, 0x37, 0x33, 0xbd, 0xc7, 0xc6, 0xab, 0x8b, 0xa8, 0xcd,
+	0x70, 0x8c, 0xef, 0x02, 0xd4, 0x86, 0x45, 0x5d, 0xec, 0x97, 0x16, 0xb4, 0xbe, 0xec, 0x3a, 0x91,
+	0xe1, 0x46, 0xc9, 0x39, 0x38, 0x68, 0xfe, 0xbe, 0x62, 0x70, 0x1f, 0x56, 0x3e, 0xcb, 0x6f, 0xd1,
+	0xb9, 0xaf, 0x09, 0xaf, 0x50, 0x21, 0xb7, 0xa1, 0x5e, 0xa2, 0x96, 0x83, 0xee, 0xfc, 0x57, 0x62,
+	0xdc, 0xe5, 0xd6, 0xfb, 0x6c, 0xde, 0xbd, 0xb1, 0xfd, 0xa1, 0x33, 0xf3, 0x1e, 0xd7, 0x3f, 0x1f,
+	0x3a, 0xd6, 0x6f, 0x3b, 0x1d, 0xeb, 0x35, 0xae, 0x77, 0xb8, 0xb6, 0x71, 0xfd, 0x89, 0xeb, 0xef,
+	0x1d, 0x3c, 0xc3, 0xfd, 0xc5, 0xc7, 0xce, 0xcc, 0x36, 0xae, 0xf7, 0xb8, 0xd6, 0xea, 0x23, 0xec,
+	0xfe, 0x41, 0xfd, 0xfb, 0x5e, 0xfa, 0x17, 0xa5, 0xff, 0x68, 0xd5, 0x5f, 0x08, 0x00, 0x00,
 }
 
 func (this *FuncToExecute) Equal(that interface{}) bool {
@@ -934,6 +980,35 @@ func (this *QueryRequest) Equal(that interface{}) bool {
 	}
 	return true
 }
+func (this *BatchQueryRequest) Equal(that interface{}) bool {
+	if that == nil {
+		return this == nil
+	}
+
+	that1, ok := that.(*BatchQueryRequest)
+	if !ok {
+		that2, ok := that.(BatchQueryRequest)
+		if ok {
+			that1 = &that2
+		} else {
+			return false
+		}
+	}
+	if that1 == nil {
+		return this == nil
+	} else if this == nil {
+		return false
+	}
+	if len(this.Requests) != len(that1.Requests) {
+		return false
+	}
+	for i := range this.Requests {
+		if !this.Requests[i].Equal(that1.Requests[i]) {
+			return false
+		}
+	}
+	return true
+}
 func (this *CompileMutationsRequest) Equal(that interface{}) bool {
 	if that == nil {
 		return this == nil
@@ -1248,6 +1323,18 @@ func (this *QueryRequest) GoString() string {
 	s = append(s, "}")
 	return strings.Join(s, "")
 }
+func (this *BatchQueryRequest) GoString() string {
+	if this == nil {
+		return "nil"
+	}
+	s := make([]string, 0, 5)
+	s = append(s, "&plannerpb.BatchQueryRequest{")
+	if this.Requests != nil {
+		s = append(s, "Requests: "+fmt.Sprintf("%#v", this.Requests)+",\n")
+	}
+	s = append(s, "}")
+	return strings.Join(s, "")
+}
 func (this *CompileMutationsRequest) GoString() string {
 	if this == nil {
 		return "nil"
@@ -1628,6 +1715,43 @@ func (m *QueryRequest) MarshalToSizedBuffer(dAtA []byte) (int, error) {
 	return len(dAtA) - i, nil
 }
 
+func (m *BatchQueryRequest) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalToSizedBuffer(dAtA[:size])
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *BatchQueryRequest) MarshalTo(dAtA []byte) (int, error) {
+	size := m.Size()
+	return m.MarshalToSizedBuffer(dAtA[:size])
+}
+
+func (m *BatchQueryRequest) MarshalToSizedBuffer(dAtA []byte) (int, error) {
+	i := len(dAtA)
+	_ = i
+	var l int
+	_ = l
+	if len(m.Requests) > 0 {
+		for iNdEx := len(m.Requests) - 1; iNdEx >= 0; iNdEx-- {
+			{
+				size, err := m.Requests[iNdEx].MarshalToSizedBuffer(dAtA[:i])
+				if err != nil {
+					return 0, err
+				}
+				i -= size
+				i = encodeVarintFuncArgs(dAtA, i, uint64(size))
+			}
+			i--
+			dAtA[i] = 0xa
+		}
+	}
+	return len(dAtA) - i, nil
+}
+
 func (m *CompileMutationsRequest) Marshal() (dAtA []byte, err error) {
 	size := m.Size()
 	dAtA = make([]byte, size)
@@ -2032,6 +2156,21 @@ func (m *QueryRequest) Size() (n int) {
 	return n
 }
 
+func (m *BatchQueryRequest) Size() (n int) {
+	if m == nil {
+		return 0
+	}
+	var l int
+	_ = l
+	if len(m.Requests) > 0 {
+		for _, e := range m.Requests {
+			l = e.Size()
+			n += 1 + l + sovFuncArgs(uint64(l))
+		}
+	}
+	return n
+}
+
 func (m *CompileMutationsRequest) Size() (n int) {
 	if m == nil {
 		return 0
@@ -2251,6 +2390,21 @@ func (this *QueryRequest) String() string {
 	}, "")
 	return s
 }
+func (this *BatchQueryRequest) String() string {
+	if this == nil {
+		return "nil"
+	}
+	repeatedStringForRequests := "[]*QueryRequest{"
+	for _, f := range this.Requests {
+		repeatedStringForRequests += strings.Replace(f.String(), "QueryRequest", "QueryRequest", 1) + ","
+	}
+	repeatedStringForRequests += "}"
+	s := strings.Join([]string{`&BatchQueryRequest{`,
+		`Requests:` + repeatedStringForRequests + `,`,
+		`}`,
+	}, "")
+	return s
+}
 func (this *CompileMutationsRequest) String() string {
 	if this == nil {
 		return "nil"
@@ -3207,6 +3361,90 @@ func (m *QueryRequest) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
+func (m *BatchQueryRequest) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowFuncArgs
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= uint64(b&0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: BatchQueryRequest: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: BatchQueryRequest: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Requests", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowFuncArgs
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= int(b&0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthFuncArgs
+			}
+			postIndex := iNdEx + msglen
+			if postIndex < 0 {
+				return ErrInvalidLengthFuncArgs
+			}
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Requests = append(m.Requests, &QueryRequest{})
+			if err := m.Requests[len(m.Requests)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		default:
+			iNdEx = preIndex
+			skippy, err := skipFuncArgs(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if (skippy < 0) || (iNdEx+skippy) < 0 {
+				return ErrInvalidLengthFuncArgs
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
 func (m *CompileMutationsRequest) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
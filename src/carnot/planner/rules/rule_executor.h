@@ -17,15 +17,20 @@
  */
 
 #pragma once
+#include <map>
 #include <memory>
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_set.h>
+
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/carnot/planner/ir/ir.h"
 #include "src/carnot/planner/rules/rules.h"
+#include "src/common/perf/elapsed_timer.h"
 
 namespace px {
 namespace carnot {
@@ -123,17 +128,40 @@ class RuleExecutor {
 
  public:
   virtual ~RuleExecutor() = default;
-  // TODO(philkuz) figure out how to collect stats on the execution.
   Status Execute(TPlan* ir_graph) {
+    rule_execution_time_us_.clear();
     for (const auto& rb : rule_batches) {
       bool can_continue = true;
       int64_t iteration = 0;
+      // Nodes changed by the previous iteration (plus their neighbors). Subsequent iterations
+      // revisit only these: a rule match can only be enabled by a change to the node itself or
+      // one of its inputs/outputs, so full-graph re-walks per iteration are wasted work on
+      // large scripts. The first iteration, and a final sweep confirming the fixed point, walk
+      // the full graph.
+      absl::flat_hash_set<int64_t> dirty;
+      bool full_walk = true;
       // We continue executing a batch until a stop condition is met.
       while (can_continue) {
         iteration += 1;
         bool graph_is_updated = false;
+        absl::flat_hash_set<int64_t> next_dirty;
+        bool next_full_walk = false;
         for (const auto& rule : rb->rules()) {
-          PL_ASSIGN_OR_RETURN(bool rule_updates_graph, rule->Execute(ir_graph));
+          ElapsedTimer timer;
+          timer.Start();
+          PL_ASSIGN_OR_RETURN(bool rule_updates_graph,
+                              rule->ExecuteRestricted(ir_graph, full_walk ? nullptr : &dirty));
+          rule_execution_time_us_[typeid(*rule).name()] += timer.ElapsedTime_us();
+          if (rule_updates_graph) {
+            if (rule->changed_nodes().empty()) {
+              // The rule changed the graph without reporting node-level changes (whole-graph
+              // rules that override Execute). Anything may have changed: re-walk in full.
+              next_full_walk = true;
+            }
+            for (int64_t node : rule->changed_nodes()) {
+              MarkDirty(ir_graph, node, &next_dirty);
+            }
+          }
           graph_is_updated = graph_is_updated || rule_updates_graph;
         }
         if (iteration >= rb->max_iterations() && graph_is_updated) {
@@ -141,17 +169,36 @@ class RuleExecutor {
           // TODO(philkuz) Reviewer: should this be a failure somehow?
           can_continue = false;
         }
-        // TODO(philkuz) in the future we might have a fast way to check whether the graph has
-        // changed. For now let's be lazy and leave it up to the user to make sure rules properly
-        // update.
         // (graph_is_updated == false) => the graph has reached a fixed point and is done
         if (!graph_is_updated) {
-          can_continue = false;
+          if (full_walk) {
+            can_continue = false;
+          } else {
+            // A dirty-restricted iteration can miss matches enabled at a distance. Confirm
+            // the fixed point with one full sweep before finishing the batch.
+            full_walk = true;
+          }
+        } else {
+          dirty = std::move(next_dirty);
+          full_walk = next_full_walk;
         }
       }
     }
+    if (VLOG_IS_ON(1)) {
+      for (const auto& [rule_name, time_us] : rule_execution_time_us_) {
+        VLOG(1) << absl::Substitute("Rule $0 took $1 us", rule_name, time_us);
+      }
+    }
     return Status::OK();
   }
+
+  /**
+   * @brief Wall time spent in each rule, summed across all batches and iterations of the last
+   * Execute call and keyed by the rule's (mangled) type name. Used to find pathological rules.
+   */
+  const std::map<std::string, uint64_t>& rule_execution_time_us() const {
+    return rule_execution_time_us_;
+  }
   template <typename S, typename... Args>
   TRuleBatch* CreateRuleBatch(std::string name, Args... args) {
     std::unique_ptr<TRuleBatch> rb(new TRuleBatch(name, std::make_unique<S>(name, args...)));
@@ -161,7 +208,24 @@ class RuleExecutor {
   }
 
  private:
+  // Marks a changed node and its immediate neighbors for revisiting. The node may already have
+  // been deleted by the rule that changed it; its id is still inserted so newly-created nodes
+  // reusing the walk order are not missed, but neighbors can only be expanded while it exists.
+  void MarkDirty(TPlan* ir_graph, int64_t node, absl::flat_hash_set<int64_t>* dirty) {
+    dirty->insert(node);
+    if (!ir_graph->HasNode(node)) {
+      return;
+    }
+    for (int64_t parent : ir_graph->dag().ParentsOf(node)) {
+      dirty->insert(parent);
+    }
+    for (int64_t child : ir_graph->dag().DependenciesOf(node)) {
+      dirty->insert(child);
+    }
+  }
+
   std::vector<std::unique_ptr<TRuleBatch>> rule_batches;
+  std::map<std::string, uint64_t> rule_execution_time_us_;
 };
 
 }  // namespace planner
@@ -168,6 +168,65 @@ TEST_F(RuleExecutorTest, rules_in_batch_correspond) {
   EXPECT_OK(executor->Execute(graph.get()));
 }
 
+// A rule that changes one specific node (once) and records every node it visits, to observe
+// which nodes the executor re-walks on later iterations.
+class NodeVisitRecordingRule : public Rule {
+ public:
+  NodeVisitRecordingRule(CompilerState* compiler_state, int64_t node_to_change)
+      : Rule(compiler_state, /*use_topo*/ false, /*reverse_topological_execution*/ false),
+        node_to_change_(node_to_change) {}
+
+  const std::vector<int64_t>& visits() const { return visits_; }
+
+ protected:
+  StatusOr<bool> Apply(IRNode* node) override {
+    visits_.push_back(node->id());
+    if (node->id() == node_to_change_ && !changed_) {
+      changed_ = true;
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  int64_t node_to_change_;
+  bool changed_ = false;
+  std::vector<int64_t> visits_;
+};
+
+// Tests that after a rule changes a node, the next iteration revisits only that node and its
+// neighbors, and that the fixed point is still confirmed with a full sweep.
+TEST_F(RuleExecutorTest, dirty_node_tracking) {
+  std::unique_ptr<TestExecutor> executor = std::move(TestExecutor::Create().ValueOrDie());
+  RuleBatch* rule_batch = executor->CreateRuleBatch<FailOnMax>("resolve", 10);
+  NodeVisitRecordingRule* rule =
+      rule_batch->AddRule<NodeVisitRecordingRule>(compiler_state_.get(), func->id());
+  ASSERT_OK(executor->Execute(graph.get()));
+
+  const auto& visits = rule->visits();
+  size_t num_nodes = graph->dag().nodes().size();
+  // Three iterations ran: a full walk, a dirty-restricted walk, and a full sweep that
+  // confirms the fixed point. The middle one must be strictly smaller than a full walk.
+  ASSERT_GT(visits.size(), 2 * num_nodes);
+  size_t num_restricted = visits.size() - 2 * num_nodes;
+  EXPECT_LT(num_restricted, num_nodes);
+
+  // The restricted iteration visited only the changed node and its immediate neighbors.
+  absl::flat_hash_set<int64_t> expected = {func->id()};
+  for (int64_t parent : graph->dag().ParentsOf(func->id())) {
+    expected.insert(parent);
+  }
+  for (int64_t child : graph->dag().DependenciesOf(func->id())) {
+    expected.insert(child);
+  }
+  for (size_t i = num_nodes; i < num_nodes + num_restricted; ++i) {
+    EXPECT_TRUE(expected.contains(visits[i]));
+  }
+
+  // Per-rule timing is collected for the one registered rule.
+  EXPECT_EQ(1, executor->rule_execution_time_us().size());
+}
+
 // Test to see that if the strategy exits, then following batches don't run.
 TEST_F(RuleExecutorTest, exit_early) {
   std::unique_ptr<TestExecutor> executor = std::move(TestExecutor::Create().ValueOrDie());
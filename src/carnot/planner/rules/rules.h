@@ -23,6 +23,7 @@
 #include <vector>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/carnot/planner/compiler_state/registry_info.h"
@@ -65,6 +66,25 @@ class BaseRule {
     return any_changed;
   }
 
+  /**
+   * @brief Executes the rule, restricting the walk to the nodes in dirty_nodes. Pass nullptr
+   * to walk the full graph. The ids of nodes this execution changed are recorded in
+   * changed_nodes(), so an executor can build the next iteration's dirty set instead of
+   * re-walking the whole graph. Rules that override Execute for whole-graph analysis ignore
+   * the restriction and run in full; they leave changed_nodes() empty, which callers must
+   * treat as "anything may have changed".
+   */
+  StatusOr<bool> ExecuteRestricted(TPlan* graph,
+                                   const absl::flat_hash_set<int64_t>* dirty_nodes) {
+    dirty_nodes_ = dirty_nodes;
+    changed_nodes_.clear();
+    auto changed_or_s = Execute(graph);
+    dirty_nodes_ = nullptr;
+    return changed_or_s;
+  }
+
+  const absl::flat_hash_set<int64_t>& changed_nodes() const { return changed_nodes_; }
+
  protected:
   StatusOr<bool> ExecuteTopologicalSorted(TPlan* graph) {
     bool any_changed = false;
@@ -73,11 +93,17 @@ class BaseRule {
       std::reverse(topo_graph.begin(), topo_graph.end());
     }
     for (int64_t node_i : topo_graph) {
+      if (dirty_nodes_ != nullptr && !dirty_nodes_->contains(node_i)) {
+        continue;
+      }
       // The node may have been deleted by a prior call to Apply on a parent or child node.
       if (!graph->HasNode(node_i)) {
         continue;
       }
       PL_ASSIGN_OR_RETURN(bool node_is_changed, Apply(graph->Get(node_i)));
+      if (node_is_changed) {
+        changed_nodes_.insert(node_i);
+      }
       any_changed = any_changed || node_is_changed;
     }
     return any_changed;
@@ -89,11 +115,17 @@ class BaseRule {
     // causing nodes to be skipped.
     auto nodes = graph->dag().nodes();
     for (int64_t node_i : nodes) {
+      if (dirty_nodes_ != nullptr && !dirty_nodes_->contains(node_i)) {
+        continue;
+      }
       // The node may have been deleted by a prior call to Apply on a parent or child node.
       if (!graph->HasNode(node_i)) {
         continue;
       }
       PL_ASSIGN_OR_RETURN(bool node_is_changed, Apply(graph->Get(node_i)));
+      if (node_is_changed) {
+        changed_nodes_.insert(node_i);
+      }
       any_changed = any_changed || node_is_changed;
     }
     return any_changed;
@@ -125,6 +157,12 @@ class BaseRule {
   CompilerState* compiler_state_;
   bool use_topo_;
   bool reverse_topological_execution_;
+
+  // Set by ExecuteRestricted for the duration of one execution: when non-null, the default
+  // walks only visit the listed nodes.
+  const absl::flat_hash_set<int64_t>* dirty_nodes_ = nullptr;
+  // Nodes changed by the most recent execution.
+  absl::flat_hash_set<int64_t> changed_nodes_;
 };
 
 using Rule = BaseRule<IR>;
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "src/carnot/exec/ml/model_pool.h"
+#include "src/carnot/udf/string_arena.h"
 #include "src/shared/metadata/metadata_state.h"
 #include "src/shared/types/types.h"
 
@@ -41,9 +42,17 @@ class FunctionContext {
   const px::md::AgentMetadataState* metadata_state() const { return metadata_state_.get(); }
   exec::ml::ModelPool* model_pool() { return model_pool_; }
 
+  /**
+   * Per-batch scratch arena for string UDFs. Allocations live until the evaluator resets the
+   * arena at the start of the next batch, after results have been copied into the output
+   * ColumnWrapper.
+   */
+  StringArena* string_arena() { return &string_arena_; }
+
  private:
   std::shared_ptr<const px::md::AgentMetadataState> metadata_state_;
   exec::ml::ModelPool* model_pool_;
+  StringArena string_arena_;
 };
 
 /**
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/udf/string_arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace px {
+namespace carnot {
+namespace udf {
+
+char* StringArena::Allocate(size_t size) {
+  if (slabs_.empty() || slabs_.back().offset + size > slabs_.back().capacity) {
+    size_t capacity = std::max(size, kDefaultSlabSize);
+    slabs_.push_back(Slab{std::make_unique<char[]>(capacity), capacity, 0});
+  }
+  auto& slab = slabs_.back();
+  char* out = slab.data.get() + slab.offset;
+  slab.offset += size;
+  bytes_allocated_ += size;
+  return out;
+}
+
+std::string_view StringArena::Intern(std::string_view s) {
+  char* dst = Allocate(s.size());
+  std::memcpy(dst, s.data(), s.size());
+  return std::string_view(dst, s.size());
+}
+
+void StringArena::Reset() {
+  if (slabs_.size() > 1) {
+    // Keep only the largest slab so a batch that spilled into several slabs coalesces into one
+    // big enough to hold the next batch without allocating.
+    auto largest = std::max_element(
+        slabs_.begin(), slabs_.end(),
+        [](const Slab& a, const Slab& b) { return a.capacity < b.capacity; });
+    Slab keep = std::move(*largest);
+    slabs_.clear();
+    slabs_.push_back(std::move(keep));
+  }
+  if (!slabs_.empty()) {
+    slabs_.back().offset = 0;
+  }
+  bytes_allocated_ = 0;
+}
+
+}  // namespace udf
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace udf {
+
+/**
+ * StringArena is a per-batch bump allocator for string scratch space in UDFs. String-producing
+ * UDFs otherwise make several small heap allocations per row for intermediate buffers; memory
+ * allocated here lives until the end of the batch, when the expression evaluator resets the
+ * arena in one step after the output ColumnWrapper has copied the results out.
+ *
+ * The arena hands out raw chunks of a slab; nothing is individually freed, and destructors are
+ * never run, so only trivially-destructible data (char buffers) belongs here. Reset() keeps the
+ * largest slab, so a UDF's steady-state batches allocate no new memory at all.
+ *
+ * Not thread-safe: each FunctionContext (and thus each exec node) owns its own arena.
+ */
+class StringArena {
+ public:
+  static constexpr size_t kDefaultSlabSize = 16 * 1024;
+
+  /**
+   * Allocate returns a pointer to `size` bytes valid until the next Reset().
+   */
+  char* Allocate(size_t size);
+
+  /**
+   * Intern copies `s` into the arena and returns a view of the copy, valid until the next
+   * Reset().
+   */
+  std::string_view Intern(std::string_view s);
+
+  /**
+   * Reset invalidates all outstanding allocations. The largest slab is retained for reuse.
+   */
+  void Reset();
+
+  size_t bytes_allocated() const { return bytes_allocated_; }
+
+ private:
+  struct Slab {
+    std::unique_ptr<char[]> data;
+    size_t capacity;
+    size_t offset;
+  };
+
+  std::vector<Slab> slabs_;
+  size_t bytes_allocated_ = 0;
+};
+
+}  // namespace udf
+}  // namespace carnot
+}  // namespace px
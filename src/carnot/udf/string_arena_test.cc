@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include "src/carnot/udf/string_arena.h"
+
+namespace px {
+namespace carnot {
+namespace udf {
+
+TEST(StringArena, allocate_and_intern) {
+  StringArena arena;
+  EXPECT_EQ(0, arena.bytes_allocated());
+
+  char* buf = arena.Allocate(5);
+  std::memcpy(buf, "hello", 5);
+  auto view = arena.Intern("world");
+  EXPECT_EQ("world", view);
+  EXPECT_EQ("hello", std::string_view(buf, 5));
+  EXPECT_EQ(10, arena.bytes_allocated());
+}
+
+TEST(StringArena, allocations_are_distinct) {
+  StringArena arena;
+  auto a = arena.Intern("aaaa");
+  auto b = arena.Intern("bbbb");
+  EXPECT_NE(a.data(), b.data());
+  EXPECT_EQ("aaaa", a);
+  EXPECT_EQ("bbbb", b);
+}
+
+TEST(StringArena, reset_reuses_memory) {
+  StringArena arena;
+  char* first = arena.Allocate(16);
+  arena.Reset();
+  EXPECT_EQ(0, arena.bytes_allocated());
+  // After a reset the retained slab is bumped from the start again.
+  char* second = arena.Allocate(16);
+  EXPECT_EQ(first, second);
+}
+
+TEST(StringArena, oversize_allocation) {
+  StringArena arena;
+  // Larger than a slab: gets a dedicated slab instead of failing.
+  size_t size = StringArena::kDefaultSlabSize * 3;
+  char* buf = arena.Allocate(size);
+  std::memset(buf, 'x', size);
+  EXPECT_EQ(size, arena.bytes_allocated());
+
+  // Reset keeps the largest slab, so the next oversize batch fits without a new allocation.
+  arena.Reset();
+  char* again = arena.Allocate(size);
+  EXPECT_EQ(buf, again);
+}
+
+TEST(StringArena, spills_across_slabs) {
+  StringArena arena;
+  size_t total = 0;
+  for (int i = 0; i < 100; ++i) {
+    auto view = arena.Intern(std::string(1024, 'a' + (i % 26)));
+    EXPECT_EQ(1024, view.size());
+    total += view.size();
+  }
+  EXPECT_EQ(total, arena.bytes_allocated());
+}
+
+}  // namespace udf
+}  // namespace carnot
+}  // namespace px
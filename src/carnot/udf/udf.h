@@ -156,6 +156,34 @@ constexpr bool IsValidExecutorFn(udfspb::UDFSourceExecutor (*)()) {
   return true;
 }
 
+/**
+ * Checks to see if a valid looking ExecBatchArrow function exists.
+ */
+template <typename ReturnType, typename TUDF, typename... Types>
+static constexpr bool IsValidExecBatchArrowFn(ReturnType (TUDF::*)(Types...)) {
+  return false;
+}
+
+template <typename TUDF>
+static constexpr bool IsValidExecBatchArrowFn(Status (TUDF::*)(FunctionContext*,
+                                                               const std::vector<arrow::Array*>&,
+                                                               arrow::ArrayBuilder*, int)) {
+  return true;
+}
+
+// SFINAE test for ExecBatchArrow fn.
+template <typename T, typename = void>
+struct has_udf_exec_batch_arrow_fn : std::false_type {};
+
+template <typename T>
+struct has_udf_exec_batch_arrow_fn<T, std::void_t<decltype(&T::ExecBatchArrow)>>
+    : std::true_type {
+  static_assert(IsValidExecBatchArrowFn(&T::ExecBatchArrow),
+                "If an ExecBatchArrow function exists, it must have the form: Status "
+                "ExecBatchArrow(FunctionContext*, const std::vector<arrow::Array*>&, "
+                "arrow::ArrayBuilder*, int)");
+};
+
 // SFINAE test for Executor fn.
 template <typename T, typename = void>
 struct has_udf_executor_fn : std::false_type {};
@@ -228,6 +256,13 @@ class ScalarUDFTraits {
    */
   static constexpr bool HasExecutor() { return has_udf_executor_fn<T>::value; }
 
+  /**
+   * Checks if the UDF provides its own vectorized Arrow batch implementation.
+   * If it does, the batch wrapper dispatches to it instead of calling Exec per row.
+   * @return true if it has an ExecBatchArrow function.
+   */
+  static constexpr bool HasExecBatchArrow() { return has_udf_exec_batch_arrow_fn<T>::value; }
+
   template <typename Q = T, std::enable_if_t<ScalarUDFTraits<Q>::HasInit(), void>* = nullptr>
   static constexpr auto InitArguments() {
     return GetArgumentTypesHelper(&Q::Init);
@@ -321,6 +356,33 @@ static constexpr bool IsValidDeserializeFn(Status (TUDA::*)(FunctionContext*,
   return true;
 }
 
+/**
+ * Checks to see if a valid looking UpdateBatchArrow function exists.
+ */
+template <typename ReturnType, typename TUDA, typename... Types>
+static constexpr bool IsValidUpdateBatchArrowFn(ReturnType (TUDA::*)(Types...)) {
+  return false;
+}
+
+template <typename TUDA>
+static constexpr bool IsValidUpdateBatchArrowFn(Status (TUDA::*)(
+    FunctionContext*, const std::vector<const arrow::Array*>&, size_t)) {
+  return true;
+}
+
+// SFINAE test for UpdateBatchArrow fn.
+template <typename T, typename = void>
+struct has_uda_update_batch_arrow_fn : std::false_type {};
+
+template <typename T>
+struct has_uda_update_batch_arrow_fn<T, std::void_t<decltype(&T::UpdateBatchArrow)>>
+    : std::true_type {
+  static_assert(IsValidUpdateBatchArrowFn(&T::UpdateBatchArrow),
+                "If an UpdateBatchArrow function exists, it must have the form: Status "
+                "UpdateBatchArrow(FunctionContext*, const std::vector<const arrow::Array*>&, "
+                "size_t)");
+};
+
 // SFINAE test for serialize fn.
 template <typename T, typename = void>
 struct has_uda_serialize_fn : std::false_type {};
@@ -368,6 +430,12 @@ class UDATraits {
     return has_uda_serialize_fn<T>() && has_uda_deserialize_fn<T>();
   }
 
+  /**
+   * Checks if the UDA provides its own vectorized arrow batch update.
+   * @return true if it has an UpdateBatchArrow function.
+   */
+  static constexpr bool HasUpdateBatchArrow() { return has_uda_update_batch_arrow_fn<T>::value; }
+
   template <typename Q = T, std::enable_if_t<UDATraits<Q>::HasInit(), void>* = nullptr>
   static constexpr auto InitArguments() {
     return GetArgumentTypesHelper(&Q::Init);
@@ -112,6 +112,8 @@ class ScalarUDFDefinition : public UDFDefinition {
       executor_ = udfspb::UDFSourceExecutor::UDF_ALL;
     }
 
+    has_exec_batch_arrow_ = ScalarUDFTraits<TUDF>::HasExecBatchArrow();
+
     return Status::OK();
   }
 
@@ -145,6 +147,13 @@ class ScalarUDFDefinition : public UDFDefinition {
   const std::vector<types::DataType>& init_arguments() const { return init_arguments_; }
   udfspb::UDFSourceExecutor executor() const { return executor_; }
 
+  /**
+   * Whether the UDF provides its own vectorized Arrow batch implementation.
+   * Evaluators can use this to prefer the Arrow path over per-row execution.
+   * @return true if the UDF has an ExecBatchArrow function.
+   */
+  bool has_exec_batch_arrow() const { return has_exec_batch_arrow_; }
+
   const std::vector<types::DataType>& RegistryArgTypes() override { return registry_arguments_; }
   size_t Arity() const { return exec_arguments_.size(); }
   const auto& exec_wrapper() const { return exec_wrapper_fn_; }
@@ -155,6 +164,7 @@ class ScalarUDFDefinition : public UDFDefinition {
   std::vector<types::DataType> registry_arguments_;
   types::DataType exec_return_type_;
   udfspb::UDFSourceExecutor executor_;
+  bool has_exec_batch_arrow_ = false;
   std::function<std::unique_ptr<ScalarUDF>()> make_fn_;
   std::function<Status(ScalarUDF*, FunctionContext* ctx,
                        const std::vector<const types::ColumnWrapper*>& inputs,
@@ -209,6 +219,8 @@ class UDADefinition : public UDFDefinition {
     finalize_value_fn = UDAWrapper<T>::FinalizeValue;
 
     supports_partial_ = UDAWrapper<T>::SupportsPartial;
+    serialize_fn_ = UDAWrapper<T>::Serialize;
+    deserialize_fn_ = UDAWrapper<T>::Deserialize;
     return Status::OK();
   }
 
@@ -246,6 +258,15 @@ class UDADefinition : public UDFDefinition {
     return finalize_arrow_fn_(uda, ctx, output);
   }
 
+  // Serialize/Deserialize move partial aggregate state between agents. They error out for
+  // UDAs that don't support partial aggregation.
+  StatusOr<types::StringValue> Serialize(UDA* uda, FunctionContext* ctx) {
+    return serialize_fn_(uda, ctx);
+  }
+  Status Deserialize(UDA* uda, FunctionContext* ctx, const types::StringValue& data) {
+    return deserialize_fn_(uda, ctx, data);
+  }
+
  private:
   std::vector<types::DataType> init_arguments_;
   std::vector<types::DataType> update_arguments_;
@@ -267,6 +288,9 @@ class UDADefinition : public UDFDefinition {
   std::function<Status(UDA* uda, FunctionContext* ctx, types::BaseValueType* output)>
       finalize_value_fn;
   std::function<Status(UDA* uda1, UDA* uda2, FunctionContext* ctx)> merge_fn_;
+  std::function<StatusOr<types::StringValue>(UDA* uda, FunctionContext* ctx)> serialize_fn_;
+  std::function<Status(UDA* uda, FunctionContext* ctx, const types::StringValue& data)>
+      deserialize_fn_;
   std::function<Status(UDA* uda, FunctionContext* ctx,
                        const std::vector<std::shared_ptr<types::BaseValueType>>& inputs)>
       init_wrapper_fn_;
@@ -308,6 +332,8 @@ class UDTFDefinition : public UDFDefinition {
 
     exec_init_ = UDTFWrapper<T>::Init;
     exec_batch_update_ = UDTFWrapper<T>::ExecBatchUpdate;
+    exec_set_partition_ = UDTFWrapper<T>::SetPartition;
+    supports_partitioning_ = UDTFTraits<T>::HasSetPartitionFn();
 
     auto init_args = UDTFTraits<T>::InitArguments();
     init_arguments_ = {init_args.begin(), init_args.end()};
@@ -339,6 +365,17 @@ class UDTFDefinition : public UDFDefinition {
     return exec_batch_update_(udtf, ctx, max_gen_records, outputs);
   }
 
+  /**
+   * Whether this UDTF implements SetPartition() and can thus be run as multiple parallel
+   * instances that each produce a disjoint shard of the output.
+   */
+  bool supports_partitioning() const { return supports_partitioning_; }
+
+  void ExecSetPartition(AnyUDTF* udtf, size_t partition_idx, size_t total_partitions) {
+    DCHECK(supports_partitioning_);
+    exec_set_partition_(udtf, partition_idx, total_partitions);
+  }
+
   const std::vector<UDTFArg>& init_arguments() const { return init_arguments_; }
   const std::vector<ColInfo>& output_relation() const { return output_relation_; }
   udfspb::UDTFSourceExecutor executor() const { return executor_; }
@@ -350,6 +387,9 @@ class UDTFDefinition : public UDFDefinition {
   std::function<bool(AnyUDTF* udtf, FunctionContext* ctx, int max_gen_records,
                      std::vector<arrow::ArrayBuilder*>* outputs)>
       exec_batch_update_;
+  std::function<void(AnyUDTF* udtf, size_t partition_idx, size_t total_partitions)>
+      exec_set_partition_;
+  bool supports_partitioning_ = false;
   std::vector<UDTFArg> init_arguments_;
   std::vector<ColInfo> output_relation_;
   udfspb::UDTFSourceExecutor executor_;
@@ -51,6 +51,40 @@ class AddUDF : public ScalarUDF {
   }
 };
 
+// Declares its read-only string argument as std::string_view, so the wrappers pass a borrowed
+// view instead of materializing a StringValue per row.
+class ViewLenUDF : public ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, std::string_view s) {
+    arg_data_ptrs.push_back(s.data());
+    return static_cast<int64_t>(s.length());
+  }
+
+  std::vector<const char*> arg_data_ptrs;
+};
+
+class VecAddUDF : public ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
+    return v1.val + v2.val;
+  }
+  // Vectorized batch implementation, dispatched to instead of the per-row Exec loop.
+  Status ExecBatchArrow(FunctionContext*, const std::vector<arrow::Array*>& inputs,
+                        arrow::ArrayBuilder* output, int count) {
+    batch_calls++;
+    auto* in1 = static_cast<arrow::Int64Array*>(inputs[0]);
+    auto* in2 = static_cast<arrow::Int64Array*>(inputs[1]);
+    auto* out = static_cast<arrow::Int64Builder*>(output);
+    PL_RETURN_IF_ERROR(out->Reserve(count));
+    for (int i = 0; i < count; ++i) {
+      out->UnsafeAppend(in1->Value(i) + in2->Value(i));
+    }
+    return Status::OK();
+  }
+
+  int batch_calls = 0;
+};
+
 class InitArgUDF : public ScalarUDF {
  public:
   Status Init(FunctionContext*, types::StringValue str, types::Int64Value i) {
@@ -115,6 +149,49 @@ TEST(UDFDefinition, str_args) {
   EXPECT_EQ("el", out[2]);
 }
 
+TEST(UDFDefinition, string_view_args) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  ScalarUDFDefinition def("viewlen");
+  EXPECT_OK(def.Init<ViewLenUDF>());
+  // The declared argument still registers as a STRING arg.
+  EXPECT_THAT(def.exec_arguments(), ElementsAre(types::STRING));
+
+  types::StringValueColumnWrapper v1({"a", "bc", "hello"});
+  types::Int64ValueColumnWrapper out(v1.Size());
+  auto u = def.Make();
+  EXPECT_TRUE(def.ExecBatch(u.get(), &ctx, {&v1}, &out, v1.Size()).ok());
+  EXPECT_EQ(1, out[0].val);
+  EXPECT_EQ(2, out[1].val);
+  EXPECT_EQ(5, out[2].val);
+}
+
+TEST(UDFDefinition, string_view_args_arrow_zero_copy) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  std::vector<types::StringValue> v1 = {"a", "bc", "hello"};
+  auto v1a = ToArrow(v1, arrow::default_memory_pool());
+
+  auto output_builder = std::make_shared<arrow::Int64Builder>();
+  auto u = std::make_shared<ViewLenUDF>();
+  EXPECT_TRUE(
+      ScalarUDFWrapper<ViewLenUDF>::ExecBatchArrow(u.get(), &ctx, {v1a.get()}, output_builder.get(),
+                                                   3)
+          .ok());
+
+  std::shared_ptr<arrow::Array> res;
+  EXPECT_TRUE(output_builder->Finish(&res).ok());
+  auto* res_arr = static_cast<arrow::Int64Array*>(res.get());
+  EXPECT_EQ(1, res_arr->Value(0));
+  EXPECT_EQ(2, res_arr->Value(1));
+  EXPECT_EQ(5, res_arr->Value(2));
+
+  // The views handed to Exec must borrow the arrow data buffer directly (zero-copy).
+  auto* str_arr = static_cast<arrow::StringArray*>(v1a.get());
+  ASSERT_EQ(3U, u->arg_data_ptrs.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(str_arr->GetView(i).data(), u->arg_data_ptrs[i]);
+  }
+}
+
 TEST(UDFDefinition, arrow_write) {
   auto ctx = FunctionContext(nullptr, nullptr);
   std::vector<types::Int64Value> v1 = {1, 2, 3};
@@ -136,6 +213,36 @@ TEST(UDFDefinition, arrow_write) {
   EXPECT_EQ(6, resArr->Value(1));
 }
 
+TEST(UDFDefinition, arrow_batch_override) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  ScalarUDFDefinition def("vecadd");
+  EXPECT_OK(def.Init<VecAddUDF>());
+  EXPECT_TRUE(def.has_exec_batch_arrow());
+
+  ScalarUDFDefinition scalar_def("add");
+  EXPECT_OK(scalar_def.Init<AddUDF>());
+  EXPECT_FALSE(scalar_def.has_exec_batch_arrow());
+
+  std::vector<types::Int64Value> v1 = {1, 2, 3};
+  std::vector<types::Int64Value> v2 = {3, 4, 5};
+  auto v1a = ToArrow(v1, arrow::default_memory_pool());
+  auto v2a = ToArrow(v2, arrow::default_memory_pool());
+
+  auto output_builder = std::make_shared<arrow::Int64Builder>();
+  auto u = std::make_shared<VecAddUDF>();
+  EXPECT_TRUE(
+      def.ExecBatchArrow(u.get(), &ctx, {v1a.get(), v2a.get()}, output_builder.get(), 3).ok());
+  // The wrapper must have dispatched to the UDF's own batch implementation.
+  EXPECT_EQ(1, u->batch_calls);
+
+  std::shared_ptr<arrow::Array> res;
+  EXPECT_TRUE(output_builder->Finish(&res).ok());
+  auto* resArr = static_cast<arrow::Int64Array*>(res.get());
+  EXPECT_EQ(4, resArr->Value(0));
+  EXPECT_EQ(6, resArr->Value(1));
+  EXPECT_EQ(8, resArr->Value(2));
+}
+
 TEST(UDFDefinition, init_args) {
   auto ctx = FunctionContext(nullptr, nullptr);
   ScalarUDFDefinition def("initargudf");
@@ -233,6 +340,62 @@ TEST(UDADefinition, with_merge) {
   EXPECT_EQ(11, out.val);
 }
 
+// Like MinSumUDA, but supports partial aggregation by serializing its running sum.
+class SerializableMinSumUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value arg1, types::Int64Value arg2) {
+    sum_ = sum_.val + std::min(arg1.val, arg2.val);
+  }
+  void Merge(udf::FunctionContext*, const SerializableMinSumUDA& other) {
+    sum_ = sum_.val + other.sum_.val;
+  }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+  types::StringValue Serialize(udf::FunctionContext*) {
+    types::StringValue out;
+    out.assign(reinterpret_cast<const char*>(&sum_.val), sizeof(sum_.val));
+    return out;
+  }
+  Status Deserialize(udf::FunctionContext*, const types::StringValue& data) {
+    sum_ = *reinterpret_cast<const int64_t*>(data.data());
+    return Status::OK();
+  }
+
+ protected:
+  types::Int64Value sum_ = 0;
+};
+
+TEST(UDADefinition, serialize_round_trip) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  UDADefinition def("minsum");
+  EXPECT_OK(def.Init<SerializableMinSumUDA>());
+  EXPECT_TRUE(def.supports_partial());
+
+  types::Int64ValueColumnWrapper v1({1, 2, 3});
+  types::Int64ValueColumnWrapper v2({5, 1, 3});
+
+  auto u1 = def.Make();
+  EXPECT_OK(def.ExecBatchUpdate(u1.get(), &ctx, {&v1, &v2}));
+  auto serialized_or_s = def.Serialize(u1.get(), &ctx);
+  EXPECT_OK(serialized_or_s);
+
+  types::Int64Value out;
+  auto u2 = def.Make();
+  EXPECT_OK(def.Deserialize(u2.get(), &ctx, serialized_or_s.ConsumeValueOrDie()));
+  EXPECT_OK(def.FinalizeValue(u2.get(), &ctx, &out));
+  EXPECT_EQ(5, out.val);
+}
+
+TEST(UDADefinition, serialize_unsupported) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  UDADefinition def("minsum");
+  EXPECT_OK(def.Init<MinSumUDA>());
+  EXPECT_FALSE(def.supports_partial());
+
+  auto u = def.Make();
+  EXPECT_NOT_OK(def.Serialize(u.get(), &ctx));
+  EXPECT_NOT_OK(def.Deserialize(u.get(), &ctx, "abc"));
+}
+
 TEST(UDADefinition, arrow_output) {
   auto ctx = FunctionContext(nullptr, nullptr);
   UDADefinition def("minsum");
@@ -43,12 +43,23 @@ class ScalarUDF1WithInit : ScalarUDF {
   types::Int64Value Exec(FunctionContext*, types::BoolValue, types::BoolValue) { return 0; }
 };
 
+class ScalarUDF1WithBatchArrow : ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, types::Int64Value) { return 0; }
+  Status ExecBatchArrow(FunctionContext*, const std::vector<arrow::Array*>&, arrow::ArrayBuilder*,
+                        int) {
+    return Status::OK();
+  }
+};
+
 TEST(ScalarUDF, basic_tests) {
   EXPECT_EQ(types::DataType::INT64, ScalarUDFTraits<ScalarUDF1>::ReturnType());
   EXPECT_THAT(ScalarUDFTraits<ScalarUDF1>::ExecArguments(),
               ElementsAre(types::DataType::BOOLEAN, types::DataType::INT64));
   EXPECT_FALSE(ScalarUDFTraits<ScalarUDF1>::HasInit());
   EXPECT_TRUE(ScalarUDFTraits<ScalarUDF1WithInit>::HasInit());
+  EXPECT_FALSE(ScalarUDFTraits<ScalarUDF1>::HasExecBatchArrow());
+  EXPECT_TRUE(ScalarUDFTraits<ScalarUDF1WithBatchArrow>::HasExecBatchArrow());
 }
 
 TEST(UDFDataTypes, valid_tests) {
@@ -191,6 +202,21 @@ TEST(UDA, deserialize_fn) { EXPECT_TRUE(IsValidDeserializeFn(&UDAWithSerdes::Des
 
 TEST(UDA, serdes_uda_traits) { EXPECT_TRUE(UDATraits<UDAWithSerdes>::SupportsPartial()); }
 
+class UDAWithBatchArrow : UDA {
+ public:
+  void Update(FunctionContext*, types::Int64Value) {}
+  Status UpdateBatchArrow(FunctionContext*, const std::vector<const arrow::Array*>&, size_t) {
+    return Status::OK();
+  }
+  void Merge(FunctionContext*, const UDAWithBatchArrow&) {}
+  types::Int64Value Finalize(FunctionContext*) { return 0; }
+};
+
+TEST(UDA, update_batch_arrow_traits) {
+  EXPECT_FALSE(UDATraits<UDA1>::HasUpdateBatchArrow());
+  EXPECT_TRUE(UDATraits<UDAWithBatchArrow>::HasUpdateBatchArrow());
+}
+
 TEST(BoolValue, value_tests) {
   // Test constructor init.
   types::BoolValue v(false);
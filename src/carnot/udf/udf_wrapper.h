@@ -22,6 +22,8 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 #include "src/carnot/udf/udf.h"
@@ -95,6 +97,34 @@ inline auto UnWrap<types::StringValue>(const types::StringValue& s) {
   return s;
 }
 
+// Maps an Exec member function pointer to the tuple of its declared argument types
+// (FunctionContext excluded).
+template <typename TFn>
+struct ExecFnArgs;
+
+template <typename ReturnType, typename TUDF, typename... Types>
+struct ExecFnArgs<ReturnType (TUDF::*)(FunctionContext*, Types...)> {
+  using args_tuple = std::tuple<std::decay_t<Types>...>;
+};
+
+// Reads one Exec argument out of an arrow array, dispatched on the UDF's declared parameter
+// type. The default reader materializes an owned value. The std::string_view reader borrows
+// the arrow offsets+data buffers directly, so UDFs that declare read-only string arguments as
+// string_view (see ValueTypeTraits<std::string_view>) run zero-copy over the batch.
+template <typename TArg>
+struct ExecArgReader {
+  static auto Read(const arrow::Array* arr, int64_t idx) {
+    return types::GetValueFromArrowArray<types::ValueTypeTraits<TArg>::data_type>(arr, idx);
+  }
+};
+
+template <>
+struct ExecArgReader<std::string_view> {
+  static std::string_view Read(const arrow::Array* arr, int64_t idx) {
+    return types::GetStringViewFromArrowArray(arr, idx);
+  }
+};
+
 /**
  * This is the inner wrapper for the arrow type.
  * This performs type casting and storing the data in the output builder.
@@ -102,8 +132,7 @@ inline auto UnWrap<types::StringValue>(const types::StringValue& s) {
 template <typename TUDF, typename TOutput, std::size_t... I>
 Status ExecWrapperArrow(TUDF* udf, FunctionContext* ctx, size_t count, TOutput* out,
                         const std::vector<arrow::Array*>& args, std::index_sequence<I...>) {
-  [[maybe_unused]] static constexpr auto exec_argument_types =
-      ScalarUDFTraits<TUDF>::ExecArguments();
+  using exec_args_tuple [[maybe_unused]] = typename ExecFnArgs<decltype(&TUDF::Exec)>::args_tuple;
   CHECK(out->Reserve(count).ok());
   size_t reserved = count * kStringAssumedSizeHeuristic;
   size_t total_size = 0;
@@ -114,8 +143,8 @@ Status ExecWrapperArrow(TUDF* udf, FunctionContext* ctx, size_t count, TOutput*
     CHECK(out->ReserveData(reserved).ok());
   }
   for (size_t idx = 0; idx < count; ++idx) {
-    auto res = UnWrap(
-        udf->Exec(ctx, types::GetValueFromArrowArray<exec_argument_types[I]>(args[I], idx)...));
+    auto res = UnWrap(udf->Exec(
+        ctx, ExecArgReader<std::tuple_element_t<I, exec_args_tuple>>::Read(args[I], idx)...));
 
     // We use doubling to make sure we minimize the number of allocations.
     // PL_CARNOT_UPDATE_FOR_NEW_TYPES.
@@ -197,13 +226,20 @@ struct ScalarUDFWrapper {
     // Check that the arity is correct.
     DCHECK(inputs.size() == ScalarUDFTraits<TUDF>::ExecArguments().size());
 
-    // The outer wrapper just casts the output type and UDF type. We then pass in
-    // the inputs with a sequence based on the number of arguments to iterate through and
-    // cast the inputs.
-    return ExecWrapperArrow<TUDF>(
-        static_cast<TUDF*>(udf), ctx, count,
-        static_cast<typename types::DataTypeTraits<return_type>::arrow_builder_type*>(output),
-        inputs, std::make_index_sequence<exec_argument_types.size()>{});
+    if constexpr (ScalarUDFTraits<TUDF>::HasExecBatchArrow()) {
+      // The UDF provides its own vectorized batch implementation; dispatch to it
+      // instead of calling Exec once per row.
+      PL_UNUSED(exec_argument_types);
+      return static_cast<TUDF*>(udf)->ExecBatchArrow(ctx, inputs, output, count);
+    } else {
+      // The outer wrapper just casts the output type and UDF type. We then pass in
+      // the inputs with a sequence based on the number of arguments to iterate through and
+      // cast the inputs.
+      return ExecWrapperArrow<TUDF>(
+          static_cast<TUDF*>(udf), ctx, count,
+          static_cast<typename types::DataTypeTraits<return_type>::arrow_builder_type*>(output),
+          inputs, std::make_index_sequence<exec_argument_types.size()>{});
+    }
   }
 
   /**
@@ -357,6 +393,11 @@ struct UDAWrapper {
     DCHECK(inputs.size() == update_argument_types.size());
 
     size_t num_records = inputs[0]->length();
+    // If the UDA provides its own vectorized implementation, use it instead of the
+    // row-at-a-time Update loop.
+    if constexpr (UDATraits<TUDA>::HasUpdateBatchArrow()) {
+      return static_cast<TUDA*>(uda)->UpdateBatchArrow(ctx, inputs, num_records);
+    }
     return UpdateWrapperArrow<TUDA>(static_cast<TUDA*>(uda), ctx, num_records, inputs,
                                     std::make_index_sequence<update_argument_types.size()>{});
   }
@@ -405,6 +446,42 @@ struct UDAWrapper {
     return Status::OK();
   }
 
+  /**
+   * Serializes the UDA's partial aggregate state into a string.
+   * Returns an error for UDAs that don't support partial aggregation.
+   */
+  template <typename Q = TUDA, std::enable_if_t<UDATraits<Q>::SupportsPartial(), void>* = nullptr>
+  static StatusOr<types::StringValue> SerializeImpl(UDA* uda, FunctionContext* ctx) {
+    return static_cast<TUDA*>(uda)->Serialize(ctx);
+  }
+
+  template <typename Q = TUDA, std::enable_if_t<!UDATraits<Q>::SupportsPartial(), void>* = nullptr>
+  static StatusOr<types::StringValue> SerializeImpl(UDA*, FunctionContext*) {
+    return error::Unimplemented("UDA does not support partial aggregation");
+  }
+
+  static StatusOr<types::StringValue> Serialize(UDA* uda, FunctionContext* ctx) {
+    return SerializeImpl(uda, ctx);
+  }
+
+  /**
+   * Restores the UDA's partial aggregate state from a serialized string.
+   * Returns an error for UDAs that don't support partial aggregation.
+   */
+  template <typename Q = TUDA, std::enable_if_t<UDATraits<Q>::SupportsPartial(), void>* = nullptr>
+  static Status DeserializeImpl(UDA* uda, FunctionContext* ctx, const types::StringValue& data) {
+    return static_cast<TUDA*>(uda)->Deserialize(ctx, data);
+  }
+
+  template <typename Q = TUDA, std::enable_if_t<!UDATraits<Q>::SupportsPartial(), void>* = nullptr>
+  static Status DeserializeImpl(UDA*, FunctionContext*, const types::StringValue&) {
+    return error::Unimplemented("UDA does not support partial aggregation");
+  }
+
+  static Status Deserialize(UDA* uda, FunctionContext* ctx, const types::StringValue& data) {
+    return DeserializeImpl(uda, ctx, data);
+  }
+
   /**
    * Finalize the UDA into an arrow builder. The arrow builder needs to be correct type
    * for the finalize return type.
@@ -467,6 +544,20 @@ struct UDTFWrapper {
     return Status::OK();
   }
 
+  /**
+   * Assigns the given partition to the UDTF instance. No-op for UDTFs without a SetPartition()
+   * member function; such UDTFs cannot be partitioned.
+   */
+  static void SetPartition(AnyUDTF* udtf, size_t partition_idx, size_t total_partitions) {
+    if constexpr (UDTFTraits<TUDTF>::HasSetPartitionFn()) {
+      static_cast<TUDTF*>(udtf)->SetPartition(partition_idx, total_partitions);
+    } else {
+      PL_UNUSED(udtf);
+      PL_UNUSED(partition_idx);
+      PL_UNUSED(total_partitions);
+    }
+  }
+
   static bool ExecBatchUpdate(AnyUDTF* udtf, FunctionContext* ctx, int max_gen_records,
                               std::vector<arrow::ArrayBuilder*>* outputs) {
     if (max_gen_records == 0) {
@@ -254,6 +254,13 @@ class UDTFTraits {
    */
   static constexpr bool HasNextRecordFn() { return NextRecordFnHelper<TUDTF>::value; }
 
+  /**
+   * Checks to see if SetPartition() exists. UDTFs that implement
+   * `void SetPartition(size_t partition_idx, size_t total_partitions)` can be run as multiple
+   * parallel instances, where each instance must produce a disjoint shard of the output.
+   */
+  static constexpr bool HasSetPartitionFn() { return SetPartitionFnHelper<TUDTF>::value; }
+
   template <typename Q = TUDTF, std::enable_if_t<UDTFTraits<Q>::HasInitArgsFn(), void>* = nullptr>
   static constexpr auto InitArguments() {
     return Q::InitArgs();
@@ -366,6 +373,12 @@ class UDTFTraits {
   template <typename T>
   struct ExecutorFnHelper<T, std::void_t<decltype(&T::Executor)>> : std::true_type {};
 
+  template <typename T, typename = void>
+  struct SetPartitionFnHelper : std::false_type {};
+
+  template <typename T>
+  struct SetPartitionFnHelper<T, std::void_t<decltype(&T::SetPartition)>> : std::true_type {};
+
   template <typename T, typename = void>
   struct NextRecordFnHelper : std::false_type {};
 
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace px {
+
+// The size of a transparent huge page on x86-64 and aarch64 (4K base pages).
+constexpr size_t kHugePageSizeBytes = 2 * 1024 * 1024;
+
+/**
+ * Advises the kernel to back the given buffer with transparent huge pages, which cuts TLB
+ * misses on large, hot, randomly-accessed structures such as hash table slot arrays.
+ *
+ * The range is shrunk inward to page boundaries, and ranges smaller than one huge page are
+ * ignored since they cannot benefit. The advice is best-effort: it is a no-op when THP is
+ * disabled on the host, and errors are deliberately swallowed. Safe to call repeatedly on
+ * the same buffer.
+ */
+inline void HintHugePages(void* addr, size_t len) {
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t start = reinterpret_cast<uintptr_t>(addr);
+  uintptr_t end = start + len;
+  start = (start + page_size - 1) & ~(page_size - 1);
+  end &= ~(page_size - 1);
+  if (end < start || end - start < kHugePageSizeBytes) {
+    return;
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE);
+#endif
+}
+
+}  // namespace px
@@ -26,14 +26,15 @@
 
 namespace px {
 
-Status::Status(statuspb::Code code, const std::string& msg) {
+Status::Status(statuspb::Code code, const std::string& msg) : code_(code) {
   state_ = std::make_unique<State>();
   state_->code = code;
   state_->msg = msg;
 }
 
 Status::Status(statuspb::Code code, const std::string& msg,
-               std::unique_ptr<google::protobuf::Message> context) {
+               std::unique_ptr<google::protobuf::Message> context)
+    : code_(code) {
   state_ = std::make_unique<State>(code, msg, std::move(context));
 }
 
@@ -41,6 +42,7 @@ Status::Status(const px::statuspb::Status& status_pb) {
   if (status_pb.err_code() == statuspb::Code::OK) {
     return;
   }
+  code_ = status_pb.err_code();
   std::unique_ptr<google::protobuf::Any> context = nullptr;
   // If type_url().empty() is true, then the Any field is not initialized
   // and we can skip reading it.
@@ -61,7 +63,7 @@ std::string Status::ToString() const {
     context_str = " Context: ";
     context_str += context()->DebugString();
   }
-  return absl::StrCat(px::error::CodeToString(code()), " : ", state_->msg + context_str);
+  return absl::StrCat(px::error::CodeToString(code()), " : ", msg() + context_str);
 }
 
 px::statuspb::Status Status::ToProto() const {
@@ -72,12 +74,11 @@ px::statuspb::Status Status::ToProto() const {
 
 void Status::ToProto(px::statuspb::Status* status_pb) const {
   CHECK(status_pb != nullptr);
+  status_pb->set_err_code(code_);
   if (state_ == nullptr) {
-    status_pb->set_err_code(statuspb::Code::OK);
     return;
   }
   status_pb->set_msg(state_->msg);
-  status_pb->set_err_code(state_->code);
   if (state_->context != nullptr) {
     auto context_pb = status_pb->mutable_context();
     // Note: this is an explicity copy, otherwise you get nested Any messages.
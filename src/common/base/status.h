@@ -35,6 +35,11 @@ class PL_MUST_USE_RESULT Status {
   // Success status.
   Status() = default;
   Status(const Status& s) noexcept;
+  /**
+   * Code-only error status. Does not allocate, so it is suitable for hot paths (e.g. per-record
+   * parsers) where the caller dispatches on the code and a message adds no value.
+   */
+  explicit Status(px::statuspb::Code code) noexcept : code_(code) {}
   Status(px::statuspb::Code code, const std::string& msg);
   Status(px::statuspb::Code code, const std::string& msg,
          std::unique_ptr<google::protobuf::Message> ctx);
@@ -44,17 +49,19 @@ class PL_MUST_USE_RESULT Status {
   void operator=(const Status& s) noexcept;
 
   /// Returns true if the status indicates success.
-  bool ok() const { return (state_ == nullptr); }
+  bool ok() const { return code_ == px::statuspb::OK; }
 
   // Return self, this makes it compatible with StatusOr<>.
   const Status& status() const { return *this; }
 
-  px::statuspb::Code code() const { return ok() ? px::statuspb::OK : state_->code; }
+  px::statuspb::Code code() const { return code_; }
 
-  const std::string& msg() const { return ok() ? empty_string() : state_->msg; }
+  const std::string& msg() const { return (state_ == nullptr) ? empty_string() : state_->msg; }
 
-  google::protobuf::Any* context() const { return ok() ? nullptr : state_->context.get(); }
-  bool has_context() const { return ok() ? false : state_->context != nullptr; }
+  google::protobuf::Any* context() const {
+    return (state_ == nullptr) ? nullptr : state_->context.get();
+  }
+  bool has_context() const { return (state_ == nullptr) ? false : state_->context != nullptr; }
 
   bool operator==(const Status& x) const;
   bool operator!=(const Status& x) const;
@@ -92,7 +99,9 @@ class PL_MUST_USE_RESULT Status {
     return *empty;
   }
 
-  // Will be null if status is OK.
+  px::statuspb::Code code_ = px::statuspb::OK;
+  // Holds the message and context. Null if status is OK, and also null for code-only error
+  // statuses constructed on hot paths.
   std::unique_ptr<State> state_;
 };
 
@@ -108,9 +117,10 @@ inline Status::State::State(const State& state) noexcept {
 }
 
 inline Status::Status(const Status& s) noexcept
-    : state_((s.state_ == nullptr) ? nullptr : new State(*s.state_)) {}
+    : code_(s.code_), state_((s.state_ == nullptr) ? nullptr : new State(*s.state_)) {}
 
 inline void Status::operator=(const Status& s) noexcept {
+  code_ = s.code_;
   // The following condition catches both aliasing (when this == &s),
   // and the common case where both s and *this are ok.
   if (state_ != s.state_) {
@@ -123,7 +133,9 @@ inline void Status::operator=(const Status& s) noexcept {
 }
 
 inline bool Status::operator==(const Status& x) const {
-  return (this->state_ == x.state_) || (ToString() == x.ToString());
+  // state_ is null both for OK and for code-only error statuses, so matching pointers only
+  // imply equality once the codes are known to match.
+  return (code_ == x.code_) && ((this->state_ == x.state_) || (ToString() == x.ToString()));
 }
 
 inline bool Status::operator!=(const Status& x) const { return !(*this == x); }
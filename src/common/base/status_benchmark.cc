@@ -0,0 +1,129 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "src/common/base/base.h"
+
+// This benchmark measures the cost of the Status/StatusOr plumbing on hot paths, and gates the
+// allocation count of the paths that are required to be allocation-free: the success path and
+// the code-only error path. If one of the gated benchmarks starts allocating, it CHECK-fails.
+
+namespace {
+std::atomic<size_t> g_alloc_count{0};
+}  // namespace
+
+// Count all global allocations made by the process, so allocations-per-op can be reported and
+// gated per benchmark.
+void* operator new(std::size_t size) {
+  ++g_alloc_count;
+  void* p = std::malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](std::size_t size) {
+  ++g_alloc_count;
+  void* p = std::malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+void ReportAndGateAllocs(benchmark::State* state, size_t allocs, bool must_be_alloc_free) {
+  double allocs_per_op = static_cast<double>(allocs) / state->iterations();
+  state->counters["allocs_per_op"] = allocs_per_op;
+  if (must_be_alloc_free) {
+    CHECK_EQ(allocs, 0U) << "Expected an allocation-free path, got "
+                         << allocs_per_op << " allocations per op.";
+  }
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_status_ok(benchmark::State& state) {
+  size_t start_allocs = g_alloc_count;
+  for (auto _ : state) {
+    px::Status s = px::Status::OK();
+    benchmark::DoNotOptimize(s.ok());
+  }
+  ReportAndGateAllocs(&state, g_alloc_count - start_allocs, /* must_be_alloc_free */ true);
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_statusor_success(benchmark::State& state) {
+  size_t start_allocs = g_alloc_count;
+  for (auto _ : state) {
+    px::StatusOr<int> s(42);
+    benchmark::DoNotOptimize(s.ok());
+  }
+  ReportAndGateAllocs(&state, g_alloc_count - start_allocs, /* must_be_alloc_free */ true);
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_status_code_only_error(benchmark::State& state) {
+  size_t start_allocs = g_alloc_count;
+  for (auto _ : state) {
+    px::Status s(px::statuspb::RESOURCE_UNAVAILABLE);
+    benchmark::DoNotOptimize(s.ok());
+  }
+  ReportAndGateAllocs(&state, g_alloc_count - start_allocs, /* must_be_alloc_free */ true);
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_statusor_code_only_error(benchmark::State& state) {
+  size_t start_allocs = g_alloc_count;
+  for (auto _ : state) {
+    px::StatusOr<int> s(px::Status(px::statuspb::RESOURCE_UNAVAILABLE));
+    benchmark::DoNotOptimize(s.ok());
+  }
+  ReportAndGateAllocs(&state, g_alloc_count - start_allocs, /* must_be_alloc_free */ true);
+}
+
+// The message-carrying error path is expected to allocate; this benchmark exists to show the
+// cost delta relative to the code-only path.
+// NOLINTNEXTLINE : runtime/references.
+void BM_status_message_error(benchmark::State& state) {
+  size_t start_allocs = g_alloc_count;
+  for (auto _ : state) {
+    px::Status s = px::error::ResourceUnavailable("Insufficient number of bytes: $0", 4);
+    benchmark::DoNotOptimize(s.ok());
+  }
+  ReportAndGateAllocs(&state, g_alloc_count - start_allocs, /* must_be_alloc_free */ false);
+}
+
+}  // namespace
+
+BENCHMARK(BM_status_ok);
+BENCHMARK(BM_statusor_success);
+BENCHMARK(BM_status_code_only_error);
+BENCHMARK(BM_statusor_code_only_error);
+BENCHMARK(BM_status_message_error);
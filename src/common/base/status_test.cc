@@ -36,6 +36,26 @@ TEST(Status, Default) {
   EXPECT_EQ(status.code(), px::statuspb::OK);
 }
 
+TEST(Status, CodeOnly) {
+  Status status(px::statuspb::RESOURCE_UNAVAILABLE);
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(status.code(), px::statuspb::RESOURCE_UNAVAILABLE);
+  EXPECT_EQ(status.msg(), "");
+  EXPECT_FALSE(status.has_context());
+  EXPECT_TRUE(error::IsResourceUnavailable(status));
+
+  Status copy = status;
+  EXPECT_EQ(copy, status);
+
+  // Code-only statuses have a null state_, like OK; equality must still distinguish them.
+  EXPECT_NE(status, Status::OK());
+  EXPECT_NE(status, Status(px::statuspb::INTERNAL));
+
+  auto pb = status.ToProto();
+  EXPECT_EQ(pb.err_code(), px::statuspb::RESOURCE_UNAVAILABLE);
+  EXPECT_EQ(pb.msg(), "");
+}
+
 TEST(Status, EqCopy) {
   Status a(px::statuspb::UNKNOWN, "Badness");
   Status b = a;
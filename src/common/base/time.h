@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <regex>
 #include <string>
 #include <utility>
@@ -110,4 +111,26 @@ inline int64_t CurrentSteadyTimeNS() {
       .count();
 }
 
+/**
+ * Helper to get the current time from the coarse (tick-resolution) wall clock, in nanoseconds.
+ * Reads a cached value through the vDSO, so it is considerably cheaper than CurrentTimeNS(),
+ * at the cost of roughly tick (1-4 ms) resolution. Prefer it for timestamps that are only
+ * compared at millisecond granularity or coarser.
+ */
+inline int64_t CurrentCoarseTimeNS() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+  return ts.tv_sec * 1000LL * 1000LL * 1000LL + ts.tv_nsec;
+}
+
+/**
+ * Coarse counterpart of CurrentSteadyTimeNS(), with the same cost/resolution trade-off as
+ * CurrentCoarseTimeNS(). See px::chrono::coarse_steady_clock for the std::chrono-style version.
+ */
+inline int64_t CurrentCoarseSteadyTimeNS() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+  return ts.tv_sec * 1000LL * 1000LL * 1000LL + ts.tv_nsec;
+}
+
 }  // namespace px
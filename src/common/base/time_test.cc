@@ -18,6 +18,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+
 #include "src/common/base/time.h"
 #include "src/common/testing/testing.h"
 
@@ -42,6 +44,13 @@ TEST(StringToTime, basic) {
 
 TEST(StringToTime, invalid_format) { EXPECT_FALSE(StringToTimeInt("hello").ok()); }
 
+TEST(CoarseClocks, tracks_fine_clocks) {
+  // The coarse clocks trail the fine ones by at most a few scheduler ticks.
+  constexpr int64_t kMaxSkewNS = 100 * 1000 * 1000;  // Generous bound for slow CI machines.
+  EXPECT_LT(std::abs(CurrentTimeNS() - CurrentCoarseTimeNS()), kMaxSkewNS);
+  EXPECT_LT(std::abs(CurrentSteadyTimeNS() - CurrentCoarseSteadyTimeNS()), kMaxSkewNS);
+}
+
 TEST(PrettyDuration, strings) {
   EXPECT_EQ("1.23 \u03BCs", PrettyDuration(1230));
   EXPECT_EQ("14.56 ms", PrettyDuration(14561230));
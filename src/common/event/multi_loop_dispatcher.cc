@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/common/event/multi_loop_dispatcher.h"
+
+#include <utility>
+
+#include <absl/hash/hash.h>
+
+namespace px {
+namespace event {
+
+namespace {
+
+// Runs the wrapped task's Work() on a worker loop, then posts Done() to the completion
+// dispatcher. The lifetime rules match LibuvRunnableAsyncTask: this object must outlive both
+// callbacks, so owners should release it via DeferredDelete from Done().
+class MultiLoopRunnableAsyncTask : public RunnableAsyncTask {
+ public:
+  MultiLoopRunnableAsyncTask(std::unique_ptr<AsyncTask> task, Dispatcher* worker,
+                             Dispatcher* done_dispatcher)
+      : RunnableAsyncTask(std::move(task)), worker_(worker), done_dispatcher_(done_dispatcher) {}
+
+  void Run() override {
+    worker_->Post([this]() {
+      task_->Work();
+      done_dispatcher_->Post([this]() { task_->Done(); });
+    });
+  }
+
+ private:
+  Dispatcher* worker_;
+  Dispatcher* done_dispatcher_;
+};
+
+}  // namespace
+
+MultiLoopDispatcher::MultiLoopDispatcher(API* api, std::string_view name, size_t num_workers) {
+  DCHECK(api != nullptr);
+  DCHECK_GT(num_workers, 0U);
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.push_back(api->AllocateDispatcher(absl::Substitute("$0_$1", name, i)));
+  }
+}
+
+MultiLoopDispatcher::~MultiLoopDispatcher() {
+  if (running_.load()) {
+    Stop();
+  }
+}
+
+void MultiLoopDispatcher::Run() {
+  CHECK(!running_.exchange(true)) << "MultiLoopDispatcher is already running.";
+  threads_.reserve(workers_.size());
+  for (auto& worker : workers_) {
+    // The loop's stop handler keeps it alive between posts, so Run blocks until Stop() is
+    // called on the worker.
+    threads_.emplace_back([&worker]() { worker->Run(Dispatcher::RunType::Block); });
+  }
+}
+
+void MultiLoopDispatcher::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  for (auto& worker : workers_) {
+    worker->Stop();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+  for (auto& worker : workers_) {
+    worker->Exit();
+  }
+}
+
+void MultiLoopDispatcher::Post(uint64_t affinity_key, PostCB callback) {
+  WorkerForKey(affinity_key)->Post(std::move(callback));
+}
+
+void MultiLoopDispatcher::Post(PostCB callback) {
+  workers_[round_robin_.fetch_add(1) % workers_.size()]->Post(std::move(callback));
+}
+
+RunnableAsyncTaskUPtr MultiLoopDispatcher::CreateAsyncTask(uint64_t affinity_key,
+                                                           std::unique_ptr<AsyncTask> task,
+                                                           Dispatcher* done_dispatcher) {
+  return std::make_unique<MultiLoopRunnableAsyncTask>(std::move(task), WorkerForKey(affinity_key),
+                                                      done_dispatcher);
+}
+
+Dispatcher* MultiLoopDispatcher::WorkerForKey(uint64_t affinity_key) {
+  return workers_[absl::Hash<uint64_t>{}(affinity_key) % workers_.size()].get();
+}
+
+}  // namespace event
+}  // namespace px
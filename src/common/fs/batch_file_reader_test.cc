@@ -0,0 +1,102 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/common/fs/batch_file_reader.h"
+
+#include <fstream>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace fs {
+
+class BatchFileReaderTest : public ::testing::Test {
+ protected:
+  std::string CreateFile(std::string_view name, std::string_view contents) {
+    std::string path = tmp_dir_.path() / name;
+    std::ofstream ofs(path);
+    ofs << contents;
+    return path;
+  }
+
+  testing::TempDir tmp_dir_;
+};
+
+TEST_F(BatchFileReaderTest, reads_files_in_order) {
+  std::vector<std::string> paths;
+  std::vector<std::string> expected;
+  for (int i = 0; i < 10; ++i) {
+    expected.push_back(absl::Substitute("contents of file $0\n", i));
+    paths.push_back(CreateFile(absl::Substitute("file$0", i), expected.back()));
+  }
+
+  BatchFileReader reader;
+  LOG(INFO) << absl::Substitute("io_uring backend in use: $0", reader.uses_io_uring());
+
+  std::vector<std::string> contents;
+  std::vector<Status> statuses = reader.ReadFiles(paths, &contents);
+  ASSERT_EQ(statuses.size(), paths.size());
+  ASSERT_EQ(contents.size(), paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    EXPECT_OK(statuses[i]);
+    EXPECT_EQ(contents[i], expected[i]);
+  }
+}
+
+TEST_F(BatchFileReaderTest, missing_file_is_not_found) {
+  std::vector<std::string> paths = {CreateFile("present", "abc"),
+                                    tmp_dir_.path() / "does_not_exist"};
+
+  BatchFileReader reader;
+  std::vector<std::string> contents;
+  std::vector<Status> statuses = reader.ReadFiles(paths, &contents);
+  ASSERT_EQ(statuses.size(), 2U);
+  EXPECT_OK(statuses[0]);
+  EXPECT_EQ(contents[0], "abc");
+  EXPECT_TRUE(error::IsNotFound(statuses[1]));
+  EXPECT_EQ(contents[1], "");
+}
+
+TEST_F(BatchFileReaderTest, truncates_to_max_file_size) {
+  std::vector<std::string> paths = {CreateFile("big", std::string(100, 'x'))};
+
+  BatchFileReader reader;
+  std::vector<std::string> contents;
+  std::vector<Status> statuses = reader.ReadFiles(paths, &contents, /*max_file_size*/ 10);
+  EXPECT_OK(statuses[0]);
+  EXPECT_EQ(contents[0], std::string(10, 'x'));
+}
+
+TEST_F(BatchFileReaderTest, batch_larger_than_ring) {
+  // More files than the ring's queue depth, to exercise chunked submission.
+  std::vector<std::string> paths;
+  for (int i = 0; i < 1000; ++i) {
+    paths.push_back(CreateFile(absl::Substitute("f$0", i), absl::Substitute("$0", i)));
+  }
+
+  BatchFileReader reader;
+  std::vector<std::string> contents;
+  std::vector<Status> statuses = reader.ReadFiles(paths, &contents);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_OK(statuses[i]);
+    EXPECT_EQ(contents[i], absl::Substitute("$0", i));
+  }
+}
+
+}  // namespace fs
+}  // namespace px
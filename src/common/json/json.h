@@ -187,6 +187,17 @@ class JSONObjectBuilder {
     writer_.EndArray();
   }
 
+  // Writes a key-value pair where value is an array of string views.
+  void WriteKV(std::string_view key, VectorView<std::string_view> value) {
+    DCHECK(!object_ended_);
+    writer_.String(key.data(), key.size());
+    writer_.StartArray();
+    for (auto v : value) {
+      writer_.String(v.data(), v.size());
+    }
+    writer_.EndArray();
+  }
+
   // Writes a key-value pair where value is an array of ints.
   void WriteKV(std::string_view key, VectorView<int32_t> value) {
     DCHECK(!object_ended_);
@@ -219,6 +230,22 @@ class JSONObjectBuilder {
     writer_.EndArray();
   }
 
+  // Same as above, for values that are views into an externally-owned buffer.
+  void WriteRepeatedKVs(std::string_view key, const std::vector<std::string_view>& keys,
+                        VectorView<std::string_view> values) {
+    DCHECK(!object_ended_);
+    DCHECK_EQ(values.size() % keys.size(), 0);
+
+    writer_.String(key.data(), key.size());
+    writer_.StartArray();
+    for (size_t i = 0; i < values.size(); ++i) {
+      writer_.StartObject();
+      WriteKV(keys[i % keys.size()], values[i]);
+      writer_.EndObject();
+    }
+    writer_.EndArray();
+  }
+
   // Writes a key and an object as value.
   // The ToJSON method of the object is called to recursively build a nested JSON structure.
   // For example:
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <absl/base/internal/spinlock.h>
+#include "src/common/base/base.h"
+
+namespace px {
+
+/**
+ * A bump allocator backed by geometrically growing blocks.
+ *
+ * Allocations are a pointer bump in the common case; nothing is freed individually. Instead,
+ * callers either destroy the arena, Reset() it between units of work, or take a Checkpoint
+ * before a speculative phase and Rewind() to it to discard everything allocated since.
+ * Rewinding retains the underlying blocks, so steady-state use settles into zero mallocs.
+ *
+ * The arena never runs destructors: New<T>() is restricted to trivially destructible types.
+ * Pair with ObjectPool for objects that need destruction.
+ *
+ * Not thread-safe. For concurrent producers, give each thread its own sub-arena via
+ * ThreadLocalArenaGroup below.
+ *
+ * Concepts and some code similar to Impala's MemPool.
+ */
+class Arena final : public px::NotCopyable {
+ public:
+  // Block sizes double from kMinBlockSize up to kMaxBlockSize; larger requests get a
+  // dedicated block of exactly the requested size.
+  static constexpr size_t kMinBlockSize = 4 * 1024;
+  static constexpr size_t kMaxBlockSize = 1024 * 1024;
+
+  /**
+   * An opaque marker for the arena's current position. Only valid for the arena that produced
+   * it, and invalidated by any earlier Rewind() or Reset().
+   */
+  class Checkpoint {
+   private:
+    friend class Arena;
+    size_t block_idx_ = 0;
+    size_t offset_ = 0;
+    size_t bytes_allocated_ = 0;
+  };
+
+  struct Stats {
+    size_t bytes_allocated = 0;  // Bytes handed out (including alignment padding).
+    size_t bytes_reserved = 0;   // Bytes held in blocks, whether or not handed out.
+    size_t num_blocks = 0;
+    size_t num_allocs = 0;
+  };
+
+  // Invoked with the signed change in reserved bytes whenever the arena acquires or releases
+  // blocks. Lets adopters wire arena growth into their own accounting/metrics.
+  using ReserveHook = std::function<void(int64_t delta_bytes)>;
+
+  Arena() = default;
+  explicit Arena(std::string_view name) : name_(name) {
+    VLOG(1) << "Creating Arena: " << name_;
+  }
+
+  ~Arena() {
+    ReleaseBlocksFrom(0);
+    VLOG_IF(1, !name_.empty()) << "Deleting Arena: " << name_;
+  }
+
+  /**
+   * Returns size bytes with the requested alignment. The memory is uninitialized and remains
+   * valid until the arena is destroyed, Reset(), or rewound past this allocation.
+   */
+  uint8_t* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    DCHECK_NE(size, 0U);
+    DCHECK((alignment & (alignment - 1)) == 0) << "Alignment must be a power of two.";
+    // Blocks come from operator new[], so only fundamental alignment is guaranteed.
+    DCHECK_LE(alignment, alignof(std::max_align_t));
+    while (true) {
+      if (current_block_ < blocks_.size()) {
+        auto& block = blocks_[current_block_];
+        const size_t aligned = (block.offset + alignment - 1) & ~(alignment - 1);
+        if (aligned + size <= block.size) {
+          bytes_allocated_ += (aligned + size) - block.offset;
+          block.offset = aligned + size;
+          ++num_allocs_;
+          return block.data.get() + aligned;
+        }
+        // Blocks retained by a previous Rewind()/Reset() are reused in order before new
+        // blocks are acquired.
+        if (current_block_ + 1 < blocks_.size()) {
+          ++current_block_;
+          continue;
+        }
+      }
+      AcquireBlock(size + alignment);
+    }
+  }
+
+  /**
+   * Allocates and constructs a T. Restricted to trivially destructible types, since the
+   * arena never runs destructors.
+   */
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena::New requires a trivially destructible type; destructors never run.");
+    return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /**
+   * Copies the string into the arena and returns a view of the copy.
+   */
+  std::string_view CopyString(std::string_view s) {
+    if (s.empty()) {
+      return {};
+    }
+    uint8_t* buf = Allocate(s.size(), 1);
+    std::copy(s.begin(), s.end(), buf);
+    return std::string_view(reinterpret_cast<const char*>(buf), s.size());
+  }
+
+  /**
+   * Captures the current position, to Rewind() to after a speculative phase.
+   */
+  Checkpoint GetCheckpoint() const {
+    Checkpoint cp;
+    cp.block_idx_ = current_block_;
+    cp.offset_ = current_block_ < blocks_.size() ? blocks_[current_block_].offset : 0;
+    cp.bytes_allocated_ = bytes_allocated_;
+    return cp;
+  }
+
+  /**
+   * Discards everything allocated since the checkpoint. Blocks are retained for reuse;
+   * memory handed out after the checkpoint must no longer be referenced.
+   */
+  void Rewind(const Checkpoint& cp) {
+    DCHECK_LE(cp.block_idx_, current_block_);
+    DCHECK_LE(cp.bytes_allocated_, bytes_allocated_);
+    for (size_t i = cp.block_idx_ + 1; i <= current_block_ && i < blocks_.size(); ++i) {
+      blocks_[i].offset = 0;
+    }
+    if (cp.block_idx_ < blocks_.size()) {
+      blocks_[cp.block_idx_].offset = cp.offset_;
+    }
+    current_block_ = cp.block_idx_;
+    bytes_allocated_ = cp.bytes_allocated_;
+  }
+
+  /**
+   * Discards all allocations. The first block is retained for reuse; the rest are released.
+   */
+  void Reset() {
+    if (!blocks_.empty()) {
+      blocks_[0].offset = 0;
+      ReleaseBlocksFrom(1);
+    }
+    current_block_ = 0;
+    bytes_allocated_ = 0;
+  }
+
+  Stats stats() const {
+    Stats s;
+    s.bytes_allocated = bytes_allocated_;
+    s.bytes_reserved = bytes_reserved_;
+    s.num_blocks = blocks_.size();
+    s.num_allocs = num_allocs_;
+    return s;
+  }
+
+  void set_reserve_hook(ReserveHook hook) { reserve_hook_ = std::move(hook); }
+
+ private:
+  struct Block {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size = 0;
+    size_t offset = 0;
+  };
+
+  void AcquireBlock(size_t min_size) {
+    size_t next_size = blocks_.empty() ? kMinBlockSize
+                                       : std::min(blocks_.back().size * 2, kMaxBlockSize);
+    next_size = std::max(next_size, min_size);
+    Block block;
+    block.data = std::make_unique<uint8_t[]>(next_size);
+    block.size = next_size;
+    blocks_.push_back(std::move(block));
+    current_block_ = blocks_.size() - 1;
+    bytes_reserved_ += next_size;
+    if (reserve_hook_) {
+      reserve_hook_(static_cast<int64_t>(next_size));
+    }
+  }
+
+  void ReleaseBlocksFrom(size_t first_idx) {
+    int64_t released = 0;
+    for (size_t i = first_idx; i < blocks_.size(); ++i) {
+      released += static_cast<int64_t>(blocks_[i].size);
+    }
+    blocks_.resize(first_idx);
+    bytes_reserved_ -= static_cast<size_t>(released);
+    if (released != 0 && reserve_hook_) {
+      reserve_hook_(-released);
+    }
+  }
+
+  const std::string name_;
+  std::vector<Block> blocks_;
+  size_t current_block_ = 0;
+  size_t bytes_allocated_ = 0;
+  size_t bytes_reserved_ = 0;
+  size_t num_allocs_ = 0;
+  ReserveHook reserve_hook_;
+};
+
+/**
+ * Hands each calling thread its own Arena, so concurrent producers can bump-allocate without
+ * contending. The lookup takes a spinlock, so acquire the sub-arena once per unit of work
+ * (e.g. per batch), not per allocation. Reset()/stats aggregate across all sub-arenas and
+ * must not race with threads still allocating.
+ */
+class ThreadLocalArenaGroup final : public px::NotCopyable {
+ public:
+  ThreadLocalArenaGroup() = default;
+  explicit ThreadLocalArenaGroup(std::string_view name) : name_(name) {}
+
+  /**
+   * Returns the calling thread's sub-arena, creating it on first use.
+   */
+  Arena* GetThreadArena() {
+    const auto tid = std::this_thread::get_id();
+    absl::base_internal::SpinLockHolder lock(&lock_);
+    auto& arena = arenas_[tid];
+    if (arena == nullptr) {
+      arena = std::make_unique<Arena>(name_);
+    }
+    return arena.get();
+  }
+
+  /**
+   * Resets every sub-arena. Callers must ensure no thread is concurrently allocating.
+   */
+  void ResetAll() {
+    absl::base_internal::SpinLockHolder lock(&lock_);
+    for (auto& [tid, arena] : arenas_) {
+      arena->Reset();
+    }
+  }
+
+  Arena::Stats AggregateStats() const {
+    Arena::Stats total;
+    absl::base_internal::SpinLockHolder lock(&lock_);
+    for (const auto& [tid, arena] : arenas_) {
+      const auto s = arena->stats();
+      total.bytes_allocated += s.bytes_allocated;
+      total.bytes_reserved += s.bytes_reserved;
+      total.num_blocks += s.num_blocks;
+      total.num_allocs += s.num_allocs;
+    }
+    return total;
+  }
+
+ private:
+  const std::string name_;
+  mutable absl::base_internal::SpinLock lock_;
+  std::map<std::thread::id, std::unique_ptr<Arena>> arenas_;
+};
+
+}  // namespace px
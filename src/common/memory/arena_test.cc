@@ -0,0 +1,157 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/common/memory/arena.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace px {
+
+TEST(arena_test, basic_allocation) {
+  Arena arena;
+  uint8_t* a = arena.Allocate(16);
+  uint8_t* b = arena.Allocate(16);
+  ASSERT_NE(nullptr, a);
+  ASSERT_NE(nullptr, b);
+  EXPECT_NE(a, b);
+  // Writable, and distinct allocations don't alias.
+  std::memset(a, 0xaa, 16);
+  std::memset(b, 0xbb, 16);
+  EXPECT_EQ(0xaa, a[15]);
+  EXPECT_EQ(0xbb, b[0]);
+
+  auto stats = arena.stats();
+  EXPECT_EQ(2, stats.num_allocs);
+  EXPECT_GE(stats.bytes_allocated, 32);
+  EXPECT_GE(stats.bytes_reserved, stats.bytes_allocated);
+}
+
+TEST(arena_test, alignment) {
+  Arena arena;
+  arena.Allocate(1, 1);
+  uint8_t* p = arena.Allocate(8, 8);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(p) % 8);
+}
+
+TEST(arena_test, new_object) {
+  struct Point {
+    int x;
+    int y;
+  };
+  Arena arena;
+  Point* p = arena.New<Point>(Point{1, 2});
+  EXPECT_EQ(1, p->x);
+  EXPECT_EQ(2, p->y);
+}
+
+TEST(arena_test, copy_string) {
+  Arena arena;
+  std::string original = "hello arena";
+  std::string_view copy = arena.CopyString(original);
+  original[0] = 'j';
+  EXPECT_EQ("hello arena", copy);
+  EXPECT_EQ("", arena.CopyString(""));
+}
+
+TEST(arena_test, grows_beyond_first_block) {
+  Arena arena;
+  for (int i = 0; i < 100; ++i) {
+    arena.Allocate(1024);
+  }
+  auto stats = arena.stats();
+  EXPECT_GT(stats.num_blocks, 1);
+  EXPECT_GE(stats.bytes_allocated, 100 * 1024);
+}
+
+TEST(arena_test, oversized_allocation) {
+  Arena arena;
+  uint8_t* p = arena.Allocate(2 * Arena::kMaxBlockSize);
+  ASSERT_NE(nullptr, p);
+  std::memset(p, 0, 2 * Arena::kMaxBlockSize);
+}
+
+TEST(arena_test, checkpoint_rewind) {
+  Arena arena;
+  arena.Allocate(64);
+  auto cp = arena.GetCheckpoint();
+  const auto before = arena.stats();
+
+  for (int i = 0; i < 1000; ++i) {
+    arena.Allocate(512);
+  }
+  arena.Rewind(cp);
+
+  auto after = arena.stats();
+  EXPECT_EQ(before.bytes_allocated, after.bytes_allocated);
+  // Rewind retains blocks for reuse, so re-running the speculative phase reserves nothing new.
+  const auto reserved_after_rewind = after.bytes_reserved;
+  for (int i = 0; i < 1000; ++i) {
+    arena.Allocate(512);
+  }
+  EXPECT_EQ(reserved_after_rewind, arena.stats().bytes_reserved);
+}
+
+TEST(arena_test, reset_retains_first_block) {
+  Arena arena;
+  for (int i = 0; i < 100; ++i) {
+    arena.Allocate(1024);
+  }
+  arena.Reset();
+  auto stats = arena.stats();
+  EXPECT_EQ(0, stats.bytes_allocated);
+  EXPECT_EQ(1, stats.num_blocks);
+}
+
+TEST(arena_test, reserve_hook) {
+  int64_t reserved = 0;
+  {
+    Arena arena;
+    arena.set_reserve_hook([&reserved](int64_t delta) { reserved += delta; });
+    for (int i = 0; i < 100; ++i) {
+      arena.Allocate(1024);
+    }
+    EXPECT_EQ(arena.stats().bytes_reserved, static_cast<size_t>(reserved));
+  }
+  EXPECT_EQ(0, reserved);
+}
+
+TEST(thread_local_arena_group_test, per_thread_arenas) {
+  ThreadLocalArenaGroup group("test");
+  Arena* main_arena = group.GetThreadArena();
+  EXPECT_EQ(main_arena, group.GetThreadArena());
+
+  Arena* other_arena = nullptr;
+  std::thread t([&]() {
+    other_arena = group.GetThreadArena();
+    other_arena->Allocate(64);
+  });
+  t.join();
+  EXPECT_NE(main_arena, other_arena);
+
+  main_arena->Allocate(64);
+  auto stats = group.AggregateStats();
+  EXPECT_EQ(2, stats.num_allocs);
+
+  group.ResetAll();
+  EXPECT_EQ(0, group.AggregateStats().bytes_allocated);
+}
+
+}  // namespace px
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/common/perf/hot_path_profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+namespace px {
+namespace profiler {
+
+constexpr char HotPathProfiler::kOverflowMarkerName[];
+
+HotPathProfiler& HotPathProfiler::GetInstance() {
+  // Deliberately leaked: threads may retire during static destruction, after a function-local
+  // static would have been destroyed.
+  static HotPathProfiler* profiler = new HotPathProfiler();
+  return *profiler;
+}
+
+uint64_t HotPathProfiler::NowTicks() {
+#if defined(__x86_64__)
+  uint32_t lo, hi;
+  asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+#else
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+#endif
+}
+
+double HotPathProfiler::NsPerTick() {
+#if defined(__x86_64__)
+  // Calibrate the TSC against steady_clock once, on the first Collect(). Modern x86-64 has a
+  // constant-rate TSC, so a single measurement holds for the process lifetime.
+  static const double ns_per_tick = []() {
+    const auto t0 = std::chrono::steady_clock::now();
+    const uint64_t c0 = NowTicks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const auto t1 = std::chrono::steady_clock::now();
+    const uint64_t c1 = NowTicks();
+    const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    return static_cast<double>(elapsed_ns) / static_cast<double>(c1 - c0);
+  }();
+  return ns_per_tick;
+#else
+  return 1.0;
+#endif
+}
+
+HotPathProfiler::ThreadSlots* HotPathProfiler::GetThreadSlots() {
+  // The handle's destructor runs at thread exit and folds this thread's counters into the
+  // process-wide retired totals.
+  struct Handle {
+    ThreadSlots* slots = nullptr;
+    ~Handle() {
+      if (slots != nullptr) {
+        GetInstance().RetireThread(slots);
+      }
+    }
+  };
+  thread_local Handle handle;
+  if (handle.slots == nullptr) {
+    handle.slots = GetInstance().RegisterThread();
+  }
+  return handle.slots;
+}
+
+HotPathProfiler::ThreadSlots* HotPathProfiler::RegisterThread() {
+  auto* slots = new ThreadSlots();
+  std::lock_guard<std::mutex> lock(lock_);
+  live_threads_.push_back(slots);
+  return slots;
+}
+
+void HotPathProfiler::RetireThread(ThreadSlots* slots) {
+  std::lock_guard<std::mutex> lock(lock_);
+  for (const auto& slot : slots->slots) {
+    const char* name = slot.name.load(std::memory_order_acquire);
+    if (name == nullptr) {
+      break;
+    }
+    auto& stats = retired_[name];
+    stats.name = name;
+    stats.count += slot.count.load(std::memory_order_relaxed);
+    stats.total_ns += slot.total_ticks.load(std::memory_order_relaxed);
+    stats.max_ns = std::max(stats.max_ns, slot.max_ticks.load(std::memory_order_relaxed));
+  }
+  const uint64_t dropped = slots->dropped.load(std::memory_order_relaxed);
+  if (dropped > 0) {
+    auto& stats = retired_[kOverflowMarkerName];
+    stats.name = kOverflowMarkerName;
+    stats.count += dropped;
+  }
+  live_threads_.erase(std::remove(live_threads_.begin(), live_threads_.end(), slots),
+                      live_threads_.end());
+  delete slots;
+}
+
+void HotPathProfiler::Record(const char* name, uint64_t ticks) {
+  ThreadSlots* thread_slots = GetThreadSlots();
+  Slot* slot = nullptr;
+  for (auto& candidate : thread_slots->slots) {
+    const char* existing = candidate.name.load(std::memory_order_relaxed);
+    if (existing == name) {
+      slot = &candidate;
+      break;
+    }
+    if (existing == nullptr) {
+      // First span for this marker on this thread. Slots are claimed in order and only by the
+      // owning thread, so a plain store suffices; release pairs with Collect()'s acquire.
+      candidate.name.store(name, std::memory_order_release);
+      slot = &candidate;
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    thread_slots->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Only this thread writes the counters, so load+store is race-free with other writers;
+  // relaxed is fine since Collect() tolerates skew.
+  slot->count.store(slot->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  slot->total_ticks.store(slot->total_ticks.load(std::memory_order_relaxed) + ticks,
+                          std::memory_order_relaxed);
+  if (ticks > slot->max_ticks.load(std::memory_order_relaxed)) {
+    slot->max_ticks.store(ticks, std::memory_order_relaxed);
+  }
+}
+
+std::vector<HotPathProfiler::MarkerStats> HotPathProfiler::Collect() {
+  const double ns_per_tick = NsPerTick();
+
+  std::map<std::string, MarkerStats> merged;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    // Retired totals are stored in ticks; converted below along with everything else.
+    merged = retired_;
+    for (const auto* thread_slots : live_threads_) {
+      for (const auto& slot : thread_slots->slots) {
+        const char* name = slot.name.load(std::memory_order_acquire);
+        if (name == nullptr) {
+          break;
+        }
+        auto& stats = merged[name];
+        stats.name = name;
+        stats.count += slot.count.load(std::memory_order_relaxed);
+        stats.total_ns += slot.total_ticks.load(std::memory_order_relaxed);
+        stats.max_ns = std::max(stats.max_ns, slot.max_ticks.load(std::memory_order_relaxed));
+      }
+      const uint64_t dropped = thread_slots->dropped.load(std::memory_order_relaxed);
+      if (dropped > 0) {
+        auto& stats = merged[kOverflowMarkerName];
+        stats.name = kOverflowMarkerName;
+        stats.count += dropped;
+      }
+    }
+  }
+
+  std::vector<MarkerStats> out;
+  out.reserve(merged.size());
+  for (auto& [name, stats] : merged) {
+    stats.total_ns = static_cast<uint64_t>(static_cast<double>(stats.total_ns) * ns_per_tick);
+    stats.max_ns = static_cast<uint64_t>(static_cast<double>(stats.max_ns) * ns_per_tick);
+    out.push_back(std::move(stats));
+  }
+  return out;
+}
+
+}  // namespace profiler
+}  // namespace px
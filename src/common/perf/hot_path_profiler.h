@@ -0,0 +1,142 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace profiler {
+
+/**
+ * HotPathProfiler is an always-on, low-overhead instrumentation layer for hot code paths.
+ *
+ * Unlike the external CPU profiler (profiler.h), which requires tcmalloc and an operator to
+ * start/stop it, these markers are cheap enough to leave compiled in and running in production:
+ * each completed span is a handful of relaxed atomic stores into a per-thread slot table, with
+ * timestamps taken from the TSC where available. Aggregation, string handling, and tick-to-ns
+ * conversion all happen in Collect(), off the hot path.
+ *
+ * Typical usage:
+ *
+ *   void Table::DoExpensiveThing() {
+ *     px::profiler::HotPathSpan span("table_store.expensive_thing");
+ *     ...
+ *   }
+ *
+ * Marker names must be string literals (or otherwise outlive the process): the per-thread slot
+ * tables key on pointer identity so the hot path never hashes or compares strings.
+ */
+class HotPathProfiler : public NotCopyable {
+ public:
+  /**
+   * Aggregated statistics for one marker, across all threads since process start.
+   */
+  struct MarkerStats {
+    std::string name;
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+  };
+
+  // Distinct markers one thread can record. Exceeding this drops the extra markers on that
+  // thread (tracked in MarkerStats under kOverflowMarkerName) rather than slowing the hot path.
+  static constexpr int kMaxMarkersPerThread = 64;
+  static constexpr char kOverflowMarkerName[] = "hot_path_profiler.slot_overflow";
+
+  static HotPathProfiler& GetInstance();
+
+  /**
+   * Records one completed span of the given duration (in ticks) against the marker.
+   * Prefer HotPathSpan over calling this directly.
+   */
+  void Record(const char* name, uint64_t ticks);
+
+  /**
+   * Returns aggregated stats for every marker, merged across live threads and threads that
+   * have since exited, sorted by name. Counters are read without synchronizing against
+   * writers, so a marker's count and total may be skewed by spans completing concurrently.
+   * The first call blocks briefly (~10ms) to calibrate the tick-to-nanosecond conversion.
+   */
+  std::vector<MarkerStats> Collect();
+
+  /**
+   * Current value of the tick source: the TSC on x86-64, otherwise steady_clock nanoseconds.
+   */
+  static uint64_t NowTicks();
+
+ private:
+  // One marker's counters on one thread. Only the owning thread writes; Collect() reads
+  // concurrently, hence the atomics. The name is stored last with release semantics to
+  // publish the slot.
+  struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ticks{0};
+    std::atomic<uint64_t> max_ticks{0};
+  };
+
+  struct ThreadSlots {
+    std::array<Slot, kMaxMarkersPerThread> slots;
+    std::atomic<uint64_t> dropped{0};
+  };
+
+  HotPathProfiler() = default;
+
+  // Returns this thread's slot table, registering the thread on first use.
+  static ThreadSlots* GetThreadSlots();
+
+  ThreadSlots* RegisterThread();
+  void RetireThread(ThreadSlots* slots);
+
+  static double NsPerTick();
+
+  std::mutex lock_;
+  std::vector<ThreadSlots*> live_threads_;
+  // Totals folded in from exited threads, keyed by marker name (by content, since literals
+  // from different translation units may not share a pointer).
+  std::map<std::string, MarkerStats> retired_;
+};
+
+/**
+ * Measures the enclosing scope and records it against the given marker on destruction.
+ * The name must be a string literal; see HotPathProfiler.
+ */
+class HotPathSpan : public NotCopyable {
+ public:
+  explicit HotPathSpan(const char* name)
+      : name_(name), start_ticks_(HotPathProfiler::NowTicks()) {}
+  ~HotPathSpan() {
+    HotPathProfiler::GetInstance().Record(name_, HotPathProfiler::NowTicks() - start_ticks_);
+  }
+
+ private:
+  const char* name_;
+  uint64_t start_ticks_;
+};
+
+}  // namespace profiler
+}  // namespace px
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "src/common/perf/hot_path_profiler.h"
+
+namespace px {
+namespace profiler {
+
+namespace {
+
+// The profiler is a process-wide singleton, so tests use distinct marker names and look up
+// their own markers rather than asserting on the full collection.
+const HotPathProfiler::MarkerStats* FindMarker(
+    const std::vector<HotPathProfiler::MarkerStats>& stats, const std::string& name) {
+  for (const auto& s : stats) {
+    if (s.name == name) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(HotPathProfilerTest, records_spans) {
+  for (int i = 0; i < 3; ++i) {
+    HotPathSpan span("test.records_spans");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto stats = HotPathProfiler::GetInstance().Collect();
+  const auto* marker = FindMarker(stats, "test.records_spans");
+  ASSERT_NE(marker, nullptr);
+  EXPECT_EQ(3, marker->count);
+  EXPECT_GT(marker->total_ns, 0);
+  EXPECT_GE(marker->total_ns, marker->max_ns);
+  EXPECT_GT(marker->max_ns, 0);
+}
+
+TEST(HotPathProfilerTest, merges_exited_threads) {
+  auto record = []() {
+    HotPathSpan span("test.merges_exited_threads");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+  record();
+
+  std::thread t(record);
+  t.join();
+
+  auto stats = HotPathProfiler::GetInstance().Collect();
+  const auto* marker = FindMarker(stats, "test.merges_exited_threads");
+  ASSERT_NE(marker, nullptr);
+  EXPECT_EQ(2, marker->count);
+}
+
+TEST(HotPathProfilerTest, distinct_markers) {
+  { HotPathSpan span("test.distinct_markers_a"); }
+  { HotPathSpan span("test.distinct_markers_b"); }
+  { HotPathSpan span("test.distinct_markers_b"); }
+
+  auto stats = HotPathProfiler::GetInstance().Collect();
+  const auto* a = FindMarker(stats, "test.distinct_markers_a");
+  const auto* b = FindMarker(stats, "test.distinct_markers_b");
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(1, a->count);
+  EXPECT_EQ(2, b->count);
+}
+
+}  // namespace profiler
+}  // namespace px
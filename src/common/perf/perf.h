@@ -22,7 +22,8 @@
  * importing them everywhere.
  */
 
-#include "src/common/perf/elapsed_timer.h"    // IWYU pragma: export
-#include "src/common/perf/profiler.h"         // IWYU pragma: export
-#include "src/common/perf/scoped_profiler.h"  // IWYU pragma: export
-#include "src/common/perf/scoped_timer.h"     // IWYU pragma: export
+#include "src/common/perf/elapsed_timer.h"      // IWYU pragma: export
+#include "src/common/perf/hot_path_profiler.h"  // IWYU pragma: export
+#include "src/common/perf/profiler.h"           // IWYU pragma: export
+#include "src/common/perf/scoped_profiler.h"    // IWYU pragma: export
+#include "src/common/perf/scoped_timer.h"       // IWYU pragma: export
@@ -51,5 +51,9 @@ using boot_clock = basic_clock<CLOCK_BOOTTIME>;
 // If resolution beyond a millisecond is not required, this should be sufficient.
 using coarse_steady_clock = basic_clock<CLOCK_MONOTONIC_COARSE>;
 
+// Clock based on CLOCK_REALTIME_COARSE: the wall-clock counterpart of coarse_steady_clock,
+// with the same cost/resolution trade-off.
+using coarse_system_clock = basic_clock<CLOCK_REALTIME_COARSE>;
+
 }  // namespace chrono
 }  // namespace px
@@ -17,6 +17,7 @@
  */
 
 #include <fstream>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -155,6 +156,20 @@ bool ShouldIncludeNetIFace(const std::string_view iface) {
 }
 
 Status ProcParser::ParseProcPIDNetDev(int32_t pid, NetworkStats* out) const {
+  DCHECK(out != nullptr);
+
+  std::string fpath = absl::Substitute("$0/$1/net/dev", proc_base_path_, pid);
+  std::ifstream ifs;
+  ifs.open(fpath);
+  if (!ifs) {
+    return error::Internal("Failed to open file $0", fpath);
+  }
+
+  std::string contents((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  return ParseProcNetDevContents(contents, out);
+}
+
+Status ProcParser::ParseProcNetDevContents(std::string_view contents, NetworkStats* out) {
   /**
    * Sample file:
    * Inter-|   Receive                                                | Transmit
@@ -167,22 +182,12 @@ Status ProcParser::ParseProcPIDNetDev(int32_t pid, NetworkStats* out) const {
    */
   DCHECK(out != nullptr);
 
-  std::string fpath = absl::Substitute("$0/$1/net/dev", proc_base_path_, pid);
-  std::ifstream ifs;
-  ifs.open(fpath);
-  if (!ifs) {
-    return error::Internal("Failed to open file $0", fpath);
-  }
+  std::vector<std::string_view> lines = absl::StrSplit(contents, '\n', absl::SkipWhitespace());
 
-  // Ignore the first two lines since they are just headers;
-  const int kHeaderLines = 2;
-  for (int i = 0; i < kHeaderLines; ++i) {
-    ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  }
-
-  std::string line;
-  while (std::getline(ifs, line)) {
-    std::vector<std::string_view> split = absl::StrSplit(line, " ", absl::SkipWhitespace());
+  // Ignore the first two lines since they are just headers.
+  const size_t kHeaderLines = 2;
+  for (size_t i = kHeaderLines; i < lines.size(); ++i) {
+    std::vector<std::string_view> split = absl::StrSplit(lines[i], " ", absl::SkipWhitespace());
     // We check less than in case more fields are added later.
     if (split.size() < kProcNetDevNumFields) {
       return error::Internal("failed to parse net dev file, incorrect number of fields");
@@ -763,30 +768,42 @@ StatusOr<int64_t> GetPIDStartTimeTicks(const std::filesystem::path& proc_pid_pat
   }
 #endif
 
-  size_t open_paren_idx = line.find_first_of('(');
-  size_t close_paren_idx = line.find_last_of(')');
-  if (open_paren_idx == std::string::npos || close_paren_idx == std::string::npos) {
-    return error::Internal("Invalid command name in file $0", fpath);
+  auto start_time_ticks_or_s = ParsePIDStartTimeTicks(line);
+  if (!start_time_ticks_or_s.ok()) {
+    return error::Internal("Failed to parse start time from file $0 [$1]", fpath,
+                           start_time_ticks_or_s.msg());
   }
+  return start_time_ticks_or_s;
+}
 
-  // When split_size > kProcStatNumFields, there are spaces in the command we need to handle.
-  // command_offset adjusts index for the number of spaces in the command field.
-  int command_offset =
-      std::count(line.begin() + open_paren_idx, line.begin() + close_paren_idx, ' ');
+StatusOr<int64_t> ParsePIDStartTimeTicks(std::string_view stat_contents) {
+  // The command field can contain spaces and parentheses, so parsing starts after the last ')';
+  // everything from there on is simple space-separated values.
+  constexpr int kFieldsAfterCommand = kProcStatStartTimeField - 2;
 
-  std::vector<std::string_view> split = absl::StrSplit(line, " ", absl::SkipWhitespace());
-  // We check less than in case more fields are added later.
-  if (split.size() < kProcStatNumFields) {
-    return error::Internal("Unexpected number of columns in file $0 [columns = $1].", fpath,
-                           split.size());
+  size_t close_paren_idx = stat_contents.find_last_of(')');
+  if (close_paren_idx == std::string_view::npos) {
+    return error::Internal("Invalid command name in stat contents.");
   }
+  std::string_view remainder = stat_contents.substr(close_paren_idx + 1);
 
-  int64_t start_time_ticks;
-  if (!absl::SimpleAtoi(split[kProcStatStartTimeField + command_offset], &start_time_ticks)) {
-    return error::Internal("Time value does not parse in file $0", fpath);
+  size_t pos = 0;
+  for (int field = 0; field <= kFieldsAfterCommand; ++field) {
+    pos = remainder.find_first_not_of(' ', pos);
+    if (pos == std::string_view::npos) {
+      return error::Internal("Unexpected number of fields in stat contents.");
+    }
+    size_t end = remainder.find_first_of(" \n", pos);
+    if (field == kFieldsAfterCommand) {
+      int64_t start_time_ticks;
+      if (!absl::SimpleAtoi(remainder.substr(pos, end - pos), &start_time_ticks)) {
+        return error::Internal("Time value does not parse in stat contents.");
+      }
+      return start_time_ticks;
+    }
+    pos = end;
   }
-
-  return start_time_ticks;
+  return error::Internal("Unexpected number of fields in stat contents.");
 }
 
 namespace {
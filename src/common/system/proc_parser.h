@@ -236,6 +236,15 @@ class ProcParser {
    */
   Status ParseProcPIDNetDev(int32_t pid, NetworkStats* out) const;
 
+  /**
+   * Parses the contents of a /proc/<pid>/net/dev file that has already been read into memory.
+   * Useful for callers that keep the file open and re-read it with a reusable buffer.
+   * @param contents The full contents of the file.
+   * @param out A valid pointer to an output struct.
+   * @return Status of the parsing.
+   */
+  static Status ParseProcNetDevContents(std::string_view contents, NetworkStats* out);
+
   /**
    * Parses /proc/stat
    * @param out a valid pointer to an output struct.
@@ -398,5 +407,12 @@ class ProcParser {
 
 StatusOr<int64_t> GetPIDStartTimeTicks(const std::filesystem::path& proc_pid_path);
 
+/**
+ * Parses the process start time (in ticks since boot) out of the contents of a
+ * /proc/<pid>/stat file. Tokenizes in place without allocating, so it is suitable for
+ * scan loops that read many stat files into a reusable buffer.
+ */
+StatusOr<int64_t> ParsePIDStartTimeTicks(std::string_view stat_contents);
+
 }  // namespace system
 }  // namespace px
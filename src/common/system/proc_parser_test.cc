@@ -24,6 +24,7 @@
 #include <istream>
 #include <memory>
 #include <sstream>
+#include <string_view>
 
 #include "src/common/fs/fs_wrapper.h"
 #include "src/common/testing/test_environment.h"
@@ -79,6 +80,31 @@ TEST_F(ProcParserTest, ParseNetworkStat) {
   EXPECT_EQ(0, stats.tx_errs);
 }
 
+TEST_F(ProcParserTest, ParseNetworkStatFromContents) {
+  constexpr std::string_view kNetDevContents =
+      "Inter-|   Receive                                                |  Transmit\n"
+      " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs "
+      "drop fifo colls carrier compressed\n"
+      "  eth0:     100      10    1    2    0     0          0         0      200      20    3    "
+      "4    0     0       0          0\n"
+      "    lo:     999      99    9    9    0     0          0         0      999      99    9    "
+      "9    0     0       0          0\n";
+
+  ProcParser::NetworkStats stats;
+  ASSERT_OK(ProcParser::ParseProcNetDevContents(kNetDevContents, &stats));
+
+  // The loopback interface is excluded from the accumulation.
+  EXPECT_EQ(100, stats.rx_bytes);
+  EXPECT_EQ(10, stats.rx_packets);
+  EXPECT_EQ(1, stats.rx_errs);
+  EXPECT_EQ(2, stats.rx_drops);
+
+  EXPECT_EQ(200, stats.tx_bytes);
+  EXPECT_EQ(20, stats.tx_packets);
+  EXPECT_EQ(3, stats.tx_errs);
+  EXPECT_EQ(4, stats.tx_drops);
+}
+
 TEST_F(ProcParserTest, ParseStatIO) {
   ProcParser::ProcessStats stats;
   PL_CHECK_OK(parser_->ParseProcPIDStatIO(123, &stats));
@@ -263,6 +289,17 @@ TEST_F(ProcParserTest, read_pid_start_time) {
   ASSERT_OK_AND_EQ(parser_->GetPIDStartTimeTicks(123), 14329);
 }
 
+TEST(ParsePIDStartTimeTicksTest, parses_stat_contents) {
+  // The command field may contain spaces and parentheses.
+  constexpr std::string_view kStatContents =
+      "1234 (comm with ) spaces) R 1 1 1 0 -1 4194304 100 0 0 0 5 5 0 0 20 0 1 0 99999 1000 100 "
+      "18446744073709551615";
+  ASSERT_OK_AND_EQ(ParsePIDStartTimeTicks(kStatContents), 99999);
+
+  EXPECT_NOT_OK(ParsePIDStartTimeTicks("no parens here"));
+  EXPECT_NOT_OK(ParsePIDStartTimeTicks("1234 (comm) R 1 1 1"));
+}
+
 TEST_F(ProcParserTest, read_pid_cmdline) {
   EXPECT_THAT("/usr/lib/slack/slack --force-device-scale-factor=1.5 --high-dpi-support=1",
               parser_->GetPIDCmdline(123));
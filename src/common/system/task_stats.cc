@@ -0,0 +1,195 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/common/system/task_stats.h"
+
+#include <linux/genetlink.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace px {
+namespace system {
+
+namespace {
+
+// A generic netlink message: netlink header, followed by the genetlink header, followed by
+// netlink attributes. Large enough for both the requests and the responses used here.
+struct GenlMsg {
+  struct nlmsghdr header;
+  struct genlmsghdr genl_header;
+  char buf[1024];
+};
+
+// Searches a netlink attribute block for the attribute of the given type.
+StatusOr<const struct nlattr*> FindAttr(const char* buf, size_t len, uint16_t attr_type) {
+  while (len >= NLA_HDRLEN) {
+    const auto* attr = reinterpret_cast<const struct nlattr*>(buf);
+    if (attr->nla_len < NLA_HDRLEN || attr->nla_len > len) {
+      break;
+    }
+    if (attr->nla_type == attr_type) {
+      return attr;
+    }
+    const size_t step = NLA_ALIGN(attr->nla_len);
+    if (step >= len) {
+      break;
+    }
+    buf += step;
+    len -= step;
+  }
+  return error::NotFound("Could not find netlink attribute of type $0", attr_type);
+}
+
+const char* AttrData(const struct nlattr* attr) {
+  return reinterpret_cast<const char*>(attr) + NLA_HDRLEN;
+}
+
+size_t AttrPayloadLen(const struct nlattr* attr) { return attr->nla_len - NLA_HDRLEN; }
+
+Status RecvResp(int fd, GenlMsg* resp) {
+  ssize_t num_bytes = recv(fd, resp, sizeof(*resp), 0);
+  if (num_bytes < 0) {
+    return error::Internal("Failed to receive netlink taskstats response [errno=$0]", errno);
+  }
+  if (!NLMSG_OK(&resp->header, static_cast<unsigned int>(num_bytes))) {
+    return error::Internal("Received malformed netlink taskstats response");
+  }
+  if (resp->header.nlmsg_type == NLMSG_ERROR) {
+    const auto* err = reinterpret_cast<const struct nlmsgerr*>(NLMSG_DATA(&resp->header));
+    return error::Internal("Netlink taskstats request failed [errno=$0]", -err->error);
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status TaskStatsReader::Connect() {
+  fd_ = socket(AF_NETLINK, SOCK_DGRAM, NETLINK_GENERIC);
+  if (fd_ < 0) {
+    return error::Internal("Could not create NETLINK_GENERIC connection. [errno=$0]", errno);
+  }
+
+  struct sockaddr_nl nl_addr = {};
+  nl_addr.nl_family = AF_NETLINK;
+  if (bind(fd_, reinterpret_cast<struct sockaddr*>(&nl_addr), sizeof(nl_addr)) < 0) {
+    return error::Internal("Could not bind NETLINK_GENERIC connection. [errno=$0]", errno);
+  }
+
+  return Status::OK();
+}
+
+Status TaskStatsReader::SendCmd(uint16_t msg_type, uint8_t genl_cmd, uint16_t attr_type,
+                                const void* attr_data, size_t attr_len) {
+  GenlMsg msg = {};
+  msg.header.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+  msg.header.nlmsg_type = msg_type;
+  msg.header.nlmsg_flags = NLM_F_REQUEST;
+  msg.genl_header.cmd = genl_cmd;
+  msg.genl_header.version = TASKSTATS_GENL_VERSION;
+
+  auto* attr = reinterpret_cast<struct nlattr*>(reinterpret_cast<char*>(&msg) +
+                                                NLMSG_ALIGN(msg.header.nlmsg_len));
+  attr->nla_type = attr_type;
+  attr->nla_len = attr_len + NLA_HDRLEN;
+  memcpy(reinterpret_cast<char*>(attr) + NLA_HDRLEN, attr_data, attr_len);
+  msg.header.nlmsg_len += NLMSG_ALIGN(attr->nla_len);
+
+  struct sockaddr_nl nl_addr = {};
+  nl_addr.nl_family = AF_NETLINK;
+
+  const char* buf = reinterpret_cast<const char*>(&msg);
+  ssize_t msg_len = msg.header.nlmsg_len;
+  ssize_t bytes_sent = 0;
+  while (bytes_sent < msg_len) {
+    ssize_t retval = sendto(fd_, buf + bytes_sent, msg_len - bytes_sent, 0,
+                            reinterpret_cast<struct sockaddr*>(&nl_addr), sizeof(nl_addr));
+    if (retval < 0) {
+      return error::Internal("Failed to send netlink taskstats message [errno=$0]", errno);
+    }
+    bytes_sent += retval;
+  }
+
+  return Status::OK();
+}
+
+Status TaskStatsReader::ResolveFamilyID() {
+  PL_RETURN_IF_ERROR(SendCmd(GENL_ID_CTRL, CTRL_CMD_GETFAMILY, CTRL_ATTR_FAMILY_NAME,
+                             TASKSTATS_GENL_NAME, strlen(TASKSTATS_GENL_NAME) + 1));
+
+  GenlMsg resp = {};
+  PL_RETURN_IF_ERROR(RecvResp(fd_, &resp));
+
+  const size_t payload_len = resp.header.nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN);
+  PL_ASSIGN_OR_RETURN(const struct nlattr* attr,
+                      FindAttr(resp.buf, payload_len, CTRL_ATTR_FAMILY_ID));
+  if (AttrPayloadLen(attr) < sizeof(family_id_)) {
+    return error::Internal("Netlink family ID attribute is too short");
+  }
+  memcpy(&family_id_, AttrData(attr), sizeof(family_id_));
+
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<TaskStatsReader>> TaskStatsReader::Create() {
+  auto reader = std::unique_ptr<TaskStatsReader>(new TaskStatsReader);
+  PL_RETURN_IF_ERROR(reader->Connect());
+  PL_RETURN_IF_ERROR(reader->ResolveFamilyID());
+  // A probe query for our own process, to surface missing privileges (CAP_NET_ADMIN) at
+  // creation time rather than on every sample.
+  PL_RETURN_IF_ERROR(reader->GetTGIDStats(getpid()).status());
+  return reader;
+}
+
+TaskStatsReader::~TaskStatsReader() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+StatusOr<struct taskstats> TaskStatsReader::GetTGIDStats(int tgid) {
+  const uint32_t tgid_attr = tgid;
+  PL_RETURN_IF_ERROR(SendCmd(family_id_, TASKSTATS_CMD_GET, TASKSTATS_CMD_ATTR_TGID, &tgid_attr,
+                             sizeof(tgid_attr)));
+
+  GenlMsg resp = {};
+  PL_RETURN_IF_ERROR(RecvResp(fd_, &resp));
+
+  // The response nests the stats: TASKSTATS_TYPE_AGGR_TGID contains the tgid and the stats.
+  const size_t payload_len = resp.header.nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN);
+  PL_ASSIGN_OR_RETURN(const struct nlattr* aggr_attr,
+                      FindAttr(resp.buf, payload_len, TASKSTATS_TYPE_AGGR_TGID));
+  PL_ASSIGN_OR_RETURN(
+      const struct nlattr* stats_attr,
+      FindAttr(AttrData(aggr_attr), AttrPayloadLen(aggr_attr), TASKSTATS_TYPE_STATS));
+
+  // The kernel's taskstats struct may differ in size from the one this was compiled against,
+  // since the struct grows across versions. Fields beyond the kernel's version stay zero.
+  struct taskstats stats = {};
+  memcpy(&stats, AttrData(stats_attr), std::min(sizeof(stats), AttrPayloadLen(stats_attr)));
+  return stats;
+}
+
+}  // namespace system
+}  // namespace px
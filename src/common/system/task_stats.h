@@ -0,0 +1,72 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <linux/taskstats.h>
+
+#include <memory>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace system {
+
+/**
+ * The TaskStatsReader class queries the kernel's taskstats interface (a generic netlink family)
+ * for per-process CPU, page fault and I/O accounting.
+ *
+ * Compared to reading /proc/<pid>/stat and /proc/<pid>/io, a single persistent netlink socket
+ * serves all processes, which is considerably cheaper on nodes with many processes.
+ */
+class TaskStatsReader {
+ public:
+  /**
+   * Create a reader connected to the kernel's taskstats netlink family.
+   * Returns error if the kernel does not expose taskstats, or if the required privileges
+   * (CAP_NET_ADMIN) are missing.
+   */
+  static StatusOr<std::unique_ptr<TaskStatsReader>> Create();
+
+  ~TaskStatsReader();
+
+  /**
+   * Returns the accounting stats of a process, aggregated across its live threads.
+   * Note that, unlike /proc/<pid>/stat, the aggregation does not include already-exited threads.
+   *
+   * @param tgid The thread group ID (i.e. the PID) of the process.
+   */
+  StatusOr<struct taskstats> GetTGIDStats(int tgid);
+
+ private:
+  TaskStatsReader() = default;
+
+  Status Connect();
+  Status ResolveFamilyID();
+  Status SendCmd(uint16_t msg_type, uint8_t genl_cmd, uint16_t attr_type, const void* attr_data,
+                 size_t attr_len);
+
+  int fd_ = -1;
+
+  // The netlink family ID under which the kernel registered taskstats.
+  // Resolved once at creation time.
+  uint16_t family_id_ = 0;
+};
+
+}  // namespace system
+}  // namespace px
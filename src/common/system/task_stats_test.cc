@@ -0,0 +1,46 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/common/system/task_stats.h"
+
+#include <unistd.h>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace system {
+
+TEST(TaskStatsReaderTest, ReadsOwnProcessStats) {
+  ASSERT_OK_AND_ASSIGN(std::unique_ptr<TaskStatsReader> reader, TaskStatsReader::Create());
+
+  ASSERT_OK_AND_ASSIGN(struct taskstats stats, reader->GetTGIDStats(getpid()));
+
+  EXPECT_GT(stats.version, 0);
+  // Any running process has touched enough memory to take minor page faults.
+  EXPECT_GT(stats.ac_minflt, 0);
+}
+
+TEST(TaskStatsReaderTest, ErrorsOutOnNonExistentProcess) {
+  ASSERT_OK_AND_ASSIGN(std::unique_ptr<TaskStatsReader> reader, TaskStatsReader::Create());
+
+  // PIDs are positive, so -1 can never name a process.
+  EXPECT_NOT_OK(reader->GetTGIDStats(-1));
+}
+
+}  // namespace system
+}  // namespace px
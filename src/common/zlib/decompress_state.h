@@ -0,0 +1,39 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+namespace px {
+
+/**
+ * Outcome of feeding one chunk of compressed input to a streaming decompressor.
+ */
+enum class DecompressState {
+  // All provided input was consumed, but the compressed stream is not yet complete.
+  // Feed the next chunk to continue.
+  kNeedsMoreInput,
+
+  // The output byte limit was reached before the stream ended. Any unconsumed input was
+  // discarded, so the decompressor must be Reset() before starting a new stream.
+  kOutputFull,
+
+  // The end of the compressed stream was reached; the output is complete.
+  kStreamEnd,
+};
+
+}  // namespace px
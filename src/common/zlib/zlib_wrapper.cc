@@ -17,7 +17,9 @@
  */
 
 #include <zlib.h>
+#include <algorithm>
 #include <string>
+#include <utility>
 
 #include "src/common/base/base.h"
 #include "src/common/zlib/zlib_wrapper.h"
@@ -25,6 +27,11 @@
 namespace px {
 namespace zlib {
 
+namespace {
+// How many bytes to grow the output by per inflate call, subject to the caller's output limit.
+constexpr size_t kOutputBlockSize = 16384;
+}  // namespace
+
 StatusOr<std::string> Inflate(std::string_view in, size_t output_block_size) {
   z_stream zs = {};
 
@@ -60,5 +67,70 @@ StatusOr<std::string> Inflate(std::string_view in, size_t output_block_size) {
   return out;
 }
 
+Inflator::Inflator(int window_bits) : window_bits_(window_bits) {}
+
+Inflator::~Inflator() {
+  if (zs_ != nullptr) {
+    inflateEnd(zs_.get());
+  }
+}
+
+Status Inflator::Init() {
+  if (zs_ != nullptr) {
+    return Status::OK();
+  }
+  auto zs = std::make_unique<z_stream>();
+  *zs = {};
+  if (inflateInit2(zs.get(), window_bits_) != Z_OK) {
+    return error::Internal("inflateInit2 failed while decompressing.");
+  }
+  zs_ = std::move(zs);
+  return Status::OK();
+}
+
+Status Inflator::Reset() {
+  if (zs_ == nullptr) {
+    return Init();
+  }
+  if (inflateReset(zs_.get()) != Z_OK) {
+    return error::Internal("inflateReset failed: $0", zs_->msg);
+  }
+  return Status::OK();
+}
+
+StatusOr<DecompressState> Inflator::Inflate(std::string_view in, std::string* out,
+                                            size_t max_output_bytes) {
+  PL_RETURN_IF_ERROR(Init());
+
+  zs_->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+  zs_->avail_in = in.size();
+
+  while (true) {
+    if (out->size() >= max_output_bytes) {
+      return DecompressState::kOutputFull;
+    }
+
+    size_t old_size = out->size();
+    size_t block_size = std::min(kOutputBlockSize, max_output_bytes - old_size);
+    out->resize(old_size + block_size);
+    zs_->next_out = reinterpret_cast<Bytef*>(out->data() + old_size);
+    zs_->avail_out = block_size;
+
+    int ret = inflate(zs_.get(), Z_NO_FLUSH);
+    out->resize(old_size + (block_size - zs_->avail_out));
+
+    if (ret == Z_STREAM_END) {
+      return DecompressState::kStreamEnd;
+    }
+    // Z_BUF_ERROR means no progress was possible (e.g. an empty chunk); it is not fatal.
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      return error::Internal("Exception during zlib decompression: $0", zs_->msg);
+    }
+    if (zs_->avail_in == 0 && zs_->avail_out != 0) {
+      return DecompressState::kNeedsMoreInput;
+    }
+  }
+}
+
 }  // namespace zlib
 }  // namespace px
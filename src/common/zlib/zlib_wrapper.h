@@ -18,9 +18,14 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
+#include "src/common/base/mixins.h"
 #include "src/common/base/statusor.h"
+#include "src/common/zlib/decompress_state.h"
+
+struct z_stream_s;
 
 namespace px {
 namespace zlib {
@@ -35,5 +40,44 @@ namespace zlib {
  */
 StatusOr<std::string> Inflate(std::string_view in, size_t output_block_size = 16384);
 
+/**
+ * Inflator incrementally decompresses a gzip/zlib stream fed in chunks.
+ *
+ * Unlike Inflate() above, the caller bounds the output size, so a prefix of a large body can be
+ * decompressed without allocating space for the full decompressed size. The underlying zlib
+ * context is reusable across streams via Reset(), which is much cheaper than constructing a new
+ * Inflator per stream.
+ */
+class Inflator : public NotCopyable {
+ public:
+  // Auto-detect gzip or zlib headers, with the maximum 32KiB window.
+  // The low 4 bits (8 to 15) cap the history window the stream may require; streams compressed
+  // with a larger window fail to decompress rather than forcing a larger allocation.
+  static constexpr int kDefaultWindowBits = 15 + 32;
+
+  explicit Inflator(int window_bits = kDefaultWindowBits);
+  ~Inflator();
+
+  /**
+   * Decompresses a chunk of the stream, appending to out.
+   *
+   * Stops once out->size() reaches max_output_bytes, in which case any unconsumed input is
+   * discarded and the Inflator must be Reset() before decompressing a new stream.
+   */
+  StatusOr<DecompressState> Inflate(std::string_view in, std::string* out, size_t max_output_bytes);
+
+  /**
+   * Resets the context so a new stream can be decompressed. Retains the window setting.
+   */
+  Status Reset();
+
+ private:
+  // Initializes the zlib context on first use, so construction cannot fail.
+  Status Init();
+
+  int window_bits_;
+  std::unique_ptr<z_stream_s> zs_;
+};
+
 }  // namespace zlib
 }  // namespace px
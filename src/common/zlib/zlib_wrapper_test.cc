@@ -46,4 +46,48 @@ TEST_F(ZlibTest, inflate_test) {
   EXPECT_OK_AND_EQ(result, GetExpectedResult());
 }
 
+TEST_F(ZlibTest, inflator_chunked_test) {
+  std::string compressed = GetCompressedString();
+
+  zlib::Inflator inflator;
+  std::string out;
+
+  // Feed the input a few bytes at a time, as the http parser would for a body spread across
+  // multiple events.
+  constexpr size_t kChunkSize = 4;
+  for (size_t pos = 0; pos < compressed.size(); pos += kChunkSize) {
+    std::string_view chunk = std::string_view(compressed).substr(pos, kChunkSize);
+    ASSERT_OK_AND_ASSIGN(DecompressState state, inflator.Inflate(chunk, &out, 1024));
+    if (pos + kChunkSize < compressed.size()) {
+      EXPECT_EQ(state, DecompressState::kNeedsMoreInput);
+    } else {
+      EXPECT_EQ(state, DecompressState::kStreamEnd);
+    }
+  }
+  EXPECT_EQ(out, GetExpectedResult());
+
+  // The context is reusable across streams after a Reset().
+  EXPECT_OK(inflator.Reset());
+  out.clear();
+  ASSERT_OK_AND_ASSIGN(DecompressState state, inflator.Inflate(compressed, &out, 1024));
+  EXPECT_EQ(state, DecompressState::kStreamEnd);
+  EXPECT_EQ(out, GetExpectedResult());
+}
+
+TEST_F(ZlibTest, inflator_output_limit_test) {
+  zlib::Inflator inflator;
+  std::string out;
+
+  // Only the first 4 decompressed bytes are requested; the rest of the body is not materialized.
+  ASSERT_OK_AND_ASSIGN(DecompressState state, inflator.Inflate(GetCompressedString(), &out, 4));
+  EXPECT_EQ(state, DecompressState::kOutputFull);
+  EXPECT_EQ(out, GetExpectedResult().substr(0, 4));
+}
+
+TEST_F(ZlibTest, inflator_corrupt_input_test) {
+  zlib::Inflator inflator;
+  std::string out;
+  EXPECT_NOT_OK(inflator.Inflate("not a gzip stream", &out, 1024));
+}
+
 }  // namespace px
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zstd.h>
+#include <algorithm>
+#include <string>
+
+#include "src/common/base/base.h"
+#include "src/common/zlib/zstd_wrapper.h"
+
+namespace px {
+namespace zstd {
+
+StatusOr<std::string> Decompress(std::string_view in, size_t output_block_size) {
+  ZSTD_DCtx* ctx = ZSTD_createDCtx();
+  if (ctx == nullptr) {
+    return error::Internal("ZSTD_createDCtx failed while decompressing.");
+  }
+
+  ZSTD_inBuffer input = {in.data(), in.size(), 0};
+
+  std::string out;
+  size_t ret = 0;
+
+  // Get the decompressed bytes blockwise using repeated calls to ZSTD_decompressStream.
+  do {
+    size_t old_size = out.size();
+    out.resize(old_size + output_block_size);
+    ZSTD_outBuffer output = {out.data() + old_size, output_block_size, 0};
+
+    ret = ZSTD_decompressStream(ctx, &output, &input);
+    out.resize(old_size + output.pos);
+
+    if (ZSTD_isError(ret)) {
+      ZSTD_freeDCtx(ctx);
+      return error::Internal("Exception during zstd decompression: $0", ZSTD_getErrorName(ret));
+    }
+  } while (input.pos < input.size);
+
+  ZSTD_freeDCtx(ctx);
+
+  if (ret != 0) {
+    // All input was consumed, but the frame is incomplete.
+    return error::Internal("Exception during zstd decompression: truncated frame.");
+  }
+
+  return out;
+}
+
+StatusOr<std::string> Compress(std::string_view in, int compression_level) {
+  std::string out;
+  out.resize(ZSTD_compressBound(in.size()));
+  size_t ret =
+      ZSTD_compress(out.data(), out.size(), in.data(), in.size(), compression_level);
+  if (ZSTD_isError(ret)) {
+    return error::Internal("Exception during zstd compression: $0", ZSTD_getErrorName(ret));
+  }
+  out.resize(ret);
+  return out;
+}
+
+Decompressor::Decompressor(int window_log_max) : window_log_max_(window_log_max) {}
+
+Decompressor::~Decompressor() {
+  if (ctx_ != nullptr) {
+    ZSTD_freeDCtx(ctx_);
+  }
+}
+
+Status Decompressor::Init() {
+  if (ctx_ != nullptr) {
+    return Status::OK();
+  }
+  ZSTD_DCtx* ctx = ZSTD_createDCtx();
+  if (ctx == nullptr) {
+    return error::Internal("ZSTD_createDCtx failed while decompressing.");
+  }
+  if (window_log_max_ > 0) {
+    size_t ret = ZSTD_DCtx_setParameter(ctx, ZSTD_d_windowLogMax, window_log_max_);
+    if (ZSTD_isError(ret)) {
+      ZSTD_freeDCtx(ctx);
+      return error::Internal("Failed to set zstd window limit: $0", ZSTD_getErrorName(ret));
+    }
+  }
+  ctx_ = ctx;
+  return Status::OK();
+}
+
+Status Decompressor::Reset() {
+  if (ctx_ == nullptr) {
+    return Init();
+  }
+  // Resets the session only, so the window limit set at Init() is retained.
+  size_t ret = ZSTD_DCtx_reset(ctx_, ZSTD_reset_session_only);
+  if (ZSTD_isError(ret)) {
+    return error::Internal("ZSTD_DCtx_reset failed: $0", ZSTD_getErrorName(ret));
+  }
+  return Status::OK();
+}
+
+StatusOr<DecompressState> Decompressor::Decompress(std::string_view in, std::string* out,
+                                                   size_t max_output_bytes) {
+  PL_RETURN_IF_ERROR(Init());
+
+  constexpr size_t kOutputBlockSize = 16384;
+
+  ZSTD_inBuffer input = {in.data(), in.size(), 0};
+
+  while (true) {
+    if (out->size() >= max_output_bytes) {
+      return DecompressState::kOutputFull;
+    }
+
+    size_t old_size = out->size();
+    size_t block_size = std::min(kOutputBlockSize, max_output_bytes - old_size);
+    out->resize(old_size + block_size);
+    ZSTD_outBuffer output = {out->data() + old_size, block_size, 0};
+
+    size_t ret = ZSTD_decompressStream(ctx_, &output, &input);
+    out->resize(old_size + output.pos);
+
+    if (ZSTD_isError(ret)) {
+      return error::Internal("Exception during zstd decompression: $0", ZSTD_getErrorName(ret));
+    }
+    if (ret == 0) {
+      return DecompressState::kStreamEnd;
+    }
+    if (input.pos == input.size && output.pos < output.size) {
+      return DecompressState::kNeedsMoreInput;
+    }
+  }
+}
+
+}  // namespace zstd
+}  // namespace px
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+
+#include "src/common/base/mixins.h"
+#include "src/common/base/statusor.h"
+#include "src/common/zlib/decompress_state.h"
+
+// Avoids pulling <zstd.h> into every includer; matches zstd.h's own typedef.
+struct ZSTD_DCtx_s;
+
+namespace px {
+namespace zstd {
+
+/**
+ * @brief Decompresses a zstd frame and returns the decompressed content as a string.
+ *
+ * @param in A view into the source buffer.
+ * @param output_block_size How many bytes to decompress into the output buffer at a time.
+ *        For small strings, best to keep this only slightly larger than the expected output size.
+ * @return Status or the decompressed content as a string.
+ */
+StatusOr<std::string> Decompress(std::string_view in, size_t output_block_size = 16384);
+
+/**
+ * @brief Compresses the input into a single zstd frame.
+ *
+ * @param in A view into the source buffer.
+ * @param compression_level zstd compression level; 1 (the default) favors throughput, which is
+ *        what the bulk data paths using this helper care about.
+ * @return Status or the compressed frame as a string.
+ */
+StatusOr<std::string> Compress(std::string_view in, int compression_level = 1);
+
+/**
+ * Decompressor incrementally decompresses a zstd frame fed in chunks.
+ *
+ * Unlike Decompress() above, the caller bounds the output size, so a prefix of a large body can
+ * be decompressed without allocating space for the full decompressed size. The underlying zstd
+ * context is reusable across frames via Reset(), which is much cheaper than constructing a new
+ * Decompressor per frame.
+ */
+class Decompressor : public NotCopyable {
+ public:
+  /**
+   * @param window_log_max Caps the log2 of the window the frame may require; frames compressed
+   *        with a larger window fail to decompress rather than forcing a larger allocation.
+   *        0 uses libzstd's default limit.
+   */
+  explicit Decompressor(int window_log_max = 0);
+  ~Decompressor();
+
+  /**
+   * Decompresses a chunk of the frame, appending to out.
+   *
+   * Stops once out->size() reaches max_output_bytes, in which case any unconsumed input is
+   * discarded and the Decompressor must be Reset() before decompressing a new frame.
+   */
+  StatusOr<DecompressState> Decompress(std::string_view in, std::string* out,
+                                       size_t max_output_bytes);
+
+  /**
+   * Resets the context so a new frame can be decompressed. Retains the window limit.
+   */
+  Status Reset();
+
+ private:
+  // Initializes the zstd context on first use, so construction cannot fail.
+  Status Init();
+
+  int window_log_max_;
+  ZSTD_DCtx_s* ctx_ = nullptr;
+};
+
+}  // namespace zstd
+}  // namespace px
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/common/zlib/zstd_wrapper.h"
+#include <string>
+
+#include <absl/strings/str_cat.h>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+
+class ZstdTest : public ::testing::Test {
+ private:
+  // zstd-compressed "This is a test\n".
+  inline static const uint8_t compressed_str_bytes_[] = {
+      0x28, 0xb5, 0x2f, 0xfd, 0x04, 0x58, 0x79, 0x00, 0x00, 0x54,
+      0x68, 0x69, 0x73, 0x20, 0x69, 0x73, 0x20, 0x61, 0x20, 0x74,
+      0x65, 0x73, 0x74, 0x0a, 0x89, 0x48, 0x23, 0xce};
+
+  // zstd-compressed "pixie" repeated 200 times (1000 bytes decompressed).
+  inline static const uint8_t compressed_repeated_str_bytes_[] = {
+      0x28, 0xb5, 0x2f, 0xfd, 0x04, 0x58, 0x65, 0x00, 0x00, 0x28, 0x70, 0x69,
+      0x78, 0x69, 0x65, 0x01, 0x00, 0xe0, 0x51, 0x15, 0x2d, 0x94, 0xef, 0xfb,
+      0xf8};
+
+  inline static const std::string expected_result_ = "This is a test\n";
+
+ public:
+  std::string GetCompressedString() {
+    return std::string(reinterpret_cast<const char*>(compressed_str_bytes_),
+                       sizeof(compressed_str_bytes_));
+  }
+
+  std::string GetCompressedRepeatedString() {
+    return std::string(reinterpret_cast<const char*>(compressed_repeated_str_bytes_),
+                       sizeof(compressed_repeated_str_bytes_));
+  }
+
+  std::string GetExpectedResult() { return expected_result_; }
+
+  std::string GetExpectedRepeatedResult() {
+    std::string out;
+    for (int i = 0; i < 200; ++i) {
+      absl::StrAppend(&out, "pixie");
+    }
+    return out;
+  }
+};
+
+TEST_F(ZstdTest, decompress_test) {
+  auto result = px::zstd::Decompress(GetCompressedString());
+  EXPECT_OK_AND_EQ(result, GetExpectedResult());
+}
+
+TEST_F(ZstdTest, compress_round_trip_test) {
+  const std::string original(10000, 'a');
+  ASSERT_OK_AND_ASSIGN(std::string compressed, px::zstd::Compress(original));
+  EXPECT_LT(compressed.size(), original.size());
+  EXPECT_OK_AND_EQ(px::zstd::Decompress(compressed), original);
+}
+
+TEST_F(ZstdTest, decompress_corrupt_input_test) {
+  EXPECT_NOT_OK(px::zstd::Decompress("not a zstd frame"));
+}
+
+TEST_F(ZstdTest, decompress_truncated_input_test) {
+  std::string compressed = GetCompressedString();
+  EXPECT_NOT_OK(px::zstd::Decompress(compressed.substr(0, compressed.size() - 4)));
+}
+
+TEST_F(ZstdTest, decompressor_chunked_test) {
+  std::string compressed = GetCompressedString();
+
+  zstd::Decompressor decompressor;
+  std::string out;
+
+  // Feed the input a few bytes at a time, as the http parser would for a body spread across
+  // multiple events.
+  constexpr size_t kChunkSize = 4;
+  for (size_t pos = 0; pos < compressed.size(); pos += kChunkSize) {
+    std::string_view chunk = std::string_view(compressed).substr(pos, kChunkSize);
+    ASSERT_OK_AND_ASSIGN(DecompressState state, decompressor.Decompress(chunk, &out, 1024));
+    if (pos + kChunkSize < compressed.size()) {
+      EXPECT_EQ(state, DecompressState::kNeedsMoreInput);
+    } else {
+      EXPECT_EQ(state, DecompressState::kStreamEnd);
+    }
+  }
+  EXPECT_EQ(out, GetExpectedResult());
+
+  // The context is reusable across frames after a Reset().
+  EXPECT_OK(decompressor.Reset());
+  out.clear();
+  ASSERT_OK_AND_ASSIGN(DecompressState state, decompressor.Decompress(compressed, &out, 1024));
+  EXPECT_EQ(state, DecompressState::kStreamEnd);
+  EXPECT_EQ(out, GetExpectedResult());
+}
+
+TEST_F(ZstdTest, decompressor_output_limit_test) {
+  zstd::Decompressor decompressor;
+  std::string out;
+
+  // Only the first 100 decompressed bytes of the 1000-byte body are requested; the rest is not
+  // materialized.
+  ASSERT_OK_AND_ASSIGN(DecompressState state,
+                       decompressor.Decompress(GetCompressedRepeatedString(), &out, 100));
+  EXPECT_EQ(state, DecompressState::kOutputFull);
+  EXPECT_EQ(out, GetExpectedRepeatedResult().substr(0, 100));
+}
+
+TEST_F(ZstdTest, decompressor_window_limit_test) {
+  // The test frame declares a 2MiB (2^21) window, so a tighter limit rejects it instead of
+  // allocating that much memory.
+  {
+    zstd::Decompressor decompressor(/* window_log_max */ 10);
+    std::string out;
+    EXPECT_NOT_OK(decompressor.Decompress(GetCompressedString(), &out, 1024));
+  }
+
+  // A limit that accommodates the declared window decompresses normally.
+  {
+    zstd::Decompressor decompressor(/* window_log_max */ 21);
+    std::string out;
+    ASSERT_OK_AND_ASSIGN(DecompressState state,
+                         decompressor.Decompress(GetCompressedString(), &out, 1024));
+    EXPECT_EQ(state, DecompressState::kStreamEnd);
+    EXPECT_EQ(out, GetExpectedResult());
+  }
+}
+
+}  // namespace px
@@ -0,0 +1,269 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package main
+
+import (
+	"context"
+	"crypto/tls"
+	"fmt"
+	"io"
+	"os"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"google.golang.org/grpc"
+	"google.golang.org/grpc/credentials"
+	"google.golang.org/grpc/credentials/insecure"
+
+	"px.dev/pixie/src/e2e_test/protocol_loadtest/grpc/loadtestpb"
+	"px.dev/pixie/src/e2e_test/util"
+)
+
+// A gRPC (http/2) traffic generator for the protocol load test server.
+//
+// The generator runs a load profile: a sequence of phases, each holding a target request rate
+// for a fixed duration. The profile repeats until the process is killed, mirroring the wrk
+// client used for HTTP load. Cumulative request counts are printed as JSON lines, so the
+// perf harness can compare what was sent against what the tracer captured.
+
+type phase struct {
+	rps      int
+	duration time.Duration
+}
+
+type stats struct {
+	unarySent    int64
+	streamsSent  int64
+	errors       int64
+	bytesWritten int64
+}
+
+func envOr(name, defaultVal string) string {
+	if val := os.Getenv(name); val != "" {
+		return val
+	}
+	return defaultVal
+}
+
+func envIntOr(name string, defaultVal int) int {
+	val := os.Getenv(name)
+	if val == "" {
+		return defaultVal
+	}
+	intVal, err := strconv.Atoi(val)
+	if err != nil {
+		panic(fmt.Errorf("invalid value for %s: %v", name, err))
+	}
+	return intVal
+}
+
+// parseProfile parses a load profile of the form "<rps>:<duration>[,<rps>:<duration>...]",
+// for example "100:1m,1000:30s,100:1m".
+func parseProfile(profile string) ([]phase, error) {
+	var phases []phase
+	for _, phaseStr := range strings.Split(profile, ",") {
+		parts := strings.Split(phaseStr, ":")
+		if len(parts) != 2 {
+			return nil, fmt.Errorf("invalid phase %q, expected <rps>:<duration>", phaseStr)
+		}
+		rps, err := strconv.Atoi(parts[0])
+		if err != nil {
+			return nil, fmt.Errorf("invalid rps in phase %q: %v", phaseStr, err)
+		}
+		duration, err := time.ParseDuration(parts[1])
+		if err != nil {
+			return nil, fmt.Errorf("invalid duration in phase %q: %v", phaseStr, err)
+		}
+		phases = append(phases, phase{rps: rps, duration: duration})
+	}
+	return phases, nil
+}
+
+type generator struct {
+	clients      []loadtestpb.LoadTesterClient
+	payloadBytes int
+	streamPeriod int
+	streamLen    int
+	requestSeq   int64
+	stats        stats
+}
+
+func (g *generator) client(seq int64) loadtestpb.LoadTesterClient {
+	return g.clients[int(seq)%len(g.clients)]
+}
+
+func (g *generator) sendUnary(ctx context.Context, seq int64) {
+	_, err := g.client(seq).Unary(ctx, &loadtestpb.UnaryRequest{
+		SeqId:          seq,
+		Payload:        string(util.RandPrintable(g.payloadBytes)),
+		BytesRequested: int32(g.payloadBytes),
+	})
+	if err != nil {
+		atomic.AddInt64(&g.stats.errors, 1)
+		return
+	}
+	atomic.AddInt64(&g.stats.unarySent, 1)
+	atomic.AddInt64(&g.stats.bytesWritten, int64(g.payloadBytes))
+}
+
+func (g *generator) sendBidirStream(ctx context.Context, seq int64) {
+	stream, err := g.client(seq).BidirectionalStreaming(ctx)
+	if err != nil {
+		atomic.AddInt64(&g.stats.errors, 1)
+		return
+	}
+	for i := 0; i < g.streamLen; i++ {
+		err = stream.Send(&loadtestpb.BidirectionalStreamingRequest{
+			SeqId:             seq,
+			StreamSeqIdClient: int64(i),
+			Payload:           string(util.RandPrintable(g.payloadBytes)),
+			BytesRequested:    int32(g.payloadBytes),
+		})
+		if err != nil {
+			atomic.AddInt64(&g.stats.errors, 1)
+			return
+		}
+		_, err = stream.Recv()
+		if err != nil {
+			atomic.AddInt64(&g.stats.errors, 1)
+			return
+		}
+		atomic.AddInt64(&g.stats.bytesWritten, int64(g.payloadBytes))
+	}
+	if err := stream.CloseSend(); err != nil {
+		atomic.AddInt64(&g.stats.errors, 1)
+		return
+	}
+	// Drain until the server closes its side of the stream.
+	for {
+		if _, err := stream.Recv(); err != nil {
+			if err != io.EOF {
+				atomic.AddInt64(&g.stats.errors, 1)
+			}
+			break
+		}
+	}
+	atomic.AddInt64(&g.stats.streamsSent, 1)
+}
+
+func (g *generator) send(ctx context.Context) {
+	seq := atomic.AddInt64(&g.requestSeq, 1)
+	if g.streamPeriod > 0 && seq%int64(g.streamPeriod) == 0 {
+		g.sendBidirStream(ctx, seq)
+		return
+	}
+	g.sendUnary(ctx, seq)
+}
+
+// runPhase generates load at the phase's target rate by pacing each worker at an equal share
+// of the total rate.
+func (g *generator) runPhase(p phase, numWorkers int) {
+	// A zero-rate phase is an idle period in the profile.
+	if p.rps <= 0 {
+		time.Sleep(p.duration)
+		return
+	}
+
+	var wg sync.WaitGroup
+	ctx, cancel := context.WithCancel(context.Background())
+	defer cancel()
+
+	for w := 0; w < numWorkers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			interval := time.Duration(int64(time.Second) * int64(numWorkers) / int64(p.rps))
+			ticker := time.NewTicker(interval)
+			defer ticker.Stop()
+			deadline := time.After(p.duration)
+			for {
+				select {
+				case <-ticker.C:
+					g.send(ctx)
+				case <-deadline:
+					return
+				}
+			}
+		}()
+	}
+	wg.Wait()
+}
+
+func (g *generator) reportStats() {
+	for range time.Tick(10 * time.Second) {
+		fmt.Printf(
+			`{"time": %q, "unary_sent": %d, "streams_sent": %d, "errors": %d, "bytes_written": %d}`+"\n",
+			time.Now().Format(time.RFC3339),
+			atomic.LoadInt64(&g.stats.unarySent),
+			atomic.LoadInt64(&g.stats.streamsSent),
+			atomic.LoadInt64(&g.stats.errors),
+			atomic.LoadInt64(&g.stats.bytesWritten))
+	}
+}
+
+func main() {
+	addr := fmt.Sprintf("%s:%s", envOr("SERVICE_NAME", "localhost"), envOr("SERVICE_PORT", "9080"))
+	numConnections := envIntOr("NUM_CONNECTIONS", 4)
+	payloadBytes := envIntOr("PAYLOAD_BYTES", 1024)
+	// Every Nth request is sent as a bidirectional stream instead of a unary call.
+	// 0 disables streaming.
+	streamPeriod := envIntOr("STREAM_PERIOD", 10)
+	streamLen := envIntOr("STREAM_NUM_MESSAGES", 5)
+
+	phases, err := parseProfile(envOr("LOAD_PROFILE", "100:1m"))
+	if err != nil {
+		panic(err)
+	}
+
+	dialOpts := []grpc.DialOption{grpc.WithBlock()}
+	if envOr("USE_TLS", "") == "true" {
+		// The load test server uses a self-signed certificate.
+		tlsConfig := &tls.Config{InsecureSkipVerify: true, NextProtos: []string{"h2"}}
+		dialOpts = append(dialOpts, grpc.WithTransportCredentials(credentials.NewTLS(tlsConfig)))
+	} else {
+		dialOpts = append(dialOpts, grpc.WithTransportCredentials(insecure.NewCredentials()))
+	}
+
+	g := &generator{
+		payloadBytes: payloadBytes,
+		streamPeriod: streamPeriod,
+		streamLen:    streamLen,
+	}
+	for i := 0; i < numConnections; i++ {
+		conn, err := grpc.Dial(addr, dialOpts...)
+		if err != nil {
+			panic(fmt.Errorf("failed to dial %s: %v", addr, err))
+		}
+		defer conn.Close()
+		g.clients = append(g.clients, loadtestpb.NewLoadTesterClient(conn))
+	}
+
+	go g.reportStats()
+
+	fmt.Printf("Generating gRPC load against %s\n", addr)
+	for {
+		for _, p := range phases {
+			fmt.Printf("Starting phase: %d rps for %v\n", p.rps, p.duration)
+			g.runPhase(p, numConnections)
+		}
+	}
+}
@@ -0,0 +1,106 @@
+# Copyright 2018- The Pixie Authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Compares the metrics of two load test runs and prints a markdown report.
+
+Input files are the metrics.json files produced by run_profile.sh (the JSON output of
+`px run -f collect_metrics.pxl -o json`). Typical use is comparing a baseline PEM build
+against an upgrade candidate running the same profile:
+
+    python3 compare_reports.py baseline/metrics.json candidate/metrics.json
+"""
+
+import argparse
+import collections
+import json
+
+
+def load_metrics(path):
+    """Loads `px run -o json` output: one JSON row per line, tagged with its table name."""
+    tables = collections.defaultdict(list)
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            row = json.loads(line)
+            table = row.pop('_tableName_', 'unknown')
+            tables[table].append(row)
+    return tables
+
+
+def numeric_summary(rows):
+    """Returns {column: (sum, max)} over the numeric columns of a table."""
+    summary = {}
+    for row in rows:
+        for col, val in row.items():
+            if isinstance(val, bool) or not isinstance(val, (int, float)):
+                continue
+            total, maximum = summary.get(col, (0, float('-inf')))
+            summary[col] = (total + val, max(maximum, val))
+    return summary
+
+
+def fmt(val):
+    if isinstance(val, float):
+        return f'{val:.2f}'
+    return str(val)
+
+
+def delta_pct(baseline, candidate):
+    if baseline == 0:
+        return 'n/a'
+    return f'{100.0 * (candidate - baseline) / baseline:+.1f}%'
+
+
+def print_table_comparison(table, baseline_rows, candidate_rows):
+    baseline_summary = numeric_summary(baseline_rows)
+    candidate_summary = numeric_summary(candidate_rows)
+
+    print(f'### {table}')
+    print()
+    print(f'Rows: baseline={len(baseline_rows)} candidate={len(candidate_rows)}')
+    print()
+    print('| metric | baseline | candidate | delta |')
+    print('| --- | --- | --- | --- |')
+    for col in sorted(set(baseline_summary) | set(candidate_summary)):
+        b_total, b_max = baseline_summary.get(col, (0, 0))
+        c_total, c_max = candidate_summary.get(col, (0, 0))
+        print(f'| {col} (sum) | {fmt(b_total)} | {fmt(c_total)} | {delta_pct(b_total, c_total)} |')
+        print(f'| {col} (max) | {fmt(b_max)} | {fmt(c_max)} | {delta_pct(b_max, c_max)} |')
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', help='metrics.json of the baseline run')
+    parser.add_argument('candidate', help='metrics.json of the candidate run')
+    args = parser.parse_args()
+
+    baseline = load_metrics(args.baseline)
+    candidate = load_metrics(args.candidate)
+
+    print('## Protocol load test comparison')
+    print()
+    print(f'Baseline: `{args.baseline}`')
+    print(f'Candidate: `{args.candidate}`')
+    print()
+    for table in sorted(set(baseline) | set(candidate)):
+        print_table_comparison(table, baseline.get(table, []), candidate.get(table, []))
+
+
+if __name__ == '__main__':
+    main()
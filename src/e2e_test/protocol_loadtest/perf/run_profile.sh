@@ -0,0 +1,104 @@
+#!/bin/bash
+
+# Copyright 2018- The Pixie Authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Runs one load profile against the current cluster and collects the qualification metrics.
+#
+# Pre-requisites:
+#   - Pixie is deployed on the cluster and `px` is authenticated.
+#   - The protocol load test server is deployed (see ../skaffold_loadtest.yaml), along with
+#     the generator images referenced by the enabled generators.
+#
+# Usage:
+#   ./run_profile.sh <profile.env> <output_dir>
+#
+# The profile is an env file (see profiles/) that selects the generators and their knobs.
+# Metrics are written as JSON to <output_dir>/metrics.json; compare two runs with
+# compare_reports.py to produce the upgrade qualification report.
+
+set -e
+
+script_dir="$(dirname "$0")"
+loadtest_dir="${script_dir}/.."
+
+usage() {
+  echo "Usage: $0 <profile.env> <output_dir>"
+  exit 1
+}
+
+if [ $# -ne 2 ]; then
+  usage
+fi
+
+profile="$1"
+output_dir="$2"
+
+# Profile knobs and their defaults.
+ENABLE_HTTP="false"
+ENABLE_GRPC="false"
+ENABLE_REDIS="false"
+ENABLE_KAFKA="false"
+DURATION_SECONDS=300
+COLLECT_WINDOW="-5m"
+
+# shellcheck source=/dev/null
+source "$profile"
+
+mkdir -p "$output_dir"
+cp "$profile" "$output_dir/profile.env"
+
+declare -a deployed_paths
+
+deploy_generator() {
+  path=$1
+  echo "Deploying $path"
+  kubectl apply -k "$path"
+  deployed_paths+=("$path")
+}
+
+cleanup() {
+  for path in "${deployed_paths[@]}"; do
+    kubectl delete -k "$path" --ignore-not-found=true
+  done
+}
+
+if [ "$ENABLE_HTTP" == "true" ]; then
+  deploy_generator "${loadtest_dir}/http/wrk/k8s"
+fi
+if [ "$ENABLE_GRPC" == "true" ]; then
+  deploy_generator "${loadtest_dir}/grpc/client/k8s"
+fi
+if [ "$ENABLE_REDIS" == "true" ]; then
+  deploy_generator "${loadtest_dir}/redis/k8s"
+fi
+if [ "$ENABLE_KAFKA" == "true" ]; then
+  deploy_generator "${loadtest_dir}/kafka/k8s"
+fi
+
+if [ "${KEEP_RUNNING:-false}" != "true" ]; then
+  trap cleanup EXIT
+fi
+
+echo "Generating load for ${DURATION_SECONDS}s"
+sleep "$DURATION_SECONDS"
+
+echo "Collecting metrics"
+sed "s/^start_time = .*/start_time = '${COLLECT_WINDOW}'/" "${script_dir}/collect_metrics.pxl" \
+  > "${output_dir}/collect_metrics.pxl"
+px run -f "${output_dir}/collect_metrics.pxl" -o json > "${output_dir}/metrics.json"
+
+echo "Metrics written to ${output_dir}/metrics.json"
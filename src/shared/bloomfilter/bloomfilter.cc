@@ -17,6 +17,7 @@
  */
 
 #include <math.h>
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -77,6 +78,18 @@ XXHash64BloomFilterPB XXHash64BloomFilter::ToProto() {
   return output;
 }
 
+Status XXHash64BloomFilter::Merge(const XXHash64BloomFilter& other) {
+  if (other.buffer_.size() != buffer_.size() || other.num_hashes_ != num_hashes_) {
+    return error::Internal(
+        "Cannot merge bloom filters with different parameters: $0 vs $1 bytes, $2 vs $3 hashes",
+        buffer_.size(), other.buffer_.size(), num_hashes_, other.num_hashes_);
+  }
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    buffer_[i] |= other.buffer_[i];
+  }
+  return Status::OK();
+}
+
 void XXHash64BloomFilter::SetBit(int bit_number) {
   int byte_index = bit_number >> 3;
   int mask = 1 << (bit_number % 8);
@@ -116,5 +129,37 @@ bool XXHash64BloomFilter::Contains(std::string_view item) const {
   return true;
 }
 
+void XXHash64BloomFilter::ContainsBatch8(const uint64_t* items, size_t count,
+                                         uint8_t* results) const {
+  constexpr size_t kChunkSize = 32;
+  uint64_t a[kChunkSize];
+  uint64_t b[kChunkSize];
+  const uint64_t num_bits = buffer_.size() << 3;
+
+  for (size_t base = 0; base < count; base += kChunkSize) {
+    const size_t n = std::min(kChunkSize, count - base);
+    // Hash the whole chunk and prefetch each item's first probe location, so the (likely
+    // uncached) buffer loads below are already in flight when they're needed.
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = XXH64(&items[base + i], sizeof(uint64_t), seed_);
+      b[i] = XXH64(&items[base + i], sizeof(uint64_t), a[i]);
+      __builtin_prefetch(&buffer_[(a[i] % num_bits) >> 3], /*rw*/ 0, /*locality*/ 1);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      bool present = true;
+      for (auto j = 0; j < num_hashes_; ++j) {
+        // Mirrors Contains(): the probe positions must match the single-item path exactly.
+        absl::uint128 x = a[i] + j * b[i];
+        int bit_number = static_cast<int>(x % num_bits);
+        if (!HasBitSet(bit_number)) {
+          present = false;
+          break;
+        }
+      }
+      results[base + i] = present;
+    }
+  }
+}
+
 }  // namespace bloomfilter
 }  // namespace px
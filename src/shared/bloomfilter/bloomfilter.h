@@ -55,6 +55,31 @@ class XXHash64BloomFilter {
   bool Contains(std::string_view item) const;
   bool Contains(const std::string& item) const { return Contains(std::string_view(item)); }
 
+  /**
+   * Convenience overloads for fixed 8-byte items (e.g. precomputed key hashes). Equivalent to
+   * Insert/Contains on the item's 8-byte in-memory representation.
+   */
+  void Insert(uint64_t item) {
+    Insert(std::string_view(reinterpret_cast<const char*>(&item), sizeof(item)));
+  }
+  bool Contains(uint64_t item) const {
+    return Contains(std::string_view(reinterpret_cast<const char*>(&item), sizeof(item)));
+  }
+
+  /**
+   * Batched membership test for fixed 8-byte items. Hashes a chunk of items and prefetches
+   * their probe locations before testing, so the dependent memory loads of many lookups
+   * overlap instead of serializing. Sets results[i] nonzero iff Contains(items[i]).
+   */
+  void ContainsBatch8(const uint64_t* items, size_t count, uint8_t* results) const;
+
+  /**
+   * Merge ORs another bloom filter into this one, so that this filter contains the union of both
+   * filters' items. The other filter must have been created with the same parameters (buffer
+   * size and number of hashes); otherwise an error is returned and this filter is unchanged.
+   */
+  Status Merge(const XXHash64BloomFilter& other);
+
   /**
    * Get the buffer size in bytes of the bloom filter.
    */
@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 
+#include "src/common/testing/testing.h"
 #include "src/shared/bloomfilter/bloomfilter.h"
 
 namespace px {
@@ -61,6 +62,24 @@ TEST(XXHash64BloomFilter, test_string) {
   EXPECT_FALSE(bf1->Contains(std::string("")));
 }
 
+TEST(XXHash64BloomFilter, test_merge) {
+  auto bf1 = XXHash64BloomFilter::Create(100, 0.01).ConsumeValueOrDie();
+  auto bf2 = XXHash64BloomFilter::Create(100, 0.01).ConsumeValueOrDie();
+  bf1->Insert("foo");
+  bf2->Insert("bar");
+
+  EXPECT_OK(bf1->Merge(*bf2));
+  EXPECT_TRUE(bf1->Contains("foo"));
+  EXPECT_TRUE(bf1->Contains("bar"));
+  // The merged-in filter is unchanged.
+  EXPECT_FALSE(bf2->Contains("foo"));
+  EXPECT_TRUE(bf2->Contains("bar"));
+
+  // Filters created with different parameters cannot be merged.
+  auto bf3 = XXHash64BloomFilter::Create(1000, 0.01).ConsumeValueOrDie();
+  EXPECT_NOT_OK(bf1->Merge(*bf3));
+}
+
 TEST(XXHash64BloomFilter, test_error_rate) {
   auto high_fp_bf = XXHash64BloomFilter::Create(10, 0.5).ConsumeValueOrDie();
   auto low_fp_bf = XXHash64BloomFilter::Create(1000, 0.0001).ConsumeValueOrDie();
@@ -113,5 +132,41 @@ TEST(XXHash64BloomFilter, test_create_from_proto) {
   }
 }
 
+TEST(XXHash64BloomFilter, test_uint64_items) {
+  auto bf = XXHash64BloomFilter::Create(100, 0.01).ConsumeValueOrDie();
+  uint64_t present = 0x1234567890abcdefULL;
+  uint64_t absent = 0xfedcba0987654321ULL;
+  bf->Insert(present);
+  EXPECT_TRUE(bf->Contains(present));
+  EXPECT_FALSE(bf->Contains(absent));
+  // The uint64 overloads are equivalent to the 8-byte string_view representation.
+  EXPECT_TRUE(
+      bf->Contains(std::string_view(reinterpret_cast<const char*>(&present), sizeof(present))));
+}
+
+TEST(XXHash64BloomFilter, test_contains_batch8) {
+  auto bf = XXHash64BloomFilter::Create(1000, 0.01).ConsumeValueOrDie();
+  // More items than one prefetch chunk, to exercise the chunked loop.
+  constexpr size_t kNumItems = 100;
+  std::vector<uint64_t> items(kNumItems);
+  for (size_t i = 0; i < kNumItems; ++i) {
+    items[i] = i * 2654435761ULL;
+    if (i % 2 == 0) {
+      bf->Insert(items[i]);
+    }
+  }
+
+  std::vector<uint8_t> results(kNumItems);
+  bf->ContainsBatch8(items.data(), items.size(), results.data());
+  for (size_t i = 0; i < kNumItems; ++i) {
+    // The batched path must agree with the single-item path exactly (including any false
+    // positives).
+    EXPECT_EQ(bf->Contains(items[i]), results[i] != 0) << "item index " << i;
+    if (i % 2 == 0) {
+      EXPECT_NE(0, results[i]) << "item index " << i;
+    }
+  }
+}
+
 }  // namespace bloomfilter
 }  // namespace px
@@ -16,8 +16,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <algorithm>
-#include <fstream>
 #include <memory>
 #include <string>
 
@@ -29,6 +31,30 @@
 namespace px {
 namespace md {
 
+namespace {
+
+// Reads the full contents of an already-open procs file. The kernel regenerates the contents on
+// every read, so rewinding and re-reading a cached descriptor returns the current membership.
+StatusOr<std::string> ReadProcsFileFromFD(int fd) {
+  if (lseek(fd, 0, SEEK_SET) != 0) {
+    return error::NotFound("Failed to seek cgroup procs file [errno=$0]", errno);
+  }
+
+  std::string contents;
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(fd, buf, sizeof(buf))) > 0) {
+    contents.append(buf, n);
+  }
+  if (n < 0) {
+    // The cgroup behind this descriptor has likely been removed.
+    return error::NotFound("Failed to read cgroup procs file [errno=$0]", errno);
+  }
+  return contents;
+}
+
+}  // namespace
+
 CGroupMetadataReader::CGroupMetadataReader(const system::Config& cfg)
     : CGroupMetadataReader(cfg.sysfs_path().string()) {}
 
@@ -72,6 +98,40 @@ StatusOr<std::string> CGroupMetadataReader::PodPath(PodQOSClass qos_class, std::
   return error::Internal("No valid cgroup path resolver.");
 }
 
+StatusOr<std::string> CGroupMetadataReader::ReadProcsFileContents(
+    PodQOSClass qos_class, std::string_view pod_id, std::string_view container_id,
+    ContainerType container_type) const {
+  auto it = procs_file_handles_.find(container_id);
+  if (it != procs_file_handles_.end()) {
+    auto contents_or_s = ReadProcsFileFromFD(it->second.fd);
+    if (contents_or_s.ok()) {
+      it->second.used_since_sweep = true;
+      return contents_or_s;
+    }
+    // The cached descriptor went stale (e.g. the container restarted and its cgroup was
+    // recreated); drop it and fall through to re-resolve the path.
+    close(it->second.fd);
+    procs_file_handles_.erase(it);
+  }
+
+  PL_ASSIGN_OR_RETURN(std::string fpath, PodPath(qos_class, pod_id, container_id, container_type));
+
+  int fd = open(fpath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    // This might not be a real error since the pod could have disappeared.
+    return error::NotFound("Failed to open file $0", fpath);
+  }
+
+  auto contents_or_s = ReadProcsFileFromFD(fd);
+  if (!contents_or_s.ok()) {
+    close(fd);
+    return contents_or_s;
+  }
+
+  procs_file_handles_[container_id] = {fd, /* used_since_sweep */ true};
+  return contents_or_s;
+}
+
 Status CGroupMetadataReader::ReadPIDs(PodQOSClass qos_class, std::string_view pod_id,
                                       std::string_view container_id, ContainerType container_type,
                                       absl::flat_hash_set<uint32_t>* pid_set) const {
@@ -80,22 +140,16 @@ Status CGroupMetadataReader::ReadPIDs(PodQOSClass qos_class, std::string_view po
   // The container files need to be recursively read and the PIDs needs be merge across all
   // containers.
 
-  PL_ASSIGN_OR_RETURN(std::string fpath, PodPath(qos_class, pod_id, container_id, container_type));
+  PL_ASSIGN_OR_RETURN(std::string contents,
+                      ReadProcsFileContents(qos_class, pod_id, container_id, container_type));
 
-  std::ifstream ifs(fpath);
-  if (!ifs) {
-    // This might not be a real error since the pod could have disappeared.
-    return error::NotFound("Failed to open file $0", fpath);
-  }
-
-  std::string line;
-  while (std::getline(ifs, line)) {
+  for (std::string_view line : absl::StrSplit(contents, '\n')) {
     if (line.empty()) {
       continue;
     }
     int64_t pid;
     if (!absl::SimpleAtoi(line, &pid)) {
-      LOG(WARNING) << absl::Substitute("Failed to parse pid file: $0", fpath);
+      LOG(WARNING) << absl::Substitute("Failed to parse pid file for container: $0", container_id);
       continue;
     }
     pid_set->emplace(pid);
@@ -103,5 +157,23 @@ Status CGroupMetadataReader::ReadPIDs(PodQOSClass qos_class, std::string_view po
   return Status::OK();
 }
 
+void CGroupMetadataReader::ReleaseUnusedProcsFileHandles() {
+  for (auto it = procs_file_handles_.begin(); it != procs_file_handles_.end();) {
+    if (!it->second.used_since_sweep) {
+      close(it->second.fd);
+      procs_file_handles_.erase(it++);
+    } else {
+      it->second.used_since_sweep = false;
+      ++it;
+    }
+  }
+}
+
+CGroupMetadataReader::~CGroupMetadataReader() {
+  for (const auto& [container_id, handle] : procs_file_handles_) {
+    close(handle.fd);
+  }
+}
+
 }  // namespace md
 }  // namespace px
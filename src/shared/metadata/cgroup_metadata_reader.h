@@ -25,6 +25,8 @@
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "src/common/base/base.h"
 #include "src/common/system/system.h"
 #include "src/shared/metadata/cgroup_path_resolver.h"
@@ -40,7 +42,7 @@ namespace md {
 class CGroupMetadataReader : public NotCopyable {
  public:
   CGroupMetadataReader() = delete;
-  virtual ~CGroupMetadataReader() = default;
+  virtual ~CGroupMetadataReader();
 
   explicit CGroupMetadataReader(const system::Config& cfg);
   explicit CGroupMetadataReader(std::string sysfs_path);
@@ -55,12 +57,46 @@ class CGroupMetadataReader : public NotCopyable {
                           std::string_view container_id, ContainerType container_type,
                           absl::flat_hash_set<uint32_t>* pid_set) const;
 
+  /**
+   * Closes cached cgroup procs file handles that have not been read since the previous call.
+   *
+   * Intended to be called once per metadata refresh cycle, so that handles for containers that
+   * have died (and are therefore no longer read) are not held open indefinitely.
+   */
+  void ReleaseUnusedProcsFileHandles();
+
  private:
   StatusOr<std::string> PodPath(PodQOSClass qos_class, std::string_view pod_id,
                                 std::string_view container_id, ContainerType container_type) const;
 
+  StatusOr<std::string> ReadProcsFileContents(PodQOSClass qos_class, std::string_view pod_id,
+                                              std::string_view container_id,
+                                              ContainerType container_type) const;
+
   std::unique_ptr<LegacyCGroupPathResolver> legacy_path_resolver_;
   std::unique_ptr<CGroupPathResolver> path_resolver_;
+
+  struct ProcsFileHandle {
+    int fd = -1;
+    // Set on every successful read; cleared by ReleaseUnusedProcsFileHandles().
+    bool used_since_sweep = false;
+  };
+
+  /**
+   * Cached open file descriptors to the per-container cgroup procs files, keyed by container ID.
+   *
+   * The kernel regenerates the procs file contents on every read, so a descriptor can be reused
+   * across refresh cycles; this avoids re-resolving the cgroup path and re-walking it with open()
+   * for every container on every refresh. An entry is dropped when a read through it fails
+   * (e.g. the container's cgroup directory was removed).
+   *
+   * Note that inotify cannot be used to maintain this map incrementally: cgroupfs only generates
+   * events for cgroup directory creation/removal, not for procs file membership changes.
+   *
+   * This cache is the reason ReadPIDs is const but the reader is stateful; accesses are not
+   * synchronized, matching the single-threaded use of this class by the metadata state manager.
+   */
+  mutable absl::flat_hash_map<std::string, ProcsFileHandle> procs_file_handles_;
 };
 
 }  // namespace md
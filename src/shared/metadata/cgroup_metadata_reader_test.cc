@@ -43,5 +43,25 @@ TEST_F(CGroupMetadataReaderTest, read_pid_list) {
   EXPECT_THAT(pid_set, ::testing::UnorderedElementsAre(123, 456, 789));
 }
 
+TEST_F(CGroupMetadataReaderTest, read_pid_list_cached) {
+  // The first read populates the procs file handle cache; repeated reads go through the cached
+  // descriptor and must return the same results.
+  for (int i = 0; i < 3; ++i) {
+    absl::flat_hash_set<uint32_t> pid_set;
+    ASSERT_OK(md_reader_->ReadPIDs(PodQOSClass::kBestEffort, "abcd", "c123", ContainerType::kDocker,
+                                   &pid_set));
+    EXPECT_THAT(pid_set, ::testing::UnorderedElementsAre(123, 456, 789));
+  }
+
+  // Two sweeps without an intervening read evict the handle; reads still work afterwards.
+  md_reader_->ReleaseUnusedProcsFileHandles();
+  md_reader_->ReleaseUnusedProcsFileHandles();
+
+  absl::flat_hash_set<uint32_t> pid_set;
+  ASSERT_OK(md_reader_->ReadPIDs(PodQOSClass::kBestEffort, "abcd", "c123", ContainerType::kDocker,
+                                 &pid_set));
+  EXPECT_THAT(pid_set, ::testing::UnorderedElementsAre(123, 456, 789));
+}
+
 }  // namespace md
 }  // namespace px
@@ -70,7 +70,43 @@ MetadataInfo AgentMetadataFilter::ToProto() {
   return output;
 }
 
-void AgentMetadataFilterImpl::Insert(std::string_view val) { bloomfilter_->Insert(val); }
+void AgentMetadataFilterImpl::Insert(std::string_view val) {
+  if (capacity_ == 0) {
+    // Deserialized filter with unknown sizing parameters; insert without adaptive growth.
+    bloomfilter_->Insert(val);
+    return;
+  }
+
+  auto inserted = entities_.emplace(val).second;
+  if (!inserted) {
+    // Already present, so the bloom filter bits are already set.
+    return;
+  }
+
+  if (static_cast<int64_t>(entities_.size()) > capacity_) {
+    // The entity count outgrew the capacity the bloom filter was sized for. Double the capacity
+    // and rebuild from the tracked entities to restore the configured false positive rate.
+    // Doubling keeps the amortized rebuild cost constant per insertion.
+    capacity_ *= 2;
+    Rebuild();
+    return;
+  }
+
+  bloomfilter_->Insert(val);
+}
+
+void AgentMetadataFilterImpl::Rebuild() {
+  auto bf_or_s = XXHash64BloomFilter::Create(capacity_, error_rate_);
+  if (!bf_or_s.ok()) {
+    // Should be impossible for a capacity/error rate that was previously accepted by Create.
+    LOG(DFATAL) << absl::Substitute("Failed to grow metadata filter: $0", bf_or_s.msg());
+    return;
+  }
+  bloomfilter_ = bf_or_s.ConsumeValueOrDie();
+  for (const auto& entity : entities_) {
+    bloomfilter_->Insert(entity);
+  }
+}
 
 bool AgentMetadataFilterImpl::Contains(std::string_view val) const {
   return bloomfilter_->Contains(val);
@@ -103,13 +103,20 @@ class AgentMetadataFilter {
 
 /**
  * An implementation of AgentMetadataFilter backed by an XXHASH64-based bloom filter.
+ *
+ * Filters constructed with Create() size the bloom filter adaptively: max_entries is treated as
+ * the initial capacity, and when the number of distinct entities outgrows the current capacity,
+ * the capacity is doubled and the filter is rebuilt from the tracked entities so the configured
+ * false positive rate is preserved. Filters deserialized with FromProto() have unknown sizing
+ * parameters and do not grow.
  */
 class AgentMetadataFilterImpl : public AgentMetadataFilter {
  public:
   static StatusOr<std::unique_ptr<AgentMetadataFilter>> Create(
       int64_t max_entries, double error_rate, const absl::flat_hash_set<MetadataType>& types) {
     PL_ASSIGN_OR_RETURN(auto bf, XXHash64BloomFilter::Create(max_entries, error_rate));
-    return std::unique_ptr<AgentMetadataFilter>(new AgentMetadataFilterImpl(std::move(bf), types));
+    return std::unique_ptr<AgentMetadataFilter>(
+        new AgentMetadataFilterImpl(std::move(bf), types, max_entries, error_rate));
   }
 
   static StatusOr<std::unique_ptr<AgentMetadataFilter>> FromProto(const MetadataInfo& proto);
@@ -124,7 +131,29 @@ class AgentMetadataFilterImpl : public AgentMetadataFilter {
                           const absl::flat_hash_set<MetadataType>& types)
       : AgentMetadataFilter(types), bloomfilter_(std::move(bloomfilter)) {}
 
+  AgentMetadataFilterImpl(std::unique_ptr<XXHash64BloomFilter> bloomfilter,
+                          const absl::flat_hash_set<MetadataType>& types, int64_t capacity,
+                          double error_rate)
+      : AgentMetadataFilter(types),
+        bloomfilter_(std::move(bloomfilter)),
+        capacity_(capacity),
+        error_rate_(error_rate) {}
+
+  /**
+   * Recreates the bloom filter at the current capacity and re-inserts all tracked entities.
+   */
+  void Rebuild();
+
   std::unique_ptr<XXHash64BloomFilter> bloomfilter_;
+
+  /**
+   * The distinct entities inserted so far, tracked so the bloom filter can be rebuilt at a
+   * larger size when the entity count outgrows the capacity the filter was sized for.
+   * Empty for filters deserialized with FromProto (capacity_ == 0), which do not grow.
+   */
+  absl::flat_hash_set<std::string> entities_;
+  int64_t capacity_ = 0;
+  double error_rate_ = 0;
 };
 
 }  // namespace md
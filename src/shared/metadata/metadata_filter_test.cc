@@ -43,6 +43,28 @@ TEST(AgentMetadataFilter, test_basic) {
   EXPECT_NOT_OK(filter->InsertEntity(MetadataType::SERVICE_NAME, "abc"));
 }
 
+TEST(AgentMetadataFilter, test_adaptive_growth) {
+  // Start with a capacity of 2 and insert well past it; the filter should grow and keep
+  // answering without false negatives.
+  auto filter =
+      AgentMetadataFilter::Create(2, 0.01, {MetadataType::POD_NAME}).ConsumeValueOrDie();
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_OK(filter->InsertEntity(MetadataType::POD_NAME, absl::Substitute("pod$0", i)));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(filter->ContainsEntity(MetadataType::POD_NAME, absl::Substitute("pod$0", i)));
+  }
+  EXPECT_FALSE(filter->ContainsEntity(MetadataType::POD_NAME, "not_present"));
+
+  // The grown filter round-trips through the proto form.
+  auto deserialized = AgentMetadataFilter::FromProto(filter->ToProto()).ConsumeValueOrDie();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(
+        deserialized->ContainsEntity(MetadataType::POD_NAME, absl::Substitute("pod$0", i)));
+  }
+}
+
 TEST(AgentMetadataFilter, test_proto) {
   auto filter =
       AgentMetadataFilter::Create(100, 0.01, {MetadataType::POD_NAME, MetadataType::CONTAINER_ID})
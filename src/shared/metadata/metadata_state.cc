@@ -27,6 +27,21 @@
 namespace px {
 namespace md {
 
+namespace {
+
+// If the object in the given map slot is shared with other state snapshots, replaces it with a
+// private copy (copy-on-write). Returns a pointer through which the object may be mutated.
+// Objects referenced by a single snapshot are mutated in place.
+template <typename T>
+T* PrepareForWrite(std::shared_ptr<T>* ptr) {
+  if (ptr->use_count() > 1) {
+    *ptr = std::shared_ptr<T>((*ptr)->Clone());
+  }
+  return ptr->get();
+}
+
+}  // namespace
+
 const K8sMetadataObject* K8sMetadataState::K8sMetadataObjectByID(UIDView id,
                                                                  K8sObjectType type) const {
   auto it = k8s_objects_by_id_.find(id);
@@ -78,6 +93,16 @@ const ContainerInfo* K8sMetadataState::ContainerInfoByID(CIDView id) const {
   return it->second.get();
 }
 
+ContainerInfo* K8sMetadataState::MutableContainerInfoByID(CIDView id) {
+  auto it = containers_by_id_.find(id);
+
+  if (it == containers_by_id_.end()) {
+    return nullptr;
+  }
+
+  return PrepareForWrite(&it->second);
+}
+
 UID K8sMetadataState::PodIDByName(K8sNameIdentView pod_name) const {
   auto it = pods_by_name_.find(pod_name);
   return (it == pods_by_name_.end()) ? "" : it->second;
@@ -124,15 +149,11 @@ std::unique_ptr<K8sMetadataState> K8sMetadataState::Clone() const {
   other->pod_cidrs_ = pod_cidrs_;
   other->service_cidr_ = service_cidr_;
 
-  other->k8s_objects_by_id_.reserve(k8s_objects_by_id_.size());
-  for (const auto& [k, v] : k8s_objects_by_id_) {
-    other->k8s_objects_by_id_[k] = v->Clone();
-  }
-
-  other->containers_by_id_.reserve(containers_by_id_.size());
-  for (const auto& [k, v] : containers_by_id_) {
-    other->containers_by_id_[k] = v->Clone();
-  }
+  // The objects themselves are shared with the clone rather than deep-copied.
+  // An object is only copied once an update handler mutates it (see PrepareForWrite),
+  // so the clone cost scales with the update delta, not with the cluster size.
+  other->k8s_objects_by_id_ = k8s_objects_by_id_;
+  other->containers_by_id_ = containers_by_id_;
 
   other->pods_by_name_ = pods_by_name_;
   other->services_by_name_ = services_by_name_;
@@ -188,7 +209,7 @@ Status K8sMetadataState::HandlePodUpdate(const PodUpdate& update) {
     VLOG(1) << "Adding Pod: " << pod->DebugString();
     it = k8s_objects_by_id_.try_emplace(object_uid, std::move(pod)).first;
   }
-  auto pod_info = static_cast<PodInfo*>(it->second.get());
+  auto pod_info = static_cast<PodInfo*>(PrepareForWrite(&it->second));
 
   // We always just add to the container set even if the container is stopped.
   // We expect all cleanup to happen periodically to allow stale objects to be queried for some
@@ -206,7 +227,7 @@ Status K8sMetadataState::HandlePodUpdate(const PodUpdate& update) {
     }
 
     pod_info->AddContainer(cid);
-    containers_by_id_[cid]->set_pod_id(object_uid);
+    PrepareForWrite(&containers_by_id_[cid])->set_pod_id(object_uid);
   }
 
   for (const auto& owner_ref : update.owner_references()) {
@@ -244,7 +265,7 @@ Status K8sMetadataState::HandleContainerUpdate(const ContainerUpdate& update) {
   }
   VLOG(1) << "container update: " << update.name();
 
-  auto* container_info = it->second.get();
+  auto* container_info = PrepareForWrite(&it->second);
   container_info->set_stop_time_ns(update.stop_timestamp_ns());
   container_info->set_state(ConvertToContainerState(update.container_state()));
   container_info->set_state_message(update.message());
@@ -266,19 +287,20 @@ Status K8sMetadataState::HandleServiceUpdate(const ServiceUpdate& update) {
     VLOG(1) << "Adding Service: " << service->DebugString();
     it = k8s_objects_by_id_.try_emplace(service_uid, std::move(service)).first;
   }
-  auto service_info = static_cast<ServiceInfo*>(it->second.get());
+  auto service_info = static_cast<ServiceInfo*>(PrepareForWrite(&it->second));
 
   for (const auto& uid : update.pod_ids()) {
-    if (k8s_objects_by_id_.find(uid) == k8s_objects_by_id_.end()) {
+    auto pod_it = k8s_objects_by_id_.find(uid);
+    if (pod_it == k8s_objects_by_id_.end()) {
       // We should be resilient to the case where we happened to miss a pod update
       // in the stream of events. If we did miss a pod update, just skip adding the
       // pod to this particular service to avoid dangling references.
       LOG(INFO) << absl::Substitute("Didn't find pod UID $0 for service $1/$2", uid, ns, name);
       continue;
     }
-    ECHECK(k8s_objects_by_id_[uid]->type() == K8sObjectType::kPod);
+    ECHECK(pod_it->second->type() == K8sObjectType::kPod);
     // We add the service uid to the pod. Lifetime of service still handled by the service object.
-    PodInfo* pod_info = static_cast<PodInfo*>(k8s_objects_by_id_[uid].get());
+    PodInfo* pod_info = static_cast<PodInfo*>(PrepareForWrite(&pod_it->second));
     pod_info->AddService(service_uid);
   }
   if (update.start_timestamp_ns() != 0) {
@@ -313,7 +335,7 @@ Status K8sMetadataState::HandleNamespaceUpdate(const NamespaceUpdate& update) {
     VLOG(1) << "Adding Namespace: " << ns_obj->DebugString();
     it = k8s_objects_by_id_.try_emplace(namespace_uid, std::move(ns_obj)).first;
   }
-  auto ns_info = static_cast<NamespaceInfo*>(it->second.get());
+  auto ns_info = static_cast<NamespaceInfo*>(PrepareForWrite(&it->second));
 
   ns_info->set_start_time_ns(update.start_timestamp_ns());
   ns_info->set_stop_time_ns(update.stop_timestamp_ns());
@@ -342,7 +364,7 @@ Status K8sMetadataState::HandleReplicaSetUpdate(const ReplicaSetUpdate& update)
     VLOG(1) << "Adding ReplicaSet: " << replica_set->DebugString();
     it = k8s_objects_by_id_.try_emplace(replica_set_uid, std::move(replica_set)).first;
   }
-  auto replica_set_info = static_cast<ReplicaSetInfo*>(it->second.get());
+  auto replica_set_info = static_cast<ReplicaSetInfo*>(PrepareForWrite(&it->second));
 
   for (const auto& owner_ref : update.owner_references()) {
     replica_set_info->AddOwnerReference(owner_ref.uid(), owner_ref.name(), owner_ref.kind());
@@ -375,7 +397,7 @@ Status K8sMetadataState::HandleDeploymentUpdate(const DeploymentUpdate& update)
     VLOG(1) << "Adding Deployment: " << deployment->DebugString();
     it = k8s_objects_by_id_.try_emplace(deployment_uid, std::move(deployment)).first;
   }
-  auto deployment_info = static_cast<DeploymentInfo*>(it->second.get());
+  auto deployment_info = static_cast<DeploymentInfo*>(PrepareForWrite(&it->second));
 
   deployment_info->set_start_time_ns(update.start_timestamp_ns());
   deployment_info->set_stop_time_ns(update.stop_timestamp_ns());
@@ -478,6 +500,46 @@ std::shared_ptr<AgentMetadataState> AgentMetadataState::CloneToShared() const {
   return state;
 }
 
+const ContainerInfo* AgentMetadataState::ContainerInfoByUPID(UPID upid) const {
+  auto it = upid_index_.find(upid);
+  if (it != upid_index_.end()) {
+    return it->second.container_info;
+  }
+
+  // Fall back for states whose index has not (yet) been built.
+  const auto* pid_info = GetPIDByUPID(upid);
+  if (pid_info == nullptr) {
+    return nullptr;
+  }
+  return k8s_metadata_state_->ContainerInfoByID(pid_info->cid());
+}
+
+const PodInfo* AgentMetadataState::PodInfoByUPID(UPID upid) const {
+  auto it = upid_index_.find(upid);
+  if (it != upid_index_.end()) {
+    return it->second.pod_info;
+  }
+
+  const auto* container_info = ContainerInfoByUPID(upid);
+  if (container_info == nullptr) {
+    return nullptr;
+  }
+  return k8s_metadata_state_->PodInfoByID(container_info->pod_id());
+}
+
+void AgentMetadataState::BuildUPIDIndex() {
+  upid_index_.clear();
+  upid_index_.reserve(pids_by_upid_.size());
+  for (const auto& [upid, pid_info] : pids_by_upid_) {
+    const ContainerInfo* container_info = k8s_metadata_state_->ContainerInfoByID(pid_info->cid());
+    const PodInfo* pod_info = nullptr;
+    if (container_info != nullptr) {
+      pod_info = k8s_metadata_state_->PodInfoByID(container_info->pod_id());
+    }
+    upid_index_.try_emplace(upid, UPIDIndexEntry{container_info, pod_info});
+  }
+}
+
 std::string AgentMetadataState::DebugString(int indent_level) const {
   std::string str;
   std::string prefix = Indent(indent_level);
@@ -36,8 +36,13 @@
 namespace px {
 namespace md {
 
-using K8sMetadataObjectUPtr = std::unique_ptr<K8sMetadataObject>;
-using ContainerInfoUPtr = std::unique_ptr<ContainerInfo>;
+// K8s objects and containers are held by shared_ptr so that successive state snapshots can share
+// the objects that did not change between snapshots. An object that is referenced by more than one
+// snapshot is treated as immutable; the update handlers copy such objects before mutating them
+// (copy-on-write). This keeps the cost of cloning the state proportional to the number of updated
+// objects rather than the total number of objects in the cluster.
+using K8sMetadataObjectSPtr = std::shared_ptr<K8sMetadataObject>;
+using ContainerInfoSPtr = std::shared_ptr<ContainerInfo>;
 using PIDInfoUPtr = std::unique_ptr<PIDInfo>;
 using AgentID = sole::uuid;
 
@@ -156,6 +161,15 @@ class K8sMetadataState : NotCopyable {
    */
   const ContainerInfo* ContainerInfoByID(CIDView id) const;
 
+  /**
+   * MutableContainerInfoByID returns a pointer through which the container may be mutated.
+   * If the container is shared with previous state snapshots, it is replaced with a private
+   * copy first (copy-on-write), so the mutation is not visible through older snapshots.
+   * @param id The ID of the container.
+   * @return Mutable ContainerInfo or nullptr if not found.
+   */
+  ContainerInfo* MutableContainerInfoByID(CIDView id);
+
   /**
    * ContainerIDByName returns the ContainerID for the container of the given name.
    * @param container_name the container name
@@ -223,6 +237,11 @@ class K8sMetadataState : NotCopyable {
    */
   UID DeploymentIDByName(K8sNameIdentView deployment_name) const;
 
+  /**
+   * Clone creates a new state that shares the (immutable) K8s objects and containers with this
+   * state instead of deep-copying them; an object is only copied once an update actually mutates
+   * it. The by-name/by-ip index maps are small relative to the objects and are copied by value.
+   */
   std::unique_ptr<K8sMetadataState> Clone() const;
 
   Status HandlePodUpdate(const PodUpdate& update);
@@ -235,7 +254,7 @@ class K8sMetadataState : NotCopyable {
 
   Status CleanupExpiredMetadata(int64_t retention_time_ns);
 
-  absl::flat_hash_map<CID, ContainerInfoUPtr>& containers_by_id() { return containers_by_id_; }
+  absl::flat_hash_map<CID, ContainerInfoSPtr>& containers_by_id() { return containers_by_id_; }
   std::string DebugString(int indent_level = 0) const;
 
  private:
@@ -248,10 +267,11 @@ class K8sMetadataState : NotCopyable {
   std::vector<CIDRBlock> pod_cidrs_;
 
   // This stores K8s native objects (services, pods, etc).
-  absl::flat_hash_map<UID, K8sMetadataObjectUPtr> k8s_objects_by_id_;
+  // Objects may be shared with other state snapshots; see the copy-on-write notes above.
+  absl::flat_hash_map<UID, K8sMetadataObjectSPtr> k8s_objects_by_id_;
 
   // This stores container objects, complementing k8s_objects_by_id_.
-  absl::flat_hash_map<CID, ContainerInfoUPtr> containers_by_id_;
+  absl::flat_hash_map<CID, ContainerInfoSPtr> containers_by_id_;
 
   /**
    * Mapping of pods by name.
@@ -333,6 +353,23 @@ class AgentMetadataState : NotCopyable {
 
   std::shared_ptr<AgentMetadataState> CloneToShared() const;
 
+  /**
+   * ContainerInfoByUPID/PodInfoByUPID look up the container/pod a process belongs to with a
+   * single hash probe, using the index built by BuildUPIDIndex(). When the index has not been
+   * built (e.g. on a shadow state mid-update), they fall back to chaining through the PID info
+   * and the K8s state. The returned pointers remain valid for the lifetime of this state.
+   */
+  const ContainerInfo* ContainerInfoByUPID(UPID upid) const;
+  const PodInfo* PodInfoByUPID(UPID upid) const;
+
+  /**
+   * BuildUPIDIndex (re)builds the UPID-keyed lookup index over all tracked PIDs. Call this after
+   * all updates have been applied and before the state is published; queries then resolve
+   * UPID-to-pod in one probe instead of three. The index holds unowned pointers into this state
+   * and is intentionally not copied by CloneToShared().
+   */
+  void BuildUPIDIndex();
+
   PIDInfo* GetPIDByUPID(UPID upid) const {
     auto it = pids_by_upid_.find(upid);
     if (it != pids_by_upid_.end()) {
@@ -390,6 +427,18 @@ class AgentMetadataState : NotCopyable {
 
   std::unique_ptr<K8sMetadataState> k8s_metadata_state_;
 
+  struct UPIDIndexEntry {
+    const ContainerInfo* container_info;
+    const PodInfo* pod_info;
+  };
+
+  /**
+   * Single-probe index from UPID to the associated container and pod, for the per-row query
+   * path. Published states are immutable, so the index is read without locks or refcount
+   * traffic; it is rebuilt once per metadata state update (see BuildUPIDIndex()).
+   */
+  absl::flat_hash_map<UPID, UPIDIndexEntry> upid_index_;
+
   /**
    * Mapping of PIDs by UPID for active pods on the system.
    */
@@ -278,6 +278,47 @@ TEST(K8sMetadataStateTest, CloneCopiedCIDR) {
   EXPECT_EQ(service_cidr.prefix_length, state_copy->service_cidr()->prefix_length);
 }
 
+TEST(K8sMetadataStateTest, CloneSharesUnmodifiedObjects) {
+  K8sMetadataState state;
+
+  K8sMetadataState::ContainerUpdate container_update;
+  ASSERT_TRUE(TextFormat::MergeFromString(kContainer0UpdatePbTxt, &container_update))
+      << "Failed to parse proto";
+  K8sMetadataState::PodUpdate pod0_update;
+  ASSERT_TRUE(TextFormat::MergeFromString(kPod0UpdatePbTxt, &pod0_update))
+      << "Failed to parse proto";
+  K8sMetadataState::PodUpdate pod2_update;
+  ASSERT_TRUE(TextFormat::MergeFromString(kPod2UpdatePbTxt, &pod2_update))
+      << "Failed to parse proto";
+
+  EXPECT_OK(state.HandleContainerUpdate(container_update));
+  EXPECT_OK(state.HandlePodUpdate(pod0_update));
+  EXPECT_OK(state.HandlePodUpdate(pod2_update));
+
+  auto clone = state.Clone();
+
+  // Objects are shared with the clone rather than deep-copied.
+  EXPECT_EQ(state.PodInfoByID("pod0_uid"), clone->PodInfoByID("pod0_uid"));
+  EXPECT_EQ(state.PodInfoByID("pod2_uid"), clone->PodInfoByID("pod2_uid"));
+  EXPECT_EQ(state.ContainerInfoByID("container0_uid"), clone->ContainerInfoByID("container0_uid"));
+
+  // Updating an object through the clone must not be visible through the original state.
+  K8sMetadataState::PodUpdate pod0_update2;
+  ASSERT_TRUE(TextFormat::MergeFromString(kPod0UpdatePbTxt, &pod0_update2))
+      << "Failed to parse proto";
+  pod0_update2.set_phase(px::shared::k8s::metadatapb::PENDING);
+  EXPECT_OK(clone->HandlePodUpdate(pod0_update2));
+
+  EXPECT_NE(state.PodInfoByID("pod0_uid"), clone->PodInfoByID("pod0_uid"));
+  EXPECT_EQ(PodPhase::kRunning, state.PodInfoByID("pod0_uid")->phase());
+  EXPECT_EQ(PodPhase::kPending, clone->PodInfoByID("pod0_uid")->phase());
+
+  // The pod update also touches the pod's container, so the container is copied as well,
+  // while the untouched pod remains shared.
+  EXPECT_NE(state.ContainerInfoByID("container0_uid"), clone->ContainerInfoByID("container0_uid"));
+  EXPECT_EQ(state.PodInfoByID("pod2_uid"), clone->PodInfoByID("pod2_uid"));
+}
+
 TEST(K8sMetadataStateTest, HandleContainerUpdate) {
   K8sMetadataState state;
 
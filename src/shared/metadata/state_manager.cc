@@ -92,6 +92,8 @@ Status AgentMetadataStateManagerImpl::PerformMetadataStateUpdate() {
     // Update PID information.
     PL_RETURN_IF_ERROR(
         ProcessPIDUpdates(ts, proc_parser_, shadow_state.get(), md_reader_.get(), &pid_updates_));
+    // Containers that died this cycle were not read above; close their cached cgroup handles.
+    md_reader_->ReleaseUnusedProcsFileHandles();
   }
 
   // Update the pod/service CIDRs if they have been updated.
@@ -117,6 +119,10 @@ Status AgentMetadataStateManagerImpl::PerformMetadataStateUpdate() {
   shadow_state->set_epoch_id(epoch_id);
   shadow_state->set_last_update_ts_ns(ts);
 
+  // Rebuild the UPID lookup index used by the query hot path. This must be the last step before
+  // publication, since the index holds unowned pointers into the state.
+  shadow_state->BuildUPIDIndex();
+
   {
     absl::base_internal::SpinLockHolder lock(&agent_metadata_state_lock_);
     agent_metadata_state_ = std::move(shadow_state);
@@ -177,6 +183,21 @@ StatusOr<UPID> InitUPID(const system::ProcParser& proc_parser, uint32_t asid, ui
   return UPID(asid, pid, pid_start_time);
 }
 
+// Returns true if the set of PIDs read from the container's cgroup differs from the UPIDs already
+// tracked for the container. Matches by PID, mirroring the logic in ProcessContainerPIDUpdates.
+bool PIDSetChanged(const StartTimeOrderedUPIDSet& upids,
+                   const absl::flat_hash_set<uint32_t>& cgroups_pids) {
+  if (upids.size() != cgroups_pids.size()) {
+    return true;
+  }
+  for (const auto& upid : upids) {
+    if (!cgroups_pids.contains(upid.pid())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace
 
 void ProcessContainerPIDUpdates(
@@ -264,7 +285,7 @@ Status ProcessPIDUpdates(
     if (pod_info->stop_time_ns() != 0) {
       VLOG(1) << absl::Substitute("Found a running container in a deleted pod [cid=$0, pod_id=$1]",
                                   cid, pod_id);
-      cinfo->set_stop_time_ns(pod_info->stop_time_ns());
+      k8s_md_state->MutableContainerInfoByID(cid)->set_stop_time_ns(pod_info->stop_time_ns());
       continue;
     }
 
@@ -282,16 +303,25 @@ Status ProcessPIDUpdates(
       // NOTE: Currently, MDS sends pods that do no belong to this Agent, so this is actually
       // required to avoid repeatedly printing out the warning message above.
       if (error::IsNotFound(s)) {
-        cinfo->set_stop_time_ns(ts);
-        for (const auto& upid : cinfo->active_upids()) {
+        auto* mutable_cinfo = k8s_md_state->MutableContainerInfoByID(cid);
+        mutable_cinfo->set_stop_time_ns(ts);
+        for (const auto& upid : mutable_cinfo->active_upids()) {
           md->MarkUPIDAsStopped(upid, ts);
         }
-        cinfo->mutable_active_upids()->clear();
+        mutable_cinfo->mutable_active_upids()->clear();
       }
       continue;
     }
 
-    ProcessContainerPIDUpdates(cid, ts, proc_parser, md, cinfo->mutable_active_upids(),
+    // Skip the diffing work when the container's PID set is unchanged, which is the common case
+    // in steady state. This also avoids copying containers that are shared with previous state
+    // snapshots just to find out there is nothing to update.
+    if (!PIDSetChanged(cinfo->active_upids(), cgroups_active_pids)) {
+      continue;
+    }
+
+    ProcessContainerPIDUpdates(cid, ts, proc_parser, md,
+                               k8s_md_state->MutableContainerInfoByID(cid)->mutable_active_upids(),
                                &cgroups_active_pids, pid_updates);
   }
 
@@ -382,6 +382,38 @@ TEST_F(AgentMetadataStateTest, pid_created) {
   EXPECT_THAT(pids_started, UnorderedElementsAre(PIDStartedEvent{pid1}, PIDStartedEvent{pid2}));
 }
 
+TEST_F(AgentMetadataStateTest, upid_index_lookup) {
+  moodycamel::BlockingConcurrentQueue<std::unique_ptr<ResourceUpdate>> updates;
+  GenerateTestUpdateEvents(&updates);
+
+  EXPECT_OK(ApplyK8sUpdates(2000 /*ts*/, &metadata_state_, &md_filter_, &updates));
+
+  moodycamel::BlockingConcurrentQueue<std::unique_ptr<PIDStatusEvent>> events;
+  FakePIDData md_reader;
+  std::filesystem::path proc_path = testing::BazelRunfilePath("src/shared/metadata/testdata/proc");
+  system::ProcParser proc_parser(proc_path.string());
+  ASSERT_OK(ProcessPIDUpdates(1000, proc_parser, &metadata_state_, &md_reader, &events));
+
+  UPID upid(kASID, 100 /*pid*/, 1000 /*ts*/);
+  const K8sMetadataState* k8s_state = metadata_state_.k8s_metadata_state();
+
+  // Before the index is built, lookups fall back to chaining through the PID and K8s state.
+  EXPECT_EQ(k8s_state->ContainerInfoByID("container_id1"),
+            metadata_state_.ContainerInfoByUPID(upid));
+  EXPECT_EQ(k8s_state->PodInfoByID("pod_id1"), metadata_state_.PodInfoByUPID(upid));
+
+  metadata_state_.BuildUPIDIndex();
+
+  // With the index built, lookups resolve in a single probe to the same objects.
+  EXPECT_EQ(k8s_state->ContainerInfoByID("container_id1"),
+            metadata_state_.ContainerInfoByUPID(upid));
+  EXPECT_EQ(k8s_state->PodInfoByID("pod_id1"), metadata_state_.PodInfoByUPID(upid));
+
+  // Unknown UPIDs resolve to nullptr.
+  EXPECT_EQ(nullptr, metadata_state_.PodInfoByUPID(UPID(kASID, 999 /*pid*/, 1 /*ts*/)));
+  EXPECT_EQ(nullptr, metadata_state_.ContainerInfoByUPID(UPID(kASID, 999 /*pid*/, 1 /*ts*/)));
+}
+
 TEST_F(AgentMetadataStateTest, insert_into_filter) {
   moodycamel::BlockingConcurrentQueue<std::unique_ptr<ResourceUpdate>> updates;
   GenerateTestUpdateEvents(&updates);
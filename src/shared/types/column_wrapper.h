@@ -52,6 +52,10 @@ class ColumnWrapper {
   virtual ~ColumnWrapper() = default;
 
   static SharedColumnWrapper Make(DataType data_type, size_t size);
+  // Same as above, but additionally reserves capacity for the expected number of rows, so
+  // callers that know their batch size up front (e.g. from the table schema) avoid the
+  // append-path reallocations.
+  static SharedColumnWrapper Make(DataType data_type, size_t size, size_t capacity);
   static SharedColumnWrapper FromArrow(const std::shared_ptr<arrow::Array>& arr);
   // Force data type of resultant wrapper, regardless of the type of the underlying arrow::Array.
   // This is needed in order to create a Time64NS ColumnWrapper from an arrow Array, since the
@@ -94,6 +98,11 @@ class ColumnWrapper {
   template <class TValueType>
   void AppendFromVector(const std::vector<TValueType>& value_vector);
 
+  // Move-append: steals the elements' storage instead of copying. For StringValue columns this
+  // transfers each string's heap buffer, so bulk handoffs don't reallocate.
+  template <class TValueType>
+  void AppendFromVector(std::vector<TValueType>&& value_vector);
+
   // Return a new SharedColumnWrapper with values according to the spec:
   //    { data[idx[0]], data[idx[1]], data[idx[2]], ... }
   // CopyIndexes leaves the original untouched, while MoveIndexes destroys the moved indexes.
@@ -149,9 +158,14 @@ class ColumnWrapperTmpl : public ColumnWrapper {
   }
 
   void AppendFromVector(const std::vector<T>& value_vector) {
-    for (const auto& value : value_vector) {
-      Append(value);
-    }
+    // Range insert sizes the vector once; for trivially-copyable (fixed-width) value types it
+    // lowers to a single memcpy rather than element-wise push_backs.
+    data_.insert(data_.end(), value_vector.begin(), value_vector.end());
+  }
+
+  void AppendFromVector(std::vector<T>&& value_vector) {
+    data_.insert(data_.end(), std::make_move_iterator(value_vector.begin()),
+                 std::make_move_iterator(value_vector.end()));
   }
 
   // Return a new SharedColumnWrapper with values according to the spec:
@@ -270,6 +284,12 @@ inline SharedColumnWrapper ColumnWrapper::Make(DataType data_type, size_t size)
 #undef TYPE_CASE
 }
 
+inline SharedColumnWrapper ColumnWrapper::Make(DataType data_type, size_t size, size_t capacity) {
+  auto wrapper = Make(data_type, size);
+  wrapper->Reserve(capacity);
+  return wrapper;
+}
+
 template <class TValueType>
 inline void ColumnWrapper::Append(TValueType val) {
   CHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type)
@@ -316,6 +336,14 @@ inline void ColumnWrapper::AppendFromVector(const std::vector<TValueType>& val)
   static_cast<ColumnWrapperTmpl<TValueType>*>(this)->AppendFromVector(val);
 }
 
+template <class TValueType>
+inline void ColumnWrapper::AppendFromVector(std::vector<TValueType>&& val) {
+  CHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type)
+      << "Expect " << ToString(data_type()) << " got "
+      << ToString(ValueTypeTraits<TValueType>::data_type);
+  static_cast<ColumnWrapperTmpl<TValueType>*>(this)->AppendFromVector(std::move(val));
+}
+
 template <DataType DT>
 struct ColumnWrapperType {};
 
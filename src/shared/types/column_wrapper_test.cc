@@ -200,6 +200,35 @@ TEST(ColumnWrapperTest, FromVectorString) {
   EXPECT_TRUE(actual_arr->Equals(expected_arr));
 }
 
+TEST(ColumnWrapperTest, MoveFromVectorString) {
+  auto wrapper = ColumnWrapper::Make(DataType::STRING, 0);
+  std::vector<types::StringValue> string_vector(
+      {"this string is long enough to live on the heap",
+       "and so is this one, so the move steals its buffer"});
+  const char* buf0 = string_vector[0].data();
+  wrapper->AppendFromVector(std::move(string_vector));
+
+  ASSERT_EQ(2, wrapper->Size());
+  EXPECT_EQ("this string is long enough to live on the heap",
+            wrapper->Get<types::StringValue>(0));
+  EXPECT_EQ("and so is this one, so the move steals its buffer",
+            wrapper->Get<types::StringValue>(1));
+  // The heap buffer was transferred rather than copied.
+  EXPECT_EQ(buf0, wrapper->Get<types::StringValue>(0).data());
+}
+
+TEST(ColumnWrapperTest, MakeWithCapacity) {
+  auto wrapper = ColumnWrapper::Make(DataType::INT64, 0, 1024);
+  EXPECT_EQ(0, wrapper->Size());
+  // Appends up to the reserved capacity must not move the backing store.
+  auto* data_before = wrapper->UnsafeRawData();
+  for (int i = 0; i < 1024; ++i) {
+    wrapper->Append<types::Int64Value>(i);
+  }
+  EXPECT_EQ(1024, wrapper->Size());
+  EXPECT_EQ(data_before, wrapper->UnsafeRawData());
+}
+
 TEST(ColumnWrapperTest, CopyIndexes) {
   using ::testing::ElementsAreArray;
 
@@ -21,7 +21,13 @@
 #include <farmhash.h>
 
 #include <cstdint>
+#include <string_view>
+#include <type_traits>
 
+// NOLINTNEXTLINE: build/include_subdir
+#include "xxh3.h"
+
+#include "src/common/base/hash_utils.h"
 #include "src/shared/types/types.h"
 
 namespace px {
@@ -63,6 +69,35 @@ struct hash<Time64NSValue> {
   }
 };
 
+/**
+ * Batched hash kernels for join/group keys. XXH3 consumes its input through SIMD lanes, and
+ * hashing a whole column in one pass streams the key data through cache once instead of
+ * re-touching each row at lookup time.
+ *
+ * Multi-column keys are built up column by column: the first key column is hashed with
+ * `init = true`, which overwrites out[i]; later columns combine their per-row hash into out[i]
+ * with HashCombine. Hashes from this family are unrelated to the scalar hash<> functors above,
+ * so a container must be fed exclusively from one or the other.
+ */
+inline uint64_t HashBytes(const void* data, size_t len) { return XXH3_64bits(data, len); }
+
+template <typename T>
+inline void HashFixedBatch(const T* data, size_t count, bool init, uint64_t* out) {
+  static_assert(std::is_trivially_copyable_v<T>, "Fixed-width hash input must be raw data");
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t h = HashBytes(&data[i], sizeof(T));
+    out[i] = init ? h : ::px::HashCombine(out[i], h);
+  }
+}
+
+inline void HashStringBatch(const std::string_view* parts, size_t count, bool init,
+                            uint64_t* out) {
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t h = HashBytes(parts[i].data(), parts[i].size());
+    out[i] = init ? h : ::px::HashCombine(out[i], h);
+  }
+}
+
 }  // namespace utils
 }  // namespace types
 }  // namespace px
@@ -60,6 +60,34 @@ TEST(HashUtils, Time64NSValue) {
   EXPECT_NE(hash<Time64NSValue>{}(v1), hash<Time64NSValue>{}(v2));
 }
 
+TEST(HashUtils, HashFixedBatch) {
+  int64_t vals[] = {1, 2, 3};
+  uint64_t hashes[] = {0, 0, 0};
+
+  HashFixedBatch(vals, 3, /* init */ true, hashes);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(HashBytes(&vals[i], sizeof(int64_t)), hashes[i]);
+  }
+
+  // A second column should combine into the existing hashes.
+  uint64_t expected[] = {hashes[0], hashes[1], hashes[2]};
+  HashFixedBatch(vals, 3, /* init */ false, hashes);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(::px::HashCombine(expected[i], HashBytes(&vals[i], sizeof(int64_t))), hashes[i]);
+  }
+}
+
+TEST(HashUtils, HashStringBatch) {
+  std::string_view parts[] = {"abc", "", "abcd"};
+  uint64_t hashes[] = {0, 0, 0};
+
+  HashStringBatch(parts, 3, /* init */ true, hashes);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(HashBytes(parts[i].data(), parts[i].size()), hashes[i]);
+  }
+  EXPECT_NE(hashes[0], hashes[2]);
+}
+
 }  // namespace utils
 }  // namespace types
 }  // namespace px
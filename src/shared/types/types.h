@@ -26,6 +26,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -356,6 +357,22 @@ struct ValueTypeTraits<StringValue> {
   using native_type = std::string;
 };
 
+/**
+ * std::string_view also maps to STRING. A UDF whose Exec only reads a string argument can
+ * declare it as std::string_view; the execution wrappers then pass a view borrowing the
+ * batch's underlying storage, valid for the duration of the call, instead of materializing
+ * a StringValue copy per row. The view must not be retained past the call.
+ */
+template <>
+struct ValueTypeTraits<std::string_view> {
+  static constexpr bool is_fixed_size = false;
+  static constexpr DataType data_type = types::STRING;
+  using arrow_type = arrow::StringType;
+  using arrow_builder_type = arrow::StringBuilder;
+  using arrow_array_type = arrow::StringArray;
+  using native_type = std::string_view;
+};
+
 /**
  * Store traits based on the native ValueType.
  * @tparam T The DataType.
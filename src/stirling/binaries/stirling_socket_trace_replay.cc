@@ -0,0 +1,231 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Replays a recorded socket_tracer data event stream through SocketTraceConnector,
+// without any BPF involvement. This makes it possible to benchmark parser and stitcher
+// changes against production-shaped traffic, offline.
+//
+// To record a stream, run stirling (e.g. stirling_wrapper) on a live node with:
+//     --socket_trace_data_events_output_path=/tmp/events.bin
+// The ".bin" suffix selects the compact length-delimited proto format that this
+// binary consumes (other suffixes produce a text dump for human consumption).
+//
+// Then replay it with:
+//     stirling_socket_trace_replay --input=/tmp/events.bin [--speed=1.0]
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/util/delimited_message_util.h>
+
+#include "src/common/base/base.h"
+#include "src/stirling/core/connector_context.h"
+#include "src/stirling/source_connectors/socket_tracer/proto/sock_event.pb.h"
+#include "src/stirling/source_connectors/socket_tracer/socket_trace_connector.h"
+#include "src/stirling/source_connectors/socket_tracer/testing/clock.h"
+#include "src/stirling/source_connectors/socket_tracer/testing/socket_trace_connector_friend.h"
+#include "src/stirling/testing/common.h"
+
+DEFINE_string(input, "",
+              "Path to a data event stream recorded with "
+              "--socket_trace_data_events_output_path=<file>.bin.");
+DEFINE_double(speed, 0.0,
+              "Replay speed as a multiplier of the recorded pace. 1.0 replays in real time, "
+              "2.0 at twice the recorded rate. 0 (the default) replays as fast as possible.");
+DEFINE_uint64(transfer_period_ms, 200,
+              "Interval of recorded time between TransferData calls. The default matches "
+              "SocketTraceConnector's sampling period on a live system.");
+
+using ::px::Status;
+using ::px::StatusOr;
+using ::px::stirling::SocketDataEvent;
+using ::px::stirling::SocketTraceConnector;
+using ::px::stirling::SocketTraceConnectorFriend;
+using ::px::stirling::StandaloneContext;
+using ::px::stirling::testing::DataTables;
+using ::px::stirling::testing::NanosToTimePoint;
+
+namespace {
+
+// One recorded perf-buffer event, with the payload owned by the replay process.
+struct ReplayEvent {
+  socket_data_event_t::attr_t attr;
+  std::string msg;
+};
+
+StatusOr<std::vector<ReplayEvent>> ReadRecordedEvents(const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input.is_open()) {
+    return ::px::error::NotFound("Could not open input file: $0", path);
+  }
+
+  google::protobuf::io::IstreamInputStream zstream(&input);
+
+  std::vector<ReplayEvent> events;
+  bool clean_eof = false;
+  px::stirling::sockeventpb::SocketDataEvent pb;
+  while (google::protobuf::util::ParseDelimitedFromZeroCopyStream(&pb, &zstream, &clean_eof)) {
+    ReplayEvent event = {};
+    event.attr.timestamp_ns = pb.attr().timestamp_ns();
+    event.attr.conn_id.upid.pid = pb.attr().conn_id().pid();
+    event.attr.conn_id.upid.start_time_ticks = pb.attr().conn_id().start_time_ns();
+    event.attr.conn_id.fd = pb.attr().conn_id().fd();
+    event.attr.conn_id.tsid = pb.attr().conn_id().generation();
+    event.attr.protocol = static_cast<traffic_protocol_t>(pb.attr().protocol());
+    event.attr.role = static_cast<endpoint_role_t>(pb.attr().role());
+    event.attr.direction = static_cast<traffic_direction_t>(pb.attr().direction());
+    event.attr.pos = pb.attr().pos();
+    event.attr.msg_size = pb.attr().msg_size();
+    event.attr.msg_buf_size = pb.msg().size();
+    event.msg = pb.msg();
+    events.push_back(std::move(event));
+  }
+  if (!clean_eof) {
+    return ::px::error::Internal(
+        "Input file $0 ended mid-message. Was it recorded with a '.bin' suffix?", path);
+  }
+  if (events.empty()) {
+    return ::px::error::Internal("Input file $0 contains no events.", path);
+  }
+  return events;
+}
+
+uint64_t ConsumeRecords(DataTables* tables, std::vector<uint64_t>* records_per_table) {
+  uint64_t num_records = 0;
+  for (size_t i = 0; i < tables->tables().size(); ++i) {
+    auto tagged_records = (*tables)[i]->ConsumeRecords();
+    for (const auto& tagged_record : tagged_records) {
+      if (!tagged_record.records.empty()) {
+        num_records += tagged_record.records[0]->Size();
+        (*records_per_table)[i] += tagged_record.records[0]->Size();
+      }
+    }
+  }
+  return num_records;
+}
+
+Status ReplayMain() {
+  if (FLAGS_input.empty()) {
+    return ::px::error::InvalidArgument("--input is required.");
+  }
+
+  PL_ASSIGN_OR_RETURN(std::vector<ReplayEvent> events, ReadRecordedEvents(FLAGS_input));
+
+  uint64_t total_bytes = 0;
+  absl::flat_hash_set<px::md::UPID> upids;
+  for (const ReplayEvent& event : events) {
+    total_bytes += event.msg.size();
+    upids.emplace(/*asid*/ 0, event.attr.conn_id.upid.pid,
+                  event.attr.conn_id.upid.start_time_ticks);
+  }
+  std::cout << absl::Substitute("Loaded $0 events ($1 bytes) across $2 upids from $3.\n",
+                                events.size(), total_bytes, upids.size(), FLAGS_input);
+
+  StandaloneContext ctx(upids);
+
+  // The recorded processes are not running here, so disable the /proc liveness checks that
+  // would otherwise mark every connection as closed.
+  FLAGS_stirling_check_proc_for_conn_close = 0;
+
+  auto connector = SocketTraceConnectorFriend::Create("socket_trace_connector");
+  auto* source = dynamic_cast<SocketTraceConnectorFriend*>(connector.get());
+  CHECK(source != nullptr);
+
+  // Drive the connector's clock from the recorded timeline, so that inactivity and expiry
+  // logic behaves as it did during the capture, independent of replay speed.
+  uint64_t replay_now_ns = events.front().attr.timestamp_ns;
+  source->test_only_set_now_fn([&replay_now_ns]() { return NanosToTimePoint(replay_now_ns); });
+
+  DataTables tables(SocketTraceConnector::kTables);
+  std::vector<uint64_t> records_per_table(tables.tables().size(), 0);
+
+  const uint64_t transfer_period_ns = FLAGS_transfer_period_ms * 1000 * 1000;
+  uint64_t next_transfer_ns = replay_now_ns + transfer_period_ns;
+  uint64_t num_transfers = 0;
+  uint64_t num_records = 0;
+
+  const uint64_t record_start_ns = events.front().attr.timestamp_ns;
+  const auto wall_start = std::chrono::steady_clock::now();
+
+  for (ReplayEvent& event : events) {
+    if (FLAGS_speed > 0) {
+      const uint64_t elapsed_record_ns = event.attr.timestamp_ns - record_start_ns;
+      const auto wall_target =
+          wall_start + std::chrono::nanoseconds(
+                           static_cast<uint64_t>(elapsed_record_ns / FLAGS_speed));
+      std::this_thread::sleep_until(wall_target);
+    }
+
+    replay_now_ns = event.attr.timestamp_ns;
+    while (replay_now_ns >= next_transfer_ns) {
+      source->TransferData(&ctx, tables.tables());
+      num_records += ConsumeRecords(&tables, &records_per_table);
+      ++num_transfers;
+      next_transfer_ns += transfer_period_ns;
+    }
+
+    auto data_event = std::make_unique<SocketDataEvent>();
+    data_event->attr = event.attr;
+    data_event->msg = event.msg;
+    source->AcceptDataEvent(std::move(data_event));
+  }
+
+  // Final TransferData to flush anything still buffered in the conn trackers.
+  source->TransferData(&ctx, tables.tables());
+  num_records += ConsumeRecords(&tables, &records_per_table);
+  ++num_transfers;
+
+  const auto wall_duration = std::chrono::steady_clock::now() - wall_start;
+  const double wall_seconds =
+      std::chrono::duration_cast<std::chrono::duration<double>>(wall_duration).count();
+  const double recorded_seconds =
+      static_cast<double>(events.back().attr.timestamp_ns - record_start_ns) / 1E9;
+
+  std::cout << absl::Substitute(
+      "Replayed $0 recorded seconds in $1 wall seconds ($2 TransferData calls).\n",
+      recorded_seconds, wall_seconds, num_transfers);
+  std::cout << absl::Substitute("Throughput: $0 events/s, $1 bytes/s.\n",
+                                static_cast<uint64_t>(events.size() / wall_seconds),
+                                static_cast<uint64_t>(total_bytes / wall_seconds));
+  std::cout << absl::Substitute("Output: $0 records.\n", num_records);
+  for (size_t i = 0; i < records_per_table.size(); ++i) {
+    if (records_per_table[i] > 0) {
+      std::cout << absl::Substitute("  $0: $1 records\n",
+                                    SocketTraceConnector::kTables[i].name(),
+                                    records_per_table[i]);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  px::EnvironmentGuard env_guard(&argc, argv);
+
+  PL_EXIT_IF_ERROR(ReplayMain());
+
+  return 0;
+}
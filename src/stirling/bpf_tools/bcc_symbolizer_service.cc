@@ -0,0 +1,55 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/bpf_tools/bcc_symbolizer_service.h"
+
+namespace px {
+namespace stirling {
+namespace bpf_tools {
+
+BCCSymbolizerService& BCCSymbolizerService::GetInstance() {
+  // Intentionally leaked: the service may be in use by detached threads at shutdown.
+  static BCCSymbolizerService* service = new BCCSymbolizerService();
+  return *service;
+}
+
+std::string BCCSymbolizerService::Symbolize(const int pid, const uintptr_t addr) {
+  std::lock_guard<std::mutex> lock(mu_);
+  return std::string(symbolizer_.SymbolOrAddrIfUnknown(pid, addr));
+}
+
+std::vector<std::string> BCCSymbolizerService::SymbolizeBatch(
+    const int pid, const std::vector<uintptr_t>& addrs) {
+  std::vector<std::string> symbols;
+  symbols.reserve(addrs.size());
+
+  std::lock_guard<std::mutex> lock(mu_);
+  for (const uintptr_t addr : addrs) {
+    symbols.emplace_back(symbolizer_.SymbolOrAddrIfUnknown(pid, addr));
+  }
+  return symbols;
+}
+
+void BCCSymbolizerService::ReleasePIDSymCache(uint32_t pid) {
+  std::lock_guard<std::mutex> lock(mu_);
+  symbolizer_.ReleasePIDSymCache(pid);
+}
+
+}  // namespace bpf_tools
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/stirling/bpf_tools/bcc_symbolizer.h"
+
+namespace px {
+namespace stirling {
+namespace bpf_tools {
+
+/**
+ * BCCSymbolizerService is a process-wide symbolization service backed by a single BCCSymbolizer.
+ *
+ * The BCC symbol tables for a pid (and for the kernel) are expensive to load, so consumers that
+ * symbolize addresses for the same pids should share one set of tables rather than each loading
+ * its own copy into a private BCCSymbolizer. Consumers access the shared instance through
+ * GetInstance().
+ *
+ * All methods are thread-safe. Unlike BCCSymbolizer, results are returned as owned strings, so
+ * they remain valid after another thread symbolizes.
+ */
+class BCCSymbolizerService : public NotCopyable {
+ public:
+  /**
+   * Returns the shared process-wide instance.
+   */
+  static BCCSymbolizerService& GetInstance();
+
+  BCCSymbolizerService() = default;
+
+  /**
+   * Resolves a single address for the given pid.
+   * Use BCCSymbolizer::kKernelPID to resolve kernel-space addresses.
+   */
+  std::string Symbolize(int pid, uintptr_t addr);
+
+  /**
+   * Resolves a batch of addresses (e.g. the frames of one stack trace) for the given pid,
+   * acquiring the internal lock only once for the whole batch.
+   * The returned vector has one entry per input address, in order.
+   */
+  std::vector<std::string> SymbolizeBatch(int pid, const std::vector<uintptr_t>& addrs);
+
+  /**
+   * Releases the symbol tables for the given pid.
+   * Meant to be called when the process exits; if the pid is symbolized again
+   * (e.g. because the pid was reused), the tables are reloaded on demand.
+   */
+  void ReleasePIDSymCache(uint32_t pid);
+
+ private:
+  std::mutex mu_;
+
+  // Not thread-safe on its own: must be accessed with mu_ held.
+  BCCSymbolizer symbolizer_;
+};
+
+}  // namespace bpf_tools
+}  // namespace stirling
+}  // namespace px
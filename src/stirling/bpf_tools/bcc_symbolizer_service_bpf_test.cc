@@ -0,0 +1,80 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/common/testing/testing.h"
+#include "src/stirling/bpf_tools/bcc_symbolizer_service.h"
+
+// Some functions for which we'll lookup symbols by address.
+namespace test {
+void Foo() { LOG(INFO) << "foo()."; }
+void Bar() { LOG(INFO) << "bar()."; }
+}  // namespace test
+
+const uintptr_t kFooAddr = reinterpret_cast<uintptr_t>(&test::Foo);
+const uintptr_t kBarAddr = reinterpret_cast<uintptr_t>(&test::Bar);
+
+namespace px {
+namespace stirling {
+namespace bpf_tools {
+
+TEST(BCCSymbolizerService, SharedInstance) {
+  EXPECT_EQ(&BCCSymbolizerService::GetInstance(), &BCCSymbolizerService::GetInstance());
+}
+
+TEST(BCCSymbolizerService, Symbolize) {
+  BCCSymbolizerService service;
+
+  const pid_t pid = getpid();
+
+  EXPECT_EQ(service.Symbolize(pid, kFooAddr), "test::Foo()");
+  EXPECT_EQ(service.Symbolize(pid, kBarAddr), "test::Bar()");
+  EXPECT_EQ(service.Symbolize(pid, 123), "0x000000000000007b");
+}
+
+TEST(BCCSymbolizerService, SymbolizeBatch) {
+  BCCSymbolizerService service;
+
+  const pid_t pid = getpid();
+
+  const std::vector<uintptr_t> addrs = {kFooAddr, kBarAddr, 123};
+  const std::vector<std::string> symbols = service.SymbolizeBatch(pid, addrs);
+
+  ASSERT_EQ(symbols.size(), addrs.size());
+  EXPECT_EQ(symbols[0], "test::Foo()");
+  EXPECT_EQ(symbols[1], "test::Bar()");
+  EXPECT_EQ(symbols[2], "0x000000000000007b");
+}
+
+TEST(BCCSymbolizerService, SymbolizeAfterRelease) {
+  BCCSymbolizerService service;
+
+  const pid_t pid = getpid();
+
+  EXPECT_EQ(service.Symbolize(pid, kFooAddr), "test::Foo()");
+
+  // Releasing the pid's symbol tables frees the BCC-side state; a subsequent
+  // symbolization reloads the tables on demand.
+  service.ReleasePIDSymCache(pid);
+  EXPECT_EQ(service.Symbolize(pid, kFooAddr), "test::Foo()");
+}
+
+}  // namespace bpf_tools
+}  // namespace stirling
+}  // namespace px
@@ -22,6 +22,7 @@
 #include <sys/mount.h>
 
 #include <iostream>
+#include <mutex>
 #include <string>
 
 #include <magic_enum.hpp>
@@ -32,6 +33,12 @@
 #include "src/stirling/bpf_tools/task_struct_resolver.h"
 #include "src/stirling/utils/linux_headers.h"
 
+DEFINE_bool(stirling_numa_local_perf_polling, false,
+            "When true, each perf buffer is drained by a dedicated thread pinned to the CPUs of "
+            "one NUMA node (buffers are spread round-robin across nodes), with events handed off "
+            "to the consumer thread through per-buffer queues. Avoids one thread pulling every "
+            "CPU's buffer pages across sockets on large multi-socket hosts.");
+
 namespace px {
 namespace stirling {
 namespace bpf_tools {
@@ -105,6 +112,13 @@ Status BCCWrapper::InitBPFProgram(std::string_view bpf_program, std::vector<std:
     return error::PermissionDenied("BCC currently only supported as the root user.");
   }
 
+  // The environment setup below (Linux header installation, task_struct offset resolution and
+  // mounting debugfs) touches state shared across all BCCWrapper instances, which may be
+  // initializing concurrently (Stirling initializes its source connectors in parallel).
+  // Serialize the setup; the BPF compilation itself runs unlocked.
+  static std::mutex env_setup_mu;
+  std::unique_lock<std::mutex> env_setup_lock(env_setup_mu);
+
   if (requires_linux_headers) {
     auto kernel_version = utils::GetCachedKernelVersion();
 
@@ -165,6 +179,8 @@ Status BCCWrapper::InitBPFProgram(std::string_view bpf_program, std::vector<std:
 
   PL_RETURN_IF_ERROR(MountDebugFS());
 
+  env_setup_lock.unlock();
+
   auto init_res = bpf_.init(std::string(bpf_program), cflags);
   if (!init_res.ok()) {
     return error::Internal("Unable to initialize BCC BPF program: $0", init_res.msg());
@@ -345,9 +361,36 @@ Status BCCWrapper::OpenPerfBuffer(const PerfBufferSpec& perf_buffer, void* cb_co
   LOG(INFO) << absl::Substitute(
       "Opening perf buffer: $0 [requested_size=$1 num_pages=$2 size=$3] (per cpu)",
       perf_buffer.name, perf_buffer.size_bytes, num_pages, num_pages * kPageSizeBytes);
-  PL_RETURN_IF_ERROR(bpf_.open_perf_buffer(std::string(perf_buffer.name),
-                                           perf_buffer.probe_output_fn, perf_buffer.probe_loss_fn,
-                                           cb_cookie, num_pages));
+
+  perf_reader_raw_cb output_fn = perf_buffer.probe_output_fn;
+  perf_reader_lost_cb loss_fn = perf_buffer.probe_loss_fn;
+  void* cookie = cb_cookie;
+  if (FLAGS_stirling_numa_local_perf_polling) {
+    // Interpose a handoff queue: the pinned drain thread enqueues raw events, and the
+    // original callbacks are replayed from the consumer thread in PollPerfBuffers().
+    drain_queues_.push_back(std::make_unique<PerfBufferDrainQueue>(
+        std::string(perf_buffer.name),
+        [fn = perf_buffer.probe_output_fn, cb_cookie](void* data, int data_size) {
+          if (fn != nullptr) {
+            fn(cb_cookie, data, data_size);
+          }
+        },
+        [fn = perf_buffer.probe_loss_fn, cb_cookie](uint64_t lost) {
+          if (fn != nullptr) {
+            fn(cb_cookie, lost);
+          }
+        }));
+    cookie = drain_queues_.back().get();
+    output_fn = [](void* q, void* data, int data_size) {
+      static_cast<PerfBufferDrainQueue*>(q)->Enqueue(data, data_size);
+    };
+    loss_fn = [](void* q, uint64_t lost) {
+      static_cast<PerfBufferDrainQueue*>(q)->AddLoss(lost);
+    };
+  }
+
+  PL_RETURN_IF_ERROR(bpf_.open_perf_buffer(std::string(perf_buffer.name), output_fn, loss_fn,
+                                           cookie, num_pages));
   perf_buffers_.push_back(perf_buffer);
   ++num_open_perf_buffers_;
   return Status::OK();
@@ -360,6 +403,55 @@ Status BCCWrapper::OpenPerfBuffers(const ArrayView<PerfBufferSpec>& perf_buffers
   return Status::OK();
 }
 
+bool BCCWrapper::RingBufferSupported() {
+  // BPF_MAP_TYPE_RINGBUF was introduced in Linux 5.8.
+  constexpr uint32_t kLinux5p8VersionCode = 329728;
+  return utils::GetCachedKernelVersion().code() >= kLinux5p8VersionCode;
+}
+
+Status BCCWrapper::OpenRingBuffer(const RingBufferSpec& ring_buffer, void* cb_cookie) {
+  if (!RingBufferSupported()) {
+    if (ring_buffer.fallback_perf_buffer.has_value()) {
+      LOG(INFO) << absl::Substitute(
+          "Kernel does not support BPF ring buffers, falling back to perf buffer: $0",
+          ring_buffer.fallback_perf_buffer->name);
+      return OpenPerfBuffer(ring_buffer.fallback_perf_buffer.value(), cb_cookie);
+    }
+    return error::Unimplemented("BPF ring buffers require Linux 5.8 or later.");
+  }
+
+  // The ring buffer size is declared in the BPF program (BPF_RINGBUF_OUTPUT), and the buffer is
+  // shared across all CPUs, so there is no per-CPU page accounting to do here.
+  LOG(INFO) << absl::Substitute("Opening ring buffer: $0 (shared across CPUs)", ring_buffer.name);
+  PL_RETURN_IF_ERROR(bpf_.open_ring_buf(ring_buffer.name, ring_buffer.probe_output_fn, cb_cookie));
+  ring_buffers_.push_back(ring_buffer);
+  ++num_open_ring_buffers_;
+  return Status::OK();
+}
+
+Status BCCWrapper::OpenRingBuffers(const ArrayView<RingBufferSpec>& ring_buffers,
+                                   void* cb_cookie) {
+  for (const RingBufferSpec& r : ring_buffers) {
+    PL_RETURN_IF_ERROR(OpenRingBuffer(r, cb_cookie));
+  }
+  return Status::OK();
+}
+
+Status BCCWrapper::CloseRingBuffer(const RingBufferSpec& ring_buffer) {
+  VLOG(1) << "Closing ring buffer: " << ring_buffer.name;
+  PL_RETURN_IF_ERROR(bpf_.close_ring_buf(ring_buffer.name));
+  --num_open_ring_buffers_;
+  return Status::OK();
+}
+
+void BCCWrapper::CloseRingBuffers() {
+  for (const RingBufferSpec& r : ring_buffers_) {
+    auto res = CloseRingBuffer(r);
+    LOG_IF(ERROR, !res.ok()) << res.msg();
+  }
+  ring_buffers_.clear();
+}
+
 Status BCCWrapper::ClosePerfBuffer(const PerfBufferSpec& perf_buffer) {
   VLOG(1) << "Closing perf buffer: " << perf_buffer.name;
   PL_RETURN_IF_ERROR(bpf_.close_perf_buffer(std::string(perf_buffer.name)));
@@ -368,6 +460,7 @@ Status BCCWrapper::ClosePerfBuffer(const PerfBufferSpec& perf_buffer) {
 }
 
 void BCCWrapper::ClosePerfBuffers() {
+  StopDrainThreads();
   for (const PerfBufferSpec& p : perf_buffers_) {
     auto res = ClosePerfBuffer(p);
     LOG_IF(ERROR, !res.ok()) << res.msg();
@@ -418,6 +511,16 @@ std::string BCCWrapper::GetKProbeTargetName(const KProbeSpec& probe) {
 }
 
 void BCCWrapper::PollPerfBuffer(std::string_view perf_buffer_name, int timeout_ms) {
+  if (!drain_queues_.empty()) {
+    StartDrainThreads();
+    for (auto& queue : drain_queues_) {
+      if (queue->name() == perf_buffer_name) {
+        queue->Consume();
+        return;
+      }
+    }
+    return;
+  }
   auto perf_buffer = bpf_.get_perf_buffer(std::string(perf_buffer_name));
   if (perf_buffer != nullptr) {
     perf_buffer->poll(timeout_ms);
@@ -425,13 +528,69 @@ void BCCWrapper::PollPerfBuffer(std::string_view perf_buffer_name, int timeout_m
 }
 
 void BCCWrapper::PollPerfBuffers(int timeout_ms) {
+  if (!drain_queues_.empty()) {
+    // Handoff mode: the pinned drain threads poll the kernel buffers; here we only replay the
+    // queued events, so the callbacks still run on the calling thread.
+    StartDrainThreads();
+    for (auto& queue : drain_queues_) {
+      queue->Consume();
+    }
+    return;
+  }
   for (const auto& spec : perf_buffers_) {
     PollPerfBuffer(spec.name, timeout_ms);
   }
 }
 
+// Poll timeout used by the drain threads. Bounds both the threads' wake-up cadence when a
+// buffer is idle and the join latency in StopDrainThreads().
+constexpr int kDrainPollTimeoutMs = 100;
+
+void BCCWrapper::StartDrainThreads() {
+  if (!drain_threads_.empty() || drain_queues_.empty()) {
+    return;
+  }
+  // BCC drains all of a named buffer's per-CPU readers from a single poll call, so one thread
+  // per buffer, spread round-robin across NUMA nodes, is the finest placement granularity
+  // available. The 128-core hosts this targets also run many buffers, so the spread works out.
+  const std::vector<std::vector<int>> node_cpus = NumaNodeCpus();
+  drain_threads_stop_ = false;
+  for (size_t i = 0; i < drain_queues_.size(); ++i) {
+    ebpf::BPFPerfBuffer* perf_buffer = bpf_.get_perf_buffer(drain_queues_[i]->name());
+    if (perf_buffer == nullptr) {
+      LOG(WARNING) << absl::Substitute("Perf buffer $0 not found; it will not be drained.",
+                                       drain_queues_[i]->name());
+      continue;
+    }
+    const std::vector<int>& cpus = node_cpus[i % node_cpus.size()];
+    drain_threads_.emplace_back([this, perf_buffer, cpus]() {
+      PinThreadToCpus(cpus);
+      while (!drain_threads_stop_.load(std::memory_order_relaxed)) {
+        perf_buffer->poll(kDrainPollTimeoutMs);
+      }
+    });
+  }
+}
+
+void BCCWrapper::StopDrainThreads() {
+  drain_threads_stop_ = true;
+  for (auto& thread : drain_threads_) {
+    thread.join();
+  }
+  drain_threads_.clear();
+  drain_queues_.clear();
+}
+
+void BCCWrapper::PollRingBuffers(int timeout_ms) {
+  for (const auto& spec : ring_buffers_) {
+    // BCC drains the ring buffer through an epoll wait on the shared buffer's fd.
+    bpf_.poll_ring_buf(spec.name, timeout_ms);
+  }
+}
+
 void BCCWrapper::Close() {
   DetachPerfEvents();
+  CloseRingBuffers();
   ClosePerfBuffers();
   DetachKProbes();
   DetachUProbes();
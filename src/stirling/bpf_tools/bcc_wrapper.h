@@ -34,16 +34,20 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <atomic>
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "src/common/base/base.h"
 #include "src/common/json/json.h"
+#include "src/stirling/bpf_tools/perf_buffer_drainer.h"
 #include "src/stirling/bpf_tools/task_struct_resolver.h"
 #include "src/stirling/obj_tools/elf_reader.h"
 
@@ -196,6 +200,28 @@ struct PerfBufferSpec {
   PerfBufferSizeCategory size_category = PerfBufferSizeCategory::kUncategorized;
 };
 
+/**
+ * Describes a BPF ring buffer (BPF_MAP_TYPE_RINGBUF), through which data is returned to
+ * user-space on kernels 5.8+. Unlike perf buffers, the buffer is shared across all CPUs, so
+ * memory does not scale with core count, and reservation-based submission avoids dropping
+ * events under bursts.
+ */
+struct RingBufferSpec {
+  // Name of the ring buffer.
+  // Must be the same as the ring buffer name declared in the probe code with BPF_RINGBUF_OUTPUT.
+  std::string name;
+
+  // Function that will be called for every event in the ring buffer,
+  // when ring buffer read is triggered.
+  ring_buffer_sample_fn probe_output_fn;
+
+  // Ring buffers require kernel support (see BCCWrapper::RingBufferSupported()). If the kernel
+  // is too old and a fallback is provided, the fallback perf buffer is opened instead.
+  // The BPF program must declare the matching output type, so callers should also use
+  // RingBufferSupported() to select the BPF program variant to deploy.
+  std::optional<PerfBufferSpec> fallback_perf_buffer;
+};
+
 /**
  * Describes a perf event to attach.
  * This can be run stand-alone and is not dependent on kProbes.
@@ -295,6 +321,24 @@ class BCCWrapper {
    */
   Status OpenPerfBuffer(const PerfBufferSpec& perf_buffer, void* cb_cookie = nullptr);
 
+  /**
+   * Whether the host kernel supports BPF ring buffers (BPF_MAP_TYPE_RINGBUF, Linux 5.8+).
+   * Callers use this to select between the ring buffer and perf buffer variants of their
+   * BPF program before calling OpenRingBuffer().
+   */
+  static bool RingBufferSupported();
+
+  /**
+   * Open a ring buffer for reading events.
+   * If the kernel does not support ring buffers, falls back to opening the spec's fallback perf
+   * buffer (if provided), otherwise returns an error.
+   * @param ring_buffer Specifications of the ring buffer (name, callback function, etc.).
+   * @param cb_cookie A pointer that is sent to the callback function when triggered by
+   * PollRingBuffers().
+   * @return Error if the ring buffer cannot be opened (e.g. ring buffer does not exist).
+   */
+  Status OpenRingBuffer(const RingBufferSpec& ring_buffer, void* cb_cookie = nullptr);
+
   /**
    * Attach a perf event, which runs a probe every time a perf counter reaches a threshold
    * condition.
@@ -344,6 +388,14 @@ class BCCWrapper {
    */
   Status OpenPerfBuffers(const ArrayView<PerfBufferSpec>& perf_buffers, void* cb_cookie);
 
+  /**
+   * Convenience function that opens multiple ring buffers.
+   * @param ring_buffers Vector of ring buffer descriptors.
+   * @param cb_cookie Raw pointer returned on callback, typically used for tracking context.
+   * @return Error of first failure (remaining ring buffer opens are not attempted).
+   */
+  Status OpenRingBuffers(const ArrayView<RingBufferSpec>& ring_buffers, void* cb_cookie);
+
   /**
    * Convenience function that opens multiple perf events.
    * @param probes Vector of perf event descriptors.
@@ -371,6 +423,10 @@ class BCCWrapper {
    * Drains all of the opened perf buffers, calling the handle function that was
    * specified in the PerfBufferSpec when OpenPerfBuffer was called.
    *
+   * With --stirling_numa_local_perf_polling, the kernel buffers are instead drained
+   * continuously by dedicated threads pinned across NUMA nodes, and this call only replays the
+   * handed-off events, so the handle functions always run on the calling thread either way.
+   *
    * @param timeout_ms If there's no event in the perf buffer, then timeout_ms specifies the
    *                   amount of time to wait for an event to arrive before returning.
    *                   Default is 0, because if nothing is ready, then we want to go back to sleep
@@ -379,7 +435,24 @@ class BCCWrapper {
   void PollPerfBuffers(int timeout_ms = 0);
 
   /**
-   * Detaches all probes, and closes all perf buffers that are open.
+   * Drains a single perf buffer by name. Used by connectors that schedule their own per-buffer
+   * drain cadence instead of draining everything via PollPerfBuffers().
+   */
+  void PollPerfBuffer(std::string_view perf_buffer_name, int timeout_ms = 0);
+
+  /**
+   * Drains all of the opened ring buffers via epoll, calling the handle function that was
+   * specified in the RingBufferSpec when OpenRingBuffer was called.
+   * Note: ring buffers that fell back to perf buffers are drained by PollPerfBuffers() instead,
+   * so connectors that may run on older kernels should call both.
+   *
+   * @param timeout_ms Amount of time to wait for an event to arrive before returning if no
+   *                   event is available.
+   */
+  void PollRingBuffers(int timeout_ms = 0);
+
+  /**
+   * Detaches all probes, and closes all perf buffers and ring buffers that are open.
    */
   void Close();
 
@@ -415,6 +488,7 @@ class BCCWrapper {
   // It is meant for verification that we have cleaned-up all resources in tests.
   static size_t num_attached_probes() { return num_attached_kprobes_ + num_attached_uprobes_; }
   static size_t num_open_perf_buffers() { return num_open_perf_buffers_; }
+  static size_t num_open_ring_buffers() { return num_open_ring_buffers_; }
   static size_t num_attached_perf_events() { return num_attached_perf_events_; }
 
  private:
@@ -424,8 +498,8 @@ class BCCWrapper {
   Status DetachUProbe(const UProbeSpec& probe);
   Status DetachTracepoint(const TracepointSpec& probe);
   Status ClosePerfBuffer(const PerfBufferSpec& perf_buffer);
+  Status CloseRingBuffer(const RingBufferSpec& ring_buffer);
   Status DetachPerfEvent(const PerfEventSpec& perf_event);
-  void PollPerfBuffer(std::string_view perf_buffer_name, int timeout_ms);
 
   // Detaches all kprobes/uprobes/perf buffers/perf events that were attached by the wrapper.
   // If any fails to detach, an error is logged, and the function continues.
@@ -433,17 +507,36 @@ class BCCWrapper {
   void DetachUProbes();
   void DetachTracepoints();
   void ClosePerfBuffers();
+  void CloseRingBuffers();
   void DetachPerfEvents();
 
   // Returns the name that identifies the target to attach this k-probe.
   std::string GetKProbeTargetName(const KProbeSpec& probe);
 
+  // Spawns one drain thread per perf buffer, pinned round-robin across NUMA nodes (see
+  // --stirling_numa_local_perf_polling). Called lazily on the first poll, so that all perf
+  // buffers have been opened by then. A no-op when the threads are already running or the
+  // flag is disabled (no drain queues exist).
+  void StartDrainThreads();
+
+  // Stops and joins the drain threads, and discards the handoff queues. Must be called before
+  // the perf buffers are closed, since the threads poll them.
+  void StopDrainThreads();
+
   std::vector<KProbeSpec> kprobes_;
   std::vector<UProbeSpec> uprobes_;
   std::vector<TracepointSpec> tracepoints_;
   std::vector<PerfBufferSpec> perf_buffers_;
+  std::vector<RingBufferSpec> ring_buffers_;
   std::vector<PerfEventSpec> perf_events_;
 
+  // Populated only with --stirling_numa_local_perf_polling: one handoff queue and one pinned
+  // drain thread per perf buffer. Non-empty drain_queues_ is what switches the poll paths to
+  // handoff mode.
+  std::vector<std::unique_ptr<PerfBufferDrainQueue>> drain_queues_;
+  std::vector<std::thread> drain_threads_;
+  std::atomic<bool> drain_threads_stop_ = false;
+
   std::string system_headers_include_dir_;
 
   // Initialize this with one of the below bitmask flags to turn on different debug output.
@@ -462,11 +555,13 @@ class BCCWrapper {
   // 1) We want to ensure we have cleaned all BPF resources up across *all* instances (no leaks).
   // 2) It is for verification only, and it doesn't make sense to create accessors from stirling to
   // here.
-  inline static size_t num_attached_kprobes_;
-  inline static size_t num_attached_uprobes_;
-  inline static size_t num_attached_tracepoints_;
-  inline static size_t num_open_perf_buffers_;
-  inline static size_t num_attached_perf_events_;
+  // They are atomic because BCCWrapper instances may be initialized on concurrent threads.
+  inline static std::atomic<size_t> num_attached_kprobes_;
+  inline static std::atomic<size_t> num_attached_uprobes_;
+  inline static std::atomic<size_t> num_attached_tracepoints_;
+  inline static std::atomic<size_t> num_open_perf_buffers_;
+  inline static std::atomic<size_t> num_open_ring_buffers_;
+  inline static std::atomic<size_t> num_attached_perf_events_;
 
  private:
   // This is shared by all source connectors that uses BCCWrapper.
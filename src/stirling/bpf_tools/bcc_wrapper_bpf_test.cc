@@ -251,6 +251,61 @@ int on_sched_process_exit(struct tracepoint__sched__sched_process_exit* args) {
   ASSERT_OK(bcc_wrapper.AttachTracepoint(probe_spec));
 }
 
+namespace {
+int RingBufferTestEventCount(void* cb_cookie, void* /*data*/, size_t /*data_size*/) {
+  ++(*static_cast<int*>(cb_cookie));
+  return 0;
+}
+}  // namespace
+
+TEST(BCCWrapperTest, RingBuffer) {
+  if (!BCCWrapper::RingBufferSupported()) {
+    LOG(INFO) << "Kernel does not support BPF ring buffers (requires 5.8+). Skipping.";
+    return;
+  }
+
+  bpf_tools::BCCWrapper bcc_wrapper;
+
+  std::string_view program = R"(
+BPF_RINGBUF_OUTPUT(events, 8);
+int probe_fn(struct pt_regs* ctx) {
+  uint64_t id = bpf_get_current_pid_tgid();
+  events.ringbuf_output(&id, sizeof(id), 0);
+  return 0;
+}
+  )";
+
+  ASSERT_OK(bcc_wrapper.InitBPFProgram(program));
+
+  ASSERT_OK_AND_ASSIGN(std::filesystem::path self_path, fs::ReadSymlink("/proc/self/exe"));
+
+  // Use address instead of symbol to specify this probe,
+  // so that even if debug symbols are stripped, the uprobe can still attach.
+  uint64_t symbol_addr = reinterpret_cast<uint64_t>(&BCCWrapperTestProbeTrigger);
+
+  UProbeSpec uprobe{.binary_path = self_path,
+                    .symbol = {},  // Keep GCC happy.
+                    .address = symbol_addr,
+                    .attach_type = BPFProbeAttachType::kEntry,
+                    .probe_fn = "probe_fn"};
+  ASSERT_OK(bcc_wrapper.AttachUProbe(uprobe));
+
+  int event_count = 0;
+  RingBufferSpec ringbuf_spec = {
+      .name = "events",
+      .probe_output_fn = &RingBufferTestEventCount,
+  };
+  ASSERT_OK(bcc_wrapper.OpenRingBuffer(ringbuf_spec, &event_count));
+  EXPECT_EQ(1, BCCWrapper::num_open_ring_buffers());
+
+  BCCWrapperTestProbeTrigger();
+  bcc_wrapper.PollRingBuffers();
+  EXPECT_EQ(1, event_count);
+
+  bcc_wrapper.Close();
+  EXPECT_EQ(0, BCCWrapper::num_open_ring_buffers());
+}
+
 }  // namespace bpf_tools
 }  // namespace stirling
 }  // namespace px
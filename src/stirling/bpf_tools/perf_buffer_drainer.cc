@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/bpf_tools/perf_buffer_drainer.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <filesystem>
+
+#include <absl/strings/match.h>
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_split.h>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace stirling {
+namespace bpf_tools {
+
+void PerfBufferDrainQueue::Enqueue(const void* data, int data_size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  std::lock_guard<std::mutex> lock(lock_);
+  if (queued_bytes_ + static_cast<size_t>(data_size) > kMaxQueuedBytes) {
+    ++lost_;
+    return;
+  }
+  events_.emplace_back(bytes, bytes + data_size);
+  queued_bytes_ += data_size;
+}
+
+void PerfBufferDrainQueue::AddLoss(uint64_t lost) {
+  std::lock_guard<std::mutex> lock(lock_);
+  lost_ += lost;
+}
+
+void PerfBufferDrainQueue::Consume() {
+  std::deque<std::vector<uint8_t>> events;
+  uint64_t lost;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    events.swap(events_);
+    queued_bytes_ = 0;
+    lost = lost_;
+    lost_ = 0;
+  }
+  if (data_fn_) {
+    for (auto& event : events) {
+      data_fn_(event.data(), static_cast<int>(event.size()));
+    }
+  }
+  if (lost > 0 && loss_fn_) {
+    loss_fn_(lost);
+  }
+}
+
+std::vector<int> ParseCpuList(std::string_view cpulist) {
+  std::vector<int> cpus;
+  for (std::string_view part : absl::StrSplit(cpulist, ',', absl::SkipWhitespace())) {
+    part = absl::StripAsciiWhitespace(part);
+    int first = 0;
+    int last = 0;
+    size_t dash_pos = part.find('-');
+    if (dash_pos == std::string_view::npos) {
+      if (!absl::SimpleAtoi(part, &first)) {
+        continue;
+      }
+      last = first;
+    } else if (!absl::SimpleAtoi(part.substr(0, dash_pos), &first) ||
+               !absl::SimpleAtoi(part.substr(dash_pos + 1), &last) || last < first) {
+      continue;
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::vector<std::vector<int>> NumaNodeCpus() {
+  std::vector<std::vector<int>> nodes;
+  const std::filesystem::path kNodeDir = "/sys/devices/system/node";
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(kNodeDir, ec)) {
+    const std::string basename = entry.path().filename().string();
+    if (!absl::StartsWith(basename, "node")) {
+      continue;
+    }
+    auto cpulist_or_s = ReadFileToString((entry.path() / "cpulist").string());
+    if (!cpulist_or_s.ok()) {
+      continue;
+    }
+    std::vector<int> cpus = ParseCpuList(cpulist_or_s.ValueOrDie());
+    if (!cpus.empty()) {
+      nodes.push_back(std::move(cpus));
+    }
+  }
+  if (nodes.empty()) {
+    // Topology unavailable: return one "node" with no CPUs, so callers still get a
+    // round-robin target and pinning degrades to a no-op.
+    nodes.emplace_back();
+  }
+  return nodes;
+}
+
+void PinThreadToCpus(const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &cpuset);
+  }
+  int retval = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+  LOG_IF(WARNING, retval != 0) << absl::Substitute(
+      "Failed to pin perf buffer drain thread to its NUMA node's CPUs, error: $0", retval);
+}
+
+}  // namespace bpf_tools
+}  // namespace stirling
+}  // namespace px
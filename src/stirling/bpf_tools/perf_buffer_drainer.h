@@ -0,0 +1,104 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace px {
+namespace stirling {
+namespace bpf_tools {
+
+/**
+ * PerfBufferDrainQueue hands events off between a perf buffer drain thread and the consumer
+ * thread. The drain thread (pinned near the buffer's producer CPUs, see
+ * --stirling_numa_local_perf_polling) copies each event into the queue as it is popped from
+ * the kernel's per-CPU pages; the consumer replays the events through the original callbacks
+ * on its next PollPerfBuffers() call, so callbacks keep their single-threaded semantics.
+ */
+class PerfBufferDrainQueue {
+ public:
+  using DataFn = std::function<void(void* data, int data_size)>;
+  using LossFn = std::function<void(uint64_t lost)>;
+
+  PerfBufferDrainQueue(std::string name, DataFn data_fn, LossFn loss_fn)
+      : name_(std::move(name)), data_fn_(std::move(data_fn)), loss_fn_(std::move(loss_fn)) {}
+
+  /**
+   * Enqueue copies one event into the queue. Called from the drain thread. If the queue has
+   * grown past its byte limit (the consumer has stalled), the event is dropped and accounted
+   * as a loss, mirroring what the kernel would do if the perf buffer itself overflowed.
+   */
+  void Enqueue(const void* data, int data_size);
+
+  /**
+   * AddLoss accumulates kernel-reported lost samples. Called from the drain thread.
+   */
+  void AddLoss(uint64_t lost);
+
+  /**
+   * Consume replays all queued events, and any accumulated loss, through the callbacks given
+   * at construction. Called from the consumer thread.
+   */
+  void Consume();
+
+  const std::string& name() const { return name_; }
+
+ private:
+  // Upper bound on queued bytes; above this, events are dropped and counted as losses.
+  static constexpr size_t kMaxQueuedBytes = 64 * 1024 * 1024;
+
+  std::string name_;
+  DataFn data_fn_;
+  LossFn loss_fn_;
+
+  std::mutex lock_;
+  std::deque<std::vector<uint8_t>> events_;
+  size_t queued_bytes_ = 0;
+  uint64_t lost_ = 0;
+};
+
+/**
+ * ParseCpuList parses a sysfs cpulist string (e.g. "0-3,8,10-11") into CPU numbers.
+ * Malformed entries are skipped.
+ */
+std::vector<int> ParseCpuList(std::string_view cpulist);
+
+/**
+ * NumaNodeCpus returns the CPUs of each NUMA node, read from
+ * /sys/devices/system/node/node*/cpulist. If the topology cannot be read (eg. inside some
+ * containers), returns a single entry with an empty CPU list, for which pinning is a no-op.
+ */
+std::vector<std::vector<int>> NumaNodeCpus();
+
+/**
+ * PinThreadToCpus pins the calling thread to the given CPUs. Best effort: failures are logged
+ * and otherwise ignored. A no-op for an empty CPU list.
+ */
+void PinThreadToCpus(const std::vector<int>& cpus);
+
+}  // namespace bpf_tools
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/bpf_tools/perf_buffer_drainer.h"
+
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+namespace bpf_tools {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(ParseCpuListTest, Basic) {
+  EXPECT_THAT(ParseCpuList("0"), ElementsAre(0));
+  EXPECT_THAT(ParseCpuList("0-3"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(ParseCpuList("0-2,8,10-11"), ElementsAre(0, 1, 2, 8, 10, 11));
+  EXPECT_THAT(ParseCpuList("0-3,8-11\n"), ElementsAre(0, 1, 2, 3, 8, 9, 10, 11));
+  EXPECT_THAT(ParseCpuList(""), IsEmpty());
+  EXPECT_THAT(ParseCpuList("garbage,1"), ElementsAre(1));
+}
+
+TEST(PerfBufferDrainQueueTest, ReplaysEventsAndLossInOrder) {
+  std::vector<std::string> events;
+  uint64_t lost = 0;
+  PerfBufferDrainQueue queue(
+      "test",
+      [&events](void* data, int data_size) {
+        events.emplace_back(static_cast<const char*>(data), data_size);
+      },
+      [&lost](uint64_t num_lost) { lost += num_lost; });
+
+  // Nothing queued: Consume is a no-op.
+  queue.Consume();
+  EXPECT_THAT(events, IsEmpty());
+
+  std::string a = "abc";
+  std::string b = "de";
+  queue.Enqueue(a.data(), a.size());
+  queue.Enqueue(b.data(), b.size());
+  queue.AddLoss(3);
+
+  // Events are held until the consumer asks for them.
+  EXPECT_THAT(events, IsEmpty());
+
+  queue.Consume();
+  EXPECT_THAT(events, ElementsAre("abc", "de"));
+  EXPECT_EQ(lost, 3);
+
+  // The queue is drained by Consume.
+  queue.Consume();
+  EXPECT_THAT(events, ElementsAre("abc", "de"));
+  EXPECT_EQ(lost, 3);
+}
+
+}  // namespace bpf_tools
+}  // namespace stirling
+}  // namespace px
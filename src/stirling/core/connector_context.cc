@@ -18,6 +18,10 @@
 
 #include "src/stirling/core/connector_context.h"
 
+#include <vector>
+
+#include "src/common/fs/batch_file_reader.h"
+
 namespace px {
 namespace stirling {
 
@@ -78,21 +82,39 @@ StandaloneContext::StandaloneContext(absl::flat_hash_set<md::UPID> upids,
 
 // Returns the list of processes from the proc filesystem. Used by StandaloneContext.
 absl::flat_hash_set<md::UPID> ListUPIDs(const std::filesystem::path& proc_path, uint32_t asid) {
-  absl::flat_hash_set<md::UPID> pids;
+  // First pass: collect the numeric /proc entries and their stat file paths.
+  std::vector<uint32_t> pids;
+  std::vector<std::string> stat_paths;
   for (const auto& p : std::filesystem::directory_iterator(proc_path)) {
     uint32_t pid = 0;
     if (!absl::SimpleAtoi(p.path().filename().string(), &pid)) {
       continue;
     }
-    StatusOr<int64_t> pid_start_time = system::GetPIDStartTimeTicks(p.path());
+    pids.push_back(pid);
+    stat_paths.push_back(p.path().string() + "/stat");
+  }
+
+  // Batch-read all of the stat files. With io_uring available, the whole scan's reads are
+  // submitted with a handful of syscalls instead of one read() per pid.
+  fs::BatchFileReader reader;
+  std::vector<std::string> stat_contents;
+  std::vector<Status> statuses = reader.ReadFiles(stat_paths, &stat_contents);
+
+  absl::flat_hash_set<md::UPID> upids;
+  for (size_t i = 0; i < pids.size(); ++i) {
+    if (!statuses[i].ok()) {
+      VLOG(1) << absl::Substitute("Could not read $0. PID is likely already dead.", stat_paths[i]);
+      continue;
+    }
+    StatusOr<int64_t> pid_start_time = system::ParsePIDStartTimeTicks(stat_contents[i]);
     if (!pid_start_time.ok()) {
       VLOG(1) << absl::Substitute("Could not get PID start time for pid $0. Likely already dead.",
-                                  p.path().string());
+                                  pids[i]);
       continue;
     }
-    pids.emplace(asid, pid, pid_start_time.ValueOrDie());
+    upids.emplace(asid, pids[i], pid_start_time.ValueOrDie());
   }
-  return pids;
+  return upids;
 }
 
 SystemWideStandaloneContext::SystemWideStandaloneContext(const std::filesystem::path& proc_path)
@@ -42,9 +42,8 @@ void DataTable::InitBuffers(types::ColumnWrapperRecordBatch* record_batch_ptr) {
   for (const auto& element : table_schema_.elements()) {
     px::types::DataType type = element.type();
 
-#define TYPE_CASE(_dt_)                           \
-  auto col = types::ColumnWrapper::Make(_dt_, 0); \
-  col->Reserve(kTargetCapacity);                  \
+#define TYPE_CASE(_dt_)                                            \
+  auto col = types::ColumnWrapper::Make(_dt_, 0, kTargetCapacity); \
   record_batch_ptr->push_back(col);
     PL_SWITCH_FOREACH_DATATYPE(type, TYPE_CASE);
 #undef TYPE_CASE
@@ -65,9 +64,6 @@ std::vector<TaggedRecordBatch> DataTable::ConsumeRecords() {
   uint64_t next_start_time = start_time_;
 
   for (auto& [tablet_id, tablet] : tablets_) {
-    // Sort based on times.
-    std::vector<size_t> sort_indexes = utils::SortedIndexes(tablet.times);
-
     // End time is cutoff time + 1, so call to SplitSortedVector() produces the following
     // classification: which classified according to:
     //   expired < start_time
@@ -75,6 +71,20 @@ std::vector<TaggedRecordBatch> DataTable::ConsumeRecords() {
     uint64_t end_time = cutoff_time_.has_value() ? (cutoff_time_.value() + 1)
                                                  : std::numeric_limits<uint64_t>::max();
 
+    // Fast path: when every record is pushable (nothing expired, nothing to carry over) and the
+    // records are already in time order, hand off the column buffers wholesale. Ownership of the
+    // buffers transfers pointer-wise all the way into the destination Table's hot store (see
+    // Table::TransferRecordBatch), so this avoids re-writing every record via MoveIndexes().
+    if (!tablet.times.empty() && std::is_sorted(tablet.times.begin(), tablet.times.end()) &&
+        tablet.times.front() >= start_time_ && tablet.times.back() < end_time) {
+      next_start_time = std::max(next_start_time, tablet.times.back());
+      tablets_out.push_back(TaggedRecordBatch{tablet_id, std::move(tablet.records)});
+      continue;
+    }
+
+    // Sort based on times.
+    std::vector<size_t> sort_indexes = utils::SortedIndexes(tablet.times);
+
     // Split the indexes into three groups:
     // 1) Expired indexes: these are too old to return.
     // 2) Pushable indexes: these are the ones that we return.
@@ -17,6 +17,9 @@
  */
 
 #include <algorithm>
+#include <string>
+
+#include <absl/container/flat_hash_set.h>
 
 #include "src/common/base/base.h"
 #include "src/stirling/core/pub_sub_manager.h"
@@ -39,5 +42,48 @@ void PopulatePublishProto(Publish* publish_pb, const InfoClassManagerVec& info_c
   }
 }
 
+void PubSubManager::GeneratePublishProto(Publish* publish_pb,
+                                         const InfoClassManagerVec& info_class_mgrs) {
+  PopulatePublishProto(publish_pb, info_class_mgrs);
+  ++version_;
+  publish_pb->set_version(version_);
+  published_tables_.clear();
+  for (const auto& mgr : info_class_mgrs) {
+    published_tables_[mgr->id()] = std::string(mgr->name());
+  }
+}
+
+bool PubSubManager::GeneratePublishDeltaProto(stirlingpb::PublishDelta* delta_pb,
+                                              const InfoClassManagerVec& info_class_mgrs) {
+  ECHECK(delta_pb != nullptr);
+  absl::flat_hash_set<uint64_t> current_ids;
+  for (const auto& mgr : info_class_mgrs) {
+    current_ids.insert(mgr->id());
+    if (!published_tables_.contains(mgr->id())) {
+      delta_pb->add_added_info_classes()->MergeFrom(mgr->ToProto());
+    }
+  }
+  for (const auto& [id, name] : published_tables_) {
+    if (!current_ids.contains(id)) {
+      delta_pb->add_removed_table_names(name);
+    }
+  }
+
+  if (delta_pb->added_info_classes_size() == 0 && delta_pb->removed_table_names_size() == 0) {
+    return false;
+  }
+
+  delta_pb->set_prev_version(version_);
+  ++version_;
+  delta_pb->set_version(version_);
+
+  for (const auto& info_class : delta_pb->added_info_classes()) {
+    published_tables_[info_class.id()] = info_class.schema().name();
+  }
+  absl::erase_if(published_tables_,
+                 [&current_ids](const auto& kv) { return !current_ids.contains(kv.first); });
+  return true;
+}
+
 }  // namespace stirling
 }  // namespace px
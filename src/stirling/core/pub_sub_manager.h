@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "src/common/base/base.h"
 #include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
 #include "src/stirling/core/info_class_manager.h"
@@ -41,6 +43,37 @@ void PopulatePublishProto(stirlingpb::Publish* publish_pb,
                           const InfoClassManagerVec& info_class_mgrs,
                           std::optional<std::string_view> filter = {});
 
+/**
+ * PubSubManager tracks the last published schema set and produces versioned publications.
+ * A full Publish carries the version of the set it represents; deltas describe only the tables
+ * added or removed since the previous version, so a single dynamic tracepoint deployment does
+ * not force subscribers into a full schema reconciliation.
+ */
+class PubSubManager {
+ public:
+  /**
+   * Generates a full publication of the given info classes, advances the version, and records
+   * the set so later calls to GeneratePublishDeltaProto() can diff against it.
+   */
+  void GeneratePublishProto(stirlingpb::Publish* publish_pb,
+                            const InfoClassManagerVec& info_class_mgrs);
+
+  /**
+   * Generates a delta publication: info classes added since the last Generate* call, and names
+   * of tables removed. Returns true and advances the version only if the set changed; an
+   * unchanged set leaves delta_pb empty.
+   */
+  bool GeneratePublishDeltaProto(stirlingpb::PublishDelta* delta_pb,
+                                 const InfoClassManagerVec& info_class_mgrs);
+
+  uint64_t version() const { return version_; }
+
+ private:
+  uint64_t version_ = 0;
+  // The last published set: info class id -> table name.
+  absl::flat_hash_map<uint64_t, std::string> published_tables_;
+};
+
 /**
  * Utility function to index a publish message by ID, for quick access.
  */
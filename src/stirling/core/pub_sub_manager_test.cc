@@ -213,5 +213,45 @@ TEST_F(PubSubManagerTest, partial_publish_test) {
   EXPECT_TRUE(MessageDifferencer::Equals(actual_publish_pb, expected_publish_pb));
 }
 
+// Tests that delta publications report only tables added or removed since the last
+// publication, with consecutive versions.
+TEST_F(PubSubManagerTest, delta_publish_test) {
+  PubSubManager pub_sub_mgr;
+
+  // Initial full publication of just the first info class.
+  InfoClassManagerVec first_mgr;
+  first_mgr.push_back(std::move(info_class_mgrs_[0]));
+  stirlingpb::Publish publish_pb;
+  pub_sub_mgr.GeneratePublishProto(&publish_pb, first_mgr);
+  EXPECT_EQ(publish_pb.version(), 1);
+  EXPECT_EQ(publish_pb.published_info_classes_size(), 1);
+
+  // No changes: the delta is empty and the version does not advance.
+  stirlingpb::PublishDelta empty_delta_pb;
+  EXPECT_FALSE(pub_sub_mgr.GeneratePublishDeltaProto(&empty_delta_pb, first_mgr));
+  EXPECT_EQ(pub_sub_mgr.version(), 1);
+
+  // Adding the second info class produces a delta with only the new table.
+  first_mgr.push_back(std::move(info_class_mgrs_[1]));
+  stirlingpb::PublishDelta add_delta_pb;
+  EXPECT_TRUE(pub_sub_mgr.GeneratePublishDeltaProto(&add_delta_pb, first_mgr));
+  EXPECT_EQ(add_delta_pb.prev_version(), 1);
+  EXPECT_EQ(add_delta_pb.version(), 2);
+  ASSERT_EQ(add_delta_pb.added_info_classes_size(), 1);
+  EXPECT_EQ(add_delta_pb.added_info_classes(0).schema().name(), "my_table");
+  EXPECT_EQ(add_delta_pb.removed_table_names_size(), 0);
+
+  // Removing the first info class produces a delta with only the removed table name.
+  InfoClassManagerVec second_mgr;
+  second_mgr.push_back(std::move(first_mgr[1]));
+  stirlingpb::PublishDelta remove_delta_pb;
+  EXPECT_TRUE(pub_sub_mgr.GeneratePublishDeltaProto(&remove_delta_pb, second_mgr));
+  EXPECT_EQ(remove_delta_pb.prev_version(), 2);
+  EXPECT_EQ(remove_delta_pb.version(), 3);
+  EXPECT_EQ(remove_delta_pb.added_info_classes_size(), 0);
+  ASSERT_EQ(remove_delta_pb.removed_table_names_size(), 1);
+  EXPECT_EQ(remove_delta_pb.removed_table_names(0), "cpu");
+}
+
 }  // namespace stirling
 }  // namespace px
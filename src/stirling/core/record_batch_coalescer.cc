@@ -0,0 +1,115 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/core/record_batch_coalescer.h"
+
+#include <memory>
+
+namespace px {
+namespace stirling {
+
+namespace {
+
+size_t RecordBatchBytes(const types::ColumnWrapperRecordBatch& records) {
+  size_t bytes = 0;
+  for (const auto& col : records) {
+    bytes += col->Bytes();
+  }
+  return bytes;
+}
+
+template <types::DataType DT>
+void AppendColumn(types::ColumnWrapper* src_col, types::ColumnWrapper* dst_col) {
+  auto* typed_src = static_cast<typename types::ColumnWrapperType<DT>::type*>(src_col);
+  auto* typed_dst = static_cast<typename types::ColumnWrapperType<DT>::type*>(dst_col);
+  for (size_t i = 0; i < typed_src->Size(); ++i) {
+    typed_dst->Append(std::move((*typed_src)[i]));
+  }
+}
+
+// Appends the contents of src's columns onto dst's columns.
+void AppendRecordBatch(types::ColumnWrapperRecordBatch* src, types::ColumnWrapperRecordBatch* dst) {
+  DCHECK_EQ(src->size(), dst->size());
+  for (size_t i = 0; i < src->size(); ++i) {
+    types::ColumnWrapper* src_col = (*src)[i].get();
+    types::ColumnWrapper* dst_col = (*dst)[i].get();
+    DCHECK(src_col->data_type() == dst_col->data_type());
+#define TYPE_CASE(_dt_) AppendColumn<_dt_>(src_col, dst_col)
+    PL_SWITCH_FOREACH_DATATYPE(dst_col->data_type(), TYPE_CASE);
+#undef TYPE_CASE
+  }
+}
+
+}  // namespace
+
+void RecordBatchCoalescer::AddRecordBatch(const DataPushCallback& agent_callback,
+                                          uint64_t table_id, types::TabletID tablet_id,
+                                          types::ColumnWrapperRecordBatch records) {
+  const size_t bytes = RecordBatchBytes(records);
+  PendingBatch& pending = pending_[{table_id, tablet_id}];
+  if (pending.records.empty()) {
+    pending.records = std::move(records);
+    pending.first_append_time = px::chrono::coarse_steady_clock::now();
+  } else {
+    AppendRecordBatch(&records, &pending.records);
+  }
+  pending.bytes += bytes;
+
+  if (pending.bytes >= flush_bytes_) {
+    Push(table_id, tablet_id, &pending, agent_callback);
+  }
+}
+
+void RecordBatchCoalescer::PushExpired(const DataPushCallback& agent_callback) {
+  const auto now = px::chrono::coarse_steady_clock::now();
+  for (auto& [key, pending] : pending_) {
+    if (!pending.records.empty() && now - pending.first_append_time >= max_latency_) {
+      Push(key.first, key.second, &pending, agent_callback);
+    }
+  }
+}
+
+void RecordBatchCoalescer::PushAll(const DataPushCallback& agent_callback) {
+  for (auto& [key, pending] : pending_) {
+    Push(key.first, key.second, &pending, agent_callback);
+  }
+}
+
+size_t RecordBatchCoalescer::PendingBytes() const {
+  size_t bytes = 0;
+  for (const auto& [key, pending] : pending_) {
+    bytes += pending.bytes;
+  }
+  return bytes;
+}
+
+void RecordBatchCoalescer::Push(uint64_t table_id, const types::TabletID& tablet_id,
+                                PendingBatch* pending, const DataPushCallback& agent_callback) {
+  if (pending->records.empty()) {
+    return;
+  }
+  Status s = agent_callback(
+      table_id, tablet_id,
+      std::make_unique<types::ColumnWrapperRecordBatch>(std::move(pending->records)));
+  LOG_IF(DFATAL, !s.ok()) << absl::Substitute("Failed to push data. Message = $0", s.msg());
+  pending->records.clear();
+  pending->bytes = 0;
+}
+
+}  // namespace stirling
+}  // namespace px
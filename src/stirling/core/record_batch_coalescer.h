@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/common/base/base.h"
+#include "src/common/system/clock.h"
+#include "src/shared/types/column_wrapper.h"
+#include "src/stirling/core/types.h"
+
+namespace px {
+namespace stirling {
+
+/**
+ * RecordBatchCoalescer accumulates per-(table, tablet) record batches and pushes them through
+ * the data push callback once the pending chunk breaches the byte threshold, or has been held
+ * longer than the latency threshold. This prevents hot tables from producing a stream of tiny
+ * hot-tier batches in the table store, which slow down compaction and scans.
+ */
+class RecordBatchCoalescer {
+ public:
+  RecordBatchCoalescer(size_t flush_bytes, std::chrono::milliseconds max_latency)
+      : flush_bytes_(flush_bytes), max_latency_(max_latency) {}
+
+  /**
+   * Adds a record batch destined for the given table and tablet to its pending chunk.
+   * If the chunk reaches the byte threshold, it is immediately pushed through the callback.
+   */
+  void AddRecordBatch(const DataPushCallback& agent_callback, uint64_t table_id,
+                      types::TabletID tablet_id, types::ColumnWrapperRecordBatch records);
+
+  /**
+   * Pushes all pending chunks that have been held longer than the latency threshold.
+   */
+  void PushExpired(const DataPushCallback& agent_callback);
+
+  /**
+   * Pushes all pending chunks, regardless of thresholds. Used on shutdown.
+   */
+  void PushAll(const DataPushCallback& agent_callback);
+
+  /**
+   * Returns the total bytes currently held across all pending chunks.
+   */
+  size_t PendingBytes() const;
+
+ private:
+  struct PendingBatch {
+    types::ColumnWrapperRecordBatch records;
+    size_t bytes = 0;
+    px::chrono::coarse_steady_clock::time_point first_append_time;
+  };
+
+  void Push(uint64_t table_id, const types::TabletID& tablet_id, PendingBatch* pending,
+            const DataPushCallback& agent_callback);
+
+  size_t flush_bytes_;
+  std::chrono::milliseconds max_latency_;
+
+  absl::flat_hash_map<std::pair<uint64_t, types::TabletID>, PendingBatch> pending_;
+};
+
+}  // namespace stirling
+}  // namespace px
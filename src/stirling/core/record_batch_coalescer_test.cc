@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/core/record_batch_coalescer.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+
+namespace {
+
+constexpr std::chrono::milliseconds kLongLatency{3600 * 1000};
+
+types::ColumnWrapperRecordBatch MakeInt64Batch(const std::vector<int64_t>& vals) {
+  auto col = types::ColumnWrapper::Make(types::DataType::INT64, 0);
+  for (int64_t v : vals) {
+    col->Append(types::Int64Value(v));
+  }
+  types::ColumnWrapperRecordBatch batch;
+  batch.push_back(std::move(col));
+  return batch;
+}
+
+}  // namespace
+
+class RecordBatchCoalescerTest : public ::testing::Test {
+ protected:
+  RecordBatchCoalescerTest() {
+    callback_ = [this](uint32_t table_id, types::TabletID /*tablet_id*/,
+                       std::unique_ptr<types::ColumnWrapperRecordBatch> batch) {
+      pushes_.emplace_back(table_id, (*batch)[0]->Size());
+      return Status::OK();
+    };
+  }
+
+  // Each entry records (table_id, num_rows) for one push through the callback.
+  std::vector<std::pair<uint32_t, size_t>> pushes_;
+  DataPushCallback callback_;
+};
+
+TEST_F(RecordBatchCoalescerTest, HoldsSmallBatchesUntilByteThreshold) {
+  RecordBatchCoalescer coalescer(/* flush_bytes */ 1024 * 1024, kLongLatency);
+
+  coalescer.AddRecordBatch(callback_, /* table_id */ 1, "", MakeInt64Batch({1, 2}));
+  coalescer.AddRecordBatch(callback_, /* table_id */ 1, "", MakeInt64Batch({3}));
+
+  EXPECT_TRUE(pushes_.empty());
+  EXPECT_EQ(coalescer.PendingBytes(), 3 * sizeof(int64_t));
+
+  coalescer.PushAll(callback_);
+  ASSERT_EQ(pushes_.size(), 1);
+  EXPECT_EQ(pushes_[0], std::make_pair(uint32_t{1}, size_t{3}));
+  EXPECT_EQ(coalescer.PendingBytes(), 0);
+}
+
+TEST_F(RecordBatchCoalescerTest, PushesOnceByteThresholdIsReached) {
+  RecordBatchCoalescer coalescer(/* flush_bytes */ 2 * sizeof(int64_t), kLongLatency);
+
+  coalescer.AddRecordBatch(callback_, /* table_id */ 1, "", MakeInt64Batch({1}));
+  EXPECT_TRUE(pushes_.empty());
+
+  coalescer.AddRecordBatch(callback_, /* table_id */ 1, "", MakeInt64Batch({2}));
+  ASSERT_EQ(pushes_.size(), 1);
+  EXPECT_EQ(pushes_[0], std::make_pair(uint32_t{1}, size_t{2}));
+}
+
+TEST_F(RecordBatchCoalescerTest, PushExpiredHonorsLatencyThreshold) {
+  RecordBatchCoalescer held(/* flush_bytes */ 1024 * 1024, kLongLatency);
+  held.AddRecordBatch(callback_, /* table_id */ 1, "", MakeInt64Batch({1}));
+  held.PushExpired(callback_);
+  EXPECT_TRUE(pushes_.empty());
+
+  RecordBatchCoalescer expired(/* flush_bytes */ 1024 * 1024, std::chrono::milliseconds{0});
+  expired.AddRecordBatch(callback_, /* table_id */ 1, "", MakeInt64Batch({1}));
+  expired.PushExpired(callback_);
+  EXPECT_EQ(pushes_.size(), 1);
+}
+
+TEST_F(RecordBatchCoalescerTest, TablesCoalesceIndependently) {
+  RecordBatchCoalescer coalescer(/* flush_bytes */ 2 * sizeof(int64_t), kLongLatency);
+
+  coalescer.AddRecordBatch(callback_, /* table_id */ 1, "", MakeInt64Batch({1}));
+  coalescer.AddRecordBatch(callback_, /* table_id */ 2, "", MakeInt64Batch({2}));
+  EXPECT_TRUE(pushes_.empty());
+
+  coalescer.AddRecordBatch(callback_, /* table_id */ 2, "", MakeInt64Batch({3}));
+  ASSERT_EQ(pushes_.size(), 1);
+  EXPECT_EQ(pushes_[0], std::make_pair(uint32_t{2}, size_t{2}));
+}
+
+}  // namespace stirling
+}  // namespace px
@@ -103,6 +103,76 @@ TEST(RecordBuilder, UnfilledColNames) {
   EXPECT_THAT(r.UnfilledColNames(), IsEmpty());
 }
 
+TEST(ColumnarRecordBuilder, BulkAppend) {
+  DataTable data_table(/*id*/ 0, kTableSchema);
+
+  {
+    DataTable::ColumnarRecordBuilder<&kTableSchema> b(&data_table);
+    b.Reserve(3);
+    for (int i = 0; i < 3; ++i) {
+      b.Times().push_back(i);
+      b.Column<b.ColIndex("a")>().push_back(i);
+      b.Column<b.ColIndex("b")>().push_back(absl::StrCat("foo", i));
+      b.Column<b.ColIndex("c")>().push_back("bar");
+    }
+  }
+
+  std::vector<TaggedRecordBatch> tablets = data_table.ConsumeRecords();
+  ASSERT_EQ(tablets.size(), 1);
+  types::ColumnWrapperRecordBatch& record_batch = tablets[0].records;
+
+  ASSERT_THAT(record_batch, RecordBatchSizeIs(3));
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(record_batch[0]->Get<types::Int64Value>(i).val, i);
+    EXPECT_EQ(record_batch[1]->Get<types::StringValue>(i), absl::StrCat("foo", i));
+    EXPECT_EQ(record_batch[2]->Get<types::StringValue>(i), "bar");
+  }
+}
+
+TEST(ColumnarRecordBuilder, StringMaxSize) {
+  DataTable data_table(/*id*/ 0, kTableSchema);
+
+  constexpr size_t kMaxStringBytes = 512;
+
+  std::string kLargeString(kMaxStringBytes + 100, 'c');
+  std::string kExpectedString(kMaxStringBytes, 'c');
+
+  {
+    DataTable::ColumnarRecordBuilder<&kTableSchema> b(&data_table, kMaxStringBytes);
+    b.Times().push_back(0);
+    b.Column<b.ColIndex("a")>().push_back(1);
+    b.Column<b.ColIndex("b")>().push_back("foo");
+    b.Column<b.ColIndex("c")>().push_back(kLargeString);
+  }
+
+  std::vector<TaggedRecordBatch> tablets = data_table.ConsumeRecords();
+  ASSERT_EQ(tablets.size(), 1);
+  types::ColumnWrapperRecordBatch& record_batch = tablets[0].records;
+
+  ASSERT_THAT(record_batch, RecordBatchSizeIs(1));
+
+  EXPECT_THAT(record_batch[2]->Get<types::StringValue>(0), StartsWith(kExpectedString));
+  EXPECT_THAT(record_batch[2]->Get<types::StringValue>(0), EndsWith("[TRUNCATED]"));
+}
+
+TEST(ColumnarRecordBuilder, MismatchedColumnSizes) {
+  DataTable data_table(/*id*/ 0, kTableSchema);
+
+  auto b_ptr = std::make_unique<DataTable::ColumnarRecordBuilder<&kTableSchema>>(&data_table);
+  b_ptr->Times().push_back(0);
+  b_ptr->Column<0>().push_back(1);
+  b_ptr->Column<2>().push_back("bar");
+  EXPECT_DEBUG_DEATH(b_ptr.reset(), "");
+
+  // Tricky: This is required because EXPECT_DEBUG_DEATH acts like a fork(),
+  // which means the main process will continue on, and will trigger the
+  // destructor a second time, which will cause the DCHECK to fire without this statement.
+#if DCHECK_IS_ON()
+  b_ptr->Column<1>().push_back("foo");
+#endif
+}
+
 TEST(DynamicRecordBuilder, StringMaxSize) {
   DataTable data_table(/*id*/ 0, kTableSchema);
 
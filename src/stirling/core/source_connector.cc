@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <chrono>
 #include <cstring>
 #include <ctime>
 #include <memory>
@@ -23,8 +24,17 @@
 
 #include <magic_enum.hpp>
 
+#include "src/common/perf/hot_path_profiler.h"
 #include "src/stirling/core/source_connector.h"
 
+// The byte threshold is aligned with the table store's cold batch target size, so that pushed
+// batches do not need to be re-chunked by compaction.
+DEFINE_uint64(stirling_push_coalesce_bytes, 64 * 1024,
+              "Per-(table, tablet) byte threshold at which coalesced record batches are pushed "
+              "to the table store. 0 disables coalescing.");
+DEFINE_uint64(stirling_push_coalesce_latency_ms, 1000,
+              "Maximum time a coalesced record batch may be held before being pushed.");
+
 namespace px {
 namespace stirling {
 
@@ -50,27 +60,56 @@ void SourceConnector::TransferData(ConnectorContext* ctx,
   DCHECK(ctx != nullptr);
   DCHECK_EQ(data_tables.size(), table_schemas().size())
       << "DataTable objects must all be specified.";
-  TransferDataImpl(ctx, data_tables);
+  const auto start = std::chrono::steady_clock::now();
+  // One clock read stamps every record generated this cycle; see transfer_time_ns().
+  transfer_time_ns_ = AdjustedSteadyClockNowNS();
+  {
+    px::profiler::HotPathSpan span("stirling.transfer_data");
+    TransferDataImpl(ctx, data_tables);
+  }
+  const int64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+  // EMA with a 1/8 weight, seeded by the first sample. Smooth enough to not thrash the
+  // scheduling order in the main loop, but still tracks load changes within a few samples.
+  if (transfer_duration_ema_ns_ == 0) {
+    transfer_duration_ema_ns_ = duration_ns;
+  } else {
+    transfer_duration_ema_ns_ += (duration_ns - transfer_duration_ema_ns_) / 8;
+  }
   sampling_freq_mgr_.Reset();
 }
 
 void SourceConnector::PushData(DataPushCallback agent_callback,
                                const std::vector<DataTable*>& data_tables) {
+  const bool coalesce = FLAGS_stirling_push_coalesce_bytes > 0;
   for (auto* data_table : data_tables) {
     auto record_batches = data_table->ConsumeRecords();
     for (auto& record_batch : record_batches) {
       if (record_batch.records.empty()) {
         continue;
       }
+      if (coalesce) {
+        push_coalescer_.AddRecordBatch(agent_callback, data_table->id(), record_batch.tablet_id,
+                                       std::move(record_batch.records));
+        continue;
+      }
       Status s = agent_callback(
           data_table->id(), record_batch.tablet_id,
           std::make_unique<types::ColumnWrapperRecordBatch>(std::move(record_batch.records)));
       LOG_IF(DFATAL, !s.ok()) << absl::Substitute("Failed to push data. Message = $0", s.msg());
     }
   }
+  if (coalesce) {
+    push_coalescer_.PushExpired(agent_callback);
+  }
   push_freq_mgr_.Reset();
 }
 
+void SourceConnector::FlushPendingData(DataPushCallback agent_callback) {
+  push_coalescer_.PushAll(agent_callback);
+}
+
 Status SourceConnector::Stop() {
   if (state_ != State::kActive) {
     return Status::OK();
@@ -27,6 +27,7 @@
 #include "src/stirling/core/connector_context.h"
 #include "src/stirling/core/data_table.h"
 #include "src/stirling/core/frequency_manager.h"
+#include "src/stirling/core/record_batch_coalescer.h"
 
 /**
  * These are the steps to follow to add a new data source connector.
@@ -37,6 +38,9 @@
  * 3. Register the data source in the appropriate registry.
  */
 
+DECLARE_uint64(stirling_push_coalesce_bytes);
+DECLARE_uint64(stirling_push_coalesce_latency_ms);
+
 namespace px {
 namespace stirling {
 
@@ -66,9 +70,19 @@ class SourceConnector : public NotCopyable {
 
   /**
    * Pushes data in data tables into table store.
+   *
+   * Record batches are coalesced per (table, tablet): a batch is forwarded to the callback once
+   * the accumulated chunk reaches the byte threshold, or has been pending longer than the
+   * latency threshold. See --stirling_push_coalesce_bytes.
    */
   void PushData(DataPushCallback agent_callback, const std::vector<DataTable*>& data_tables);
 
+  /**
+   * Pushes any record batches still held by the push coalescer. Called on shutdown so that
+   * pending data is not dropped.
+   */
+  void FlushPendingData(DataPushCallback agent_callback);
+
   /**
    * Stops the source connector and releases any acquired resources.
    * May only be called after a successful Init().
@@ -110,6 +124,14 @@ class SourceConnector : public NotCopyable {
   // in the exact same way.
   uint64_t AdjustedSteadyClockNowNS() const { return ConvertToRealTime(CurrentSteadyTimeNS()); }
 
+  /**
+   * The timestamp taken at the start of the current TransferData cycle, from the same adjusted
+   * clock as AdjustedSteadyClockNowNS(). Connectors that stamp each generated record with "now"
+   * should use this instead of re-reading the clock per record: all records produced within one
+   * cycle are observed at the same sampling instant, so one clock read per cycle suffices.
+   */
+  uint64_t transfer_time_ns() const { return transfer_time_ns_; }
+
   virtual void SetDebugLevel(int level) { debug_level_ = level; }
   virtual void EnablePIDTrace(int pid) { pids_to_trace_.insert(pid); }
   virtual void DisablePIDTrace(int pid) { pids_to_trace_.erase(pid); }
@@ -117,10 +139,20 @@ class SourceConnector : public NotCopyable {
   const FrequencyManager& sampling_freq_mgr() const { return sampling_freq_mgr_; }
   const FrequencyManager& push_freq_mgr() const { return push_freq_mgr_; }
 
+  /**
+   * Exponential moving average of recent TransferData durations, in nanoseconds.
+   * Zero until the first TransferData call. Used by the main loop to schedule cheap
+   * connectors ahead of expensive ones and to enforce its transfer time budget.
+   */
+  int64_t transfer_duration_ema_ns() const { return transfer_duration_ema_ns_; }
+
  protected:
   explicit SourceConnector(std::string_view source_name,
                            const ArrayView<DataTableSchema>& table_schemas)
-      : source_name_(source_name), table_schemas_(table_schemas) {}
+      : push_coalescer_(FLAGS_stirling_push_coalesce_bytes,
+                        std::chrono::milliseconds(FLAGS_stirling_push_coalesce_latency_ms)),
+        source_name_(source_name),
+        table_schemas_(table_schemas) {}
 
   virtual Status InitImpl() = 0;
 
@@ -149,6 +181,9 @@ class SourceConnector : public NotCopyable {
   FrequencyManager sampling_freq_mgr_;
   FrequencyManager push_freq_mgr_;
 
+  // Coalesces small record batches across push cycles. See PushData().
+  RecordBatchCoalescer push_coalescer_;
+
   // Debug members.
   int debug_level_ = 0;
   absl::flat_hash_set<int> pids_to_trace_;
@@ -156,6 +191,12 @@ class SourceConnector : public NotCopyable {
  private:
   std::atomic<State> state_ = State::kUninitialized;
 
+  // See transfer_duration_ema_ns(). Updated by TransferData.
+  int64_t transfer_duration_ema_ns_ = 0;
+
+  // See transfer_time_ns(). Updated once per TransferData cycle.
+  uint64_t transfer_time_ns_ = 0;
+
   const std::string source_name_;
   const ArrayView<DataTableSchema> table_schemas_;
 };
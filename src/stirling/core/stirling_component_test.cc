@@ -81,5 +81,19 @@ TEST_F(SourceToTableTest, source_to_table) {
   }
 }
 
+TEST_F(SourceToTableTest, transfer_duration_tracking) {
+  EXPECT_OK(source_->Init());
+  std::vector<DataTable*> data_tables{table_.get(), nullptr};
+  SystemWideStandaloneContext ctx;
+
+  // The cost estimate used by the main loop's transfer budget is seeded by the first
+  // TransferData call and keeps tracking subsequent ones.
+  EXPECT_EQ(0, source_->transfer_duration_ema_ns());
+  source_->TransferData(&ctx, data_tables);
+  EXPECT_GT(source_->transfer_duration_ema_ns(), 0);
+  source_->TransferData(&ctx, data_tables);
+  EXPECT_GT(source_->transfer_duration_ema_ns(), 0);
+}
+
 }  // namespace stirling
 }  // namespace px
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "src/common/testing/testing.h"
+#include "src/stirling/core/source_registry.h"
+#include "src/stirling/proto/stirling.pb.h"
+#include "src/stirling/source_connectors/seq_gen/seq_gen_connector.h"
+#include "src/stirling/stirling.h"
+
+DECLARE_string(stirling_lazy_init_sources);
+
+namespace px {
+namespace stirling {
+
+// A dormant (lazily initialized) source should publish its tables, produce no data until one of
+// its tables is queried, and then activate and produce data.
+TEST(StirlingLazyInitTest, DormantSourceActivatesWhenQueried) {
+  PL_SET_FOR_SCOPE(FLAGS_stirling_lazy_init_sources, "seq_gen");
+
+  auto registry = std::make_unique<SourceRegistry>();
+  registry->RegisterOrDie<SeqGenConnector>("seq_gen");
+  std::unique_ptr<Stirling> stirling = Stirling::Create(std::move(registry));
+
+  // The dormant source's tables are still published, so queries can subscribe to them.
+  stirlingpb::Publish publish;
+  stirling->GetPublishProto(&publish);
+  ASSERT_GT(publish.published_info_classes_size(), 0);
+
+  std::atomic<int64_t> record_count = 0;
+  stirling->RegisterDataPushCallback(
+      [&record_count](uint64_t /*table_id*/, types::TabletID /*tablet_id*/,
+                      std::unique_ptr<types::ColumnWrapperRecordBatch> batch) {
+        record_count += (*batch)[0]->Size();
+        return Status::OK();
+      });
+
+  ASSERT_OK(stirling->RunAsThread());
+  ASSERT_OK(stirling->WaitUntilRunning(std::chrono::seconds(5)));
+
+  // While dormant, the source produces no data.
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+  EXPECT_EQ(record_count, 0);
+
+  // Report that a query is reading the source's tables; this should trigger initialization.
+  absl::flat_hash_set<std::string> queried_tables;
+  for (const auto& info_class : publish.published_info_classes()) {
+    queried_tables.insert(info_class.schema().name());
+  }
+  stirling->UpdateQueriedTables(std::move(queried_tables));
+
+  for (int i = 0; i < 100 && record_count == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  EXPECT_GT(record_count, 0);
+
+  stirling->Stop();
+}
+
+}  // namespace stirling
+}  // namespace px
@@ -44,6 +44,26 @@ struct LowercaseHex {
   static inline constexpr int kSizePerByte = 2;
   static inline constexpr bool kKeepPrintableChars = false;
 };
+
+// Extracts the note descriptor from an ELF note section (e.g. .note.gnu.build-id),
+// and returns it as a lowercase hex string.
+std::string ParseNoteDesc(ELFIO::section* psec) {
+  // Structure of a note section:
+  //    namesz :   32-bit, size of "name" field
+  //    descsz :   32-bit, size of "desc" field
+  //    type   :   32-bit, vendor specific "type"
+  //    name   :   "namesz" bytes, null-terminated string
+  //    desc   :   "descsz" bytes, binary data
+  int32_t name_size =
+      utils::LEndianBytesToInt<int32_t>(std::string_view(psec->get_data(), sizeof(int32_t)));
+  int32_t desc_size = utils::LEndianBytesToInt<int32_t>(
+      std::string_view(psec->get_data() + sizeof(int32_t), sizeof(int32_t)));
+
+  int32_t desc_pos = 3 * sizeof(int32_t) + name_size;
+  std::string_view desc = std::string_view(psec->get_data() + desc_pos, desc_size);
+
+  return BytesToString<LowercaseHex>(desc);
+}
 }  // namespace
 
 Status ElfReader::LocateDebugSymbols(const std::filesystem::path& debug_file_dir) {
@@ -66,21 +86,7 @@ Status ElfReader::LocateDebugSymbols(const std::filesystem::path& debug_file_dir
 
     // Method 1: build-id.
     if (psec->get_name() == ".note.gnu.build-id") {
-      // Structure of this section:
-      //    namesz :   32-bit, size of "name" field
-      //    descsz :   32-bit, size of "desc" field
-      //    type   :   32-bit, vendor specific "type"
-      //    name   :   "namesz" bytes, null-terminated string
-      //    desc   :   "descsz" bytes, binary data
-      int32_t name_size =
-          utils::LEndianBytesToInt<int32_t>(std::string_view(psec->get_data(), sizeof(int32_t)));
-      int32_t desc_size = utils::LEndianBytesToInt<int32_t>(
-          std::string_view(psec->get_data() + sizeof(int32_t), sizeof(int32_t)));
-
-      int32_t desc_pos = 3 * sizeof(int32_t) + name_size;
-      std::string_view desc = std::string_view(psec->get_data() + desc_pos, desc_size);
-
-      build_id = BytesToString<LowercaseHex>(desc);
+      build_id = ParseNoteDesc(psec);
       VLOG(1) << absl::Substitute("Found build-id: $0", build_id);
     }
 
@@ -158,6 +164,24 @@ Status ElfReader::LocateDebugSymbols(const std::filesystem::path& debug_file_dir
   return error::Internal("Could not find debug symbols for $0", binary_path_);
 }
 
+StatusOr<std::string> ElfReader::BuildID() {
+  // Prefer the GNU build-id. Fall back to the Go build ID, which pure-Go binaries carry even
+  // when they were linked without a GNU build-id.
+  constexpr std::string_view kBuildIDSections[] = {".note.gnu.build-id", ".note.go.buildid"};
+
+  for (std::string_view section_name : kBuildIDSections) {
+    ELFIO::Elf_Half sec_num = elf_reader_.sections.size();
+    for (int i = 0; i < sec_num; ++i) {
+      ELFIO::section* psec = elf_reader_.sections[i];
+      if (psec->get_name() == section_name) {
+        return ParseNoteDesc(psec);
+      }
+    }
+  }
+
+  return error::NotFound("Binary $0 does not contain a build-id note", binary_path_);
+}
+
 // TODO(oazizi): Consider changing binary_path to std::filesystem::path.
 StatusOr<std::unique_ptr<ElfReader>> ElfReader::Create(
     const std::string& binary_path, const std::filesystem::path& debug_file_dir) {
@@ -402,6 +426,13 @@ void ElfReader::Symbolizer::AddEntry(size_t addr, size_t size, std::string name)
   symbols_.emplace(addr, SymbolAddrInfo{size, std::move(name)});
 }
 
+void ElfReader::Symbolizer::ForEachEntry(
+    const std::function<void(uintptr_t addr, size_t size, const std::string& name)>& fn) const {
+  for (const auto& [addr, info] : symbols_) {
+    fn(addr, info.size, info.name);
+  }
+}
+
 std::string_view ElfReader::Symbolizer::Lookup(size_t addr) const {
   static std::string symbol_str;
 
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -50,6 +51,17 @@ class ElfReader {
 
   std::filesystem::path& debug_symbols_path() { return debug_symbols_path_; }
 
+  /**
+   * Returns the build ID of the binary as a lowercase hex string.
+   * The GNU build-id (.note.gnu.build-id) is preferred; for pure-Go binaries without one,
+   * the Go build ID (.note.go.buildid) is used instead.
+   * Since the build ID identifies the binary's contents, it is suitable as a key for caching
+   * analysis results across runs.
+   *
+   * @return error if the binary carries no build ID note.
+   */
+  StatusOr<std::string> BuildID();
+
   struct SymbolInfo {
     std::string name;
     int type = -1;
@@ -131,6 +143,13 @@ class ElfReader {
      */
     std::string_view Lookup(uintptr_t addr) const;
 
+    /**
+     * Invokes fn(addr, size, name) on every entry, in increasing address order.
+     * Used to serialize the symbolizer contents (e.g. for a persistent symbol index).
+     */
+    void ForEachEntry(
+        const std::function<void(uintptr_t addr, size_t size, const std::string& name)>& fn) const;
+
    private:
     struct SymbolAddrInfo {
       size_t size;
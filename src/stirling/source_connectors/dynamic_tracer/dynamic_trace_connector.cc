@@ -188,6 +188,17 @@ Status DynamicTraceConnector::InitImpl() {
 
   PL_RETURN_IF_ERROR(OpenPerfBuffer(spec, this));
 
+  // Batched outputs need a periodic flush, so partially-filled batches from low-rate
+  // tracepoints are not stranded waiting for the next probe hit.
+  for (const auto& perf_buffer_spec : bcc_program_.perf_buffer_specs) {
+    if (perf_buffer_spec.batch_size > 1) {
+      PL_RETURN_IF_ERROR(AttachSamplingProbe(bpf_tools::SamplingProbeSpec{
+          .probe_fn = dynamic_tracing::kPerfOutputFlushProbeFn,
+          .period_millis = static_cast<uint64_t>(kSamplingPeriod.count())}));
+      break;
+    }
+  }
+
   return Status::OK();
 }
 
@@ -356,6 +367,9 @@ class StructDecoder {
     return ParseStructBlobToJSON(struct_specs.Get(idx), bytes);
   }
 
+  // Returns the unconsumed portion of the buffer.
+  std::string_view Remainder() const { return buf_; }
+
  private:
   std::string_view buf_;
 };
@@ -453,9 +467,9 @@ Status FillColumn(StructDecoder* struct_decoder, DataTable::DynamicRecordBuilder
 
 }  // namespace
 
-Status DynamicTraceConnector::AppendRecord(const Struct& st, uint32_t asid, std::string_view buf,
+Status DynamicTraceConnector::AppendRecord(const Struct& st, uint32_t asid, std::string_view* buf,
                                            DataTable* data_table) {
-  StructDecoder struct_decoder(buf);
+  StructDecoder struct_decoder(*buf);
   DataTable::DynamicRecordBuilder r(data_table);
 
   int col_idx = 0;
@@ -482,6 +496,25 @@ Status DynamicTraceConnector::AppendRecord(const Struct& st, uint32_t asid, std:
     }
   }
 
+  *buf = struct_decoder.Remainder();
+
+  return Status::OK();
+}
+
+Status DynamicTraceConnector::AppendBatchedRecords(const Struct& st, uint32_t asid,
+                                                   std::string_view buf, DataTable* data_table) {
+  // The frame layout must match the batch struct emitted by GenPerfBufferOutput in code_gen.cc:
+  // a packed {uint32_t count; uint64_t start_ns;} header, followed by `count` packed records.
+  // Decoding is driven by the count, so any trailing perf buffer padding is ignored.
+  StructDecoder header_decoder(buf);
+  PL_ASSIGN_OR_RETURN(uint32_t count, header_decoder.ExtractField<uint32_t>());
+  PL_RETURN_IF_ERROR(header_decoder.ExtractField<uint64_t>().status());
+
+  std::string_view records_buf = header_decoder.Remainder();
+  for (uint32_t i = 0; i < count; ++i) {
+    PL_RETURN_IF_ERROR(AppendRecord(st, asid, &records_buf, data_table));
+  }
+
   return Status::OK();
 }
 
@@ -497,11 +530,17 @@ void DynamicTraceConnector::TransferDataImpl(ConnectorContext* ctx,
 
   PollPerfBuffers();
 
+  const auto& perf_buffer_spec = bcc_program_.perf_buffer_specs.front();
+
   for (const auto& item : data_items_) {
     // TODO(yzhao): Right now only support scalar types. We should replace type with ScalarType
     // in Struct::Field.
-    ECHECK_OK(AppendRecord(bcc_program_.perf_buffer_specs.front().output, ctx->GetASID(), item,
-                           data_table));
+    if (perf_buffer_spec.batch_size > 1) {
+      ECHECK_OK(AppendBatchedRecords(perf_buffer_spec.output, ctx->GetASID(), item, data_table));
+    } else {
+      std::string_view buf = item;
+      ECHECK_OK(AppendRecord(perf_buffer_spec.output, ctx->GetASID(), &buf, data_table));
+    }
   }
 
   data_items_.clear();
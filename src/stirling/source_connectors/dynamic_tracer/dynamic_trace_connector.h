@@ -62,8 +62,15 @@ class DynamicTraceConnector : public SourceConnector, public bpf_tools::BCCWrapp
   Status StopImpl() override { return Status::OK(); }
 
  private:
+  // Decodes one record from the front of *buf and appends it to the data table.
+  // Advances *buf past the consumed bytes.
   Status AppendRecord(const ::px::stirling::dynamic_tracing::ir::physical::Struct& st,
-                      uint32_t asid, std::string_view buf, DataTable* data_table);
+                      uint32_t asid, std::string_view* buf, DataTable* data_table);
+
+  // Decodes a count-prefixed batch of records produced by a batched BPF output
+  // (see GenPerfBufferOutput in code_gen.cc).
+  Status AppendBatchedRecords(const ::px::stirling::dynamic_tracing::ir::physical::Struct& st,
+                              uint32_t asid, std::string_view buf, DataTable* data_table);
 
   // Describes the output table column types.
   std::unique_ptr<DynamicDataTableSchema> table_schema_;
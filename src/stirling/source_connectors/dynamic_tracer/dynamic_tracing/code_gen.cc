@@ -28,6 +28,7 @@
 
 #include "src/common/base/base.h"
 #include "src/stirling/bpf_tools/utils.h"
+#include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/types.h"
 #include "src/stirling/obj_tools/elf_reader.h"
 #include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/types.h"
 
@@ -182,6 +183,9 @@ class BCCCodeGenerator {
 
   // Map from Struct names to their definition.
   absl::flat_hash_map<std::string_view, const ir::physical::Struct*> structs_;
+
+  // Map from perf buffer output names to their definition.
+  absl::flat_hash_map<std::string_view, const PerfBufferOutput*> outputs_;
 };
 
 // Returns the C type name of the input ScalarType.
@@ -578,25 +582,67 @@ std::string GenMapDeleteAction(const MapDeleteAction& action) {
   return absl::Substitute("$0.delete(&$1);", action.map_name(), action.key_variable_name());
 }
 
-std::string GenPerfBufferOutput(const PerfBufferOutput& output) {
-  return absl::Substitute("BPF_PERF_OUTPUT($0);", output.name());
+std::vector<std::string> GenPerfBufferOutput(const PerfBufferOutput& output) {
+  std::vector<std::string> code_lines;
+
+  // When batching is enabled, records are staged in a per-CPU array and submitted to the perf
+  // buffer in groups, amortizing the per-submission overhead on hot tracepoints.
+  // The count-prefixed frame layout must stay in sync with the decoder in
+  // dynamic_trace_connector.cc.
+  if (output.batch_size() > 1) {
+    code_lines.push_back(absl::Substitute("struct $0_batch_t {", output.name()));
+    code_lines.push_back("  uint32_t count;");
+    code_lines.push_back("  uint64_t start_ns;");
+    code_lines.push_back(
+        absl::Substitute("  struct $0 records[$1];", output.struct_type(), output.batch_size()));
+    code_lines.push_back("} __attribute__((packed, aligned(1)));");
+    code_lines.push_back(
+        absl::Substitute("BPF_PERCPU_ARRAY($0_batch_array, struct $0_batch_t, 1);", output.name()));
+  }
+
+  code_lines.push_back(absl::Substitute("BPF_PERF_OUTPUT($0);", output.name()));
+
+  return code_lines;
 }
 
 namespace {
 
 StatusOr<std::vector<std::string>> GenPerfBufferOutputAction(
-    const ir::physical::Struct& output_struct, const PerfBufferOutputAction& action) {
+    const ir::physical::Struct& output_struct, const PerfBufferOutput& output,
+    const PerfBufferOutputAction& action) {
   std::string output_var_name = absl::StrCat(action.perf_buffer_name(), "_value");
 
   std::vector<std::string> code_lines;
 
-  // Generate a temporary variable in a BPF map, to avoid crossing the BPF stack size limit.
-  std::string arr_idx_var_name = absl::StrCat(output_var_name, "_idx");
-  code_lines.push_back(absl::Substitute("uint32_t $0 = 0;", arr_idx_var_name));
-  code_lines.push_back(absl::Substitute("struct $0* $1 = $2.lookup(&$3);",
-                                        action.output_struct_name(), output_var_name,
-                                        action.data_buffer_array_name(), arr_idx_var_name));
-  code_lines.push_back(absl::Substitute("if ($0 == NULL) { return 0; }", output_var_name));
+  const bool batched = output.batch_size() > 1;
+
+  if (batched) {
+    // Stage the record in the per-CPU batch, and submit the whole batch once it is full,
+    // or once the oldest staged record exceeds the flush interval.
+    // Note that a partially-filled batch is only flushed by a subsequent probe hit.
+    const std::string& name = action.perf_buffer_name();
+    code_lines.push_back(absl::Substitute("uint32_t $0_batch_idx = 0;", name));
+    code_lines.push_back(absl::Substitute(
+        "struct $0_batch_t* $0_batch = $0_batch_array.lookup(&$0_batch_idx);", name));
+    code_lines.push_back(absl::Substitute("if ($0_batch == NULL) { return 0; }", name));
+    // Copy the count into a register and re-bound it, so the BPF verifier can prove the array
+    // access below is within bounds.
+    code_lines.push_back(absl::Substitute("uint32_t $0_record_idx = $0_batch->count;", name));
+    code_lines.push_back(absl::Substitute("if ($0_record_idx >= $1) { $0_record_idx = 0; }", name,
+                                          output.batch_size()));
+    code_lines.push_back(absl::Substitute(
+        "if ($0_record_idx == 0) { $0_batch->start_ns = bpf_ktime_get_ns(); }", name));
+    code_lines.push_back(absl::Substitute("struct $0* $1 = &$2_batch->records[$2_record_idx];",
+                                          action.output_struct_name(), output_var_name, name));
+  } else {
+    // Generate a temporary variable in a BPF map, to avoid crossing the BPF stack size limit.
+    std::string arr_idx_var_name = absl::StrCat(output_var_name, "_idx");
+    code_lines.push_back(absl::Substitute("uint32_t $0 = 0;", arr_idx_var_name));
+    code_lines.push_back(absl::Substitute("struct $0* $1 = $2.lookup(&$3);",
+                                          action.output_struct_name(), output_var_name,
+                                          action.data_buffer_array_name(), arr_idx_var_name));
+    code_lines.push_back(absl::Substitute("if ($0 == NULL) { return 0; }", output_var_name));
+  }
 
   int struct_field_index = 0;
   for (const auto& f : action.variable_names()) {
@@ -604,8 +650,24 @@ StatusOr<std::vector<std::string>> GenPerfBufferOutputAction(
                                           output_struct.fields(struct_field_index++).name(), f));
   }
 
-  code_lines.push_back(absl::Substitute("$0.perf_submit(ctx, $1, sizeof(*$1));",
-                                        action.perf_buffer_name(), output_var_name));
+  if (batched) {
+    const std::string& name = action.perf_buffer_name();
+    code_lines.push_back(absl::Substitute("uint32_t $0_batch_count = $0_record_idx + 1;", name));
+    code_lines.push_back(absl::Substitute("$0_batch->count = $0_batch_count;", name));
+    code_lines.push_back(absl::Substitute(
+        "if ($0_batch_count >= $1 || bpf_ktime_get_ns() - $0_batch->start_ns >= $2) {", name,
+        output.batch_size(), output.batch_flush_ns()));
+    // Only the header and the filled records are submitted, not the whole batch struct.
+    code_lines.push_back(absl::Substitute(
+        "$0.perf_submit(ctx, $0_batch, sizeof(uint32_t) + sizeof(uint64_t) + "
+        "$0_batch_count * sizeof(struct $1));",
+        name, output.struct_type()));
+    code_lines.push_back(absl::Substitute("$0_batch->count = 0;", name));
+    code_lines.push_back("}");
+  } else {
+    code_lines.push_back(absl::Substitute("$0.perf_submit(ctx, $1, sizeof(*$1));",
+                                          action.perf_buffer_name(), output_var_name));
+  }
 
   return code_lines;
 }
@@ -857,7 +919,13 @@ StatusOr<std::vector<std::string>> BCCCodeGenerator::GenerateProbe(const Probe&
     if (iter == structs_.end()) {
       return error::InvalidArgument("Output struct '$0' is undefined", action.output_struct_name());
     }
-    MOVE_BACK_STR_VEC(GenPerfBufferOutputAction(*iter->second, action), &code_lines);
+    auto output_iter = outputs_.find(action.perf_buffer_name());
+    if (output_iter == outputs_.end()) {
+      return error::InvalidArgument("Perf buffer output '$0' is undefined",
+                                    action.perf_buffer_name());
+    }
+    MOVE_BACK_STR_VEC(GenPerfBufferOutputAction(*iter->second, *output_iter->second, action),
+                      &code_lines);
   }
 
   for (const auto& printk : probe.printks()) {
@@ -941,6 +1009,49 @@ std::vector<std::string> GenGOID() {
   };
 }
 
+// Generates a probe that submits any batch that has records older than the batch flush
+// interval. This is attached as a sampling probe (see kPerfOutputFlushProbeFn), since a
+// partially-filled batch would otherwise only be flushed by the next probe hit.
+std::vector<std::string> GenPerfOutputFlushProbe(const Program& program) {
+  std::vector<std::string> code_lines;
+
+  for (const auto& output : program.outputs()) {
+    if (output.batch_size() <= 1) {
+      continue;
+    }
+
+    if (code_lines.empty()) {
+      code_lines.push_back(absl::Substitute("int $0(struct bpf_perf_event_data* ctx) {",
+                                            kPerfOutputFlushProbeFn));
+      code_lines.push_back("uint64_t now_ns = bpf_ktime_get_ns();");
+    }
+
+    const std::string& name = output.name();
+    code_lines.push_back(absl::Substitute("uint32_t $0_batch_idx = 0;", name));
+    code_lines.push_back(absl::Substitute(
+        "struct $0_batch_t* $0_batch = $0_batch_array.lookup(&$0_batch_idx);", name));
+    code_lines.push_back(absl::Substitute(
+        "if ($0_batch != NULL && $0_batch->count > 0 && now_ns - $0_batch->start_ns >= $1) {",
+        name, output.batch_flush_ns()));
+    code_lines.push_back(absl::Substitute("uint32_t $0_batch_count = $0_batch->count;", name));
+    code_lines.push_back(absl::Substitute("if ($0_batch_count > $1) { $0_batch_count = $1; }",
+                                          name, output.batch_size()));
+    code_lines.push_back(absl::Substitute(
+        "$0.perf_submit(ctx, $0_batch, sizeof(uint32_t) + sizeof(uint64_t) + "
+        "$0_batch_count * sizeof(struct $1));",
+        name, output.struct_type()));
+    code_lines.push_back(absl::Substitute("$0_batch->count = 0;", name));
+    code_lines.push_back("}");
+  }
+
+  if (!code_lines.empty()) {
+    code_lines.push_back("return 0;");
+    code_lines.push_back("}");
+  }
+
+  return code_lines;
+}
+
 std::vector<std::string> GenUtilFNs() {
   std::vector<std::string> code_lines;
   MoveBackStrVec(GenNsecToClock(), &code_lines);
@@ -1027,13 +1138,16 @@ StatusOr<std::vector<std::string>> BCCCodeGenerator::GenerateCodeLines() {
   }
 
   for (const auto& output : program_.outputs()) {
-    code_lines.push_back(GenPerfBufferOutput(output));
+    MoveBackStrVec(GenPerfBufferOutput(output), &code_lines);
+    outputs_[output.name()] = &output;
   }
 
   for (const auto& probe : program_.probes()) {
     MOVE_BACK_STR_VEC(GenerateProbe(probe), &code_lines);
   }
 
+  MoveBackStrVec(GenPerfOutputFlushProbe(program_), &code_lines);
+
   return code_lines;
 }
 
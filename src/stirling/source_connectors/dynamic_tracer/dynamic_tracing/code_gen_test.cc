@@ -40,6 +40,7 @@ using ::px::stirling::dynamic_tracing::ir::shared::BPFHelper;
 using ::px::stirling::dynamic_tracing::ir::shared::ScalarType;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
+using ::testing::IsSupersetOf;
 using ::testing::StrEq;
 
 TEST(GenStructTest, Output) {
@@ -475,6 +476,85 @@ TEST(GenProgramTest, SpecsAndCode) {
   EXPECT_THAT(bcc_code_lines, ElementsAreArray(expected_code_lines));
 }
 
+TEST(GenProgramTest, BatchedPerfOutput) {
+  const std::string program_protobuf = R"proto(
+                                       structs {
+                                         name: "event_t"
+                                         fields {
+                                           name: "i32"
+                                           type: INT32
+                                         }
+                                       }
+                                       outputs {
+                                         name: "events"
+                                         struct_type: "event_t"
+                                         batch_size: 2
+                                         batch_flush_ns: 1000000
+                                       }
+                                       probes {
+                                         name: "probe_entry"
+                                         tracepoint {
+                                           symbol: "target_symbol"
+                                           type: ENTRY
+                                         }
+                                         vars {
+                                           scalar_var {
+                                             name: "var"
+                                             type: INT32
+                                             reg: SP
+                                           }
+                                         }
+                                         output_actions {
+                                           perf_buffer_name: "events"
+                                           output_struct_name: "event_t"
+                                           variable_names: "var"
+                                         }
+                                       }
+                                       )proto";
+
+  ir::physical::Program program;
+
+  ASSERT_TRUE(TextFormat::ParseFromString(program_protobuf, &program));
+
+  ASSERT_OK_AND_ASSIGN(const std::string bcc_code, GenBCCProgram(program));
+
+  // With batch_size > 1, records are staged in a per-CPU batch, and submitted as a
+  // count-prefixed frame once the batch is full or the oldest record is too old.
+  const std::vector<std::string> expected_batch_code_lines = {
+      "struct events_batch_t {",
+      "  uint32_t count;",
+      "  uint64_t start_ns;",
+      "  struct event_t records[2];",
+      "} __attribute__((packed, aligned(1)));",
+      "BPF_PERCPU_ARRAY(events_batch_array, struct events_batch_t, 1);",
+      "BPF_PERF_OUTPUT(events);",
+      "uint32_t events_batch_idx = 0;",
+      "struct events_batch_t* events_batch = events_batch_array.lookup(&events_batch_idx);",
+      "if (events_batch == NULL) { return 0; }",
+      "uint32_t events_record_idx = events_batch->count;",
+      "if (events_record_idx >= 2) { events_record_idx = 0; }",
+      "if (events_record_idx == 0) { events_batch->start_ns = bpf_ktime_get_ns(); }",
+      "struct event_t* events_value = &events_batch->records[events_record_idx];",
+      "events_value->i32 = var;",
+      "uint32_t events_batch_count = events_record_idx + 1;",
+      "events_batch->count = events_batch_count;",
+      "if (events_batch_count >= 2 || bpf_ktime_get_ns() - events_batch->start_ns >= 1000000) {",
+      "events.perf_submit(ctx, events_batch, sizeof(uint32_t) + sizeof(uint64_t) + "
+      "events_batch_count * sizeof(struct event_t));",
+      "events_batch->count = 0;",
+      "}",
+      // A sampling probe flushes batches whose oldest record has exceeded the flush interval.
+      "int flush_perf_output_batches(struct bpf_perf_event_data* ctx) {",
+      "uint64_t now_ns = bpf_ktime_get_ns();",
+      "if (events_batch != NULL && events_batch->count > 0 && now_ns - events_batch->start_ns "
+      ">= 1000000) {",
+      "if (events_batch_count > 2) { events_batch_count = 2; }",
+  };
+
+  std::vector<std::string> bcc_code_lines = absl::StrSplit(bcc_code, "\n");
+  EXPECT_THAT(bcc_code_lines, IsSupersetOf(expected_batch_code_lines));
+}
+
 }  // namespace dynamic_tracing
 }  // namespace stirling
 }  // namespace px
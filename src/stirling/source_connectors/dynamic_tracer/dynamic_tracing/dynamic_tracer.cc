@@ -38,6 +38,7 @@
 #include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/code_gen.h"
 #include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/dwarvifier.h"
 #include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/ir/sharedpb/shared.pb.h"
+#include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/obj_info_cache.h"
 #include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/probe_transformer.h"
 #include "src/stirling/utils/proc_path_tools.h"
 
@@ -49,8 +50,6 @@ namespace dynamic_tracing {
 
 using ::px::stirling::bpf_tools::BPFProbeAttachType;
 using ::px::stirling::bpf_tools::UProbeSpec;
-using ::px::stirling::obj_tools::DwarfReader;
-using ::px::stirling::obj_tools::ElfReader;
 using ::px::system::ProcParser;
 
 namespace {
@@ -91,33 +90,28 @@ StatusOr<BCCProgram::PerfBufferSpec> GetPerfBufferSpec(
 
   pf_spec.name = output.name();
   pf_spec.output = *iter->second;
+  pf_spec.batch_size = output.batch_size();
 
   return pf_spec;
 }
 
-// Return value for Prepare(), so we can return multiple pointers.
-struct ObjInfo {
-  std::unique_ptr<ElfReader> elf_reader;
-  std::unique_ptr<DwarfReader> dwarf_reader;
-};
-
-// Prepares the input program for compilation by:
-// 1) Resolving the tracepoint target specification into an object path (e.g. UPID->path).
-// 2) Preparing the Elf and Dwarf info for the binary.
-StatusOr<ObjInfo> Prepare(const ir::logical::TracepointDeployment& input_program) {
-  ObjInfo obj_info;
-
-  const auto& binary_path = input_program.deployment_spec().path();
-  LOG(INFO) << absl::Substitute("Tracepoint binary: $0", binary_path);
-
-  PL_ASSIGN_OR_RETURN(obj_info.elf_reader, ElfReader::Create(binary_path));
-
-  const auto& debug_symbols_path = obj_info.elf_reader->debug_symbols_path().string();
-
-  obj_info.dwarf_reader =
-      DwarfReader::CreateIndexingAll(debug_symbols_path).ConsumeValueOr(nullptr);
-
-  return obj_info;
+// Defaults for batching perf buffer submissions (see PerfBufferOutput in physical.proto).
+// The flush interval matches the connector's sampling period, so a partially-filled batch
+// does not add more than one sampling period of latency (provided the probe keeps firing).
+constexpr int32_t kDefaultPerfBufferBatchSize = 16;
+constexpr int64_t kDefaultPerfBufferBatchFlushNs = 100 * 1000 * 1000;
+
+// Fills in the defaults for any batching parameters not set by the tracepoint deployment.
+// This runs after the dwarvifier, so hand-written physical programs keep whatever they specify.
+void ApplyPerfBufferBatchingDefaults(ir::physical::Program* program) {
+  for (auto& output : *program->mutable_outputs()) {
+    if (output.batch_size() == 0) {
+      output.set_batch_size(kDefaultPerfBufferBatchSize);
+    }
+    if (output.batch_flush_ns() == 0) {
+      output.set_batch_flush_ns(kDefaultPerfBufferBatchFlushNs);
+    }
+  }
 }
 
 }  // namespace
@@ -132,23 +126,29 @@ StatusOr<BCCProgram> CompileProgram(ir::logical::TracepointDeployment* input_pro
                                   input_program->tracepoints_size());
   }
 
-  // Get the ELF and DWARF readers for the program.
-  PL_ASSIGN_OR_RETURN(ObjInfo obj_info, Prepare(*input_program));
+  const auto& target_binary_path = input_program->deployment_spec().path();
+  LOG(INFO) << absl::Substitute("Tracepoint binary: $0", target_binary_path);
+
+  // Get the ELF and DWARF readers for the program. The readers are shared across deployments
+  // that target the same binary build, so the expensive DWARF indexing runs once per distinct
+  // build rather than once per deployment.
+  PL_ASSIGN_OR_RETURN(ObjInfoCache::ScopedObjInfo obj_info,
+                      ObjInfoCache::GetInstance().Acquire(target_binary_path));
 
   // --------------------------
   // Pre-processing pipeline
   // --------------------------
 
   // Populate source language.
-  DetectSourceLanguage(obj_info.elf_reader.get(), obj_info.dwarf_reader.get(), input_program);
+  DetectSourceLanguage(obj_info.elf_reader(), obj_info.dwarf_reader(), input_program);
 
   // Expand symbol.
-  PL_RETURN_IF_ERROR(ResolveProbeSymbol(obj_info.elf_reader.get(), input_program));
+  PL_RETURN_IF_ERROR(ResolveProbeSymbol(obj_info.elf_reader(), input_program));
 
   LOG_IF(INFO, FLAGS_debug_dt_pipeline) << input_program->DebugString();
 
   // Auto-gen probe variables
-  PL_RETURN_IF_ERROR(AutoTraceExpansion(obj_info.dwarf_reader.get(), input_program));
+  PL_RETURN_IF_ERROR(AutoTraceExpansion(obj_info.dwarf_reader(), input_program));
 
   LOG_IF(INFO, FLAGS_debug_dt_pipeline) << input_program->DebugString();
 
@@ -162,11 +162,13 @@ StatusOr<BCCProgram> CompileProgram(ir::logical::TracepointDeployment* input_pro
   LOG_IF(INFO, FLAGS_debug_dt_pipeline) << input_program->DebugString();
 
   PL_ASSIGN_OR_RETURN(ir::physical::Program physical_program,
-                      GeneratePhysicalProgram(intermediate_program, obj_info.dwarf_reader.get(),
-                                              obj_info.elf_reader.get()));
+                      GeneratePhysicalProgram(intermediate_program, obj_info.dwarf_reader(),
+                                              obj_info.elf_reader()));
 
   LOG_IF(INFO, FLAGS_debug_dt_pipeline) << physical_program.DebugString();
 
+  ApplyPerfBufferBatchingDefaults(&physical_program);
+
   PL_ASSIGN_OR_RETURN(std::string bcc_code, GenBCCProgram(physical_program));
 
   // --------------------------
@@ -186,7 +188,7 @@ StatusOr<BCCProgram> CompileProgram(ir::logical::TracepointDeployment* input_pro
 
   for (const auto& probe : physical_program.probes()) {
     PL_ASSIGN_OR_RETURN(std::vector<UProbeSpec> specs,
-                        GetUProbeSpec(binary_path, language, probe, obj_info.elf_reader.get()));
+                        GetUProbeSpec(binary_path, language, probe, obj_info.elf_reader()));
     for (auto& spec : specs) {
       bcc_program.uprobe_specs.push_back(std::move(spec));
     }
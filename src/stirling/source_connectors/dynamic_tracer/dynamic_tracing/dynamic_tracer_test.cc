@@ -300,6 +300,12 @@ const std::vector<std::string> kExpectedBCC = {
     "const struct pid_goid_map_value_t* goid_ptr = pid_goid_map.lookup(&current_pid_tgid);",
     "return (goid_ptr == NULL) ? -1 : goid_ptr->goid;",
     "}",
+    "struct probe_output_batch_t {",
+    "  uint32_t count;",
+    "  uint64_t start_ns;",
+    "  struct probe_output_value_t records[16];",
+    "} __attribute__((packed, aligned(1)));",
+    "BPF_PERCPU_ARRAY(probe_output_batch_array, struct probe_output_batch_t, 1);",
     "BPF_PERF_OUTPUT(probe_output);",
     "int probe_entry_runtime_casgstatus(struct pt_regs* ctx) {",
     "void* sp_ = (void*)PT_REGS_SP(ctx);",
@@ -363,10 +369,15 @@ const std::vector<std::string> kExpectedBCC = {
     "uint64_t start_ktime_ns = probe0_argstash_ptr->time_;",
     "int64_t latency = time_ - start_ktime_ns;",
     "probe0_argstash.delete(&goid_);",
-    "uint32_t probe_output_value_idx = 0;",
+    "uint32_t probe_output_batch_idx = 0;",
+    "struct probe_output_batch_t* probe_output_batch = "
+    "probe_output_batch_array.lookup(&probe_output_batch_idx);",
+    "if (probe_output_batch == NULL) { return 0; }",
+    "uint32_t probe_output_record_idx = probe_output_batch->count;",
+    "if (probe_output_record_idx >= 16) { probe_output_record_idx = 0; }",
+    "if (probe_output_record_idx == 0) { probe_output_batch->start_ns = bpf_ktime_get_ns(); }",
     "struct probe_output_value_t* probe_output_value = "
-    "probe_output_data_buffer_array.lookup(&probe_output_value_idx);",
-    "if (probe_output_value == NULL) { return 0; }",
+    "&probe_output_batch->records[probe_output_record_idx];",
     "probe_output_value->tgid_ = tgid_;",
     "probe_output_value->tgid_start_time_ = tgid_start_time_;",
     "probe_output_value->time_ = time_;",
@@ -376,7 +387,29 @@ const std::vector<std::string> kExpectedBCC = {
     "probe_output_value->f3 = arg2;",
     "probe_output_value->f4 = retval0;",
     "probe_output_value->latency = latency;",
-    "probe_output.perf_submit(ctx, probe_output_value, sizeof(*probe_output_value));",
+    "uint32_t probe_output_batch_count = probe_output_record_idx + 1;",
+    "probe_output_batch->count = probe_output_batch_count;",
+    "if (probe_output_batch_count >= 16 || bpf_ktime_get_ns() - probe_output_batch->start_ns >= "
+    "100000000) {",
+    "probe_output.perf_submit(ctx, probe_output_batch, sizeof(uint32_t) + sizeof(uint64_t) + "
+    "probe_output_batch_count * sizeof(struct probe_output_value_t));",
+    "probe_output_batch->count = 0;",
+    "}",
+    "return 0;",
+    "}",
+    "int flush_perf_output_batches(struct bpf_perf_event_data* ctx) {",
+    "uint64_t now_ns = bpf_ktime_get_ns();",
+    "uint32_t probe_output_batch_idx = 0;",
+    "struct probe_output_batch_t* probe_output_batch = "
+    "probe_output_batch_array.lookup(&probe_output_batch_idx);",
+    "if (probe_output_batch != NULL && probe_output_batch->count > 0 && now_ns - "
+    "probe_output_batch->start_ns >= 100000000) {",
+    "uint32_t probe_output_batch_count = probe_output_batch->count;",
+    "if (probe_output_batch_count > 16) { probe_output_batch_count = 16; }",
+    "probe_output.perf_submit(ctx, probe_output_batch, sizeof(uint32_t) + sizeof(uint64_t) + "
+    "probe_output_batch_count * sizeof(struct probe_output_value_t));",
+    "probe_output_batch->count = 0;",
+    "}",
     "return 0;",
     "}",
 };
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/obj_info_cache.h"
+
+#include <utility>
+
+namespace px {
+namespace stirling {
+namespace dynamic_tracing {
+
+using ::px::stirling::obj_tools::DwarfReader;
+using ::px::stirling::obj_tools::ElfReader;
+
+ObjInfoCache& ObjInfoCache::GetInstance() {
+  static ObjInfoCache* cache = new ObjInfoCache();
+  return *cache;
+}
+
+StatusOr<ObjInfoCache::ScopedObjInfo> ObjInfoCache::Acquire(const std::string& binary_path) {
+  // Creating the ElfReader is cheap relative to DWARF indexing, and is needed anyway to read
+  // the build ID, which keys the cache.
+  PL_ASSIGN_OR_RETURN(std::unique_ptr<ElfReader> elf_reader, ElfReader::Create(binary_path));
+
+  std::shared_ptr<Entry> entry;
+
+  StatusOr<std::string> build_id_or = elf_reader->BuildID();
+  if (build_id_or.ok()) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto iter = entries_.find(build_id_or.ValueOrDie());
+    if (iter != entries_.end()) {
+      entry = iter->second;
+    } else {
+      EvictIfNeeded();
+      entry = std::make_shared<Entry>();
+      entries_[build_id_or.ValueOrDie()] = entry;
+      insertion_order_.push_back(build_id_or.ConsumeValueOrDie());
+    }
+  } else {
+    // No build ID to key on, so this binary is not cacheable. Hand out a standalone entry.
+    VLOG(1) << absl::Substitute("Not caching obj info for binary $0: $1", binary_path,
+                                build_id_or.msg());
+    entry = std::make_shared<Entry>();
+  }
+
+  // Serializes against other deployments preparing or using the same binary, so the DWARF
+  // indexing below runs at most once per distinct build.
+  std::unique_lock<std::mutex> entry_lock(entry->mu);
+
+  if (entry->elf_reader == nullptr) {
+    entry->elf_reader = std::move(elf_reader);
+
+    const auto& debug_symbols_path = entry->elf_reader->debug_symbols_path().string();
+    entry->dwarf_reader =
+        DwarfReader::CreateIndexingAll(debug_symbols_path).ConsumeValueOr(nullptr);
+  }
+
+  return ScopedObjInfo(std::move(entry), std::move(entry_lock));
+}
+
+void ObjInfoCache::EvictIfNeeded() {
+  while (entries_.size() >= kMaxEntries && !insertion_order_.empty()) {
+    auto iter = entries_.find(insertion_order_.front());
+    if (iter == entries_.end()) {
+      insertion_order_.pop_front();
+      continue;
+    }
+    // An entry whose lock is held is still in use by an active deployment; the shared_ptr keeps
+    // it alive, but avoid dropping it from the map while its DWARF index is still being built.
+    if (!iter->second->mu.try_lock()) {
+      break;
+    }
+    iter->second->mu.unlock();
+    entries_.erase(iter);
+    insertion_order_.pop_front();
+  }
+}
+
+}  // namespace dynamic_tracing
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/common/base/base.h"
+#include "src/stirling/obj_tools/dwarf_reader.h"
+#include "src/stirling/obj_tools/elf_reader.h"
+
+namespace px {
+namespace stirling {
+namespace dynamic_tracing {
+
+/**
+ * Caches the ELF and DWARF readers for a binary, keyed by the binary's build ID.
+ *
+ * Preparing a binary for dynamic tracing is dominated by DWARF indexing
+ * (DwarfReader::CreateIndexingAll), which can take seconds for large Go binaries.
+ * Tracepoint deployments each run on their own thread, so without a cache, deploying
+ * multiple tracepoints on the same binary repeats that work per deployment.
+ *
+ * The build ID identifies the binary's contents, so replicas of the same build running in
+ * different containers (and therefore with different paths and inodes) share a single entry,
+ * and an updated binary at the same path naturally gets a new entry.
+ * Binaries without a build ID are not cached; a fresh entry is returned for each acquisition.
+ */
+class ObjInfoCache : public NotCopyable {
+ public:
+  // Bounds the number of retained entries. A DwarfReader's index can hold a non-trivial
+  // amount of memory, so keep only the few most recently deployed binaries.
+  static constexpr size_t kMaxEntries = 8;
+
+  /**
+   * Provides exclusive access to the readers of a cache entry for the duration of its lifetime.
+   *
+   * The readers are not thread-safe, so concurrent deployments against the same binary
+   * serialize on the entry; deployments against distinct binaries proceed in parallel.
+   */
+  class ScopedObjInfo {
+   public:
+    obj_tools::ElfReader* elf_reader() const { return entry_->elf_reader.get(); }
+
+    // May be nullptr if the binary has no DWARF debug info (e.g. a stripped binary).
+    obj_tools::DwarfReader* dwarf_reader() const { return entry_->dwarf_reader.get(); }
+
+   private:
+    friend class ObjInfoCache;
+
+    struct Entry {
+      std::mutex mu;
+      std::unique_ptr<obj_tools::ElfReader> elf_reader;
+      std::unique_ptr<obj_tools::DwarfReader> dwarf_reader;
+    };
+
+    ScopedObjInfo(std::shared_ptr<Entry> entry, std::unique_lock<std::mutex> lock)
+        : entry_(std::move(entry)), lock_(std::move(lock)) {}
+
+    // Note: lock_ must be declared after entry_, so it is released before the entry can be
+    // destroyed.
+    std::shared_ptr<Entry> entry_;
+    std::unique_lock<std::mutex> lock_;
+  };
+
+  static ObjInfoCache& GetInstance();
+
+  ObjInfoCache() = default;
+
+  /**
+   * Returns the readers for the binary at the input path, creating and indexing them if the
+   * binary has not been seen before. Blocks while another thread is preparing or using the
+   * same binary.
+   */
+  StatusOr<ScopedObjInfo> Acquire(const std::string& binary_path);
+
+ private:
+  using Entry = ScopedObjInfo::Entry;
+
+  // Evicts the oldest entries that are not currently in use until the cache is under capacity.
+  // Must be called with mu_ held.
+  void EvictIfNeeded();
+
+  std::mutex mu_;
+  absl::flat_hash_map<std::string, std::shared_ptr<Entry>> entries_;
+  // Build IDs in insertion order, for eviction.
+  std::deque<std::string> insertion_order_;
+};
+
+}  // namespace dynamic_tracing
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/obj_info_cache.h"
+
+#include <string>
+
+#include "src/common/testing/testing.h"
+
+constexpr std::string_view kBinaryPath = "src/stirling/obj_tools/testdata/go/test_go_1_16_binary";
+
+namespace px {
+namespace stirling {
+namespace dynamic_tracing {
+
+TEST(ObjInfoCacheTest, ReusesReadersForSameBinary) {
+  ObjInfoCache cache;
+
+  const std::string binary_path = px::testing::BazelRunfilePath(kBinaryPath).string();
+
+  obj_tools::ElfReader* first_elf_reader = nullptr;
+  {
+    ASSERT_OK_AND_ASSIGN(ObjInfoCache::ScopedObjInfo obj_info, cache.Acquire(binary_path));
+    ASSERT_NE(obj_info.elf_reader(), nullptr);
+    first_elf_reader = obj_info.elf_reader();
+  }
+
+  // A second acquisition of the same binary returns the cached readers.
+  ASSERT_OK_AND_ASSIGN(ObjInfoCache::ScopedObjInfo obj_info, cache.Acquire(binary_path));
+  EXPECT_EQ(obj_info.elf_reader(), first_elf_reader);
+}
+
+TEST(ObjInfoCacheTest, MissingBinary) {
+  ObjInfoCache cache;
+  EXPECT_NOT_OK(cache.Acquire("/path/to/nowhere"));
+}
+
+}  // namespace dynamic_tracing
+}  // namespace stirling
+}  // namespace px
@@ -53,13 +53,23 @@ constexpr size_t kStructByteArraySize = 64;
 // generated types.
 constexpr size_t kStructBlobSize = 64;
 
+// Name of the generated BPF function that flushes stale, partially-filled perf output batches.
+// Generated only when an output has batching enabled, and meant to be attached as a sampling
+// probe, so records from low-rate tracepoints are not stranded waiting for the next probe hit.
+constexpr char kPerfOutputFlushProbeFn[] = "flush_perf_output_batches";
+
 struct BCCProgram {
   struct PerfBufferSpec {
     std::string name;
     ir::physical::Struct output;
 
+    // Number of records per batched perf buffer submission.
+    // Values <= 1 mean each record is submitted (and decoded) individually.
+    int32_t batch_size = 1;
+
     std::string ToString() const {
-      return absl::Substitute("[name=$0 Output struct=$1]", name, output.DebugString());
+      return absl::Substitute("[name=$0 batch_size=$1 Output struct=$2]", name, batch_size,
+                              output.DebugString());
     }
   };
 
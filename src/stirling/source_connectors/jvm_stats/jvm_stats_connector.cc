@@ -46,6 +46,13 @@ void JVMStatsConnector::FindJavaUPIDs(const ConnectorContext& ctx) {
   proc_tracker_.Update(ctx.GetUPIDs());
   const auto& upid_pidinfo_map = ctx.GetPIDInfoMap();
 
+  // Drop the state of terminated processes. The persistent mapping keeps the perf file's pages
+  // alive even after the JVM exits, so relying on read failures to age out dead processes no
+  // longer works.
+  for (const auto& upid : proc_tracker_.deleted_upids()) {
+    java_procs_.erase(upid);
+  }
+
   for (const auto& upid : proc_tracker_.new_upids()) {
     // The host PID 1 is not a Java app. However, when later invoking HsperfdataPath(), it could be
     // confused to conclude that there is a hsperfdata file for PID 1, because of the limitations
@@ -69,23 +76,21 @@ void JVMStatsConnector::FindJavaUPIDs(const ConnectorContext& ctx) {
   }
 }
 
-Status JVMStatsConnector::ExportStats(const md::UPID& upid,
-                                      const std::filesystem::path& hsperf_data_path,
+Status JVMStatsConnector::ExportStats(const md::UPID& upid, JavaProcInfo* java_proc,
                                       DataTable* data_table) const {
-  PL_ASSIGN_OR_RETURN(std::string hsperf_data_str, ReadFileToString(hsperf_data_path));
-
-  if (hsperf_data_str.empty()) {
-    // Assume this is a transient failure.
-    return Status::OK();
+  if (java_proc->reader == nullptr) {
+    // The reader resolves the counter offsets once, so it cannot be created until the JVM has
+    // fully laid out its hsperfdata file. Failures here are counted against the monitoring
+    // attempts, like read failures were before.
+    PL_ASSIGN_OR_RETURN(java_proc->reader,
+                        java::HsperfdataReader::Create(java_proc->hsperf_data_path));
   }
 
-  java::Stats stats(std::move(hsperf_data_str));
-  if (!stats.Parse().ok()) {
-    // Assumes this is a transient failure.
-    return Status::OK();
-  }
+  java::Stats stats = java_proc->reader->ReadStats();
 
-  uint64_t time = AdjustedSteadyClockNowNS();
+  // All JVMs sampled in one TransferData cycle share the cycle timestamp; re-reading the
+  // clock per process would only introduce artificial skew between their records.
+  uint64_t time = transfer_time_ns();
 
   DataTable::RecordBuilder<&kJVMStatsTable> r(data_table, time);
   r.Append<kTimeIdx>(time);
@@ -115,7 +120,7 @@ void JVMStatsConnector::TransferDataImpl(ConnectorContext* ctx,
     JavaProcInfo& java_proc = iter->second;
 
     md::UPID upid_with_asid(ctx->GetASID(), upid.pid(), upid.start_ts());
-    auto status = ExportStats(upid_with_asid, java_proc.hsperf_data_path, data_table);
+    auto status = ExportStats(upid_with_asid, &java_proc, data_table);
     if (!status.ok()) {
       ++java_proc.export_failure_count;
     }
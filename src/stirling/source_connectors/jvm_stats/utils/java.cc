@@ -18,11 +18,18 @@
 
 #include "src/stirling/source_connectors/jvm_stats/utils/java.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <absl/strings/match.h>
 
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/common/base/byte_utils.h"
@@ -41,6 +48,48 @@ using ::px::stirling::java::hsperf::ParseHsperfData;
 using ::px::system::ProcParser;
 using ::px::utils::LEndianBytesToInt;
 
+namespace {
+
+constexpr std::string_view kYoungGCTimeSuffix = "gc.collector.0.time";
+constexpr std::string_view kFullGCTimeSuffix = "gc.collector.1.time";
+
+const std::vector<std::string_view> kUsedHeapSizeSuffixes = {
+    "gc.generation.0.space.0.used",
+    "gc.generation.0.space.1.used",
+    "gc.generation.0.space.2.used",
+    "gc.generation.1.space.0.used",
+};
+
+const std::vector<std::string_view> kTotalHeapSizeSuffixes = {
+    "gc.generation.0.space.0.capacity",
+    "gc.generation.0.space.1.capacity",
+    "gc.generation.0.space.2.capacity",
+    "gc.generation.1.space.0.capacity",
+};
+
+const std::vector<std::string_view> kMaxHeapSizeSuffixes = {
+    "gc.generation.0.maxCapacity",
+    "gc.generation.1.maxCapacity",
+};
+
+// Whether this counter backs any of the stats published in the jvm_stats table.
+bool IsMonitoredCounter(std::string_view name) {
+  if (absl::EndsWith(name, kYoungGCTimeSuffix) || absl::EndsWith(name, kFullGCTimeSuffix)) {
+    return true;
+  }
+  for (const auto* suffixes :
+       {&kUsedHeapSizeSuffixes, &kTotalHeapSizeSuffixes, &kMaxHeapSizeSuffixes}) {
+    for (std::string_view suffix : *suffixes) {
+      if (absl::EndsWith(name, suffix)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 Stats::Stats(std::vector<Stat> stats) : stats_(std::move(stats)) {}
 
 Stats::Stats(std::string hsperf_data_str) : hsperf_data_(std::move(hsperf_data_str)) {}
@@ -58,34 +107,15 @@ Status Stats::Parse() {
   return Status::OK();
 }
 
-uint64_t Stats::YoungGCTimeNanos() const { return StatForSuffix("gc.collector.0.time"); }
+uint64_t Stats::YoungGCTimeNanos() const { return StatForSuffix(kYoungGCTimeSuffix); }
 
-uint64_t Stats::FullGCTimeNanos() const { return StatForSuffix("gc.collector.1.time"); }
+uint64_t Stats::FullGCTimeNanos() const { return StatForSuffix(kFullGCTimeSuffix); }
 
-uint64_t Stats::UsedHeapSizeBytes() const {
-  return SumStatsForSuffixes({
-      "gc.generation.0.space.0.used",
-      "gc.generation.0.space.1.used",
-      "gc.generation.0.space.2.used",
-      "gc.generation.1.space.0.used",
-  });
-}
+uint64_t Stats::UsedHeapSizeBytes() const { return SumStatsForSuffixes(kUsedHeapSizeSuffixes); }
 
-uint64_t Stats::TotalHeapSizeBytes() const {
-  return SumStatsForSuffixes({
-      "gc.generation.0.space.0.capacity",
-      "gc.generation.0.space.1.capacity",
-      "gc.generation.0.space.2.capacity",
-      "gc.generation.1.space.0.capacity",
-  });
-}
+uint64_t Stats::TotalHeapSizeBytes() const { return SumStatsForSuffixes(kTotalHeapSizeSuffixes); }
 
-uint64_t Stats::MaxHeapSizeBytes() const {
-  return SumStatsForSuffixes({
-      "gc.generation.0.maxCapacity",
-      "gc.generation.1.maxCapacity",
-  });
-}
+uint64_t Stats::MaxHeapSizeBytes() const { return SumStatsForSuffixes(kMaxHeapSizeSuffixes); }
 
 uint64_t Stats::StatForSuffix(std::string_view suffix) const {
   for (const auto& stat : stats_) {
@@ -104,6 +134,75 @@ uint64_t Stats::SumStatsForSuffixes(const std::vector<std::string_view>& suffixe
   return sum;
 }
 
+StatusOr<std::unique_ptr<HsperfdataReader>> HsperfdataReader::Create(
+    const std::filesystem::path& hsperf_data_path) {
+  const int fd = open(hsperf_data_path.string().c_str(), O_RDONLY);
+  if (fd == -1) {
+    return error::Internal("Failed to open hsperfdata file $0: $1", hsperf_data_path.string(),
+                           strerror(errno));
+  }
+
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) == -1) {
+    close(fd);
+    return error::Internal("Failed to stat hsperfdata file $0: $1", hsperf_data_path.string(),
+                           strerror(errno));
+  }
+  const size_t size = stat_buf.st_size;
+  if (size < sizeof(hsperf::Prologue)) {
+    close(fd);
+    return error::Internal("hsperfdata file $0 is too small: $1 bytes", hsperf_data_path.string(),
+                           size);
+  }
+
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the file descriptor is closed.
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return error::Internal("Failed to mmap hsperfdata file $0: $1", hsperf_data_path.string(),
+                           strerror(errno));
+  }
+
+  std::string_view buf_view(static_cast<const char*>(addr), size);
+  // Wrap the mapping immediately so the error paths below unmap it.
+  auto reader = std::unique_ptr<HsperfdataReader>(new HsperfdataReader(buf_view));
+
+  // The JVM clears the accessible flag while it is still laying out the counters. Parsing at that
+  // point would permanently miss counters, since the offsets are only resolved once.
+  const auto* prologue = reinterpret_cast<const hsperf::Prologue*>(buf_view.data());
+  if (prologue->accessible == 0) {
+    return error::Internal("hsperfdata file $0 is not yet accessible", hsperf_data_path.string());
+  }
+
+  hsperf::HsperfData hsperf_data = {};
+  PL_RETURN_IF_ERROR(ParseHsperfData(buf_view, &hsperf_data));
+  for (const auto& entry : hsperf_data.data_entries) {
+    if (entry.header->data_type != static_cast<uint8_t>(hsperf::DataType::kLong)) {
+      continue;
+    }
+    if (!IsMonitoredCounter(entry.name)) {
+      continue;
+    }
+    reader->counter_offsets_.push_back(
+        {std::string(entry.name), static_cast<size_t>(entry.data.data() - buf_view.data())});
+  }
+  return reader;
+}
+
+HsperfdataReader::~HsperfdataReader() {
+  munmap(const_cast<char*>(data_.data()), data_.size());
+}
+
+Stats HsperfdataReader::ReadStats() const {
+  std::vector<Stats::Stat> stats;
+  stats.reserve(counter_offsets_.size());
+  for (const auto& counter : counter_offsets_) {
+    stats.push_back({counter.name,
+                     LEndianBytesToInt<uint64_t>(data_.substr(counter.offset, sizeof(uint64_t)))});
+  }
+  return Stats(std::move(stats));
+}
+
 StatusOr<std::filesystem::path> HsperfdataPath(pid_t pid) {
   const system::Config& sysconfig = system::Config::GetInstance();
   const std::filesystem::path& host_path = sysconfig.host_path();
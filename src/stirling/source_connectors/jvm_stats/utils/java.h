@@ -19,11 +19,13 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "src/common/base/mixins.h"
 #include "src/common/base/statusor.h"
 
 namespace px {
@@ -64,6 +66,39 @@ class Stats {
   std::vector<Stat> stats_;
 };
 
+/**
+ * Reads the monitored counters of a JVM process from a persistent memory mapping of its
+ * hsperfdata file.
+ *
+ * The layout of the file is fixed for the lifetime of a JVM, so the offsets of the counters
+ * backing the jvm_stats table are resolved once when the reader is created. Subsequent reads only
+ * load those counter values from the mapped memory, instead of re-opening and re-parsing the
+ * whole file on every sample.
+ */
+class HsperfdataReader : public NotCopyMoveable {
+ public:
+  static StatusOr<std::unique_ptr<HsperfdataReader>> Create(
+      const std::filesystem::path& hsperf_data_path);
+  ~HsperfdataReader();
+
+  /**
+   * Returns the current values of the monitored counters.
+   */
+  Stats ReadStats() const;
+
+ private:
+  explicit HsperfdataReader(std::string_view data) : data_(data) {}
+
+  struct CounterOffset {
+    std::string name;
+    size_t offset;
+  };
+
+  // The memory-mapped content of the hsperfdata file.
+  std::string_view data_;
+  std::vector<CounterOffset> counter_offsets_;
+};
+
 /**
  * Returns the path of the hsperfdata for a JVM process.
  */
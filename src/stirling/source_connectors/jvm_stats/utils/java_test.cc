@@ -27,6 +27,7 @@
 
 #include <absl/strings/match.h>
 
+#include "src/common/base/base.h"
 #include "src/common/exec/subprocess.h"
 #include "src/common/testing/test_environment.h"
 #include "src/common/testing/testing.h"
@@ -59,6 +60,29 @@ TEST(StatsTest, CommonValues) {
   EXPECT_EQ(2, stats.MaxHeapSizeBytes());
 }
 
+// Tests that the persistent reader resolves counter offsets from the mapped file, and computes
+// the same stats as parsing the whole file.
+TEST(HsperfdataReaderTest, ReadStatsFromMappedFile) {
+  const std::string path = testing::BazelRunfilePath(
+      "src/stirling/source_connectors/jvm_stats/utils/test_hsperfdata");
+
+  ASSERT_OK_AND_ASSIGN(auto reader, HsperfdataReader::Create(path));
+
+  ASSERT_OK_AND_ASSIGN(const std::string content, ReadFileToString(path));
+  Stats parsed_stats(content);
+  ASSERT_OK(parsed_stats.Parse());
+
+  // Read twice to exercise the reuse of the resolved offsets.
+  for (int i = 0; i < 2; ++i) {
+    Stats stats = reader->ReadStats();
+    EXPECT_EQ(parsed_stats.YoungGCTimeNanos(), stats.YoungGCTimeNanos());
+    EXPECT_EQ(parsed_stats.FullGCTimeNanos(), stats.FullGCTimeNanos());
+    EXPECT_EQ(parsed_stats.UsedHeapSizeBytes(), stats.UsedHeapSizeBytes());
+    EXPECT_EQ(parsed_stats.TotalHeapSizeBytes(), stats.TotalHeapSizeBytes());
+    EXPECT_EQ(parsed_stats.MaxHeapSizeBytes(), stats.MaxHeapSizeBytes());
+  }
+}
+
 TEST(HsperfdataPathTest, ResultIsAsExpected) {
   const char kClassPath[] = "src/stirling/source_connectors/jvm_stats/testing/HelloWorld.jar";
   const std::string class_path = testing::BazelRunfilePath(kClassPath);
@@ -18,6 +18,9 @@
 
 #include "src/stirling/source_connectors/network_stats/network_stats_connector.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <chrono>
 #include <filesystem>
 #include <iostream>
@@ -25,6 +28,7 @@
 
 #include "src/common/base/base.h"
 #include "src/common/system/proc_parser.h"
+#include "src/common/system/socket_info.h"
 #include "src/shared/metadata/metadata.h"
 
 namespace px {
@@ -38,7 +42,18 @@ Status NetworkStatsConnector::InitImpl() {
   return Status::OK();
 }
 
-Status NetworkStatsConnector::StopImpl() { return Status::OK(); }
+Status NetworkStatsConnector::StopImpl() {
+  CloseNetnsFDs();
+  return Status::OK();
+}
+
+void NetworkStatsConnector::CloseNetnsFDs() {
+  for (const auto& [netns, fd] : netns_fds_) {
+    PL_UNUSED(netns);
+    close(fd);
+  }
+  netns_fds_.clear();
+}
 
 void NetworkStatsConnector::TransferDataImpl(ConnectorContext* ctx,
                                              const std::vector<DataTable*>& data_tables) {
@@ -53,7 +68,12 @@ void NetworkStatsConnector::TransferNetworkStatsTable(ConnectorContext* ctx,
                                                       DataTable* data_table) {
   const md::K8sMetadataState& k8s_md = ctx->GetK8SMetadata();
 
-  int64_t timestamp = AdjustedSteadyClockNowNS();
+  int64_t timestamp = transfer_time_ns();
+
+  // Per-sample state: stats are collected once per network namespace, no matter how many pods
+  // share it, and namespaces not seen this sample have their cached handles dropped below.
+  netns_stats_cache_.clear();
+  seen_netns_.clear();
 
   for (const auto& [pod_name, pod_id] : k8s_md.pods_by_name()) {
     PL_UNUSED(pod_name);
@@ -65,7 +85,7 @@ void NetworkStatsConnector::TransferNetworkStatsTable(ConnectorContext* ctx,
     }
 
     ProcParser::NetworkStats stats;
-    auto s = GetNetworkStatsForPod(*proc_parser_, *pod_info, k8s_md, &stats);
+    auto s = GetNetworkStatsForPod(*pod_info, k8s_md, &stats);
 
     if (!s.ok()) {
       VLOG(1) << absl::StrCat("Failed to get Pod network stats: ", s.msg());
@@ -85,10 +105,19 @@ void NetworkStatsConnector::TransferNetworkStatsTable(ConnectorContext* ctx,
     r.Append<r.ColIndex("tx_errors")>(stats.tx_errs);
     r.Append<r.ColIndex("tx_drops")>(stats.tx_drops);
   }
+
+  // Drop handles for namespaces that no longer back any pod.
+  for (auto iter = netns_fds_.begin(); iter != netns_fds_.end();) {
+    if (!seen_netns_.contains(iter->first)) {
+      close(iter->second);
+      netns_fds_.erase(iter++);
+    } else {
+      ++iter;
+    }
+  }
 }
 
-Status NetworkStatsConnector::GetNetworkStatsForPod(const system::ProcParser& proc_parser,
-                                                    const md::PodInfo& pod_info,
+Status NetworkStatsConnector::GetNetworkStatsForPod(const md::PodInfo& pod_info,
                                                     const md::K8sMetadataState& k8s_metadata_state,
                                                     system::ProcParser::NetworkStats* stats) {
   DCHECK(stats != nullptr);
@@ -119,9 +148,26 @@ Status NetworkStatsConnector::GetNetworkStatsForPod(const system::ProcParser& pr
                          container_info->active_upids().end(), md::UPIDStartTSCompare()));
 
     for (const auto& upid : container_info->active_upids()) {
-      auto s = proc_parser.ParseProcPIDNetDev(upid.pid(), stats);
+      auto netns_or_status = system::NetNamespace(sysconfig_.proc_path(), upid.pid());
+      if (!netns_or_status.ok()) {
+        // Process likely died; try the next one.
+        continue;
+      }
+      const uint32_t netns = netns_or_status.ConsumeValueOrDie();
+      seen_netns_.insert(netns);
+
+      // Pods sharing a network namespace (e.g. hostNetwork pods) see the same stats, so each
+      // namespace is read at most once per sample.
+      auto cache_iter = netns_stats_cache_.find(netns);
+      if (cache_iter != netns_stats_cache_.end()) {
+        *stats = cache_iter->second;
+        return Status::OK();
+      }
+
+      auto s = ReadNetDevStats(netns, upid.pid(), stats);
       if (s.ok()) {
         // Since we just need to read one pid, we can bail on the first successful read.
+        netns_stats_cache_[netns] = *stats;
         return s;
       }
       VLOG(1) << absl::Substitute("Failed to read network stats for pod=$0, using upid=$1",
@@ -132,5 +178,53 @@ Status NetworkStatsConnector::GetNetworkStatsForPod(const system::ProcParser& pr
   return error::Internal("Failed to get networks stats for pod_id=$0", pod_info.uid());
 }
 
+Status NetworkStatsConnector::ReadNetDevStats(uint32_t netns, uint32_t pid,
+                                              system::ProcParser::NetworkStats* stats) {
+  auto iter = netns_fds_.find(netns);
+  if (iter != netns_fds_.end()) {
+    auto s = ReadAndParseNetDevFD(iter->second, stats);
+    if (s.ok()) {
+      return s;
+    }
+    // The process backing this handle has likely died; drop it and open a fresh one below.
+    close(iter->second);
+    netns_fds_.erase(iter);
+  }
+
+  std::string fpath = absl::Substitute("$0/$1/net/dev", sysconfig_.proc_path().string(), pid);
+  const int fd = open(fpath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return error::Internal("Failed to open file $0 [errno=$1]", fpath, errno);
+  }
+  netns_fds_[netns] = fd;
+  return ReadAndParseNetDevFD(fd, stats);
+}
+
+Status NetworkStatsConnector::ReadAndParseNetDevFD(int fd,
+                                                   system::ProcParser::NetworkStats* stats) {
+  stats->Clear();
+
+  // Read through pread so the handle's file offset is untouched, and the next sample re-reads
+  // from the start of the file.
+  constexpr size_t kChunkSize = 4096;
+  size_t offset = 0;
+  while (true) {
+    if (net_dev_buffer_.size() < offset + kChunkSize) {
+      net_dev_buffer_.resize(offset + kChunkSize);
+    }
+    const ssize_t num_bytes = pread(fd, net_dev_buffer_.data() + offset, kChunkSize, offset);
+    if (num_bytes < 0) {
+      return error::Internal("Failed to read net/dev file [errno=$0]", errno);
+    }
+    if (num_bytes == 0) {
+      break;
+    }
+    offset += num_bytes;
+  }
+
+  return system::ProcParser::ParseProcNetDevContents(
+      std::string_view(net_dev_buffer_.data(), offset), stats);
+}
+
 }  // namespace stirling
 }  // namespace px
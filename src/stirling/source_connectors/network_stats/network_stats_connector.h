@@ -24,6 +24,9 @@
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
 #include "src/common/base/base.h"
 #include "src/common/system/system.h"
 #include "src/shared/metadata/metadata.h"
@@ -64,12 +67,34 @@ class NetworkStatsConnector : public SourceConnector {
  private:
   void TransferNetworkStatsTable(ConnectorContext* ctx, DataTable* data_table);
 
-  static Status GetNetworkStatsForPod(const system::ProcParser& proc_parser,
-                                      const md::PodInfo& pod_info,
-                                      const md::K8sMetadataState& k8s_metadata_state,
-                                      system::ProcParser::NetworkStats* stats);
+  Status GetNetworkStatsForPod(const md::PodInfo& pod_info,
+                               const md::K8sMetadataState& k8s_metadata_state,
+                               system::ProcParser::NetworkStats* stats);
+
+  // Reads the stats of a network namespace through its cached net/dev handle, opening one
+  // through /proc/<pid>/net/dev if not already cached.
+  Status ReadNetDevStats(uint32_t netns, uint32_t pid, system::ProcParser::NetworkStats* stats);
+
+  // Reads the contents of an open net/dev file into the reusable buffer and parses it.
+  Status ReadAndParseNetDevFD(int fd, system::ProcParser::NetworkStats* stats);
+
+  void CloseNetnsFDs();
 
   std::unique_ptr<system::ProcParser> proc_parser_;
+
+  // One open /proc/<pid>/net/dev handle per pod network namespace, keyed by the namespace's
+  // inode number, so that sampling does not re-open a file per pod every period. Handles whose
+  // backing process has died are replaced on the fly; handles whose namespace no longer backs
+  // any pod are dropped after each sample.
+  absl::flat_hash_map<uint32_t, int> netns_fds_;
+
+  // Per-sample state: parsed stats by namespace, so pods sharing a network namespace are
+  // collected with a single read, and the set of namespaces seen, used to expire handles.
+  absl::flat_hash_map<uint32_t, system::ProcParser::NetworkStats> netns_stats_cache_;
+  absl::flat_hash_set<uint32_t> seen_netns_;
+
+  // Reusable buffer for net/dev contents, to avoid per-sample allocations.
+  std::string net_dev_buffer_;
 };
 
 }  // namespace stirling
@@ -29,7 +29,9 @@
 
 // This BPF probe samples stack-traces using two fundamental data structures:
 // 1. stack_traces: a map from stack-trace [1] to stack-trace-id (an integer).
-// 2. histogram: a map from stack-trace-id to observation count.
+// 2. histogram: a map from stack-trace-key (upid & stack-trace-ids) to observation count.
+// Samples are deduplicated & counted in-kernel: each sample increments its count
+// in the histogram, and user-space drains the histogram once per transfer period.
 // The higher a count, the more we have observed a particular stack-trace,
 // and the more likely something in that stack-trace is a potential perf. issue.
 
@@ -50,8 +52,8 @@
 // the set of instruction pointers found in the call stack at the moment
 // the sample was triggered.
 
-BPF_PERF_OUTPUT(histogram_a);
-BPF_PERF_OUTPUT(histogram_b);
+BPF_HASH(histogram_a, struct stack_trace_key_t, uint64_t, CFG_STACK_TRACE_ENTRIES);
+BPF_HASH(histogram_b, struct stack_trace_key_t, uint64_t, CFG_STACK_TRACE_ENTRIES);
 BPF_STACK_TRACE(stack_traces_a, CFG_STACK_TRACE_ENTRIES);
 BPF_STACK_TRACE(stack_traces_b, CFG_STACK_TRACE_ENTRIES);
 
@@ -90,7 +92,7 @@ int sample_call_stack(struct bpf_perf_event_data* ctx) {
     // map set A branch:
     key.user_stack_id = stack_traces_a.get_stackid(&ctx->regs, BPF_F_USER_STACK);
     key.kernel_stack_id = stack_traces_a.get_stackid(&ctx->regs, 0);
-    histogram_a.perf_submit(ctx, &key, sizeof(key));
+    histogram_a.increment(key);
 
     sample_count = *sample_count_a_ptr;
     *sample_count_a_ptr += 1;
@@ -98,7 +100,7 @@ int sample_call_stack(struct bpf_perf_event_data* ctx) {
     // map set B branch:
     key.user_stack_id = stack_traces_b.get_stackid(&ctx->regs, BPF_F_USER_STACK);
     key.kernel_stack_id = stack_traces_b.get_stackid(&ctx->regs, 0);
-    histogram_b.perf_submit(ctx, &key, sizeof(key));
+    histogram_b.increment(key);
 
     sample_count = *sample_count_b_ptr;
     *sample_count_b_ptr += 1;
@@ -17,23 +17,36 @@
  */
 
 // This file is compiled into agent.so, a shared library that will be injected into the target
-// Java process. Once injected, it creates a symbol log file into which it writes every
-// symbol compiled by the JVM along with the symbol address and code size. This symbol file
-// is then used by the Stirling data collector inside of the PEM (Pixie Edge Module) to
-// populate Java symbols that cannot be found by inspecting binaries (i.e. cannot be found
-// by the "normal" means used to find symbols in compiled binaries from C, C++, Go, and Rust).
-
+// Java process. Once injected, it publishes every symbol compiled by the JVM (along with the
+// symbol address and code size) into a shared-memory symbol ring: a file in the artifacts
+// path that both this agent and the Stirling data collector (inside of the PEM, the Pixie
+// Edge Module) mmap. Symbols are batched and published with explicit flush epochs, so that
+// Stirling sees new symbols with bounded latency and without any per-symbol filesystem I/O.
+// If the ring cannot be set up, the agent falls back to the legacy symbol log file. Either
+// way, the symbols are used to resolve Java stack frames that cannot be found by inspecting
+// binaries (i.e. cannot be found by the "normal" means used to find symbols in compiled
+// binaries from C, C++, Go, and Rust).
+
+#include <fcntl.h>
 #include <jvmti.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
+#include <chrono>
 #include <mutex>
+#include <string>
+#include <thread>
 
 // NOLINTNEXTLINE: build/include_subdir
 #include "raw_symbol_update.h"
 
+// NOLINTNEXTLINE: build/include_subdir
+#include "symbol_ring.h"
+
 // NOLINTNEXTLINE: build/include_subdir
 #include "agent_hash.h"
 
@@ -47,11 +60,25 @@ namespace {
 constexpr bool kUsingTxtLogFile = false;
 constexpr bool kUsingBinLogFile = true;
 
+// Publish a pending batch once it exceeds this size, even between flusher thread wakeups.
+constexpr size_t kBatchFlushBytes = 64 * 1024;
+
+// The flusher thread publishes any pending batch on this period; this bounds the latency
+// between a JVMTI compile event and the symbol becoming visible to Stirling.
+constexpr auto kFlushPeriod = std::chrono::milliseconds{100};
+
 std::mutex g_mtx;
 bool g_callbacks_attached = false;
 FILE* g_log_file_ptr = nullptr;
 FILE* g_bin_file_ptr = nullptr;
 
+// Shared-memory symbol ring state. When g_ring_ok is true, symbol updates are batched into
+// g_batch (guarded by g_mtx) and published into g_ring; the bin file is not used.
+px::stirling::java::SymbolRing g_ring;
+bool g_ring_ok = false;
+std::string g_batch;
+uint64_t g_batch_num_updates = 0;
+
 }  // namespace
 
 void LogF(const char* format, ...) {
@@ -112,6 +139,25 @@ void FWriteRetryOnErr(FILE* f, T* p, const size_t n_total) {
   }
 }
 
+// Publishes the pending batch into the symbol ring & bumps the flush epoch.
+// Requires g_mtx to be held.
+void FlushBatchLocked() {
+  if (g_batch.empty()) {
+    return;
+  }
+  if (g_ring.TryPublish(g_batch.data(), g_batch.size())) {
+    g_ring.BumpFlushEpoch();
+  } else {
+    // The consumer has fallen too far behind (or is gone); drop the batch rather than
+    // block a JVMTI callback or grow without bound.
+    g_ring.AddDroppedUpdates(g_batch_num_updates);
+    LogF("[error] Symbol ring full; dropped %llu symbol updates.",
+         (unsigned long long)g_batch_num_updates);  // NOLINT: runtime/int
+  }
+  g_batch.clear();
+  g_batch_num_updates = 0;
+}
+
 void WriteSymbol(const uint64_t addr, const uint32_t code_size, const bool method_unload,
                  const char* const symbol_ptr, const char* const fn_sig_ptr,
                  const char* const class_sig_ptr) {
@@ -137,7 +183,18 @@ void WriteSymbol(const uint64_t addr, const uint32_t code_size, const bool metho
   } else {
     LogF("WriteSymbol|0x%016llx|%u|%s|%s|%s", addr, code_size, symbol, fn_sig, class_sig);
   }
-  if (g_bin_file_ptr != nullptr) {
+  if (g_ring_ok) {
+    // Batch the serialized update; published by FlushBatchLocked() (here, once the batch is
+    // large enough, or from the flusher thread within kFlushPeriod).
+    g_batch.append(reinterpret_cast<const char*>(&symbol_metadata), sizeof(symbol_metadata));
+    g_batch.append(symbol, symbol_metadata.symbol_size);
+    g_batch.append(fn_sig, symbol_metadata.fn_sig_size);
+    g_batch.append(class_sig, symbol_metadata.class_sig_size);
+    ++g_batch_num_updates;
+    if (g_batch.size() >= kBatchFlushBytes) {
+      FlushBatchLocked();
+    }
+  } else if (g_bin_file_ptr != nullptr) {
     FWriteRetryOnErr(g_bin_file_ptr, &symbol_metadata, sizeof(symbol_metadata));
     FWriteRetryOnErr(g_bin_file_ptr, symbol, symbol_metadata.symbol_size);
     FWriteRetryOnErr(g_bin_file_ptr, fn_sig, symbol_metadata.fn_sig_size);
@@ -338,6 +395,55 @@ FILE* FOpenLogFile(const std::string& file_path) {
   return f;
 }
 
+// Creates & maps the shared-memory symbol ring, and starts the flusher thread that bounds
+// the latency between a JVMTI compile event and publication into the ring.
+// Returns false (leaving g_ring_ok unset) if any step fails; the caller then falls back to
+// the legacy symbol log file.
+bool OpenSymbolRing(const std::string& artifacts_path) {
+  using px::stirling::java::kDefaultSymbolRingDataBytes;
+  using px::stirling::java::kSymbolRingFileName;
+  using px::stirling::java::SymbolRing;
+
+  const std::string ring_path = artifacts_path + "/" + kSymbolRingFileName;
+  const uint64_t total_bytes = SymbolRing::TotalBytes(kDefaultSymbolRingDataBytes);
+
+  const int fd = open(ring_path.c_str(), O_CREAT | O_RDWR, 0644);
+  if (fd == -1) {
+    LogF("[error] OpenSymbolRing() unable to open: %s.", ring_path.c_str());
+    return false;
+  }
+  if (ftruncate(fd, total_bytes) != 0) {
+    LogF("[error] OpenSymbolRing() unable to size: %s.", ring_path.c_str());
+    close(fd);
+    return false;
+  }
+  void* base = mmap(nullptr, total_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  // The mapping keeps the file contents alive; the fd is no longer needed.
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    LogF("[error] OpenSymbolRing() unable to mmap: %s.", ring_path.c_str());
+    return false;
+  }
+
+  g_ring = SymbolRing(base);
+  g_ring.Init(kDefaultSymbolRingDataBytes);
+  g_ring_ok = true;
+
+  // The flusher thread runs for the remaining lifetime of the JVM.
+  std::thread([]() {
+    while (true) {
+      std::this_thread::sleep_for(kFlushPeriod);
+      std::lock_guard<std::mutex> lock(g_mtx);
+      FlushBatchLocked();
+    }
+  }).detach();
+
+  LogF("OpenSymbolRing(), ring path: %s.", ring_path.c_str());
+  return true;
+}
+
 jint OpenLogFiles(const char* options) {
   if (options == nullptr) {
     return JNI_ERR;
@@ -356,6 +462,13 @@ jint OpenLogFiles(const char* options) {
       return JNI_ERR;
     }
   }
+
+  // Preferred symbol transport: the shared-memory symbol ring.
+  if (OpenSymbolRing(artifacts_path)) {
+    LogF("OpenLogFiles(), artifacts path pfx: %s.", options);
+    return JNI_OK;
+  }
+
   if (kUsingBinLogFile) {
     g_bin_file_ptr = FOpenLogFile(artifacts_path + "/" + px::stirling::java::kBinSymbolFileName);
     if (g_bin_file_ptr == nullptr) {
@@ -402,6 +515,12 @@ JNIEXPORT jint JNICALL Agent_OnAttach(JavaVM* jvm, char* options, void* /*reserv
   PX_JVMTI_AGENT_RETURN_IF_ERROR(SetCallbackFunctions(jvmti));
   PX_JVMTI_AGENT_RETURN_IF_ERROR(ReplayCallbacks(jvmti));
 
+  if (g_ring_ok) {
+    // Publish the replay burst promptly, rather than waiting out a flusher thread period.
+    std::lock_guard<std::mutex> lock(g_mtx);
+    FlushBatchLocked();
+  }
+
   LogF("Pixie JVMTI symbolization agent startup sequence complete.");
   return JNI_OK;
 }
@@ -21,7 +21,7 @@
 #include "src/common/exec/subprocess.h"
 #include "src/common/fs/fs_wrapper.h"
 #include "src/stirling/source_connectors/perf_profiler/java/agent/agent_hash.h"
-#include "src/stirling/source_connectors/perf_profiler/java/agent/raw_symbol_update.h"
+#include "src/stirling/source_connectors/perf_profiler/java/agent/symbol_ring.h"
 #include "src/stirling/testing/common.h"
 
 namespace px {
@@ -40,7 +40,10 @@ TEST(JavaAgentTest, ExpectedSymbolsTest) {
   ASSERT_TRUE(fs::Exists(kBazelAppPath));
 
   const fs_path artifacts_path = absl::Substitute("java-agent-test-$0", PX_JVMTI_AGENT_HASH);
-  const fs_path symbol_file_path = artifacts_path / java::kBinSymbolFileName;
+
+  // The agent publishes symbols into the shared-memory symbol ring. The symbol strings are
+  // stored raw in the ring's data region, so a substring check on the file contents works.
+  const fs_path symbol_file_path = artifacts_path / java::kSymbolRingFileName;
 
   if (fs::Exists(artifacts_path)) {
     // The symbol file is created by the Java process when the agent is attached.
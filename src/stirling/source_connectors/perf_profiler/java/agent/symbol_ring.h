@@ -0,0 +1,169 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+// NB: this file is compiled both into agent.so (inside of the agent build containers, with no
+// access to the px source tree) and into Stirling. Like raw_symbol_update.h, it can only depend
+// on the C and C++ standard libraries.
+
+namespace px {
+namespace stirling {
+namespace java {
+
+char const* const kSymbolRingFileName = "java-symbols.ring";
+
+// The symbol ring is a single-producer (JVMTI agent) single-consumer (Stirling) byte ring,
+// backed by a file in the symbolization artifacts path that both sides mmap with MAP_SHARED.
+// The agent batches RawSymbolUpdate records (each followed by its symbol/fn-sig/class-sig
+// strings, the same serialization as the legacy symbol file) and publishes whole batches by
+// advancing write_pos; each publish also advances flush_epoch. Stirling polls flush_epoch
+// (a plain shared-memory read, no syscalls) to detect new symbols, consumes complete records
+// up to write_pos, and advances read_pos so the agent can reuse the space.
+//
+// Positions are monotonic byte counts; the ring index is pos % data_capacity. Because batches
+// are published atomically (a single release-store of write_pos), the consumer only ever
+// observes whole records. If the consumer falls behind and a batch does not fit, the agent
+// drops the batch and counts the affected updates in dropped_updates.
+struct SymbolRingHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t data_capacity;
+  std::atomic<uint64_t> write_pos;
+  std::atomic<uint64_t> read_pos;
+  std::atomic<uint64_t> flush_epoch;
+  std::atomic<uint64_t> dropped_updates;
+};
+
+constexpr uint64_t kSymbolRingMagic = 0x5053594d52494e47ULL;  // "PSYMRING"
+constexpr uint32_t kSymbolRingVersion = 1;
+constexpr uint32_t kDefaultSymbolRingDataBytes = 4 * 1024 * 1024;
+
+// A view over a mapped symbol ring; both the agent (producer) and Stirling (consumer)
+// construct one of these on top of their own mapping of the ring file.
+class SymbolRing {
+ public:
+  SymbolRing() : base_(nullptr) {}
+  explicit SymbolRing(void* base) : base_(base) {}
+
+  static uint64_t TotalBytes(const uint32_t data_capacity) {
+    return sizeof(SymbolRingHeader) + data_capacity;
+  }
+
+  // Producer side: initializes a freshly created (zero-filled) ring file.
+  // The magic is written last so that a consumer never sees a half-initialized header.
+  void Init(const uint32_t data_capacity) {
+    header()->version = kSymbolRingVersion;
+    header()->data_capacity = data_capacity;
+    header()->write_pos.store(0, std::memory_order_relaxed);
+    header()->read_pos.store(0, std::memory_order_relaxed);
+    header()->flush_epoch.store(0, std::memory_order_relaxed);
+    header()->dropped_updates.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header()->magic = kSymbolRingMagic;
+  }
+
+  // Consumer side: checks that the mapping is an initialized ring of the expected version.
+  bool Valid(const uint64_t mapped_size) const {
+    if (mapped_size < sizeof(SymbolRingHeader)) {
+      return false;
+    }
+    return header()->magic == kSymbolRingMagic && header()->version == kSymbolRingVersion &&
+           mapped_size >= TotalBytes(header()->data_capacity);
+  }
+
+  // Producer side: copies n bytes into the ring and publishes them with a release-store of
+  // write_pos. Returns false (without writing) if the consumer has not freed enough space.
+  bool TryPublish(const char* bytes, const uint64_t n) {
+    const uint64_t write = header()->write_pos.load(std::memory_order_relaxed);
+    const uint64_t read = header()->read_pos.load(std::memory_order_acquire);
+    const uint64_t capacity = header()->data_capacity;
+    if (n > capacity - (write - read)) {
+      return false;
+    }
+    CopyIn(write, bytes, n);
+    header()->write_pos.store(write + n, std::memory_order_release);
+    return true;
+  }
+
+  void BumpFlushEpoch() { header()->flush_epoch.fetch_add(1, std::memory_order_release); }
+
+  void AddDroppedUpdates(const uint64_t n) {
+    header()->dropped_updates.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  uint64_t flush_epoch() const { return header()->flush_epoch.load(std::memory_order_acquire); }
+
+  uint64_t dropped_updates() const {
+    return header()->dropped_updates.load(std::memory_order_relaxed);
+  }
+
+  // Consumer side: number of published bytes not yet consumed.
+  uint64_t AvailableBytes() const {
+    return header()->write_pos.load(std::memory_order_acquire) -
+           header()->read_pos.load(std::memory_order_relaxed);
+  }
+
+  // Consumer side: copies out n bytes starting at the given offset past read_pos,
+  // without consuming them.
+  void Peek(const uint64_t offset, char* dst, const uint64_t n) const {
+    const uint64_t pos = header()->read_pos.load(std::memory_order_relaxed) + offset;
+    const uint64_t capacity = header()->data_capacity;
+    const uint64_t idx = pos % capacity;
+    const uint64_t contiguous = capacity - idx;
+    if (n <= contiguous) {
+      memcpy(dst, data() + idx, n);
+    } else {
+      memcpy(dst, data() + idx, contiguous);
+      memcpy(dst + contiguous, data(), n - contiguous);
+    }
+  }
+
+  // Consumer side: marks n bytes as consumed, releasing the space back to the producer.
+  void AdvanceRead(const uint64_t n) {
+    const uint64_t read = header()->read_pos.load(std::memory_order_relaxed);
+    header()->read_pos.store(read + n, std::memory_order_release);
+  }
+
+ private:
+  SymbolRingHeader* header() const { return reinterpret_cast<SymbolRingHeader*>(base_); }
+  char* data() const { return reinterpret_cast<char*>(base_) + sizeof(SymbolRingHeader); }
+
+  void CopyIn(const uint64_t pos, const char* src, const uint64_t n) {
+    const uint64_t capacity = header()->data_capacity;
+    const uint64_t idx = pos % capacity;
+    const uint64_t contiguous = capacity - idx;
+    if (n <= contiguous) {
+      memcpy(data() + idx, src, n);
+    } else {
+      memcpy(data() + idx, src, contiguous);
+      memcpy(data(), src + contiguous, n - contiguous);
+    }
+  }
+
+  void* base_;
+};
+
+}  // namespace java
+}  // namespace stirling
+}  // namespace px
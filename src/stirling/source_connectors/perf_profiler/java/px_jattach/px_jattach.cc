@@ -123,9 +123,10 @@ void AgentAttachApp::CreateArtifactsPathOrDie() {
     // instance has attempted to attach an agent *at the same time* as this Stirling process.
     // Otherwise, Stirling would have used the pre-existing symbol file (and therefore would
     // not have attempted to attach an agent).
-    const std::filesystem::path symbol_file_path = StirlingSymbolFilePath(target_upid_);
-    if (fs::Exists(symbol_file_path)) {
-      // The other Stirling instance injected a symbolization agent and created a symbol file.
+    if (fs::Exists(StirlingSymbolRingPath(target_upid_)) ||
+        fs::Exists(StirlingSymbolFilePath(target_upid_))) {
+      // The other Stirling instance injected a symbolization agent, which created a symbol
+      // ring (or, for older agents, a symbol file).
       std::exit(0);
     }
 
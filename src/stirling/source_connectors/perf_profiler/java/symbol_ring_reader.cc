@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "src/stirling/source_connectors/perf_profiler/java/symbol_ring_reader.h"
+
+namespace px {
+namespace stirling {
+namespace java {
+
+StatusOr<std::unique_ptr<SymbolRingReader>> SymbolRingReader::Create(
+    const std::filesystem::path& path) {
+  const int fd = open(path.string().c_str(), O_RDWR);
+  if (fd == -1) {
+    return error::Internal("Could not open symbol ring file: $0.", path.string());
+  }
+
+  struct stat sb;
+  if (fstat(fd, &sb) != 0) {
+    close(fd);
+    return error::Internal("Could not stat symbol ring file: $0.", path.string());
+  }
+  const uint64_t mapped_size = sb.st_size;
+
+  // The mapping is read & write: the reader writes read_pos to release consumed bytes.
+  void* base = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  // The mapping keeps the file contents alive; the fd is no longer needed.
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    return error::Internal("Could not mmap symbol ring file: $0.", path.string());
+  }
+
+  auto reader = std::unique_ptr<SymbolRingReader>(new SymbolRingReader(base, mapped_size));
+
+  if (!reader->ring_.Valid(mapped_size)) {
+    // The agent writes the ring magic last during initialization, so an invalid header most
+    // likely means we raced the agent startup; the caller can retry on its next iteration.
+    return error::Internal("Symbol ring file not (yet) initialized: $0.", path.string());
+  }
+  return reader;
+}
+
+SymbolRingReader::SymbolRingReader(void* base, const uint64_t mapped_size)
+    : base_(base), mapped_size_(mapped_size), ring_(base) {}
+
+SymbolRingReader::~SymbolRingReader() { munmap(base_, mapped_size_); }
+
+void SymbolRingReader::ConsumeUpdates(const SymbolUpdateFn& fn) {
+  // The available byte count is sampled once: bytes published during this call are picked up
+  // on the next call (whose caller will also observe a newer flush epoch).
+  const uint64_t available = ring_.AvailableBytes();
+
+  RawSymbolUpdate update;
+  uint64_t consumed = 0;
+
+  while (available - consumed >= sizeof(RawSymbolUpdate)) {
+    ring_.Peek(consumed, reinterpret_cast<char*>(&update), sizeof(RawSymbolUpdate));
+
+    const uint64_t n = update.TotalNumSymbolBytes();
+    if (available - consumed < sizeof(RawSymbolUpdate) + n) {
+      // Defensive: the agent publishes whole records, so a partial record should not be
+      // observable. Leave it for the next call rather than reading past the published bytes.
+      break;
+    }
+
+    if (staging_.size() < n) {
+      staging_.resize(n);
+    }
+    ring_.Peek(consumed + sizeof(RawSymbolUpdate), staging_.data(), n);
+    fn(update, staging_.data());
+
+    consumed += sizeof(RawSymbolUpdate) + n;
+  }
+
+  if (consumed > 0) {
+    ring_.AdvanceRead(consumed);
+  }
+}
+
+}  // namespace java
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "src/common/base/base.h"
+#include "src/stirling/source_connectors/perf_profiler/java/agent/raw_symbol_update.h"
+#include "src/stirling/source_connectors/perf_profiler/java/agent/symbol_ring.h"
+
+namespace px {
+namespace stirling {
+namespace java {
+
+// The Stirling-side consumer of the shared-memory symbol ring written by the JVMTI
+// symbolization agent (see agent/symbol_ring.h for the ring layout & protocol).
+// Create() maps the ring file for the target JVM; ConsumeUpdates() then hands back every
+// symbol update published since the previous call. Checking for new symbols is a plain
+// shared-memory read of the flush epoch, so polling is free when the JVM is quiescent.
+class SymbolRingReader : public NotCopyable {
+ public:
+  // Callback invoked per symbol update; symbol_bytes points at update.TotalNumSymbolBytes()
+  // bytes laid out per the offsets in RawSymbolUpdate, valid only for the duration of the call.
+  using SymbolUpdateFn = std::function<void(const RawSymbolUpdate& update, char* symbol_bytes)>;
+
+  static StatusOr<std::unique_ptr<SymbolRingReader>> Create(const std::filesystem::path& path);
+  ~SymbolRingReader();
+
+  // The agent bumps the flush epoch each time it publishes a batch. A reader that has seen
+  // epoch e has seen every update published up to that bump; if the epoch is unchanged,
+  // ConsumeUpdates() would find nothing and can be skipped entirely.
+  uint64_t flush_epoch() const { return ring_.flush_epoch(); }
+
+  // Count of symbol updates the agent dropped because the ring was full (i.e. because we
+  // fell too far behind); these symbols are permanently lost to this reader.
+  uint64_t dropped_updates() const { return ring_.dropped_updates(); }
+
+  // Invokes fn for each complete symbol update published since the previous call,
+  // then releases the consumed bytes back to the agent.
+  void ConsumeUpdates(const SymbolUpdateFn& fn);
+
+ private:
+  SymbolRingReader(void* base, uint64_t mapped_size);
+
+  void* base_;
+  const uint64_t mapped_size_;
+  SymbolRing ring_;
+
+  // Staging area for copying records out of the ring (records may wrap the ring end).
+  std::string staging_;
+};
+
+}  // namespace java
+}  // namespace stirling
+}  // namespace px
@@ -40,17 +40,19 @@ DEFINE_uint32(stirling_profiler_table_update_period_seconds,
               "Number of seconds between profiler table updates.");
 DEFINE_uint32(stirling_profiler_stack_trace_sample_period_ms, 11,
               "Number of milliseconds between stack trace samples.");
+DEFINE_uint32(stirling_profiler_on_demand_period_ms, 1000,
+              "Number of milliseconds between profiler table updates while an on-demand "
+              "profiling request is active (see PerfProfileConnector::StartOnDemandProfiling).");
+DEFINE_bool(stirling_profiler_intern_stack_traces, false,
+            "If true, emit the folded stack trace string only on the first record of each "
+            "stack_trace_id per aging period; repeat records carry an empty string and must "
+            "be joined to a prior record on stack_trace_id to recover the string. Cuts table "
+            "memory and transfer volume when the same stacks repeat across update periods.");
 
 // Scaling factor is sized to avoid hash table collisions and timing variations.
 DEFINE_double(stirling_profiler_stack_trace_size_factor, 3.0,
               "Scaling factor to apply to Profiler's eBPF stack trace map sizes");
 
-// Scaling factor for perf buffer to account for timing variations.
-// This factor is smaller than the stack trace scaling factor because there is no need to account
-// for hash table collisions.
-DEFINE_double(stirling_profiler_perf_buffer_size_factor, 1.2,
-              "Scaling factor to apply to Profiler's eBPF perf buffer sizes");
-
 namespace px {
 namespace stirling {
 
@@ -97,26 +99,6 @@ Status PerfProfileConnector::InitImpl() {
   // but it should be lower than provisioned_stack_traces.
   const int32_t overrun_threshold = (expected_stack_traces + provisioned_stack_traces) / 2;
 
-  // Compute the size of the perf buffers.
-  const double perf_buffer_overprovision_factor = FLAGS_stirling_profiler_perf_buffer_size_factor;
-  const int32_t num_perf_buffer_entries =
-      static_cast<int32_t>(perf_buffer_overprovision_factor * expected_stack_traces_per_cpu);
-
-  // Perf buffer entries use the following struct:
-  //      struct {
-  //        struct perf_event_header {
-  //          __u32   type;
-  //          __u16   misc;
-  //          __u16   size;
-  //        } header;
-  //        u32    size;        /* if PERF_SAMPLE_RAW */
-  //        char  data[size];   /* if PERF_SAMPLE_RAW */
-  //      };
-  // The entire struct as a whole is 12-bytes + data[size].
-  const int32_t perf_buffer_entry_size =
-      sizeof(struct perf_event_header) + sizeof(uint32_t) + sizeof(stack_trace_key_t);
-  const int32_t perf_buffer_size = perf_buffer_entry_size * num_perf_buffer_entries;
-
   const std::vector<std::string> defines = {
       absl::Substitute("-DCFG_STACK_TRACE_ENTRIES=$0", provisioned_stack_traces),
       absl::Substitute("-DCFG_OVERRUN_THRESHOLD=$0", overrun_threshold),
@@ -125,19 +107,16 @@ Status PerfProfileConnector::InitImpl() {
   const auto probe_specs = MakeArray<bpf_tools::SamplingProbeSpec>(
       {"sample_call_stack", static_cast<uint64_t>(stack_trace_sampling_period_.count())});
 
-  const auto perf_buffer_specs = MakeArray<bpf_tools::PerfBufferSpec>(
-      {{"histogram_a", HandleHistoEvent, HandleHistoLoss, perf_buffer_size},
-       {"histogram_b", HandleHistoEvent, HandleHistoLoss, perf_buffer_size}});
-
   PL_RETURN_IF_ERROR(InitBPFProgram(profiler_bcc_script, defines));
   PL_RETURN_IF_ERROR(AttachSamplingProbes(probe_specs));
-  PL_RETURN_IF_ERROR(OpenPerfBuffers(perf_buffer_specs, this));
 
   stack_traces_a_ = std::make_unique<ebpf::BPFStackTable>(GetStackTable("stack_traces_a"));
   stack_traces_b_ = std::make_unique<ebpf::BPFStackTable>(GetStackTable("stack_traces_b"));
 
-  histogram_a_perf_buffer_ = GetPerfBuffer("histogram_a");
-  histogram_b_perf_buffer_ = GetPerfBuffer("histogram_b");
+  histogram_a_ = std::make_unique<RawHistogram>(
+      GetHashTable<stack_trace_key_t, uint64_t>("histogram_a"));
+  histogram_b_ = std::make_unique<RawHistogram>(
+      GetHashTable<stack_trace_key_t, uint64_t>("histogram_b"));
 
   profiler_state_ =
       std::make_unique<ebpf::BPFArrayTable<uint64_t>>(GetArrayTable<uint64_t>("profiler_state"));
@@ -170,10 +149,26 @@ Status PerfProfileConnector::InitImpl() {
     PL_ASSIGN_OR_RETURN(k_symbolizer_, CachingSymbolizer::Create(std::move(k_symbolizer_)));
   }
 
+  // Start the symbolization thread. From here on, the symbolizers are used exclusively by
+  // that thread, so that a symbolization latency spike (e.g. a Java attach or a large
+  // binary's symbol table) does not stall the shared transfer thread.
+  symbolization_thread_ = std::thread(&PerfProfileConnector::RunSymbolizationThread, this);
+
   return Status::OK();
 }
 
 Status PerfProfileConnector::StopImpl() {
+  // Stop the symbolization thread first: it drains any remaining work before exiting,
+  // and joining it here ensures no other thread is alive when we tear down BCC below.
+  {
+    std::lock_guard<std::mutex> lock(symbolization_mu_);
+    symbolization_stop_ = true;
+  }
+  symbolization_cv_.notify_all();
+  if (symbolization_thread_.joinable()) {
+    symbolization_thread_.join();
+  }
+
   // Must call Close() after attach_uprobes_thread_ has joined,
   // otherwise the two threads will cause concurrent accesses to BCC,
   // that will cause races and undefined behavior.
@@ -181,23 +176,6 @@ Status PerfProfileConnector::StopImpl() {
   return Status::OK();
 }
 
-void PerfProfileConnector::AcceptStackTraceKey(stack_trace_key_t* data) {
-  raw_histo_data_.push_back(*data);
-}
-
-void PerfProfileConnector::HandleHistoEvent(void* cb_cookie, void* data, int /*data_size*/) {
-  DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
-  auto* connector = static_cast<PerfProfileConnector*>(cb_cookie);
-  auto* histo_key_ptr = static_cast<stack_trace_key_t*>(data);
-  connector->AcceptStackTraceKey(histo_key_ptr);
-}
-
-void PerfProfileConnector::HandleHistoLoss(void* cb_cookie, uint64_t lost) {
-  DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
-  auto* connector = static_cast<PerfProfileConnector*>(cb_cookie);
-  connector->stats_.Increment(StatKey::kLossHistoEvent, lost);
-}
-
 void PerfProfileConnector::CleanupSymbolizers(const absl::flat_hash_set<md::UPID>& deleted_upids) {
   for (const auto& md_upid : deleted_upids) {
     // Clean-up caches.
@@ -219,41 +197,61 @@ void PerfProfileConnector::CleanupSymbolizers(const absl::flat_hash_set<md::UPID
   }
 }
 
-PerfProfileConnector::StackTraceHisto PerfProfileConnector::AggregateStackTraces(
-    ConnectorContext* ctx, ebpf::BPFStackTable* stack_traces) {
-  // TODO(jps): switch from using get_table_offline() to directly stepping through
-  // the histogram data structure. Inline populating our own data structures with this.
-  // Avoid an unnecessary copy of the information in local stack_trace_keys_and_counts.
-  StackTraceHisto symbolic_histogram;
-  uint64_t cum_sum_count = 0;
+PerfProfileConnector::SymbolizationBatch PerfProfileConnector::BuildSymbolizationBatch(
+    ConnectorContext* ctx, ebpf::BPFStackTable* stack_traces, RawHistogram* histogram) {
+  SymbolizationBatch batch;
+  batch.timestamp_ns = AdjustedSteadyClockNowNS();
+  batch.asid = ctx->GetASID();
 
-  const uint32_t asid = ctx->GetASID();
-  const absl::flat_hash_set<md::UPID>& upids_for_symbolization = ctx->GetUPIDs();
+  // Find destroyed processes: the symbolization thread uses this to clean up symbolizer state.
+  proc_tracker_.Update(ctx->GetUPIDs());
+  batch.deleted_upids = proc_tracker_.deleted_upids();
 
-  // Cause symbolizers to perform any necessary updates before we put them to work.
-  u_symbolizer_->IterationPreTick();
-  k_symbolizer_->IterationPreTick();
+  const absl::flat_hash_set<md::UPID>& upids_for_symbolization = ctx->GetUPIDs();
 
-  // Create a new stringifier for this iteration of the continuous perf profiler.
-  Stringifier stringifier(u_symbolizer_.get(), k_symbolizer_.get(), stack_traces);
+  // Snapshot the on-demand targets: entries for these UPIDs are always symbolized, even if
+  // the metadata state has not caught up to the process yet.
+  absl::flat_hash_set<md::UPID> on_demand_upids;
+  {
+    std::lock_guard<std::mutex> lock(on_demand_mu_);
+    on_demand_upids = on_demand_upids_;
+  }
 
+  uint64_t cum_sum_count = 0;
   absl::flat_hash_set<int> k_stack_ids_to_remove;
 
-  for (const auto& stack_trace_key : raw_histo_data_) {
-    std::string stack_trace_str;
+  // Drain the in-kernel histogram for this map set. The samples were deduplicated and counted
+  // in-kernel, so each entry here represents a unique (upid, stack-trace) pair with its count.
+  constexpr bool kClearTable = true;
+  const std::vector<std::pair<stack_trace_key_t, uint64_t>> histo =
+      histogram->get_table_offline(kClearTable);
 
-    const md::UPID upid(asid, stack_trace_key.upid.pid, stack_trace_key.upid.start_time_ticks);
-    const bool symbolize = upids_for_symbolization.contains(upid);
+  batch.entries.reserve(histo.size());
+
+  for (const auto& [stack_trace_key, count] : histo) {
+    const md::UPID upid(batch.asid, stack_trace_key.upid.pid,
+                        stack_trace_key.upid.start_time_ticks);
+    const bool on_demand = on_demand_upids.contains(upid);
+    const bool symbolize = on_demand || upids_for_symbolization.contains(upid);
+    batch.has_on_demand_target = batch.has_on_demand_target || on_demand;
 
     if (symbolize) {
-      // The stringifier clears stack-ids out of the stack traces table when it
-      // first encounters them. If a stack-id is reused by a different stack-trace-key,
-      // the stringifier returns its memoized stack trace string. Because the stack-ids
-      // are not stable across profiler iterations, we create and destroy a stringifer
-      // on each profiler iteration.
-      stack_trace_str = stringifier.FoldedStackTraceString(stack_trace_key);
+      // Extract the stack trace addresses for the symbolization thread.
+      // Each stack-id is extracted (and cleared) exactly once: stack-ids can be shared
+      // between stack-trace-keys (this is especially common for kernel stack-ids).
+      constexpr bool kClearStackId = true;
+      if (stack_trace_key.user_stack_id >= 0 &&
+          !batch.stack_addrs.contains(stack_trace_key.user_stack_id)) {
+        batch.stack_addrs[stack_trace_key.user_stack_id] =
+            stack_traces->get_stack_addr(stack_trace_key.user_stack_id, kClearStackId);
+      }
+      if (stack_trace_key.kernel_stack_id >= 0 &&
+          !batch.stack_addrs.contains(stack_trace_key.kernel_stack_id)) {
+        batch.stack_addrs[stack_trace_key.kernel_stack_id] =
+            stack_traces->get_stack_addr(stack_trace_key.kernel_stack_id, kClearStackId);
+      }
     } else {
-      // If we do not stringifiy this stack trace, we still need to clear
+      // If we will not symbolize this stack trace, we still need to clear
       // its entry from the stack traces table. It is safe to do so immediately
       // for the user stack-id, but we need to allow the kernel stack-id to remain
       // in the stack-traces table in case it gets used by a stack trace that we
@@ -264,100 +262,233 @@ PerfProfileConnector::StackTraceHisto PerfProfileConnector::AggregateStackTraces
       if (stack_trace_key.kernel_stack_id >= 0) {
         k_stack_ids_to_remove.insert(stack_trace_key.kernel_stack_id);
       }
-      stack_trace_str = std::string(profiler::kNotSymbolizedMessage);
     }
 
-    profiler::SymbolicStackTrace symbolic_stack_trace = {upid, std::move(stack_trace_str)};
-
-    ++symbolic_histogram[symbolic_stack_trace];
-    ++cum_sum_count;
-
-    // TODO(jps): If we see a perf. issue with having two maps keyed by symbolic-stack-trace,
-    // refactor such that creating/finding symoblic-stack-trace-id and count aggregation
-    // are both done here, in AggregateStackTraces().
-    // One possible implementation:
-    // make the histogram a map from "symbolic-track-trace" => "count & stack-trace-id"
-    // e.g.:
-    // ... auto& count_and_id = symbolic_histogram[symbolic_stack_trace];
-    // ... count_and_id.id = id;
-    // ... count_and_id.count += count;
-    // alternate impl. is a map from "stack-trace-id" => "count & symbolic-stack-trace"
+    batch.entries.push_back({stack_trace_key, count, symbolize});
+    cum_sum_count += count;
   }
 
   // Clear any kernel stack-ids, that were potentially not already cleared,
   // out of the stack traces table.
   for (const int k_stack_id : k_stack_ids_to_remove) {
-    stack_traces->clear_stack_id(k_stack_id);
+    if (!batch.stack_addrs.contains(k_stack_id)) {
+      stack_traces->clear_stack_id(k_stack_id);
+    }
   }
 
-  raw_histo_data_.clear();
-
-  VLOG(1) << "PerfProfileConnector::AggregateStackTraces(): cum_sum_count: " << cum_sum_count;
+  VLOG(1) << "PerfProfileConnector::BuildSymbolizationBatch(): cum_sum_count: " << cum_sum_count;
   stats_.Increment(StatKey::kCumulativeSumOfAllStackTraces, cum_sum_count);
+  return batch;
+}
+
+PerfProfileConnector::StackTraceHisto PerfProfileConnector::SymbolizeBatch(
+    const SymbolizationBatch& batch) {
+  StackTraceHisto symbolic_histogram;
+
+  // Cause symbolizers to perform any necessary updates before we put them to work.
+  u_symbolizer_->IterationPreTick();
+  k_symbolizer_->IterationPreTick();
+
+  // Create a new stringifier for this batch. The stringifier memoizes its results per
+  // stack-id, so if a stack-id is reused by a different stack-trace-key, the folded stack
+  // trace string is built only once. Because the stack-ids are not stable across profiler
+  // iterations, we create and destroy a stringifier on each batch.
+  Stringifier stringifier(u_symbolizer_.get(), k_symbolizer_.get(),
+                          [&batch](const int stack_id) -> std::vector<uintptr_t> {
+                            auto iter = batch.stack_addrs.find(stack_id);
+                            if (iter == batch.stack_addrs.end()) {
+                              return {};
+                            }
+                            return iter->second;
+                          });
+
+  for (const auto& entry : batch.entries) {
+    std::string stack_trace_str;
+    if (entry.symbolize) {
+      stack_trace_str = stringifier.FoldedStackTraceString(entry.key);
+    } else {
+      stack_trace_str = std::string(profiler::kNotSymbolizedMessage);
+    }
+
+    const md::UPID upid(batch.asid, entry.key.upid.pid, entry.key.upid.start_time_ticks);
+    profiler::SymbolicStackTrace symbolic_stack_trace = {upid, std::move(stack_trace_str)};
+
+    symbolic_histogram[symbolic_stack_trace] += entry.count;
+  }
+
   return symbolic_histogram;
 }
 
-void PerfProfileConnector::CreateRecords(ebpf::BPFStackTable* stack_traces, ConnectorContext* ctx,
-                                         DataTable* data_table) {
+void PerfProfileConnector::RunSymbolizationThread() {
+  while (true) {
+    SymbolizationBatch batch;
+    {
+      std::unique_lock<std::mutex> lock(symbolization_mu_);
+      symbolization_cv_.wait(lock,
+                             [this] { return symbolization_stop_ || !work_queue_.empty(); });
+      if (work_queue_.empty()) {
+        // Stop requested and no work left: exit. We drain the work queue before exiting
+        // so that already-extracted stack traces are not silently discarded.
+        return;
+      }
+      batch = std::move(work_queue_.front());
+      work_queue_.pop_front();
+    }
+
+    // Cleanup the symbolizer so we don't leak memory.
+    CleanupSymbolizers(batch.deleted_upids);
+
+    SymbolizedBatch result;
+    result.timestamp_ns = batch.timestamp_ns;
+    result.histogram = SymbolizeBatch(batch);
+
+    if (batch.print_symbolizer_stats) {
+      PrintSymbolizerStats();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(symbolization_mu_);
+      results_queue_.push_back(std::move(result));
+      ++num_batches_completed_;
+    }
+    symbolization_cv_.notify_all();
+  }
+}
+
+void PerfProfileConnector::CreateRecords(const SymbolizedBatch& batch, DataTable* data_table) {
   constexpr size_t kMaxSymbolSize = 512;
   constexpr size_t kMaxStackDepth = 64;
   constexpr size_t kMaxStackTraceSize = kMaxStackDepth * kMaxSymbolSize;
 
-  const uint64_t timestamp_ns = AdjustedSteadyClockNowNS();
-
   // Stack traces from kernel/BPF are ordered lists of instruction pointers (addresses).
-  // AggregateStackTraces() will collapse some of those into identical symbolic stack traces;
+  // SymbolizeBatch() will collapse some of those into identical symbolic stack traces;
   // for example, consider the following two stack traces from BPF:
   // p0, p1, p2 => main;qux;baz   # both p2 & p3 point into baz.
   // p0, p1, p3 => main;qux;baz
 
-  StackTraceHisto stack_trace_histogram = AggregateStackTraces(ctx, stack_traces);
-
   constexpr auto age_tick_period = std::chrono::minutes(5);
   if (sampling_freq_mgr_.count() % (age_tick_period / sampling_period_) == 0) {
     stack_trace_ids_.AgeTick();
   }
 
-  for (const auto& [key, count] : stack_trace_histogram) {
-    DataTable::RecordBuilder<&kStackTraceTable> r(data_table, timestamp_ns);
+  for (const auto& [key, count] : batch.histogram) {
+    bool first_lookup_this_generation = false;
+    const uint64_t stack_trace_id = stack_trace_ids_.Lookup(key, &first_lookup_this_generation);
+
+    // When interning, the stack trace string is emitted only on the first record of each ID
+    // per aging period; repeat records carry an empty string. Because IDs are stable for the
+    // duration of the aging period (see StackTraceIDCache), a consumer can recover the string
+    // by joining back on stack_trace_id, and is guaranteed to find it within one aging period.
+    const bool emit_stack_trace_str =
+        !FLAGS_stirling_profiler_intern_stack_traces || first_lookup_this_generation;
 
-    r.Append<r.ColIndex("time_")>(timestamp_ns);
+    DataTable::RecordBuilder<&kStackTraceTable> r(data_table, batch.timestamp_ns);
+
+    r.Append<r.ColIndex("time_")>(batch.timestamp_ns);
     r.Append<r.ColIndex("upid")>(key.upid.value());
-    r.Append<r.ColIndex("stack_trace_id")>(stack_trace_ids_.Lookup(key));
-    r.Append<r.ColIndex("stack_trace")>(key.stack_trace_str, kMaxStackTraceSize);
+    r.Append<r.ColIndex("stack_trace_id")>(stack_trace_id);
+    r.Append<r.ColIndex("stack_trace")>(emit_stack_trace_str ? key.stack_trace_str : "",
+                                        kMaxStackTraceSize);
     r.Append<r.ColIndex("count")>(count);
   }
 }
 
+void PerfProfileConnector::DrainSymbolizedResults(DataTable* data_table) {
+  std::deque<SymbolizedBatch> results;
+  {
+    std::unique_lock<std::mutex> lock(symbolization_mu_);
+    // Wait (bounded) for outstanding batches. Normally, symbolization completes well within
+    // the timeout, so records land on the same iteration their samples were collected.
+    symbolization_cv_.wait_for(lock, kDrainResultsTimeout,
+                               [this] { return num_batches_completed_ == num_batches_submitted_; });
+    results.swap(results_queue_);
+  }
+  for (const auto& result : results) {
+    CreateRecords(result, data_table);
+  }
+}
+
 void PerfProfileConnector::ProcessBPFStackTraces(ConnectorContext* ctx, DataTable* data_table) {
   // Choose the maps to consume.
   const bool using_map_set_a = transfer_count_ % 2 == 0;
   auto& stack_traces = using_map_set_a ? stack_traces_a_ : stack_traces_b_;
-  auto& histo_perf_buf = using_map_set_a ? histogram_a_perf_buffer_ : histogram_b_perf_buffer_;
+  auto& histogram = using_map_set_a ? histogram_a_ : histogram_b_;
   const uint32_t sample_count_idx = using_map_set_a ? kSampleCountAIdx : kSampleCountBIdx;
 
-  // Read out the perf buffer that contains the histogram for this iteration.
-  // TODO(jps): change PollPerfBuffer() to use std::chrono.
-  constexpr int kPollTimeoutMS = 0;
-  histo_perf_buf->poll(kPollTimeoutMS);
-
   ++transfer_count_;
 
-  // First, tell BPF to switch the maps it writes to.
+  // First, tell BPF to switch the maps it writes to,
+  // so that we drain a histogram that is no longer being written.
   const ebpf::StatusTuple s = profiler_state_->update_value(kTransferCountIdx, transfer_count_);
   LOG_IF(ERROR, !s.ok()) << "Error writing transfer_count_";
 
-  // Read BPF stack traces & histogram, build records, incorporate records to data table.
-  CreateRecords(stack_traces.get(), ctx, data_table);
+  // Drain the BPF histogram & stack traces into a batch of raw (addresses, count) entries.
+  // This must happen on this thread (BCC map access is not thread-safe), but it is cheap:
+  // symbolization, the expensive part, is deferred to the symbolization thread.
+  SymbolizationBatch batch = BuildSymbolizationBatch(ctx, stack_traces.get(), histogram.get());
+  batch.print_symbolizer_stats = sampling_freq_mgr_.count() % stats_log_interval_ == 0;
+
+  {
+    std::lock_guard<std::mutex> lock(symbolization_mu_);
+    if (work_queue_.size() >= kMaxSymbolizationQueueDepth && !batch.has_on_demand_target) {
+      // Bounded queue: drop this batch rather than stalling the transfer thread
+      // or growing without limit when symbolization cannot keep up. Batches carrying
+      // on-demand targets are exempt; the on-demand window is short, so the overshoot
+      // is bounded by (window / on-demand period) batches.
+      stats_.Increment(StatKey::kSymbolizationBatchesDropped, 1);
+    } else {
+      work_queue_.push_back(std::move(batch));
+      ++num_batches_submitted_;
+    }
+  }
+  symbolization_cv_.notify_all();
+
+  // Append the batches the symbolization thread has finished. In the common case, this
+  // includes the batch submitted just above; if symbolization is running long, the records
+  // are picked up on a later iteration instead.
+  DrainSymbolizedResults(data_table);
 
   // Now that we've consumed the data, reset the sample count in BPF.
   profiler_state_->update_value(sample_count_idx, 0);
 }
 
+void PerfProfileConnector::StartOnDemandProfiling(absl::flat_hash_set<md::UPID> target_upids,
+                                                  std::chrono::milliseconds duration) {
+  const std::chrono::milliseconds on_demand_period{FLAGS_stirling_profiler_on_demand_period_ms};
+  std::lock_guard<std::mutex> lock(on_demand_mu_);
+  LOG(INFO) << absl::Substitute(
+      "PerfProfiler: on-demand profiling of $0 processes for $1 ms (update period $2 ms).",
+      target_upids.size(), duration.count(), on_demand_period.count());
+  on_demand_upids_ = std::move(target_upids);
+  on_demand_deadline_ = std::chrono::steady_clock::now() + duration;
+  if (!on_demand_active_) {
+    on_demand_active_ = true;
+    sampling_freq_mgr_.set_period(on_demand_period);
+    push_freq_mgr_.set_period(on_demand_period);
+    // Reset so the shorter period takes effect now, rather than when the current
+    // (up to 30 second) cycle runs out.
+    sampling_freq_mgr_.Reset();
+    push_freq_mgr_.Reset();
+  }
+}
+
+void PerfProfileConnector::UpdateOnDemandState() {
+  std::lock_guard<std::mutex> lock(on_demand_mu_);
+  if (on_demand_active_ && std::chrono::steady_clock::now() >= on_demand_deadline_) {
+    LOG(INFO) << "PerfProfiler: on-demand profiling window ended; reverting to normal cadence.";
+    on_demand_active_ = false;
+    on_demand_upids_.clear();
+    sampling_freq_mgr_.set_period(sampling_period_);
+    push_freq_mgr_.set_period(push_period_);
+  }
+}
+
 void PerfProfileConnector::TransferDataImpl(ConnectorContext* ctx,
                                             const std::vector<DataTable*>& data_tables) {
   DCHECK_EQ(data_tables.size(), 1);
 
+  UpdateOnDemandState();
+
   auto* data_table = data_tables[0];
 
   if (data_table == nullptr) {
@@ -366,10 +497,6 @@ void PerfProfileConnector::TransferDataImpl(ConnectorContext* ctx,
 
   ProcessBPFStackTraces(ctx, data_table);
 
-  // Cleanup the symbolizer so we don't leak memory.
-  proc_tracker_.Update(ctx->GetUPIDs());
-  CleanupSymbolizers(proc_tracker_.deleted_upids());
-
   stats_.Increment(StatKey::kBPFMapSwitchoverEvent, 1);
 
   if (sampling_freq_mgr_.count() % stats_log_interval_ == 0) {
@@ -379,6 +506,10 @@ void PerfProfileConnector::TransferDataImpl(ConnectorContext* ctx,
 
 void PerfProfileConnector::PrintStats() const {
   LOG(INFO) << "PerfProfileConnector statistics: " << stats_.Print();
+}
+
+// Called from the symbolization thread, which owns the symbolizers.
+void PerfProfileConnector::PrintSymbolizerStats() const {
   if (FLAGS_stirling_profiler_cache_symbols) {
     auto u_symbolizer = static_cast<CachingSymbolizer*>(u_symbolizer_.get());
     auto k_symbolizer = static_cast<CachingSymbolizer*>(k_symbolizer_.get());
@@ -18,8 +18,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -67,11 +71,30 @@ class PerfProfileConnector : public SourceConnector, public bpf_tools::BCCWrappe
   enum class StatKey {
     kBPFMapSwitchoverEvent,
     kCumulativeSumOfAllStackTraces,
-    kLossHistoEvent,
+    kSymbolizationBatchesDropped,
   };
 
   utils::StatCounter<StatKey> stats() const { return stats_; }
 
+  /**
+   * Temporarily switches the profiler into on-demand mode for the target processes: the BPF
+   * state is drained and symbolized every --stirling_profiler_on_demand_period_ms instead of
+   * every table update period, so freshly collected folded stack traces reach the stack traces
+   * table within a second or two of the request. Entries for the target UPIDs are always
+   * symbolized, and their batches bypass the symbolization queue bound. Reverts automatically
+   * once `duration` has elapsed. A second call replaces the current request.
+   *
+   * Thread-safe, but the frequency-manager retune is only race-free when the caller is
+   * serialized with the sampling loop (Stirling::ProfileOnDemand holds the appropriate lock).
+   */
+  void StartOnDemandProfiling(absl::flat_hash_set<md::UPID> target_upids,
+                              std::chrono::milliseconds duration);
+
+  bool on_demand_active() const {
+    std::lock_guard<std::mutex> lock(on_demand_mu_);
+    return on_demand_active_;
+  }
+
  private:
   // The time interval between stack trace samples, i.e. the sample rate used inside of BPF.
   const std::chrono::milliseconds stack_trace_sampling_period_;
@@ -85,27 +108,79 @@ class PerfProfileConnector : public SourceConnector, public bpf_tools::BCCWrappe
   // StackTraceHisto: SymbolicStackTrace => observation-count
   using StackTraceHisto = absl::flat_hash_map<profiler::SymbolicStackTrace, uint64_t>;
 
-  // RawHistoData: a list of stack trace keys that will need to be histogrammed.
-  using RawHistoData = std::vector<stack_trace_key_t>;
+  // RawHistogram: the in-kernel histogram, a map from stack-trace-key to observation-count.
+  using RawHistogram = ebpf::BPFHashTable<stack_trace_key_t, uint64_t>;
+
+  // One raw (stack-trace-key, count) entry drained from the in-kernel histogram,
+  // plus the decision of whether its stack traces should be symbolized.
+  struct RawHistoEntry {
+    stack_trace_key_t key;
+    uint64_t count;
+    bool symbolize;
+  };
+
+  // One iteration's worth of raw profiler output, handed to the symbolization thread.
+  // The stack trace addresses are extracted (destructively) on the transfer thread,
+  // because BCC map access is not thread-safe; everything the symbolization thread
+  // needs is copied into the batch.
+  struct SymbolizationBatch {
+    uint64_t timestamp_ns = 0;
+    uint32_t asid = 0;
+    std::vector<RawHistoEntry> entries;
+    // Addresses for each stack-trace-id referenced by entries.
+    absl::flat_hash_map<int, std::vector<uintptr_t>> stack_addrs;
+    // UPIDs deleted since the previous batch; used to clean up symbolizer state.
+    absl::flat_hash_set<md::UPID> deleted_upids;
+    // Set on the stats log interval; the symbolization thread owns the symbolizers
+    // and therefore also their stats printouts.
+    bool print_symbolizer_stats = false;
+    // Set when any entry belongs to an on-demand profiling target; such batches bypass the
+    // symbolization queue bound so the requested stacks are never dropped.
+    bool has_on_demand_target = false;
+  };
+
+  // A symbolized iteration, handed back to the transfer thread for table append.
+  struct SymbolizedBatch {
+    uint64_t timestamp_ns = 0;
+    StackTraceHisto histogram;
+  };
 
   explicit PerfProfileConnector(std::string_view source_name);
 
   void ProcessBPFStackTraces(ConnectorContext* ctx, DataTable* data_table);
 
-  // Read BPF data structures, build & incorporate records to the table.
-  void CreateRecords(ebpf::BPFStackTable* stack_traces, ConnectorContext* ctx,
-                     DataTable* data_table);
+  // Drain the in-kernel histogram & extract the referenced stack traces (transfer thread).
+  SymbolizationBatch BuildSymbolizationBatch(ConnectorContext* ctx,
+                                             ebpf::BPFStackTable* stack_traces,
+                                             RawHistogram* histogram);
+
+  // Symbolize one batch into a symbolic histogram (symbolization thread).
+  StackTraceHisto SymbolizeBatch(const SymbolizationBatch& batch);
 
-  StackTraceHisto AggregateStackTraces(ConnectorContext* ctx, ebpf::BPFStackTable* stack_traces);
+  // Main loop of the symbolization thread.
+  void RunSymbolizationThread();
+
+  // Build & incorporate records for a symbolized batch to the table (transfer thread).
+  void CreateRecords(const SymbolizedBatch& batch, DataTable* data_table);
+
+  // Append any batches the symbolization thread has finished (transfer thread).
+  void DrainSymbolizedResults(DataTable* data_table);
 
   void CleanupSymbolizers(const absl::flat_hash_set<md::UPID>& deleted_upids);
 
+  // Reverts an elapsed on-demand profiling window (transfer thread).
+  void UpdateOnDemandState();
+
   void PrintStats() const;
+  void PrintSymbolizerStats() const;
 
   // data structures shared with BPF:
   std::unique_ptr<ebpf::BPFStackTable> stack_traces_a_;
   std::unique_ptr<ebpf::BPFStackTable> stack_traces_b_;
 
+  std::unique_ptr<RawHistogram> histogram_a_;
+  std::unique_ptr<RawHistogram> histogram_b_;
+
   std::unique_ptr<ebpf::BPFArrayTable<uint64_t>> profiler_state_;
 
   // Number of iterations, where each iteration is drains the information collectid in BPF.
@@ -114,26 +189,44 @@ class PerfProfileConnector : public SourceConnector, public bpf_tools::BCCWrappe
   // Tracks unique stack trace ids, for the lifetime of Stirling:
   StackTraceIDCache stack_trace_ids_;
 
-  // The raw histogram from BPF; it is populated on each iteration by a call to PollPerfBuffer().
-  RawHistoData raw_histo_data_;
-
   // For converting stack trace addresses to symbols.
+  // After InitImpl(), these are used exclusively by the symbolization thread.
   std::unique_ptr<Symbolizer> k_symbolizer_;
   std::unique_ptr<Symbolizer> u_symbolizer_;
 
+  // The symbolization pipeline. The transfer thread pushes raw batches onto work_queue_
+  // and pops finished batches off results_queue_; the symbolization thread does the reverse.
+  // Bounding the work queue ensures that a slow symbolization (e.g. a Java attach or a large
+  // binary's DWARF info) cannot cause unbounded memory growth; overflow batches are dropped
+  // and accounted in kSymbolizationBatchesDropped.
+  static constexpr size_t kMaxSymbolizationQueueDepth = 4;
+
+  // How long the transfer thread waits for outstanding batches when draining results.
+  // In the common case, symbolization finishes well within this time and records reach
+  // the data table on the same iteration their samples were collected. This timeout is
+  // the bound on how long a symbolization latency spike can stall the transfer thread.
+  static constexpr std::chrono::milliseconds kDrainResultsTimeout{250};
+
+  std::thread symbolization_thread_;
+  std::mutex symbolization_mu_;
+  std::condition_variable symbolization_cv_;
+  std::deque<SymbolizationBatch> work_queue_;
+  std::deque<SymbolizedBatch> results_queue_;
+  uint64_t num_batches_submitted_ = 0;
+  uint64_t num_batches_completed_ = 0;
+  bool symbolization_stop_ = false;
+
+  // On-demand profiling state (see StartOnDemandProfiling). Written by the requesting thread,
+  // read on the transfer thread; the deadline is checked (and the mode reverted) per transfer.
+  mutable std::mutex on_demand_mu_;
+  bool on_demand_active_ = false;
+  absl::flat_hash_set<md::UPID> on_demand_upids_;
+  std::chrono::steady_clock::time_point on_demand_deadline_;
+
   // Keeps track of processes. Used to find destroyed processes on which to perform clean-up.
   // TODO(oazizi): Investigate ways of sharing across source_connectors.
   ProcTracker proc_tracker_;
 
-  static void HandleHistoEvent(void* cb_cookie, void* data, int /*data_size*/);
-  static void HandleHistoLoss(void* cb_cookie, uint64_t lost);
-
-  // Called by HandleHistoEvent() to add the stack-trace-key to raw_histo_data_.
-  void AcceptStackTraceKey(stack_trace_key_t* data);
-
-  ebpf::BPFPerfBuffer* histogram_a_perf_buffer_;
-  ebpf::BPFPerfBuffer* histogram_b_perf_buffer_;
-
   const uint32_t stats_log_interval_;
   utils::StatCounter<StatKey> stats_;
 };
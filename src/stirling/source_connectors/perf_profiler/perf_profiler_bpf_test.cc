@@ -201,8 +201,8 @@ class PerfProfileBPFTest : public ::testing::TestWithParam<std::filesystem::path
     source_ = PerfProfileConnector::Create("perf_profile_connector");
     ASSERT_OK(source_->Init());
 
-    // Immediately start the transfer data thread to continue draining perf buffers,
-    // i.e. to prevent dropping perf buffer entries.
+    // Immediately start the transfer data thread to continue draining the BPF maps,
+    // i.e. to prevent overrunning the stack traces & histogram maps.
     StartTransferDataThread();
   }
 
@@ -298,8 +298,6 @@ class PerfProfileBPFTest : public ::testing::TestWithParam<std::filesystem::path
     EXPECT_GT(ratio, 2.0 - kRatioMargin);
     // TODO(jps): This is extremely flaky on Jenkins. Please fix and re-enable.
     // EXPECT_LT(ratio, 2.0 + kRatioMargin);
-
-    EXPECT_EQ(source_->stats().Get(PerfProfileConnector::StatKey::kLossHistoEvent), 0);
   }
 
   void ConsumeRecords() {
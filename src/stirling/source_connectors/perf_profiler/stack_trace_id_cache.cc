@@ -16,7 +16,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include <utility>
+#include <algorithm>
+
+#include <absl/hash/hash.h>
 
 #include "src/stirling/source_connectors/perf_profiler/stack_trace_id_cache.h"
 
@@ -24,31 +26,75 @@ namespace px {
 namespace stirling {
 // TODO(jps): Add profiler namespace for all profiler code.
 
-uint64_t StackTraceIDCache::Lookup(const profiler::SymbolicStackTrace& stack_trace) {
-  // Case 1: Stack trace ID is in the current set. Just return it.
-  const auto it = stack_trace_ids_.find(stack_trace);
-  if (it != stack_trace_ids_.end()) {
-    const uint64_t stack_trace_id = it->second;
-    return stack_trace_id;
+StackTraceIDCache::Entry* StackTraceIDCache::FindEntry(std::vector<Entry>* entries,
+                                                       uint64_t stack_trace_hash) {
+  const auto it = std::lower_bound(
+      entries->begin(), entries->end(), stack_trace_hash,
+      [](const Entry& entry, uint64_t hash) { return entry.stack_trace_hash < hash; });
+  if (it == entries->end() || it->stack_trace_hash != stack_trace_hash) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+uint64_t StackTraceIDCache::Lookup(const profiler::SymbolicStackTrace& stack_trace,
+                                   bool* first_lookup_this_generation) {
+  const uint64_t stack_trace_hash = absl::Hash<profiler::SymbolicStackTrace>{}(stack_trace);
+
+  // Case 1: Stack trace ID was assigned in an earlier generation. Refresh its stamp.
+  Entry* entry = FindEntry(&entries_, stack_trace_hash);
+  if (entry != nullptr) {
+    if (first_lookup_this_generation != nullptr) {
+      *first_lookup_this_generation = entry->last_used_generation != generation_;
+    }
+    entry->last_used_generation = generation_;
+    return entry->stack_trace_id;
   }
 
-  // Case 2: Stack trace ID is in the previous set. Copy it to current set, and return it.
-  const auto it2 = prev_stack_trace_ids_.find(stack_trace);
-  if (it2 != prev_stack_trace_ids_.end()) {
-    const uint64_t stack_trace_id = it2->second;
-    stack_trace_ids_[stack_trace] = stack_trace_id;
-    return stack_trace_id;
+  // Case 2: Stack trace ID was assigned earlier in this generation.
+  entry = FindEntry(&pending_entries_, stack_trace_hash);
+  if (entry != nullptr) {
+    if (first_lookup_this_generation != nullptr) {
+      *first_lookup_this_generation = false;
+    }
+    return entry->stack_trace_id;
   }
 
-  // Case 3: Stack trace ID is not in the current nor the previous set. Create a new ID.
+  // Case 3: Stack trace is new (or was garbage collected). Create a new ID. The sorted insert
+  // only shifts entries added this generation; older entries live in entries_ and don't move.
+  if (first_lookup_this_generation != nullptr) {
+    *first_lookup_this_generation = true;
+  }
   const uint64_t stack_trace_id = ++next_stack_trace_id_;
-  stack_trace_ids_[stack_trace] = stack_trace_id;
+  const auto it = std::lower_bound(
+      pending_entries_.begin(), pending_entries_.end(), stack_trace_hash,
+      [](const Entry& e, uint64_t hash) { return e.stack_trace_hash < hash; });
+  pending_entries_.insert(it, Entry{stack_trace_hash, stack_trace_id, generation_});
   return stack_trace_id;
 }
 
 void StackTraceIDCache::AgeTick() {
-  prev_stack_trace_ids_ = std::move(stack_trace_ids_);
-  stack_trace_ids_.clear();
+  ++generation_;
+
+  // Garbage collect entries unused for more than kRetentionGenerations generations.
+  // Erase-remove keeps entries_ sorted (removal is order preserving).
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [this](const Entry& entry) {
+                                  return entry.last_used_generation + kRetentionGenerations <
+                                         generation_;
+                                }),
+                 entries_.end());
+
+  // Merge this generation's new entries into the main index. Both runs are sorted.
+  if (!pending_entries_.empty()) {
+    const auto middle = entries_.insert(entries_.end(), pending_entries_.begin(),
+                                        pending_entries_.end());
+    std::inplace_merge(entries_.begin(), middle, entries_.end(),
+                       [](const Entry& a, const Entry& b) {
+                         return a.stack_trace_hash < b.stack_trace_hash;
+                       });
+    pending_entries_.clear();
+  }
 }
 
 }  // namespace stirling
@@ -18,9 +18,7 @@
 
 #pragma once
 
-#include <string>
-
-#include <absl/container/flat_hash_map.h>
+#include <vector>
 
 #include "src/stirling/source_connectors/perf_profiler/shared/types.h"
 
@@ -33,25 +31,62 @@ namespace stirling {
 //     aggregations with integers are more efficient than aggregations with strings.
 //  2) The IDs enable table normalization (future work).
 //
+// The IDs are keyed by a 64-bit hash of the stack trace content (UPID + folded stack string),
+// not by the kernel's BPF stack-map IDs, so they remain stable across the BPF stack-map clears
+// that happen each push period. The cache never stores the stack trace strings themselves:
+// entries are kept in a single compact array sorted by content hash and found by binary search,
+// so the per-stack-trace footprint is fixed (24 bytes) rather than proportional to the folded
+// string length. Entries are stamped with the generation in which they were last looked up, and
+// AgeTick() garbage-collects entries unused for more than kRetentionGenerations generations.
+//
 // As a cache, it should be noted that no guarantee is made that a stack trace from one time
 // period is assigned the same stack trace ID. Any consumer of the data can only assume that
-// two records with identical stack trace IDs will have identical stack trace strings. The
-// reverse, however, is not true: Two records with identical stack trace strings may not have
-// the same stack trace ID.
-//
-// We allow identical stack trace strings to map to different stack trace id integers to bound
-// the total memory consumed by this map. Otherwise the map's memory usage grows unbounded.
+// two records with identical stack trace IDs will have identical stack trace strings (up to the
+// vanishingly small probability of a 64-bit hash collision). The reverse is not true: two
+// records with identical stack trace strings may not have the same stack trace ID, because an
+// entry evicted by the generational GC gets a fresh ID when the stack trace reappears.
 //
-// For cases where the same stack trace ID shows up with different IDs,
+// For cases where the same stack trace shows up with different IDs,
 // the UI will aggregate the identical stack traces for us in the visualization.
 class StackTraceIDCache {
  public:
-  uint64_t Lookup(const profiler::SymbolicStackTrace& stack_trace);
+  // Returns the stack trace ID for the given stack trace, assigning a new ID if needed.
+  // If provided, first_lookup_this_generation is set to true when this is the first lookup
+  // of the stack trace since the last AgeTick() (including the case of a brand new ID).
+  // Used to emit the stack trace string only once per ID per generation: any consumer that
+  // joins IDs back to strings within one aging period is guaranteed to find the string.
+  uint64_t Lookup(const profiler::SymbolicStackTrace& stack_trace,
+                  bool* first_lookup_this_generation = nullptr);
+
+  // Advances the generation: merges this generation's new entries into the sorted index and
+  // drops entries that have not been looked up for more than kRetentionGenerations generations.
   void AgeTick();
 
+  // Number of stack trace IDs currently retained.
+  size_t size() const { return entries_.size() + pending_entries_.size(); }
+
  private:
-  absl::flat_hash_map<profiler::SymbolicStackTrace, uint64_t> stack_trace_ids_;
-  absl::flat_hash_map<profiler::SymbolicStackTrace, uint64_t> prev_stack_trace_ids_;
+  // An entry evicted here is forgotten: if its stack trace reappears, it gets a new ID.
+  // One generation of retention means an ID survives exactly one push period without use,
+  // matching the prior current/previous two-map design.
+  static constexpr uint64_t kRetentionGenerations = 1;
+
+  struct Entry {
+    uint64_t stack_trace_hash;
+    uint64_t stack_trace_id;
+    uint64_t last_used_generation;
+  };
+
+  Entry* FindEntry(std::vector<Entry>* entries, uint64_t stack_trace_hash);
+
+  // All entries assigned before the current generation, sorted by stack_trace_hash.
+  std::vector<Entry> entries_;
+
+  // Entries first seen this generation, also sorted by stack_trace_hash. Kept separate so
+  // that inserts only shift this generation's (small) tail; merged into entries_ by AgeTick().
+  std::vector<Entry> pending_entries_;
+
+  uint64_t generation_ = 0;
 
   // Tracks the next stack-trace-id to be assigned;
   // incremented by 1 for each such assignment.
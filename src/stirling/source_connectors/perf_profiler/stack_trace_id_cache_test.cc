@@ -51,5 +51,55 @@ TEST(StackTraceIDCache, Basic) {
   EXPECT_NE(stack_trace_ids.Lookup(kStackTrace2), id2);
 }
 
+TEST(StackTraceIDCache, FirstLookupThisGeneration) {
+  StackTraceIDCache stack_trace_ids;
+
+  const md::UPID kUPID(1, 1, 1);
+  const profiler::SymbolicStackTrace kStackTrace{kUPID, "a();b();c();"};
+
+  bool first_lookup = false;
+
+  // A brand new stack trace is a first lookup.
+  stack_trace_ids.Lookup(kStackTrace, &first_lookup);
+  EXPECT_TRUE(first_lookup);
+
+  // A repeat lookup in the same generation is not.
+  stack_trace_ids.Lookup(kStackTrace, &first_lookup);
+  EXPECT_FALSE(first_lookup);
+
+  stack_trace_ids.AgeTick();
+
+  // The first lookup after an age tick is a first lookup again (with the same ID).
+  stack_trace_ids.Lookup(kStackTrace, &first_lookup);
+  EXPECT_TRUE(first_lookup);
+  stack_trace_ids.Lookup(kStackTrace, &first_lookup);
+  EXPECT_FALSE(first_lookup);
+}
+
+TEST(StackTraceIDCache, GenerationalGC) {
+  StackTraceIDCache stack_trace_ids;
+
+  const md::UPID kUPID(1, 1, 1);
+  const profiler::SymbolicStackTrace kHotStackTrace{kUPID, "a();b();c();"};
+  const profiler::SymbolicStackTrace kColdStackTrace{kUPID, "d();e();f();"};
+
+  const uint64_t hot_id = stack_trace_ids.Lookup(kHotStackTrace);
+  stack_trace_ids.Lookup(kColdStackTrace);
+  EXPECT_EQ(stack_trace_ids.size(), 2);
+
+  // Keep the hot stack trace in use across generations; leave the cold one untouched.
+  stack_trace_ids.AgeTick();
+  EXPECT_EQ(stack_trace_ids.Lookup(kHotStackTrace), hot_id);
+  EXPECT_EQ(stack_trace_ids.size(), 2);
+
+  stack_trace_ids.AgeTick();
+  EXPECT_EQ(stack_trace_ids.Lookup(kHotStackTrace), hot_id);
+
+  // The cold entry was unused for two generations and has been garbage collected.
+  stack_trace_ids.AgeTick();
+  EXPECT_EQ(stack_trace_ids.size(), 1);
+  EXPECT_EQ(stack_trace_ids.Lookup(kHotStackTrace), hot_id);
+}
+
 }  // namespace stirling
 }  // namespace px
@@ -31,7 +31,18 @@ namespace stirling {
 
 Stringifier::Stringifier(Symbolizer* u_symbolizer, Symbolizer* k_symbolizer,
                          ebpf::BPFStackTable* stack_traces)
-    : u_symbolizer_(u_symbolizer), k_symbolizer_(k_symbolizer), stack_traces_(stack_traces) {}
+    : Stringifier(u_symbolizer, k_symbolizer, [stack_traces](const int stack_id) {
+        // Clear the stack-traces map as we go along here; this has lower overhead
+        // compared to first reading the stack-traces map, then using clear_table_non_atomic().
+        constexpr bool kClearStackId = true;
+        return stack_traces->get_stack_addr(stack_id, kClearStackId);
+      }) {}
+
+Stringifier::Stringifier(Symbolizer* u_symbolizer, Symbolizer* k_symbolizer,
+                         StackTraceAddrsFn stack_trace_addrs_fn)
+    : u_symbolizer_(u_symbolizer),
+      k_symbolizer_(k_symbolizer),
+      stack_trace_addrs_fn_(std::move(stack_trace_addrs_fn)) {}
 
 std::string Stringifier::BuildStackTraceString(const std::vector<uintptr_t>& addrs,
                                                profiler::SymbolizerFn symbolize_fn,
@@ -88,12 +99,8 @@ std::string Stringifier::FindOrBuildStackTraceString(const int stack_id,
   // if no memoized result is available, build the folded stack trace string.
   auto [iter, inserted] = stack_trace_strs_.try_emplace(stack_id, "");
   if (inserted) {
-    // Clear the stack-traces map as we go along here; this has lower overhead
-    // compared to first reading the stack-traces map, then using clear_table_non_atomic().
-    constexpr bool kClearStackId = true;
-
-    // Get the stack trace (as a vector of addresses) from the shared BPF stack trace table.
-    const std::vector<uintptr_t> addrs = stack_traces_->get_stack_addr(stack_id, kClearStackId);
+    // Get the stack trace (as a vector of addresses) for this stack-trace-id.
+    const std::vector<uintptr_t> addrs = stack_trace_addrs_fn_(stack_id);
     VLOG_IF(1, addrs.empty()) << absl::Substitute("[empty_stack_trace] stack_id: $0", stack_id);
 
     iter->second = BuildStackTraceString(addrs, symbolize_fn, prefix);
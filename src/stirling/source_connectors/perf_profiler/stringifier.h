@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/stirling/bpf_tools/bcc_bpf_intf/upid.h"
@@ -51,6 +53,9 @@ namespace stirling {
 // of the continuous perf. profiler.
 class Stringifier {
  public:
+  // StackTraceAddrsFn maps a stack-trace-id to the list of addresses in that stack trace.
+  using StackTraceAddrsFn = std::function<std::vector<uintptr_t>(int stack_id)>;
+
   /**
    * Construct a stack trace stringifier.
    *
@@ -61,6 +66,18 @@ class Stringifier {
   Stringifier(Symbolizer* u_symbolizer, Symbolizer* k_symbolizer,
               ebpf::BPFStackTable* stack_traces);
 
+  /**
+   * Construct a stack trace stringifier from pre-extracted stack trace addresses.
+   * Used when stringification happens off the thread that owns the BCC stack traces map
+   * (BCC map access is not thread-safe), with the addresses extracted up-front.
+   *
+   * @param u_symbolizer A symbolizer for user-space addresses.
+   * @param k_symbolizer A symbolizer for kernel-space addresses.
+   * @param stack_trace_addrs_fn Returns the addresses for a given stack-trace-id.
+   */
+  Stringifier(Symbolizer* u_symbolizer, Symbolizer* k_symbolizer,
+              StackTraceAddrsFn stack_trace_addrs_fn);
+
   // Returns a folded stack trace string based on the stack trace histogram key.
   // The key contains both a user & kernel stack-trace-id, which are subsequently
   // passed into FindOrBuildStackTraceString().
@@ -81,12 +98,12 @@ class Stringifier {
   Symbolizer* const u_symbolizer_;
   Symbolizer* const k_symbolizer_;
 
-  // The shared BPF stack trace table provides a stack trace, as a list of addresses,
-  // based on the stack-trace-id (an integer). When read, a given stack trace is consumed by
-  // a destructive read, i.e. such that the BPF stack trace table does not need
+  // Provides a stack trace, as a list of addresses, based on the stack-trace-id (an integer).
+  // When reading straight from the shared BPF stack trace table, a given stack trace is
+  // consumed by a destructive read, i.e. such that the BPF stack trace table does not need
   // to be explicitly cleared (by re-iterating the histogram) after an iteration
   // of the continuous perf. profiler is completed.
-  ebpf::BPFStackTable* const stack_traces_;
+  const StackTraceAddrsFn stack_trace_addrs_fn_;
 };
 
 }  // namespace stirling
@@ -21,7 +21,7 @@
 
 #include <absl/functional/bind_front.h>
 
-#include "src/stirling/bpf_tools/bcc_symbolizer.h"
+#include "src/stirling/bpf_tools/bcc_symbolizer_service.h"
 #include "src/stirling/source_connectors/perf_profiler/symbolizers/bcc_symbolizer.h"
 
 namespace px {
@@ -36,12 +36,16 @@ void BCCSymbolizer::DeleteUPID(const struct upid_t& upid) {
   // If the BCC side symbol cache has already been freed, this does nothing.
   // If later the pid is reused, then BCC will re-allocate the pid's symbol
   // symbol cache (when get_addr_symbol() is called).
-  bcc_symbolizer_.ReleasePIDSymCache(upid.pid);
+  bpf_tools::BCCSymbolizerService::GetInstance().ReleasePIDSymCache(upid.pid);
+}
+
+std::string_view BCCSymbolizer::Symbolize(const int pid, const uintptr_t addr) {
+  symbol_ = bpf_tools::BCCSymbolizerService::GetInstance().Symbolize(pid, addr);
+  return symbol_;
 }
 
 profiler::SymbolizerFn BCCSymbolizer::GetSymbolizerFn(const struct upid_t& upid) {
-  auto fn = absl::bind_front(&bpf_tools::BCCSymbolizer::SymbolOrAddrIfUnknown, &bcc_symbolizer_,
-                             static_cast<int32_t>(upid.pid));
+  auto fn = absl::bind_front(&BCCSymbolizer::Symbolize, this, static_cast<int32_t>(upid.pid));
   return fn;
 }
 
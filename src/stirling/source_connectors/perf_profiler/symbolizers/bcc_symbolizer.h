@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "src/stirling/source_connectors/perf_profiler/symbolizers/symbolizer.h"
 
@@ -27,6 +28,8 @@ namespace stirling {
 
 /**
  * A Symbolizer that uses BCC's symbolizer under the hood.
+ * All instances resolve through the shared BCCSymbolizerService, so the BCC symbol tables for a
+ * pid are loaded once per node regardless of how many symbolizers reference that pid.
  */
 class BCCSymbolizer : public Symbolizer, public NotCopyMoveable {
  public:
@@ -39,7 +42,12 @@ class BCCSymbolizer : public Symbolizer, public NotCopyMoveable {
 
  private:
   BCCSymbolizer() = default;
-  bpf_tools::BCCSymbolizer bcc_symbolizer_;
+
+  std::string_view Symbolize(int pid, uintptr_t addr);
+
+  // Storage for the most recent symbolization result, so that Symbolize() can return a
+  // string_view as required by profiler::SymbolizerFn.
+  std::string symbol_;
 };
 
 }  // namespace stirling
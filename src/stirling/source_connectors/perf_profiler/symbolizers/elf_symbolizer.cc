@@ -16,19 +16,136 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include <absl/functional/bind_front.h>
 
+#include "src/common/fs/fs_wrapper.h"
 #include "src/stirling/obj_tools/elf_reader.h"
 #include "src/stirling/source_connectors/perf_profiler/symbolizers/elf_symbolizer.h"
 #include "src/stirling/utils/proc_path_tools.h"
 
+DEFINE_string(stirling_profiler_symbol_cache_dir, "",
+              "If set, directory in which the profiler persists per-binary symbol indexes, "
+              "keyed by build-id. Cached indexes survive Stirling restarts and are shared by "
+              "all containers running the same binary. Empty means no persistent cache.");
+
 using ::px::stirling::obj_tools::ElfReader;
 
 namespace px {
 namespace stirling {
 
+namespace {
+
+// Bump the version whenever the symbol index file layout changes,
+// so that files written by older builds are ignored rather than misread.
+constexpr uint32_t kSymbolIndexVersion = 1;
+
+// Fixed-layout header of a symbol index file. The header is followed by num_symbols entries,
+// each serialized as: u64 address, u64 size, u32 name length, name bytes.
+struct SymbolIndexHeader {
+  uint32_t version = kSymbolIndexVersion;
+  uint32_t num_symbols = 0;
+};
+
+std::filesystem::path SymbolIndexPath(const std::string& build_id) {
+  return std::filesystem::path(FLAGS_stirling_profiler_symbol_cache_dir) /
+         (build_id + ".symindex");
+}
+
+StatusOr<std::unique_ptr<ElfReader::Symbolizer>> ReadSymbolIndexFile(
+    const std::filesystem::path& path) {
+  PL_ASSIGN_OR_RETURN(std::string contents, ReadFileToString(path.string(), std::ios_base::binary));
+
+  if (contents.size() < sizeof(SymbolIndexHeader)) {
+    return error::Internal("Symbol index file $0 is truncated.", path.string());
+  }
+
+  SymbolIndexHeader header;
+  std::memcpy(&header, contents.data(), sizeof(header));
+  if (header.version != kSymbolIndexVersion) {
+    return error::Internal("Symbol index file $0 has unsupported version $1.", path.string(),
+                           header.version);
+  }
+
+  std::string_view buf = std::string_view(contents).substr(sizeof(header));
+
+  auto symbolizer = std::make_unique<ElfReader::Symbolizer>();
+  for (uint32_t i = 0; i < header.num_symbols; ++i) {
+    uint64_t addr;
+    uint64_t size;
+    uint32_t name_len;
+    constexpr size_t kEntryHeaderSize = sizeof(addr) + sizeof(size) + sizeof(name_len);
+    if (buf.size() < kEntryHeaderSize) {
+      return error::Internal("Symbol index file $0 is corrupted.", path.string());
+    }
+    std::memcpy(&addr, buf.data(), sizeof(addr));
+    std::memcpy(&size, buf.data() + sizeof(addr), sizeof(size));
+    std::memcpy(&name_len, buf.data() + sizeof(addr) + sizeof(size), sizeof(name_len));
+    buf.remove_prefix(kEntryHeaderSize);
+    if (buf.size() < name_len) {
+      return error::Internal("Symbol index file $0 is corrupted.", path.string());
+    }
+    symbolizer->AddEntry(addr, size, std::string(buf.substr(0, name_len)));
+    buf.remove_prefix(name_len);
+  }
+
+  if (!buf.empty()) {
+    return error::Internal("Symbol index file $0 has trailing bytes.", path.string());
+  }
+
+  return symbolizer;
+}
+
+Status WriteSymbolIndexFile(const std::filesystem::path& path,
+                            const ElfReader::Symbolizer& symbolizer) {
+  std::string entries;
+  uint32_t num_symbols = 0;
+  symbolizer.ForEachEntry([&](uintptr_t addr, size_t size, const std::string& name) {
+    const uint64_t addr64 = addr;
+    const uint64_t size64 = size;
+    const uint32_t name_len = name.size();
+    entries.append(reinterpret_cast<const char*>(&addr64), sizeof(addr64));
+    entries.append(reinterpret_cast<const char*>(&size64), sizeof(size64));
+    entries.append(reinterpret_cast<const char*>(&name_len), sizeof(name_len));
+    entries.append(name);
+    ++num_symbols;
+  });
+
+  SymbolIndexHeader header;
+  header.num_symbols = num_symbols;
+
+  std::string contents;
+  contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  contents.append(entries);
+
+  PL_RETURN_IF_ERROR(fs::CreateDirectories(path.parent_path()));
+
+  // Write to a temporary file and rename it into place, so that other Stirling instances
+  // (and future runs) never observe a partially-written index.
+  std::filesystem::path tmp_path = path;
+  tmp_path += absl::Substitute(".tmp.$0", getpid());
+
+  PL_RETURN_IF_ERROR(WriteFileFromString(tmp_path.string(), contents, std::ios_base::binary));
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+    return error::Internal("Could not rename symbol index file into place: $0", ec.message());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
 StatusOr<std::unique_ptr<Symbolizer>> ElfSymbolizer::Create() {
   ElfSymbolizer* elf_symbolizer = new ElfSymbolizer();
   auto symbolizer = std::unique_ptr<Symbolizer>(elf_symbolizer);
@@ -37,7 +154,8 @@ StatusOr<std::unique_ptr<Symbolizer>> ElfSymbolizer::Create() {
 
 void ElfSymbolizer::DeleteUPID(const struct upid_t& upid) { symbolizers_.erase(upid); }
 
-StatusOr<std::unique_ptr<ElfReader::Symbolizer>> CreateUPIDSymbolizer(const struct upid_t& upid) {
+StatusOr<std::shared_ptr<const ElfReader::Symbolizer>> ElfSymbolizer::CreateUPIDSymbolizer(
+    const struct upid_t& upid) {
   PL_ASSIGN_OR_RETURN(std::unique_ptr<FilePathResolver> fp_resolver,
                       FilePathResolver::Create(upid.pid));
   // TODO(yzhao): Might need to check the start time.
@@ -46,9 +164,58 @@ StatusOr<std::unique_ptr<ElfReader::Symbolizer>> CreateUPIDSymbolizer(const stru
   PL_ASSIGN_OR_RETURN(std::filesystem::path host_proc_exe, fp_resolver->ResolvePath(proc_exe));
   host_proc_exe = system::Config::GetInstance().ToHostPath(host_proc_exe);
   PL_ASSIGN_OR_RETURN(std::unique_ptr<ElfReader> elf_reader, ElfReader::Create(host_proc_exe));
+
+  // The build-id identifies the binary's contents, so it keys both layers of sharing below:
+  // the in-memory index shared by all live processes running the same binary, and the
+  // persistent on-disk index that survives Stirling restarts.
+  const StatusOr<std::string> build_id = elf_reader->BuildID();
+
+  // First, look for a live in-memory index for this binary. The index is immutable, so
+  // processes running binaries with identical contents (e.g. many containers running the
+  // same image) share one index rather than holding per-process heap copies, and lookups
+  // are a binary search over that shared index.
+  if (build_id.ok()) {
+    auto iter = indexes_by_build_id_.find(build_id.ValueOrDie());
+    if (iter != indexes_by_build_id_.end()) {
+      std::shared_ptr<const ElfReader::Symbolizer> index = iter->second.lock();
+      if (index != nullptr) {
+        return index;
+      }
+      // The last process using this index has been deleted; rebuild below.
+      indexes_by_build_id_.erase(iter);
+    }
+  }
+
+  // Second, if the persistent symbol cache is enabled, look for an on-disk index.
+  std::filesystem::path symbol_index_path;
+  if (!FLAGS_stirling_profiler_symbol_cache_dir.empty() && build_id.ok()) {
+    symbol_index_path = SymbolIndexPath(build_id.ValueOrDie());
+    StatusOr<std::unique_ptr<ElfReader::Symbolizer>> cached_symbolizer =
+        ReadSymbolIndexFile(symbol_index_path);
+    if (cached_symbolizer.ok()) {
+      std::shared_ptr<const ElfReader::Symbolizer> index = cached_symbolizer.ConsumeValueOrDie();
+      indexes_by_build_id_[build_id.ValueOrDie()] = index;
+      return index;
+    }
+  }
+
+  // Otherwise, build the index from the ELF symtab.
   PL_ASSIGN_OR_RETURN(std::unique_ptr<ElfReader::Symbolizer> upid_symbolizer,
                       elf_reader->GetSymbolizer());
-  return upid_symbolizer;
+
+  if (!symbol_index_path.empty()) {
+    Status s = WriteSymbolIndexFile(symbol_index_path, *upid_symbolizer);
+    if (!s.ok()) {
+      VLOG(1) << absl::Substitute("Could not write symbol index file $0. Message = $1",
+                                  symbol_index_path.string(), s.msg());
+    }
+  }
+
+  std::shared_ptr<const ElfReader::Symbolizer> index = std::move(upid_symbolizer);
+  if (build_id.ok()) {
+    indexes_by_build_id_[build_id.ValueOrDie()] = index;
+  }
+  return index;
 }
 
 std::string_view EmptySymbolizerFn(const uintptr_t addr) {
@@ -65,9 +232,9 @@ profiler::SymbolizerFn ElfSymbolizer::GetSymbolizerFn(const struct upid_t& upid)
     return profiler::SymbolizerFn(&(BogusKernelSymbolizerFn));
   }
 
-  std::unique_ptr<ElfReader::Symbolizer>& upid_symbolizer = symbolizers_[upid];
+  std::shared_ptr<const ElfReader::Symbolizer>& upid_symbolizer = symbolizers_[upid];
   if (upid_symbolizer == nullptr) {
-    StatusOr<std::unique_ptr<ElfReader::Symbolizer>> upid_symbolizer_status =
+    StatusOr<std::shared_ptr<const ElfReader::Symbolizer>> upid_symbolizer_status =
         CreateUPIDSymbolizer(upid);
     if (!upid_symbolizer_status.ok()) {
       VLOG(1) << absl::Substitute("Failed to create Symbolizer function for $0 [error=$1]",
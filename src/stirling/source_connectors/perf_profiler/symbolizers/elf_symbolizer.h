@@ -19,9 +19,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "src/stirling/source_connectors/perf_profiler/symbolizers/symbolizer.h"
 
+DECLARE_string(stirling_profiler_symbol_cache_dir);
+
 namespace px {
 namespace stirling {
 
@@ -40,10 +43,21 @@ class ElfSymbolizer : public Symbolizer, public NotCopyMoveable {
  private:
   ElfSymbolizer() = default;
 
-  // A symbolizer per UPID.
+  StatusOr<std::shared_ptr<const px::stirling::obj_tools::ElfReader::Symbolizer>>
+  CreateUPIDSymbolizer(const struct upid_t& upid);
+
+  // A symbolizer per UPID. The underlying symbol indexes are immutable and shared:
+  // processes running binaries with identical contents (i.e. the same build-id,
+  // e.g. many containers running the same image) point at a single index.
   absl::flat_hash_map<struct upid_t,
-                      std::unique_ptr<px::stirling::obj_tools::ElfReader::Symbolizer>>
+                      std::shared_ptr<const px::stirling::obj_tools::ElfReader::Symbolizer>>
       symbolizers_;
+
+  // Live symbol indexes by build-id, used to share one index across UPIDs.
+  // Entries are weak so that an index is freed once the last process using it is deleted.
+  absl::flat_hash_map<std::string,
+                      std::weak_ptr<const px::stirling::obj_tools::ElfReader::Symbolizer>>
+      indexes_by_build_id_;
 };
 
 }  // namespace stirling
@@ -78,7 +78,55 @@ void JavaSymbolizationContext::RemoveArtifacts() const {
   }
 }
 
+void JavaSymbolizationContext::IngestSymbolUpdate(const java::RawSymbolUpdate& update,
+                                                  const char* symbol_bytes) {
+  // We either put a new symbol into the symbol map (common case) or remove a symbol.
+  if (update.method_unload) {
+    // Handle remove symbol scenario.
+    // NB: if we go back to caching Java symbols, we will need to invalidate
+    // any cached instances of this symbol.
+    symbol_map_.erase(update.addr);
+    return;
+  }
+
+  // TODO(jps): Remove null terminating character from java::RawSymbolUpdate.
+  const std::string symbol(symbol_bytes + update.SymbolOffset(), update.symbol_size - 1);
+  const std::string_view fn_sig(symbol_bytes + update.FnSigOffset(), update.fn_sig_size - 1);
+  const std::string_view class_sig(symbol_bytes + update.ClassSigOffset(),
+                                   update.class_sig_size - 1);
+
+  using symbolization::kJavaPrefix;
+  const auto demangled = absl::StrCat(kJavaPrefix, java::Demangle(symbol, class_sig, fn_sig));
+
+  // TODO(jps): Change to uint32_t in java::RawSymbolUpdate.
+  const uint32_t code_size = static_cast<uint32_t>(update.code_size);
+  symbol_map_.try_emplace(update.addr, demangled, code_size);
+}
+
 void JavaSymbolizationContext::UpdateSymbolMap() {
+  if (symbol_ring_reader_ != nullptr) {
+    // Sample the flush epoch first: anything published after this point is picked up on the
+    // next refresh, which will observe a newer epoch.
+    const uint64_t flush_epoch = symbol_ring_reader_->flush_epoch();
+    if (flush_epoch == last_consumed_flush_epoch_) {
+      // Nothing new has been published; checking cost just one shared-memory read.
+      return;
+    }
+    symbol_ring_reader_->ConsumeUpdates(
+        [this](const java::RawSymbolUpdate& update, char* symbol_bytes) {
+          IngestSymbolUpdate(update, symbol_bytes);
+        });
+    last_consumed_flush_epoch_ = flush_epoch;
+
+    const uint64_t dropped_updates = symbol_ring_reader_->dropped_updates();
+    if (dropped_updates != last_dropped_updates_) {
+      char const* const warn = "Symbol ring overflow: $0 Java symbol updates dropped.";
+      LOG(WARNING) << absl::Substitute(warn, dropped_updates - last_dropped_updates_);
+      last_dropped_updates_ = dropped_updates;
+    }
+    return;
+  }
+
   auto reset_symbol_file = [&](const auto pos) {
     symbol_file_->seekg(pos);
     symbol_file_->clear();
@@ -88,14 +136,7 @@ void JavaSymbolizationContext::UpdateSymbolMap() {
   java::RawSymbolUpdate update;
 
   std::string buffer;
-  std::string symbol;
-  std::string fn_sig;
-  std::string class_sig;
-
   buffer.reserve(300);
-  symbol.reserve(100);
-  fn_sig.reserve(100);
-  class_sig.reserve(100);
 
   while (true) {
     const auto pos = symbol_file_->tellg();
@@ -122,41 +163,13 @@ void JavaSymbolizationContext::UpdateSymbolMap() {
       break;
     }
 
-    // At this point, we have consumed an entire udpate from the symbol file.
-    // We either put a new symbol into the symbol map (common case) or remove a symbol.
-
-    if (update.method_unload) {
-      // Handle remove symbol scenario.
-      // NB: if we go back to caching Java symbols, we will need to invalidate
-      // any cached instances of this symbol.
-      symbol_map_.erase(update.addr);
-      continue;
-    }
-
-    // TODO(jps): Make the interface to the demangler consume string_view only, then
-    // convert symbol, fn_sig, and class_sig to string_view (reduces copying).
-    // TODO(jps): Remove null terminating character from java::RawSymbolUpdate.
-    symbol.assign(buffer.data() + update.SymbolOffset(), update.symbol_size - 1);
-    fn_sig.assign(buffer.data() + update.FnSigOffset(), update.fn_sig_size - 1);
-    class_sig.assign(buffer.data() + update.ClassSigOffset(), update.class_sig_size - 1);
-
-    using symbolization::kJavaPrefix;
-    const auto demangled = absl::StrCat(kJavaPrefix, java::Demangle(symbol, class_sig, fn_sig));
-
-    // TODO(jps): Change to uint32_t in java::RawSymbolUpdate.
-    const uint32_t code_size = static_cast<uint32_t>(update.code_size);
-    symbol_map_.try_emplace(update.addr, demangled, code_size);
+    // At this point, we have consumed an entire update from the symbol file.
+    IngestSymbolUpdate(update, buffer.data());
   }
   DCHECK(symbol_file_->good());
 }
 
-JavaSymbolizationContext::JavaSymbolizationContext(const struct upid_t& target_upid,
-                                                   profiler::SymbolizerFn native_symbolizer_fn,
-                                                   std::unique_ptr<std::ifstream> symbol_file)
-    : native_symbolizer_fn_(native_symbolizer_fn), symbol_file_(std::move(symbol_file)) {
-  DCHECK(symbol_file_->good());
-  UpdateSymbolMap();
-
+void JavaSymbolizationContext::ResolveHostArtifactsPath(const struct upid_t& target_upid) {
   auto status_or_host_artifacts_path = java::ResolveHostArtifactsPath(target_upid);
 
   if (!status_or_host_artifacts_path.ok()) {
@@ -168,7 +181,29 @@ JavaSymbolizationContext::JavaSymbolizationContext(const struct upid_t& target_u
   host_artifacts_path_resolved_ = true;
 }
 
-JavaSymbolizationContext::~JavaSymbolizationContext() { symbol_file_->close(); }
+JavaSymbolizationContext::JavaSymbolizationContext(
+    const struct upid_t& target_upid, profiler::SymbolizerFn native_symbolizer_fn,
+    std::unique_ptr<java::SymbolRingReader> symbol_ring_reader)
+    : native_symbolizer_fn_(native_symbolizer_fn),
+      symbol_ring_reader_(std::move(symbol_ring_reader)) {
+  UpdateSymbolMap();
+  ResolveHostArtifactsPath(target_upid);
+}
+
+JavaSymbolizationContext::JavaSymbolizationContext(const struct upid_t& target_upid,
+                                                   profiler::SymbolizerFn native_symbolizer_fn,
+                                                   std::unique_ptr<std::ifstream> symbol_file)
+    : native_symbolizer_fn_(native_symbolizer_fn), symbol_file_(std::move(symbol_file)) {
+  DCHECK(symbol_file_->good());
+  UpdateSymbolMap();
+  ResolveHostArtifactsPath(target_upid);
+}
+
+JavaSymbolizationContext::~JavaSymbolizationContext() {
+  if (symbol_file_ != nullptr) {
+    symbol_file_->close();
+  }
+}
 
 std::string_view JavaSymbolizationContext::Symbolize(const uintptr_t addr) {
   if (requires_refresh_) {
@@ -255,13 +290,31 @@ std::string_view JavaSymbolizer::Symbolize(JavaSymbolizationContext* ctx, const
 }
 
 Status JavaSymbolizer::CreateNewJavaSymbolizationContext(const struct upid_t& upid) {
-  constexpr auto kIOFlags = std::ios::in | std::ios::binary;
-  const std::filesystem::path symbol_file_path = java::StirlingSymbolFilePath(upid);
-  auto symbol_file = std::make_unique<std::ifstream>(symbol_file_path, kIOFlags);
+  // Preferred transport: the shared-memory symbol ring published by the JVMTI agent.
+  // Fall back to the legacy symbol file (older agents, or agents whose ring setup failed).
+  std::unique_ptr<java::SymbolRingReader> symbol_ring_reader;
+  std::unique_ptr<std::ifstream> symbol_file;
+
+  const std::filesystem::path symbol_ring_path = java::StirlingSymbolRingPath(upid);
+  if (fs::Exists(symbol_ring_path)) {
+    auto reader_or_status = java::SymbolRingReader::Create(symbol_ring_path);
+    if (reader_or_status.ok()) {
+      symbol_ring_reader = reader_or_status.ConsumeValueOrDie();
+    } else {
+      char const* const warn = "Java attacher [pid=$0]: $1 Falling back to symbol file.";
+      LOG(WARNING) << absl::Substitute(warn, upid.pid, reader_or_status.msg());
+    }
+  }
+
+  if (symbol_ring_reader == nullptr) {
+    constexpr auto kIOFlags = std::ios::in | std::ios::binary;
+    const std::filesystem::path symbol_file_path = java::StirlingSymbolFilePath(upid);
+    symbol_file = std::make_unique<std::ifstream>(symbol_file_path, kIOFlags);
 
-  if (symbol_file->fail()) {
-    char const* const fmt = "Java attacher [pid=$0]: Could not open symbol file: $1.";
-    return error::Internal(fmt, upid.pid, symbol_file_path.string());
+    if (symbol_file->fail()) {
+      char const* const fmt = "Java attacher [pid=$0]: Could not open symbol file: $1.";
+      return error::Internal(fmt, upid.pid, symbol_file_path.string());
+    }
   }
 
   DCHECK(symbolization_contexts_.find(upid) == symbolization_contexts_.end());
@@ -270,8 +323,13 @@ Status JavaSymbolizer::CreateNewJavaSymbolizationContext(const struct upid_t& up
   DCHECK(inserted);
   if (inserted) {
     auto native_symbolizer_fn = native_symbolizer_->GetSymbolizerFn(upid);
-    iter->second = std::make_unique<JavaSymbolizationContext>(upid, native_symbolizer_fn,
-                                                              std::move(symbol_file));
+    if (symbol_ring_reader != nullptr) {
+      iter->second = std::make_unique<JavaSymbolizationContext>(upid, native_symbolizer_fn,
+                                                                std::move(symbol_ring_reader));
+    } else {
+      iter->second = std::make_unique<JavaSymbolizationContext>(upid, native_symbolizer_fn,
+                                                                std::move(symbol_file));
+    }
   }
   auto& ctx = iter->second;
 
@@ -389,11 +447,12 @@ profiler::SymbolizerFn JavaSymbolizer::GetSymbolizerFn(const struct upid_t& upid
   // This process is a java process, increment the counter.
   g_java_proc_counter.Increment();
 
-  const std::filesystem::path symbol_file_path = java::StirlingSymbolFilePath(upid);
+  const bool symbol_artifacts_exist = fs::Exists(java::StirlingSymbolRingPath(upid)) ||
+                                      fs::Exists(java::StirlingSymbolFilePath(upid));
 
-  if (fs::Exists(symbol_file_path)) {
-    LOG(INFO) << absl::Substitute("Found a pre-existing symbol file for pid: $0", upid.pid);
-    // Found a pre-existing symbol file. Attempt to use it.
+  if (symbol_artifacts_exist) {
+    LOG(INFO) << absl::Substitute("Found pre-existing symbol artifacts for pid: $0", upid.pid);
+    // Found a pre-existing symbol ring or symbol file. Attempt to use it.
     const Status new_ctx_status = CreateNewJavaSymbolizationContext(upid);
     if (!new_ctx_status.ok()) {
       // Something went wrong with the pre-existing symbol file. Fall back to native.
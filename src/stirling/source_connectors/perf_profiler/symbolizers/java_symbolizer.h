@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "src/stirling/source_connectors/perf_profiler/java/attach.h"
+#include "src/stirling/source_connectors/perf_profiler/java/symbol_ring_reader.h"
 #include "src/stirling/source_connectors/perf_profiler/symbolizers/symbolizer.h"
 #include "src/stirling/utils/monitor.h"
 
@@ -44,6 +45,13 @@ class JavaSymbolizationContext {
   };
   using SymbolMapType = absl::btree_map<uint64_t, SymbolAndCodeSize>;
 
+  // Preferred transport: the shared-memory symbol ring published by the JVMTI agent.
+  JavaSymbolizationContext(const struct upid_t& target_upid,
+                           profiler::SymbolizerFn native_symbolizer_fn,
+                           std::unique_ptr<java::SymbolRingReader> symbol_ring_reader);
+
+  // Legacy transport: the symbol log file (kept for agents that fail to set up the ring,
+  // and for pre-existing symbol files from older agents).
   JavaSymbolizationContext(const struct upid_t& target_upid,
                            profiler::SymbolizerFn native_symbolizer_fn,
                            std::unique_ptr<std::ifstream> symbol_file);
@@ -56,11 +64,16 @@ class JavaSymbolizationContext {
   void set_requires_refresh() { requires_refresh_ = true; }
 
  private:
+  void ResolveHostArtifactsPath(const struct upid_t& target_upid);
   void UpdateSymbolMap();
+  void IngestSymbolUpdate(const java::RawSymbolUpdate& update, const char* symbol_bytes);
 
   bool requires_refresh_ = false;
   SymbolMapType symbol_map_;
   profiler::SymbolizerFn native_symbolizer_fn_;
+  std::unique_ptr<java::SymbolRingReader> symbol_ring_reader_;
+  uint64_t last_consumed_flush_epoch_ = 0;
+  uint64_t last_dropped_updates_ = 0;
   std::unique_ptr<std::ifstream> symbol_file_;
   bool host_artifacts_path_resolved_ = false;
   std::filesystem::path host_artifacts_path_;
@@ -78,6 +78,37 @@ TYPED_TEST(SymbolizerTest, UserSymbols) {
   EXPECT_EQ(symbolize(2), std::string("0x0000000000000002"));
 }
 
+// Verifies the persistent symbol cache: a cold start builds the symbolizer from the ELF
+// symtab and writes an index file; a warm start reconstructs the symbolizer from that index
+// (without re-reading the symtab) and must resolve the same symbols.
+TEST_F(ElfSymbolizerTest, PersistentSymbolCache) {
+  ::px::testing::TempDir cache_dir;
+  PL_SET_FOR_SCOPE(FLAGS_stirling_profiler_symbol_cache_dir, cache_dir.path().string());
+
+  struct upid_t this_upid;
+  this_upid.pid = static_cast<uint32_t>(getpid());
+  this_upid.start_time_ticks = 0;
+
+  // Cold start: populates the cache directory.
+  auto symbolize = symbolizer_->GetSymbolizerFn(this_upid);
+  EXPECT_EQ(symbolize(kFooAddr), "test::foo()");
+  EXPECT_EQ(symbolize(kBarAddr), "test::bar()");
+
+  // Expect exactly one index file, keyed by this binary's build-id.
+  size_t num_index_files = 0;
+  for (const auto& dir_entry : std::filesystem::directory_iterator(cache_dir.path())) {
+    EXPECT_EQ(dir_entry.path().extension(), ".symindex");
+    ++num_index_files;
+  }
+  EXPECT_EQ(num_index_files, 1);
+
+  // Warm start: a fresh symbolizer loads the index file.
+  ASSERT_OK_AND_ASSIGN(std::unique_ptr<Symbolizer> warm_symbolizer, ElfSymbolizer::Create());
+  auto warm_symbolize = warm_symbolizer->GetSymbolizerFn(this_upid);
+  EXPECT_EQ(warm_symbolize(kFooAddr), "test::foo()");
+  EXPECT_EQ(warm_symbolize(kBarAddr), "test::bar()");
+}
+
 TEST_F(BCCSymbolizerTest, KernelSymbols) {
   ASSERT_OK_AND_ASSIGN(std::unique_ptr<Symbolizer> symbolizer, BCCSymbolizer::Create());
 
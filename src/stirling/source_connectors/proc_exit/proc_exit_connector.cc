@@ -24,6 +24,7 @@
 
 #include "src/common/base/base.h"
 #include "src/common/metrics/metrics.h"
+#include "src/stirling/bpf_tools/bcc_symbolizer_service.h"
 #include "src/stirling/bpf_tools/bcc_wrapper.h"
 #include "src/stirling/bpf_tools/macros.h"
 #include "src/stirling/bpf_tools/utils.h"
@@ -131,6 +132,10 @@ void ProcExitConnector::TransferDataImpl(ConnectorContext* ctx,
     r.Append<proc_exit_tracer::kSignalIdx>(GetExitSignal(event.exit_code));
     r.Append<proc_exit_tracer::kCommIdx>(std::move(event.comm));
 
+    // The process is gone, so release its shared BCC symbol tables right away, instead of
+    // waiting for a symbolizer's periodic clean-up pass to notice the exit.
+    bpf_tools::BCCSymbolizerService::GetInstance().ReleasePIDSymCache(event.upid.pid);
+
     UpdateCrashedJavaProcCounters(ctx->GetASID(), event, ctx->GetPIDInfoMap());
   }
   events_.clear();
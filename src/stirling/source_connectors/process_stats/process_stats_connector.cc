@@ -35,6 +35,16 @@ using system::ProcParser;
 Status ProcessStatsConnector::InitImpl() {
   sampling_freq_mgr_.set_period(kSamplingPeriod);
   push_freq_mgr_.set_period(kPushPeriod);
+
+  auto reader_or_status = system::TaskStatsReader::Create();
+  if (reader_or_status.ok()) {
+    task_stats_reader_ = reader_or_status.ConsumeValueOrDie();
+  } else {
+    LOG(INFO) << absl::Substitute(
+        "Netlink taskstats is not available, falling back to per-pid /proc reads. Error=\"$0\"",
+        reader_or_status.msg());
+  }
+
   return Status::OK();
 }
 
@@ -44,7 +54,7 @@ void ProcessStatsConnector::TransferProcessStatsTable(ConnectorContext* ctx,
                                                       DataTable* data_table) {
   const absl::flat_hash_map<md::UPID, md::PIDInfoUPtr>& pid_info_by_upid = ctx->GetPIDInfoMap();
 
-  int64_t timestamp = AdjustedSteadyClockNowNS();
+  int64_t timestamp = transfer_time_ns();
 
   for (const auto& [upid, pid_info] : pid_info_by_upid) {
     // TODO(zasgar): Fix condition for dead pids after helper function is added.
@@ -66,11 +76,33 @@ void ProcessStatsConnector::TransferProcessStatsTable(ConnectorContext* ctx,
       continue;
     }
 
-    auto s2 = proc_parser_->ParseProcPIDStatIO(pid, &stats);
-    if (!s2.ok()) {
-      VLOG(1) << absl::Substitute(
-          "Failed to fetch IO stat info for PID ($0). Error=\"$1\" skipping.", pid, s2.msg());
-      continue;
+    bool task_stats_filled = false;
+    if (task_stats_reader_ != nullptr) {
+      auto task_stats_or_status = task_stats_reader_->GetTGIDStats(pid);
+      if (task_stats_or_status.ok()) {
+        // Prefer the netlink-provided CPU, fault and I/O accounting, which avoids the
+        // /proc/<pid>/io read. Note that the taskstats aggregation only covers live threads,
+        // while /proc/<pid>/stat also accumulates exited ones.
+        const struct taskstats& task_stats = task_stats_or_status.ValueOrDie();
+        stats.minor_faults = task_stats.ac_minflt;
+        stats.major_faults = task_stats.ac_majflt;
+        stats.utime_ns = task_stats.ac_utime * 1000;
+        stats.ktime_ns = task_stats.ac_stime * 1000;
+        stats.rchar_bytes = task_stats.read_char;
+        stats.wchar_bytes = task_stats.write_char;
+        stats.read_bytes = task_stats.read_bytes;
+        stats.write_bytes = task_stats.write_bytes;
+        task_stats_filled = true;
+      }
+    }
+
+    if (!task_stats_filled) {
+      auto s2 = proc_parser_->ParseProcPIDStatIO(pid, &stats);
+      if (!s2.ok()) {
+        VLOG(1) << absl::Substitute(
+            "Failed to fetch IO stat info for PID ($0). Error=\"$1\" skipping.", pid, s2.msg());
+        continue;
+      }
     }
 
     DataTable::RecordBuilder<&kProcessStatsTable> r(data_table, timestamp);
@@ -26,6 +26,7 @@
 
 #include "src/common/base/base.h"
 #include "src/common/system/system.h"
+#include "src/common/system/task_stats.h"
 #include "src/shared/metadata/metadata.h"
 #include "src/stirling/core/canonical_types.h"
 #include "src/stirling/core/source_connector.h"
@@ -65,6 +66,12 @@ class ProcessStatsConnector : public SourceConnector {
   void TransferProcessStatsTable(ConnectorContext* ctx, DataTable* data_table);
 
   std::unique_ptr<system::ProcParser> proc_parser_;
+
+  // Netlink-based collector for CPU, fault and I/O accounting. One persistent socket serves all
+  // processes, which is much cheaper than per-pid /proc reads on nodes with many processes.
+  // May be nullptr (e.g. kernel without taskstats, or missing privileges), in which case the
+  // collection falls back to /proc.
+  std::unique_ptr<system::TaskStatsReader> task_stats_reader_;
 };
 
 }  // namespace stirling
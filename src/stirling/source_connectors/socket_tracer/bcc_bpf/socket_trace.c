@@ -44,6 +44,14 @@ const int32_t kInvalidFD = -1;
 // is reported to user-space. It applies to read and write traffic combined.
 const int kConnStatsDataThreshold = 65536;
 
+// Parameters for the protocol inference negative cache.
+// A connection whose first kProtocolInferenceFailureThreshold inference attempts all fail to
+// classify is considered uninteresting (e.g. a custom TCP protocol), and inference is paused
+// on it for kProtocolInferencePauseNs. After the pause expires, a fresh batch of attempts is
+// allowed, in case a recognizable protocol appears later in the stream.
+const int kProtocolInferenceFailureThreshold = 16;
+const uint64_t kProtocolInferencePauseNs = 30ULL * 1000 * 1000 * 1000;
+
 // This is the perf buffer for BPF program to export data from kernel to user space.
 BPF_PERF_OUTPUT(socket_data_events);
 BPF_PERF_OUTPUT(socket_control_events);
@@ -71,6 +79,19 @@ BPF_HASH(conn_info_map, uint64_t, struct conn_info_t, 131072);
 // Key is {tgid, fd}; Value is TSID.
 BPF_HASH(conn_disabled_map, uint64_t, uint64_t);
 
+// CIDR blocks covering endpoints that are inside the cluster.
+// Used to drop client-side traffic to in-cluster endpoints in the kernel;
+// such traffic is traced on the server side instead.
+// This map is only written from user-space, and only read from BPF.
+// Unused slots have sa_family == 0.
+BPF_ARRAY(cluster_cidrs_map, struct cluster_cidr_t, MAX_CLUSTER_CIDRS);
+
+// For each protocol, a bit-mask of the connection roles that are subject to the cluster CIDR
+// filter above. User-space populates this with the roles it would disable anyway when the remote
+// endpoint is inside the cluster (see ConnTracker::UpdateState). Roles that are traced regardless
+// of the remote endpoint's location (e.g. DNS clients) are excluded from the mask.
+BPF_PERCPU_ARRAY(cidr_filter_role_map, uint64_t, kNumProtocols);
+
 // Map from thread to its ongoing accept() syscall's input argument.
 // Tracks accept() call from entry -> exit.
 // Key is {tgid, pid}.
@@ -220,6 +241,59 @@ static __inline bool should_trace_protocol_data(const struct conn_info_t* conn_i
   return control & conn_info->role;
 }
 
+static __inline bool cidr_contains_remote_addr(const struct cluster_cidr_t* cidr,
+                                               const union sockaddr_t* addr) {
+  if (cidr->sa_family != addr->sa.sa_family) {
+    return false;
+  }
+  if (cidr->sa_family == AF_INET) {
+    return (addr->in4.sin_addr.s_addr & cidr->mask[0]) == cidr->addr[0];
+  }
+  return ((addr->in6.sin6_addr.s6_addr32[0] & cidr->mask[0]) == cidr->addr[0]) &&
+         ((addr->in6.sin6_addr.s6_addr32[1] & cidr->mask[1]) == cidr->addr[1]) &&
+         ((addr->in6.sin6_addr.s6_addr32[2] & cidr->mask[2]) == cidr->addr[2]) &&
+         ((addr->in6.sin6_addr.s6_addr32[3] & cidr->mask[3]) == cidr->addr[3]);
+}
+
+static __inline bool is_remote_addr_in_cluster(const union sockaddr_t* addr) {
+  if (addr->sa.sa_family != AF_INET && addr->sa.sa_family != AF_INET6) {
+    // The remote address has not been resolved (yet); leave the decision to user-space.
+    return false;
+  }
+
+#pragma unroll
+  for (int i = 0; i < MAX_CLUSTER_CIDRS; ++i) {
+    int idx = i;
+    struct cluster_cidr_t* cidr = cluster_cidrs_map.lookup(&idx);
+    if (cidr == NULL || cidr->sa_family == 0) {
+      continue;
+    }
+    if (cidr_contains_remote_addr(cidr, addr)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Kernel-side mirror of the cluster scoping in ConnTracker::UpdateState(): client-side
+// connections to endpoints inside the cluster are traced on the server side instead.
+// Filtering here saves the perf buffer round-trip for data that user-space would discard anyway.
+static __inline bool is_conn_cidr_filtered(const struct conn_info_t* conn_info) {
+  if (!ENABLE_IN_KERNEL_CIDR_FILTERING) {
+    return false;
+  }
+
+  uint32_t protocol = conn_info->protocol;
+  uint64_t kZero = 0;
+  uint64_t filtered_roles = *cidr_filter_role_map.lookup_or_init(&protocol, &kZero);
+  if ((filtered_roles & conn_info->role) == 0) {
+    return false;
+  }
+
+  return is_remote_addr_in_cluster(&conn_info->addr);
+}
+
 static __inline bool is_stirling_tgid(const uint32_t tgid) {
   int idx = kStirlingTGIDIndex;
   int64_t* stirling_tgid = control_values.lookup(&idx);
@@ -260,6 +334,17 @@ static __inline void update_traffic_class(struct conn_info_t* conn_info,
   if (conn_info == NULL) {
     return;
   }
+
+  // Negative cache: skip inference while it is paused on a connection that has repeatedly
+  // failed to classify. Once the pause (TTL) expires, a fresh batch of attempts is allowed.
+  if (conn_info->protocol == kProtocolUnknown && conn_info->protocol_infer_pause_until_ns != 0) {
+    if (bpf_ktime_get_ns() < conn_info->protocol_infer_pause_until_ns) {
+      return;
+    }
+    conn_info->protocol_infer_pause_until_ns = 0;
+    conn_info->protocol_total_count = 0;
+  }
+
   conn_info->protocol_total_count += 1;
 
   // Try to infer connection type (protocol) based on data.
@@ -267,9 +352,18 @@ static __inline void update_traffic_class(struct conn_info_t* conn_info,
 
   // Could not infer the traffic.
   if (inferred_protocol.protocol == kProtocolUnknown || conn_info->protocol == kProtocolMongo) {
+    if (conn_info->protocol == kProtocolUnknown &&
+        conn_info->protocol_total_count >= kProtocolInferenceFailureThreshold) {
+      conn_info->protocol_infer_pause_until_ns = bpf_ktime_get_ns() + kProtocolInferencePauseNs;
+    }
     return;
   }
 
+  // The number of events that classified as the designated protocol: a confidence signal.
+  // Note that once set, a connection's protocol is never overwritten, so a single packet that
+  // happens to match a different protocol's signature cannot flip the classification.
+  conn_info->protocol_match_count += 1;
+
   // Update protocol if not set.
   if (conn_info->protocol == kProtocolUnknown) {
     conn_info->protocol = inferred_protocol.protocol;
@@ -650,7 +744,21 @@ static __inline bool should_send_data(uint32_t tgid, uint64_t conn_disabled_tsid
   }
 
   // Only trace data for protocols of interest, or if forced on.
-  return (force_trace_tgid || should_trace_protocol_data(conn_info));
+  if (force_trace_tgid) {
+    return true;
+  }
+
+  if (!should_trace_protocol_data(conn_info)) {
+    return false;
+  }
+
+  // Never trace connections that user-space would disable because the remote endpoint is inside
+  // the cluster.
+  if (is_conn_cidr_filtered(conn_info)) {
+    return false;
+  }
+
+  return true;
 }
 
 static __inline void update_conn_stats(struct pt_regs* ctx, struct conn_info_t* conn_info,
@@ -665,6 +773,14 @@ static __inline void update_conn_stats(struct pt_regs* ctx, struct conn_info_t*
       break;
   }
 
+  // When in-kernel conn stats aggregation is enabled, the counters updated above are read
+  // periodically by user-space straight out of conn_info_map, and no steady-state events are
+  // submitted through the perf buffer. Events are still submitted on close (see
+  // process_syscall_close), where the map entry is about to be deleted.
+  if (ENABLE_IN_KERNEL_CONN_STATS) {
+    return;
+  }
+
   // Only send event if there's been enough of a change.
   // TODO(oazizi): Add elapsed time since last send as a triggering condition too.
   uint64_t total_bytes = conn_info->wr_bytes + conn_info->rd_bytes;
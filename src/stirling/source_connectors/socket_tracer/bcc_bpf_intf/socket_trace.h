@@ -28,6 +28,24 @@
 
 const char kControlMapName[] = "control_map";
 const char kControlValuesArrayName[] = "control_values";
+const char kClusterCIDRsMapName[] = "cluster_cidrs_map";
+const char kCIDRFilterRoleMapName[] = "cidr_filter_role_map";
+
+// Maximum number of CIDR blocks that user-space can push into the kernel-side cluster filter.
+// A cluster typically only has a handful of CIDRs (pod CIDR, service CIDR), but each IPv4 CIDR
+// takes two slots (native and IPv4-mapped IPv6 form).
+#define MAX_CLUSTER_CIDRS 16
+const int kMaxClusterCIDRs = MAX_CLUSTER_CIDRS;
+
+// A CIDR block, in a form that BPF can match against a remote endpoint address cheaply.
+// User-space pre-computes the mask from the prefix length, and pre-applies it to the address.
+// All words are in network byte order; IPv4 addresses use word 0 only.
+struct cluster_cidr_t {
+  // AF_INET or AF_INET6. A value of 0 marks an unused slot.
+  uint32_t sa_family;
+  uint32_t mask[4];
+  uint32_t addr[4];
+};
 
 const int64_t kTraceAllTGIDs = -1;
 
@@ -79,6 +97,12 @@ struct conn_info_t {
   // How many times traffic inference has been applied on this connection.
   int32_t protocol_total_count;
 
+  // If non-zero, protocol inference on this connection is paused until this time
+  // (in ns, kernel monotonic clock). Set when repeated inference attempts fail to classify
+  // the connection, so that heavy non-traced protocols do not pay the classification cost
+  // on every event (a negative cache with a TTL).
+  uint64_t protocol_infer_pause_until_ns;
+
   // Keep the header of the last packet suspected to be MySQL/Kafka. MySQL/Kafka server does 2
   // separate read syscalls, first to read the header, and second the body of the packet. Thus, we
   // keep a state. (MySQL): Length(3 bytes) + seq_number(1 byte). (Kafka): Length(4 bytes)
@@ -18,6 +18,8 @@
 
 #include "src/stirling/source_connectors/socket_tracer/conn_stats.h"
 
+#include <cstring>
+
 #include <absl/strings/substitute.h>
 
 #include "src/common/base/base.h"
@@ -32,52 +34,93 @@ ConnStats::AggKey BuildAggKey(const upid_t& upid, endpoint_role_t role,
   // Both local UPID and remote endpoint must be fully specified.
   DCHECK_NE(upid.pid, 0);
   DCHECK_NE(upid.start_time_ticks, 0);
-  DCHECK(remote_endpoint.family != SockAddrFamily::kUnspecified);
+  DCHECK(remote_endpoint.family == SockAddrFamily::kIPv4 ||
+         remote_endpoint.family == SockAddrFamily::kIPv6);
   DCHECK(role != kRoleUnknown);
-  return {
-      .upid = upid,
-      .remote_addr = remote_endpoint.AddrStr(),
-      // Set port to 0 if this event is from a server process.
-      // This avoids creating excessive amount of records from changing ports of K8s services.
-      .remote_port = role == kRoleServer ? 0 : remote_endpoint.port(),
-  };
+
+  ConnStats::AggKey key;
+  key.upid = upid;
+  // The address stays in binary form; formatting it per tracker per cycle would allocate a
+  // string for every connection on the node. It is rendered once per emitted record instead.
+  key.addr_family = remote_endpoint.family;
+  if (remote_endpoint.family == SockAddrFamily::kIPv4) {
+    const auto& addr = std::get<SockAddrIPv4>(remote_endpoint.addr).addr;
+    memcpy(key.remote_addr.data(), &addr, sizeof(addr));
+  } else {
+    const auto& addr = std::get<SockAddrIPv6>(remote_endpoint.addr).addr;
+    memcpy(key.remote_addr.data(), &addr, sizeof(addr));
+  }
+  // Set port to 0 if this event is from a server process.
+  // This avoids creating excessive amount of records from changing ports of K8s services.
+  key.remote_port = role == kRoleServer ? 0 : remote_endpoint.port();
+  return key;
 }
 
 }  // namespace
 
+std::string ConnStats::AggKey::RemoteAddrStr() const {
+  switch (addr_family) {
+    case SockAddrFamily::kIPv4: {
+      struct in_addr addr;
+      memcpy(&addr, remote_addr.data(), sizeof(addr));
+      return IPv4AddrToString(addr).ValueOr("<Could not decode>");
+    }
+    case SockAddrFamily::kIPv6: {
+      struct in6_addr addr;
+      memcpy(&addr, remote_addr.data(), sizeof(addr));
+      return IPv6AddrToString(addr).ValueOr("<Could not decode>");
+    }
+    default:
+      return "-";
+  }
+}
+
 absl::flat_hash_map<ConnStats::AggKey, ConnStats::Stats>& ConnStats::UpdateStats() {
   ++update_counter_;
 
-  for (const auto& tracker : conn_trackers_mgr_->active_trackers()) {
-    if (tracker->IsZombie()) {
-      tracker->MarkFinalConnStatsReported();
+  for (size_t shard = 0; shard < conn_trackers_mgr_->num_shards(); ++shard) {
+    for (const auto& tracker : conn_trackers_mgr_->active_trackers(shard)) {
+      if (tracker->IsZombie()) {
+        tracker->MarkFinalConnStatsReported();
+      }
+
+      if (!(tracker->remote_endpoint().family == SockAddrFamily::kIPv4 ||
+            tracker->remote_endpoint().family == SockAddrFamily::kIPv6) ||
+          tracker->role() == kRoleUnknown) {
+        continue;
+      }
+
+      auto& conn_stats = tracker->conn_stats();
+      int conn_open = conn_stats.OpenSinceLastRead();
+      int conn_close = conn_stats.CloseSinceLastRead();
+      int bytes_recv = conn_stats.BytesRecvSinceLastRead();
+      int bytes_sent = conn_stats.BytesSentSinceLastRead();
+
+      AggKey key =
+          BuildAggKey(tracker->conn_id().upid, tracker->role(), tracker->remote_endpoint());
+      auto& stats = agg_stats_[key];
+
+      // Change-only flush: the entry is only marked active when one of its counters or
+      // attributes actually moved this cycle. Most connections on a busy node are idle
+      // between windows, and leaving last_update untouched makes TransferConnStats skip
+      // them instead of re-emitting an identical row every window.
+      const bool changed = conn_open != 0 || conn_close != 0 || bytes_recv != 0 ||
+                           bytes_sent != 0 || stats.protocol != tracker->protocol() ||
+                           stats.role != tracker->role() || stats.ssl != tracker->ssl();
+
+      stats.addr_family = tracker->remote_endpoint().family;
+      stats.role = tracker->role();
+      stats.protocol = tracker->protocol();
+      stats.ssl = tracker->ssl();
+      stats.conn_open += conn_open;
+      stats.conn_close += conn_close;
+      stats.bytes_recv += bytes_recv;
+      stats.bytes_sent += bytes_sent;
+
+      if (changed) {
+        stats.last_update = update_counter_;
+      }
     }
-
-    if (!(tracker->remote_endpoint().family == SockAddrFamily::kIPv4 ||
-          tracker->remote_endpoint().family == SockAddrFamily::kIPv6) ||
-        tracker->role() == kRoleUnknown) {
-      continue;
-    }
-
-    auto& conn_stats = tracker->conn_stats();
-    int conn_open = conn_stats.OpenSinceLastRead();
-    int conn_close = conn_stats.CloseSinceLastRead();
-    int bytes_recv = conn_stats.BytesRecvSinceLastRead();
-    int bytes_sent = conn_stats.BytesSentSinceLastRead();
-
-    AggKey key = BuildAggKey(tracker->conn_id().upid, tracker->role(), tracker->remote_endpoint());
-    auto& stats = agg_stats_[key];
-
-    stats.addr_family = tracker->remote_endpoint().family;
-    stats.role = tracker->role();
-    stats.protocol = tracker->protocol();
-    stats.ssl = tracker->ssl();
-    stats.conn_open += conn_open;
-    stats.conn_close += conn_close;
-    stats.bytes_recv += bytes_recv;
-    stats.bytes_sent += bytes_sent;
-
-    stats.last_update = update_counter_;
   }
 
   return agg_stats_;
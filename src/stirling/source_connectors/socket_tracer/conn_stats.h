@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <utility>
 
@@ -25,6 +26,7 @@
 #include <absl/container/flat_hash_set.h>
 #include <absl/hash/hash.h>
 
+#include "src/common/base/inet_utils.h"
 #include "src/shared/upid/upid.h"
 #include "src/stirling/bpf_tools/bcc_bpf_intf/upid.h"
 #include "src/stirling/source_connectors/socket_tracer/conn_trackers_manager.h"
@@ -46,22 +48,30 @@ class ConnStats {
   // set to 0 by BuildAggKey() to collapse multiple connections from the same client to a server.
   struct AggKey {
     struct upid_t upid;
-    std::string remote_addr;
-    int remote_port;
+    // Remote address in binary network order (IPv4 uses the first 4 bytes). Kept binary and
+    // rendered with RemoteAddrStr() only when a record is emitted, so the map -- hundreds of
+    // thousands of entries on service-mesh nodes -- carries no per-entry heap allocations.
+    SockAddrFamily addr_family = SockAddrFamily::kUnspecified;
+    std::array<uint8_t, 16> remote_addr = {};
+    int remote_port = 0;
+
+    std::string RemoteAddrStr() const;
 
     bool operator==(const AggKey& rhs) const {
       return upid.tgid == rhs.upid.tgid && upid.start_time_ticks == rhs.upid.start_time_ticks &&
-             remote_addr == rhs.remote_addr && remote_port == rhs.remote_port;
+             addr_family == rhs.addr_family && remote_addr == rhs.remote_addr &&
+             remote_port == rhs.remote_port;
     }
 
     template <typename H>
     friend H AbslHashValue(H h, const AggKey& key) {
-      return H::combine(std::move(h), key.upid.tgid, key.upid.start_time_ticks, key.remote_addr,
-                        key.remote_port);
+      return H::combine(std::move(h), key.upid.tgid, key.upid.start_time_ticks, key.addr_family,
+                        key.remote_addr, key.remote_port);
     }
 
     std::string ToString() const {
-      return absl::Substitute("[tgid=$0 addr=$1 port=$2]", upid.tgid, remote_addr, remote_port);
+      return absl::Substitute("[tgid=$0 addr=$1 port=$2]", upid.tgid, RemoteAddrStr(),
+                              remote_port);
     }
   };
 
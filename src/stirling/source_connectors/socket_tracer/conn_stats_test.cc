@@ -35,6 +35,7 @@ using ::testing::AllOf;
 using ::testing::Field;
 using ::testing::IsEmpty;
 using ::testing::Pair;
+using ::testing::Property;
 using ::testing::SizeIs;
 
 TEST(HashTest, CanBeUsedInFlatHashMap) {
@@ -43,7 +44,8 @@ TEST(HashTest, CanBeUsedInFlatHashMap) {
 
   ConnStats::AggKey key = {
       .upid = {.tgid = 1, .start_time_ticks = 2},
-      .remote_addr = "test",
+      .addr_family = SockAddrFamily::kIPv4,
+      .remote_addr = {1, 1, 1, 1},
       .remote_port = 12345,
   };
 
@@ -69,9 +71,9 @@ class ConnStatsTest : public ::testing::Test {
   ConnStats conn_stats_;
 };
 
-auto AggKeyIs(int tgid, std::string_view remote_addr, int remote_port) {
+auto AggKeyIs(int tgid, std::string remote_addr, int remote_port) {
   return AllOf(Field(&ConnStats::AggKey::upid, Field(&upid_t::tgid, tgid)),
-               Field(&ConnStats::AggKey::remote_addr, remote_addr),
+               Property(&ConnStats::AggKey::RemoteAddrStr, remote_addr),
                Field(&ConnStats::AggKey::remote_port, remote_port));
 }
 
@@ -396,5 +398,54 @@ TEST_F(ConnStatsTest, DisabledConnTracker) {
               ElementsAre(Pair(AggKeyIs(11111, "1.1.1.1", 80), StatsIs(1, 1, 200, 100))));
 }
 
+// Tests that an entry is only marked active on cycles where its counters actually moved,
+// so idle connections are not re-emitted every window.
+TEST_F(ConnStatsTest, IdleConnectionNotActive) {
+  constexpr struct conn_id_t kConnID0 = {
+      .upid = {.pid = 11111, .start_time_ticks = 1000},
+      .fd = 3,
+      .tsid = 10000,
+  };
+
+  struct conn_stats_event_t conn_stats_event;
+  conn_stats_event.timestamp_ns = 0;
+  conn_stats_event.conn_id = kConnID0;
+  conn_stats_event.role = kRoleClient;
+  conn_stats_event.addr.in4.sin_family = AF_INET;
+  conn_stats_event.addr.in4.sin_port = htons(80);
+  conn_stats_event.addr.in4.sin_addr.s_addr = 0x01010101;  // 1.1.1.1
+  conn_stats_event.conn_events = 0;
+  conn_stats_event.rd_bytes = 0;
+  conn_stats_event.wr_bytes = 0;
+
+  ConnTracker& tracker = conn_trackers_mgr_.GetOrCreateConnTracker(conn_stats_event.conn_id);
+  conn_stats_event.timestamp_ns += 1;
+  conn_stats_event.conn_events |= CONN_OPEN;
+  tracker.AddConnStats(conn_stats_event);
+
+  {
+    auto& agg_stats = conn_stats_.UpdateStats();
+    ASSERT_THAT(agg_stats, SizeIs(1));
+    EXPECT_TRUE(conn_stats_.Active(agg_stats.begin()->second));
+  }
+
+  // Idle cycle: the connection is still open, but nothing changed.
+  {
+    auto& agg_stats = conn_stats_.UpdateStats();
+    ASSERT_THAT(agg_stats, SizeIs(1));
+    EXPECT_FALSE(conn_stats_.Active(agg_stats.begin()->second));
+  }
+
+  // New traffic makes it active again.
+  conn_stats_event.timestamp_ns += 1;
+  conn_stats_event.rd_bytes += 5;
+  tracker.AddConnStats(conn_stats_event);
+  {
+    auto& agg_stats = conn_stats_.UpdateStats();
+    ASSERT_THAT(agg_stats, SizeIs(1));
+    EXPECT_TRUE(conn_stats_.Active(agg_stats.begin()->second));
+  }
+}
+
 }  // namespace stirling
 }  // namespace px
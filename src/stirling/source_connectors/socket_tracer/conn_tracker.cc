@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <deque>
 #include <filesystem>
 #include <numeric>
@@ -57,6 +58,11 @@ DEFINE_int64(
 DEFINE_int64(stirling_untracked_upid_threshold_seconds, 0,
              "If non-zero, Stirling will disable data tracking of processes that are outside the "
              "list of PIDs tracked by the context after the specified time period.");
+DEFINE_uint64(stirling_trace_sampling_threshold_rps, 0,
+              "If non-zero, per-connection records-per-second above which adaptive record "
+              "sampling engages: a representative subset of records is traced in full, and the "
+              "rest are dropped and accounted by count only. The keep rate auto-adjusts so that "
+              "roughly the threshold number of records per second are retained per connection.");
 
 namespace px {
 namespace stirling {
@@ -392,10 +398,52 @@ ConnTracker::ProcessToRecords<protocols::http2::ProtocolTraits>() {
   CONN_TRACE(2) << absl::Substitute("Processed records, count=$0", result.records.size());
 
   UpdateResultStats(result);
+  SampleRecords(&result.records);
 
   return std::move(result.records);
 }
 
+void ConnTracker::UpdateRecordSamplingStride(size_t num_records) {
+  if (FLAGS_stirling_trace_sampling_threshold_rps == 0) {
+    record_sampling_stride_ = 1;
+    return;
+  }
+
+  // The first call only establishes the reference time for rate computation.
+  if (last_record_sampling_update_time_.time_since_epoch().count() == 0) {
+    last_record_sampling_update_time_ = current_time_;
+    return;
+  }
+
+  const auto time_delta = current_time_ - last_record_sampling_update_time_;
+  if (time_delta <= std::chrono::steady_clock::duration::zero()) {
+    return;
+  }
+  last_record_sampling_update_time_ = current_time_;
+
+  const double time_delta_seconds = std::chrono::duration<double>(time_delta).count();
+  const double record_rate_rps = static_cast<double>(num_records) / time_delta_seconds;
+
+  // Exponentially-weighted moving average, so that a short burst does not engage sampling,
+  // but a sustained high-rate connection does (and disengages once the rate drops again).
+  constexpr double kAlpha = 0.25;
+  avg_record_rate_rps_ = kAlpha * record_rate_rps + (1 - kAlpha) * avg_record_rate_rps_;
+
+  const double threshold_rps = static_cast<double>(FLAGS_stirling_trace_sampling_threshold_rps);
+  const uint32_t prev_stride = record_sampling_stride_;
+  if (avg_record_rate_rps_ > threshold_rps) {
+    record_sampling_stride_ =
+        static_cast<uint32_t>(std::ceil(avg_record_rate_rps_ / threshold_rps));
+  } else {
+    record_sampling_stride_ = 1;
+  }
+
+  if (record_sampling_stride_ != prev_stride) {
+    CONN_TRACE(1) << absl::Substitute("Record sampling stride changed $0 -> $1 (avg rate $2 rps).",
+                                      prev_stride, record_sampling_stride_, avg_record_rate_rps_);
+  }
+}
+
 void ConnTracker::Reset() {
   send_data_.Reset();
   recv_data_.Reset();
@@ -658,6 +706,8 @@ auto CreateTraceRoles() {
   return res;
 }
 
+}  // namespace
+
 bool ShouldTraceProtocolRole(traffic_protocol_t protocol, endpoint_role_t role) {
   // Specifies for each protocol what Role should trigger data tracing.
   static const EnumMap<traffic_protocol_t, absl::flat_hash_set<endpoint_role_t>> kTraceRoles =
@@ -665,8 +715,6 @@ bool ShouldTraceProtocolRole(traffic_protocol_t protocol, endpoint_role_t role)
   return kTraceRoles.Get(protocol).contains(role);
 }
 
-}  // namespace
-
 void ConnTracker::UpdateState(const std::vector<CIDRBlock>& cluster_cidrs) {
   if (state_ == State::kDisabled) {
     return;
@@ -50,6 +50,7 @@ DECLARE_int64(stirling_conn_trace_fd);
 DECLARE_bool(stirling_conn_disable_to_bpf);
 DECLARE_int64(stirling_check_proc_for_conn_close);
 DECLARE_int64(stirling_untracked_upid_threshold_seconds);
+DECLARE_uint64(stirling_trace_sampling_threshold_rps);
 
 #define CONN_TRACE(level) LOG_IF(INFO, level <= debug_trace_level_) << ToString() << " "
 
@@ -59,6 +60,11 @@ namespace stirling {
 // Forward declaration to avoid circular include and conn_tracker.h.
 class ConnTrackersManager;
 
+// Returns whether the given protocol and role combination is traced unconditionally,
+// regardless of where the remote endpoint is (e.g. DNS clients).
+// Other role and protocol combinations are subject to cluster-based scoping.
+bool ShouldTraceProtocolRole(traffic_protocol_t protocol, endpoint_role_t role);
+
 /**
  * Describes a connection from user space. This corresponds to struct conn_info_t in
  * src/stirling/source_connectors/socket_tracer/bcc_bpf_intf/socket_trace.h.
@@ -103,6 +109,12 @@ class ConnTracker : NotCopyMoveable {
     // The number of valid/invalid records.
     kValidRecords,
     kInvalidRecords,
+
+    // The number of message body bytes dropped because they exceeded the body size limit.
+    kBodyBytesTruncated,
+
+    // The number of records dropped by adaptive record sampling on high-rate connections.
+    kRecordsSampledOut,
   };
 
   // State values change monotonically from lower to higher values.
@@ -278,6 +290,7 @@ class ConnTracker : NotCopyMoveable {
     CONN_TRACE(2) << absl::Substitute("records=$0", result.records.size());
 
     UpdateResultStats(result);
+    SampleRecords(&result.records);
 
     return std::move(result.records);
   }
@@ -318,6 +331,7 @@ class ConnTracker : NotCopyMoveable {
   endpoint_role_t role() const { return role_; }
   bool ssl() const { return ssl_; }
   ConnStatsTracker& conn_stats() { return conn_stats_; }
+  const ConnStatsTracker& conn_stats() const { return conn_stats_; }
 
   /**
    * Get remote IP endpoint of the connection.
@@ -610,6 +624,27 @@ class ConnTracker : NotCopyMoveable {
     return data_buffer_total + http2_events_total + parsed_msg_total;
   }
 
+  /**
+   * Returns the bytes currently allocated by the send and recv data stream buffers.
+   * Unlike MemUsage(), this does not depend on the protocol, so it can be aggregated
+   * across all trackers regardless of their traffic type.
+   */
+  size_t BufferMemUsage() const {
+    return send_data().data_buffer().capacity() + recv_data().data_buffer().capacity();
+  }
+
+  /**
+   * Releases the memory held by the send and recv data stream buffers, dropping any
+   * unparsed events. Used by ConnTrackersManager when the global buffer budget is exceeded;
+   * parsing re-synchronizes on subsequent events.
+   */
+  void ReclaimBufferMemory() {
+    send_data_.Reset();
+    recv_data_.Reset();
+    send_data_.data_buffer().ShrinkToFit();
+    recv_data_.data_buffer().ShrinkToFit();
+  }
+
  private:
   /**
    * The iterations given for protocol detection by uprobes. The value is given to the worst
@@ -669,6 +704,49 @@ class ConnTracker : NotCopyMoveable {
     stats_.Increment(StatKey::kValidRecords, result.records.size());
   }
 
+  // Overload for HTTP records, which additionally accounts for body bytes dropped due to the
+  // body size limit (body_size records the original length of the body on the wire).
+  void UpdateResultStats(const protocols::RecordsWithErrorCount<protocols::http::Record>& result) {
+    stats_.Increment(StatKey::kInvalidRecords, result.error_count);
+    stats_.Increment(StatKey::kValidRecords, result.records.size());
+    for (const auto& record : result.records) {
+      if (record.req.body_size > record.req.body.size()) {
+        stats_.Increment(StatKey::kBodyBytesTruncated,
+                         record.req.body_size - record.req.body.size());
+      }
+      if (record.resp.body_size > record.resp.body.size()) {
+        stats_.Increment(StatKey::kBodyBytesTruncated,
+                         record.resp.body_size - record.resp.body.size());
+      }
+    }
+  }
+
+  // Recomputes the record sampling stride from the observed record rate.
+  // See the adaptive record sampling members below for details.
+  void UpdateRecordSamplingStride(size_t num_records);
+
+  // Adaptive record sampling for high-rate connections (e.g. load balancer front-ends):
+  // a representative subset of records is kept and traced in full; the rest are dropped and
+  // accounted by count in StatKey::kRecordsSampledOut. Per-connection data volume accounting
+  // remains complete via conn_stats. Sampling engages only when the connection's record rate
+  // exceeds --stirling_trace_sampling_threshold_rps, and the keep rate auto-adjusts so that
+  // roughly that many records per second are retained.
+  template <typename TRecordType>
+  void SampleRecords(std::vector<TRecordType>* records) {
+    UpdateRecordSamplingStride(records->size());
+    if (record_sampling_stride_ <= 1) {
+      return;
+    }
+    size_t num_kept = 0;
+    for (auto& record : *records) {
+      if (record_sampling_counter_++ % record_sampling_stride_ == 0) {
+        (*records)[num_kept++] = std::move(record);
+      }
+    }
+    stats_.Increment(StatKey::kRecordsSampledOut, records->size() - num_kept);
+    records->resize(num_kept);
+  }
+
   int debug_trace_level_ = 0;
 
   // Used to identify the remove endpoint in case the accept/connect was not traced.
@@ -739,6 +817,13 @@ class ConnTracker : NotCopyMoveable {
 
   utils::StatCounter<StatKey> stats_;
 
+  // Adaptive record sampling state: a smoothed estimate of the connection's record rate,
+  // and the stride (keep 1 of every N records) derived from it. See SampleRecords().
+  std::chrono::time_point<std::chrono::steady_clock> last_record_sampling_update_time_;
+  double avg_record_rate_rps_ = 0;
+  uint32_t record_sampling_stride_ = 1;
+  uint64_t record_sampling_counter_ = 0;
+
   // Connection trackers need to keep a state because there can be information between
   // needed from previous requests/responses needed to parse or render current request.
   // E.g. MySQL keeps a map of previously occurred stmt prepare events as the state such
@@ -367,6 +367,48 @@ TEST_F(ConnTrackerTest, DataEventsChangesCounter) {
   EXPECT_EQ(kHTTPResp0.size(), tracker.GetStat(ConnTracker::StatKey::kBytesSent));
 }
 
+TEST_F(ConnTrackerTest, AdaptiveRecordSamplingOnHighRateConnection) {
+  PL_SET_FOR_SCOPE(FLAGS_stirling_trace_sampling_threshold_rps, 10);
+
+  ConnTracker tracker;
+  tracker.InitProtocolState<http::StateWrapper>();
+  tracker.AddControlEvent(event_gen_.InitConn());
+  tracker.set_current_time(now());
+
+  // Each simulated one-second iteration pushes 20 request-response pairs,
+  // i.e. 2x the configured 10 rps sampling threshold.
+  auto run_iteration = [&](int num_record_pairs) {
+    for (int i = 0; i < num_record_pairs; ++i) {
+      tracker.AddDataEvent(event_gen_.InitSendEvent<kProtocolHTTP>(kHTTPReq0));
+      tracker.AddDataEvent(event_gen_.InitRecvEvent<kProtocolHTTP>(kHTTPResp0));
+    }
+    mock_clock_.advance(1'000'000'000);
+    tracker.set_current_time(now());
+    return tracker.ProcessToRecords<http::ProtocolTraits>();
+  };
+
+  // The smoothed record rate must cross the threshold before sampling engages:
+  // the first iteration only establishes the reference time for the rate computation,
+  // then the EWMA ramps 5 -> 8.75 -> 11.6 rps, crossing the 10 rps threshold.
+  EXPECT_THAT(run_iteration(20), SizeIs(20));
+  EXPECT_THAT(run_iteration(20), SizeIs(20));
+  EXPECT_THAT(run_iteration(20), SizeIs(20));
+
+  // Sampling engaged: keep 1 of every 2 records.
+  EXPECT_THAT(run_iteration(20), SizeIs(10));
+  EXPECT_THAT(run_iteration(20), SizeIs(10));
+  EXPECT_EQ(20, tracker.GetStat(ConnTracker::StatKey::kRecordsSampledOut));
+
+  // Sampled-out records still count towards kValidRecords: 5 iterations of 20 records.
+  EXPECT_EQ(100, tracker.GetStat(ConnTracker::StatKey::kValidRecords));
+
+  // Once the rate drops, the EWMA decays below the threshold and sampling disengages.
+  EXPECT_THAT(run_iteration(0), IsEmpty());
+  EXPECT_THAT(run_iteration(0), IsEmpty());
+  EXPECT_THAT(run_iteration(5), SizeIs(5));
+  EXPECT_EQ(20, tracker.GetStat(ConnTracker::StatKey::kRecordsSampledOut));
+}
+
 TEST_F(ConnTrackerTest, MemUsage) {
   testing::MockClock mock_clock;
   testing::EventGenerator event_gen_(&mock_clock);
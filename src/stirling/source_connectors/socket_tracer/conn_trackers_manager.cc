@@ -18,10 +18,19 @@
 
 #include "src/stirling/source_connectors/socket_tracer/conn_trackers_manager.h"
 
+#include <algorithm>
+
+#include <absl/hash/hash.h>
+
 DEFINE_double(
     stirling_conn_tracker_cleanup_threshold, 0.2,
     "Percentage of trackers that are ready for destruction that will trigger a memory cleanup");
 
+DEFINE_uint64(stirling_conn_tracker_global_buffer_limit_bytes, 128ULL * 1024 * 1024,
+              "Aggregate budget for all connection trackers' data stream buffers. When exceeded, "
+              "buffers are reclaimed from the largest (and stalest) trackers first. "
+              "A value of 0 disables the budget.");
+
 namespace px {
 namespace stirling {
 
@@ -107,6 +116,10 @@ constexpr size_t kMaxConnTrackerPoolSize = 2048;
 
 uint64_t GetConnMapKey(uint32_t pid, int32_t fd) { return (static_cast<uint64_t>(pid) << 32) | fd; }
 
+size_t ShardIndex(uint64_t conn_map_key) {
+  return absl::Hash<uint64_t>()(conn_map_key) % ConnTrackersManager::kNumShards;
+}
+
 }  // namespace
 
 ConnTrackersManager::ConnTrackersManager() : trackers_pool_(kMaxConnTrackerPoolSize) {}
@@ -119,7 +132,7 @@ ConnTracker& ConnTrackersManager::GetOrCreateConnTracker(struct conn_id_t conn_i
   auto [conn_tracker_ptr, created] = conn_trackers.GetOrCreate(conn_id, &trackers_pool_);
 
   if (created) {
-    active_trackers_.push_back(conn_tracker_ptr);
+    active_tracker_shards_[ShardIndex(conn_map_key)].push_back(conn_tracker_ptr);
     conn_tracker_ptr->manager_ = this;
 
     stats_.Increment(StatKey::kTotal);
@@ -151,12 +164,12 @@ StatusOr<const ConnTracker*> ConnTrackersManager::GetConnTracker(uint32_t pid, i
 }
 
 void ConnTrackersManager::CleanupTrackers() {
-  {
-    auto iter = active_trackers_.begin();
-    while (iter != active_trackers_.end()) {
+  for (auto& shard_trackers : active_tracker_shards_) {
+    auto iter = shard_trackers.begin();
+    while (iter != shard_trackers.end()) {
       const auto& tracker = *iter;
       if (tracker->ReadyForDestruction()) {
-        active_trackers_.erase(iter++);
+        shard_trackers.erase(iter++);
         stats_.Increment(StatKey::kReadyForDestruction);
       } else {
         ++iter;
@@ -194,9 +207,72 @@ void ConnTrackersManager::CleanupTrackers() {
   DebugChecks();
 }
 
+void ConnTrackersManager::EnforceBufferMemoryBudget() {
+  const size_t limit_bytes = FLAGS_stirling_conn_tracker_global_buffer_limit_bytes;
+
+  size_t total_bytes = 0;
+  for (const auto& shard_trackers : active_tracker_shards_) {
+    for (const auto* tracker : shard_trackers) {
+      total_bytes += tracker->BufferMemUsage();
+    }
+  }
+
+  stats_.Reset(StatKey::kBufferMemUsage);
+  stats_.Increment(StatKey::kBufferMemUsage, static_cast<int>(total_bytes));
+
+  if (limit_bytes == 0 || total_bytes <= limit_bytes) {
+    return;
+  }
+
+  stats_.Increment(StatKey::kMemPressureEvents);
+
+  // Reclaim from the largest buffers first, breaking ties in favor of the trackers that have
+  // gone longest without traffic. This returns below budget while disturbing the fewest
+  // connections.
+  struct Candidate {
+    size_t mem_usage;
+    uint64_t last_bpf_timestamp_ns;
+    ConnTracker* tracker;
+  };
+  std::vector<Candidate> candidates;
+  for (auto& shard_trackers : active_tracker_shards_) {
+    for (auto* tracker : shard_trackers) {
+      size_t mem_usage = tracker->BufferMemUsage();
+      if (mem_usage > 0) {
+        candidates.push_back({mem_usage, tracker->last_bpf_timestamp_ns(), tracker});
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    if (a.mem_usage != b.mem_usage) {
+      return a.mem_usage > b.mem_usage;
+    }
+    return a.last_bpf_timestamp_ns < b.last_bpf_timestamp_ns;
+  });
+
+  for (const Candidate& candidate : candidates) {
+    if (total_bytes <= limit_bytes) {
+      break;
+    }
+    candidate.tracker->ReclaimBufferMemory();
+    const size_t reclaimed = candidate.mem_usage - candidate.tracker->BufferMemUsage();
+    VLOG(1) << absl::Substitute("Reclaimed $0 buffer bytes from conn_tracker=$1", reclaimed,
+                                candidate.tracker->ToString());
+    total_bytes -= reclaimed;
+    stats_.Increment(StatKey::kBufferMemReclaimed, static_cast<int>(reclaimed));
+  }
+
+  stats_.Reset(StatKey::kBufferMemUsage);
+  stats_.Increment(StatKey::kBufferMemUsage, static_cast<int>(total_bytes));
+}
+
 void ConnTrackersManager::DebugChecks() const {
+  size_t num_active_trackers = 0;
+  for (const auto& shard_trackers : active_tracker_shards_) {
+    num_active_trackers += shard_trackers.size();
+  }
   DCHECK_EQ(stats_.Get(StatKey::kTotal),
-            active_trackers_.size() + stats_.Get(StatKey::kReadyForDestruction));
+            num_active_trackers + stats_.Get(StatKey::kReadyForDestruction));
 }
 
 std::string ConnTrackersManager::DebugInfo() const {
@@ -205,10 +281,13 @@ std::string ConnTrackersManager::DebugInfo() const {
   absl::StrAppend(&out, "ConnTracker count statistics: ", StatsString(),
                   "\nDetailed statistics of individual ConnTracker:\n");
 
-  for (const auto& tracker : active_trackers_) {
-    absl::StrAppend(&out, absl::Substitute("  conn_tracker=$0 zombie=$1 ready_for_destruction=$2\n",
-                                           tracker->ToString(), tracker->IsZombie(),
-                                           tracker->ReadyForDestruction()));
+  for (const auto& shard_trackers : active_tracker_shards_) {
+    for (const auto& tracker : shard_trackers) {
+      absl::StrAppend(&out,
+                      absl::Substitute("  conn_tracker=$0 zombie=$1 ready_for_destruction=$2\n",
+                                       tracker->ToString(), tracker->IsZombie(),
+                                       tracker->ReadyForDestruction()));
+    }
   }
 
   return out;
@@ -220,8 +299,10 @@ std::string ConnTrackersManager::StatsString() const {
 
 void ConnTrackersManager::ComputeProtocolStats() {
   absl::flat_hash_map<traffic_protocol_t, int> protocol_count;
-  for (const auto* tracker : active_trackers_) {
-    ++protocol_count[tracker->protocol()];
+  for (const auto& shard_trackers : active_tracker_shards_) {
+    for (const auto* tracker : shard_trackers) {
+      ++protocol_count[tracker->protocol()];
+    }
   }
   for (auto protocol : magic_enum::enum_values<traffic_protocol_t>()) {
     protocol_stats_.Reset(protocol);
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <map>
 #include <memory>
@@ -28,9 +29,10 @@
 
 #include "src/stirling/source_connectors/socket_tracer/conn_tracker.h"
 #include "src/stirling/utils/obj_pool.h"
-#include "src/stirling/utils/stat_counter.h"
+#include "src/stirling/utils/sharded_stat_counter.h"
 
 DECLARE_double(stirling_conn_tracker_cleanup_threshold);
+DECLARE_uint64(stirling_conn_tracker_global_buffer_limit_bytes);
 
 namespace px {
 namespace stirling {
@@ -95,8 +97,19 @@ class ConnTrackersManager {
     kCreated,
     kDestroyed,
     kDestroyedGens,
+
+    // Memory pressure metrics, maintained by EnforceBufferMemoryBudget().
+    kBufferMemUsage,
+    kBufferMemReclaimed,
+    kMemPressureEvents,
   };
 
+  // Number of shards that active trackers are distributed across, keyed by a hash of the
+  // tracker's PID+FD. A tracker stays in the same shard for its entire life, and shards hold
+  // disjoint tracker sets, so different shards can be processed in parallel without locking,
+  // as long as trackers are only created and destroyed from the main thread.
+  static constexpr size_t kNumShards = 8;
+
   ConnTrackersManager();
 
   /**
@@ -105,7 +118,11 @@ class ConnTrackersManager {
    */
   ConnTracker& GetOrCreateConnTracker(struct conn_id_t conn_id);
 
-  const std::list<ConnTracker*>& active_trackers() const { return active_trackers_; }
+  size_t num_shards() const { return kNumShards; }
+
+  const std::list<ConnTracker*>& active_trackers(size_t shard) const {
+    return active_tracker_shards_[shard];
+  }
 
   /**
    * Returns the latest generation of a connection tracker for the given pid and fd.
@@ -120,6 +137,16 @@ class ConnTrackersManager {
    */
   void CleanupTrackers();
 
+  /**
+   * Enforces the global budget on the aggregate memory held by all trackers' data stream
+   * buffers. Each tracker individually respects its per-connection cap, so pressure comes from
+   * many connections buffering at once; when the aggregate exceeds
+   * FLAGS_stirling_conn_tracker_global_buffer_limit_bytes, buffers are reclaimed from the
+   * largest (and, on ties, stalest) trackers until the total is back under budget.
+   * Also refreshes the kBufferMemUsage pressure metric.
+   */
+  void EnforceBufferMemoryBudget();
+
   /**
    * Returns extensive debug information about the connection trackers.
    */
@@ -144,15 +171,17 @@ class ConnTrackersManager {
   // Key is {PID, FD} for outer map, and tsid for inner map.
   absl::flat_hash_map<uint64_t, ConnTrackerGenerations> conn_id_tracker_generations_;
 
-  std::list<ConnTracker*> active_trackers_;
+  // Active trackers, sharded by a hash of the tracker's PID+FD key. See kNumShards.
+  std::array<std::list<ConnTracker*>, kNumShards> active_tracker_shards_;
 
   // A pool of unused trackers that can be recycled.
   // This is useful for avoiding memory reallocations.
   ConnTrackerPool trackers_pool_;
 
-  // Records statistics of ConnTracker for reporting and consistency check.
-  utils::StatCounter<StatKey> stats_;
-  utils::StatCounter<traffic_protocol_t> protocol_stats_;
+  // Records statistics of ConnTracker for reporting and consistency check. Sharded because
+  // tracker shards are parsed on parallel transfer threads.
+  utils::ShardedStatCounter<StatKey> stats_;
+  utils::ShardedStatCounter<traffic_protocol_t> protocol_stats_;
 };
 
 }  // namespace stirling
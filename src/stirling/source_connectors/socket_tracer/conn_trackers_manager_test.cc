@@ -42,9 +42,11 @@ class ConnTrackersManagerTest : public ::testing::Test {
   }
 
   void TransferStreamsProxy(double mark_for_death_probability, int death_countdown) {
-    for (auto& tracker : trackers_mgr_.active_trackers()) {
-      if (probability_dist_(rng_) < mark_for_death_probability) {
-        tracker->MarkForDeath(death_countdown);
+    for (size_t shard = 0; shard < trackers_mgr_.num_shards(); ++shard) {
+      for (auto& tracker : trackers_mgr_.active_trackers(shard)) {
+        if (probability_dist_(rng_) < mark_for_death_probability) {
+          tracker->MarkForDeath(death_countdown);
+        }
       }
     }
   }
@@ -112,6 +114,32 @@ TEST_F(ConnTrackersManagerTest, DebugInfo) {
   EXPECT_THAT(debug_info, HasSubstr("conn_tracker=conn_id=[upid=1:1 fd=1 gen=1]"));
 }
 
+// Tests that the global buffer budget reclaims from the largest tracker first, while smaller
+// trackers are left untouched.
+TEST_F(ConnTrackersManagerTest, BufferMemoryGovernor) {
+  PL_SET_FOR_SCOPE(FLAGS_stirling_conn_tracker_global_buffer_limit_bytes, 32 * 1024);
+
+  struct conn_id_t conn_id_a = {{{1}, 0}, 1, 1};
+  struct conn_id_t conn_id_b = {{{2}, 0}, 1, 1};
+  ConnTracker& tracker_a = trackers_mgr_.GetOrCreateConnTracker(conn_id_a);
+  ConnTracker& tracker_b = trackers_mgr_.GetOrCreateConnTracker(conn_id_b);
+
+  // Each tracker is below any per-connection limit, but together they exceed the global budget.
+  tracker_a.send_data().data_buffer().Add(0, std::string(48 * 1024, 'a'), 1);
+  tracker_b.send_data().data_buffer().Add(0, std::string(8 * 1024, 'b'), 1);
+
+  trackers_mgr_.EnforceBufferMemoryBudget();
+
+  EXPECT_LT(tracker_a.BufferMemUsage(), 1024);
+  EXPECT_GE(tracker_b.BufferMemUsage(), 8 * 1024);
+  EXPECT_THAT(trackers_mgr_.StatsString(), HasSubstr("kMemPressureEvents=1"));
+
+  // Under budget: nothing further is reclaimed.
+  trackers_mgr_.EnforceBufferMemoryBudget();
+  EXPECT_GE(tracker_b.BufferMemUsage(), 8 * 1024);
+  EXPECT_THAT(trackers_mgr_.StatsString(), HasSubstr("kMemPressureEvents=1"));
+}
+
 class ConnTrackerGenerationsTest : public ::testing::Test {
  protected:
   ConnTrackerGenerationsTest() : tracker_pool(1024) {
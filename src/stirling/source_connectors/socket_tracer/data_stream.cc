@@ -113,8 +113,8 @@ void DataStream::ProcessBytesToFrames(message_type_t type, TStateType* state) {
     size_t contiguous_bytes = data_buffer_.Head().size();
 
     // Now parse the raw data.
-    parse_result =
-        protocols::ParseFrames(type, &data_buffer_, &typed_messages, IsSyncRequired(), state);
+    parse_result = protocols::ParseFrames(type, &data_buffer_, &typed_messages, IsSyncRequired(),
+                                          state, &GetFramePool<TFrameType>());
     if (contiguous_bytes != data_buffer_.size()) {
       // We weren't able to submit all bytes, which means we ran into a missing event.
       // We don't expect missing events to arrive in the future, so just cut our losses.
@@ -168,7 +168,7 @@ void DataStream::ProcessBytesToFrames(message_type_t type, TStateType* state) {
   ssize_t num_bytes_advanced = data_buffer_.position() - last_processed_pos_;
   if (num_bytes_advanced > 0 && static_cast<size_t>(num_bytes_advanced) > frame_bytes) {
     size_t bytes_lost = num_bytes_advanced - frame_bytes;
-    SocketTracerMetrics::GetProtocolMetrics(protocol_).data_loss_bytes.Increment(bytes_lost);
+    SocketTracerMetrics::RecordDataLossBytes(protocol_, bytes_lost);
   }
   last_processed_pos_ = data_buffer_.position();
 
@@ -192,8 +192,8 @@ template void DataStream::ProcessBytesToFrames<protocols::cass::Frame, protocols
 template void
 DataStream::ProcessBytesToFrames<protocols::pgsql::RegularMessage, protocols::pgsql::StateWrapper>(
     message_type_t type, protocols::pgsql::StateWrapper* state);
-template void DataStream::ProcessBytesToFrames<protocols::dns::Frame, protocols::NoState>(
-    message_type_t type, protocols::NoState* state);
+template void DataStream::ProcessBytesToFrames<protocols::dns::Frame, protocols::dns::StateWrapper>(
+    message_type_t type, protocols::dns::StateWrapper* state);
 template void DataStream::ProcessBytesToFrames<protocols::redis::Message, protocols::NoState>(
     message_type_t type, protocols::NoState* state);
 template void
@@ -209,6 +209,7 @@ void DataStream::Reset() {
   UpdateLastProgressTime();
 
   frames_ = std::monostate();
+  frame_pool_ = std::monostate();
 }
 
 }  // namespace stirling
@@ -104,6 +104,20 @@ class DataStream : NotCopyMoveable {
     return std::get<std::deque<TFrameType>>(frames_);
   }
 
+  /**
+   * Returns the pool of dead frames for this stream, so that buffers of frames that have been
+   * parsed and discarded can be reused by new frames.
+   * @tparam TFrameType The parsed frame type within the pool.
+   * @return pool of frames.
+   */
+  template <typename TFrameType>
+  protocols::FramePool<TFrameType>& GetFramePool() {
+    if (std::holds_alternative<std::monostate>(frame_pool_)) {
+      frame_pool_ = protocols::FramePool<TFrameType>();
+    }
+    return std::get<protocols::FramePool<TFrameType>>(frame_pool_);
+  }
+
   template <typename TFrameType>
   const std::deque<TFrameType>& Frames() const {
     DCHECK(std::holds_alternative<std::deque<TFrameType>>(frames_)) << absl::Substitute(
@@ -220,9 +234,9 @@ class DataStream : NotCopyMoveable {
     if (size > size_limit_bytes) {
       VLOG(1) << absl::Substitute("Messages cleared due to size limit ($0 > $1).", size,
                                   size_limit_bytes);
-      Frames<TFrameType>().clear();
+      GetFramePool<TFrameType>().RecycleAll(&Frames<TFrameType>());
     }
-    EraseExpiredFrames(expiry_timestamp, &Frames<TFrameType>());
+    EraseExpiredFrames(expiry_timestamp, &GetFramePool<TFrameType>(), &Frames<TFrameType>());
   }
 
   /**
@@ -255,7 +269,7 @@ class DataStream : NotCopyMoveable {
   template <typename TFrameType>
   static void EraseExpiredFrames(
       std::chrono::time_point<std::chrono::steady_clock> expiry_timestamp,
-      std::deque<TFrameType>* frames) {
+      protocols::FramePool<TFrameType>* frame_pool, std::deque<TFrameType>* frames) {
     auto iter = frames->begin();
     for (; iter != frames->end(); ++iter) {
       auto frame_timestamp = std::chrono::time_point<std::chrono::steady_clock>(
@@ -267,6 +281,9 @@ class DataStream : NotCopyMoveable {
         break;
       }
     }
+    for (auto it = frames->begin(); it != iter; ++it) {
+      frame_pool->Recycle(std::move(*it));
+    }
     frames->erase(frames->begin(), iter);
   }
 
@@ -285,6 +302,10 @@ class DataStream : NotCopyMoveable {
   // bug, so we add std::monostate as the default type. And switch to the right time in runtime.
   protocols::FrameDequeVariant frames_;
 
+  // Pool of dead frames of the same type as frames_, used to recycle the frames' heap
+  // allocations across ParseFrames() cycles.
+  protocols::FramePoolVariant frame_pool_;
+
   // The following state keeps track of whether the raw events were touched or not since the last
   // call to ProcessBytesToFrames(). It enables ProcessToRecords() to exit early if nothing has
   // changed.
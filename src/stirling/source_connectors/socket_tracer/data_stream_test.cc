@@ -56,6 +56,12 @@ class DataStreamTest : public ::testing::Test {
     return testing::NanosToTimePoint(mock_clock_.now());
   }
 
+  // Data loss is recorded in a sharded counter and only published to prometheus on sync.
+  static int64_t DataLossBytes(traffic_protocol_t protocol) {
+    SocketTracerMetrics::SyncProtocolMetrics();
+    return SocketTracerMetrics::GetProtocolMetrics(protocol).data_loss_bytes.Value();
+  }
+
   testing::MockClock mock_clock_;
   testing::EventGenerator event_gen_;
 };
@@ -94,8 +100,7 @@ TEST_F(DataStreamTest, LostEvent) {
   stream.ProcessBytesToFrames<http::Message>(message_type_t::kRequest, &state);
   EXPECT_THAT(stream.Frames<http::Message>(), SizeIs(4));
 
-  EXPECT_EQ(req1->msg.size() + req4->msg.size(),
-            SocketTracerMetrics::GetProtocolMetrics(kProtocolHTTP).data_loss_bytes.Value());
+  EXPECT_EQ(req1->msg.size() + req4->msg.size(), DataLossBytes(kProtocolHTTP));
 }
 
 TEST_F(DataStreamTest, StuckTemporarily) {
@@ -126,7 +131,7 @@ TEST_F(DataStreamTest, StuckTemporarily) {
   EXPECT_EQ(requests[1].req_path, "/foo.html");
   EXPECT_EQ(requests[2].req_path, "/bar.html");
 
-  EXPECT_EQ(0, SocketTracerMetrics::GetProtocolMetrics(kProtocolHTTP).data_loss_bytes.Value());
+  EXPECT_EQ(0, DataLossBytes(kProtocolHTTP));
 }
 
 TEST_F(DataStreamTest, StuckTooLong) {
@@ -160,8 +165,7 @@ TEST_F(DataStreamTest, StuckTooLong) {
   EXPECT_EQ(requests[0].req_path, "/foo.html");
   EXPECT_EQ(requests[1].req_path, "/bar.html");
 
-  EXPECT_EQ(kHTTPReq0.length(),
-            SocketTracerMetrics::GetProtocolMetrics(kProtocolHTTP).data_loss_bytes.Value());
+  EXPECT_EQ(kHTTPReq0.length(), DataLossBytes(kProtocolHTTP));
 }
 
 TEST_F(DataStreamTest, PartialMessageRecovery) {
@@ -186,8 +190,7 @@ TEST_F(DataStreamTest, PartialMessageRecovery) {
   EXPECT_EQ(requests[0].req_path, "/index.html");
   EXPECT_EQ(requests[1].req_path, "/bar.html");
 
-  EXPECT_EQ(kHTTPReq1.length(),
-            SocketTracerMetrics::GetProtocolMetrics(kProtocolHTTP).data_loss_bytes.Value());
+  EXPECT_EQ(kHTTPReq1.length(), DataLossBytes(kProtocolHTTP));
 }
 
 TEST_F(DataStreamTest, HeadAndMiddleMissing) {
@@ -220,8 +223,7 @@ TEST_F(DataStreamTest, HeadAndMiddleMissing) {
   ASSERT_THAT(requests, SizeIs(1));
   EXPECT_EQ(requests[0].req_path, "/bar.html");
 
-  EXPECT_EQ(req0b_size + kHTTPReq1.length(),
-            SocketTracerMetrics::GetProtocolMetrics(kProtocolHTTP).data_loss_bytes.Value());
+  EXPECT_EQ(req0b_size + kHTTPReq1.length(), DataLossBytes(kProtocolHTTP));
 }
 
 TEST_F(DataStreamTest, LateArrivalPlusMissingEvents) {
@@ -277,8 +279,7 @@ TEST_F(DataStreamTest, LateArrivalPlusMissingEvents) {
   EXPECT_EQ(requests[1].req_path, "/index.html");
   EXPECT_EQ(requests[2].req_path, "/foo.html");
 
-  EXPECT_EQ(kHTTPReq0.length() + kHTTPReq2.length(),
-            SocketTracerMetrics::GetProtocolMetrics(kProtocolHTTP).data_loss_bytes.Value());
+  EXPECT_EQ(kHTTPReq0.length() + kHTTPReq2.length(), DataLossBytes(kProtocolHTTP));
 }
 
 // This test checks that various stats updated on each call ProcessBytesToFrames()
@@ -421,8 +422,7 @@ TEST_F(DataStreamTest, SpikeCapacityWithLargeDataChunk) {
 
   // Run ProcessBytesToFrames again to propagate data loss stats.
   stream.ProcessBytesToFrames<http::Message>(message_type_t::kResponse, &state);
-  EXPECT_EQ(kHTTPIncompleteResp.length() - retention_capacity_bytes,
-            SocketTracerMetrics::GetProtocolMetrics(kProtocolHTTP).data_loss_bytes.Value());
+  EXPECT_EQ(kHTTPIncompleteResp.length() - retention_capacity_bytes, DataLossBytes(kProtocolHTTP));
 }
 
 TEST_F(DataStreamTest, ResyncCausesDuplicateEventBug) {
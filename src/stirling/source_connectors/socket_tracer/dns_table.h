@@ -51,6 +51,11 @@ static constexpr DataElement kDNSElements[] = {
          types::DataType::STRING,
          types::SemanticType::ST_NONE,
          types::PatternType::GENERAL},
+        {"count", "Number of identical request-response pairs represented by this record "
+                  "within one sampling window",
+         types::DataType::INT64,
+         types::SemanticType::ST_NONE,
+         types::PatternType::METRIC_GAUGE},
         canonical_data_elements::kLatencyNS,
 #ifndef NDEBUG
         canonical_data_elements::kPXInfo,
@@ -67,6 +72,7 @@ static constexpr int kDNSReqHdrIdx = kDNSTable.ColIndex("req_header");
 static constexpr int kDNSReqBodyIdx = kDNSTable.ColIndex("req_body");
 static constexpr int kDNSRespHdrIdx = kDNSTable.ColIndex("resp_header");
 static constexpr int kDNSRespBodyIdx = kDNSTable.ColIndex("resp_body");
+static constexpr int kDNSCountIdx = kDNSTable.ColIndex("count");
 
 }  // namespace stirling
 }  // namespace px
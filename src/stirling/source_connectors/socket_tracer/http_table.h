@@ -97,6 +97,11 @@ constexpr DataElement kHTTPElements[] = {
          types::DataType::INT64,
          types::SemanticType::ST_BYTES,
          types::PatternType::METRIC_GAUGE},
+        {"trace_id", "Distributed tracing trace ID propagated in the request headers "
+         "(traceparent or B3), or empty if absent",
+         types::DataType::STRING,
+         types::SemanticType::ST_NONE,
+         types::PatternType::STRUCTURED},
         canonical_data_elements::kLatencyNS,
 #ifndef NDEBUG
         canonical_data_elements::kPXInfo,
@@ -126,6 +131,7 @@ constexpr int kHTTPRespStatusIdx = kHTTPTable.ColIndex("resp_status");
 constexpr int kHTTPRespMessageIdx = kHTTPTable.ColIndex("resp_message");
 constexpr int kHTTPRespBodyIdx = kHTTPTable.ColIndex("resp_body");
 constexpr int kHTTPRespBodySizeIdx = kHTTPTable.ColIndex("resp_body_size");
+constexpr int kHTTPTraceIDIdx = kHTTPTable.ColIndex("trace_id");
 constexpr int kHTTPLatencyIdx = kHTTPTable.ColIndex("latency");
 
 }  // namespace stirling
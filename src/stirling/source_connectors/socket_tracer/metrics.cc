@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -49,6 +50,11 @@ void ResetProtocolMetrics(traffic_protocol_t protocol) {
   g_protocol_metrics.insert_or_assign(
       protocol, std::make_unique<SocketTracerMetrics>(&GetMetricsRegistry(), protocol));
 }
+
+// Per-event counts land here; SyncProtocolMetrics() publishes the deltas into the prometheus
+// counters. This keeps the transfer threads off the (unsynchronized) g_protocol_metrics map.
+utils::ShardedStatCounter<traffic_protocol_t> g_data_loss_bytes;
+std::array<int64_t, magic_enum::enum_count<traffic_protocol_t>()> g_synced_data_loss_bytes = {};
 }  // namespace
 
 SocketTracerMetrics& SocketTracerMetrics::GetProtocolMetrics(traffic_protocol_t protocol) {
@@ -58,7 +64,25 @@ SocketTracerMetrics& SocketTracerMetrics::GetProtocolMetrics(traffic_protocol_t
   return *g_protocol_metrics[protocol];
 }
 
+void SocketTracerMetrics::RecordDataLossBytes(traffic_protocol_t protocol, int64_t bytes) {
+  g_data_loss_bytes.Increment(protocol, bytes);
+}
+
+void SocketTracerMetrics::SyncProtocolMetrics() {
+  for (auto protocol : magic_enum::enum_values<traffic_protocol_t>()) {
+    int64_t total = g_data_loss_bytes.Get(protocol);
+    int64_t delta = total - g_synced_data_loss_bytes[static_cast<int>(protocol)];
+    if (delta <= 0) {
+      continue;
+    }
+    GetProtocolMetrics(protocol).data_loss_bytes.Increment(delta);
+    g_synced_data_loss_bytes[static_cast<int>(protocol)] = total;
+  }
+}
+
 void SocketTracerMetrics::TestOnlyResetProtocolMetrics(traffic_protocol_t protocol) {
+  g_data_loss_bytes.Reset(protocol);
+  g_synced_data_loss_bytes[static_cast<int>(protocol)] = 0;
   ResetProtocolMetrics(protocol);
 }
 
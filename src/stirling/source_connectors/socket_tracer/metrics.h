@@ -23,6 +23,7 @@
 
 #include "src/common/metrics/metrics.h"
 #include "src/stirling/source_connectors/socket_tracer/bcc_bpf_intf/common.h"
+#include "src/stirling/utils/sharded_stat_counter.h"
 
 namespace px {
 namespace stirling {
@@ -34,6 +35,14 @@ struct SocketTracerMetrics {
 
   static SocketTracerMetrics& GetProtocolMetrics(traffic_protocol_t protocol);
 
+  // Per-event hot path: records lost bytes in a sharded counter without touching the
+  // prometheus registry. Safe to call concurrently from the transfer threads.
+  static void RecordDataLossBytes(traffic_protocol_t protocol, int64_t bytes);
+
+  // Publishes the sharded counters into the prometheus counters. Called from the socket
+  // tracer's periodic stats reporting; concurrent increments may land in the next sync.
+  static void SyncProtocolMetrics();
+
   static void TestOnlyResetProtocolMetrics(traffic_protocol_t protocol);
 };
 
@@ -30,6 +30,7 @@
 
 #include "src/common/base/base.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/amqp/types_gen.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/frame_scanner.h"
 #include "src/stirling/utils/binary_decoder.h"
 
 namespace px {
@@ -47,22 +48,33 @@ namespace amqp {
 // +------+---------+-------------+  +------------+  +-----------+
 //  octet   short         long         size octets       octet
 
-// The first octet can be used to quickly determine if the message boundary starts
-size_t FindFrameBoundary(std::string_view buf, size_t start_pos) {
-  // LOG(DEBUG) << "IN AMQP find frame boundary";
-  if (buf.size() < kMinFrameLength) {
-    return std::string::npos;
-  }
+namespace {
 
-  for (; start_pos < buf.size(); ++start_pos) {
-    const AMQPFrameTypes type_marker = static_cast<AMQPFrameTypes>(buf[start_pos]);
-    if (type_marker == AMQPFrameTypes::kFrameHeader || type_marker == AMQPFrameTypes::kFrameBody ||
-        type_marker == AMQPFrameTypes::kFrameMethod ||
-        type_marker == AMQPFrameTypes::kFrameHeartbeat) {
-      return start_pos;
-    }
-  }
-  return std::string_view::npos;
+bool IsValidFrameTypeMarker(uint8_t marker) {
+  const AMQPFrameTypes type_marker = static_cast<AMQPFrameTypes>(marker);
+  return type_marker == AMQPFrameTypes::kFrameHeader || type_marker == AMQPFrameTypes::kFrameBody ||
+         type_marker == AMQPFrameTypes::kFrameMethod ||
+         type_marker == AMQPFrameTypes::kFrameHeartbeat;
+}
+
+// The first octet can be used to quickly determine if the message boundary starts.
+struct AMQPFrameScanner : public LengthPrefixedFrameScanner<AMQPFrameScanner> {
+  static constexpr size_t kMinFrameLength = ::px::stirling::protocols::amqp::kMinFrameLength;
+  static constexpr FrameHeaderDescriptor kFrameHeader = {
+      .header_length = 7,
+      .length_field_offset = 3,
+      .length_field_size = 4,
+      .length_includes_header = false,
+      .trailer_length = 1,  // The frame-end octet.
+  };
+
+  static bool IsFrameStart(std::string_view buf) { return IsValidFrameTypeMarker(buf[0]); }
+};
+
+}  // namespace
+
+size_t FindFrameBoundary(std::string_view buf, size_t start_pos) {
+  return AMQPFrameScanner::FindFrameBoundary(buf, start_pos);
 }
 
 // Parse the message's type, channel
@@ -75,10 +87,7 @@ ParseState ParseFrame(message_type_t type, std::string_view* buf, Frame* packet)
 
   PL_ASSIGN_OR_RETURN_INVALID(uint8_t frame_type, decoder.ExtractInt<uint8_t>());
   AMQPFrameTypes frame_type_header = static_cast<AMQPFrameTypes>(frame_type);
-  if (!(frame_type_header == AMQPFrameTypes::kFrameHeader ||
-        frame_type_header == AMQPFrameTypes::kFrameBody ||
-        frame_type_header == AMQPFrameTypes::kFrameMethod ||
-        frame_type_header == AMQPFrameTypes::kFrameHeartbeat)) {
+  if (!IsValidFrameTypeMarker(frame_type)) {
     return ParseState::kInvalid;
   }
 
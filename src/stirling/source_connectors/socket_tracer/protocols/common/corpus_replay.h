@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/event_parser.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/interface.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+/**
+ * Helpers for corpus-driven parser benchmarks (see the corpus_replay_benchmark targets under the
+ * per-protocol directories): replay a curated request/response byte corpus through the full
+ * ParseFramesLoop + StitchFrames pipeline, and return the counts a benchmark needs to report
+ * MB/s and records/s. Deliberately free of any benchmark library dependency so it can live
+ * alongside the parser interfaces.
+ */
+struct CorpusReplayResult {
+  ParseState req_parse_state = ParseState::kInvalid;
+  ParseState resp_parse_state = ParseState::kInvalid;
+  size_t frames_parsed = 0;
+  size_t records_stitched = 0;
+  int stitch_error_count = 0;
+};
+
+/**
+ * Assigns strictly interleaved timestamps (req0 < resp0 < req1 < resp1 < ...) to the parsed
+ * frames. ParseFramesLoop does not populate timestamps (in production they come from the data
+ * stream buffer), while the stitchers match on timestamp order. This suits protocols where
+ * every request produces exactly one response frame.
+ */
+template <typename TFrameType>
+void AssignInterleavedTimestamps(std::deque<TFrameType>* reqs, std::deque<TFrameType>* resps) {
+  uint64_t ts = 1;
+  auto req_iter = reqs->begin();
+  auto resp_iter = resps->begin();
+  while (req_iter != reqs->end() || resp_iter != resps->end()) {
+    if (req_iter != reqs->end()) {
+      (req_iter++)->timestamp_ns = ts++;
+    }
+    if (resp_iter != resps->end()) {
+      (resp_iter++)->timestamp_ns = ts++;
+    }
+  }
+}
+
+/**
+ * Replays one request/response corpus through ParseFramesLoop in both directions, then
+ * StitchFrames. assign_timestamps is invoked with (&reqs, &resps) between parsing and
+ * stitching; protocols with multi-frame responses (e.g. MySQL resultsets) need a custom
+ * assignment, others can pass AssignInterleavedTimestamps<TFrameType>.
+ */
+template <typename TRecordType, typename TFrameType, typename TStateType, typename TTimestampFn>
+CorpusReplayResult ReplayCorpus(std::string_view req_buf, std::string_view resp_buf,
+                                TStateType* state, const TTimestampFn& assign_timestamps) {
+  std::deque<TFrameType> reqs;
+  std::deque<TFrameType> resps;
+  CorpusReplayResult result;
+  result.req_parse_state =
+      ParseFramesLoop(message_type_t::kRequest, req_buf, &reqs, state).state;
+  result.resp_parse_state =
+      ParseFramesLoop(message_type_t::kResponse, resp_buf, &resps, state).state;
+  result.frames_parsed = reqs.size() + resps.size();
+
+  assign_timestamps(&reqs, &resps);
+
+  RecordsWithErrorCount<TRecordType> records =
+      StitchFrames<TRecordType, TFrameType, TStateType>(&reqs, &resps, state);
+  result.records_stitched = records.records.size();
+  result.stitch_error_count = records.error_count;
+  return result;
+}
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -180,6 +180,39 @@ TEST_P(DataStreamBufferTest, TimestampWithGap) {
   EXPECT_OK_AND_EQ(stream_buffer.GetTimestamp(13), 10);
 }
 
+// Exercises the single-event fast path of the lazy implementation, where the event's buffer is
+// adopted as the head without a copy. Run against both implementations to pin down the shared
+// semantics.
+TEST_P(DataStreamBufferTest, SingleEventHead) {
+  DataStreamBuffer stream_buffer(15, 15, 15);
+
+  // A lone event becomes the head as-is.
+  stream_buffer.Add(0, "0123", 0);
+  EXPECT_EQ(stream_buffer.Head(), "0123");
+  EXPECT_EQ(stream_buffer.position(), 0);
+  EXPECT_OK_AND_EQ(stream_buffer.GetTimestamp(0), 0);
+  EXPECT_OK_AND_EQ(stream_buffer.GetTimestamp(3), 0);
+
+  // RemovePrefix on the adopted head behaves as usual.
+  stream_buffer.RemovePrefix(2);
+  EXPECT_EQ(stream_buffer.Head(), "23");
+  EXPECT_EQ(stream_buffer.position(), 2);
+
+  // A contiguous event merges with the leftover adopted head.
+  stream_buffer.Add(4, "4567", 4);
+  EXPECT_EQ(stream_buffer.Head(), "234567");
+  EXPECT_OK_AND_EQ(stream_buffer.GetTimestamp(2), 0);
+  EXPECT_OK_AND_EQ(stream_buffer.GetTimestamp(4), 4);
+
+  // After consuming the head entirely, a lone event with a gap becomes the new head.
+  stream_buffer.RemovePrefix(6);
+  stream_buffer.Add(10, "abcd", 10);
+  stream_buffer.Trim();
+  EXPECT_EQ(stream_buffer.Head(), "abcd");
+  EXPECT_EQ(stream_buffer.position(), 10);
+  EXPECT_OK_AND_EQ(stream_buffer.GetTimestamp(10), 10);
+}
+
 TEST_P(DataStreamBufferTest, SizeAndGetPos) {
   DataStreamBuffer stream_buffer(15, 15, 15);
 
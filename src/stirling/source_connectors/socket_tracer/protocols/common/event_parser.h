@@ -31,6 +31,7 @@
 #include "src/stirling/source_connectors/socket_tracer/bcc_bpf_intf/common.h"
 #include "src/stirling/source_connectors/socket_tracer/bcc_bpf_intf/socket_trace.hpp"
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/data_stream_buffer.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/frame_pool.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/interface.h"
 #include "src/stirling/utils/parse_state.h"
 #include "src/stirling/utils/utils.h"
@@ -93,13 +94,16 @@ struct ParseResult {
  * @param frames The container to which newly parsed frames are added.
  * @param resync If set to true, Parse will first search for the next frame boundary (even
  * if it is currently at a valid frame boundary).
+ * @param frame_pool If provided, new frames are drawn from the pool so that buffers of
+ * previously recycled frames are reused.
  *
  * @return ParseResult with locations where parseable frames were found in the source buffer.
  */
 template <typename TFrameType, typename TStateType = NoState>
 ParseResult ParseFrames(message_type_t type, DataStreamBuffer* data_stream_buffer,
                         std::deque<TFrameType>* frames, bool resync = false,
-                        TStateType* state = nullptr) {
+                        TStateType* state = nullptr,
+                        FramePool<TFrameType>* frame_pool = nullptr) {
   std::string_view buf = data_stream_buffer->Head();
 
   size_t start_pos = 0;
@@ -124,7 +128,7 @@ ParseResult ParseFrames(message_type_t type, DataStreamBuffer* data_stream_buffe
   const size_t prev_size = frames->size();
 
   // Parse and append new frames to the frames vector.
-  ParseResult result = ParseFramesLoop(type, buf, frames, state);
+  ParseResult result = ParseFramesLoop(type, buf, frames, state, frame_pool);
 
   VLOG(1) << absl::Substitute("Parsed $0 new frames", frames->size() - prev_size);
 
@@ -161,7 +165,8 @@ ParseResult ParseFrames(message_type_t type, DataStreamBuffer* data_stream_buffe
 // TODO(oazizi): Convert tests to use ParseFrames() instead of ParseFramesLoop().
 template <typename TFrameType, typename TStateType = NoState>
 ParseResult ParseFramesLoop(message_type_t type, std::string_view buf,
-                            std::deque<TFrameType>* frames, TStateType* state = nullptr) {
+                            std::deque<TFrameType>* frames, TStateType* state = nullptr,
+                            FramePool<TFrameType>* frame_pool = nullptr) {
   std::vector<StartEndPos> frame_positions;
   const size_t buf_size = buf.size();
   ParseState s = ParseState::kSuccess;
@@ -170,7 +175,7 @@ ParseResult ParseFramesLoop(message_type_t type, std::string_view buf,
   int invalid_count = 0;
 
   while (!buf.empty() && s != ParseState::kEOS) {
-    TFrameType frame;
+    TFrameType frame = (frame_pool == nullptr) ? TFrameType() : frame_pool->Pop();
 
     s = ParseFrame(type, &buf, &frame, state);
 
@@ -212,6 +217,9 @@ ParseResult ParseFramesLoop(message_type_t type, std::string_view buf,
     }
 
     if (stop) {
+      if (frame_pool != nullptr) {
+        frame_pool->Recycle(std::move(frame));
+      }
       break;
     }
 
@@ -223,6 +231,9 @@ ParseResult ParseFramesLoop(message_type_t type, std::string_view buf,
       frame_positions.push_back({start_position, end_position});
       frame_bytes += (end_position - start_position) + 1;
       frames->push_back(std::move(frame));
+    } else if (frame_pool != nullptr) {
+      // The frame was not recorded, so return its buffers to the pool for reuse.
+      frame_pool->Recycle(std::move(frame));
     }
   }
   return ParseResult{std::move(frame_positions), bytes_processed, s, invalid_count, frame_bytes};
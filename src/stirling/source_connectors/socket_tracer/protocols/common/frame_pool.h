@@ -0,0 +1,108 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <deque>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+// Detects whether TFrameType has a Reset() member function.
+// Frame types opt into buffer reuse by providing Reset(), which must restore the frame to its
+// default-constructed state while retaining the capacity of any heap-allocated members.
+template <typename TFrameType, typename = void>
+struct has_frame_reset : std::false_type {};
+
+template <typename TFrameType>
+struct has_frame_reset<TFrameType, std::void_t<decltype(std::declval<TFrameType&>().Reset())>>
+    : std::true_type {};
+
+/**
+ * FramePool holds dead protocol frames so their heap allocations (e.g. the body string of an
+ * http::Message) can be reused by subsequently parsed frames, instead of being released and
+ * reallocated on every ParseFrames() cycle.
+ *
+ * Unlike ObjPool (src/stirling/utils/obj_pool.h), which destroys the pooled object and
+ * placement-news a fresh one, FramePool keeps the recycled frames alive so that the capacity of
+ * their internal buffers is preserved. This requires the frame type to provide a Reset() member
+ * function; for frame types without Reset(), Pop() and Recycle() degenerate into plain
+ * construction and destruction, so the pool can be instantiated for any frame type.
+ */
+template <typename TFrameType>
+class FramePool {
+ public:
+  // Frames can hold large bodies, so keep the per-stream pool small. The steady-state parse rate
+  // per stream between two TransferData() iterations rarely exceeds this.
+  static constexpr size_t kDefaultCapacity = 32;
+
+  explicit FramePool(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+  /**
+   * Returns either a recycled frame (already reset to its default state) or a
+   * default-constructed one.
+   */
+  TFrameType Pop() {
+    if constexpr (has_frame_reset<TFrameType>::value) {
+      if (!pool_.empty()) {
+        TFrameType frame = std::move(pool_.back());
+        pool_.pop_back();
+        return frame;
+      }
+    }
+    return TFrameType();
+  }
+
+  /**
+   * Submits a dead frame for recycling. The frame is reset immediately, so pooled frames hold on
+   * to their buffer capacity but not to stale content.
+   */
+  void Recycle(TFrameType&& frame) {
+    if constexpr (has_frame_reset<TFrameType>::value) {
+      if (pool_.size() >= capacity_) {
+        return;
+      }
+      frame.Reset();
+      pool_.push_back(std::move(frame));
+    }
+  }
+
+  /**
+   * Recycles all frames in the container, and clears it.
+   */
+  void RecycleAll(std::deque<TFrameType>* frames) {
+    for (auto& frame : *frames) {
+      Recycle(std::move(frame));
+    }
+    frames->clear();
+  }
+
+  size_t size() const { return pool_.size(); }
+
+ private:
+  size_t capacity_;
+  std::vector<TFrameType> pool_;
+};
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
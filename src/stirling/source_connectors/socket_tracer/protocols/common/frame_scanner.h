@@ -0,0 +1,108 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+/**
+ * FrameScanner is a CRTP helper that unifies frame-boundary scanning across protocol parsers.
+ *
+ * The scan operates directly on the contiguous view handed out by the data stream buffer, so no
+ * payload bytes are copied while searching for a boundary. The derived class provides:
+ *
+ *   static constexpr size_t kMinFrameLength;             // Minimum bytes for a parseable frame.
+ *   static bool IsFrameStart(std::string_view buf);      // Whether buf starts with a frame.
+ *
+ * IsFrameStart() is called with at least kMinFrameLength bytes remaining, so it may inspect the
+ * frame header without bounds checks.
+ */
+template <typename TDerived>
+class FrameScanner {
+ public:
+  /**
+   * Returns the position of the first potential frame start at or after start_pos,
+   * or npos if no such position exists.
+   */
+  static size_t FindFrameBoundary(std::string_view buf, size_t start_pos) {
+    if (buf.size() < TDerived::kMinFrameLength) {
+      return std::string_view::npos;
+    }
+    for (size_t i = start_pos; i + TDerived::kMinFrameLength <= buf.size(); ++i) {
+      if (TDerived::IsFrameStart(buf.substr(i))) {
+        return i;
+      }
+    }
+    return std::string_view::npos;
+  }
+};
+
+/**
+ * Describes the fixed-size header of a length-prefixed binary frame.
+ * The length field is assumed to be big-endian, per network byte order.
+ */
+struct FrameHeaderDescriptor {
+  // Size of the fixed frame header, in bytes.
+  size_t header_length;
+  // Offset of the length field within the header.
+  size_t length_field_offset;
+  // Size of the length field, in bytes.
+  size_t length_field_size;
+  // Whether the value of the length field includes the header itself.
+  bool length_includes_header;
+  // Size of any fixed trailer after the payload (e.g. AMQP's frame-end octet).
+  size_t trailer_length;
+};
+
+/**
+ * A FrameScanner for protocols whose frames carry an explicit payload length in a fixed-size
+ * header. In addition to the FrameScanner requirements, the derived class provides:
+ *
+ *   static constexpr FrameHeaderDescriptor kFrameHeader;
+ */
+template <typename TDerived>
+class LengthPrefixedFrameScanner : public FrameScanner<TDerived> {
+ public:
+  /**
+   * Returns the total on-wire size of the frame at the head of buf (header + payload + trailer),
+   * computed from the header's length field. Returns 0 if the header is incomplete.
+   */
+  static size_t ComputeFrameLength(std::string_view buf) {
+    constexpr FrameHeaderDescriptor d = TDerived::kFrameHeader;
+    if (buf.size() < d.header_length) {
+      return 0;
+    }
+    constexpr int kLengthFieldSize = static_cast<int>(d.length_field_size);
+    uint64_t length = ::px::utils::BEndianBytesToInt<uint64_t, kLengthFieldSize>(
+        buf.substr(d.length_field_offset));
+    if (!d.length_includes_header) {
+      length += d.header_length;
+    }
+    return length + d.trailer_length;
+  }
+};
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
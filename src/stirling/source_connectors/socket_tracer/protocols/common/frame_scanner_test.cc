@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/frame_scanner.h"
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+// A toy protocol: 1-byte magic 'M', 2-byte big-endian payload length, payload, 1-byte trailer.
+struct TestFrameScanner : public LengthPrefixedFrameScanner<TestFrameScanner> {
+  static constexpr size_t kMinFrameLength = 4;
+  static constexpr FrameHeaderDescriptor kFrameHeader = {
+      .header_length = 3,
+      .length_field_offset = 1,
+      .length_field_size = 2,
+      .length_includes_header = false,
+      .trailer_length = 1,
+  };
+
+  static bool IsFrameStart(std::string_view buf) { return buf[0] == 'M'; }
+};
+
+TEST(FrameScannerTest, FindFrameBoundary) {
+  EXPECT_EQ(TestFrameScanner::FindFrameBoundary(CreateStringView<char>("M\x00\x01xy"), 0), 0);
+  EXPECT_EQ(TestFrameScanner::FindFrameBoundary(CreateStringView<char>("..M\x00\x01xy"), 0), 2);
+  EXPECT_EQ(TestFrameScanner::FindFrameBoundary(CreateStringView<char>("..M\x00\x01xy"), 3),
+            std::string_view::npos);
+  EXPECT_EQ(TestFrameScanner::FindFrameBoundary("......", 0), std::string_view::npos);
+
+  // No boundary is reported if fewer than kMinFrameLength bytes remain.
+  EXPECT_EQ(TestFrameScanner::FindFrameBoundary("..M", 0), std::string_view::npos);
+}
+
+TEST(FrameScannerTest, ComputeFrameLength) {
+  // Header (3) + payload (2) + trailer (1).
+  EXPECT_EQ(TestFrameScanner::ComputeFrameLength(CreateStringView<char>("M\x00\x02")), 6);
+
+  // The length is computed from the header alone, even if the payload has not arrived yet.
+  EXPECT_EQ(TestFrameScanner::ComputeFrameLength(CreateStringView<char>("M\x01\x00")), 260);
+
+  // An incomplete header yields 0.
+  EXPECT_EQ(TestFrameScanner::ComputeFrameLength("M"), 0);
+}
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -33,7 +33,18 @@ FixedSizeContiguousBuffer::FixedSizeContiguousBuffer(size_t capacity)
   DCHECK_GT(capacity, 0);
 }
 
+FixedSizeContiguousBuffer::FixedSizeContiguousBuffer(std::string data)
+    : storage_(std::move(data)),
+      data_(reinterpret_cast<uint8_t*>(storage_.data())),
+      capacity_(storage_.size()) {
+  DCHECK_GT(capacity_, 0);
+}
+
 FixedSizeContiguousBuffer::~FixedSizeContiguousBuffer() {
+  if (!storage_.empty()) {
+    // `data_` points into `storage_`, which owns the memory.
+    return;
+  }
   if (capacity_ == 0) {
     return;
   }
@@ -122,6 +133,25 @@ bool LazyContiguousDataStreamBufferImpl::IsHeadAndEventsMergeable() const {
 }
 
 void LazyContiguousDataStreamBufferImpl::MergeContiguousEventsIntoHead() {
+  // Fast path: if there is no leftover data in head_ from a previous polling iteration, and the
+  // contiguous run at the front of events_ is a single event, adopt that event's buffer as the new
+  // head_ instead of copying it. This eliminates the copy for the common case of a request or
+  // response that arrives as a single event (including large bodies up to the perf buffer chunk
+  // size).
+  if (head_ == nullptr) {
+    auto first_it = events_.begin();
+    size_t first_event_size = first_it->second.data.size();
+    auto second_it = std::next(first_it);
+    if (second_it == events_.end() || second_it->first != first_it->first + first_event_size) {
+      head_position_ = first_it->first;
+      head_pos_to_ts_.emplace(first_it->first, first_it->second.timestamp);
+      head_ = std::make_unique<FixedSizeContiguousBuffer>(std::move(first_it->second.data));
+      events_size_ -= first_event_size;
+      events_.erase(first_it);
+      return;
+    }
+  }
+
   size_t new_buffer_size = 0;
   size_t buffer_end_pos = FirstEventPos();
   size_t new_head_position = FirstEventPos();
@@ -43,6 +43,9 @@ class FixedSizeContiguousBuffer : public NotCopyable {
   ~FixedSizeContiguousBuffer();
   // Passing capacity == 0 is undefined behaviour.
   explicit FixedSizeContiguousBuffer(size_t capacity);
+  // Adopts `data` as the underlying buffer, without copying the bytes.
+  // Passing an empty string is undefined behaviour.
+  explicit FixedSizeContiguousBuffer(std::string data);
   std::string_view StringView();
   // Invalidate first n bytes of data
   void RemovePrefix(size_t n);
@@ -51,6 +54,9 @@ class FixedSizeContiguousBuffer : public NotCopyable {
   size_t Capacity() const;
 
  private:
+  // Backing store when constructed by adopting a string. Empty when the buffer was allocated by the
+  // capacity constructor, in which case `data_` owns the allocation.
+  std::string storage_;
   uint8_t* data_;
   size_t capacity_;
   size_t offset_ = 0;
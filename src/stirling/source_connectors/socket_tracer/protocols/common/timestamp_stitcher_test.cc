@@ -18,6 +18,8 @@
 
 #include <gtest/gtest.h>
 
+#include <absl/strings/str_cat.h>
+
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/timestamp_stitcher.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/types.h"
 
@@ -185,6 +187,51 @@ TEST_F(TimestampStitcherTest, MissingOneReqFollowedByOneResp) {
   EXPECT_EQ(records.records.size(), 99);
 }
 
+TEST_F(TimestampStitcherTest, ManyInFlightRequestsMatchLatest) {
+  std::deque<Message> req_messages;
+  std::deque<Message> resp_messages;
+
+  // A large run of requests, all older than the single response.
+  // Only the latest request should be matched; the others are clobbered.
+  for (int i = 0; i < 1000; ++i) {
+    Message req = HTTPReq0Message();
+    req.body = absl::StrCat("req", i);
+    req.timestamp_ns = i + 1;
+    req_messages.push_back(req);
+  }
+  Message resp = HTTPResp0Message();
+  resp.timestamp_ns = 2000;
+  resp_messages.push_back(resp);
+
+  auto records = StitchMessagesWithTimestampOrder<Record>(&req_messages, &resp_messages);
+  ASSERT_EQ(records.records.size(), 1);
+  EXPECT_EQ(records.records[0].req.body, "req999");
+
+  // All requests older than the response are consumed.
+  EXPECT_TRUE(req_messages.empty());
+  EXPECT_TRUE(resp_messages.empty());
+}
+
+TEST_F(TimestampStitcherTest, RespWithoutOlderReqIsIgnored) {
+  std::deque<Message> req_messages;
+  std::deque<Message> resp_messages;
+
+  Message resp = HTTPResp0Message();
+  resp.timestamp_ns = 1;
+  resp_messages.push_back(resp);
+
+  Message req = HTTPReq0Message();
+  req.timestamp_ns = 2;
+  req_messages.push_back(req);
+
+  auto records = StitchMessagesWithTimestampOrder<Record>(&req_messages, &resp_messages);
+  EXPECT_EQ(records.records.size(), 0);
+
+  // The unmatched request remains for the next cycle; the response is discarded.
+  EXPECT_EQ(req_messages.size(), 1);
+  EXPECT_TRUE(resp_messages.empty());
+}
+
 }  // namespace protocols
 }  // namespace stirling
 }  // namespace px
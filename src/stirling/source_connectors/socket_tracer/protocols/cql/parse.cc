@@ -18,14 +18,13 @@
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/cql/parse.h"
 
-#include <arpa/inet.h>
 #include <deque>
 #include <string_view>
 #include <utility>
 
-#include "src/common/base/byte_utils.h"
 #include "src/common/base/types.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/cql/types.h"
+#include "src/stirling/utils/binary_decoder.h"
 #include "src/stirling/utils/parse_state.h"
 
 // TODO(oazizi): Consider splitting this file into public and private pieces. The public one would
@@ -42,21 +41,30 @@ namespace cass {
 ParseState ParseFrame(message_type_t type, std::string_view* buf, Frame* result) {
   DCHECK(type == message_type_t::kRequest || type == message_type_t::kResponse);
 
-  if (buf->size() < kFrameHeaderLength) {
+  // Frame header layout: version, flags, stream, opcode, length. The length is validated
+  // once here, so the individual field extractions below need no bounds checks.
+  static_assert(
+      BinaryDecoder::LayoutSize<uint8_t, uint8_t, uint16_t, uint8_t, int32_t>() ==
+      kFrameHeaderLength);
+  BinaryDecoder decoder(*buf);
+  auto header_or = decoder.ExtractFixedLayout<uint8_t, uint8_t, uint16_t, uint8_t, int32_t>();
+  if (!header_or.ok()) {
     return ParseState::kNeedsMoreData;
   }
+  UncheckedBinaryDecoder header = header_or.ConsumeValueOrDie();
 
-  std::optional<Opcode> opcode = magic_enum::enum_cast<Opcode>((*buf)[4]);
+  const uint8_t version_byte = header.ExtractBEInt<uint8_t>();
+  bool is_resp = version_byte & kDirectionMask;
+  result->hdr.version = version_byte & kVersionMask;
+  result->hdr.flags = header.ExtractBEInt<uint8_t>();
+  result->hdr.stream = header.ExtractBEInt<uint16_t>();
+
+  std::optional<Opcode> opcode = magic_enum::enum_cast<Opcode>(header.ExtractChar());
   if (!opcode) {
     return ParseState::kInvalid;
   }
-
-  bool is_resp = static_cast<uint8_t>((*buf)[0]) & kDirectionMask;
-  result->hdr.version = static_cast<uint8_t>((*buf)[0]) & kVersionMask;
-  result->hdr.flags = static_cast<uint8_t>((*buf)[1]);
-  result->hdr.stream = ntohs(utils::LEndianBytesToInt<uint16_t>(buf->substr(2, 2)));
   result->hdr.opcode = static_cast<Opcode>(opcode.value());
-  result->hdr.length = ntohl(utils::LEndianBytesToInt<int32_t>(buf->substr(5, 4)));
+  result->hdr.length = header.ExtractBEInt<int32_t>();
 
   if (is_resp != IsRespOpcode(result->hdr.opcode)) {
     return ParseState::kInvalid;
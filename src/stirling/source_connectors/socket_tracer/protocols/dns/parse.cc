@@ -51,9 +51,44 @@ class PxDnsParserListener : public DnsParserListener {
   std::vector<DNSRecord> records_;
 };
 
-ParseState ParseFrame(message_type_t type, std::string_view* buf, Frame* result) {
+// Bounds on the per-connection decoded-packet cache. Only packets up to the classic UDP
+// message limit are cached: they cover the repeated-query traffic that matters on resolver
+// nodes, and they bound the per-entry key size.
+constexpr size_t kMaxCacheablePacketSize = 512;
+constexpr size_t kMaxDecodedPacketCacheEntries = 1024;
+
+namespace {
+
+// Returns the packet bytes with the txid (first two bytes) masked out, for use as a cache key.
+// Repeated queries for the same name differ only in their txid, so masking it makes them
+// cache-equal while preserving the full compression layout in the key.
+std::string TxidMaskedPacket(std::string_view buf) {
+  std::string key(buf);
+  key[kTXIDOffset] = 0;
+  key[kTXIDOffset + 1] = 0;
+  return key;
+}
+
+}  // namespace
+
+ParseState ParseFrame(message_type_t type, std::string_view* buf, Frame* result, State* state) {
   PL_UNUSED(type);
 
+  std::string cache_key;
+  if (state != nullptr && buf->size() > sizeof(DNSHeader) &&
+      buf->size() <= kMaxCacheablePacketSize) {
+    cache_key = TxidMaskedPacket(*buf);
+    auto it = state->decoded_packets.find(cache_key);
+    if (it != state->decoded_packets.end()) {
+      ++state->cache_hits;
+      result->header = it->second.header;
+      result->header.txid = utils::BEndianBytesToInt<uint16_t>(buf->substr(kTXIDOffset, 2));
+      result->AddRecords(std::vector<DNSRecord>(it->second.records));
+      buf->remove_prefix(buf->length());
+      return ParseState::kSuccess;
+    }
+  }
+
   PxDnsParserListener response_handler;
   std::unique_ptr<DnsParser> parser = DnsParserNew(&response_handler);
   int retval = parser->parse(buf->data(), buf->length());
@@ -78,6 +113,17 @@ ParseState ParseFrame(message_type_t type, std::string_view* buf, Frame* result)
   DCHECK_NE(result->header.num_auth, 0xffff);
   DCHECK_NE(result->header.num_addl, 0xffff);
 
+  if (!cache_key.empty()) {
+    ++state->cache_misses;
+    // A full cache is simply dropped; tracking recency isn't worth it for this workload, since
+    // a steady-state resolver's working set is far smaller than the cache bound.
+    if (state->decoded_packets.size() >= kMaxDecodedPacketCacheEntries) {
+      state->decoded_packets.clear();
+    }
+    state->decoded_packets.emplace(
+        std::move(cache_key), DecodedPacket{result->header, response_handler.records_});
+  }
+
   result->AddRecords(std::move(response_handler.records_));
   buf->remove_prefix(buf->length());
 
@@ -87,13 +133,13 @@ ParseState ParseFrame(message_type_t type, std::string_view* buf, Frame* result)
 
 template <>
 ParseState ParseFrame(message_type_t type, std::string_view* buf, dns::Frame* result,
-                      NoState* /*state*/) {
-  return dns::ParseFrame(type, buf, result);
+                      dns::StateWrapper* state) {
+  return dns::ParseFrame(type, buf, result, state == nullptr ? nullptr : &state->global);
 }
 
 template <>
 size_t FindFrameBoundary<dns::Frame>(message_type_t /*type*/, std::string_view /*buf*/,
-                                     size_t /*start_pos*/, NoState* /*state*/) {
+                                     size_t /*start_pos*/, dns::StateWrapper* /*state*/) {
   // Not implemented.
   // Search for magic string that we should insert between UDP packets.
   return std::string::npos;
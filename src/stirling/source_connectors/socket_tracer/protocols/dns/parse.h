@@ -34,11 +34,11 @@ namespace protocols {
  */
 template <>
 ParseState ParseFrame(message_type_t type, std::string_view* buf, dns::Frame* frame,
-                      NoState* state);
+                      dns::StateWrapper* state);
 
 template <>
 size_t FindFrameBoundary<dns::Frame>(message_type_t type, std::string_view buf, size_t start_pos,
-                                     NoState* state);
+                                     dns::StateWrapper* state);
 
 }  // namespace protocols
 }  // namespace stirling
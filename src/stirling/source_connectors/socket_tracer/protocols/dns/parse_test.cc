@@ -251,7 +251,9 @@ TEST_F(DNSParserTest, BasicReq) {
   auto frame_view = CreateStringView<char>(CharArrayStringView<uint8_t>(kQueryFrame));
 
   std::deque<Frame> frames;
-  ParseResult parse_result = ParseFramesLoop(message_type_t::kRequest, frame_view, &frames);
+  StateWrapper state;
+  ParseResult parse_result =
+      ParseFramesLoop(message_type_t::kRequest, frame_view, &frames, &state);
 
   ASSERT_EQ(parse_result.state, ParseState::kSuccess);
   ASSERT_EQ(frames.size(), 1);
@@ -268,11 +270,48 @@ TEST_F(DNSParserTest, BasicReq) {
   EXPECT_EQ(frames[0].records()[0].addr.AddrStr(), "0.0.0.0");
 }
 
+TEST_F(DNSParserTest, DecodedPacketCache) {
+  StateWrapper state;
+
+  // First parse populates the per-connection cache.
+  {
+    auto frame_view = CreateStringView<char>(CharArrayStringView<uint8_t>(kQueryFrame));
+    std::deque<Frame> frames;
+    ParseResult parse_result =
+        ParseFramesLoop(message_type_t::kRequest, frame_view, &frames, &state);
+    ASSERT_EQ(parse_result.state, ParseState::kSuccess);
+  }
+  EXPECT_EQ(state.global.cache_hits, 0);
+  EXPECT_EQ(state.global.cache_misses, 1);
+
+  // A repeat of the same query with a different txid is served from the cache, and carries the
+  // live packet's txid.
+  std::vector<uint8_t> repeat(kQueryFrame, kQueryFrame + sizeof(kQueryFrame));
+  repeat[0] = 0x12;
+  repeat[1] = 0x34;
+  std::string_view frame_view(reinterpret_cast<const char*>(repeat.data()), repeat.size());
+
+  std::deque<Frame> frames;
+  ParseResult parse_result =
+      ParseFramesLoop(message_type_t::kRequest, frame_view, &frames, &state);
+
+  ASSERT_EQ(parse_result.state, ParseState::kSuccess);
+  EXPECT_EQ(state.global.cache_hits, 1);
+  EXPECT_EQ(state.global.cache_misses, 1);
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].header.txid, 0x1234);
+  EXPECT_EQ(frames[0].header.flags, 0x0100);
+  ASSERT_EQ(frames[0].records().size(), 1);
+  EXPECT_EQ(frames[0].records()[0].name, "intellij-experiments.appspot.com");
+}
+
 TEST_F(DNSParserTest, BasicResp) {
   auto frame_view = CreateStringView<char>(CharArrayStringView<uint8_t>(kRespFrame));
 
   std::deque<Frame> frames;
-  ParseResult parse_result = ParseFramesLoop(message_type_t::kResponse, frame_view, &frames);
+  StateWrapper state;
+  ParseResult parse_result =
+      ParseFramesLoop(message_type_t::kResponse, frame_view, &frames, &state);
 
   ASSERT_EQ(parse_result.state, ParseState::kSuccess);
   ASSERT_EQ(frames.size(), 1);
@@ -293,7 +332,9 @@ TEST_F(DNSParserTest, BasicReq2) {
   auto frame_view = CreateStringView<char>(CharArrayStringView<uint8_t>(kReqFrame2));
 
   std::deque<Frame> frames;
-  ParseResult parse_result = ParseFramesLoop(message_type_t::kResponse, frame_view, &frames);
+  StateWrapper state;
+  ParseResult parse_result =
+      ParseFramesLoop(message_type_t::kResponse, frame_view, &frames, &state);
 
   ASSERT_EQ(parse_result.state, ParseState::kSuccess);
   ASSERT_EQ(frames.size(), 1);
@@ -314,7 +355,9 @@ TEST_F(DNSParserTest, CNameAndMultipleResponses) {
   auto frame_view = CreateStringView<char>(CharArrayStringView<uint8_t>(kRespFrame2));
 
   std::deque<Frame> frames;
-  ParseResult parse_result = ParseFramesLoop(message_type_t::kResponse, frame_view, &frames);
+  StateWrapper state;
+  ParseResult parse_result =
+      ParseFramesLoop(message_type_t::kResponse, frame_view, &frames, &state);
 
   ASSERT_EQ(parse_result.state, ParseState::kSuccess);
   ASSERT_EQ(frames.size(), 1);
@@ -356,7 +399,9 @@ TEST_F(DNSParserTest, CNameAndMultipleResponses2) {
   auto frame_view = CreateStringView<char>(CharArrayStringView<uint8_t>(kRespFrame3));
 
   std::deque<Frame> frames;
-  ParseResult parse_result = ParseFramesLoop(message_type_t::kResponse, frame_view, &frames);
+  StateWrapper state;
+  ParseResult parse_result =
+      ParseFramesLoop(message_type_t::kResponse, frame_view, &frames, &state);
 
   ASSERT_EQ(parse_result.state, ParseState::kSuccess);
   ASSERT_EQ(frames.size(), 1);
@@ -399,7 +444,9 @@ TEST_F(DNSParserTest, IncompleteHeader) {
   auto frame_view = CreateStringView<char>(CharArrayStringView<uint8_t>(kIncompleteHeader));
 
   std::deque<Frame> frames;
-  ParseResult parse_result = ParseFramesLoop(message_type_t::kRequest, frame_view, &frames);
+  StateWrapper state;
+  ParseResult parse_result =
+      ParseFramesLoop(message_type_t::kRequest, frame_view, &frames, &state);
 
   ASSERT_EQ(parse_result.state, ParseState::kInvalid);
 }
@@ -412,7 +459,9 @@ TEST_F(DNSParserTest, PartialRecords) {
     frame_view.remove_suffix(10);
 
     std::deque<Frame> frames;
-    ParseResult parse_result = ParseFramesLoop(message_type_t::kRequest, frame_view, &frames);
+    StateWrapper state;
+    ParseResult parse_result =
+        ParseFramesLoop(message_type_t::kRequest, frame_view, &frames, &state);
 
     ASSERT_EQ(parse_result.state, ParseState::kSuccess);
   }
@@ -422,7 +471,9 @@ TEST_F(DNSParserTest, PartialRecords) {
     frame_view.remove_suffix(20);
 
     std::deque<Frame> frames;
-    ParseResult parse_result = ParseFramesLoop(message_type_t::kRequest, frame_view, &frames);
+    StateWrapper state;
+    ParseResult parse_result =
+        ParseFramesLoop(message_type_t::kRequest, frame_view, &frames, &state);
 
     ASSERT_EQ(parse_result.state, ParseState::kInvalid);
   }
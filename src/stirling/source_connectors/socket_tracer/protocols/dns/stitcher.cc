@@ -25,10 +25,17 @@
 #include <deque>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
 
 #include "src/common/base/base.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/dns/types.h"
 
+DEFINE_bool(stirling_dns_record_aggregation, true,
+            "If true, identical DNS request-response pairs stitched within one transfer window "
+            "are collapsed into a single dns_events record with a count.");
+
 namespace px {
 namespace stirling {
 namespace protocols {
@@ -237,6 +244,28 @@ RecordsWithErrorCount<Record> StitchFrames(std::deque<Frame>* req_frames,
 
   resp_frames->clear();
 
+  // On resolver nodes the same (name, type) pairs repeat heavily within a push window. Collapse
+  // identical query/answer pairs into one record carrying a count, keeping the most recent
+  // pair's headers and timestamps so the emitted time and latency reflect a real pairing.
+  if (FLAGS_stirling_dns_record_aggregation && entries.size() > 1) {
+    std::vector<Record> deduped;
+    deduped.reserve(entries.size());
+    absl::flat_hash_map<std::string, size_t> dedup_idx;
+    for (auto& entry : entries) {
+      // The record separator makes the concatenated key unambiguous.
+      std::string key = absl::StrCat(entry.req.query, "\x1e", entry.resp.msg);
+      auto [it, inserted] = dedup_idx.try_emplace(std::move(key), deduped.size());
+      if (inserted) {
+        deduped.push_back(std::move(entry));
+      } else {
+        int64_t count = deduped[it->second].count + entry.count;
+        deduped[it->second] = std::move(entry);
+        deduped[it->second].count = count;
+      }
+    }
+    entries = std::move(deduped);
+  }
+
   return {entries, error_count};
 }
 
@@ -46,7 +46,7 @@ RecordsWithErrorCount<Record> StitchFrames(std::deque<Frame>* req_packets,
 template <>
 inline RecordsWithErrorCount<dns::Record> StitchFrames(std::deque<dns::Frame>* req_packets,
                                                        std::deque<dns::Frame>* resp_packets,
-                                                       NoState* /* state */) {
+                                                       dns::StateWrapper* /* state */) {
   return dns::StitchFrames(req_packets, resp_packets);
 }
 
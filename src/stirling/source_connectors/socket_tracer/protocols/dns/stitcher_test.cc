@@ -24,6 +24,8 @@
 #include "src/common/base/inet_utils.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/dns/stitcher.h"
 
+DECLARE_bool(stirling_dns_record_aggregation);
+
 using ::testing::HasSubstr;
 using ::testing::IsEmpty;
 
@@ -111,6 +113,64 @@ TEST(DnsStitcherTest, RecordOutput) {
   EXPECT_EQ(record.resp.msg, R"({"answers":[{"name":"pixie.ai","type":"A","addr":"1.2.3.4"}]})");
 }
 
+TEST(DnsStitcherTest, RecordAggregation) {
+  std::deque<Frame> req_frames;
+  std::deque<Frame> resp_frames;
+  RecordsWithErrorCount<Record> result;
+
+  InetAddr ip_addr;
+  ip_addr.family = InetAddrFamily::kIPv4;
+  struct in_addr addr_tmp;
+  PL_CHECK_OK(ParseIPv4Addr("1.2.3.4", &addr_tmp));
+  ip_addr.addr = addr_tmp;
+
+  std::vector<DNSRecord> pixie_records = {DNSRecord{"pixie.ai", "", ip_addr}};
+  std::vector<DNSRecord> px_records = {DNSRecord{"px.dev", "", ip_addr}};
+
+  // Two identical pairs (differing only in txid and timestamps), plus one distinct pair.
+  int t = 0;
+  req_frames.push_back(CreateReqFrame(++t, 0));
+  resp_frames.push_back(CreateRespFrame(++t, 0, pixie_records));
+  req_frames.push_back(CreateReqFrame(++t, 1));
+  resp_frames.push_back(CreateRespFrame(++t, 1, pixie_records));
+  req_frames.push_back(CreateReqFrame(++t, 2));
+  resp_frames.push_back(CreateRespFrame(++t, 2, px_records));
+
+  result = StitchFrames(&req_frames, &resp_frames);
+  EXPECT_EQ(result.error_count, 0);
+  ASSERT_EQ(result.records.size(), 2);
+
+  // The repeated pair is collapsed into one record carrying the most recent pair's timestamps.
+  Record& aggregated = result.records[0];
+  EXPECT_EQ(aggregated.count, 2);
+  EXPECT_THAT(std::string(aggregated.resp.msg), HasSubstr("pixie.ai"));
+  EXPECT_EQ(aggregated.req.timestamp_ns, 3);
+  EXPECT_EQ(aggregated.resp.timestamp_ns, 4);
+
+  EXPECT_EQ(result.records[1].count, 1);
+  EXPECT_THAT(std::string(result.records[1].resp.msg), HasSubstr("px.dev"));
+}
+
+TEST(DnsStitcherTest, RecordAggregationDisabled) {
+  FLAGS_stirling_dns_record_aggregation = false;
+
+  std::deque<Frame> req_frames;
+  std::deque<Frame> resp_frames;
+  RecordsWithErrorCount<Record> result;
+
+  int t = 0;
+  req_frames.push_back(CreateReqFrame(++t, 0));
+  resp_frames.push_back(CreateRespFrame(++t, 0, std::vector<DNSRecord>()));
+  req_frames.push_back(CreateReqFrame(++t, 1));
+  resp_frames.push_back(CreateRespFrame(++t, 1, std::vector<DNSRecord>()));
+
+  result = StitchFrames(&req_frames, &resp_frames);
+  EXPECT_EQ(result.error_count, 0);
+  EXPECT_EQ(result.records.size(), 2);
+
+  FLAGS_stirling_dns_record_aggregation = true;
+}
+
 TEST(DnsStitcherTest, OutOfOrderMatching) {
   std::deque<Frame> req_frames;
   std::deque<Frame> resp_frames;
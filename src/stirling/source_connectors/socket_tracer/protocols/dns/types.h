@@ -22,8 +22,10 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
 #include <magic_enum.hpp>
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/event_parser.h"  // For FrameBase.
@@ -112,6 +114,34 @@ struct Frame : public FrameBase {
   size_t records_size_ = 0;
 };
 
+//-----------------------------------------------------------------------------
+// State
+//-----------------------------------------------------------------------------
+
+// One decoded DNS packet, cached by its txid-masked bytes.
+struct DecodedPacket {
+  // The txid field is not meaningful here; the live packet's txid is read directly.
+  DNSHeader header;
+  std::vector<DNSRecord> records;
+};
+
+struct State {
+  // Cache of decoded packets, keyed by the packet bytes with the txid masked out. High-QPS
+  // resolvers see the same question (and often the same answer) packets over and over, with
+  // identical compression layout and differing only in txid; a hit skips name decompression
+  // entirely. Bounded in parse.cc; cleared by the connection tracker on buffer cleanup.
+  absl::flat_hash_map<std::string, DecodedPacket> decoded_packets;
+
+  uint64_t cache_hits = 0;
+  uint64_t cache_misses = 0;
+};
+
+struct StateWrapper {
+  State global;
+  std::monostate send;
+  std::monostate recv;
+};
+
 //-----------------------------------------------------------------------------
 // Table Store Entry Level Structs
 //-----------------------------------------------------------------------------
@@ -153,15 +183,20 @@ struct Record {
   Request req;
   Response resp;
 
+  // Number of identical request-response pairs this record represents. The stitcher collapses
+  // repeated pairs within one transfer window into a single record (see
+  // --stirling_dns_record_aggregation), so this is usually 1 but can be large on resolver nodes.
+  int64_t count = 1;
+
   std::string ToString() const {
-    return absl::Substitute("req=[$0] resp=[$1]", req.ToString(), resp.ToString());
+    return absl::Substitute("req=[$0] resp=[$1] count=$2", req.ToString(), resp.ToString(), count);
   }
 };
 
 struct ProtocolTraits : public BaseProtocolTraits<Record> {
   using frame_type = Frame;
   using record_type = Record;
-  using state_type = NoState;
+  using state_type = StateWrapper;
 };
 
 }  // namespace dns
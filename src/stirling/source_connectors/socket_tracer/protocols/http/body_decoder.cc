@@ -246,7 +246,8 @@ ParseState ParseChunked(std::string_view* data, size_t body_size_limit_bytes, st
 }
 
 ParseState ParseContent(std::string_view content_len_str, std::string_view* data,
-                        size_t body_size_limit_bytes, std::string* result, size_t* body_size) {
+                        size_t body_size_limit_bytes, std::string* result, size_t* body_size,
+                        size_t* body_bytes_to_skip) {
   size_t len;
   if (!absl::SimpleAtoi(content_len_str, &len)) {
     LOG(ERROR) << absl::Substitute("Unable to parse Content-Length: $0", content_len_str);
@@ -254,6 +255,16 @@ ParseState ParseContent(std::string_view content_len_str, std::string_view* data
   }
 
   if (data->size() < len) {
+    // The full body has not arrived yet. If the portion of the body that will be retained is
+    // already available, emit the message now instead of buffering a multi-MB body that would be
+    // truncated anyway. The remainder is discarded by the caller as it streams in.
+    if (body_bytes_to_skip != nullptr && data->size() >= body_size_limit_bytes) {
+      *result = data->substr(0, body_size_limit_bytes);
+      *body_size = len;
+      *body_bytes_to_skip = len - data->size();
+      data->remove_prefix(data->size());
+      return ParseState::kSuccess;
+    }
     return ParseState::kNeedsMoreData;
   }
 
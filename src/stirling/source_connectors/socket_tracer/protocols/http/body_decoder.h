@@ -50,12 +50,16 @@ ParseState ParseChunked(std::string_view* buf, size_t body_size_limit_bytes, std
  * @param data View into the data buffer contained the body. If parsing succeeds, the corresponding
  * bytes are consumed; otherwise the string_view bytes are not modified.
  * @param result  Result where the body is placed upon success.
+ * @param body_bytes_to_skip If non-null, enables streaming bodies: once the retained body prefix
+ * (body_size_limit_bytes) is available, the message is emitted without waiting for the full body,
+ * and the number of outstanding body bytes to discard from the stream is written here.
  * @return ParseState::kInvalid if content length cannot be parsed.
  *         ParseState::kNeedsMoreData if the message is incomplete.
  *         ParseState::kSuccess if the entire body is present and well-formed.
  */
 ParseState ParseContent(std::string_view content_len_str, std::string_view* data,
-                        size_t body_size_limit_bytes, std::string* result, size_t* body_size);
+                        size_t body_size_limit_bytes, std::string* result, size_t* body_size,
+                        size_t* body_bytes_to_skip = nullptr);
 
 }  // namespace http
 }  // namespace protocols
@@ -86,7 +86,7 @@ HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t num_headers) {
 
 }  // namespace pico_wrapper
 
-ParseState ParseRequestBody(std::string_view* buf, Message* result) {
+ParseState ParseRequestBody(std::string_view* buf, Message* result, size_t* body_bytes_to_skip) {
   // From https://tools.ietf.org/html/rfc7230:
   //  A sender MUST NOT send a Content-Length header field in any message
   //  that contains a Transfer-Encoding header field.
@@ -105,7 +105,7 @@ ParseState ParseRequestBody(std::string_view* buf, Message* result) {
   if (content_length_iter != result->headers.end()) {
     std::string_view content_len_str = content_length_iter->second;
     auto r = ParseContent(content_len_str, buf, FLAGS_http_body_limit_bytes, &result->body,
-                          &result->body_size);
+                          &result->body_size, body_bytes_to_skip);
     DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
     return r;
   }
@@ -130,7 +130,8 @@ ParseState ParseRequestBody(std::string_view* buf, Message* result) {
   return ParseState::kSuccess;
 }
 
-ParseState ParseResponseBody(std::string_view* buf, Message* result, State* state) {
+ParseState ParseResponseBody(std::string_view* buf, Message* result, State* state,
+                             size_t* body_bytes_to_skip) {
   // Case 0: Check for a HEAD response with no body.
   // Responses to HEAD requests are special, because they may include Content-Length
   // or Transfer-Encoding, but the body will still be empty.
@@ -155,7 +156,7 @@ ParseState ParseResponseBody(std::string_view* buf, Message* result, State* stat
   if (content_length_iter != result->headers.end()) {
     std::string_view content_len_str = content_length_iter->second;
     auto s = ParseContent(content_len_str, buf, FLAGS_http_body_limit_bytes, &result->body,
-                          &result->body_size);
+                          &result->body_size, body_bytes_to_skip);
     DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
     return s;
   }
@@ -199,6 +200,7 @@ ParseState ParseResponseBody(std::string_view* buf, Message* result, State* stat
   // perf buffer, so that we can terminate such messages.
   if (state->conn_closed) {
     result->body = *buf;
+    result->body_size = buf->size();
     buf->remove_prefix(buf->size());
 
     LOG_FIRST_N(WARNING, 10)
@@ -210,7 +212,7 @@ ParseState ParseResponseBody(std::string_view* buf, Message* result, State* stat
   return ParseState::kNeedsMoreData;
 }
 
-ParseState ParseRequest(std::string_view* buf, Message* result) {
+ParseState ParseRequest(std::string_view* buf, Message* result, size_t* body_bytes_to_skip) {
   pico_wrapper::HTTPRequest req;
   int retval = pico_wrapper::ParseRequest(*buf, &req);
 
@@ -224,7 +226,7 @@ ParseState ParseRequest(std::string_view* buf, Message* result) {
     result->req_path = std::string(req.path, req.path_len);
     result->headers_byte_size = retval;
 
-    return ParseRequestBody(buf, result);
+    return ParseRequestBody(buf, result, body_bytes_to_skip);
   }
   if (retval == -2) {
     return ParseState::kNeedsMoreData;
@@ -232,7 +234,8 @@ ParseState ParseRequest(std::string_view* buf, Message* result) {
   return ParseState::kInvalid;
 }
 
-ParseState ParseResponse(std::string_view* buf, Message* result, State* state) {
+ParseState ParseResponse(std::string_view* buf, Message* result, State* state,
+                         size_t* body_bytes_to_skip) {
   pico_wrapper::HTTPResponse resp;
   int retval = pico_wrapper::ParseResponse(*buf, &resp);
 
@@ -246,7 +249,7 @@ ParseState ParseResponse(std::string_view* buf, Message* result, State* state) {
     result->resp_message = std::string(resp.msg, resp.msg_len);
     result->headers_byte_size = retval;
 
-    return ParseResponseBody(buf, result, state);
+    return ParseResponseBody(buf, result, state, body_bytes_to_skip);
   }
   if (retval == -2) {
     return ParseState::kNeedsMoreData;
@@ -265,11 +268,27 @@ ParseState ParseResponse(std::string_view* buf, Message* result, State* state) {
  * @return parse state indicating how the parse progressed.
  */
 ParseState ParseFrame(message_type_t type, std::string_view* buf, Message* result, State* state) {
+  // Select the skip counter for the direction being parsed.
+  size_t* body_bytes_to_skip = nullptr;
+  if (state != nullptr) {
+    body_bytes_to_skip = (type == message_type_t::kRequest) ? &state->req_body_bytes_to_skip
+                                                            : &state->resp_body_bytes_to_skip;
+  }
+
+  // Discard the unretained remainder of a streaming body emitted earlier, without buffering it.
+  // kIgnored consumes the bytes from the stream without producing a frame.
+  if (body_bytes_to_skip != nullptr && *body_bytes_to_skip > 0) {
+    size_t skip = std::min(*body_bytes_to_skip, buf->size());
+    buf->remove_prefix(skip);
+    *body_bytes_to_skip -= skip;
+    return ParseState::kIgnored;
+  }
+
   switch (type) {
     case message_type_t::kRequest:
-      return ParseRequest(buf, result);
+      return ParseRequest(buf, result, body_bytes_to_skip);
     case message_type_t::kResponse:
-      return ParseResponse(buf, result, state);
+      return ParseResponse(buf, result, state, body_bytes_to_skip);
     default:
       return ParseState::kInvalid;
   }
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <deque>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "src/common/base/base.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/parse.h"
+
+using px::stirling::ParseState;
+using px::stirling::protocols::ParseFramesLoop;
+using px::stirling::protocols::ParseResult;
+using px::stirling::protocols::http::Message;
+using px::stirling::protocols::http::StateWrapper;
+
+namespace {
+
+std::string HTTPRespWithSizedBody(const std::string& body) {
+  return absl::StrCat(
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: application/json; charset=utf-8\r\n"
+      "Content-Length: ",
+      body.size(),
+      "\r\n"
+      "\r\n",
+      body);
+}
+
+std::string HTTPRespWithChunkedBody(const std::string& body) {
+  return absl::StrCat(
+      "HTTP/1.1 200 OK\r\n"
+      "Transfer-Encoding: chunked\r\n"
+      "\r\n",
+      absl::Hex(body.size()), "\r\n", body, "\r\n0\r\n\r\n");
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_HTTPParseSizedBodyResponses(benchmark::State& state) {
+  const int num_messages = 256;
+  const std::string body(state.range(0), 'x');
+  std::string buf;
+  for (int i = 0; i < num_messages; ++i) {
+    absl::StrAppend(&buf, HTTPRespWithSizedBody(body));
+  }
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    StateWrapper parse_state{};
+    std::deque<Message> parsed_messages;
+    ParseResult result =
+        ParseFramesLoop(message_type_t::kResponse, buf, &parsed_messages, &parse_state);
+    CHECK(result.state == ParseState::kSuccess);
+    CHECK_EQ(static_cast<int>(parsed_messages.size()), num_messages);
+    benchmark::DoNotOptimize(parsed_messages);
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+  state.SetItemsProcessed(state.iterations() * num_messages);
+}
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_HTTPParseChunkedBodyResponses(benchmark::State& state) {
+  const int num_messages = 256;
+  const std::string body(state.range(0), 'x');
+  std::string buf;
+  for (int i = 0; i < num_messages; ++i) {
+    absl::StrAppend(&buf, HTTPRespWithChunkedBody(body));
+  }
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    StateWrapper parse_state{};
+    std::deque<Message> parsed_messages;
+    ParseResult result =
+        ParseFramesLoop(message_type_t::kResponse, buf, &parsed_messages, &parse_state);
+    CHECK(result.state == ParseState::kSuccess);
+    CHECK_EQ(static_cast<int>(parsed_messages.size()), num_messages);
+    benchmark::DoNotOptimize(parsed_messages);
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+  state.SetItemsProcessed(state.iterations() * num_messages);
+}
+
+BENCHMARK(BM_HTTPParseSizedBodyResponses)->RangeMultiplier(8)->Range(64, 1 << 15);
+BENCHMARK(BM_HTTPParseChunkedBodyResponses)->RangeMultiplier(8)->Range(64, 1 << 15);
@@ -552,6 +552,44 @@ TEST_F(HTTPParserTest, LongContentLengthBodyTruncated) {
   EXPECT_THAT(parsed_messages, ElementsAre(expected_message));
 }
 
+// A body larger than the size limit does not require full buffering: once the retained body
+// prefix is available, the message is emitted, and the remainder of the body is skipped as it
+// streams in.
+TEST_F(HTTPParserTest, StreamingLargeContentLengthBody) {
+  StateWrapper state{};
+
+  std::string headers =
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Length: 1000\r\n"
+      "\r\n";
+  std::string body(1000, 'x');
+  std::string msg2 = HTTPRespWithSizedBody("pixielabs");
+
+  // First part: headers plus 300 body bytes. This exceeds the 256 byte body limit, so the
+  // message should be emitted without waiting for the full body.
+  std::string part1 = absl::StrCat(headers, body.substr(0, 300));
+
+  std::deque<Message> parsed_messages;
+  ParseResult result1 = ParseFramesLoop(message_type_t::kResponse, part1, &parsed_messages, &state);
+
+  EXPECT_EQ(ParseState::kSuccess, result1.state);
+  EXPECT_EQ(part1.size(), result1.end_position);
+  ASSERT_EQ(1, parsed_messages.size());
+  EXPECT_EQ(std::string(256, 'x'), parsed_messages[0].body);
+  EXPECT_EQ(1000, parsed_messages[0].body_size);
+
+  // Second part: the remaining 700 body bytes are skipped without being buffered, and the
+  // following message parses normally.
+  std::string part2 = absl::StrCat(body.substr(300), msg2);
+
+  parsed_messages.clear();
+  ParseResult result2 = ParseFramesLoop(message_type_t::kResponse, part2, &parsed_messages, &state);
+
+  EXPECT_EQ(ParseState::kSuccess, result2.state);
+  EXPECT_EQ(part2.size(), result2.end_position);
+  EXPECT_THAT(parsed_messages, ElementsAre(HasBody("pixielabs")));
+}
+
 TEST_F(HTTPParserTest, ParseIncompleteChunks) {
   StateWrapper state{};
   std::string msg1 =
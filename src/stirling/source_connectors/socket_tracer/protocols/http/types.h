@@ -45,6 +45,10 @@ inline constexpr char kContentLength[] = "Content-Length";
 inline constexpr char kContentType[] = "Content-Type";
 inline constexpr char kTransferEncoding[] = "Transfer-Encoding";
 inline constexpr char kUpgrade[] = "Upgrade";
+// Distributed-tracing context propagation headers (W3C trace context and Zipkin B3).
+inline constexpr char kTraceparent[] = "traceparent";
+inline constexpr char kB3[] = "b3";
+inline constexpr char kB3TraceID[] = "X-B3-TraceId";
 
 struct Message : public FrameBase {
   message_type_t type = message_type_t::kUnknown;
@@ -69,6 +73,22 @@ struct Message : public FrameBase {
     return sizeof(Message) + headers_byte_size + body.size() + resp_message.size();
   }
 
+  // Restores the message to its default-constructed state, but retains the capacity of the
+  // string members so that a FramePool can reuse their allocations.
+  void Reset() {
+    type = message_type_t::kUnknown;
+    minor_version = -1;
+    headers.clear();
+    req_method.assign("-");
+    req_path.assign("-");
+    resp_status = -1;
+    resp_message.assign("-");
+    body.assign("-");
+    body_size = 0;
+    headers_byte_size = 0;
+    timestamp_ns = 0;
+  }
+
   std::string ToString() const override {
     return absl::Substitute(
         "[type=$0 minor_version=$1 headers=[$2] req_method=$3 "
@@ -102,6 +122,14 @@ struct Record {
 
 struct State {
   bool conn_closed = false;
+
+  // Number of remaining body bytes to discard from the head of the stream, per direction
+  // (kRequest parses the send stream, kResponse parses the recv stream).
+  // Set when a message with a large Content-Length body is emitted before its full body has
+  // arrived: only the retained body prefix is copied into the message, and the remainder is
+  // skipped as it streams in, without ever being buffered.
+  size_t req_body_bytes_to_skip = 0;
+  size_t resp_body_bytes_to_skip = 0;
 };
 
 struct StateWrapper {
@@ -25,6 +25,38 @@ namespace stirling {
 namespace protocols {
 namespace http {
 
+std::string_view TraceIDFromTraceparent(std::string_view value) {
+  size_t first_dash = value.find('-');
+  if (first_dash == std::string_view::npos) {
+    return {};
+  }
+  size_t second_dash = value.find('-', first_dash + 1);
+  if (second_dash == std::string_view::npos) {
+    second_dash = value.size();
+  }
+  return value.substr(first_dash + 1, second_dash - first_dash - 1);
+}
+
+std::string_view TraceIDFromB3(std::string_view value) {
+  return value.substr(0, value.find('-'));
+}
+
+std::string ExtractTraceID(const HeadersMap& http_headers) {
+  auto iter = http_headers.find(kTraceparent);
+  if (iter != http_headers.end()) {
+    return std::string(TraceIDFromTraceparent(iter->second));
+  }
+  iter = http_headers.find(kB3TraceID);
+  if (iter != http_headers.end()) {
+    return iter->second;
+  }
+  iter = http_headers.find(kB3);
+  if (iter != http_headers.end()) {
+    return std::string(TraceIDFromB3(iter->second));
+  }
+  return "";
+}
+
 bool MatchesHTTPHeaders(const HeadersMap& http_headers, const HTTPHeaderFilter& filter) {
   if (!filter.inclusions.empty()) {
     bool included = false;
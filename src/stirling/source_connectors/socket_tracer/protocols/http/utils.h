@@ -59,6 +59,28 @@ HTTPHeaderFilter ParseHTTPHeaderFilters(std::string_view filters);
  */
 bool MatchesHTTPHeaders(const HeadersMap& http_headers, const HTTPHeaderFilter& filter);
 
+/**
+ * @brief Returns the trace-id field of a W3C `traceparent` header value
+ * ("<version>-<trace-id>-<parent-id>-<flags>"), or an empty view if the value is malformed.
+ * The returned view points into `value`.
+ */
+std::string_view TraceIDFromTraceparent(std::string_view value);
+
+/**
+ * @brief Returns the trace-id field of a B3 single-header value
+ * ("<trace-id>-<span-id>-..."). The returned view points into `value`.
+ */
+std::string_view TraceIDFromB3(std::string_view value);
+
+/**
+ * @brief Extracts the distributed-tracing trace ID propagated in the message's headers,
+ * checking `traceparent` (W3C trace context), `X-B3-TraceId` and the `b3` single header.
+ * Returns an empty string when no trace context is present. This is a few case-insensitive
+ * map lookups per message, so trace IDs can be surfaced as a table column instead of being
+ * regex-extracted from the serialized headers downstream.
+ */
+std::string ExtractTraceID(const HeadersMap& http_headers);
+
 /**
  * Detects the content-type of an HTTP message. Currently only checks for JSON.
  */
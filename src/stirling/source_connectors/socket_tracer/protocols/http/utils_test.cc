@@ -76,6 +76,39 @@ TEST(ParseHTTPHeaderFiltersAndMatchTest, FiltersAreAsExpectedAndMatchesWork) {
   }
 }
 
+TEST(ExtractTraceIDTest, TraceparentHeader) {
+  const HeadersMap http_headers = {
+      {"Host", "example.com"},
+      {"Traceparent", "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"},
+  };
+  EXPECT_EQ(ExtractTraceID(http_headers), "0af7651916cd43dd8448eb211c80319c");
+}
+
+TEST(ExtractTraceIDTest, B3Headers) {
+  const HeadersMap multi_header = {
+      {"X-B3-TraceId", "80f198ee56343ba864fe8b2a57d3eff7"},
+      {"X-B3-SpanId", "e457b5a2e4d86bd1"},
+  };
+  EXPECT_EQ(ExtractTraceID(multi_header), "80f198ee56343ba864fe8b2a57d3eff7");
+
+  const HeadersMap single_header = {
+      {"b3", "80f198ee56343ba864fe8b2a57d3eff7-e457b5a2e4d86bd1-1"},
+  };
+  EXPECT_EQ(ExtractTraceID(single_header), "80f198ee56343ba864fe8b2a57d3eff7");
+}
+
+TEST(ExtractTraceIDTest, NoTraceContext) {
+  const HeadersMap http_headers = {
+      {"Content-Type", "application/json"},
+  };
+  EXPECT_EQ(ExtractTraceID(http_headers), "");
+
+  const HeadersMap malformed = {
+      {"traceparent", "malformed_without_dashes"},
+  };
+  EXPECT_EQ(ExtractTraceID(malformed), "");
+}
+
 }  // namespace http
 }  // namespace protocols
 }  // namespace stirling
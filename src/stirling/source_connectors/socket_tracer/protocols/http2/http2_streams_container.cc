@@ -19,6 +19,8 @@
 #include "src/stirling/source_connectors/socket_tracer/protocols/http2/http2_streams_container.h"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace px {
 namespace stirling {
@@ -54,9 +56,30 @@ void HTTP2StreamsContainer::Cleanup(
     size_t size_limit_bytes, std::chrono::time_point<std::chrono::steady_clock> expiry_timestamp) {
   size_t size = StreamsSize();
   if (size > size_limit_bytes) {
-    VLOG(1) << absl::Substitute("HTTP2 streams cleared due to size limit ($0 > $1).", size,
-                                size_limit_bytes);
-    streams_.clear();
+    const size_t orig_size = size;
+    // Evict the least-recently-active streams until under the limit, so that streams with
+    // recent activity survive the cleanup.
+    std::vector<std::pair<uint64_t, uint32_t>> last_activity_and_id;
+    last_activity_and_id.reserve(streams_.size());
+    for (const auto& [id, stream] : streams_) {
+      uint64_t timestamp_ns = std::max(stream.send.timestamp_ns, stream.recv.timestamp_ns);
+      last_activity_and_id.emplace_back(timestamp_ns, id);
+    }
+    std::sort(last_activity_and_id.begin(), last_activity_and_id.end());
+
+    size_t num_evicted = 0;
+    for (const auto& [timestamp_ns, id] : last_activity_and_id) {
+      if (size <= size_limit_bytes) {
+        break;
+      }
+      auto iter = streams_.find(id);
+      size -= iter->second.ByteSize();
+      streams_.erase(iter);
+      ++num_evicted;
+    }
+    VLOG(1) << absl::Substitute(
+        "HTTP2 streams evicted $0 least-recently-active streams due to size limit ($1 > $2).",
+        num_evicted, orig_size, size_limit_bytes);
   }
 
   EraseExpiredStreams(expiry_timestamp, &streams_);
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/http2/http2_streams_container.h"
+
+#include <chrono>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+
+namespace {
+
+// An expiry timestamp older than any stream activity, so that Cleanup() only applies the size
+// limit.
+std::chrono::time_point<std::chrono::steady_clock> NoExpiry() {
+  return std::chrono::time_point<std::chrono::steady_clock>(std::chrono::nanoseconds(0));
+}
+
+void AddStream(HTTP2StreamsContainer* streams, uint32_t stream_id, uint64_t timestamp_ns) {
+  protocols::http2::HalfStream* half_stream =
+      streams->HalfStreamPtr(stream_id, /* write_event */ true);
+  half_stream->AddHeader(":method", "post");
+  half_stream->UpdateTimestamp(timestamp_ns);
+}
+
+}  // namespace
+
+TEST(HTTP2StreamsContainerTest, CleanupEvictsLeastRecentlyActiveStreamsFirst) {
+  HTTP2StreamsContainer streams;
+
+  // All streams are the same size; stream 1 has the oldest activity, stream 5 the newest.
+  AddStream(&streams, 1, 1000);
+  AddStream(&streams, 3, 2000);
+  AddStream(&streams, 5, 3000);
+
+  // A limit one byte short of the total forces the eviction of exactly one stream.
+  streams.Cleanup(streams.StreamsSize() - 1, NoExpiry());
+
+  EXPECT_FALSE(streams.streams().contains(1));
+  EXPECT_TRUE(streams.streams().contains(3));
+  EXPECT_TRUE(streams.streams().contains(5));
+
+  // A limit of zero evicts everything.
+  streams.Cleanup(0, NoExpiry());
+  EXPECT_TRUE(streams.streams().empty());
+}
+
+TEST(HTTP2StreamsContainerTest, CleanupUnderSizeLimitIsANoOp) {
+  HTTP2StreamsContainer streams;
+
+  AddStream(&streams, 1, 1000);
+  AddStream(&streams, 3, 2000);
+
+  streams.Cleanup(streams.StreamsSize(), NoExpiry());
+
+  EXPECT_EQ(streams.streams().size(), 2);
+}
+
+}  // namespace stirling
+}  // namespace px
@@ -61,6 +61,24 @@ TEST(KafkaPacketDecoderTest, ExtractRecordBatchV8) {
   EXPECT_OK_AND_EQ(decoder.ExtractRecordBatch(), expected_result);
 }
 
+TEST(KafkaPacketDecoderTest, ExtractRecordBatchOmitRecordContents) {
+  // Same input as ExtractRecordBatchV8, but with record contents omitted, so only the batch
+  // envelope is decoded and the individual records are skipped over.
+  const std::string_view input = CreateStringView<char>(
+      "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x46\xff\xff\xff\xff\x02\xa7\x88\x71\xd8\x00"
+      "\x00\x00\x00\x00\x00\x00\x00\x01\x7a\xb2\x0a\x70\x1d\x00\x00\x01\x7a\xb2\x0a\x70\x1d\xff"
+      "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\x00\x00\x00\x01\x28\x00\x00\x00\x01"
+      "\x1c\x4d\x79\x20\x66\x69\x72\x73\x74\x20\x65\x76\x65\x6e\x74\x00");
+  PacketDecoder decoder(input);
+  decoder.SetAPIInfo(APIKey::kProduce, 8);
+  decoder.SetOmitRecordContents(true);
+  int32_t offset = 0;
+  ASSERT_OK_AND_ASSIGN(RecordBatch record_batch, decoder.ExtractRecordBatch(&offset));
+  EXPECT_THAT(record_batch.records, IsEmpty());
+  // The decoder skips to the end of the batch, as if the records had been decoded.
+  EXPECT_TRUE(decoder.eof());
+}
+
 TEST(KafkaPacketDecoderTest, ExtractRecordBatchV9) {
   const std::string_view input = CreateStringView<char>(
       "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x4e\xff\xff\xff\xff\x02\xc0\xde\x91\x11\x00"
@@ -244,6 +244,12 @@ class PacketDecoder {
     is_flexible_ = IsFlexible(api_key, api_version);
   }
 
+  // When set, ExtractRecordBatch() validates the record batch envelope but skips over the
+  // individual records instead of decoding their keys and values. The emitted JSON omits
+  // record contents, so the production stitcher enables this to avoid decoding payload
+  // bytes that would be thrown away.
+  void SetOmitRecordContents(bool omit) { omit_record_contents_ = omit; }
+
  private:
   // Represents a sequence of characters. First the length N is given as an INT16. Then N
   // bytes follow which are the UTF-8 encoding of the character sequence.
@@ -314,6 +320,7 @@ class PacketDecoder {
   APIKey api_key_;
   int16_t api_version_ = 0;
   bool is_flexible_ = false;
+  bool omit_record_contents_ = false;
 };
 
 }  // namespace kafka
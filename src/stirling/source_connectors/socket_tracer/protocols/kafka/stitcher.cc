@@ -27,6 +27,11 @@
 #include "src/stirling/source_connectors/socket_tracer/protocols/kafka/common/types.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/kafka/decoder/packet_decoder.h"
 
+DEFINE_int32(kafka_body_limit_bytes, 65536,
+             "The maximum length of the kafka request and response bodies emitted into the "
+             "kafka_events table. A value of 0 skips decoding of the message payloads entirely, "
+             "emitting only the envelope fields (api_key, client_id, latency).");
+
 namespace px {
 namespace stirling {
 namespace protocols {
@@ -98,9 +103,17 @@ Status ProcessMetadataReq(PacketDecoder* decoder, Request* req) {
 Status ProcessReq(Packet* req_packet, Request* req) {
   req->timestamp_ns = req_packet->timestamp_ns;
   PacketDecoder decoder(*req_packet);
+  // The individual records inside record batches never make it into the emitted output,
+  // so skip decoding their contents.
+  decoder.SetOmitRecordContents(true);
   // Extracts api_key, api_version, and correlation_id.
   PL_RETURN_IF_ERROR(decoder.ExtractReqHeader(req));
 
+  // The body columns are truncated to zero, so only the envelope fields are needed.
+  if (FLAGS_kafka_body_limit_bytes == 0) {
+    return Status::OK();
+  }
+
   // TODO(chengruizhe): Add support for more api keys.
   switch (req->api_key) {
     case APIKey::kProduce:
@@ -123,9 +136,14 @@ Status ProcessResp(Packet* resp_packet, Response* resp, APIKey api_key, int16_t
   resp->timestamp_ns = resp_packet->timestamp_ns;
   PacketDecoder decoder(*resp_packet);
   decoder.SetAPIInfo(api_key, api_version);
+  decoder.SetOmitRecordContents(true);
 
   PL_RETURN_IF_ERROR(decoder.ExtractRespHeader(resp));
 
+  if (FLAGS_kafka_body_limit_bytes == 0) {
+    return Status::OK();
+  }
+
   switch (api_key) {
     case APIKey::kProduce:
       return ProcessProduceResp(&decoder, resp);
@@ -162,6 +180,13 @@ RecordsWithErrorCount<Record> StitchFrames(std::deque<Packet>* req_packets,
   std::vector<Record> entries;
   int error_count = 0;
 
+  // Since resp_packets are popped off at the end of every call, any request left over from a
+  // previous call has already been checked against all previously seen responses. With no new
+  // responses, there is nothing for the leftover requests to match, so skip walking the deque.
+  if (resp_packets->empty()) {
+    return {entries, error_count};
+  }
+
   // Maps correlation_id to resp packet.
   absl::flat_hash_map<int32_t, Packet*> correlation_id_map;
   for (auto& resp_packet : *resp_packets) {
@@ -185,6 +210,14 @@ RecordsWithErrorCount<Record> StitchFrames(std::deque<Packet>* req_packets,
       // Remove this correlation_id from state.
       // TODO(chengruizhe): Add expiration time for correlation_ids in the state.
       state->seen_correlation_ids.erase(req_packet.correlation_id);
+
+      // Once every new response has been matched, the remaining requests cannot produce any more
+      // records in this call, so stop walking the deque. This keeps the cost of each call
+      // proportional to the newly received responses rather than the backlog of requests still
+      // waiting for theirs.
+      if (correlation_id_map.empty()) {
+        break;
+      }
     }
   }
 
@@ -27,6 +27,8 @@
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/interface.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/kafka/common/types.h"
 
+DECLARE_int32(kafka_body_limit_bytes);
+
 namespace px {
 namespace stirling {
 namespace protocols {
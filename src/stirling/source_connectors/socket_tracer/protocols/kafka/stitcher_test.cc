@@ -65,6 +65,25 @@ TEST(KafkaStitcherTest, BasicMatching) {
             "\"record_errors\":[],\"error_message\":\"\"}]}],\"throttle_time_ms\":0}");
 }
 
+TEST(KafkaStitcherTest, BodyLimitZeroSkipsPayloadDecoding) {
+  int32_t orig_body_limit = FLAGS_kafka_body_limit_bytes;
+  FLAGS_kafka_body_limit_bytes = 0;
+
+  std::deque<Packet> req_packets = {testdata::kProduceReqPacket};
+  std::deque<Packet> resp_packets = {testdata::kProduceRespPacket};
+  State state{};
+
+  RecordsWithErrorCount<Record> result = StitchFrames(&req_packets, &resp_packets, &state);
+  EXPECT_EQ(result.error_count, 0);
+  ASSERT_EQ(result.records.size(), 1);
+  // The envelope fields are still decoded, but the message payloads are skipped.
+  EXPECT_EQ(result.records[0].req.api_key, APIKey::kProduce);
+  EXPECT_TRUE(result.records[0].req.msg.empty());
+  EXPECT_TRUE(result.records[0].resp.msg.empty());
+
+  FLAGS_kafka_body_limit_bytes = orig_body_limit;
+}
+
 }  // namespace kafka
 }  // namespace protocols
 }  // namespace stirling
@@ -19,6 +19,7 @@
 #include <string>
 #include <utility>
 
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/frame_scanner.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/mux/parse.h"
 #include "src/stirling/utils/binary_decoder.h"
 
@@ -27,6 +28,35 @@ namespace stirling {
 namespace protocols {
 namespace mux {
 
+namespace {
+
+struct MuxFrameScanner : public LengthPrefixedFrameScanner<MuxFrameScanner> {
+  // 4 byte length field, 1 byte type and 3 byte tag.
+  static constexpr size_t kMinFrameLength = 8;
+  static constexpr FrameHeaderDescriptor kFrameHeader = {
+      .header_length = 4,
+      .length_field_offset = 0,
+      .length_field_size = 4,
+      .length_includes_header = false,
+      .trailer_length = 0,
+  };
+
+  static bool IsFrameStart(std::string_view buf) {
+    // The mux length field counts the type and tag bytes, so a valid frame spans at least
+    // kMinFrameLength bytes in total.
+    if (ComputeFrameLength(buf) < kMinFrameLength) {
+      return false;
+    }
+    if (!IsMuxType(static_cast<int8_t>(buf[4]))) {
+      return false;
+    }
+    const auto tag = ::px::utils::BEndianBytesToInt<uint32_t, 3>(buf.substr(5));
+    return tag >= 1 && tag <= ((1 << 23) - 1);
+  }
+};
+
+}  // namespace
+
 ParseState ParseFullFrame(BinaryDecoder* decoder, Frame* frame) {
   PL_ASSIGN_OR(frame->tag, decoder->ExtractInt<uint24_t>(), return ParseState::kInvalid);
 
@@ -132,9 +162,9 @@ ParseState ParseFrame(message_type_t, std::string_view* buf, mux::Frame* frame,
 }
 
 template <>
-size_t FindFrameBoundary<mux::Frame>(message_type_t, std::string_view, size_t, NoState*) {
-  // Not implemented.
-  return std::string::npos;
+size_t FindFrameBoundary<mux::Frame>(message_type_t, std::string_view buf, size_t start_pos,
+                                     NoState*) {
+  return mux::MuxFrameScanner::FindFrameBoundary(buf, start_pos);
 }
 
 }  // namespace protocols
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/common/base/base.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/corpus_replay.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/mysql/parse.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/mysql/stitcher.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/mysql/test_data.h"
+
+// Corpus-driven conformance + throughput benchmark for the MySQL pipeline: replays prepared
+// statement cycles (STMT_PREPARE / STMT_EXECUTE with a resultset / STMT_CLOSE, from the
+// SockShop capture in test_data.h) through ParseFramesLoop + StitchFrames, reporting MB/s
+// (bytes_per_second) and records/s (items_per_second) for pre-merge comparison of parser
+// changes.
+
+using px::stirling::ParseState;
+using px::stirling::protocols::CorpusReplayResult;
+using px::stirling::protocols::ReplayCorpus;
+using px::stirling::protocols::mysql::Packet;
+using px::stirling::protocols::mysql::Record;
+using px::stirling::protocols::mysql::StateWrapper;
+
+namespace mysql_testdata = px::stirling::protocols::mysql::testdata;
+
+namespace {
+
+// Number of prepare/execute/close cycles per corpus. Each cycle produces 3 records.
+constexpr int kNumCycles = 128;
+constexpr int kRecordsPerCycle = 3;
+
+}  // namespace
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_MySQLCorpusReplayPreparedStatements(benchmark::State& state) {
+  std::string req_buf;
+  std::string resp_buf;
+  // Response packet count for each request, in request order, for timestamp assignment below.
+  std::vector<size_t> resp_counts;
+  for (int i = 0; i < kNumCycles; ++i) {
+    for (const auto& p : mysql_testdata::kRawStmtPrepareReq) {
+      absl::StrAppend(&req_buf, p);
+    }
+    resp_counts.push_back(mysql_testdata::kRawStmtPrepareResp.size());
+    for (const auto& p : mysql_testdata::kRawStmtPrepareResp) {
+      absl::StrAppend(&resp_buf, p);
+    }
+
+    for (const auto& p : mysql_testdata::kRawStmtExecuteReq) {
+      absl::StrAppend(&req_buf, p);
+    }
+    resp_counts.push_back(mysql_testdata::kRawStmtExecuteResp.size());
+    for (const auto& p : mysql_testdata::kRawStmtExecuteResp) {
+      absl::StrAppend(&resp_buf, p);
+    }
+
+    // STMT_CLOSE has no response.
+    for (const auto& p : mysql_testdata::kRawStmtCloseReq) {
+      absl::StrAppend(&req_buf, p);
+    }
+    resp_counts.push_back(0);
+  }
+
+  // MySQL responses span multiple packets, and the stitcher groups a request's response packets
+  // by timestamp (after this request, before the next). Lay timestamps out accordingly.
+  auto assign_timestamps = [&resp_counts](std::deque<Packet>* reqs, std::deque<Packet>* resps) {
+    uint64_t ts = 1;
+    auto resp_iter = resps->begin();
+    for (size_t i = 0; i < reqs->size(); ++i) {
+      (*reqs)[i].timestamp_ns = ts++;
+      for (size_t j = 0; j < resp_counts[i] && resp_iter != resps->end(); ++j) {
+        (resp_iter++)->timestamp_ns = ts++;
+      }
+    }
+  };
+
+  CorpusReplayResult result;
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    StateWrapper conn_state{};
+    result = ReplayCorpus<Record, Packet>(req_buf, resp_buf, &conn_state, assign_timestamps);
+    benchmark::DoNotOptimize(result);
+  }
+  CHECK(result.req_parse_state == ParseState::kSuccess);
+  CHECK(result.resp_parse_state == ParseState::kSuccess);
+  CHECK_EQ(static_cast<int>(result.records_stitched), kNumCycles * kRecordsPerCycle);
+  CHECK_EQ(result.stitch_error_count, 0);
+  state.SetBytesProcessed(state.iterations() * (req_buf.size() + resp_buf.size()));
+  state.SetItemsProcessed(state.iterations() * kNumCycles * kRecordsPerCycle);
+}
+
+BENCHMARK(BM_MySQLCorpusReplayPreparedStatements);
@@ -190,7 +190,9 @@ StatusOr<ParseState> HandleResultsetResponse(DequeView<Packet> resp_packets, Rec
     resp_packets.pop_front();
   }
 
-  std::vector<ResultsetRow> results;
+  // Only the row count is published, so the rows are scanned for packet boundaries without
+  // materializing any column values.
+  size_t num_rows = 0;
 
   auto isLastPacket = [](const Packet& p) {
     return (IsErrPacket(p) || IsOKPacket(p) || IsEOFPacket(p));
@@ -200,7 +202,6 @@ StatusOr<ParseState> HandleResultsetResponse(DequeView<Packet> resp_packets, Rec
     const Packet& row_packet = resp_packets.front();
 
     Status s;
-    // TODO(chengruizhe): Get actual results from the resultset row packets if needed.
     // Attempt to process it as a resultset row packet first. Process[Text/Binary]ResultRowPacket
     // functions, if returning ok, indicates with very high confidence that the packet is indeed a
     // resultset row packet. IsOKPacket, on the other hand, is not as robust.
@@ -212,8 +213,7 @@ StatusOr<ParseState> HandleResultsetResponse(DequeView<Packet> resp_packets, Rec
 
     if (s.ok()) {
       resp_packets.pop_front();
-      ResultsetRow row{row_packet.msg};
-      results.emplace_back(std::move(row));
+      ++num_rows;
     } else if (isLastPacket(row_packet)) {
       break;
     } else {
@@ -237,7 +237,7 @@ StatusOr<ParseState> HandleResultsetResponse(DequeView<Packet> resp_packets, Rec
   if (multi_resultset) {
     absl::StrAppend(&entry->resp.msg, ", ");
   }
-  absl::StrAppend(&entry->resp.msg, "Resultset rows = ", results.size());
+  absl::StrAppend(&entry->resp.msg, "Resultset rows = ", num_rows);
 
   // Check for another resultset in case this is a multi-resultset.
   if (MoreResultsExist(last_packet)) {
@@ -344,7 +344,7 @@ StatusOr<ParseState> HandleStmtPrepareOKResponse(DequeView<Packet> resp_packets,
   }
 
   // Update state.
-  state->prepared_statements.emplace(
+  state->prepared_statements.Insert(
       stmt_id,
       PreparedStatement{.request = entry->req.msg,
                         .response = StmtPrepareOKResponse{.header = resp_header,
@@ -462,7 +462,7 @@ Status ProcessStmtExecuteParam(std::string_view msg, size_t* type_offset, size_t
 }  // namespace
 
 StatusOr<ParseState> HandleStmtExecuteRequest(const Packet& req_packet,
-                                              std::map<int, PreparedStatement>* prepare_map,
+                                              PreparedStatementsCache* prepare_map,
                                               Record* entry) {
   if (req_packet.msg.size() < 1 + kStmtIDBytes) {
     return error::Internal("Insufficient number of bytes for STMT_EXECUTE");
@@ -474,8 +474,8 @@ StatusOr<ParseState> HandleStmtExecuteRequest(const Packet& req_packet,
   int stmt_id =
       utils::LEndianBytesToInt<int, kStmtIDBytes>(req_packet.msg.substr(kStmtIDStartOffset));
 
-  auto iter = prepare_map->find(stmt_id);
-  if (iter == prepare_map->end()) {
+  PreparedStatement* prepared_statement = prepare_map->Find(stmt_id);
+  if (prepared_statement == nullptr) {
     // There can be 2 possibilities in this case:
     // 1. The stitcher is confused/messed up and accidentally deleted wrong prepare event.
     // 2. Client sent a Stmt Exec for a deleted Stmt Prepare
@@ -491,7 +491,7 @@ StatusOr<ParseState> HandleStmtExecuteRequest(const Packet& req_packet,
     return ParseState::kSuccess;
   }
 
-  int num_params = iter->second.response.header.num_params;
+  int num_params = prepared_statement->response.header.num_params;
 
   size_t offset = kStmtIDStartOffset + kStmtIDBytes + kFlagsBytes + kIterationCountBytes;
 
@@ -520,14 +520,14 @@ StatusOr<ParseState> HandleStmtExecuteRequest(const Packet& req_packet,
     }
   }
 
-  std::string_view stmt_prepare_request = iter->second.request;
+  std::string_view stmt_prepare_request = prepared_statement->request;
   entry->req.msg = CombinePrepareExecute(stmt_prepare_request, params);
 
   return ParseState::kSuccess;
 }
 
 StatusOr<ParseState> HandleStmtCloseRequest(const Packet& req_packet,
-                                            std::map<int, PreparedStatement>* prepare_map,
+                                            PreparedStatementsCache* prepare_map,
                                             Record* entry) {
   if (req_packet.msg.size() < 1 + kStmtIDBytes) {
     return error::Internal("Insufficient number of bytes for STMT_CLOSE");
@@ -539,10 +539,7 @@ StatusOr<ParseState> HandleStmtCloseRequest(const Packet& req_packet,
 
   int stmt_id =
       utils::LEndianBytesToInt<int, kStmtIDBytes>(req_packet.msg.substr(kStmtIDStartOffset));
-  auto iter = prepare_map->find(stmt_id);
-  if (iter != prepare_map->end()) {
-    prepare_map->erase(iter);
-  } else {
+  if (!prepare_map->Erase(stmt_id)) {
     // We may have missed the prepare statement (e.g. due to the missing start of connection
     // problem), but we can still process the close, and continue on. Just print a warning.
     entry->px_info = absl::Substitute(
@@ -145,8 +145,8 @@ TEST(HandleStmtExecuteRequest, Basic) {
   Packet req_packet = testutils::GenStmtExecuteRequest(testdata::kStmtExecuteRequest);
   PreparedStatement prepared_stmt = testdata::kPreparedStatement;
   int stmt_id = prepared_stmt.response.header.stmt_id;
-  std::map<int, PreparedStatement> prepare_map;
-  prepare_map.emplace(stmt_id, std::move(prepared_stmt));
+  PreparedStatementsCache prepare_map(kPreparedStatementsCacheCapacity);
+  prepare_map.Insert(stmt_id, std::move(prepared_stmt));
 
   Record entry;
   EXPECT_OK_AND_EQ(HandleStmtExecuteRequest(req_packet, &prepare_map, &entry),
@@ -101,10 +101,11 @@ Status ProcessTextResultsetRowPacket(const Packet& packet, size_t num_col) {
   if ((packet.msg.length() == 1) && (packet.msg.front() == kResultsetRowNullPrefix)) {
     return Status::OK();
   }
-  std::string result;
+  // The column values are only scanned for boundaries, not materialized: the stitcher just counts
+  // rows, so copying the values out would be wasted work.
   size_t offset = 0;
   for (size_t i = 0; i < num_col; ++i) {
-    PL_RETURN_IF_ERROR(DissectStringParam(packet.msg, &offset, &result));
+    PL_RETURN_IF_ERROR(SkipStringParam(packet.msg, &offset));
   }
 
   // Shouldn't have anything after the length encoded string.
@@ -137,6 +138,8 @@ Status ProcessBinaryResultsetRowPacket(const Packet& packet,
 
   // Starting from the 3rd bit in the null_bitmap, each bit at pos i records if the the i-2th value
   // is null.
+  // As with text resultset rows, the values are only scanned for boundaries, not materialized:
+  // the stitcher just counts rows, so rendering the values to strings would be wasted work.
   for (size_t i = 0; i < column_defs.size(); ++i) {
     unsigned int null_bitmap_bytepos = (i + kBinaryResultsetRowNullBitmapOffset) / 8;
     unsigned int null_bitmap_bitpos = (i + kBinaryResultsetRowNullBitmapOffset) % 8;
@@ -147,7 +150,7 @@ Status ProcessBinaryResultsetRowPacket(const Packet& packet,
       continue;
     }
 
-    std::string val;
+    size_t val_len = 0;
     switch (column_defs[i].column_type) {
       case ColType::kString:
       case ColType::kVarChar:
@@ -162,38 +165,42 @@ Status ProcessBinaryResultsetRowPacket(const Packet& packet,
       case ColType::kBit:
       case ColType::kDecimal:
       case ColType::kNewDecimal:
-        PL_RETURN_IF_ERROR(DissectStringParam(packet.msg, &offset, &val));
-        break;
+        PL_RETURN_IF_ERROR(SkipStringParam(packet.msg, &offset));
+        continue;
       case ColType::kLongLong:
-        PL_RETURN_IF_ERROR(DissectIntParam<8>(packet.msg, &offset, &val));
+      case ColType::kDouble:
+        val_len = 8;
         break;
       case ColType::kLong:
       case ColType::kInt24:
-        PL_RETURN_IF_ERROR(DissectIntParam<4>(packet.msg, &offset, &val));
+      case ColType::kFloat:
+        val_len = 4;
         break;
       case ColType::kShort:
       case ColType::kYear:
-        PL_RETURN_IF_ERROR(DissectIntParam<2>(packet.msg, &offset, &val));
+        val_len = 2;
         break;
       case ColType::kTiny:
-        PL_RETURN_IF_ERROR(DissectIntParam<1>(packet.msg, &offset, &val));
-        break;
-      case ColType::kDouble:
-        PL_RETURN_IF_ERROR(DissectFloatParam<double>(packet.msg, &offset, &val));
-        break;
-      case ColType::kFloat:
-        PL_RETURN_IF_ERROR(DissectFloatParam<float>(packet.msg, &offset, &val));
+        val_len = 1;
         break;
       case ColType::kDate:
       case ColType::kDateTime:
       case ColType::kTimestamp:
       case ColType::kTime:
-        // TODO(chengruizhe): Implement DissectDateTime correctly.
-        PL_RETURN_IF_ERROR(DissectDateTimeParam(packet.msg, &offset, &val));
+        // Date/time values are prefixed with a 1-byte length.
+        if (offset >= packet.msg.size()) {
+          return error::Internal("Not enough bytes in binary resultset row.");
+        }
+        val_len = 1 + static_cast<uint8_t>(packet.msg[offset]);
         break;
       default:
         return error::Internal("Unrecognized result column type.");
     }
+
+    if (packet.msg.size() < offset + val_len) {
+      return error::Internal("Not enough bytes in binary resultset row.");
+    }
+    offset += val_len;
   }
 
   if (offset != packet.msg.size()) {
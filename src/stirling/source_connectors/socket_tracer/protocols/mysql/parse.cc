@@ -25,6 +25,7 @@
 
 #include "src/common/base/byte_utils.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/mysql/types.h"
+#include "src/stirling/utils/binary_decoder.h"
 #include "src/stirling/utils/parse_state.h"
 
 namespace px {
@@ -37,13 +38,17 @@ ParseState ParseFrame(message_type_t type, std::string_view* buf, Packet* result
     return ParseState::kInvalid;
   }
 
-  if (buf->size() < kPacketHeaderLength) {
+  // Packet header layout: 3-byte little-endian payload length, followed by the sequence ID.
+  // The length is validated once here, so the field extractions below need no bounds checks.
+  BinaryDecoder decoder(*buf);
+  auto header_or = decoder.ExtractFixed<kPacketHeaderLength>();
+  if (!header_or.ok()) {
     return ParseState::kNeedsMoreData;
   }
+  UncheckedBinaryDecoder header = header_or.ConsumeValueOrDie();
 
-  result->sequence_id = static_cast<uint8_t>((*buf)[3]);
-
-  int packet_length = utils::LEndianBytesToInt<int, kPayloadLengthLength>(*buf);
+  int packet_length = header.ExtractLEInt<int, kPayloadLengthLength>();
+  result->sequence_id = header.ExtractBEInt<uint8_t>();
 
   // TODO(oazizi): Is pre-checking requests here a good idea? Somewhat out of place.
   // Better fit for stitcher (when analyzing structure of packet bodies).
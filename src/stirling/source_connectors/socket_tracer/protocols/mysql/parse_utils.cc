@@ -95,6 +95,15 @@ Status DissectStringParam(std::string_view msg, size_t* param_offset, std::strin
   return Status::OK();
 }
 
+Status SkipStringParam(std::string_view msg, size_t* param_offset) {
+  PL_ASSIGN_OR_RETURN(int param_length, ProcessLengthEncodedInt(msg, param_offset));
+  if (msg.size() < *param_offset + param_length) {
+    return error::Internal("Not enough bytes to dissect string param.");
+  }
+  *param_offset += param_length;
+  return Status::OK();
+}
+
 template <size_t length>
 Status DissectIntParam(std::string_view msg, size_t* offset, std::string* param) {
   int64_t p;
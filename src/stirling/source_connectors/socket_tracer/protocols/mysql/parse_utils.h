@@ -50,6 +50,10 @@ StatusOr<int64_t> ProcessLengthEncodedInt(std::string_view s, size_t* offset);
 
 Status DissectStringParam(std::string_view msg, size_t* param_offset, std::string* packet);
 
+// Validates a length-encoded string and advances the offset past it, without copying the value.
+// Use this instead of DissectStringParam when only packet boundaries matter.
+Status SkipStringParam(std::string_view msg, size_t* param_offset);
+
 template <size_t length>
 Status DissectIntParam(std::string_view msg, size_t* param_offset, std::string* packet);
 
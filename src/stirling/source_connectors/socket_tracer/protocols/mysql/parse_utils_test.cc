@@ -84,6 +84,19 @@ TEST(ProcessLengthEncodedInt, NotEnoughBytes) {
       ProcessLengthEncodedInt(ConstStringView("\xfe\x01\x23\x45\x67\x89\xab\xcd"), &offset));
 }
 
+TEST(SkipStringParam, Basics) {
+  size_t offset = 0;
+  EXPECT_OK(SkipStringParam(ConstStringView("\x05"
+                                            "mysql"),
+                            &offset));
+  EXPECT_EQ(offset, 6);
+
+  offset = 0;
+  EXPECT_NOT_OK(SkipStringParam(ConstStringView("\x05"
+                                                "mys"),
+                                &offset));
+}
+
 TEST(ProcessStmtExecuteParams, Basics) {
   std::string value;
   size_t offset;
@@ -182,6 +182,15 @@ RecordsWithErrorCount<Record> ProcessMySQLPackets(std::deque<Packet>* req_packet
   std::vector<Record> entries;
   int error_count = 0;
 
+  // If the previous iteration stopped to wait for more response packets, and no new frames have
+  // arrived since, then re-processing would just re-parse the same incomplete data. Skip it.
+  if (state->stitch_waiting_for_more_data && req_packets->size() == 1 &&
+      req_packets->front().timestamp_ns == state->stitch_wait_req_timestamp_ns &&
+      resp_packets->size() == state->stitch_wait_resp_count) {
+    return {entries, error_count};
+  }
+  state->stitch_waiting_for_more_data = false;
+
   // Process one request per loop iteration. Each request may consume 0, 1 or 2+ response packets.
   // The actual work is forked off to a helper function depending on the command type.
   // There are three possible outcomes for each request:
@@ -246,6 +255,10 @@ RecordsWithErrorCount<Record> ProcessMySQLPackets(std::deque<Packet>* req_packet
         if (is_last_req && resp_looks_healthy) {
           VLOG(3) << "Appears to be an incomplete message. Waiting for more data";
           // More response data will probably be captured in next iteration, so stop.
+          // Record the resume cursor so the next iteration can skip straight to the new data.
+          state->stitch_waiting_for_more_data = true;
+          state->stitch_wait_req_timestamp_ns = req_packet.timestamp_ns;
+          state->stitch_wait_resp_count = resp_packets->size();
           break;
         }
         VLOG(1) << absl::Substitute(
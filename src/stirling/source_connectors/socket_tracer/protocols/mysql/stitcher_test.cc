@@ -40,15 +40,14 @@ TEST(StitcherTest, TestProcessStmtPrepareOK) {
   Packet req = testutils::GenStringRequest(testdata::kStmtPrepareRequest, Command::kStmtPrepare);
   std::deque<Packet> ok_resp_packets =
       testutils::GenStmtPrepareOKResponse(testdata::kStmtPrepareResponse);
-  State state{std::map<int, PreparedStatement>()};
+  State state;
 
   // Run function-under-test.
   Record entry;
   EXPECT_OK_AND_EQ(ProcessStmtPrepare(req, ok_resp_packets, &state, &entry), ParseState::kSuccess);
 
   // Check resulting state and entries.
-  auto iter = state.prepared_statements.find(testdata::kStmtID);
-  EXPECT_TRUE(iter != state.prepared_statements.end());
+  EXPECT_TRUE(state.prepared_statements.Contains(testdata::kStmtID));
   Record expected_entry{.req = {Command::kStmtPrepare, testdata::kStmtPrepareRequest.msg, 0},
                         .resp = {RespStatus::kOK, "", 0}};
   EXPECT_EQ(expected_entry, entry);
@@ -60,15 +59,14 @@ TEST(StitcherTest, TestProcessStmtPrepareErr) {
   std::deque<Packet> err_resp_packets;
   ErrResponse err_resp = {.error_code = 1096, .error_message = "This is an error."};
   err_resp_packets.emplace_back(testutils::GenErr(/* seq_id */ 1, err_resp));
-  State state{std::map<int, PreparedStatement>()};
+  State state;
 
   // Run function-under-test.
   Record entry;
   EXPECT_OK_AND_EQ(ProcessStmtPrepare(req, err_resp_packets, &state, &entry), ParseState::kSuccess);
 
   // Check resulting state and entries.
-  auto iter = state.prepared_statements.find(testdata::kStmtID);
-  EXPECT_EQ(iter, state.prepared_statements.end());
+  EXPECT_FALSE(state.prepared_statements.Contains(testdata::kStmtID));
   Record expected_err_entry{.req = {Command::kStmtPrepare, testdata::kStmtPrepareRequest.msg, 0},
                             .resp = {RespStatus::kErr, "This is an error.", 0}};
   EXPECT_EQ(expected_err_entry, entry);
@@ -78,8 +76,8 @@ TEST(StitcherTest, TestProcessStmtExecute) {
   // Test setup.
   Packet req = testutils::GenStmtExecuteRequest(testdata::kStmtExecuteRequest);
   std::deque<Packet> resultset = testutils::GenResultset(testdata::kStmtExecuteResultset);
-  State state{std::map<int, PreparedStatement>()};
-  state.prepared_statements.emplace(testdata::kStmtID, testdata::kPreparedStatement);
+  State state;
+  state.prepared_statements.Insert(testdata::kStmtID, testdata::kPreparedStatement);
 
   // Run function-under-test.
   Record entry;
@@ -105,8 +103,8 @@ TEST(StitcherTest, TestProcessStmtSendLongData) {
   // TODO(oazizi): Not a real COM_STMT_SEND_LONG_DATA. Need to replace with a real capture.
   Packet req = testutils::GenStringRequest(StringRequest{""}, Command::kStmtSendLongData);
   std::deque<Packet> resp_packets = {};
-  State state{std::map<int, PreparedStatement>()};
-  state.prepared_statements.emplace(testdata::kStmtID, testdata::kPreparedStatement);
+  State state;
+  state.prepared_statements.Insert(testdata::kStmtID, testdata::kPreparedStatement);
 
   // Run function-under-test.
   Record entry;
@@ -123,8 +121,8 @@ TEST(StitcherTest, TestProcessStmtClose) {
   // Test setup.
   Packet req = testutils::GenStmtCloseRequest(testdata::kStmtCloseRequest);
   std::deque<Packet> resp_packets = {};
-  State state{std::map<int, PreparedStatement>()};
-  state.prepared_statements.emplace(testdata::kStmtID, testdata::kPreparedStatement);
+  State state;
+  state.prepared_statements.Insert(testdata::kStmtID, testdata::kPreparedStatement);
 
   // Run function-under-test.
   Record entry;
@@ -190,8 +188,8 @@ TEST(ProcessMySQLPacketsTest, OldResponses) {
   responses.push_front(resp1);
   responses.push_front(resp0);
 
-  State state{std::map<int, PreparedStatement>()};
-  state.prepared_statements.emplace(testdata::kStmtID, testdata::kPreparedStatement);
+  State state;
+  state.prepared_statements.Insert(testdata::kStmtID, testdata::kPreparedStatement);
 
   std::deque<Packet> requests = {req};
   RecordsWithErrorCount<Record> result = ProcessMySQLPackets(&requests, &responses, &state);
@@ -214,7 +212,7 @@ TEST(ProcessMySQLPacketsTest, NonMySQLTraffic1) {
 
   std::deque<Packet> requests = {p0};
   std::deque<Packet> responses = {p1};
-  State state{.prepared_statements = std::map<int, PreparedStatement>(), .active = false};
+  State state{.active = false};
 
   RecordsWithErrorCount<Record> result = ProcessMySQLPackets(&requests, &responses, &state);
   EXPECT_EQ(result.records.size(), 0);
@@ -237,7 +235,7 @@ TEST(ProcessMySQLPacketsTest, NonMySQLTraffic2) {
 
   std::deque<Packet> requests = {p0};
   std::deque<Packet> responses = {p1};
-  State state{.prepared_statements = std::map<int, PreparedStatement>(), .active = false};
+  State state{.active = false};
 
   RecordsWithErrorCount<Record> result = ProcessMySQLPackets(&requests, &responses, &state);
   EXPECT_EQ(result.records.size(), 0);
@@ -257,7 +255,7 @@ TEST(ProcessMySQLPacketsTest, NonMySQLTraffic3) {
 
   std::deque<Packet> requests = {p};
   std::deque<Packet> responses = {};
-  State state{.prepared_statements = std::map<int, PreparedStatement>(), .active = false};
+  State state{.active = false};
 
   RecordsWithErrorCount<Record> result = ProcessMySQLPackets(&requests, &responses, &state);
   EXPECT_EQ(result.records.size(), 0);
@@ -30,6 +30,7 @@
 
 #include "src/common/base/base.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/event_parser.h"  // For FrameBase
+#include "src/stirling/utils/slru_cache.h"
 #include "src/stirling/utils/utils.h"
 
 namespace px {
@@ -62,6 +63,14 @@ struct Packet : public FrameBase {
   std::string msg;
 
   size_t ByteSize() const override { return sizeof(Packet) + msg.size(); }
+
+  // Restores the packet to its default-constructed state, but retains the capacity of msg so
+  // that a FramePool can reuse its allocation.
+  void Reset() {
+    sequence_id = 0;
+    msg.clear();
+    timestamp_ns = 0;
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -348,16 +357,32 @@ struct PreparedStatement {
 };
 
 /**
- * State stores a map of stmt_id to active StmtPrepare event. It's used to be looked up
+ * Bound on the number of prepared statements tracked per connection.
+ * Eviction is segmented-LRU, so statements that are executed repeatedly survive bursts of
+ * one-shot statements (common on ORM-generated workloads).
+ */
+constexpr size_t kPreparedStatementsCacheCapacity = 1024;
+
+using PreparedStatementsCache = ::px::stirling::utils::SLRUCache<int, PreparedStatement>;
+
+/**
+ * State stores a cache of stmt_id to active StmtPrepare event. It's used to be looked up
  * for the StmtPrepare event when a StmtExecute is received.
  */
 struct State {
-  std::map<int, PreparedStatement> prepared_statements;
+  PreparedStatementsCache prepared_statements{kPreparedStatementsCacheCapacity};
   // To prevent pushing data on mis-classified connections,
   // we start off in inactive state, which means no data will be pushed out.
   // Only on certain conditions, which increase our confidence that the data is indeed MySQL,
   // do we flip this switch, and start pushing data.
   bool active = false;
+  // Resume cursor for the stitcher. When stitching stops to wait for more response packets,
+  // this records the pending request and the number of response packets that were available,
+  // so subsequent iterations can skip re-processing the same incomplete data until new frames
+  // arrive.
+  bool stitch_waiting_for_more_data = false;
+  uint64_t stitch_wait_req_timestamp_ns = 0;
+  size_t stitch_wait_resp_count = 0;
 };
 
 struct StateWrapper {
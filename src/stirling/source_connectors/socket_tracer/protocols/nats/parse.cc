@@ -18,6 +18,7 @@
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/nats/parse.h"
 
+#include <array>
 #include <initializer_list>
 #include <map>
 #include <optional>
@@ -32,6 +33,7 @@
 
 #include "src/common/base/base.h"
 #include "src/common/json/json.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/frame_scanner.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/nats/types.h"
 #include "src/stirling/utils/binary_decoder.h"
 
@@ -47,20 +49,31 @@ using ::px::utils::ToJSONString;
 constexpr std::string_view kMessageTerminateMarker = "\r\n";
 constexpr std::string_view kMessageFieldDelimiters = " \t";
 
-size_t FindMessageBoundary(std::string_view buf, size_t start_pos) {
-  // Based on https://github.com/nats-io/docs/blob/master/nats_protocol/nats-protocol.md.
-  const std::vector<std::string_view> kmessage_type_ts = {kInfo, kConnect, kPub,  kSub, kUnsub,
-                                                          kMsg,  kPing,    kPong, kOK,  kERR};
-  constexpr ssize_t kMinMsgSize = 3;
-  for (ssize_t i = start_pos; i < static_cast<ssize_t>(buf.size()) - kMinMsgSize; ++i) {
-    auto buf_substr = buf.substr(i);
+namespace {
+
+// Based on https://github.com/nats-io/docs/blob/master/nats_protocol/nats-protocol.md.
+// NATS messages are text-delimited, so a boundary is identified by a command keyword
+// rather than a length-prefixed header.
+struct NATSMessageScanner : public FrameScanner<NATSMessageScanner> {
+  // The shortest message is a command followed by the \r\n terminator.
+  static constexpr size_t kMinFrameLength = 4;
+
+  static bool IsFrameStart(std::string_view buf) {
+    static constexpr std::array<std::string_view, 10> kmessage_type_ts = {
+        kInfo, kConnect, kPub, kSub, kUnsub, kMsg, kPing, kPong, kOK, kERR};
     for (auto msg_type : kmessage_type_ts) {
-      if (absl::StartsWith(buf_substr, msg_type)) {
-        return i;
+      if (absl::StartsWith(buf, msg_type)) {
+        return true;
       }
     }
+    return false;
   }
-  return std::string_view::npos;
+};
+
+}  // namespace
+
+size_t FindMessageBoundary(std::string_view buf, size_t start_pos) {
+  return NATSMessageScanner::FindFrameBoundary(buf, start_pos);
 }
 
 namespace {
@@ -46,9 +46,12 @@ constexpr int kNullValLen = -1;
 
 ParseState ParseRegularMessage(std::string_view* buf, RegularMessage* msg) {
   BinaryDecoder decoder(*buf);
-  PL_ASSIGN_OR_RETURN_NEEDS_MORE_DATA(const char char_val, decoder.ExtractChar());
-  msg->tag = static_cast<Tag>(char_val);
-  PL_ASSIGN_OR_RETURN_NEEDS_MORE_DATA(msg->len, decoder.ExtractInt<int32_t>());
+  // Message header layout: 1-byte tag followed by the 4-byte length. The length is validated
+  // once here, so the field extractions below need no bounds checks.
+  PL_ASSIGN_OR_RETURN_NEEDS_MORE_DATA(UncheckedBinaryDecoder header,
+                                      (decoder.ExtractFixedLayout<char, int32_t>()));
+  msg->tag = static_cast<Tag>(header.ExtractChar());
+  msg->len = header.ExtractBEInt<int32_t>();
 
   constexpr int kLenFieldLen = 4;
   if (msg->len < kLenFieldLen) {
@@ -28,6 +28,14 @@
 #include "src/stirling/source_connectors/socket_tracer/protocols/pgsql/parse.h"
 #include "src/stirling/utils/binary_decoder.h"
 
+// Defaults from the same env var as max_body_bytes (the response body truncation limit), so that
+// deployments that raise the body limit also decode enough data rows to fill it.
+DEFINE_uint64(stirling_pgsql_data_row_preview_bytes,
+              gflags::Uint64FromEnv("PL_STIRLING_MAX_BODY_BYTES", 512),
+              "The number of rendered resultset bytes beyond which the PostgreSQL stitcher stops "
+              "decoding data rows. The response body is truncated to max_body_bytes anyway, so "
+              "rows past this limit would be decoded only to be discarded.");
+
 namespace px {
 namespace stirling {
 namespace protocols {
@@ -35,6 +43,18 @@ namespace pgsql {
 
 namespace {
 
+// Returns the number of bytes a data row contributes to QueryResp::ToString(), i.e. the rendered
+// column values, the separators between them, and the trailing newline. Used to stop decoding
+// data rows once enough have accumulated to fill the truncated response body.
+size_t DataRowRenderedSize(const DataRow& data_row) {
+  constexpr size_t kNullSize = 6;  // Length of "[NULL]".
+  size_t size = data_row.cols.empty() ? 0 : data_row.cols.size() - 1;
+  for (const auto& col : data_row.cols) {
+    size += col.has_value() ? col.value().size() : kNullSize;
+  }
+  return size + 1;
+}
+
 void AdvanceIterBeyondTimestamp(MsgDeqIter* start, const MsgDeqIter& end, uint64_t ts) {
   while (*start != end && (*start)->timestamp_ns < ts) {
     ++(*start);
@@ -88,6 +108,11 @@ Status FillQueryResp(MsgDeqIter* resp_iter, const MsgDeqIter& end, QueryReqResp:
   bool found_cmd_cmpl = false;
   bool found_err_resp = false;
 
+  // Bytes the decoded data rows would contribute to the response body. Once this exceeds the
+  // truncation limit, the remaining rows are dropped without decoding: only a truncated body is
+  // published, so decoding thousand-row resultsets would be wasted work.
+  size_t data_rows_size = 0;
+
   for (auto& iter = *resp_iter; iter != end; ++iter) {
     if (iter->tag == Tag::kCmdComplete) {
       found_cmd_cmpl = true;
@@ -122,8 +147,12 @@ Status FillQueryResp(MsgDeqIter* resp_iter, const MsgDeqIter& end, QueryReqResp:
     }
 
     if (iter->tag == Tag::kDataRow) {
+      if (data_rows_size > FLAGS_stirling_pgsql_data_row_preview_bytes) {
+        continue;
+      }
       DataRow data_row;
       PL_RETURN_IF_ERROR(ParseDataRow(*iter, &data_row));
+      data_rows_size += DataRowRenderedSize(data_row);
       resp->data_rows.push_back(std::move(data_row));
     }
   }
@@ -153,6 +182,9 @@ Status HandleQuery(const RegularMessage& msg, MsgDeqIter* resp_iter, const MsgDe
 
   bool found_resp = false;
 
+  // See FillQueryResp() for why data row decoding stops after the truncation limit is reached.
+  size_t data_rows_size = 0;
+
   for (auto& iter = *resp_iter; iter != end; ++iter) {
     if (iter->tag == Tag::kEmptyQueryResponse) {
       found_resp = true;
@@ -183,10 +215,13 @@ Status HandleQuery(const RegularMessage& msg, MsgDeqIter* resp_iter, const MsgDe
     }
 
     if (iter->tag == Tag::kDataRow) {
+      req_resp->resp.timestamp_ns = iter->timestamp_ns;
+      if (data_rows_size > FLAGS_stirling_pgsql_data_row_preview_bytes) {
+        continue;
+      }
       DataRow data_row;
       PL_RETURN_IF_ERROR(ParseDataRow(*iter, &data_row));
-
-      req_resp->resp.timestamp_ns = data_row.timestamp_ns;
+      data_rows_size += DataRowRenderedSize(data_row);
       req_resp->resp.data_rows.push_back(std::move(data_row));
     }
   }
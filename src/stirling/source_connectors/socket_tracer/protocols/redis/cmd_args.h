@@ -81,7 +81,7 @@ struct CmdArgs {
 };
 
 // Returns the object that describes the command of the payloads, if there is a matching one.
-std::optional<const CmdArgs*> GetCmdAndArgs(VectorView<std::string>* payloads);
+std::optional<const CmdArgs*> GetCmdAndArgs(VectorView<std::string_view>* payloads);
 
 }  // namespace redis
 }  // namespace protocols
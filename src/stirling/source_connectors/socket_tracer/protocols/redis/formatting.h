@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include <string>
+#include <string_view>
 
 #include "src/common/base/base.h"
 #include "src/common/json/json.h"
@@ -30,8 +30,9 @@ namespace protocols {
 namespace redis {
 
 // Formats an the payloads of an array message according to its type type, and writes the result
-// to the input message result argument.
-void FormatArrayMessage(VectorView<std::string> payloads_view, Message* msg);
+// to the input message result argument. The payload views only need to live for the duration of
+// the call; the formatted result is copied into the message.
+void FormatArrayMessage(VectorView<std::string_view> payloads_view, Message* msg);
 
 }  // namespace redis
 }  // namespace protocols
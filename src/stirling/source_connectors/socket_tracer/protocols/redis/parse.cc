@@ -74,7 +74,8 @@ StatusOr<int> ParseSize(BinaryDecoder* decoder) {
 }
 
 // Bulk string is formatted as <length>\r\n<actual string, up to 512MB>\r\n
-Status ParseBulkString(BinaryDecoder* decoder, Message* msg) {
+// The returned view points into the decoder's buffer, except for the NULL sentinel.
+StatusOr<std::string_view> ParseBulkString(BinaryDecoder* decoder) {
   PL_ASSIGN_OR_RETURN(int len, ParseSize(decoder));
 
   constexpr int kMaxLen = 512 * 1024 * 1024;
@@ -86,8 +87,7 @@ Status ParseBulkString(BinaryDecoder* decoder, Message* msg) {
     constexpr std::string_view kNullBulkString = "<NULL>";
     // TODO(yzhao): This appears wrong, as Redis has NULL value, here "<NULL>" is presented as
     // a string. ATM don't know how to output NULL value in Rapidjson. Research and update this.
-    msg->payload = kNullBulkString;
-    return Status::OK();
+    return kNullBulkString;
   }
 
   PL_ASSIGN_OR_RETURN(std::string_view payload,
@@ -96,11 +96,10 @@ Status ParseBulkString(BinaryDecoder* decoder, Message* msg) {
     return error::InvalidArgument("Bulk string should be terminated by '$0'", kTerminalSequence);
   }
   payload.remove_suffix(kTerminalSequence.size());
-  msg->payload = payload;
-  return Status::OK();
+  return payload;
 }
 
-bool IsPubMsg(const std::vector<std::string>& payloads) {
+bool IsPubMsg(const std::vector<std::string_view>& payloads) {
   // Published message format is at https://redis.io/topics/pubsub#format-of-pushed-messages
   constexpr size_t kArrayPayloadSize = 3;
   if (payloads.size() < kArrayPayloadSize) {
@@ -113,6 +112,36 @@ bool IsPubMsg(const std::vector<std::string>& payloads) {
   return true;
 }
 
+// Tokenizes the elements of an array in a single pass, as views into the decoder's buffer.
+// Returns false as soon as a nested array is encountered; the caller then falls back to the
+// recursive path, restarting from a saved copy of the decoder.
+StatusOr<bool> TokenizeFlatArray(int len, BinaryDecoder* decoder,
+                                 std::vector<std::string_view>* tokens) {
+  for (int i = 0; i < len; ++i) {
+    PL_ASSIGN_OR_RETURN(const char type_marker, decoder->ExtractChar());
+    switch (type_marker) {
+      case kSimpleStringMarker:
+      case kErrorMarker:
+      case kIntegerMarker: {
+        PL_ASSIGN_OR_RETURN(std::string_view str, decoder->ExtractStringUntil(kTerminalSequence));
+        tokens->push_back(str);
+        break;
+      }
+      case kBulkStringsMarker: {
+        PL_ASSIGN_OR_RETURN(std::string_view str, ParseBulkString(decoder));
+        tokens->push_back(str);
+        break;
+      }
+      case kArrayMarker:
+        return false;
+      default:
+        return error::InvalidArgument(
+            "Unexpected Redis type marker char (displayed as integer): %d", type_marker);
+    }
+  }
+  return true;
+}
+
 // This calls ParseMessage(), which eventually calls ParseArray() and are both recursive
 // functions. This is because Array message can include nested array messages.
 Status ParseArray(message_type_t type, BinaryDecoder* decoder, Message* msg);
@@ -127,7 +156,8 @@ Status ParseMessage(message_type_t type, BinaryDecoder* decoder, Message* msg) {
       break;
     }
     case kBulkStringsMarker: {
-      PL_RETURN_IF_ERROR(ParseBulkString(decoder, msg));
+      PL_ASSIGN_OR_RETURN(std::string_view str, ParseBulkString(decoder));
+      msg->payload = str;
       break;
     }
     case kErrorMarker: {
@@ -161,16 +191,38 @@ Status ParseArray(message_type_t type, BinaryDecoder* decoder, Message* msg) {
     return Status::OK();
   }
 
+  // Pipelined clients send long runs of flat arrays of scalars (a command and its arguments).
+  // Those are tokenized in a single pass into a token arena that is reused across messages on
+  // this thread, avoiding a Message and a std::string allocation per element. Arrays with
+  // nested arrays are rare, and fall back to the recursive path below.
+  static thread_local std::vector<std::string_view> token_arena;
+  token_arena.clear();
+  const BinaryDecoder elements_start = *decoder;
+  PL_ASSIGN_OR_RETURN(const bool is_flat, TokenizeFlatArray(len, decoder, &token_arena));
+
+  if (is_flat) {
+    FormatArrayMessage(VectorView<std::string_view>(token_arena), msg);
+
+    if (type == message_type_t::kResponse && IsPubMsg(token_arena)) {
+      msg->is_published_message = true;
+    }
+
+    return Status::OK();
+  }
+
+  *decoder = elements_start;
   std::vector<std::string> payloads;
+  payloads.reserve(len);
   for (int i = 0; i < len; ++i) {
     Message tmp;
     PL_RETURN_IF_ERROR(ParseMessage(type, decoder, &tmp));
     payloads.push_back(std::move(tmp.payload));
   }
 
-  FormatArrayMessage(VectorView<std::string>(payloads), msg);
+  std::vector<std::string_view> payload_views(payloads.begin(), payloads.end());
+  FormatArrayMessage(VectorView<std::string_view>(payload_views), msg);
 
-  if (type == message_type_t::kResponse && IsPubMsg(payloads)) {
+  if (type == message_type_t::kResponse && IsPubMsg(payload_views)) {
     msg->is_published_message = true;
   }
 
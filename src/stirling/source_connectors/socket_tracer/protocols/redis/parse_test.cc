@@ -19,6 +19,7 @@
 #include "src/stirling/source_connectors/socket_tracer/protocols/redis/parse.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/common/testing/testing.h"
@@ -138,6 +139,39 @@ TEST(ParsePubMsgTest, DetectPublishedMessage) {
   EXPECT_TRUE(msg.is_published_message);
 }
 
+TEST(ParsePipelinedTest, ContiguousCommandsParsedSequentially) {
+  // Simulates a pipelined client: multiple commands in one contiguous buffer.
+  std::string_view buf =
+      "*3\r\n$6\r\nappend\r\n$3\r\nfoo\r\n$3\r\nbar\r\n"
+      "*2\r\n$7\r\nzpopmax\r\n$3\r\nfoo\r\n"
+      "*3\r\n$6\r\nswapdb\r\n$3\r\nfoo\r\n$3\r\nbar\r\n";
+
+  const std::vector<std::pair<std::string_view, std::string_view>> expected = {
+      {"APPEND", R"({"key":"foo","value":"bar"})"},
+      {"ZPOPMAX", R"({"key":"foo"})"},
+      {"SWAPDB", R"({"index1":"foo","index2":"bar"})"},
+  };
+
+  for (const auto& [command, payload] : expected) {
+    Message msg;
+    EXPECT_EQ(ParseFrame(message_type_t::kRequest, &buf, &msg), ParseState::kSuccess);
+    EXPECT_THAT(std::string(msg.command), StrEq(std::string(command)));
+    EXPECT_THAT(msg.payload, StrEq(std::string(payload)));
+  }
+  EXPECT_THAT(buf, IsEmpty());
+}
+
+TEST(ParseNestedArrayTest, FallsBackToRecursiveParsing) {
+  // Transaction (EXEC) responses commonly contain nested arrays, which are excluded from the
+  // single-pass flat-array tokenization.
+  std::string_view buf = "*2\r\n*2\r\n+OK\r\n:1\r\n$3\r\nfoo\r\n";
+  Message msg;
+
+  EXPECT_EQ(ParseFrame(message_type_t::kResponse, &buf, &msg), ParseState::kSuccess);
+  EXPECT_THAT(buf, IsEmpty());
+  EXPECT_THAT(msg.payload, StrEq(R"(["[\"OK\",\"1\"]","foo"])"));
+}
+
 class ParseIncompleteInputTest : public ::testing::TestWithParam<std::string> {};
 
 TEST_P(ParseIncompleteInputTest, IncompleteInput) {
@@ -160,7 +194,7 @@ INSTANTIATE_TEST_SUITE_P(
                       "*3\r\n+OK\r\n-Error message\r\n$11\r", "*3\r\n+OK\r\n-Error message\r\n$11",
                       "*3\r\n+OK\r\n-Error message\r\n", "*3\r\n+OK\r\n-Error message\r",
                       "*3\r\n+OK\r\n-Error message", "*3\r\n+OK\r\n", "*3\r\n+OK\r", "*3\r\n+OK",
-                      "*3\r\n", "*3\r", "*3"));
+                      "*3\r\n", "*3\r", "*3", "*2\r\n*1\r\n+OK\r\n"));
 
 class ParseInvalidInputTest : public ::testing::TestWithParam<std::string> {};
 
@@ -22,6 +22,7 @@
 #include <variant>
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/amqp/types_gen.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/frame_pool.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/cql/types.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/dns/types.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/types.h"
@@ -50,6 +51,21 @@ using FrameDequeVariant = std::variant<std::monostate,
                                        std::deque<kafka::Packet>,
                                        std::deque<nats::Message>,
                                        std::deque<amqp::Frame>>;
+
+// Pools of dead frames whose buffers can be reused by newly parsed frames.
+// Mirrors the structure of FrameDequeVariant above.
+// PROTOCOL_LIST: Requires update on new protocols.
+using FramePoolVariant = std::variant<std::monostate,
+                                      FramePool<cass::Frame>,
+                                      FramePool<http::Message>,
+                                      FramePool<mux::Frame>,
+                                      FramePool<mysql::Packet>,
+                                      FramePool<pgsql::RegularMessage>,
+                                      FramePool<dns::Frame>,
+                                      FramePool<redis::Message>,
+                                      FramePool<kafka::Packet>,
+                                      FramePool<nats::Message>,
+                                      FramePool<amqp::Frame>>;
 // clang-format off
 
 }  // namespace protocols
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/stirling/bpf_tools/bcc_wrapper.h"
@@ -42,6 +43,13 @@ class ConnInfoMapManager {
 
   void CleanupBPFMapLeaks(ConnTrackersManager* conn_trackers_mgr);
 
+  // Reads out all conn_info_map entries. Used for periodic in-kernel conn stats collection,
+  // where BPF aggregates per-connection byte counters in the map instead of submitting
+  // steady-state events through the perf buffer.
+  std::vector<std::pair<uint64_t, struct conn_info_t>> FetchAllEntries() {
+    return conn_info_map_.get_table_offline();
+  }
+
  private:
   ebpf::BPFHashTable<uint64_t, struct conn_info_t> conn_info_map_;
   ebpf::BPFHashTable<uint64_t, uint64_t> conn_disabled_map_;
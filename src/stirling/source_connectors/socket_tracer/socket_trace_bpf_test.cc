@@ -107,11 +107,13 @@ class SocketTraceBPFTest
   StatusOr<ConnTracker*> GetMutableConnTracker(int pid, int fd) {
     conn_id_t conn_id;
     conn_id.tsid = 0;
-    for (const auto* conn_tracker : source_->conn_trackers_mgr_.active_trackers()) {
-      if (conn_tracker->conn_id().upid.pid == static_cast<uint32_t>(pid) &&
-          conn_tracker->conn_id().fd == fd) {
-        conn_id = conn_tracker->conn_id();
-        break;
+    for (size_t shard = 0; shard < source_->conn_trackers_mgr_.num_shards(); ++shard) {
+      for (const auto* conn_tracker : source_->conn_trackers_mgr_.active_trackers(shard)) {
+        if (conn_tracker->conn_id().upid.pid == static_cast<uint32_t>(pid) &&
+            conn_tracker->conn_id().fd == fd) {
+          conn_id = conn_tracker->conn_id();
+          break;
+        }
       }
     }
     // If tsid=0 then the above loop didn't find any conn trackers with the same {pid, fd} pair.
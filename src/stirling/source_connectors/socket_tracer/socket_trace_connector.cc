@@ -18,12 +18,16 @@
 
 #include "src/stirling/source_connectors/socket_tracer/socket_trace_connector.h"
 
+#include <arpa/inet.h>
 #include <sys/sysinfo.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 #include <absl/container/flat_hash_map.h>
@@ -42,6 +46,7 @@
 #include "src/stirling/source_connectors/socket_tracer/bcc_bpf_intf/go_grpc_types.hpp"
 #include "src/stirling/source_connectors/socket_tracer/bcc_bpf_intf/socket_trace.hpp"
 #include "src/stirling/source_connectors/socket_tracer/conn_stats.h"
+#include "src/stirling/source_connectors/socket_tracer/metrics.h"
 #include "src/stirling/source_connectors/socket_tracer/proto/sock_event.pb.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/utils.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/http2/grpc.h"
@@ -61,6 +66,25 @@ DEFINE_uint32(stirling_socket_tracer_stats_logging_ratio,
 DEFINE_bool(stirling_enable_periodic_bpf_map_cleanup, true,
             "Disable periodic BPF map cleanup (for testing)");
 
+DEFINE_bool(stirling_enable_in_kernel_conn_stats, true,
+            "If true, steady-state connection byte counters are aggregated in-kernel in "
+            "conn_info_map and read periodically, rather than submitted as individual perf "
+            "buffer events. Events are still submitted on connection close.");
+
+DEFINE_uint32(stirling_socket_tracer_transfer_threads, 4,
+              "Number of threads used to parse connection trackers into records during "
+              "TransferData. Tracker shards are parsed in parallel, while record appends stay "
+              "on the main thread. A value of 1 disables parallelism.");
+
+DEFINE_bool(stirling_enable_in_kernel_cidr_filtering, true,
+            "If true, data events on client-side connections to endpoints inside the cluster "
+            "are dropped in-kernel using the cluster CIDRs, instead of being discarded in "
+            "user-space after inspection.");
+
+DEFINE_bool(stirling_enable_adaptive_perf_buffer_drain, true,
+            "If true, idle perf buffers are drained less frequently, while buffers showing "
+            "activity or event loss are drained on every sampling iteration.");
+
 DEFINE_int32(test_only_socket_trace_target_pid, kTraceAllTGIDs,
              "The PID of a process to trace. This forces BPF to export events by ignoring event "
              "filtering. The purpose is to observe the underlying raw events for debugging.");
@@ -165,7 +189,7 @@ SocketTraceConnector::SocketTraceConnector(std::string_view source_name)
 
 void SocketTraceConnector::InitProtocolTransferSpecs() {
 #define TRANSFER_STREAM_PROTOCOL(protocol_name) \
-  &SocketTraceConnector::TransferStream<protocols::protocol_name::ProtocolTraits>
+  &SocketTraceConnector::ParseStream<protocols::protocol_name::ProtocolTraits>
 
   // PROTOCOL_LIST: Requires update on new protocols.
 
@@ -220,7 +244,7 @@ void SocketTraceConnector::InitProtocolTransferSpecs() {
       {kProtocolMongo, TransferSpec{/* trace_mode */ px::stirling::TraceMode::Off,
                                     /* table_num */ static_cast<uint32_t>(-1),
                                     /* trace_roles */ {},
-                                    /* transfer_fn */ nullptr}},
+                                    /* parse_fn */ nullptr}},
       {kProtocolAMQP, TransferSpec{FLAGS_stirling_enable_amqp_tracing,
                                    kAMQPTableNum,
                                    {kRoleClient, kRoleServer},
@@ -228,7 +252,7 @@ void SocketTraceConnector::InitProtocolTransferSpecs() {
       {kProtocolUnknown, TransferSpec{/* trace_mode */ px::stirling::TraceMode::Off,
                                       /* table_num */ static_cast<uint32_t>(-1),
                                       /* trace_roles */ {},
-                                      /* transfer_fn */ nullptr}}};
+                                      /* parse_fn */ nullptr}}};
 #undef TRANSFER_STREAM_PROTOCOL
 
   for (uint64_t i = 0; i < kNumProtocols; ++i) {
@@ -397,6 +421,9 @@ Status SocketTraceConnector::InitBPF() {
       absl::StrCat("-DENABLE_MUX_TRACING=", FLAGS_stirling_enable_mux_tracing),
       absl::StrCat("-DENABLE_AMQP_TRACING=", FLAGS_stirling_enable_amqp_tracing),
       absl::StrCat("-DENABLE_MONGO_TRACING=", "true"),
+      absl::StrCat("-DENABLE_IN_KERNEL_CONN_STATS=", FLAGS_stirling_enable_in_kernel_conn_stats),
+      absl::StrCat("-DENABLE_IN_KERNEL_CIDR_FILTERING=",
+                   FLAGS_stirling_enable_in_kernel_cidr_filtering),
   };
   PL_RETURN_IF_ERROR(InitBPFProgram(socket_trace_bcc_script, defines));
 
@@ -408,6 +435,26 @@ Status SocketTraceConnector::InitBPF() {
   PL_RETURN_IF_ERROR(OpenPerfBuffers(kPerfBufferSpecs, this));
   LOG(INFO) << absl::Substitute("Number of perf buffers opened = $0", kPerfBufferSpecs.size());
 
+  // Set up the adaptive drain schedule. Data-category buffers are the hot path and never back
+  // off; control buffers may be drained less frequently while idle.
+  // Must be consistent with the perf buffer specs above.
+  drain_states_ = {
+      {"socket_data_events", StatKey::kPollSocketDataEventCount, StatKey::kLossSocketDataEvent,
+       /* allow_backoff */ false},
+      {"socket_control_events", StatKey::kPollSocketControlEventCount,
+       StatKey::kLossSocketControlEvent},
+      {"conn_stats_events", StatKey::kPollConnStatsEventCount, StatKey::kLossConnStatsEvent},
+      {"mmap_events", StatKey::kPollMMapEventCount, StatKey::kLossMMapEvent},
+      {"go_grpc_events", StatKey::kPollHTTP2EventCount, StatKey::kLossHTTP2Event,
+       /* allow_backoff */ false},
+      {"grpc_c_events", StatKey::kPollGrpcCEventCount, StatKey::kLossGrpcCEvent,
+       /* allow_backoff */ false},
+      {"grpc_c_header_events", StatKey::kPollGrpcCHeaderEventCount, StatKey::kLossGrpcCHeaderEvent,
+       /* allow_backoff */ false},
+      {"grpc_c_close_events", StatKey::kPollGrpcCCloseEventCount, StatKey::kLossGrpcCCloseEvent,
+       /* allow_backoff */ false},
+  };
+
   // Set trace role to BPF probes.
   for (const auto& p : magic_enum::enum_values<traffic_protocol_t>()) {
     if (protocol_transfer_specs_[p].enabled) {
@@ -419,6 +466,17 @@ Status SocketTraceConnector::InitBPF() {
     }
   }
 
+  // Tell BPF which roles, for each protocol, are subject to the kernel-side cluster CIDR filter.
+  // These are the roles that user-space would disable anyway when the remote endpoint is inside
+  // the cluster (see ConnTracker::UpdateState); roles traced unconditionally are exempt.
+  for (const auto& p : magic_enum::enum_values<traffic_protocol_t>()) {
+    uint64_t role_mask = 0;
+    if (!ShouldTraceProtocolRole(p, kRoleClient)) {
+      role_mask |= kRoleClient;
+    }
+    PL_RETURN_IF_ERROR(UpdateBPFCIDRFilterRole(p, role_mask));
+  }
+
   PL_RETURN_IF_ERROR(TestOnlySetTargetPID());
   if (FLAGS_stirling_disable_self_tracing) {
     PL_RETURN_IF_ERROR(DisableSelfTracing());
@@ -571,18 +629,34 @@ void SocketTraceConnector::UpdateCommonState(ConnectorContext* ctx) {
   // to maintain consistency with how BPF generates timestamps on its events.
   perf_buffer_drain_time_ = AdjustedSteadyClockNowNS();
 
-  // This drains all perf buffers, and causes Handle() callback functions to get called.
-  // Note that it drains *all* perf buffers, not just those that are required for this table,
+  // This drains the perf buffers, and causes Handle() callback functions to get called.
+  // Note that it drains perf buffers that are not required for this table,
   // so raw data will be pushed to connection trackers more aggressively.
   // No data is lost, but this is a side-effect of sorts that affects timing of transfers.
   // It may be worth noting during debug.
-  PollPerfBuffers();
+  if (FLAGS_stirling_enable_adaptive_perf_buffer_drain && !drain_states_.empty()) {
+    PollPerfBuffersAdaptively();
+  } else {
+    PollPerfBuffers();
+  }
 
   // Set-up current state for connection inference purposes.
   if (socket_info_mgr_ != nullptr) {
     socket_info_mgr_->Flush();
   }
 
+  // Keep the kernel-side cluster CIDR filter in sync with the latest view from the metadata
+  // service. The CIDRs rarely change, so only push them down to BPF when they do.
+  if (FLAGS_stirling_enable_in_kernel_cidr_filtering) {
+    std::vector<CIDRBlock> cluster_cidrs = ctx->GetClusterCIDRs();
+    if (cluster_cidrs != current_cluster_cidrs_) {
+      Status s = UpdateBPFClusterCIDRs(cluster_cidrs);
+      LOG_IF(ERROR, !s.ok()) << absl::Substitute("Failed to update BPF cluster CIDR filter: $0",
+                                                 s.msg());
+      current_cluster_cidrs_ = std::move(cluster_cidrs);
+    }
+  }
+
   // Deploy uprobes on newly discovered PIDs.
   std::thread thread = RunDeployUProbesThread(ctx->GetUPIDs());
   // Let it run in the background.
@@ -591,6 +665,7 @@ void SocketTraceConnector::UpdateCommonState(ConnectorContext* ctx) {
   }
 
   conn_trackers_mgr_.CleanupTrackers();
+  conn_trackers_mgr_.EnforceBufferMemoryBudget();
 
   // Periodically check for leaking conn_info_map entries.
   // TODO(oazizi): Track down and plug the leaks, then zap this function.
@@ -604,6 +679,80 @@ void SocketTraceConnector::UpdateCommonState(ConnectorContext* ctx) {
   }
 }
 
+void SocketTraceConnector::PollPerfBuffersAdaptively() {
+  for (auto& state : drain_states_) {
+    if (sampling_freq_mgr_.count() % state.period_multiple != 0) {
+      continue;
+    }
+
+    PollPerfBuffer(state.name);
+
+    int64_t event_count = stats_.Get(state.event_count_key);
+    int64_t loss_count = stats_.Get(state.loss_key);
+    int64_t events_delta = event_count - state.prev_event_count;
+    int64_t loss_delta = loss_count - state.prev_loss_count;
+
+    if (loss_delta > 0) {
+      // The buffer overflowed since the last drain. Drain once more right away to free up space,
+      // instead of letting the backlog sit for another full sampling period.
+      PollPerfBuffer(state.name);
+      event_count = stats_.Get(state.event_count_key);
+      loss_count = stats_.Get(state.loss_key);
+    }
+
+    state.prev_event_count = event_count;
+    state.prev_loss_count = loss_count;
+
+    if (!state.allow_backoff) {
+      continue;
+    }
+
+    if (events_delta > 0 || loss_delta > 0) {
+      // An active or lossy buffer is drained on every sampling iteration.
+      state.period_multiple = 1;
+    } else if (state.period_multiple < kMaxDrainPeriodMultiple) {
+      // An idle buffer backs off exponentially, up to the cap.
+      state.period_multiple *= 2;
+    }
+  }
+}
+
+void SocketTraceConnector::PollConnStatsBPFMap() {
+  if (conn_info_map_mgr_ == nullptr) {
+    return;
+  }
+
+  // All synthesized events in one scan share a timestamp, taken from the same monotonic clock
+  // that BPF uses, so they order correctly against the close events that BPF still submits.
+  const uint64_t timestamp_ns = CurrentSteadyTimeNS();
+
+  for (const auto& [pid_fd, conn_info] : conn_info_map_mgr_->FetchAllEntries()) {
+    // Connections without traffic carry no information for conn stats. Skipping them also
+    // avoids creating trackers for every open fd on the node.
+    if (conn_info.wr_bytes == 0 && conn_info.rd_bytes == 0) {
+      continue;
+    }
+
+    // If the connection already closed, the close event that BPF submitted carries the final
+    // counters, and this map read may be stale. Don't regress the tracker's state.
+    auto tracker_or = conn_trackers_mgr_.GetConnTracker(conn_info.conn_id.upid.pid,
+                                                        conn_info.conn_id.fd);
+    if (tracker_or.ok() && tracker_or.ValueOrDie()->conn_stats().closed()) {
+      continue;
+    }
+
+    conn_stats_event_t event = {};
+    event.timestamp_ns = timestamp_ns;
+    event.conn_id = conn_info.conn_id;
+    event.addr = conn_info.addr;
+    event.role = conn_info.role;
+    event.wr_bytes = conn_info.wr_bytes;
+    event.rd_bytes = conn_info.rd_bytes;
+    event.conn_events = 0;
+    AcceptConnStatsEvent(event);
+  }
+}
+
 void SocketTraceConnector::UpdateTrackerTraceLevel(ConnTracker* tracker) {
   if (pids_to_trace_.contains(tracker->conn_id().upid.pid)) {
     tracker->SetDebugTrace(2);
@@ -622,6 +771,9 @@ void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx,
   DataTable* conn_stats_table = data_tables[kConnStatsTableNum];
   if (conn_stats_table != nullptr &&
       sampling_freq_mgr_.count() % FLAGS_stirling_conn_stats_sampling_ratio == 0) {
+    if (FLAGS_stirling_enable_in_kernel_conn_stats) {
+      PollConnStatsBPFMap();
+    }
     TransferConnStats(ctx, conn_stats_table);
   }
 
@@ -629,6 +781,7 @@ void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx,
     conn_trackers_mgr_.ComputeProtocolStats();
     LOG(INFO) << "ConnTracker statistics: " << conn_trackers_mgr_.StatsString();
     LOG(INFO) << "SocketTracer statistics: " << stats_.Print();
+    SocketTracerMetrics::SyncProtocolMetrics();
   }
 
   constexpr auto kDebugDumpPeriod = std::chrono::minutes(1);
@@ -652,39 +805,86 @@ void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx,
     }
   }
 
-  for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers()) {
-    const auto& transfer_spec = protocol_transfer_specs_[conn_tracker->protocol()];
+  // Pre-tick phase: update per-tracker state ahead of parsing.
+  for (size_t shard = 0; shard < conn_trackers_mgr_.num_shards(); ++shard) {
+    for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers(shard)) {
+      UpdateTrackerTraceLevel(conn_tracker);
+
+      // Once a known UPID, always a known UPID.
+      if (!conn_tracker->is_tracked_upid()) {
+        md::UPID upid(ctx->GetASID(), conn_tracker->conn_id().upid.pid,
+                      conn_tracker->conn_id().upid.start_time_ticks);
+        if (ctx->GetUPIDs().contains(upid)) {
+          conn_tracker->set_is_tracked_upid();
+        }
+      }
 
-    DataTable* data_table = nullptr;
-    if (transfer_spec.enabled) {
-      data_table = data_tables[transfer_spec.table_num];
+      conn_tracker->IterationPreTick(iteration_time_, cluster_cidrs, proc_parser_.get(),
+                                     socket_info_mgr_.get());
     }
+  }
 
-    UpdateTrackerTraceLevel(conn_tracker);
+  // Parse phase: trackers are parsed into records shard-by-shard. Shards hold disjoint tracker
+  // sets and parsing only touches tracker-local state, so shards can be parsed in parallel
+  // without locks. Record appends touch the shared DataTables, so they are deferred to the
+  // append phase below.
+  std::vector<std::vector<std::function<void()>>> append_fns(conn_trackers_mgr_.num_shards());
+  auto parse_shard_fn = [&](size_t shard) {
+    for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers(shard)) {
+      const auto& transfer_spec = protocol_transfer_specs_[conn_tracker->protocol()];
+
+      DataTable* data_table = nullptr;
+      if (transfer_spec.enabled) {
+        data_table = data_tables[transfer_spec.table_num];
+      }
 
-    // Once a known UPID, always a known UPID.
-    if (!conn_tracker->is_tracked_upid()) {
-      md::UPID upid(ctx->GetASID(), conn_tracker->conn_id().upid.pid,
-                    conn_tracker->conn_id().upid.start_time_ticks);
-      if (ctx->GetUPIDs().contains(upid)) {
-        conn_tracker->set_is_tracked_upid();
+      if (transfer_spec.parse_fn != nullptr) {
+        auto append_fn = transfer_spec.parse_fn(*this, ctx, conn_tracker, data_table);
+        if (append_fn) {
+          append_fns[shard].push_back(std::move(append_fn));
+        }
+      } else {
+        // If there's no parse function, then the tracker should not be holding any data.
+        // http::ProtocolTraits is used as a placeholder; the frames deque is expected to be
+        // std::monotstate.
+        ECHECK(conn_tracker->send_data().Empty<protocols::http::Message>());
+        ECHECK(conn_tracker->recv_data().Empty<protocols::http::Message>());
       }
     }
+  };
 
-    conn_tracker->IterationPreTick(iteration_time_, cluster_cidrs, proc_parser_.get(),
-                                   socket_info_mgr_.get());
-
-    if (transfer_spec.transfer_fn != nullptr) {
-      transfer_spec.transfer_fn(*this, ctx, conn_tracker, data_table);
-    } else {
-      // If there's no transfer function, then the tracker should not be holding any data.
-      // http::ProtocolTraits is used as a placeholder; the frames deque is expected to be
-      // std::monotstate.
-      ECHECK(conn_tracker->send_data().Empty<protocols::http::Message>());
-      ECHECK(conn_tracker->recv_data().Empty<protocols::http::Message>());
+  const size_t num_threads =
+      std::min<size_t>(std::max<uint32_t>(FLAGS_stirling_socket_tracer_transfer_threads, 1),
+                       conn_trackers_mgr_.num_shards());
+  if (num_threads <= 1) {
+    for (size_t shard = 0; shard < conn_trackers_mgr_.num_shards(); ++shard) {
+      parse_shard_fn(shard);
     }
+  } else {
+    std::atomic<size_t> next_shard(0);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      workers.emplace_back([&]() {
+        for (size_t shard = next_shard.fetch_add(1); shard < conn_trackers_mgr_.num_shards();
+             shard = next_shard.fetch_add(1)) {
+          parse_shard_fn(shard);
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
 
-    conn_tracker->IterationPostTick();
+  // Append phase: push the parsed records into the data tables, and finish the iteration.
+  for (size_t shard = 0; shard < conn_trackers_mgr_.num_shards(); ++shard) {
+    for (auto& append_fn : append_fns[shard]) {
+      append_fn();
+    }
+    for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers(shard)) {
+      conn_tracker->IterationPostTick();
+    }
   }
 
   // Once we've cleared all the debug trace levels for this pid, we can remove it from the list.
@@ -698,6 +898,85 @@ Status SocketTraceConnector::UpdateBPFProtocolTraceRole(traffic_protocol_t proto
                                            &control_map_handle);
 }
 
+Status SocketTraceConnector::UpdateBPFCIDRFilterRole(traffic_protocol_t protocol,
+                                                     uint64_t role_mask) {
+  auto cidr_role_map_handle = GetPerCPUArrayTable<uint64_t>(kCIDRFilterRoleMapName);
+  return bpf_tools::UpdatePerCPUArrayValue(static_cast<int>(protocol), role_mask,
+                                           &cidr_role_map_handle);
+}
+
+namespace {
+
+// Converts a CIDRBlock into the pre-masked form that BPF matches against remote addresses.
+// See struct cluster_cidr_t for the format.
+struct cluster_cidr_t ToBPFClusterCIDR(const CIDRBlock& cidr) {
+  struct cluster_cidr_t out = {};
+  if (cidr.ip_addr.family == InetAddrFamily::kIPv4) {
+    out.sa_family = AF_INET;
+    uint32_t mask = (cidr.prefix_length == 0) ? 0 : htonl(~0U << (32 - cidr.prefix_length));
+    out.mask[0] = mask;
+    out.addr[0] = std::get<struct in_addr>(cidr.ip_addr.addr).s_addr & mask;
+  } else {
+    DCHECK(cidr.ip_addr.family == InetAddrFamily::kIPv6);
+    out.sa_family = AF_INET6;
+    const struct in6_addr& addr6 = std::get<struct in6_addr>(cidr.ip_addr.addr);
+    for (int word = 0; word < 4; ++word) {
+      int bits = std::clamp<int>(static_cast<int>(cidr.prefix_length) - 32 * word, 0, 32);
+      uint32_t mask = (bits == 0) ? 0 : htonl(~0U << (32 - bits));
+      out.mask[word] = mask;
+      out.addr[word] = addr6.s6_addr32[word] & mask;
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+Status SocketTraceConnector::UpdateBPFClusterCIDRs(const std::vector<CIDRBlock>& cluster_cidrs) {
+  // Mirror ConnTracker::IsRemoteAddrInCluster(): loopback addresses count as in-cluster, and
+  // IPv4 CIDRs must also match connections reported with IPv4-mapped IPv6 addresses.
+  std::vector<CIDRBlock> cidrs = cluster_cidrs;
+  if (!cluster_cidrs.empty() && FLAGS_treat_loopback_as_in_cluster) {
+    CIDRBlock loopback_cidr4;
+    CIDRBlock loopback_cidr6;
+    PL_RETURN_IF_ERROR(ParseCIDRBlock("127.0.0.0/8", &loopback_cidr4));
+    PL_RETURN_IF_ERROR(ParseCIDRBlock("::1/128", &loopback_cidr6));
+    cidrs.push_back(std::move(loopback_cidr4));
+    cidrs.push_back(std::move(loopback_cidr6));
+  }
+  const size_t num_base_cidrs = cidrs.size();
+  for (size_t i = 0; i < num_base_cidrs; ++i) {
+    if (cidrs[i].ip_addr.family == InetAddrFamily::kIPv4) {
+      cidrs.push_back(MapIPv4ToIPv6(cidrs[i]));
+    }
+  }
+
+  if (cidrs.size() > static_cast<size_t>(kMaxClusterCIDRs)) {
+    // A truncated list is safe: connections to the CIDRs that didn't fit are still disabled by
+    // user-space after inspection; they just don't benefit from kernel-side filtering.
+    LOG_FIRST_N(WARNING, 10) << absl::Substitute(
+        "Kernel-side CIDR filter supports up to $0 CIDRs; got $1. Dropping the excess.",
+        kMaxClusterCIDRs, cidrs.size());
+    cidrs.resize(kMaxClusterCIDRs);
+  }
+
+  auto cluster_cidrs_handle = GetArrayTable<struct cluster_cidr_t>(kClusterCIDRsMapName);
+  for (int i = 0; i < kMaxClusterCIDRs; ++i) {
+    struct cluster_cidr_t entry = {};
+    if (static_cast<size_t>(i) < cidrs.size()) {
+      entry = ToBPFClusterCIDR(cidrs[i]);
+    }
+    ebpf::StatusTuple update_res = cluster_cidrs_handle.update_value(i, entry);
+    if (!update_res.ok()) {
+      return error::Internal(absl::Substitute(
+          "Failed to update cluster CIDR filter on index: $0, error message: $1", i,
+          update_res.msg()));
+    }
+  }
+
+  return Status::OK();
+}
+
 Status SocketTraceConnector::TestOnlySetTargetPID() {
   int64_t pid = FLAGS_test_only_socket_trace_target_pid;
   if (pid != kTraceAllTGIDs) {
@@ -762,6 +1041,7 @@ void SocketTraceConnector::HandleDataEventLoss(void* cb_cookie, uint64_t lost) {
 void SocketTraceConnector::HandleControlEvent(void* cb_cookie, void* data, int /*data_size*/) {
   DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
   auto* connector = static_cast<SocketTraceConnector*>(cb_cookie);
+  connector->stats_.Increment(StatKey::kPollSocketControlEventCount);
   connector->AcceptControlEvent(*static_cast<const socket_control_event_t*>(data));
 }
 
@@ -774,6 +1054,7 @@ void SocketTraceConnector::HandleControlEventLoss(void* cb_cookie, uint64_t lost
 void SocketTraceConnector::HandleConnStatsEvent(void* cb_cookie, void* data, int /*data_size*/) {
   DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
   auto* connector = static_cast<SocketTraceConnector*>(cb_cookie);
+  connector->stats_.Increment(StatKey::kPollConnStatsEventCount);
   connector->AcceptConnStatsEvent(*static_cast<const conn_stats_event_t*>(data));
 }
 
@@ -786,6 +1067,7 @@ void SocketTraceConnector::HandleConnStatsEventLoss(void* cb_cookie, uint64_t lo
 void SocketTraceConnector::HandleMMapEvent(void* cb_cookie, void* data, int /*data_size*/) {
   DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
   auto* connector = static_cast<SocketTraceConnector*>(cb_cookie);
+  connector->stats_.Increment(StatKey::kPollMMapEventCount);
   connector->uprobe_mgr_.NotifyMMapEvent(*static_cast<upid_t*>(data));
 }
 
@@ -798,6 +1080,7 @@ void SocketTraceConnector::HandleHTTP2Event(void* cb_cookie, void* data, int /*d
   DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
 
   auto* connector = static_cast<SocketTraceConnector*>(cb_cookie);
+  connector->stats_.Increment(StatKey::kPollHTTP2EventCount);
 
   // Note: Directly accessing data through the data pointer can result in mis-aligned accesses.
   // This is because the perf buffer data starts at an offset of 4 bytes.
@@ -844,6 +1127,7 @@ void SocketTraceConnector::HandleGrpcCHeaderEvent(void* cb_cookie, void* data, i
   DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
 
   auto* connector = static_cast<SocketTraceConnector*>(cb_cookie);
+  connector->stats_.Increment(StatKey::kPollGrpcCHeaderEventCount);
   struct grpc_c_header_event_data_t* event_data =
       static_cast<struct grpc_c_header_event_data_t*>(data);
   // TODO(yzhao): Implement a C++ companion of the C struct so that smart object management applies.
@@ -857,6 +1141,7 @@ void SocketTraceConnector::HandleGrpcCEvent(void* cb_cookie, void* data, int /*d
   DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
 
   auto* connector = static_cast<SocketTraceConnector*>(cb_cookie);
+  connector->stats_.Increment(StatKey::kPollGrpcCEventCount);
   struct grpc_c_event_data_t* event_data = static_cast<struct grpc_c_event_data_t*>(data);
   // TODO(yzhao): Implement a C++ companion of the C struct so that smart object management applies.
   auto event = std::make_unique<struct grpc_c_event_data_t>(*event_data);
@@ -869,6 +1154,7 @@ void SocketTraceConnector::HandleGrpcCCloseEvent(void* cb_cookie, void* data, in
   DCHECK(cb_cookie != nullptr) << "Perf buffer callback not set-up properly. Missing cb_cookie.";
 
   auto* connector = static_cast<SocketTraceConnector*>(cb_cookie);
+  connector->stats_.Increment(StatKey::kPollGrpcCCloseEventCount);
   struct grpc_c_stream_closed_data* event_data =
       static_cast<struct grpc_c_stream_closed_data*>(data);
   auto event = std::make_unique<struct grpc_c_stream_closed_data>(*event_data);
@@ -1091,52 +1377,146 @@ std::string PXInfoString(const ConnTracker& conn_tracker, const TRecordType& rec
   return absl::Substitute("conn_tracker=$0 record=$1", conn_tracker.ToString(), record.ToString());
 }
 
-}  // namespace
+// Serializes HTTP2 headers to JSON, with memoization.
+// gRPC workloads repeat identical header sets (same :path, same user-agent, etc.) across the
+// streams of a connection, so each distinct header set is serialized once and the JSON is reused.
+// Note: the cache is not protected by a lock. AppendMessage() only runs in the append phase of
+// TransferDataImpl(), which is single-threaded (see ParseStream() for the threading contract).
+std::string HTTP2HeadersToJSON(const protocols::http2::NVMap& headers) {
+  // Bounds the memory held by the cache. When the limit is hit, the cache is simply cleared;
+  // the working set of distinct header sets is expected to stay far below this limit.
+  constexpr size_t kMaxCacheEntries = 4096;
 
-template <>
-void SocketTraceConnector::AppendMessage(ConnectorContext* ctx, const ConnTracker& conn_tracker,
-                                         protocols::http::Record record, DataTable* data_table) {
-  protocols::http::Message& req_message = record.req;
-  protocols::http::Message& resp_message = record.resp;
+  static absl::flat_hash_map<protocols::http2::NVMap, std::string> cache;
 
-  // Currently decompresses gzip content, but could handle other transformations too.
-  // Note that we do this after filtering to avoid burning CPU cycles unnecessarily.
-  protocols::http::PreProcessMessage(&resp_message);
+  auto iter = cache.find(headers);
+  if (iter != cache.end()) {
+    return iter->second;
+  }
 
-  md::UPID upid(ctx->GetASID(), conn_tracker.conn_id().upid.pid,
-                conn_tracker.conn_id().upid.start_time_ticks);
+  std::string json = ToJSONString(headers);
 
-  HTTPContentType content_type = HTTPContentType::kUnknown;
-  if (protocols::http::IsJSONContent(resp_message)) {
-    content_type = HTTPContentType::kJSON;
+  if (cache.size() >= kMaxCacheEntries) {
+    cache.clear();
   }
+  cache.emplace(headers, json);
 
-  DataTable::RecordBuilder<&kHTTPTable> r(data_table, resp_message.timestamp_ns);
-  r.Append<r.ColIndex("time_")>(resp_message.timestamp_ns);
-  r.Append<r.ColIndex("upid")>(upid.value());
-  // Note that there is a string copy here,
-  // But std::move is not allowed because we re-use conn object.
-  r.Append<r.ColIndex("remote_addr")>(conn_tracker.remote_endpoint().AddrStr());
-  r.Append<r.ColIndex("remote_port")>(conn_tracker.remote_endpoint().port());
-  r.Append<r.ColIndex("trace_role")>(conn_tracker.role());
-  r.Append<r.ColIndex("major_version")>(1);
-  r.Append<r.ColIndex("minor_version")>(resp_message.minor_version);
-  r.Append<r.ColIndex("content_type")>(static_cast<uint64_t>(content_type));
-  r.Append<r.ColIndex("req_headers")>(ToJSONString(req_message.headers), kMaxHTTPHeadersBytes);
-  r.Append<r.ColIndex("req_method")>(std::move(req_message.req_method));
-  r.Append<r.ColIndex("req_path")>(std::move(req_message.req_path));
-  r.Append<r.ColIndex("req_body_size")>(req_message.body_size);
-  r.Append<r.ColIndex("req_body")>(std::move(req_message.body), FLAGS_max_body_bytes);
-  r.Append<r.ColIndex("resp_headers")>(ToJSONString(resp_message.headers), kMaxHTTPHeadersBytes);
-  r.Append<r.ColIndex("resp_status")>(resp_message.resp_status);
-  r.Append<r.ColIndex("resp_message")>(std::move(resp_message.resp_message));
-  r.Append<r.ColIndex("resp_body_size")>(resp_message.body_size);
-  r.Append<r.ColIndex("resp_body")>(std::move(resp_message.body), FLAGS_max_body_bytes);
-  r.Append<r.ColIndex("latency")>(
-      CalculateLatency(req_message.timestamp_ns, resp_message.timestamp_ns));
+  return json;
+}
+
+// Extracts the propagated trace ID from an HTTP2 header block. HTTP2 header names are
+// transmitted lowercase, so the lookups are plain (case-sensitive) multimap finds.
+std::string HTTP2TraceID(const protocols::http2::NVMap& headers) {
+  auto iter = headers.find("traceparent");
+  if (iter != headers.end()) {
+    return std::string(protocols::http::TraceIDFromTraceparent(iter->second));
+  }
+  iter = headers.find("x-b3-traceid");
+  if (iter != headers.end()) {
+    return iter->second;
+  }
+  iter = headers.find("b3");
+  if (iter != headers.end()) {
+    return std::string(protocols::http::TraceIDFromB3(iter->second));
+  }
+  return "";
+}
+
+// Mirrors RecordBuilder's per-Append() truncation, for the columnar HTTP path where columns
+// use different limits. The columnar builder applies one limit to every string column, so the
+// per-column limits are applied while filling instead.
+void TruncateStringField(types::StringValue* val, size_t max_bytes) {
+  if (val->size() > max_bytes) {
+    val->resize(max_bytes);
+    val->append(DataTable::kTruncatedMsg);
+  }
+  val->shrink_to_fit();
+}
+
+}  // namespace
+
+void SocketTraceConnector::AppendHTTPRecords(ConnectorContext* ctx,
+                                             const ConnTracker& conn_tracker,
+                                             std::vector<protocols::http::Record> records,
+                                             DataTable* data_table) {
+  // The default string limit of RecordBuilder::Append(), applied to the columns without their
+  // own limit.
+  constexpr size_t kMaxStringBytes = 1024;
+
+  md::UPID upid(ctx->GetASID(), conn_tracker.conn_id().upid.pid,
+                conn_tracker.conn_id().upid.start_time_ticks);
+  types::StringValue remote_addr = conn_tracker.remote_endpoint().AddrStr();
+  TruncateStringField(&remote_addr, kMaxStringBytes);
+  const int remote_port = conn_tracker.remote_endpoint().port();
+
+  // Every string is pre-truncated to its own limit while filling, so the builder-wide limit
+  // only needs to be large enough to never re-truncate.
+  const size_t max_string_bytes =
+      std::max<size_t>(kMaxHTTPHeadersBytes, FLAGS_max_body_bytes) +
+      sizeof(DataTable::kTruncatedMsg);
+  DataTable::ColumnarRecordBuilder<&kHTTPTable> b(data_table, max_string_bytes);
+  b.Reserve(records.size());
+  for (auto& record : records) {
+    protocols::http::Message& req_message = record.req;
+    protocols::http::Message& resp_message = record.resp;
+
+    // Currently decompresses gzip content, but could handle other transformations too.
+    // Note that we do this after filtering to avoid burning CPU cycles unnecessarily.
+    protocols::http::PreProcessMessage(&resp_message);
+
+    HTTPContentType content_type = HTTPContentType::kUnknown;
+    if (protocols::http::IsJSONContent(resp_message)) {
+      content_type = HTTPContentType::kJSON;
+    }
+
+    b.Times().push_back(resp_message.timestamp_ns);
+    b.Column<b.ColIndex("time_")>().push_back(resp_message.timestamp_ns);
+    b.Column<b.ColIndex("upid")>().push_back(upid.value());
+    // Note that there is a string copy here: the endpoint is shared by all of the connection's
+    // records.
+    b.Column<b.ColIndex("remote_addr")>().push_back(remote_addr);
+    b.Column<b.ColIndex("remote_port")>().push_back(remote_port);
+    b.Column<b.ColIndex("trace_role")>().push_back(conn_tracker.role());
+    b.Column<b.ColIndex("major_version")>().push_back(1);
+    b.Column<b.ColIndex("minor_version")>().push_back(resp_message.minor_version);
+    b.Column<b.ColIndex("content_type")>().push_back(static_cast<uint64_t>(content_type));
+
+    types::StringValue req_headers = ToJSONString(req_message.headers);
+    TruncateStringField(&req_headers, kMaxHTTPHeadersBytes);
+    b.Column<b.ColIndex("req_headers")>().push_back(std::move(req_headers));
+    types::StringValue trace_id = protocols::http::ExtractTraceID(req_message.headers);
+    TruncateStringField(&trace_id, kMaxStringBytes);
+    types::StringValue req_method = std::move(req_message.req_method);
+    TruncateStringField(&req_method, kMaxStringBytes);
+    b.Column<b.ColIndex("req_method")>().push_back(std::move(req_method));
+    types::StringValue req_path = std::move(req_message.req_path);
+    TruncateStringField(&req_path, kMaxStringBytes);
+    b.Column<b.ColIndex("req_path")>().push_back(std::move(req_path));
+    b.Column<b.ColIndex("req_body_size")>().push_back(req_message.body_size);
+    types::StringValue req_body = std::move(req_message.body);
+    TruncateStringField(&req_body, FLAGS_max_body_bytes);
+    b.Column<b.ColIndex("req_body")>().push_back(std::move(req_body));
+
+    types::StringValue resp_headers = ToJSONString(resp_message.headers);
+    TruncateStringField(&resp_headers, kMaxHTTPHeadersBytes);
+    b.Column<b.ColIndex("resp_headers")>().push_back(std::move(resp_headers));
+    b.Column<b.ColIndex("resp_status")>().push_back(resp_message.resp_status);
+    types::StringValue resp_msg = std::move(resp_message.resp_message);
+    TruncateStringField(&resp_msg, kMaxStringBytes);
+    b.Column<b.ColIndex("resp_message")>().push_back(std::move(resp_msg));
+    b.Column<b.ColIndex("resp_body_size")>().push_back(resp_message.body_size);
+    types::StringValue resp_body = std::move(resp_message.body);
+    TruncateStringField(&resp_body, FLAGS_max_body_bytes);
+    b.Column<b.ColIndex("resp_body")>().push_back(std::move(resp_body));
+    b.Column<b.ColIndex("trace_id")>().push_back(std::move(trace_id));
+    b.Column<b.ColIndex("latency")>().push_back(
+        CalculateLatency(req_message.timestamp_ns, resp_message.timestamp_ns));
 #ifndef NDEBUG
-  r.Append<r.ColIndex("px_info_")>(PXInfoString(conn_tracker, record));
+    types::StringValue px_info = PXInfoString(conn_tracker, record);
+    TruncateStringField(&px_info, kMaxStringBytes);
+    b.Column<b.ColIndex("px_info_")>().push_back(std::move(px_info));
 #endif
+  }
 }
 
 template <>
@@ -1184,9 +1564,11 @@ void SocketTraceConnector::AppendMessage(ConnectorContext* ctx, const ConnTracke
   r.Append<r.ColIndex("major_version")>(2);
   // HTTP2 does not define minor version.
   r.Append<r.ColIndex("minor_version")>(0);
-  r.Append<r.ColIndex("req_headers")>(ToJSONString(req_stream->headers()), kMaxHTTPHeadersBytes);
+  r.Append<r.ColIndex("req_headers")>(HTTP2HeadersToJSON(req_stream->headers()),
+                                      kMaxHTTPHeadersBytes);
   r.Append<r.ColIndex("content_type")>(static_cast<uint64_t>(content_type));
-  r.Append<r.ColIndex("resp_headers")>(ToJSONString(resp_stream->headers()), kMaxHTTPHeadersBytes);
+  r.Append<r.ColIndex("resp_headers")>(HTTP2HeadersToJSON(resp_stream->headers()),
+                                       kMaxHTTPHeadersBytes);
   r.Append<r.ColIndex("req_method")>(
       req_stream->headers().ValueByKey(protocols::http2::headers::kMethod));
   r.Append<r.ColIndex("req_path")>(req_stream->headers().ValueByKey(":path"));
@@ -1200,6 +1582,7 @@ void SocketTraceConnector::AppendMessage(ConnectorContext* ctx, const ConnTracke
   r.Append<r.ColIndex("req_body")>(req_stream->ConsumeData());
   r.Append<r.ColIndex("resp_body_size")>(resp_stream->original_data_size());
   r.Append<r.ColIndex("resp_body")>(resp_stream->ConsumeData());
+  r.Append<r.ColIndex("trace_id")>(HTTP2TraceID(req_stream->headers()));
   int64_t latency_ns = CalculateLatency(req_stream->timestamp_ns, resp_stream->timestamp_ns);
   r.Append<r.ColIndex("latency")>(latency_ns);
   // TODO(yzhao): Remove once http2::Record::bpf_timestamp_ns is removed.
@@ -1272,6 +1655,7 @@ void SocketTraceConnector::AppendMessage(ConnectorContext* ctx, const ConnTracke
   r.Append<r.ColIndex("req_body")>(entry.req.query);
   r.Append<r.ColIndex("resp_header")>(entry.resp.header);
   r.Append<r.ColIndex("resp_body")>(entry.resp.msg);
+  r.Append<r.ColIndex("count")>(entry.count);
   r.Append<r.ColIndex("latency")>(
       CalculateLatency(entry.req.timestamp_ns, entry.resp.timestamp_ns));
 #ifndef NDEBUG
@@ -1415,7 +1799,7 @@ void SocketTraceConnector::AppendMessage(ConnectorContext* ctx, const ConnTracke
 template <>
 void SocketTraceConnector::AppendMessage(ConnectorContext* ctx, const ConnTracker& conn_tracker,
                                          protocols::kafka::Record record, DataTable* data_table) {
-  constexpr size_t kMaxKafkaBodyBytes = 65536;
+  const size_t kafka_body_limit_bytes = FLAGS_kafka_body_limit_bytes;
 
   md::UPID upid(ctx->GetASID(), conn_tracker.conn_id().upid.pid,
                 conn_tracker.conn_id().upid.start_time_ticks);
@@ -1429,8 +1813,8 @@ void SocketTraceConnector::AppendMessage(ConnectorContext* ctx, const ConnTracke
   r.Append<r.ColIndex("trace_role")>(role);
   r.Append<r.ColIndex("req_cmd")>(static_cast<int64_t>(record.req.api_key));
   r.Append<r.ColIndex("client_id")>(std::move(record.req.client_id), FLAGS_max_body_bytes);
-  r.Append<r.ColIndex("req_body")>(std::move(record.req.msg), kMaxKafkaBodyBytes);
-  r.Append<r.ColIndex("resp")>(std::move(record.resp.msg), kMaxKafkaBodyBytes);
+  r.Append<r.ColIndex("req_body")>(std::move(record.req.msg), kafka_body_limit_bytes);
+  r.Append<r.ColIndex("resp")>(std::move(record.resp.msg), kafka_body_limit_bytes);
   r.Append<r.ColIndex("latency")>(
       CalculateLatency(record.req.timestamp_ns, record.resp.timestamp_ns));
 #ifndef NDEBUG
@@ -1498,8 +1882,9 @@ void SocketTraceConnector::WriteDataEvent(const SocketDataEvent& event) {
 //-----------------------------------------------------------------------------
 
 template <typename TProtocolTraits>
-void SocketTraceConnector::TransferStream(ConnectorContext* ctx, ConnTracker* tracker,
-                                          DataTable* data_table) {
+std::function<void()> SocketTraceConnector::ParseStream(ConnectorContext* ctx,
+                                                        ConnTracker* tracker,
+                                                        DataTable* data_table) {
   using TFrameType = typename TProtocolTraits::frame_type;
 
   VLOG(3) << absl::StrCat("Connection\n", DebugString<TProtocolTraits>(*tracker, ""));
@@ -1508,6 +1893,8 @@ void SocketTraceConnector::TransferStream(ConnectorContext* ctx, ConnTracker* tr
   // This is a nop if the containers are already of the right type.
   tracker->InitFrames<TFrameType>();
 
+  std::function<void()> append_fn;
+
   if (data_table != nullptr && tracker->state() == ConnTracker::State::kTransferring) {
     // ProcessToRecords() parses raw events and produces messages in format that are expected by
     // table store. But those messages are not cached inside ConnTracker.
@@ -1515,7 +1902,20 @@ void SocketTraceConnector::TransferStream(ConnectorContext* ctx, ConnTracker* tr
     for (auto& record : records) {
       TProtocolTraits::ConvertTimestamps(
           &record, [&](uint64_t mono_time) { return ConvertToRealTime(mono_time); });
-      AppendMessage(ctx, *tracker, std::move(record), data_table);
+    }
+    if (!records.empty()) {
+      if constexpr (std::is_same_v<TProtocolTraits, protocols::http::ProtocolTraits>) {
+        // The high-volume HTTP path fills columnar batches instead of per-record appends.
+        append_fn = [ctx, tracker, data_table, records = std::move(records)]() mutable {
+          AppendHTTPRecords(ctx, *tracker, std::move(records), data_table);
+        };
+      } else {
+        append_fn = [ctx, tracker, data_table, records = std::move(records)]() mutable {
+          for (auto& record : records) {
+            AppendMessage(ctx, *tracker, std::move(record), data_table);
+          }
+        };
+      }
     }
   }
 
@@ -1527,13 +1927,15 @@ void SocketTraceConnector::TransferStream(ConnectorContext* ctx, ConnTracker* tr
   tracker->Cleanup<TProtocolTraits>(FLAGS_messages_size_limit_bytes,
                                     FLAGS_datastream_buffer_retention_size,
                                     message_expiry_timestamp, buffer_expiry_timestamp);
+
+  return append_fn;
 }
 
 void SocketTraceConnector::TransferConnStats(ConnectorContext* ctx, DataTable* data_table) {
   namespace idx = ::px::stirling::conn_stats_idx;
 
   absl::flat_hash_set<md::UPID> upids = ctx->GetUPIDs();
-  uint64_t time = AdjustedSteadyClockNowNS();
+  uint64_t time = transfer_time_ns();
 
   auto& agg_stats = conn_stats_.UpdateStats();
 
@@ -1558,7 +1960,7 @@ void SocketTraceConnector::TransferConnStats(ConnectorContext* ctx, DataTable* d
 
       r.Append<idx::kTime>(time);
       r.Append<idx::kUPID>(upid.value());
-      r.Append<idx::kRemoteAddr>(key.remote_addr);
+      r.Append<idx::kRemoteAddr>(key.RemoteAddrStr());
       r.Append<idx::kRemotePort>(key.remote_port);
       r.Append<idx::kAddrFamily>(static_cast<int>(stats.addr_family));
       r.Append<idx::kProtocol>(stats.protocol);
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <fstream>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -48,6 +49,7 @@
 #include "src/stirling/utils/linux_headers.h"
 #include "src/stirling/utils/proc_path_tools.h"
 #include "src/stirling/utils/proc_tracker.h"
+#include "src/stirling/utils/sharded_stat_counter.h"
 
 DECLARE_uint32(stirling_conn_stats_sampling_ratio);
 DECLARE_bool(stirling_enable_periodic_bpf_map_cleanup);
@@ -132,6 +134,15 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
   // data from inside BPF to user-space.
   Status UpdateBPFProtocolTraceRole(traffic_protocol_t protocol, uint64_t role_mask);
 
+  // Updates the BPF map value that specifies which role(s) of the given protocol's traffic are
+  // subject to the kernel-side cluster CIDR filter. These are the roles that user-space would
+  // disable when the remote endpoint is inside the cluster (see ConnTracker::UpdateState).
+  Status UpdateBPFCIDRFilterRole(traffic_protocol_t protocol, uint64_t role_mask);
+
+  // Pushes the cluster CIDRs (plus loopback and IPv4-mapped IPv6 forms) into the BPF map
+  // consulted by the kernel-side CIDR filter.
+  Status UpdateBPFClusterCIDRs(const std::vector<CIDRBlock>& cluster_cidrs);
+
   // Instructs Stirling to log detailed debug information about the traced events from the PID
   // specified by --test_only_socket_trace_target_pid.
   Status TestOnlySetTargetPID();
@@ -181,6 +192,15 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
   auto InitPerfBufferSpecs();
   void InitProtocolTransferSpecs();
 
+  // Drains each perf buffer on its own schedule, based on observed activity and losses.
+  // See PerfBufferDrainState below.
+  void PollPerfBuffersAdaptively();
+
+  // Reads the in-kernel per-connection byte counters out of conn_info_map and feeds them into
+  // the conn trackers as synthesized conn_stats events. Used when BPF aggregates conn stats
+  // in-kernel instead of submitting steady-state events through the perf buffer.
+  void PollConnStatsBPFMap();
+
   ConnTracker& GetOrCreateConnTracker(struct conn_id_t conn_id);
 
   // Events from BPF.
@@ -200,8 +220,15 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
       bool outgoing,
       /* OUT */ struct go_grpc_http2_header_event_t* header_event_data_go_style);
 
+  // Parses the tracker's raw events into records, and performs tracker house-keeping
+  // (frame initialization and buffer expiration). This phase only touches tracker-local state,
+  // so different trackers may be parsed concurrently.
+  // Returns a deferred function that appends the parsed records to the data table, or an empty
+  // function if there is nothing to append. The returned function touches the shared DataTable,
+  // and must be run on the main thread.
   template <typename TProtocolTraits>
-  void TransferStream(ConnectorContext* ctx, ConnTracker* tracker, DataTable* data_table);
+  std::function<void()> ParseStream(ConnectorContext* ctx, ConnTracker* tracker,
+                                    DataTable* data_table);
   void TransferConnStats(ConnectorContext* ctx, DataTable* data_table);
 
   void set_iteration_time(std::chrono::time_point<std::chrono::steady_clock> time) {
@@ -216,6 +243,12 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
   static void AppendMessage(ConnectorContext* ctx, const ConnTracker& conn_tracker,
                             TRecordType record, DataTable* data_table);
 
+  // Batch variant of AppendMessage for the high-volume HTTP path: fills per-column vectors via
+  // DataTable::ColumnarRecordBuilder instead of dispatching record-by-record.
+  static void AppendHTTPRecords(ConnectorContext* ctx, const ConnTracker& conn_tracker,
+                                std::vector<protocols::http::Record> records,
+                                DataTable* data_table);
+
   std::thread RunDeployUProbesThread(const absl::flat_hash_set<md::UPID>& pids);
 
   // Setups output file stream object writing to the input file path.
@@ -238,8 +271,11 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
     int32_t trace_mode = TraceMode::Off;
     uint32_t table_num = 0;
     std::vector<endpoint_role_t> trace_roles;
-    std::function<void(SocketTraceConnector&, ConnectorContext*, ConnTracker*, DataTable*)>
-        transfer_fn = nullptr;
+    // Parses a tracker's events into records, returning a deferred append function.
+    // See ParseStream() for the threading contract.
+    std::function<std::function<void()>(SocketTraceConnector&, ConnectorContext*, ConnTracker*,
+                                        DataTable*)>
+        parse_fn = nullptr;
     bool enabled = false;
   };
 
@@ -252,7 +288,7 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
 
   // This map controls how each protocol is processed and transferred.
   // The table num identifies which data the collected data is transferred.
-  // The transfer_fn defines which function is called to process the data for transfer.
+  // The parse_fn defines which function is called to process the data for transfer.
   std::vector<TransferSpec> protocol_transfer_specs_;
 
   // The time at which TransferDataImpl() begin. Used as a universal timestamp for the iteration,
@@ -280,6 +316,10 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
 
   std::shared_ptr<ConnInfoMapManager> conn_info_map_mgr_;
 
+  // The cluster CIDRs last pushed into the BPF-side filter map,
+  // used to avoid re-writing the map when the CIDRs haven't changed.
+  std::vector<CIDRBlock> current_cluster_cidrs_;
+
   UProbeManager uprobe_mgr_;
 
   enum class StatKey {
@@ -296,9 +336,37 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
     kPollSocketDataEventAttrSize,
     kPollSocketDataEventDataSize,
     kPollSocketDataEventSize,
+
+    kPollSocketControlEventCount,
+    kPollConnStatsEventCount,
+    kPollMMapEventCount,
+    kPollHTTP2EventCount,
+    kPollGrpcCEventCount,
+    kPollGrpcCHeaderEventCount,
+    kPollGrpcCCloseEventCount,
+  };
+
+  // Incremented from the per-CPU perf buffer drain threads and the parallel transfer threads,
+  // so the counter is sharded to keep the hot-path increments contention-free.
+  utils::ShardedStatCounter<StatKey> stats_;
+
+  // Adaptive drain schedule for one perf buffer.
+  // A buffer that yields no events backs off exponentially, draining only every
+  // period_multiple-th sampling iteration. Any activity or event loss snaps it back to draining
+  // on every iteration. Buffers on the data path never back off, since a missed burst there is
+  // where events get lost.
+  struct PerfBufferDrainState {
+    std::string name;
+    StatKey event_count_key;
+    StatKey loss_key;
+    bool allow_backoff = true;
+    uint32_t period_multiple = 1;
+    int64_t prev_event_count = 0;
+    int64_t prev_loss_count = 0;
   };
 
-  utils::StatCounter<StatKey> stats_;
+  static constexpr uint32_t kMaxDrainPeriodMultiple = 8;
+  std::vector<PerfBufferDrainState> drain_states_;
 
   friend class SocketTraceConnectorFriend;
   friend class SocketTraceBPFTest;
@@ -26,8 +26,12 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <filesystem>
 #include <map>
+#include <thread>
+#include <utility>
 
 #include "src/common/base/base.h"
 #include "src/common/base/utils.h"
@@ -47,6 +51,15 @@ DEFINE_bool(stirling_enable_grpc_c_tracing, false,
 DEFINE_double(stirling_rescan_exp_backoff_factor, 2.0,
               "Exponential backoff factor used in decided how often to rescan binaries for "
               "dynamically loaded libraries");
+DEFINE_string(stirling_go_symaddrs_cache_dir, "",
+              "Directory in which resolved Go symbol addresses are cached on disk, keyed by the "
+              "binary's build ID. Lets restarts skip the expensive DWARF analysis for binaries "
+              "that were already analyzed by a previous run. Point this at a persistent (host) "
+              "path to survive PEM restarts. An empty value disables the cache.");
+DEFINE_uint32(stirling_uprobe_go_analysis_threads, 4,
+              "Number of threads used to analyze Go binaries (ELF/DWARF parsing and symbol "
+              "address resolution) during uprobe deployment. BPF map updates and probe "
+              "attachment stay on the deployment thread. A value of 1 disables parallelism.");
 
 namespace px {
 namespace stirling {
@@ -158,39 +171,25 @@ Status UProbeManager::UpdateOpenSSLSymAddrs(obj_tools::RawFptrManager* fptr_mana
   return Status::OK();
 }
 
-Status UProbeManager::UpdateGoCommonSymAddrs(ElfReader* elf_reader, DwarfReader* dwarf_reader,
-                                             const std::vector<int32_t>& pids) {
-  PL_ASSIGN_OR_RETURN(struct go_common_symaddrs_t symaddrs,
-                      GoCommonSymAddrs(elf_reader, dwarf_reader));
-
+void UProbeManager::UpdateGoCommonSymAddrs(const struct go_common_symaddrs_t& symaddrs,
+                                           const std::vector<int32_t>& pids) {
   for (auto& pid : pids) {
     go_common_symaddrs_map_->UpdateValue(pid, symaddrs);
   }
-
-  return Status::OK();
 }
 
-Status UProbeManager::UpdateGoHTTP2SymAddrs(ElfReader* elf_reader, DwarfReader* dwarf_reader,
-                                            const std::vector<int32_t>& pids) {
-  PL_ASSIGN_OR_RETURN(struct go_http2_symaddrs_t symaddrs,
-                      GoHTTP2SymAddrs(elf_reader, dwarf_reader));
-
+void UProbeManager::UpdateGoHTTP2SymAddrs(const struct go_http2_symaddrs_t& symaddrs,
+                                          const std::vector<int32_t>& pids) {
   for (auto& pid : pids) {
     go_http2_symaddrs_map_->UpdateValue(pid, symaddrs);
   }
-
-  return Status::OK();
 }
 
-Status UProbeManager::UpdateGoTLSSymAddrs(ElfReader* elf_reader, DwarfReader* dwarf_reader,
-                                          const std::vector<int32_t>& pids) {
-  PL_ASSIGN_OR_RETURN(struct go_tls_symaddrs_t symaddrs, GoTLSSymAddrs(elf_reader, dwarf_reader));
-
+void UProbeManager::UpdateGoTLSSymAddrs(const struct go_tls_symaddrs_t& symaddrs,
+                                        const std::vector<int32_t>& pids) {
   for (auto& pid : pids) {
     go_tls_symaddrs_map_->UpdateValue(pid, symaddrs);
   }
-
-  return Status::OK();
 }
 
 Status UProbeManager::UpdateNodeTLSWrapSymAddrs(int32_t pid, const std::filesystem::path& node_exe,
@@ -425,9 +424,7 @@ void UProbeManager::SetupGOIDMaps(const std::string& binary, const std::vector<i
 }
 
 StatusOr<int> UProbeManager::AttachGoRuntimeUProbes(const std::string& binary,
-                                                    obj_tools::ElfReader* elf_reader,
-                                                    obj_tools::DwarfReader* /* dwarf_reader */,
-                                                    const std::vector<int32_t>& /* pids */) {
+                                                    obj_tools::ElfReader* elf_reader) {
   // Step 1: Update BPF symbols_map on all new PIDs.
   // TODO(oazizi): Implement this piece.
 
@@ -440,19 +437,19 @@ StatusOr<int> UProbeManager::AttachGoRuntimeUProbes(const std::string& binary,
   return AttachUProbeTmpl(kGoRuntimeUProbeTmpls, binary, elf_reader);
 }
 
-StatusOr<int> UProbeManager::AttachGoTLSUProbes(const std::string& binary,
-                                                obj_tools::ElfReader* elf_reader,
-                                                obj_tools::DwarfReader* dwarf_reader,
-                                                const std::vector<int32_t>& pids) {
-  // Step 1: Update BPF symbols_map on all new PIDs.
-  Status s = UpdateGoTLSSymAddrs(elf_reader, dwarf_reader, pids);
-  if (!s.ok()) {
+StatusOr<int> UProbeManager::AttachGoTLSUProbes(
+    const std::string& binary, obj_tools::ElfReader* elf_reader,
+    const std::optional<struct go_tls_symaddrs_t>& symaddrs, const std::vector<int32_t>& pids) {
+  if (!symaddrs.has_value()) {
     // Doesn't appear to be a binary with the mandatory symbols.
     // Might not even be a golang binary.
     // Either way, not of interest to probe.
     return 0;
   }
 
+  // Step 1: Update BPF symbols_map on all new PIDs.
+  UpdateGoTLSSymAddrs(symaddrs.value(), pids);
+
   // Step 2: Deploy uprobes on all new binaries.
   auto result = go_tls_probed_binaries_.insert(binary);
   if (!result.second) {
@@ -466,16 +463,16 @@ StatusOr<int> UProbeManager::AttachGoTLSUProbes(const std::string& binary,
 // That allows the BPF code and companion user-space code for uprobe & kprobe be separated
 // cleanly. For example, right now, enabling uprobe & kprobe simultaneously can crash Stirling,
 // because of the mixed & duplicate data events from these 2 sources.
-StatusOr<int> UProbeManager::AttachGoHTTP2Probes(const std::string& binary,
-                                                 obj_tools::ElfReader* elf_reader,
-                                                 obj_tools::DwarfReader* dwarf_reader,
-                                                 const std::vector<int32_t>& pids) {
-  // Step 1: Update BPF symaddrs for this binary.
-  Status s = UpdateGoHTTP2SymAddrs(elf_reader, dwarf_reader, pids);
-  if (!s.ok()) {
+StatusOr<int> UProbeManager::AttachGoHTTP2Probes(
+    const std::string& binary, obj_tools::ElfReader* elf_reader,
+    const std::optional<struct go_http2_symaddrs_t>& symaddrs, const std::vector<int32_t>& pids) {
+  if (!symaddrs.has_value()) {
     return 0;
   }
 
+  // Step 1: Update BPF symaddrs for this binary.
+  UpdateGoHTTP2SymAddrs(symaddrs.value(), pids);
+
   // Step 2: Deploy uprobes on all new binaries.
   auto result = go_http2_probed_binaries_.insert(binary);
   if (!result.second) {
@@ -520,6 +517,58 @@ std::map<std::string, std::vector<int32_t>> ConvertPIDsListToMap(
   return pids;
 }
 
+// Returns the (device, inode) pair identifying the file backing the binary.
+// Note: the return type matches UProbeManager::BinaryFileID.
+StatusOr<std::pair<uint64_t, uint64_t>> GetBinaryFileID(const std::string& binary) {
+  struct stat stat_buf;
+  if (stat(binary.c_str(), &stat_buf) != 0) {
+    return error::Internal("Failed to stat binary $0. errno $1.", binary, errno);
+  }
+  return std::make_pair<uint64_t, uint64_t>(stat_buf.st_dev, stat_buf.st_ino);
+}
+
+// Version of the on-disk Go symbol address cache format.
+// Bump whenever the layout of GoSymAddrsCacheHeader changes.
+constexpr uint32_t kGoSymAddrsCacheVersion = 1;
+
+// Header of an on-disk Go symbol address cache entry. The header is followed by the symaddrs
+// structs flagged as present, in the order: common, tls, http2.
+struct GoSymAddrsCacheHeader {
+  uint32_t version = kGoSymAddrsCacheVersion;
+  // Sizes of the symaddrs structs, used to reject entries written by a build with different
+  // struct layouts.
+  uint32_t common_size = sizeof(struct go_common_symaddrs_t);
+  uint32_t tls_size = sizeof(struct go_tls_symaddrs_t);
+  uint32_t http2_size = sizeof(struct go_http2_symaddrs_t);
+  // Whether HTTP2 symbol addresses were resolved when the entry was written. An entry written
+  // with HTTP2 tracing disabled cannot serve a lookup that requires them.
+  uint8_t http2_analyzed = 0;
+  uint8_t has_common = 0;
+  uint8_t has_tls = 0;
+  uint8_t has_http2 = 0;
+};
+
+std::filesystem::path GoSymAddrsCachePath(const std::string& build_id) {
+  return std::filesystem::path(FLAGS_stirling_go_symaddrs_cache_dir) / (build_id + ".symaddrs");
+}
+
+template <typename TSymAddrs>
+void AppendSymAddrs(const std::optional<TSymAddrs>& symaddrs, std::string* contents) {
+  if (symaddrs.has_value()) {
+    contents->append(reinterpret_cast<const char*>(&symaddrs.value()), sizeof(TSymAddrs));
+  }
+}
+
+template <typename TSymAddrs>
+void ExtractSymAddrs(bool present, std::string_view* contents, std::optional<TSymAddrs>* symaddrs) {
+  if (present) {
+    TSymAddrs value;
+    std::memcpy(&value, contents->data(), sizeof(TSymAddrs));
+    contents->remove_prefix(sizeof(TSymAddrs));
+    *symaddrs = value;
+  }
+}
+
 }  // namespace
 
 std::thread UProbeManager::RunDeployUProbesThread(const absl::flat_hash_set<md::UPID>& pids) {
@@ -742,12 +791,191 @@ int UProbeManager::DeployGrpcCUProbes(const absl::flat_hash_set<md::UPID>& pids)
   return uprobe_count;
 }
 
+std::optional<UProbeManager::GoSymAddrs> UProbeManager::ReadGoSymAddrsCacheFile(
+    const std::string& build_id) {
+  const std::filesystem::path path = GoSymAddrsCachePath(build_id);
+
+  StatusOr<std::string> contents_status = ReadFileToString(path.string(), std::ios_base::binary);
+  if (!contents_status.ok()) {
+    return std::nullopt;
+  }
+  std::string_view contents = contents_status.ValueOrDie();
+
+  GoSymAddrsCacheHeader header;
+  if (contents.size() < sizeof(header)) {
+    return std::nullopt;
+  }
+  std::memcpy(&header, contents.data(), sizeof(header));
+  contents.remove_prefix(sizeof(header));
+
+  if (header.version != kGoSymAddrsCacheVersion ||
+      header.common_size != sizeof(struct go_common_symaddrs_t) ||
+      header.tls_size != sizeof(struct go_tls_symaddrs_t) ||
+      header.http2_size != sizeof(struct go_http2_symaddrs_t)) {
+    return std::nullopt;
+  }
+
+  if (cfg_enable_http2_tracing_ && !header.http2_analyzed) {
+    // The entry was written with HTTP2 tracing disabled, so it lacks the HTTP2 symbol
+    // addresses we now need. Re-analyze.
+    return std::nullopt;
+  }
+
+  const size_t expected_size =
+      (header.has_common ? sizeof(struct go_common_symaddrs_t) : 0) +
+      (header.has_tls ? sizeof(struct go_tls_symaddrs_t) : 0) +
+      (header.has_http2 ? sizeof(struct go_http2_symaddrs_t) : 0);
+  if (contents.size() != expected_size) {
+    return std::nullopt;
+  }
+
+  GoSymAddrs symaddrs;
+  ExtractSymAddrs(header.has_common, &contents, &symaddrs.common);
+  ExtractSymAddrs(header.has_tls, &contents, &symaddrs.tls);
+  ExtractSymAddrs(header.has_http2, &contents, &symaddrs.http2);
+  return symaddrs;
+}
+
+void UProbeManager::WriteGoSymAddrsCacheFile(const std::string& build_id,
+                                             const GoSymAddrs& symaddrs) {
+  GoSymAddrsCacheHeader header;
+  header.http2_analyzed = cfg_enable_http2_tracing_;
+  header.has_common = symaddrs.common.has_value();
+  header.has_tls = symaddrs.tls.has_value();
+  header.has_http2 = symaddrs.http2.has_value();
+
+  std::string contents;
+  contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  AppendSymAddrs(symaddrs.common, &contents);
+  AppendSymAddrs(symaddrs.tls, &contents);
+  AppendSymAddrs(symaddrs.http2, &contents);
+
+  const std::filesystem::path path = GoSymAddrsCachePath(build_id);
+
+  Status s = fs::CreateDirectories(path.parent_path());
+  if (!s.ok()) {
+    VLOG(1) << absl::Substitute("Could not create Go symaddrs cache dir $0. Message = $1",
+                                path.parent_path().string(), s.msg());
+    return;
+  }
+
+  // Write to a temporary file and rename it into place, so that concurrent analysis threads and
+  // future runs never observe a partially-written entry.
+  static std::atomic<int> tmp_counter = 0;
+  std::filesystem::path tmp_path = path;
+  tmp_path += absl::Substitute(".tmp.$0.$1", getpid(), tmp_counter.fetch_add(1));
+
+  s = WriteFileFromString(tmp_path.string(), contents, std::ios_base::binary);
+  if (!s.ok()) {
+    VLOG(1) << absl::Substitute("Could not write Go symaddrs cache entry $0. Message = $1",
+                                tmp_path.string(), s.msg());
+    return;
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    VLOG(1) << absl::Substitute("Could not rename Go symaddrs cache entry $0 to $1. Message = $2",
+                                tmp_path.string(), path.string(), ec.message());
+    std::filesystem::remove(tmp_path, ec);
+  }
+}
+
+UProbeManager::GoBinaryAnalysis UProbeManager::AnalyzeGoBinary(const std::string& binary) {
+  GoBinaryAnalysis analysis;
+
+  // Read binary's symbols.
+  StatusOr<std::unique_ptr<ElfReader>> elf_reader_status = ElfReader::Create(binary);
+  if (!elf_reader_status.ok()) {
+    LOG(WARNING) << absl::Substitute(
+        "Cannot analyze binary $0 for uprobe deployment. "
+        "If file is under /var/lib, container may have terminated. "
+        "Message = $1",
+        binary, elf_reader_status.msg());
+    return analysis;
+  }
+  analysis.elf_reader = elf_reader_status.ConsumeValueOrDie();
+
+  // Avoid going past this point if not a golang program.
+  // The DwarfReader is memory intensive, and the remaining analysis is Golang specific.
+  if (!IsGoExecutable(analysis.elf_reader.get())) {
+    return analysis;
+  }
+
+  // Consult the persistent symbol address cache (if enabled), so that binaries analyzed by a
+  // previous run (e.g. before a PEM restart) skip the expensive DWARF analysis below.
+  std::string build_id;
+  if (!FLAGS_stirling_go_symaddrs_cache_dir.empty()) {
+    StatusOr<std::string> build_id_status = analysis.elf_reader->BuildID();
+    if (build_id_status.ok()) {
+      build_id = build_id_status.ConsumeValueOrDie();
+      std::optional<GoSymAddrs> cached_symaddrs = ReadGoSymAddrsCacheFile(build_id);
+      if (cached_symaddrs.has_value()) {
+        VLOG(1) << absl::Substitute("Loaded symbol addresses of binary $0 from cache (build ID $1)",
+                                    binary, build_id);
+        analysis.symaddrs = std::move(cached_symaddrs.value());
+        return analysis;
+      }
+    }
+  }
+
+  StatusOr<std::unique_ptr<DwarfReader>> dwarf_reader_status =
+      DwarfReader::CreateIndexingAll(binary);
+  if (!dwarf_reader_status.ok()) {
+    VLOG(1) << absl::Substitute(
+        "Failed to get binary $0 debug symbols. Cannot deploy uprobes. "
+        "Message = $1",
+        binary, dwarf_reader_status.msg());
+    return analysis;
+  }
+  std::unique_ptr<DwarfReader> dwarf_reader = dwarf_reader_status.ConsumeValueOrDie();
+
+  StatusOr<struct go_common_symaddrs_t> common_symaddrs =
+      GoCommonSymAddrs(analysis.elf_reader.get(), dwarf_reader.get());
+  if (!common_symaddrs.ok()) {
+    VLOG(1) << absl::Substitute(
+        "Golang binary $0 does not have the mandatory symbols (e.g. TCPConn).", binary);
+  } else {
+    analysis.symaddrs.common = common_symaddrs.ConsumeValueOrDie();
+
+    StatusOr<struct go_tls_symaddrs_t> tls_symaddrs =
+        GoTLSSymAddrs(analysis.elf_reader.get(), dwarf_reader.get());
+    if (tls_symaddrs.ok()) {
+      analysis.symaddrs.tls = tls_symaddrs.ConsumeValueOrDie();
+    }
+
+    if (cfg_enable_http2_tracing_) {
+      StatusOr<struct go_http2_symaddrs_t> http2_symaddrs =
+          GoHTTP2SymAddrs(analysis.elf_reader.get(), dwarf_reader.get());
+      if (http2_symaddrs.ok()) {
+        analysis.symaddrs.http2 = http2_symaddrs.ConsumeValueOrDie();
+      }
+    }
+  }
+
+  // Cache the analysis results, including negative results (a Go binary without the mandatory
+  // symbols), so that known-unsuitable binaries are not re-analyzed by the next run.
+  if (!build_id.empty()) {
+    WriteGoSymAddrsCacheFile(build_id, analysis.symaddrs);
+  }
+
+  return analysis;
+}
+
 int UProbeManager::DeployGoUProbes(const absl::flat_hash_set<md::UPID>& pids) {
   int uprobe_count = 0;
 
   static int32_t kPID = getpid();
 
-  for (const auto& [binary, pid_vec] : ConvertPIDsListToMap(pids, &fp_resolver_)) {
+  struct WorkItem {
+    std::string binary;
+    BinaryFileID file_id;
+    std::vector<int32_t> pid_vec;
+    GoBinaryAnalysis analysis;
+  };
+  std::vector<WorkItem> work_items;
+
+  for (auto& [binary, pid_vec] : ConvertPIDsListToMap(pids, &fp_resolver_)) {
     // Don't bother rescanning binaries that have been scanned before to avoid unnecessary work.
     if (!scanned_binaries_.insert(binary).second) {
       continue;
@@ -761,49 +989,80 @@ int UProbeManager::DeployGoUProbes(const absl::flat_hash_set<md::UPID>& pids) {
       }
     }
 
-    // Read binary's symbols.
-    StatusOr<std::unique_ptr<ElfReader>> elf_reader_status = ElfReader::Create(binary);
-    if (!elf_reader_status.ok()) {
-      LOG(WARNING) << absl::Substitute(
-          "Cannot analyze binary $0 for uprobe deployment. "
-          "If file is under /var/lib, container may have terminated. "
-          "Message = $1",
-          binary, elf_reader_status.msg());
+    PL_ASSIGN_OR(BinaryFileID file_id, GetBinaryFileID(binary), continue);
+
+    // The same file mounted at multiple paths (e.g. containers created from the same container
+    // image) only needs to be analyzed once. The kernel keys uprobes by inode, so the probes
+    // attached through the first path already cover this one; only the per-PID symbol address
+    // maps need to be populated.
+    auto cache_iter = go_symaddrs_cache_.find(file_id);
+    if (cache_iter != go_symaddrs_cache_.end()) {
+      const GoSymAddrs& symaddrs = cache_iter->second;
+      if (symaddrs.common.has_value()) {
+        UpdateGoCommonSymAddrs(symaddrs.common.value(), pid_vec);
+        if (symaddrs.tls.has_value()) {
+          UpdateGoTLSSymAddrs(symaddrs.tls.value(), pid_vec);
+        }
+        if (symaddrs.http2.has_value()) {
+          UpdateGoHTTP2SymAddrs(symaddrs.http2.value(), pid_vec);
+        }
+        SetupGOIDMaps(binary, pid_vec);
+      }
       continue;
     }
-    std::unique_ptr<ElfReader> elf_reader = elf_reader_status.ConsumeValueOrDie();
 
-    // Avoid going past this point if not a golang program.
-    // The DwarfReader is memory intensive, and the remaining probes are Golang specific.
-    if (!IsGoExecutable(elf_reader.get())) {
-      continue;
-    }
+    work_items.push_back(WorkItem{binary, file_id, std::move(pid_vec), {}});
+  }
 
-    StatusOr<std::unique_ptr<DwarfReader>> dwarf_reader_status =
-        DwarfReader::CreateIndexingAll(binary);
-    if (!dwarf_reader_status.ok()) {
-      VLOG(1) << absl::Substitute(
-          "Failed to get binary $0 debug symbols. Cannot deploy uprobes. "
-          "Message = $1",
-          binary, dwarf_reader_status.msg());
-      continue;
+  // Analysis phase: ELF/DWARF parsing and symbol address resolution dominate deployment time
+  // (DWARF indexing in particular), and only touch binary-local state, so binaries are analyzed
+  // in parallel.
+  auto analyze_item_fn = [this](WorkItem* item) { item->analysis = AnalyzeGoBinary(item->binary); };
+
+  const size_t num_threads = std::min<size_t>(
+      std::max<uint32_t>(FLAGS_stirling_uprobe_go_analysis_threads, 1), work_items.size());
+  if (num_threads <= 1) {
+    for (auto& item : work_items) {
+      analyze_item_fn(&item);
+    }
+  } else {
+    std::atomic<size_t> next_item(0);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      workers.emplace_back([&]() {
+        for (size_t idx = next_item.fetch_add(1); idx < work_items.size();
+             idx = next_item.fetch_add(1)) {
+          analyze_item_fn(&work_items[idx]);
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
     }
-    std::unique_ptr<DwarfReader> dwarf_reader = dwarf_reader_status.ConsumeValueOrDie();
+  }
 
-    Status s = UpdateGoCommonSymAddrs(elf_reader.get(), dwarf_reader.get(), pid_vec);
-    if (!s.ok()) {
-      VLOG(1) << absl::Substitute(
-          "Golang binary $0 does not have the mandatory symbols (e.g. TCPConn).", binary);
+  // Deployment phase: BPF map updates and uprobe attachment go through BCC, which is not
+  // thread-safe, so this phase stays on the deployment thread.
+  for (auto& item : work_items) {
+    const std::string& binary = item.binary;
+    const std::vector<int32_t>& pid_vec = item.pid_vec;
+    const GoSymAddrs& symaddrs = item.analysis.symaddrs;
+
+    go_symaddrs_cache_.emplace(item.file_id, symaddrs);
+
+    if (!symaddrs.common.has_value()) {
       continue;
     }
 
+    UpdateGoCommonSymAddrs(symaddrs.common.value(), pid_vec);
+
     // Setup thread to GOID mapping.
     SetupGOIDMaps(binary, pid_vec);
 
     // Go Runtime Probes.
     {
-      StatusOr<int> attach_status =
-          AttachGoRuntimeUProbes(binary, elf_reader.get(), dwarf_reader.get(), pid_vec);
+      StatusOr<int> attach_status = AttachGoRuntimeUProbes(binary, item.analysis.elf_reader.get());
       if (!attach_status.ok()) {
         monitor_.AppendSourceStatusRecord("socket_tracer", attach_status.status(),
                                           "AttachGoRuntimeUProbes");
@@ -817,7 +1076,7 @@ int UProbeManager::DeployGoUProbes(const absl::flat_hash_set<md::UPID>& pids) {
     // GoTLS Probes.
     {
       StatusOr<int> attach_status =
-          AttachGoTLSUProbes(binary, elf_reader.get(), dwarf_reader.get(), pid_vec);
+          AttachGoTLSUProbes(binary, item.analysis.elf_reader.get(), symaddrs.tls, pid_vec);
       if (!attach_status.ok()) {
         monitor_.AppendSourceStatusRecord("socket_tracer", attach_status.status(),
                                           "AttachGoTLSUProbes");
@@ -831,7 +1090,7 @@ int UProbeManager::DeployGoUProbes(const absl::flat_hash_set<md::UPID>& pids) {
     // Go HTTP2 Probes.
     if (cfg_enable_http2_tracing_) {
       StatusOr<int> attach_status =
-          AttachGoHTTP2Probes(binary, elf_reader.get(), dwarf_reader.get(), pid_vec);
+          AttachGoHTTP2Probes(binary, item.analysis.elf_reader.get(), symaddrs.http2, pid_vec);
       if (!attach_status.ok()) {
         monitor_.AppendSourceStatusRecord("socket_tracer", attach_status.status(),
                                           "AttachGoHTTP2Probes");
@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -497,21 +498,69 @@ class UProbeManager {
    */
   void SetupGOIDMaps(const std::string& binary, const std::vector<int32_t>& pids);
 
+  // Identifies the file backing a binary by (device, inode). The kernel keys uprobes by inode,
+  // so the same file mounted at multiple container paths (e.g. containers created from the same
+  // container image) only needs to be analyzed and probed once.
+  using BinaryFileID = std::pair<uint64_t, uint64_t>;
+
+  // Symbol addresses resolved for a Go binary. A value of std::nullopt means the corresponding
+  // symbols could not be resolved (e.g. the binary is not a Go binary, or doesn't use the
+  // corresponding library).
+  struct GoSymAddrs {
+    std::optional<struct go_common_symaddrs_t> common;
+    std::optional<struct go_tls_symaddrs_t> tls;
+    std::optional<struct go_http2_symaddrs_t> http2;
+  };
+
+  // Results of the CPU-intensive portion of Go uprobe deployment for one binary:
+  // ELF/DWARF parsing and symbol address resolution.
+  struct GoBinaryAnalysis {
+    std::unique_ptr<obj_tools::ElfReader> elf_reader;
+    GoSymAddrs symaddrs;
+  };
+
+  /**
+   * Analyzes a Go binary for uprobe deployment: parses its ELF and DWARF sections and resolves
+   * the symbol addresses required by the Go uprobes. This is the expensive part of deployment
+   * (DWARF indexing in particular), and it only touches binary-local state, so it is safe to run
+   * on multiple binaries concurrently. BPF map updates and probe attachment are not thread-safe,
+   * and are performed separately by DeployGoUProbes().
+   *
+   * @param binary The path to the binary to analyze.
+   * @return The analysis results. On failure (e.g. the binary has disappeared), the elf_reader
+   *         member will be nullptr and all symbol addresses will be std::nullopt.
+   */
+  GoBinaryAnalysis AnalyzeGoBinary(const std::string& binary);
+
+  /**
+   * Reads an entry of the persistent Go symbol address cache
+   * (--stirling_go_symaddrs_cache_dir), keyed by the binary's build ID. Since the build ID
+   * identifies the binary's contents, cached entries remain valid across PEM restarts for
+   * binaries that have not changed.
+   *
+   * @param build_id The build ID of the binary, as returned by ElfReader::BuildID().
+   * @return The cached symbol addresses, or std::nullopt if there is no usable cache entry
+   *         (missing, written by an incompatible version, or lacking required addresses).
+   */
+  std::optional<GoSymAddrs> ReadGoSymAddrsCacheFile(const std::string& build_id);
+
+  /**
+   * Writes an entry of the persistent Go symbol address cache. Negative results (a Go binary
+   * without the mandatory symbols) are cached as well, so known-unsuitable binaries are not
+   * re-analyzed on the next run.
+   */
+  void WriteGoSymAddrsCacheFile(const std::string& build_id, const GoSymAddrs& symaddrs);
+
   /**
    * Attaches the required probes for general Go tracing to the specified binary, if it is a
    * compatible Go binary.
    *
    * @param binary The path to the binary on which to deploy Go probes.
    * @param elf_reader ELF reader for the binary.
-   * @param dwarf_reader DWARF reader for the binary.
-   * @param pids The list of PIDs that are new instances of the binary. Used to populate symbol
-   *             addresses.
    * @return The number of uprobes deployed, or error. It is not an error if the binary
    *         is not a Go binary; instead the return value will be zero.
    */
-  StatusOr<int> AttachGoRuntimeUProbes(const std::string& binary, obj_tools::ElfReader* elf_reader,
-                                       obj_tools::DwarfReader* dwarf_reader,
-                                       const std::vector<int32_t>& new_pids);
+  StatusOr<int> AttachGoRuntimeUProbes(const std::string& binary, obj_tools::ElfReader* elf_reader);
 
   /**
    * Attaches the required probes for Go HTTP2 tracing to the specified binary, if it is a
@@ -519,7 +568,7 @@ class UProbeManager {
    *
    * @param binary The path to the binary on which to deploy Go HTTP2 probes.
    * @param elf_reader ELF reader for the binary.
-   * @param dwarf_reader DWARF reader for the binary.
+   * @param symaddrs The HTTP2 symbol addresses resolved by AnalyzeGoBinary().
    * @param pids The list of PIDs that are new instances of the binary. Used to populate symbol
    *             addresses.
    * @return The number of uprobes deployed, or error. It is not considered an error if the binary
@@ -527,7 +576,7 @@ class UProbeManager {
    *         zero.
    */
   StatusOr<int> AttachGoHTTP2Probes(const std::string& binary, obj_tools::ElfReader* elf_reader,
-                                    obj_tools::DwarfReader* dwarf_reader,
+                                    const std::optional<struct go_http2_symaddrs_t>& symaddrs,
                                     const std::vector<int32_t>& pids);
 
   /**
@@ -536,14 +585,14 @@ class UProbeManager {
    *
    * @param binary The path to the binary on which to deploy Go HTTP2 probes.
    * @param elf_reader ELF reader for the binary.
-   * @param dwarf_reader DWARF reader for the binary.
+   * @param symaddrs The GoTLS symbol addresses resolved by AnalyzeGoBinary().
    * @param pids The list of PIDs that are new instances of the binary. Used to populate symbol
    *             addresses.
    * @return The number of uprobes deployed, or error. It is not an error if the binary
    *         is not a Go binary or doesn't use Go TLS; instead the return value will be zero.
    */
   StatusOr<int> AttachGoTLSUProbes(const std::string& binary, obj_tools::ElfReader* elf_reader,
-                                   obj_tools::DwarfReader* dwarf_reader,
+                                   const std::optional<struct go_tls_symaddrs_t>& symaddrs,
                                    const std::vector<int32_t>& new_pids);
 
   /**
@@ -591,14 +640,12 @@ class UProbeManager {
 
   Status UpdateOpenSSLSymAddrs(px::stirling::obj_tools::RawFptrManager* fptrManager,
                                std::filesystem::path container_lib, uint32_t pid);
-  Status UpdateGoCommonSymAddrs(obj_tools::ElfReader* elf_reader,
-                                obj_tools::DwarfReader* dwarf_reader,
-                                const std::vector<int32_t>& pids);
-  Status UpdateGoHTTP2SymAddrs(obj_tools::ElfReader* elf_reader,
-                               obj_tools::DwarfReader* dwarf_reader,
-                               const std::vector<int32_t>& pids);
-  Status UpdateGoTLSSymAddrs(obj_tools::ElfReader* elf_reader, obj_tools::DwarfReader* dwarf_reader,
+  void UpdateGoCommonSymAddrs(const struct go_common_symaddrs_t& symaddrs,
+                              const std::vector<int32_t>& pids);
+  void UpdateGoHTTP2SymAddrs(const struct go_http2_symaddrs_t& symaddrs,
                              const std::vector<int32_t>& pids);
+  void UpdateGoTLSSymAddrs(const struct go_tls_symaddrs_t& symaddrs,
+                           const std::vector<int32_t>& pids);
   Status UpdateNodeTLSWrapSymAddrs(int32_t pid, const std::filesystem::path& node_exe,
                                    const SemVer& ver);
 
@@ -644,6 +691,12 @@ class UProbeManager {
   absl::flat_hash_set<std::string> nodejs_binaries_;
   absl::flat_hash_set<std::string> grpc_c_probed_binaries_;
 
+  // Cached Go symbol addresses per binary file, keyed by (device, inode). Containers created from
+  // the same container image share the underlying binary file, so the expensive ELF/DWARF
+  // analysis is performed once per distinct file rather than once per mount path. A cached entry
+  // with no symbol addresses records that the binary was analyzed and found unsuitable.
+  absl::flat_hash_map<BinaryFileID, GoSymAddrs> go_symaddrs_cache_;
+
   // BPF maps through which the addresses of symbols for a given pid are communicated to uprobes.
   std::unique_ptr<UserSpaceManagedBPFMap<uint32_t, struct openssl_symaddrs_t>>
       openssl_symaddrs_map_;
@@ -29,6 +29,9 @@
 #include <vector>
 
 #include <absl/base/internal/spinlock.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/str_split.h>
 
 #include "src/common/base/base.h"
 #include "src/common/json/json.h"
@@ -64,6 +67,46 @@ DEFINE_string(
     "Choose sources to enable. [kAll|kProd|kMetrics|kTracers|kProfiler] or comma separated list of "
     "sources (find them the header files of source connector classes).");
 
+DEFINE_string(stirling_disabled_tables, gflags::StringFromEnv("PL_STIRLING_DISABLED_TABLES", ""),
+              "Comma-separated list of table names (e.g. 'kafka_events,amqp_events') for which "
+              "data collection is disabled. Source connectors skip parsing for disabled tables. "
+              "The flag may be changed at runtime; changes take effect within one TransferData "
+              "cycle.");
+
+DEFINE_int64(stirling_transfer_budget_ms,
+             gflags::Int64FromEnv("PL_STIRLING_TRANSFER_BUDGET_MS", 100),
+             "Soft time budget for one pass of TransferData calls in the main loop. Expired "
+             "connectors run cheapest first (by their recent TransferData cost); once the budget "
+             "is exceeded, the remaining connectors are deferred to the next wakeup so that a "
+             "slow connector cannot delay cheap ones (e.g. socket tracing) by more than one "
+             "budget. 0 disables the budget.");
+
+DEFINE_string(stirling_dedicated_thread_sources,
+              gflags::StringFromEnv("PL_STIRLING_DEDICATED_THREAD_SOURCES", ""),
+              "Comma-separated list of source connector names (e.g. 'perf_profiler') to run on "
+              "dedicated threads instead of the shared main loop. Useful for heavyweight "
+              "connectors whose TransferData routinely overruns the transfer budget.");
+
+DEFINE_int64(stirling_table_subscription_idle_s,
+             gflags::Int64FromEnv("PL_STIRLING_TABLE_SUBSCRIPTION_IDLE_S", 300),
+             "How long a table stays fully sampled after a query last read it. Tables idle for "
+             "longer are sampled at --stirling_unqueried_table_sample_period_ms until queried "
+             "again. Only takes effect once the agent reports queried tables (see "
+             "Stirling::UpdateQueriedTables); 0 disables query-aware sampling.");
+
+DEFINE_string(stirling_lazy_init_sources,
+              gflags::StringFromEnv("PL_STIRLING_LAZY_INIT_SOURCES", ""),
+              "Comma-separated list of source connector names (e.g. 'perf_profiler,jvm_stats') "
+              "to initialize lazily. Their tables are published, but BPF programs are not "
+              "compiled or attached until a query first reads one of their tables (see "
+              "Stirling::UpdateQueriedTables). Sources that are never queried stay dormant.");
+
+DEFINE_int64(stirling_unqueried_table_sample_period_ms,
+             gflags::Int64FromEnv("PL_STIRLING_UNQUERIED_TABLE_SAMPLE_PERIOD_MS", 30000),
+             "Sample period for tables no query has read recently. Keeping a slow trickle "
+             "(rather than disabling outright) means a newly-run script still finds fresh-ish "
+             "data while unqueried protocol tables stop consuming CPU and table store memory.");
+
 namespace px {
 namespace stirling {
 
@@ -201,11 +244,15 @@ class StirlingImpl final : public Stirling {
   StatusOr<stirlingpb::Publish> GetTracepointInfo(sole::uuid trace_id) override;
   Status RemoveTracepoint(sole::uuid trace_id) override;
   void GetPublishProto(stirlingpb::Publish* publish_pb) override;
+  bool GetPublishDeltaProto(stirlingpb::PublishDelta* delta_pb) override;
   void RegisterDataPushCallback(DataPushCallback f) override { data_push_callback_ = f; }
   void RegisterAgentMetadataCallback(AgentMetadataCallback f) override {
     DCHECK(f != nullptr);
     agent_metadata_callback_ = f;
   }
+  void UpdateQueriedTables(absl::flat_hash_set<std::string> queried_tables) override;
+  Status ProfileOnDemand(absl::flat_hash_set<md::UPID> target_upids,
+                         std::chrono::milliseconds duration) override;
   std::unique_ptr<ConnectorContext> GetContext();
 
   void Run() override;
@@ -226,6 +273,18 @@ class StirlingImpl final : public Stirling {
   // Adds a source to Stirling, and updates all state accordingly.
   Status AddSource(std::unique_ptr<SourceConnector> source);
 
+  // Registers an already-initialized source with Stirling's bookkeeping structures.
+  void RegisterSource(std::unique_ptr<SourceConnector> source);
+
+  // Registers a constructed-but-uninitialized source (see --stirling_lazy_init_sources).
+  // Its tables are published, but the source is not sampled until activated.
+  void RegisterDormantSource(std::unique_ptr<SourceConnector> source);
+
+  // Initializes dormant sources that a query has started reading. Initialization runs on a
+  // background thread (BPF compilation takes seconds), and the source joins the sampling loop
+  // once it completes. Called periodically from RunCore.
+  void ActivateQueriedDormantSources();
+
   // Removes a source and all its info classes from stirling.
   Status RemoveSource(std::string_view source_name);
 
@@ -240,6 +299,23 @@ class StirlingImpl final : public Stirling {
   // Main run implementation.
   void RunCore();
 
+  // Run loop for a single source on a dedicated thread (--stirling_dedicated_thread_sources).
+  // Mirrors the sample/push phases of RunCore for just this source. Spawned and joined by
+  // RunCore; only static sources may be dedicated, since dynamic trace connectors can be
+  // removed while running.
+  void RunDedicatedSourceCore(SourceConnector* source, SourceOutput output);
+
+  // Tracks when a throttled (unqueried) table may next take a full sample, owned by the loop
+  // that evaluates the throttle.
+  using CrawlStateMap =
+      absl::flat_hash_map<std::string, px::chrono::coarse_steady_clock::time_point>;
+
+  // Returns the subset of `table_names` to mask during this TransferData pass because no query
+  // has read them within the subscription idle window. Tables past their crawl timer are let
+  // through (and their timer re-armed), so unqueried tables still trickle data.
+  absl::flat_hash_set<std::string> GetThrottledTables(const std::vector<std::string>& table_names,
+                                                      CrawlStateMap* crawl_state);
+
   // Wait for Stirling to stop its main loop.
   void WaitForStop();
 
@@ -256,6 +332,20 @@ class StirlingImpl final : public Stirling {
 
   InfoClassManagerVec info_class_mgrs_ ABSL_GUARDED_BY(info_class_mgrs_lock_);
 
+  // Tracks the published schema set and its version, for generating delta publications.
+  PubSubManager pub_sub_mgr_ ABSL_GUARDED_BY(info_class_mgrs_lock_);
+
+  // Sources registered via RegisterDormantSource, waiting for a query to read one of their
+  // tables before being initialized.
+  struct DormantSource {
+    std::unique_ptr<SourceConnector> source;
+    std::vector<InfoClassManager*> mgrs;
+  };
+  std::vector<DormantSource> dormant_sources_ ABSL_GUARDED_BY(info_class_mgrs_lock_);
+
+  // Threads running lazy source initialization. Appended and joined by the RunCore thread.
+  std::vector<std::thread> lazy_init_threads_;
+
   // Lock to protect both info_class_mgrs_ and sources_.
   absl::base_internal::SpinLock info_class_mgrs_lock_;
 
@@ -272,6 +362,14 @@ class StirlingImpl final : public Stirling {
   AgentMetadataCallback agent_metadata_callback_ = nullptr;
   AgentMetadataType agent_metadata_;
 
+  // Query-aware sampling state: when each table was last reported as read by a query. The
+  // throttle stays inactive until the first UpdateQueriedTables call, so Stirling behaves
+  // normally when the agent never reports subscriptions.
+  absl::base_internal::SpinLock queried_tables_lock_;
+  absl::flat_hash_map<std::string, px::chrono::coarse_steady_clock::time_point>
+      queried_table_times_ ABSL_GUARDED_BY(queried_tables_lock_);
+  bool table_subscriptions_active_ ABSL_GUARDED_BY(queried_tables_lock_) = false;
+
   absl::base_internal::SpinLock dynamic_trace_status_map_lock_;
   absl::flat_hash_map<sole::uuid, StatusOr<stirlingpb::Publish>> dynamic_trace_status_map_
       ABSL_GUARDED_BY(dynamic_trace_status_map_lock_);
@@ -402,10 +500,50 @@ Status StirlingImpl::Init() {
     return error::NotFound("Source registry doesn't exist");
   }
 
+  absl::flat_hash_set<std::string> lazy_sources;
+  for (std::string_view name :
+       absl::StrSplit(FLAGS_stirling_lazy_init_sources, ",", absl::SkipWhitespace())) {
+    lazy_sources.emplace(absl::StripAsciiWhitespace(name));
+  }
+
+  std::vector<std::unique_ptr<SourceConnector>> sources;
+  std::vector<std::string> source_names;
   for (const auto& [name, create_source_fn, _] : registry_->sources()) {
-    auto source_ptr = create_source_fn(name);
+    auto source = create_source_fn(name);
+    if (lazy_sources.contains(name)) {
+      LOG(INFO) << absl::Substitute(
+          "Source connector '$0' registered dormant; it will initialize when first queried.",
+          name);
+      RegisterDormantSource(std::move(source));
+      continue;
+    }
+    source_names.push_back(name);
+    sources.push_back(std::move(source));
+  }
 
-    Status s = AddSource(std::move(source_ptr));
+  // Initialize the sources in parallel. Each BPF-based source compiles its BPF program with
+  // LLVM during Init(), which dominates Stirling's cold start; overlapping the compilations
+  // reduces startup time to roughly that of the slowest source.
+  std::vector<Status> statuses(sources.size());
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+      threads.emplace_back([&statuses, &sources, i]() { statuses[i] = sources[i]->Init(); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  // Register the successfully initialized sources, preserving registry order.
+  for (size_t i = 0; i < sources.size(); ++i) {
+    const std::string& name = source_names[i];
+    const Status& s = statuses[i];
+
+    if (s.ok()) {
+      RegisterSource(std::move(sources[i]));
+    }
     monitor_.AppendSourceStatusRecord(name, s, "Init");
 
     LOG_IF(WARNING, !s.ok()) << absl::Substitute(
@@ -439,6 +577,12 @@ Status StirlingImpl::AddSource(std::unique_ptr<SourceConnector> source) {
   // Step 1: Init the source.
   PL_RETURN_IF_ERROR(source->Init());
 
+  RegisterSource(std::move(source));
+
+  return Status::OK();
+}
+
+void StirlingImpl::RegisterSource(std::unique_ptr<SourceConnector> source) {
   absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
 
   std::vector<InfoClassManager*> mgrs;
@@ -458,8 +602,70 @@ Status StirlingImpl::AddSource(std::unique_ptr<SourceConnector> source) {
                                       // DataTable objects are created after subscribing.
                                       std::move(data_tables)};
   sources_.push_back(std::move(source));
+}
 
-  return Status::OK();
+void StirlingImpl::RegisterDormantSource(std::unique_ptr<SourceConnector> source) {
+  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+
+  // The info classes are created up front so that the source's tables are published, which is
+  // what allows a query to subscribe to them and trigger activation.
+  std::vector<InfoClassManager*> mgrs;
+  mgrs.reserve(source->table_schemas().size());
+  for (const DataTableSchema& schema : source->table_schemas()) {
+    LOG(INFO) << absl::Substitute("Adding info class (dormant): [$0/$1]", source->name(),
+                                  schema.name());
+    auto mgr = std::make_unique<InfoClassManager>(schema);
+    mgr->SetSourceConnector(source.get());
+    mgrs.push_back(mgr.get());
+    info_class_mgrs_.push_back(std::move(mgr));
+  }
+
+  dormant_sources_.push_back(DormantSource{std::move(source), std::move(mgrs)});
+}
+
+void StirlingImpl::ActivateQueriedDormantSources() {
+  absl::flat_hash_set<std::string> queried;
+  {
+    absl::base_internal::SpinLockHolder lock(&queried_tables_lock_);
+    if (!table_subscriptions_active_) {
+      return;
+    }
+    for (const auto& [name, time] : queried_table_times_) {
+      queried.insert(name);
+    }
+  }
+
+  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+  auto iter = dormant_sources_.begin();
+  while (iter != dormant_sources_.end()) {
+    const bool queried_table =
+        std::any_of(iter->mgrs.begin(), iter->mgrs.end(),
+                    [&queried](InfoClassManager* mgr) { return queried.contains(mgr->name()); });
+    if (!queried_table) {
+      ++iter;
+      continue;
+    }
+
+    LOG(INFO) << absl::Substitute("Activating dormant source connector '$0'.",
+                                  iter->source->name());
+    lazy_init_threads_.emplace_back([this, dormant = std::move(*iter)]() mutable {
+      const std::string name = dormant.source->name();
+      Status s = dormant.source->Init();
+      monitor_.AppendSourceStatusRecord(name, s, "LazyInit");
+      if (!s.ok()) {
+        LOG(WARNING) << absl::Substitute(
+            "Dormant source connector '$0' failed to initialize, error: $1", name, s.ToString());
+        return;
+      }
+      std::unique_ptr<ConnectorContext> ctx = GetContext();
+      dormant.source->InitContext(ctx.get());
+
+      absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+      source_output_map_[dormant.source.get()] = {dormant.mgrs, GetDataTables(dormant.mgrs)};
+      sources_.push_back(std::move(dormant.source));
+    });
+    iter = dormant_sources_.erase(iter);
+  }
 }
 
 Status StirlingImpl::RemoveSource(std::string_view source_name) {
@@ -556,6 +762,10 @@ void StirlingImpl::DeployDynamicTraceConnector(
   auto timer = ElapsedTimer();
   timer.Start();
 
+  // Report progress through the deployment phases, so the UI can distinguish a deployment
+  // that is still compiling from one that is attaching probes.
+  UpdateDynamicTraceStatus(trace_id, error::ResourceUnavailable("Compiling BPF program."));
+
   // Try creating the DynamicTraceConnector--which compiles BCC code.
   // On failure, set status and exit.
   ASSIGN_OR_RETURN_ERROR(std::unique_ptr<SourceConnector> source,
@@ -575,6 +785,8 @@ void StirlingImpl::DeployDynamicTraceConnector(
     }
   }
 
+  UpdateDynamicTraceStatus(trace_id, error::ResourceUnavailable("Deploying BPF program."));
+
   timer.Start();
   // Next, try adding the source (this actually tries to deploy BPF code).
   // On failure, set status and exit, but do this outside the lock for efficiency reasons.
@@ -691,7 +903,12 @@ Status StirlingImpl::RemoveTracepoint(sole::uuid trace_id) {
 
 void StirlingImpl::GetPublishProto(stirlingpb::Publish* publish_pb) {
   absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
-  PopulatePublishProto(publish_pb, info_class_mgrs_);
+  pub_sub_mgr_.GeneratePublishProto(publish_pb, info_class_mgrs_);
+}
+
+bool StirlingImpl::GetPublishDeltaProto(stirlingpb::PublishDelta* delta_pb) {
+  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+  return pub_sub_mgr_.GeneratePublishDeltaProto(delta_pb, info_class_mgrs_);
 }
 
 // Main call to start the data collection.
@@ -749,9 +966,11 @@ void StirlingImpl::Run() {
 
 namespace {
 
-// Helper function: Figure out when to wake up next.
+// Helper function: Figure out when to wake up next. Sources running on dedicated threads are
+// excluded; they manage their own wakeups.
 std::chrono::milliseconds TimeUntilNextTick(
-    const absl::flat_hash_map<SourceConnector*, SourceOutput> source_output_map) {
+    const absl::flat_hash_map<SourceConnector*, SourceOutput> source_output_map,
+    const absl::flat_hash_set<SourceConnector*>& dedicated_sources) {
   // The amount to sleep depends on when the earliest Source needs to be sampled again.
   // Do this to avoid burning CPU cycles unnecessarily
   auto now = px::chrono::coarse_steady_clock::now();
@@ -761,6 +980,9 @@ std::chrono::milliseconds TimeUntilNextTick(
   constexpr std::chrono::milliseconds kMaxSleepDuration{1000};
   auto wakeup_time = now + kMaxSleepDuration;
   for (const auto& [source, output] : source_output_map) {
+    if (dedicated_sources.contains(source)) {
+      continue;
+    }
     wakeup_time = std::min(wakeup_time, source->sampling_freq_mgr().next());
     wakeup_time = std::min(wakeup_time, source->push_freq_mgr().next());
   }
@@ -794,8 +1016,93 @@ bool DataExceedsThreshold(const std::vector<DataTable*>& data_tables) {
   return false;
 }
 
+// Re-parses the --stirling_disabled_tables flag into `disabled_tables` when its value has
+// changed since the last call. The flag can be changed at runtime.
+void UpdateDisabledTables(std::string* cached_flag_value,
+                          absl::flat_hash_set<std::string>* disabled_tables) {
+  if (*cached_flag_value == FLAGS_stirling_disabled_tables) {
+    return;
+  }
+  *cached_flag_value = FLAGS_stirling_disabled_tables;
+  disabled_tables->clear();
+  for (std::string_view name :
+       absl::StrSplit(*cached_flag_value, ",", absl::SkipWhitespace())) {
+    disabled_tables->emplace(absl::StripAsciiWhitespace(name));
+  }
+}
+
+// Returns the data tables to pass to TransferData, with tables disabled via
+// --stirling_disabled_tables masked out as nullptr. Source connectors skip processing for null
+// tables (e.g. the socket tracer skips parsing and stitching, while its retention limits keep the
+// raw buffers bounded), so masking defers all processing work for tables that no one consumes.
+std::vector<DataTable*> MaskDisabledTables(const SourceOutput& output,
+                                           const absl::flat_hash_set<std::string>& disabled_tables) {
+  std::vector<DataTable*> data_tables = output.data_tables;
+  for (size_t i = 0; i < data_tables.size(); ++i) {
+    if (disabled_tables.contains(output.info_class_mgrs[i]->name())) {
+      data_tables[i] = nullptr;
+    }
+  }
+  return data_tables;
+}
+
 }  // namespace
 
+void StirlingImpl::UpdateQueriedTables(absl::flat_hash_set<std::string> queried_tables) {
+  const auto now = px::chrono::coarse_steady_clock::now();
+  absl::base_internal::SpinLockHolder lock(&queried_tables_lock_);
+  table_subscriptions_active_ = true;
+  for (const auto& name : queried_tables) {
+    queried_table_times_[name] = now;
+  }
+}
+
+Status StirlingImpl::ProfileOnDemand(absl::flat_hash_set<md::UPID> target_upids,
+                                     std::chrono::milliseconds duration) {
+  // Holding info_class_mgrs_lock_ serializes with the sampling loop, making the profiler's
+  // frequency-manager retune safe.
+  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+  for (const auto& source : sources_) {
+    if (source->name() == PerfProfileConnector::kName) {
+      static_cast<PerfProfileConnector*>(source.get())
+          ->StartOnDemandProfiling(std::move(target_upids), duration);
+      return Status::OK();
+    }
+  }
+  return error::NotFound("Perf profiler source is not running; cannot profile on demand.");
+}
+
+absl::flat_hash_set<std::string> StirlingImpl::GetThrottledTables(
+    const std::vector<std::string>& table_names, CrawlStateMap* crawl_state) {
+  absl::flat_hash_set<std::string> throttled;
+  if (FLAGS_stirling_table_subscription_idle_s <= 0) {
+    return throttled;
+  }
+  const auto now = px::chrono::coarse_steady_clock::now();
+  const std::chrono::seconds idle{FLAGS_stirling_table_subscription_idle_s};
+  const std::chrono::milliseconds crawl{FLAGS_stirling_unqueried_table_sample_period_ms};
+
+  absl::base_internal::SpinLockHolder lock(&queried_tables_lock_);
+  if (!table_subscriptions_active_) {
+    return throttled;
+  }
+  for (const auto& name : table_names) {
+    auto it = queried_table_times_.find(name);
+    if (it != queried_table_times_.end() && now - it->second < idle) {
+      crawl_state->erase(name);
+      continue;
+    }
+    auto [crawl_it, inserted] = crawl_state->try_emplace(name, now + crawl);
+    if (!inserted && now >= crawl_it->second) {
+      // The crawl timer expired: let this pass take a full sample, then re-arm.
+      crawl_it->second = now + crawl;
+      continue;
+    }
+    throttled.insert(name);
+  }
+  return throttled;
+}
+
 // Main Data Collector loop.
 // Poll on Data Source Through connectors, when appropriate, then go to sleep.
 // Must run as a thread, so only call from Run() as a thread.
@@ -812,9 +1119,41 @@ void StirlingImpl::RunCore() {
   }
   // TODO(oazizi): We need to call InitContext on dynamic sources too. Fix.
 
+  // Spawn the dedicated threads for heavyweight connectors before entering the shared loop.
+  // Only static sources can be dedicated, so the pointers stay valid for Stirling's lifetime.
+  absl::flat_hash_set<SourceConnector*> dedicated_sources;
+  std::vector<std::thread> dedicated_threads;
+  {
+    absl::flat_hash_set<std::string> dedicated_names;
+    for (std::string_view name : absl::StrSplit(FLAGS_stirling_dedicated_thread_sources, ",",
+                                                absl::SkipWhitespace())) {
+      dedicated_names.emplace(absl::StripAsciiWhitespace(name));
+    }
+    absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+    for (auto& [source, output] : source_output_map_) {
+      if (!dedicated_names.contains(source->name())) {
+        continue;
+      }
+      dedicated_sources.insert(source);
+      dedicated_threads.emplace_back(&StirlingImpl::RunDedicatedSourceCore, this, source, output);
+    }
+  }
+
   // Indicates completion of initialization, and start of data collection.
   LOG(INFO) << "Stirling is running.";
 
+  // Cache of the parsed --stirling_disabled_tables flag. The flag can be changed at runtime, so it
+  // is re-parsed whenever its value changes.
+  std::string disabled_tables_flag;
+  absl::flat_hash_set<std::string> disabled_tables;
+
+  // Scratch vector of expired sources, reused across iterations.
+  std::vector<SourceConnector*> expired_sources;
+
+  // Query-aware sampling state owned by this loop (see GetThrottledTables).
+  CrawlStateMap crawl_state;
+  std::vector<std::string> all_table_names;
+
   while (run_enable_) {
     auto sleep_duration = std::chrono::milliseconds::zero();
 
@@ -825,32 +1164,125 @@ void StirlingImpl::RunCore() {
     //               mgr->SamplingRequired() will be true for any manager.
     std::unique_ptr<ConnectorContext> ctx = GetContext();
 
+    // Kick off initialization of any dormant sources whose tables are now being queried.
+    ActivateQueriedDormantSources();
+
     {
       // Acquire spin lock to go through one iteration of sampling and pushing data.
       // Needed to avoid race with main thread update info_class_mgrs_ on new subscription.
       absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
 
-      // Run through every SourceConnector and InfoClassManager being managed.
+      UpdateDisabledTables(&disabled_tables_flag, &disabled_tables);
+
+      // Merge tables disabled by flag with tables throttled because no query reads them.
+      all_table_names.clear();
+      for (const auto& mgr : info_class_mgrs_) {
+        all_table_names.push_back(std::string(mgr->name()));
+      }
+      absl::flat_hash_set<std::string> masked_tables =
+          GetThrottledTables(all_table_names, &crawl_state);
+      masked_tables.insert(disabled_tables.begin(), disabled_tables.end());
+
+      // Phase 1: Probe expired sources for their data, cheapest first, under a soft time
+      // budget. Running cheap connectors first bounds how long a slow connector (e.g.
+      // perf_profiler symbolization) can delay perf-buffer draining for the others; once the
+      // budget is exceeded, the remaining connectors stay expired and run on the next wakeup.
+      expired_sources.clear();
       for (auto& [source, output] : source_output_map_) {
-        // Phase 1: Probe each source for its data.
-        if (source->sampling_freq_mgr().Expired()) {
+        if (source->sampling_freq_mgr().Expired() && !dedicated_sources.contains(source)) {
+          expired_sources.push_back(source);
+        }
+      }
+      std::stable_sort(expired_sources.begin(), expired_sources.end(),
+                       [](const SourceConnector* a, const SourceConnector* b) {
+                         return a->transfer_duration_ema_ns() < b->transfer_duration_ema_ns();
+                       });
+      const std::chrono::milliseconds budget{FLAGS_stirling_transfer_budget_ms};
+      const auto phase_start = std::chrono::steady_clock::now();
+      for (auto* source : expired_sources) {
+        const auto& output = source_output_map_[source];
+        if (masked_tables.empty()) {
           source->TransferData(ctx.get(), output.data_tables);
+        } else {
+          source->TransferData(ctx.get(), MaskDisabledTables(output, masked_tables));
+        }
+        if (budget.count() > 0 && std::chrono::steady_clock::now() - phase_start > budget) {
+          // The deferred connectors are the most expensive of this pass; each eventually runs
+          // once it reaches the front of a pass, so none is starved indefinitely.
+          break;
+        }
+      }
+
+      // Phase 2: Push Data upstream.
+      for (auto& [source, output] : source_output_map_) {
+        if (dedicated_sources.contains(source)) {
+          continue;
         }
-        // Phase 2: Push Data upstream.
         if (source->push_freq_mgr().Expired() || DataExceedsThreshold(output.data_tables)) {
           source->PushData(data_push_callback_, output.data_tables);
         }
       }
 
       // Figure out how long to sleep.
-      sleep_duration = TimeUntilNextTick(source_output_map_);
+      sleep_duration = TimeUntilNextTick(source_output_map_, dedicated_sources);
     }
 
     SleepForDuration(sleep_duration);
   }
+
+  for (auto& thread : dedicated_threads) {
+    thread.join();
+  }
+  for (auto& thread : lazy_init_threads_) {
+    thread.join();
+  }
+
+  // Push any record batches still held by the push coalescers, so no data is dropped on exit.
+  for (auto& entry : source_output_map_) {
+    entry.first->FlushPendingData(data_push_callback_);
+  }
+
   running_ = false;
 }
 
+void StirlingImpl::RunDedicatedSourceCore(SourceConnector* source, SourceOutput output) {
+  LOG(INFO) << absl::Substitute("Source connector '$0' is running on a dedicated thread.",
+                                source->name());
+
+  std::string disabled_tables_flag;
+  absl::flat_hash_set<std::string> disabled_tables;
+  CrawlStateMap crawl_state;
+  std::vector<std::string> table_names;
+  for (const auto* mgr : output.info_class_mgrs) {
+    table_names.push_back(std::string(mgr->name()));
+  }
+
+  while (run_enable_) {
+    std::unique_ptr<ConnectorContext> ctx = GetContext();
+    UpdateDisabledTables(&disabled_tables_flag, &disabled_tables);
+
+    if (source->sampling_freq_mgr().Expired()) {
+      absl::flat_hash_set<std::string> masked_tables =
+          GetThrottledTables(table_names, &crawl_state);
+      masked_tables.insert(disabled_tables.begin(), disabled_tables.end());
+      if (masked_tables.empty()) {
+        source->TransferData(ctx.get(), output.data_tables);
+      } else {
+        source->TransferData(ctx.get(), MaskDisabledTables(output, masked_tables));
+      }
+    }
+    if (source->push_freq_mgr().Expired() || DataExceedsThreshold(output.data_tables)) {
+      source->PushData(data_push_callback_, output.data_tables);
+    }
+
+    auto now = px::chrono::coarse_steady_clock::now();
+    auto wakeup_time = std::min(source->sampling_freq_mgr().next(), source->push_freq_mgr().next());
+    SleepForDuration(std::chrono::duration_cast<std::chrono::milliseconds>(wakeup_time - now));
+  }
+
+  source->FlushPendingData(data_push_callback_);
+}
+
 bool StirlingImpl::IsRunning() const { return running_; }
 
 Status StirlingImpl::WaitUntilRunning(std::chrono::milliseconds timeout) const {
@@ -24,9 +24,11 @@
 #include <string>
 #include <vector>
 
+#include <absl/container/flat_hash_set.h>
 #include <sole.hpp>
 
 #include "src/common/base/base.h"
+#include "src/shared/upid/upid.h"
 #include "src/stirling/core/pub_sub_manager.h"
 #include "src/stirling/core/source_registry.h"
 #include "src/stirling/proto/stirling.pb.h"
@@ -135,6 +137,14 @@ class Stirling : public NotCopyable {
    */
   virtual void GetPublishProto(stirlingpb::Publish* publish_pb) = 0;
 
+  /**
+   * Populate a delta publication: info classes added or removed since the last call to
+   * GetPublishProto or GetPublishDeltaProto. Returns true if anything changed. Lets the agent
+   * forward a single dynamic tracepoint deployment as a delta instead of republishing the full
+   * schema set. The proto is defined in //src/stirling/proto/stirling.proto.
+   */
+  virtual bool GetPublishDeltaProto(stirlingpb::PublishDelta* delta_pb) = 0;
+
   /**
    * Register call-back from Agent. Used to periodically send data.
    *
@@ -152,6 +162,28 @@ class Stirling : public NotCopyable {
    */
   virtual void RegisterAgentMetadataCallback(AgentMetadataCallback f) = 0;
 
+  /**
+   * Informs Stirling which tables are currently being read by queries. Called by the agent
+   * whenever a query plan is executed, with the source tables of that plan. Tables that have
+   * not appeared in any update for a while are sampled at a crawl
+   * (--stirling_unqueried_table_sample_period_ms) until they are queried again, reclaiming the
+   * CPU and table store memory spent producing data no one reads. Until the first update is
+   * received, all tables are sampled normally.
+   */
+  virtual void UpdateQueriedTables(absl::flat_hash_set<std::string> queried_tables) = 0;
+
+  /**
+   * Temporarily boosts the perf profiler for the target processes. While the request is
+   * active, the profiler drains and symbolizes its BPF state every
+   * --stirling_profiler_on_demand_period_ms (default 1s) instead of every table update period,
+   * so fresh folded stack traces for the targets reach the stack traces table within a second
+   * or two. Intended as the hook for ad-hoc "profile this pod now" requests (e.g. from a UDTF
+   * or an agent RPC). Reverts automatically after `duration`. Returns an error if the perf
+   * profiler source is not running.
+   */
+  virtual Status ProfileOnDemand(absl::flat_hash_set<md::UPID> target_upids,
+                                 std::chrono::milliseconds duration) = 0;
+
   /**
    * Main data collection call. This version blocks, so make sure to wrap a thread around it.
    */
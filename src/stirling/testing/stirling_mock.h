@@ -41,8 +41,14 @@ class MockStirling : public Stirling {
   MOCK_METHOD(StatusOr<stirlingpb::Publish>, GetTracepointInfo, (sole::uuid trace_id), (override));
   MOCK_METHOD(Status, RemoveTracepoint, (sole::uuid trace_id), (override));
   MOCK_METHOD(void, GetPublishProto, (stirlingpb::Publish * publish_pb), (override));
+  MOCK_METHOD(bool, GetPublishDeltaProto, (stirlingpb::PublishDelta * delta_pb), (override));
   MOCK_METHOD(void, RegisterDataPushCallback, (DataPushCallback f), (override));
   MOCK_METHOD(void, RegisterAgentMetadataCallback, (AgentMetadataCallback f), (override));
+  MOCK_METHOD(void, UpdateQueriedTables, (absl::flat_hash_set<std::string> queried_tables),
+              (override));
+  MOCK_METHOD(Status, ProfileOnDemand,
+              (absl::flat_hash_set<md::UPID> target_upids, std::chrono::milliseconds duration),
+              (override));
   MOCK_METHOD(void, Run, (), (override));
   MOCK_METHOD(Status, RunAsThread, (), (override));
   MOCK_METHOD(bool, IsRunning, (), (const override));
@@ -20,11 +20,67 @@
 
 #include <string_view>
 
+#include <absl/base/optimization.h>
+
 #include "src/common/base/base.h"
 
 namespace px {
 namespace stirling {
 
+/**
+ * Companion to BinaryDecoder that extracts fields without per-field bounds checks.
+ * Obtain one through BinaryDecoder::ExtractFixed() or ExtractFixedLayout(), which validate the
+ * total length up-front, so the extractions below compile down to plain loads.
+ * In debug builds, extractions still DCHECK against overruns.
+ */
+class UncheckedBinaryDecoder {
+ public:
+  explicit UncheckedBinaryDecoder(std::string_view buf) : buf_(buf) {}
+
+  size_t BufSize() const { return buf_.size(); }
+  std::string_view Buf() const { return buf_; }
+
+  template <typename TCharType = char>
+  TCharType ExtractChar() {
+    static_assert(sizeof(TCharType) == 1);
+    DCHECK(!buf_.empty());
+    TCharType res = buf_.front();
+    buf_.remove_prefix(1);
+    return res;
+  }
+
+  // Big-endian (network order) extraction, matching BinaryDecoder::ExtractInt().
+  // TNumBytes may be smaller than the destination type, for fields like MySQL's 3-byte lengths.
+  template <typename TIntType, size_t TNumBytes = sizeof(TIntType)>
+  TIntType ExtractBEInt() {
+    DCHECK_GE(buf_.size(), TNumBytes);
+    TIntType val = ::px::utils::BEndianBytesToInt<TIntType, TNumBytes>(buf_);
+    buf_.remove_prefix(TNumBytes);
+    return val;
+  }
+
+  // Little-endian extraction.
+  template <typename TIntType, size_t TNumBytes = sizeof(TIntType)>
+  TIntType ExtractLEInt() {
+    DCHECK_GE(buf_.size(), TNumBytes);
+    TIntType val = ::px::utils::LEndianBytesToInt<TIntType, TNumBytes>(buf_);
+    buf_.remove_prefix(TNumBytes);
+    return val;
+  }
+
+  template <typename TCharType = char>
+  std::basic_string_view<TCharType> ExtractString(size_t len) {
+    static_assert(sizeof(TCharType) == 1);
+    DCHECK_GE(buf_.size(), len);
+    auto tbuf = CreateStringView<TCharType>(buf_);
+    buf_.remove_prefix(len);
+    return tbuf.substr(0, len);
+  }
+
+ private:
+  std::string_view buf_;
+};
+
 /**
  * Provides functions to extract bytes from a bytes buffer.
  */
@@ -42,8 +98,9 @@ class BinaryDecoder {
   template <typename TCharType = char>
   StatusOr<TCharType> ExtractChar() {
     static_assert(sizeof(TCharType) == 1);
-    if (buf_.size() < sizeof(TCharType)) {
-      return error::ResourceUnavailable("Insufficient number of bytes.");
+    if (ABSL_PREDICT_FALSE(buf_.size() < sizeof(TCharType))) {
+      // Code-only status avoids allocating on this hot path; partial frames are common.
+      return Status(statuspb::RESOURCE_UNAVAILABLE);
     }
     TCharType res = buf_.front();
     buf_.remove_prefix(1);
@@ -52,8 +109,8 @@ class BinaryDecoder {
 
   template <typename TIntType>
   StatusOr<TIntType> ExtractInt() {
-    if (buf_.size() < sizeof(TIntType)) {
-      return error::ResourceUnavailable("Insufficient number of bytes.");
+    if (ABSL_PREDICT_FALSE(buf_.size() < sizeof(TIntType))) {
+      return Status(statuspb::RESOURCE_UNAVAILABLE);
     }
     TIntType val = ::px::utils::BEndianBytesToInt<TIntType>(buf_);
     buf_.remove_prefix(sizeof(TIntType));
@@ -63,8 +120,8 @@ class BinaryDecoder {
   template <typename TCharType = char>
   StatusOr<std::basic_string_view<TCharType>> ExtractString(size_t len) {
     static_assert(sizeof(TCharType) == 1);
-    if (buf_.size() < len) {
-      return error::ResourceUnavailable("Insufficient number of bytes.");
+    if (ABSL_PREDICT_FALSE(buf_.size() < len)) {
+      return Status(statuspb::RESOURCE_UNAVAILABLE);
     }
     auto tbuf = CreateStringView<TCharType>(buf_);
     buf_.remove_prefix(len);
@@ -78,8 +135,8 @@ class BinaryDecoder {
     static_assert(sizeof(TCharType) == 1);
     auto tbuf = CreateStringView<TCharType>(buf_);
     size_t pos = tbuf.find(sentinel);
-    if (pos == std::string_view::npos) {
-      return error::NotFound("Could not find sentinel character");
+    if (ABSL_PREDICT_FALSE(pos == std::string_view::npos)) {
+      return Status(statuspb::NOT_FOUND);
     }
     buf_.remove_prefix(pos + 1);
     return tbuf.substr(0, pos);
@@ -92,8 +149,8 @@ class BinaryDecoder {
     static_assert(sizeof(TCharType) == 1);
     auto tbuf = CreateStringView<TCharType>(buf_);
     size_t pos = tbuf.find(sentinel);
-    if (pos == std::string_view::npos) {
-      return error::NotFound("Could not find sentinel character");
+    if (ABSL_PREDICT_FALSE(pos == std::string_view::npos)) {
+      return Status(statuspb::NOT_FOUND);
     }
     buf_.remove_prefix(pos + sentinel.size());
     return tbuf.substr(0, pos);
@@ -104,9 +161,36 @@ class BinaryDecoder {
     return ExtractStringUntil<TCharType>(std::basic_string_view<TCharType>(sentinel));
   }
 
+  // Total wire size of a fixed-width layout described as a list of field types.
+  template <typename... TFieldTypes>
+  static constexpr size_t LayoutSize() {
+    return (sizeof(TFieldTypes) + ... + 0);
+  }
+
+  // Checks once that the buffer holds TSize bytes, then consumes them and returns an
+  // UncheckedBinaryDecoder over them, so each field extraction skips its bounds check.
+  template <size_t TSize>
+  StatusOr<UncheckedBinaryDecoder> ExtractFixed() {
+    if (ABSL_PREDICT_FALSE(buf_.size() < TSize)) {
+      return Status(statuspb::RESOURCE_UNAVAILABLE);
+    }
+    UncheckedBinaryDecoder sub_decoder(buf_.substr(0, TSize));
+    buf_.remove_prefix(TSize);
+    return sub_decoder;
+  }
+
+  // Like ExtractFixed(), with the layout described by its field types.
+  // Example, for a header of {uint8_t version, uint16_t stream, int32_t length}:
+  //   PL_ASSIGN_OR_RETURN(UncheckedBinaryDecoder header,
+  //                       (decoder.ExtractFixedLayout<uint8_t, uint16_t, int32_t>()));
+  template <typename... TFieldTypes>
+  StatusOr<UncheckedBinaryDecoder> ExtractFixedLayout() {
+    return ExtractFixed<LayoutSize<TFieldTypes...>()>();
+  }
+
   Status ExtractBufIgnore(uint64_t num_bytes) {
-    if (buf_.size() < num_bytes) {
-      return error::ResourceUnavailable("Insufficient number of bytes.");
+    if (ABSL_PREDICT_FALSE(buf_.size() < num_bytes)) {
+      return Status(statuspb::RESOURCE_UNAVAILABLE);
     }
     buf_.remove_prefix(num_bytes);
     return Status::OK();
@@ -84,6 +84,37 @@ TEST(BinaryDecoderTest, ExtractStringUntilStr) {
   EXPECT_EQ("name", bin_decoder.Buf());
 }
 
+TEST(BinaryDecoderTest, ExtractFixedLayout) {
+  std::string_view data("\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01");
+  BinaryDecoder bin_decoder(data);
+
+  static_assert(BinaryDecoder::LayoutSize<int8_t, int16_t, int32_t>() == 7);
+
+  ASSERT_OK_AND_ASSIGN(UncheckedBinaryDecoder header,
+                       (bin_decoder.ExtractFixedLayout<int8_t, int16_t, int32_t>()));
+  EXPECT_EQ(header.ExtractBEInt<int8_t>(), 1);
+  EXPECT_EQ(header.ExtractBEInt<int16_t>(), 257);
+  EXPECT_EQ(header.ExtractBEInt<int32_t>(), 16843009);
+  EXPECT_EQ(0, header.BufSize());
+
+  // The fixed layout is consumed from the underlying decoder.
+  EXPECT_EQ(3, bin_decoder.BufSize());
+
+  // Not enough data left for the same layout again.
+  EXPECT_NOT_OK((bin_decoder.ExtractFixedLayout<int8_t, int16_t, int32_t>()));
+  EXPECT_EQ(3, bin_decoder.BufSize());
+}
+
+TEST(BinaryDecoderTest, UncheckedExtractions) {
+  std::string_view data("\x02\x01\x00""abc");
+  BinaryDecoder bin_decoder(data);
+
+  ASSERT_OK_AND_ASSIGN(UncheckedBinaryDecoder sub_decoder, bin_decoder.ExtractFixed<6>());
+  EXPECT_EQ((sub_decoder.ExtractLEInt<int, 3>()), 258);
+  EXPECT_EQ(sub_decoder.ExtractString(3), "abc");
+  EXPECT_EQ(0, sub_decoder.BufSize());
+}
+
 TEST(BinaryDecoderTest, TooShortText) {
   {
     std::string_view data("");
@@ -22,6 +22,9 @@
 #include <link.h>
 #include <sys/auxv.h>
 #include <sys/utsname.h>
+#include <unistd.h>
+
+#include <farmhash.h>
 
 #include <fstream>
 #include <limits>
@@ -39,6 +42,11 @@
 #include "src/common/system/config.h"
 #include "src/common/zlib/zlib_wrapper.h"
 
+DEFINE_string(stirling_linux_headers_cache_dir, "",
+              "If set, prepared Linux header trees are cached in this directory, keyed by kernel "
+              "version signature. Point this at a persistent host path so that restarts (and "
+              "identical nodes sharing the volume) skip the header extraction.");
+
 namespace px {
 namespace stirling {
 namespace utils {
@@ -571,6 +579,73 @@ StatusOr<PackagedLinuxHeadersSpec> FindClosestPackagedLinuxHeaders(
   return selected;
 }
 
+StatusOr<std::string> KernelHeadersSignature(KernelVersion kernel_version,
+                                             const std::filesystem::path& kernel_config) {
+  PL_ASSIGN_OR_RETURN(std::string config_contents, ReadFileToString(kernel_config));
+  uint64_t config_fingerprint = ::util::Fingerprint64(config_contents);
+  return absl::Substitute("$0.$1.$2-$3", static_cast<int>(kernel_version.version),
+                          static_cast<int>(kernel_version.major_rev),
+                          static_cast<int>(kernel_version.minor_rev),
+                          absl::Hex(config_fingerprint));
+}
+
+bool HeadersCacheEntryExists(const std::filesystem::path& cache_entry_dir) {
+  return fs::Exists(cache_entry_dir / "include/generated/uapi/linux/version.h") &&
+         fs::Exists(cache_entry_dir / "include/generated/autoconf.h");
+}
+
+Status SaveHeadersToCache(const std::filesystem::path& headers_dir,
+                          const std::filesystem::path& cache_entry_dir) {
+  PL_RETURN_IF_ERROR(fs::CreateDirectories(cache_entry_dir.parent_path()));
+
+  std::filesystem::path tmp_dir = cache_entry_dir;
+  tmp_dir += absl::Substitute(".tmp-$0", getpid());
+  PL_RETURN_IF_ERROR(fs::RemoveAll(tmp_dir));
+  PL_RETURN_IF_ERROR(fs::Copy(headers_dir, tmp_dir,
+                              std::filesystem::copy_options::recursive |
+                                  std::filesystem::copy_options::copy_symlinks));
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_dir, cache_entry_dir, ec);
+  if (ec) {
+    // Another process may have populated the entry first; its copy is equally valid.
+    PL_RETURN_IF_ERROR(fs::RemoveAll(tmp_dir));
+    if (!HeadersCacheEntryExists(cache_entry_dir)) {
+      return error::Internal("Failed to move prepared headers into the cache: $0", ec.message());
+    }
+  }
+  return Status::OK();
+}
+
+namespace {
+
+// Returns the cache entry location for the prepared headers of the running kernel, or an empty
+// path if the cache is disabled or the kernel's signature could not be computed.
+std::filesystem::path HeadersCacheEntryDir(KernelVersion kernel_version) {
+  if (FLAGS_stirling_linux_headers_cache_dir.empty()) {
+    return {};
+  }
+
+  auto kernel_config_or = FindKernelConfig();
+  if (!kernel_config_or.ok()) {
+    LOG(WARNING) << absl::Substitute("Headers cache disabled, no kernel config found: $0",
+                                     kernel_config_or.msg());
+    return {};
+  }
+
+  auto signature_or = KernelHeadersSignature(kernel_version, kernel_config_or.ValueOrDie());
+  if (!signature_or.ok()) {
+    LOG(WARNING) << absl::Substitute("Headers cache disabled, could not compute signature: $0",
+                                     signature_or.msg());
+    return {};
+  }
+
+  return std::filesystem::path(FLAGS_stirling_linux_headers_cache_dir) /
+         absl::StrCat("linux-headers-", signature_or.ConsumeValueOrDie());
+}
+
+}  // namespace
+
 Status InstallPackagedLinuxHeaders(const std::filesystem::path& lib_modules_dir) {
   // This is the directory in our container images that contains packaged linux headers.
   const std::filesystem::path kPackagedHeadersRoot = "/pl";
@@ -581,6 +656,17 @@ Status InstallPackagedLinuxHeaders(const std::filesystem::path& lib_modules_dir)
 
   PL_ASSIGN_OR_RETURN(KernelVersion kernel_version, GetKernelVersion());
 
+  // If a previous run (or an identical node sharing the cache volume) already prepared headers
+  // for this kernel signature, reuse them and skip the extraction entirely.
+  const std::filesystem::path cache_entry_dir = HeadersCacheEntryDir(kernel_version);
+  if (!cache_entry_dir.empty() && HeadersCacheEntryExists(cache_entry_dir)) {
+    PL_RETURN_IF_ERROR(fs::CreateSymlinkIfNotExists(cache_entry_dir, lib_modules_build_dir));
+    LOG(INFO) << absl::Substitute("Using cached copy of prepared headers at $0",
+                                  cache_entry_dir.string());
+    g_packaged_headers_installed = true;
+    return Status::OK();
+  }
+
   PL_ASSIGN_OR_RETURN(PackagedLinuxHeadersSpec packaged_headers,
                       FindClosestPackagedLinuxHeaders(kPackagedHeadersRoot, kernel_version));
   LOG(INFO) << absl::Substitute("Using packaged header: $0", packaged_headers.path.string());
@@ -591,6 +677,13 @@ Status InstallPackagedLinuxHeaders(const std::filesystem::path& lib_modules_dir)
   LOG(INFO) << absl::Substitute("Successfully installed packaged copy of headers at $0",
                                 lib_modules_build_dir.string());
   g_packaged_headers_installed = true;
+
+  if (!cache_entry_dir.empty()) {
+    Status s = SaveHeadersToCache(packaged_headers.path, cache_entry_dir);
+    LOG_IF(WARNING, !s.ok()) << absl::Substitute(
+        "Failed to save prepared headers to the cache, error: $0", s.ToString());
+  }
+
   return Status::OK();
 }
 
@@ -168,6 +168,38 @@ struct PackagedLinuxHeadersSpec {
 StatusOr<PackagedLinuxHeadersSpec> FindClosestPackagedLinuxHeaders(
     const std::filesystem::path& packaged_headers_root, KernelVersion kernel_version);
 
+/**
+ * Computes a signature identifying the prepared header tree for the running kernel.
+ * The prepared tree depends on the kernel version code (baked into version.h) and on the kernel
+ * config (from which autoconf.h and timeconst.h are generated), so the signature covers both:
+ * it combines the kernel version with a fingerprint of the config file contents.
+ *
+ * @param kernel_version The kernel version to encode in the signature.
+ * @param kernel_config Path to the kernel config file.
+ * @return error if the config file could not be read.
+ */
+StatusOr<std::string> KernelHeadersSignature(KernelVersion kernel_version,
+                                             const std::filesystem::path& kernel_config);
+
+/**
+ * Returns whether the input directory holds a complete cached header tree.
+ * The generated files are the last ones written during preparation, so their presence
+ * indicates a complete entry.
+ */
+bool HeadersCacheEntryExists(const std::filesystem::path& cache_entry_dir);
+
+/**
+ * Copies a prepared header tree into the headers cache.
+ * The tree is first copied to a temporary directory next to the final location and then renamed
+ * into place, so a crash or a concurrent writer cannot leave a torn entry at the final path.
+ *
+ * @param headers_dir Root of the prepared header tree to save.
+ * @param cache_entry_dir Final location of the cache entry.
+ * @return error if the tree could not be copied into place and no valid entry exists.
+ */
+Status SaveHeadersToCache(const std::filesystem::path& headers_dir,
+                          const std::filesystem::path& cache_entry_dir);
+
 Status InstallPackagedLinuxHeaders(const std::filesystem::path& lib_modules_dir);
 
 // After headers are installed, this variable is set to true.
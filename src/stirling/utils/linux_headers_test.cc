@@ -264,6 +264,56 @@ TEST(LinuxHeadersUtils, FindClosestPackagedLinuxHeaders) {
   }
 }
 
+TEST(LinuxHeadersUtils, KernelHeadersSignature) {
+  TempDir tmp_dir;
+
+  std::filesystem::path config_a = tmp_dir.path() / "config_a";
+  std::filesystem::path config_b = tmp_dir.path() / "config_b";
+  ASSERT_OK(WriteFileFromString(config_a, "CONFIG_HZ=250\n"));
+  ASSERT_OK(WriteFileFromString(config_b, "CONFIG_HZ=1000\n"));
+
+  ASSERT_OK_AND_ASSIGN(std::string sig1, KernelHeadersSignature({4, 14, 10}, config_a));
+  ASSERT_OK_AND_ASSIGN(std::string sig2, KernelHeadersSignature({4, 14, 10}, config_a));
+
+  // The signature is deterministic.
+  EXPECT_EQ(sig1, sig2);
+  EXPECT_THAT(sig1, ::testing::StartsWith("4.14.10-"));
+
+  // A different kernel version or a different config produce different signatures.
+  ASSERT_OK_AND_ASSIGN(std::string sig3, KernelHeadersSignature({4, 14, 11}, config_a));
+  EXPECT_NE(sig1, sig3);
+  ASSERT_OK_AND_ASSIGN(std::string sig4, KernelHeadersSignature({4, 14, 10}, config_b));
+  EXPECT_NE(sig1, sig4);
+
+  EXPECT_NOT_OK(KernelHeadersSignature({4, 14, 10}, tmp_dir.path() / "nonexistent"));
+}
+
+TEST(LinuxHeadersUtils, SaveAndReuseHeadersCacheEntry) {
+  TempDir tmp_dir;
+
+  // Build a minimal prepared header tree.
+  std::filesystem::path headers_dir = tmp_dir.path() / "headers";
+  std::filesystem::create_directories(headers_dir / "include/generated/uapi/linux");
+  ASSERT_OK(WriteFileFromString(headers_dir / "include/generated/uapi/linux/version.h",
+                                "#define LINUX_VERSION_CODE 266752\n"));
+  ASSERT_OK(WriteFileFromString(headers_dir / "include/generated/autoconf.h",
+                                "#define CONFIG_HZ 250\n"));
+
+  std::filesystem::path cache_entry_dir = tmp_dir.path() / "cache/linux-headers-4.18.0-abcd";
+
+  EXPECT_FALSE(HeadersCacheEntryExists(cache_entry_dir));
+  ASSERT_OK(SaveHeadersToCache(headers_dir, cache_entry_dir));
+  EXPECT_TRUE(HeadersCacheEntryExists(cache_entry_dir));
+
+  // The cached copy has the same contents as the prepared tree.
+  EXPECT_OK_AND_EQ(ReadFileToString(cache_entry_dir / "include/generated/uapi/linux/version.h"),
+                   "#define LINUX_VERSION_CODE 266752\n");
+
+  // Saving again over an existing entry is not an error.
+  EXPECT_OK(SaveHeadersToCache(headers_dir, cache_entry_dir));
+  EXPECT_TRUE(HeadersCacheEntryExists(cache_entry_dir));
+}
+
 }  // namespace utils
 }  // namespace stirling
 }  // namespace px
@@ -63,7 +63,7 @@ void StirlingMonitor::AppendSourceStatusRecord(const std::string& source_connect
                                                const Status& status, const std::string& context) {
   absl::base_internal::SpinLockHolder lock(&source_status_lock_);
   source_status_records_.push_back(
-      {CurrentTimeNS(), source_connector, status.code(), status.msg(), context});
+      {CurrentCoarseTimeNS(), source_connector, status.code(), status.msg(), context});
 }
 
 void StirlingMonitor::AppendProbeStatusRecord(const std::string& source_connector,
@@ -71,7 +71,7 @@ void StirlingMonitor::AppendProbeStatusRecord(const std::string& source_connecto
                                               const std::string& info) {
   absl::base_internal::SpinLockHolder lock(&probe_status_lock_);
   probe_status_records_.push_back(
-      {CurrentTimeNS(), source_connector, tracepoint, status.code(), status.msg(), info});
+      {CurrentCoarseTimeNS(), source_connector, tracepoint, status.code(), status.msg(), info});
 }
 
 std::vector<SourceStatusRecord> StirlingMonitor::ConsumeSourceStatusRecords() {
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/substitute.h>
+
+#include <magic_enum.hpp>
+
+namespace px {
+namespace stirling {
+namespace utils {
+
+/**
+ * A sharded variant of StatCounter, for counters incremented on per-event hot paths from
+ * multiple threads.
+ *
+ * Each thread is assigned one of TNumShards cache-line-aligned shards, so an increment is a
+ * relaxed atomic add on a line no other core is writing to -- effectively the cost of a plain
+ * store -- rather than a contended RMW on a shared counter. Reads aggregate across all shards,
+ * so Get() and Print() are much more expensive than Increment() and are intended for periodic
+ * scrapes, not hot paths. A read concurrent with increments may miss the newest additions.
+ *
+ * Like StatCounter, the enum values of the key type cannot have custom values.
+ */
+template <typename TKeyType, size_t TNumShards = 16>
+class ShardedStatCounter {
+ public:
+  void Increment(TKeyType key, int64_t count = 1) {
+    shards_[ShardIdx()].counts[static_cast<int>(key)].fetch_add(count,
+                                                                std::memory_order_relaxed);
+  }
+  void Decrement(TKeyType key, int64_t count = 1) {
+    shards_[ShardIdx()].counts[static_cast<int>(key)].fetch_sub(count,
+                                                                std::memory_order_relaxed);
+  }
+  void Reset(TKeyType key) {
+    for (auto& shard : shards_) {
+      shard.counts[static_cast<int>(key)].store(0, std::memory_order_relaxed);
+    }
+  }
+  int64_t Get(TKeyType key) const {
+    int64_t sum = 0;
+    for (const auto& shard : shards_) {
+      sum += shard.counts[static_cast<int>(key)].load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+  std::string Print() const {
+    std::string out;
+    for (auto key : magic_enum::enum_values<TKeyType>()) {
+      absl::StrAppend(&out, absl::Substitute("$0=$1 ", magic_enum::enum_name(key), Get(key)));
+    }
+    return out;
+  }
+
+ private:
+  static constexpr size_t kNumKeys = magic_enum::enum_count<TKeyType>();
+
+  // 64 bytes matches the cache line size of the x86-64 and aarch64 targets we build for;
+  // std::hardware_destructive_interference_size is not available on all of our toolchains.
+  struct alignas(64) Shard {
+    std::array<std::atomic<int64_t>, kNumKeys> counts = {};
+  };
+
+  // Threads are assigned shards round-robin, once per thread. The assignment is shared by all
+  // counters of the same type, which keeps a thread's writes on the same shard lines everywhere.
+  static size_t ShardIdx() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t idx = next_shard.fetch_add(1, std::memory_order_relaxed) % TNumShards;
+    return idx;
+  }
+
+  std::array<Shard, TNumShards> shards_ = {};
+};
+
+}  // namespace utils
+}  // namespace stirling
+}  // namespace px
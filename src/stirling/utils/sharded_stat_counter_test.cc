@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/utils/sharded_stat_counter.h"
+
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+namespace utils {
+
+using ::testing::StrEq;
+
+enum class Key {
+  kFirst,
+  kSecond,
+};
+
+// Tests that ShardedStatCounter tracked values and printed string are correct, mirroring the
+// StatCounter test.
+TEST(ShardedStatCounterTest, CheckValuesAndPrint) {
+  ShardedStatCounter<Key> counter;
+
+  counter.Increment(Key::kFirst);
+  EXPECT_EQ(counter.Get(Key::kFirst), 1);
+
+  counter.Increment(Key::kFirst, 2);
+  EXPECT_EQ(counter.Get(Key::kFirst), 3);
+
+  counter.Decrement(Key::kFirst);
+  EXPECT_EQ(counter.Get(Key::kFirst), 2);
+
+  counter.Decrement(Key::kFirst, 2);
+  EXPECT_EQ(counter.Get(Key::kFirst), 0);
+
+  counter.Decrement(Key::kFirst);
+  EXPECT_EQ(counter.Get(Key::kFirst), -1);
+
+  EXPECT_THAT(counter.Print(), StrEq("kFirst=-1 kSecond=0 "));
+
+  counter.Reset(Key::kFirst);
+  EXPECT_EQ(counter.Get(Key::kFirst), 0);
+}
+
+// Tests that increments from many threads are not lost, regardless of how threads map to shards.
+TEST(ShardedStatCounterTest, ConcurrentIncrements) {
+  constexpr int kNumThreads = 32;
+  constexpr int kIncrementsPerThread = 10000;
+
+  ShardedStatCounter<Key> counter;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&counter]() {
+      for (int j = 0; j < kIncrementsPerThread; ++j) {
+        counter.Increment(Key::kFirst);
+        counter.Increment(Key::kSecond, 2);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(counter.Get(Key::kFirst), kNumThreads * kIncrementsPerThread);
+  EXPECT_EQ(counter.Get(Key::kSecond), 2 * kNumThreads * kIncrementsPerThread);
+}
+
+}  // namespace utils
+}  // namespace stirling
+}  // namespace px
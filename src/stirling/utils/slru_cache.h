@@ -0,0 +1,208 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <list>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace stirling {
+namespace utils {
+
+/**
+ * A bounded cache with a segmented-LRU (SLRU) eviction policy.
+ *
+ * New entries start in a probationary segment; an entry is promoted to the protected segment
+ * the first time it is found again. Evictions take the least-recently-used probationary entry
+ * first, so a burst of one-shot insertions (e.g. unprepared statements from an ORM) churns only
+ * the probationary segment, while repeatedly-used entries survive in the protected segment.
+ *
+ * Hit/miss/eviction counters are maintained for telemetry; Find() counts as a hit or miss.
+ *
+ * The cache is copyable (required by holders such as std::any); copies rebuild the key index.
+ */
+template <typename TKey, typename TValue>
+class SLRUCache {
+ public:
+  // The fraction of the capacity reserved for the protected segment.
+  static constexpr double kProtectedRatio = 0.8;
+
+  explicit SLRUCache(size_t capacity)
+      : capacity_(capacity), protected_capacity_(static_cast<size_t>(capacity * kProtectedRatio)) {}
+
+  SLRUCache(const SLRUCache& other)
+      : capacity_(other.capacity_),
+        protected_capacity_(other.protected_capacity_),
+        probationary_(other.probationary_),
+        protected_(other.protected_),
+        hits_(other.hits_),
+        misses_(other.misses_),
+        evictions_(other.evictions_) {
+    RebuildIndex();
+  }
+
+  SLRUCache& operator=(const SLRUCache& other) {
+    if (this != &other) {
+      capacity_ = other.capacity_;
+      protected_capacity_ = other.protected_capacity_;
+      probationary_ = other.probationary_;
+      protected_ = other.protected_;
+      hits_ = other.hits_;
+      misses_ = other.misses_;
+      evictions_ = other.evictions_;
+      RebuildIndex();
+    }
+    return *this;
+  }
+
+  // Moving a std::list preserves its iterators, so the index can be moved as-is.
+  SLRUCache(SLRUCache&& other) = default;
+  SLRUCache& operator=(SLRUCache&& other) = default;
+
+  /**
+   * Returns a pointer to the value for the key, or nullptr if not present.
+   * A present key is promoted (probationary -> protected, or to the protected MRU position).
+   * The returned pointer is invalidated by the next non-const operation on the cache.
+   */
+  TValue* Find(const TKey& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    Promote(&it->second);
+    return &it->second.iter->second;
+  }
+
+  /**
+   * Inserts or replaces the value for the key. New entries enter the probationary segment.
+   * Returns a pointer to the stored value, invalidated like Find()'s.
+   */
+  TValue* Insert(TKey key, TValue value) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second.iter->second = std::move(value);
+      Promote(&it->second);
+      return &it->second.iter->second;
+    }
+
+    while (size() >= capacity_ && capacity_ > 0) {
+      Evict();
+    }
+
+    probationary_.emplace_front(key, std::move(value));
+    index_[std::move(key)] = IndexEntry{Segment::kProbationary, probationary_.begin()};
+    return &probationary_.front().second;
+  }
+
+  /**
+   * Removes the entry for the key, if present. Returns whether an entry was removed.
+   */
+  bool Erase(const TKey& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    SegmentList(it->second.segment)->erase(it->second.iter);
+    index_.erase(it);
+    return true;
+  }
+
+  bool Contains(const TKey& key) const { return index_.contains(key); }
+
+  size_t size() const { return index_.size(); }
+  bool empty() const { return index_.empty(); }
+  size_t capacity() const { return capacity_; }
+
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  uint64_t evictions() const { return evictions_; }
+
+ private:
+  enum class Segment { kProbationary, kProtected };
+
+  using EntryList = std::list<std::pair<TKey, TValue>>;
+
+  struct IndexEntry {
+    Segment segment;
+    typename EntryList::iterator iter;
+  };
+
+  EntryList* SegmentList(Segment segment) {
+    return segment == Segment::kProbationary ? &probationary_ : &protected_;
+  }
+
+  // Moves a found entry to the protected MRU position, demoting the protected LRU entry to the
+  // probationary segment if the protected segment is full.
+  void Promote(IndexEntry* index_entry) {
+    if (index_entry->segment == Segment::kProtected) {
+      protected_.splice(protected_.begin(), protected_, index_entry->iter);
+      return;
+    }
+
+    if (protected_.size() >= protected_capacity_ && !protected_.empty()) {
+      auto demoted = std::prev(protected_.end());
+      probationary_.splice(probationary_.begin(), protected_, demoted);
+      index_[demoted->first] = IndexEntry{Segment::kProbationary, demoted};
+    }
+
+    protected_.splice(protected_.begin(), probationary_, index_entry->iter);
+    index_entry->segment = Segment::kProtected;
+  }
+
+  // Evicts the probationary LRU entry, falling back to the protected LRU entry if the
+  // probationary segment is empty.
+  void Evict() {
+    EntryList* list = probationary_.empty() ? &protected_ : &probationary_;
+    DCHECK(!list->empty());
+    index_.erase(list->back().first);
+    list->pop_back();
+    ++evictions_;
+  }
+
+  void RebuildIndex() {
+    index_.clear();
+    for (auto iter = probationary_.begin(); iter != probationary_.end(); ++iter) {
+      index_[iter->first] = IndexEntry{Segment::kProbationary, iter};
+    }
+    for (auto iter = protected_.begin(); iter != protected_.end(); ++iter) {
+      index_[iter->first] = IndexEntry{Segment::kProtected, iter};
+    }
+  }
+
+  size_t capacity_;
+  size_t protected_capacity_;
+
+  EntryList probationary_;
+  EntryList protected_;
+  absl::flat_hash_map<TKey, IndexEntry> index_;
+
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+}  // namespace utils
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/utils/slru_cache.h"
+
+#include <string>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+namespace utils {
+
+TEST(SLRUCacheTest, InsertAndFind) {
+  SLRUCache<int, std::string> cache(4);
+
+  cache.Insert(1, "one");
+  cache.Insert(2, "two");
+
+  ASSERT_NE(cache.Find(1), nullptr);
+  EXPECT_EQ(*cache.Find(1), "one");
+  EXPECT_EQ(cache.Find(3), nullptr);
+
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.hits(), 2);
+  EXPECT_EQ(cache.misses(), 1);
+}
+
+TEST(SLRUCacheTest, InsertReplacesExistingValue) {
+  SLRUCache<int, std::string> cache(4);
+
+  cache.Insert(1, "one");
+  cache.Insert(1, "uno");
+
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(*cache.Find(1), "uno");
+}
+
+TEST(SLRUCacheTest, EvictsProbationaryLRUFirst) {
+  SLRUCache<int, std::string> cache(4);
+
+  cache.Insert(1, "one");
+  cache.Insert(2, "two");
+
+  // Promote key 1 to the protected segment.
+  ASSERT_NE(cache.Find(1), nullptr);
+
+  cache.Insert(3, "three");
+  cache.Insert(4, "four");
+
+  // Cache is at capacity; the next insertion evicts the probationary LRU entry (key 2),
+  // not the protected key 1.
+  cache.Insert(5, "five");
+
+  EXPECT_TRUE(cache.Contains(1));
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_TRUE(cache.Contains(3));
+  EXPECT_TRUE(cache.Contains(4));
+  EXPECT_TRUE(cache.Contains(5));
+  EXPECT_EQ(cache.evictions(), 1);
+}
+
+TEST(SLRUCacheTest, HotEntriesSurviveOneShotChurn) {
+  SLRUCache<int, std::string> cache(8);
+
+  cache.Insert(1, "hot1");
+  cache.Insert(2, "hot2");
+  ASSERT_NE(cache.Find(1), nullptr);
+  ASSERT_NE(cache.Find(2), nullptr);
+
+  // A burst of one-shot entries exceeding the capacity several times over.
+  for (int i = 100; i < 200; ++i) {
+    cache.Insert(i, "one-shot");
+  }
+
+  EXPECT_TRUE(cache.Contains(1));
+  EXPECT_TRUE(cache.Contains(2));
+  EXPECT_EQ(cache.size(), 8);
+}
+
+TEST(SLRUCacheTest, Erase) {
+  SLRUCache<int, std::string> cache(4);
+
+  cache.Insert(1, "one");
+  EXPECT_TRUE(cache.Erase(1));
+  EXPECT_FALSE(cache.Erase(1));
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_TRUE(cache.empty());
+}
+
+TEST(SLRUCacheTest, CopyRebuildsIndex) {
+  SLRUCache<int, std::string> cache(4);
+  cache.Insert(1, "one");
+  cache.Insert(2, "two");
+  ASSERT_NE(cache.Find(1), nullptr);
+
+  SLRUCache<int, std::string> copy = cache;
+  ASSERT_NE(copy.Find(1), nullptr);
+  EXPECT_EQ(*copy.Find(1), "one");
+
+  // Mutating the copy does not affect the original.
+  copy.Erase(2);
+  EXPECT_FALSE(copy.Contains(2));
+  EXPECT_TRUE(cache.Contains(2));
+}
+
+}  // namespace utils
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <cmath>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/column_wrapper.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace table_store {
+namespace schema {
+
+/**
+ * Bulk column copy kernels, shared by the operators that rearrange batch data row-by-row
+ * (join output construction, ordered union merge, selection-vector materialization).
+ *
+ * The scalar CopyValue path in row_batch.h appends one value at a time, which pays builder
+ * bookkeeping (validity bitmap append, capacity branch) per row. The helpers here amortize
+ * that over a range: fixed-width ranges become a single Arrow AppendValues (one memcpy),
+ * and gathers coalesce runs of consecutive indices into range copies.
+ *
+ * BOOLEAN (bit-packed) and UINT128 arrays don't expose a raw values pointer, so those fall
+ * back to per-row appends after a single reserve; STRING ranges reserve character data once
+ * and then append views straight out of the source buffer, avoiding per-row std::string
+ * materialization.
+ */
+
+// The fixed-width types whose arrays and wrappers expose contiguous native-value storage.
+template <types::DataType T>
+constexpr bool HasContiguousValues() {
+  return T == types::DataType::INT64 || T == types::DataType::TIME64NS ||
+         T == types::DataType::FLOAT64;
+}
+
+/**
+ * Appends rows [start, start + count) of input_col to the builder.
+ */
+template <types::DataType T>
+Status CopyValueRange(arrow::ArrayBuilder* output_col_builder, const arrow::Array* input_col,
+                      int64_t start, int64_t count) {
+  auto* typed_builder =
+      static_cast<typename types::DataTypeTraits<T>::arrow_builder_type*>(output_col_builder);
+  const auto* typed_col =
+      static_cast<const typename types::DataTypeTraits<T>::arrow_array_type*>(input_col);
+
+  if constexpr (HasContiguousValues<T>()) {
+    PL_RETURN_IF_ERROR(typed_builder->AppendValues(typed_col->raw_values() + start, count));
+  } else if constexpr (T == types::DataType::STRING) {
+    const char* chars = reinterpret_cast<const char*>(typed_col->value_data()->data());
+    int64_t bytes = typed_col->value_offset(start + count) - typed_col->value_offset(start);
+    int64_t total = bytes + typed_builder->value_data_length();
+    if (total >= typed_builder->value_data_capacity()) {
+      PL_RETURN_IF_ERROR(typed_builder->ReserveData(std::lrint(1.5 * total)));
+    }
+    PL_RETURN_IF_ERROR(typed_builder->Reserve(count));
+    for (int64_t i = start; i < start + count; ++i) {
+      typed_builder->UnsafeAppend(chars + typed_col->value_offset(i), typed_col->value_length(i));
+    }
+  } else {
+    PL_RETURN_IF_ERROR(typed_builder->Reserve(count));
+    for (int64_t i = start; i < start + count; ++i) {
+      typed_builder->UnsafeAppend(typed_col->Value(i));
+    }
+  }
+  return Status::OK();
+}
+
+/**
+ * Appends input_col[indices[i]] to the builder for each index, in order. Runs of consecutive
+ * indices — common in selection vectors produced by filters — are coalesced into range copies.
+ */
+template <types::DataType T>
+Status GatherValues(arrow::ArrayBuilder* output_col_builder, const arrow::Array* input_col,
+                    const std::vector<int64_t>& indices) {
+  auto* typed_builder =
+      static_cast<typename types::DataTypeTraits<T>::arrow_builder_type*>(output_col_builder);
+  PL_RETURN_IF_ERROR(typed_builder->Reserve(indices.size()));
+
+  if constexpr (T == types::DataType::STRING) {
+    const auto* typed_col = static_cast<const arrow::StringArray*>(input_col);
+    int64_t total = typed_builder->value_data_length();
+    for (int64_t idx : indices) {
+      total += typed_col->value_length(idx);
+    }
+    if (total >= typed_builder->value_data_capacity()) {
+      PL_RETURN_IF_ERROR(typed_builder->ReserveData(std::lrint(1.5 * total)));
+    }
+    const char* chars = reinterpret_cast<const char*>(typed_col->value_data()->data());
+    for (int64_t idx : indices) {
+      typed_builder->UnsafeAppend(chars + typed_col->value_offset(idx),
+                                  typed_col->value_length(idx));
+    }
+  } else if constexpr (HasContiguousValues<T>()) {
+    const auto* values =
+        static_cast<const typename types::DataTypeTraits<T>::arrow_array_type*>(input_col)
+            ->raw_values();
+    size_t run_start = 0;
+    while (run_start < indices.size()) {
+      size_t run_end = run_start + 1;
+      while (run_end < indices.size() && indices[run_end] == indices[run_end - 1] + 1) {
+        ++run_end;
+      }
+      if (run_end - run_start == 1) {
+        typed_builder->UnsafeAppend(values[indices[run_start]]);
+      } else {
+        PL_RETURN_IF_ERROR(
+            typed_builder->AppendValues(values + indices[run_start], run_end - run_start));
+      }
+      run_start = run_end;
+    }
+  } else {
+    const auto* typed_col =
+        static_cast<const typename types::DataTypeTraits<T>::arrow_array_type*>(input_col);
+    for (int64_t idx : indices) {
+      typed_builder->UnsafeAppend(typed_col->Value(idx));
+    }
+  }
+  return Status::OK();
+}
+
+/**
+ * Appends rows [start, start + count) of a ColumnWrapper to the builder. The fixed-size value
+ * wrappers are single-member structs over their native type, so for the contiguous types the
+ * wrapper's backing array is handed to Arrow's AppendValues directly.
+ */
+template <types::DataType T>
+Status CopyWrapperRange(arrow::ArrayBuilder* output_col_builder,
+                        const types::ColumnWrapper* input_wrapper, size_t start, size_t count) {
+  using ValueType = typename types::DataTypeTraits<T>::value_type;
+  auto* typed_builder =
+      static_cast<typename types::DataTypeTraits<T>::arrow_builder_type*>(output_col_builder);
+  const auto* data =
+      static_cast<const types::ColumnWrapperTmpl<ValueType>*>(input_wrapper)->UnsafeRawData() +
+      start;
+
+  if constexpr (HasContiguousValues<T>()) {
+    using NativeType = typename types::DataTypeTraits<T>::native_type;
+    static_assert(sizeof(ValueType) == sizeof(NativeType));
+    PL_RETURN_IF_ERROR(
+        typed_builder->AppendValues(reinterpret_cast<const NativeType*>(data), count));
+  } else if constexpr (T == types::DataType::STRING) {
+    int64_t total = typed_builder->value_data_length();
+    for (size_t i = 0; i < count; ++i) {
+      total += data[i].size();
+    }
+    if (total >= typed_builder->value_data_capacity()) {
+      PL_RETURN_IF_ERROR(typed_builder->ReserveData(std::lrint(1.5 * total)));
+    }
+    PL_RETURN_IF_ERROR(typed_builder->Reserve(count));
+    for (size_t i = 0; i < count; ++i) {
+      typed_builder->UnsafeAppend(data[i]);
+    }
+  } else {
+    PL_RETURN_IF_ERROR(typed_builder->Reserve(count));
+    for (size_t i = 0; i < count; ++i) {
+      typed_builder->UnsafeAppend(data[i].val);
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace schema
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <memory>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/column_wrapper.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/schema/column_copy.h"
+
+namespace px {
+namespace table_store {
+namespace schema {
+
+std::shared_ptr<arrow::Array> FinishBuilder(arrow::ArrayBuilder* builder) {
+  std::shared_ptr<arrow::Array> out;
+  PL_CHECK_OK(builder->Finish(&out));
+  return out;
+}
+
+TEST(ColumnCopyTest, copy_value_range_int64) {
+  std::vector<types::Int64Value> in = {1, 2, 3, 4, 5};
+  auto col = types::ToArrow(in, arrow::default_memory_pool());
+
+  auto builder = types::MakeArrowBuilder(types::DataType::INT64, arrow::default_memory_pool());
+  ASSERT_OK(CopyValueRange<types::DataType::INT64>(builder.get(), col.get(), 1, 3));
+  auto out = FinishBuilder(builder.get());
+
+  std::vector<types::Int64Value> expected = {2, 3, 4};
+  EXPECT_TRUE(out->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+}
+
+TEST(ColumnCopyTest, copy_value_range_string) {
+  std::vector<types::StringValue> in = {"ab", "", "cdef", "g", "hi"};
+  auto col = types::ToArrow(in, arrow::default_memory_pool());
+
+  auto builder = types::MakeArrowBuilder(types::DataType::STRING, arrow::default_memory_pool());
+  ASSERT_OK(CopyValueRange<types::DataType::STRING>(builder.get(), col.get(), 0, 4));
+  // A second range append must grow the character data correctly.
+  ASSERT_OK(CopyValueRange<types::DataType::STRING>(builder.get(), col.get(), 4, 1));
+  auto out = FinishBuilder(builder.get());
+
+  EXPECT_TRUE(out->Equals(types::ToArrow(in, arrow::default_memory_pool())));
+}
+
+TEST(ColumnCopyTest, copy_value_range_boolean) {
+  std::vector<types::BoolValue> in = {true, false, true, true};
+  auto col = types::ToArrow(in, arrow::default_memory_pool());
+
+  auto builder = types::MakeArrowBuilder(types::DataType::BOOLEAN, arrow::default_memory_pool());
+  ASSERT_OK(CopyValueRange<types::DataType::BOOLEAN>(builder.get(), col.get(), 1, 3));
+  auto out = FinishBuilder(builder.get());
+
+  std::vector<types::BoolValue> expected = {false, true, true};
+  EXPECT_TRUE(out->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+}
+
+TEST(ColumnCopyTest, gather_values_coalesces_runs) {
+  std::vector<types::Float64Value> in = {0.5, 1.5, 2.5, 3.5, 4.5, 5.5};
+  auto col = types::ToArrow(in, arrow::default_memory_pool());
+
+  // A mix of a consecutive run, a single index, and an out-of-order jump.
+  std::vector<int64_t> indices = {1, 2, 3, 5, 0};
+  auto builder = types::MakeArrowBuilder(types::DataType::FLOAT64, arrow::default_memory_pool());
+  ASSERT_OK(GatherValues<types::DataType::FLOAT64>(builder.get(), col.get(), indices));
+  auto out = FinishBuilder(builder.get());
+
+  std::vector<types::Float64Value> expected = {1.5, 2.5, 3.5, 5.5, 0.5};
+  EXPECT_TRUE(out->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+}
+
+TEST(ColumnCopyTest, gather_values_string) {
+  std::vector<types::StringValue> in = {"aa", "b", "", "cccc", "dd"};
+  auto col = types::ToArrow(in, arrow::default_memory_pool());
+
+  std::vector<int64_t> indices = {4, 0, 0, 2, 3};
+  auto builder = types::MakeArrowBuilder(types::DataType::STRING, arrow::default_memory_pool());
+  ASSERT_OK(GatherValues<types::DataType::STRING>(builder.get(), col.get(), indices));
+  auto out = FinishBuilder(builder.get());
+
+  std::vector<types::StringValue> expected = {"dd", "aa", "aa", "", "cccc"};
+  EXPECT_TRUE(out->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+}
+
+TEST(ColumnCopyTest, copy_wrapper_range_int64) {
+  auto wrapper = types::ColumnWrapper::Make(types::DataType::INT64, 0);
+  for (int64_t i = 0; i < 6; ++i) {
+    wrapper->Append<types::Int64Value>(10 * i);
+  }
+
+  auto builder = types::MakeArrowBuilder(types::DataType::INT64, arrow::default_memory_pool());
+  ASSERT_OK(CopyWrapperRange<types::DataType::INT64>(builder.get(), wrapper.get(), 2, 3));
+  auto out = FinishBuilder(builder.get());
+
+  std::vector<types::Int64Value> expected = {20, 30, 40};
+  EXPECT_TRUE(out->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+}
+
+TEST(ColumnCopyTest, copy_wrapper_range_string) {
+  auto wrapper = types::ColumnWrapper::Make(types::DataType::STRING, 0);
+  std::vector<types::StringValue> in = {"x", "yy", "zzz", ""};
+  for (const auto& val : in) {
+    wrapper->Append<types::StringValue>(val);
+  }
+
+  auto builder = types::MakeArrowBuilder(types::DataType::STRING, arrow::default_memory_pool());
+  ASSERT_OK(CopyWrapperRange<types::DataType::STRING>(builder.get(), wrapper.get(), 0, 4));
+  auto out = FinishBuilder(builder.get());
+
+  EXPECT_TRUE(out->Equals(types::ToArrow(in, arrow::default_memory_pool())));
+}
+
+}  // namespace schema
+}  // namespace table_store
+}  // namespace px
@@ -17,15 +17,21 @@
  */
 
 #include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/util/bit-util.h>
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <absl/strings/str_format.h>
 #include "src/common/base/base.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/type_utils.h"
+#include "src/table_store/schema/column_copy.h"
 #include "src/table_store/schema/row_batch.h"
 
 namespace px {
@@ -48,6 +54,16 @@ Status RowBatch::AddColumn(const std::shared_ptr<arrow::Array>& col) {
   }
 
   columns_.emplace_back(col);
+  // null_count() is computed (and cached by Arrow) on first call for sliced arrays; a batch-long
+  // bitmap popcount here buys every downstream consumer a branch-free kernel check.
+  const int64_t null_count = col->null_count();
+  if (null_count == 0) {
+    null_stats_.push_back(ColumnNullStats::kAllValid);
+  } else if (null_count == num_rows_) {
+    null_stats_.push_back(ColumnNullStats::kAllNull);
+  } else {
+    null_stats_.push_back(ColumnNullStats::kMayHaveNulls);
+  }
   return Status::OK();
 }
 
@@ -78,6 +94,36 @@ int64_t RowBatch::NumBytes() const {
   return total_bytes;
 }
 
+namespace {
+
+template <DataType T>
+Status GatherSelectedValues(const std::vector<int64_t>& selection, const arrow::Array* input_col,
+                            RowBatch* output_rb, arrow::MemoryPool* mem_pool) {
+  auto builder = types::MakeArrowBuilder(T, mem_pool);
+  PL_RETURN_IF_ERROR(GatherValues<T>(builder.get(), input_col, selection));
+  std::shared_ptr<arrow::Array> output_array;
+  PL_RETURN_IF_ERROR(builder->Finish(&output_array));
+  return output_rb->AddColumn(output_array);
+}
+
+}  // namespace
+
+StatusOr<std::unique_ptr<RowBatch>> RowBatch::MaterializeSelection(
+    arrow::MemoryPool* mem_pool) const {
+  DCHECK(has_selection());
+  auto output_rb = std::make_unique<RowBatch>(desc_, num_selected_rows());
+  for (size_t col_idx = 0; col_idx < columns_.size(); ++col_idx) {
+#define TYPE_CASE(_dt_)                                            \
+  PL_RETURN_IF_ERROR(GatherSelectedValues<_dt_>(*selection_, columns_[col_idx].get(), \
+                                                output_rb.get(), mem_pool));
+    PL_SWITCH_FOREACH_DATATYPE(desc_.type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+  }
+  output_rb->set_eow(eow_);
+  output_rb->set_eos(eos_);
+  return output_rb;
+}
+
 // Serialize/deserialize from protobuf.
 
 // PL_CARNOT_UPDATE_FOR_NEW_TYPES
@@ -159,6 +205,7 @@ Status CopyFromInputPB(std::shared_ptr<arrow::Array>* output_column,
 }
 
 Status RowBatch::ToProto(table_store::schemapb::RowBatchData* proto) const {
+  DCHECK(!has_selection()) << "Materialize the selection before serializing.";
   proto->set_num_rows(num_rows_);
   proto->set_eow(eow_);
   proto->set_eos(eos_);
@@ -223,6 +270,188 @@ StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromProto(
   return output_rb;
 }
 
+namespace {
+
+// An arrow::Buffer view into externally-owned memory (a parsed proto field, an mmapped
+// snapshot region) that keeps the owner alive for the lifetime of the buffer.
+class BorrowedBuffer : public arrow::Buffer {
+ public:
+  BorrowedBuffer(std::string_view data, std::shared_ptr<const void> owner)
+      : arrow::Buffer(reinterpret_cast<const uint8_t*>(data.data()),
+                      static_cast<int64_t>(data.size())),
+        owner_(std::move(owner)) {}
+
+ private:
+  std::shared_ptr<const void> owner_;
+};
+
+// Copies `length` bits starting at `bit_offset` into a freshly-aligned bitmap.
+std::string CopyBitmapRange(const uint8_t* bitmap, int64_t bit_offset, int64_t length) {
+  std::string out((length + 7) / 8, '\0');
+  if (bit_offset % 8 == 0) {
+    std::memcpy(out.data(), bitmap + bit_offset / 8, out.size());
+  } else {
+    for (int64_t i = 0; i < length; ++i) {
+      if (arrow::BitUtil::GetBit(bitmap, bit_offset + i)) {
+        arrow::BitUtil::SetBit(reinterpret_cast<uint8_t*>(out.data()), i);
+      }
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+Status RowBatch::ToArrowBuffersProto(
+    table_store::schemapb::ArrowRowBatchData* row_batch_proto) const {
+  CHECK(row_batch_proto != nullptr);
+  DCHECK(!has_selection()) << "Materialize the selection before serializing.";
+  row_batch_proto->set_num_rows(num_rows_);
+  row_batch_proto->set_eow(eow_);
+  row_batch_proto->set_eos(eos_);
+
+  for (size_t col_idx = 0; col_idx < columns_.size(); ++col_idx) {
+    const auto& arr = columns_[col_idx];
+    auto dt = desc_.type(col_idx);
+    row_batch_proto->add_col_types(dt);
+    auto* col = row_batch_proto->add_cols();
+
+    if (!ColumnAllValid(col_idx)) {
+      col->set_null_bitmap(CopyBitmapRange(arr->null_bitmap_data(), arr->offset(), num_rows_));
+    }
+
+    switch (dt) {
+      case DataType::BOOLEAN: {
+        auto typed = static_cast<arrow::BooleanArray*>(arr.get());
+        if (num_rows_ > 0) {
+          col->set_data(CopyBitmapRange(typed->values()->data(), typed->offset(), num_rows_));
+        }
+        break;
+      }
+      case DataType::STRING: {
+        auto typed = static_cast<arrow::StringArray*>(arr.get());
+        // Offsets are rebased so the shipped character data starts at zero, which also
+        // handles sliced arrays.
+        int32_t first = num_rows_ > 0 ? typed->value_offset(0) : 0;
+        int32_t last = num_rows_ > 0 ? typed->value_offset(num_rows_) : 0;
+        std::string offsets((num_rows_ + 1) * sizeof(int32_t), '\0');
+        auto* out_offsets = reinterpret_cast<int32_t*>(offsets.data());
+        for (int64_t i = 1; i <= num_rows_; ++i) {
+          out_offsets[i] = typed->value_offset(i) - first;
+        }
+        col->set_offsets(std::move(offsets));
+        if (last > first) {
+          col->set_data(typed->value_data()->data() + first, last - first);
+        }
+        break;
+      }
+      default: {
+        // All remaining types are fixed width; ship the values buffer directly.
+        if (num_rows_ > 0) {
+          int64_t width = types::ArrowTypeToBytes(arr->type_id());
+          const uint8_t* values = arr->data()->buffers[1]->data() + arr->offset() * width;
+          col->set_data(values, num_rows_ * width);
+        }
+      }
+    }
+  }
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromArrowColumnBuffers(
+    const std::vector<types::DataType>& col_types, int64_t num_rows,
+    const std::vector<ArrowColumnBuffers>& cols, std::shared_ptr<const void> buffer_owner) {
+  if (cols.size() != col_types.size()) {
+    return error::InvalidArgument("Mismatched cols ($0) and col_types ($1)", cols.size(),
+                                  col_types.size());
+  }
+
+  RowDescriptor desc(col_types);
+  auto output_rb = std::make_unique<RowBatch>(desc, num_rows);
+
+  for (size_t i = 0; i < cols.size(); ++i) {
+    const auto& col = cols[i];
+    auto dt = col_types[i];
+
+    std::shared_ptr<arrow::Buffer> validity;
+    int64_t null_count = 0;
+    if (!col.null_bitmap.empty()) {
+      validity = std::make_shared<BorrowedBuffer>(col.null_bitmap, buffer_owner);
+      null_count = arrow::kUnknownNullCount;
+    }
+    auto data = std::make_shared<BorrowedBuffer>(col.data, buffer_owner);
+
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+    switch (dt) {
+      case DataType::BOOLEAN:
+        if (col.data.size() < static_cast<size_t>((num_rows + 7) / 8)) {
+          return error::InvalidArgument("Short BOOLEAN buffer in column $0", i);
+        }
+        buffers = {validity, data};
+        break;
+      case DataType::STRING: {
+        if (col.offsets.size() != static_cast<size_t>(num_rows + 1) * sizeof(int32_t)) {
+          return error::InvalidArgument("Bad STRING offsets in column $0", i);
+        }
+        // The offsets may come off the wire and are used to index the data buffer unchecked
+        // once wrapped, so validate their contents, not just the buffer length.
+        const auto* offset_vals = reinterpret_cast<const int32_t*>(col.offsets.data());
+        if (offset_vals[0] != 0) {
+          return error::InvalidArgument("STRING offsets in column $0 must start at 0", i);
+        }
+        for (int64_t row = 0; row < num_rows; ++row) {
+          if (offset_vals[row + 1] < offset_vals[row]) {
+            return error::InvalidArgument("Non-monotonic STRING offsets in column $0", i);
+          }
+        }
+        if (static_cast<size_t>(offset_vals[num_rows]) > col.data.size()) {
+          return error::InvalidArgument("STRING offsets in column $0 exceed the data buffer", i);
+        }
+        auto offsets = std::make_shared<BorrowedBuffer>(col.offsets, buffer_owner);
+        buffers = {validity, offsets, data};
+        break;
+      }
+      default: {
+        int64_t width = types::ArrowTypeToBytes(types::ToArrowType(dt));
+        if (col.data.size() != static_cast<size_t>(num_rows * width)) {
+          return error::InvalidArgument("Bad values buffer in column $0", i);
+        }
+        buffers = {validity, data};
+      }
+    }
+
+    auto arrow_type = types::MakeArrowBuilder(dt, arrow::default_memory_pool())->type();
+    auto array_data = arrow::ArrayData::Make(arrow_type, num_rows, std::move(buffers), null_count);
+    PL_RETURN_IF_ERROR(output_rb->AddColumn(arrow::MakeArray(array_data)));
+  }
+
+  return output_rb;
+}
+
+StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromArrowBuffersProto(
+    const table_store::schemapb::ArrowRowBatchData& proto,
+    std::shared_ptr<const void> buffer_owner) {
+  if (proto.cols_size() != proto.col_types_size()) {
+    return error::InvalidArgument("Mismatched cols ($0) and col_types ($1) in ArrowRowBatchData",
+                                  proto.cols_size(), proto.col_types_size());
+  }
+
+  std::vector<DataType> types;
+  types.reserve(proto.col_types_size());
+  std::vector<ArrowColumnBuffers> cols;
+  cols.reserve(proto.cols_size());
+  for (auto i = 0; i < proto.cols_size(); ++i) {
+    types.push_back(proto.col_types(i));
+    cols.push_back({proto.cols(i).data(), proto.cols(i).offsets(), proto.cols(i).null_bitmap()});
+  }
+
+  PL_ASSIGN_OR_RETURN(auto output_rb, FromArrowColumnBuffers(types, proto.num_rows(), cols,
+                                                             std::move(buffer_owner)));
+  output_rb->set_eow(proto.eow());
+  output_rb->set_eos(proto.eos());
+  return output_rb;
+}
+
 StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromColumnBuilders(
     const RowDescriptor& desc, bool eow, bool eos,
     std::vector<std::unique_ptr<arrow::ArrayBuilder>>* builders) {
@@ -253,6 +482,7 @@ StatusOr<std::unique_ptr<RowBatch>> RowBatch::WithZeroRows(const RowDescriptor&
 }
 
 StatusOr<std::unique_ptr<RowBatch>> RowBatch::Slice(int64_t offset, int64_t length) const {
+  DCHECK(!has_selection()) << "Materialize the selection before slicing.";
   if (offset + length > num_rows() || offset < 0) {
     return error::InvalidArgument("Slice(offset=$0, length=$1) on rowbatch of length $2 is invalid",
                                   offset, length, num_rows());
@@ -23,6 +23,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -33,6 +34,17 @@ namespace px {
 namespace table_store {
 namespace schema {
 
+/**
+ * Batch-level null statistics for one column, derived from the Arrow array's null count when
+ * the column is added. Evaluators and UDAs can check kAllValid to select branch-free kernels
+ * that skip the validity bitmap entirely — true for essentially all Stirling-generated data.
+ */
+enum class ColumnNullStats : int8_t {
+  kAllValid = 0,
+  kAllNull,
+  kMayHaveNulls,
+};
+
 /**
  * A RowBatch is a table-like structure which consists of equal-length arrays
  * that match the schema described by the RowDescriptor.
@@ -53,6 +65,41 @@ class RowBatch {
   static StatusOr<std::unique_ptr<RowBatch>> FromProto(
       const table_store::schemapb::RowBatchData& row_batch_proto);
 
+  /**
+   * Serializes this batch's columns as raw Arrow buffers (bulk memcpys) instead of the
+   * per-value encoding that ToProto performs.
+   */
+  Status ToArrowBuffersProto(table_store::schemapb::ArrowRowBatchData* row_batch_proto) const;
+  /**
+   * Reconstructs a RowBatch by wrapping the proto's buffers in place, without copying the
+   * column data. `buffer_owner` must keep the proto's memory alive (typically a
+   * shared_ptr to the enclosing request) and is retained by the returned columns.
+   */
+  static StatusOr<std::unique_ptr<RowBatch>> FromArrowBuffersProto(
+      const table_store::schemapb::ArrowRowBatchData& row_batch_proto,
+      std::shared_ptr<const void> buffer_owner);
+
+  /**
+   * Raw buffer spans for one column, in the layout produced by ToArrowBuffersProto:
+   * fixed-width value buffers, rebased STRING offsets, and an optional validity bitmap
+   * (empty when all values are valid).
+   */
+  struct ArrowColumnBuffers {
+    std::string_view data;
+    std::string_view offsets;
+    std::string_view null_bitmap;
+  };
+
+  /**
+   * Reconstructs a RowBatch by wrapping the given buffer spans in place, without copying.
+   * `buffer_owner` must keep the spans' memory alive (e.g. a parsed proto or an mmapped
+   * snapshot region) and is retained by the returned columns. Shared by FromArrowBuffersProto
+   * and the table snapshot restore path.
+   */
+  static StatusOr<std::unique_ptr<RowBatch>> FromArrowColumnBuffers(
+      const std::vector<types::DataType>& col_types, int64_t num_rows,
+      const std::vector<ArrowColumnBuffers>& cols, std::shared_ptr<const void> buffer_owner);
+
   static StatusOr<std::unique_ptr<RowBatch>> FromColumnBuilders(
       const RowDescriptor& desc, bool eow, bool eos,
       std::vector<std::unique_ptr<arrow::ArrayBuilder>>* builders);
@@ -94,6 +141,60 @@ class RowBatch {
    */
   bool HasColumn(int64_t i) const;
 
+  /**
+   * @ param i the index of the column to check.
+   * @ returns the null statistics for the column at the given index.
+   */
+  ColumnNullStats column_null_stats(int64_t i) const { return null_stats_[i]; }
+
+  /**
+   * @ param i the index of the column to check.
+   * @ returns whether the column at the given index has no null values.
+   */
+  bool ColumnAllValid(int64_t i) const { return null_stats_[i] == ColumnNullStats::kAllValid; }
+
+  /**
+   * @ returns whether no column in the batch has any null values.
+   */
+  bool AllColumnsValid() const {
+    for (const auto& stats : null_stats_) {
+      if (stats != ColumnNullStats::kAllValid) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Attaches a selection vector: the ascending row indices that are logically present in the
+   * batch. Columns keep their full physical length and are typically shared with the input
+   * batch, so a filter can emit its result without copying any column data. Consumers that do
+   * not understand selections must call MaterializeSelection() first.
+   */
+  void SetSelectionVector(std::shared_ptr<const std::vector<int64_t>> selection) {
+    selection_ = std::move(selection);
+  }
+
+  bool has_selection() const { return selection_ != nullptr; }
+
+  /**
+   * @ return the selection vector. Only valid if has_selection().
+   */
+  const std::vector<int64_t>& selection_vector() const { return *selection_; }
+
+  /**
+   * @ return the number of logically present rows: the selected rows if a selection vector is
+   * attached, otherwise the physical row count.
+   */
+  int64_t num_selected_rows() const {
+    return has_selection() ? static_cast<int64_t>(selection_->size()) : num_rows_;
+  }
+
+  /**
+   * Copies the selected rows into a new, selection-free row batch. eow/eos are carried over.
+   */
+  StatusOr<std::unique_ptr<RowBatch>> MaterializeSelection(arrow::MemoryPool* mem_pool) const;
+
   /**
    * @ return the number of rows that each row batch should contain.
    */
@@ -126,6 +227,10 @@ class RowBatch {
   bool eow_ = false;
   bool eos_ = false;
   std::vector<std::shared_ptr<arrow::Array>> columns_;
+  // Parallel to columns_; filled in by AddColumn.
+  std::vector<ColumnNullStats> null_stats_;
+  // Row indices logically present in the batch; nullptr means all rows.
+  std::shared_ptr<const std::vector<int64_t>> selection_;
 };
 
 // Append a scalar value to an arrow::Array.
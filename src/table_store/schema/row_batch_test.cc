@@ -17,8 +17,10 @@
  */
 
 #include <arrow/array.h>
+#include <arrow/builder.h>
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/util/message_differencer.h>
+#include <cstring>
 #include <vector>
 
 #include "src/common/testing/testing.h"
@@ -80,6 +82,88 @@ TEST_F(RowBatchTest, basic_test) {
       rb_->DebugString());
 }
 
+TEST_F(RowBatchTest, null_stats_all_valid) {
+  // ToArrow never appends nulls, so every column should report all-valid.
+  EXPECT_TRUE(rb_->ColumnAllValid(0));
+  EXPECT_TRUE(rb_->ColumnAllValid(1));
+  EXPECT_TRUE(rb_->ColumnAllValid(2));
+  EXPECT_TRUE(rb_->AllColumnsValid());
+  EXPECT_EQ(ColumnNullStats::kAllValid, rb_->column_null_stats(0));
+}
+
+TEST_F(RowBatchTest, null_stats_with_nulls) {
+  auto rb = std::make_unique<RowBatch>(*rd_, 3);
+
+  arrow::BooleanBuilder bool_builder;
+  EXPECT_TRUE(bool_builder.Append(true).ok());
+  EXPECT_TRUE(bool_builder.AppendNull().ok());
+  EXPECT_TRUE(bool_builder.Append(false).ok());
+  std::shared_ptr<arrow::Array> bool_col;
+  EXPECT_TRUE(bool_builder.Finish(&bool_col).ok());
+  EXPECT_TRUE(rb->AddColumn(bool_col).ok());
+
+  arrow::Int64Builder int_builder;
+  EXPECT_TRUE(int_builder.AppendNull().ok());
+  EXPECT_TRUE(int_builder.AppendNull().ok());
+  EXPECT_TRUE(int_builder.AppendNull().ok());
+  std::shared_ptr<arrow::Array> int_col;
+  EXPECT_TRUE(int_builder.Finish(&int_col).ok());
+  EXPECT_TRUE(rb->AddColumn(int_col).ok());
+
+  std::vector<types::Float64Value> in3 = {3.3, 4.1, 5.6};
+  EXPECT_TRUE(rb->AddColumn(types::ToArrow(in3, arrow::default_memory_pool())).ok());
+
+  EXPECT_EQ(ColumnNullStats::kMayHaveNulls, rb->column_null_stats(0));
+  EXPECT_EQ(ColumnNullStats::kAllNull, rb->column_null_stats(1));
+  EXPECT_EQ(ColumnNullStats::kAllValid, rb->column_null_stats(2));
+  EXPECT_FALSE(rb->ColumnAllValid(0));
+  EXPECT_FALSE(rb->AllColumnsValid());
+
+  // A slice covering only the valid prefix of the float column stays all-valid, while a slice
+  // into the partially-null bool column recomputes its own stats.
+  auto slice = rb->Slice(2, 1).ConsumeValueOrDie();
+  EXPECT_TRUE(slice->ColumnAllValid(0));
+  EXPECT_EQ(ColumnNullStats::kAllNull, slice->column_null_stats(1));
+  EXPECT_TRUE(slice->ColumnAllValid(2));
+}
+
+TEST_F(RowBatchTest, selection_vector_materialize) {
+  EXPECT_FALSE(rb_->has_selection());
+  EXPECT_EQ(3, rb_->num_selected_rows());
+
+  rb_->SetSelectionVector(std::make_shared<std::vector<int64_t>>(std::vector<int64_t>{0, 2}));
+  EXPECT_TRUE(rb_->has_selection());
+  EXPECT_EQ(2, rb_->num_selected_rows());
+  EXPECT_EQ(3, rb_->num_rows());
+
+  auto out = rb_->MaterializeSelection(arrow::default_memory_pool()).ConsumeValueOrDie();
+  EXPECT_FALSE(out->has_selection());
+  EXPECT_EQ(2, out->num_rows());
+
+  std::vector<types::BoolValue> expected0 = {true, true};
+  std::vector<types::Int64Value> expected1 = {3, 5};
+  std::vector<types::Float64Value> expected2 = {3.3, 5.6};
+  EXPECT_TRUE(out->ColumnAt(0)->Equals(types::ToArrow(expected0, arrow::default_memory_pool())));
+  EXPECT_TRUE(out->ColumnAt(1)->Equals(types::ToArrow(expected1, arrow::default_memory_pool())));
+  EXPECT_TRUE(out->ColumnAt(2)->Equals(types::ToArrow(expected2, arrow::default_memory_pool())));
+}
+
+TEST(RowBatchSelectionTest, materialize_string_column) {
+  RowDescriptor rd({types::DataType::STRING});
+  RowBatch rb(rd, 3);
+  std::vector<types::StringValue> in = {"abc", "de", "fghi"};
+  EXPECT_TRUE(rb.AddColumn(types::ToArrow(in, arrow::default_memory_pool())).ok());
+  rb.SetSelectionVector(std::make_shared<std::vector<int64_t>>(std::vector<int64_t>{0, 2}));
+  rb.set_eos(true);
+  rb.set_eow(true);
+
+  auto out = rb.MaterializeSelection(arrow::default_memory_pool()).ConsumeValueOrDie();
+  std::vector<types::StringValue> expected = {"abc", "fghi"};
+  EXPECT_TRUE(out->ColumnAt(0)->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+  EXPECT_TRUE(out->eow());
+  EXPECT_TRUE(out->eos());
+}
+
 TEST_F(RowBatchTest, extra_col_test) {
   std::vector<types::BoolValue> in4 = {true, false, true};
   EXPECT_FALSE(rb_->AddColumn(types::ToArrow(in4, arrow::default_memory_pool())).ok());
@@ -179,6 +263,107 @@ TEST_F(RowBatchTest, to_from_proto) {
   EXPECT_TRUE(differ.Compare(input_proto, output_proto));
 }
 
+TEST_F(RowBatchTest, to_from_arrow_buffers_proto) {
+  auto descriptor =
+      std::vector<types::DataType>({types::DataType::BOOLEAN, types::DataType::INT64,
+                                    types::DataType::FLOAT64, types::DataType::STRING});
+  RowDescriptor rd = RowDescriptor(descriptor);
+  auto rb = std::make_unique<RowBatch>(rd, 3);
+  rb->set_eow(true);
+
+  std::vector<types::BoolValue> in1 = {true, false, true};
+  std::vector<types::Int64Value> in2 = {3, 4, 5};
+  std::vector<types::Float64Value> in3 = {3.3, 4.1, 5.6};
+  std::vector<types::StringValue> in4 = {"hello", "thisIs", "aString"};
+
+  EXPECT_OK(rb->AddColumn(types::ToArrow(in1, arrow::default_memory_pool())));
+  EXPECT_OK(rb->AddColumn(types::ToArrow(in2, arrow::default_memory_pool())));
+  EXPECT_OK(rb->AddColumn(types::ToArrow(in3, arrow::default_memory_pool())));
+  EXPECT_OK(rb->AddColumn(types::ToArrow(in4, arrow::default_memory_pool())));
+
+  auto proto = std::make_shared<table_store::schemapb::ArrowRowBatchData>();
+  EXPECT_OK(rb->ToArrowBuffersProto(proto.get()));
+
+  auto out_rb = RowBatch::FromArrowBuffersProto(*proto, proto).ConsumeValueOrDie();
+  EXPECT_EQ(rd, out_rb->desc());
+  EXPECT_EQ(3, out_rb->num_rows());
+  EXPECT_TRUE(out_rb->eow());
+  EXPECT_FALSE(out_rb->eos());
+  for (int64_t i = 0; i < rb->num_columns(); ++i) {
+    EXPECT_TRUE(rb->ColumnAt(i)->Equals(out_rb->ColumnAt(i))) << "Column " << i;
+  }
+}
+
+TEST_F(RowBatchTest, to_from_arrow_buffers_proto_sliced) {
+  auto descriptor = std::vector<types::DataType>({types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor rd = RowDescriptor(descriptor);
+  auto rb = std::make_unique<RowBatch>(rd, 4);
+
+  std::vector<types::Int64Value> in1 = {1, 2, 3, 4};
+  std::vector<types::StringValue> in2 = {"a", "bb", "ccc", "dddd"};
+  EXPECT_OK(rb->AddColumn(types::ToArrow(in1, arrow::default_memory_pool())));
+  EXPECT_OK(rb->AddColumn(types::ToArrow(in2, arrow::default_memory_pool())));
+
+  // Slicing produces arrays with non-zero offsets, which the encoder must rebase.
+  ASSERT_OK_AND_ASSIGN(auto sliced, rb->Slice(1, 2));
+
+  auto proto = std::make_shared<table_store::schemapb::ArrowRowBatchData>();
+  EXPECT_OK(sliced->ToArrowBuffersProto(proto.get()));
+
+  auto out_rb = RowBatch::FromArrowBuffersProto(*proto, proto).ConsumeValueOrDie();
+  EXPECT_EQ(2, out_rb->num_rows());
+  for (int64_t i = 0; i < sliced->num_columns(); ++i) {
+    EXPECT_TRUE(sliced->ColumnAt(i)->Equals(out_rb->ColumnAt(i))) << "Column " << i;
+  }
+}
+
+TEST_F(RowBatchTest, from_arrow_buffers_proto_rejects_malformed_offsets) {
+  auto descriptor = std::vector<types::DataType>({types::DataType::STRING});
+  RowDescriptor rd = RowDescriptor(descriptor);
+  auto rb = std::make_unique<RowBatch>(rd, 2);
+
+  std::vector<types::StringValue> in = {"ab", "cd"};
+  EXPECT_OK(rb->AddColumn(types::ToArrow(in, arrow::default_memory_pool())));
+
+  auto proto = std::make_shared<table_store::schemapb::ArrowRowBatchData>();
+  EXPECT_OK(rb->ToArrowBuffersProto(proto.get()));
+
+  // Offsets must be validated before the buffers are wrapped; each corruption below would
+  // otherwise make the string array index out of bounds.
+  auto corrupt = [&](int64_t idx, int32_t value) {
+    auto corrupted = std::make_shared<table_store::schemapb::ArrowRowBatchData>(*proto);
+    auto* offsets = corrupted->mutable_cols(0)->mutable_offsets();
+    int32_t le_value = value;
+    memcpy(offsets->data() + idx * sizeof(int32_t), &le_value, sizeof(int32_t));
+    return corrupted;
+  };
+
+  // First offset not zero.
+  auto bad_first = corrupt(0, 1);
+  EXPECT_NOT_OK(RowBatch::FromArrowBuffersProto(*bad_first, bad_first));
+
+  // Decreasing offsets.
+  auto bad_order = corrupt(1, -1);
+  EXPECT_NOT_OK(RowBatch::FromArrowBuffersProto(*bad_order, bad_order));
+
+  // Final offset past the end of the data buffer.
+  auto bad_end = corrupt(2, 100);
+  EXPECT_NOT_OK(RowBatch::FromArrowBuffersProto(*bad_end, bad_end));
+}
+
+TEST_F(RowBatchTest, to_from_arrow_buffers_proto_zero_rows) {
+  auto rb = RowBatch::WithZeroRows(*rd_, /*eow*/ true, /*eos*/ true).ConsumeValueOrDie();
+
+  auto proto = std::make_shared<table_store::schemapb::ArrowRowBatchData>();
+  EXPECT_OK(rb->ToArrowBuffersProto(proto.get()));
+
+  auto out_rb = RowBatch::FromArrowBuffersProto(*proto, proto).ConsumeValueOrDie();
+  EXPECT_EQ(*rd_, out_rb->desc());
+  EXPECT_EQ(0, out_rb->num_rows());
+  EXPECT_TRUE(out_rb->eow());
+  EXPECT_TRUE(out_rb->eos());
+}
+
 TEST_F(RowBatchTest, with_zero_rows) {
   bool eow = true;
   bool eos = false;
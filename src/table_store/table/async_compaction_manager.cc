@@ -0,0 +1,157 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/resource.h>
+
+#include <memory>
+#include <utility>
+
+#include "src/table_store/table/async_compaction_manager.h"
+
+namespace px {
+namespace table_store {
+
+AsyncCompactionManager::AsyncCompactionManager(TableStore* table_store,
+                                               arrow::MemoryPool* mem_pool, size_t num_threads,
+                                               int64_t batches_per_tick)
+    : table_store_(table_store),
+      mem_pool_(mem_pool),
+      num_threads_(num_threads),
+      batches_per_tick_(batches_per_tick) {}
+
+AsyncCompactionManager::~AsyncCompactionManager() { Stop(); }
+
+void AsyncCompactionManager::Start() {
+  DCHECK(workers_.empty());
+  workers_.reserve(num_threads_);
+  for (size_t i = 0; i < num_threads_; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+void AsyncCompactionManager::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (stop_) {
+      return;
+    }
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void AsyncCompactionManager::SchedulePass() {
+  auto tables = table_store_->GetTables();
+  auto rollups = table_store_->GetRollups();
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    for (auto& table : tables) {
+      if (!table->CompactionNeeded() && !table->ReclaimNeeded()) {
+        continue;
+      }
+      if (pending_.insert(table.get()).second) {
+        queue_.push_back(std::move(table));
+      }
+    }
+    for (auto* rollup : rollups) {
+      if (!rollup->HasWork()) {
+        continue;
+      }
+      if (rollup_pending_.insert(rollup).second) {
+        rollup_queue_.push_back(rollup);
+      }
+    }
+  }
+  work_cv_.notify_all();
+}
+
+void AsyncCompactionManager::WaitForIdle() {
+  std::unique_lock<std::mutex> lock(lock_);
+  idle_cv_.wait(lock,
+                [this] { return queue_.empty() && rollup_queue_.empty() && num_active_ == 0; });
+}
+
+void AsyncCompactionManager::WorkerLoop() {
+  // Compaction should lose the CPU to data ingest and query execution, so drop the worker to
+  // the lowest scheduling priority. Best effort: on Linux this sets the niceness of the
+  // calling thread only.
+  setpriority(PRIO_PROCESS, 0, 19);
+
+  std::unique_lock<std::mutex> lock(lock_);
+  while (true) {
+    work_cv_.wait(lock, [this] { return stop_ || !queue_.empty() || !rollup_queue_.empty(); });
+    if (stop_) {
+      return;
+    }
+
+    // Compaction takes priority over rollup maintenance: it is what relieves memory pressure.
+    if (!queue_.empty()) {
+      auto table = queue_.front();
+      queue_.pop_front();
+      ++num_active_;
+      lock.unlock();
+
+      // Restore headroom before compacting: expiring old batches down to the table's low
+      // watermark is what keeps the write path from having to expire inline. A no-op for
+      // tables below their high watermark.
+      auto status = table->ReclaimBatches(batches_per_tick_);
+      if (status.ok()) {
+        status = table->CompactHotToCold(mem_pool_, batches_per_tick_);
+      }
+      LOG_IF(ERROR, !status.ok()) << "Table compaction failed: " << status.msg();
+      bool more_work = status.ok() && (table->CompactionNeeded() || table->ReclaimNeeded());
+
+      lock.lock();
+      --num_active_;
+      pending_.erase(table.get());
+      if (more_work && !stop_ && pending_.insert(table.get()).second) {
+        queue_.push_back(std::move(table));
+        work_cv_.notify_one();
+      }
+    } else {
+      auto* rollup = rollup_queue_.front();
+      rollup_queue_.pop_front();
+      ++num_active_;
+      lock.unlock();
+
+      auto more_work_or_s = rollup->ProcessBatches(batches_per_tick_);
+      LOG_IF(ERROR, !more_work_or_s.ok())
+          << "Rollup processing failed: " << more_work_or_s.msg();
+      bool more_work = more_work_or_s.ok() && more_work_or_s.ValueOrDie();
+
+      lock.lock();
+      --num_active_;
+      rollup_pending_.erase(rollup);
+      if (more_work && !stop_ && rollup_pending_.insert(rollup).second) {
+        rollup_queue_.push_back(rollup);
+        work_cv_.notify_one();
+      }
+    }
+
+    if (queue_.empty() && rollup_queue_.empty() && num_active_ == 0) {
+      idle_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace table_store
+}  // namespace px
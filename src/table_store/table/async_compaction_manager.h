@@ -0,0 +1,118 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <absl/container/flat_hash_set.h>
+
+#include "src/table_store/table/table_store.h"
+
+namespace px {
+namespace table_store {
+
+/**
+ * AsyncCompactionManager runs hot-to-cold table compaction on a dedicated low-priority thread
+ * pool, so that the event loop thread that ingests data and schedules queries never blocks on
+ * compaction work.
+ *
+ * `SchedulePass` (called periodically from the event loop) enqueues every table that has
+ * compactable hot data or has grown past its expiry high watermark. Each worker tick first
+ * reclaims expired batches down to the table's low watermark and then compacts a bounded
+ * number of cold batches, re-enqueueing the table at the back of the queue if it still has
+ * work, so a single large table cannot starve the others and memory pressure from an ingest
+ * burst is worked off incrementally. Keeping expiry here, off the write path, means writes at
+ * the table size limit don't pay for eviction inline (see Table::ReclaimBatches).
+ *
+ * The workers also maintain the table store's rollups (see TableRollup): `SchedulePass`
+ * enqueues every rollup with unprocessed source batches, and worker ticks fold a bounded
+ * number of batches per rollup once the table queue is drained, so downsampling rides the
+ * compaction cadence without competing with compaction for memory relief.
+ *
+ * Tables and rollups are internally synchronized, so workers only rely on their own locking;
+ * the `TableStore` itself is only touched from `SchedulePass` on the caller's thread, which
+ * must also serialize against rollup registration.
+ */
+class AsyncCompactionManager {
+ public:
+  static constexpr size_t kDefaultNumThreads = 1;
+  // Maximum number of cold batches to create for a single table in one worker tick.
+  static constexpr int64_t kDefaultBatchesPerTick = 16;
+
+  AsyncCompactionManager(TableStore* table_store, arrow::MemoryPool* mem_pool,
+                         size_t num_threads = kDefaultNumThreads,
+                         int64_t batches_per_tick = kDefaultBatchesPerTick);
+  ~AsyncCompactionManager();
+
+  /**
+   * Start spawns the worker threads. Must be called before `SchedulePass`.
+   */
+  void Start();
+
+  /**
+   * Stop shuts down the worker threads. In-flight compaction ticks are finished, queued work
+   * is dropped. Called by the destructor if not called explicitly.
+   */
+  void Stop();
+
+  /**
+   * SchedulePass enqueues every table in the table store that has compactable hot data or
+   * needs batches reclaimed, and every rollup that has unprocessed source batches, then
+   * returns immediately. Entries that are already queued or being worked on are not enqueued
+   * again.
+   */
+  void SchedulePass();
+
+  /**
+   * WaitForIdle blocks until the queue is drained and no worker is compacting. Only used by
+   * tests.
+   */
+  void WaitForIdle();
+
+ private:
+  void WorkerLoop();
+
+  TableStore* table_store_;
+  arrow::MemoryPool* mem_pool_;
+  const size_t num_threads_;
+  const int64_t batches_per_tick_;
+
+  std::mutex lock_;
+  std::condition_variable work_cv_;
+  std::condition_variable idle_cv_;
+  std::deque<std::shared_ptr<Table>> queue_;
+  // Tables that are queued or currently being compacted, to avoid duplicate queue entries.
+  absl::flat_hash_set<const Table*> pending_;
+  // Rollups with source batches to fold. Worked on only when the table queue is empty, since
+  // compaction is what relieves memory pressure. Rollups are owned by the table store and
+  // never removed, so raw pointers are safe here.
+  std::deque<TableRollup*> rollup_queue_;
+  absl::flat_hash_set<const TableRollup*> rollup_pending_;
+  size_t num_active_ = 0;
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace table_store
+}  // namespace px
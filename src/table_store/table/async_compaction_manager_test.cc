@@ -0,0 +1,144 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <memory>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/table_store/table/async_compaction_manager.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+std::shared_ptr<Table> MakeTableWithPendingCompaction() {
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+  int64_t rb_size = 8 * sizeof(int64_t);
+  // compacted_batch_size of one row batch, so each written batch is immediately compactable.
+  auto table = std::make_shared<Table>("test_table", rel, 128 * rb_size, rb_size);
+
+  for (int i = 0; i < 4; ++i) {
+    auto rb = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 8);
+    std::vector<types::Int64Value> col(8, i);
+    PL_CHECK_OK(rb.AddColumn(types::ToArrow(col, arrow::default_memory_pool())));
+    PL_CHECK_OK(table->WriteRowBatch(rb));
+  }
+  return table;
+}
+
+}  // namespace
+
+TEST(AsyncCompactionManagerTest, compacts_scheduled_tables_in_background) {
+  TableStore table_store;
+  auto table_a = MakeTableWithPendingCompaction();
+  auto table_b = MakeTableWithPendingCompaction();
+  table_store.AddTable(table_a, "a");
+  table_store.AddTable(table_b, "b");
+
+  EXPECT_TRUE(table_a->CompactionNeeded());
+  EXPECT_TRUE(table_b->CompactionNeeded());
+
+  AsyncCompactionManager manager(&table_store, arrow::default_memory_pool(),
+                                 /* num_threads */ 2, /* batches_per_tick */ 1);
+  manager.Start();
+  manager.SchedulePass();
+  manager.WaitForIdle();
+
+  // batches_per_tick is 1, so draining the tables requires the workers to re-enqueue them.
+  EXPECT_FALSE(table_a->CompactionNeeded());
+  EXPECT_FALSE(table_b->CompactionNeeded());
+  EXPECT_GT(table_a->GetTableStats().compacted_batches, 0);
+  EXPECT_GT(table_b->GetTableStats().compacted_batches, 0);
+
+  // A pass over fully compacted tables is a no-op.
+  manager.SchedulePass();
+  manager.WaitForIdle();
+  manager.Stop();
+}
+
+TEST(AsyncCompactionManagerTest, reclaims_tables_past_high_watermark) {
+  TableStore table_store;
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+  int64_t rb_size = 4 * sizeof(int64_t);
+  // 3 batches of 32 bytes = 96 bytes in a 100 byte table: past the high watermark, under the
+  // limit, so nothing is expired inline on write.
+  auto table = std::make_shared<Table>("test_table", rel, /* max_table_size */ 100);
+  for (int i = 0; i < 3; ++i) {
+    auto rb = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 4);
+    std::vector<types::Int64Value> col(4, i);
+    PL_CHECK_OK(rb.AddColumn(types::ToArrow(col, arrow::default_memory_pool())));
+    PL_CHECK_OK(table->WriteRowBatch(rb));
+  }
+  table_store.AddTable(table, "t");
+  EXPECT_TRUE(table->ReclaimNeeded());
+
+  AsyncCompactionManager manager(&table_store, arrow::default_memory_pool(),
+                                 /* num_threads */ 1, /* batches_per_tick */ 1);
+  manager.Start();
+  manager.SchedulePass();
+  manager.WaitForIdle();
+  manager.Stop();
+
+  // The workers evicted the oldest batch, bringing the table below its low watermark.
+  EXPECT_FALSE(table->ReclaimNeeded());
+  EXPECT_EQ(table->GetTableStats().bytes, 2 * rb_size);
+  EXPECT_EQ(table->GetTableStats().batches_expired, 1);
+}
+
+TEST(AsyncCompactionManagerTest, processes_rollups_in_background) {
+  TableStore table_store;
+  schema::Relation rel({types::DataType::TIME64NS, types::DataType::INT64},
+                       {"time_", "latency"});
+  auto table = Table::Create("events", rel);
+  table_store.AddTable(table, "events");
+
+  RollupSpec spec;
+  spec.src_table_name = "events";
+  spec.rollup_table_name = "events_rollup";
+  spec.bucket_width_ns = 10;
+  spec.aggs = {{"latency", RollupSpec::AggKind::kSum, "latency_sum"}};
+  ASSERT_OK(table_store.AddRollup(spec));
+
+  auto rb = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 3);
+  std::vector<types::Time64NSValue> times = {1, 5, 12};
+  std::vector<types::Int64Value> latencies = {2, 3, 7};
+  PL_CHECK_OK(rb.AddColumn(types::ToArrow(times, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb.AddColumn(types::ToArrow(latencies, arrow::default_memory_pool())));
+  PL_CHECK_OK(table->WriteRowBatch(rb));
+
+  AsyncCompactionManager manager(&table_store, arrow::default_memory_pool(),
+                                 /* num_threads */ 2, /* batches_per_tick */ 1);
+  manager.Start();
+  manager.SchedulePass();
+  manager.WaitForIdle();
+  manager.Stop();
+
+  // Bucket [0, 10) was completed by the row at t=12 and flushed to the companion table.
+  auto* rollup_table = table_store.GetTable("events_rollup");
+  Table::Cursor cursor(rollup_table);
+  auto out = cursor.GetNextRowBatch().ConsumeValueOrDie();
+  EXPECT_EQ(1, out->num_rows());
+  EXPECT_EQ(0, types::GetValueFromArrowArray<types::DataType::TIME64NS>(out->ColumnAt(0).get(),
+                                                                        0));
+  EXPECT_EQ(5,
+            types::GetValueFromArrowArray<types::DataType::INT64>(out->ColumnAt(1).get(), 0));
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "src/table_store/table/internal/arena_memory_pool.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+namespace {
+
+// Matches arrow's default buffer alignment, so buffers handed out by the arena satisfy the same
+// alignment guarantees as the system pool.
+constexpr size_t kBufferAlignment = 64;
+
+size_t AlignedSize(int64_t size) {
+  size_t s = std::max<int64_t>(size, 1);
+  return (s + kBufferAlignment - 1) & ~(kBufferAlignment - 1);
+}
+
+}  // namespace
+
+ArenaMemoryPool::~ArenaMemoryPool() {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  DCHECK_EQ(0, bytes_allocated_) << "ArenaMemoryPool destroyed with live allocations";
+  for (auto& [addr, slab] : slabs_) {
+    std::free(slab.data);
+  }
+}
+
+arrow::Status ArenaMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  ARROW_RETURN_NOT_OK(AllocateLocked(size, out));
+  bytes_allocated_ += size;
+  max_memory_ = std::max(max_memory_, bytes_allocated_);
+  return arrow::Status::OK();
+}
+
+arrow::Status ArenaMemoryPool::AllocateLocked(int64_t size, uint8_t** out) {
+  *out = nullptr;
+  size_t aligned = AlignedSize(size);
+
+  // Allocations that would consume most of a slab get a dedicated one, so they don't crowd out
+  // the bump slab and leave its remainder stranded.
+  if (aligned >= slab_size_) {
+    uint8_t* data = nullptr;
+    if (posix_memalign(reinterpret_cast<void**>(&data), kBufferAlignment, aligned) != 0) {
+      return arrow::Status::OutOfMemory("ArenaMemoryPool failed to allocate ", size, " bytes");
+    }
+    slabs_.emplace(reinterpret_cast<uintptr_t>(data), Slab{data, aligned, aligned, 1});
+    *out = data;
+    return arrow::Status::OK();
+  }
+
+  if (current_ == nullptr || current_->offset + aligned > current_->capacity) {
+    uint8_t* data = nullptr;
+    if (posix_memalign(reinterpret_cast<void**>(&data), kBufferAlignment, slab_size_) != 0) {
+      return arrow::Status::OutOfMemory("ArenaMemoryPool failed to allocate ", size, " bytes");
+    }
+    auto [it, inserted] = slabs_.emplace(reinterpret_cast<uintptr_t>(data), Slab{data, slab_size_});
+    DCHECK(inserted);
+    current_ = &it->second;
+  }
+
+  *out = current_->data + current_->offset;
+  current_->offset += aligned;
+  current_->live_allocs++;
+  return arrow::Status::OK();
+}
+
+arrow::Status ArenaMemoryPool::Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  size_t aligned_old = AlignedSize(old_size);
+  size_t aligned_new = AlignedSize(new_size);
+
+  if (aligned_old != aligned_new) {
+    auto it = FindSlab(*ptr);
+    auto& slab = it->second;
+    size_t buffer_offset = *ptr - slab.data;
+    // Builders grow their buffers repeatedly; if this is the most recent allocation of its slab
+    // the bump offset can simply be moved, avoiding a copy.
+    bool is_tail = buffer_offset + aligned_old == slab.offset;
+    if (is_tail && buffer_offset + aligned_new <= slab.capacity) {
+      slab.offset = buffer_offset + aligned_new;
+    } else {
+      uint8_t* out = nullptr;
+      ARROW_RETURN_NOT_OK(AllocateLocked(new_size, &out));
+      std::memcpy(out, *ptr, std::min(old_size, new_size));
+      FreeLocked(*ptr, old_size);
+      *ptr = out;
+    }
+  }
+
+  bytes_allocated_ += new_size - old_size;
+  max_memory_ = std::max(max_memory_, bytes_allocated_);
+  return arrow::Status::OK();
+}
+
+void ArenaMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  FreeLocked(buffer, size);
+  bytes_allocated_ -= size;
+}
+
+void ArenaMemoryPool::FreeLocked(uint8_t* buffer, int64_t size) {
+  auto it = FindSlab(buffer);
+  auto& slab = it->second;
+  size_t aligned = AlignedSize(size);
+
+  // Reclaim bump space when the most recent allocation of a slab is freed.
+  if (static_cast<size_t>(buffer - slab.data) + aligned == slab.offset) {
+    slab.offset -= aligned;
+  }
+  slab.live_allocs--;
+  DCHECK_GE(slab.live_allocs, 0);
+  if (slab.live_allocs == 0) {
+    if (&slab == current_) {
+      // Keep the bump slab for reuse instead of churning through the allocator.
+      slab.offset = 0;
+      return;
+    }
+    std::free(slab.data);
+    slabs_.erase(it);
+  }
+}
+
+std::map<uintptr_t, ArenaMemoryPool::Slab>::iterator ArenaMemoryPool::FindSlab(uint8_t* buffer) {
+  auto it = slabs_.upper_bound(reinterpret_cast<uintptr_t>(buffer));
+  DCHECK(it != slabs_.begin());
+  --it;
+  DCHECK_LT(reinterpret_cast<uintptr_t>(buffer),
+            reinterpret_cast<uintptr_t>(it->second.data) + it->second.capacity);
+  return it;
+}
+
+int64_t ArenaMemoryPool::bytes_allocated() const {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  return bytes_allocated_;
+}
+
+int64_t ArenaMemoryPool::max_memory() const {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  return max_memory_;
+}
+
+size_t ArenaMemoryPool::NumSlabs() const {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  return slabs_.size();
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include <absl/base/internal/spinlock.h>
+#include <arrow/memory_pool.h>
+#include <arrow/status.h>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * ArenaMemoryPool is an arrow MemoryPool that bump-allocates out of large contiguous slabs.
+ * Each table owns one, so a table's arrow buffers (hot column caches, compacted cold batches,
+ * decoded column slices) end up packed next to each other rather than interleaved with every
+ * other table's allocations in the global heap. Freed space within a slab is not reused; a slab
+ * is returned to the OS wholesale once every allocation carved from it has been freed, which
+ * matches the FIFO expiry pattern of table batches. NUMA placement follows the kernel's
+ * first-touch policy: a slab lands on the node of the thread that first writes it, so batches
+ * written and compacted on one socket stay local to it.
+ *
+ * Buffers allocated from the pool call back into it when they are destroyed, so they must not
+ * outlive the owning table. All methods are thread-safe.
+ */
+class ArenaMemoryPool : public arrow::MemoryPool {
+ public:
+  static constexpr size_t kDefaultSlabSize = 1ULL << 20;
+
+  explicit ArenaMemoryPool(size_t slab_size = kDefaultSlabSize) : slab_size_(slab_size) {}
+  ~ArenaMemoryPool() override;
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+
+  /**
+   * NumSlabs returns the number of slabs currently held. Intended for tests and stats.
+   */
+  size_t NumSlabs() const;
+
+ private:
+  struct Slab {
+    uint8_t* data;
+    size_t capacity;
+    // Bump offset: the next allocation from this slab starts here.
+    size_t offset = 0;
+    // Number of allocations carved from this slab that have not been freed yet. The slab is
+    // released when this drops to zero.
+    int64_t live_allocs = 0;
+  };
+
+  arrow::Status AllocateLocked(int64_t size, uint8_t** out)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void FreeLocked(uint8_t* buffer, int64_t size) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the slab that `buffer` was allocated from.
+  std::map<uintptr_t, Slab>::iterator FindSlab(uint8_t* buffer)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const size_t slab_size_;
+  mutable absl::base_internal::SpinLock lock_;
+  // Slabs keyed by the address of their first byte, so the slab containing an arbitrary
+  // pointer can be found with an upper_bound lookup.
+  std::map<uintptr_t, Slab> slabs_ ABSL_GUARDED_BY(lock_);
+  // The slab new allocations are bumped from, or nullptr if none has room.
+  Slab* current_ ABSL_GUARDED_BY(lock_) = nullptr;
+  int64_t bytes_allocated_ ABSL_GUARDED_BY(lock_) = 0;
+  int64_t max_memory_ ABSL_GUARDED_BY(lock_) = 0;
+};
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/arena_memory_pool.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+TEST(ArenaMemoryPoolTest, packs_allocations_into_slabs) {
+  ArenaMemoryPool pool;
+
+  std::vector<uint8_t*> ptrs(8);
+  for (auto& ptr : ptrs) {
+    ASSERT_TRUE(pool.Allocate(100, &ptr).ok());
+    // Buffers are aligned the same as arrow's system pool.
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(ptr) % 64);
+  }
+  // All allocations fit in a single slab, bump-allocated back to back.
+  EXPECT_EQ(1, pool.NumSlabs());
+  for (size_t i = 1; i < ptrs.size(); ++i) {
+    EXPECT_EQ(128, ptrs[i] - ptrs[i - 1]);
+  }
+  EXPECT_EQ(800, pool.bytes_allocated());
+
+  for (auto* ptr : ptrs) {
+    pool.Free(ptr, 100);
+  }
+  EXPECT_EQ(0, pool.bytes_allocated());
+  // The bump slab is kept for reuse.
+  EXPECT_EQ(1, pool.NumSlabs());
+}
+
+TEST(ArenaMemoryPoolTest, slabs_are_released_wholesale) {
+  ArenaMemoryPool pool(/* slab_size */ 256);
+
+  std::vector<uint8_t*> ptrs(8);
+  for (auto& ptr : ptrs) {
+    ASSERT_TRUE(pool.Allocate(128, &ptr).ok());
+  }
+  EXPECT_EQ(4, pool.NumSlabs());
+
+  // Freeing in FIFO order releases each drained slab, except the current bump slab.
+  for (auto* ptr : ptrs) {
+    pool.Free(ptr, 128);
+  }
+  EXPECT_EQ(1, pool.NumSlabs());
+  EXPECT_EQ(0, pool.bytes_allocated());
+}
+
+TEST(ArenaMemoryPoolTest, reallocate_grows_tail_allocation_in_place) {
+  ArenaMemoryPool pool;
+
+  uint8_t* ptr = nullptr;
+  ASSERT_TRUE(pool.Allocate(64, &ptr).ok());
+  ptr[0] = 42;
+  uint8_t* orig = ptr;
+  // The most recent allocation of a slab grows by moving the bump offset, without a copy.
+  ASSERT_TRUE(pool.Reallocate(64, 256, &ptr).ok());
+  EXPECT_EQ(orig, ptr);
+  EXPECT_EQ(42, ptr[0]);
+  EXPECT_EQ(256, pool.bytes_allocated());
+  pool.Free(ptr, 256);
+}
+
+TEST(ArenaMemoryPoolTest, backs_arrow_builders) {
+  ArenaMemoryPool pool;
+
+  std::vector<types::StringValue> strings = {"pl/vizier-pem", "pl/kelvin", "pl/nats"};
+  auto arr = types::ToArrow(strings, &pool);
+  ASSERT_NE(nullptr, arr);
+  EXPECT_GT(pool.bytes_allocated(), 0);
+  for (size_t i = 0; i < strings.size(); ++i) {
+    EXPECT_EQ(std::string(strings[i]), types::GetStringViewFromArrowArray(arr.get(), i));
+  }
+
+  // Dropping the array returns its buffers to the arena.
+  arr.reset();
+  EXPECT_EQ(0, pool.bytes_allocated());
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -51,6 +51,10 @@ class ArrowArrayCompactor {
    * columns) reserve space for columns data given by col_size_bytes.
    * To prevent extraneous copies/allocations, `Reserve` should be called once with the total size
    * of the compacted batch.
+   * Reservations are deltas on top of the builders' current unused capacity, so the compactor can
+   * be reused across compaction rounds: calling `Reserve` for the next round's sizes immediately
+   * after `Finish` (while the builders are empty) makes the next round's `Reserve` a no-op and
+   * issues the round's single allocation ahead of time.
    * @param num_rows Number of rows needed for the compacted batch.
    * @param variable_col_size_bytes Vector of sizes in bytes for each column, ignoring fixed costs.
    * For all columns that aren't strings, this should be 0. For string columns, we need to reserve
@@ -146,6 +146,46 @@ TEST_P(ArrowArrayCompactorTest, SlicedCompaction) {
       std::vector<types::StringValue>{"s", "one", "very"}, arrow::default_memory_pool())));
 }
 
+TEST_P(ArrowArrayCompactorTest, ReuseAcrossRounds) {
+  std::vector<types::Time64NSValue> times_rb0 = {1, 2, 3};
+  std::vector<types::BoolValue> bools_rb0 = {true, false, true};
+  std::vector<types::StringValue> strings_rb0 = {"short", "longer string than first row", "s"};
+  std::unique_ptr<RecordOrRowBatch> rb0;
+  ColSizes rb0_col_sizes;
+  std::tie(rb0, rb0_col_sizes) = MakeRecordOrRowBatch(times_rb0, bools_rb0, strings_rb0);
+  size_t rb0_num_rows = times_rb0.size();
+
+  std::vector<types::Time64NSValue> times_rb1 = {9, 10, 20, 25};
+  std::vector<types::BoolValue> bools_rb1 = {true, false, true, false};
+  std::vector<types::StringValue> strings_rb1 = {"one", "very", "long", "strings"};
+  std::unique_ptr<RecordOrRowBatch> rb1;
+  ColSizes rb1_col_sizes;
+  std::tie(rb1, rb1_col_sizes) = MakeRecordOrRowBatch(times_rb1, bools_rb1, strings_rb1);
+  size_t rb1_num_rows = times_rb1.size();
+
+  // Round 1, with the next round's sizes reserved ahead of time right after Finish.
+  ASSERT_OK(compactor_->Reserve(rb0_num_rows, rb0_col_sizes));
+  compactor_->UnsafeAppendBatchSlice(*rb0, 0, rb0_num_rows);
+  ASSERT_OK_AND_ASSIGN(auto round0_columns, compactor_->Finish());
+  ASSERT_OK(compactor_->Reserve(rb1_num_rows, rb1_col_sizes));
+
+  // Round 2 reserves again; the builders already have the capacity, so this must be a no-op
+  // rather than compounding the reservation or corrupting the builders.
+  ASSERT_OK(compactor_->Reserve(rb1_num_rows, rb1_col_sizes));
+  compactor_->UnsafeAppendBatchSlice(*rb1, 0, rb1_num_rows);
+  ASSERT_OK_AND_ASSIGN(auto round1_columns, compactor_->Finish());
+
+  EXPECT_TRUE(round0_columns[0]->Equals(types::ToArrow(times_rb0, arrow::default_memory_pool())));
+  EXPECT_TRUE(round0_columns[1]->Equals(types::ToArrow(bools_rb0, arrow::default_memory_pool())));
+  EXPECT_TRUE(
+      round0_columns[2]->Equals(types::ToArrow(strings_rb0, arrow::default_memory_pool())));
+
+  EXPECT_TRUE(round1_columns[0]->Equals(types::ToArrow(times_rb1, arrow::default_memory_pool())));
+  EXPECT_TRUE(round1_columns[1]->Equals(types::ToArrow(bools_rb1, arrow::default_memory_pool())));
+  EXPECT_TRUE(
+      round1_columns[2]->Equals(types::ToArrow(strings_rb1, arrow::default_memory_pool())));
+}
+
 INSTANTIATE_RECORD_OR_ROW_BATCH_TESTSUITE(ArrowArrayCompactor, ArrowArrayCompactorTest,
                                           /*include_mixed*/ true);
 
@@ -15,6 +15,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -26,9 +27,8 @@ namespace table_store {
 namespace internal {
 
 BatchSizeAccountantNonMutableState BatchSizeAccountant::CreateNonMutableState(
-    const schema::Relation& rel, size_t compacted_size) {
+    const schema::Relation& rel) {
   BatchSizeAccountantNonMutableState state;
-  state.compacted_size = compacted_size;
   state.num_cols = rel.NumColumns();
   state.per_row_fixed_size = 0;
   for (const auto& [col_idx, data_type] : Enumerate(rel.col_types())) {
@@ -53,12 +53,13 @@ BatchSizeAccountantNonMutableState BatchSizeAccountant::CreateNonMutableState(
 
 std::unique_ptr<BatchSizeAccountant> BatchSizeAccountant::Create(const schema::Relation& rel,
                                                                  size_t compacted_size) {
-  return std::unique_ptr<BatchSizeAccountant>(
-      new BatchSizeAccountant(BatchSizeAccountant::CreateNonMutableState(rel, compacted_size)));
+  return std::unique_ptr<BatchSizeAccountant>(new BatchSizeAccountant(
+      BatchSizeAccountant::CreateNonMutableState(rel), compacted_size));
 }
 
-BatchSizeAccountant::BatchSizeAccountant(BatchSizeAccountantNonMutableState state)
-    : non_mutable_state_(state) {}
+BatchSizeAccountant::BatchSizeAccountant(BatchSizeAccountantNonMutableState state,
+                                         size_t compacted_size)
+    : non_mutable_state_(state), compacted_size_(compacted_size) {}
 
 BatchSizeAccountant::BatchStats BatchSizeAccountant::CalcBatchStats(
     const BatchSizeAccountantNonMutableState& non_mutable_state, const RecordOrRowBatch& batch) {
@@ -85,7 +86,7 @@ BatchSizeAccountant::CompactedBatchSpec* BatchSizeAccountant::NewCompactedBatchS
 void BatchSizeAccountant::NewHotBatch(const BatchStats& batch_stats) {
   CompactedBatchSpec* compacted_spec = nullptr;
   if (!compacted_batch_specs_.empty() &&
-      compacted_batch_specs_.back().bytes < non_mutable_state_.compacted_size) {
+      compacted_batch_specs_.back().bytes < compacted_size_) {
     compacted_spec = &compacted_batch_specs_.back();
   } else {
     compacted_spec = NewCompactedBatchSpec();
@@ -109,7 +110,7 @@ void BatchSizeAccountant::NewHotBatch(const BatchStats& batch_stats) {
     compacted_spec->num_rows++;
     compacted_spec->bytes += row_bytes;
     curr_hot_slice.bytes += row_bytes;
-    if (compacted_spec->bytes >= non_mutable_state_.compacted_size) {
+    if (compacted_spec->bytes >= compacted_size_) {
       curr_hot_slice.last_slice_for_batch = (row_idx == batch_stats.num_rows - 1);
       compacted_spec->hot_slices.push_back(std::move(curr_hot_slice));
       curr_hot_slice = CompactedBatchSpec::HotSlice{};
@@ -160,7 +161,7 @@ void BatchSizeAccountant::ExpireColdBatch() {
 
 bool BatchSizeAccountant::CompactedBatchReady() const {
   return !compacted_batch_specs_.empty() &&
-         (compacted_batch_specs_.front().bytes >= non_mutable_state_.compacted_size);
+         (compacted_batch_specs_.front().bytes >= compacted_size_);
 }
 
 const BatchSizeAccountant::CompactedBatchSpec& BatchSizeAccountant::GetNextCompactedBatchSpec()
@@ -212,6 +213,15 @@ uint64_t BatchSizeAccountant::FinishCompactedBatch() {
   return rows_to_remove;
 }
 
+void BatchSizeAccountant::UpdateCompactedSize(uint64_t desired_size) {
+  // Move halfway towards the desired size each update, so the target follows sustained changes
+  // in consumer throughput but doesn't thrash on bursty measurements.
+  uint64_t new_size = (compacted_size_ + desired_size) / 2;
+  compacted_size_ = std::clamp(new_size, kMinCompactedBatchSize, kMaxCompactedBatchSize);
+}
+
+uint64_t BatchSizeAccountant::CompactedSize() const { return compacted_size_; }
+
 uint64_t BatchSizeAccountant::HotBytes() const { return hot_bytes_; }
 
 uint64_t BatchSizeAccountant::ColdBytes() const { return cold_bytes_; }
@@ -45,7 +45,6 @@ namespace internal {
  * ABSL_GUARDED_BY, etc.
  */
 struct BatchSizeAccountantNonMutableState {
-  uint64_t compacted_size;
   uint32_t num_cols;
   uint64_t per_row_fixed_size;
   std::vector<int64_t> variable_cols_indices;
@@ -134,6 +133,19 @@ class BatchSizeAccountant {
    * into the cold store via CompactedBatchSpec.
    */
   uint64_t FinishCompactedBatch();
+  /**
+   * UpdateCompactedSize adjusts the target compacted batch size towards `desired_size`, which
+   * callers derive from the table's observed consumer throughput. The target moves as an
+   * exponentially weighted average so that a single noisy measurement doesn't swing batch
+   * sizes, and is clamped to [kMinCompactedBatchSize, kMaxCompactedBatchSize]. The new target
+   * applies to batches that have not yet been sealed; already sealed compacted batch specs keep
+   * their boundaries.
+   */
+  void UpdateCompactedSize(uint64_t desired_size);
+  /**
+   * @return the current target compacted batch size in bytes.
+   */
+  uint64_t CompactedSize() const;
   /**
    * @return the number of bytes stored in the hot store.
    */
@@ -145,17 +157,26 @@ class BatchSizeAccountant {
 
   const BatchSizeAccountantNonMutableState& NonMutableState() const;
 
+  // Bounds for the adaptive compacted batch size target. The initial size passed to Create is
+  // taken as-is, so tables configured outside this range stay there until the first update.
+  static constexpr uint64_t kMinCompactedBatchSize = 16 * 1024;
+  static constexpr uint64_t kMaxCompactedBatchSize = 4 * 1024 * 1024;
+
  private:
   const BatchSizeAccountantNonMutableState non_mutable_state_;
 
+  // Target size of a compacted batch in bytes. Mutable (unlike the fields in
+  // non_mutable_state_) and synchronized by the same external lock as the rest of the
+  // accountant's mutable state.
+  uint64_t compacted_size_;
+
   std::deque<CompactedBatchSpec> compacted_batch_specs_;
   std::deque<uint64_t> cold_batch_bytes_;
   uint64_t hot_bytes_ = 0;
   uint64_t cold_bytes_ = 0;
 
-  static BatchSizeAccountantNonMutableState CreateNonMutableState(const schema::Relation& rel,
-                                                                  size_t compacted_size);
-  explicit BatchSizeAccountant(BatchSizeAccountantNonMutableState state);
+  static BatchSizeAccountantNonMutableState CreateNonMutableState(const schema::Relation& rel);
+  BatchSizeAccountant(BatchSizeAccountantNonMutableState state, size_t compacted_size);
   CompactedBatchSpec* NewCompactedBatchSpec();
 };
 
@@ -201,6 +201,49 @@ TEST_P(BatchSizeAccountantTest, IndexThenCompactWithExpiry) {
   EXPECT_EQ(2 * half_compaction_rb_bytes_, accountant_->ColdBytes());
 }
 
+TEST_P(BatchSizeAccountantTest, UpdateCompactedSize) {
+  EXPECT_EQ(compacted_size_, accountant_->CompactedSize());
+
+  // The target moves halfway towards the desired size each update, clamped to the allowed range.
+  accountant_->UpdateCompactedSize(BatchSizeAccountant::kMaxCompactedBatchSize);
+  EXPECT_EQ((compacted_size_ + BatchSizeAccountant::kMaxCompactedBatchSize) / 2,
+            accountant_->CompactedSize());
+
+  // Repeated low-throughput updates converge to the minimum, never below it.
+  for (int i = 0; i < 64; ++i) {
+    accountant_->UpdateCompactedSize(0);
+  }
+  EXPECT_EQ(BatchSizeAccountant::kMinCompactedBatchSize, accountant_->CompactedSize());
+
+  // Repeated high-throughput updates converge to the maximum, never above it.
+  for (int i = 0; i < 64; ++i) {
+    accountant_->UpdateCompactedSize(100 * BatchSizeAccountant::kMaxCompactedBatchSize);
+  }
+  EXPECT_EQ(BatchSizeAccountant::kMaxCompactedBatchSize, accountant_->CompactedSize());
+}
+
+TEST_P(BatchSizeAccountantTest, ShrinkingCompactedSizeSealsPendingSpec) {
+  auto accountant =
+      BatchSizeAccountant::Create(*rel_, BatchSizeAccountant::kMaxCompactedBatchSize);
+
+  // A batch larger than the minimum target but far below the initial one is not ready.
+  std::vector<types::Time64NSValue> times = {1};
+  std::vector<types::BoolValue> bools = {true};
+  std::vector<types::StringValue> strings = {
+      std::string(2 * BatchSizeAccountant::kMinCompactedBatchSize, 'x')};
+  auto [rb, col_sizes] = MakeRecordOrRowBatch(times, bools, strings);
+  accountant->NewHotBatch(BatchSizeAccountant::CalcBatchStats(accountant->NonMutableState(), *rb));
+  EXPECT_FALSE(accountant->CompactedBatchReady());
+
+  // Shrinking the target below the pending spec's size makes it ready without new writes, so
+  // trickle tables don't hold rows in the hot tier indefinitely.
+  for (int i = 0; i < 64; ++i) {
+    accountant->UpdateCompactedSize(0);
+  }
+  EXPECT_EQ(BatchSizeAccountant::kMinCompactedBatchSize, accountant->CompactedSize());
+  EXPECT_TRUE(accountant->CompactedBatchReady());
+}
+
 INSTANTIATE_RECORD_OR_ROW_BATCH_TESTSUITE(BatchSizeAccountant, BatchSizeAccountantTest,
                                           /*include_mixed*/ true);
 
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <absl/hash/hash.h>
+
+#include "src/table_store/table/internal/scan_predicate.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * ColumnBloomFilter is a bloom filter over the values of a single string column within a
+ * single batch. It is used to prune batches on equality predicates: if `MayContain` returns
+ * false, the batch is guaranteed not to contain the value. False positives are possible, so
+ * a true result only means the batch must be scanned.
+ */
+class ColumnBloomFilter {
+ public:
+  /**
+   * Create builds an empty bloom filter sized for the given number of values, using
+   * `kBitsPerValue` bits per value rounded up to a power of two.
+   * @param expected_count, the number of values that will be added to the filter.
+   * @return the empty bloom filter.
+   */
+  static ColumnBloomFilter Create(size_t expected_count) {
+    size_t num_bits = kMinBits;
+    while (num_bits < expected_count * kBitsPerValue) {
+      num_bits <<= 1;
+    }
+    return ColumnBloomFilter(num_bits);
+  }
+
+  void Add(std::string_view val) {
+    auto [h1, h2] = Hashes(val);
+    for (size_t i = 0; i < kNumHashes; ++i) {
+      SetBit((h1 + i * h2) & bit_mask_);
+    }
+  }
+
+  bool MayContain(std::string_view val) const {
+    auto [h1, h2] = Hashes(val);
+    for (size_t i = 0; i < kNumHashes; ++i) {
+      if (!GetBit((h1 + i * h2) & bit_mask_)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr size_t kMinBits = 64;
+  static constexpr size_t kBitsPerValue = 10;
+  static constexpr size_t kNumHashes = 4;
+
+  explicit ColumnBloomFilter(size_t num_bits)
+      : bit_mask_(num_bits - 1), words_(num_bits / 64, 0) {}
+
+  // Double hashing: the i-th probe is `h1 + i * h2`. h2 is forced odd so that, with a
+  // power-of-two number of bits, successive probes don't collapse onto each other.
+  static std::pair<uint64_t, uint64_t> Hashes(std::string_view val) {
+    uint64_t h1 = absl::Hash<std::string_view>{}(val);
+    uint64_t h2 = ((h1 >> 32) * 0x9E3779B97F4A7C15ULL) | 1;
+    return {h1, h2};
+  }
+
+  void SetBit(uint64_t bit_idx) { words_[bit_idx >> 6] |= (1ULL << (bit_idx & 63)); }
+  bool GetBit(uint64_t bit_idx) const {
+    return (words_[bit_idx >> 6] & (1ULL << (bit_idx & 63))) != 0;
+  }
+
+  uint64_t bit_mask_;
+  std::vector<uint64_t> words_;
+};
+
+/**
+ * BatchStats holds the pruning statistics for a single batch: per-column zone maps (min/max)
+ * and optional bloom filters for string columns. For cold batches, which are immutable, both
+ * are computed eagerly when the batch enters the store, so pruning never has to touch the
+ * batch's arrow arrays. For hot batches, zone maps are computed lazily on the first predicate
+ * that references a column, and bloom filters are not built.
+ */
+struct BatchStats {
+  std::map<int64_t, std::optional<ColumnMinMax>> min_max;
+  std::map<int64_t, ColumnBloomFilter> bloom_filters;
+};
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
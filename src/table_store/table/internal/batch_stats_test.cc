@@ -0,0 +1,57 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/table_store/table/internal/batch_stats.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+TEST(ColumnBloomFilterTest, added_values_are_contained) {
+  std::vector<std::string> values = {"pl/vizier-metadata", "pl/vizier-pem", "px-sock-shop/carts",
+                                     "px-sock-shop/orders", ""};
+  auto bloom = ColumnBloomFilter::Create(values.size());
+  for (const auto& val : values) {
+    bloom.Add(val);
+  }
+  for (const auto& val : values) {
+    EXPECT_TRUE(bloom.MayContain(val));
+  }
+}
+
+TEST(ColumnBloomFilterTest, absent_values_are_mostly_excluded) {
+  // Oversize the filter relative to the number of added values so that the false positive
+  // probability is negligible and the test is not flaky.
+  auto bloom = ColumnBloomFilter::Create(1024);
+  bloom.Add("pl/vizier-metadata");
+  bloom.Add("pl/vizier-pem");
+
+  EXPECT_TRUE(bloom.MayContain("pl/vizier-metadata"));
+  EXPECT_TRUE(bloom.MayContain("pl/vizier-pem"));
+  EXPECT_FALSE(bloom.MayContain("px-sock-shop/carts"));
+  EXPECT_FALSE(bloom.MayContain("pl/vizier-query-broker"));
+  EXPECT_FALSE(bloom.MayContain(""));
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
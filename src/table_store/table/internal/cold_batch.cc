@@ -0,0 +1,346 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <arrow/builder.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/strings/substitute.h>
+
+#include "src/common/base/utils.h"
+#include "src/common/fs/fs_wrapper.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/cold_batch.h"
+
+DEFINE_string(table_store_cold_spill_dir,
+              gflags::StringFromEnv("PL_TABLE_STORE_COLD_SPILL_DIR", ""),
+              "If set, cold table store batches are written to memory-mapped files in this "
+              "directory and read back on demand, trading RAM for disk-backed retention. "
+              "Empty disables spilling.");
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+namespace {
+
+struct DictEncodeResult {
+  std::shared_ptr<arrow::StringArray> dict;
+  std::shared_ptr<arrow::Int32Array> codes;
+};
+
+// Dictionary encodes the given string array, or returns std::nullopt if the encoded
+// representation would not be smaller than the plain array.
+std::optional<DictEncodeResult> TryDictEncode(const arrow::StringArray& arr,
+                                              arrow::MemoryPool* mem_pool) {
+  absl::flat_hash_map<std::string_view, int32_t> val_to_code;
+  std::vector<int32_t> codes;
+  codes.reserve(arr.length());
+  size_t dict_chars = 0;
+  for (int64_t i = 0; i < arr.length(); ++i) {
+    auto view = types::GetStringViewFromArrowArray(&arr, i);
+    auto [it, inserted] = val_to_code.emplace(view, static_cast<int32_t>(val_to_code.size()));
+    if (inserted) {
+      dict_chars += view.size();
+    }
+    codes.push_back(it->second);
+  }
+
+  size_t num_distinct = val_to_code.size();
+  size_t plain_bytes =
+      arr.value_offset(arr.length()) + (arr.length() + 1) * sizeof(int32_t);
+  size_t encoded_bytes = dict_chars + (num_distinct + 1) * sizeof(int32_t) +
+                         codes.size() * sizeof(int32_t);
+  if (encoded_bytes >= plain_bytes) {
+    return std::nullopt;
+  }
+
+  // Build the dictionary in code order, so that `codes[i]` indexes the value of row i.
+  std::vector<std::string_view> dict_values(num_distinct);
+  for (const auto& [view, code] : val_to_code) {
+    dict_values[code] = view;
+  }
+
+  arrow::StringBuilder dict_builder(mem_pool);
+  if (!dict_builder.Reserve(num_distinct).ok() || !dict_builder.ReserveData(dict_chars).ok()) {
+    return std::nullopt;
+  }
+  for (const auto& view : dict_values) {
+    dict_builder.UnsafeAppend(view.data(), view.size());
+  }
+  std::shared_ptr<arrow::Array> dict_arr;
+  if (!dict_builder.Finish(&dict_arr).ok()) {
+    return std::nullopt;
+  }
+
+  arrow::Int32Builder codes_builder(mem_pool);
+  if (!codes_builder.Reserve(codes.size()).ok()) {
+    return std::nullopt;
+  }
+  for (auto code : codes) {
+    codes_builder.UnsafeAppend(code);
+  }
+  std::shared_ptr<arrow::Array> codes_arr;
+  if (!codes_builder.Finish(&codes_arr).ok()) {
+    return std::nullopt;
+  }
+
+  return DictEncodeResult{std::static_pointer_cast<arrow::StringArray>(dict_arr),
+                          std::static_pointer_cast<arrow::Int32Array>(codes_arr)};
+}
+
+constexpr int64_t kSpillAlignment = 8;
+
+// An arrow::Buffer view into a shared memory mapping. The mapping is unmapped when the last
+// buffer referencing it is destroyed.
+class MmapBuffer : public arrow::Buffer {
+ public:
+  MmapBuffer(std::shared_ptr<void> mapping, const uint8_t* data, int64_t size)
+      : arrow::Buffer(data, size), mapping_(std::move(mapping)) {}
+
+ private:
+  std::shared_ptr<void> mapping_;
+};
+
+struct BufferSpan {
+  // Offset of the buffer within the spill file, or -1 for an absent buffer (eg. an array
+  // without a null bitmap).
+  int64_t offset = -1;
+  int64_t size = 0;
+};
+
+Status WriteSpanToFd(int fd, const uint8_t* data, int64_t size) {
+  int64_t written = 0;
+  while (written < size) {
+    auto n = ::write(fd, data + written, size - written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return error::Internal("Failed to write to cold spill file: $0", std::strerror(errno));
+    }
+    written += n;
+  }
+  return Status::OK();
+}
+
+// Writes each of the array's buffers to the file at an 8-byte aligned offset, and records
+// where each buffer landed in `spans`.
+Status WriteArrayBuffers(int fd, const arrow::ArrayData& data, int64_t* file_offset,
+                         std::vector<BufferSpan>* spans) {
+  static constexpr char kZeros[kSpillAlignment] = {};
+  for (const auto& buf : data.buffers) {
+    auto& span = spans->emplace_back();
+    if (buf == nullptr) {
+      continue;
+    }
+    int64_t padding = (kSpillAlignment - (*file_offset % kSpillAlignment)) % kSpillAlignment;
+    if (padding > 0) {
+      PL_RETURN_IF_ERROR(WriteSpanToFd(fd, reinterpret_cast<const uint8_t*>(kZeros), padding));
+      *file_offset += padding;
+    }
+    span.offset = *file_offset;
+    span.size = buf->size();
+    PL_RETURN_IF_ERROR(WriteSpanToFd(fd, buf->data(), buf->size()));
+    *file_offset += buf->size();
+  }
+  return Status::OK();
+}
+
+// Rebuilds an array identical to `data` but with every buffer backed by the memory mapping.
+ArrowArrayPtr RemapArray(const arrow::ArrayData& data, const std::shared_ptr<void>& mapping,
+                         const std::vector<BufferSpan>& spans) {
+  const auto* base = static_cast<const uint8_t*>(mapping.get());
+  std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+  buffers.reserve(spans.size());
+  for (const auto& span : spans) {
+    if (span.offset < 0) {
+      buffers.push_back(nullptr);
+      continue;
+    }
+    buffers.push_back(std::make_shared<MmapBuffer>(mapping, base + span.offset, span.size));
+  }
+  return arrow::MakeArray(
+      arrow::ArrayData::Make(data.type, data.length, std::move(buffers), data.null_count));
+}
+
+}  // namespace
+
+size_t ColdBatch::num_rows() const {
+  DCHECK(!cols_.empty());
+  return std::visit(
+      overloaded{
+          [](const ArrowArrayPtr& plain) { return static_cast<size_t>(plain->length()); },
+          [](const DictEncodedColumn& encoded) {
+            return static_cast<size_t>(encoded.codes->length());
+          },
+      },
+      cols_[0]);
+}
+
+void ColdBatch::DictionaryEncodeStringColumns(const schema::Relation& rel,
+                                              arrow::MemoryPool* mem_pool,
+                                              StringInternPool* intern_pool) {
+  for (size_t col_idx = 0; col_idx < cols_.size(); ++col_idx) {
+    if (rel.col_types()[col_idx] != types::DataType::STRING ||
+        IsDictionaryEncoded(col_idx)) {
+      continue;
+    }
+    const auto& plain = std::get<ArrowArrayPtr>(cols_[col_idx]);
+    if (plain->length() == 0) {
+      continue;
+    }
+    auto encoded =
+        TryDictEncode(static_cast<const arrow::StringArray&>(*plain), mem_pool);
+    if (encoded.has_value()) {
+      if (intern_pool != nullptr) {
+        encoded->dict = intern_pool->Intern(std::move(encoded->dict));
+      }
+      cols_[col_idx] = DictEncodedColumn{std::move(encoded->dict), std::move(encoded->codes)};
+    }
+  }
+}
+
+StatusOr<ArrowArrayPtr> ColdBatch::ColumnSlice(size_t col_idx, int64_t offset, int64_t length,
+                                               arrow::MemoryPool* mem_pool) const {
+  return std::visit(
+      overloaded{
+          [offset, length](const ArrowArrayPtr& plain) -> StatusOr<ArrowArrayPtr> {
+            return plain->Slice(offset, length);
+          },
+          [offset, length, mem_pool](const DictEncodedColumn& encoded) -> StatusOr<ArrowArrayPtr> {
+            arrow::StringBuilder builder(mem_pool);
+            PL_RETURN_IF_ERROR(builder.Reserve(length));
+            size_t slice_chars = 0;
+            for (int64_t i = offset; i < offset + length; ++i) {
+              slice_chars += encoded.dict->value_length(encoded.codes->Value(i));
+            }
+            PL_RETURN_IF_ERROR(builder.ReserveData(slice_chars));
+            for (int64_t i = offset; i < offset + length; ++i) {
+              auto view = types::GetStringViewFromArrowArray(encoded.dict.get(),
+                                                             encoded.codes->Value(i));
+              builder.UnsafeAppend(view.data(), view.size());
+            }
+            ArrowArrayPtr out;
+            PL_RETURN_IF_ERROR(builder.Finish(&out));
+            return out;
+          },
+      },
+      cols_[col_idx]);
+}
+
+Status ColdBatch::SpillToDisk(const std::string& dir) {
+  if (spilled_ || cols_.empty()) {
+    return Status::OK();
+  }
+
+  // Collect every arrow array backing the batch, in column order. Dictionary encoded columns
+  // contribute their dictionary followed by their codes.
+  std::vector<const arrow::Array*> arrays;
+  for (const auto& col : cols_) {
+    std::visit(overloaded{
+                   [&arrays](const ArrowArrayPtr& plain) { arrays.push_back(plain.get()); },
+                   [&arrays](const DictEncodedColumn& encoded) {
+                     arrays.push_back(encoded.dict.get());
+                     arrays.push_back(encoded.codes.get());
+                   },
+               },
+               col);
+  }
+  // Sliced arrays share buffers with their parent; spilling them would double-count bytes and
+  // complicate offset handling. Compacted batches are built from freshly finished builders, so
+  // in practice this never triggers.
+  for (const auto* arr : arrays) {
+    if (arr->offset() != 0) {
+      return Status::OK();
+    }
+  }
+
+  PL_RETURN_IF_ERROR(fs::CreateDirectories(std::filesystem::path(dir)));
+  static std::atomic<int64_t> spill_counter(0);
+  auto path = absl::Substitute("$0/cold_batch_$1_$2.spill", dir, getpid(),
+                               spill_counter.fetch_add(1));
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    return error::Internal("Failed to create cold spill file $0: $1", path,
+                           std::strerror(errno));
+  }
+
+  int64_t file_offset = 0;
+  std::vector<std::vector<BufferSpan>> spans(arrays.size());
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    auto s = WriteArrayBuffers(fd, *arrays[i]->data(), &file_offset, &spans[i]);
+    if (!s.ok()) {
+      ::close(fd);
+      ::unlink(path.c_str());
+      return s;
+    }
+  }
+  if (file_offset == 0) {
+    ::close(fd);
+    ::unlink(path.c_str());
+    return Status::OK();
+  }
+
+  void* addr = ::mmap(nullptr, file_offset, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  // Unlink up front: the kernel keeps the file alive while it is mapped, and reclaims the disk
+  // space as soon as the last MmapBuffer (and with it the mapping) is destroyed on batch expiry.
+  ::unlink(path.c_str());
+  if (addr == MAP_FAILED) {
+    return error::Internal("Failed to mmap cold spill file $0: $1", path, std::strerror(errno));
+  }
+  auto mapping = std::shared_ptr<void>(
+      addr, [len = file_offset](void* a) { ::munmap(a, len); });
+
+  size_t arr_idx = 0;
+  for (auto& col : cols_) {
+    std::visit(overloaded{
+                   [&](ArrowArrayPtr& plain) {
+                     plain = RemapArray(*plain->data(), mapping, spans[arr_idx++]);
+                   },
+                   [&](DictEncodedColumn& encoded) {
+                     encoded.dict = std::static_pointer_cast<arrow::StringArray>(
+                         RemapArray(*encoded.dict->data(), mapping, spans[arr_idx++]));
+                     encoded.codes = std::static_pointer_cast<arrow::Int32Array>(
+                         RemapArray(*encoded.codes->data(), mapping, spans[arr_idx++]));
+                   },
+               },
+               col);
+  }
+  spilled_ = true;
+  return Status::OK();
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/table_store/table/internal/string_intern_pool.h"
+#include "src/table_store/schema/relation.h"
+
+DECLARE_string(table_store_cold_spill_dir);
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+using ArrowArrayPtr = std::shared_ptr<arrow::Array>;
+
+/**
+ * ColdBatch holds the per-column arrow arrays of a single compacted (cold) batch. String
+ * columns whose values repeat are stored dictionary encoded: a dictionary of distinct values
+ * plus an int32 code per row. Encoded columns are decoded lazily, and only for the slice a
+ * scan actually materializes, so repeated pod/service/path strings are stored once for the
+ * lifetime of the batch.
+ */
+class ColdBatch {
+ public:
+  ColdBatch() = default;
+  explicit ColdBatch(std::vector<ArrowArrayPtr> cols) : cols_(cols.begin(), cols.end()) {}
+
+  size_t num_columns() const { return cols_.size(); }
+  size_t num_rows() const;
+
+  /**
+   * DictionaryEncodeStringColumns dictionary encodes the batch's string columns in place. A
+   * column is only encoded when the encoded representation (dictionary plus codes) is smaller
+   * than the plain arrow array, so low-repetition columns stay as plain string arrays.
+   * @param rel, the table's relation, used to find the string columns.
+   * @param mem_pool, the arrow memory pool to allocate the encoded arrays from.
+   * @param intern_pool, optional pool used to share byte-identical dictionaries across batches
+   * and tables. Passing `nullptr` disables interning.
+   */
+  void DictionaryEncodeStringColumns(const schema::Relation& rel, arrow::MemoryPool* mem_pool,
+                                     StringInternPool* intern_pool = nullptr);
+
+  bool IsDictionaryEncoded(size_t col_idx) const {
+    return std::holds_alternative<DictEncodedColumn>(cols_[col_idx]);
+  }
+
+  /**
+   * PlainColumn returns the arrow array for a column that is not dictionary encoded. It is
+   * unsafe to call on an encoded column.
+   */
+  const ArrowArrayPtr& PlainColumn(size_t col_idx) const {
+    DCHECK(!IsDictionaryEncoded(col_idx));
+    return std::get<ArrowArrayPtr>(cols_[col_idx]);
+  }
+
+  /**
+   * Dictionary returns the distinct values of a dictionary encoded column. It is unsafe to
+   * call on a plain column.
+   */
+  const std::shared_ptr<arrow::StringArray>& Dictionary(size_t col_idx) const {
+    DCHECK(IsDictionaryEncoded(col_idx));
+    return std::get<DictEncodedColumn>(cols_[col_idx]).dict;
+  }
+
+  /**
+   * ColumnSlice returns the rows [offset, offset + length) of the given column as a plain
+   * arrow array. Plain columns are sliced without copying; dictionary encoded columns are
+   * decoded, but only for the requested slice.
+   */
+  StatusOr<ArrowArrayPtr> ColumnSlice(size_t col_idx, int64_t offset, int64_t length,
+                                      arrow::MemoryPool* mem_pool) const;
+
+  /**
+   * SpillToDisk writes the batch's column buffers to a file in `dir` and remaps every column
+   * as a zero-copy arrow array over a read-only memory mapping of that file, releasing the
+   * heap-allocated buffers. The file is unlinked immediately after mapping, so its disk space
+   * is reclaimed automatically when the batch is expired and the mapping is dropped. Reads
+   * through the mapping fault pages back in on demand, so cursors see the same arrays as
+   * before; the kernel is free to evict clean pages under memory pressure.
+   */
+  Status SpillToDisk(const std::string& dir);
+
+  bool spilled() const { return spilled_; }
+
+ private:
+  struct DictEncodedColumn {
+    std::shared_ptr<arrow::StringArray> dict;
+    std::shared_ptr<arrow::Int32Array> codes;
+  };
+
+  std::vector<std::variant<ArrowArrayPtr, DictEncodedColumn>> cols_;
+  bool spilled_ = false;
+};
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/cold_batch.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+TEST(ColdBatchTest, dictionary_encodes_repetitive_string_columns) {
+  schema::Relation rel({types::DataType::INT64, types::DataType::STRING}, {"col1", "col2"});
+
+  std::vector<types::Int64Value> ints = {1, 2, 3, 4, 5, 6};
+  std::vector<types::StringValue> strings = {"pl/vizier-pem", "pl/vizier-pem", "pl/kelvin",
+                                             "pl/vizier-pem", "pl/kelvin", "pl/vizier-pem"};
+  auto int_arr = types::ToArrow(ints, arrow::default_memory_pool());
+  auto str_arr = types::ToArrow(strings, arrow::default_memory_pool());
+
+  ColdBatch batch(std::vector<ArrowArrayPtr>{int_arr, str_arr});
+  batch.DictionaryEncodeStringColumns(rel, arrow::default_memory_pool());
+
+  EXPECT_FALSE(batch.IsDictionaryEncoded(0));
+  ASSERT_TRUE(batch.IsDictionaryEncoded(1));
+  EXPECT_EQ(6, batch.num_rows());
+  EXPECT_EQ(2, batch.Dictionary(1)->length());
+
+  // Full slice decodes back to the original values.
+  auto full = batch.ColumnSlice(1, 0, 6, arrow::default_memory_pool()).ConsumeValueOrDie();
+  EXPECT_TRUE(full->Equals(str_arr));
+
+  // Partial slices decode only the requested rows.
+  auto slice = batch.ColumnSlice(1, 2, 3, arrow::default_memory_pool()).ConsumeValueOrDie();
+  EXPECT_TRUE(slice->Equals(types::ToArrow(
+      std::vector<types::StringValue>{"pl/kelvin", "pl/vizier-pem", "pl/kelvin"},
+      arrow::default_memory_pool())));
+
+  // Plain columns slice without copying.
+  auto int_slice = batch.ColumnSlice(0, 1, 2, arrow::default_memory_pool()).ConsumeValueOrDie();
+  EXPECT_TRUE(int_slice->Equals(int_arr->Slice(1, 2)));
+}
+
+TEST(ColdBatchTest, low_repetition_string_columns_stay_plain) {
+  schema::Relation rel({types::DataType::STRING}, {"col1"});
+
+  std::vector<types::StringValue> strings = {"aa", "bb", "cc", "dd"};
+  auto str_arr = types::ToArrow(strings, arrow::default_memory_pool());
+
+  ColdBatch batch(std::vector<ArrowArrayPtr>{str_arr});
+  batch.DictionaryEncodeStringColumns(rel, arrow::default_memory_pool());
+
+  // All values are distinct, so the encoded form would be larger than the plain array.
+  EXPECT_FALSE(batch.IsDictionaryEncoded(0));
+  EXPECT_EQ(str_arr, batch.PlainColumn(0));
+}
+
+TEST(ColdBatchTest, spill_to_disk_round_trips_columns) {
+  schema::Relation rel({types::DataType::INT64, types::DataType::STRING}, {"col1", "col2"});
+
+  std::vector<types::Int64Value> ints = {10, 20, 30, 40, 50, 60};
+  std::vector<types::StringValue> strings = {"pl/vizier-pem", "pl/vizier-pem", "pl/kelvin",
+                                             "pl/vizier-pem", "pl/kelvin", "pl/vizier-pem"};
+  auto int_arr = types::ToArrow(ints, arrow::default_memory_pool());
+  auto str_arr = types::ToArrow(strings, arrow::default_memory_pool());
+
+  ColdBatch batch(std::vector<ArrowArrayPtr>{int_arr, str_arr});
+  batch.DictionaryEncodeStringColumns(rel, arrow::default_memory_pool());
+  ASSERT_TRUE(batch.IsDictionaryEncoded(1));
+
+  auto spill_dir = std::filesystem::path(::testing::TempDir()) / "cold_batch_spill_test";
+  ASSERT_OK(batch.SpillToDisk(spill_dir.string()));
+  EXPECT_TRUE(batch.spilled());
+  // The spill file is unlinked once mapped, so the directory holds no files.
+  EXPECT_TRUE(std::filesystem::is_empty(spill_dir));
+
+  // Columns read back identically through the mapping.
+  auto plain = batch.ColumnSlice(0, 0, 6, arrow::default_memory_pool()).ConsumeValueOrDie();
+  EXPECT_TRUE(plain->Equals(int_arr));
+  auto full = batch.ColumnSlice(1, 0, 6, arrow::default_memory_pool()).ConsumeValueOrDie();
+  EXPECT_TRUE(full->Equals(str_arr));
+  auto slice = batch.ColumnSlice(1, 2, 3, arrow::default_memory_pool()).ConsumeValueOrDie();
+  EXPECT_TRUE(slice->Equals(types::ToArrow(
+      std::vector<types::StringValue>{"pl/kelvin", "pl/vizier-pem", "pl/kelvin"},
+      arrow::default_memory_pool())));
+
+  // Spilling twice is a no-op.
+  ASSERT_OK(batch.SpillToDisk(spill_dir.string()));
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
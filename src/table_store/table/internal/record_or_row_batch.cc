@@ -16,6 +16,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "src/common/base/utils.h"
@@ -25,6 +28,50 @@ namespace px {
 namespace table_store {
 namespace internal {
 
+namespace {
+
+template <types::DataType TDataType>
+ColumnMinMax ColumnWrapperMinMax(types::ColumnWrapper* col, int64_t row_offset) {
+  auto iterable = types::ColumnWrapperIterator<TDataType>(col);
+  auto it = iterable.begin() + row_offset;
+  auto min = *it;
+  auto max = min;
+  for (++it; it != iterable.end(); ++it) {
+    auto val = *it;
+    if (val < min) {
+      min = val;
+    }
+    if (max < val) {
+      max = val;
+    }
+  }
+  if constexpr (TDataType == types::DataType::STRING) {
+    return std::make_pair(std::string(std::move(min)), std::string(std::move(max)));
+  } else {
+    return std::make_pair(std::move(min), std::move(max));
+  }
+}
+
+std::optional<ColumnMinMax> ColumnWrapperMinMax(types::ColumnWrapper* col, int64_t row_offset,
+                                                types::DataType col_data_type) {
+  switch (col_data_type) {
+    case types::DataType::BOOLEAN:
+      return ColumnWrapperMinMax<types::DataType::BOOLEAN>(col, row_offset);
+    case types::DataType::INT64:
+      return ColumnWrapperMinMax<types::DataType::INT64>(col, row_offset);
+    case types::DataType::TIME64NS:
+      return ColumnWrapperMinMax<types::DataType::TIME64NS>(col, row_offset);
+    case types::DataType::FLOAT64:
+      return ColumnWrapperMinMax<types::DataType::FLOAT64>(col, row_offset);
+    case types::DataType::STRING:
+      return ColumnWrapperMinMax<types::DataType::STRING>(col, row_offset);
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
 size_t RecordOrRowBatch::Length() const {
   return std::visit(overloaded{
                         [this](const RecordBatchWithCache& record_batch_w_cache) {
@@ -107,18 +154,19 @@ void RecordOrRowBatch::RemovePrefix(size_t num_rows) { row_offset_ += num_rows;
 
 Status RecordOrRowBatch::AddBatchSliceToRowBatch(size_t row_start, size_t batch_size,
                                                  const std::vector<int64_t>& cols,
-                                                 schema::RowBatch* output_rb) const {
+                                                 schema::RowBatch* output_rb,
+                                                 arrow::MemoryPool* mem_pool) const {
   row_start += row_offset_;
   return std::visit(
       overloaded{
-          [row_start, batch_size, cols,
-           output_rb](const RecordBatchWithCache& record_batch_w_cache) {
+          [row_start, batch_size, cols, output_rb,
+           mem_pool](const RecordBatchWithCache& record_batch_w_cache) {
             for (auto col_idx : cols) {
               if (!record_batch_w_cache.cache_validity[col_idx]) {
                 // Arrow array wasn't in cache, convert it to arrow and then add
                 // to cache.
-                auto arr = (*record_batch_w_cache.record_batch)[col_idx]->ConvertToArrow(
-                    arrow::default_memory_pool());
+                auto arr =
+                    (*record_batch_w_cache.record_batch)[col_idx]->ConvertToArrow(mem_pool);
                 record_batch_w_cache.arrow_cache[col_idx] = arr;
                 record_batch_w_cache.cache_validity[col_idx] = true;
               }
@@ -192,6 +240,26 @@ std::vector<uint64_t> RecordOrRowBatch::GetVariableSizedColumnRowBytes(size_t co
   return rows_bytes;
 }
 
+std::optional<ColumnMinMax> RecordOrRowBatch::GetColumnMinMax(int64_t col_idx,
+                                                              types::DataType col_data_type) const {
+  if (Length() == 0) {
+    return std::nullopt;
+  }
+  return std::visit(
+      overloaded{
+          [this, col_idx, col_data_type](const RecordBatchWithCache& record_batch_w_cache) {
+            auto col = (*record_batch_w_cache.record_batch)[col_idx];
+            return ColumnWrapperMinMax(col.get(), row_offset_, col_data_type);
+          },
+          [this, col_idx, col_data_type](const schema::RowBatch& row_batch) {
+            auto length = row_batch.num_rows() - row_offset_;
+            auto arr = row_batch.ColumnAt(col_idx)->Slice(row_offset_, length);
+            return ComputeColumnMinMax(arr.get(), col_data_type);
+          },
+      },
+      batch_);
+}
+
 }  // namespace internal
 }  // namespace table_store
 }  // namespace px
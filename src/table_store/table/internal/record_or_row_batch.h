@@ -18,11 +18,15 @@
 
 #pragma once
 
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include <arrow/memory_pool.h>
+
 #include "src/table_store/schema/row_batch.h"
+#include "src/table_store/table/internal/scan_predicate.h"
 #include "src/table_store/table/internal/types.h"
 
 namespace px {
@@ -94,11 +98,12 @@ class RecordOrRowBatch {
    * @param batch_size, size of the output slice.
    * @param cols, a vector of column indices to include in the output slice.
    * @param output_rb, a pointer to the row batch to add the columns to.
+   * @param mem_pool, the arrow memory pool to allocate column cache conversions from.
    * @return Status, errors if adding columns to the row batch fails.
    */
   Status AddBatchSliceToRowBatch(size_t row_start, size_t batch_size,
-                                 const std::vector<int64_t>& cols,
-                                 schema::RowBatch* output_rb) const;
+                                 const std::vector<int64_t>& cols, schema::RowBatch* output_rb,
+                                 arrow::MemoryPool* mem_pool = arrow::default_memory_pool()) const;
 
   /**
    * UnsafeAppendColumnToBuilder appends a slice of a column of this record or row batch to the
@@ -125,6 +130,17 @@ class RecordOrRowBatch {
    */
   std::vector<uint64_t> GetVariableSizedColumnRowBytes(size_t col_idx) const;
 
+  /**
+   * GetColumnMinMax computes min/max statistics for the given column over the rows currently
+   * in the batch (i.e. excluding any removed prefix). Returns std::nullopt for column types
+   * without statistics support.
+   * @param col_idx, index of the column to compute statistics for.
+   * @param col_data_type, the DataType of the column.
+   * @return min/max statistics for the column, or std::nullopt.
+   */
+  std::optional<ColumnMinMax> GetColumnMinMax(int64_t col_idx,
+                                              types::DataType col_data_type) const;
+
  private:
   std::variant<RecordBatchWithCache, schema::RowBatch> batch_;
   int64_t row_offset_ = 0;
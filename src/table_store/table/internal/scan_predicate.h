@@ -0,0 +1,174 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * ColumnPredicate is a single comparison against a column of a table, pushed down into a
+ * scan. Predicates are used only to prune batches: a batch is skipped when its per-column
+ * min/max statistics prove that no row in the batch can satisfy the predicate. Batches that
+ * are returned may still contain non-matching rows, so consumers must apply the full filter
+ * downstream.
+ */
+struct ColumnPredicate {
+  enum class Op {
+    Equal,
+    LessThanOrEqual,
+    GreaterThanOrEqual,
+    StringPrefix,
+  };
+  // Index of the column within the table's relation.
+  int64_t col_idx;
+  Op op;
+  // TIME64NS values are stored as int64_t.
+  std::variant<bool, int64_t, double, std::string> value;
+};
+
+/**
+ * ScanPredicate is a conjunction of column predicates. A batch can be skipped if any single
+ * predicate proves that the batch cannot contain a matching row.
+ */
+using ScanPredicate = std::vector<ColumnPredicate>;
+
+/**
+ * ColumnMinMax holds the minimum and maximum values of a single column within a single
+ * batch. TIME64NS columns are stored as int64_t.
+ */
+using ColumnMinMax =
+    std::variant<std::pair<bool, bool>, std::pair<int64_t, int64_t>, std::pair<double, double>,
+                 std::pair<std::string, std::string>>;
+
+namespace scan_predicate_impl {
+
+template <types::DataType TDataType>
+ColumnMinMax ArrowArrayMinMax(const arrow::Array* arr) {
+  auto min = types::GetValueFromArrowArray<TDataType>(arr, 0);
+  auto max = min;
+  for (int64_t i = 1; i < arr->length(); ++i) {
+    auto val = types::GetValueFromArrowArray<TDataType>(arr, i);
+    if (val < min) {
+      min = val;
+    }
+    if (max < val) {
+      max = val;
+    }
+  }
+  return std::make_pair(std::move(min), std::move(max));
+}
+
+// Returns the smallest string strictly greater than every string with the given prefix, or
+// std::nullopt if no such string exists (i.e. the prefix is entirely 0xff bytes).
+inline std::optional<std::string> StringPrefixUpperBound(std::string prefix) {
+  while (!prefix.empty() && static_cast<unsigned char>(prefix.back()) == 0xff) {
+    prefix.pop_back();
+  }
+  if (prefix.empty()) {
+    return std::nullopt;
+  }
+  prefix.back() = static_cast<char>(static_cast<unsigned char>(prefix.back()) + 1);
+  return prefix;
+}
+
+}  // namespace scan_predicate_impl
+
+/**
+ * ComputeColumnMinMax computes min/max statistics for the given arrow array. Returns
+ * std::nullopt for empty arrays and for column types without statistics support (UINT128).
+ */
+inline std::optional<ColumnMinMax> ComputeColumnMinMax(const arrow::Array* arr,
+                                                       types::DataType data_type) {
+  if (arr->length() == 0) {
+    return std::nullopt;
+  }
+  switch (data_type) {
+    case types::DataType::BOOLEAN:
+      return scan_predicate_impl::ArrowArrayMinMax<types::DataType::BOOLEAN>(arr);
+    case types::DataType::INT64:
+      return scan_predicate_impl::ArrowArrayMinMax<types::DataType::INT64>(arr);
+    case types::DataType::TIME64NS:
+      return scan_predicate_impl::ArrowArrayMinMax<types::DataType::TIME64NS>(arr);
+    case types::DataType::FLOAT64:
+      return scan_predicate_impl::ArrowArrayMinMax<types::DataType::FLOAT64>(arr);
+    case types::DataType::STRING:
+      return scan_predicate_impl::ArrowArrayMinMax<types::DataType::STRING>(arr);
+    default:
+      return std::nullopt;
+  }
+}
+
+/**
+ * MinMaxMayMatch returns whether a batch with the given column statistics could contain a
+ * row satisfying the predicate. Conservatively returns true when the predicate's value type
+ * doesn't match the statistics' type.
+ */
+inline bool MinMaxMayMatch(const ColumnMinMax& min_max, const ColumnPredicate& pred) {
+  return std::visit(
+      [&pred](const auto& mm) {
+        using T = std::decay_t<decltype(mm.first)>;
+        if (pred.op == ColumnPredicate::Op::StringPrefix) {
+          if constexpr (std::is_same_v<T, std::string>) {
+            const auto* prefix = std::get_if<std::string>(&pred.value);
+            if (prefix == nullptr) {
+              return true;
+            }
+            // Strings with the prefix form the range [prefix, upper_bound).
+            if (mm.second < *prefix) {
+              return false;
+            }
+            auto upper = scan_predicate_impl::StringPrefixUpperBound(*prefix);
+            return !upper.has_value() || mm.first < upper.value();
+          } else {
+            return true;
+          }
+        }
+        const T* val = std::get_if<T>(&pred.value);
+        if (val == nullptr) {
+          return true;
+        }
+        switch (pred.op) {
+          case ColumnPredicate::Op::Equal:
+            return !(*val < mm.first) && !(mm.second < *val);
+          case ColumnPredicate::Op::LessThanOrEqual:
+            return !(*val < mm.first);
+          case ColumnPredicate::Op::GreaterThanOrEqual:
+            return !(mm.second < *val);
+          default:
+            return true;
+        }
+      },
+      min_max);
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
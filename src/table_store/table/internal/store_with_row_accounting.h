@@ -19,6 +19,7 @@
 #pragma once
 
 #include <deque>
+#include <map>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -28,6 +29,9 @@
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/column_wrapper.h"
 #include "src/table_store/schema/relation.h"
+#include "src/table_store/table/internal/batch_stats.h"
+#include "src/table_store/table/internal/scan_predicate.h"
+#include "src/table_store/table/internal/string_intern_pool.h"
 #include "src/table_store/table/internal/types.h"
 
 namespace px {
@@ -72,8 +76,9 @@ class StoreWithRowTimeAccounting {
   using TBatch = typename StoreTypeTraits<TStoreType>::batch_type;
 
  public:
-  StoreWithRowTimeAccounting(const schema::Relation& rel, int64_t time_col_idx)
-      : rel_(rel), time_col_idx_(time_col_idx) {}
+  StoreWithRowTimeAccounting(const schema::Relation& rel, int64_t time_col_idx,
+                             arrow::MemoryPool* mem_pool = arrow::default_memory_pool())
+      : rel_(rel), time_col_idx_(time_col_idx), mem_pool_(mem_pool) {}
 
   /**
    * GetNextRowBatch returns the next row batch in this store after the given unique row id.
@@ -87,56 +92,78 @@ class StoreWithRowTimeAccounting {
    * @param stop_row_id, an optional unique RowID to stop the batch at. If provided, the batch will
    * be sliced such that no rows are included with `RowID >= stop_row_id.value()`.
    * @param cols, a vector of column indices to include in the outputted row batch.
+   * @param predicate, an optional ScanPredicate. Batches whose min/max statistics prove that no
+   * row can satisfy the predicate are skipped (the cursor state is advanced past them). Passing
+   * `nullptr` disables pruning.
    * @return a unique_ptr to the RowBatch or nullptr if there are no more rows in this store that
    * match the parameters above. On error returns a Status.
    */
   StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(
       RowID* last_read_row_id, BatchHints* hints, std::optional<RowID> stop_row_id,
-      const std::vector<int64_t>& cols) const {
+      const std::vector<int64_t>& cols, const ScanPredicate* predicate = nullptr) const {
     auto start_row_id = *last_read_row_id + 1;
-    if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
-      return std::unique_ptr<schema::RowBatch>(nullptr);
-    }
     if (DCHECK_IS_ON() && stop_row_id.has_value()) {
       DCHECK_LT(start_row_id, stop_row_id.value());
     }
 
-    BatchID batch_id;
-    if (hints != nullptr && BatchHintValid(*hints, start_row_id)) {
-      batch_id = hints->batch_id;
-    } else {
-      batch_id = FindBatchIDFromRowID(start_row_id);
-    }
+    while (true) {
+      if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
+        return std::unique_ptr<schema::RowBatch>(nullptr);
+      }
 
-    const auto& batch = GetBatchFromBatchID(batch_id);
-    RowID batch_first_row_id = BatchFirstRowID(batch_id);
-    RowID batch_last_row_id = BatchLastRowID(batch_id);
-    size_t row_offset = start_row_id - batch_first_row_id;
-    size_t batch_size = batch_last_row_id - start_row_id + 1;
-    if (stop_row_id.has_value() && batch_last_row_id >= stop_row_id.value()) {
-      // Reduce batch size if the batch extends past the given stop row.
-      batch_size -= (batch_last_row_id - stop_row_id.value()) + 1;
-    }
+      BatchID batch_id;
+      if (hints != nullptr && BatchHintValid(*hints, start_row_id)) {
+        batch_id = hints->batch_id;
+      } else {
+        batch_id = FindBatchIDFromRowID(start_row_id);
+      }
 
-    // Get column types for row descriptor.
-    std::vector<types::DataType> col_types;
-    for (int64_t col_idx : cols) {
-      DCHECK(static_cast<size_t>(col_idx) < rel_.NumColumns());
-      col_types.push_back(rel_.col_types()[col_idx]);
+      const auto& batch = GetBatchFromBatchID(batch_id);
+      RowID batch_first_row_id = BatchFirstRowID(batch_id);
+      RowID batch_last_row_id = BatchLastRowID(batch_id);
+      size_t row_offset = start_row_id - batch_first_row_id;
+      size_t batch_size = batch_last_row_id - start_row_id + 1;
+      if (stop_row_id.has_value() && batch_last_row_id >= stop_row_id.value()) {
+        // Reduce batch size if the batch extends past the given stop row.
+        batch_size -= (batch_last_row_id - stop_row_id.value()) + 1;
+      }
+
+      if (predicate != nullptr && !predicate->empty() &&
+          !BatchMayMatchPredicate(batch_id, *predicate)) {
+        // The batch's statistics prove it cannot contain a matching row, so skip it without
+        // materializing it and continue with the next batch.
+        *last_read_row_id = start_row_id + batch_size - 1;
+        if (hints != nullptr) {
+          hints->batch_id = batch_id + 1;
+          hints->hint_type = TStoreType;
+        }
+        if (stop_row_id.has_value() && *last_read_row_id + 1 >= stop_row_id.value()) {
+          return std::unique_ptr<schema::RowBatch>(nullptr);
+        }
+        start_row_id = *last_read_row_id + 1;
+        continue;
+      }
+
+      // Get column types for row descriptor.
+      std::vector<types::DataType> col_types;
+      for (int64_t col_idx : cols) {
+        DCHECK(static_cast<size_t>(col_idx) < rel_.NumColumns());
+        col_types.push_back(rel_.col_types()[col_idx]);
+      }
+      auto output_rb =
+          std::make_unique<schema::RowBatch>(schema::RowDescriptor(col_types), batch_size);
+      PL_RETURN_IF_ERROR(
+          AddBatchSliceToRowBatch(batch, row_offset, batch_size, cols, output_rb.get()));
+
+      // Update the ptr to the last read row.
+      *last_read_row_id = start_row_id + batch_size - 1;
+
+      // Set hints to point to the next batch in the current store. It's fine if that batch doesn't
+      // exist, as the next call will ignore the hints if that's the case.
+      hints->batch_id = batch_id + 1;
+      hints->hint_type = TStoreType;
+      return output_rb;
     }
-    auto output_rb =
-        std::make_unique<schema::RowBatch>(schema::RowDescriptor(col_types), batch_size);
-    PL_RETURN_IF_ERROR(
-        AddBatchSliceToRowBatch(batch, row_offset, batch_size, cols, output_rb.get()));
-
-    // Update the ptr to the last read row.
-    *last_read_row_id = start_row_id + batch_size - 1;
-
-    // Set hints to point to the next batch in the current store. It's fine if that batch doesn't
-    // exist, as the next call will ignore the hints if that's the case.
-    hints->batch_id = batch_id + 1;
-    hints->hint_type = TStoreType;
-    return output_rb;
   }
 
   /**
@@ -145,6 +172,38 @@ class StoreWithRowTimeAccounting {
    */
   size_t Size() const { return batches_.size(); }
 
+  /**
+   * NumBatchesWithZoneMaps returns the number of batches in this store with per-column zone
+   * maps (min/max) computed for at least one column. Cold batches compute zone maps eagerly,
+   * hot batches lazily on the first predicate that references a column, so for the hot store
+   * this measures how much of the store is coverable by predicate pruning without a scan.
+   * @return number of batches with zone maps.
+   */
+  int64_t NumBatchesWithZoneMaps() const {
+    int64_t count = 0;
+    for (const auto& stats : stats_cache_) {
+      if (!stats.min_max.empty()) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * NumBatchesWithBloomFilters returns the number of batches in this store with bloom filters
+   * built for at least one string column. Only cold batches build bloom filters.
+   * @return number of batches with bloom filters.
+   */
+  int64_t NumBatchesWithBloomFilters() const {
+    int64_t count = 0;
+    for (const auto& stats : stats_cache_) {
+      if (!stats.bloom_filters.empty()) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
   /**
    * front gets a reference to the first batch in the store.
    * @return reference to the first batch in the store.
@@ -164,6 +223,7 @@ class StoreWithRowTimeAccounting {
 
     row_ids_.pop_front();
     if (time_col_idx_ != -1) times_.pop_front();
+    stats_cache_.pop_front();
 
     auto&& front = std::move(batches_.front());
     batches_.pop_front();
@@ -179,6 +239,18 @@ class StoreWithRowTimeAccounting {
   template <typename... Args>
   TBatch& EmplaceBack(RowID first_row_id, Args... args) {
     auto& batch = batches_.emplace_back(std::forward<Args>(args)...);
+    auto& stats = stats_cache_.emplace_back();
+    if constexpr (std::is_same_v<TBatch, ColdBatch>) {
+      batch.DictionaryEncodeStringColumns(rel_, mem_pool_, string_intern_pool_.get());
+      // Cold batches are immutable, so their zone maps and bloom filters are computed once,
+      // eagerly, and pruning never has to touch the batch's arrow arrays again.
+      PopulateColdBatchStats(batch, &stats);
+      if (!FLAGS_table_store_cold_spill_dir.empty()) {
+        auto status = batch.SpillToDisk(FLAGS_table_store_cold_spill_dir);
+        // On failure the batch simply stays in RAM.
+        LOG_IF(ERROR, !status.ok()) << "Failed to spill cold batch to disk: " << status.msg();
+      }
+    }
 
     row_ids_.emplace_back(first_row_id, first_row_id + BatchLength(batch) - 1);
     if (time_col_idx_ != -1) {
@@ -269,6 +341,9 @@ class StoreWithRowTimeAccounting {
     if (time_col_idx_ != -1) {
       times_.front().first = GetTimeValue(batches_.front(), 0);
     }
+    // Cached min/max statistics are left untouched: removing rows can only narrow a column's
+    // actual range, so the cached statistics remain a conservative superset and can at worst
+    // miss a pruning opportunity, never skip a matching batch.
   }
 
   /**
@@ -296,6 +371,15 @@ class StoreWithRowTimeAccounting {
     return times_.back().second;
   }
 
+  /**
+   * set_string_intern_pool sets the pool used to share dictionary encoded string column
+   * dictionaries across batches and tables. Only meaningful for the cold store; callers must
+   * synchronize with other accesses to this store.
+   */
+  void set_string_intern_pool(std::shared_ptr<StringInternPool> pool) {
+    string_intern_pool_ = std::move(pool);
+  }
+
  private:
   BatchID LastBatchID() const { return first_batch_id_ + batches_.size() - 1; }
 
@@ -323,6 +407,85 @@ class StoreWithRowTimeAccounting {
     return batches_[batch_id - first_batch_id_];
   }
 
+  std::optional<ColumnMinMax> ComputeBatchColumnMinMax(const TBatch& batch, int64_t col_idx) const {
+    if constexpr (std::is_same_v<TBatch, ColdBatch>) {
+      if (batch.IsDictionaryEncoded(col_idx)) {
+        // The dictionary holds every distinct value of the column, so its min/max is the
+        // column's min/max.
+        return ComputeColumnMinMax(batch.Dictionary(col_idx).get(), types::DataType::STRING);
+      }
+      return ComputeColumnMinMax(batch.PlainColumn(col_idx).get(), rel_.col_types()[col_idx]);
+    } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
+      return batch.GetColumnMinMax(col_idx, rel_.col_types()[col_idx]);
+    } else {
+      constexpr_else_static_assert_false();
+    }
+  }
+
+  // Eagerly computes zone maps for every column, and bloom filters for string columns, of a
+  // newly added cold batch.
+  void PopulateColdBatchStats(const ColdBatch& batch, BatchStats* stats) const {
+    for (size_t col_idx = 0; col_idx < rel_.NumColumns(); ++col_idx) {
+      auto col_data_type = rel_.col_types()[col_idx];
+      stats->min_max.emplace(col_idx, ComputeBatchColumnMinMax(batch, col_idx));
+      if (col_data_type != types::DataType::STRING) {
+        continue;
+      }
+      // For dictionary encoded columns, statistics only need the distinct values, which is
+      // exactly what the dictionary holds.
+      const auto* arr = batch.IsDictionaryEncoded(col_idx)
+                            ? static_cast<const arrow::Array*>(batch.Dictionary(col_idx).get())
+                            : batch.PlainColumn(col_idx).get();
+      if (arr->length() == 0) {
+        continue;
+      }
+      auto bloom = ColumnBloomFilter::Create(arr->length());
+      for (int64_t i = 0; i < arr->length(); ++i) {
+        bloom.Add(types::GetStringViewFromArrowArray(arr, i));
+      }
+      stats->bloom_filters.emplace(col_idx, std::move(bloom));
+    }
+  }
+
+  // Returns whether the given batch could contain a row matching the predicate, based on
+  // per-column zone maps and bloom filters. For hot batches, zone maps are computed lazily on
+  // the first predicate that references a column and then cached for the lifetime of the
+  // batch; for cold batches all statistics are precomputed in `PopulateColdBatchStats`.
+  bool BatchMayMatchPredicate(BatchID batch_id, const ScanPredicate& predicate) const {
+    auto& stats = stats_cache_[batch_id - first_batch_id_];
+    for (const auto& pred : predicate) {
+      if (time_col_idx_ != -1 && pred.col_idx == time_col_idx_) {
+        // The per-batch time index maintained for cursor positioning already holds the
+        // first/last timestamp of every batch, and the time column is sorted, so the time
+        // column's zone map comes for free without touching the batch.
+        const TimeInterval& interval = times_[batch_id - first_batch_id_];
+        if (!MinMaxMayMatch(std::pair<int64_t, int64_t>(interval.first, interval.second), pred)) {
+          return false;
+        }
+        continue;
+      }
+      auto it = stats.min_max.find(pred.col_idx);
+      if (it == stats.min_max.end()) {
+        const auto& batch = GetBatchFromBatchID(batch_id);
+        it = stats.min_max.emplace(pred.col_idx, ComputeBatchColumnMinMax(batch, pred.col_idx))
+                 .first;
+      }
+      if (it->second.has_value() && !MinMaxMayMatch(it->second.value(), pred)) {
+        return false;
+      }
+      if (pred.op == ColumnPredicate::Op::Equal) {
+        auto bloom_it = stats.bloom_filters.find(pred.col_idx);
+        if (bloom_it != stats.bloom_filters.end()) {
+          const auto* val = std::get_if<std::string>(&pred.value);
+          if (val != nullptr && !bloom_it->second.MayContain(*val)) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
   bool BatchHintValid(const BatchHints& hints, RowID row_id) const {
     if (hints.hint_type != TStoreType) {
       return false;
@@ -342,7 +505,7 @@ class StoreWithRowTimeAccounting {
 
   size_t BatchLength(const TBatch& batch) const {
     if constexpr (std::is_same_v<ColdBatch, TBatch>) {
-      return batch[0]->length();
+      return batch.num_rows();
     } else if constexpr (std::is_same_v<HotBatch, TBatch>) {
       return batch.Length();
     } else {
@@ -353,7 +516,7 @@ class StoreWithRowTimeAccounting {
   size_t FindTimeFirstGreaterThanOrEqual(const TBatch& batch, Time time) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
       return types::SearchArrowArrayGreaterThanOrEqual<types::DataType::TIME64NS>(
-          batch[time_col_idx_].get(), time);
+          batch.PlainColumn(time_col_idx_).get(), time);
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.FindTimeFirstGreaterThanOrEqual(time_col_idx_, time);
     } else {
@@ -364,7 +527,7 @@ class StoreWithRowTimeAccounting {
   size_t FindTimeFirstGreaterThan(const TBatch& batch, Time time) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
       return types::SearchArrowArrayLessThanOrEqual<types::DataType::TIME64NS>(
-                 batch[time_col_idx_].get(), time) +
+                 batch.PlainColumn(time_col_idx_).get(), time) +
              1;
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.FindTimeFirstGreaterThan(time_col_idx_, time);
@@ -375,8 +538,8 @@ class StoreWithRowTimeAccounting {
 
   Time GetTimeValue(const TBatch& batch, int64_t row_idx) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
-      return types::GetValueFromArrowArray<types::DataType::TIME64NS>(batch[time_col_idx_].get(),
-                                                                      row_idx);
+      return types::GetValueFromArrowArray<types::DataType::TIME64NS>(
+          batch.PlainColumn(time_col_idx_).get(), row_idx);
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.GetTimeValue(time_col_idx_, row_idx);
     } else {
@@ -389,12 +552,14 @@ class StoreWithRowTimeAccounting {
                                  schema::RowBatch* output_rb) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
       for (auto col_idx : cols) {
-        auto arr = batch[col_idx]->Slice(row_offset, batch_size);
+        // ColumnSlice lazily decodes dictionary encoded columns, and only for this slice.
+        PL_ASSIGN_OR_RETURN(auto arr,
+                            batch.ColumnSlice(col_idx, row_offset, batch_size, mem_pool_));
         PL_RETURN_IF_ERROR(output_rb->AddColumn(arr));
       }
       return Status::OK();
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
-      return batch.AddBatchSliceToRowBatch(row_offset, batch_size, cols, output_rb);
+      return batch.AddBatchSliceToRowBatch(row_offset, batch_size, cols, output_rb, mem_pool_);
     } else {
       constexpr_else_static_assert_false();
     }
@@ -406,6 +571,16 @@ class StoreWithRowTimeAccounting {
   std::deque<TBatch> batches_;
   std::deque<RowIDInterval> row_ids_;
   std::deque<TimeInterval> times_;
+  // Per-batch pruning statistics (zone maps and bloom filters), kept in lockstep with
+  // `batches_`. Computed eagerly for cold batches, lazily for hot batches. Mutable since hot
+  // statistics are memoized during const reads.
+  mutable std::deque<BatchStats> stats_cache_;
+  // Optional pool for sharing string column dictionaries across batches and tables. Unused by
+  // the hot store.
+  std::shared_ptr<StringInternPool> string_intern_pool_;
+  // Pool used for the store's own allocations: hot arrow column caches, cold dictionary
+  // encoding and decoded column slices. Typically the owning table's arena.
+  arrow::MemoryPool* mem_pool_;
 };
 
 }  // namespace internal
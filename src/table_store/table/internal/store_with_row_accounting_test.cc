@@ -124,6 +124,74 @@ TEST_F(ColdStoreTest, PushRowBatchesCheckProperties) {
   EXPECT_EQ(4, optional_row_id.value());
 }
 
+TEST_F(ColdStoreTest, predicate_pruning_with_zone_maps_and_bloom_filters) {
+  // Two batches whose string columns have disjoint values but overlapping lexicographic
+  // ranges, so a zone map alone cannot prune an equality predicate between them.
+  auto rb0 = MakeRowBatch({1, 2}, {true, false}, {"aa", "zz"});
+  auto rb1 = MakeRowBatch({3, 4}, {true, false}, {"ab", "zy"});
+  store_->EmplaceBack(0, rb0.columns());
+  store_->EmplaceBack(2, rb1.columns());
+
+  // "ab" lies within the first batch's [aa, zz] range, but its bloom filter proves the value
+  // is absent, so the scan starts at the second batch.
+  {
+    ScanPredicate predicate = {{/* col_idx */ 2, ColumnPredicate::Op::Equal, std::string("ab")}};
+    RowID last_read_row_id = -1;
+    BatchHints hints;
+    auto rb = store_->GetNextRowBatch(&last_read_row_id, &hints, std::nullopt, {0, 2}, &predicate)
+                  .ConsumeValueOrDie();
+    ASSERT_NE(nullptr, rb);
+    EXPECT_EQ(2, rb->num_rows());
+    EXPECT_EQ(3, last_read_row_id);
+    EXPECT_TRUE(rb->ColumnAt(1)->Equals(types::ToArrow(
+        std::vector<types::StringValue>{"ab", "zy"}, arrow::default_memory_pool())));
+  }
+
+  // Zone map on the time column prunes the first batch.
+  {
+    ScanPredicate predicate = {
+        {/* col_idx */ 0, ColumnPredicate::Op::GreaterThanOrEqual, int64_t{3}}};
+    RowID last_read_row_id = -1;
+    BatchHints hints;
+    auto rb = store_->GetNextRowBatch(&last_read_row_id, &hints, std::nullopt, {0, 2}, &predicate)
+                  .ConsumeValueOrDie();
+    ASSERT_NE(nullptr, rb);
+    EXPECT_EQ(2, rb->num_rows());
+    EXPECT_EQ(3, last_read_row_id);
+  }
+
+  // A predicate nothing satisfies prunes every batch and advances past the end of the store.
+  {
+    ScanPredicate predicate = {
+        {/* col_idx */ 2, ColumnPredicate::Op::Equal, std::string("absent")}};
+    RowID last_read_row_id = -1;
+    BatchHints hints;
+    auto rb = store_->GetNextRowBatch(&last_read_row_id, &hints, std::nullopt, {0, 2}, &predicate)
+                  .ConsumeValueOrDie();
+    EXPECT_EQ(nullptr, rb);
+    EXPECT_EQ(3, last_read_row_id);
+  }
+}
+
+TEST_F(ColdStoreTest, dictionary_encoded_strings_round_trip) {
+  // Repetitive string values get dictionary encoded on entry to the cold store; scans must
+  // still see the original plain values.
+  std::vector<types::StringValue> strings = {"pl/vizier-pem", "pl/vizier-pem", "pl/kelvin",
+                                             "pl/vizier-pem"};
+  auto rb0 = MakeRowBatch({1, 2, 3, 4}, {true, false, true, false}, strings);
+  store_->EmplaceBack(0, rb0.columns());
+
+  EXPECT_TRUE(store_->front().IsDictionaryEncoded(2));
+
+  RowID last_read_row_id = -1;
+  BatchHints hints;
+  auto rb = store_->GetNextRowBatch(&last_read_row_id, &hints, std::nullopt, {0, 2})
+                .ConsumeValueOrDie();
+  ASSERT_NE(nullptr, rb);
+  EXPECT_TRUE(
+      rb->ColumnAt(1)->Equals(types::ToArrow(strings, arrow::default_memory_pool())));
+}
+
 TEST_P(HotStoreTest, PushRowBatchesCheckProperties) {
   std::vector<types::Time64NSValue> times = {1, 1, 10, 11};
   std::vector<types::BoolValue> bools = {true, false, true, false};
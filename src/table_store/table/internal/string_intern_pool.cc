@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string_view>
+#include <utility>
+
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/string_intern_pool.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+size_t StringInternPool::HashDictionary(const arrow::StringArray& dict) {
+  size_t h = absl::Hash<int64_t>{}(dict.length());
+  for (int64_t i = 0; i < dict.length(); ++i) {
+    auto view = types::GetStringViewFromArrowArray(&dict, i);
+    h = absl::Hash<std::pair<size_t, std::string_view>>{}({h, view});
+  }
+  return h;
+}
+
+std::shared_ptr<arrow::StringArray> StringInternPool::Intern(
+    std::shared_ptr<arrow::StringArray> dict) {
+  auto hash = HashDictionary(*dict);
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  auto& bucket = dicts_[hash];
+  for (auto it = bucket.begin(); it != bucket.end();) {
+    auto live = it->lock();
+    if (live == nullptr) {
+      it = bucket.erase(it);
+      continue;
+    }
+    if (live->Equals(*dict)) {
+      return live;
+    }
+    ++it;
+  }
+  bucket.emplace_back(dict);
+  return dict;
+}
+
+size_t StringInternPool::NumLiveDictionaries() const {
+  absl::base_internal::SpinLockHolder lock(&lock_);
+  size_t count = 0;
+  for (const auto& [hash, bucket] : dicts_) {
+    for (const auto& weak : bucket) {
+      if (!weak.expired()) {
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <absl/base/internal/spinlock.h>
+#include <absl/container/flat_hash_map.h>
+#include <arrow/array.h>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * StringInternPool deduplicates the dictionaries of dictionary encoded string columns across
+ * batches and tables. The same pod, container and service names appear in the string columns of
+ * many tables (http_events, conn_stats, process_stats, ...), so their per-batch dictionaries are
+ * frequently byte-identical; interning them stores each distinct dictionary once per table store.
+ *
+ * The pool holds only weak references, so it never extends a dictionary's lifetime: once every
+ * batch referencing a dictionary has been expired, the dictionary is freed and its pool entry is
+ * pruned on the next access. All methods are thread-safe, since cold batches may be built
+ * concurrently by background compaction threads.
+ */
+class StringInternPool {
+ public:
+  /**
+   * Intern returns the pooled dictionary equal to `dict` if one is live, registering `dict` and
+   * returning it unchanged otherwise.
+   */
+  std::shared_ptr<arrow::StringArray> Intern(std::shared_ptr<arrow::StringArray> dict);
+
+  /**
+   * NumLiveDictionaries returns the number of distinct dictionaries currently referenced by at
+   * least one batch. Intended for tests and stats.
+   */
+  size_t NumLiveDictionaries() const;
+
+ private:
+  static size_t HashDictionary(const arrow::StringArray& dict);
+
+  mutable absl::base_internal::SpinLock lock_;
+  // Content hash -> dictionaries with that hash. Buckets hold more than one entry only on hash
+  // collision; expired entries are pruned whenever their bucket is visited.
+  absl::flat_hash_map<size_t, std::vector<std::weak_ptr<arrow::StringArray>>> dicts_
+      ABSL_GUARDED_BY(lock_);
+};
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
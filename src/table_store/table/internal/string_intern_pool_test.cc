@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/cold_batch.h"
+#include "src/table_store/table/internal/string_intern_pool.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+namespace {
+
+std::shared_ptr<arrow::StringArray> MakeStringArray(std::vector<types::StringValue> values) {
+  return std::static_pointer_cast<arrow::StringArray>(
+      types::ToArrow(values, arrow::default_memory_pool()));
+}
+
+}  // namespace
+
+TEST(StringInternPoolTest, dedupes_identical_dictionaries) {
+  StringInternPool pool;
+
+  auto a = MakeStringArray({"pl/vizier-pem", "pl/kelvin"});
+  auto b = MakeStringArray({"pl/vizier-pem", "pl/kelvin"});
+  auto c = MakeStringArray({"pl/vizier-pem", "pl/nats"});
+  ASSERT_NE(a.get(), b.get());
+
+  auto interned_a = pool.Intern(a);
+  auto interned_b = pool.Intern(b);
+  auto interned_c = pool.Intern(c);
+
+  // Byte-identical dictionaries share one arrow array; distinct contents do not.
+  EXPECT_EQ(interned_a.get(), a.get());
+  EXPECT_EQ(interned_b.get(), a.get());
+  EXPECT_NE(interned_c.get(), a.get());
+  EXPECT_EQ(2, pool.NumLiveDictionaries());
+}
+
+TEST(StringInternPoolTest, expired_dictionaries_are_released) {
+  StringInternPool pool;
+
+  auto a = MakeStringArray({"pl/vizier-pem", "pl/kelvin"});
+  auto interned = pool.Intern(a);
+  ASSERT_EQ(1, pool.NumLiveDictionaries());
+
+  // The pool holds only weak references, so dropping all batch references frees the dictionary.
+  a.reset();
+  interned.reset();
+  EXPECT_EQ(0, pool.NumLiveDictionaries());
+
+  // A new dictionary with the same content gets a fresh entry.
+  auto b = MakeStringArray({"pl/vizier-pem", "pl/kelvin"});
+  EXPECT_EQ(pool.Intern(b).get(), b.get());
+  EXPECT_EQ(1, pool.NumLiveDictionaries());
+}
+
+TEST(StringInternPoolTest, cold_batches_share_dictionaries_across_encodes) {
+  schema::Relation rel({types::DataType::STRING}, {"col1"});
+  StringInternPool pool;
+
+  std::vector<types::StringValue> strings = {"pl/vizier-pem", "pl/vizier-pem", "pl/kelvin",
+                                             "pl/vizier-pem", "pl/kelvin", "pl/vizier-pem"};
+  ColdBatch batch1(
+      std::vector<ArrowArrayPtr>{types::ToArrow(strings, arrow::default_memory_pool())});
+  ColdBatch batch2(
+      std::vector<ArrowArrayPtr>{types::ToArrow(strings, arrow::default_memory_pool())});
+  batch1.DictionaryEncodeStringColumns(rel, arrow::default_memory_pool(), &pool);
+  batch2.DictionaryEncodeStringColumns(rel, arrow::default_memory_pool(), &pool);
+
+  ASSERT_TRUE(batch1.IsDictionaryEncoded(0));
+  ASSERT_TRUE(batch2.IsDictionaryEncoded(0));
+  // Both batches reference the same dictionary array.
+  EXPECT_EQ(batch1.Dictionary(0).get(), batch2.Dictionary(0).get());
+  EXPECT_EQ(1, pool.NumLiveDictionaries());
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -29,13 +29,14 @@
 #include "src/shared/types/column_wrapper.h"
 #include "src/shared/types/types.h"
 #include "src/table_store/schema/row_batch.h"
+#include "src/table_store/table/internal/cold_batch.h"
 
 namespace px {
 namespace table_store {
 namespace internal {
 
 using RecordBatchPtr = std::unique_ptr<px::types::ColumnWrapperRecordBatch>;
-using ArrowArrayPtr = std::shared_ptr<arrow::Array>;
+// ArrowArrayPtr is defined in cold_batch.h.
 using Time = int64_t;
 using TimeInterval = std::pair<Time, Time>;
 using RowID = int64_t;
@@ -62,7 +63,7 @@ struct BatchHints {
 
 class RecordOrRowBatch;
 
-using ColdBatch = std::vector<ArrowArrayPtr>;
+// ColdBatch is defined in cold_batch.h.
 
 template <StoreType type>
 struct StoreTypeTraits {};
@@ -30,6 +30,7 @@
 #include "internal/store_with_row_accounting.h"
 #include "src/common/base/base.h"
 #include "src/common/base/status.h"
+#include "src/common/perf/hot_path_profiler.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/type_utils.h"
 #include "src/table_store/schema/relation.h"
@@ -49,7 +50,24 @@ namespace px {
 namespace table_store {
 
 Table::Cursor::Cursor(const Table* table, StartSpec start, StopSpec stop)
-    : table_(table), hints_(internal::BatchHints{}) {
+    : Cursor(table, std::move(start), std::move(stop), PredicateSpec{}) {}
+
+Table::Cursor::Cursor(const Table* table, StartSpec start, StopSpec stop, PredicateSpec predicate)
+    : Cursor(table, std::move(start), std::move(stop), std::move(predicate),
+             std::vector<int64_t>{}) {}
+
+Table::Cursor::Cursor(const Table* table, StartSpec start, StopSpec stop, PredicateSpec predicate,
+                      std::vector<int64_t> cols)
+    : table_(table),
+      hints_(internal::BatchHints{}),
+      predicate_(std::move(predicate)),
+      cols_(std::move(cols)) {
+  if (cols_.empty()) {
+    // No explicit projection: the cursor reads all of the table's columns.
+    for (int64_t i = 0; i < static_cast<int64_t>(table_->rel_.NumColumns()); ++i) {
+      cols_.push_back(i);
+    }
+  }
   AdvanceToStart(start);
   StopStateFromSpec(std::move(stop));
 }
@@ -111,6 +129,9 @@ void Table::Cursor::StopStateFromSpec(StopSpec&& stop) {
 }
 
 bool Table::Cursor::NextBatchReady() {
+  if (stop_.spec.max_rows > 0 && rows_returned_ >= stop_.spec.max_rows) {
+    return false;
+  }
   switch (stop_.spec.type) {
     case StopSpec::StopType::StopAtTimeOrEndOfTable:
     case StopSpec::StopType::CurrentEndOfTable: {
@@ -128,6 +149,9 @@ bool Table::Cursor::NextBatchReady() {
 }
 
 bool Table::Cursor::Done() {
+  if (stop_.spec.max_rows > 0 && rows_returned_ >= stop_.spec.max_rows) {
+    return true;
+  }
   auto next_row_id = last_read_row_id_ + 1;
   switch (stop_.spec.type) {
     case StopSpec::StopType::StopAtTimeOrEndOfTable:
@@ -151,6 +175,56 @@ bool Table::Cursor::Done() {
 
 void Table::Cursor::UpdateStopSpec(Cursor::StopSpec stop) { StopStateFromSpec(std::move(stop)); }
 
+Table::Cursor::Cursor(const Table* table, RowID first_row_id, RowID stop_row_id,
+                      PredicateSpec predicate)
+    : table_(table), hints_(internal::BatchHints{}), predicate_(std::move(predicate)) {
+  last_read_row_id_ = first_row_id - 1;
+  stop_.spec.type = StopSpec::StopType::CurrentEndOfTable;
+  stop_.stop_row_id = stop_row_id;
+  stop_.stop_row_id_final = true;
+}
+
+StatusOr<std::vector<Table::Cursor>> Table::Cursor::Split(size_t num_partitions) {
+  if (num_partitions == 0) {
+    return error::InvalidArgument("Cannot split a Cursor into 0 partitions.");
+  }
+  if (stop_.spec.type == StopSpec::StopType::Infinite) {
+    return error::InvalidArgument("Cannot split an Infinite Cursor.");
+  }
+  if (stop_.spec.max_rows > 0) {
+    // A row limit is a property of the cursor's scan order, so it can't be distributed across
+    // partitions.
+    return error::InvalidArgument("Cannot split a Cursor with a row limit.");
+  }
+  if (stop_.spec.type == StopSpec::StopType::StopAtTime) {
+    UpdateStopStateForStopAtTime();
+    if (!stop_.stop_row_id_final) {
+      return error::InvalidArgument(
+          "Cannot split a StopAtTime Cursor before its stop time is within the table.");
+    }
+  }
+
+  RowID start_row_id = last_read_row_id_ + 1;
+  int64_t num_rows = stop_.stop_row_id - start_row_id;
+  std::vector<Cursor> partitions;
+  if (num_rows <= 0) {
+    return partitions;
+  }
+
+  int64_t n = std::min<int64_t>(num_partitions, num_rows);
+  partitions.reserve(n);
+  for (int64_t i = 0; i < n; ++i) {
+    RowID partition_start = start_row_id + num_rows * i / n;
+    RowID partition_stop = start_row_id + num_rows * (i + 1) / n;
+    Cursor partition(table_, partition_start, partition_stop, predicate_);
+    partition.cols_ = cols_;
+    partitions.push_back(std::move(partition));
+  }
+  // The range has been handed off to the partitions; consume this cursor.
+  last_read_row_id_ = stop_.stop_row_id - 1;
+  return partitions;
+}
+
 internal::RowID* Table::Cursor::LastReadRowID() { return &last_read_row_id_; }
 
 internal::BatchHints* Table::Cursor::Hints() { return &hints_; }
@@ -162,9 +236,30 @@ std::optional<internal::RowID> Table::Cursor::StopRowID() const {
   return stop_.stop_row_id;
 }
 
+const internal::ScanPredicate* Table::Cursor::Predicate() const { return &predicate_; }
+
+StatusOr<std::unique_ptr<schema::RowBatch>> Table::Cursor::ApplyRowLimit(
+    std::unique_ptr<schema::RowBatch> rb) {
+  if (stop_.spec.max_rows <= 0) {
+    return rb;
+  }
+  int64_t remaining = stop_.spec.max_rows - rows_returned_;
+  if (rb->num_rows() > remaining) {
+    PL_ASSIGN_OR_RETURN(rb, rb->Slice(0, remaining));
+  }
+  rows_returned_ += rb->num_rows();
+  return rb;
+}
+
+StatusOr<std::unique_ptr<schema::RowBatch>> Table::Cursor::GetNextRowBatch() {
+  PL_ASSIGN_OR_RETURN(auto rb, table_->GetNextRowBatch(this, cols_));
+  return ApplyRowLimit(std::move(rb));
+}
+
 StatusOr<std::unique_ptr<schema::RowBatch>> Table::Cursor::GetNextRowBatch(
     const std::vector<int64_t>& cols) {
-  return table_->GetNextRowBatch(this, cols);
+  PL_ASSIGN_OR_RETURN(auto rb, table_->GetNextRowBatch(this, cols));
+  return ApplyRowLimit(std::move(rb));
 }
 
 Table::Table(std::string_view table_name, const schema::Relation& relation, size_t max_table_size,
@@ -173,8 +268,7 @@ Table::Table(std::string_view table_name, const schema::Relation& relation, size
       rel_(relation),
       max_table_size_(max_table_size),
       compacted_batch_size_(compacted_batch_size),
-      // TODO(james): move mem_pool into constructor.
-      compactor_(rel_, arrow::default_memory_pool()) {
+      compactor_(rel_, &arena_pool_) {
   absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
   absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
   for (const auto& [i, col_name] : Enumerate(rel_.col_names())) {
@@ -184,9 +278,9 @@ Table::Table(std::string_view table_name, const schema::Relation& relation, size
   }
   batch_size_accountant_ = internal::BatchSizeAccountant::Create(rel_, compacted_batch_size_);
   hot_store_ = std::make_unique<internal::StoreWithRowTimeAccounting<internal::StoreType::Hot>>(
-      rel_, time_col_idx_);
+      rel_, time_col_idx_, &arena_pool_);
   cold_store_ = std::make_unique<internal::StoreWithRowTimeAccounting<internal::StoreType::Cold>>(
-      rel_, time_col_idx_);
+      rel_, time_col_idx_, &arena_pool_);
 }
 
 Status Table::ToProto(table_store::schemapb::Table* table_proto) const {
@@ -215,39 +309,60 @@ StatusOr<std::unique_ptr<schema::RowBatch>> Table::GetNextRowBatch(
   absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
   PL_ASSIGN_OR_RETURN(auto rb,
                       cold_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
-                                                   cursor->StopRowID(), cols));
+                                                   cursor->StopRowID(), cols, cursor->Predicate()));
   if (rb == nullptr) {
     absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
-    PL_ASSIGN_OR_RETURN(rb, hot_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
-                                                        cursor->StopRowID(), cols));
+    PL_ASSIGN_OR_RETURN(rb,
+                        hot_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
+                                                    cursor->StopRowID(), cols,
+                                                    cursor->Predicate()));
     if (rb == nullptr && hot_store_->Size() > 0) {
       // If the cursor was pointing to an expired row batch, update the cursor to point to the start
       // of the table, then try to get the next row batch.
       *cursor->LastReadRowID() = hot_store_->FirstRowID() - 1;
       if (!cursor->Done()) {
-        PL_ASSIGN_OR_RETURN(rb,
-                            hot_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
-                                                        cursor->StopRowID(), cols));
+        PL_ASSIGN_OR_RETURN(rb, hot_store_->GetNextRowBatch(cursor->LastReadRowID(),
+                                                            cursor->Hints(), cursor->StopRowID(),
+                                                            cols, cursor->Predicate()));
       }
     }
   }
   if (rb == nullptr) {
+    if (!cursor->Predicate()->empty()) {
+      // Predicate pruning may skip every remaining batch, in which case the cursor has been
+      // advanced but no rows are available. Return an empty batch rather than an error.
+      std::vector<types::DataType> col_types;
+      col_types.reserve(cols.size());
+      for (auto col_idx : cols) {
+        col_types.push_back(rel_.col_types()[col_idx]);
+      }
+      return schema::RowBatch::WithZeroRows(schema::RowDescriptor(std::move(col_types)),
+                                            /* eow */ false, /* eos */ false);
+    }
     return error::InvalidArgument("Data after Cursor is not in the table.");
   }
+  {
+    absl::base_internal::SpinLockHolder lock(&stats_lock_);
+    window_bytes_read_ += rb->NumBytes();
+  }
   return rb;
 }
 
+// Hard-limit backstop on the write path. The background reclaimer (see ReclaimBatches) keeps
+// the table below its low watermark, so under a steady ingest rate this loop doesn't run and
+// writes never expire batches inline; it only kicks in when a burst outruns the reclaimer.
 Status Table::ExpireRowBatches(int64_t row_batch_size) {
-  if (row_batch_size > max_table_size_) {
+  const int64_t max_table_size = max_table_size_;
+  if (row_batch_size > max_table_size) {
     return error::InvalidArgument("RowBatch size ($0) is bigger than maximum table size ($1).",
-                                  row_batch_size, max_table_size_);
+                                  row_batch_size, max_table_size);
   }
   int64_t bytes;
   {
     absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
     bytes = batch_size_accountant_->HotBytes() + batch_size_accountant_->ColdBytes();
   }
-  while (bytes + row_batch_size > max_table_size_) {
+  while (bytes + row_batch_size > max_table_size) {
     PL_RETURN_IF_ERROR(ExpireBatch());
     {
       absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
@@ -313,6 +428,7 @@ Status Table::WriteHot(internal::RecordOrRowBatch&& record_or_row_batch) {
     ++batches_added_;
     metrics_.batches_added_counter.Increment();
     bytes_added_ += batch_stats.bytes;
+    window_bytes_added_ += batch_stats.bytes;
     metrics_.bytes_added_counter.Increment(batch_stats.bytes);
   }
 
@@ -390,33 +506,58 @@ schema::Relation Table::GetRelation() const { return rel_; }
 TableStats Table::GetTableStats() const {
   TableStats info;
   int64_t min_time = -1;
-  int64_t num_batches = 0;
+  int64_t max_time = -1;
+  int64_t num_hot_batches = 0;
+  int64_t num_cold_batches = 0;
+  int64_t num_rows = 0;
   int64_t hot_bytes = 0;
   int64_t cold_bytes = 0;
+  int64_t zone_map_batches = 0;
+  int64_t bloom_filter_batches = 0;
   {
     absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
     min_time = cold_store_->MinTime();
-    num_batches += cold_store_->Size();
+    num_cold_batches = cold_store_->Size();
     absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
-    num_batches += hot_store_->Size();
+    num_hot_batches = hot_store_->Size();
     hot_bytes = batch_size_accountant_->HotBytes();
     cold_bytes = batch_size_accountant_->ColdBytes();
     if (min_time == -1) {
       min_time = hot_store_->MinTime();
     }
+    if (num_hot_batches > 0) {
+      max_time = hot_store_->MaxTime();
+    } else if (num_cold_batches > 0) {
+      max_time = cold_store_->MaxTime();
+    }
+    if (num_cold_batches > 0) {
+      num_rows = next_row_id_ - cold_store_->FirstRowID();
+    } else if (num_hot_batches > 0) {
+      num_rows = next_row_id_ - hot_store_->FirstRowID();
+    }
+    zone_map_batches =
+        cold_store_->NumBatchesWithZoneMaps() + hot_store_->NumBatchesWithZoneMaps();
+    bloom_filter_batches =
+        cold_store_->NumBatchesWithBloomFilters() + hot_store_->NumBatchesWithBloomFilters();
   }
   absl::base_internal::SpinLockHolder lock(&stats_lock_);
 
   info.batches_added = batches_added_;
   info.batches_expired = batches_expired_;
   info.bytes_added = bytes_added_;
-  info.num_batches = num_batches;
+  info.num_batches = num_hot_batches + num_cold_batches;
+  info.num_hot_batches = num_hot_batches;
+  info.num_cold_batches = num_cold_batches;
+  info.num_rows = num_rows;
   info.bytes = hot_bytes + cold_bytes;
   info.hot_bytes = hot_bytes;
   info.cold_bytes = cold_bytes;
   info.compacted_batches = compacted_batches_;
   info.max_table_size = max_table_size_;
   info.min_time = min_time;
+  info.max_time = max_time;
+  info.zone_map_batches = zone_map_batches;
+  info.bloom_filter_batches = bloom_filter_batches;
 
   return info;
 }
@@ -448,6 +589,15 @@ Status Table::CompactSingleBatchUnlocked(arrow::MemoryPool*) {
     hot_store_->RemovePrefix(num_rows_to_remove);
   }
 
+  // Warm-start the next round: if another compacted batch is already ready, reserve its space in
+  // the compactor's builders now. Reservations are deltas over unused builder capacity, so the
+  // next round's Reserve becomes a no-op and each round makes exactly one pre-sized allocation
+  // instead of regrowing builder buffers from scratch.
+  if (batch_size_accountant_->CompactedBatchReady()) {
+    const auto& next_spec = batch_size_accountant_->GetNextCompactedBatchSpec();
+    PL_RETURN_IF_ERROR(compactor_.Reserve(next_spec.num_rows, next_spec.variable_col_bytes));
+  }
+
   {
     absl::base_internal::SpinLockHolder stat_lock(&stats_lock_);
     compacted_batches_++;
@@ -457,12 +607,19 @@ Status Table::CompactSingleBatchUnlocked(arrow::MemoryPool*) {
 }
 
 Status Table::CompactHotToCold(arrow::MemoryPool* mem_pool) {
+  return CompactHotToCold(mem_pool, kMaxBatchesPerCompactionCall);
+}
+
+Status Table::CompactHotToCold(arrow::MemoryPool* mem_pool, int64_t max_batches) {
+  px::profiler::HotPathSpan span("table_store.compact_hot_to_cold");
+  MaybeUpdateCompactedSize();
   bool next_ready = false;
   {
     absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
     next_ready = batch_size_accountant_->CompactedBatchReady();
   }
-  while (next_ready) {
+  int64_t batches_compacted = 0;
+  while (next_ready && batches_compacted < max_batches) {
     absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
     absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
     // We have to check CompactedBatchReady() again, in case hot batches were expired since the last
@@ -471,11 +628,81 @@ Status Table::CompactHotToCold(arrow::MemoryPool* mem_pool) {
       break;
     }
     PL_RETURN_IF_ERROR(CompactSingleBatchUnlocked(mem_pool));
+    batches_compacted++;
     next_ready = batch_size_accountant_->CompactedBatchReady();
   }
   return Status::OK();
 }
 
+void Table::MaybeUpdateCompactedSize() {
+  int64_t window_bytes = 0;
+  double elapsed_seconds = 0;
+  {
+    absl::base_internal::SpinLockHolder lock(&stats_lock_);
+    auto now_ns = CurrentSteadyTimeNS();
+    if (now_ns - window_start_ns_ < kCompactedSizeUpdatePeriodNs) {
+      return;
+    }
+    elapsed_seconds = static_cast<double>(now_ns - window_start_ns_) / 1E9;
+    // Consumer throughput drives the target, but a table that is written far faster than it is
+    // currently read should still seal scan-friendly batches for later queries.
+    window_bytes = std::max(window_bytes_read_, window_bytes_added_);
+    window_bytes_read_ = 0;
+    window_bytes_added_ = 0;
+    window_start_ns_ = now_ns;
+  }
+
+  auto desired_size =
+      static_cast<uint64_t>(window_bytes / elapsed_seconds * kCompactedSizeTargetSeconds);
+  absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
+  batch_size_accountant_->UpdateCompactedSize(desired_size);
+}
+
+bool Table::CompactionNeeded() const {
+  absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
+  return batch_size_accountant_->CompactedBatchReady();
+}
+
+bool Table::ReclaimNeeded() const {
+  int64_t bytes;
+  {
+    absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
+    bytes = batch_size_accountant_->HotBytes() + batch_size_accountant_->ColdBytes();
+  }
+  return bytes > static_cast<int64_t>(kReclaimHighWatermarkRatio * max_table_size_);
+}
+
+Status Table::ReclaimBatches(int64_t max_batches) {
+  // Hysteresis: only start evicting once past the high watermark, then evict down to the low
+  // watermark. This keeps a table that merely hovers between the watermarks from losing data.
+  if (!ReclaimNeeded()) {
+    return Status::OK();
+  }
+  const int64_t target = static_cast<int64_t>(kReclaimLowWatermarkRatio * max_table_size_);
+  for (int64_t i = 0; i < max_batches; ++i) {
+    int64_t bytes;
+    {
+      absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
+      bytes = batch_size_accountant_->HotBytes() + batch_size_accountant_->ColdBytes();
+    }
+    if (bytes <= target) {
+      break;
+    }
+    PL_RETURN_IF_ERROR(ExpireBatch());
+    {
+      absl::base_internal::SpinLockHolder lock(&stats_lock_);
+      batches_expired_++;
+      metrics_.batches_expired_counter.Increment();
+    }
+  }
+  return Status::OK();
+}
+
+void Table::SetStringInternPool(std::shared_ptr<internal::StringInternPool> pool) {
+  absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
+  cold_store_->set_string_intern_pool(std::move(pool));
+}
+
 StatusOr<bool> Table::ExpireCold() {
   absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
   if (cold_store_->Size() == 0) {
@@ -22,6 +22,7 @@
 #include <arrow/array.h>
 #include <arrow/record_batch.h>
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <optional>
@@ -41,9 +42,11 @@
 #include "src/table_store/schema/row_batch.h"
 #include "src/table_store/schema/row_descriptor.h"
 #include "src/table_store/schemapb/schema.pb.h"
+#include "src/table_store/table/internal/arena_memory_pool.h"
 #include "src/table_store/table/internal/arrow_array_compactor.h"
 #include "src/table_store/table/internal/batch_size_accountant.h"
 #include "src/table_store/table/internal/record_or_row_batch.h"
+#include "src/table_store/table/internal/scan_predicate.h"
 #include "src/table_store/table/internal/store_with_row_accounting.h"
 #include "src/table_store/table/internal/types.h"
 #include "src/table_store/table/table_metrics.h"
@@ -60,12 +63,23 @@ struct TableStats {
   int64_t hot_bytes;
   int64_t cold_bytes;
   int64_t num_batches;
+  int64_t num_hot_batches;
+  int64_t num_cold_batches;
+  // Number of rows currently in the table.
+  int64_t num_rows;
   int64_t batches_added;
   int64_t batches_expired;
   int64_t bytes_added;
   int64_t compacted_batches;
   int64_t max_table_size;
+  // Minimum and maximum timestamps currently in the table; -1 if the table has no time_ column
+  // or no data.
   int64_t min_time;
+  int64_t max_time;
+  // Number of batches with zone maps (per-column min/max) respectively bloom filters computed,
+  // i.e. batches that predicate pushdown can prune without scanning. See internal::BatchStats.
+  int64_t zone_map_batches;
+  int64_t bloom_filter_batches;
 };
 
 /**
@@ -113,6 +127,21 @@ class Table : public NotCopyable {
 
   static inline constexpr int64_t kDefaultColdBatchMinSize = 64 * 1024;
 
+  // Parameters of the adaptive compacted batch size target. Every
+  // kCompactedSizeUpdatePeriodNs, the target is steered towards the bytes consumers read from
+  // (or producers wrote to) the table in kCompactedSizeTargetSeconds, so high-throughput tables
+  // compact into large scan-friendly batches while trickle tables seal small batches quickly
+  // instead of holding rows in the hot tier.
+  static inline constexpr int64_t kCompactedSizeUpdatePeriodNs = 5ll * 1000 * 1000 * 1000;
+  static inline constexpr double kCompactedSizeTargetSeconds = 1.0;
+
+  // Watermarks for background expiry (see ReclaimNeeded/ReclaimBatches). The background
+  // reclaimer starts evicting once the table grows past the high watermark and evicts down to
+  // the low watermark. The headroom between the low watermark and the size limit is what keeps
+  // the write path's inline hard-limit expiry from firing under a steady ingest rate.
+  static inline constexpr double kReclaimHighWatermarkRatio = 0.9;
+  static inline constexpr double kReclaimLowWatermarkRatio = 0.8;
+
  public:
   static inline constexpr int64_t kMaxBatchesPerCompactionCall = 256;
   using StopPosition = int64_t;
@@ -171,10 +200,30 @@ class Table : public NotCopyable {
       StopType type = CurrentEndOfTable;
       // Only valid for StopAtTime or StopAtTimeOrEndOfTable types.
       Time stop_time = -1;
+      // Maximum number of rows the cursor will return before it is considered exhausted,
+      // regardless of the StopType. Used to stop scanning early when a downstream limit bounds
+      // how many rows are needed. The final batch is truncated to the limit. 0 means unlimited.
+      int64_t max_rows = 0;
     };
 
+    /**
+     * PredicateSpec is a conjunction of simple column predicates (equality, ranges, string
+     * prefixes) pushed down into the scan. Batches whose per-column min/max statistics prove
+     * that no row can match are skipped without being materialized. Pruning is conservative:
+     * returned batches may still contain non-matching rows, so callers must apply the full
+     * filter downstream.
+     */
+    using ColumnPredicate = internal::ColumnPredicate;
+    using PredicateSpec = internal::ScanPredicate;
+
     explicit Cursor(const Table* table) : Cursor(table, StartSpec{}, StopSpec{}) {}
     Cursor(const Table* table, StartSpec start, StopSpec stop);
+    Cursor(const Table* table, StartSpec start, StopSpec stop, PredicateSpec predicate);
+    // `cols` is the set of column indices this cursor projects. Only these columns are ever
+    // converted, decoded or copied when reading batches through the cursor. An empty vector
+    // selects all columns of the table.
+    Cursor(const Table* table, StartSpec start, StopSpec stop, PredicateSpec predicate,
+           std::vector<int64_t> cols);
 
     // In the case of StopType == Infinite or StopType == StopAtTime, this returns whether the table
     // has the next batch ready. In the case of StopType == CurrentEndOfTable, this returns !Done().
@@ -183,21 +232,46 @@ class Table : public NotCopyable {
     // `NextBatchReady()` and `GetNextRowBatch(...)`, and then the row batch after the expired one
     // is past the stopping condition. In this case `GetNextRowBatch(...)` will return an error.
     bool NextBatchReady();
+    // Returns the next row batch containing only the cursor's projected columns.
+    StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch();
     StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(const std::vector<int64_t>& cols);
     // In the case of StopType == Infinite, this function always returns false.
     bool Done();
     // Change the StopSpec of the cursor.
     void UpdateStopSpec(StopSpec stop);
 
+    /**
+     * Split partitions this cursor's remaining row range into up to `num_partitions` contiguous
+     * sub-ranges, returned as independent cursors. Each returned cursor carries its own
+     * position, hints and a copy of the predicate, so the partitions can be iterated from
+     * different threads concurrently; the table's internal spinlocks are only held briefly per
+     * batch, so partitions don't serialize against each other. Every remaining row of this
+     * cursor is covered by exactly one partition, and this cursor is consumed (Done() becomes
+     * true). Fewer than `num_partitions` cursors are returned when there are fewer rows than
+     * partitions.
+     *
+     * Requires a bounded cursor: splitting an Infinite cursor, or a StopAtTime cursor whose
+     * stop time is not yet within the table, returns an error. As with any cursor, if a
+     * partition's rows are expired before they are read, that partition falls back to the
+     * current start of the table (capped at its stop row).
+     */
+    StatusOr<std::vector<Cursor>> Split(size_t num_partitions);
+
    private:
+    // Constructs a cursor over the fixed row range [first_row_id, stop_row_id). Used by Split.
+    Cursor(const Table* table, RowID first_row_id, RowID stop_row_id, PredicateSpec predicate);
     void AdvanceToStart(const StartSpec& start);
     void StopStateFromSpec(StopSpec&& stop);
     void UpdateStopStateForStopAtTime();
+    // Truncates the given batch to the cursor's remaining row budget, if a row limit is set.
+    StatusOr<std::unique_ptr<schema::RowBatch>> ApplyRowLimit(
+        std::unique_ptr<schema::RowBatch> rb);
 
     // The following methods are made private so that they are only accessible from Table.
     internal::RowID* LastReadRowID();
     internal::BatchHints* Hints();
     std::optional<internal::RowID> StopRowID() const;
+    const internal::ScanPredicate* Predicate() const;
 
     struct StopState {
       StopSpec spec;
@@ -209,7 +283,13 @@ class Table : public NotCopyable {
     const Table* table_;
     internal::BatchHints hints_;
     RowID last_read_row_id_;
+    // Number of rows returned so far; only tracked when StopSpec.max_rows is set.
+    int64_t rows_returned_ = 0;
     StopState stop_;
+    PredicateSpec predicate_;
+    // Column indices projected by this cursor. Filled with all of the table's columns when no
+    // explicit projection is given.
+    std::vector<int64_t> cols_;
 
     friend class Table;
   };
@@ -301,17 +381,73 @@ class Table : public NotCopyable {
    */
   Status CompactHotToCold(arrow::MemoryPool* mem_pool);
 
+  /**
+   * Same as above but creates a maximum of `max_batches` cold batches, for callers that need
+   * to bound the work done in a single call (eg. incremental background compaction).
+   * @param mem_pool arrow MemoryPool to be used for creating new cold batches.
+   * @param max_batches maximum number of cold batches to create in this call.
+   */
+  Status CompactHotToCold(arrow::MemoryPool* mem_pool, int64_t max_batches);
+
+  /**
+   * CompactionNeeded returns whether there is enough data in the hot store to create at least
+   * one cold batch.
+   */
+  bool CompactionNeeded() const;
+
+  /**
+   * ReclaimNeeded returns whether the table has grown past its high watermark, meaning the
+   * background reclaimer should evict batches to restore headroom below the size limit.
+   */
+  bool ReclaimNeeded() const;
+
+  /**
+   * Evicts the oldest batches until the table is below its low watermark. At most `max_batches`
+   * batches are evicted per call, for callers that need to bound the work done in a single call
+   * (eg. the background reclaimer); use ReclaimNeeded to check whether another call is required.
+   * Keeping the table below the low watermark leaves enough headroom for writes to land without
+   * expiring batches inline, which would otherwise add latency spikes to the write path once
+   * the table reaches its size limit.
+   */
+  Status ReclaimBatches(int64_t max_batches);
+
+  /**
+   * Updates the table's maximum size in bytes. Shrinking does not evict data immediately: the
+   * background reclaimer (or the inline hard limit on the next write) brings the table under the
+   * new limit. Used to re-balance per-table budgets at runtime based on observed write rates.
+   */
+  void SetMaxTableSize(int64_t max_table_size) { max_table_size_ = max_table_size; }
+
+  /**
+   * SetStringInternPool sets the pool used to share cold batch string dictionaries across
+   * tables. Called by TableStore when the table is added, so that all of a table store's tables
+   * intern into the same pool.
+   */
+  void SetStringInternPool(std::shared_ptr<internal::StringInternPool> pool);
+
  private:
   TableMetrics metrics_;
 
   schema::Relation rel_;
 
+  // Per-table arena that the table's own arrow allocations (hot column caches, compacted cold
+  // batches, decoded column slices) are served from, keeping each table's data contiguous and
+  // freeing slabs wholesale as batches expire. Declared before the stores and compactor so it
+  // outlives the buffers allocated from it.
+  internal::ArenaMemoryPool arena_pool_;
+
   mutable absl::base_internal::SpinLock stats_lock_;
   int64_t batches_expired_ ABSL_GUARDED_BY(stats_lock_) = 0;
   int64_t batches_added_ ABSL_GUARDED_BY(stats_lock_) = 0;
   int64_t bytes_added_ ABSL_GUARDED_BY(stats_lock_) = 0;
   int64_t compacted_batches_ ABSL_GUARDED_BY(stats_lock_) = 0;
-  int64_t max_table_size_ = 0;
+  // Throughput window for the adaptive compacted batch size target. `window_bytes_read_` is
+  // mutable since cursor reads happen on the const GetNextRowBatch path.
+  mutable int64_t window_bytes_read_ ABSL_GUARDED_BY(stats_lock_) = 0;
+  int64_t window_bytes_added_ ABSL_GUARDED_BY(stats_lock_) = 0;
+  int64_t window_start_ns_ ABSL_GUARDED_BY(stats_lock_) = CurrentSteadyTimeNS();
+  // Atomic so the size limit can be re-balanced at runtime while writers read it locklessly.
+  std::atomic<int64_t> max_table_size_ = 0;
   const int64_t compacted_batch_size_;
   mutable absl::base_internal::SpinLock hot_lock_;
   std::unique_ptr<internal::StoreWithRowTimeAccounting<internal::StoreType::Hot>> hot_store_
@@ -335,6 +471,10 @@ class Table : public NotCopyable {
   Status ExpireRowBatches(int64_t row_batch_size);
   Status CompactSingleBatchUnlocked(arrow::MemoryPool* mem_pool)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(cold_lock_) ABSL_EXCLUSIVE_LOCKS_REQUIRED(hot_lock_);
+  // Steers the accountant's compacted batch size target using the table's read/write
+  // throughput over the last window. Called from CompactHotToCold; a no-op until
+  // kCompactedSizeUpdatePeriodNs has elapsed since the last update.
+  void MaybeUpdateCompactedSize();
   Status UpdateTableMetricGauges();
 
   Time MaxTime() const;
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "src/common/zlib/zstd_wrapper.h"
+#include "src/table_store/schemapb/schema.pb.h"
+#include "src/table_store/table/table_export.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+void AppendU64(uint64_t val, std::string* out) {
+  out->append(reinterpret_cast<const char*>(&val), sizeof(val));
+}
+
+}  // namespace
+
+TableExporter::TableExporter(const Table* table, Options options)
+    : table_(table),
+      options_(std::move(options)),
+      cursor_(table_, options_.start, options_.stop) {}
+
+Status TableExporter::AppendFrame(uint64_t flags, std::string_view payload, std::string* out) {
+  std::string compressed;
+  if (options_.compress) {
+    PL_ASSIGN_OR_RETURN(compressed, zstd::Compress(payload, options_.compression_level));
+    payload = compressed;
+    flags |= kFlagCompressed;
+  }
+  AppendU64(kMagic, out);
+  AppendU64(flags, out);
+  AppendU64(payload.size(), out);
+  out->append(payload);
+  return Status::OK();
+}
+
+StatusOr<bool> TableExporter::NextFrame(std::string* out) {
+  if (!schema_sent_) {
+    schemapb::Relation rel_pb;
+    PL_RETURN_IF_ERROR(table_->GetRelation().ToProto(&rel_pb));
+    payload_scratch_.clear();
+    if (!rel_pb.AppendToString(&payload_scratch_)) {
+      return error::Internal("Failed to serialize relation for table export");
+    }
+    PL_RETURN_IF_ERROR(AppendFrame(kFlagSchema, payload_scratch_, out));
+    schema_sent_ = true;
+    return true;
+  }
+
+  schemapb::ArrowRowBatchData batch_pb;
+  while (!cursor_.Done()) {
+    PL_ASSIGN_OR_RETURN(auto rb, cursor_.GetNextRowBatch());
+    if (rb->num_rows() == 0) {
+      continue;
+    }
+    batch_pb.Clear();
+    PL_RETURN_IF_ERROR(rb->ToArrowBuffersProto(&batch_pb));
+
+    payload_scratch_.clear();
+    AppendU64(rb->num_rows(), &payload_scratch_);
+    AppendU64(batch_pb.cols_size(), &payload_scratch_);
+    for (const auto& col : batch_pb.cols()) {
+      AppendU64(col.data().size(), &payload_scratch_);
+      AppendU64(col.offsets().size(), &payload_scratch_);
+      AppendU64(col.null_bitmap().size(), &payload_scratch_);
+      payload_scratch_.append(col.data());
+      payload_scratch_.append(col.offsets());
+      payload_scratch_.append(col.null_bitmap());
+    }
+    PL_RETURN_IF_ERROR(AppendFrame(/*flags*/ 0, payload_scratch_, out));
+    return true;
+  }
+  return false;
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+
+#include "src/common/base/base.h"
+#include "src/table_store/table/table.h"
+
+namespace px {
+namespace table_store {
+
+/**
+ * TableExporter streams a table's contents as framed Arrow column buffers for bulk export,
+ * bypassing the per-value RowBatchData proto encoding of the query result path. Each call to
+ * NextFrame appends one self-contained frame to the caller's buffer; the caller forwards the
+ * frames over whatever transport serves the export (a streaming RPC, a file, ...).
+ *
+ * Frame layout (all integers are 64-bit, native endianness):
+ *   magic, flags, payload_len, then payload_len bytes of payload.
+ * Flags bit 0 marks a zstd-compressed payload (the layout below describes it decompressed);
+ * bit 1 marks the schema frame, whose payload is a serialized schemapb::Relation. The first
+ * frame of a stream is always the schema frame, so the stream is self-describing.
+ * A data frame's payload is:
+ *   num_rows, num_cols
+ *   per column: data_len, offsets_len, null_bitmap_len, then the three buffers back to back.
+ * The buffer contents are exactly what RowBatch::ToArrowBuffersProto produces (fixed-width
+ * Arrow value buffers, rebased STRING offsets, optional validity bitmap), so a reader can
+ * reconstruct batches with RowBatch::FromArrowColumnBuffers without copying.
+ *
+ * Frames are host-specific (native endianness and Arrow buffer layout), matching the table
+ * store snapshot format; consumers on the other end of the export are expected to run on the
+ * same architecture family as the node.
+ */
+class TableExporter : public NotCopyable {
+ public:
+  struct Options {
+    // What slice of the table to export; defaults cover everything currently in the table.
+    Table::Cursor::StartSpec start;
+    Table::Cursor::StopSpec stop;
+    // When set, each frame's payload is zstd-compressed.
+    bool compress = false;
+    int compression_level = 1;
+  };
+
+  TableExporter(const Table* table, Options options);
+
+  /**
+   * Appends the next frame to `out`. Returns false (appending nothing) once the table slice
+   * has been fully exported.
+   */
+  StatusOr<bool> NextFrame(std::string* out);
+
+  static inline constexpr uint64_t kMagic = 0x3154525058455850ULL;  // "PXEXPRT1".
+  static inline constexpr uint64_t kFlagCompressed = 1 << 0;
+  static inline constexpr uint64_t kFlagSchema = 1 << 1;
+
+ private:
+  // Wraps `payload` in a frame header (compressing it first when configured) and appends the
+  // result to `out`.
+  Status AppendFrame(uint64_t flags, std::string_view payload, std::string* out);
+
+  const Table* table_;
+  Options options_;
+  Table::Cursor cursor_;
+  bool schema_sent_ = false;
+  // Reused per-frame scratch, so steady-state export does no per-batch allocations beyond
+  // what the cursor itself performs.
+  std::string payload_scratch_;
+};
+
+}  // namespace table_store
+}  // namespace px
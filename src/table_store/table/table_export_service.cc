@@ -0,0 +1,87 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+#include <utility>
+
+#include "src/table_store/table/table_export.h"
+#include "src/table_store/table/table_export_service.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+// Frames are accumulated until a response reaches this size, so small row batches don't each
+// pay the per-message overhead of the stream.
+constexpr size_t kTargetResponseBytes = 1024 * 1024;
+
+}  // namespace
+
+::grpc::Status TableExportService::ExportTable(
+    ::grpc::ServerContext* context, const exportpb::ExportTableRequest* req,
+    ::grpc::ServerWriter<exportpb::ExportTableResponse>* writer) {
+  Table* table = table_store_->GetTable(req->table_name());
+  if (table == nullptr) {
+    return ::grpc::Status(::grpc::StatusCode::NOT_FOUND,
+                          absl::Substitute("Table '$0' not found", req->table_name()));
+  }
+
+  TableExporter::Options options;
+  if (req->start_time() != 0) {
+    options.start.type = Table::Cursor::StartSpec::StartAtTime;
+    options.start.start_time = req->start_time();
+  }
+  if (req->stop_time() != 0) {
+    options.stop.type = Table::Cursor::StopSpec::StopAtTimeOrEndOfTable;
+    options.stop.stop_time = req->stop_time();
+  }
+  options.compress = req->compress();
+  if (req->compression_level() != 0) {
+    options.compression_level = req->compression_level();
+  }
+  TableExporter exporter(table, std::move(options));
+
+  std::string buffer;
+  bool more = true;
+  while (more) {
+    if (context->IsCancelled()) {
+      return ::grpc::Status(::grpc::StatusCode::CANCELLED, "Export cancelled by client");
+    }
+    buffer.clear();
+    while (more && buffer.size() < kTargetResponseBytes) {
+      auto more_or_s = exporter.NextFrame(&buffer);
+      if (!more_or_s.ok()) {
+        return ::grpc::Status(::grpc::StatusCode::INTERNAL, more_or_s.msg());
+      }
+      more = more_or_s.ConsumeValueOrDie();
+    }
+    if (buffer.empty()) {
+      break;
+    }
+    exportpb::ExportTableResponse resp;
+    resp.set_frame_data(std::move(buffer));
+    if (!writer->Write(resp)) {
+      return ::grpc::Status(::grpc::StatusCode::CANCELLED, "Export stream closed by client");
+    }
+  }
+  return ::grpc::Status::OK;
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+
+#include "src/common/base/base.h"
+#include "src/table_store/exportpb/export.grpc.pb.h"
+#include "src/table_store/exportpb/export.pb.h"
+#include "src/table_store/table/table_store.h"
+
+namespace px {
+namespace table_store {
+
+/**
+ * TableExportService serves bulk table exports over gRPC by streaming TableExporter frames.
+ * It holds no per-stream state of its own, so one instance can be registered on an existing
+ * grpc::Server (the agent registers it on Carnot's result sink server) and serve concurrent
+ * exports; table cursors tolerate concurrent writes to the table.
+ */
+class TableExportService final : public exportpb::TableExportService::Service {
+ public:
+  explicit TableExportService(TableStore* table_store) : table_store_(table_store) {}
+
+  ::grpc::Status ExportTable(::grpc::ServerContext* context,
+                             const exportpb::ExportTableRequest* req,
+                             ::grpc::ServerWriter<exportpb::ExportTableResponse>* writer) override;
+
+ private:
+  TableStore* table_store_;
+};
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/schema/relation.h"
+#include "src/table_store/schemapb/schema.pb.h"
+#include "src/table_store/table/table_export.h"
+#include "src/table_store/table/table_export_service.h"
+
+namespace px {
+namespace table_store {
+
+using ::grpc::InsecureServerCredentials;
+using ::grpc::ServerBuilder;
+
+class TableExportServiceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema::Relation rel({types::DataType::INT64, types::DataType::STRING}, {"col1", "col2"});
+    auto table = Table::Create("test_table", rel);
+
+    auto rb = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 3);
+    std::vector<types::Int64Value> col1 = {1, 2, 3};
+    std::vector<types::StringValue> col2 = {"hello", "abc", "defg"};
+    PL_CHECK_OK(rb.AddColumn(types::ToArrow(col1, arrow::default_memory_pool())));
+    PL_CHECK_OK(rb.AddColumn(types::ToArrow(col2, arrow::default_memory_pool())));
+    PL_CHECK_OK(table->WriteRowBatch(rb));
+
+    table_store_ = std::make_unique<TableStore>();
+    table_store_->AddTable(table, "test_table");
+    service_ = std::make_unique<TableExportService>(table_store_.get());
+
+    ServerBuilder builder;
+    builder.AddListeningPort("localhost:0", InsecureServerCredentials());
+    builder.RegisterService(service_.get());
+    server_ = builder.BuildAndStart();
+    grpc::ChannelArguments args;
+    stub_ = exportpb::TableExportService::NewStub(server_->InProcessChannel(args));
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  // Runs an ExportTable call to completion, concatenating all streamed frame data.
+  ::grpc::Status Export(const exportpb::ExportTableRequest& req, std::string* stream_out) {
+    ::grpc::ClientContext ctx;
+    auto reader = stub_->ExportTable(&ctx, req);
+    exportpb::ExportTableResponse resp;
+    while (reader->Read(&resp)) {
+      stream_out->append(resp.frame_data());
+    }
+    return reader->Finish();
+  }
+
+  std::unique_ptr<TableStore> table_store_;
+  std::unique_ptr<TableExportService> service_;
+  std::unique_ptr<::grpc::Server> server_;
+  std::unique_ptr<exportpb::TableExportService::Stub> stub_;
+};
+
+TEST_F(TableExportServiceTest, exports_schema_and_data_frames) {
+  exportpb::ExportTableRequest req;
+  req.set_table_name("test_table");
+
+  std::string stream;
+  auto s = Export(req, &stream);
+  ASSERT_TRUE(s.ok()) << s.error_message();
+
+  // The stream starts with a schema frame carrying the table's relation.
+  ASSERT_GE(stream.size(), 3 * sizeof(uint64_t));
+  uint64_t magic, flags, payload_len;
+  std::memcpy(&magic, stream.data(), sizeof(magic));
+  std::memcpy(&flags, stream.data() + sizeof(uint64_t), sizeof(flags));
+  std::memcpy(&payload_len, stream.data() + 2 * sizeof(uint64_t), sizeof(payload_len));
+  EXPECT_EQ(TableExporter::kMagic, magic);
+  EXPECT_TRUE(flags & TableExporter::kFlagSchema);
+
+  schemapb::Relation rel_pb;
+  ASSERT_TRUE(rel_pb.ParseFromString(stream.substr(3 * sizeof(uint64_t), payload_len)));
+  schema::Relation relation;
+  ASSERT_OK(relation.FromProto(&rel_pb));
+  EXPECT_TRUE(table_store_->GetTable("test_table")->GetRelation() == relation);
+
+  // A data frame follows the schema frame.
+  EXPECT_GT(stream.size(), 3 * sizeof(uint64_t) + payload_len);
+}
+
+TEST_F(TableExportServiceTest, unknown_table_returns_not_found) {
+  exportpb::ExportTableRequest req;
+  req.set_table_name("no_such_table");
+
+  std::string stream;
+  auto s = Export(req, &stream);
+  EXPECT_EQ(::grpc::StatusCode::NOT_FOUND, s.error_code());
+  EXPECT_TRUE(stream.empty());
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/common/zlib/zstd_wrapper.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/schema/relation.h"
+#include "src/table_store/schemapb/schema.pb.h"
+#include "src/table_store/table/table_export.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+std::shared_ptr<Table> TestTable() {
+  schema::Relation rel({types::DataType::INT64, types::DataType::STRING}, {"col1", "col2"});
+  auto table = Table::Create("test_table", rel);
+
+  auto rb1 = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 3);
+  std::vector<types::Int64Value> col1_in1 = {1, 2, 3};
+  std::vector<types::StringValue> col2_in1 = {"hello", "abc", "defg"};
+  PL_CHECK_OK(rb1.AddColumn(types::ToArrow(col1_in1, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb1.AddColumn(types::ToArrow(col2_in1, arrow::default_memory_pool())));
+  PL_CHECK_OK(table->WriteRowBatch(rb1));
+
+  auto rb2 = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 2);
+  std::vector<types::Int64Value> col1_in2 = {5, 6};
+  std::vector<types::StringValue> col2_in2 = {"a", "bc"};
+  PL_CHECK_OK(rb2.AddColumn(types::ToArrow(col1_in2, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb2.AddColumn(types::ToArrow(col2_in2, arrow::default_memory_pool())));
+  PL_CHECK_OK(table->WriteRowBatch(rb2));
+
+  return table;
+}
+
+// Minimal reader for the export frame format; mirrors the layout documented in table_export.h.
+struct Frame {
+  uint64_t flags;
+  std::string payload;
+};
+
+std::vector<Frame> ParseFrames(const std::string& stream) {
+  std::vector<Frame> frames;
+  size_t off = 0;
+  auto read_u64 = [&](uint64_t* val) {
+    CHECK_LE(off + sizeof(*val), stream.size());
+    std::memcpy(val, stream.data() + off, sizeof(*val));
+    off += sizeof(*val);
+  };
+  while (off < stream.size()) {
+    uint64_t magic, flags, payload_len;
+    read_u64(&magic);
+    CHECK_EQ(magic, TableExporter::kMagic);
+    read_u64(&flags);
+    read_u64(&payload_len);
+    CHECK_LE(off + payload_len, stream.size());
+    std::string payload = stream.substr(off, payload_len);
+    off += payload_len;
+    if (flags & TableExporter::kFlagCompressed) {
+      payload = zstd::Decompress(payload).ConsumeValueOrDie();
+    }
+    frames.push_back(Frame{flags, std::move(payload)});
+  }
+  return frames;
+}
+
+// Reconstructs a RowBatch from a data frame payload.
+std::unique_ptr<schema::RowBatch> BatchFromPayload(const std::vector<types::DataType>& col_types,
+                                                   const std::string& payload) {
+  auto owner = std::make_shared<std::string>(payload);
+  size_t off = 0;
+  auto read_u64 = [&]() {
+    uint64_t val;
+    CHECK_LE(off + sizeof(val), owner->size());
+    std::memcpy(&val, owner->data() + off, sizeof(val));
+    off += sizeof(val);
+    return val;
+  };
+  auto read_bytes = [&](uint64_t len) {
+    CHECK_LE(off + len, owner->size());
+    std::string_view bytes(owner->data() + off, len);
+    off += len;
+    return bytes;
+  };
+  const uint64_t num_rows = read_u64();
+  const uint64_t num_cols = read_u64();
+  CHECK_EQ(num_cols, col_types.size());
+  std::vector<schema::RowBatch::ArrowColumnBuffers> cols(num_cols);
+  for (uint64_t c = 0; c < num_cols; ++c) {
+    const uint64_t data_len = read_u64();
+    const uint64_t offsets_len = read_u64();
+    const uint64_t null_len = read_u64();
+    cols[c].data = read_bytes(data_len);
+    cols[c].offsets = read_bytes(offsets_len);
+    cols[c].null_bitmap = read_bytes(null_len);
+  }
+  return schema::RowBatch::FromArrowColumnBuffers(col_types, num_rows, cols, owner)
+      .ConsumeValueOrDie();
+}
+
+void VerifyExportedStream(const std::shared_ptr<Table>& table, const std::string& stream) {
+  auto frames = ParseFrames(stream);
+  ASSERT_EQ(3, frames.size());
+
+  // The first frame carries the schema.
+  ASSERT_TRUE(frames[0].flags & TableExporter::kFlagSchema);
+  schemapb::Relation rel_pb;
+  ASSERT_TRUE(rel_pb.ParseFromString(frames[0].payload));
+  schema::Relation relation;
+  ASSERT_OK(relation.FromProto(&rel_pb));
+  EXPECT_TRUE(table->GetRelation() == relation);
+
+  auto rb1 = BatchFromPayload(relation.col_types(), frames[1].payload);
+  std::vector<types::Int64Value> col1_in1 = {1, 2, 3};
+  std::vector<types::StringValue> col2_in1 = {"hello", "abc", "defg"};
+  EXPECT_TRUE(rb1->ColumnAt(0)->Equals(types::ToArrow(col1_in1, arrow::default_memory_pool())));
+  EXPECT_TRUE(rb1->ColumnAt(1)->Equals(types::ToArrow(col2_in1, arrow::default_memory_pool())));
+
+  auto rb2 = BatchFromPayload(relation.col_types(), frames[2].payload);
+  std::vector<types::Int64Value> col1_in2 = {5, 6};
+  std::vector<types::StringValue> col2_in2 = {"a", "bc"};
+  EXPECT_TRUE(rb2->ColumnAt(0)->Equals(types::ToArrow(col1_in2, arrow::default_memory_pool())));
+  EXPECT_TRUE(rb2->ColumnAt(1)->Equals(types::ToArrow(col2_in2, arrow::default_memory_pool())));
+}
+
+}  // namespace
+
+TEST(TableExportTest, round_trip) {
+  auto table = TestTable();
+  TableExporter exporter(table.get(), TableExporter::Options{});
+
+  std::string stream;
+  while (exporter.NextFrame(&stream).ConsumeValueOrDie()) {
+  }
+  VerifyExportedStream(table, stream);
+}
+
+TEST(TableExportTest, round_trip_compressed) {
+  auto table = TestTable();
+  TableExporter::Options options;
+  options.compress = true;
+  TableExporter exporter(table.get(), options);
+
+  std::string stream;
+  while (exporter.NextFrame(&stream).ConsumeValueOrDie()) {
+  }
+  VerifyExportedStream(table, stream);
+}
+
+TEST(TableExportTest, empty_table_emits_only_schema) {
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+  auto table = Table::Create("empty_table", rel);
+  TableExporter exporter(table.get(), TableExporter::Options{});
+
+  std::string stream;
+  EXPECT_TRUE(exporter.NextFrame(&stream).ConsumeValueOrDie());
+  EXPECT_FALSE(exporter.NextFrame(&stream).ConsumeValueOrDie());
+  auto frames = ParseFrames(stream);
+  ASSERT_EQ(1, frames.size());
+  EXPECT_TRUE(frames[0].flags & TableExporter::kFlagSchema);
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,366 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/table_store/table/table_rollup.h"
+
+#include <utility>
+
+#include <absl/container/flat_hash_set.h>
+
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+constexpr char kTimeColName[] = "time_";
+
+bool IsGroupableType(types::DataType type) {
+  return type == types::DataType::INT64 || type == types::DataType::STRING;
+}
+
+bool IsAggregableType(types::DataType type) {
+  return type == types::DataType::INT64 || type == types::DataType::FLOAT64;
+}
+
+}  // namespace
+
+StatusOr<schema::Relation> TableRollup::OutputRelation(const RollupSpec& spec,
+                                                       const schema::Relation& src_relation) {
+  if (spec.bucket_width_ns <= 0) {
+    return error::InvalidArgument("Rollup bucket width must be positive, got $0.",
+                                  spec.bucket_width_ns);
+  }
+  if (!src_relation.HasColumn(kTimeColName) ||
+      src_relation.GetColumnType(kTimeColName) != types::DataType::TIME64NS) {
+    return error::InvalidArgument(
+        "Rollup source table '$0' must have a TIME64NS '$1' column.", spec.src_table_name,
+        kTimeColName);
+  }
+  if (spec.aggs.empty()) {
+    return error::InvalidArgument("Rollup on table '$0' must specify at least one aggregate.",
+                                  spec.src_table_name);
+  }
+
+  schema::Relation out;
+  out.AddColumn(types::DataType::TIME64NS, kTimeColName);
+  absl::flat_hash_set<std::string> used_names{kTimeColName};
+
+  for (const auto& group_col : spec.group_cols) {
+    if (!src_relation.HasColumn(group_col)) {
+      return error::InvalidArgument("Rollup group column '$0' does not exist in table '$1'.",
+                                    group_col, spec.src_table_name);
+    }
+    auto type = src_relation.GetColumnType(group_col);
+    if (!IsGroupableType(type)) {
+      return error::InvalidArgument(
+          "Rollup group column '$0' must be INT64 or STRING, got $1.", group_col,
+          types::ToString(type));
+    }
+    if (!used_names.insert(group_col).second) {
+      return error::InvalidArgument("Rollup group column '$0' specified twice.", group_col);
+    }
+    out.AddColumn(type, group_col);
+  }
+
+  for (const auto& agg : spec.aggs) {
+    if (agg.output_col.empty()) {
+      return error::InvalidArgument("Rollup aggregates on table '$0' must name an output column.",
+                                    spec.src_table_name);
+    }
+    if (!used_names.insert(agg.output_col).second) {
+      return error::InvalidArgument("Rollup output column '$0' specified twice.", agg.output_col);
+    }
+    if (agg.kind == RollupSpec::AggKind::kCount) {
+      out.AddColumn(types::DataType::INT64, agg.output_col);
+      continue;
+    }
+    if (!src_relation.HasColumn(agg.src_col)) {
+      return error::InvalidArgument("Rollup aggregate column '$0' does not exist in table '$1'.",
+                                    agg.src_col, spec.src_table_name);
+    }
+    auto type = src_relation.GetColumnType(agg.src_col);
+    if (!IsAggregableType(type)) {
+      return error::InvalidArgument(
+          "Rollup aggregate column '$0' must be INT64 or FLOAT64, got $1.", agg.src_col,
+          types::ToString(type));
+    }
+    out.AddColumn(agg.kind == RollupSpec::AggKind::kMean ? types::DataType::FLOAT64 : type,
+                  agg.output_col);
+  }
+  return out;
+}
+
+StatusOr<std::unique_ptr<TableRollup>> TableRollup::Create(const RollupSpec& spec,
+                                                           std::shared_ptr<Table> src_table,
+                                                           std::shared_ptr<Table> rollup_table) {
+  PL_ASSIGN_OR_RETURN(auto output_relation, OutputRelation(spec, src_table->GetRelation()));
+  if (!(rollup_table->GetRelation() == output_relation)) {
+    return error::InvalidArgument(
+        "Rollup table '$0' does not have the relation derived from the rollup spec.",
+        spec.rollup_table_name);
+  }
+  // Create through a naked pointer since std::make_unique cannot access the private ctor.
+  return std::unique_ptr<TableRollup>(new TableRollup(spec, std::move(src_table),
+                                                      std::move(rollup_table),
+                                                      std::move(output_relation)));
+}
+
+TableRollup::TableRollup(RollupSpec spec, std::shared_ptr<Table> src_table,
+                         std::shared_ptr<Table> rollup_table, schema::Relation output_relation)
+    : spec_(std::move(spec)),
+      src_table_(std::move(src_table)),
+      rollup_table_(std::move(rollup_table)),
+      output_relation_(std::move(output_relation)) {
+  const auto src_relation = src_table_->GetRelation();
+
+  // The cursor only materializes the columns the rollup reads, so build the projection and
+  // record each column's slot within the projected batch.
+  std::vector<int64_t> projection;
+  absl::flat_hash_map<int64_t, int64_t> col_to_slot;
+  auto slot_for = [&](int64_t col_idx) {
+    auto [it, inserted] = col_to_slot.try_emplace(col_idx, projection.size());
+    if (inserted) {
+      projection.push_back(col_idx);
+    }
+    return it->second;
+  };
+
+  time_slot_ = slot_for(src_relation.GetColumnIndex(kTimeColName));
+  for (const auto& group_col : spec_.group_cols) {
+    auto col_idx = src_relation.GetColumnIndex(group_col);
+    group_slots_.push_back(slot_for(col_idx));
+    group_types_.push_back(src_relation.GetColumnType(col_idx));
+  }
+  for (const auto& agg : spec_.aggs) {
+    if (agg.kind == RollupSpec::AggKind::kCount) {
+      agg_slots_.push_back(-1);
+      agg_types_.push_back(types::DATA_TYPE_UNKNOWN);
+      continue;
+    }
+    auto col_idx = src_relation.GetColumnIndex(agg.src_col);
+    agg_slots_.push_back(slot_for(col_idx));
+    agg_types_.push_back(src_relation.GetColumnType(col_idx));
+  }
+
+  Table::Cursor::StopSpec stop;
+  stop.type = Table::Cursor::StopSpec::Infinite;
+  cursor_ = std::make_unique<Table::Cursor>(src_table_.get(), Table::Cursor::StartSpec{}, stop,
+                                            Table::Cursor::PredicateSpec{}, std::move(projection));
+}
+
+bool TableRollup::HasWork() {
+  std::lock_guard<std::mutex> lock(lock_);
+  return cursor_->NextBatchReady();
+}
+
+StatusOr<bool> TableRollup::ProcessBatches(int64_t max_batches) {
+  std::lock_guard<std::mutex> lock(lock_);
+  int64_t processed = 0;
+  while (processed < max_batches && cursor_->NextBatchReady()) {
+    PL_ASSIGN_OR_RETURN(auto rb, cursor_->GetNextRowBatch());
+    ConsumeBatch(*rb);
+    ++processed;
+  }
+  if (processed > 0) {
+    PL_RETURN_IF_ERROR(FlushCompletedBuckets());
+  }
+  return cursor_->NextBatchReady();
+}
+
+void TableRollup::ConsumeBatch(const schema::RowBatch& rb) {
+  const auto* time_arr = rb.ColumnAt(time_slot_).get();
+  for (int64_t row = 0; row < rb.num_rows(); ++row) {
+    auto time = types::GetValueFromArrowArray<types::DataType::TIME64NS>(time_arr, row);
+    if (time > max_time_seen_) {
+      max_time_seen_ = time;
+    }
+    auto bucket_start = time - (time % spec_.bucket_width_ns);
+    if (bucket_start < flush_watermark_) {
+      // The bucket this row belongs to was already flushed; folding the row in now would
+      // require emitting an out-of-order row into the rollup table.
+      ++late_rows_dropped_;
+      continue;
+    }
+    auto& bucket = buckets_[bucket_start];
+
+    std::string key;
+    for (size_t g = 0; g < group_slots_.size(); ++g) {
+      const auto* arr = rb.ColumnAt(group_slots_[g]).get();
+      if (group_types_[g] == types::DataType::INT64) {
+        auto val = types::GetValueFromArrowArray<types::DataType::INT64>(arr, row);
+        key.append(reinterpret_cast<const char*>(&val), sizeof(val));
+      } else {
+        auto val = types::GetStringViewFromArrowArray(arr, row);
+        uint32_t size = val.size();
+        key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        key.append(val.data(), val.size());
+      }
+    }
+
+    auto [it, inserted] = bucket.try_emplace(std::move(key));
+    auto& group = it->second;
+    if (inserted) {
+      group.aggs.resize(spec_.aggs.size());
+      group.group_vals.resize(group_slots_.size());
+      for (size_t g = 0; g < group_slots_.size(); ++g) {
+        const auto* arr = rb.ColumnAt(group_slots_[g]).get();
+        if (group_types_[g] == types::DataType::INT64) {
+          group.group_vals[g].int_val =
+              types::GetValueFromArrowArray<types::DataType::INT64>(arr, row);
+        } else {
+          group.group_vals[g].str_val =
+              std::string(types::GetStringViewFromArrowArray(arr, row));
+        }
+      }
+    }
+
+    for (size_t a = 0; a < spec_.aggs.size(); ++a) {
+      auto& state = group.aggs[a];
+      ++state.count;
+      if (spec_.aggs[a].kind == RollupSpec::AggKind::kCount) {
+        continue;
+      }
+      const auto* arr = rb.ColumnAt(agg_slots_[a]).get();
+      if (agg_types_[a] == types::DataType::INT64) {
+        auto val = types::GetValueFromArrowArray<types::DataType::INT64>(arr, row);
+        state.sum_int += val;
+        state.min_int = std::min(state.min_int, val);
+        state.max_int = std::max(state.max_int, val);
+      } else {
+        auto val = types::GetValueFromArrowArray<types::DataType::FLOAT64>(arr, row);
+        state.sum_float += val;
+        state.min_float = std::min(state.min_float, val);
+        state.max_float = std::max(state.max_float, val);
+      }
+    }
+  }
+}
+
+Status TableRollup::FlushCompletedBuckets() {
+  if (max_time_seen_ == std::numeric_limits<int64_t>::min()) {
+    return Status::OK();
+  }
+  // Every bucket ending at or before the high-water timestamp is complete. The watermark
+  // advances even past buckets that received no rows, so a late row can never re-open a time
+  // range the rollup table has moved beyond.
+  auto watermark = (max_time_seen_ / spec_.bucket_width_ns) * spec_.bucket_width_ns;
+  if (watermark <= flush_watermark_) {
+    return Status::OK();
+  }
+  flush_watermark_ = watermark;
+
+  struct FlushRow {
+    int64_t bucket_start;
+    const GroupState* group;
+  };
+  std::vector<FlushRow> rows;
+  auto end_it = buckets_.begin();
+  while (end_it != buckets_.end() && end_it->first < watermark) {
+    for (const auto& [key, group] : end_it->second) {
+      rows.push_back(FlushRow{end_it->first, &group});
+    }
+    ++end_it;
+  }
+  if (rows.empty()) {
+    buckets_.erase(buckets_.begin(), end_it);
+    return Status::OK();
+  }
+
+  schema::RowBatch rb(schema::RowDescriptor(output_relation_.col_types()),
+                      static_cast<int64_t>(rows.size()));
+  auto* mem_pool = arrow::default_memory_pool();
+
+  std::vector<types::Time64NSValue> times;
+  times.reserve(rows.size());
+  for (const auto& row : rows) {
+    times.emplace_back(row.bucket_start);
+  }
+  PL_RETURN_IF_ERROR(rb.AddColumn(types::ToArrow(times, mem_pool)));
+
+  for (size_t g = 0; g < group_slots_.size(); ++g) {
+    if (group_types_[g] == types::DataType::INT64) {
+      std::vector<types::Int64Value> vals;
+      vals.reserve(rows.size());
+      for (const auto& row : rows) {
+        vals.emplace_back(row.group->group_vals[g].int_val);
+      }
+      PL_RETURN_IF_ERROR(rb.AddColumn(types::ToArrow(vals, mem_pool)));
+    } else {
+      std::vector<types::StringValue> vals;
+      vals.reserve(rows.size());
+      for (const auto& row : rows) {
+        vals.emplace_back(row.group->group_vals[g].str_val);
+      }
+      PL_RETURN_IF_ERROR(rb.AddColumn(types::ToArrow(vals, mem_pool)));
+    }
+  }
+
+  for (size_t a = 0; a < spec_.aggs.size(); ++a) {
+    const auto kind = spec_.aggs[a].kind;
+    const bool int_arg = agg_types_[a] == types::DataType::INT64;
+    if (kind == RollupSpec::AggKind::kMean) {
+      std::vector<types::Float64Value> vals;
+      vals.reserve(rows.size());
+      for (const auto& row : rows) {
+        const auto& state = row.group->aggs[a];
+        auto sum = int_arg ? static_cast<double>(state.sum_int) : state.sum_float;
+        vals.emplace_back(sum / static_cast<double>(state.count));
+      }
+      PL_RETURN_IF_ERROR(rb.AddColumn(types::ToArrow(vals, mem_pool)));
+    } else if (kind == RollupSpec::AggKind::kCount) {
+      std::vector<types::Int64Value> vals;
+      vals.reserve(rows.size());
+      for (const auto& row : rows) {
+        vals.emplace_back(row.group->aggs[a].count);
+      }
+      PL_RETURN_IF_ERROR(rb.AddColumn(types::ToArrow(vals, mem_pool)));
+    } else if (int_arg) {
+      std::vector<types::Int64Value> vals;
+      vals.reserve(rows.size());
+      for (const auto& row : rows) {
+        const auto& state = row.group->aggs[a];
+        vals.emplace_back(kind == RollupSpec::AggKind::kSum
+                              ? state.sum_int
+                              : (kind == RollupSpec::AggKind::kMin ? state.min_int
+                                                                   : state.max_int));
+      }
+      PL_RETURN_IF_ERROR(rb.AddColumn(types::ToArrow(vals, mem_pool)));
+    } else {
+      std::vector<types::Float64Value> vals;
+      vals.reserve(rows.size());
+      for (const auto& row : rows) {
+        const auto& state = row.group->aggs[a];
+        vals.emplace_back(kind == RollupSpec::AggKind::kSum
+                              ? state.sum_float
+                              : (kind == RollupSpec::AggKind::kMin ? state.min_float
+                                                                   : state.max_float));
+      }
+      PL_RETURN_IF_ERROR(rb.AddColumn(types::ToArrow(vals, mem_pool)));
+    }
+  }
+
+  PL_RETURN_IF_ERROR(rollup_table_->WriteRowBatch(rb));
+  buckets_.erase(buckets_.begin(), end_it);
+  return Status::OK();
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/common/base/base.h"
+#include "src/table_store/schema/relation.h"
+#include "src/table_store/table/table.h"
+
+namespace px {
+namespace table_store {
+
+/**
+ * RollupSpec declaratively describes a downsampled companion table: rows of the source table
+ * are bucketed by time and optionally grouped by a set of columns, and a list of per-column
+ * aggregates is computed for every (bucket, group) pair. Because an aggregate row stands in
+ * for every raw row in its bucket, the companion table holds hours of queryable history in
+ * the memory that minutes of full-resolution data cost.
+ */
+struct RollupSpec {
+  enum class AggKind {
+    kCount,
+    kSum,
+    kMin,
+    kMax,
+    kMean,
+  };
+
+  struct Agg {
+    // Name of the aggregated column in the source table. Must be INT64 or FLOAT64 for every
+    // kind except kCount, which counts rows and ignores the column (leave it empty).
+    std::string src_col;
+    AggKind kind;
+    // Name of the resulting column in the rollup table.
+    std::string output_col;
+  };
+
+  // Name of the table to downsample.
+  std::string src_table_name;
+  // Name of the companion table holding the rollup rows.
+  std::string rollup_table_name;
+  // Width of a time bucket, in nanoseconds.
+  int64_t bucket_width_ns = 0;
+  // Names of the source columns to group by within a bucket (INT64 or STRING). May be empty,
+  // in which case each bucket produces a single row.
+  std::vector<std::string> group_cols;
+  std::vector<Agg> aggs;
+};
+
+/**
+ * TableRollup incrementally maintains the companion table described by a RollupSpec. It keeps
+ * an infinite cursor over the source table and folds newly arrived rows into per-(bucket,
+ * group) accumulators; once the source's high-water timestamp passes the end of a bucket, the
+ * bucket is finalized and its rows are appended to the rollup table. Rollup rows are therefore
+ * written in bucket order, keeping the companion table time-sorted like any other table.
+ *
+ * Rows that arrive after their bucket has already been flushed cannot be folded in without
+ * emitting out-of-order rows, so they are dropped and counted in `late_rows_dropped`. The
+ * source table is expected to be approximately time-ordered, so in practice this only affects
+ * rows delayed by more than a full bucket.
+ *
+ * `ProcessBatches` is internally synchronized and is driven from the compaction worker threads
+ * (see AsyncCompactionManager), so rollups are computed off the event loop, piggybacking on the
+ * same cadence as hot-to-cold compaction.
+ */
+class TableRollup : public NotCopyable {
+ public:
+  /**
+   * OutputRelation derives the rollup table's relation from the spec and the source relation:
+   * a `time_` column holding the bucket start, followed by the group columns (source types)
+   * and one column per aggregate. Errors out if the spec doesn't match the source relation.
+   */
+  static StatusOr<schema::Relation> OutputRelation(const RollupSpec& spec,
+                                                   const schema::Relation& src_relation);
+
+  /**
+   * Create validates the spec against both tables and returns a rollup ready for processing.
+   * The rollup table must have been created with the relation returned by `OutputRelation`.
+   */
+  static StatusOr<std::unique_ptr<TableRollup>> Create(const RollupSpec& spec,
+                                                       std::shared_ptr<Table> src_table,
+                                                       std::shared_ptr<Table> rollup_table);
+
+  /**
+   * HasWork returns whether the source table has unprocessed batches ready.
+   */
+  bool HasWork();
+
+  /**
+   * ProcessBatches consumes up to `max_batches` newly arrived source batches, then flushes any
+   * buckets completed by them into the rollup table. Returns whether more batches are ready,
+   * so the caller can re-enqueue the rollup instead of processing a large backlog in one tick.
+   */
+  StatusOr<bool> ProcessBatches(int64_t max_batches);
+
+  const RollupSpec& spec() const { return spec_; }
+  const schema::Relation& output_relation() const { return output_relation_; }
+
+  // Number of rows dropped because they arrived after their bucket was flushed.
+  int64_t late_rows_dropped() const { return late_rows_dropped_; }
+
+ private:
+  // Per-aggregate accumulator. Only the fields relevant to the aggregate's kind and argument
+  // type are maintained.
+  struct AggState {
+    int64_t count = 0;
+    int64_t sum_int = 0;
+    double sum_float = 0.0;
+    int64_t min_int = std::numeric_limits<int64_t>::max();
+    int64_t max_int = std::numeric_limits<int64_t>::min();
+    double min_float = std::numeric_limits<double>::infinity();
+    double max_float = -std::numeric_limits<double>::infinity();
+  };
+
+  // A single group-by value; which field is valid depends on the group column's type.
+  struct GroupValue {
+    int64_t int_val = 0;
+    std::string str_val;
+  };
+
+  struct GroupState {
+    std::vector<GroupValue> group_vals;
+    std::vector<AggState> aggs;
+  };
+
+  // Groups within one time bucket, keyed by the serialized group-by values.
+  using Bucket = absl::flat_hash_map<std::string, GroupState>;
+
+  TableRollup(RollupSpec spec, std::shared_ptr<Table> src_table,
+              std::shared_ptr<Table> rollup_table, schema::Relation output_relation);
+
+  // Folds one projected source batch into the bucket accumulators.
+  void ConsumeBatch(const schema::RowBatch& rb);
+  // Writes every bucket whose end has passed the high-water timestamp to the rollup table.
+  Status FlushCompletedBuckets();
+
+  const RollupSpec spec_;
+  const std::shared_ptr<Table> src_table_;
+  const std::shared_ptr<Table> rollup_table_;
+  const schema::Relation output_relation_;
+
+  // Column indices into the projected source batch (the cursor only materializes the columns
+  // the rollup reads). kCount aggs with no source column have slot -1.
+  int64_t time_slot_ = -1;
+  std::vector<int64_t> group_slots_;
+  std::vector<types::DataType> group_types_;
+  std::vector<int64_t> agg_slots_;
+  std::vector<types::DataType> agg_types_;
+
+  // Guards the cursor and all accumulator state; ProcessBatches may be called from any of the
+  // compaction worker threads.
+  std::mutex lock_;
+  std::unique_ptr<Table::Cursor> cursor_;
+  // Open buckets keyed by bucket start time; ordered so flushes emit rows in time order.
+  std::map<int64_t, Bucket> buckets_;
+  // Largest source timestamp seen so far; buckets ending at or before it are complete.
+  int64_t max_time_seen_ = std::numeric_limits<int64_t>::min();
+  // Start of the first bucket that has not been flushed; rows before it are late.
+  int64_t flush_watermark_ = std::numeric_limits<int64_t>::min();
+  int64_t late_rows_dropped_ = 0;
+};
+
+}  // namespace table_store
+}  // namespace px
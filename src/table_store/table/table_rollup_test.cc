@@ -0,0 +1,236 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/table_store.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+// A source table shaped like a tracing table: a time column, a string service and an
+// integer latency.
+std::shared_ptr<Table> MakeSourceTable() {
+  schema::Relation rel({types::DataType::TIME64NS, types::DataType::STRING,
+                        types::DataType::INT64},
+                       {"time_", "service", "latency"});
+  return Table::Create("http_events", rel);
+}
+
+void WriteBatch(Table* table, const std::vector<types::Time64NSValue>& times,
+                const std::vector<types::StringValue>& services,
+                const std::vector<types::Int64Value>& latencies) {
+  auto rb = schema::RowBatch(schema::RowDescriptor(table->GetRelation().col_types()),
+                             static_cast<int64_t>(times.size()));
+  PL_CHECK_OK(rb.AddColumn(types::ToArrow(times, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb.AddColumn(types::ToArrow(services, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb.AddColumn(types::ToArrow(latencies, arrow::default_memory_pool())));
+  PL_CHECK_OK(table->WriteRowBatch(rb));
+}
+
+RollupSpec MakeSpec() {
+  RollupSpec spec;
+  spec.src_table_name = "http_events";
+  spec.rollup_table_name = "http_events_1m";
+  spec.bucket_width_ns = 10;
+  spec.group_cols = {"service"};
+  spec.aggs = {
+      {"", RollupSpec::AggKind::kCount, "count"},
+      {"latency", RollupSpec::AggKind::kSum, "latency_sum"},
+      {"latency", RollupSpec::AggKind::kMin, "latency_min"},
+      {"latency", RollupSpec::AggKind::kMax, "latency_max"},
+      {"latency", RollupSpec::AggKind::kMean, "latency_mean"},
+  };
+  return spec;
+}
+
+// (bucket start, service) -> (count, sum, min, max, mean). Rows within a bucket come out in
+// hash-map order, so tests compare against a sorted map.
+using RollupRows = std::map<std::tuple<int64_t, std::string>,
+                            std::tuple<int64_t, int64_t, int64_t, int64_t, double>>;
+
+RollupRows ReadRollupTable(Table* table) {
+  RollupRows rows;
+  Table::Cursor cursor(table);
+  while (!cursor.Done()) {
+    auto rb = cursor.GetNextRowBatch().ConsumeValueOrDie();
+    for (int64_t i = 0; i < rb->num_rows(); ++i) {
+      auto time = types::GetValueFromArrowArray<types::DataType::TIME64NS>(
+          rb->ColumnAt(0).get(), i);
+      auto service = std::string(types::GetStringViewFromArrowArray(rb->ColumnAt(1).get(), i));
+      rows[{time, service}] = {
+          types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(2).get(), i),
+          types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(3).get(), i),
+          types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(4).get(), i),
+          types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(5).get(), i),
+          types::GetValueFromArrowArray<types::DataType::FLOAT64>(rb->ColumnAt(6).get(), i)};
+    }
+  }
+  return rows;
+}
+
+}  // namespace
+
+TEST(TableRollupTest, output_relation) {
+  auto src_table = MakeSourceTable();
+  auto relation = TableRollup::OutputRelation(MakeSpec(), src_table->GetRelation())
+                      .ConsumeValueOrDie();
+  schema::Relation expected({types::DataType::TIME64NS, types::DataType::STRING,
+                             types::DataType::INT64, types::DataType::INT64,
+                             types::DataType::INT64, types::DataType::INT64,
+                             types::DataType::FLOAT64},
+                            {"time_", "service", "count", "latency_sum", "latency_min",
+                             "latency_max", "latency_mean"});
+  EXPECT_EQ(expected, relation);
+}
+
+TEST(TableRollupTest, spec_validation) {
+  auto src_table = MakeSourceTable();
+  const auto& src_relation = src_table->GetRelation();
+
+  auto spec = MakeSpec();
+  spec.bucket_width_ns = 0;
+  EXPECT_NOT_OK(TableRollup::OutputRelation(spec, src_relation));
+
+  spec = MakeSpec();
+  spec.group_cols = {"no_such_col"};
+  EXPECT_NOT_OK(TableRollup::OutputRelation(spec, src_relation));
+
+  spec = MakeSpec();
+  spec.aggs = {{"service", RollupSpec::AggKind::kSum, "service_sum"}};
+  EXPECT_NOT_OK(TableRollup::OutputRelation(spec, src_relation));
+
+  spec = MakeSpec();
+  spec.aggs.push_back({"latency", RollupSpec::AggKind::kSum, "latency_sum"});
+  EXPECT_NOT_OK(TableRollup::OutputRelation(spec, src_relation));
+
+  spec = MakeSpec();
+  spec.aggs.clear();
+  EXPECT_NOT_OK(TableRollup::OutputRelation(spec, src_relation));
+
+  // A relation without a time column can't be bucketed.
+  schema::Relation timeless({types::DataType::INT64}, {"col1"});
+  EXPECT_NOT_OK(TableRollup::OutputRelation(MakeSpec(), timeless));
+}
+
+TEST(TableRollupTest, aggregates_completed_buckets) {
+  auto src_table = MakeSourceTable();
+  auto spec = MakeSpec();
+  auto relation = TableRollup::OutputRelation(spec, src_table->GetRelation())
+                      .ConsumeValueOrDie();
+  auto rollup_table = Table::Create(spec.rollup_table_name, relation);
+  auto rollup = TableRollup::Create(spec, src_table, rollup_table).ConsumeValueOrDie();
+
+  EXPECT_FALSE(rollup->HasWork());
+  WriteBatch(src_table.get(), {1, 2, 5, 9}, {"a", "a", "b", "a"}, {10, 20, 7, 30});
+  WriteBatch(src_table.get(), {12, 15, 21}, {"b", "b", "a"}, {5, 3, 100});
+  EXPECT_TRUE(rollup->HasWork());
+
+  // The high-water timestamp (21) completes buckets [0, 10) and [10, 20); bucket [20, 30)
+  // stays open.
+  EXPECT_FALSE(rollup->ProcessBatches(/* max_batches */ 10).ConsumeValueOrDie());
+  RollupRows expected = {
+      {{0, "a"}, {3, 60, 10, 30, 20.0}},
+      {{0, "b"}, {1, 7, 7, 7, 7.0}},
+      {{10, "b"}, {2, 8, 3, 5, 4.0}},
+  };
+  EXPECT_EQ(expected, ReadRollupTable(rollup_table.get()));
+
+  // A later write completes bucket [20, 30); earlier buckets are not re-emitted.
+  WriteBatch(src_table.get(), {33}, {"a"}, {1});
+  EXPECT_FALSE(rollup->ProcessBatches(/* max_batches */ 10).ConsumeValueOrDie());
+  expected[{20, "a"}] = {1, 100, 100, 100, 100.0};
+  EXPECT_EQ(expected, ReadRollupTable(rollup_table.get()));
+  EXPECT_EQ(0, rollup->late_rows_dropped());
+}
+
+TEST(TableRollupTest, drops_rows_behind_the_flush_watermark) {
+  auto src_table = MakeSourceTable();
+  auto spec = MakeSpec();
+  auto relation = TableRollup::OutputRelation(spec, src_table->GetRelation())
+                      .ConsumeValueOrDie();
+  auto rollup_table = Table::Create(spec.rollup_table_name, relation);
+  auto rollup = TableRollup::Create(spec, src_table, rollup_table).ConsumeValueOrDie();
+
+  WriteBatch(src_table.get(), {5, 25}, {"a", "a"}, {10, 20});
+  EXPECT_FALSE(rollup->ProcessBatches(/* max_batches */ 10).ConsumeValueOrDie());
+  // Buckets [0, 10) and the empty [10, 20) are now behind the watermark, so a row at t=12
+  // can't be folded in without emitting an out-of-order rollup row.
+  WriteBatch(src_table.get(), {12, 31}, {"a", "a"}, {1000, 5});
+  EXPECT_FALSE(rollup->ProcessBatches(/* max_batches */ 10).ConsumeValueOrDie());
+
+  RollupRows expected = {
+      {{0, "a"}, {1, 10, 10, 10, 10.0}},
+      {{20, "a"}, {1, 20, 20, 20, 20.0}},
+  };
+  EXPECT_EQ(expected, ReadRollupTable(rollup_table.get()));
+  EXPECT_EQ(1, rollup->late_rows_dropped());
+}
+
+TEST(TableRollupTest, bounded_batches_per_call) {
+  auto src_table = MakeSourceTable();
+  auto spec = MakeSpec();
+  auto relation = TableRollup::OutputRelation(spec, src_table->GetRelation())
+                      .ConsumeValueOrDie();
+  auto rollup_table = Table::Create(spec.rollup_table_name, relation);
+  auto rollup = TableRollup::Create(spec, src_table, rollup_table).ConsumeValueOrDie();
+
+  WriteBatch(src_table.get(), {1}, {"a"}, {1});
+  WriteBatch(src_table.get(), {2}, {"a"}, {2});
+  WriteBatch(src_table.get(), {11}, {"a"}, {3});
+
+  // Only the first batch is consumed; more work remains.
+  EXPECT_TRUE(rollup->ProcessBatches(/* max_batches */ 1).ConsumeValueOrDie());
+  EXPECT_TRUE(ReadRollupTable(rollup_table.get()).empty());
+
+  EXPECT_FALSE(rollup->ProcessBatches(/* max_batches */ 10).ConsumeValueOrDie());
+  RollupRows expected = {{{0, "a"}, {2, 3, 1, 2, 1.5}}};
+  EXPECT_EQ(expected, ReadRollupTable(rollup_table.get()));
+}
+
+TEST(TableRollupTest, table_store_registration) {
+  TableStore table_store;
+  auto spec = MakeSpec();
+
+  // The source table must exist before the rollup.
+  EXPECT_NOT_OK(table_store.AddRollup(spec));
+  table_store.AddTable(MakeSourceTable(), spec.src_table_name);
+  EXPECT_OK(table_store.AddRollup(spec));
+  // The companion table name is now taken.
+  EXPECT_NOT_OK(table_store.AddRollup(spec));
+
+  auto* rollup_table = table_store.GetTable(spec.rollup_table_name);
+  ASSERT_NE(nullptr, rollup_table);
+  ASSERT_EQ(1, table_store.GetRollups().size());
+
+  WriteBatch(table_store.GetTable(spec.src_table_name), {1, 15}, {"a", "a"}, {4, 8});
+  EXPECT_FALSE(table_store.GetRollups()[0]->ProcessBatches(10).ConsumeValueOrDie());
+  RollupRows expected = {{{0, "a"}, {1, 4, 4, 4, 4.0}}};
+  EXPECT_EQ(expected, ReadRollupTable(rollup_table));
+}
+
+}  // namespace table_store
+}  // namespace px
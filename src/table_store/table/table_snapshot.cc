@@ -0,0 +1,308 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "src/table_store/table/table_snapshot.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+// "PXTSNAP1", read as a little-endian uint64.
+constexpr uint64_t kSnapshotMagic = 0x3150414e53545850ULL;
+constexpr uint64_t kSnapshotVersion = 1;
+// Column buffers are aligned so that the mmapped file region can back Arrow arrays directly.
+constexpr uint64_t kBufferAlignment = 64;
+
+// Snapshot file layout (all integers are 64-bit, native endianness):
+//   magic, version, num_tables
+//   per table:
+//     name_len, relation_len, num_batches
+//     name bytes, serialized schemapb::Relation bytes
+//     per batch:
+//       num_rows, num_cols
+//       per column:
+//         data_len, offsets_len, null_bitmap_len
+//         then each (possibly empty) buffer, preceded by padding to kBufferAlignment.
+// The buffer contents are exactly what RowBatch::ToArrowBuffersProto produces.
+
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(const std::string& path)
+      : out_(path, std::ios::binary | std::ios::trunc) {}
+
+  bool ok() const { return out_.good(); }
+  uint64_t pos() { return static_cast<uint64_t>(out_.tellp()); }
+
+  void WriteU64(uint64_t val) { out_.write(reinterpret_cast<const char*>(&val), sizeof(val)); }
+  void WriteBytes(std::string_view bytes) { out_.write(bytes.data(), bytes.size()); }
+
+  void AlignTo(uint64_t alignment) {
+    static constexpr char kZeros[kBufferAlignment] = {};
+    uint64_t rem = pos() % alignment;
+    if (rem != 0) {
+      out_.write(kZeros, alignment - rem);
+    }
+  }
+
+  // Overwrites the u64 previously written at `at`; used to backpatch batch counts.
+  void PatchU64(uint64_t at, uint64_t val) {
+    auto end = out_.tellp();
+    out_.seekp(at);
+    WriteU64(val);
+    out_.seekp(end);
+  }
+
+  bool Close() {
+    out_.close();
+    return out_.good();
+  }
+
+ private:
+  std::ofstream out_;
+};
+
+class SnapshotReader {
+ public:
+  SnapshotReader(const uint8_t* data, uint64_t size) : data_(data), size_(size) {}
+
+  StatusOr<uint64_t> ReadU64() {
+    if (offset_ + sizeof(uint64_t) > size_) {
+      return CorruptError();
+    }
+    uint64_t val;
+    std::memcpy(&val, data_ + offset_, sizeof(val));
+    offset_ += sizeof(val);
+    return val;
+  }
+
+  StatusOr<std::string_view> ReadBytes(uint64_t len) {
+    if (len > size_ || offset_ > size_ - len) {
+      return CorruptError();
+    }
+    std::string_view bytes(reinterpret_cast<const char*>(data_ + offset_), len);
+    offset_ += len;
+    return bytes;
+  }
+
+  Status AlignTo(uint64_t alignment) {
+    uint64_t rem = offset_ % alignment;
+    if (rem != 0) {
+      offset_ += alignment - rem;
+    }
+    if (offset_ > size_) {
+      return CorruptError();
+    }
+    return Status::OK();
+  }
+
+ private:
+  Status CorruptError() const {
+    return error::Internal("Corrupted table store snapshot (offset $0 of $1)", offset_, size_);
+  }
+
+  const uint8_t* data_;
+  uint64_t size_;
+  uint64_t offset_ = 0;
+};
+
+}  // namespace
+
+Status WriteTableStoreSnapshot(TableStore* table_store, const std::string& path) {
+  // Resolve names to tables up front; sorted for a deterministic file layout.
+  auto relation_map = table_store->GetRelationMap();
+  std::vector<std::pair<std::string, Table*>> tables;
+  for (const auto& [name, relation] : *relation_map) {
+    PL_UNUSED(relation);
+    Table* table = table_store->GetTable(name);
+    if (table != nullptr) {
+      tables.emplace_back(name, table);
+    }
+  }
+  std::sort(tables.begin(), tables.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  const std::string tmp_path = path + ".tmp";
+  SnapshotWriter writer(tmp_path);
+  if (!writer.ok()) {
+    return error::Internal("Failed to open table store snapshot '$0' for writing", tmp_path);
+  }
+
+  writer.WriteU64(kSnapshotMagic);
+  writer.WriteU64(kSnapshotVersion);
+  writer.WriteU64(tables.size());
+
+  schemapb::ArrowRowBatchData batch_pb;
+  for (const auto& [name, table] : tables) {
+    schemapb::Relation rel_pb;
+    PL_RETURN_IF_ERROR(table->GetRelation().ToProto(&rel_pb));
+    const std::string rel_bytes = rel_pb.SerializeAsString();
+
+    writer.WriteU64(name.size());
+    writer.WriteU64(rel_bytes.size());
+    // The batch count isn't known until the table has been iterated; backpatched below.
+    const uint64_t num_batches_pos = writer.pos();
+    writer.WriteU64(0);
+    writer.WriteBytes(name);
+    writer.WriteBytes(rel_bytes);
+
+    uint64_t num_batches = 0;
+    Table::Cursor cursor(table);
+    while (!cursor.Done()) {
+      PL_ASSIGN_OR_RETURN(auto rb, cursor.GetNextRowBatch());
+      if (rb->num_rows() == 0) {
+        continue;
+      }
+      batch_pb.Clear();
+      PL_RETURN_IF_ERROR(rb->ToArrowBuffersProto(&batch_pb));
+
+      writer.WriteU64(rb->num_rows());
+      writer.WriteU64(batch_pb.cols_size());
+      for (const auto& col : batch_pb.cols()) {
+        writer.WriteU64(col.data().size());
+        writer.WriteU64(col.offsets().size());
+        writer.WriteU64(col.null_bitmap().size());
+        writer.AlignTo(kBufferAlignment);
+        writer.WriteBytes(col.data());
+        writer.AlignTo(kBufferAlignment);
+        writer.WriteBytes(col.offsets());
+        writer.AlignTo(kBufferAlignment);
+        writer.WriteBytes(col.null_bitmap());
+      }
+      ++num_batches;
+    }
+    writer.PatchU64(num_batches_pos, num_batches);
+  }
+
+  if (!writer.Close()) {
+    return error::Internal("Failed while writing table store snapshot '$0'", tmp_path);
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    return error::Internal("Failed to move table store snapshot into '$0': $1", path, ec.message());
+  }
+  return Status::OK();
+}
+
+Status RestoreTableStoreSnapshot(const std::string& path, TableStore* table_store) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return error::NotFound("No table store snapshot at '$0'", path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return error::Internal("Failed to stat table store snapshot '$0'", path);
+  }
+  const uint64_t size = st.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return error::Internal("Failed to mmap table store snapshot '$0'", path);
+  }
+  // Restored batches reference the mapping directly; it is unmapped once the last batch
+  // referencing it has been compacted or expired.
+  std::shared_ptr<const void> owner(static_cast<const void*>(addr),
+                                    [size](const void* p) { munmap(const_cast<void*>(p), size); });
+
+  SnapshotReader reader(static_cast<const uint8_t*>(addr), size);
+  PL_ASSIGN_OR_RETURN(const uint64_t magic, reader.ReadU64());
+  if (magic != kSnapshotMagic) {
+    return error::InvalidArgument("'$0' is not a table store snapshot", path);
+  }
+  PL_ASSIGN_OR_RETURN(const uint64_t version, reader.ReadU64());
+  if (version != kSnapshotVersion) {
+    return error::InvalidArgument("Unsupported table store snapshot version $0", version);
+  }
+  PL_ASSIGN_OR_RETURN(const uint64_t num_tables, reader.ReadU64());
+
+  for (uint64_t t = 0; t < num_tables; ++t) {
+    PL_ASSIGN_OR_RETURN(const uint64_t name_len, reader.ReadU64());
+    PL_ASSIGN_OR_RETURN(const uint64_t rel_len, reader.ReadU64());
+    PL_ASSIGN_OR_RETURN(const uint64_t num_batches, reader.ReadU64());
+    PL_ASSIGN_OR_RETURN(const std::string_view name, reader.ReadBytes(name_len));
+    PL_ASSIGN_OR_RETURN(const std::string_view rel_bytes, reader.ReadBytes(rel_len));
+
+    schemapb::Relation rel_pb;
+    if (!rel_pb.ParseFromArray(rel_bytes.data(), rel_bytes.size())) {
+      return error::Internal("Corrupted relation in table store snapshot '$0'", path);
+    }
+    schema::Relation relation;
+    PL_RETURN_IF_ERROR(relation.FromProto(&rel_pb));
+
+    const std::string table_name(name);
+    Table* target = table_store->GetTable(table_name);
+    if (target == nullptr) {
+      auto table = Table::Create(table_name, relation);
+      table_store->AddTable(table, table_name);
+      target = table.get();
+    } else if (!(target->GetRelation() == relation)) {
+      // Schema changed across the restart; the snapshotted data no longer fits. Skip the
+      // table but keep reading past its batches so the rest of the snapshot restores.
+      LOG(WARNING) << absl::Substitute(
+          "Skipping table '$0' from snapshot '$1': relation has changed", table_name, path);
+      target = nullptr;
+    }
+
+    for (uint64_t b = 0; b < num_batches; ++b) {
+      PL_ASSIGN_OR_RETURN(const uint64_t num_rows, reader.ReadU64());
+      PL_ASSIGN_OR_RETURN(const uint64_t num_cols, reader.ReadU64());
+      if (num_cols != relation.NumColumns()) {
+        return error::Internal("Corrupted batch in table store snapshot '$0'", path);
+      }
+      std::vector<schema::RowBatch::ArrowColumnBuffers> cols(num_cols);
+      for (uint64_t c = 0; c < num_cols; ++c) {
+        PL_ASSIGN_OR_RETURN(const uint64_t data_len, reader.ReadU64());
+        PL_ASSIGN_OR_RETURN(const uint64_t offsets_len, reader.ReadU64());
+        PL_ASSIGN_OR_RETURN(const uint64_t null_len, reader.ReadU64());
+        PL_RETURN_IF_ERROR(reader.AlignTo(kBufferAlignment));
+        PL_ASSIGN_OR_RETURN(cols[c].data, reader.ReadBytes(data_len));
+        PL_RETURN_IF_ERROR(reader.AlignTo(kBufferAlignment));
+        PL_ASSIGN_OR_RETURN(cols[c].offsets, reader.ReadBytes(offsets_len));
+        PL_RETURN_IF_ERROR(reader.AlignTo(kBufferAlignment));
+        PL_ASSIGN_OR_RETURN(cols[c].null_bitmap, reader.ReadBytes(null_len));
+      }
+      if (target == nullptr) {
+        continue;
+      }
+      PL_ASSIGN_OR_RETURN(auto rb, schema::RowBatch::FromArrowColumnBuffers(
+                                       relation.col_types(), num_rows, cols, owner));
+      PL_RETURN_IF_ERROR(target->WriteRowBatch(*rb));
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+
+#include "src/common/base/base.h"
+#include "src/table_store/table/table_store.h"
+
+namespace px {
+namespace table_store {
+
+/**
+ * WriteTableStoreSnapshot writes all data currently in the table store (hot and cold tiers of
+ * every table, default tablet only) to a snapshot file at `path`. Column data is written as raw
+ * Arrow buffers, so the cost is one memcpy per buffer plus the usual hot-tier Arrow conversion
+ * for batches that have not been compacted yet.
+ *
+ * The snapshot is host-specific (native endianness and Arrow buffer layout): it is meant to
+ * carry a node's data across a process restart (eg. a DaemonSet upgrade), not for portable
+ * interchange. The file is written atomically: a temporary file is renamed into place, so a
+ * crash mid-write never leaves a partial snapshot at `path`.
+ */
+Status WriteTableStoreSnapshot(TableStore* table_store, const std::string& path);
+
+/**
+ * RestoreTableStoreSnapshot mmaps the snapshot at `path` and appends its batches back into the
+ * table store. Column data is not copied: the restored batches wrap the mmapped buffers
+ * directly, and the mapping stays alive until the last restored batch is compacted or expired.
+ *
+ * Tables already registered in the store receive the restored batches in place; tables only
+ * present in the snapshot are created and added. A snapshotted table whose relation no longer
+ * matches the registered one (eg. across a schema change) is skipped with a warning.
+ */
+Status RestoreTableStoreSnapshot(const std::string& path, TableStore* table_store);
+
+}  // namespace table_store
+}  // namespace px
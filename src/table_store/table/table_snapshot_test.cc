@@ -0,0 +1,161 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/array.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <string>
+#include <vector>
+
+#include "src/common/testing/temp_dir.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/schema/relation.h"
+#include "src/table_store/table/table_snapshot.h"
+#include "src/table_store/table/table_store.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+std::shared_ptr<Table> MakeStringTable() {
+  schema::Relation rel({types::DataType::INT64, types::DataType::STRING}, {"col1", "col2"});
+  auto table = Table::Create("strings", rel);
+
+  auto rb1 = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 3);
+  std::vector<types::Int64Value> col1_in1 = {1, 2, 3};
+  std::vector<types::StringValue> col2_in1 = {"hello", "abc", "defg"};
+  PL_CHECK_OK(rb1.AddColumn(types::ToArrow(col1_in1, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb1.AddColumn(types::ToArrow(col2_in1, arrow::default_memory_pool())));
+  PL_CHECK_OK(table->WriteRowBatch(rb1));
+
+  auto rb2 = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 2);
+  std::vector<types::Int64Value> col1_in2 = {5, 6};
+  std::vector<types::StringValue> col2_in2 = {"", "x"};
+  PL_CHECK_OK(rb2.AddColumn(types::ToArrow(col1_in2, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb2.AddColumn(types::ToArrow(col2_in2, arrow::default_memory_pool())));
+  PL_CHECK_OK(table->WriteRowBatch(rb2));
+
+  return table;
+}
+
+std::shared_ptr<Table> MakeFloatTable() {
+  schema::Relation rel({types::DataType::FLOAT64, types::DataType::BOOLEAN}, {"col1", "col2"});
+  auto table = Table::Create("floats", rel);
+
+  auto rb = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 4);
+  std::vector<types::Float64Value> col1 = {0.5, 1.2, 5.3, -2.0};
+  std::vector<types::BoolValue> col2 = {true, false, false, true};
+  PL_CHECK_OK(rb.AddColumn(types::ToArrow(col1, arrow::default_memory_pool())));
+  PL_CHECK_OK(rb.AddColumn(types::ToArrow(col2, arrow::default_memory_pool())));
+  PL_CHECK_OK(table->WriteRowBatch(rb));
+
+  return table;
+}
+
+// Compares the full contents of two tables via their proto representation.
+void ExpectTablesEqual(Table* expected, Table* actual) {
+  schemapb::Table expected_pb;
+  schemapb::Table actual_pb;
+  ASSERT_OK(expected->ToProto(&expected_pb));
+  ASSERT_OK(actual->ToProto(&actual_pb));
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(actual_pb, expected_pb));
+}
+
+}  // namespace
+
+TEST(TableSnapshotTest, round_trip) {
+  auto strings = MakeStringTable();
+  auto floats = MakeFloatTable();
+  // Compact one table so the snapshot covers both hot and cold batches.
+  ASSERT_OK(strings->CompactHotToCold(arrow::default_memory_pool()));
+
+  TableStore store;
+  store.AddTable(strings, "strings");
+  store.AddTable(floats, "floats");
+
+  ::px::testing::TempDir temp_dir;
+  const std::string path = temp_dir.path() / "table_store.snapshot";
+  ASSERT_OK(WriteTableStoreSnapshot(&store, path));
+
+  // Restore into an empty store: both tables are created from the snapshot.
+  TableStore restored_store;
+  ASSERT_OK(RestoreTableStoreSnapshot(path, &restored_store));
+
+  auto* restored_strings = restored_store.GetTable("strings");
+  auto* restored_floats = restored_store.GetTable("floats");
+  ASSERT_NE(restored_strings, nullptr);
+  ASSERT_NE(restored_floats, nullptr);
+  ExpectTablesEqual(strings.get(), restored_strings);
+  ExpectTablesEqual(floats.get(), restored_floats);
+
+  // Restored batches live in the hot tier backed by the mmapped file; compacting them copies
+  // the data into the table's own memory.
+  ASSERT_OK(restored_strings->CompactHotToCold(arrow::default_memory_pool()));
+  ExpectTablesEqual(strings.get(), restored_strings);
+}
+
+TEST(TableSnapshotTest, restore_into_registered_table) {
+  auto floats = MakeFloatTable();
+  TableStore store;
+  store.AddTable(floats, "floats");
+
+  ::px::testing::TempDir temp_dir;
+  const std::string path = temp_dir.path() / "table_store.snapshot";
+  ASSERT_OK(WriteTableStoreSnapshot(&store, path));
+
+  // The restore target already has the table registered (as on PEM startup, where schemas are
+  // installed before the snapshot is restored); batches are appended in place.
+  TableStore restored_store;
+  auto empty = Table::Create("floats", floats->GetRelation());
+  restored_store.AddTable(empty, "floats");
+  ASSERT_OK(RestoreTableStoreSnapshot(path, &restored_store));
+  ExpectTablesEqual(floats.get(), restored_store.GetTable("floats"));
+}
+
+TEST(TableSnapshotTest, relation_mismatch_skipped) {
+  auto floats = MakeFloatTable();
+  auto strings = MakeStringTable();
+  TableStore store;
+  store.AddTable(floats, "floats");
+  store.AddTable(strings, "strings");
+
+  ::px::testing::TempDir temp_dir;
+  const std::string path = temp_dir.path() / "table_store.snapshot";
+  ASSERT_OK(WriteTableStoreSnapshot(&store, path));
+
+  // "floats" now has a different relation: its snapshotted batches are skipped, but the rest
+  // of the snapshot still restores.
+  TableStore restored_store;
+  schema::Relation changed_rel({types::DataType::INT64}, {"col1"});
+  auto changed = Table::Create("floats", changed_rel);
+  restored_store.AddTable(changed, "floats");
+  ASSERT_OK(RestoreTableStoreSnapshot(path, &restored_store));
+
+  EXPECT_EQ(restored_store.GetTable("floats")->GetTableStats().num_rows, 0);
+  ExpectTablesEqual(strings.get(), restored_store.GetTable("strings"));
+}
+
+TEST(TableSnapshotTest, missing_snapshot_is_not_found) {
+  TableStore store;
+  auto s = RestoreTableStoreSnapshot("/nonexistent/table_store.snapshot", &store);
+  EXPECT_TRUE(error::IsNotFound(s));
+}
+
+}  // namespace table_store
+}  // namespace px
@@ -44,6 +44,7 @@ StatusOr<Table*> TableStore::CreateNewTablet(uint64_t table_id, const types::Tab
   const schema::Relation& relation = table_info.relation;
 
   std::shared_ptr<Table> new_tablet = Table::Create(table_info.table_name, relation);
+  new_tablet->SetStringInternPool(string_intern_pool_);
 
   TableIDTablet id_key = {table_id, tablet_id};
   id_to_table_map_[id_key] = new_tablet;
@@ -116,6 +117,8 @@ void TableStore::AddTable(std::shared_ptr<table_store::Table> table, const std::
                           std::optional<uint64_t> table_id, const types::TabletID& tablet_id) {
   const auto& table_relation = table->GetRelation();
 
+  table->SetStringInternPool(string_intern_pool_);
+
   // Register the table by name.
   RegisterTableName(table_name, tablet_id, table_relation, table);
 
@@ -165,5 +168,42 @@ Status TableStore::RunCompaction(arrow::MemoryPool* mem_pool) {
   return Status::OK();
 }
 
+std::vector<std::shared_ptr<Table>> TableStore::GetTables() const {
+  std::vector<std::shared_ptr<Table>> tables;
+  tables.reserve(name_to_table_map_.size());
+  for (const auto& it : name_to_table_map_) {
+    tables.push_back(it.second);
+  }
+  return tables;
+}
+
+Status TableStore::AddRollup(const RollupSpec& spec) {
+  auto src_it = name_to_table_map_.find(NameTablet{spec.src_table_name, kDefaultTablet});
+  if (src_it == name_to_table_map_.end()) {
+    return error::NotFound("Cannot create rollup: source table '$0' does not exist.",
+                           spec.src_table_name);
+  }
+  if (GetTable(spec.rollup_table_name) != nullptr) {
+    return error::AlreadyExists("Cannot create rollup: table '$0' already exists.",
+                                spec.rollup_table_name);
+  }
+  PL_ASSIGN_OR_RETURN(auto relation,
+                      TableRollup::OutputRelation(spec, src_it->second->GetRelation()));
+  auto rollup_table = Table::Create(spec.rollup_table_name, relation);
+  PL_ASSIGN_OR_RETURN(auto rollup, TableRollup::Create(spec, src_it->second, rollup_table));
+  AddTable(std::move(rollup_table), spec.rollup_table_name);
+  rollups_.push_back(std::move(rollup));
+  return Status::OK();
+}
+
+std::vector<TableRollup*> TableStore::GetRollups() const {
+  std::vector<TableRollup*> rollups;
+  rollups.reserve(rollups_.size());
+  for (const auto& rollup : rollups_) {
+    rollups.push_back(rollup.get());
+  }
+  return rollups;
+}
+
 }  // namespace table_store
 }  // namespace px
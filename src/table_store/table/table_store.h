@@ -31,7 +31,9 @@
 #include "src/shared/types/hash_utils.h"
 #include "src/table_store/schema/relation.h"
 #include "src/table_store/schema/schema.h"
+#include "src/table_store/table/internal/string_intern_pool.h"
 #include "src/table_store/table/table.h"
+#include "src/table_store/table/table_rollup.h"
 #include "src/table_store/table/tablets_group.h"
 
 namespace px {
@@ -167,6 +169,24 @@ class TableStore {
 
   Status RunCompaction(arrow::MemoryPool* mem_pool);
 
+  /**
+   * GetTables returns all the tables currently in the table store.
+   */
+  std::vector<std::shared_ptr<Table>> GetTables() const;
+
+  /**
+   * AddRollup creates the companion table described by the spec, registers it under the spec's
+   * rollup table name and starts maintaining it (see TableRollup). The source table must
+   * already exist, and the rollup table name must be unused.
+   */
+  Status AddRollup(const RollupSpec& spec);
+
+  /**
+   * GetRollups returns all registered rollups. The returned rollups are internally
+   * synchronized, but the vector itself is not: callers must serialize against AddRollup.
+   */
+  std::vector<TableRollup*> GetRollups() const;
+
  private:
   void RegisterTableName(const std::string& table_name, const types::TabletID& tablet_id,
                          const schema::Relation& table_relation,
@@ -197,6 +217,13 @@ class TableStore {
   absl::flat_hash_map<std::string, schema::Relation> name_to_relation_map_;
   // Mapping from id to name and relation pair for adding new tablets.
   absl::flat_hash_map<uint64_t, TableInfo> id_to_table_info_map_;
+  // Rollups maintaining downsampled companion tables; both their source and output tables are
+  // owned by the maps above.
+  std::vector<std::unique_ptr<TableRollup>> rollups_;
+  // Pool shared by all tables in this store, so that cold batch string dictionaries (pod,
+  // container and service names repeated across tables) are stored once per node.
+  std::shared_ptr<internal::StringInternPool> string_intern_pool_ =
+      std::make_shared<internal::StringInternPool>();
 };
 
 }  // namespace table_store
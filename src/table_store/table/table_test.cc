@@ -372,6 +372,96 @@ TEST(TableTest, expiry_test_w_compaction) {
   EXPECT_EQ(table.GetTableStats().bytes, rb5_size);
 }
 
+TEST(TableTest, table_stats_scan_estimates) {
+  schema::Relation rel({types::DataType::TIME64NS, types::DataType::INT64}, {"time_", "col1"});
+  auto rd = schema::RowDescriptor(rel.col_types());
+
+  int64_t rb_size = 4 * (sizeof(int64_t) + sizeof(int64_t));
+  // compacted_batch_size of one row batch, so each written batch is immediately compactable.
+  Table table("test_table", rel, 128 * rb_size, rb_size);
+
+  for (int i = 0; i < 2; ++i) {
+    schema::RowBatch rb(rd, 4);
+    std::vector<types::Time64NSValue> times = {4 * i + 1, 4 * i + 2, 4 * i + 3, 4 * i + 4};
+    std::vector<types::Int64Value> col(4, i);
+    EXPECT_OK(rb.AddColumn(types::ToArrow(times, arrow::default_memory_pool())));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(col, arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  }
+
+  auto stats = table.GetTableStats();
+  EXPECT_EQ(stats.num_rows, 8);
+  EXPECT_EQ(stats.num_hot_batches, 2);
+  EXPECT_EQ(stats.num_cold_batches, 0);
+  EXPECT_EQ(stats.min_time, 1);
+  EXPECT_EQ(stats.max_time, 8);
+  EXPECT_EQ(stats.zone_map_batches, 0);
+
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+
+  stats = table.GetTableStats();
+  EXPECT_EQ(stats.num_rows, 8);
+  EXPECT_EQ(stats.num_hot_batches, 0);
+  EXPECT_EQ(stats.num_cold_batches, 2);
+  EXPECT_EQ(stats.min_time, 1);
+  EXPECT_EQ(stats.max_time, 8);
+  // Cold batches compute their zone maps eagerly on compaction.
+  EXPECT_EQ(stats.zone_map_batches, 2);
+}
+
+TEST(TableTest, background_reclaim_watermarks) {
+  auto rd = schema::RowDescriptor({types::DataType::INT64});
+  schema::Relation rel(rd.types(), {"col1"});
+
+  // 3 batches of 32 bytes = 96 bytes, past the high watermark (90) but under the limit, so no
+  // batches are expired inline on write.
+  Table table("test_table", rel, 100);
+  int64_t rb_size = 4 * sizeof(int64_t);
+  for (int i = 0; i < 3; ++i) {
+    schema::RowBatch rb(rd, 4);
+    std::vector<types::Int64Value> col(4, i);
+    EXPECT_OK(rb.AddColumn(types::ToArrow(col, arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  }
+  EXPECT_EQ(table.GetTableStats().bytes, 3 * rb_size);
+  EXPECT_TRUE(table.ReclaimNeeded());
+
+  // Reclaiming evicts the oldest batches until the table is below the low watermark (80).
+  EXPECT_OK(table.ReclaimBatches(/* max_batches */ 10));
+  EXPECT_EQ(table.GetTableStats().bytes, 2 * rb_size);
+  EXPECT_EQ(table.GetTableStats().batches_expired, 1);
+  EXPECT_FALSE(table.ReclaimNeeded());
+
+  // Between the watermarks, reclaiming is a no-op (hysteresis).
+  EXPECT_OK(table.ReclaimBatches(/* max_batches */ 10));
+  EXPECT_EQ(table.GetTableStats().bytes, 2 * rb_size);
+}
+
+TEST(TableTest, set_max_table_size) {
+  auto rd = schema::RowDescriptor({types::DataType::INT64});
+  schema::Relation rel(rd.types(), {"col1"});
+
+  // 3 batches of 32 bytes = 96 bytes, under the high watermark of the initial 128-byte limit.
+  Table table("test_table", rel, 128);
+  int64_t rb_size = 4 * sizeof(int64_t);
+  for (int i = 0; i < 3; ++i) {
+    schema::RowBatch rb(rd, 4);
+    std::vector<types::Int64Value> col(4, i);
+    EXPECT_OK(rb.AddColumn(types::ToArrow(col, arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  }
+  EXPECT_FALSE(table.ReclaimNeeded());
+
+  // Shrinking the limit at runtime doesn't evict immediately, but the reclaimer now sees the
+  // table above the new high watermark (90) and evicts down to the new low watermark (80).
+  table.SetMaxTableSize(100);
+  EXPECT_EQ(table.GetTableStats().max_table_size, 100);
+  EXPECT_EQ(table.GetTableStats().bytes, 3 * rb_size);
+  EXPECT_TRUE(table.ReclaimNeeded());
+  EXPECT_OK(table.ReclaimBatches(/* max_batches */ 10));
+  EXPECT_EQ(table.GetTableStats().bytes, 2 * rb_size);
+}
+
 TEST(TableTest, batch_size_too_big) {
   auto rd = schema::RowDescriptor({types::DataType::INT64, types::DataType::STRING});
   schema::Relation rel(rd.types(), {"col1", "col2"});
@@ -939,6 +1029,228 @@ TEST(TableTest, GetNextRowBatch_after_expiry) {
   EXPECT_TRUE(rb1->ColumnAt(1)->Equals(types::ToArrow(col2_in2, arrow::default_memory_pool())));
 }
 
+TEST(TableTest, cursor_predicate_prunes_batches) {
+  schema::Relation rel({types::DataType::INT64, types::DataType::STRING}, {"col1", "col2"});
+
+  std::shared_ptr<Table> table_ptr = Table::Create("test_table", rel);
+  Table& table = *table_ptr;
+
+  auto rd = schema::RowDescriptor(rel.col_types());
+  std::vector<std::vector<types::Int64Value>> col1_batches = {{1, 2, 3}, {10, 11, 12}, {20, 21}};
+  std::vector<std::vector<types::StringValue>> col2_batches = {
+      {"apple", "avocado", "banana"}, {"mango", "melon", "peach"}, {"pear", "plum"}};
+  for (size_t i = 0; i < col1_batches.size(); ++i) {
+    auto rb = schema::RowBatch(rd, static_cast<int64_t>(col1_batches[i].size()));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(col1_batches[i], arrow::default_memory_pool())));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(col2_batches[i], arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  }
+  // Run compaction so that pruning is exercised regardless of which store holds the batches.
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+
+  // Equality on col1 only matches the middle batch, so the first batch is skipped.
+  {
+    Table::Cursor cursor(table_ptr.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                         {{/* col_idx */ 0, Table::Cursor::ColumnPredicate::Op::Equal,
+                           /* value */ int64_t{11}}});
+    auto rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+    EXPECT_TRUE(
+        rb->ColumnAt(0)->Equals(types::ToArrow(col1_batches[1], arrow::default_memory_pool())));
+  }
+
+  // String prefix on col2 only matches the last batch.
+  {
+    Table::Cursor cursor(table_ptr.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                         {{/* col_idx */ 1, Table::Cursor::ColumnPredicate::Op::StringPrefix,
+                           /* value */ std::string("pl")}});
+    auto rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+    EXPECT_TRUE(
+        rb->ColumnAt(0)->Equals(types::ToArrow(col1_batches[2], arrow::default_memory_pool())));
+  }
+
+  // A range predicate that no batch satisfies prunes everything: the cursor returns an empty
+  // batch (not an error) and is then exhausted.
+  {
+    Table::Cursor cursor(table_ptr.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                         {{/* col_idx */ 0, Table::Cursor::ColumnPredicate::Op::GreaterThanOrEqual,
+                           /* value */ int64_t{100}}});
+    auto rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+    EXPECT_EQ(0, rb->num_rows());
+    EXPECT_TRUE(cursor.Done());
+  }
+}
+
+TEST(TableTest, cursor_predicate_prunes_batches_on_time_index) {
+  schema::Relation rel({types::DataType::TIME64NS, types::DataType::INT64}, {"time_", "col1"});
+
+  std::shared_ptr<Table> table_ptr = Table::Create("test_table", rel);
+  Table& table = *table_ptr;
+
+  auto rd = schema::RowDescriptor(rel.col_types());
+  std::vector<std::vector<types::Time64NSValue>> time_batches = {
+      {100, 200, 300}, {400, 500, 600}, {700, 800}};
+  std::vector<std::vector<types::Int64Value>> col1_batches = {{1, 2, 3}, {4, 5, 6}, {7, 8}};
+  for (size_t i = 0; i < time_batches.size(); ++i) {
+    auto rb = schema::RowBatch(rd, static_cast<int64_t>(time_batches[i].size()));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(time_batches[i], arrow::default_memory_pool())));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(col1_batches[i], arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  }
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+
+  // Predicates on the time column are answered from the per-batch time index rather than
+  // per-batch statistics. A range predicate covering only the middle batch skips the first one.
+  Table::Cursor cursor(table_ptr.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                       {{/* col_idx */ 0, Table::Cursor::ColumnPredicate::Op::GreaterThanOrEqual,
+                         /* value */ int64_t{350}},
+                        {/* col_idx */ 0, Table::Cursor::ColumnPredicate::Op::LessThanOrEqual,
+                         /* value */ int64_t{650}}});
+  auto rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+  EXPECT_TRUE(
+      rb->ColumnAt(0)->Equals(types::ToArrow(time_batches[1], arrow::default_memory_pool())));
+  rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+  EXPECT_EQ(0, rb->num_rows());
+  EXPECT_TRUE(cursor.Done());
+}
+
+TEST(TableTest, cursor_column_projection) {
+  schema::Relation rel({types::DataType::BOOLEAN, types::DataType::INT64, types::DataType::FLOAT64},
+                       {"col1", "col2", "col3"});
+
+  std::shared_ptr<Table> table_ptr = Table::Create("test_table", rel);
+  Table& table = *table_ptr;
+
+  auto rb = schema::RowBatch(schema::RowDescriptor(rel.col_types()), 3);
+  std::vector<types::BoolValue> col1_in = {true, false, true};
+  std::vector<types::Int64Value> col2_in = {1, 2, 3};
+  std::vector<types::Float64Value> col3_in = {1.0, 2.0, 3.0};
+  EXPECT_OK(rb.AddColumn(types::ToArrow(col1_in, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(col2_in, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(col3_in, arrow::default_memory_pool())));
+  EXPECT_OK(table.WriteRowBatch(rb));
+
+  // A cursor constructed with a projection only returns the projected columns.
+  Table::Cursor cursor(table_ptr.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                       Table::Cursor::PredicateSpec{}, std::vector<int64_t>({2, 0}));
+  auto actual_rb = cursor.GetNextRowBatch().ConsumeValueOrDie();
+  ASSERT_EQ(2, actual_rb->num_columns());
+  EXPECT_TRUE(
+      actual_rb->ColumnAt(0)->Equals(types::ToArrow(col3_in, arrow::default_memory_pool())));
+  EXPECT_TRUE(
+      actual_rb->ColumnAt(1)->Equals(types::ToArrow(col1_in, arrow::default_memory_pool())));
+
+  // A cursor without an explicit projection reads all columns.
+  Table::Cursor full_cursor(table_ptr.get());
+  auto full_rb = full_cursor.GetNextRowBatch().ConsumeValueOrDie();
+  ASSERT_EQ(3, full_rb->num_columns());
+
+  // Split partitions inherit the parent cursor's projection.
+  Table::Cursor split_cursor(table_ptr.get(), Table::Cursor::StartSpec{},
+                             Table::Cursor::StopSpec{}, Table::Cursor::PredicateSpec{},
+                             std::vector<int64_t>({1}));
+  auto partitions = split_cursor.Split(1).ConsumeValueOrDie();
+  ASSERT_EQ(1, partitions.size());
+  auto partition_rb = partitions[0].GetNextRowBatch().ConsumeValueOrDie();
+  ASSERT_EQ(1, partition_rb->num_columns());
+  EXPECT_TRUE(
+      partition_rb->ColumnAt(0)->Equals(types::ToArrow(col2_in, arrow::default_memory_pool())));
+}
+
+TEST(TableTest, cursor_row_limit) {
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+
+  std::shared_ptr<Table> table_ptr = Table::Create("test_table", rel);
+  Table& table = *table_ptr;
+
+  auto rd = schema::RowDescriptor(rel.col_types());
+  std::vector<types::Int64Value> col1_in1 = {1, 2, 3};
+  auto rb1 = schema::RowBatch(rd, 3);
+  EXPECT_OK(rb1.AddColumn(types::ToArrow(col1_in1, arrow::default_memory_pool())));
+  EXPECT_OK(table.WriteRowBatch(rb1));
+  std::vector<types::Int64Value> col1_in2 = {4, 5, 6};
+  auto rb2 = schema::RowBatch(rd, 3);
+  EXPECT_OK(rb2.AddColumn(types::ToArrow(col1_in2, arrow::default_memory_pool())));
+  EXPECT_OK(table.WriteRowBatch(rb2));
+
+  Table::Cursor::StopSpec stop;
+  stop.max_rows = 4;
+  Table::Cursor cursor(table_ptr.get(), Table::Cursor::StartSpec{}, stop);
+
+  auto actual_rb = cursor.GetNextRowBatch().ConsumeValueOrDie();
+  EXPECT_TRUE(
+      actual_rb->ColumnAt(0)->Equals(types::ToArrow(col1_in1, arrow::default_memory_pool())));
+  EXPECT_FALSE(cursor.Done());
+  EXPECT_TRUE(cursor.NextBatchReady());
+
+  // The second batch is truncated to the remaining row budget, after which the cursor is
+  // exhausted.
+  actual_rb = cursor.GetNextRowBatch().ConsumeValueOrDie();
+  std::vector<types::Int64Value> expected = {4};
+  EXPECT_TRUE(
+      actual_rb->ColumnAt(0)->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+  EXPECT_TRUE(cursor.Done());
+  EXPECT_FALSE(cursor.NextBatchReady());
+
+  // A row limit also bounds an otherwise infinite cursor.
+  Table::Cursor::StopSpec infinite_stop;
+  infinite_stop.type = Table::Cursor::StopSpec::StopType::Infinite;
+  infinite_stop.max_rows = 6;
+  Table::Cursor infinite_cursor(table_ptr.get(), Table::Cursor::StartSpec{}, infinite_stop);
+  EXPECT_OK(infinite_cursor.GetNextRowBatch());
+  EXPECT_OK(infinite_cursor.GetNextRowBatch());
+  EXPECT_TRUE(infinite_cursor.Done());
+  EXPECT_FALSE(infinite_cursor.NextBatchReady());
+}
+
+TEST(TableTest, split_cursor_partitions_cover_all_rows) {
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+
+  std::shared_ptr<Table> table_ptr = Table::Create("test_table", rel);
+  Table& table = *table_ptr;
+
+  auto rd = schema::RowDescriptor(rel.col_types());
+  std::vector<types::Int64Value> expected_vals;
+  for (int64_t batch_idx = 0; batch_idx < 4; ++batch_idx) {
+    std::vector<types::Int64Value> vals;
+    for (int64_t i = 0; i < 5; ++i) {
+      vals.emplace_back(5 * batch_idx + i);
+      expected_vals.emplace_back(5 * batch_idx + i);
+    }
+    auto rb = schema::RowBatch(rd, static_cast<int64_t>(vals.size()));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(vals, arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  }
+  // Compact so the split spans both the cold and hot stores.
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+
+  Table::Cursor cursor(table_ptr.get());
+  auto partitions = cursor.Split(3).ConsumeValueOrDie();
+  ASSERT_EQ(3, partitions.size());
+  // The split consumes the original cursor.
+  EXPECT_TRUE(cursor.Done());
+
+  // Partition boundaries don't align with batch boundaries, yet each row is returned by exactly
+  // one partition and concatenating the partitions in order reproduces the full table.
+  std::vector<types::Int64Value> read_vals;
+  for (auto& partition : partitions) {
+    while (!partition.Done()) {
+      auto rb = partition.GetNextRowBatch({0}).ConsumeValueOrDie();
+      auto arr = rb->ColumnAt(0).get();
+      for (int64_t i = 0; i < arr->length(); ++i) {
+        read_vals.emplace_back(types::GetValueFromArrowArray<types::DataType::INT64>(arr, i));
+      }
+    }
+  }
+  EXPECT_TRUE(types::ToArrow(read_vals, arrow::default_memory_pool())
+                  ->Equals(types::ToArrow(expected_vals, arrow::default_memory_pool())));
+
+  // Infinite cursors can't be partitioned.
+  Table::Cursor infinite_cursor(
+      table_ptr.get(), Table::Cursor::StartSpec{},
+      Table::Cursor::StopSpec{Table::Cursor::StopSpec::StopType::Infinite, -1});
+  EXPECT_NOT_OK(infinite_cursor.Split(3));
+}
+
 struct CursorTestCase {
   std::string name;
   std::vector<std::vector<int64_t>> initial_time_batches;
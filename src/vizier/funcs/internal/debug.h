@@ -24,6 +24,7 @@
 #include "src/carnot/udf/udf.h"
 #include "src/carnot/udfspb/udfs.pb.h"
 #include "src/common/base/base.h"
+#include "src/common/perf/hot_path_profiler.h"
 #include "src/common/perf/tcmalloc.h"
 #include "src/common/system/proc_parser.h"
 #include "src/shared/types/typespb/types.pb.h"
@@ -389,6 +390,50 @@ class HeapRangesUDTF final : public carnot::udf::UDTF<HeapRangesUDTF> {
 #endif
 };
 
+class HotPathStatsUDTF final : public carnot::udf::UDTF<HotPathStatsUDTF> {
+ public:
+  static constexpr auto Executor() { return carnot::udfspb::UDTFSourceExecutor::UDTF_ALL_AGENTS; }
+
+  static constexpr auto OutputRelation() {
+    return MakeArray(
+        ColInfo("asid", types::DataType::INT64, types::PatternType::GENERAL,
+                "The short ID of the agent", types::SemanticType::ST_ASID),
+        ColInfo("marker", types::DataType::STRING, types::PatternType::GENERAL_ENUM,
+                "The name of the instrumented hot path"),
+        ColInfo("count", types::DataType::INT64, types::PatternType::METRIC_COUNTER,
+                "The number of times the hot path ran since the agent started"),
+        ColInfo("total_ns", types::DataType::INT64, types::PatternType::METRIC_COUNTER,
+                "Total time spent in the hot path since the agent started",
+                types::SemanticType::ST_DURATION_NS),
+        ColInfo("max_ns", types::DataType::INT64, types::PatternType::METRIC_GAUGE,
+                "The longest single run of the hot path",
+                types::SemanticType::ST_DURATION_NS));
+  }
+
+  Status Init(FunctionContext*) {
+    stats_ = px::profiler::HotPathProfiler::GetInstance().Collect();
+    return Status::OK();
+  }
+
+  bool NextRecord(FunctionContext* ctx, RecordWriter* rw) {
+    if (idx_ >= stats_.size()) {
+      return false;
+    }
+    const auto& marker = stats_[idx_];
+    rw->Append<IndexOf("asid")>(ctx->metadata_state()->asid());
+    rw->Append<IndexOf("marker")>(marker.name);
+    rw->Append<IndexOf("count")>(static_cast<int64_t>(marker.count));
+    rw->Append<IndexOf("total_ns")>(static_cast<int64_t>(marker.total_ns));
+    rw->Append<IndexOf("max_ns")>(static_cast<int64_t>(marker.max_ns));
+    ++idx_;
+    return idx_ < stats_.size();
+  }
+
+ private:
+  size_t idx_ = 0;
+  std::vector<px::profiler::HotPathProfiler::MarkerStats> stats_;
+};
+
 }  // namespace funcs
 }  // namespace vizier
 }  // namespace px
@@ -37,6 +37,8 @@ void RegisterFuncsOrDie(carnot::udf::Registry* registry) {
   registry->RegisterOrDie<AgentProcSMapsUDTF>("_DebugAgentProcSMaps");
 
   registry->RegisterOrDie<HeapReleaseFreeMemoryUDTF>("_HeapReleaseFreeMemory");
+
+  registry->RegisterOrDie<HotPathStatsUDTF>("_HotPathStats");
 }
 
 }  // namespace internal
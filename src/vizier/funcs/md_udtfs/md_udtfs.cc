@@ -40,6 +40,8 @@ void RegisterFuncsOrDie(const VizierFuncFactoryContext& ctx, carnot::udf::Regist
       "_DebugMDGetWithPrefix", ctx);
   registry->RegisterFactoryOrDie<GetDebugTableInfo, UDTFWithTableStoreFactory<GetDebugTableInfo>>(
       "_DebugTableInfo", ctx.table_store());
+  registry->RegisterFactoryOrDie<GetTableStats, UDTFWithTableStoreFactory<GetTableStats>>(
+      "GetTableStats", ctx.table_store());
 
   registry->RegisterFactoryOrDie<GetUDFList, UDTFWithRegistryFactory<GetUDFList>>("GetUDFList",
                                                                                   registry);
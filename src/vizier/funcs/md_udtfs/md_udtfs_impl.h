@@ -726,6 +726,94 @@ class GetDebugTableInfo final : public carnot::udf::UDTF<GetDebugTableInfo> {
   std::vector<uint64_t> table_ids_;
 };
 
+/**
+ * This UDTF exposes per-table statistics from the table store: sizes and batch counts split by
+ * hot/cold tier, row counts, the covered time range and pruning-statistic coverage. Capacity
+ * dashboards use it to tune retention, and scan-cost estimates (eg. bytes per row, bytes per
+ * unit time) can be derived directly from its columns.
+ */
+class GetTableStats final : public carnot::udf::UDTF<GetTableStats> {
+ public:
+  GetTableStats() = delete;
+  explicit GetTableStats(const ::px::table_store::TableStore* table_store)
+      : table_store_(table_store) {}
+  static constexpr auto Executor() { return carnot::udfspb::UDTFSourceExecutor::UDTF_ALL_AGENTS; }
+
+  static constexpr auto OutputRelation() {
+    return MakeArray(
+        ColInfo("asid", types::DataType::INT64, types::PatternType::GENERAL,
+                "The short ID of the agent"),
+        ColInfo("name", types::DataType::STRING, types::PatternType::GENERAL,
+                "The name of this table"),
+        ColInfo("size", types::DataType::INT64, types::PatternType::GENERAL,
+                "The size of this table in bytes"),
+        ColInfo("hot_size", types::DataType::INT64, types::PatternType::GENERAL,
+                "The number of bytes in the hot tier. This is also the compaction backlog, "
+                "since hot batches are what compaction consumes"),
+        ColInfo("cold_size", types::DataType::INT64, types::PatternType::GENERAL,
+                "The number of bytes in the cold tier"),
+        ColInfo("max_table_size", types::DataType::INT64, types::PatternType::GENERAL,
+                "The maximum size of this table in bytes"),
+        ColInfo("num_rows", types::DataType::INT64, types::PatternType::GENERAL,
+                "The number of rows currently in this table"),
+        ColInfo("num_hot_batches", types::DataType::INT64, types::PatternType::GENERAL,
+                "The number of batches in the hot tier"),
+        ColInfo("num_cold_batches", types::DataType::INT64, types::PatternType::GENERAL,
+                "The number of batches in the cold tier"),
+        ColInfo("avg_row_bytes", types::DataType::FLOAT64, types::PatternType::GENERAL,
+                "The average size of a row in bytes. 0 if the table is empty"),
+        ColInfo("min_time", types::DataType::TIME64NS, types::PatternType::GENERAL,
+                "The minimum timestamp currently present in this table. -1 if there is no time_ "
+                "column on the table or no data"),
+        ColInfo("max_time", types::DataType::TIME64NS, types::PatternType::GENERAL,
+                "The maximum timestamp currently present in this table. -1 if there is no time_ "
+                "column on the table or no data"),
+        ColInfo("zone_map_batches", types::DataType::INT64, types::PatternType::GENERAL,
+                "The number of batches with zone maps (per-column min/max statistics) computed, "
+                "i.e. batches that predicate pushdown can prune without scanning"),
+        ColInfo("bloom_filter_batches", types::DataType::INT64, types::PatternType::GENERAL,
+                "The number of batches with bloom filters built for string columns"));
+  }
+  Status Init(FunctionContext*) {
+    table_ids_ = table_store_->GetTableIDs();
+    return Status::OK();
+  }
+
+  bool NextRecord(FunctionContext* ctx, RecordWriter* rw) {
+    if (static_cast<size_t>(current_idx_) >= table_ids_.size()) {
+      return false;
+    }
+
+    uint64_t selected_id = table_ids_[current_idx_];
+    const auto* table = table_store_->GetTable(selected_id);
+    auto info = table->GetTableStats();
+
+    rw->Append<IndexOf("asid")>(ctx->metadata_state()->asid());
+    rw->Append<IndexOf("name")>(table_store_->GetTableName(selected_id));
+    rw->Append<IndexOf("size")>(info.bytes);
+    rw->Append<IndexOf("hot_size")>(info.hot_bytes);
+    rw->Append<IndexOf("cold_size")>(info.cold_bytes);
+    rw->Append<IndexOf("max_table_size")>(info.max_table_size);
+    rw->Append<IndexOf("num_rows")>(info.num_rows);
+    rw->Append<IndexOf("num_hot_batches")>(info.num_hot_batches);
+    rw->Append<IndexOf("num_cold_batches")>(info.num_cold_batches);
+    rw->Append<IndexOf("avg_row_bytes")>(
+        info.num_rows > 0 ? static_cast<double>(info.bytes) / info.num_rows : 0.0);
+    rw->Append<IndexOf("min_time")>(info.min_time);
+    rw->Append<IndexOf("max_time")>(info.max_time);
+    rw->Append<IndexOf("zone_map_batches")>(info.zone_map_batches);
+    rw->Append<IndexOf("bloom_filter_batches")>(info.bloom_filter_batches);
+
+    ++current_idx_;
+    return static_cast<size_t>(current_idx_) < table_ids_.size();
+  }
+
+ private:
+  const ::px::table_store::TableStore* table_store_;
+  int current_idx_ = 0;
+  std::vector<uint64_t> table_ids_;
+};
+
 /**
  * This UDTF fetches information about tracepoints from MDS.
  */
@@ -29,7 +29,7 @@ Status KelvinManager::InitImpl() { return Status::OK(); }
 
 Status KelvinManager::PostRegisterHookImpl() {
   auto execute_query_handler = std::make_shared<ExecuteQueryMessageHandler>(
-      dispatcher(), info(), agent_nats_connector(), carnot());
+      dispatcher(), info(), agent_nats_connector(), carnot(), worker_loops());
   PL_RETURN_IF_ERROR(RegisterMessageHandler(messages::VizierMessage::MsgCase::kExecuteQueryRequest,
                                             execute_query_handler));
 
@@ -22,6 +22,7 @@
 #include <string>
 #include <utility>
 
+#include <absl/hash/hash.h>
 #include <jwt/jwt.hpp>
 
 #include "src/common/base/base.h"
@@ -78,15 +79,40 @@ class ExecuteQueryMessageHandler::ExecuteQueryTask : public AsyncTask {
 ExecuteQueryMessageHandler::ExecuteQueryMessageHandler(px::event::Dispatcher* dispatcher,
                                                        Info* agent_info,
                                                        Manager::VizierNATSConnector* nats_conn,
-                                                       carnot::Carnot* carnot)
-    : MessageHandler(dispatcher, agent_info, nats_conn), carnot_(carnot) {}
+                                                       carnot::Carnot* carnot,
+                                                       px::event::MultiLoopDispatcher* exec_loops)
+    : MessageHandler(dispatcher, agent_info, nats_conn), carnot_(carnot), exec_loops_(exec_loops) {}
 
 Status ExecuteQueryMessageHandler::HandleMessage(std::unique_ptr<messages::VizierMessage> msg) {
+  // Report the tables this plan reads, so the data collector can prioritize them.
+  if (queried_tables_callback_) {
+    auto tables = ExtractQueriedTables(msg->execute_query_request().plan());
+    if (!tables.empty()) {
+      queried_tables_callback_(std::move(tables));
+    }
+  }
+
   // Create a task and run it on the threadpool.
   auto task = std::make_unique<ExecuteQueryTask>(this, carnot_, std::move(msg));
 
   auto query_id = task->query_id();
-  auto runnable = dispatcher()->CreateAsyncTask(std::move(task));
+  // With a worker pool, execute on the loop that owns this query ID, so any future messages for
+  // the same query are ordered behind it; Done still runs on the main dispatcher thread.
+  auto runnable = exec_loops_ != nullptr
+                      ? exec_loops_->CreateAsyncTask(absl::Hash<sole::uuid>{}(query_id),
+                                                     std::move(task), dispatcher())
+                      : dispatcher()->CreateAsyncTask(std::move(task));
+
+  // Until the query broker forwards a priority class with the request, all queries are admitted
+  // at dashboard priority; the scheduler still bounds total concurrency.
+  PL_ASSIGN_OR_RETURN(bool start_now,
+                      scheduler_.Submit(query_id, QueryScheduler::Priority::kDashboard));
+  if (!start_now) {
+    LOG(INFO) << absl::Substitute("Queued query: id=$0", query_id.str());
+    queued_queries_[query_id] = std::move(runnable);
+    return Status::OK();
+  }
+
   auto runnable_ptr = runnable.get();
   LOG(INFO) << "Queries in flight: " << running_queries_.size();
   running_queries_[query_id] = std::move(runnable);
@@ -103,6 +129,30 @@ void ExecuteQueryMessageHandler::HandleQueryExecutionComplete(sole::uuid query_i
     return;
   }
   dispatcher()->DeferredDelete(std::move(node.mapped()));
+
+  // Start any queued queries that the freed slot admits, in priority order.
+  for (const auto& next_id : scheduler_.OnQueryComplete(query_id)) {
+    auto queued = queued_queries_.extract(next_id);
+    if (queued.empty()) {
+      LOG(ERROR) << "Scheduler released a query with no queued task: " << next_id.str();
+      continue;
+    }
+    auto* runnable_ptr = queued.mapped().get();
+    running_queries_[next_id] = std::move(queued.mapped());
+    runnable_ptr->Run();
+  }
+}
+
+absl::flat_hash_set<std::string> ExtractQueriedTables(const carnot::planpb::Plan& plan) {
+  absl::flat_hash_set<std::string> tables;
+  for (const auto& fragment : plan.nodes()) {
+    for (const auto& node : fragment.nodes()) {
+      if (node.op().op_type() == carnot::planpb::MEMORY_SOURCE_OPERATOR) {
+        tables.insert(node.op().mem_source_op().name());
+      }
+    }
+  }
+  return tables;
 }
 
 }  // namespace agent
@@ -18,11 +18,18 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include "src/carnot/plan/plan.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/common/event/multi_loop_dispatcher.h"
 #include "src/vizier/services/agent/manager/manager.h"
+#include "src/vizier/services/agent/manager/query_scheduler.h"
 
 namespace px {
 namespace vizier {
@@ -37,13 +44,29 @@ namespace agent {
  */
 class ExecuteQueryMessageHandler : public Manager::MessageHandler {
  public:
+  using QueriedTablesCallback = std::function<void(absl::flat_hash_set<std::string>)>;
+
   ExecuteQueryMessageHandler() = delete;
+  /**
+   * If exec_loops is non-null, query tasks run on that worker pool, keyed by query ID so work
+   * for the same query stays ordered on one loop. Otherwise they run on the dispatcher's shared
+   * libuv thread pool. Done callbacks always run on the dispatcher thread either way.
+   */
   ExecuteQueryMessageHandler(px::event::Dispatcher* dispatcher, Info* agent_info,
-                             Manager::VizierNATSConnector* nats_conn, carnot::Carnot* carnot);
+                             Manager::VizierNATSConnector* nats_conn, carnot::Carnot* carnot,
+                             px::event::MultiLoopDispatcher* exec_loops = nullptr);
   ~ExecuteQueryMessageHandler() override = default;
 
   Status HandleMessage(std::unique_ptr<messages::VizierMessage> msg) override;
 
+  /**
+   * Registers a callback invoked with the source table names of every executed plan. PEMs use
+   * this to drive Stirling's query-aware sampling of its tables.
+   */
+  void RegisterQueriedTablesCallback(QueriedTablesCallback cb) {
+    queried_tables_callback_ = std::move(cb);
+  }
+
  protected:
   /**
    * HandleQueryExecutionComplete can be called by the async task to signal that work has been
@@ -57,10 +80,27 @@ class ExecuteQueryMessageHandler : public Manager::MessageHandler {
 
   carnot::Carnot* carnot_;
 
+  // Worker loop pool for query execution, or nullptr to use the shared libuv thread pool.
+  px::event::MultiLoopDispatcher* exec_loops_;
+
+  // Admits queries by priority class; driven from the dispatcher thread only.
+  QueryScheduler scheduler_;
+
   // Map from query_id -> Running query task.
   absl::flat_hash_map<sole::uuid, px::event::RunnableAsyncTaskUPtr> running_queries_;
+
+  // Map from query_id -> task admitted by the scheduler but not yet started.
+  absl::flat_hash_map<sole::uuid, px::event::RunnableAsyncTaskUPtr> queued_queries_;
+
+  // Invoked with the source tables of each executed plan, if registered.
+  QueriedTablesCallback queried_tables_callback_;
 };
 
+/**
+ * Returns the names of the tables read by the plan's memory sources.
+ */
+absl::flat_hash_set<std::string> ExtractQueriedTables(const carnot::planpb::Plan& plan);
+
 }  // namespace agent
 }  // namespace vizier
 }  // namespace px
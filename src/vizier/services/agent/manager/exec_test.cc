@@ -0,0 +1,81 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/vizier/services/agent/manager/exec.h"
+
+#include <google/protobuf/text_format.h>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace vizier {
+namespace agent {
+
+constexpr char kTwoSourcePlan[] = R"proto(
+nodes {
+  id: 1
+  nodes {
+    id: 1
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op { name: "http_events" }
+    }
+  }
+  nodes {
+    id: 2
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op { name: "process_stats" }
+    }
+  }
+  nodes {
+    id: 3
+    op {
+      op_type: MEMORY_SINK_OPERATOR
+      mem_sink_op { name: "out" }
+    }
+  }
+}
+nodes {
+  id: 2
+  nodes {
+    id: 4
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op { name: "http_events" }
+    }
+  }
+}
+)proto";
+
+TEST(ExtractQueriedTablesTest, collects_memory_source_tables) {
+  carnot::planpb::Plan plan;
+  ASSERT_TRUE(google::protobuf::TextFormat::ParseFromString(kTwoSourcePlan, &plan));
+
+  auto tables = ExtractQueriedTables(plan);
+  EXPECT_THAT(tables, ::testing::UnorderedElementsAre("http_events", "process_stats"));
+}
+
+TEST(ExtractQueriedTablesTest, empty_plan) {
+  carnot::planpb::Plan plan;
+  EXPECT_TRUE(ExtractQueriedTables(plan).empty());
+}
+
+}  // namespace agent
+}  // namespace vizier
+}  // namespace px
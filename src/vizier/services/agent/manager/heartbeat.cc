@@ -77,7 +77,10 @@ Status HeartbeatMessageHandler::SendHeartbeatInternal() {
 
   heartbeat_info_.last_sent_seq_num++;
 
-  last_sent_hb_ = std::make_unique<messages::VizierMessage>();
+  // The previous heartbeat has been acked: recycle its arena block for the new one.
+  last_sent_hb_ = nullptr;
+  hb_arena_.Reset();
+  last_sent_hb_ = google::protobuf::Arena::CreateMessage<messages::VizierMessage>(&hb_arena_);
 
   auto& req = *last_sent_hb_;
   auto hb = req.mutable_heartbeat();
@@ -111,6 +114,13 @@ Status HeartbeatMessageHandler::SendHeartbeatInternal() {
     last_metadata_epoch_id_ = current_epoch;
   }
 
+  // When nothing has changed since the last heartbeat, send a bare liveness heartbeat rather
+  // than repeating the update info. The receiver treats a missing update_info as "no changes".
+  if (update_info->process_created_size() == 0 && update_info->process_terminated_size() == 0 &&
+      update_info->schema_size() == 0 && !update_info->has_data()) {
+    hb->clear_update_info();
+  }
+
   VLOG(1) << "Sending heartbeat message: " << req.DebugString();
   heartbeat_info_.last_heartbeat_send_time_ = time_source_.MonotonicTime();
 
@@ -20,6 +20,8 @@
 
 #include <memory>
 
+#include <google/protobuf/arena.h>
+
 #include "src/vizier/services/agent/manager/manager.h"
 
 namespace px {
@@ -61,7 +63,12 @@ class HeartbeatMessageHandler : public Manager::MessageHandler {
     std::chrono::steady_clock::time_point last_heartbeat_send_time_;
   };
 
-  std::unique_ptr<px::vizier::messages::VizierMessage> last_sent_hb_;
+  // The heartbeat (and its update info: process lists, schema, metadata filter) is built on an
+  // arena that is reset each beat, so steady-state heartbeats reuse the same allocation instead
+  // of churning the heap. The message is owned by the arena; it stays alive until the next
+  // beat so un-acked heartbeats can be resent.
+  google::protobuf::Arena hb_arena_;
+  px::vizier::messages::VizierMessage* last_sent_hb_ = nullptr;
   int64_t last_metadata_epoch_id_ = 0;
   bool sent_schema_ = false;
 
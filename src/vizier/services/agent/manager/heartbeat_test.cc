@@ -304,6 +304,29 @@ TEST_F(HeartbeatMessageHandlerTest, HandleHeartbeatRelationUpdates) {
   EXPECT_EQ(3, hb.update_info().schema().size());
 }
 
+TEST_F(HeartbeatMessageHandlerTest, HandleHeartbeatNoChanges) {
+  // The first heartbeat carries the schema and metadata info.
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(1, nats_conn_->published_msgs().size());
+  auto hb = nats_conn_->published_msgs()[0].heartbeat();
+  EXPECT_EQ(0, hb.sequence_number());
+  EXPECT_TRUE(hb.has_update_info());
+
+  auto hb_ack = std::make_unique<messages::VizierMessage>();
+  hb_ack->mutable_heartbeat_ack()->set_sequence_number(0);
+  EXPECT_OK(heartbeat_handler_->HandleMessage(std::move(hb_ack)));
+
+  // With no PID events, schema updates, or metadata filter changes, subsequent heartbeats are
+  // bare liveness messages without update info.
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::milliseconds(5001));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+
+  EXPECT_EQ(2, nats_conn_->published_msgs().size());
+  hb = nats_conn_->published_msgs()[1].heartbeat();
+  EXPECT_EQ(1, hb.sequence_number());
+  EXPECT_FALSE(hb.has_update_info());
+}
+
 class HeartbeatNackMessageHandlerTest : public ::testing::Test {
  protected:
   void TearDown() override { dispatcher_->Exit(); }
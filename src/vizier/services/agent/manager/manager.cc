@@ -65,6 +65,11 @@ DEFINE_string(vizier_id, gflags::StringFromEnv("PL_VIZIER_ID", ""), "The ID of t
 DEFINE_string(vizier_name, gflags::StringFromEnv("PL_VIZIER_NAME", ""),
               "The name of the cluster according to vizier.");
 
+DEFINE_int32(agent_worker_loops, gflags::Int32FromEnv("PL_AGENT_WORKER_LOOPS", 0),
+             "Number of worker event loops the agent runs alongside its main loop. Query "
+             "execution is fanned out across them, keyed by query ID. 0 disables the pool, "
+             "running queries on the shared libuv thread pool instead.");
+
 namespace px {
 namespace vizier {
 namespace agent {
@@ -137,6 +142,11 @@ Manager::Manager(sole::uuid agent_id, std::string_view pod_name, std::string_vie
   info_.capabilities = std::move(capabilities);
   info_.pod_name = std::string(pod_name);
   info_.host_ip = std::string(host_ip);
+
+  if (FLAGS_agent_worker_loops > 0) {
+    worker_loops_ = std::make_unique<px::event::MultiLoopDispatcher>(api_.get(), "agent_worker",
+                                                                     FLAGS_agent_worker_loops);
+  }
 }
 
 Status Manager::Init() {
@@ -191,6 +201,9 @@ Status Manager::Init() {
 
 Status Manager::Run() {
   running_ = true;
+  if (worker_loops_) {
+    worker_loops_->Run();
+  }
   dispatcher_->Run(px::event::Dispatcher::RunType::Block);
   running_ = false;
   return Status::OK();
@@ -203,6 +216,16 @@ Status Manager::Stop(std::chrono::milliseconds timeout) {
   }
   stop_called_ = true;
 
+  if (tablestore_compaction_manager_) {
+    tablestore_compaction_manager_->Stop();
+  }
+
+  // Stop the worker pool before the main dispatcher: Stop() joins the workers, so by the time it
+  // returns, every completion callback they post at the main loop has already been queued.
+  if (worker_loops_) {
+    worker_loops_->Stop();
+  }
+
   dispatcher_->Stop();
   auto s = StopImpl(timeout);
 
@@ -223,7 +246,11 @@ Status Manager::RegisterBackgroundHelpers() {
       metadata_update_timer_->EnableTimer(std::chrono::seconds(5));
     }
   });
-  metadata_update_timer_->EnableTimer(std::chrono::seconds(5));
+  // Run the first update immediately rather than a full period from now: Stirling starts
+  // tracing as soon as registration completes, and resolving the UPIDs in its records needs an
+  // initial metadata state. Waiting the full period here delays the first usable data by that
+  // much on every agent start.
+  metadata_update_timer_->EnableTimer(std::chrono::seconds(0));
 
   chan_cache_garbage_collect_timer_ = dispatcher_->CreateTimer([this]() {
     VLOG(1) << "GRPC channel cache garbage collection";
@@ -335,12 +362,17 @@ Status Manager::PostRegisterHook(uint32_t asid) {
     PL_RETURN_IF_ERROR(metrics_nats_connector_->Connect(dispatcher_.get()));
   }
 
+  // TODO(james): when we change ExecState::exec_mem_pool to not return just the default pool, we
+  // will need to figure out how to use the correct memory pool here, but for now we can just use
+  // the default pool.
+  tablestore_compaction_manager_ = std::make_unique<table_store::AsyncCompactionManager>(
+      table_store(), arrow::default_memory_pool());
+  tablestore_compaction_manager_->Start();
+  // The timer only scans for tables with compactable data and enqueues them; the compaction
+  // itself runs on the AsyncCompactionManager's low-priority worker threads, so data ingest on
+  // this thread is never stalled by compaction.
   tablestore_compaction_timer_ = dispatcher()->CreateTimer([this]() {
-    // TODO(james): when we change ExecState::exec_mem_pool to not return just the default pool, we
-    // will need to figure out how to use the correct memory pool here, but for now we can just use
-    // the default pool.
-    auto status = table_store()->RunCompaction(arrow::default_memory_pool());
-    LOG_IF(ERROR, !status.ok()) << status.msg();
+    tablestore_compaction_manager_->SchedulePass();
     if (tablestore_compaction_timer_) {
       tablestore_compaction_timer_->EnableTimer(kTableStoreCompactionPeriod);
     }
@@ -420,6 +452,11 @@ std::unique_ptr<Manager::ResultSinkStub> Manager::ResultSinkStubGenerator(
   args.SetInt(GRPC_ARG_HTTP2_BDP_PROBE, 1);
   args.SetInt(GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS, 50000);
   args.SetInt(GRPC_ARG_HTTP2_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS, 100000);
+  // These channels persist across queries (see chan_cache_), with each query's result streams
+  // multiplexed on one HTTP/2 connection. A larger HPACK table lets the per-stream metadata
+  // repeated on every stream (notably the auth token) be indexed once per connection.
+  args.SetInt(GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_ENCODER, 64 * 1024);
+  args.SetInt(GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER, 64 * 1024);
 
   chan = grpc::CreateCustomChannel(remote_addr, grpc_channel_creds_, args);
   chan_cache_->Add(remote_addr, chan);
@@ -28,10 +28,12 @@
 #include "src/carnot/carnot.h"
 #include "src/common/base/base.h"
 #include "src/common/event/event.h"
+#include "src/common/event/multi_loop_dispatcher.h"
 #include "src/common/event/nats.h"
 #include "src/common/metrics/memory_metrics.h"
 #include "src/common/uuid/uuid.h"
 #include "src/shared/metadata/metadata.h"
+#include "src/table_store/table/async_compaction_manager.h"
 #include "src/vizier/funcs/context/vizier_context.h"
 #include "src/vizier/messages/messagespb/messages.pb.h"
 #include "src/vizier/services/agent/manager/chan_cache.h"
@@ -163,6 +165,9 @@ class Manager : public px::NotCopyable {
   px::md::AgentMetadataStateManager* mds_manager() { return mds_manager_.get(); }
   RelationInfoManager* relation_info_manager() { return relation_info_manager_.get(); }
   px::event::Dispatcher* dispatcher() { return dispatcher_.get(); }
+  // Worker loop pool for fanning independent work out of the main event loop.
+  // Returns nullptr when --agent_worker_loops is 0.
+  px::event::MultiLoopDispatcher* worker_loops() { return worker_loops_.get(); }
   carnot::Carnot* carnot() { return carnot_.get(); }
   const Info* info() const { return &info_; }
   Info* info() { return &info_; }
@@ -216,6 +221,9 @@ class Manager : public px::NotCopyable {
 
   Info info_;
   px::event::DispatcherUPtr dispatcher_;
+  // Pool of worker event loops. Thread-unsafe agent state stays on dispatcher_; handlers fan
+  // independent work (e.g. query execution) out to these loops, keyed so related work is ordered.
+  px::event::MultiLoopDispatcherUPtr worker_loops_;
   const std::string nats_addr_;
   // NATS connector for subscribing to and publishing agent updates.
   std::unique_ptr<VizierNATSConnector> agent_nats_connector_;
@@ -237,6 +245,8 @@ class Manager : public px::NotCopyable {
 
   // Timer to manage table store compaction.
   px::event::TimerUPtr tablestore_compaction_timer_;
+  // Background thread pool that runs the compaction work scheduled by the timer.
+  std::unique_ptr<table_store::AsyncCompactionManager> tablestore_compaction_manager_;
 
   px::metrics::MemoryMetrics memory_metrics_;
   // Timer to collect MemoryMetrics for this agent.
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/vizier/services/agent/manager/nats_message_batcher.h"
+
+#include <utility>
+
+namespace px {
+namespace vizier {
+namespace agent {
+
+NATSMessageBatcher::NATSMessageBatcher(px::event::Dispatcher* dispatcher,
+                                       Manager::VizierNATSConnector* nats_conn,
+                                       std::chrono::milliseconds flush_interval)
+    : nats_conn_(nats_conn),
+      flush_interval_(flush_interval),
+      flush_timer_(dispatcher->CreateTimer(std::bind(&NATSMessageBatcher::Flush, this))) {}
+
+void NATSMessageBatcher::Publish(const std::string& coalescing_key,
+                                 std::unique_ptr<messages::VizierMessage> msg) {
+  auto [it, inserted] = pending_.insert_or_assign(coalescing_key, std::move(msg));
+  PL_UNUSED(it);
+  if (inserted) {
+    pending_order_.push_back(coalescing_key);
+  }
+  // The timer is one-shot; it is re-armed by the first message queued after a flush.
+  if (!flush_timer_->Enabled()) {
+    flush_timer_->EnableTimer(flush_interval_);
+  }
+}
+
+void NATSMessageBatcher::Flush() {
+  for (const auto& key : pending_order_) {
+    auto it = pending_.find(key);
+    DCHECK(it != pending_.end());
+    auto s = nats_conn_->Publish(*it->second);
+    if (!s.ok()) {
+      LOG(ERROR) << absl::Substitute("Failed to publish batched NATS message (key=$0): $1", key,
+                                     s.msg());
+    }
+  }
+  pending_.clear();
+  pending_order_.clear();
+  flush_timer_->DisableTimer();
+}
+
+}  // namespace agent
+}  // namespace vizier
+}  // namespace px
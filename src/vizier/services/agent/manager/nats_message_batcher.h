@@ -0,0 +1,77 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/vizier/services/agent/manager/manager.h"
+
+namespace px {
+namespace vizier {
+namespace agent {
+
+/**
+ * NATSMessageBatcher coalesces non-latency-critical outbound NATS messages.
+ *
+ * Messages are held until the flush interval elapses rather than being published immediately.
+ * Messages queued with the same coalescing key replace any pending message for that key, so only
+ * the most recent state is sent. This cuts the NATS message rate for chatty senders (e.g. status
+ * updates that flap within a flush window) at the cost of up to one flush interval of latency.
+ *
+ * Not thread-safe: like the message handlers, it must only be driven from the dispatcher thread.
+ */
+class NATSMessageBatcher : public NotCopyable {
+ public:
+  static constexpr std::chrono::milliseconds kDefaultFlushInterval{1000};
+
+  NATSMessageBatcher() = delete;
+  NATSMessageBatcher(px::event::Dispatcher* dispatcher, Manager::VizierNATSConnector* nats_conn,
+                     std::chrono::milliseconds flush_interval = kDefaultFlushInterval);
+
+  /**
+   * Queues a message to be published on the next flush. If a message with the same coalescing
+   * key is already pending, the new message replaces it, keeping the original send order.
+   */
+  void Publish(const std::string& coalescing_key,
+               std::unique_ptr<messages::VizierMessage> msg);
+
+  /**
+   * Publishes all pending messages immediately, in the order their keys were first queued.
+   */
+  void Flush();
+
+  size_t num_pending() const { return pending_.size(); }
+
+ private:
+  Manager::VizierNATSConnector* nats_conn_;
+  const std::chrono::milliseconds flush_interval_;
+  px::event::TimerUPtr flush_timer_;
+
+  // Keys in first-queued order, so coalesced replacements do not reorder sends.
+  std::vector<std::string> pending_order_;
+  absl::flat_hash_map<std::string, std::unique_ptr<messages::VizierMessage>> pending_;
+};
+
+}  // namespace agent
+}  // namespace vizier
+}  // namespace px
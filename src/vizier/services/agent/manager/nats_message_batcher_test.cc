@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/vizier/services/agent/manager/nats_message_batcher.h"
+
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "src/common/event/api_impl.h"
+#include "src/common/event/nats.h"
+#include "src/common/testing/event/simulated_time_system.h"
+#include "src/common/testing/testing.h"
+#include "src/vizier/services/agent/manager/test_utils.h"
+
+namespace px {
+namespace vizier {
+namespace agent {
+
+namespace {
+std::unique_ptr<messages::VizierMessage> MakeHeartbeatMsg(int64_t seq) {
+  auto msg = std::make_unique<messages::VizierMessage>();
+  msg->mutable_heartbeat()->set_sequence_number(seq);
+  return msg;
+}
+}  // namespace
+
+class NATSMessageBatcherTest : public ::testing::Test {
+ protected:
+  void TearDown() override { dispatcher_->Exit(); }
+
+  NATSMessageBatcherTest() {
+    start_monotonic_time_ = std::chrono::steady_clock::now();
+    start_system_time_ = std::chrono::system_clock::now();
+    time_system_ =
+        std::make_unique<event::SimulatedTimeSystem>(start_monotonic_time_, start_system_time_);
+    api_ = std::make_unique<px::event::APIImpl>(time_system_.get());
+    dispatcher_ = api_->AllocateDispatcher("manager");
+    nats_conn_ = std::make_unique<FakeNATSConnector<px::vizier::messages::VizierMessage>>();
+
+    batcher_ = std::make_unique<NATSMessageBatcher>(dispatcher_.get(), nats_conn_.get(),
+                                                    std::chrono::milliseconds(1000));
+  }
+
+  event::MonotonicTimePoint start_monotonic_time_;
+  event::SystemTimePoint start_system_time_;
+  std::unique_ptr<event::SimulatedTimeSystem> time_system_;
+  std::unique_ptr<event::APIImpl> api_;
+  std::unique_ptr<event::Dispatcher> dispatcher_;
+  std::unique_ptr<FakeNATSConnector<px::vizier::messages::VizierMessage>> nats_conn_;
+  std::unique_ptr<NATSMessageBatcher> batcher_;
+};
+
+TEST_F(NATSMessageBatcherTest, flushes_after_interval) {
+  batcher_->Publish("key0", MakeHeartbeatMsg(0));
+  EXPECT_EQ(1, batcher_->num_pending());
+  EXPECT_EQ(0, nats_conn_->published_msgs().size());
+
+  // Nothing is sent before the flush interval elapses.
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::milliseconds(500));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(0, nats_conn_->published_msgs().size());
+
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::milliseconds(1001));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+  ASSERT_EQ(1, nats_conn_->published_msgs().size());
+  EXPECT_EQ(0, nats_conn_->published_msgs()[0].heartbeat().sequence_number());
+  EXPECT_EQ(0, batcher_->num_pending());
+}
+
+TEST_F(NATSMessageBatcherTest, coalesces_same_key) {
+  batcher_->Publish("key0", MakeHeartbeatMsg(0));
+  batcher_->Publish("key1", MakeHeartbeatMsg(1));
+  // This replaces the pending message for key0, but keeps its original send order.
+  batcher_->Publish("key0", MakeHeartbeatMsg(2));
+  EXPECT_EQ(2, batcher_->num_pending());
+
+  batcher_->Flush();
+  ASSERT_EQ(2, nats_conn_->published_msgs().size());
+  EXPECT_EQ(2, nats_conn_->published_msgs()[0].heartbeat().sequence_number());
+  EXPECT_EQ(1, nats_conn_->published_msgs()[1].heartbeat().sequence_number());
+  EXPECT_EQ(0, batcher_->num_pending());
+}
+
+TEST_F(NATSMessageBatcherTest, timer_rearms_after_flush) {
+  batcher_->Publish("key0", MakeHeartbeatMsg(0));
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::milliseconds(1001));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+  ASSERT_EQ(1, nats_conn_->published_msgs().size());
+
+  // A message queued after a flush is held for a full flush interval again.
+  batcher_->Publish("key0", MakeHeartbeatMsg(1));
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::milliseconds(1500));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(1, nats_conn_->published_msgs().size());
+
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::milliseconds(2002));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+  ASSERT_EQ(2, nats_conn_->published_msgs().size());
+  EXPECT_EQ(1, nats_conn_->published_msgs()[1].heartbeat().sequence_number());
+}
+
+}  // namespace agent
+}  // namespace vizier
+}  // namespace px
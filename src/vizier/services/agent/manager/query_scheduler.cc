@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/vizier/services/agent/manager/query_scheduler.h"
+
+#include <utility>
+
+namespace px {
+namespace vizier {
+namespace agent {
+
+StatusOr<bool> QueryScheduler::Submit(const sole::uuid& query_id, Priority priority) {
+  size_t cls = static_cast<size_t>(priority);
+  const ClassLimits& limits = limits_.classes[cls];
+
+  if (running_per_class_[cls] < limits.max_concurrent) {
+    ++running_per_class_[cls];
+    running_[query_id] = priority;
+    return true;
+  }
+
+  if (queued_per_class_[cls].size() >= static_cast<size_t>(limits.max_queued)) {
+    return error::ResourceUnavailable(
+        "Query queue for priority class $0 is full ($1 queued); rejecting query $2.", cls,
+        limits.max_queued, query_id.str());
+  }
+
+  queued_per_class_[cls].push_back(query_id);
+  return false;
+}
+
+std::vector<sole::uuid> QueryScheduler::OnQueryComplete(const sole::uuid& query_id) {
+  auto node = running_.extract(query_id);
+  if (node.empty()) {
+    LOG(ERROR) << "Completion for query not tracked by the scheduler: " << query_id.str();
+    return {};
+  }
+  --running_per_class_[static_cast<size_t>(node.mapped())];
+
+  // Start queued queries in strict priority order, wherever slots are now free. A completion
+  // frees one slot, but scan all classes in case limits were under-filled.
+  std::vector<sole::uuid> to_start;
+  for (size_t cls = kNumPriorities; cls-- > 0;) {
+    auto& queue = queued_per_class_[cls];
+    while (!queue.empty() && running_per_class_[cls] < limits_.classes[cls].max_concurrent) {
+      sole::uuid next = queue.front();
+      queue.pop_front();
+      ++running_per_class_[cls];
+      running_[next] = static_cast<Priority>(cls);
+      to_start.push_back(next);
+    }
+  }
+  return to_start;
+}
+
+}  // namespace agent
+}  // namespace vizier
+}  // namespace px
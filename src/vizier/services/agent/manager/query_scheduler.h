@@ -0,0 +1,106 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+#include <sole.hpp>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace vizier {
+namespace agent {
+
+/**
+ * QueryScheduler admits query executions by priority class, so an expensive ad-hoc query cannot
+ * starve the standing alerting scripts.
+ *
+ * Each class has a concurrency limit. A submitted query starts immediately if its class has a
+ * free slot; otherwise it queues FIFO within its class. When a running query completes, queued
+ * queries are started in strict priority order (alerting before dashboards before ad-hoc).
+ * Queues are bounded, and submissions to a full queue are rejected so the caller can fail the
+ * query instead of building an unbounded backlog.
+ *
+ * The scheduler is not thread-safe: like the rest of the message handlers, it is driven
+ * entirely from the agent's dispatcher thread.
+ */
+class QueryScheduler : public NotCopyable {
+ public:
+  enum class Priority {
+    kAdHoc = 0,
+    kDashboard = 1,
+    kAlerting = 2,
+  };
+  static constexpr size_t kNumPriorities = 3;
+
+  struct ClassLimits {
+    int max_concurrent;
+    int max_queued;
+  };
+
+  struct Limits {
+    // Indexed by Priority.
+    std::array<ClassLimits, kNumPriorities> classes;
+  };
+
+  // Alerting gets the most slots so standing scripts keep their SLO; ad-hoc analyst load gets
+  // the fewest and the shortest queue.
+  static constexpr Limits kDefaultLimits = {{{
+      /* kAdHoc */ {2, 16},
+      /* kDashboard */ {4, 32},
+      /* kAlerting */ {4, 64},
+  }}};
+
+  explicit QueryScheduler(const Limits& limits = kDefaultLimits) : limits_(limits) {}
+
+  /**
+   * Admits a query. Returns true if the query may start now, false if it was queued, or an
+   * error if its class queue is full (the query should be failed).
+   */
+  StatusOr<bool> Submit(const sole::uuid& query_id, Priority priority);
+
+  /**
+   * Marks a previously started query complete and returns the queued queries (if any) that may
+   * start in its place, in priority order.
+   */
+  std::vector<sole::uuid> OnQueryComplete(const sole::uuid& query_id);
+
+  int num_running(Priority priority) const {
+    return running_per_class_[static_cast<size_t>(priority)];
+  }
+  size_t num_queued(Priority priority) const {
+    return queued_per_class_[static_cast<size_t>(priority)].size();
+  }
+
+ private:
+  const Limits limits_;
+
+  std::array<int, kNumPriorities> running_per_class_ = {};
+  std::array<std::deque<sole::uuid>, kNumPriorities> queued_per_class_;
+  // Class of each running query, so completions free the right slot.
+  absl::flat_hash_map<sole::uuid, Priority> running_;
+};
+
+}  // namespace agent
+}  // namespace vizier
+}  // namespace px
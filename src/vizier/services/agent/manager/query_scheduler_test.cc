@@ -0,0 +1,115 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/vizier/services/agent/manager/query_scheduler.h"
+
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace vizier {
+namespace agent {
+
+using Priority = QueryScheduler::Priority;
+
+namespace {
+QueryScheduler::Limits TestLimits() {
+  // One slot per class with short queues, to make admission decisions easy to exercise.
+  return QueryScheduler::Limits{{{
+      /* kAdHoc */ {1, 2},
+      /* kDashboard */ {1, 2},
+      /* kAlerting */ {1, 2},
+  }}};
+}
+}  // namespace
+
+TEST(QuerySchedulerTest, starts_within_concurrency_limit) {
+  QueryScheduler scheduler(TestLimits());
+
+  auto q1 = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(q1, Priority::kAdHoc), true);
+  EXPECT_EQ(scheduler.num_running(Priority::kAdHoc), 1);
+
+  // The class is at its limit, so the next query queues.
+  auto q2 = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(q2, Priority::kAdHoc), false);
+  EXPECT_EQ(scheduler.num_queued(Priority::kAdHoc), 1U);
+
+  // Other classes are unaffected.
+  auto q3 = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(q3, Priority::kAlerting), true);
+
+  // Completing q1 releases the queued ad-hoc query.
+  auto to_start = scheduler.OnQueryComplete(q1);
+  ASSERT_EQ(to_start.size(), 1U);
+  EXPECT_EQ(to_start[0], q2);
+  EXPECT_EQ(scheduler.num_running(Priority::kAdHoc), 1);
+  EXPECT_EQ(scheduler.num_queued(Priority::kAdHoc), 0U);
+}
+
+TEST(QuerySchedulerTest, rejects_when_queue_full) {
+  QueryScheduler scheduler(TestLimits());
+
+  ASSERT_OK_AND_EQ(scheduler.Submit(sole::uuid4(), Priority::kAdHoc), true);
+  ASSERT_OK_AND_EQ(scheduler.Submit(sole::uuid4(), Priority::kAdHoc), false);
+  ASSERT_OK_AND_EQ(scheduler.Submit(sole::uuid4(), Priority::kAdHoc), false);
+
+  auto s = scheduler.Submit(sole::uuid4(), Priority::kAdHoc);
+  ASSERT_NOT_OK(s);
+  EXPECT_TRUE(error::IsResourceUnavailable(s.status()));
+}
+
+TEST(QuerySchedulerTest, releases_in_priority_order) {
+  // A single shared view of priority: alerting drains before dashboards, which drain before
+  // ad-hoc, regardless of submission order.
+  QueryScheduler scheduler(TestLimits());
+
+  auto running_adhoc = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(running_adhoc, Priority::kAdHoc), true);
+  auto running_dash = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(running_dash, Priority::kDashboard), true);
+  auto running_alert = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(running_alert, Priority::kAlerting), true);
+
+  auto queued_adhoc = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(queued_adhoc, Priority::kAdHoc), false);
+  auto queued_alert = sole::uuid4();
+  ASSERT_OK_AND_EQ(scheduler.Submit(queued_alert, Priority::kAlerting), false);
+
+  // Completing queries frees one slot in each class; the released list is priority-ordered.
+  auto released = scheduler.OnQueryComplete(running_alert);
+  ASSERT_EQ(released.size(), 1U);
+  EXPECT_EQ(released[0], queued_alert);
+
+  released = scheduler.OnQueryComplete(running_adhoc);
+  ASSERT_EQ(released.size(), 1U);
+  EXPECT_EQ(released[0], queued_adhoc);
+
+  // Nothing left to release.
+  EXPECT_EQ(scheduler.OnQueryComplete(running_dash).size(), 0U);
+}
+
+TEST(QuerySchedulerTest, untracked_completion_is_ignored) {
+  QueryScheduler scheduler(TestLimits());
+  EXPECT_EQ(scheduler.OnQueryComplete(sole::uuid4()).size(), 0U);
+}
+
+}  // namespace agent
+}  // namespace vizier
+}  // namespace px
@@ -18,7 +18,13 @@
 
 #include "src/vizier/services/agent/pem/pem_manager.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
 #include "src/common/system/config.h"
+#include "src/table_store/table/table_snapshot.h"
 #include "src/vizier/services/agent/manager/exec.h"
 #include "src/vizier/services/agent/manager/manager.h"
 
@@ -29,6 +35,13 @@ DEFINE_int32(
     "actual memory usage of all tables could be slightly higher because of indexing and other "
     "overheads.");
 
+DEFINE_int32(table_store_data_limit_percent_of_node,
+             gflags::Int32FromEnv("PL_TABLE_STORE_DATA_LIMIT_PERCENT", 0),
+             "If set to a value in (0, 100], the table store data limit is computed as this "
+             "percent of the node's total memory instead of the fixed table_store_data_limit. "
+             "This lets one setting (e.g. via the operator's customPEMFlags) size PEMs "
+             "appropriately across heterogeneously sized nodes.");
+
 DEFINE_int32(table_store_http_events_percent,
              gflags::Int32FromEnv("PL_TABLE_STORE_HTTP_EVENTS_PERCENT", 40),
              "The percent of the table store data limit that should be devoted to the http_events "
@@ -43,6 +56,12 @@ DEFINE_int32(table_store_proc_exit_events_limit_bytes,
              gflags::Int32FromEnv("PL_TABLE_STORE_PROC_EXIT_EVENTS_LIMIT_BYTES", 10 * 1024 * 1024),
              "The maximum amount of data to store in the proc_exit_events table.");
 
+DEFINE_string(table_store_snapshot_path,
+              gflags::StringFromEnv("PL_TABLE_STORE_SNAPSHOT_PATH", ""),
+              "If set, the table store is snapshotted to this path on graceful shutdown and "
+              "restored from it on startup, carrying collected data across PEM restarts. "
+              "Typically a hostPath so the data survives the pod being replaced.");
+
 namespace px {
 namespace vizier {
 namespace agent {
@@ -53,7 +72,21 @@ Status PEMManager::InitImpl() {
   return Status::OK();
 }
 
+Status PEMManager::WaitForStirling() {
+  if (stirling_ == nullptr && stirling_future_.valid()) {
+    if (stirling_future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      LOG(INFO) << "Waiting for Stirling initialization (BPF deployment) to complete.";
+    }
+    stirling_ = stirling_future_.get();
+  }
+  if (stirling_ == nullptr) {
+    return error::Internal("Stirling is not available");
+  }
+  return Status::OK();
+}
+
 Status PEMManager::PostRegisterHookImpl() {
+  PL_RETURN_IF_ERROR(WaitForStirling());
   stirling_->RegisterDataPushCallback(std::bind(&table_store::TableStore::AppendData, table_store(),
                                                 std::placeholders::_1, std::placeholders::_2,
                                                 std::placeholders::_3));
@@ -66,10 +99,17 @@ Status PEMManager::PostRegisterHookImpl() {
       std::bind(&px::md::AgentMetadataStateManager::CurrentAgentMetadataState, mds_manager()));
 
   PL_RETURN_IF_ERROR(InitSchemas());
+  RestoreTableStoreSnapshot();
   PL_RETURN_IF_ERROR(stirling_->RunAsThread());
 
   auto execute_query_handler = std::make_shared<ExecuteQueryMessageHandler>(
-      dispatcher(), info(), agent_nats_connector(), carnot());
+      dispatcher(), info(), agent_nats_connector(), carnot(), worker_loops());
+  // Report each plan's source tables to Stirling, so that tables no query reads can be
+  // sampled at a crawl.
+  execute_query_handler->RegisterQueriedTablesCallback(
+      [this](absl::flat_hash_set<std::string> tables) {
+        stirling_->UpdateQueriedTables(std::move(tables));
+      });
   PL_RETURN_IF_ERROR(RegisterMessageHandler(messages::VizierMessage::MsgCase::kExecuteQueryRequest,
                                             execute_query_handler));
 
@@ -78,21 +118,59 @@ Status PEMManager::PostRegisterHookImpl() {
                                           stirling_.get(), table_store(), relation_info_manager());
   PL_RETURN_IF_ERROR(RegisterMessageHandler(messages::VizierMessage::MsgCase::kTracepointMessage,
                                             tracepoint_manager_));
+  StartTableStoreRebalancer();
   return Status::OK();
 }
 
 Status PEMManager::StopImpl(std::chrono::milliseconds) {
-  stirling_->Stop();
-  stirling_.reset();
+  // If we are stopped before registration completed, the background creation may still own
+  // Stirling; claim it so its BPF resources are torn down.
+  if (stirling_ == nullptr && stirling_future_.valid()) {
+    stirling_ = stirling_future_.get();
+  }
+  if (stirling_ != nullptr) {
+    stirling_->Stop();
+    stirling_.reset();
+  }
+  WriteTableStoreSnapshot();
   return Status::OK();
 }
 
+void PEMManager::RestoreTableStoreSnapshot() {
+  if (FLAGS_table_store_snapshot_path.empty()) {
+    return;
+  }
+  auto s = table_store::RestoreTableStoreSnapshot(FLAGS_table_store_snapshot_path, table_store());
+  if (s.ok()) {
+    LOG(INFO) << "Restored table store snapshot from " << FLAGS_table_store_snapshot_path;
+  } else if (!error::IsNotFound(s)) {
+    LOG(WARNING) << "Failed to restore table store snapshot: " << s.msg();
+  }
+  // Remove the snapshot either way: the data it held is now in memory (or unusable), and a
+  // later restart should not restore it again on top of newer data.
+  std::error_code ec;
+  std::filesystem::remove(FLAGS_table_store_snapshot_path, ec);
+}
+
+void PEMManager::WriteTableStoreSnapshot() {
+  if (FLAGS_table_store_snapshot_path.empty()) {
+    return;
+  }
+  // Stirling has already been stopped, so the tables are quiesced.
+  auto s = table_store::WriteTableStoreSnapshot(table_store(), FLAGS_table_store_snapshot_path);
+  if (s.ok()) {
+    LOG(INFO) << "Wrote table store snapshot to " << FLAGS_table_store_snapshot_path;
+  } else {
+    LOG(WARNING) << "Failed to write table store snapshot: " << s.msg();
+  }
+}
+
 Status PEMManager::InitSchemas() {
   px::stirling::stirlingpb::Publish publish_pb;
   stirling_->GetPublishProto(&publish_pb);
   auto relation_info_vec = ConvertPublishPBToRelationInfo(publish_pb);
 
-  int64_t memory_limit = FLAGS_table_store_data_limit * 1024 * 1024;
+  int64_t memory_limit = TableStoreMemoryLimit();
   int64_t num_tables = relation_info_vec.size();
   int64_t http_table_size = (FLAGS_table_store_http_events_percent * memory_limit) / 100;
   int64_t stirling_error_table_size = FLAGS_table_store_stirling_error_limit_bytes / 2;
@@ -122,14 +200,86 @@ Status PEMManager::InitSchemas() {
     } else {
       table_ptr = std::make_shared<table_store::Table>(relation_info.name, relation_info.relation,
                                                        other_table_size);
+      rebalanced_tables_.push_back(relation_info.name);
     }
 
     table_store()->AddTable(std::move(table_ptr), relation_info.name, relation_info.id);
     PL_RETURN_IF_ERROR(relation_info_manager()->AddRelationInfo(relation_info));
   }
+  rebalance_pool_bytes_ = other_table_size * static_cast<int64_t>(rebalanced_tables_.size());
   return Status::OK();
 }
 
+int64_t PEMManager::TableStoreMemoryLimit() {
+  int64_t memory_limit = FLAGS_table_store_data_limit * 1024LL * 1024;
+  if (FLAGS_table_store_data_limit_percent_of_node <= 0) {
+    return memory_limit;
+  }
+  int32_t percent = std::min(FLAGS_table_store_data_limit_percent_of_node, 100);
+  px::system::ProcParser proc(px::system::Config::GetInstance());
+  px::system::ProcParser::SystemStats stats;
+  auto s = proc.ParseProcMemInfo(&stats);
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to read node memory size, falling back to the fixed table store "
+                    "data limit: "
+                 << s.msg();
+    return memory_limit;
+  }
+  memory_limit = (stats.mem_total_bytes * percent) / 100;
+  LOG(INFO) << absl::Substitute("Table store data limit set to $0 bytes ($1% of node memory)",
+                                memory_limit, percent);
+  return memory_limit;
+}
+
+void PEMManager::StartTableStoreRebalancer() {
+  if (rebalanced_tables_.size() < 2) {
+    return;
+  }
+  table_rebalance_timer_ = dispatcher()->CreateTimer([this]() {
+    RebalanceTableSizes();
+    if (table_rebalance_timer_) {
+      table_rebalance_timer_->EnableTimer(kTableRebalancePeriod);
+    }
+  });
+  table_rebalance_timer_->EnableTimer(kTableRebalancePeriod);
+}
+
+void PEMManager::RebalanceTableSizes() {
+  // Smoothing for the per-table write rate estimate, and the fraction of the equal split every
+  // table keeps regardless of traffic, so an idle table retains capacity for bursts and a
+  // single write never exceeds its limit.
+  constexpr double kRateEwmaAlpha = 0.5;
+  constexpr double kMinShareOfEqualSplit = 0.25;
+
+  std::vector<std::pair<table_store::Table*, double>> rates;
+  double total_rate = 0;
+  for (const auto& name : rebalanced_tables_) {
+    auto* table = table_store()->GetTable(name);
+    if (table == nullptr) {
+      continue;
+    }
+    int64_t bytes_added = table->GetTableStats().bytes_added;
+    int64_t delta = bytes_added - table_prev_bytes_added_[name];
+    table_prev_bytes_added_[name] = bytes_added;
+    double& rate = table_write_rates_[name];
+    rate = kRateEwmaAlpha * delta + (1.0 - kRateEwmaAlpha) * rate;
+    rates.emplace_back(table, rate);
+    total_rate += rate;
+  }
+  if (rates.empty() || total_rate <= 0) {
+    return;
+  }
+
+  const int64_t equal_share = rebalance_pool_bytes_ / static_cast<int64_t>(rates.size());
+  const int64_t floor_bytes = static_cast<int64_t>(equal_share * kMinShareOfEqualSplit);
+  const int64_t distributable =
+      rebalance_pool_bytes_ - floor_bytes * static_cast<int64_t>(rates.size());
+  for (const auto& [table, rate] : rates) {
+    table->SetMaxTableSize(floor_bytes +
+                           static_cast<int64_t>(distributable * (rate / total_rate)));
+  }
+}
+
 Status PEMManager::InitClockConverters() {
   clock_converter_timer_ = dispatcher()->CreateTimer([this]() {
     auto clock_converter = px::system::Config::GetInstance().clock_converter();
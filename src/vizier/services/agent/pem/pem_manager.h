@@ -19,10 +19,14 @@
 #pragma once
 
 #include <chrono>
+#include <future>
 #include <memory>
 #include <numeric>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
 
 #include <prometheus/gauge.h>
 
@@ -35,6 +39,7 @@ namespace vizier {
 namespace agent {
 
 constexpr auto kNodeMemoryCollectionPeriod = std::chrono::minutes(1);
+constexpr auto kTableRebalancePeriod = std::chrono::minutes(1);
 
 class PEMManager : public Manager {
  public:
@@ -51,8 +56,14 @@ class PEMManager : public Manager {
   PEMManager() = delete;
   PEMManager(sole::uuid agent_id, std::string_view pod_name, std::string_view host_ip,
              std::string_view nats_url)
-      : PEMManager(agent_id, pod_name, host_ip, nats_url,
-                   px::stirling::Stirling::Create(px::stirling::CreateSourceRegistryFromFlag())) {}
+      : PEMManager(agent_id, pod_name, host_ip, nats_url, nullptr) {
+    // Stirling creation compiles and deploys the BPF sources, which dominates PEM cold start.
+    // Kick it off in the background so it overlaps the NATS connection, agent registration and
+    // the initial metadata sync; the result is claimed in PostRegisterHookImpl().
+    stirling_future_ = std::async(std::launch::async, [] {
+      return px::stirling::Stirling::Create(px::stirling::CreateSourceRegistryFromFlag());
+    });
+  }
 
   PEMManager(sole::uuid agent_id, std::string_view pod_name, std::string_view host_ip,
              std::string_view nats_url, std::unique_ptr<stirling::Stirling> stirling)
@@ -82,7 +93,23 @@ class PEMManager : public Manager {
  private:
   Status InitSchemas();
   Status InitClockConverters();
+  // Claims the Stirling instance created in the background, blocking if its BPF deployment has
+  // not finished yet. No-op if Stirling was injected or already claimed.
+  Status WaitForStirling();
   void StartNodeMemoryCollector();
+  // Computes the table store byte budget, either from the fixed table_store_data_limit flag or,
+  // if table_store_data_limit_percent_of_node is set, from the node's total memory, so a single
+  // setting sizes PEMs appropriately across heterogeneous nodes.
+  int64_t TableStoreMemoryLimit();
+  // Periodically redistributes the shared (non-dedicated) table budget pool across tables in
+  // proportion to their observed write rates, so busy tables get retention headroom that idle
+  // tables on this node would otherwise waste.
+  void StartTableStoreRebalancer();
+  void RebalanceTableSizes();
+  // Best-effort save/restore of the table store across restarts; no-ops unless
+  // --table_store_snapshot_path is set. See src/table_store/table/table_snapshot.h.
+  void RestoreTableStoreSnapshot();
+  void WriteTableStoreSnapshot();
   static services::shared::agent::AgentCapabilities Capabilities() {
     services::shared::agent::AgentCapabilities capabilities;
     capabilities.set_collects_data(true);
@@ -90,12 +117,21 @@ class PEMManager : public Manager {
   }
 
   std::unique_ptr<stirling::Stirling> stirling_;
+  std::future<std::unique_ptr<stirling::Stirling>> stirling_future_;
   std::shared_ptr<TracepointManager> tracepoint_manager_;
 
   // Timer for triggering ClockConverter polls.
   px::event::TimerUPtr clock_converter_timer_;
   // Timer for collecting info about the node's available memory.
   px::event::TimerUPtr node_memory_timer_;
+  // Timer and state for re-balancing per-table size limits based on observed write rates. The
+  // rebalanced tables share `rebalance_pool_bytes_`; dedicated tables (http_events etc.) keep
+  // their configured sizes.
+  px::event::TimerUPtr table_rebalance_timer_;
+  std::vector<std::string> rebalanced_tables_;
+  int64_t rebalance_pool_bytes_ = 0;
+  absl::flat_hash_map<std::string, int64_t> table_prev_bytes_added_;
+  absl::flat_hash_map<std::string, double> table_write_rates_;
   prometheus::Gauge& node_available_memory_;
   prometheus::Gauge& node_total_memory_;
 };
@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -37,17 +38,16 @@ TracepointManager::TracepointManager(px::event::Dispatcher* dispatcher, Info* ag
                                      RelationInfoManager* relation_info_manager)
     : MessageHandler(dispatcher, agent_info, nats_conn),
       dispatcher_(dispatcher),
-      nats_conn_(nats_conn),
       stirling_(stirling),
       table_store_(table_store),
-      relation_info_manager_(relation_info_manager) {
+      relation_info_manager_(relation_info_manager),
+      update_batcher_(dispatcher, nats_conn) {
   // Monitor is the background co-routine that monitors the state of the probes and sends
   // updates to the MDS.
   tracepoint_monitor_timer_ =
       dispatcher_->CreateTimer(std::bind(&TracepointManager::Monitor, this));
   // Kick off the background monitor.
   tracepoint_monitor_timer_->EnableTimer(kUpdateInterval);
-  PL_UNUSED(nats_conn_);
 }
 
 Status TracepointManager::HandleMessage(std::unique_ptr<messages::VizierMessage> msg) {
@@ -196,18 +196,16 @@ void TracepointManager::Monitor() {
     }
 
     tracepoint.current_state = current_state;
-    // Update MDS with the latest status.
-    px::vizier::messages::VizierMessage msg;
-    auto tracepoint_msg = msg.mutable_tracepoint_message();
+    // Update MDS with the latest status. Updates are coalesced per tracepoint, so only the
+    // latest state within a flush window is published.
+    auto msg = std::make_unique<px::vizier::messages::VizierMessage>();
+    auto tracepoint_msg = msg->mutable_tracepoint_message();
     auto update_msg = tracepoint_msg->mutable_tracepoint_info_update();
     ToProto(agent_info()->agent_id, update_msg->mutable_agent_id());
     ToProto(id, update_msg->mutable_id());
     update_msg->set_state(tracepoint.current_state);
     probe_status.ToProto(update_msg->mutable_status());
-    auto s = nats_conn_->Publish(msg);
-    if (!s.ok()) {
-      LOG(ERROR) << "Failed to update nats";
-    }
+    update_batcher_.Publish(id.str(), std::move(msg));
   }
   tracepoint_monitor_timer_->EnableTimer(kUpdateInterval);
 }
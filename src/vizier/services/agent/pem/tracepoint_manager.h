@@ -26,6 +26,7 @@
 #include "src/stirling/source_connectors/dynamic_tracer/dynamic_tracing/ir/logicalpb/logical.pb.h"
 #include "src/stirling/stirling.h"
 #include "src/vizier/services/agent/manager/manager.h"
+#include "src/vizier/services/agent/manager/nats_message_batcher.h"
 
 namespace px {
 namespace vizier {
@@ -65,10 +66,12 @@ class TracepointManager : public Manager::MessageHandler {
   Status UpdateSchema(const stirling::stirlingpb::Publish& publish_proto);
 
   px::event::Dispatcher* dispatcher_;
-  Manager::VizierNATSConnector* nats_conn_;
   stirling::Stirling* stirling_;
   table_store::TableStore* table_store_;
   RelationInfoManager* relation_info_manager_;
+  // Coalesces tracepoint status updates so that state flaps within a flush window produce a
+  // single NATS message per tracepoint.
+  NATSMessageBatcher update_batcher_;
 
   event::TimerUPtr tracepoint_monitor_timer_;
   mutable std::mutex mu_;
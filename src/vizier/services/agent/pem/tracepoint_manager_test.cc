@@ -142,6 +142,12 @@ TEST_F(TracepointManagerTest, CreateTracepoint) {
   time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::seconds(10));
   dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
 
+  // The status update is coalesced and only published once the batcher's flush interval elapses.
+  EXPECT_EQ(0, nats_conn_->published_msgs().size());
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::seconds(11) +
+                                 std::chrono::milliseconds(1));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+
   ASSERT_EQ(1, nats_conn_->published_msgs().size());
   auto update = extractTracepointInfoUpdate(nats_conn_->published_msgs()[0]);
   EXPECT_EQ(statuspb::RUNNING_STATE, update.state());
@@ -175,6 +181,12 @@ TEST_F(TracepointManagerTest, CreateTracepointFailed) {
   time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::seconds(10));
   dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
 
+  // The status update is coalesced and only published once the batcher's flush interval elapses.
+  EXPECT_EQ(0, nats_conn_->published_msgs().size());
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::seconds(11) +
+                                 std::chrono::milliseconds(1));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+
   ASSERT_EQ(1, nats_conn_->published_msgs().size());
   auto update = extractTracepointInfoUpdate(nats_conn_->published_msgs()[0]);
   EXPECT_EQ(statuspb::FAILED_STATE, update.state());
@@ -208,6 +220,12 @@ TEST_F(TracepointManagerTest, CreateTracepointPreconditionFailed) {
   time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::seconds(10));
   dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
 
+  // The status update is coalesced and only published once the batcher's flush interval elapses.
+  EXPECT_EQ(0, nats_conn_->published_msgs().size());
+  time_system_->SetMonotonicTime(start_monotonic_time_ + std::chrono::seconds(11) +
+                                 std::chrono::milliseconds(1));
+  dispatcher_->Run(event::Dispatcher::RunType::NonBlock);
+
   ASSERT_EQ(1, nats_conn_->published_msgs().size());
   auto update = extractTracepointInfoUpdate(nats_conn_->published_msgs()[0]);
   EXPECT_EQ(statuspb::FAILED_STATE, update.state());